@@ -21,9 +21,46 @@
 
 namespace outpost
 {
+template <unsigned PREC>
+class FP;
+
+namespace internal
+{
+/**
+ * Conversion of a raw fixpoint value between two precisions.
+ */
+template <unsigned FROM, unsigned TO, bool increase = (TO >= FROM)>
+struct FixpointRescale
+{
+    static constexpr int32_t
+    apply(int32_t value)
+    {
+        return value * (1 << (TO - FROM));
+    }
+};
+
+template <unsigned FROM, unsigned TO>
+struct FixpointRescale<FROM, TO, false>
+{
+    static constexpr int32_t
+    apply(int32_t value)
+    {
+        return value >> (FROM - TO);
+    }
+};
+}  // namespace internal
+
 /**
  * Fixpoint numbers for fast arithmetic operations
  *
+ * All constructors and non-modifying operators are `constexpr`, so that
+ * constants (e.g. filter coefficients) are calculated at compile time and
+ * become immediate values of the arithmetic operations:
+ *
+ * \code
+ * static constexpr Fixpoint h0 = -0.125;
+ * \endcode
+ *
  * @tparam  PREC
  *      Precision, i.e. the number of  fractional bits to use.
  *
@@ -37,25 +74,37 @@ public:
     friend class FP;
 
     // Constructors from various standard types
-    FP() : value(0)
+    constexpr FP() : value(0)
     {
     }
 
-    FP(const FP&) = default;
+    constexpr FP(const FP&) = default;
 
-    FP(int16_t x) : value(x * (1 << PREC))
+    constexpr FP(int16_t x) : value(x * (1 << PREC))
     {
     }
 
-    FP(int32_t x) : value(x * (1 << PREC))
+    constexpr FP(int32_t x) : value(x * (1 << PREC))
     {
     }
 
-    FP(float x) : value(x * (1 << PREC))
+    constexpr FP(float x) : value(x * (1 << PREC))
     {
     }
 
-    FP(double x) : value(x * (1 << PREC))
+    constexpr FP(double x) : value(x * (1 << PREC))
+    {
+    }
+
+    /**
+     * Conversion from a fixpoint number with a different precision.
+     *
+     * Reducing the precision truncates towards negative infinity like
+     * the shift operators.
+     */
+    template <unsigned PP>
+    explicit constexpr FP(const FP<PP>& x) :
+        value(internal::FixpointRescale<PP, PREC>::apply(x.value))
     {
     }
 
@@ -63,14 +112,10 @@ public:
      * Absolute value of the given number.
      * @return Positive number with the same value
      */
-    FP
+    constexpr FP
     abs() const
     {
-        if (value < 0)
-        {
-            return FP::toFixpoint(-value);
-        }
-        return FP::toFixpoint(value);
+        return (value < 0) ? FP::toFixpoint(-value) : FP::toFixpoint(value);
     }
 
     /**
@@ -78,18 +123,9 @@ public:
      *
      * @return Rounded int32_t
      */
-    explicit operator int32_t() const
+    explicit constexpr operator int32_t() const
     {
-        uint8_t round = 0;
-        if (value > 0 && ((1 << (PREC - 1)) & value))
-        {
-            round = 1;
-        }
-        else if (value < 0 && ((1 << (PREC - 1)) & value) && (((1 << (PREC - 1)) - 1) & value))
-        {
-            round = 1;
-        }
-        return static_cast<int32_t>(value >> PREC) + round;
+        return static_cast<int32_t>(value >> PREC) + getRounding();
     }
 
     /**
@@ -97,18 +133,9 @@ public:
      *
      * @return Rounded int16_t
      */
-    explicit operator int16_t() const
+    explicit constexpr operator int16_t() const
     {
-        uint8_t round = 0;
-        if (value > 0 && ((1 << (PREC - 1)) & value))
-        {
-            round = 1;
-        }
-        else if (value < 0 && ((1 << (PREC - 1)) & value) && (((1 << (PREC - 1)) - 1) & value))
-        {
-            round = 1;
-        }
-        return static_cast<int16_t>(value >> PREC) + round;
+        return static_cast<int16_t>(static_cast<int16_t>(value >> PREC) + getRounding());
     }
 
     /**
@@ -116,7 +143,7 @@ public:
      *
      * @return Value as float
      */
-    explicit operator float() const
+    explicit constexpr operator float() const
     {
         return (static_cast<float>(value)) / (1 << PREC);
     }
@@ -126,7 +153,7 @@ public:
      *
      * @return Value as double
      */
-    explicit operator double() const
+    explicit constexpr operator double() const
     {
         return (static_cast<double>(value)) / (1 << PREC);
     }
@@ -204,11 +231,10 @@ public:
      * @param x Summand
      * @return Sum of the current and a second fixpoint number
      */
-    FP
+    constexpr FP
     operator+(const FP& x) const
     {
-        FP res(*this);
-        return res += x;
+        return FP::toFixpoint(value + x.value);
     }
 
     /**
@@ -230,11 +256,10 @@ public:
      * @return Sum of the current and the casted input number
      */
     template <typename TT>
-    FP
+    constexpr FP
     operator+(const TT& x) const
     {
-        FP res(*this);
-        return res += FP(x);
+        return *this + FP(x);
     }
 
     /**
@@ -254,11 +279,10 @@ public:
      * @param x Subtrahend
      * @return Difference of the current and the casted input number
      */
-    FP
+    constexpr FP
     operator-(const FP& x) const
     {
-        FP res(*this);
-        return res -= x;
+        return FP::toFixpoint(value - x.value);
     }
 
     /**
@@ -280,11 +304,10 @@ public:
      * @return Difference of the current and the casted input number
      */
     template <typename TT>
-    FP
+    constexpr FP
     operator-(const TT& x) const
     {
-        FP res(*this);
-        return res -= FP(x);
+        return *this - FP(x);
     }
 
     /**
@@ -295,8 +318,7 @@ public:
     FP&
     operator*=(const FP& x)
     {
-        value = static_cast<int32_t>((static_cast<int64_t>(value) * static_cast<int64_t>(x.value))
-                                     >> PREC);
+        *this = *this * x;
         return *this;
     }
 
@@ -305,10 +327,10 @@ public:
      * @param x Factor
      * @return Product of the current and a second fixpoint number
      */
-    FP operator*(const FP& x) const
+    constexpr FP operator*(const FP& x) const
     {
-        FP res(*this);
-        return res *= x;
+        return FP::toFixpoint(static_cast<int32_t>(
+                (static_cast<int64_t>(value) * static_cast<int64_t>(x.value)) >> PREC));
     }
 
     /**
@@ -330,10 +352,9 @@ public:
      * @return Product of the current and the casted input number
      */
     template <typename TT>
-    FP operator*(const TT& x) const
+    constexpr FP operator*(const TT& x) const
     {
-        FP res(*this);
-        return res *= FP(x);
+        return *this * FP(x);
     }
 
     /**
@@ -344,8 +365,7 @@ public:
     FP&
     operator/=(const FP& x)
     {
-        value = static_cast<int32_t>(((static_cast<int64_t>(value)) << PREC)
-                                     / (static_cast<int64_t>(x.value)));
+        *this = *this / x;
         return *this;
     }
 
@@ -354,11 +374,14 @@ public:
      * @param x Divisor
      * @return Quotient of the current and a second fixpoint number
      */
-    FP
+    constexpr FP
     operator/(const FP& x) const
     {
-        FP res(*this);
-        return res /= x;
+        // Multiplication instead of a left shift, which is not defined
+        // for negative values in a constant expression.
+        return FP::toFixpoint(static_cast<int32_t>(
+                (static_cast<int64_t>(value) * (static_cast<int64_t>(1) << PREC))
+                / static_cast<int64_t>(x.value)));
     }
 
     /**
@@ -380,11 +403,10 @@ public:
      * @return Quotient of the current and the casted input number
      */
     template <typename TT>
-    FP
+    constexpr FP
     operator/(const TT& x) const
     {
-        FP res(*this);
-        return res /= FP(x);
+        return *this / FP(x);
     }
 
     /**
@@ -404,11 +426,10 @@ public:
      * @param x Number of bits to shift
      * @return Fixpoint shifted by x bits
      */
-    FP
+    constexpr FP
     operator<<(const unsigned x) const
     {
-        FP res(*this);
-        return res <<= x;
+        return FP::toFixpoint(static_cast<int32_t>(static_cast<uint32_t>(value) << x));
     }
 
     /**
@@ -428,11 +449,10 @@ public:
      * @param x Number of bits to shift
      * @return Fixpoint shifted by x bits
      */
-    FP
+    constexpr FP
     operator>>(const unsigned x) const
     {
-        FP res(*this);
-        return res >>= x;
+        return FP::toFixpoint(value >> x);
     }
 
     /**
@@ -441,7 +461,7 @@ public:
      * @return True iff the current value is less than x
      */
     template <typename TT>
-    bool
+    constexpr bool
     operator<(const TT& x) const
     {
         return (*this < FP(x));
@@ -452,7 +472,7 @@ public:
      * @param x Number to compare to
      * @return True iff the current value is less than x
      */
-    bool
+    constexpr bool
     operator<(const FP& x) const
     {
         return (value < x.value);
@@ -464,7 +484,7 @@ public:
      * @return True iff the current value is greater than x
      */
     template <typename TT>
-    bool
+    constexpr bool
     operator>(const TT& x) const
     {
         return (*this > FP(x));
@@ -475,7 +495,7 @@ public:
      * @param x Number to compare to
      * @return True iff the current value is greater than x
      */
-    bool
+    constexpr bool
     operator>(const FP& x) const
     {
         return (value > x.value);
@@ -487,7 +507,7 @@ public:
      * @return True iff the current value is equal to x
      */
     template <typename TT>
-    bool
+    constexpr bool
     operator==(const TT& x) const
     {
         return (*this == FP(x));
@@ -498,7 +518,7 @@ public:
      * @param x Number to compare to
      * @return True iff the current value is equal to x
      */
-    bool
+    constexpr bool
     operator==(const FP& x) const
     {
         return value == x.value;
@@ -510,7 +530,7 @@ public:
      * @return True iff the current value is not equal to x
      */
     template <typename TT>
-    bool
+    constexpr bool
     operator!=(const TT& x) const
     {
         return (*this != FP(x));
@@ -521,7 +541,7 @@ public:
      * @param x Number to compare to
      * @return True iff the current value is not equal to x
      */
-    bool
+    constexpr bool
     operator!=(const FP& x) const
     {
         return value != x.value;
@@ -533,7 +553,7 @@ public:
      * @return True iff the current value is less than or equal to x
      */
     template <typename TT>
-    bool
+    constexpr bool
     operator<=(const TT& x) const
     {
         return (*this <= FP(x));
@@ -544,7 +564,7 @@ public:
      * @param x Number to compare to
      * @return True iff the current value is less than or equal to x.
      */
-    bool
+    constexpr bool
     operator<=(const FP& x) const
     {
         return value <= x.value;
@@ -556,7 +576,7 @@ public:
      * @return True iff the current value is greater than or equal to x
      */
     template <typename TT>
-    bool
+    constexpr bool
     operator>=(const TT& x) const
     {
         return (*this >= FP(x));
@@ -567,7 +587,7 @@ public:
      * @param x Number to compare to
      * @return True iff the current value is greater than or equal to x
      */
-    bool
+    constexpr bool
     operator>=(const FP& x) const
     {
         return value >= x.value;
@@ -577,7 +597,7 @@ public:
      * Getter for the raw underlying int32_tv value.
      * @return Raw underlying value
      */
-    int32_t
+    constexpr int32_t
     getValue() const
     {
         return value;
@@ -593,12 +613,10 @@ public:
         value = x;
     }
 
-    static const FP
+    static constexpr FP
     toFixpoint(int32_t x)
     {
-        FP res;
-        res.value = x;
-        return res;
+        return FP(x, RawValue());
     }
 
     static const FP MAX;
@@ -606,6 +624,27 @@ public:
     static const FP MIN;
 
 private:
+    struct RawValue
+    {
+    };
+
+    constexpr FP(int32_t x, RawValue) : value(x)
+    {
+    }
+
+    /**
+     * Rounding of the integer part, see the cast operators.
+     */
+    constexpr int32_t
+    getRounding() const
+    {
+        return ((value > 0 && ((1 << (PREC - 1)) & value))
+                || (value < 0 && ((1 << (PREC - 1)) & value)
+                    && (((1 << (PREC - 1)) - 1) & value)))
+                       ? 1
+                       : 0;
+    }
+
     int32_t value;
 };
 
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_BASE_FIXPOINT_ARRAY_H_
+#define OUTPOST_BASE_FIXPOINT_ARRAY_H_
+
+#include "fixpoint.h"
+#include "slice.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace internal
+{
+inline int32_t
+saturateToInt32(int64_t x)
+{
+    return static_cast<int32_t>((x > INT32_MAX) ? INT32_MAX : ((x < INT32_MIN) ? INT32_MIN : x));
+}
+}  // namespace internal
+
+/**
+ * Operations on arrays of fixpoint numbers.
+ *
+ * The sizes of the arrays are checked once per call, the loops work on
+ * the raw values without any dependency between the elements so that
+ * the compiler can vectorize them for the target.
+ *
+ * The results are the same as for the element-wise operators of `FP`, i.e.
+ * a product is truncated towards negative infinity. The plain variants wrap
+ * around on overflow like the operators, the saturated variants limit the
+ * results to the value range of the underlying int32_t.
+ *
+ * \code
+ * // Convert sensor counts and remove the offset
+ * FixpointArray<16>::convert(counts, samples);
+ * FixpointArray<16>::axpy(Fixpoint(-1), offsets, samples);
+ * \endcode
+ *
+ * @tparam  PREC
+ *      Precision, i.e. the number of fractional bits.
+ */
+template <unsigned PREC>
+class FixpointArray
+{
+public:
+    typedef FP<PREC> Value;
+
+    /**
+     * Multiply all values with a factor.
+     */
+    static inline void
+    scale(outpost::Slice<Value> values, Value factor)
+    {
+        const int64_t f = factor.getValue();
+        for (size_t i = 0; i < values.getNumberOfElements(); ++i)
+        {
+            const int64_t product = static_cast<int64_t>(values[i].getValue()) * f;
+            values[i].setValue(static_cast<int32_t>(product >> PREC));
+        }
+    }
+
+    static inline void
+    scaleSaturated(outpost::Slice<Value> values, Value factor)
+    {
+        const int64_t f = factor.getValue();
+        for (size_t i = 0; i < values.getNumberOfElements(); ++i)
+        {
+            const int64_t product = static_cast<int64_t>(values[i].getValue()) * f;
+            values[i].setValue(internal::saturateToInt32(product >> PREC));
+        }
+    }
+
+    /**
+     * Calculate `y = a * x + y`.
+     *
+     * \retval false
+     *      The arrays have different sizes, nothing has been calculated.
+     */
+    static inline bool
+    axpy(Value a, outpost::Slice<const Value> x, outpost::Slice<Value> y)
+    {
+        if (x.getNumberOfElements() != y.getNumberOfElements())
+        {
+            return false;
+        }
+        const int64_t factor = a.getValue();
+        for (size_t i = 0; i < y.getNumberOfElements(); ++i)
+        {
+            const int64_t product = (static_cast<int64_t>(x[i].getValue()) * factor) >> PREC;
+            y[i].setValue(static_cast<int32_t>(static_cast<int32_t>(product)
+                                               + static_cast<int64_t>(y[i].getValue())));
+        }
+        return true;
+    }
+
+    static inline bool
+    axpySaturated(Value a, outpost::Slice<const Value> x, outpost::Slice<Value> y)
+    {
+        if (x.getNumberOfElements() != y.getNumberOfElements())
+        {
+            return false;
+        }
+        const int64_t factor = a.getValue();
+        for (size_t i = 0; i < y.getNumberOfElements(); ++i)
+        {
+            const int64_t product = (static_cast<int64_t>(x[i].getValue()) * factor) >> PREC;
+            y[i].setValue(internal::saturateToInt32(internal::saturateToInt32(product)
+                                                    + static_cast<int64_t>(y[i].getValue())));
+        }
+        return true;
+    }
+
+    /**
+     * Dot product of two arrays.
+     *
+     * The products are summed up with full precision in 64 bit and are
+     * shifted once at the end, the result is therefore more accurate than
+     * summing up the truncated products of `FP::operator*`. The result is
+     * saturated.
+     *
+     * \retval false
+     *      The arrays have different sizes, the result is unchanged.
+     */
+    static inline bool
+    dot(outpost::Slice<const Value> x, outpost::Slice<const Value> y, Value& result)
+    {
+        if (x.getNumberOfElements() != y.getNumberOfElements())
+        {
+            return false;
+        }
+        int64_t sum = 0;
+        for (size_t i = 0; i < x.getNumberOfElements(); ++i)
+        {
+            sum += static_cast<int64_t>(x[i].getValue()) * static_cast<int64_t>(y[i].getValue());
+        }
+        result.setValue(internal::saturateToInt32(sum >> PREC));
+        return true;
+    }
+
+    /**
+     * Convert integers to fixpoint numbers.
+     *
+     * \retval false
+     *      The arrays have different sizes, nothing has been converted.
+     */
+    static inline bool
+    convert(outpost::Slice<const int16_t> input, outpost::Slice<Value> output)
+    {
+        if (input.getNumberOfElements() != output.getNumberOfElements())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < output.getNumberOfElements(); ++i)
+        {
+            output[i].setValue(static_cast<int32_t>(input[i] * (1 << PREC)));
+        }
+        return true;
+    }
+
+    /**
+     * Convert integers to fixpoint numbers, limits the values if the
+     * precision leaves less than 16 integer bits.
+     */
+    static inline bool
+    convertSaturated(outpost::Slice<const int16_t> input, outpost::Slice<Value> output)
+    {
+        if (input.getNumberOfElements() != output.getNumberOfElements())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < output.getNumberOfElements(); ++i)
+        {
+            output[i].setValue(internal::saturateToInt32(static_cast<int64_t>(input[i])
+                                                         * (static_cast<int64_t>(1) << PREC)));
+        }
+        return true;
+    }
+
+    /**
+     * Convert floating point numbers to fixpoint numbers, truncated
+     * towards zero like `FP(float)`.
+     *
+     * The values must be within the range of the fixpoint format.
+     */
+    static inline bool
+    convert(outpost::Slice<const float> input, outpost::Slice<Value> output)
+    {
+        if (input.getNumberOfElements() != output.getNumberOfElements())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < output.getNumberOfElements(); ++i)
+        {
+            output[i].setValue(static_cast<int32_t>(input[i] * (1 << PREC)));
+        }
+        return true;
+    }
+
+    /**
+     * Convert floating point numbers to fixpoint numbers, values outside
+     * of the range of the fixpoint format (including NaN) are limited.
+     */
+    static inline bool
+    convertSaturated(outpost::Slice<const float> input, outpost::Slice<Value> output)
+    {
+        if (input.getNumberOfElements() != output.getNumberOfElements())
+        {
+            return false;
+        }
+        // INT32_MAX is not exactly representable as float, the largest
+        // float below 2^31 is used instead.
+        const float maximum = 2147483520.0f;
+        const float minimum = -2147483648.0f;
+        for (size_t i = 0; i < output.getNumberOfElements(); ++i)
+        {
+            float x = input[i] * (1 << PREC);
+            x = (x < maximum) ? x : maximum;
+            x = (x > minimum) ? x : minimum;
+            output[i].setValue(static_cast<int32_t>(x));
+        }
+        return true;
+    }
+};
+
+}  // namespace outpost
+
+#endif /* OUTPOST_BASE_FIXPOINT_ARRAY_H_ */
@@ -0,0 +1,445 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_BASE_FIXPOINT_MATH_H_
+#define OUTPOST_BASE_FIXPOINT_MATH_H_
+
+#include "fixpoint.h"
+#include "slice.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace internal
+{
+inline unsigned
+countLeadingZeros(uint64_t x)
+{
+    unsigned n = 0;
+    for (unsigned bits = 32; bits > 0; bits >>= 1)
+    {
+        if ((x >> (64 - bits)) == 0)
+        {
+            n += bits;
+            x <<= bits;
+        }
+    }
+    return n;
+}
+
+/**
+ * Reciprocal of a normalized value.
+ *
+ * \param m
+ *      Value in [2^31, 2^32), i.e. m / 2^32 in [0.5, 1).
+ * \return
+ *      2^62 / m, i.e. the reciprocal of m / 2^32 with 30 fractional bits.
+ *      The relative error is below 2^-28.
+ */
+inline uint64_t
+reciprocalQ30(uint32_t m)
+{
+    // Linear start value 48/17 - 32/17 * m, error below 1/17. Three Newton
+    // iterations y = y * (2 - m * y) square the error each time.
+    uint64_t y = 3031741621ULL - ((2021161080ULL * m) >> 32);
+    for (int i = 0; i < 3; ++i)
+    {
+        const uint64_t product = (static_cast<uint64_t>(m) * y) >> 32;
+        y = (y * ((static_cast<uint64_t>(1) << 31) - product)) >> 30;
+    }
+    return y;
+}
+
+/**
+ * Quotient \p numerator / \p denominator with 30 fractional bits.
+ *
+ * Requires 0 <= numerator <= denominator and denominator > 0.
+ */
+inline int64_t
+divideQ30(uint64_t numerator, uint64_t denominator)
+{
+    const unsigned shift = countLeadingZeros(denominator);
+    const uint32_t m = static_cast<uint32_t>((denominator << shift) >> 32);
+    const uint32_t n = static_cast<uint32_t>((numerator << shift) >> 32);
+    return static_cast<int64_t>((static_cast<uint64_t>(n) * reciprocalQ30(m)) >> 32);
+}
+
+/**
+ * sin(pi / 2 * f) for f in [0, 1], argument and result with 30 fractional
+ * bits. Taylor polynomial up to the 13th order.
+ */
+inline int64_t
+sinQuarterQ30(int64_t f)
+{
+    static const int64_t coefficients[] = {
+            61, -3864, 172272, -5026995, 85569306, -693598668, 1686629713};
+
+    const int64_t f2 = (f * f) >> 30;
+    int64_t p = coefficients[0];
+    for (size_t i = 1; i < sizeof(coefficients) / sizeof(coefficients[0]); ++i)
+    {
+        p = coefficients[i] + ((p * f2) >> 30);
+    }
+    return (p * f) >> 30;
+}
+
+/**
+ * atan(z) for |z| <= tan(pi / 8), argument and result with 30 fractional
+ * bits. Taylor polynomial up to the 17th order.
+ */
+inline int64_t
+atanQ30(int64_t z)
+{
+    static const int64_t coefficients[] = {63161284,
+                                           -71582788,
+                                           82595525,
+                                           -97612893,
+                                           119304647,
+                                           -153391689,
+                                           214748365,
+                                           -357913941,
+                                           1073741824};
+
+    const int64_t z2 = (z * z) >> 30;
+    int64_t p = coefficients[0];
+    for (size_t i = 1; i < sizeof(coefficients) / sizeof(coefficients[0]); ++i)
+    {
+        p = coefficients[i] + ((p * z2) >> 30);
+    }
+    return (p * z) >> 30;
+}
+}  // namespace internal
+
+/**
+ * Mathematical functions for fixpoint numbers.
+ *
+ * Only integer additions, multiplications and shifts are used, there is no
+ * division and no floating point operation. All functions are
+ * deterministic, they give the same results on all targets.
+ *
+ * | Function       | Error of the result                                 |
+ * |----------------|-----------------------------------------------------|
+ * | reciprocal()   | exact, same result as `Value(1) / x`                |
+ * | sqrt()         | exact, rounded down                                 |
+ * | sin(), cos()   | below 2^-27 + 2^-(PREC+1), plus 2^-30 * \|x\|         |
+ * | atan2()        | below 2^-27 + 2^-(PREC+1)                           |
+ *
+ * The errors are absolute errors. The error of sin() and cos() grows with
+ * the argument because the argument reduction by 2 pi is done with a
+ * truncated constant.
+ *
+ * The array variants apply the function to each element. They return
+ * false without calculating anything if the arrays have different sizes.
+ *
+ * \code
+ * Fixpoint angle = FixpointMath<16>::atan2(sunVector.y, sunVector.x);
+ * Fixpoint length = FixpointMath<16>::sqrt(x * x + y * y);
+ * \endcode
+ *
+ * @tparam  PREC
+ *      Precision, i.e. the number of fractional bits. At most 29 so that
+ *      pi can be represented.
+ */
+template <unsigned PREC>
+class FixpointMath
+{
+    static_assert(PREC >= 1 && PREC <= 29, "Precision must be within 1 and 29 bits");
+
+public:
+    typedef FP<PREC> Value;
+
+    /**
+     * Calculate 1 / x.
+     *
+     * The result is limited to the range of the fixpoint format,
+     * 1 / 0 yields the maximum value.
+     */
+    static inline Value
+    reciprocal(Value x)
+    {
+        const int32_t raw = x.getValue();
+        const uint64_t maximum = (raw < 0) ? (static_cast<uint64_t>(1) << 31)
+                                           : static_cast<uint64_t>(INT32_MAX);
+        if (raw == 0)
+        {
+            return Value::toFixpoint(INT32_MAX);
+        }
+        const uint32_t magnitude = (raw < 0) ? (0U - static_cast<uint32_t>(raw))
+                                             : static_cast<uint32_t>(raw);
+
+        // magnitude = m * 2^-n with m in [2^31, 2^32), the estimate is
+        // therefore 2^(2 * PREC) / magnitude = reciprocalQ30(m) * 2^(n + 2 * PREC - 62)
+        const unsigned n = internal::countLeadingZeros(magnitude) - 32;
+        const uint64_t y = internal::reciprocalQ30(magnitude << n);
+        const int shift = static_cast<int>(n + 2 * PREC) - 62;
+        uint64_t quotient = 0;
+        if (shift >= 0)
+        {
+            quotient = y << shift;
+        }
+        else if (shift > -64)
+        {
+            quotient = y >> -shift;
+        }
+
+        // The estimate is off by a few units at most, correct it to the
+        // truncated quotient.
+        if (quotient > maximum + 8)
+        {
+            return saturate(raw < 0);
+        }
+        const int64_t dividend = static_cast<int64_t>(1) << (2 * PREC);
+        int64_t remainder = dividend - static_cast<int64_t>(quotient) * magnitude;
+        while (remainder < 0)
+        {
+            quotient--;
+            remainder += magnitude;
+        }
+        while (remainder >= static_cast<int64_t>(magnitude))
+        {
+            quotient++;
+            remainder -= magnitude;
+        }
+        if (quotient > maximum)
+        {
+            return saturate(raw < 0);
+        }
+        const int64_t result = static_cast<int64_t>(quotient);
+        return Value::toFixpoint(static_cast<int32_t>((raw < 0) ? -result : result));
+    }
+
+    /**
+     * Calculate the square root, rounded down.
+     *
+     * Negative arguments yield zero.
+     */
+    static inline Value
+    sqrt(Value x)
+    {
+        const int32_t raw = x.getValue();
+        if (raw <= 0)
+        {
+            return Value();
+        }
+
+        // Bitwise calculation of the integer square root of raw * 2^PREC
+        uint64_t value = static_cast<uint64_t>(raw) << PREC;
+        uint64_t result = 0;
+        uint64_t bit = static_cast<uint64_t>(1) << 62;
+        while (bit > value)
+        {
+            bit >>= 2;
+        }
+        while (bit != 0)
+        {
+            if (value >= result + bit)
+            {
+                value -= result + bit;
+                result = (result >> 1) + bit;
+            }
+            else
+            {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+        return Value::toFixpoint(static_cast<int32_t>(result));
+    }
+
+    /**
+     * Sine of an angle in radians.
+     */
+    static inline Value
+    sin(Value x)
+    {
+        return fromQ30(sinTurn(toTurn(x)));
+    }
+
+    /**
+     * Cosine of an angle in radians.
+     */
+    static inline Value
+    cos(Value x)
+    {
+        return fromQ30(sinTurn(toTurn(x) + quarterTurn));
+    }
+
+    /**
+     * Angle of the vector (x, y) in radians, within [-pi, pi].
+     *
+     * atan2(0, 0) yields zero.
+     */
+    static inline Value
+    atan2(Value y, Value x)
+    {
+        const int32_t rawX = x.getValue();
+        const int32_t rawY = y.getValue();
+        if ((rawX == 0) && (rawY == 0))
+        {
+            return Value();
+        }
+        const uint64_t absX = (rawX < 0) ? (0U - static_cast<uint32_t>(rawX))
+                                         : static_cast<uint32_t>(rawX);
+        const uint64_t absY = (rawY < 0) ? (0U - static_cast<uint32_t>(rawY))
+                                         : static_cast<uint32_t>(rawY);
+
+        // Reduce to the first octant, atan(n / d) with n <= d
+        const bool swapped = (absY > absX);
+        const uint64_t numerator = swapped ? absX : absY;
+        const uint64_t denominator = swapped ? absY : absX;
+
+        int64_t angle = 0;
+        if ((numerator << 30) > tanPiEighthQ30 * denominator)
+        {
+            // atan(n / d) = pi / 4 + atan((n - d) / (n + d))
+            angle = piQuarterQ30
+                    - internal::atanQ30(internal::divideQ30(denominator - numerator,
+                                                            denominator + numerator));
+        }
+        else
+        {
+            angle = internal::atanQ30(internal::divideQ30(numerator, denominator));
+        }
+
+        if (swapped)
+        {
+            angle = 2 * piQuarterQ30 - angle;
+        }
+        if (rawX < 0)
+        {
+            angle = 4 * piQuarterQ30 - angle;
+        }
+        if (rawY < 0)
+        {
+            angle = -angle;
+        }
+        return fromQ30(angle);
+    }
+
+    static inline bool
+    reciprocal(outpost::Slice<const Value> input, outpost::Slice<Value> output)
+    {
+        return apply(input, output, &FixpointMath::reciprocal);
+    }
+
+    static inline bool
+    sqrt(outpost::Slice<const Value> input, outpost::Slice<Value> output)
+    {
+        return apply(input, output, &FixpointMath::sqrt);
+    }
+
+    static inline bool
+    sin(outpost::Slice<const Value> input, outpost::Slice<Value> output)
+    {
+        return apply(input, output, &FixpointMath::sin);
+    }
+
+    static inline bool
+    cos(outpost::Slice<const Value> input, outpost::Slice<Value> output)
+    {
+        return apply(input, output, &FixpointMath::cos);
+    }
+
+    static inline bool
+    atan2(outpost::Slice<const Value> y,
+          outpost::Slice<const Value> x,
+          outpost::Slice<Value> output)
+    {
+        if ((x.getNumberOfElements() != output.getNumberOfElements())
+            || (y.getNumberOfElements() != output.getNumberOfElements()))
+        {
+            return false;
+        }
+        for (size_t i = 0; i < output.getNumberOfElements(); ++i)
+        {
+            output[i] = atan2(y[i], x[i]);
+        }
+        return true;
+    }
+
+private:
+    /// round(tan(pi / 8) * 2^30)
+    static constexpr uint64_t tanPiEighthQ30 = 444758426;
+
+    /// round(pi / 4 * 2^30)
+    static constexpr int64_t piQuarterQ30 = 843314857;
+
+    /// round(2^32 / (2 * pi))
+    static constexpr int64_t turnsPerRadian = 683565276;
+
+    static constexpr uint32_t quarterTurn = static_cast<uint32_t>(1) << 30;
+
+    static inline Value
+    saturate(bool negative)
+    {
+        return Value::toFixpoint(negative ? INT32_MIN : INT32_MAX);
+    }
+
+    /// Round a value with 30 fractional bits to the precision of the format
+    static inline Value
+    fromQ30(int64_t x)
+    {
+        const int64_t half = static_cast<int64_t>(1) << (29 - PREC);
+        return Value::toFixpoint(static_cast<int32_t>((x + half) >> (30 - PREC)));
+    }
+
+    /// Angle as fraction of a full turn, 2^32 is one turn
+    static inline uint32_t
+    toTurn(Value x)
+    {
+        return static_cast<uint32_t>((static_cast<int64_t>(x.getValue()) * turnsPerRadian) >> PREC);
+    }
+
+    /// Sine of an angle given as fraction of a full turn, result with 30 fractional bits
+    static inline int64_t
+    sinTurn(uint32_t turn)
+    {
+        const uint32_t quadrant = turn >> 30;
+        int64_t f = static_cast<int64_t>(turn & (quarterTurn - 1));
+        if ((quadrant & 1) != 0)
+        {
+            f = static_cast<int64_t>(quarterTurn) - f;
+        }
+        const int64_t result = internal::sinQuarterQ30(f);
+        return ((quadrant & 2) != 0) ? -result : result;
+    }
+
+    static inline bool
+    apply(outpost::Slice<const Value> input, outpost::Slice<Value> output, Value (*function)(Value))
+    {
+        if (input.getNumberOfElements() != output.getNumberOfElements())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < output.getNumberOfElements(); ++i)
+        {
+            output[i] = function(input[i]);
+        }
+        return true;
+    }
+};
+
+template <unsigned PREC>
+constexpr uint64_t FixpointMath<PREC>::tanPiEighthQ30;
+
+template <unsigned PREC>
+constexpr int64_t FixpointMath<PREC>::piQuarterQ30;
+
+template <unsigned PREC>
+constexpr int64_t FixpointMath<PREC>::turnsPerRadian;
+
+template <unsigned PREC>
+constexpr uint32_t FixpointMath<PREC>::quarterTurn;
+
+}  // namespace outpost
+
+#endif /* OUTPOST_BASE_FIXPOINT_MATH_H_ */
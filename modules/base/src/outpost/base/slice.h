@@ -15,12 +15,184 @@
 #define OUTPOST_SLICE_H
 
 #include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 
 #include <gsl/span>
 #include <type_traits>
 
 namespace outpost
 {
+namespace internal
+{
+// workaround missing "is_trivially_copyable" in g++ < 5.0
+template <typename T>
+struct SliceIsTriviallyCopyable
+{
+#if __GNUG__ && __GNUC__ < 5
+    static constexpr bool value = __has_trivial_copy(T);
+#else
+    static constexpr bool value = std::is_trivially_copyable<T>::value;
+#endif
+};
+
+/**
+ * Element types whose object representation is equal if and only if the
+ * values are equal, these can be compared with memcmp.
+ *
+ * Excludes floating point values (+0.0 and -0.0, NaN) and types with
+ * possible padding bytes.
+ */
+template <typename T>
+struct SliceIsBitwiseComparable
+{
+    static constexpr bool value = std::is_integral<T>::value || std::is_enum<T>::value
+                                  || std::is_pointer<T>::value;
+};
+
+/**
+ * Single byte types for which memset and memchr can be used.
+ */
+template <typename T>
+struct SliceIsByte
+{
+    static constexpr bool value = SliceIsBitwiseComparable<T>::value && (sizeof(T) == 1);
+};
+
+template <typename T, bool trivial = SliceIsTriviallyCopyable<T>::value>
+struct SliceCopy
+{
+    static inline void
+    copy(T* destination, const T* source, size_t numberOfElements)
+    {
+        for (size_t i = 0; i < numberOfElements; ++i)
+        {
+            destination[i] = source[i];
+        }
+    }
+
+    static inline void
+    move(T* destination, const T* source, size_t numberOfElements)
+    {
+        if (destination < source)
+        {
+            copy(destination, source, numberOfElements);
+        }
+        else
+        {
+            for (size_t i = numberOfElements; i > 0; --i)
+            {
+                destination[i - 1] = source[i - 1];
+            }
+        }
+    }
+};
+
+template <typename T>
+struct SliceCopy<T, true>
+{
+    static inline void
+    copy(T* destination, const T* source, size_t numberOfElements)
+    {
+        if (numberOfElements > 0)
+        {
+            memcpy(destination, source, numberOfElements * sizeof(T));
+        }
+    }
+
+    static inline void
+    move(T* destination, const T* source, size_t numberOfElements)
+    {
+        if (numberOfElements > 0)
+        {
+            memmove(destination, source, numberOfElements * sizeof(T));
+        }
+    }
+};
+
+template <typename T, bool bitwise = SliceIsBitwiseComparable<T>::value>
+struct SliceCompare
+{
+    static inline bool
+    equals(const T* first, const T* second, size_t numberOfElements)
+    {
+        for (size_t i = 0; i < numberOfElements; ++i)
+        {
+            if (!(first[i] == second[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+template <typename T>
+struct SliceCompare<T, true>
+{
+    static inline bool
+    equals(const T* first, const T* second, size_t numberOfElements)
+    {
+        return (numberOfElements == 0)
+               || (memcmp(first, second, numberOfElements * sizeof(T)) == 0);
+    }
+};
+
+template <typename T, bool byte = SliceIsByte<T>::value>
+struct SliceSearch
+{
+    static inline void
+    fill(T* data, size_t numberOfElements, const T& value)
+    {
+        for (size_t i = 0; i < numberOfElements; ++i)
+        {
+            data[i] = value;
+        }
+    }
+
+    static inline size_t
+    find(const T* data, size_t numberOfElements, const T& value)
+    {
+        for (size_t i = 0; i < numberOfElements; ++i)
+        {
+            if (data[i] == value)
+            {
+                return i;
+            }
+        }
+        return numberOfElements;
+    }
+};
+
+template <typename T>
+struct SliceSearch<T, true>
+{
+    static inline void
+    fill(T* data, size_t numberOfElements, const T& value)
+    {
+        if (numberOfElements > 0)
+        {
+            memset(data, static_cast<uint8_t>(value), numberOfElements);
+        }
+    }
+
+    static inline size_t
+    find(const T* data, size_t numberOfElements, const T& value)
+    {
+        if (numberOfElements == 0)
+        {
+            return 0;
+        }
+        const void* position = memchr(data, static_cast<uint8_t>(value), numberOfElements);
+        if (position == nullptr)
+        {
+            return numberOfElements;
+        }
+        return static_cast<size_t>(static_cast<const T*>(position) - data);
+    }
+};
+}  // namespace internal
+
 /**
  * Slices are a dynamically-sized view into a contiguous sequence of memory.
  *
@@ -43,6 +215,7 @@ public:
 
     // constants and types for compatibility with STL/GSL
     using value_type = ElementType;
+    using ValueType = typename std::remove_const<ElementType>::type;
     using pointer = ElementType*;
     using reference = ElementType&;
 
@@ -198,10 +371,87 @@ public:
     inline void
     fill(const ElementType& v)
     {
+        internal::SliceSearch<ValueType>::fill(mData, mNumberOfElements, v);
+    }
+
+    /**
+     * Copy all elements of the source to the beginning of this slice.
+     *
+     * Uses memcpy for trivially copyable types. The source and this
+     * slice must not overlap, see move() otherwise.
+     *
+     * \retval false
+     *      The source has more elements than this slice, nothing has
+     *      been copied.
+     */
+    inline bool
+    copyFrom(Slice<const ValueType> source) const
+    {
+        if (source.getNumberOfElements() > mNumberOfElements)
+        {
+            return false;
+        }
+        internal::SliceCopy<ValueType>::copy(
+                mData, source.mData, source.getNumberOfElements());
+        return true;
+    }
+
+    /**
+     * Copy all elements of the source to the beginning of this slice.
+     *
+     * Like copyFrom(), but the source and this slice may overlap.
+     */
+    inline bool
+    move(Slice<const ValueType> source) const
+    {
+        if (source.getNumberOfElements() > mNumberOfElements)
+        {
+            return false;
+        }
+        internal::SliceCopy<ValueType>::move(
+                mData, source.mData, source.getNumberOfElements());
+        return true;
+    }
+
+    /**
+     * Check if both slices have the same length and equal elements.
+     *
+     * Integral, enum and pointer types are compared with memcmp, all other
+     * types element-wise with `operator==`.
+     */
+    inline bool
+    equals(Slice<const ValueType> other) const
+    {
+        return (other.getNumberOfElements() == mNumberOfElements)
+               && internal::SliceCompare<ValueType>::equals(
+                       mData, other.mData, mNumberOfElements);
+    }
+
+    /**
+     * Find the first element equal to the given value.
+     *
+     * \return
+     *      Index of the element, getNumberOfElements() if the value
+     *      is not part of the slice.
+     */
+    inline IndexType
+    find(const ValueType& value) const
+    {
+        return internal::SliceSearch<ValueType>::find(mData, mNumberOfElements, value);
+    }
+
+    /**
+     * Count the elements equal to the given value.
+     */
+    inline LengthType
+    count(const ValueType& value) const
+    {
+        LengthType n = 0;
         for (IndexType i = 0; i < mNumberOfElements; i++)
         {
-            mData[i] = v;
+            n += (mData[i] == value) ? 1 : 0;
         }
+        return n;
     }
 
     /**
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/base/fixpoint_array.h>
+
+#include <unittest/harness.h>
+
+using outpost::Fixpoint;
+using outpost::FixpointArray;
+using outpost::Slice;
+
+TEST(FixpointArrayTest, scaleShouldMatchElementWiseMultiplication)
+{
+    Fixpoint values[5] = {1.5, -2.25, 100, -0.001, 0};
+    Fixpoint expected[5];
+    const Fixpoint factor(-0.3);
+    for (size_t i = 0; i < 5; ++i)
+    {
+        expected[i] = values[i] * factor;
+    }
+
+    FixpointArray<16>::scale(outpost::asSlice(values), factor);
+    for (size_t i = 0; i < 5; ++i)
+    {
+        EXPECT_EQ(expected[i], values[i]) << i;
+    }
+}
+
+TEST(FixpointArrayTest, scaleSaturatedShouldLimitResults)
+{
+    Fixpoint values[3] = {20000, -20000, 2};
+    FixpointArray<16>::scaleSaturated(outpost::asSlice(values), Fixpoint(4));
+
+    EXPECT_EQ(INT32_MAX, values[0].getValue());
+    EXPECT_EQ(INT32_MIN, values[1].getValue());
+    EXPECT_EQ(Fixpoint(8), values[2]);
+}
+
+TEST(FixpointArrayTest, axpyShouldMatchElementWiseOperations)
+{
+    const Fixpoint x[4] = {1, -2.5, 0.125, 300};
+    Fixpoint y[4] = {10, 20, -30, 0.5};
+    Fixpoint expected[4];
+    const Fixpoint a(0.75);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        expected[i] = y[i] + a * x[i];
+    }
+
+    EXPECT_TRUE(FixpointArray<16>::axpy(a, outpost::asSlice(x), outpost::asSlice(y)));
+    for (size_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(expected[i], y[i]) << i;
+    }
+}
+
+TEST(FixpointArrayTest, axpyShouldRejectDifferentSizes)
+{
+    const Fixpoint x[2] = {1, 2};
+    Fixpoint y[3] = {1, 2, 3};
+
+    EXPECT_FALSE(FixpointArray<16>::axpy(1, outpost::asSlice(x), outpost::asSlice(y)));
+    EXPECT_FALSE(FixpointArray<16>::axpySaturated(1, outpost::asSlice(x), outpost::asSlice(y)));
+    EXPECT_EQ(Fixpoint(3), y[2]);
+}
+
+TEST(FixpointArrayTest, axpySaturatedShouldLimitResults)
+{
+    const Fixpoint x[2] = {30000, -30000};
+    Fixpoint y[2] = {10000, -10000};
+
+    EXPECT_TRUE(FixpointArray<16>::axpySaturated(
+            Fixpoint(1), outpost::asSlice(x), outpost::asSlice(y)));
+    EXPECT_EQ(INT32_MAX, y[0].getValue());
+    EXPECT_EQ(INT32_MIN, y[1].getValue());
+}
+
+TEST(FixpointArrayTest, shouldCalculateDotProduct)
+{
+    const Fixpoint x[3] = {1, 2, 3};
+    const Fixpoint y[3] = {4, -5, 0.5};
+
+    Fixpoint result;
+    EXPECT_TRUE(FixpointArray<16>::dot(outpost::asSlice(x), outpost::asSlice(y), result));
+    EXPECT_EQ(Fixpoint(-4.5), result);
+
+    EXPECT_FALSE(FixpointArray<16>::dot(
+            outpost::asSlice(x), Slice<const Fixpoint>(outpost::asSlice(y)).first(2), result));
+    EXPECT_EQ(Fixpoint(-4.5), result);
+}
+
+TEST(FixpointArrayTest, shouldConvertIntegers)
+{
+    const int16_t input[3] = {-32768, 1, 32767};
+    Fixpoint output[3];
+
+    EXPECT_TRUE(FixpointArray<16>::convert(outpost::asSlice(input), outpost::asSlice(output)));
+    for (size_t i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(Fixpoint(input[i]), output[i]) << i;
+    }
+
+    outpost::FP<20> saturated[3];
+    EXPECT_TRUE(FixpointArray<20>::convertSaturated(outpost::asSlice(input),
+                                                    outpost::asSlice(saturated)));
+    EXPECT_EQ(INT32_MIN, saturated[0].getValue());
+    EXPECT_EQ(outpost::FP<20>(1), saturated[1]);
+    EXPECT_EQ(INT32_MAX, saturated[2].getValue());
+}
+
+TEST(FixpointArrayTest, shouldConvertFloats)
+{
+    const float input[4] = {1.5f, -0.3f, 1e6f, -1e6f};
+    Fixpoint output[4];
+
+    EXPECT_TRUE(FixpointArray<16>::convert(outpost::asSlice(input).first(2),
+                                           outpost::asSlice(output).first(2)));
+    EXPECT_EQ(Fixpoint(1.5f), output[0]);
+    EXPECT_EQ(Fixpoint(-0.3f), output[1]);
+
+    EXPECT_TRUE(FixpointArray<16>::convertSaturated(outpost::asSlice(input),
+                                                    outpost::asSlice(output)));
+    EXPECT_EQ(Fixpoint(1.5f), output[0]);
+    EXPECT_EQ(Fixpoint(-0.3f), output[1]);
+    EXPECT_EQ(2147483520, output[2].getValue());
+    EXPECT_EQ(INT32_MIN, output[3].getValue());
+
+    EXPECT_FALSE(FixpointArray<16>::convert(outpost::asSlice(input),
+                                            outpost::asSlice(output).first(3)));
+}
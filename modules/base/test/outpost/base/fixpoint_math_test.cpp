@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/base/fixpoint_math.h>
+
+#include <unittest/harness.h>
+
+#include <math.h>
+
+using outpost::Fixpoint;
+using outpost::FixpointMath;
+
+namespace
+{
+typedef FixpointMath<16> Math16;
+typedef FixpointMath<29> Math29;
+
+// Deterministic pseudo random raw values over the whole range and all magnitudes
+int32_t
+nextValue(uint32_t& state)
+{
+    state = state * 1664525U + 1013904223U;
+    return static_cast<int32_t>(state) >> ((state >> 7) % 31);
+}
+
+template <unsigned PREC>
+double
+toDouble(outpost::FP<PREC> x)
+{
+    return static_cast<double>(x.getValue()) / (static_cast<int64_t>(1) << PREC);
+}
+}  // namespace
+
+TEST(FixpointMathTest, reciprocalShouldMatchDivision)
+{
+    uint32_t state = 1;
+    for (int i = 0; i < 100000; ++i)
+    {
+        const Fixpoint x = Fixpoint::toFixpoint(nextValue(state));
+        if (x.getValue() == 0)
+        {
+            continue;
+        }
+        const int64_t expected = (static_cast<int64_t>(1) << 32) / x.getValue();
+        if ((expected <= INT32_MAX) && (expected >= INT32_MIN))
+        {
+            ASSERT_EQ(Fixpoint(1) / x, Math16::reciprocal(x)) << x.getValue();
+        }
+    }
+}
+
+TEST(FixpointMathTest, reciprocalShouldSaturate)
+{
+    EXPECT_EQ(INT32_MAX, Math16::reciprocal(Fixpoint()).getValue());
+    EXPECT_EQ(INT32_MAX, Math16::reciprocal(Fixpoint::toFixpoint(1)).getValue());
+    EXPECT_EQ(INT32_MIN, Math16::reciprocal(Fixpoint::toFixpoint(-1)).getValue());
+    EXPECT_EQ(Fixpoint(0.5), Math16::reciprocal(Fixpoint(2)));
+    EXPECT_EQ(Fixpoint(-4), Math16::reciprocal(Fixpoint(-0.25)));
+}
+
+TEST(FixpointMathTest, sqrtShouldRoundDown)
+{
+    EXPECT_EQ(Fixpoint(3), Math16::sqrt(Fixpoint(9)));
+    EXPECT_EQ(Fixpoint(0.5), Math16::sqrt(Fixpoint(0.25)));
+    EXPECT_EQ(Fixpoint(), Math16::sqrt(Fixpoint(-4)));
+
+    uint32_t state = 2;
+    for (int i = 0; i < 100000; ++i)
+    {
+        const int32_t raw = nextValue(state) & INT32_MAX;
+        const int64_t root = Math16::sqrt(Fixpoint::toFixpoint(raw)).getValue();
+        const int64_t square = static_cast<int64_t>(raw) << 16;
+        ASSERT_LE(root * root, square) << raw;
+        ASSERT_GT((root + 1) * (root + 1), square) << raw;
+    }
+}
+
+TEST(FixpointMathTest, sinAndCosShouldBeWithinErrorBound)
+{
+    const double bound16 = ldexp(1, -27) + ldexp(1, -17);
+    const double bound29 = ldexp(1, -27) + ldexp(1, -30);
+    for (double x = -100; x < 100; x += 0.00731)
+    {
+        const double limit16 = bound16 + ldexp(fabs(x), -30);
+        EXPECT_NEAR(::sin(toDouble(Fixpoint(x))), toDouble(Math16::sin(Fixpoint(x))), limit16);
+        EXPECT_NEAR(::cos(toDouble(Fixpoint(x))), toDouble(Math16::cos(Fixpoint(x))), limit16);
+
+        const outpost::FP<29> small(x / 64);
+        const double limit29 = bound29 + ldexp(fabs(x / 64), -30);
+        EXPECT_NEAR(::sin(toDouble(small)), toDouble(Math29::sin(small)), limit29);
+        EXPECT_NEAR(::cos(toDouble(small)), toDouble(Math29::cos(small)), limit29);
+    }
+}
+
+TEST(FixpointMathTest, atan2ShouldBeWithinErrorBound)
+{
+    EXPECT_EQ(Fixpoint(), Math16::atan2(Fixpoint(), Fixpoint()));
+    // Rounded to the nearest value, Fixpoint(double) would truncate
+    EXPECT_EQ(lround(M_PI * 65536), Math16::atan2(Fixpoint(), Fixpoint(-1)).getValue());
+    EXPECT_EQ(lround(M_PI / 2 * 65536), Math16::atan2(Fixpoint(3), Fixpoint()).getValue());
+    EXPECT_EQ(lround(-M_PI / 2 * 65536), Math16::atan2(Fixpoint(-3), Fixpoint()).getValue());
+
+    const double bound16 = ldexp(1, -27) + ldexp(1, -17);
+    const double bound29 = ldexp(1, -27) + ldexp(1, -30);
+    uint32_t state = 3;
+    for (int i = 0; i < 100000; ++i)
+    {
+        const int32_t x = nextValue(state);
+        const int32_t y = nextValue(state);
+        const double expected = ::atan2(static_cast<double>(y), static_cast<double>(x));
+
+        const double result16 = toDouble(
+                Math16::atan2(Fixpoint::toFixpoint(y), Fixpoint::toFixpoint(x)));
+        const double result29 = toDouble(Math29::atan2(outpost::FP<29>::toFixpoint(y),
+                                                       outpost::FP<29>::toFixpoint(x)));
+        ASSERT_NEAR(expected, result16, bound16) << x << ", " << y;
+        ASSERT_NEAR(expected, result29, bound29) << x << ", " << y;
+    }
+}
+
+TEST(FixpointMathTest, arrayFunctionsShouldMatchScalarFunctions)
+{
+    const Fixpoint input[4] = {0.1, -2, 3.5, 100};
+    Fixpoint output[4];
+
+    ASSERT_TRUE(Math16::sin(outpost::asSlice(input), outpost::asSlice(output)));
+    for (size_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(Math16::sin(input[i]), output[i]);
+    }
+    ASSERT_TRUE(Math16::reciprocal(outpost::asSlice(input), outpost::asSlice(output)));
+    for (size_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(Math16::reciprocal(input[i]), output[i]);
+    }
+    ASSERT_TRUE(Math16::atan2(
+            outpost::asSlice(input), outpost::asSlice(input), outpost::asSlice(output)));
+    for (size_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(Math16::atan2(input[i], input[i]), output[i]);
+    }
+
+    EXPECT_FALSE(Math16::sqrt(outpost::asSlice(input), outpost::asSlice(output).first(3)));
+    EXPECT_FALSE(Math16::cos(outpost::asSlice(input).first(2), outpost::asSlice(output)));
+}
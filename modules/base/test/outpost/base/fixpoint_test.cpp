@@ -388,3 +388,33 @@ TEST(FixpointTest, absTest)
     EXPECT_EQ(fp1.abs(), fp1);
     EXPECT_EQ(fp2.abs(), fp2 * (-1.0));
 }
+
+TEST(FixpointTest, shouldEvaluateAtCompileTime)
+{
+    constexpr outpost::Fixpoint a = -0.125;
+    constexpr outpost::Fixpoint b(int16_t(3));
+    static_assert(a.getValue() == -8192, "conversion from double");
+    static_assert((a * b).getValue() == -24576, "multiplication");
+    static_assert((b / outpost::Fixpoint(int16_t(-2))).getValue() == -98304, "division");
+    static_assert((a + b - 1.0) == 1.875, "mixed operations");
+    static_assert((a << 3) == -1.0, "shift");
+    static_assert(static_cast<int32_t>(b * 0.5) == 2, "rounding");
+    static_assert(a.abs() == 0.125, "abs");
+
+    // Evaluated at runtime
+    outpost::Fixpoint c = a;
+    c *= b;
+    EXPECT_EQ(a * b, c);
+}
+
+TEST(FixpointTest, shouldConvertBetweenPrecisions)
+{
+    constexpr outpost::FP<20> high(-1.75);
+    constexpr outpost::FP<8> low(high);
+    static_assert(low.getValue() == -448, "reduced precision");
+    static_assert(outpost::FP<20>(low) == high, "increased precision");
+
+    const outpost::FP<20> fraction = outpost::FP<20>::toFixpoint(0x1234);
+    EXPECT_EQ(0x1234 >> 12, outpost::FP<8>(fraction).getValue());
+    EXPECT_EQ(outpost::FP<16>(1.5), outpost::FP<16>(outpost::FP<16>(1.5)));
+}
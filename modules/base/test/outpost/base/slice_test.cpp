@@ -334,3 +334,79 @@ TEST(SliceTest, shouldBeUseableInConstexprContextForStdArray)
 
     static_assert(outpost::asSlice(array).getNumberOfElements() == 4, "Must have length 4.");
 }
+
+TEST(SliceTest, shouldFillBytes)
+{
+    uint8_t data[5] = {0};
+    Slice<uint8_t> array(data);
+    array.first(3).fill(0xA5);
+
+    EXPECT_THAT(data, testing::ElementsAre(0xA5, 0xA5, 0xA5, 0, 0));
+}
+
+TEST(SliceTest, shouldCopyFromSmallerSource)
+{
+    const uint16_t source[3] = {1, 2, 3};
+    uint16_t data[4] = {0};
+    Slice<uint16_t> array(data);
+
+    EXPECT_TRUE(array.copyFrom(outpost::asSlice(source)));
+    EXPECT_THAT(data, testing::ElementsAre(1, 2, 3, 0));
+}
+
+TEST(SliceTest, shouldRejectCopyFromLargerSource)
+{
+    const uint8_t source[3] = {1, 2, 3};
+    uint8_t data[2] = {0};
+    Slice<uint8_t> array(data);
+
+    EXPECT_FALSE(array.copyFrom(outpost::asSlice(source)));
+    EXPECT_THAT(data, testing::ElementsAre(0, 0));
+}
+
+TEST(SliceTest, shouldMoveOverlappingElements)
+{
+    uint32_t data[5] = {1, 2, 3, 4, 5};
+    Slice<uint32_t> array(data);
+
+    EXPECT_TRUE(array.skipFirst(1).move(array.first(4)));
+    EXPECT_THAT(data, testing::ElementsAre(1, 1, 2, 3, 4));
+
+    EXPECT_TRUE(array.move(array.skipFirst(2)));
+    EXPECT_THAT(data, testing::ElementsAre(2, 3, 4, 3, 4));
+    EXPECT_FALSE(array.skipFirst(1).move(array));
+}
+
+TEST(SliceTest, shouldCompareElements)
+{
+    const uint8_t first[3] = {1, 2, 3};
+    const uint8_t second[3] = {1, 2, 4};
+    Slice<const uint8_t> array(first);
+
+    EXPECT_TRUE(array.equals(outpost::asSlice(first)));
+    EXPECT_FALSE(array.equals(outpost::asSlice(second)));
+    EXPECT_TRUE(array.first(2).equals(outpost::asSlice(second).first(2)));
+    EXPECT_FALSE(array.equals(array.first(2)));
+
+    const double zero[2] = {0.0, 0.0};
+    const double negativeZero[2] = {-0.0, 0.0};
+    EXPECT_TRUE(outpost::asSlice(zero).equals(outpost::asSlice(negativeZero)));
+}
+
+TEST(SliceTest, shouldFindAndCountElements)
+{
+    const uint8_t bytes[6] = {7, 1, 7, 3, 7, 0};
+    Slice<const uint8_t> array(bytes);
+
+    EXPECT_EQ(0U, array.find(7));
+    EXPECT_EQ(3U, array.find(3));
+    EXPECT_EQ(6U, array.find(9));
+    EXPECT_EQ(0U, array.first(0).find(7));
+    EXPECT_EQ(3U, array.count(7));
+    EXPECT_EQ(0U, array.count(9));
+
+    const uint32_t words[4] = {10, 20, 30, 20};
+    EXPECT_EQ(1U, outpost::asSlice(words).find(20));
+    EXPECT_EQ(4U, outpost::asSlice(words).find(40));
+    EXPECT_EQ(2U, outpost::asSlice(words).count(20));
+}
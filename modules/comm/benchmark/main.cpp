@@ -0,0 +1,569 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/*
+ * End-to-end throughput and latency of the SpaceWire receive path.
+ *
+ * Packets are injected into a unittest::hal::SpaceWireStub, received by
+ * the thread of a SpaceWireMultiProtocolHandler and fanned out to several
+ * listeners, each with an own SharedBufferPool and SharedBufferQueue and a
+ * thread consuming the queue. At the same time an RmapInitiator on the
+ * same handler reads from an RmapTarget, which is connected through a
+ * second stub and handler.
+ *
+ * One JSON record is written to stdout per measurement, see
+ * outpost::utils::BenchmarkRecord:
+ *
+ *     {"suite":"comm","benchmark":"spaceWireReceive","packet_size":1024,
+ *      "listeners":4,"packets":20000,"packets_per_second":...,
+ *      "megabytes_per_second":...,"dropped":0,"dispatch_samples":80000,...,
+ *      "rmap_samples":412,...,"status":"ok"}
+ *
+ * The dispatch latency (prefix "dispatch_") is measured from the injection
+ * of a packet until a listener thread has received it from its queue,
+ * every listener adds one sample per packet. The RMAP latency (prefix
+ * "rmap_") is the duration of a blocking read of 64 bytes. The throughput relates to the injected packets, dropped is
+ * the number of packets the dispatcher could not deliver to a listener
+ * because its pool or queue was exhausted. The status is "ok" or
+ * "failed", the latter if a packet was corrupted, lost without being
+ * counted as dropped or an RMAP read failed.
+ *
+ * Usage:
+ *
+ *     benchmark [packet sizes [listener counts [packets]]]
+ *
+ * with comma separated lists, e.g. "benchmark 16,1024 1,4 20000". The
+ * default measures all combinations of 16, 256, 1024 and 4096 bytes with
+ * 1, 2, 4 and 8 listeners.
+ */
+
+#include <outpost/base/slice.h>
+#include <outpost/comm/rmap/rmap_initiator.h>
+#include <outpost/comm/rmap/rmap_target.h>
+#include <outpost/hal/space_wire_multi_protocol_handler.h>
+#include <outpost/rtos/atomic.h>
+#include <outpost/rtos/clock.h>
+#include <outpost/rtos/cycle_clock.h>
+#include <outpost/rtos/semaphore.h>
+#include <outpost/rtos/thread.h>
+#include <outpost/utils/benchmark/benchmark_record.h>
+#include <outpost/utils/container/reference_queue.h>
+#include <outpost/utils/container/shared_object_pool.h>
+
+#include <unittest/hal/spacewire_stub.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+using namespace outpost;
+
+namespace
+{
+constexpr size_t maximumNumberOfListeners = 8;
+constexpr size_t maximumPacketSize = 4096;
+
+// Protocol identifier, packet counter and injection timestamp
+constexpr size_t headerSize = 2 + sizeof(uint32_t) + sizeof(rtos::CycleClock::Ticks);
+
+// Packets in flight between the injecting thread and the first listener
+constexpr size_t window = 16;
+
+constexpr size_t poolSize = 32;
+constexpr size_t queueSize = 32;
+
+constexpr size_t rmapReadLength = 64;
+constexpr uint32_t rmapAddress = 0x1000;
+constexpr uint8_t targetLogicalAddress = 0x20;
+constexpr uint8_t key = 0x11;
+
+// Incrementing read with reply, the verify flag is only valid for writes
+constexpr comm::RMapOptions readOptions(true, false, true);
+
+// Packets for n listeners use the identifier firstProtocolId + n, see Listener
+constexpr uint8_t firstProtocolId = 0x10;
+
+// One entry per listener and number of listeners it is part of, plus RMAP
+constexpr uint32_t numberOfQueues =
+        maximumNumberOfListeners * (maximumNumberOfListeners + 1) / 2 + 1;
+
+typedef hal::SpaceWireMultiProtocolHandler<numberOfQueues, maximumPacketSize + 64> Handler;
+typedef hal::SpaceWireMultiProtocolHandler<1, maximumPacketSize + 64> TargetHandler;
+
+const size_t defaultPacketSizes[] = {16, 256, 1024, 4096};
+const size_t defaultListenerCounts[] = {1, 2, 4, 8};
+constexpr size_t defaultNumberOfPackets = 20000;
+
+char handlerName[] = "SPW";
+char targetHandlerName[] = "SPWT";
+
+rtos::SystemClock systemClock;
+
+unittest::hal::SpaceWireStub spacewire(maximumPacketSize + 64);
+unittest::hal::SpaceWireStub targetSpacewire(maximumPacketSize + 64);
+
+Handler handler(
+        spacewire, 100, 0, handlerName, support::parameter::HeartbeatSource::default0, systemClock);
+TargetHandler targetHandler(targetSpacewire,
+                            100,
+                            0,
+                            targetHandlerName,
+                            support::parameter::HeartbeatSource::default0,
+                            systemClock);
+
+// Credits of the injecting thread, returned by the first listener
+rtos::Semaphore credits(window);
+
+double
+toMicroseconds(rtos::CycleClock::Ticks ticks)
+{
+    return static_cast<double>(ticks) * 1e6
+           / static_cast<double>(rtos::CycleClock::getFrequency());
+}
+
+// ---------------------------------------------------------------------------
+/**
+ * Consumer of the queue of a listener.
+ *
+ * A dispatcher cannot remove a queue again. All listeners are therefore
+ * registered once: listener i listens to the identifiers of all
+ * measurements with more than i listeners.
+ */
+class Listener : public rtos::Thread
+{
+public:
+    Listener() :
+        Thread(100, defaultStackSize, "listener"),
+        mIndex(0),
+        mReceived(0),
+        mCorrupted(0),
+        mPacketSize(0)
+    {
+    }
+
+    void
+    initialize(size_t index)
+    {
+        mIndex = index;
+        for (size_t n = index + 1; n <= maximumNumberOfListeners; ++n)
+        {
+            handler.addQueue(static_cast<uint8_t>(firstProtocolId + n), &mPool, &mQueue, true);
+        }
+        mSamples.reserve(defaultNumberOfPackets);
+        start();
+    }
+
+    /// Prepare the next measurement, the queue must be empty
+    void
+    reset(size_t packetSize, size_t numberOfPackets)
+    {
+        mPacketSize = packetSize;
+        mSamples.clear();
+        mSamples.reserve(numberOfPackets);
+        mCorrupted.store(0);
+        mReceived.store(0);
+    }
+
+    size_t
+    getNumberOfReceivedPackets() const
+    {
+        return mReceived.load();
+    }
+
+    size_t
+    getNumberOfCorruptedPackets() const
+    {
+        return mCorrupted.load();
+    }
+
+    size_t
+    getNumberOfDroppedPackets()
+    {
+        return handler.getNumberOfDroppedPackages(&mQueue);
+    }
+
+    const std::vector<rtos::CycleClock::Ticks>&
+    getSamples() const
+    {
+        return mSamples;
+    }
+
+private:
+    virtual void
+    run() override
+    {
+        while (true)
+        {
+            utils::SharedBufferPointer packet;
+            if (mQueue.receive(packet, time::Seconds(1)))
+            {
+                const rtos::CycleClock::Ticks now = rtos::CycleClock::now();
+                outpost::Slice<const uint8_t> data = packet.asSlice();
+
+                rtos::CycleClock::Ticks injected = 0;
+                if ((data.getNumberOfElements() == mPacketSize)
+                    && (data[data.getNumberOfElements() - 1] == static_cast<uint8_t>(mPacketSize)))
+                {
+                    memcpy(&injected, &data[2 + sizeof(uint32_t)], sizeof(injected));
+                    mSamples.push_back(now - injected);
+                }
+                else
+                {
+                    mCorrupted.fetchAdd(1);
+                }
+                packet = utils::SharedBufferPointer();
+
+                if (mIndex == 0)
+                {
+                    credits.release();
+                }
+
+                // Published last, the samples are complete once all
+                // packets are counted
+                mReceived.fetchAdd(1);
+            }
+        }
+    }
+
+    size_t mIndex;
+    utils::SharedBufferPool<maximumPacketSize, poolSize> mPool;
+    utils::SharedBufferQueue<queueSize> mQueue;
+
+    rtos::Atomic<size_t> mReceived;
+    rtos::Atomic<size_t> mCorrupted;
+    size_t mPacketSize;
+    std::vector<rtos::CycleClock::Ticks> mSamples;
+};
+
+Listener listeners[maximumNumberOfListeners];
+
+// ---------------------------------------------------------------------------
+uint8_t targetMemory[rmapReadLength];
+comm::RmapMemoryRegion targetRegions[] = {
+        comm::RmapMemoryRegion(0, rmapAddress, outpost::asSlice(targetMemory))};
+
+comm::RmapTarget target(targetHandler,
+                        outpost::asSlice(targetRegions),
+                        targetLogicalAddress,
+                        key,
+                        100,
+                        0,
+                        support::parameter::HeartbeatSource::default0);
+
+comm::RmapTargetNode targetNode("target", 1, targetLogicalAddress, key);
+comm::RmapTargetsList targetNodes;
+comm::RmapInitiator initiator(
+        handler, &targetNodes, 100, 0, support::parameter::HeartbeatSource::default0);
+
+/**
+ * Executes RMAP reads while a measurement is running.
+ */
+class RmapReader : public rtos::Thread
+{
+public:
+    RmapReader() : Thread(100, defaultStackSize, "rmap"), mStart(0), mDone(0), mRunning(0)
+    {
+    }
+
+    void
+    begin()
+    {
+        mSamples.clear();
+        mNumberOfFailures = 0;
+        mRunning.store(1);
+        mStart.release();
+    }
+
+    void
+    end()
+    {
+        mRunning.store(0);
+        mDone.acquire();
+    }
+
+    const std::vector<rtos::CycleClock::Ticks>&
+    getSamples() const
+    {
+        return mSamples;
+    }
+
+    size_t
+    getNumberOfFailures() const
+    {
+        return mNumberOfFailures;
+    }
+
+private:
+    virtual void
+    run() override
+    {
+        uint8_t buffer[rmapReadLength];
+        while (true)
+        {
+            mStart.acquire();
+            while (mRunning.load() != 0)
+            {
+                const rtos::CycleClock::Ticks start = rtos::CycleClock::now();
+                comm::RmapResult result = initiator.read(targetNode,
+                                                         readOptions,
+                                                         rmapAddress,
+                                                         0,
+                                                         outpost::asSlice(buffer),
+                                                         time::Seconds(1));
+                if (result && (memcmp(buffer, targetMemory, sizeof(buffer)) == 0))
+                {
+                    mSamples.push_back(rtos::CycleClock::now() - start);
+                }
+                else
+                {
+                    mNumberOfFailures++;
+                }
+            }
+            mDone.release();
+        }
+    }
+
+    rtos::Semaphore mStart;
+    rtos::Semaphore mDone;
+    rtos::Atomic<uint32_t> mRunning;
+    size_t mNumberOfFailures = 0;
+    std::vector<rtos::CycleClock::Ticks> mSamples;
+};
+
+RmapReader rmapReader;
+
+// ---------------------------------------------------------------------------
+void
+inject(size_t packetSize, size_t numberOfListeners, size_t numberOfPackets)
+{
+    std::vector<uint8_t> packet(packetSize, 0);
+    packet[0] = comm::rmap::defaultLogicalAddress;
+    packet[1] = static_cast<uint8_t>(firstProtocolId + numberOfListeners);
+    packet[packetSize - 1] = static_cast<uint8_t>(packetSize);
+
+    for (uint32_t i = 0; i < numberOfPackets; ++i)
+    {
+        // The first listener may drop packets, do not wait forever for
+        // its credit
+        credits.acquire(time::Milliseconds(10));
+
+        memcpy(&packet[2], &i, sizeof(i));
+        const rtos::CycleClock::Ticks now = rtos::CycleClock::now();
+        memcpy(&packet[2 + sizeof(i)], &now, sizeof(now));
+        spacewire.addPacketToReceive(packet);
+    }
+}
+
+/**
+ * Wait until every listener has received or dropped all packets.
+ *
+ * \retval false    Packets were lost without being counted.
+ */
+bool
+waitForListeners(size_t numberOfListeners, size_t numberOfPackets)
+{
+    for (size_t i = 0; i < numberOfListeners; ++i)
+    {
+        size_t retries = 5000;
+        while ((listeners[i].getNumberOfReceivedPackets()
+                + listeners[i].getNumberOfDroppedPackets())
+               < numberOfPackets)
+        {
+            if (retries == 0)
+            {
+                return false;
+            }
+            retries--;
+            rtos::Thread::sleep(time::Milliseconds(1));
+        }
+    }
+    return true;
+}
+
+void
+measure(size_t packetSize, size_t numberOfListeners, size_t numberOfPackets)
+{
+    for (size_t i = 0; i < numberOfListeners; ++i)
+    {
+        listeners[i].reset(packetSize, numberOfPackets);
+    }
+    handler.resetErrorCounters();
+    while (credits.acquire(time::Duration::zero()))
+    {
+    }
+    for (size_t i = 0; i < window; ++i)
+    {
+        credits.release();
+    }
+
+    rmapReader.begin();
+    const rtos::CycleClock::Ticks start = rtos::CycleClock::now();
+    inject(packetSize, numberOfListeners, numberOfPackets);
+    bool valid = waitForListeners(numberOfListeners, numberOfPackets);
+    const rtos::CycleClock::Ticks end = rtos::CycleClock::now();
+    rmapReader.end();
+
+    std::vector<rtos::CycleClock::Ticks> dispatchSamples;
+    size_t dropped = 0;
+    for (size_t i = 0; i < numberOfListeners; ++i)
+    {
+        const std::vector<rtos::CycleClock::Ticks>& samples = listeners[i].getSamples();
+        dispatchSamples.insert(dispatchSamples.end(), samples.begin(), samples.end());
+        dropped += listeners[i].getNumberOfDroppedPackets();
+        valid = (listeners[i].getNumberOfCorruptedPackets() == 0) && valid;
+    }
+    valid = (handler.getNumberOfUnmatchedPackages() == 0) && valid;
+    valid = (rmapReader.getNumberOfFailures() == 0) && valid;
+
+    typedef outpost::Slice<rtos::CycleClock::Ticks> Samples;
+    std::vector<rtos::CycleClock::Ticks> rmapSamples = rmapReader.getSamples();
+    const utils::BenchmarkStatistics dispatch = utils::BenchmarkStatistics::calculate(
+            Samples::unsafe(dispatchSamples.data(), dispatchSamples.size()), 1);
+    const utils::BenchmarkStatistics rmap = utils::BenchmarkStatistics::calculate(
+            Samples::unsafe(rmapSamples.data(), rmapSamples.size()), 1);
+
+    double seconds = toMicroseconds(end - start) / 1e6;
+    if (seconds <= 0)
+    {
+        seconds = 1e-6;
+    }
+
+    utils::BenchmarkRecord record("comm", "spaceWireReceive");
+    record.addInteger("packet_size", packetSize)
+            .addInteger("listeners", numberOfListeners)
+            .addInteger("packets", numberOfPackets)
+            .addNumber("packets_per_second", numberOfPackets / seconds, 0)
+            .addNumber("megabytes_per_second",
+                       static_cast<double>(numberOfPackets * packetSize) / seconds / 1e6,
+                       2)
+            .addInteger("dropped", dropped)
+            .addStatistics(dispatch, "dispatch_")
+            .addStatistics(rmap, "rmap_")
+            .write(valid);
+}
+
+/**
+ * Parse a comma separated list of numbers into \p values.
+ *
+ * \return  Number of values, zero if the list is invalid.
+ */
+size_t
+parseList(const char* list, size_t* values, size_t maximumNumberOfValues)
+{
+    size_t count = 0;
+    while ((*list != '\0') && (count < maximumNumberOfValues))
+    {
+        char* end = nullptr;
+        const unsigned long value = strtoul(list, &end, 10);
+        if ((end == list) || ((*end != ',') && (*end != '\0')))
+        {
+            return 0;
+        }
+        values[count++] = value;
+        list = (*end == ',') ? end + 1 : end;
+    }
+    return count;
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+    size_t packetSizes[16];
+    size_t numberOfPacketSizes = sizeof(defaultPacketSizes) / sizeof(defaultPacketSizes[0]);
+    std::copy(defaultPacketSizes, defaultPacketSizes + numberOfPacketSizes, packetSizes);
+
+    size_t listenerCounts[16];
+    size_t numberOfListenerCounts =
+            sizeof(defaultListenerCounts) / sizeof(defaultListenerCounts[0]);
+    std::copy(defaultListenerCounts,
+              defaultListenerCounts + numberOfListenerCounts,
+              listenerCounts);
+
+    size_t numberOfPackets = defaultNumberOfPackets;
+
+    if (argc > 1)
+    {
+        numberOfPacketSizes = parseList(argv[1], packetSizes, 16);
+    }
+    if (argc > 2)
+    {
+        numberOfListenerCounts = parseList(argv[2], listenerCounts, 16);
+    }
+    if (argc > 3)
+    {
+        numberOfPackets = strtoul(argv[3], nullptr, 10);
+    }
+
+    bool validArguments = (numberOfPacketSizes > 0) && (numberOfListenerCounts > 0)
+                          && (numberOfPackets > 0);
+    for (size_t i = 0; i < numberOfPacketSizes; ++i)
+    {
+        validArguments = (packetSizes[i] >= headerSize + 1)
+                         && (packetSizes[i] <= maximumPacketSize) && validArguments;
+    }
+    for (size_t i = 0; i < numberOfListenerCounts; ++i)
+    {
+        validArguments = (listenerCounts[i] >= 1)
+                         && (listenerCounts[i] <= maximumNumberOfListeners) && validArguments;
+    }
+    if (!validArguments)
+    {
+        fprintf(stderr,
+                "usage: %s [packet sizes [listener counts [packets]]]\n"
+                "  packet sizes:    %zu..%zu bytes, comma separated\n"
+                "  listener counts: 1..%zu, comma separated\n",
+                argv[0],
+                headerSize + 1,
+                maximumPacketSize,
+                maximumNumberOfListeners);
+        return 1;
+    }
+
+    for (size_t i = 0; i < rmapReadLength; ++i)
+    {
+        targetMemory[i] = static_cast<uint8_t>(i);
+    }
+
+    spacewire.connect(targetSpacewire);
+    targetSpacewire.connect(spacewire);
+    for (unittest::hal::SpaceWireStub* stub : {&spacewire, &targetSpacewire})
+    {
+        stub->setReceiveWaiting(true);
+        stub->open();
+        stub->up(time::Duration::zero());
+    }
+
+    for (size_t i = 0; i < maximumNumberOfListeners; ++i)
+    {
+        listeners[i].initialize(i);
+    }
+    targetNodes.addTargetNode(&targetNode);
+    initiator.init();
+    target.init();
+    rmapReader.start();
+    handler.start();
+    targetHandler.start();
+
+    for (size_t i = 0; i < numberOfPacketSizes; ++i)
+    {
+        for (size_t k = 0; k < numberOfListenerCounts; ++k)
+        {
+            measure(packetSizes[i], listenerCounts[k], numberOfPackets);
+        }
+    }
+
+    // The threads of the pipeline cannot end
+    exit(0);
+}
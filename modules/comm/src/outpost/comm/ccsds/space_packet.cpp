@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "space_packet.h"
+
+using namespace outpost::comm;
+
+constexpr size_t SpacePacketView::primaryHeaderSize;
+constexpr size_t SpacePacketView::minimumPacketSize;
+constexpr uint16_t SpacePacketView::maximumApid;
+constexpr uint16_t SpacePacketView::idleApid;
+constexpr uint16_t SpacePacketView::maximumSequenceCount;
+
+bool
+SpacePacketView::parse(outpost::Slice<const uint8_t> data)
+{
+    reset();
+
+    const size_t length = getPacketLength(data);
+    if ((length == 0) || (length > data.getNumberOfElements()))
+    {
+        return false;
+    }
+
+    // Only version 1 packets (version number 0) are defined
+    if ((data[0] >> 5) != 0)
+    {
+        return false;
+    }
+
+    mPacket = data.first(length);
+    return true;
+}
+
+size_t
+SpacePacketView::getPacketLength(outpost::Slice<const uint8_t> data)
+{
+    if (data.getNumberOfElements() < primaryHeaderSize)
+    {
+        return 0;
+    }
+
+    // The length field contains the length of the data field minus one
+    const size_t dataFieldLength = ((static_cast<size_t>(data[4]) << 8) | data[5]) + 1;
+    return primaryHeaderSize + dataFieldLength;
+}
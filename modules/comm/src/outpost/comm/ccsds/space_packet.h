@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMM_CCSDS_SPACE_PACKET_H_
+#define OUTPOST_COMM_CCSDS_SPACE_PACKET_H_
+
+#include <outpost/base/slice.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace comm
+{
+/**
+ * CCSDS Space Packet (CCSDS 133.0-B), read in place.
+ *
+ * The primary header is decoded when a field is accessed, the view only
+ * refers to the data given to parse(). The data must stay valid as long
+ * as the view is used.
+ *
+ * \code
+ * SpacePacketView packet;
+ * if (packet.parse(buffer.asSlice()))
+ * {
+ *     handle(packet.getApid(), packet.getDataField());
+ * }
+ * \endcode
+ */
+class SpacePacketView
+{
+public:
+    static constexpr size_t primaryHeaderSize = 6;
+
+    /// Smallest packet, the data field has at least one byte
+    static constexpr size_t minimumPacketSize = primaryHeaderSize + 1;
+
+    static constexpr uint16_t maximumApid = 0x7FF;
+    static constexpr uint16_t idleApid = 0x7FF;
+    static constexpr uint16_t maximumSequenceCount = 0x3FFF;
+
+    enum class Type : uint8_t
+    {
+        telemetry = 0,
+        telecommand = 1
+    };
+
+    enum class SequenceFlags : uint8_t
+    {
+        continuation = 0,
+        first = 1,
+        last = 2,
+        unsegmented = 3
+    };
+
+    inline SpacePacketView() : mPacket(outpost::Slice<const uint8_t>::empty())
+    {
+    }
+
+    /**
+     * Check the primary header and refer to the packet.
+     *
+     * \param data
+     *      Begins with the primary header. Bytes behind the length given
+     *      in the header, e.g. a checksum of the transport, are not part
+     *      of the packet.
+     *
+     * \retval false  The data is shorter than the packet or the version
+     *                is not 0, the view is empty.
+     */
+    bool
+    parse(outpost::Slice<const uint8_t> data);
+
+    inline void
+    reset()
+    {
+        mPacket = outpost::Slice<const uint8_t>::empty();
+    }
+
+    inline bool
+    isValid() const
+    {
+        return (mPacket.getNumberOfElements() != 0);
+    }
+
+    /**
+     * Complete packet including the primary header.
+     */
+    inline outpost::Slice<const uint8_t>
+    asSlice() const
+    {
+        return mPacket;
+    }
+
+    inline uint8_t
+    getVersion() const
+    {
+        return getByte(0) >> 5;
+    }
+
+    inline Type
+    getType() const
+    {
+        return static_cast<Type>((getByte(0) >> 4) & 0x01);
+    }
+
+    inline bool
+    hasSecondaryHeader() const
+    {
+        return ((getByte(0) & 0x08) != 0);
+    }
+
+    inline uint16_t
+    getApid() const
+    {
+        return static_cast<uint16_t>(((getByte(0) & 0x07) << 8) | getByte(1));
+    }
+
+    inline bool
+    isIdle() const
+    {
+        return (getApid() == idleApid);
+    }
+
+    inline SequenceFlags
+    getSequenceFlags() const
+    {
+        return static_cast<SequenceFlags>(getByte(2) >> 6);
+    }
+
+    inline uint16_t
+    getSequenceCount() const
+    {
+        return static_cast<uint16_t>(((getByte(2) & 0x3F) << 8) | getByte(3));
+    }
+
+    /**
+     * Length of the complete packet, 0 for an empty view.
+     */
+    inline size_t
+    getPacketLength() const
+    {
+        return mPacket.getNumberOfElements();
+    }
+
+    /**
+     * Secondary header and user data, a part of the parsed data.
+     */
+    inline outpost::Slice<const uint8_t>
+    getDataField() const
+    {
+        return isValid() ? mPacket.skipFirst(primaryHeaderSize)
+                         : outpost::Slice<const uint8_t>::empty();
+    }
+
+    /**
+     * Packet length given by the primary header of \p data.
+     *
+     * \return  0 if \p data is shorter than the primary header.
+     */
+    static size_t
+    getPacketLength(outpost::Slice<const uint8_t> data);
+
+private:
+    inline uint8_t
+    getByte(size_t offset) const
+    {
+        return (offset < mPacket.getNumberOfElements()) ? mPacket[offset] : 0;
+    }
+
+    outpost::Slice<const uint8_t> mPacket;
+};
+
+}  // namespace comm
+}  // namespace outpost
+
+#endif
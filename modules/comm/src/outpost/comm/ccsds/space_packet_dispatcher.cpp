@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "space_packet_dispatcher.h"
+
+#include <string.h>
+
+using namespace outpost::comm;
+
+constexpr uint8_t SpacePacketDispatcherBase::noListener;
+
+SpacePacketDispatcherBase::SpacePacketDispatcherBase(outpost::Slice<Listener> listeners,
+                                                     size_t offset) :
+    mListeners(listeners),
+    mOffset(offset),
+    mNumberOfListeners(0),
+    mDefaultListener(),
+    mNumberOfInvalidPackets(0),
+    mNumberOfUnmatchedPackets(0)
+{
+    memset(mTable, noListener, sizeof(mTable));
+}
+
+bool
+SpacePacketDispatcherBase::addQueue(uint16_t apid,
+                                    outpost::utils::SharedBufferQueueBase* queue,
+                                    uint16_t mask)
+{
+    if ((queue == nullptr) || (mNumberOfListeners >= mListeners.getNumberOfElements())
+        || (mNumberOfListeners >= noListener))
+    {
+        return false;
+    }
+
+    mask &= SpacePacketView::maximumApid;
+    apid &= mask;
+    for (size_t i = 0; i <= SpacePacketView::maximumApid; i++)
+    {
+        if (((i & mask) == apid) && (mTable[i] != noListener))
+        {
+            return false;
+        }
+    }
+
+    Listener& listener = mListeners[mNumberOfListeners];
+    listener = Listener();
+    listener.mQueue = queue;
+    listener.mApid = apid;
+    listener.mMask = mask;
+
+    for (size_t i = 0; i <= SpacePacketView::maximumApid; i++)
+    {
+        if ((i & mask) == apid)
+        {
+            mTable[i] = static_cast<uint8_t>(mNumberOfListeners);
+        }
+    }
+    mNumberOfListeners++;
+    return true;
+}
+
+bool
+SpacePacketDispatcherBase::handlePacket(const outpost::utils::SharedBufferPointer& buffer)
+{
+    SpacePacketView packet;
+    if (!buffer.isValid() || (buffer.getLength() <= mOffset)
+        || !packet.parse(buffer.asSlice().skipFirst(mOffset)))
+    {
+        mNumberOfInvalidPackets++;
+        return false;
+    }
+
+    const uint16_t apid = packet.getApid();
+    const uint8_t index = mTable[apid];
+    if ((index == noListener) && packet.isIdle())
+    {
+        // Idle packets only fill the link
+        return false;
+    }
+
+    Listener& listener = (index != noListener) ? mListeners[index] : mDefaultListener;
+    if (listener.mQueue == nullptr)
+    {
+        mNumberOfUnmatchedPackets++;
+        return false;
+    }
+
+    checkSequenceCount(listener, packet);
+
+    outpost::utils::SharedChildPointer child;
+    if (!buffer.getChild(child, apid, mOffset, packet.getPacketLength())
+        || !listener.mQueue->send(std::move(child)))
+    {
+        listener.mNumberOfDroppedPackets++;
+        return false;
+    }
+    listener.mNumberOfPackets++;
+    return true;
+}
+
+uint32_t
+SpacePacketDispatcherBase::getNumberOfPackets(
+        const outpost::utils::SharedBufferQueueBase* queue) const
+{
+    const Listener* listener = findListener(queue);
+    return (listener != nullptr) ? listener->mNumberOfPackets : 0;
+}
+
+uint32_t
+SpacePacketDispatcherBase::getNumberOfDroppedPackets(
+        const outpost::utils::SharedBufferQueueBase* queue) const
+{
+    const Listener* listener = findListener(queue);
+    return (listener != nullptr) ? listener->mNumberOfDroppedPackets : 0;
+}
+
+uint32_t
+SpacePacketDispatcherBase::getNumberOfSequenceErrors(
+        const outpost::utils::SharedBufferQueueBase* queue) const
+{
+    const Listener* listener = findListener(queue);
+    return (listener != nullptr) ? listener->mNumberOfSequenceErrors : 0;
+}
+
+void
+SpacePacketDispatcherBase::resetErrorCounters()
+{
+    for (size_t i = 0; i < mNumberOfListeners; i++)
+    {
+        mListeners[i].mNumberOfDroppedPackets = 0;
+        mListeners[i].mNumberOfSequenceErrors = 0;
+    }
+    mDefaultListener.mNumberOfDroppedPackets = 0;
+    mNumberOfInvalidPackets = 0;
+    mNumberOfUnmatchedPackets = 0;
+}
+
+const SpacePacketDispatcherBase::Listener*
+SpacePacketDispatcherBase::findListener(const outpost::utils::SharedBufferQueueBase* queue) const
+{
+    for (size_t i = 0; i < mNumberOfListeners; i++)
+    {
+        if (mListeners[i].mQueue == queue)
+        {
+            return &mListeners[i];
+        }
+    }
+    if ((queue != nullptr) && (mDefaultListener.mQueue == queue))
+    {
+        return &mDefaultListener;
+    }
+    return nullptr;
+}
+
+void
+SpacePacketDispatcherBase::checkSequenceCount(Listener& listener, const SpacePacketView& packet)
+{
+    // The counts of several APIDs are independent of each other
+    if (listener.mMask != SpacePacketView::maximumApid)
+    {
+        return;
+    }
+
+    const uint16_t count = packet.getSequenceCount();
+    if (listener.mSequenceCountValid && (count != listener.mNextSequenceCount))
+    {
+        listener.mNumberOfSequenceErrors++;
+    }
+    listener.mNextSequenceCount = (count + 1) & SpacePacketView::maximumSequenceCount;
+    listener.mSequenceCountValid = true;
+}
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMM_CCSDS_SPACE_PACKET_DISPATCHER_H_
+#define OUTPOST_COMM_CCSDS_SPACE_PACKET_DISPATCHER_H_
+
+#include "space_packet.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/utils/container/reference_queue.h>
+#include <outpost/utils/container/shared_buffer.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace comm
+{
+/**
+ * Distribute received Space Packets to queues by their APID.
+ *
+ * A queue receives the packets of all APIDs that match its APID in the
+ * bits of a mask, e.g. APID 0x100 with mask 0x7F0 for the APIDs 0x100
+ * to 0x10F. The queue of every APID is stored in a table with one entry
+ * per APID, the lookup does not depend on the number of queues.
+ *
+ * The queues get a child pointer to the received buffer, the packet is
+ * not copied. The type of the child is the APID.
+ *
+ * Idle packets are discarded unless a queue was added for the idle APID.
+ *
+ * For queues of a single APID (mask 0x7FF) the sequence count is
+ * checked, every gap is counted as sequence error.
+ *
+ * Queues have to be added before packets are dispatched. handlePacket()
+ * must not be called by several threads at the same time.
+ *
+ * \see SpacePacketDispatcher
+ */
+class SpacePacketDispatcherBase
+{
+public:
+    struct Listener
+    {
+        Listener() :
+            mQueue(nullptr),
+            mApid(0),
+            mMask(0),
+            mNextSequenceCount(0),
+            mSequenceCountValid(false),
+            mNumberOfPackets(0),
+            mNumberOfDroppedPackets(0),
+            mNumberOfSequenceErrors(0)
+        {
+        }
+
+        outpost::utils::SharedBufferQueueBase* mQueue;
+        uint16_t mApid;
+        uint16_t mMask;
+        uint16_t mNextSequenceCount;
+        bool mSequenceCountValid;
+        uint32_t mNumberOfPackets;
+        uint32_t mNumberOfDroppedPackets;
+        uint32_t mNumberOfSequenceErrors;
+    };
+
+    /**
+     * \param listeners
+     *      Storage for the queues, at most 254 elements.
+     * \param offset
+     *      Number of bytes in front of the packet in a received buffer,
+     *      e.g. the address and protocol identifier of a SpaceWire packet.
+     */
+    SpacePacketDispatcherBase(outpost::Slice<Listener> listeners, size_t offset);
+
+    // disable copy constructor
+    SpacePacketDispatcherBase(const SpacePacketDispatcherBase&) = delete;
+
+    // disable assignment operator
+    SpacePacketDispatcherBase&
+    operator=(const SpacePacketDispatcherBase&) = delete;
+
+    /**
+     * Add a queue for the APIDs matching \p apid in the bits of \p mask.
+     *
+     * \retval false  No storage left, \p queue is nullptr or one of the
+     *                APIDs is already assigned to a queue.
+     */
+    bool
+    addQueue(uint16_t apid,
+             outpost::utils::SharedBufferQueueBase* queue,
+             uint16_t mask = SpacePacketView::maximumApid);
+
+    /**
+     * Queue for the packets of APIDs without a queue, may be nullptr.
+     */
+    inline void
+    setDefaultQueue(outpost::utils::SharedBufferQueueBase* queue)
+    {
+        mDefaultListener.mQueue = queue;
+    }
+
+    /**
+     * Dispatch the packet in a received buffer.
+     *
+     * \param buffer
+     *      Received data, the packet starts at the offset given to the
+     *      constructor.
+     *
+     * \retval true   Packet was put into a queue.
+     */
+    bool
+    handlePacket(const outpost::utils::SharedBufferPointer& buffer);
+
+    /**
+     * Number of packets put into \p queue.
+     */
+    uint32_t
+    getNumberOfPackets(const outpost::utils::SharedBufferQueueBase* queue) const;
+
+    /**
+     * Number of packets for \p queue dropped because the queue was full.
+     */
+    uint32_t
+    getNumberOfDroppedPackets(const outpost::utils::SharedBufferQueueBase* queue) const;
+
+    /**
+     * Number of gaps in the sequence count of the packets for \p queue.
+     */
+    uint32_t
+    getNumberOfSequenceErrors(const outpost::utils::SharedBufferQueueBase* queue) const;
+
+    /// Buffers which do not contain a valid packet
+    inline uint32_t
+    getNumberOfInvalidPackets() const
+    {
+        return mNumberOfInvalidPackets;
+    }
+
+    /// Packets of APIDs without a queue while no default queue was set
+    inline uint32_t
+    getNumberOfUnmatchedPackets() const
+    {
+        return mNumberOfUnmatchedPackets;
+    }
+
+    void
+    resetErrorCounters();
+
+private:
+    static constexpr uint8_t noListener = 0xFF;
+
+    const Listener*
+    findListener(const outpost::utils::SharedBufferQueueBase* queue) const;
+
+    void
+    checkSequenceCount(Listener& listener, const SpacePacketView& packet);
+
+    const outpost::Slice<Listener> mListeners;
+    const size_t mOffset;
+    size_t mNumberOfListeners;
+    Listener mDefaultListener;
+    uint32_t mNumberOfInvalidPackets;
+    uint32_t mNumberOfUnmatchedPackets;
+
+    // Index into mListeners for every APID
+    uint8_t mTable[SpacePacketView::maximumApid + 1];
+};
+
+namespace internal
+{
+/**
+ * Memory of a SpacePacketDispatcher.
+ *
+ * Base class of SpacePacketDispatcher so that it is constructed before
+ * SpacePacketDispatcherBase refers to it.
+ */
+template <size_t numberOfQueues>
+class SpacePacketDispatcherStorage
+{
+protected:
+    SpacePacketDispatcherStorage() : mListenerStorage()
+    {
+    }
+
+    SpacePacketDispatcherBase::Listener mListenerStorage[numberOfQueues];
+};
+}  // namespace internal
+
+/**
+ * Space Packet dispatcher with storage for \p numberOfQueues queues.
+ */
+template <size_t numberOfQueues>
+class SpacePacketDispatcher : private internal::SpacePacketDispatcherStorage<numberOfQueues>,
+                              public SpacePacketDispatcherBase
+{
+    static_assert(numberOfQueues > 0, "At least one queue required");
+    static_assert(numberOfQueues < 0xFF, "At most 254 queues are supported");
+
+public:
+    explicit SpacePacketDispatcher(size_t offset = 0) :
+        internal::SpacePacketDispatcherStorage<numberOfQueues>(),
+        SpacePacketDispatcherBase(outpost::asSlice(this->mListenerStorage), offset)
+    {
+    }
+};
+
+}  // namespace comm
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "downlink_scheduler.h"
+
+#include <string.h>
+
+using outpost::comm::DownlinkSchedulerBase;
+
+DownlinkSchedulerBase::DownlinkSchedulerBase(outpost::Slice<PacketClass> classes) :
+    mClasses(classes), mNumberOfClasses(0), mCurrent(0), mLock()
+{
+}
+
+int
+DownlinkSchedulerBase::addClass(outpost::utils::SharedRingBuffer& queue,
+                                uint32_t quantum,
+                                uint32_t budget)
+{
+    outpost::rtos::MutexGuard lock(mLock);
+    if ((mNumberOfClasses >= mClasses.getNumberOfElements()) || (quantum == 0))
+    {
+        return -1;
+    }
+
+    PacketClass& packetClass = mClasses[mNumberOfClasses];
+    packetClass = PacketClass();
+    packetClass.mQueue = &queue;
+    packetClass.mQuantum = quantum;
+    packetClass.mBudget = budget;
+    return static_cast<int>(mNumberOfClasses++);
+}
+
+bool
+DownlinkSchedulerBase::submit(size_t classIndex, const outpost::utils::SharedBufferPointer& packet)
+{
+    outpost::rtos::MutexGuard lock(mLock);
+    if (classIndex >= mNumberOfClasses)
+    {
+        return false;
+    }
+    return mClasses[classIndex].mQueue->append(packet);
+}
+
+size_t
+DownlinkSchedulerBase::fillFrame(outpost::Slice<uint8_t> frame)
+{
+    outpost::rtos::MutexGuard lock(mLock);
+    const size_t frameLength = frame.getNumberOfElements();
+    size_t position = 0;
+
+    // Stop after every class was visited once without an eligible packet
+    size_t ineligible = 0;
+    while (ineligible < mNumberOfClasses)
+    {
+        PacketClass& packetClass = mClasses[mCurrent];
+        if (!hasEligiblePacket(packetClass, frameLength))
+        {
+            if (packetClass.mQueue->isEmpty())
+            {
+                packetClass.mDeficit = 0;
+            }
+            packetClass.mCredited = false;
+            advance();
+            ineligible++;
+            continue;
+        }
+
+        ineligible = 0;
+        if (!packetClass.mCredited)
+        {
+            packetClass.mDeficit += packetClass.mQuantum;
+            packetClass.mCredited = true;
+        }
+
+        while (hasEligiblePacket(packetClass, frameLength))
+        {
+            const outpost::utils::SharedBufferPointer& packet = packetClass.mQueue->read();
+            const size_t length = packet.getLength();
+            if (length > packetClass.mDeficit)
+            {
+                break;
+            }
+            if (length > (frameLength - position))
+            {
+                // The class keeps its credit and starts the next frame
+                return position;
+            }
+
+            memcpy(&frame[position], &packet[0], length);
+            position += length;
+            packetClass.mDeficit -= length;
+            packetClass.mUsedBudget += length;
+            packetClass.mNumberOfPackets++;
+            packetClass.mNumberOfBytes += length;
+            packetClass.mQueue->pop();
+        }
+
+        if (packetClass.mQueue->isEmpty())
+        {
+            packetClass.mDeficit = 0;
+        }
+        packetClass.mCredited = false;
+        advance();
+    }
+    return position;
+}
+
+void
+DownlinkSchedulerBase::startPeriod()
+{
+    outpost::rtos::MutexGuard lock(mLock);
+    for (size_t i = 0; i < mNumberOfClasses; ++i)
+    {
+        mClasses[i].mUsedBudget = 0;
+    }
+}
+
+size_t
+DownlinkSchedulerBase::getNumberOfPendingPackets(size_t classIndex) const
+{
+    outpost::rtos::MutexGuard lock(mLock);
+    return (classIndex < mNumberOfClasses) ? mClasses[classIndex].mQueue->getUsedSlots() : 0;
+}
+
+uint32_t
+DownlinkSchedulerBase::getNumberOfPackets(size_t classIndex) const
+{
+    return (classIndex < mNumberOfClasses) ? mClasses[classIndex].mNumberOfPackets : 0;
+}
+
+uint32_t
+DownlinkSchedulerBase::getNumberOfBytes(size_t classIndex) const
+{
+    return (classIndex < mNumberOfClasses) ? mClasses[classIndex].mNumberOfBytes : 0;
+}
+
+uint32_t
+DownlinkSchedulerBase::getNumberOfDroppedPackets(size_t classIndex) const
+{
+    return (classIndex < mNumberOfClasses) ? mClasses[classIndex].mNumberOfDroppedPackets : 0;
+}
+
+bool
+DownlinkSchedulerBase::hasEligiblePacket(PacketClass& packetClass, size_t frameLength)
+{
+    outpost::utils::SharedRingBuffer& queue = *packetClass.mQueue;
+    while (!queue.isEmpty()
+           && (!queue.read().isValid() || (queue.read().getLength() == 0)
+               || (queue.read().getLength() > frameLength)))
+    {
+        queue.pop();
+        packetClass.mNumberOfDroppedPackets++;
+    }
+
+    if (queue.isEmpty())
+    {
+        return false;
+    }
+    return (packetClass.mBudget == 0)
+           || ((packetClass.mUsedBudget + queue.read().getLength()) <= packetClass.mBudget);
+}
+
+void
+DownlinkSchedulerBase::advance()
+{
+    mCurrent++;
+    if (mCurrent >= mNumberOfClasses)
+    {
+        mCurrent = 0;
+    }
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMM_DOWNLINK_DOWNLINK_SCHEDULER_H_
+#define OUTPOST_COMM_DOWNLINK_DOWNLINK_SCHEDULER_H_
+
+#include <outpost/base/slice.h>
+#include <outpost/rtos.h>
+#include <outpost/utils/container/shared_buffer.h>
+#include <outpost/utils/container/shared_ring_buffer.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace comm
+{
+/**
+ * Schedule the downlink of telemetry packets from several classes.
+ *
+ * Every class (e.g. real-time housekeeping, events, science data) has a
+ * SharedRingBuffer of packets. The classes share the link by deficit
+ * round robin: each round a class is credited with its quantum in bytes
+ * and sends packets as long as the credit covers them. Over time the
+ * classes therefore get a share of the link proportional to their
+ * quantum, independent of their packet sizes. A class without packets
+ * loses its remaining credit.
+ *
+ * In addition a class can be limited by a budget of bytes per period.
+ * The period is defined by the caller through startPeriod(), e.g. once
+ * per second for a budget in bytes per second. Budget not used by one
+ * class is available to the others.
+ *
+ * fillFrame() packs as many packets as fit into the data field of a
+ * transfer frame, so that small packets share the overhead of a frame.
+ * The packets have to be self-delimiting, e.g. Space Packets. A packet
+ * larger than the frame is discarded. The scheduling state is kept
+ * between frames, a packet which does not fit into the rest of a frame
+ * starts the next one.
+ *
+ * Packets are added with submit(), which may be called by the producer
+ * threads while another thread fills the frames.
+ *
+ * \see DownlinkScheduler
+ */
+class DownlinkSchedulerBase
+{
+public:
+    struct PacketClass
+    {
+        PacketClass() :
+            mQueue(nullptr),
+            mQuantum(0),
+            mBudget(0),
+            mDeficit(0),
+            mUsedBudget(0),
+            mCredited(false),
+            mNumberOfPackets(0),
+            mNumberOfBytes(0),
+            mNumberOfDroppedPackets(0)
+        {
+        }
+
+        outpost::utils::SharedRingBuffer* mQueue;
+        uint32_t mQuantum;
+
+        /// Bytes per period, zero for no limit
+        uint32_t mBudget;
+
+        uint32_t mDeficit;
+        uint32_t mUsedBudget;
+
+        /// Quantum of the current round was already added to the deficit
+        bool mCredited;
+
+        uint32_t mNumberOfPackets;
+        uint32_t mNumberOfBytes;
+        uint32_t mNumberOfDroppedPackets;
+    };
+
+    explicit DownlinkSchedulerBase(outpost::Slice<PacketClass> classes);
+
+    // disable copy constructor
+    DownlinkSchedulerBase(const DownlinkSchedulerBase&) = delete;
+
+    // disable assignment operator
+    DownlinkSchedulerBase&
+    operator=(const DownlinkSchedulerBase&) = delete;
+
+    /**
+     * Add a class of packets.
+     *
+     * The classes are visited in the order in which they were added.
+     *
+     * \param queue
+     *      Packets of the class. Must only be accessed through the
+     *      scheduler afterwards.
+     * \param quantum
+     *      Bytes credited per round, the weight of the class. Should
+     *      be at least the size of the largest packet of the class.
+     * \param budget
+     *      Bytes per period, zero for no limit.
+     *
+     * \return  Index of the class, or -1 if no storage is left or
+     *          \p quantum is zero.
+     */
+    int
+    addClass(outpost::utils::SharedRingBuffer& queue, uint32_t quantum, uint32_t budget = 0);
+
+    /**
+     * Add a packet to a class.
+     *
+     * \retval false  Invalid class or its queue is full.
+     */
+    bool
+    submit(size_t classIndex, const outpost::utils::SharedBufferPointer& packet);
+
+    /**
+     * Copy the next packets into \p frame.
+     *
+     * \return  Number of bytes written, the rest of the frame is left
+     *          for e.g. an idle packet. Zero if no packet is eligible.
+     */
+    size_t
+    fillFrame(outpost::Slice<uint8_t> frame);
+
+    /**
+     * Start a new budget period.
+     */
+    void
+    startPeriod();
+
+    inline size_t
+    getNumberOfClasses() const
+    {
+        return mNumberOfClasses;
+    }
+
+    /**
+     * Number of packets waiting in a class.
+     */
+    size_t
+    getNumberOfPendingPackets(size_t classIndex) const;
+
+    /**
+     * Number of packets sent by a class.
+     */
+    uint32_t
+    getNumberOfPackets(size_t classIndex) const;
+
+    /**
+     * Number of bytes sent by a class.
+     */
+    uint32_t
+    getNumberOfBytes(size_t classIndex) const;
+
+    /**
+     * Packets of a class which were discarded because they are empty
+     * or larger than a frame.
+     */
+    uint32_t
+    getNumberOfDroppedPackets(size_t classIndex) const;
+
+private:
+    /**
+     * Discard the packets at the head of the class which can never be
+     * sent, then check whether the budget allows the next packet.
+     */
+    bool
+    hasEligiblePacket(PacketClass& packetClass, size_t frameLength);
+
+    void
+    advance();
+
+    const outpost::Slice<PacketClass> mClasses;
+    size_t mNumberOfClasses;
+    size_t mCurrent;
+    mutable outpost::rtos::Mutex mLock;
+};
+
+namespace internal
+{
+/**
+ * Memory of a DownlinkScheduler.
+ *
+ * Base class of DownlinkScheduler so that it is constructed before
+ * DownlinkSchedulerBase refers to it.
+ */
+template <size_t numberOfClasses>
+class DownlinkSchedulerStorage
+{
+protected:
+    DownlinkSchedulerStorage() : mClassStorage()
+    {
+    }
+
+    DownlinkSchedulerBase::PacketClass mClassStorage[numberOfClasses];
+};
+}  // namespace internal
+
+/**
+ * Downlink scheduler with storage for \p numberOfClasses classes.
+ */
+template <size_t numberOfClasses>
+class DownlinkScheduler : private internal::DownlinkSchedulerStorage<numberOfClasses>,
+                          public DownlinkSchedulerBase
+{
+    static_assert(numberOfClasses > 0, "At least one class required");
+
+public:
+    DownlinkScheduler() :
+        internal::DownlinkSchedulerStorage<numberOfClasses>(),
+        DownlinkSchedulerBase(outpost::asSlice(this->mClassStorage))
+    {
+    }
+};
+
+}  // namespace comm
+}  // namespace outpost
+
+#endif
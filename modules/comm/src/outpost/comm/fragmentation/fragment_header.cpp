@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "fragment_header.h"
+
+using outpost::comm::FragmentHeader;
+
+constexpr size_t FragmentHeader::size;
+
+static inline void
+writeWord(uint8_t* data, uint32_t value)
+{
+    data[0] = static_cast<uint8_t>(value >> 24);
+    data[1] = static_cast<uint8_t>(value >> 16);
+    data[2] = static_cast<uint8_t>(value >> 8);
+    data[3] = static_cast<uint8_t>(value);
+}
+
+static inline uint32_t
+readWord(const uint8_t* data)
+{
+    return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16)
+           | (static_cast<uint32_t>(data[2]) << 8) | data[3];
+}
+
+bool
+FragmentHeader::write(outpost::Slice<uint8_t> buffer) const
+{
+    if (buffer.getNumberOfElements() < size)
+    {
+        return false;
+    }
+
+    buffer[0] = mTargetLogicalAddress;
+    buffer[1] = mProtocolId;
+    buffer[2] = static_cast<uint8_t>(mDatasetId >> 8);
+    buffer[3] = static_cast<uint8_t>(mDatasetId);
+    buffer[4] = static_cast<uint8_t>(mIndex >> 8);
+    buffer[5] = static_cast<uint8_t>(mIndex);
+    buffer[6] = static_cast<uint8_t>(mNumberOfFragments >> 8);
+    buffer[7] = static_cast<uint8_t>(mNumberOfFragments);
+    writeWord(&buffer[8], mTotalLength);
+    writeWord(&buffer[12], mOffset);
+    return true;
+}
+
+bool
+FragmentHeader::read(outpost::Slice<const uint8_t> packet)
+{
+    if (packet.getNumberOfElements() < size)
+    {
+        return false;
+    }
+
+    mTargetLogicalAddress = packet[0];
+    mProtocolId = packet[1];
+    mDatasetId = static_cast<uint16_t>((packet[2] << 8) | packet[3]);
+    mIndex = static_cast<uint16_t>((packet[4] << 8) | packet[5]);
+    mNumberOfFragments = static_cast<uint16_t>((packet[6] << 8) | packet[7]);
+    mTotalLength = readWord(&packet[8]);
+    mOffset = readWord(&packet[12]);
+
+    const size_t length = packet.getNumberOfElements() - size;
+    return (mNumberOfFragments > 0) && (mIndex < mNumberOfFragments) && (mTotalLength > 0)
+           && (mOffset <= mTotalLength) && (length <= (mTotalLength - mOffset));
+}
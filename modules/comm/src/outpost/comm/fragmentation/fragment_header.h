@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMM_FRAGMENTATION_FRAGMENT_HEADER_H_
+#define OUTPOST_COMM_FRAGMENTATION_FRAGMENT_HEADER_H_
+
+#include <outpost/base/slice.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace comm
+{
+/**
+ * Header of a SpaceWire packet carrying one fragment of a dataset.
+ *
+ * \code
+ * 0       target logical address
+ * 1       protocol identifier
+ * 2..3    dataset identifier
+ * 4..5    fragment index
+ * 6..7    number of fragments
+ * 8..11   total length of the dataset
+ * 12..15  position of the fragment in the dataset
+ * 16..    fragment data
+ * \endcode
+ *
+ * All fields are big endian. The position allows the receiver to store
+ * the data of a fragment at its final place independent of the order
+ * in which the fragments arrive.
+ */
+struct FragmentHeader
+{
+    static constexpr size_t size = 16;
+
+    FragmentHeader() :
+        mTargetLogicalAddress(0),
+        mProtocolId(0),
+        mDatasetId(0),
+        mIndex(0),
+        mNumberOfFragments(0),
+        mTotalLength(0),
+        mOffset(0)
+    {
+    }
+
+    /**
+     * Write the header into the first size bytes of \p buffer.
+     *
+     * \retval false  Buffer too short.
+     */
+    bool
+    write(outpost::Slice<uint8_t> buffer) const;
+
+    /**
+     * Read the header of a received fragment.
+     *
+     * \retval false  Packet shorter than the header, or the fields are
+     *                not consistent with each other or with the length
+     *                of the fragment data.
+     */
+    bool
+    read(outpost::Slice<const uint8_t> packet);
+
+    uint8_t mTargetLogicalAddress;
+    uint8_t mProtocolId;
+    uint16_t mDatasetId;
+    uint16_t mIndex;
+    uint16_t mNumberOfFragments;
+    uint32_t mTotalLength;
+    uint32_t mOffset;
+};
+
+}  // namespace comm
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "fragment_reassembler.h"
+
+#include <string.h>
+
+using outpost::comm::FragmentReassemblerBase;
+
+FragmentReassemblerBase::FragmentReassemblerBase(outpost::Slice<Dataset> datasets,
+                                                 outpost::Slice<uint32_t> bitmap,
+                                                 outpost::utils::SharedBufferPoolBase& pool,
+                                                 outpost::utils::SharedBufferQueueBase& output,
+                                                 const outpost::time::Clock& clock,
+                                                 outpost::time::Duration timeout) :
+    mDatasets(datasets),
+    mMaximumNumberOfFragments(
+            (datasets.getNumberOfElements() == 0)
+                    ? 0
+                    : (bitmap.getNumberOfElements() / datasets.getNumberOfElements()) * 32),
+    mPool(pool),
+    mOutput(output),
+    mClock(clock),
+    mTimeout(timeout),
+    mLock(),
+    mNumberOfCompletedDatasets(0),
+    mNumberOfDroppedDatasets(0),
+    mNumberOfDroppedFragments(0)
+{
+    const size_t words = mMaximumNumberOfFragments / 32;
+    for (size_t i = 0; i < mDatasets.getNumberOfElements(); ++i)
+    {
+        mDatasets[i].mReceived = bitmap.subSlice(i * words, words);
+    }
+}
+
+FragmentReassemblerBase::Result
+FragmentReassemblerBase::handleFragment(outpost::Slice<const uint8_t> packet)
+{
+    FragmentHeader header;
+    if (!header.read(packet) || (header.mNumberOfFragments > mMaximumNumberOfFragments))
+    {
+        outpost::rtos::MutexGuard lock(mLock);
+        mNumberOfDroppedFragments++;
+        return Result::invalid;
+    }
+
+    outpost::rtos::MutexGuard lock(mLock);
+    Result result = Result::incomplete;
+    Dataset* dataset = findDataset(header.mDatasetId);
+    if (dataset == nullptr)
+    {
+        dataset = startDataset(header, result);
+        if (dataset == nullptr)
+        {
+            mNumberOfDroppedFragments++;
+            return result;
+        }
+    }
+    else if ((dataset->mNumberOfFragments != header.mNumberOfFragments)
+             || (dataset->mTotalLength != header.mTotalLength))
+    {
+        mNumberOfDroppedFragments++;
+        return Result::invalid;
+    }
+
+    uint32_t& word = dataset->mReceived[header.mIndex / 32];
+    const uint32_t bit = 1UL << (header.mIndex % 32);
+    if (word & bit)
+    {
+        return Result::duplicate;
+    }
+
+    const outpost::Slice<const uint8_t> data = packet.skipFirst(FragmentHeader::size);
+    if (data.getNumberOfElements() > 0)
+    {
+        memcpy(&dataset->mBuffer[header.mOffset], &data[0], data.getNumberOfElements());
+    }
+    word |= bit;
+    dataset->mReceivedFragments++;
+    dataset->mLastFragment = mClock.now();
+
+    if (dataset->mReceivedFragments < dataset->mNumberOfFragments)
+    {
+        return Result::incomplete;
+    }
+
+    outpost::utils::SharedChildPointer child;
+    if (!dataset->mBuffer.getChild(child, dataset->mId, 0, dataset->mTotalLength)
+        || !mOutput.send(std::move(child)))
+    {
+        result = Result::outputFull;
+        mNumberOfDroppedDatasets++;
+    }
+    else
+    {
+        result = Result::complete;
+        mNumberOfCompletedDatasets++;
+    }
+    release(*dataset);
+    return result;
+}
+
+size_t
+FragmentReassemblerBase::cleanup()
+{
+    outpost::rtos::MutexGuard lock(mLock);
+    return cleanupExpired(mClock.now());
+}
+
+size_t
+FragmentReassemblerBase::getNumberOfActiveDatasets() const
+{
+    size_t active = 0;
+    for (const Dataset& dataset : mDatasets)
+    {
+        if (dataset.mActive)
+        {
+            active++;
+        }
+    }
+    return active;
+}
+
+FragmentReassemblerBase::Dataset*
+FragmentReassemblerBase::findDataset(uint16_t id)
+{
+    for (Dataset& dataset : mDatasets)
+    {
+        if (dataset.mActive && (dataset.mId == id))
+        {
+            return &dataset;
+        }
+    }
+    return nullptr;
+}
+
+FragmentReassemblerBase::Dataset*
+FragmentReassemblerBase::startDataset(const FragmentHeader& header, Result& result)
+{
+    Dataset* free = nullptr;
+    for (size_t pass = 0; (pass < 2) && (free == nullptr); ++pass)
+    {
+        if (pass == 1)
+        {
+            // Only look for expired datasets when every slot is in use
+            cleanupExpired(mClock.now());
+        }
+        for (Dataset& dataset : mDatasets)
+        {
+            if (!dataset.mActive)
+            {
+                free = &dataset;
+                break;
+            }
+        }
+    }
+    if (free == nullptr)
+    {
+        result = Result::noFreeDataset;
+        return nullptr;
+    }
+
+    if (!mPool.allocateForLength(free->mBuffer, header.mTotalLength)
+        || (free->mBuffer.getLength() < header.mTotalLength))
+    {
+        free->mBuffer = outpost::utils::SharedBufferPointer();
+        result = Result::noBuffer;
+        return nullptr;
+    }
+
+    for (uint32_t& word : free->mReceived)
+    {
+        word = 0;
+    }
+    free->mTotalLength = header.mTotalLength;
+    free->mId = header.mDatasetId;
+    free->mNumberOfFragments = header.mNumberOfFragments;
+    free->mReceivedFragments = 0;
+    free->mActive = true;
+    return free;
+}
+
+void
+FragmentReassemblerBase::release(Dataset& dataset)
+{
+    dataset.mBuffer = outpost::utils::SharedBufferPointer();
+    dataset.mActive = false;
+}
+
+size_t
+FragmentReassemblerBase::cleanupExpired(outpost::time::SpacecraftElapsedTime now)
+{
+    size_t discarded = 0;
+    for (Dataset& dataset : mDatasets)
+    {
+        if (dataset.mActive && ((now - dataset.mLastFragment) >= mTimeout))
+        {
+            release(dataset);
+            mNumberOfDroppedDatasets++;
+            discarded++;
+        }
+    }
+    return discarded;
+}
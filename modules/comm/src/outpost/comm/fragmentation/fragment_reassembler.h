@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMM_FRAGMENTATION_FRAGMENT_REASSEMBLER_H_
+#define OUTPOST_COMM_FRAGMENTATION_FRAGMENT_REASSEMBLER_H_
+
+#include "fragment_header.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/rtos.h>
+#include <outpost/time/clock.h>
+#include <outpost/time/duration.h>
+#include <outpost/utils/container/reference_queue.h>
+#include <outpost/utils/container/shared_buffer.h>
+#include <outpost/utils/container/shared_object_pool.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace comm
+{
+/**
+ * Reassemble the datasets sent by a FragmentSender.
+ *
+ * A buffer for the complete dataset is allocated from a pool with the
+ * first received fragment. The data of every fragment is copied once to
+ * its position in this buffer, the fragments may therefore arrive in any
+ * order. Received fragments are tracked in a bitmap, duplicates are
+ * ignored. When the last missing fragment arrives a child pointer with
+ * the length of the dataset is put into the output queue and the
+ * reassembler releases its reference to the buffer.
+ *
+ * The received packets are best taken from a zero-copy queue of the
+ * SpaceWireMultiProtocolHandler (pool nullptr), so that the fragment is
+ * copied only into the dataset buffer.
+ *
+ * A dataset which did not receive a fragment for the configured timeout
+ * is discarded by cleanup() and its buffer returned to the pool.
+ * cleanup() is also executed when a new dataset finds no free slot.
+ *
+ * \see FragmentReassembler
+ */
+class FragmentReassemblerBase
+{
+public:
+    enum class Result
+    {
+        /// Fragment stored, fragments of the dataset are still missing
+        incomplete,
+
+        /// Dataset is complete and was put into the output queue
+        complete,
+
+        /// Fragment was already received and is ignored
+        duplicate,
+
+        /// Header is invalid or does not match the earlier fragments
+        invalid,
+
+        /// All slots are in use by incomplete datasets
+        noFreeDataset,
+
+        /// No pool buffer large enough for the dataset
+        noBuffer,
+
+        /// Output queue was full, the dataset is dropped
+        outputFull
+    };
+
+    struct Dataset
+    {
+        Dataset() :
+            mBuffer(),
+            mReceived(outpost::Slice<uint32_t>::empty()),
+            mLastFragment(),
+            mTotalLength(0),
+            mId(0),
+            mNumberOfFragments(0),
+            mReceivedFragments(0),
+            mActive(false)
+        {
+        }
+
+        outpost::utils::SharedBufferPointer mBuffer;
+
+        /// One bit per fragment
+        outpost::Slice<uint32_t> mReceived;
+
+        outpost::time::SpacecraftElapsedTime mLastFragment;
+        uint32_t mTotalLength;
+        uint16_t mId;
+        uint16_t mNumberOfFragments;
+        uint16_t mReceivedFragments;
+        bool mActive;
+    };
+
+    /**
+     * \param datasets
+     *      Storage for the datasets reassembled at the same time.
+     * \param bitmap
+     *      Storage for the received fragments, split equally between
+     *      the datasets. 32 fragments per word.
+     * \param pool
+     *      Pool for the dataset buffers. With a size class pool the
+     *      buffer is chosen by the total length of the dataset.
+     * \param output
+     *      Receives the completed datasets.
+     * \param clock
+     *      Clock for the timeout of incomplete datasets.
+     * \param timeout
+     *      Time after the last received fragment after which an
+     *      incomplete dataset is discarded.
+     */
+    FragmentReassemblerBase(outpost::Slice<Dataset> datasets,
+                            outpost::Slice<uint32_t> bitmap,
+                            outpost::utils::SharedBufferPoolBase& pool,
+                            outpost::utils::SharedBufferQueueBase& output,
+                            const outpost::time::Clock& clock,
+                            outpost::time::Duration timeout);
+
+    // disable copy constructor
+    FragmentReassemblerBase(const FragmentReassemblerBase&) = delete;
+
+    // disable assignment operator
+    FragmentReassemblerBase&
+    operator=(const FragmentReassemblerBase&) = delete;
+
+    /**
+     * Store a received fragment.
+     *
+     * \param packet
+     *      Complete SpaceWire packet starting with the target logical
+     *      address. A SharedBufferPointer converts implicitly.
+     */
+    Result
+    handleFragment(outpost::Slice<const uint8_t> packet);
+
+    /**
+     * Discard the incomplete datasets whose last fragment is older than
+     * the timeout.
+     *
+     * \return  Number of discarded datasets.
+     */
+    size_t
+    cleanup();
+
+    /**
+     * Largest number of fragments of a dataset.
+     */
+    inline size_t
+    getMaximumNumberOfFragments() const
+    {
+        return mMaximumNumberOfFragments;
+    }
+
+    size_t
+    getNumberOfActiveDatasets() const;
+
+    inline uint32_t
+    getNumberOfCompletedDatasets() const
+    {
+        return mNumberOfCompletedDatasets;
+    }
+
+    /**
+     * Datasets discarded by a timeout, a full output queue or a missing
+     * buffer.
+     */
+    inline uint32_t
+    getNumberOfDroppedDatasets() const
+    {
+        return mNumberOfDroppedDatasets;
+    }
+
+    /**
+     * Fragments which were invalid or found no free slot or buffer.
+     */
+    inline uint32_t
+    getNumberOfDroppedFragments() const
+    {
+        return mNumberOfDroppedFragments;
+    }
+
+private:
+    Dataset*
+    findDataset(uint16_t id);
+
+    Dataset*
+    startDataset(const FragmentHeader& header, Result& result);
+
+    void
+    release(Dataset& dataset);
+
+    size_t
+    cleanupExpired(outpost::time::SpacecraftElapsedTime now);
+
+    const outpost::Slice<Dataset> mDatasets;
+    const size_t mMaximumNumberOfFragments;
+    outpost::utils::SharedBufferPoolBase& mPool;
+    outpost::utils::SharedBufferQueueBase& mOutput;
+    const outpost::time::Clock& mClock;
+    const outpost::time::Duration mTimeout;
+
+    outpost::rtos::Mutex mLock;
+    uint32_t mNumberOfCompletedDatasets;
+    uint32_t mNumberOfDroppedDatasets;
+    uint32_t mNumberOfDroppedFragments;
+};
+
+namespace internal
+{
+/**
+ * Memory of a FragmentReassembler.
+ *
+ * Base class of FragmentReassembler so that it is constructed before
+ * FragmentReassemblerBase refers to it.
+ */
+template <size_t numberOfDatasets, size_t maximumNumberOfFragments>
+class FragmentReassemblerStorage
+{
+protected:
+    static constexpr size_t wordsPerDataset = (maximumNumberOfFragments + 31) / 32;
+
+    FragmentReassemblerStorage() : mDatasetStorage(), mBitmapStorage()
+    {
+    }
+
+    FragmentReassemblerBase::Dataset mDatasetStorage[numberOfDatasets];
+    uint32_t mBitmapStorage[numberOfDatasets * wordsPerDataset];
+};
+}  // namespace internal
+
+/**
+ * Fragment reassembler with storage for \p numberOfDatasets datasets of
+ * up to \p maximumNumberOfFragments fragments each.
+ */
+template <size_t numberOfDatasets, size_t maximumNumberOfFragments>
+class FragmentReassembler
+    : private internal::FragmentReassemblerStorage<numberOfDatasets, maximumNumberOfFragments>,
+      public FragmentReassemblerBase
+{
+    static_assert(numberOfDatasets > 0, "At least one dataset required");
+    static_assert(maximumNumberOfFragments > 0, "At least one fragment required");
+    static_assert(maximumNumberOfFragments <= UINT16_MAX, "Fragment index is 16 bit");
+
+public:
+    FragmentReassembler(outpost::utils::SharedBufferPoolBase& pool,
+                        outpost::utils::SharedBufferQueueBase& output,
+                        const outpost::time::Clock& clock,
+                        outpost::time::Duration timeout) :
+        internal::FragmentReassemblerStorage<numberOfDatasets, maximumNumberOfFragments>(),
+        FragmentReassemblerBase(outpost::asSlice(this->mDatasetStorage),
+                                outpost::asSlice(this->mBitmapStorage),
+                                pool,
+                                output,
+                                clock,
+                                timeout)
+    {
+    }
+};
+
+}  // namespace comm
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "fragment_sender.h"
+
+using outpost::comm::FragmentSender;
+
+constexpr size_t FragmentSender::defaultMaximumPacketLength;
+
+FragmentSender::FragmentSender(outpost::hal::SpaceWireMultiProtocolHandlerInterface& spw,
+                               uint8_t targetLogicalAddress,
+                               uint8_t protocolId,
+                               size_t maximumPacketLength) :
+    mSpaceWire(spw),
+    mTargetLogicalAddress(targetLogicalAddress),
+    mProtocolId(protocolId),
+    mMaximumFragmentLength((maximumPacketLength > FragmentHeader::size)
+                                   ? (maximumPacketLength - FragmentHeader::size)
+                                   : 0),
+    mNextDatasetId(0)
+{
+}
+
+size_t
+FragmentSender::getNumberOfFragments(size_t length) const
+{
+    if ((mMaximumFragmentLength == 0) || (length == 0) || (length > UINT32_MAX))
+    {
+        return 0;
+    }
+
+    const size_t fragments = (length + mMaximumFragmentLength - 1) / mMaximumFragmentLength;
+    return (fragments > UINT16_MAX) ? 0 : fragments;
+}
+
+bool
+FragmentSender::send(const outpost::utils::SharedBufferPointer& dataset,
+                     outpost::time::Duration timeout)
+{
+    if (!dataset.isValid())
+    {
+        return false;
+    }
+
+    const outpost::Slice<const uint8_t> data = dataset.asSlice();
+    const size_t numberOfFragments = getNumberOfFragments(data.getNumberOfElements());
+    if (numberOfFragments == 0)
+    {
+        return false;
+    }
+
+    FragmentHeader header;
+    header.mTargetLogicalAddress = mTargetLogicalAddress;
+    header.mProtocolId = mProtocolId;
+    header.mDatasetId = mNextDatasetId++;
+    header.mNumberOfFragments = static_cast<uint16_t>(numberOfFragments);
+    header.mTotalLength = static_cast<uint32_t>(data.getNumberOfElements());
+
+    uint8_t headerBuffer[FragmentHeader::size];
+    for (size_t i = 0; i < numberOfFragments; ++i)
+    {
+        const size_t offset = i * mMaximumFragmentLength;
+        header.mIndex = static_cast<uint16_t>(i);
+        header.mOffset = static_cast<uint32_t>(offset);
+        header.write(outpost::asSlice(headerBuffer));
+
+        const outpost::Slice<const uint8_t> fragments[2] = {
+                outpost::asSlice(headerBuffer),
+                data.skipFirst(offset).first(mMaximumFragmentLength)};
+        if (!mSpaceWire.sendFragments(outpost::asSlice(fragments), timeout))
+        {
+            return false;
+        }
+    }
+    return true;
+}
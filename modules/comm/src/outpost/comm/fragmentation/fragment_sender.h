@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMM_FRAGMENTATION_FRAGMENT_SENDER_H_
+#define OUTPOST_COMM_FRAGMENTATION_FRAGMENT_SENDER_H_
+
+#include "fragment_header.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/hal/space_wire_multi_protocol_handler.h>
+#include <outpost/time/duration.h>
+#include <outpost/utils/container/shared_buffer.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace comm
+{
+/**
+ * Send datasets larger than a SpaceWire packet as a series of fragments.
+ *
+ * Every fragment is a packet with a FragmentHeader followed by a part of
+ * the dataset. The header and the part are handed to
+ * SpaceWireMultiProtocolHandlerInterface::sendFragments() as two
+ * slices, the dataset is not copied into an intermediate buffer. The
+ * SharedBufferPointer keeps the dataset allocated until the last
+ * fragment is sent.
+ *
+ * The fragments are reassembled by a FragmentReassembler registered for
+ * the same protocol identifier at the target.
+ *
+ * A sender must not be used by several threads at the same time.
+ */
+class FragmentSender
+{
+public:
+    /// Default of SpaceWireMultiProtocolHandler
+    static constexpr size_t defaultMaximumPacketLength = 4500;
+
+    /**
+     * \param spw
+     *      SpaceWire interface used to send the fragments.
+     * \param targetLogicalAddress
+     *      Logical address of the receiver.
+     * \param protocolId
+     *      Protocol identifier the receiver dispatches on.
+     * \param maximumPacketLength
+     *      Length of the largest packet including the header, must
+     *      be larger than FragmentHeader::size.
+     */
+    FragmentSender(outpost::hal::SpaceWireMultiProtocolHandlerInterface& spw,
+                   uint8_t targetLogicalAddress,
+                   uint8_t protocolId,
+                   size_t maximumPacketLength = defaultMaximumPacketLength);
+
+    // disable copy constructor
+    FragmentSender(const FragmentSender&) = delete;
+
+    // disable assignment operator
+    FragmentSender&
+    operator=(const FragmentSender&) = delete;
+
+    /**
+     * Send the data referenced by \p dataset.
+     *
+     * The fragments are sent in order, every fragment may wait up to
+     * \p timeout for a transmit buffer. The sending stops at the first
+     * fragment which could not be sent.
+     *
+     * \retval false  Dataset is invalid or empty, has more fragments
+     *                than the header can describe, or a fragment could
+     *                not be sent.
+     */
+    bool
+    send(const outpost::utils::SharedBufferPointer& dataset,
+         outpost::time::Duration timeout = outpost::time::Duration::maximum());
+
+    /**
+     * Number of data bytes carried by one fragment.
+     */
+    inline size_t
+    getMaximumFragmentLength() const
+    {
+        return mMaximumFragmentLength;
+    }
+
+    /**
+     * Number of fragments needed for a dataset of \p length bytes, zero
+     * if it cannot be sent.
+     */
+    size_t
+    getNumberOfFragments(size_t length) const;
+
+    /**
+     * Identifier used for the next dataset.
+     */
+    inline uint16_t
+    getNextDatasetId() const
+    {
+        return mNextDatasetId;
+    }
+
+private:
+    outpost::hal::SpaceWireMultiProtocolHandlerInterface& mSpaceWire;
+    const uint8_t mTargetLogicalAddress;
+    const uint8_t mProtocolId;
+    const size_t mMaximumFragmentLength;
+    uint16_t mNextDatasetId;
+};
+
+}  // namespace comm
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "space_wire_remote_encoder.h"
+
+#include <outpost/base/fixpoint.h>
+#include <outpost/utils/storage/bitfield.h>
+#include <outpost/utils/storage/serialize.h>
+
+using outpost::comm::SpaceWireRemoteEncoderBase;
+using outpost::compression::CompressionScheme;
+using outpost::compression::DataBlock;
+
+constexpr size_t SpaceWireRemoteEncoderBase::defaultMaximumPacketLength;
+constexpr size_t SpaceWireRemoteEncoderBase::requestHeaderSize;
+constexpr size_t SpaceWireRemoteEncoderBase::responseHeaderSize;
+
+SpaceWireRemoteEncoderBase::SpaceWireRemoteEncoderBase(
+        outpost::Slice<Transaction> transactions,
+        outpost::hal::SpaceWireMultiProtocolHandlerInterface& spw,
+        outpost::utils::SharedBufferQueueBase& responses,
+        const outpost::time::Clock& clock,
+        uint8_t targetLogicalAddress,
+        uint8_t protocolId,
+        outpost::time::Duration responseTimeout,
+        outpost::time::Duration retryInterval,
+        size_t maximumPacketLength) :
+    mTransactions(transactions),
+    mSpaceWire(spw),
+    mResponses(responses),
+    mClock(clock),
+    mTargetLogicalAddress(targetLogicalAddress),
+    mProtocolId(protocolId),
+    mResponseTimeout(responseTimeout),
+    mRetryInterval(retryInterval),
+    mMaximumPacketLength(maximumPacketLength),
+    mDownUntil(outpost::time::SpacecraftElapsedTime::startOfEpoch()),
+    mNumberOfPendingBlocks(0),
+    mNextTransactionId(0),
+    mNumberOfTimeouts(0),
+    mNumberOfRejectedBlocks(0),
+    mNumberOfDiscardedResponses(0)
+{
+}
+
+bool
+SpaceWireRemoteEncoderBase::isAvailable() const
+{
+    return mClock.now() >= mDownUntil;
+}
+
+size_t
+SpaceWireRemoteEncoderBase::getNumberOfPendingBlocks() const
+{
+    return mNumberOfPendingBlocks;
+}
+
+bool
+SpaceWireRemoteEncoderBase::submit(const DataBlock& block, CompressionScheme scheme)
+{
+    if (!isAvailable() || (mNumberOfPendingBlocks >= mTransactions.getNumberOfElements())
+        || !block.isComplete() || block.isTransformed() || block.isEncoded())
+    {
+        return false;
+    }
+
+    const outpost::Slice<outpost::Fixpoint> samples = block.getSamples();
+    const size_t length = requestHeaderSize + samples.getNumberOfElements() * sizeof(int32_t);
+    if ((length > mMaximumPacketLength) || (findTransaction(mNextTransactionId) != nullptr))
+    {
+        // Too large, or the identifier is still in use after a wrap-around
+        return false;
+    }
+
+    Transaction* transaction = nullptr;
+    for (size_t i = 0; (transaction == nullptr) && (i < mTransactions.getNumberOfElements()); ++i)
+    {
+        if (!mTransactions[i].mPending)
+        {
+            transaction = &mTransactions[i];
+        }
+    }
+
+    outpost::hal::SpaceWire::TransmitBuffer* buffer = nullptr;
+    outpost::Slice<uint8_t> packet = outpost::Slice<uint8_t>::empty();
+    if (!mSpaceWire.reserve(buffer, packet, outpost::time::Duration::zero()))
+    {
+        markDown(mClock.now());
+        return false;
+    }
+    if (packet.getNumberOfElements() < length)
+    {
+        mSpaceWire.abort(buffer, outpost::time::Duration::zero());
+        return false;
+    }
+
+    outpost::Serialize stream(packet);
+    stream.store<uint8_t>(mTargetLogicalAddress);
+    stream.store<uint8_t>(mProtocolId);
+    stream.store<uint8_t>(static_cast<uint8_t>(PacketType::request));
+    stream.store<uint16_t>(mNextTransactionId);
+    stream.store<uint8_t>(static_cast<uint8_t>(scheme));
+    stream.store<uint16_t>(block.getParameterId());
+    stream.store<uint64_t>(block.getStartTime().timeSinceEpoch().milliseconds());
+    uint8_t* pos = stream.getPointerToCurrentPosition();
+    outpost::Bitfield::write<0, 3>(pos, static_cast<uint8_t>(block.getSamplingRate()));
+    outpost::Bitfield::write<4, 7>(pos, static_cast<uint8_t>(block.getBlocksize()));
+    stream.skip(1U);
+    for (size_t i = 0; i < samples.getNumberOfElements(); ++i)
+    {
+        stream.store<int32_t>(samples[i].getValue());
+    }
+
+    if (!mSpaceWire.commit(buffer, length, outpost::time::Duration::zero()))
+    {
+        markDown(mClock.now());
+        return false;
+    }
+
+    transaction->mBlock = block;
+    transaction->mDeadline = mClock.now() + mResponseTimeout;
+    transaction->mId = mNextTransactionId++;
+    transaction->mPending = true;
+    ++mNumberOfPendingBlocks;
+    return true;
+}
+
+bool
+SpaceWireRemoteEncoderBase::receive(DataBlock& block, outpost::time::Duration timeout)
+{
+    const outpost::time::SpacecraftElapsedTime now = mClock.now();
+    for (size_t i = 0; i < mTransactions.getNumberOfElements(); ++i)
+    {
+        Transaction& transaction = mTransactions[i];
+        if (transaction.mPending && (now >= transaction.mDeadline))
+        {
+            ++mNumberOfTimeouts;
+            markDown(now);
+            finish(transaction, block);
+            return true;
+        }
+    }
+
+    outpost::utils::SharedBufferPointer packet;
+    while (mResponses.receive(packet, timeout))
+    {
+        if (handleResponse(packet, block))
+        {
+            return true;
+        }
+        // Only wait for the first packet
+        timeout = outpost::time::Duration::zero();
+    }
+    return false;
+}
+
+bool
+SpaceWireRemoteEncoderBase::handleResponse(const outpost::utils::SharedBufferPointer& packet,
+                                           DataBlock& block)
+{
+    const outpost::Slice<const uint8_t> data = packet.asSlice();
+    if ((data.getNumberOfElements() < responseHeaderSize) || (data[1] != mProtocolId))
+    {
+        ++mNumberOfDiscardedResponses;
+        return false;
+    }
+
+    outpost::Deserialize stream(data);
+    stream.skip<uint16_t>();
+    const uint8_t type = stream.read<uint8_t>();
+    Transaction* transaction = findTransaction(stream.read<uint16_t>());
+    if ((transaction == nullptr)
+        || ((type != static_cast<uint8_t>(PacketType::encoded))
+            && (type != static_cast<uint8_t>(PacketType::rejected))))
+    {
+        ++mNumberOfDiscardedResponses;
+        return false;
+    }
+
+    outpost::utils::SharedChildPointer child;
+    const size_t length = data.getNumberOfElements() - responseHeaderSize;
+    if ((type == static_cast<uint8_t>(PacketType::encoded))
+        && packet.getChild(child, 0, responseHeaderSize, length)
+        && DataBlock::fromEncodedData(child, length, block))
+    {
+        transaction->mBlock = DataBlock();
+        transaction->mPending = false;
+        --mNumberOfPendingBlocks;
+    }
+    else
+    {
+        ++mNumberOfRejectedBlocks;
+        finish(*transaction, block);
+    }
+    return true;
+}
+
+SpaceWireRemoteEncoderBase::Transaction*
+SpaceWireRemoteEncoderBase::findTransaction(uint16_t id)
+{
+    for (size_t i = 0; i < mTransactions.getNumberOfElements(); ++i)
+    {
+        if (mTransactions[i].mPending && (mTransactions[i].mId == id))
+        {
+            return &mTransactions[i];
+        }
+    }
+    return nullptr;
+}
+
+void
+SpaceWireRemoteEncoderBase::finish(Transaction& transaction, DataBlock& block)
+{
+    block = transaction.mBlock;
+    transaction.mBlock = DataBlock();
+    transaction.mPending = false;
+    --mNumberOfPendingBlocks;
+}
+
+void
+SpaceWireRemoteEncoderBase::markDown(outpost::time::SpacecraftElapsedTime now)
+{
+    mDownUntil = now + mRetryInterval;
+}
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMM_OFFLOAD_SPACE_WIRE_REMOTE_ENCODER_H_
+#define OUTPOST_COMM_OFFLOAD_SPACE_WIRE_REMOTE_ENCODER_H_
+
+#include <outpost/base/slice.h>
+#include <outpost/compression/data_block.h>
+#include <outpost/compression/remote_encoder.h>
+#include <outpost/hal/space_wire_multi_protocol_handler.h>
+#include <outpost/time/clock.h>
+#include <outpost/time/duration.h>
+#include <outpost/utils/container/reference_queue.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace comm
+{
+/**
+ * Compression service on a co-processor node reached over SpaceWire.
+ *
+ * Every submitted DataBlock is sent as a single request packet:
+ *
+ *     | Logical Address | Protocol Id | Type (0) | Transaction Id (16 bit) |
+ *     | Scheme | Parameter Id (16 bit) | Start time, ms (64 bit) |
+ *     | Sampling rate (bits 0-3), Blocksize (bits 4-7) |
+ *     | Raw fixpoint samples (32 bit each) ... |
+ *
+ * The remote answers every request with a response packet:
+ *
+ *     | Logical Address | Protocol Id | Type (1 or 2) | Transaction Id |
+ *     | Encoded block as written by DataBlock::encode() ... |
+ *
+ * Type 1 carries the encoded block, type 2 without data rejects the
+ * request. All values are big endian.
+ *
+ * Up to the number of transactions given by the storage are in flight at
+ * the same time. The raw block stays referenced until its response has
+ * been received, so that it can be returned unencoded when the request is
+ * rejected or not answered within the response timeout. After a timeout
+ * or a failed request the remote is considered down and no further
+ * requests are sent for the retry interval.
+ *
+ * The responses are taken from a queue registered for the protocol
+ * identifier at the SpaceWireMultiProtocolHandler, preferably a zero-copy
+ * queue (pool nullptr), in which case the encoded block keeps the
+ * received buffer.
+ *
+ * A remote encoder must not be used by several threads at the same time.
+ *
+ * \see SpaceWireRemoteEncoder
+ */
+class SpaceWireRemoteEncoderBase : public outpost::compression::RemoteEncoder
+{
+public:
+    enum class PacketType : uint8_t
+    {
+        request = 0,
+        encoded = 1,
+        rejected = 2
+    };
+
+    /// Default of SpaceWireMultiProtocolHandler
+    static constexpr size_t defaultMaximumPacketLength = 4500;
+
+    /// Bytes of a request before the samples
+    static constexpr size_t requestHeaderSize = 17;
+
+    /// Bytes of a response before the encoded block
+    static constexpr size_t responseHeaderSize = 5;
+
+    struct Transaction
+    {
+        Transaction() : mBlock(), mDeadline(), mId(0), mPending(false)
+        {
+        }
+
+        /// Raw block, returned if the remote fails
+        outpost::compression::DataBlock mBlock;
+        outpost::time::SpacecraftElapsedTime mDeadline;
+        uint16_t mId;
+        bool mPending;
+    };
+
+    /**
+     * \param transactions
+     *      Storage for the requests in flight at the same time.
+     * \param spw
+     *      SpaceWire interface used to send the requests.
+     * \param responses
+     *      Queue receiving the response packets of \p protocolId.
+     * \param clock
+     *      Clock for the response timeout.
+     * \param targetLogicalAddress
+     *      Logical address of the compression service.
+     * \param protocolId
+     *      Protocol identifier of requests and responses.
+     * \param responseTimeout
+     *      Time after a request after which its raw block is returned.
+     * \param retryInterval
+     *      Time the remote is considered down after a failure.
+     * \param maximumPacketLength
+     *      Length of the largest request, blocks with more samples are
+     *      not submitted.
+     */
+    SpaceWireRemoteEncoderBase(outpost::Slice<Transaction> transactions,
+                               outpost::hal::SpaceWireMultiProtocolHandlerInterface& spw,
+                               outpost::utils::SharedBufferQueueBase& responses,
+                               const outpost::time::Clock& clock,
+                               uint8_t targetLogicalAddress,
+                               uint8_t protocolId,
+                               outpost::time::Duration responseTimeout,
+                               outpost::time::Duration retryInterval,
+                               size_t maximumPacketLength = defaultMaximumPacketLength);
+
+    // disable copy constructor
+    SpaceWireRemoteEncoderBase(const SpaceWireRemoteEncoderBase&) = delete;
+
+    // disable assignment operator
+    SpaceWireRemoteEncoderBase&
+    operator=(const SpaceWireRemoteEncoderBase&) = delete;
+
+    /**
+     * Send a request for \p block.
+     *
+     * \retval false  The remote is down, all transactions are in flight,
+     *                the block is not a complete raw block or does not
+     *                fit into a transmit buffer, or the request could
+     *                not be sent.
+     */
+    bool
+    submit(const outpost::compression::DataBlock& block,
+           outpost::compression::CompressionScheme scheme) override;
+
+    /**
+     * Take the next finished transaction.
+     *
+     * Expired transactions are returned first with their raw block,
+     * otherwise waits up to \p timeout for a response. Responses to
+     * unknown transactions, e.g. after their timeout, are discarded.
+     */
+    bool
+    receive(outpost::compression::DataBlock& block, outpost::time::Duration timeout) override;
+
+    size_t
+    getNumberOfPendingBlocks() const override;
+
+    /**
+     * Whether requests are sent, i.e. the retry interval after the last
+     * failure has passed.
+     */
+    bool
+    isAvailable() const;
+
+    /**
+     * Number of requests which were not answered in time.
+     */
+    inline uint32_t
+    getNumberOfTimeouts() const
+    {
+        return mNumberOfTimeouts;
+    }
+
+    /**
+     * Number of requests rejected by the remote or answered with an
+     * invalid block.
+     */
+    inline uint32_t
+    getNumberOfRejectedBlocks() const
+    {
+        return mNumberOfRejectedBlocks;
+    }
+
+    /**
+     * Number of discarded response packets.
+     */
+    inline uint32_t
+    getNumberOfDiscardedResponses() const
+    {
+        return mNumberOfDiscardedResponses;
+    }
+
+private:
+    Transaction*
+    findTransaction(uint16_t id);
+
+    /**
+     * Hand the raw block of a finished transaction back and free it.
+     */
+    void
+    finish(Transaction& transaction, outpost::compression::DataBlock& block);
+
+    /**
+     * Handle a response packet.
+     *
+     * \retval true  \p block has been set.
+     */
+    bool
+    handleResponse(const outpost::utils::SharedBufferPointer& packet,
+                   outpost::compression::DataBlock& block);
+
+    void
+    markDown(outpost::time::SpacecraftElapsedTime now);
+
+    const outpost::Slice<Transaction> mTransactions;
+    outpost::hal::SpaceWireMultiProtocolHandlerInterface& mSpaceWire;
+    outpost::utils::SharedBufferQueueBase& mResponses;
+    const outpost::time::Clock& mClock;
+    const uint8_t mTargetLogicalAddress;
+    const uint8_t mProtocolId;
+    const outpost::time::Duration mResponseTimeout;
+    const outpost::time::Duration mRetryInterval;
+    const size_t mMaximumPacketLength;
+
+    outpost::time::SpacecraftElapsedTime mDownUntil;
+    size_t mNumberOfPendingBlocks;
+    uint16_t mNextTransactionId;
+    uint32_t mNumberOfTimeouts;
+    uint32_t mNumberOfRejectedBlocks;
+    uint32_t mNumberOfDiscardedResponses;
+};
+
+namespace internal
+{
+/**
+ * Memory of a SpaceWireRemoteEncoder.
+ *
+ * Base class of SpaceWireRemoteEncoder so that it is constructed before
+ * SpaceWireRemoteEncoderBase refers to it.
+ */
+template <size_t numberOfTransactions>
+class SpaceWireRemoteEncoderStorage
+{
+protected:
+    SpaceWireRemoteEncoderStorage() : mTransactionStorage()
+    {
+    }
+
+    SpaceWireRemoteEncoderBase::Transaction mTransactionStorage[numberOfTransactions];
+};
+}  // namespace internal
+
+/**
+ * Remote encoder with up to \p numberOfTransactions requests in flight.
+ */
+template <size_t numberOfTransactions>
+class SpaceWireRemoteEncoder
+    : private internal::SpaceWireRemoteEncoderStorage<numberOfTransactions>,
+      public SpaceWireRemoteEncoderBase
+{
+    static_assert(numberOfTransactions > 0, "At least one transaction required");
+
+public:
+    SpaceWireRemoteEncoder(outpost::hal::SpaceWireMultiProtocolHandlerInterface& spw,
+                           outpost::utils::SharedBufferQueueBase& responses,
+                           const outpost::time::Clock& clock,
+                           uint8_t targetLogicalAddress,
+                           uint8_t protocolId,
+                           outpost::time::Duration responseTimeout,
+                           outpost::time::Duration retryInterval,
+                           size_t maximumPacketLength = defaultMaximumPacketLength) :
+        internal::SpaceWireRemoteEncoderStorage<numberOfTransactions>(),
+        SpaceWireRemoteEncoderBase(outpost::asSlice(this->mTransactionStorage),
+                                   spw,
+                                   responses,
+                                   clock,
+                                   targetLogicalAddress,
+                                   protocolId,
+                                   responseTimeout,
+                                   retryInterval,
+                                   maximumPacketLength)
+    {
+    }
+};
+
+}  // namespace comm
+}  // namespace outpost
+
+#endif
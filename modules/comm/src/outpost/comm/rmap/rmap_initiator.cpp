@@ -17,57 +17,85 @@
 
 #include "rmap_common.h"
 
+#include <outpost/utils/log/log.h>
+#include <outpost/utils/trace/trace.h>
+
 using namespace outpost::comm;
 
-constexpr outpost::time::Duration RmapInitiator::receiveTimeout;
-constexpr outpost::time::Duration RmapInitiator::startUpWaitInterval;
+namespace
+{
+/// Part of \p timeout left after \p elapsed, an infinite timeout stays infinite
+outpost::time::Duration
+getRemainingTime(outpost::time::Duration timeout, outpost::time::Duration elapsed)
+{
+    if (timeout == outpost::time::Duration::infinity())
+    {
+        return timeout;
+    }
+    return (elapsed < timeout) ? (timeout - elapsed) : outpost::time::Duration::zero();
+}
+}  // namespace
+
+constexpr outpost::time::Duration RmapInitiatorBase::receiveTimeout;
+constexpr outpost::rtos::EventGroup::Bits RmapInitiatorBase::packetReceivedEvent;
+constexpr outpost::rtos::EventGroup::Bits RmapInitiatorBase::stopEvent;
+constexpr outpost::time::Duration RmapInitiatorBase::startUpWaitInterval;
+
+RmapInitiatorBase::TransactionsList::TransactionsList(
+        outpost::Slice<RmapTransaction> const& transactions,
+        outpost::Slice<uint8_t> const& freeTransactions,
+        outpost::Slice<uint16_t> const& generations) :
+    mTransactions(transactions),
+    mFreeTransactions(freeTransactions),
+    mNumberOfFreeTransactions(transactions.getNumberOfElements()),
+    mGenerations(generations),
+    mNumberOfGenerations(rmap::maxTransactionIds / transactions.getNumberOfElements())
+{
+    for (uint8_t i = 0; i < mNumberOfFreeTransactions; i++)
+    {
+        // Lowest index on top of the stack
+        mFreeTransactions[i] = mNumberOfFreeTransactions - 1 - i;
+        mGenerations[i] = 0;
+    }
+}
 
 uint8_t
-RmapInitiator::TransactionsList::getNumberOfActiveTransactions()
+RmapInitiatorBase::TransactionsList::getNumberOfActiveTransactions()
 {
-    uint8_t active = 0;
+    return mTransactions.getNumberOfElements() - mNumberOfFreeTransactions;
+}
 
-    for (uint8_t i = 0; i < rmap::maxConcurrentTransactions; i++)
+void
+RmapInitiatorBase::TransactionsList::removeTransaction(uint16_t tid)
+{
+    RmapTransaction* transaction = getTransaction(tid);
+    if (transaction != nullptr)
     {
-        if (mTransactions[i].getState() != RmapTransaction::State::notInitiated)
-        {
-            active++;
-        }
+        removeTransaction(transaction);
     }
-    return active;
 }
 
 void
-RmapInitiator::TransactionsList::removeTransaction(uint16_t tid)
+RmapInitiatorBase::TransactionsList::removeTransaction(RmapTransaction* transaction)
 {
-    for (uint8_t i = 0; i < rmap::maxConcurrentTransactions; i++)
+    if (transaction->getState() != RmapTransaction::State::notInitiated)
     {
-        if (mTransactions[i].getTransactionID() == tid)
-        {
-            mTransactions[i].reset();
-            break;
-        }
+        transaction->reset();
+        mFreeTransactions[mNumberOfFreeTransactions] =
+                static_cast<uint8_t>(transaction - &mTransactions[0]);
+        mNumberOfFreeTransactions++;
     }
 }
 
 RmapTransaction*
-RmapInitiator::TransactionsList::getTransaction(uint16_t tid)
+RmapInitiatorBase::TransactionsList::getTransaction(uint16_t tid)
 {
-    bool found = false;
-    uint8_t i;
-
-    for (i = 0; i < rmap::maxConcurrentTransactions; i++)
-    {
-        if (mTransactions[i].getTransactionID() == tid)
-        {
-            found = true;
-            break;
-        }
-    }
-
-    if (found)
+    // The index of the transaction is part of the ID
+    RmapTransaction& transaction = mTransactions[tid % mTransactions.getNumberOfElements()];
+    if ((transaction.getState() != RmapTransaction::State::notInitiated)
+        && (transaction.getTransactionID() == tid))
     {
-        return &mTransactions[i];
+        return &transaction;
     }
     else
     {
@@ -76,65 +104,70 @@ RmapInitiator::TransactionsList::getTransaction(uint16_t tid)
 }
 
 bool
-RmapInitiator::TransactionsList::isTransactionIdUsed(uint16_t tid)
+RmapInitiatorBase::TransactionsList::isTransactionIdUsed(uint16_t tid)
 {
-    bool used = false;
-
-    for (uint8_t i = 0; i < rmap::maxConcurrentTransactions; i++)
-    {
-        if (mTransactions[i].getTransactionID() == tid)
-        {
-            used = true;
-            break;
-        }
-    }
-
-    return used;
+    return getTransaction(tid) != nullptr;
 }
 
 RmapTransaction*
-RmapInitiator::TransactionsList::getFreeTransaction()
+RmapInitiatorBase::TransactionsList::getFreeTransaction()
 {
-    for (uint8_t i = 0; i < rmap::maxConcurrentTransactions; i++)
+    if (mNumberOfFreeTransactions == 0)
     {
-        if (mTransactions[i].getState() == RmapTransaction::State::notInitiated)
-        {
-            mTransactions[i].setState(RmapTransaction::State::reserved);
-            return &mTransactions[i];
-        }
+        return nullptr;
     }
-    return nullptr;
+
+    mNumberOfFreeTransactions--;
+    uint8_t index = mFreeTransactions[mNumberOfFreeTransactions];
+
+    // A new generation for every use, late replies to an earlier use do not match
+    uint16_t generation = mGenerations[index];
+    mGenerations[index] = (generation + 1) % mNumberOfGenerations;
+
+    RmapTransaction* transaction = &mTransactions[index];
+    transaction->setState(RmapTransaction::State::reserved);
+    transaction->setTransactionID(generation * mTransactions.getNumberOfElements() + index);
+    return transaction;
 }
 
 //-----------------------------------------------------------------------------
-RmapInitiator::RmapInitiator(hal::SpaceWireMultiProtocolHandlerInterface& spw,
-                             RmapTargetsList* list,
-                             uint8_t priority,
-                             size_t stackSize,
-                             outpost::support::parameter::HeartbeatSource heartbeatSource,
-                             uint8_t initiatorLogicalAddress) :
+RmapInitiatorBase::RmapInitiatorBase(hal::SpaceWireMultiProtocolHandlerInterface& spw,
+                                     RmapTargetsList* list,
+                                     uint8_t priority,
+                                     size_t stackSize,
+                                     outpost::support::parameter::HeartbeatSource heartbeatSource,
+                                     uint8_t initiatorLogicalAddress,
+                                     const Storage& storage) :
     outpost::rtos::Thread(priority, stackSize, "RMEN"),
     mSpW(spw),
     mTargetNodes(list),
     mOperationLock(),
     mInitiatorLogicalAddress(initiatorLogicalAddress),
     mStopped(true),
-    mTransactionId(0),
-    mTransactionsList(),
+    mTransactionsList(storage.mTransactions, storage.mFreeTransactions, storage.mGenerations),
+    mMaximumDataLength(storage.mMaximumDataLength),
     mCounters(),
-    mHeartbeatSource(heartbeatSource)
+    mPeakActiveTransactions(0),
+    mClock(),
+    mHeartbeat(heartbeatSource),
+    mQueue(storage.mQueue),
+    mPool(storage.mPool),
+    mEvents(),
+    mEventNotification(false)
 {
+    mEventNotification = mQueue.setEventNotification(&mEvents, packetReceivedEvent);
 }
 
-RmapInitiator::~RmapInitiator()
+RmapInitiatorBase::~RmapInitiatorBase()
 {
+    mQueue.setEventNotification(nullptr, 0);
 }
 
 /**
  * Starts the internal thread and waits till the listeners are set up
  */
 void
-RmapInitiator::init(void)
+RmapInitiatorBase::init(void)
 {
     // setup the receive part
     mSpW.addQueue(rmap::protocolIdentifier, &mPool, &mQueue, true);
@@ -143,12 +176,12 @@ RmapInitiator::init(void)
 }
 
 RmapResult
-RmapInitiator::write(const char* targetNodeName,
-                     const RMapOptions& options,
-                     uint32_t memoryAddress,
-                     uint8_t extendedMemoryAdress,
-                     outpost::Slice<const uint8_t> const& data,
-                     const outpost::time::Duration& timeout)
+RmapInitiatorBase::write(const char* targetNodeName,
+                         const RMapOptions& options,
+                         uint32_t memoryAddress,
+                         uint8_t extendedMemoryAdress,
+                         outpost::Slice<const uint8_t> const& data,
+                         const outpost::time::Duration& timeout)
 {
     RmapResult result;
     result.mResult = RmapResult::Code::invalidParameters;
@@ -169,12 +202,12 @@ RmapInitiator::write(const char* targetNodeName,
 }
 
 RmapResult
-RmapInitiator::write(RmapTargetNode& rmapTargetNode,
-                     const RMapOptions& options,
-                     uint32_t memoryAddress,
-                     uint8_t extendedMemoryAdress,
-                     outpost::Slice<const uint8_t> const& data,
-                     const outpost::time::Duration& timeout)
+RmapInitiatorBase::write(RmapTargetNode& rmapTargetNode,
+                         const RMapOptions& options,
+                         uint32_t memoryAddress,
+                         uint8_t extendedMemoryAdress,
+                         outpost::Slice<const uint8_t> const& data,
+                         const outpost::time::Duration& timeout)
 {
     RmapResult result;
     if (data.getNumberOfElements() == 0)
@@ -184,38 +217,58 @@ RmapInitiator::write(RmapTargetNode& rmapTargetNode,
         return result;
     }
 
-    RmapTransaction* transaction = nullptr;
-
-    bool sendSuccesful = false;
-    // mutex guarded scope to guard the transaction setup
+    if (data.getNumberOfElements() > mMaximumDataLength)
     {
-        // Guard operation against concurrent accesses
-        outpost::rtos::MutexGuard lock(mOperationLock);
-
-        // Using existing free element from the transaction list
-        transaction = mTransactionsList.getFreeTransaction();
-
-        if (transaction == nullptr)
-        {
-            result.mResult = RmapResult::Code::noFreeTransactions;
-            return result;
-        }
+        return transferChunks(rmapTargetNode,
+                              options,
+                              memoryAddress,
+                              extendedMemoryAdress,
+                              outpost::Slice<uint8_t>::empty(),
+                              data,
+                              timeout);
+    }
 
-        // id must also be under mutex
-        uint16_t transactionID = getNextAvailableTransactionID();
-        transaction->setTransactionID(transactionID);
-    }  // MutexGuard scope
+    // Retries share the timeout of the caller
+    const RmapAdaptiveTimeout& adaptiveTimeout = rmapTargetNode.getAdaptiveTimeout();
+    const outpost::time::SpacecraftElapsedTime start = mClock.now();
+    outpost::time::Duration remaining = timeout;
+    uint8_t attempt = 0;
+    do
+    {
+        result = writeOnce(rmapTargetNode,
+                           options,
+                           memoryAddress,
+                           extendedMemoryAdress,
+                           data,
+                           adaptiveTimeout.getTimeout(
+                                   rmapTargetNode.getStatistics(), attempt, remaining));
+        attempt++;
+        remaining = getRemainingTime(timeout, mClock.now() - start);
+    } while ((result.getResult() == RmapResult::Code::timeout) && adaptiveTimeout.mEnabled
+             && (attempt <= adaptiveTimeout.mRetries)
+             && (remaining > outpost::time::Duration::zero()));
 
-    RmapPacket* cmd = transaction->getCommandPacket();
+    return result;
+}
 
-    // Packet configuration
-    cmd->setInitiatorLogicalAddress(mInitiatorLogicalAddress);
-    cmd->setWrite();
-    cmd->setCommand();
+RmapResult
+RmapInitiatorBase::writeOnce(RmapTargetNode& rmapTargetNode,
+                             const RMapOptions& options,
+                             uint32_t memoryAddress,
+                             uint8_t extendedMemoryAdress,
+                             outpost::Slice<const uint8_t> const& data,
+                             const outpost::time::Duration& timeout)
+{
+    RmapResult result;
+    RmapTransaction* transaction = reserveTransaction();
+    if (transaction == nullptr)
+    {
+        result.mResult = RmapResult::Code::noFreeTransactions;
+        return result;
+    }
 
-    cmd->setIncrementFlag(options.mIncrementMode);
-    cmd->setVerifyFlag(options.mVerifyMode);
-    cmd->setReplyFlag(options.mReplyMode);
+    prepareWriteCommand(
+            transaction, rmapTargetNode, options, memoryAddress, extendedMemoryAdress, data);
 
     if (options.mReplyMode)
     {
@@ -230,14 +283,10 @@ RmapInitiator::write(RmapTargetNode& rmapTargetNode,
         // UnSets the transaction mode
         transaction->setBlockingMode(false);
     }
-    cmd->setExtendedAddress(extendedMemoryAdress);
-    cmd->setAddress(memoryAddress);
-    cmd->setData(data);  // also set data length and crc
-    cmd->setTargetInformation(rmapTargetNode);
     transaction->setTimeoutDuration(timeout);
 
     // Transaction will be initiated and sent through the SpW interface
-    sendSuccesful = sendPacket(transaction);
+    bool sendSuccesful = sendPacket(transaction);
 
     if (sendSuccesful)
     {
@@ -252,35 +301,17 @@ RmapInitiator::write(RmapTargetNode& rmapTargetNode,
             // Command sent but no reply
             if (state == RmapTransaction::State::reserved)
             {
-                console_out("RMAP-Initiator: command sent but no reply received for the "
+                OUTPOST_LOG("RMAP-Initiator: command sent but no reply received for the "
                             "transaction %u\n",
                             transaction->getTransactionID());
 
                 result.mResult = RmapResult::Code::timeout;
+                recordTimeout(transaction);
             }
             // Command sent and reply received
             else if (state == RmapTransaction::State::replyReceived)
             {
-                RmapPacket* rply = transaction->getReplyPacket();
-
-                result.mErrorCode =
-                        static_cast<RmapReplyStatus::ErrorStatusCodes>(rply->getStatus());
-                if (rply->getStatus() == RmapReplyStatus::commandExecutedSuccessfully)
-                {
-                    console_out("RMAP-Initiator: reply received with success\n");
-
-                    result.mResult = RmapResult::Code::success;
-                }
-                else
-                {
-                    console_out("RMAP-Initiator: reply received with failure\n");
-
-                    RmapReplyStatus::replyStatus(
-                            static_cast<RmapReplyStatus::ErrorStatusCodes>(rply->getStatus()));
-
-                    result.mResult = RmapResult::Code::executionFailed;
-                    mCounters.mPackageCrcError++;
-                }
+                evaluateWriteReply(transaction, result);
             }
         }
         else
@@ -292,9 +323,9 @@ RmapInitiator::write(RmapTargetNode& rmapTargetNode,
     else
     {
         // Command was not sent successfully
-        console_out("RMAP-Initiator: transaction could not be initiated, failed to send command\n");
+        OUTPOST_LOG("RMAP-Initiator: transaction could not be initiated, failed to send command\n");
         result.mResult = RmapResult::Code::sendFailed;
-        mCounters.mSpacewireFailure++;
+        mCounters.increment(spacewireFailure);
     }
 
     // mutex guarded scope to guard the transaction tear down
@@ -302,19 +333,19 @@ RmapInitiator::write(RmapTargetNode& rmapTargetNode,
         // Guard operation against concurrent accesses
         outpost::rtos::MutexGuard lock(mOperationLock);
         // Delete the transaction from the list
-        mTransactionsList.removeTransaction(transaction->getTransactionID());
+        mTransactionsList.removeTransaction(transaction);
     }
 
     return result;
 }
 
 RmapResult
-RmapInitiator::read(const char* targetNodeName,
-                    const RMapOptions& options,
-                    uint32_t memoryAddress,
-                    uint8_t extendedMemoryAdress,
-                    outpost::Slice<uint8_t> const& buffer,
-                    const outpost::time::Duration& timeout)
+RmapInitiatorBase::read(const char* targetNodeName,
+                        const RMapOptions& options,
+                        uint32_t memoryAddress,
+                        uint8_t extendedMemoryAdress,
+                        outpost::Slice<uint8_t> const& buffer,
+                        const outpost::time::Duration& timeout)
 {
     RmapResult result;
     result.mResult = RmapResult::Code::invalidParameters;
@@ -335,52 +366,164 @@ RmapInitiator::read(const char* targetNodeName,
 }
 
 RmapResult
-RmapInitiator::read(RmapTargetNode& rmapTargetNode,
-                    const RMapOptions& options,
-                    uint32_t memoryAddress,
-                    uint8_t extendedMemoryAdress,
-                    outpost::Slice<uint8_t> const& buffer,
-                    const outpost::time::Duration& timeout)
+RmapInitiatorBase::read(RmapTargetNode& rmapTargetNode,
+                        const RMapOptions& options,
+                        uint32_t memoryAddress,
+                        uint8_t extendedMemoryAdress,
+                        outpost::Slice<uint8_t> const& buffer,
+                        const outpost::time::Duration& timeout)
 {
-    RmapResult result;
-    if (buffer.getNumberOfElements() > rmap::bufferSize)
+    if (buffer.getNumberOfElements() > mMaximumDataLength)
     {
-        console_out("RMAP-Initiator: Requested size for read %u, maximal allowed size %u\n",
+        return transferChunks(rmapTargetNode,
+                              options,
+                              memoryAddress,
+                              extendedMemoryAdress,
+                              buffer,
+                              outpost::Slice<const uint8_t>::empty(),
+                              timeout);
+    }
+
+    RmapResult result;
+    RmapTransaction* transaction = nullptr;
+    if (executeRead(rmapTargetNode,
+                    options,
+                    memoryAddress,
+                    extendedMemoryAdress,
                     buffer.getNumberOfElements(),
-                    rmap::bufferSize);
-        result.mResult = RmapResult::Code::invalidParameters;
-        return result;
+                    timeout,
+                    transaction,
+                    result))
+    {
+        // Copy received data to the external buffer
+        buffer.copyFrom(transaction->getReplyPacket()->getData().first(result.getReadBytes()));
     }
 
-    if (buffer.getNumberOfElements() == 0)
+    if (transaction != nullptr)
     {
-        // the second read function also return without a message in this case
-        result.mResult = RmapResult::Code::invalidParameters;
-        return result;
+        removeBlockingTransaction(transaction);
     }
+    return result;
+}
+
+RmapResult
+RmapInitiatorBase::read(RmapTargetNode& rmapTargetNode,
+                        const RMapOptions& options,
+                        uint32_t memoryAddress,
+                        uint8_t extendedMemoryAdress,
+                        size_t length,
+                        outpost::utils::SharedChildPointer& data,
+                        const outpost::time::Duration& timeout)
+{
+    data = outpost::utils::SharedChildPointer();
 
+    RmapResult result;
     RmapTransaction* transaction = nullptr;
-    bool sendSuccesful = false;
+    if (executeRead(rmapTargetNode,
+                    options,
+                    memoryAddress,
+                    extendedMemoryAdress,
+                    length,
+                    timeout,
+                    transaction,
+                    result)
+        && (result.getReadBytes() > 0))
+    {
+        // The data field is a part of the received packet
+        const outpost::utils::SharedBufferPointer& rxBuffer = transaction->getBuffer();
+        size_t offset = &transaction->getReplyPacket()->getData()[0] - &rxBuffer.asSlice()[0];
+        if (!rxBuffer.getChild(data, rmap::protocolIdentifier, offset, result.getReadBytes()))
+        {
+            result.mResult = RmapResult::Code::invalidReply;
+        }
+    }
 
-    // Scope for the MutexGuard, protecting the trnasaction setup
+    if (transaction != nullptr)
     {
-        // Guard operation against concurrent accesses
-        outpost::rtos::MutexGuard lock(mOperationLock);
+        // The received buffer stays valid as long as data refers to it
+        removeBlockingTransaction(transaction);
+    }
+    return result;
+}
 
-        transaction = mTransactionsList.getFreeTransaction();
+bool
+RmapInitiatorBase::executeRead(RmapTargetNode& rmapTargetNode,
+                               const RMapOptions& options,
+                               uint32_t memoryAddress,
+                               uint8_t extendedMemoryAdress,
+                               size_t length,
+                               const outpost::time::Duration& timeout,
+                               RmapTransaction*& transaction,
+                               RmapResult& result)
+{
+    if (length > mMaximumDataLength)
+    {
+        OUTPOST_LOG("RMAP-Initiator: Requested size for read %u, maximal allowed size %u\n",
+                    length,
+                    mMaximumDataLength);
+        result.mResult = RmapResult::Code::invalidParameters;
+        return false;
+    }
 
-        if (transaction == nullptr)
-        {
-            console_out("RMAP-Initiator: All transactions are in use\n");
-            result.mResult = RmapResult::Code::noFreeTransactions;
-            return result;
-        }
-        // id must also be under mutex
-        uint16_t transactionID = getNextAvailableTransactionID();
-        transaction->setTransactionID(transactionID);
-    }  // MutexGuard scope
+    if (length == 0)
+    {
+        // the second read function also return without a message in this case
+        result.mResult = RmapResult::Code::invalidParameters;
+        return false;
+    }
 
-    RmapPacket* cmd = transaction->getCommandPacket();
+    // Retries share the timeout of the caller
+    const RmapAdaptiveTimeout& adaptiveTimeout = rmapTargetNode.getAdaptiveTimeout();
+    const outpost::time::SpacecraftElapsedTime start = mClock.now();
+    uint8_t attempt = 0;
+    bool dataValid = executeReadOnce(rmapTargetNode,
+                                     options,
+                                     memoryAddress,
+                                     extendedMemoryAdress,
+                                     length,
+                                     adaptiveTimeout.getTimeout(
+                                             rmapTargetNode.getStatistics(), attempt, timeout),
+                                     transaction,
+                                     result);
+    outpost::time::Duration remaining = getRemainingTime(timeout, mClock.now() - start);
+    while ((result.getResult() == RmapResult::Code::timeout) && adaptiveTimeout.mEnabled
+           && (attempt < adaptiveTimeout.mRetries) && (remaining > outpost::time::Duration::zero()))
+    {
+        // A late reply to the previous attempt is counted as unknown transaction
+        removeBlockingTransaction(transaction);
+        transaction = nullptr;
+
+        attempt++;
+        dataValid = executeReadOnce(rmapTargetNode,
+                                    options,
+                                    memoryAddress,
+                                    extendedMemoryAdress,
+                                    length,
+                                    adaptiveTimeout.getTimeout(
+                                            rmapTargetNode.getStatistics(), attempt, remaining),
+                                    transaction,
+                                    result);
+        remaining = getRemainingTime(timeout, mClock.now() - start);
+    }
+    return dataValid;
+}
+
+bool
+RmapInitiatorBase::executeReadOnce(RmapTargetNode& rmapTargetNode,
+                                   const RMapOptions& options,
+                                   uint32_t memoryAddress,
+                                   uint8_t extendedMemoryAdress,
+                                   size_t length,
+                                   const outpost::time::Duration& timeout,
+                                   RmapTransaction*& transaction,
+                                   RmapResult& result)
+{
+    transaction = reserveTransaction();
+    if (transaction == nullptr)
+    {
+        result.mResult = RmapResult::Code::noFreeTransactions;
+        return false;
+    }
 
     // Read transaction will always be blocking
     transaction->setBlockingMode(true);
@@ -388,115 +531,366 @@ RmapInitiator::read(RmapTargetNode& rmapTargetNode,
     // Extra block call with zero timeout for acquiring already released lock
     transaction->blockTransaction(outpost::time::Duration::zero());
 
-    // Sets the command packet
-    cmd->setInitiatorLogicalAddress(mInitiatorLogicalAddress);
-    cmd->setRead();
-    cmd->setCommand();
-
-    cmd->setIncrementFlag(options.mIncrementMode);
-    cmd->setVerifyFlag(options.mVerifyMode);
-    cmd->setReplyFlag(true);
-
-    cmd->setExtendedAddress(extendedMemoryAdress);
-    cmd->setAddress(memoryAddress);
-    cmd->setDataLength(buffer.getNumberOfElements());
-
-    // InitiatorLogicalAddress might be updated in below
-    cmd->setTargetInformation(rmapTargetNode);
-    transaction->setInitiatorLogicalAddress(cmd->getInitiatorLogicalAddress());
+    prepareReadCommand(
+            transaction, rmapTargetNode, options, memoryAddress, extendedMemoryAdress, length);
     transaction->setTimeoutDuration(timeout);
 
-    sendSuccesful = sendPacket(transaction);
+    bool dataValid = false;
+    bool sendSuccesful = sendPacket(transaction);
 
     if (sendSuccesful)
     {
-        console_out("RMAP-Initiator: Command sent %u, waiting for reply\n",
+        OUTPOST_LOG("RMAP-Initiator: Command sent %u, waiting for reply\n",
                     transaction->getState());
 
         // Wait for the RMAP reply
         transaction->blockTransaction(timeout);
 
-        console_out("RMAP-Initiator: Notified with state: %u\n", transaction->getState());
+        OUTPOST_LOG("RMAP-Initiator: Notified with state: %u\n", transaction->getState());
 
         if (transaction->getState() == RmapTransaction::State::replyReceived)
         {
-            RmapPacket* rply = transaction->getReplyPacket();
-            uint8_t replyStatus = rply->getStatus();
-            result.mErrorCode = static_cast<RmapReplyStatus::ErrorStatusCodes>(replyStatus);
+            dataValid = evaluateReadReply(transaction, length, result);
+        }
+        else
+        {
+            OUTPOST_LOG("RMAP-Initiator: Timeout\n");
+            result.mResult = RmapResult::Code::timeout;
+            recordTimeout(transaction);
+        }
+    }
+    else
+    {
+        OUTPOST_LOG("RMAP-Initiator: Transaction could not be initiated\n");
+        result.mResult = RmapResult::Code::sendFailed;
+        mCounters.increment(spacewireFailure);
+    }
+    return dataValid;
+}
 
-            if (replyStatus != RmapReplyStatus::commandExecutedSuccessfully)
+void
+RmapInitiatorBase::removeBlockingTransaction(RmapTransaction* transaction)
+{
+    // Guard operation against concurrent accesses
+    outpost::rtos::MutexGuard lock(mOperationLock);
+    // Delete the transaction from the list
+    // Will also release the SharedBuffer allocated for the received data
+    mTransactionsList.removeTransaction(transaction);
+}
+
+bool
+RmapInitiatorBase::submitRead(RmapTargetNode& rmapTargetNode,
+                              const RMapOptions& options,
+                              uint32_t memoryAddress,
+                              uint8_t extendedMemoryAdress,
+                              outpost::Slice<uint8_t> const& buffer,
+                              RmapRequest& request,
+                              const outpost::time::Duration& timeout)
+{
+    if (request.isPending())
+    {
+        return false;
+    }
+
+    request.mResult = RmapResult();
+    if ((buffer.getNumberOfElements() == 0) || (buffer.getNumberOfElements() > mMaximumDataLength))
+    {
+        request.mResult.mResult = RmapResult::Code::invalidParameters;
+        return false;
+    }
+
+    request.mReadBuffer = buffer;
+    request.mScatterList = outpost::Slice<RmapReadElement>::empty();
+    return startRead(rmapTargetNode,
+                     options,
+                     memoryAddress,
+                     extendedMemoryAdress,
+                     buffer.getNumberOfElements(),
+                     request,
+                     timeout);
+}
+
+RmapResult
+RmapInitiatorBase::readBatch(RmapTargetNode& rmapTargetNode,
+                             const RMapOptions& options,
+                             uint8_t extendedMemoryAdress,
+                             outpost::Slice<RmapReadElement> const& elements,
+                             const outpost::time::Duration& timeout)
+{
+    RmapResult result;
+    for (size_t i = 0; i < elements.getNumberOfElements(); i++)
+    {
+        size_t length = elements[i].mBuffer.getNumberOfElements();
+        if ((length == 0) || (length > mMaximumDataLength))
+        {
+            result.mResult = RmapResult::Code::invalidParameters;
+            return result;
+        }
+        elements[i].mResult = RmapResult();
+    }
+
+    // Requests are submitted and finished in the same order, slot = index % number of slots
+    RmapRequest requests[maxBatchTransactions];
+    size_t groupStart[maxBatchTransactions];
+    const size_t numberOfSlots =
+            outpost::utils::min<size_t>(maxBatchTransactions,
+                                        mTransactionsList.mTransactions.getNumberOfElements());
+    size_t submitted = 0;
+    size_t finished = 0;
+
+    size_t next = 0;
+    result.mResult = RmapResult::Code::success;
+    while ((next < elements.getNumberOfElements()) || (finished < submitted))
+    {
+        bool transactionsAvailable = true;
+        while (transactionsAvailable && (next < elements.getNumberOfElements())
+               && ((submitted - finished) < numberOfSlots))
+        {
+            size_t count =
+                    getCoalescedElements(options, elements.skipFirst(next), mMaximumDataLength);
+            size_t slot = submitted % numberOfSlots;
+            RmapRequest& request = requests[slot];
+
+            request.mResult = RmapResult();
+            request.mReadBuffer = outpost::Slice<uint8_t>::empty();
+            request.mScatterList = elements.subSlice(next, count);
+            size_t length = 0;
+            for (size_t i = 0; i < count; i++)
+            {
+                length += elements[next + i].mBuffer.getNumberOfElements();
+            }
+
+            if (startRead(rmapTargetNode,
+                          options,
+                          elements[next].mAddress,
+                          extendedMemoryAdress,
+                          length,
+                          request,
+                          timeout))
             {
-                console_out("RMAP-Initiator: Command not executed successfully: %u\n", replyStatus);
-                result.mResult = RmapResult::Code::executionFailed;
-                mCounters.mOperationFailed++;
+                groupStart[slot] = next;
+                submitted++;
+                next += count;
+            }
+            else if ((request.getResult().getResult() == RmapResult::Code::noFreeTransactions)
+                     && (finished < submitted))
+            {
+                // Transactions are shared with other users, retry after the next reply
+                transactionsAvailable = false;
             }
             else
             {
-                result.mReadbytes = rply->getDataLength();
-                if (buffer.getNumberOfElements() < rply->getDataLength())
-                {
-                    console_out("RMAP-Initiator: Read reply with more data then requested\n");
-                    result.mResult = RmapResult::Code::invalidReply;
-                    mCounters.mIncorrectOperation++;
-                }
-                else if (buffer.getNumberOfElements() > rply->getDataLength())
-                {
-                    console_out("RMAP-Initiator: Read reply with insufficient data\n");
+                finishReadElements(request.mScatterList, request.getResult(), result);
+                next += count;
+            }
+        }
 
-                    // Copy received data to the external buffer
-                    memcpy(&buffer[0], &rply->getData()[0], rply->getDataLength());
+        if (finished < submitted)
+        {
+            size_t slot = finished % numberOfSlots;
+            RmapRequest& request = requests[slot];
+            RmapResult groupResult = wait(request, timeout);
+            finishReadElements(
+                    elements.subSlice(groupStart[slot], request.mScatterList.getNumberOfElements()),
+                    groupResult,
+                    result);
+            finished++;
+        }
+    }
 
-                    result.mResult = RmapResult::Code::replyTooShort;
-                }
-                else
-                {
-                    // Copy received data to the external buffer
-                    // at this point rply->getDataLength() == buffer.getNumberOfElements()
-                    memcpy(&buffer[0], &rply->getData()[0], rply->getDataLength());
+    return result;
+}
 
-                    // Release the SpW buffer
+RmapResult
+RmapInitiatorBase::transferChunks(RmapTargetNode& rmapTargetNode,
+                                  const RMapOptions& options,
+                                  uint32_t memoryAddress,
+                                  uint8_t extendedMemoryAdress,
+                                  outpost::Slice<uint8_t> const& readBuffer,
+                                  outpost::Slice<const uint8_t> const& writeData,
+                                  const outpost::time::Duration& timeout)
+{
+    const bool isRead = (readBuffer.getNumberOfElements() != 0);
+    const size_t length =
+            isRead ? readBuffer.getNumberOfElements() : writeData.getNumberOfElements();
+
+    // Requests are submitted and finished in the same order, slot = index % number of slots
+    RmapRequest requests[maxBatchTransactions];
+    const size_t numberOfSlots =
+            outpost::utils::min<size_t>(maxBatchTransactions,
+                                        mTransactionsList.mTransactions.getNumberOfElements());
+    size_t submitted = 0;
+    size_t finished = 0;
 
-                    result.mResult = RmapResult::Code::success;
-                }
+    RmapResult result;
+    result.mResult = RmapResult::Code::success;
+
+    size_t offset = 0;
+    while (((offset < length) && result) || (finished < submitted))
+    {
+        bool transactionsAvailable = true;
+        while (transactionsAvailable && (offset < length) && result
+               && ((submitted - finished) < numberOfSlots))
+        {
+            const size_t chunkLength =
+                    outpost::utils::min<size_t>(mMaximumDataLength, length - offset);
+            const uint32_t address = options.mIncrementMode
+                                             ? static_cast<uint32_t>(memoryAddress + offset)
+                                             : memoryAddress;
+            RmapRequest& request = requests[submitted % numberOfSlots];
+
+            bool sent;
+            if (isRead)
+            {
+                sent = submitRead(rmapTargetNode,
+                                  options,
+                                  address,
+                                  extendedMemoryAdress,
+                                  readBuffer.subSlice(offset, chunkLength),
+                                  request,
+                                  timeout);
+            }
+            else
+            {
+                sent = submitWrite(rmapTargetNode,
+                                   options,
+                                   address,
+                                   extendedMemoryAdress,
+                                   writeData.subSlice(offset, chunkLength),
+                                   request,
+                                   timeout);
+            }
+
+            if (sent)
+            {
+                submitted++;
+                offset += chunkLength;
+            }
+            else if ((request.getResult().getResult() == RmapResult::Code::noFreeTransactions)
+                     && (finished < submitted))
+            {
+                // Transactions are shared with other users, retry after the next reply
+                transactionsAvailable = false;
+            }
+            else
+            {
+                result.mResult = request.getResult().mResult;
+                result.mErrorCode = request.getResult().mErrorCode;
             }
         }
-        else
+
+        if (finished < submitted)
         {
-            console_out("RMAP-Initiator: Timeout\n");
-            result.mResult = RmapResult::Code::timeout;
+            RmapResult chunkResult = wait(requests[finished % numberOfSlots], timeout);
+            result.mReadbytes += chunkResult.mReadbytes;
+            if (result && !chunkResult)
+            {
+                // Report the first failure, the following chunks are not sent
+                result.mResult = chunkResult.mResult;
+                result.mErrorCode = chunkResult.mErrorCode;
+            }
+            finished++;
         }
     }
-    else
+
+    return result;
+}
+
+bool
+RmapInitiatorBase::submitWrite(RmapTargetNode& rmapTargetNode,
+                               const RMapOptions& options,
+                               uint32_t memoryAddress,
+                               uint8_t extendedMemoryAdress,
+                               outpost::Slice<const uint8_t> const& data,
+                               RmapRequest& request,
+                               const outpost::time::Duration& timeout)
+{
+    if (request.isPending())
     {
-        console_out("RMAP-Initiator: Transaction could not be initiated\n");
-        result.mResult = RmapResult::Code::sendFailed;
-        mCounters.mSpacewireFailure++;
+        return false;
     }
 
-    // mutex guarded scope to guard the transaction tear down
+    request.mResult = RmapResult();
+    if (data.getNumberOfElements() == 0)
     {
-        // Guard operation against concurrent accesses
-        outpost::rtos::MutexGuard lock(mOperationLock);
-        // Delete the transaction from the list
-        // Will also release the SharedBuffer allocated for the received data
-        mTransactionsList.removeTransaction(transaction->getTransactionID());
+        request.mResult.mResult = RmapResult::Code::invalidParameters;
+        return false;
     }
 
-    return result;
+    RmapTransaction* transaction = reserveTransaction();
+    if (transaction == nullptr)
+    {
+        request.mResult.mResult = RmapResult::Code::noFreeTransactions;
+        return false;
+    }
+
+    prepareWriteCommand(
+            transaction, rmapTargetNode, options, memoryAddress, extendedMemoryAdress, data);
+    transaction->setTimeoutDuration(timeout);
+
+    request.mReadBuffer = outpost::Slice<uint8_t>::empty();
+    return startRequest(transaction, request);
+}
+
+RmapResult
+RmapInitiatorBase::wait(RmapRequest& request, const outpost::time::Duration& timeout)
+{
+    if (request.isPending() && !request.mCompleted.acquire(timeout))
+    {
+        if (cancel(request))
+        {
+            OUTPOST_LOG("RMAP-Initiator: Timeout\n");
+        }
+    }
+    return request.getResult();
+}
+
+bool
+RmapInitiatorBase::cancel(RmapRequest& request)
+{
+    outpost::rtos::MutexGuard lock(mOperationLock);
+
+    if (!request.isPending())
+    {
+        // Reply was already handled
+        return false;
+    }
+
+    request.mResult.mResult = RmapResult::Code::timeout;
+    recordTimeout(request.mTransaction);
+    finishRequest(request);
+    return true;
+}
+
+void
+RmapInitiatorBase::resetPeakActiveTransactions()
+{
+    outpost::rtos::MutexGuard lock(mOperationLock);
+    mPeakActiveTransactions = mTransactionsList.getNumberOfActiveTransactions();
 }
 
 //=============================================================================
 
 void
-RmapInitiator::run()
+RmapInitiatorBase::run()
 {
     mStopped = false;
+    mEvents.clear(stopEvent);
     while (!mStopped)
     {
-        outpost::support::Heartbeat::send(mHeartbeatSource, receiveTimeout * 2);
-        doSingleStep();
+        mHeartbeat.send(receiveTimeout * 2);
+        if (mEventNotification && mQueue.isEmpty())
+        {
+            // Sleep until a packet is received or stop() is called, the
+            // timeout only keeps the heartbeat alive
+            mEvents.waitAny(packetReceivedEvent | stopEvent, receiveTimeout);
+        }
+        else
+        {
+            doSingleStep();
+        }
     }
-    outpost::support::Heartbeat::suspend(mHeartbeatSource);
+    mHeartbeat.suspend();
     mStopped = true;
 }
 
@@ -505,9 +899,9 @@ RmapInitiator::run()
  * for testing needed as own function
  */
 void
-RmapInitiator::doSingleStep()
+RmapInitiatorBase::doSingleStep()
 {
-    RmapPacket packet;
+    RmapPacketView packet;
 
     outpost::utils::SharedBufferPointer rxBuffer;
 
@@ -522,7 +916,7 @@ RmapInitiator::doSingleStep()
 }
 
 bool
-RmapInitiator::sendPacket(RmapTransaction* transaction)
+RmapInitiatorBase::sendPacket(RmapTransaction* transaction)
 {
     RmapPacket* cmd = transaction->getCommandPacket();
     bool result = false;
@@ -533,34 +927,43 @@ RmapInitiator::sendPacket(RmapTransaction* transaction)
     // required reply corresponding transaction will found and freed accordingly
     // therefore transmit can directly begin
 
-    // Request TX buffer
-    outpost::Slice<uint8_t> txBuffer = outpost::asSlice(mSendBuffer);
+    // Reserve a TX buffer, the packet is serialized directly into it
+    outpost::hal::SpaceWire::TransmitBuffer* transmitBuffer = nullptr;
+    outpost::Slice<uint8_t> txBuffer = outpost::Slice<uint8_t>::empty();
+    if (!mSpW.reserve(transmitBuffer, txBuffer, transaction->getTimeoutDuration()))
+    {
+        return false;
+    }
 
     // Serialize the packet content to the SpW buffer
     if (cmd->constructPacket(txBuffer))
     {
-#ifdef DEBUG_EN
-        console_out("TX-Data length: %zu\n", txBuffer.getNumberOfElements());
-        for (uint16_t i = 0; i < txBuffer.getNumberOfElements(); i++)
+        // The reply may be handled before commit() returns
+        transaction->setSendTime(mClock.now());
+        result = mSpW.commit(
+                transmitBuffer, txBuffer.getNumberOfElements(), transaction->getTimeoutDuration());
+        if (result)
         {
-            console_out("%02X ", txBuffer[i]);
-            if (i % 30 == 29)
-            {
-                console_out("\n");
-            }
+            OUTPOST_TRACE(outpost::utils::trace::rmapCommandSent,
+                          transaction->getTransactionID(),
+                          cmd->getTargetLogicalAddress());
         }
-        console_out("\n");
-#endif
-        if (mSpW.send(txBuffer, transaction->getTimeoutDuration()))
+        if (result && (transaction->getTargetNode() != nullptr))
         {
-            result = true;
+            transaction->getTargetNode()->getStatistics().recordRequest(
+                    cmd->isWrite() ? cmd->getDataLength() : 0);
         }
     }
+    else
+    {
+        mSpW.abort(transmitBuffer, transaction->getTimeoutDuration());
+    }
     return result;
 }
 
 bool
-RmapInitiator::receivePacket(RmapPacket* rxedPacket, outpost::utils::SharedBufferPointer& rxBuffer)
+RmapInitiatorBase::receivePacket(RmapPacketView* rxedPacket,
+                                 outpost::utils::SharedBufferPointer& rxBuffer)
 {
     bool result = false;
 
@@ -569,33 +972,19 @@ RmapInitiator::receivePacket(RmapPacket* rxedPacket, outpost::utils::SharedBuffe
     {
         outpost::Slice<const uint8_t> rxData = rxBuffer.asSlice();
 
-#ifdef DEBUG_EN
-        console_out("RX-Data length: %zu\n", rxData.getNumberOfElements());
-        for (uint16_t i = 0; i < rxData.getNumberOfElements(); i++)
-        {
-            console_out("%02X ", rxData[i]);
-            if (i % 30 == 29)
-            {
-                console_out("\n");
-            }
-        }
-        console_out("\n");
-#endif
-
-        rxedPacket->reset();
-
-        auto extractionResult = rxedPacket->extractReplyPacket(rxData, mInitiatorLogicalAddress);
+        // The packet only refers to rxData, rxBuffer keeps it alive
+        auto extractionResult = rxedPacket->parseReply(rxData, mInitiatorLogicalAddress);
         switch (extractionResult)
         {
             case RmapPacket::ExtractionResult::success: result = true; break;
             case RmapPacket::ExtractionResult::incorrectAddress: result = false; break;
             case RmapPacket::ExtractionResult::crcError:
                 result = false;
-                mCounters.mPackageCrcError++;
+                mCounters.increment(packageCrcError);
                 break;
             case RmapPacket::ExtractionResult::invalid:
                 result = false;
-                mCounters.mInvalidSize++;
+                mCounters.increment(invalidSize);
                 break;
         }
     }
@@ -603,11 +992,34 @@ RmapInitiator::receivePacket(RmapPacket* rxedPacket, outpost::utils::SharedBuffe
 }
 
 void
-RmapInitiator::handleReplyPacket(RmapPacket* packet, outpost::utils::SharedBufferPointer& rxBuffer)
+RmapInitiatorBase::handleReplyPacket(const RmapPacketView* packet,
+                                     outpost::utils::SharedBufferPointer& rxBuffer)
+{
+    RmapRequest* finishedRequest = nullptr;
+    uint32_t sequence = 0;
+
+    // Scope for the MutexGuard, the owner of a finished request is informed without the lock
+    {
+        // Prevents that this function and removeTransaction both change the transaction
+        // Which could lead to unusable transaction objects
+        outpost::rtos::MutexGuard lock(mOperationLock);
+        finishedRequest = assignReplyPacket(packet, rxBuffer);
+        if (finishedRequest != nullptr)
+        {
+            sequence = finishedRequest->mSequence;
+        }
+    }
+
+    if (finishedRequest != nullptr)
+    {
+        notifyCompletion(*finishedRequest, sequence);
+    }
+}
+
+RmapRequest*
+RmapInitiatorBase::assignReplyPacket(const RmapPacketView* packet,
+                                     outpost::utils::SharedBufferPointer& rxBuffer)
 {
-    // Prevents that this function and removeTransaction both change the transaction
-    // Which could lead to unusable transaction objects
-    outpost::rtos::MutexGuard lock(mOperationLock);
 
     // Find a corresponding command packet
     RmapTransaction* transaction = resolveTransaction(packet);
@@ -615,8 +1027,8 @@ RmapInitiator::handleReplyPacket(RmapPacket* packet, outpost::utils::SharedBuffe
     if (transaction == nullptr)
     {
         // If not found, increment error counter
-        mCounters.mUnknownTransactionID++;
-        console_out("RMAP Reply packet (dataLength %lu bytes) was received but "
+        mCounters.increment(unknownTransactionID);
+        OUTPOST_LOG("RMAP Reply packet (dataLength %u bytes) was received but "
                     "no corresponding transaction was found.\n",
                     packet->getDataLength());
     }
@@ -626,9 +1038,20 @@ RmapInitiator::handleReplyPacket(RmapPacket* packet, outpost::utils::SharedBuffe
         if ((transaction->getCommandPacket()->getInstruction() & 0x3c)
             != (packet->getInstruction() & 0x3c))
         {
-            console_out("RMAP-Initiator: Received reply does not fit request \n");
-            mCounters.mIncorrectOperation++;
-            return;
+            OUTPOST_LOG("RMAP-Initiator: Received reply does not fit request \n");
+            mCounters.increment(incorrectOperation);
+            return nullptr;
+        }
+
+        OUTPOST_TRACE(outpost::utils::trace::rmapReplyReceived,
+                      transaction->getTransactionID(),
+                      packet->getStatus());
+
+        if (transaction->getTargetNode() != nullptr)
+        {
+            transaction->getTargetNode()->getStatistics().recordReply(
+                    mClock.now() - transaction->getSendTime(),
+                    packet->getDataLength());
         }
 
         // Register reply packet to the resolved transaction
@@ -641,20 +1064,40 @@ RmapInitiator::handleReplyPacket(RmapPacket* packet, outpost::utils::SharedBuffe
         // Update transaction state
         transaction->setState(RmapTransaction::State::replyReceived);
 
-        console_out("RMAP-Initiator: Reply received, thus notifying blocking thread\n");
+        RmapRequest* request = transaction->getRequest();
+        if (request != nullptr)
+        {
+            // Asynchronous request, nobody is waiting for the transaction
+            if (transaction->getCommandPacket()->isRead())
+            {
+                if (evaluateReadReply(transaction, request->mReadLength, request->mResult))
+                {
+                    copyReadData(transaction->getReplyPacket()->getData(), *request);
+                }
+            }
+            else
+            {
+                evaluateWriteReply(transaction, request->mResult);
+            }
+            finishRequest(*request);
+            return request;
+        }
+
+        OUTPOST_LOG("RMAP-Initiator: Reply received, thus notifying blocking thread\n");
 
         if (transaction->isBlockingMode())
         {
-            console_out("RMAP-Initiator: Transaction with TID %u is blocking, thus "
+            OUTPOST_LOG("RMAP-Initiator: Transaction with TID %u is blocking, thus "
                         "releasing lock...\n",
                         transaction->getTransactionID());
             transaction->releaseTransaction();
         }
     }
+    return nullptr;
 }
 
 RmapTransaction*
-RmapInitiator::resolveTransaction(RmapPacket* packet)
+RmapInitiatorBase::resolveTransaction(const RmapPacketView* packet)
 {
     uint16_t transactionID = packet->getTransactionID();
     RmapTransaction* transaction = mTransactionsList.getTransaction(transactionID);
@@ -662,29 +1105,337 @@ RmapInitiator::resolveTransaction(RmapPacket* packet)
     if (transaction == nullptr)
     {
         // TID is not in use
-        console_out("RMAP-Initiator: Unexpected RMAP Reply Packet Was Received\n");
+        OUTPOST_LOG("RMAP-Initiator: Unexpected RMAP Reply Packet Was Received\n");
         return nullptr;
     }
     return transaction;
 }
 
-uint16_t
-RmapInitiator::getNextAvailableTransactionID()
+RmapTransaction*
+RmapInitiatorBase::reserveTransaction()
+{
+    // Guard operation against concurrent accesses
+    outpost::rtos::MutexGuard lock(mOperationLock);
+
+    // Using existing free element from the transaction list
+    RmapTransaction* transaction = mTransactionsList.getFreeTransaction();
+    if (transaction == nullptr)
+    {
+        OUTPOST_LOG("RMAP-Initiator: All transactions are in use\n");
+    }
+    else
+    {
+        mPeakActiveTransactions = outpost::utils::max<size_t>(
+                mPeakActiveTransactions, mTransactionsList.getNumberOfActiveTransactions());
+    }
+    return transaction;
+}
+
+void
+RmapInitiatorBase::prepareWriteCommand(RmapTransaction* transaction,
+                                       RmapTargetNode& rmapTargetNode,
+                                       const RMapOptions& options,
+                                       uint32_t memoryAddress,
+                                       uint8_t extendedMemoryAdress,
+                                       outpost::Slice<const uint8_t> const& data)
+{
+    RmapPacket* cmd = transaction->getCommandPacket();
+
+    // Packet configuration
+    cmd->setInitiatorLogicalAddress(mInitiatorLogicalAddress);
+    cmd->setWrite();
+    cmd->setCommand();
+
+    cmd->setIncrementFlag(options.mIncrementMode);
+    cmd->setVerifyFlag(options.mVerifyMode);
+    cmd->setReplyFlag(options.mReplyMode);
+
+    cmd->setExtendedAddress(extendedMemoryAdress);
+    cmd->setAddress(memoryAddress);
+    cmd->setData(data);  // also set data length and crc
+    cmd->setTargetInformation(rmapTargetNode);
+    transaction->setTargetNode(&rmapTargetNode);
+}
+
+void
+RmapInitiatorBase::prepareReadCommand(RmapTransaction* transaction,
+                                      RmapTargetNode& rmapTargetNode,
+                                      const RMapOptions& options,
+                                      uint32_t memoryAddress,
+                                      uint8_t extendedMemoryAdress,
+                                      size_t length)
+{
+    RmapPacket* cmd = transaction->getCommandPacket();
+
+    // Sets the command packet
+    cmd->setInitiatorLogicalAddress(mInitiatorLogicalAddress);
+    cmd->setRead();
+    cmd->setCommand();
+
+    cmd->setIncrementFlag(options.mIncrementMode);
+    cmd->setVerifyFlag(options.mVerifyMode);
+    cmd->setReplyFlag(true);
+
+    cmd->setExtendedAddress(extendedMemoryAdress);
+    cmd->setAddress(memoryAddress);
+    cmd->setDataLength(length);
+
+    // InitiatorLogicalAddress might be updated in below
+    cmd->setTargetInformation(rmapTargetNode);
+    transaction->setInitiatorLogicalAddress(cmd->getInitiatorLogicalAddress());
+    transaction->setTargetNode(&rmapTargetNode);
+}
+
+void
+RmapInitiatorBase::evaluateWriteReply(RmapTransaction* transaction, RmapResult& result)
+{
+    const RmapPacketView* rply = transaction->getReplyPacket();
+
+    result.mErrorCode = static_cast<RmapReplyStatus::ErrorStatusCodes>(rply->getStatus());
+    if (rply->getStatus() == RmapReplyStatus::commandExecutedSuccessfully)
+    {
+        OUTPOST_LOG("RMAP-Initiator: reply received with success\n");
+
+        result.mResult = RmapResult::Code::success;
+    }
+    else
+    {
+        OUTPOST_LOG("RMAP-Initiator: reply received with failure\n");
+
+        RmapReplyStatus::replyStatus(
+                static_cast<RmapReplyStatus::ErrorStatusCodes>(rply->getStatus()));
+
+        result.mResult = RmapResult::Code::executionFailed;
+        mCounters.increment(packageCrcError);
+    }
+}
+
+bool
+RmapInitiatorBase::evaluateReadReply(RmapTransaction* transaction,
+                                     size_t length,
+                                     RmapResult& result)
 {
-    // Check in the current transaction list that the TID is not in use
-    for (uint16_t i = mTransactionId + 1; i != mTransactionId; i++)
+    const RmapPacketView* rply = transaction->getReplyPacket();
+    uint8_t replyStatus = rply->getStatus();
+    result.mErrorCode = static_cast<RmapReplyStatus::ErrorStatusCodes>(replyStatus);
+
+    bool dataValid = false;
+    if (replyStatus != RmapReplyStatus::commandExecutedSuccessfully)
     {
-        // cast to prevent compiler warning (always false comparison when using default values)
-        if (static_cast<uint32_t>(i) >= rmap::maxTransactionIds)
+        OUTPOST_LOG("RMAP-Initiator: Command not executed successfully: %u\n", replyStatus);
+        result.mResult = RmapResult::Code::executionFailed;
+        mCounters.increment(operationFailed);
+    }
+    else
+    {
+        result.mReadbytes = rply->getDataLength();
+        if (length < rply->getDataLength())
+        {
+            OUTPOST_LOG("RMAP-Initiator: Read reply with more data then requested\n");
+            result.mResult = RmapResult::Code::invalidReply;
+            mCounters.increment(incorrectOperation);
+        }
+        else if (length > rply->getDataLength())
         {
-            i = 0;
+            OUTPOST_LOG("RMAP-Initiator: Read reply with insufficient data\n");
+            result.mResult = RmapResult::Code::replyTooShort;
+            dataValid = true;
         }
+        else
+        {
+            result.mResult = RmapResult::Code::success;
+            dataValid = true;
+        }
+    }
+    return dataValid;
+}
 
-        if (!mTransactionsList.isTransactionIdUsed(i))
+void
+RmapInitiatorBase::copyReadData(outpost::Slice<const uint8_t> const& data, RmapRequest& request)
+{
+    if (request.mScatterList.getNumberOfElements() == 0)
+    {
+        // Copy received data to the external buffer
+        request.mReadBuffer.copyFrom(data);
+        return;
+    }
+
+    size_t offset = 0;
+    for (size_t i = 0; i < request.mScatterList.getNumberOfElements(); i++)
+    {
+        RmapReadElement& element = request.mScatterList[i];
+        size_t length = 0;
+        if (offset < data.getNumberOfElements())
+        {
+            length = outpost::utils::min<size_t>(element.mBuffer.getNumberOfElements(),
+                                                 data.getNumberOfElements() - offset);
+            element.mBuffer.copyFrom(data.subSlice(offset, length));
+        }
+        element.mResult.mReadbytes = length;
+        offset += element.mBuffer.getNumberOfElements();
+    }
+}
+
+bool
+RmapInitiatorBase::startRead(RmapTargetNode& rmapTargetNode,
+                             const RMapOptions& options,
+                             uint32_t memoryAddress,
+                             uint8_t extendedMemoryAdress,
+                             size_t length,
+                             RmapRequest& request,
+                             const outpost::time::Duration& timeout)
+{
+    RmapTransaction* transaction = reserveTransaction();
+    if (transaction == nullptr)
+    {
+        request.mResult.mResult = RmapResult::Code::noFreeTransactions;
+        return false;
+    }
+
+    prepareReadCommand(
+            transaction, rmapTargetNode, options, memoryAddress, extendedMemoryAdress, length);
+    transaction->setTimeoutDuration(timeout);
+
+    request.mReadLength = length;
+    return startRequest(transaction, request);
+}
+
+size_t
+RmapInitiatorBase::getCoalescedElements(const RMapOptions& options,
+                                        outpost::Slice<RmapReadElement> const& elements,
+                                        size_t maximumLength)
+{
+    size_t count = 1;
+    if (options.mIncrementMode)
+    {
+        size_t length = elements[0].mBuffer.getNumberOfElements();
+        while ((count < elements.getNumberOfElements())
+               && (elements[count].mAddress
+                   == elements[count - 1].mAddress
+                              + elements[count - 1].mBuffer.getNumberOfElements())
+               && ((length + elements[count].mBuffer.getNumberOfElements()) <= maximumLength))
         {
-            mTransactionId = i;
-            break;
+            length += elements[count].mBuffer.getNumberOfElements();
+            count++;
         }
     }
-    return mTransactionId;
+    return count;
+}
+
+void
+RmapInitiatorBase::finishReadElements(outpost::Slice<RmapReadElement> const& elements,
+                                      const RmapResult& groupResult,
+                                      RmapResult& batchResult)
+{
+    for (size_t i = 0; i < elements.getNumberOfElements(); i++)
+    {
+        RmapReadElement& element = elements[i];
+        uint32_t readBytes = element.mResult.mReadbytes;
+        element.mResult = groupResult;
+        element.mResult.mReadbytes = readBytes;
+        batchResult.mReadbytes += readBytes;
+
+        // The remote may have stopped within a coalesced read
+        if ((groupResult.getResult() == RmapResult::Code::replyTooShort)
+            && (readBytes == element.mBuffer.getNumberOfElements()))
+        {
+            element.mResult.mResult = RmapResult::Code::success;
+        }
+    }
+
+    if (batchResult && !groupResult)
+    {
+        // Report the first failure
+        batchResult.mResult = groupResult.mResult;
+        batchResult.mErrorCode = groupResult.mErrorCode;
+    }
+}
+
+bool
+RmapInitiatorBase::startRequest(RmapTransaction* transaction, RmapRequest& request)
+{
+    // Nobody blocks on the transaction, the reply is assigned to the request instead
+    transaction->setBlockingMode(false);
+
+    // The reply may be handled by the receiver thread as soon as the command is sent
+    {
+        outpost::rtos::MutexGuard lock(mOperationLock);
+
+        // Consume a completion left over from an earlier request, a
+        // notification still in progress for it is discarded
+        request.mCompleted.acquire(outpost::time::Duration::zero());
+        request.mSequence++;
+
+        transaction->setRequest(&request);
+        request.mTransaction = transaction;
+        request.mPending = true;
+    }
+
+    if (!sendPacket(transaction))
+    {
+        OUTPOST_LOG("RMAP-Initiator: Transaction could not be initiated\n");
+        mCounters.increment(spacewireFailure);
+
+        outpost::rtos::MutexGuard lock(mOperationLock);
+        request.mResult.mResult = RmapResult::Code::sendFailed;
+        finishRequest(request);
+        return false;
+    }
+
+    if (!transaction->getCommandPacket()->isReplyFlagSet())
+    {
+        // Command was sent successfully, in non reply mode there is nothing more
+        uint32_t sequence;
+        {
+            outpost::rtos::MutexGuard lock(mOperationLock);
+            request.mResult.mResult = RmapResult::Code::success;
+            finishRequest(request);
+            sequence = request.mSequence;
+        }
+        notifyCompletion(request, sequence);
+    }
+    return true;
+}
+
+void
+RmapInitiatorBase::finishRequest(RmapRequest& request)
+{
+    // Will also release the SharedBuffer allocated for the received data
+    mTransactionsList.removeTransaction(request.mTransaction);
+    request.mTransaction = nullptr;
+    request.mPending = false;
+}
+
+void
+RmapInitiatorBase::notifyCompletion(RmapRequest& request, uint32_t sequence)
+{
+    {
+        outpost::rtos::MutexGuard lock(mOperationLock);
+        if (request.mSequence != sequence)
+        {
+            // Submitted again after it was finished, e.g. after polling isPending()
+            return;
+        }
+    }
+
+    if (request.mHandler != nullptr)
+    {
+        request.mHandler->onRmapCompletion(request);
+    }
+
+    // The handler may have submitted the request again
+    outpost::rtos::MutexGuard lock(mOperationLock);
+    if (request.mSequence == sequence)
+    {
+        request.mCompleted.release();
+    }
+}
+
+void
+RmapInitiatorBase::recordTimeout(RmapTransaction* transaction)
+{
+    if (transaction->getTargetNode() != nullptr)
+    {
+        transaction->getTargetNode()->getStatistics().recordTimeout();
+    }
 }
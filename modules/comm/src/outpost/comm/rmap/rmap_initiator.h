@@ -18,17 +18,21 @@
 
 #include "rmap_options.h"
 #include "rmap_packet.h"
+#include "rmap_packet_view.h"
+#include "rmap_request.h"
 #include "rmap_result.h"
 #include "rmap_status.h"
 #include "rmap_transaction.h"
 
 #include <outpost/hal/space_wire_multi_protocol_handler.h>
 #include <outpost/rtos.h>
+#include <outpost/rtos/clock.h>
 #include <outpost/smpc.h>
-#include <outpost/support/heartbeat.h>
+#include <outpost/support/heartbeat_limiter.h>
 #include <outpost/time/duration.h>
 #include <outpost/utils/container/reference_queue.h>
 #include <outpost/utils/container/shared_object_pool.h>
+#include <outpost/utils/counter_block.h>
 #include <outpost/utils/minmax.h>
 
 #include <array>
@@ -49,33 +53,42 @@ namespace comm
  * The reception of RMAP packet is handled by separate thread being supplied by
  * the initiator for any asynchronous incoming packets due to some delayed transport.
  *
+ * Besides the blocking read() and write() operations requests can be
+ * submitted without waiting for the reply, see submitRead() and
+ * submitWrite(). This allows a single thread to keep all
+ * transactions in flight.
+ *
+ * Blocking reads and writes of more than getMaximumDataLength() bytes
+ * are split into several commands, which are sent without waiting for
+ * the reply of the previous command.
+ *
+ * Blocking single-command reads and writes use the adaptive timeout of
+ * the target if it is enabled, see RmapTargetNode::setAdaptiveTimeout().
+ *
+ * The memory for transactions and received packets is provided by
+ * GenericRmapInitiator, which defines the number of concurrent
+ * transactions, the maximum data length of a command and the number of
+ * receive buffers. RmapInitiator uses the defaults from rmap_common.h.
+ *
  * \author  Muhammad Bassam
  */
-class RmapInitiator : public outpost::rtos::Thread
+class RmapInitiatorBase : public outpost::rtos::Thread
 {
     friend class TestingRmap;
 
     // For parameterize the class
     static constexpr outpost::time::Duration receiveTimeout = outpost::time::Seconds(5);
 
-    // Packet length related constants.
-    static constexpr uint16_t maxReadCommandLength =
-            rmap::readCommandOverhead + (2 * rmap::maxAddressLength);
-    static constexpr uint16_t maxWriteCommandLength =
-            rmap::writeCommandOverhead + (2 * rmap::maxAddressLength) + rmap::bufferSize;
-
-    static constexpr uint16_t maxCommandLength = maxWriteCommandLength;
-
-    static constexpr uint16_t maxReadReplyLength =
-            rmap::readReplyOverhead + rmap::maxAddressLength + rmap::bufferSize;
-    static constexpr uint16_t maxWriteReplyLength =
-            rmap::writeReplyOverhead + rmap::maxAddressLength;
-
-    static constexpr uint16_t maxReplyLength = maxReadReplyLength;
+    // Maximum number of transactions used by a single readBatch() call or chunked transfer
+    static constexpr size_t maxBatchTransactions = rmap::maxConcurrentTransactions;
 
     // Interval duration to check when the dispatcher thread is running
     static constexpr outpost::time::Duration startUpWaitInterval = outpost::time::Milliseconds(1);
 
+    // Events the receiver thread waits for
+    static constexpr outpost::rtos::EventGroup::Bits packetReceivedEvent = 1U << 0;
+    static constexpr outpost::rtos::EventGroup::Bits stopEvent = 1U << 1;
+
 public:
     struct ErrorCounters
     {
@@ -100,12 +113,24 @@ public:
     /**
      * Handles a list of  Transaction object,
      * list not thread save.
+     *
+     * The transaction ID is composed of the index of the transaction and
+     * a generation counter of that index. Resolving an ID and reserving a
+     * transaction do not need to search the list.
      */
     struct TransactionsList
     {
-        TransactionsList() : mTransactions()
-        {
-        }
+        /**
+         * \param transactions
+         *      Transaction objects, at most 255.
+         * \param freeTransactions
+         *      Same number of elements as transactions.
+         * \param generations
+         *      Same number of elements as transactions.
+         */
+        TransactionsList(outpost::Slice<RmapTransaction> const& transactions,
+                         outpost::Slice<uint8_t> const& freeTransactions,
+                         outpost::Slice<uint16_t> const& generations);
 
         ~TransactionsList()
         {
@@ -117,26 +142,54 @@ public:
         void
         removeTransaction(uint16_t tid);
 
+        /**
+         * Free a reserved transaction.
+         */
+        void
+        removeTransaction(RmapTransaction* transaction);
+
         RmapTransaction*
         getTransaction(uint16_t tid);
 
         bool
         isTransactionIdUsed(uint16_t tid);
 
+        /**
+         * Reserve a free transaction and assign a new transaction ID.
+         */
         RmapTransaction*
         getFreeTransaction();
 
-        RmapTransaction mTransactions[rmap::maxConcurrentTransactions];
+        outpost::Slice<RmapTransaction> mTransactions;
+
+        // Stack of the indices of the free transactions
+        outpost::Slice<uint8_t> mFreeTransactions;
+        uint8_t mNumberOfFreeTransactions;
+
+        // Generation used for the next ID of every transaction
+        outpost::Slice<uint16_t> mGenerations;
+
+        // Number of different IDs per transaction
+        const uint16_t mNumberOfGenerations;
+    };
+
+    /**
+     * Memory used by an initiator.
+     */
+    struct Storage
+    {
+        outpost::Slice<RmapTransaction> mTransactions;
+        outpost::Slice<uint8_t> mFreeTransactions;
+        outpost::Slice<uint16_t> mGenerations;
+        outpost::utils::SharedBufferQueueBase& mQueue;
+        outpost::utils::SharedBufferPoolBase& mPool;
+
+        /// Maximum number of data bytes of a single read or write
+        uint16_t mMaximumDataLength;
     };
 
     //--------------------------------------------------------------------------
-    RmapInitiator(hal::SpaceWireMultiProtocolHandlerInterface& spw,
-                  RmapTargetsList* list,
-                  uint8_t priority,
-                  size_t stackSize,
-                  outpost::support::parameter::HeartbeatSource heartbeatSource,
-                  uint8_t initiatorLogicalAddress = rmap::defaultLogicalAddress);
-    ~RmapInitiator();
+    ~RmapInitiatorBase();
 
     /**
      * Starts the internal thread and waits till the listeners are set up
@@ -203,7 +256,9 @@ public:
      *      The MSB of the (40Bit) remote memory address
      *
      * @param data
-     *      A Slice containing the data to write
+     *      A Slice containing the data to write. Data longer than
+     *      getMaximumDataLength() is written with several commands, which
+     *      increment the address only with increment mode.
      *
      * @param timeout
      *      Timeout in case of blocking transaction, otherwise use
@@ -273,14 +328,17 @@ public:
      *      The MSB of the (40Bit) remote memory address
      *
      * @param buffer
-     *      A Slice where received data bytes will be stored
+     *      A Slice where received data bytes will be stored. Buffers
+     *      longer than getMaximumDataLength() are read with several
+     *      commands, which increment the address only with increment mode.
      *
      * @param timeout
      *      Timeout for the SpW read operation
      *
      * @return
      *      Description of the result, will implicitly cast to true in success case and false
-     * otherwise
+     * otherwise. A split read stops at the first failed command, the
+     * number of read bytes is the sum over all commands.
      */
 
     RmapResult
@@ -291,6 +349,206 @@ public:
          outpost::Slice<uint8_t> const& buffer,
          const outpost::time::Duration& timeout = outpost::time::Duration::maximum());
 
+    /**
+     * Read from remote memory without copying the received data.
+     *
+     * Blocks like the other read operations. Instead of copying the reply
+     * the data field of the received packet is returned as child of the
+     * receive buffer. The receive buffer is kept as long as the child
+     * pointer, or copies of it, exist. Only rmap::numberOfReceiveBuffers
+     * receive buffers are available, the data should be released
+     * quickly.
+     *
+     * @param targetNode
+     *      Reference to the target node object found from the list
+     *
+     * @param options
+     *      contains the options with which the command is executed
+     *
+     * @param memoryAddress
+     *      Actual remote memory address where the data is being read from
+     *
+     * @param extendedMemoryAddress
+     *      The MSB of the (40Bit) remote memory address
+     *
+     * @param length
+     *      Number of bytes to read, at most getMaximumDataLength()
+     *
+     * @param data
+     *      Set to the received data if the result is "success" or
+     *      "replyTooShort", invalid otherwise
+     *
+     * @param timeout
+     *      Timeout for the SpW read operation
+     *
+     * @return
+     *      Description of the result, will implicitly cast to true in success case and false
+     * otherwise
+     */
+    RmapResult
+    read(RmapTargetNode& rmapTargetNode,
+         const RMapOptions& options,
+         uint32_t memoryAddress,
+         uint8_t extendedMemoryAdress,
+         size_t length,
+         outpost::utils::SharedChildPointer& data,
+         const outpost::time::Duration& timeout = outpost::time::Duration::maximum());
+
+    /**
+     * Start a read from remote memory without waiting for the reply.
+     *
+     * The reply is handled by the receiver thread, which copies the data
+     * to the buffer, stores the result in the request and calls the
+     * completion handler of the request. A request for which no reply
+     * arrives keeps its transaction until wait() or cancel() is called.
+     *
+     * @param targetNode
+     *      Reference to the target node object found from the list
+     *
+     * @param options
+     *      contains the options with which the command is executed
+     *
+     * @param memoryAddress
+     *      Actual remote memory address where the data is being read from
+     *
+     * @param extendedMemoryAddress
+     *      The MSB of the (40Bit) remote memory address
+     *
+     * @param buffer
+     *      A Slice where received data bytes will be stored, must stay
+     *      valid until the request is finished
+     *
+     * @param request
+     *      Handle for the operation, must not be pending
+     *
+     * @param timeout
+     *      Timeout for sending the command
+     *
+     * @return
+     *      true if the command was sent. Otherwise the reason is available
+     *      through request.getResult() and the completion handler is not
+     *      called. Returns false without changing the request if it is
+     *      still pending.
+     */
+    bool
+    submitRead(RmapTargetNode& rmapTargetNode,
+               const RMapOptions& options,
+               uint32_t memoryAddress,
+               uint8_t extendedMemoryAdress,
+               outpost::Slice<uint8_t> const& buffer,
+               RmapRequest& request,
+               const outpost::time::Duration& timeout = outpost::time::Seconds(1));
+
+    /**
+     * Read a list of scattered memory locations of one target.
+     *
+     * The reads are sent back-to-back using up to
+     * rmap::maxConcurrentTransactions transactions, the function returns
+     * once all replies are received or timed out. With increment mode
+     * consecutive elements of adjacent address ranges are coalesced into
+     * a single RMAP read of up to rmap::bufferSize bytes, the reply is
+     * distributed over the element buffers.
+     *
+     * @param targetNode
+     *      Reference to the target node object found from the list
+     *
+     * @param options
+     *      contains the options with which the commands are executed
+     *
+     * @param extendedMemoryAddress
+     *      The MSB of the (40Bit) remote memory address, common to all elements
+     *
+     * @param elements
+     *      Locations to read, the result of each element is stored in
+     *      the element
+     *
+     * @param timeout
+     *      Timeout for sending a command and for waiting for each reply
+     *
+     * @return
+     *      Success if all elements were read completely, otherwise the first
+     *      failure. The number of read bytes is the sum over all elements.
+     */
+    RmapResult
+    readBatch(RmapTargetNode& rmapTargetNode,
+              const RMapOptions& options,
+              uint8_t extendedMemoryAdress,
+              outpost::Slice<RmapReadElement> const& elements,
+              const outpost::time::Duration& timeout = outpost::time::Seconds(1));
+
+    /**
+     * Start a write to remote memory without waiting for the reply.
+     *
+     * Without reply mode the request is finished as soon as the command
+     * is sent, the completion handler is then called from the calling
+     * thread.
+     *
+     * @param targetNode
+     *      Reference to the target node object found from the list
+     *
+     * @param options
+     *      contains the options with which the command is executed
+     *
+     * @param memoryAddress
+     *      Actual remote memory address where the data is being written
+     *
+     * @param extendedMemoryAddress
+     *      The MSB of the (40Bit) remote memory address
+     *
+     * @param data
+     *      A Slice containing the data to write, copied into the command
+     *
+     * @param request
+     *      Handle for the operation, must not be pending
+     *
+     * @param timeout
+     *      Timeout for sending the command
+     *
+     * @return
+     *      true if the command was sent, see submitRead().
+     */
+    bool
+    submitWrite(RmapTargetNode& rmapTargetNode,
+                const RMapOptions& options,
+                uint32_t memoryAddress,
+                uint8_t extendedMemoryAdress,
+                outpost::Slice<const uint8_t> const& data,
+                RmapRequest& request,
+                const outpost::time::Duration& timeout = outpost::time::Seconds(1));
+
+    /**
+     * Wait for a submitted request to finish.
+     *
+     * If no reply arrives in time the request is cancelled and finishes
+     * with RmapResult::Code::timeout.
+     *
+     * @param request
+     *      Handle passed to submitRead() or submitWrite()
+     *
+     * @param timeout
+     *      Maximum time to wait for the reply
+     *
+     * @return
+     *      Result of the request
+     */
+    RmapResult
+    wait(RmapRequest& request,
+         const outpost::time::Duration& timeout = outpost::time::Duration::maximum());
+
+    /**
+     * Abandon a pending request and free its transaction.
+     *
+     * A reply arriving later is counted as unknown transaction. The
+     * completion handler is not called and the result of the request is
+     * set to RmapResult::Code::timeout.
+     *
+     * @return
+     *      true if the request was pending, false if it had already
+     *      finished.
+     */
+    bool
+    cancel(RmapRequest& request);
+
     //--------------------------------------------------------------------------
 
     inline size_t
@@ -299,19 +557,85 @@ public:
         return mTransactionsList.getNumberOfActiveTransactions();
     }
 
+    /**
+     * Highest number of transactions in use at the same time since the
+     * start or the last call of resetPeakActiveTransactions().
+     *
+     * Reaching the number of available transactions means that requests
+     * may have been rejected with RmapResult::Code::noFreeTransactions.
+     */
+    inline size_t
+    getPeakActiveTransactions() const
+    {
+        return mPeakActiveTransactions;
+    }
+
+    void
+    resetPeakActiveTransactions();
+
+    /**
+     * Maximum number of data bytes of a single read or write command.
+     */
+    inline uint16_t
+    getMaximumDataLength() const
+    {
+        return mMaximumDataLength;
+    }
+
     inline ErrorCounters
     getErrorCounters() const
     {
-        return mCounters;
+        ErrorCounters counters;
+        counters.mUnknownTransactionID = mCounters.get(unknownTransactionID);
+        counters.mPackageCrcError = mCounters.get(packageCrcError);
+        counters.mIncorrectOperation = mCounters.get(incorrectOperation);
+        counters.mInvalidSize = mCounters.get(invalidSize);
+        counters.mOperationFailed = mCounters.get(operationFailed);
+        counters.mSpacewireFailure = mCounters.get(spacewireFailure);
+        return counters;
     }
 
     inline void
     resetErrorCounters()
     {
-        mCounters = ErrorCounters();
+        mCounters.reset();
+    }
+
+    /**
+     * Limit the heartbeat ticks to one per \p interval.
+     *
+     * By default a tick is sent for every received package, which results
+     * in a high rate of ticks for high package rates.
+     *
+     * \warning Must be called before init().
+     */
+    inline void
+    setHeartbeatInterval(outpost::time::Clock& clock, outpost::time::Duration interval)
+    {
+        mHeartbeat.setInterval(clock, interval);
     }
 
+protected:
+    RmapInitiatorBase(hal::SpaceWireMultiProtocolHandlerInterface& spw,
+                      RmapTargetsList* list,
+                      uint8_t priority,
+                      size_t stackSize,
+                      outpost::support::parameter::HeartbeatSource heartbeatSource,
+                      uint8_t initiatorLogicalAddress,
+                      const Storage& storage);
+
 private:
+    enum ErrorCounter
+    {
+        unknownTransactionID,
+        packageCrcError,
+        incorrectOperation,
+        invalidSize,
+        operationFailed,
+        spacewireFailure,
+        numberOfErrorCounters
+    };
+
     virtual void
     run() override;
 
@@ -328,6 +652,9 @@ private:
         if (mStopped == false)
         {
             mStopped = true;
+
+            // Wake up the receiver thread
+            mEvents.set(stopEvent);
         }
     }
 
@@ -347,21 +674,202 @@ private:
     sendPacket(RmapTransaction* transaction);
 
     bool
-    receivePacket(RmapPacket* rxedPacket, outpost::utils::SharedBufferPointer& rxBuffer);
+    receivePacket(RmapPacketView* rxedPacket, outpost::utils::SharedBufferPointer& rxBuffer);
 
     void
-    handleReplyPacket(RmapPacket* packet, outpost::utils::SharedBufferPointer& rxBuffer);
+    handleReplyPacket(const RmapPacketView* packet, outpost::utils::SharedBufferPointer& rxBuffer);
+
+    /**
+     * Assign a reply to its transaction, requires mOperationLock to be
+     * locked by the current thread.
+     *
+     * \return
+     *      The asynchronous request finished by the reply, nullptr otherwise.
+     */
+    RmapRequest*
+    assignReplyPacket(const RmapPacketView* packet, outpost::utils::SharedBufferPointer& rxBuffer);
 
     RmapTransaction*
-    resolveTransaction(RmapPacket* packet);
+    resolveTransaction(const RmapPacketView* packet);
 
     /**
-     * Returns a free Transaction ID,
-     * requires mOperationLock to be lock to current thread
-     * to prevent race conditions
+     * Reserve a free transaction and assign a transaction ID.
+     *
+     * \retval nullptr if all transactions are in use
      */
-    uint16_t
-    getNextAvailableTransactionID();
+    RmapTransaction*
+    reserveTransaction();
+
+    void
+    prepareWriteCommand(RmapTransaction* transaction,
+                        RmapTargetNode& rmapTargetNode,
+                        const RMapOptions& options,
+                        uint32_t memoryAddress,
+                        uint8_t extendedMemoryAdress,
+                        outpost::Slice<const uint8_t> const& data);
+
+    void
+    prepareReadCommand(RmapTransaction* transaction,
+                       RmapTargetNode& rmapTargetNode,
+                       const RMapOptions& options,
+                       uint32_t memoryAddress,
+                       uint8_t extendedMemoryAdress,
+                       size_t length);
+
+    /**
+     * Send a read command and wait for the reply.
+     *
+     * Uses and repeats the command according to the adaptive timeout of
+     * the target.
+     *
+     * \param transaction
+     *      Set to the used transaction, must be removed with
+     *      removeBlockingTransaction() if not nullptr
+     *
+     * \retval true    Reply data is valid, result.getReadBytes() bytes are available
+     */
+    bool
+    executeRead(RmapTargetNode& rmapTargetNode,
+                const RMapOptions& options,
+                uint32_t memoryAddress,
+                uint8_t extendedMemoryAdress,
+                size_t length,
+                const outpost::time::Duration& timeout,
+                RmapTransaction*& transaction,
+                RmapResult& result);
+
+    /**
+     * Single attempt of executeRead() with a validated length.
+     */
+    bool
+    executeReadOnce(RmapTargetNode& rmapTargetNode,
+                    const RMapOptions& options,
+                    uint32_t memoryAddress,
+                    uint8_t extendedMemoryAdress,
+                    size_t length,
+                    const outpost::time::Duration& timeout,
+                    RmapTransaction*& transaction,
+                    RmapResult& result);
+
+    /**
+     * Single attempt of write() with data of at most mMaximumDataLength bytes.
+     */
+    RmapResult
+    writeOnce(RmapTargetNode& rmapTargetNode,
+              const RMapOptions& options,
+              uint32_t memoryAddress,
+              uint8_t extendedMemoryAdress,
+              outpost::Slice<const uint8_t> const& data,
+              const outpost::time::Duration& timeout);
+
+    void
+    removeBlockingTransaction(RmapTransaction* transaction);
+
+    /**
+     * Evaluate the reply of a write command, requires the state replyReceived.
+     */
+    void
+    evaluateWriteReply(RmapTransaction* transaction, RmapResult& result);
+
+    /**
+     * Evaluate the reply of a read command, requires the state replyReceived.
+     *
+     * \param length
+     *      Number of requested bytes
+     *
+     * \retval true    Received data can be copied, result.getReadBytes() bytes are valid
+     */
+    bool
+    evaluateReadReply(RmapTransaction* transaction, size_t length, RmapResult& result);
+
+    /**
+     * Copy the data of a read reply to the buffer or scatter list of a request.
+     */
+    static void
+    copyReadData(outpost::Slice<const uint8_t> const& data, RmapRequest& request);
+
+    /**
+     * Reserve and send a read command for an asynchronous request, the
+     * destination of the data has to be set in the request.
+     */
+    bool
+    startRead(RmapTargetNode& rmapTargetNode,
+              const RMapOptions& options,
+              uint32_t memoryAddress,
+              uint8_t extendedMemoryAdress,
+              size_t length,
+              RmapRequest& request,
+              const outpost::time::Duration& timeout);
+
+    /**
+     * Read or write more than mMaximumDataLength bytes.
+     *
+     * The data is split into commands of the maximum data length which
+     * are kept in flight on up to rmap::maxConcurrentTransactions
+     * transactions. No further commands are sent after the first failed
+     * command.
+     *
+     * \param readBuffer
+     *      Destination of a read, empty for a write.
+     * \param writeData
+     *      Data of a write, empty for a read.
+     */
+    RmapResult
+    transferChunks(RmapTargetNode& rmapTargetNode,
+                   const RMapOptions& options,
+                   uint32_t memoryAddress,
+                   uint8_t extendedMemoryAdress,
+                   outpost::Slice<uint8_t> const& readBuffer,
+                   outpost::Slice<const uint8_t> const& writeData,
+                   const outpost::time::Duration& timeout);
+
+    /**
+     * Number of leading elements which can be read with a single command.
+     */
+    static size_t
+    getCoalescedElements(const RMapOptions& options,
+                         outpost::Slice<RmapReadElement> const& elements,
+                         size_t maximumLength);
+
+    /**
+     * Store the result of a (coalesced) read in its elements.
+     */
+    static void
+    finishReadElements(outpost::Slice<RmapReadElement> const& elements,
+                       const RmapResult& groupResult,
+                       RmapResult& batchResult);
+
+    /**
+     * Send the command of a prepared transaction on behalf of an
+     * asynchronous request.
+     */
+    bool
+    startRequest(RmapTransaction* transaction, RmapRequest& request);
+
+    /**
+     * Free the transaction of a request and mark it as finished,
+     * requires mOperationLock to be locked by the current thread.
+     */
+    void
+    finishRequest(RmapRequest& request);
+
+    /**
+     * Inform the owner of a finished request, must be called without
+     * holding mOperationLock.
+     *
+     * \param sequence
+     *      RmapRequest::mSequence when the request was finished. Nothing
+     *      is done if the request has been submitted again since then.
+     */
+    void
+    notifyCompletion(RmapRequest& request, uint32_t sequence);
+
+    /**
+     * Record a request which did not receive a reply in the statistics
+     * of its target.
+     */
+    static void
+    recordTimeout(RmapTransaction* transaction);
 
     //--------------------------------------------------------------------------
     hal::SpaceWireMultiProtocolHandlerInterface& mSpW;
@@ -369,19 +877,124 @@ private:
     outpost::rtos::Mutex mOperationLock;
     const uint8_t mInitiatorLogicalAddress;
     volatile bool mStopped;
-    uint16_t mTransactionId;
     TransactionsList mTransactionsList;
+    const uint16_t mMaximumDataLength;
+
+    // Incremented by the receiver and the calling threads
+    outpost::utils::CounterBlock<numberOfErrorCounters> mCounters;
+    size_t mPeakActiveTransactions;
+    outpost::rtos::SystemClock mClock;
+
+    outpost::support::HeartbeatLimiter mHeartbeat;
+
+    outpost::utils::SharedBufferQueueBase& mQueue;
+    outpost::utils::SharedBufferPoolBase& mPool;
+
+    outpost::rtos::EventGroup mEvents;
+
+    // Set if the queue notifies mEvents, otherwise the receiver polls the queue
+    bool mEventNotification;
+};
+
+namespace internal
+{
+/**
+ * Memory of a GenericRmapInitiator.
+ *
+ * Base class of GenericRmapInitiator so that it is constructed before
+ * RmapInitiatorBase refers to it.
+ */
+template <uint8_t numberOfTransactions, uint16_t maxDataLength, uint8_t numberOfReceiveBuffers>
+class RmapInitiatorStorage
+{
+protected:
+    static constexpr uint16_t maxReplyLength =
+            rmap::readReplyOverhead + rmap::maxAddressLength + maxDataLength;
+
+    RmapInitiatorStorage() :
+        mTransactionStorage(),
+        mFreeTransactionStorage(),
+        mGenerationStorage(),
+        mQueueStorage(),
+        mPoolStorage()
+    {
+    }
 
-    ErrorCounters mCounters;
+    RmapInitiatorBase::Storage
+    getStorage()
+    {
+        return RmapInitiatorBase::Storage{outpost::asSlice(mTransactionStorage),
+                                          outpost::asSlice(mFreeTransactionStorage),
+                                          outpost::asSlice(mGenerationStorage),
+                                          mQueueStorage,
+                                          mPoolStorage,
+                                          maxDataLength};
+    }
 
-    const outpost::support::parameter::HeartbeatSource mHeartbeatSource;
+    RmapTransaction mTransactionStorage[numberOfTransactions];
+    uint8_t mFreeTransactionStorage[numberOfTransactions];
+    uint16_t mGenerationStorage[numberOfTransactions];
+    outpost::utils::SharedBufferQueue<numberOfReceiveBuffers> mQueueStorage;
+    outpost::utils::SharedBufferPool<maxReplyLength, numberOfReceiveBuffers> mPoolStorage;
+};
+}  // namespace internal
 
-    std::array<uint8_t, maxCommandLength> mSendBuffer;
+/**
+ * RMAP initiator with configurable resources.
+ *
+ * \tparam numberOfTransactions
+ *      Maximum number of concurrent transactions, 1..255.
+ * \tparam maxDataLength
+ *      Maximum number of data bytes of a single read or write command,
+ *      defines the size of the receive buffers.
+ * \tparam numberOfReceiveBuffers
+ *      How many reply packages can be queued, including the currently
+ *      processed one (i.e. min = 1).
+ */
+template <uint8_t numberOfTransactions,
+          uint16_t maxDataLength,
+          uint8_t numberOfReceiveBuffers = rmap::numberOfReceiveBuffers>
+class GenericRmapInitiator
+    : private internal::RmapInitiatorStorage<numberOfTransactions,
+                                             maxDataLength,
+                                             numberOfReceiveBuffers>,
+      public RmapInitiatorBase
+{
+    static_assert(numberOfTransactions > 0, "At least one transaction required");
+    static_assert(maxDataLength > 0, "Data length must not be zero");
+    static_assert(numberOfReceiveBuffers > 0, "At least one receive buffer required");
+    static_assert(maxDataLength <= 0xFFFF - rmap::readReplyOverhead - rmap::maxAddressLength,
+                  "Reply does not fit into a receive buffer");
 
-    outpost::utils::SharedBufferQueue<rmap::numberOfReceiveBuffers> mQueue;
-    outpost::utils::SharedBufferPool<maxReplyLength, rmap::numberOfReceiveBuffers> mPool;
+public:
+    GenericRmapInitiator(hal::SpaceWireMultiProtocolHandlerInterface& spw,
+                         RmapTargetsList* list,
+                         uint8_t priority,
+                         size_t stackSize,
+                         outpost::support::parameter::HeartbeatSource heartbeatSource,
+                         uint8_t initiatorLogicalAddress = rmap::defaultLogicalAddress) :
+        internal::RmapInitiatorStorage<numberOfTransactions,
+                                       maxDataLength,
+                                       numberOfReceiveBuffers>(),
+        RmapInitiatorBase(spw,
+                          list,
+                          priority,
+                          stackSize,
+                          heartbeatSource,
+                          initiatorLogicalAddress,
+                          this->getStorage())
+    {
+    }
 };
 
+/**
+ * RMAP initiator with the default resources of rmap_common.h.
+ */
+typedef GenericRmapInitiator<rmap::maxConcurrentTransactions,
+                             rmap::bufferSize,
+                             rmap::numberOfReceiveBuffers>
+        RmapInitiator;
+
 }  // namespace comm
 }  // namespace outpost
 
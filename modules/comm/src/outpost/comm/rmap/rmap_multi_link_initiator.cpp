@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "rmap_multi_link_initiator.h"
+
+#include <outpost/utils/log/log.h>
+
+using namespace outpost::comm;
+
+constexpr size_t RmapMultiLinkInitiator::probeInterval;
+
+RmapMultiLinkInitiator::RmapMultiLinkInitiator(outpost::Slice<RmapLink> const& links,
+                                               Distribution distribution) :
+    mLinks(links), mDistribution(distribution), mNextLink(0), mLock()
+{
+    if (mLinks.getNumberOfElements() == 0)
+    {
+        OUTPOST_LOG("RMAP-MultiLink: no links, all requests are rejected\n");
+    }
+}
+
+RmapResult
+RmapMultiLinkInitiator::read(RmapTargetNode& rmapTargetNode,
+                             const RMapOptions& options,
+                             uint32_t memoryAddress,
+                             uint8_t extendedMemoryAdress,
+                             outpost::Slice<uint8_t> const& buffer,
+                             const outpost::time::Duration& timeout)
+{
+    return execute(rmapTargetNode, [&](RmapInitiatorBase& initiator) {
+        return initiator.read(
+                rmapTargetNode, options, memoryAddress, extendedMemoryAdress, buffer, timeout);
+    });
+}
+
+RmapResult
+RmapMultiLinkInitiator::write(RmapTargetNode& rmapTargetNode,
+                              const RMapOptions& options,
+                              uint32_t memoryAddress,
+                              uint8_t extendedMemoryAdress,
+                              outpost::Slice<const uint8_t> const& data,
+                              const outpost::time::Duration& timeout)
+{
+    return execute(rmapTargetNode, [&](RmapInitiatorBase& initiator) {
+        return initiator.write(
+                rmapTargetNode, options, memoryAddress, extendedMemoryAdress, data, timeout);
+    });
+}
+
+RmapLink
+RmapMultiLinkInitiator::getLink(size_t index)
+{
+    outpost::rtos::MutexGuard lock(mLock);
+    return mLinks[index];
+}
+
+template <typename Transfer>
+RmapResult
+RmapMultiLinkInitiator::execute(const RmapTargetNode& rmapTargetNode, Transfer transfer)
+{
+    const size_t numberOfLinks = mLinks.getNumberOfElements();
+    RmapResult result;
+    if (numberOfLinks == 0)
+    {
+        result.mResult = RmapResult::Code::invalidParameters;
+        return result;
+    }
+
+    size_t index = selectLink(rmapTargetNode);
+    for (size_t attempt = 0; attempt < numberOfLinks; attempt++)
+    {
+        // The initiator of a link is never changed, no lock required
+        result = transfer(*mLinks[index].mInitiator);
+        recordResult(index, result);
+        if (!isLinkFailure(result))
+        {
+            break;
+        }
+
+        index = (index + 1) % numberOfLinks;
+        if (attempt + 1 < numberOfLinks)
+        {
+            OUTPOST_LOG("RMAP-MultiLink: retry on link %u\n", index);
+        }
+    }
+    return result;
+}
+
+size_t
+RmapMultiLinkInitiator::selectLink(const RmapTargetNode& rmapTargetNode)
+{
+    outpost::rtos::MutexGuard lock(mLock);
+
+    const size_t numberOfLinks = mLinks.getNumberOfElements();
+    size_t preferred;
+    if (mDistribution == Distribution::byTarget)
+    {
+        preferred = rmapTargetNode.getTargetLogicalAddress() % numberOfLinks;
+    }
+    else
+    {
+        preferred = mNextLink;
+        mNextLink = (mNextLink + 1) % numberOfLinks;
+    }
+
+    // Use the first link without a recent failure, the preferred link if all failed
+    for (size_t i = 0; i < numberOfLinks; i++)
+    {
+        RmapLink& link = mLinks[(preferred + i) % numberOfLinks];
+        if (link.mSkip == 0)
+        {
+            return (preferred + i) % numberOfLinks;
+        }
+        link.mSkip--;
+    }
+    return preferred;
+}
+
+void
+RmapMultiLinkInitiator::recordResult(size_t index, const RmapResult& result)
+{
+    outpost::rtos::MutexGuard lock(mLock);
+
+    RmapLink& link = mLinks[index];
+    link.mRequests++;
+    if (isLinkFailure(result))
+    {
+        link.mFailures++;
+        link.mSkip = probeInterval;
+    }
+    else
+    {
+        link.mSkip = 0;
+    }
+}
+
+bool
+RmapMultiLinkInitiator::isLinkFailure(const RmapResult& result)
+{
+    // Other results are caused by the target or the parameters and are the same on all links
+    switch (result.getResult())
+    {
+        case RmapResult::Code::timeout:
+        case RmapResult::Code::sendFailed:
+        case RmapResult::Code::noFreeTransactions: return true;
+        default: return false;
+    }
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMM_RMAP_MULTI_LINK_INITIATOR_H_
+#define OUTPOST_COMM_RMAP_MULTI_LINK_INITIATOR_H_
+
+#include "rmap_initiator.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/rtos.h>
+#include <outpost/time/duration.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace comm
+{
+/**
+ * SpaceWire link of a RmapMultiLinkInitiator.
+ */
+struct RmapLink
+{
+    explicit RmapLink(RmapInitiatorBase& initiator) :
+        mInitiator(&initiator), mFailures(0), mRequests(0), mSkip(0)
+    {
+    }
+
+    /// Initiator bound to the SpaceWire interface of the link
+    RmapInitiatorBase* mInitiator;
+
+    /// Number of requests which timed out or could not be sent on this link
+    size_t mFailures;
+
+    /// Number of requests sent through this link
+    size_t mRequests;
+
+    /// Number of selections for which the link is skipped after a failure
+    size_t mSkip;
+};
+
+/**
+ * RMAP initiator using several redundant SpaceWire links.
+ *
+ * Each link is served by its own initiator. The links must reach the
+ * targets with the same target node configuration, e.g. the nominal and
+ * the redundant router with the same port numbering.
+ *
+ * Requests are distributed over the links either by the logical address
+ * of the target, which keeps the order of the requests to one target,
+ * or round-robin. A request which times out or cannot be sent is
+ * retried on the next link. A link on which a request failed is skipped
+ * for the next probeInterval selections, afterwards it is used again.
+ *
+ * \warning A write which timed out may have been executed by the target
+ *          anyway and is executed a second time by the retry.
+ */
+class RmapMultiLinkInitiator
+{
+public:
+    enum class Distribution
+    {
+        byTarget,
+        roundRobin
+    };
+
+    /// Number of selections for which a failed link is skipped
+    static constexpr size_t probeInterval = 16;
+
+    /**
+     * \param links
+     *      Links to use. Without any link all requests fail with
+     *      RmapResult::Code::invalidParameters.
+     * \param distribution
+     *      Assignment of the requests to the links.
+     */
+    RmapMultiLinkInitiator(outpost::Slice<RmapLink> const& links,
+                           Distribution distribution = Distribution::byTarget);
+
+    // disable copy constructor
+    RmapMultiLinkInitiator(const RmapMultiLinkInitiator&) = delete;
+
+    // disable assignment operator
+    RmapMultiLinkInitiator&
+    operator=(const RmapMultiLinkInitiator&) = delete;
+
+    /**
+     * Read from remote memory, see RmapInitiatorBase::read().
+     *
+     * \param timeout
+     *      Timeout per link. The request is retried on the next link
+     *      after a timeout, the total duration can be a multiple of it.
+     */
+    RmapResult
+    read(RmapTargetNode& rmapTargetNode,
+         const RMapOptions& options,
+         uint32_t memoryAddress,
+         uint8_t extendedMemoryAdress,
+         outpost::Slice<uint8_t> const& buffer,
+         const outpost::time::Duration& timeout = outpost::time::Seconds(1));
+
+    /**
+     * Write remote memory, see RmapInitiatorBase::write().
+     *
+     * \param timeout
+     *      Timeout per link, see read().
+     */
+    RmapResult
+    write(RmapTargetNode& rmapTargetNode,
+          const RMapOptions& options,
+          uint32_t memoryAddress,
+          uint8_t extendedMemoryAdress,
+          outpost::Slice<const uint8_t> const& data,
+          const outpost::time::Duration& timeout = outpost::time::Seconds(1));
+
+    inline size_t
+    getNumberOfLinks() const
+    {
+        return mLinks.getNumberOfElements();
+    }
+
+    /**
+     * Copy of the state of a link, updated by every request.
+     */
+    RmapLink
+    getLink(size_t index);
+
+private:
+    /**
+     * Execute \p transfer on the selected link and on the other links
+     * until it succeeds or fails for a reason independent of the link.
+     */
+    template <typename Transfer>
+    RmapResult
+    execute(const RmapTargetNode& rmapTargetNode, Transfer transfer);
+
+    size_t
+    selectLink(const RmapTargetNode& rmapTargetNode);
+
+    void
+    recordResult(size_t index, const RmapResult& result);
+
+    static bool
+    isLinkFailure(const RmapResult& result);
+
+    const outpost::Slice<RmapLink> mLinks;
+    const Distribution mDistribution;
+    size_t mNextLink;
+
+    // Protects mLinks and mNextLink
+    outpost::rtos::Mutex mLock;
+};
+
+}  // namespace comm
+}  // namespace outpost
+
+#endif
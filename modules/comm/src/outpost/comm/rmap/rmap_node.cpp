@@ -17,6 +17,8 @@
 #include "rmap_packet.h"
 #include "rmap_status.h"
 
+#include <outpost/utils/log/log.h>
+
 using namespace outpost::comm;
 
 //------------------------------------------------------------------------------
@@ -27,7 +29,9 @@ RmapTargetNode::RmapTargetNode() :
     mReplyAddress(),
     mTargetLogicalAddress(rmap::defaultLogicalAddress),
     mKey(0),
-    mId(0)
+    mId(0),
+    mStatistics(),
+    mAdaptiveTimeout()
 {
     strcpy(mName, "Default");
     memset(mTargetSpaceWireAddress, 0, sizeof(mTargetSpaceWireAddress));
@@ -42,7 +46,9 @@ RmapTargetNode::RmapTargetNode(const char* name,
     mReplyAddressLength(0),
     mTargetLogicalAddress(targetLogicalAddress),
     mKey(key),
-    mId(id)
+    mId(id),
+    mStatistics(),
+    mAdaptiveTimeout()
 {
     if (strlen(name) < rmap::maxNodeNameLength)
     {
@@ -90,7 +96,7 @@ RmapTargetNode::setTargetSpaceWireAddress(outpost::Slice<uint8_t> targetSpaceWir
 }
 
 //------------------------------------------------------------------------------
-RmapTargetsList::RmapTargetsList() : mNodes(), mSize(0)
+RmapTargetsList::RmapTargetsList() : mNodes(), mNameHashes(), mLogicalAddressIndex(), mSize(0)
 {
 }
 
@@ -98,11 +104,11 @@ RmapTargetsList::~RmapTargetsList()
 {
 }
 
-RmapTargetsList::RmapTargetsList(outpost::Slice<RmapTargetNode*> rmapTargetNodes)
+RmapTargetsList::RmapTargetsList(outpost::Slice<RmapTargetNode*> rmapTargetNodes) :
+    mNodes(), mNameHashes(), mLogicalAddressIndex(), mSize(0)
 {
     if (rmapTargetNodes.getNumberOfElements() <= rmap::maxAddressLength)
     {
-        mSize = rmapTargetNodes.getNumberOfElements();
         addTargetNodes(rmapTargetNodes);
     }
 }
@@ -114,7 +120,14 @@ RmapTargetsList::addTargetNode(RmapTargetNode* node)
 
     if (mSize < rmap::maxAddressLength)
     {
+        mNameHashes[mSize] = getNameHash(node->getName());
         mNodes[mSize++] = node;
+
+        uint8_t& index = mLogicalAddressIndex[node->getTargetLogicalAddress()];
+        if (index == 0)
+        {
+            index = mSize;
+        }
         result = true;
     }
     return result;
@@ -126,7 +139,7 @@ RmapTargetsList::addTargetNodes(outpost::Slice<RmapTargetNode*> nodes)
     bool result = false;
     size_t listElements = nodes.getNumberOfElements();
 
-    if ((listElements + mSize) < rmap::maxAddressLength)
+    if ((listElements + mSize) <= rmap::maxAddressLength)
     {
         for (size_t i = 0; i < listElements; i++)
         {
@@ -146,10 +159,12 @@ RmapTargetsList::getTargetNode(const char* name)
     }
 
     RmapTargetNode* rt = nullptr;
+    const uint32_t hash = getNameHash(name);
 
     for (uint8_t i = 0; i < mSize; i++)
     {
-        if (!strncmp(mNodes[i]->getName(), name, rmap::maxNodeNameLength))
+        if ((mNameHashes[i] == hash)
+            && !strncmp(mNodes[i]->getName(), name, rmap::maxNodeNameLength))
         {
             rt = mNodes[i];
             break;
@@ -164,6 +179,43 @@ RmapTargetsList::getTargetNode(uint8_t logicalAddress)
 {
     RmapTargetNode* rt = nullptr;
 
+    const uint8_t index = mLogicalAddressIndex[logicalAddress];
+    if ((index != 0) && (mNodes[index - 1]->getTargetLogicalAddress() == logicalAddress))
+    {
+        rt = mNodes[index - 1];
+    }
+    else
+    {
+        // No node had the address when it was added or the indexed node
+        // got a new address, search for nodes whose address was changed
+        rt = findTargetNode(logicalAddress);
+    }
+
+    if (!rt)
+    {
+        OUTPOST_LOG("Error: No such RMAP target node\n");
+    }
+
+    return rt;
+}
+
+uint32_t
+RmapTargetsList::getNameHash(const char* name)
+{
+    // FNV-1a over the significant characters of the name
+    uint32_t hash = 2166136261UL;
+    for (uint8_t i = 0; (i < rmap::maxNodeNameLength) && (name[i] != '\0'); i++)
+    {
+        hash = (hash ^ static_cast<uint8_t>(name[i])) * 16777619UL;
+    }
+    return hash;
+}
+
+RmapTargetNode*
+RmapTargetsList::findTargetNode(uint8_t logicalAddress)
+{
+    RmapTargetNode* rt = nullptr;
+
     for (uint8_t i = 0; i < mSize; i++)
     {
         if (mNodes[i]->getTargetLogicalAddress() == logicalAddress)
@@ -173,10 +225,5 @@ RmapTargetsList::getTargetNode(uint8_t logicalAddress)
         }
     }
 
-    if (!rt)
-    {
-        console_out("Error: No such RMAP target node\n");
-    }
-
     return rt;
 }
@@ -16,6 +16,7 @@
 #define OUTPOST_COMM_RMAP_NODE_H_
 
 #include "rmap_common.h"
+#include "rmap_statistics.h"
 
 #include <outpost/base/slice.h>
 
@@ -116,6 +117,44 @@ public:
         return mId;
     }
 
+    /**
+     * Performance statistics of the transactions with this target.
+     *
+     * Updated by every initiator which accesses the target.
+     */
+    inline RmapTargetStatistics&
+    getStatistics()
+    {
+        return mStatistics;
+    }
+
+    inline const RmapTargetStatistics&
+    getStatistics() const
+    {
+        return mStatistics;
+    }
+
+    /**
+     * Replace the timeouts of blocking reads and writes by a timeout
+     * derived from the measured round-trip latency.
+     *
+     * The timeout given to the read or write is only used as upper limit
+     * for all attempts together, a retry only gets the remaining time.
+     * With retries a request is repeated after a timeout, which executes
+     * a write a second time if only its reply was lost.
+     */
+    inline void
+    setAdaptiveTimeout(const RmapAdaptiveTimeout& adaptiveTimeout)
+    {
+        mAdaptiveTimeout = adaptiveTimeout;
+    }
+
+    inline const RmapAdaptiveTimeout&
+    getAdaptiveTimeout() const
+    {
+        return mAdaptiveTimeout;
+    }
+
 private:
     // TODO Replace with bounded array
     uint8_t mTargetSpaceWireAddressLength;
@@ -127,6 +166,8 @@ private:
     uint8_t mKey;
     char mName[rmap::maxNodeNameLength];
     uint8_t mId;
+    RmapTargetStatistics mStatistics;
+    RmapAdaptiveTimeout mAdaptiveTimeout;
 };
 
 //------------------------------------------------------------------------------
@@ -135,6 +176,19 @@ private:
  *
  * Provides the list for RMAP targets to be used by the RMAP initiator class.
  *
+ * Lookups do not walk the list. The logical address is resolved through
+ * a table indexed by the address, names are compared against a hash
+ * computed when adding the node and only matching hashes are compared
+ * character by character. On high-rate paths the node should still be
+ * resolved once and passed to the RmapTargetNode& overloads of the
+ * initiator.
+ *
+ * The name of a node is fixed at construction, so its hash stays valid.
+ * The table of logical addresses is only updated when adding nodes. If
+ * the address of a node is changed afterwards with
+ * RmapTargetNode::setTargetLogicalAddress(), lookups of the new address
+ * search the list.
+ *
  * \author  Muhammad Bassam
  */
 class RmapTargetsList
@@ -184,11 +238,13 @@ public:
     /**
      * Get RMAP target node from the list
      *
-     * \param name
+     * \param logicalAddress
      *      Target logical address
      *
      * \return
-     *      Pointer to the node if found, otherwise nullptr
+     *      Pointer to the node if found, otherwise nullptr. If several
+     *      nodes share the address the first one added is returned,
+     *      unless addresses have been changed after adding the nodes.
      * */
     RmapTargetNode*
     getTargetNode(uint8_t logicalAddress);
@@ -207,8 +263,18 @@ public:
     }
 
 private:
+    static uint32_t
+    getNameHash(const char* name);
+
+    RmapTargetNode*
+    findTargetNode(uint8_t logicalAddress);
+
     // TODO Replace with bounded array
     RmapTargetNode* mNodes[rmap::maxAddressLength];
+    uint32_t mNameHashes[rmap::maxAddressLength];
+
+    // Index + 1 of the first node with the logical address, 0 if there is none
+    uint8_t mLogicalAddressIndex[256];
     uint8_t mSize;
 };
 }  // namespace comm
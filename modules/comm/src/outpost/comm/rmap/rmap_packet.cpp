@@ -13,8 +13,10 @@
  */
 
 #include "rmap_packet.h"
+#include "rmap_packet_view.h"
 
 #include <outpost/utils/coding/crc.h>
+#include <outpost/utils/log/log.h>
 
 using namespace outpost::comm;
 
@@ -104,8 +106,22 @@ RmapPacket::~RmapPacket()
 void
 RmapPacket::reset()
 {
-    RmapPacket empty;
-    *this = empty;
+    mSpwTargetAddressLength = 0;
+    memset(mSpwTargets, 0, sizeof(mSpwTargets));
+    mTargetLogicalAddress = rmap::defaultLogicalAddress;
+    mInstruction.reset();
+    mDestKey = 0;
+    memset(mReplyAddress, 0, sizeof(mReplyAddress));
+    mInitiatorLogicalAddress = rmap::defaultLogicalAddress;
+    mExtendedAddress = rmap::defaultExtendedAddress;
+    mTransactionIdentifier = 0;
+    mAddress = 0;
+    mDataLength = 0;
+    mStatus = RmapReplyStatus::unknown;
+    mHeaderLength = 0;
+    mData = Slice<const uint8_t>::empty();
+    mHeaderCRC = 0;
+    mDataCRC = 0;
 }
 
 void
@@ -113,7 +129,9 @@ RmapPacket::setData(const outpost::Slice<const uint8_t>& data)
 {
     mData = data;
     mDataLength = data.getNumberOfElements();
-    mDataCRC = outpost::Crc8CcittReversed::calculate(data);
+
+    // Calculated while copying the data in constructPacket()
+    mDataCRC = 0;
 }
 
 bool
@@ -125,7 +143,7 @@ RmapPacket::constructPacket(outpost::Slice<uint8_t>& buffer)
 
     if (buffer.getNumberOfElements() < headerLength)
     {
-        console_out("RMAP-Packet: Trying to send larger packet than available buffer space\n");
+        OUTPOST_LOG("RMAP-Packet: Trying to send larger packet than available buffer space\n");
         return false;
     }
 
@@ -140,7 +158,7 @@ RmapPacket::constructPacket(outpost::Slice<uint8_t>& buffer)
         // Check that the data can fit into the buffer, 1 byte for data crc
         if ((buffer.getNumberOfElements() < headerLength + mDataLength + 1))
         {
-            console_out("RMAP-Packet: Trying to send larger packet than available buffer "
+            OUTPOST_LOG("RMAP-Packet: Trying to send larger packet than available buffer "
                         "space\n");
             return false;
         }
@@ -148,12 +166,14 @@ RmapPacket::constructPacket(outpost::Slice<uint8_t>& buffer)
         // sanity check
         if (mData.getNumberOfElements() != mDataLength)
         {
-            console_out("RMAP-Packet: dataLength and provided data is not equal for write "
+            OUTPOST_LOG("RMAP-Packet: dataLength and provided data is not equal for write "
                         "command\n");
             return false;
         }
 
-        stream.store(mData);
+        mDataCRC = outpost::Crc8CcittReversed::calculateAndCopy(
+                mData, stream.getPointerToCurrentPosition());
+        stream.skip(mDataLength);
         stream.store<uint8_t>(mDataCRC);
     }
 
@@ -165,123 +185,30 @@ RmapPacket::constructPacket(outpost::Slice<uint8_t>& buffer)
 RmapPacket::ExtractionResult
 RmapPacket::extractReplyPacket(outpost::Slice<const uint8_t>& data, uint8_t initiatorLogicalAddress)
 {
-    if (data.getNumberOfElements() < rmap::minimumReplySize)
+    RmapPacketView view;
+    ExtractionResult result = view.parseReply(data, initiatorLogicalAddress);
+    if (result != ExtractionResult::success)
     {
-        console_out("RMAP-Packet: packet size less then minimum\n");
-        return ExtractionResult::invalid;
+        return result;
     }
 
-    outpost::Deserialize stream(data);
-    ptrdiff_t headerEndPosition;
-    uint8_t packetHeaderCRC;
-    uint8_t calculatedHeaderCRC;
-    uint8_t calculatedDataCRC;
-    uint8_t packetDataCRC;
-
-    uint8_t initiatoraLogicalAddress = stream.read<uint8_t>();
-
-    if (initiatoraLogicalAddress != initiatorLogicalAddress)
-    {
-        console_out("RMAP-Packet: Initiator logical address doesn't match\n");
-        return ExtractionResult::incorrectAddress;
-    }
-
-    uint8_t protocolIdentifiter = stream.read<uint8_t>();
-
-    if (protocolIdentifiter != rmap::protocolIdentifier)
-    {
-        console_out("RMAP-Packet: Protocol ID is not RMAP\n");
-        return ExtractionResult::invalid;
-    }
-
-    mInstruction.setAllRaw(stream.read<uint8_t>());
-
-    // If reply packet is received
-    if (isReplyPacket())
+    mInstruction.setAllRaw(view.getInstruction());
+    if (view.isReplyPacket())
     {
         memset(mReplyAddress, 0, rmap::maxAddressLength);
 
-        mInitiatorLogicalAddress = initiatoraLogicalAddress;
-        mStatus = stream.read<uint8_t>();
-
-        mTargetLogicalAddress = stream.read<uint8_t>();
-        mTransactionIdentifier = stream.read<uint16_t>();
-
-        // Write command reply
-        if (isWrite())
+        mInitiatorLogicalAddress = view.getInitiatorLogicalAddress();
+        mStatus = view.getStatus();
+        mTargetLogicalAddress = view.getTargetLogicalAddress();
+        mTransactionIdentifier = view.getTransactionID();
+        mHeaderLength = view.getHeaderLength();
+        mHeaderCRC = view.getHeaderCRC();
+        if (view.isRead())
         {
-            if (data.getNumberOfElements() != rmap::writeReplyOverhead)
-            {
-                console_out("RMAP-Packet: Incorrect size for write reply\n");
-                return ExtractionResult::invalid;
-            }
-            headerEndPosition = stream.getPosition();
-            packetHeaderCRC = stream.read<uint8_t>();
-
-            calculatedHeaderCRC = outpost::Crc8CcittReversed::calculate(
-                    outpost::Slice<uint8_t>::unsafe(const_cast<uint8_t*>(stream.getPointer()),
-                                                    static_cast<size_t>(headerEndPosition)));
-
-            if (calculatedHeaderCRC != packetHeaderCRC)
-            {
-                console_out("RMAP-Packet: invalid packet header CRC\n");
-                return ExtractionResult::crcError;
-            }
-            mHeaderCRC = packetHeaderCRC;
-        }
-        // Read command reply
-        else
-        {
-            if (data.getNumberOfElements() < rmap::readReplyOverhead)
-            {
-                console_out("RMAP-Packet: too small read reply\n");
-                return ExtractionResult::invalid;
-            }
-
-            // Skip the reserved byte
-            stream.skip(1);
-
-            // Read data length
-            mDataLength = stream.readUnsigned24();
-
-            // Get the header CRC
-            headerEndPosition = stream.getPosition();
-            packetHeaderCRC = stream.read<uint8_t>();
-
-            calculatedHeaderCRC = outpost::Crc8CcittReversed::calculate(
-                    outpost::Slice<uint8_t>::unsafe(const_cast<uint8_t*>(stream.getPointer()),
-                                                    static_cast<size_t>(headerEndPosition)));
-
-            if (calculatedHeaderCRC != packetHeaderCRC)
-            {
-                console_out("RMAP-Packet: Invalid packet header CRC\n");
-                return ExtractionResult::crcError;
-            }
-            mHeaderCRC = packetHeaderCRC;
-
-            // Check data length
-            if (mDataLength + rmap::readReplyOverhead != data.getNumberOfElements())
-            {
-                console_out("RMAP-Packet: data length mismatch\n");
-                return ExtractionResult::invalid;
-            }
-
-            mData = Slice<const uint8_t>::unsafe(stream.getPointerToCurrentPosition(), mDataLength);
-
-            // Skip the data byte to calculate data CRC
-            stream.skip(mDataLength);
-
-            packetDataCRC = stream.read<uint8_t>();
-
-            calculatedDataCRC = outpost::Crc8CcittReversed::calculate(mData);
-            if (packetDataCRC != calculatedDataCRC)
-            {
-                console_out("RMAP-Packet: Invalid packet data CRC\n");
-                return ExtractionResult::crcError;
-            }
-            mDataCRC = packetDataCRC;
+            mDataLength = view.getDataLength();
+            mData = view.getData();
+            mDataCRC = view.getDataCRC();
         }
-        mHeaderLength = headerEndPosition;
     }
 
     return ExtractionResult::success;
@@ -504,9 +504,19 @@ public:
         return mData;
     }
 
+    /**
+     * Set the data of a write command.
+     *
+     * The data is only referenced, it must stay valid until the packet
+     * has been constructed. The data CRC is calculated while copying the
+     * data into the packet buffer in constructPacket().
+     */
     void
     setData(const outpost::Slice<const uint8_t>& data);
 
+    /**
+     * Data CRC, available after constructPacket() or extractReplyPacket().
+     */
     inline uint8_t
     getDataCRC() const
     {
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "rmap_packet_view.h"
+
+#include <outpost/utils/coding/crc.h>
+#include <outpost/utils/log/log.h>
+
+using namespace outpost::comm;
+
+constexpr size_t RmapPacketView::initiatorLogicalAddressOffset;
+constexpr size_t RmapPacketView::protocolIdentifierOffset;
+constexpr size_t RmapPacketView::instructionOffset;
+constexpr size_t RmapPacketView::statusOffset;
+constexpr size_t RmapPacketView::targetLogicalAddressOffset;
+constexpr size_t RmapPacketView::transactionIdOffset;
+constexpr size_t RmapPacketView::dataLengthOffset;
+constexpr size_t RmapPacketView::writeReplyHeaderLength;
+constexpr size_t RmapPacketView::readReplyHeaderLength;
+
+RmapPacketView::ExtractionResult
+RmapPacketView::parseReply(outpost::Slice<const uint8_t> data, uint8_t initiatorLogicalAddress)
+{
+    reset();
+
+    const size_t size = data.getNumberOfElements();
+    if (size < rmap::minimumReplySize)
+    {
+        OUTPOST_LOG("RMAP-Packet: packet size less then minimum\n");
+        return RmapPacket::ExtractionResult::invalid;
+    }
+
+    if (data[initiatorLogicalAddressOffset] != initiatorLogicalAddress)
+    {
+        OUTPOST_LOG("RMAP-Packet: Initiator logical address doesn't match\n");
+        return RmapPacket::ExtractionResult::incorrectAddress;
+    }
+
+    if (data[protocolIdentifierOffset] != rmap::protocolIdentifier)
+    {
+        OUTPOST_LOG("RMAP-Packet: Protocol ID is not RMAP\n");
+        return RmapPacket::ExtractionResult::invalid;
+    }
+
+    mPacket = data;
+    if (!isReplyPacket())
+    {
+        return RmapPacket::ExtractionResult::success;
+    }
+
+    if (isWrite())
+    {
+        if (size != rmap::writeReplyOverhead)
+        {
+            OUTPOST_LOG("RMAP-Packet: Incorrect size for write reply\n");
+            reset();
+            return RmapPacket::ExtractionResult::invalid;
+        }
+        if (outpost::Crc8CcittReversed::calculate(data.first(writeReplyHeaderLength))
+            != data[writeReplyHeaderLength])
+        {
+            OUTPOST_LOG("RMAP-Packet: invalid packet header CRC\n");
+            reset();
+            return RmapPacket::ExtractionResult::crcError;
+        }
+        return RmapPacket::ExtractionResult::success;
+    }
+
+    if (size < rmap::readReplyOverhead)
+    {
+        OUTPOST_LOG("RMAP-Packet: too small read reply\n");
+        reset();
+        return RmapPacket::ExtractionResult::invalid;
+    }
+    if (outpost::Crc8CcittReversed::calculate(data.first(readReplyHeaderLength))
+        != data[readReplyHeaderLength])
+    {
+        OUTPOST_LOG("RMAP-Packet: Invalid packet header CRC\n");
+        reset();
+        return RmapPacket::ExtractionResult::crcError;
+    }
+
+    const uint32_t dataLength = getDataLength();
+    if (dataLength + rmap::readReplyOverhead != size)
+    {
+        OUTPOST_LOG("RMAP-Packet: data length mismatch\n");
+        reset();
+        return RmapPacket::ExtractionResult::invalid;
+    }
+
+    if (outpost::Crc8CcittReversed::calculate(data.subSlice(readReplyHeaderLength + 1, dataLength))
+        != data[size - 1])
+    {
+        OUTPOST_LOG("RMAP-Packet: Invalid packet data CRC\n");
+        reset();
+        return RmapPacket::ExtractionResult::crcError;
+    }
+
+    return RmapPacket::ExtractionResult::success;
+}
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMM_RMAP_PACKET_VIEW_H_
+#define OUTPOST_COMM_RMAP_PACKET_VIEW_H_
+
+#include <outpost/base/slice.h>
+#include <outpost/comm/rmap/rmap_packet.h>
+#include <outpost/utils/storage/bit_access.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace comm
+{
+/**
+ * Received RMAP reply, read directly from the receive buffer.
+ *
+ * parseReply() validates a reply like RmapPacket::extractReplyPacket()
+ * but only keeps a reference to the received data, the header fields are
+ * decoded when they are accessed. Copying a view copies only the
+ * reference. The data must stay valid as long as the view is used, e.g.
+ * by keeping the SharedBufferPointer it was received in.
+ */
+class RmapPacketView
+{
+public:
+    typedef RmapPacket::ExtractionResult ExtractionResult;
+
+    inline RmapPacketView() : mPacket(outpost::Slice<const uint8_t>::empty())
+    {
+    }
+
+    /**
+     * Validate a received packet and refer to it.
+     *
+     * Command packets are accepted after the check of the addresses, but
+     * only the fields of the first three bytes are available then.
+     *
+     * \param data
+     *      Received packet, must stay valid while the view is used.
+     * \param initiatorLogicalAddress
+     *      Expected logical address of the initiator.
+     *
+     * \return  Same as RmapPacket::extractReplyPacket(). On failure the
+     *          view is empty.
+     */
+    ExtractionResult
+    parseReply(outpost::Slice<const uint8_t> data, uint8_t initiatorLogicalAddress);
+
+    /**
+     * Remove the reference to the received data.
+     */
+    inline void
+    reset()
+    {
+        mPacket = outpost::Slice<const uint8_t>::empty();
+    }
+
+    inline bool
+    isValid() const
+    {
+        return (mPacket.getNumberOfElements() != 0);
+    }
+
+    /**
+     * Complete packet given to parseReply().
+     */
+    inline outpost::Slice<const uint8_t>
+    asSlice() const
+    {
+        return mPacket;
+    }
+
+    inline uint8_t
+    getInitiatorLogicalAddress() const
+    {
+        return getByte(initiatorLogicalAddressOffset);
+    }
+
+    inline uint8_t
+    getInstruction() const
+    {
+        return getByte(instructionOffset);
+    }
+
+    inline bool
+    isReplyPacket() const
+    {
+        return isValid()
+               && (outpost::BitAccess::get<uint8_t, 7, 6>(getInstruction())
+                   == RmapPacket::InstructionField::replyPacket);
+    }
+
+    inline bool
+    isCommandPacket() const
+    {
+        return isValid()
+               && (outpost::BitAccess::get<uint8_t, 7, 6>(getInstruction())
+                   == RmapPacket::InstructionField::commandPacket);
+    }
+
+    inline bool
+    isWrite() const
+    {
+        return outpost::BitAccess::get<uint8_t, RmapPacket::InstructionField::operationBit>(
+                getInstruction());
+    }
+
+    inline bool
+    isRead() const
+    {
+        return !isWrite();
+    }
+
+    inline uint8_t
+    getStatus() const
+    {
+        return isReplyPacket() ? getByte(statusOffset)
+                               : static_cast<uint8_t>(RmapReplyStatus::unknown);
+    }
+
+    inline uint8_t
+    getTargetLogicalAddress() const
+    {
+        return isReplyPacket() ? getByte(targetLogicalAddressOffset) : 0;
+    }
+
+    inline uint16_t
+    getTransactionID() const
+    {
+        if (!isReplyPacket())
+        {
+            return 0;
+        }
+        return static_cast<uint16_t>((getByte(transactionIdOffset) << 8)
+                                     | getByte(transactionIdOffset + 1));
+    }
+
+    /**
+     * Length of the data of a read reply, zero for write replies.
+     */
+    inline uint32_t
+    getDataLength() const
+    {
+        if (!isReplyPacket() || isWrite())
+        {
+            return 0;
+        }
+        return (static_cast<uint32_t>(getByte(dataLengthOffset)) << 16)
+               | (static_cast<uint32_t>(getByte(dataLengthOffset + 1)) << 8)
+               | getByte(dataLengthOffset + 2);
+    }
+
+    /**
+     * Data of a read reply, a part of the received packet.
+     */
+    inline outpost::Slice<const uint8_t>
+    getData() const
+    {
+        if (getDataLength() == 0)
+        {
+            return outpost::Slice<const uint8_t>::empty();
+        }
+        return mPacket.subSlice(readReplyHeaderLength + 1, getDataLength());
+    }
+
+    /**
+     * Length of the header without the header CRC.
+     */
+    inline uint32_t
+    getHeaderLength() const
+    {
+        if (!isReplyPacket())
+        {
+            return 0;
+        }
+        return isWrite() ? writeReplyHeaderLength : readReplyHeaderLength;
+    }
+
+    inline uint8_t
+    getHeaderCRC() const
+    {
+        return isReplyPacket() ? getByte(getHeaderLength()) : 0;
+    }
+
+    inline uint8_t
+    getDataCRC() const
+    {
+        return (getDataLength() != 0) ? getByte(mPacket.getNumberOfElements() - 1) : 0;
+    }
+
+private:
+    static constexpr size_t initiatorLogicalAddressOffset = 0;
+    static constexpr size_t protocolIdentifierOffset = 1;
+    static constexpr size_t instructionOffset = 2;
+    static constexpr size_t statusOffset = 3;
+    static constexpr size_t targetLogicalAddressOffset = 4;
+    static constexpr size_t transactionIdOffset = 5;
+    static constexpr size_t dataLengthOffset = 8;
+
+    static constexpr size_t writeReplyHeaderLength = 7;
+    static constexpr size_t readReplyHeaderLength = 11;
+
+    inline uint8_t
+    getByte(size_t offset) const
+    {
+        return (offset < mPacket.getNumberOfElements()) ? mPacket[offset] : 0;
+    }
+
+    outpost::Slice<const uint8_t> mPacket;
+};
+
+}  // namespace comm
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMM_RMAP_REQUEST_H_
+#define OUTPOST_COMM_RMAP_REQUEST_H_
+
+#include "rmap_result.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/rtos.h>
+
+namespace outpost
+{
+namespace comm
+{
+class RmapInitiatorBase;
+class RmapRequest;
+class RmapTransaction;
+
+/**
+ * Receives the completion of asynchronous RMAP requests.
+ *
+ * Called from the receiver thread of the RmapInitiator, or from the
+ * submitting thread for writes without reply. The implementation must
+ * return quickly, submitting a follow-up request is allowed.
+ */
+class RmapCompletionHandler
+{
+public:
+    virtual ~RmapCompletionHandler() = default;
+
+    /**
+     * Called once a submitted request is finished.
+     *
+     * \param request
+     *      The finished request, the result is available through
+     *      RmapRequest::getResult().
+     */
+    virtual void
+    onRmapCompletion(RmapRequest& request) = 0;
+};
+
+/**
+ * Element of a scatter-gather read, see RmapInitiator::readBatch().
+ */
+struct RmapReadElement
+{
+    RmapReadElement(uint32_t address, outpost::Slice<uint8_t> const& buffer) :
+        mAddress(address), mBuffer(buffer), mResult()
+    {
+    }
+
+    /// Remote memory address of the first byte
+    uint32_t mAddress;
+
+    /// Destination for the read data, the size defines the number of bytes to read
+    outpost::Slice<uint8_t> mBuffer;
+
+    /// Result of the read, the number of read bytes refers to this element only
+    RmapResult mResult;
+};
+
+/**
+ * Handle for an asynchronous RMAP operation.
+ *
+ * Owned by the user and passed to RmapInitiator::submitRead() or
+ * RmapInitiator::submitWrite(). The handle must stay valid until
+ * the request is finished, either by a reply, by
+ * RmapInitiator::wait() or by RmapInitiator::cancel(). It can be
+ * reused for further requests afterwards.
+ */
+class RmapRequest
+{
+    friend class RmapInitiatorBase;
+
+public:
+    RmapRequest() : RmapRequest(nullptr)
+    {
+    }
+
+    /**
+     * \param handler
+     *      Called when a request submitted with this handle is finished,
+     *      may be nullptr.
+     */
+    explicit RmapRequest(RmapCompletionHandler* handler) :
+        mPending(false),
+        mTransaction(nullptr),
+        mResult(),
+        mReadBuffer(outpost::Slice<uint8_t>::empty()),
+        mScatterList(outpost::Slice<RmapReadElement>::empty()),
+        mReadLength(0),
+        mHandler(handler),
+        mCompleted(outpost::rtos::BinarySemaphore::State::acquired),
+        mSequence(0)
+    {
+    }
+
+    ~RmapRequest() = default;
+
+    RmapRequest(const RmapRequest&) = delete;
+
+    RmapRequest&
+    operator=(const RmapRequest&) = delete;
+
+    /**
+     * Check whether the request has been submitted and is not finished yet.
+     */
+    inline bool
+    isPending() const
+    {
+        return mPending;
+    }
+
+    /**
+     * Result of the last finished request.
+     *
+     * Only valid if the request is not pending.
+     */
+    inline RmapResult
+    getResult() const
+    {
+        return mResult;
+    }
+
+private:
+    // All members are only changed while holding the operation lock of the initiator
+    volatile bool mPending;
+    RmapTransaction* mTransaction;
+    RmapResult mResult;
+    outpost::Slice<uint8_t> mReadBuffer;
+
+    // Alternatively to mReadBuffer read data is distributed over these elements
+    outpost::Slice<RmapReadElement> mScatterList;
+    size_t mReadLength;
+    RmapCompletionHandler* const mHandler;
+    outpost::rtos::BinarySemaphore mCompleted;
+
+    // Incremented for every submission, a completion of an earlier
+    // submission notified after the handle has been reused is discarded
+    uint32_t mSequence;
+};
+
+}  // namespace comm
+}  // namespace outpost
+
+#endif
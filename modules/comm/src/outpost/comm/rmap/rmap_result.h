@@ -20,11 +20,13 @@ namespace outpost
 {
 namespace comm
 {
-class RmapInitiator;
+class RmapInitiatorBase;
+class RmapMultiLinkInitiator;
 
 class RmapResult
 {
-    friend class RmapInitiator;
+    friend class RmapInitiatorBase;
+    friend class RmapMultiLinkInitiator;
 
 public:
     enum class Code
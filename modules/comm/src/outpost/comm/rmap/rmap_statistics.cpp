@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "rmap_statistics.h"
+
+using namespace outpost::comm;
+
+constexpr size_t RmapTargetStatistics::numberOfLatencyBuckets;
+
+namespace
+{
+constexpr int64_t maximumMicroseconds = 0xFFFFFFFF;
+constexpr uint32_t firstBucketLimit = 64;
+
+uint32_t
+toMicroseconds(outpost::time::Duration duration)
+{
+    const int64_t microseconds = duration.microseconds();
+    if (microseconds < 0)
+    {
+        return 0;
+    }
+    else if (microseconds > maximumMicroseconds)
+    {
+        return static_cast<uint32_t>(maximumMicroseconds);
+    }
+    return static_cast<uint32_t>(microseconds);
+}
+}  // namespace
+
+RmapTargetStatistics::RmapTargetStatistics() :
+    mNumberOfRequests(0),
+    mNumberOfReplies(0),
+    mNumberOfTimeouts(0),
+    mBytesWritten(0),
+    mBytesRead(0),
+    mMinimumLatency(0xFFFFFFFF),
+    mMaximumLatency(0),
+    mTotalLatency(0),
+    mLatencyBuckets(),
+    mSmoothedLatency(0),
+    mLatencyVariation(0)
+{
+}
+
+outpost::time::Duration
+RmapTargetStatistics::getLatencyBucketLimit(size_t bucket)
+{
+    if (bucket >= numberOfLatencyBuckets - 1)
+    {
+        return time::Duration::infinity();
+    }
+    return time::Microseconds(static_cast<int64_t>(firstBucketLimit) << bucket);
+}
+
+void
+RmapTargetStatistics::recordRequest(size_t writtenBytes)
+{
+    mNumberOfRequests.fetchAdd(1);
+    mBytesWritten.fetchAdd(static_cast<uint32_t>(writtenBytes));
+}
+
+void
+RmapTargetStatistics::recordReply(time::Duration latency, size_t readBytes)
+{
+    const uint32_t microseconds = toMicroseconds(latency);
+
+    mNumberOfReplies.fetchAdd(1);
+    mBytesRead.fetchAdd(static_cast<uint32_t>(readBytes));
+    mTotalLatency.fetchAdd(microseconds);
+
+    uint32_t minimum = mMinimumLatency.load();
+    while (microseconds < minimum && !mMinimumLatency.compareAndSwap(minimum, microseconds))
+    {
+        // minimum was updated by the failed exchange, try again
+    }
+
+    uint32_t maximum = mMaximumLatency.load();
+    while (microseconds > maximum && !mMaximumLatency.compareAndSwap(maximum, microseconds))
+    {
+        // maximum was updated by the failed exchange, try again
+    }
+
+    size_t bucket = 0;
+    uint32_t limit = firstBucketLimit;
+    while ((bucket < numberOfLatencyBuckets - 1) && (microseconds >= limit))
+    {
+        bucket++;
+        limit <<= 1;
+    }
+    mLatencyBuckets[bucket].fetchAdd(1);
+
+    const uint32_t smoothed = mSmoothedLatency.load();
+    if (smoothed == 0)
+    {
+        mSmoothedLatency.store((microseconds > 0) ? microseconds : 1);
+        mLatencyVariation.store(microseconds / 2);
+    }
+    else
+    {
+        const uint32_t deviation =
+                (microseconds > smoothed) ? (microseconds - smoothed) : (smoothed - microseconds);
+        const uint64_t variation = mLatencyVariation.load();
+        mLatencyVariation.store(static_cast<uint32_t>((3 * variation + deviation) / 4));
+        mSmoothedLatency.store(
+                static_cast<uint32_t>((7 * static_cast<uint64_t>(smoothed) + microseconds) / 8));
+    }
+}
+
+outpost::time::Duration
+RmapTargetStatistics::getMinimumLatency() const
+{
+    if (mNumberOfReplies.load() == 0)
+    {
+        return time::Duration::zero();
+    }
+    return time::Microseconds(mMinimumLatency.load());
+}
+
+outpost::time::Duration
+RmapTargetStatistics::getAverageLatency() const
+{
+    const uint32_t replies = mNumberOfReplies.load();
+    if (replies == 0)
+    {
+        return time::Duration::zero();
+    }
+    return time::Microseconds(static_cast<int64_t>(mTotalLatency.load() / replies));
+}
+
+void
+RmapTargetStatistics::reset()
+{
+    mNumberOfRequests.store(0);
+    mNumberOfReplies.store(0);
+    mNumberOfTimeouts.store(0);
+    mBytesWritten.store(0);
+    mBytesRead.store(0);
+    mMinimumLatency.store(0xFFFFFFFF);
+    mMaximumLatency.store(0);
+    mTotalLatency.store(0);
+    mSmoothedLatency.store(0);
+    mLatencyVariation.store(0);
+    for (size_t i = 0; i < numberOfLatencyBuckets; i++)
+    {
+        mLatencyBuckets[i].store(0);
+    }
+}
+
+outpost::time::Duration
+RmapAdaptiveTimeout::getTimeout(const RmapTargetStatistics& statistics,
+                                uint8_t attempt,
+                                time::Duration limit) const
+{
+    if (!mEnabled)
+    {
+        return limit;
+    }
+
+    time::Duration timeout = mInitial;
+    if (statistics.getSmoothedLatency() != time::Duration::zero())
+    {
+        timeout = statistics.getSmoothedLatency()
+                  + statistics.getLatencyVariation() * mVariationFactor;
+    }
+    if (timeout < mMinimum)
+    {
+        timeout = mMinimum;
+    }
+
+    for (uint8_t i = 0; (i < attempt) && (timeout < limit); i++)
+    {
+        timeout = timeout * 2;
+    }
+    return (timeout < limit) ? timeout : limit;
+}
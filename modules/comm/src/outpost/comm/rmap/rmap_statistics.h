@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMM_RMAP_STATISTICS_H_
+#define OUTPOST_COMM_RMAP_STATISTICS_H_
+
+#include <outpost/rtos/atomic.h>
+#include <outpost/time/duration.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace comm
+{
+/**
+ * Performance statistics of the RMAP transactions with a single target.
+ *
+ * The round-trip latency is measured from sending the command to handling
+ * the reply in the receiver thread of the initiator. Latencies are sorted
+ * into buckets with doubling width, bucket i counts latencies below
+ * getLatencyBucketLimit(i), the last bucket counts all remaining ones.
+ * A growing latency before any timeout occurs usually points to a
+ * congested or degrading SpaceWire link.
+ *
+ * Updated lock-free by the initiator. Times are kept with microsecond
+ * resolution, single latencies in 32 bit and the total latency used for
+ * the average in 64 bit, so that it does not wrap.
+ */
+class RmapTargetStatistics
+{
+public:
+    static constexpr size_t numberOfLatencyBuckets = 12;
+
+    RmapTargetStatistics();
+
+    RmapTargetStatistics(const RmapTargetStatistics&) = delete;
+
+    RmapTargetStatistics&
+    operator=(const RmapTargetStatistics&) = delete;
+
+    /**
+     * Upper limit (exclusive) of a latency bucket.
+     *
+     * The limit of the first bucket is 64 us, the limit of the last bucket
+     * is Duration::infinity().
+     */
+    static time::Duration
+    getLatencyBucketLimit(size_t bucket);
+
+    /**
+     * Record a command sent to the target.
+     *
+     * \param writtenBytes
+     *      Number of data bytes of a write command, 0 for reads.
+     */
+    void
+    recordRequest(size_t writtenBytes);
+
+    /**
+     * Record a reply received from the target.
+     *
+     * \param latency
+     *      Time between sending the command and handling the reply.
+     * \param readBytes
+     *      Number of data bytes of a read reply, 0 for writes.
+     */
+    void
+    recordReply(time::Duration latency, size_t readBytes);
+
+    inline void
+    recordTimeout()
+    {
+        mNumberOfTimeouts.fetchAdd(1);
+    }
+
+    /// Number of commands sent to the target
+    inline uint32_t
+    getNumberOfRequests() const
+    {
+        return mNumberOfRequests.load();
+    }
+
+    /// Number of replies which could be assigned to a pending request
+    inline uint32_t
+    getNumberOfReplies() const
+    {
+        return mNumberOfReplies.load();
+    }
+
+    /// Requests which did not receive a reply in time or were cancelled
+    inline uint32_t
+    getNumberOfTimeouts() const
+    {
+        return mNumberOfTimeouts.load();
+    }
+
+    inline uint32_t
+    getBytesWritten() const
+    {
+        return mBytesWritten.load();
+    }
+
+    inline uint32_t
+    getBytesRead() const
+    {
+        return mBytesRead.load();
+    }
+
+    /**
+     * Minimal round-trip latency, Duration::zero() if no reply was received.
+     */
+    time::Duration
+    getMinimumLatency() const;
+
+    inline time::Duration
+    getMaximumLatency() const
+    {
+        return time::Microseconds(mMaximumLatency.load());
+    }
+
+    /**
+     * Average round-trip latency, Duration::zero() if no reply was received.
+     */
+    time::Duration
+    getAverageLatency() const;
+
+    /**
+     * Smoothed round-trip latency, Duration::zero() if no reply was received.
+     *
+     * Exponentially weighted moving average with a weight of 1/8 for
+     * the newest latency, as used for the TCP retransmission timer
+     * (RFC 6298).
+     */
+    inline time::Duration
+    getSmoothedLatency() const
+    {
+        return time::Microseconds(mSmoothedLatency.load());
+    }
+
+    /**
+     * Smoothed mean deviation of the latency from the smoothed latency,
+     * weight 1/4 for the newest deviation.
+     */
+    inline time::Duration
+    getLatencyVariation() const
+    {
+        return time::Microseconds(mLatencyVariation.load());
+    }
+
+    inline uint32_t
+    getLatencyBucket(size_t bucket) const
+    {
+        return mLatencyBuckets[bucket].load();
+    }
+
+    void
+    reset();
+
+private:
+    rtos::Atomic<uint32_t> mNumberOfRequests;
+    rtos::Atomic<uint32_t> mNumberOfReplies;
+    rtos::Atomic<uint32_t> mNumberOfTimeouts;
+    rtos::Atomic<uint32_t> mBytesWritten;
+    rtos::Atomic<uint32_t> mBytesRead;
+
+    rtos::Atomic<uint32_t> mMinimumLatency;
+    rtos::Atomic<uint32_t> mMaximumLatency;
+    rtos::Atomic<uint64_t> mTotalLatency;
+    rtos::Atomic<uint32_t> mLatencyBuckets[numberOfLatencyBuckets];
+
+    // Only updated by recordReply(), concurrent replies from several
+    // initiators may lose an update of the estimate
+    rtos::Atomic<uint32_t> mSmoothedLatency;
+    rtos::Atomic<uint32_t> mLatencyVariation;
+};
+
+/**
+ * Timeout derived from the measured round-trip latency of a target.
+ *
+ * The timeout is the smoothed latency plus mVariationFactor times its
+ * variation, like the TCP retransmission timeout. It is doubled for
+ * every retry and limited by the timeout given by the caller. Until the
+ * first reply of the target has been received mInitial is used.
+ *
+ * \see RmapTargetNode::setAdaptiveTimeout()
+ */
+struct RmapAdaptiveTimeout
+{
+    RmapAdaptiveTimeout() :
+        mEnabled(false),
+        mVariationFactor(4),
+        mRetries(0),
+        mMinimum(time::Milliseconds(1)),
+        mInitial(time::Milliseconds(100))
+    {
+    }
+
+    /**
+     * Timeout for an attempt of a request.
+     *
+     * \param attempt
+     *      Number of the attempt, 0 for the first one.
+     * \param limit
+     *      Timeout given by the caller.
+     *
+     * 
+eturn  \p limit if adaptive timeouts are disabled.
+     */
+    time::Duration
+    getTimeout(const RmapTargetStatistics& statistics,
+               uint8_t attempt,
+               time::Duration limit) const;
+
+    bool mEnabled;
+
+    /// Weight of the latency variation, 4 for TCP
+    uint8_t mVariationFactor;
+
+    /// Number of times a request is repeated after a timeout
+    uint8_t mRetries;
+
+    /// Lower limit of the timeout, covers the resolution of the clock and scheduling jitter
+    time::Duration mMinimum;
+
+    /// Timeout used while no latency has been measured
+    time::Duration mInitial;
+};
+
+}  // namespace comm
+}  // namespace outpost
+
+#endif
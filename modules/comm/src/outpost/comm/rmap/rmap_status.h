@@ -16,14 +16,6 @@
 
 #include <stdint.h>
 
-//#define DEBUG_EN
-#ifdef DEBUG_EN
-#include <stdio.h>
-#define console_out printf
-#else
-#define console_out(...)
-#endif
-
 namespace outpost
 {
 namespace comm
@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "rmap_target.h"
+
+#include "rmap_packet.h"
+
+#include <outpost/utils/coding/crc8.h>
+#include <outpost/utils/log/log.h>
+#include <outpost/utils/storage/serialize.h>
+
+using namespace outpost::comm;
+
+constexpr outpost::time::Duration RmapTargetBase::receiveTimeout;
+constexpr outpost::time::Duration RmapTargetBase::sendTimeout;
+
+namespace
+{
+// Read-modify-write accesses 1 to 4 bytes, the command carries data and mask
+constexpr size_t maxReadModifyWriteLength = 8;
+
+/**
+ * Check for the command codes defined by ECSS-E-ST-50-52C.
+ *
+ * All writes are valid, reads require the reply flag and no verify
+ * flag, the only read with verify flag is the incrementing
+ * read-modify-write.
+ */
+bool
+isValidCommand(RmapPacket::InstructionField& instruction)
+{
+    if (instruction.getOperation() == RmapPacket::InstructionField::write)
+    {
+        return true;
+    }
+    else if (!instruction.isReplyEnabled())
+    {
+        return false;
+    }
+    else if (instruction.isVerifyEnabled())
+    {
+        return instruction.isIncrementEnabled();
+    }
+    return true;
+}
+}  // namespace
+
+RmapTargetBase::RmapTargetBase(hal::SpaceWireMultiProtocolHandlerInterface& spw,
+                               outpost::Slice<RmapMemoryRegion> const& regions,
+                               uint8_t logicalAddress,
+                               uint8_t key,
+                               uint8_t priority,
+                               size_t stackSize,
+                               outpost::support::parameter::HeartbeatSource heartbeatSource,
+                               outpost::utils::SharedBufferQueueBase& queue,
+                               outpost::utils::SharedBufferPoolBase& pool) :
+    outpost::rtos::Thread(priority, stackSize, "RMTG"),
+    mSpW(spw),
+    mRegions(regions),
+    mLogicalAddress(logicalAddress),
+    mKey(key),
+    mStopped(true),
+    mNumberOfExecutedCommands(0),
+    mCounters(),
+    mHeartbeat(heartbeatSource),
+    mQueue(queue),
+    mPool(pool)
+{
+}
+
+RmapTargetBase::~RmapTargetBase()
+{
+}
+
+void
+RmapTargetBase::init()
+{
+    mSpW.addQueue(rmap::protocolIdentifier, &mPool, &mQueue, true);
+    start();
+}
+
+void
+RmapTargetBase::run()
+{
+    mStopped = false;
+    while (!mStopped)
+    {
+        mHeartbeat.send(receiveTimeout * 2);
+        doSingleStep();
+    }
+    mHeartbeat.suspend();
+}
+
+void
+RmapTargetBase::doSingleStep()
+{
+    outpost::utils::SharedBufferPointer rxBuffer;
+    if (mQueue.receive(rxBuffer, receiveTimeout) && rxBuffer.isValid())
+    {
+        handleCommand(rxBuffer.asSlice());
+    }
+}
+
+void
+RmapTargetBase::handleCommand(outpost::Slice<const uint8_t> const& packet)
+{
+    if (packet.getNumberOfElements() < rmap::readCommandOverhead)
+    {
+        mCounters.mHeaderCrcError++;
+        return;
+    }
+
+    RmapPacket::InstructionField instruction;
+    instruction.setAllRaw(packet[2]);
+    if (instruction.getPacketType() != RmapPacket::InstructionField::commandPacket)
+    {
+        // Replies are handled by an initiator on the same link
+        return;
+    }
+
+    const size_t replyAddressLength = sizeof(uint32_t) * instruction.getReplyAddressLength();
+    const size_t headerLength = rmap::readCommandOverhead + replyAddressLength;
+    if ((packet.getNumberOfElements() < headerLength)
+        || (outpost::Crc8CcittReversed::calculate(packet.first(headerLength - 1))
+            != packet[headerLength - 1]))
+    {
+        // Without a valid header it is unknown where to send a reply to
+        OUTPOST_LOG("RMAP-Target: invalid command header\n");
+        mCounters.mHeaderCrcError++;
+        return;
+    }
+
+    outpost::Deserialize stream(packet);
+    const uint8_t targetLogicalAddress = stream.read<uint8_t>();
+    stream.skip(2);  // protocol identifier and instruction
+    const uint8_t key = stream.read<uint8_t>();
+
+    Command command;
+    command.mInstruction = instruction.getRaw();
+    command.mReplyAddress = packet.subSlice(stream.getPosition(), replyAddressLength);
+    stream.skip(replyAddressLength);
+    command.mInitiatorLogicalAddress = stream.read<uint8_t>();
+    command.mTransactionId = stream.read<uint16_t>();
+    command.mExtendedAddress = stream.read<uint8_t>();
+    command.mAddress = stream.read<uint32_t>();
+    command.mDataLength = stream.readUnsigned24();
+
+    const outpost::Slice<const uint8_t> payload = packet.skipFirst(headerLength);
+
+    RmapReplyStatus::ErrorStatusCodes status;
+    outpost::Slice<const uint8_t> replyData = outpost::Slice<const uint8_t>::empty();
+    uint8_t previous[maxReadModifyWriteLength / 2];
+
+    if (!isValidCommand(instruction))
+    {
+        status = RmapReplyStatus::unusedRmapPacketType;
+        mCounters.mInvalidCommand++;
+    }
+    else if (targetLogicalAddress != mLogicalAddress)
+    {
+        status = RmapReplyStatus::invalidTargetLogicalAddress;
+        mCounters.mInvalidCommand++;
+    }
+    else if (key != mKey)
+    {
+        status = RmapReplyStatus::invalidKey;
+        mCounters.mInvalidCommand++;
+    }
+    else if (!instruction.isIncrementEnabled())
+    {
+        status = RmapReplyStatus::rmapCommandNotImplemented;
+        mCounters.mRejectedCommand++;
+    }
+    else if (instruction.getOperation() == RmapPacket::InstructionField::write)
+    {
+        status = executeWrite(command, payload);
+    }
+    else if (instruction.isVerifyEnabled())
+    {
+        status = executeReadModifyWrite(command, payload, previous);
+        if (status == RmapReplyStatus::commandExecutedSuccessfully)
+        {
+            replyData = outpost::Slice<const uint8_t>::unsafe(previous, command.mDataLength / 2);
+        }
+    }
+    else
+    {
+        const uint8_t* memory = findMemory(
+                command.mExtendedAddress, command.mAddress, command.mDataLength, false);
+        if (memory == nullptr)
+        {
+            status = RmapReplyStatus::rmapCommandNotImplemented;
+            mCounters.mRejectedCommand++;
+        }
+        else
+        {
+            status = RmapReplyStatus::commandExecutedSuccessfully;
+            replyData = outpost::Slice<const uint8_t>::unsafe(memory, command.mDataLength);
+        }
+    }
+
+    if (status == RmapReplyStatus::commandExecutedSuccessfully)
+    {
+        mNumberOfExecutedCommands++;
+    }
+
+    if (instruction.isReplyEnabled())
+    {
+        sendReply(command, status, replyData);
+    }
+}
+
+RmapReplyStatus::ErrorStatusCodes
+RmapTargetBase::executeWrite(const Command& command, outpost::Slice<const uint8_t> const& payload)
+{
+    RmapPacket::InstructionField instruction;
+    instruction.setAllRaw(command.mInstruction);
+
+    uint8_t* memory =
+            findMemory(command.mExtendedAddress, command.mAddress, command.mDataLength, true);
+    if (memory == nullptr)
+    {
+        mCounters.mRejectedCommand++;
+        return RmapReplyStatus::rmapCommandNotImplemented;
+    }
+
+    RmapReplyStatus::ErrorStatusCodes status = checkData(command, payload);
+    if (status != RmapReplyStatus::commandExecutedSuccessfully)
+    {
+        mCounters.mDataError++;
+    }
+
+    // An unverified write is executed while the data arrives, its CRC is
+    // only known afterwards
+    if ((status == RmapReplyStatus::commandExecutedSuccessfully)
+        || ((status == RmapReplyStatus::invalidDataCrc) && !instruction.isVerifyEnabled()))
+    {
+        memcpy(memory, payload.begin(), command.mDataLength);
+    }
+    return status;
+}
+
+RmapReplyStatus::ErrorStatusCodes
+RmapTargetBase::executeReadModifyWrite(const Command& command,
+                                       outpost::Slice<const uint8_t> const& payload,
+                                       uint8_t* previous)
+{
+    const size_t length = command.mDataLength / 2;
+    if ((command.mDataLength > maxReadModifyWriteLength) || ((command.mDataLength % 2) != 0))
+    {
+        mCounters.mDataError++;
+        return RmapReplyStatus::rmwDataLengthError;
+    }
+
+    uint8_t* memory = findMemory(command.mExtendedAddress, command.mAddress, length, true);
+    if (memory == nullptr)
+    {
+        mCounters.mRejectedCommand++;
+        return RmapReplyStatus::rmapCommandNotImplemented;
+    }
+
+    RmapReplyStatus::ErrorStatusCodes status = checkData(command, payload);
+    if (status != RmapReplyStatus::commandExecutedSuccessfully)
+    {
+        mCounters.mDataError++;
+        return status;
+    }
+
+    for (size_t i = 0; i < length; i++)
+    {
+        const uint8_t data = payload[i];
+        const uint8_t mask = payload[length + i];
+        previous[i] = memory[i];
+        memory[i] = (data & mask) | (previous[i] & ~mask);
+    }
+    return status;
+}
+
+RmapReplyStatus::ErrorStatusCodes
+RmapTargetBase::checkData(const Command& command, outpost::Slice<const uint8_t> const& payload)
+{
+    // The data is followed by the data CRC
+    if (payload.getNumberOfElements() < command.mDataLength + 1)
+    {
+        return RmapReplyStatus::earlyEOP;
+    }
+    else if (payload.getNumberOfElements() > command.mDataLength + 1)
+    {
+        return RmapReplyStatus::tooMuchData;
+    }
+    else if (outpost::Crc8CcittReversed::calculate(payload.first(command.mDataLength))
+             != payload[command.mDataLength])
+    {
+        return RmapReplyStatus::invalidDataCrc;
+    }
+    return RmapReplyStatus::commandExecutedSuccessfully;
+}
+
+uint8_t*
+RmapTargetBase::findMemory(uint8_t extendedAddress, uint32_t address, size_t length, bool write)
+{
+    for (size_t i = 0; i < mRegions.getNumberOfElements(); i++)
+    {
+        RmapMemoryRegion& region = mRegions[i];
+        if ((region.mExtendedAddress == extendedAddress) && (address >= region.mAddress)
+            && ((address - region.mAddress) <= region.mMemory.getNumberOfElements())
+            && (length <= region.mMemory.getNumberOfElements() - (address - region.mAddress)))
+        {
+            if (write && !region.mWritable)
+            {
+                return nullptr;
+            }
+            return region.mMemory.begin() + (address - region.mAddress);
+        }
+    }
+    return nullptr;
+}
+
+void
+RmapTargetBase::sendReply(const Command& command,
+                          RmapReplyStatus::ErrorStatusCodes status,
+                          outpost::Slice<const uint8_t> const& data)
+{
+    RmapPacket::InstructionField instruction;
+    instruction.setAllRaw(command.mInstruction);
+    const bool hasData = (instruction.getOperation() == RmapPacket::InstructionField::read);
+
+    // Leading zeros of the reply address are not part of the path
+    size_t pathStart = 0;
+    while ((pathStart < command.mReplyAddress.getNumberOfElements())
+           && (command.mReplyAddress[pathStart] == 0))
+    {
+        pathStart++;
+    }
+    const outpost::Slice<const uint8_t> path = command.mReplyAddress.skipFirst(pathStart);
+
+    outpost::hal::SpaceWire::TransmitBuffer* transmitBuffer = nullptr;
+    outpost::Slice<uint8_t> txBuffer = outpost::Slice<uint8_t>::empty();
+    if (!mSpW.reserve(transmitBuffer, txBuffer, sendTimeout))
+    {
+        mCounters.mSpacewireFailure++;
+        return;
+    }
+    outpost::Slice<const uint8_t> replyData = data;
+    const size_t length = path.getNumberOfElements()
+                          + (hasData ? rmap::readReplyOverhead + data.getNumberOfElements()
+                                     : rmap::writeReplyOverhead);
+    if (length > txBuffer.getNumberOfElements())
+    {
+        OUTPOST_LOG("RMAP-Target: reply does not fit into the transmit buffer\n");
+        mCounters.mRejectedCommand++;
+        status = RmapReplyStatus::generalErrorCode;
+        replyData = outpost::Slice<const uint8_t>::empty();
+    }
+
+    outpost::Serialize stream(txBuffer);
+    stream.store(path);
+
+    const uint8_t* header = stream.getPointerToCurrentPosition();
+    instruction.setPacketType(RmapPacket::InstructionField::replyPacket);
+    stream.store<uint8_t>(command.mInitiatorLogicalAddress);
+    stream.store<uint8_t>(rmap::protocolIdentifier);
+    stream.store<uint8_t>(instruction.getRaw());
+    stream.store<uint8_t>(status);
+    stream.store<uint8_t>(mLogicalAddress);
+    stream.store<uint16_t>(command.mTransactionId);
+    if (hasData)
+    {
+        stream.store<uint8_t>(0);  // reserved
+        stream.store24(replyData.getNumberOfElements());
+    }
+    const size_t headerLength = stream.getPointerToCurrentPosition() - header;
+    stream.store<uint8_t>(outpost::Crc8CcittReversed::calculate(
+            outpost::Slice<const uint8_t>::unsafe(header, headerLength)));
+
+    if (hasData)
+    {
+        const uint8_t crc = outpost::Crc8CcittReversed::calculateAndCopy(
+                replyData, stream.getPointerToCurrentPosition());
+        stream.skip(replyData.getNumberOfElements());
+        stream.store<uint8_t>(crc);
+    }
+
+    if (!mSpW.commit(transmitBuffer, stream.getPosition(), sendTimeout))
+    {
+        mCounters.mSpacewireFailure++;
+    }
+}
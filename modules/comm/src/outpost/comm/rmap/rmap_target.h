@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMM_RMAP_TARGET_H_
+#define OUTPOST_COMM_RMAP_TARGET_H_
+
+#include "rmap_common.h"
+#include "rmap_status.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/hal/space_wire_multi_protocol_handler.h>
+#include <outpost/rtos.h>
+#include <outpost/support/heartbeat_limiter.h>
+#include <outpost/time/clock.h>
+#include <outpost/time/duration.h>
+#include <outpost/utils/container/reference_queue.h>
+#include <outpost/utils/container/shared_object_pool.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace comm
+{
+/**
+ * Memory exposed by an RmapTarget.
+ *
+ * The memory is accessed directly, without any locking. Commands must
+ * not cross the boundaries of a region.
+ */
+struct RmapMemoryRegion
+{
+    RmapMemoryRegion(uint8_t extendedAddress,
+                     uint32_t address,
+                     outpost::Slice<uint8_t> const& memory,
+                     bool writable = true) :
+        mExtendedAddress(extendedAddress), mAddress(address), mMemory(memory), mWritable(writable)
+    {
+    }
+
+    /// Extended address of the region
+    uint8_t mExtendedAddress;
+
+    /// RMAP address of the first byte of the region
+    uint32_t mAddress;
+
+    outpost::Slice<uint8_t> mMemory;
+
+    /// False to reject write and read-modify-write commands
+    bool mWritable;
+};
+
+/**
+ * RMAP target.
+ *
+ * Serves RMAP read, write and read-modify-write commands against a list
+ * of memory regions. Commands are received through the RMAP protocol
+ * identifier of the SpaceWire handler by a separate thread. An
+ * RmapInitiator may use the same handler, both ignore the packets of
+ * the other side.
+ *
+ * Replies are serialized directly into the transmit buffer of the
+ * SpaceWire handler, read data is copied from the memory region into
+ * the buffer while its CRC is calculated.
+ *
+ * Supported are incrementing accesses only, non-incrementing commands are
+ * rejected with RmapReplyStatus::rmapCommandNotImplemented. Writes with
+ * the verify flag set are only executed after the data CRC has been
+ * checked, writes without it are executed even if the data CRC is wrong
+ * and reply the error afterwards. A data length that does not match the
+ * packet length always prevents the write.
+ *
+ * The memory for received commands is provided by GenericRmapTarget.
+ *
+ * \see     ECSS-E-ST-50-52C SpaceWire - Remote memory access protocol
+ */
+class RmapTargetBase : public outpost::rtos::Thread
+{
+    friend class TestingRmapTarget;
+
+    static constexpr outpost::time::Duration receiveTimeout = outpost::time::Seconds(5);
+    static constexpr outpost::time::Duration sendTimeout = outpost::time::Seconds(1);
+
+public:
+    struct ErrorCounters
+    {
+        ErrorCounters() :
+            mHeaderCrcError(0),
+            mInvalidCommand(0),
+            mRejectedCommand(0),
+            mDataError(0),
+            mSpacewireFailure(0)
+        {
+        }
+
+        size_t mHeaderCrcError;    // too short or corrupted header, packet discarded
+        size_t mInvalidCommand;    // unused command code, wrong logical address or key
+        size_t mRejectedCommand;   // no matching region, read-only or non-incrementing
+        size_t mDataError;         // data CRC or length mismatch
+        size_t mSpacewireFailure;  // reply could not be sent
+    };
+
+    virtual ~RmapTargetBase();
+
+    /**
+     * Register the receive queue at the SpaceWire handler and start the
+     * receiver thread.
+     */
+    void
+    init();
+
+    inline uint8_t
+    getLogicalAddress() const
+    {
+        return mLogicalAddress;
+    }
+
+    /// Number of commands which were executed successfully
+    inline size_t
+    getNumberOfExecutedCommands() const
+    {
+        return mNumberOfExecutedCommands;
+    }
+
+    inline ErrorCounters
+    getErrorCounters() const
+    {
+        return mCounters;
+    }
+
+    inline void
+    resetErrorCounters()
+    {
+        mCounters = ErrorCounters();
+        mNumberOfExecutedCommands = 0;
+    }
+
+    /**
+     * Limit the heartbeat ticks to one per \p interval.
+     *
+     * By default a tick is sent for every received command, which results
+     * in a high rate of ticks for high command rates.
+     *
+     * \warning Must be called before init().
+     */
+    inline void
+    setHeartbeatInterval(outpost::time::Clock& clock, outpost::time::Duration interval)
+    {
+        mHeartbeat.setInterval(clock, interval);
+    }
+
+protected:
+    /**
+     * \param regions
+     *      Memory exposed by the target, must stay valid for the lifetime
+     *      of the target.
+     * \param logicalAddress
+     *      Commands to other logical addresses are rejected.
+     * \param key
+     *      Commands with a different key are rejected.
+     */
+    RmapTargetBase(hal::SpaceWireMultiProtocolHandlerInterface& spw,
+                   outpost::Slice<RmapMemoryRegion> const& regions,
+                   uint8_t logicalAddress,
+                   uint8_t key,
+                   uint8_t priority,
+                   size_t stackSize,
+                   outpost::support::parameter::HeartbeatSource heartbeatSource,
+                   outpost::utils::SharedBufferQueueBase& queue,
+                   outpost::utils::SharedBufferPoolBase& pool);
+
+private:
+    /**
+     * Fields of a received command which are needed for the reply.
+     */
+    struct Command
+    {
+        Command() :
+            mInstruction(0),
+            mReplyAddress(outpost::Slice<const uint8_t>::empty()),
+            mInitiatorLogicalAddress(0),
+            mTransactionId(0),
+            mExtendedAddress(0),
+            mAddress(0),
+            mDataLength(0)
+        {
+        }
+
+        uint8_t mInstruction;
+        outpost::Slice<const uint8_t> mReplyAddress;
+        uint8_t mInitiatorLogicalAddress;
+        uint16_t mTransactionId;
+        uint8_t mExtendedAddress;
+        uint32_t mAddress;
+        uint32_t mDataLength;
+    };
+
+    virtual void
+    run() override;
+
+    void
+    doSingleStep();
+
+    /**
+     * Execute a single command and send the reply if requested.
+     */
+    void
+    handleCommand(outpost::Slice<const uint8_t> const& packet);
+
+    RmapReplyStatus::ErrorStatusCodes
+    executeWrite(const Command& command, outpost::Slice<const uint8_t> const& payload);
+
+    RmapReplyStatus::ErrorStatusCodes
+    executeReadModifyWrite(const Command& command,
+                           outpost::Slice<const uint8_t> const& payload,
+                           uint8_t* previous);
+
+    /**
+     * Check the length and the CRC of the data following the header.
+     *
+     * \param payload
+     *      Data and data CRC of the command.
+     */
+    static RmapReplyStatus::ErrorStatusCodes
+    checkData(const Command& command, outpost::Slice<const uint8_t> const& payload);
+
+    /**
+     * Find the memory accessed by a command.
+     *
+     * \return
+     *      Start of the accessed memory, nullptr if it is not part of a
+     *      single region or must not be written.
+     */
+    uint8_t*
+    findMemory(uint8_t extendedAddress, uint32_t address, size_t length, bool write);
+
+    /**
+     * Serialize the reply into a transmit buffer and send it.
+     *
+     * \param data
+     *      Data of a read or read-modify-write reply, the length defines
+     *      the data length field.
+     */
+    void
+    sendReply(const Command& command,
+              RmapReplyStatus::ErrorStatusCodes status,
+              outpost::Slice<const uint8_t> const& data);
+
+    //--------------------------------------------------------------------------
+    hal::SpaceWireMultiProtocolHandlerInterface& mSpW;
+    outpost::Slice<RmapMemoryRegion> mRegions;
+    const uint8_t mLogicalAddress;
+    const uint8_t mKey;
+    volatile bool mStopped;
+
+    size_t mNumberOfExecutedCommands;
+    ErrorCounters mCounters;
+
+    outpost::support::HeartbeatLimiter mHeartbeat;
+
+    outpost::utils::SharedBufferQueueBase& mQueue;
+    outpost::utils::SharedBufferPoolBase& mPool;
+};
+
+namespace internal
+{
+/**
+ * Memory of a GenericRmapTarget.
+ *
+ * Base class of GenericRmapTarget so that it is constructed before
+ * RmapTargetBase refers to it.
+ */
+template <uint16_t maxDataLength, uint8_t numberOfReceiveBuffers>
+class RmapTargetStorage
+{
+protected:
+    static constexpr uint16_t maxCommandLength =
+            rmap::writeCommandOverhead + rmap::maxAddressLength + maxDataLength;
+
+    RmapTargetStorage() : mQueueStorage(), mPoolStorage()
+    {
+    }
+
+    outpost::utils::SharedBufferQueue<numberOfReceiveBuffers> mQueueStorage;
+    outpost::utils::SharedBufferPool<maxCommandLength, numberOfReceiveBuffers> mPoolStorage;
+};
+}  // namespace internal
+
+/**
+ * RMAP target with configurable resources.
+ *
+ * \tparam maxDataLength
+ *      Maximum number of data bytes of a received write command, defines
+ *      the size of the receive buffers. Longer commands are discarded by
+ *      the SpaceWire handler.
+ * \tparam numberOfReceiveBuffers
+ *      How many command packages can be queued, including the currently
+ *      processed one (i.e. min = 1).
+ */
+template <uint16_t maxDataLength, uint8_t numberOfReceiveBuffers = rmap::numberOfReceiveBuffers>
+class GenericRmapTarget
+    : private internal::RmapTargetStorage<maxDataLength, numberOfReceiveBuffers>,
+      public RmapTargetBase
+{
+    static_assert(maxDataLength > 0, "Data length must not be zero");
+    static_assert(numberOfReceiveBuffers > 0, "At least one receive buffer required");
+    static_assert(maxDataLength <= 0xFFFF - rmap::writeCommandOverhead - rmap::maxAddressLength,
+                  "Command does not fit into a receive buffer");
+
+public:
+    GenericRmapTarget(hal::SpaceWireMultiProtocolHandlerInterface& spw,
+                      outpost::Slice<RmapMemoryRegion> const& regions,
+                      uint8_t logicalAddress,
+                      uint8_t key,
+                      uint8_t priority,
+                      size_t stackSize,
+                      outpost::support::parameter::HeartbeatSource heartbeatSource) :
+        internal::RmapTargetStorage<maxDataLength, numberOfReceiveBuffers>(),
+        RmapTargetBase(spw,
+                       regions,
+                       logicalAddress,
+                       key,
+                       priority,
+                       stackSize,
+                       heartbeatSource,
+                       this->mQueueStorage,
+                       this->mPoolStorage)
+    {
+    }
+};
+
+/**
+ * RMAP target with the default resources of rmap_common.h.
+ */
+typedef GenericRmapTarget<rmap::bufferSize, rmap::numberOfReceiveBuffers> RmapTarget;
+
+}  // namespace comm
+}  // namespace outpost
+
+#endif
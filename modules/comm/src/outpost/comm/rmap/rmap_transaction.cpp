@@ -25,7 +25,10 @@ RmapTransaction::RmapTransaction() :
     mReplyPacket(),
     mCommandPacket(),
     mReplyLock(outpost::rtos::BinarySemaphore::State::released),
-    mBuffer()
+    mBuffer(),
+    mRequest(nullptr),
+    mTargetNode(nullptr),
+    mSendTime(outpost::time::SpacecraftElapsedTime::startOfEpoch())
 {
 }
 
@@ -45,4 +48,6 @@ RmapTransaction::reset()
     mReplyPacket.reset();
     mCommandPacket.reset();
     mBuffer = outpost::utils::SharedBufferPointer();
+    mRequest = nullptr;
+    mTargetNode = nullptr;
 }
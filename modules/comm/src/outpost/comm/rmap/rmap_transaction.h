@@ -15,9 +15,12 @@
 #define OUTPOST_COMM_RMAP_TRANSACTION_H_
 
 #include "rmap_packet.h"
+#include "rmap_packet_view.h"
+#include "rmap_request.h"
 
 #include <outpost/rtos.h>
 #include <outpost/time/duration.h>
+#include <outpost/time/time_epoch.h>
 #include <outpost/utils/container/shared_buffer.h>
 
 namespace outpost
@@ -134,14 +137,17 @@ public:
         return &mCommandPacket;
     }
 
-    inline RmapPacket*
-    getReplyPacket()
+    /**
+     * Received reply, refers to the data of getBuffer().
+     */
+    inline const RmapPacketView*
+    getReplyPacket() const
     {
         return &mReplyPacket;
     }
 
     inline void
-    setReplyPacket(RmapPacket* replyPacket)
+    setReplyPacket(const RmapPacketView* replyPacket)
     {
         mReplyPacket = *replyPacket;
     }
@@ -152,6 +158,56 @@ public:
         mBuffer = buffer;
     }
 
+    inline const outpost::utils::SharedBufferPointer&
+    getBuffer() const
+    {
+        return mBuffer;
+    }
+
+    /**
+     * Set the handle of an asynchronous request, nullptr for blocking
+     * operations.
+     */
+    inline void
+    setRequest(RmapRequest* request)
+    {
+        mRequest = request;
+    }
+
+    inline RmapRequest*
+    getRequest() const
+    {
+        return mRequest;
+    }
+
+    /**
+     * Set the target of the command, receives the statistics of the
+     * transaction.
+     */
+    inline void
+    setTargetNode(RmapTargetNode* targetNode)
+    {
+        mTargetNode = targetNode;
+    }
+
+    inline RmapTargetNode*
+    getTargetNode() const
+    {
+        return mTargetNode;
+    }
+
+    inline void
+    setSendTime(outpost::time::SpacecraftElapsedTime sendTime)
+    {
+        mSendTime = sendTime;
+    }
+
+    inline outpost::time::SpacecraftElapsedTime
+    getSendTime() const
+    {
+        return mSendTime;
+    }
+
     /**
      * Blocks the current thread holding initiating the transaction.
      *
@@ -195,10 +251,13 @@ private:
     State mState;
 
     bool mBlockingMode;
-    RmapPacket mReplyPacket;
+    RmapPacketView mReplyPacket;
     RmapPacket mCommandPacket;
     outpost::rtos::BinarySemaphore mReplyLock;
     outpost::utils::SharedBufferPointer mBuffer;
+    RmapRequest* mRequest;
+    RmapTargetNode* mTargetNode;
+    outpost::time::SpacecraftElapsedTime mSendTime;
 };
 }  // namespace comm
 }  // namespace outpost
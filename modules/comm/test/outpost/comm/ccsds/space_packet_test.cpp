@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/comm/ccsds/space_packet.h>
+#include <outpost/comm/ccsds/space_packet_dispatcher.h>
+#include <outpost/utils/container/shared_object_pool.h>
+
+#include <unittest/harness.h>
+
+#include <string.h>
+
+using namespace outpost::comm;
+
+namespace
+{
+// Telecommand with secondary header, APID 0x123, unsegmented, count 0x1ABC, 3 data bytes
+const uint8_t telecommand[] = {0x19, 0x23, 0xDA, 0xBC, 0x00, 0x02, 0xAA, 0xBB, 0xCC};
+
+class SpacePacketDispatcherTest : public testing::Test
+{
+public:
+    static constexpr size_t offset = 2;
+
+    SpacePacketDispatcherTest() : mDispatcher(offset)
+    {
+    }
+
+    /**
+     * Telemetry packet with one data byte behind \p offset bytes.
+     */
+    outpost::utils::SharedBufferPointer
+    createPacket(uint16_t apid, uint16_t count)
+    {
+        outpost::utils::SharedBufferPointer buffer;
+        EXPECT_TRUE(mPool.allocate(buffer));
+        outpost::Slice<uint8_t> data = buffer->getPointer();
+        memset(&data[0], 0xEE, offset);
+        data[offset + 0] = static_cast<uint8_t>(apid >> 8);
+        data[offset + 1] = static_cast<uint8_t>(apid);
+        data[offset + 2] = static_cast<uint8_t>(0xC0 | (count >> 8));
+        data[offset + 3] = static_cast<uint8_t>(count);
+        data[offset + 4] = 0;
+        data[offset + 5] = 0;
+        data[offset + 6] = 0x42;
+        return buffer;
+    }
+
+    outpost::utils::SharedBufferPool<32, 8> mPool;
+    outpost::utils::SharedBufferQueue<8> mQueue;
+    outpost::utils::SharedBufferQueue<8> mRangeQueue;
+    SpacePacketDispatcher<2> mDispatcher;
+};
+
+constexpr size_t SpacePacketDispatcherTest::offset;
+}  // namespace
+
+TEST(SpacePacketViewTest, shouldDecodePrimaryHeader)
+{
+    SpacePacketView packet;
+    ASSERT_TRUE(packet.parse(outpost::asSlice(telecommand)));
+
+    EXPECT_EQ(0, packet.getVersion());
+    EXPECT_EQ(SpacePacketView::Type::telecommand, packet.getType());
+    EXPECT_TRUE(packet.hasSecondaryHeader());
+    EXPECT_EQ(0x123, packet.getApid());
+    EXPECT_EQ(SpacePacketView::SequenceFlags::unsegmented, packet.getSequenceFlags());
+    EXPECT_EQ(0x1ABC, packet.getSequenceCount());
+    EXPECT_EQ(sizeof(telecommand), packet.getPacketLength());
+
+    // The data field is a part of the parsed data
+    ASSERT_EQ(3U, packet.getDataField().getNumberOfElements());
+    EXPECT_EQ(&telecommand[6], &packet.getDataField()[0]);
+}
+
+TEST(SpacePacketViewTest, shouldIgnoreTrailingBytes)
+{
+    uint8_t data[sizeof(telecommand) + 2] = {};
+    memcpy(data, telecommand, sizeof(telecommand));
+
+    SpacePacketView packet;
+    ASSERT_TRUE(packet.parse(outpost::asSlice(data)));
+    EXPECT_EQ(sizeof(telecommand), packet.getPacketLength());
+}
+
+TEST(SpacePacketViewTest, shouldRejectInvalidPackets)
+{
+    SpacePacketView packet;
+    EXPECT_FALSE(packet.parse(outpost::asSlice(telecommand).first(5)));
+    EXPECT_FALSE(packet.parse(outpost::asSlice(telecommand).first(8)));
+    EXPECT_FALSE(packet.isValid());
+    EXPECT_EQ(0U, packet.getDataField().getNumberOfElements());
+
+    uint8_t version[sizeof(telecommand)];
+    memcpy(version, telecommand, sizeof(telecommand));
+    version[0] |= 0x20;
+    EXPECT_FALSE(packet.parse(outpost::asSlice(version)));
+}
+
+TEST_F(SpacePacketDispatcherTest, shouldDispatchWithoutCopy)
+{
+    ASSERT_TRUE(mDispatcher.addQueue(0x123, &mQueue));
+
+    outpost::utils::SharedBufferPointer buffer = createPacket(0x123, 0);
+    EXPECT_TRUE(mDispatcher.handlePacket(buffer));
+
+    outpost::utils::SharedBufferPointer received;
+    ASSERT_TRUE(mQueue.receive(received, outpost::time::Duration::zero()));
+    EXPECT_EQ(0x123, received.getType());
+    ASSERT_EQ(SpacePacketView::minimumPacketSize, received.getLength());
+    EXPECT_EQ(&buffer->getPointer()[offset], &received.asSlice()[0]);
+    EXPECT_EQ(1U, mDispatcher.getNumberOfPackets(&mQueue));
+}
+
+TEST_F(SpacePacketDispatcherTest, shouldMatchApidRange)
+{
+    ASSERT_TRUE(mDispatcher.addQueue(0x200, &mRangeQueue, 0x7F0));
+    ASSERT_TRUE(mDispatcher.addQueue(0x123, &mQueue));
+
+    EXPECT_TRUE(mDispatcher.handlePacket(createPacket(0x200, 0)));
+    EXPECT_TRUE(mDispatcher.handlePacket(createPacket(0x20F, 0)));
+    EXPECT_FALSE(mDispatcher.handlePacket(createPacket(0x210, 0)));
+
+    EXPECT_EQ(2U, mDispatcher.getNumberOfPackets(&mRangeQueue));
+    EXPECT_EQ(0U, mDispatcher.getNumberOfPackets(&mQueue));
+    EXPECT_EQ(1U, mDispatcher.getNumberOfUnmatchedPackets());
+}
+
+TEST_F(SpacePacketDispatcherTest, shouldRejectOverlappingQueues)
+{
+    ASSERT_TRUE(mDispatcher.addQueue(0x200, &mRangeQueue, 0x700));
+    EXPECT_FALSE(mDispatcher.addQueue(0x234, &mQueue));
+    EXPECT_TRUE(mDispatcher.addQueue(0x334, &mQueue));
+
+    outpost::utils::SharedBufferQueue<1> other;
+    EXPECT_FALSE(mDispatcher.addQueue(0x400, &other));
+    EXPECT_FALSE(mDispatcher.addQueue(0x400, nullptr));
+}
+
+TEST_F(SpacePacketDispatcherTest, shouldUseDefaultQueue)
+{
+    mDispatcher.setDefaultQueue(&mQueue);
+    EXPECT_TRUE(mDispatcher.handlePacket(createPacket(0x042, 0)));
+    EXPECT_EQ(1U, mDispatcher.getNumberOfPackets(&mQueue));
+
+    // idle packets are discarded
+    EXPECT_FALSE(mDispatcher.handlePacket(createPacket(SpacePacketView::idleApid, 0)));
+    EXPECT_EQ(0U, mDispatcher.getNumberOfUnmatchedPackets());
+}
+
+TEST_F(SpacePacketDispatcherTest, shouldCountSequenceGaps)
+{
+    ASSERT_TRUE(mDispatcher.addQueue(0x123, &mQueue));
+
+    EXPECT_TRUE(
+            mDispatcher.handlePacket(createPacket(0x123, SpacePacketView::maximumSequenceCount)));
+    EXPECT_TRUE(mDispatcher.handlePacket(createPacket(0x123, 0)));
+    EXPECT_EQ(0U, mDispatcher.getNumberOfSequenceErrors(&mQueue));
+
+    EXPECT_TRUE(mDispatcher.handlePacket(createPacket(0x123, 2)));
+    EXPECT_EQ(1U, mDispatcher.getNumberOfSequenceErrors(&mQueue));
+}
+
+TEST_F(SpacePacketDispatcherTest, shouldCountInvalidAndDroppedPackets)
+{
+    outpost::utils::SharedBufferQueue<1> small;
+    ASSERT_TRUE(mDispatcher.addQueue(0x123, &small));
+
+    outpost::utils::SharedBufferPointer invalid = createPacket(0x123, 0);
+    invalid->getPointer()[offset + 5] = 0xFF;
+    EXPECT_FALSE(mDispatcher.handlePacket(invalid));
+    EXPECT_FALSE(mDispatcher.handlePacket(outpost::utils::SharedBufferPointer()));
+    EXPECT_EQ(2U, mDispatcher.getNumberOfInvalidPackets());
+
+    EXPECT_TRUE(mDispatcher.handlePacket(createPacket(0x123, 0)));
+    EXPECT_FALSE(mDispatcher.handlePacket(createPacket(0x123, 1)));
+    EXPECT_EQ(1U, mDispatcher.getNumberOfDroppedPackets(&small));
+
+    mDispatcher.resetErrorCounters();
+    EXPECT_EQ(0U, mDispatcher.getNumberOfInvalidPackets());
+    EXPECT_EQ(0U, mDispatcher.getNumberOfDroppedPackets(&small));
+}
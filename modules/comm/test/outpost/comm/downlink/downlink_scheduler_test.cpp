@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/comm/downlink/downlink_scheduler.h>
+#include <outpost/utils/container/shared_object_pool.h>
+
+#include <unittest/harness.h>
+
+using namespace outpost::comm;
+
+namespace
+{
+class DownlinkSchedulerTest : public testing::Test
+{
+public:
+    static constexpr size_t queueSize = 16;
+
+    DownlinkSchedulerTest() :
+        mHousekeeping(outpost::asSlice(mHousekeepingStorage), outpost::asSlice(mHousekeepingFlags)),
+        mScience(outpost::asSlice(mScienceStorage), outpost::asSlice(mScienceFlags))
+    {
+    }
+
+    /**
+     * Packet of \p length bytes, all set to \p value.
+     */
+    outpost::utils::SharedBufferPointer
+    createPacket(size_t length, uint8_t value)
+    {
+        outpost::utils::SharedBufferPointer buffer;
+        EXPECT_TRUE(mPool.allocate(buffer));
+        for (size_t i = 0; i < length; ++i)
+        {
+            buffer[i] = value;
+        }
+        outpost::utils::SharedChildPointer child;
+        EXPECT_TRUE(buffer.getChild(child, 0, 0, length));
+        return child;
+    }
+
+    outpost::utils::SharedBufferPool<200, 64> mPool;
+
+    outpost::utils::SharedBufferPointer mHousekeepingStorage[queueSize];
+    uint8_t mHousekeepingFlags[queueSize];
+    outpost::utils::SharedRingBuffer mHousekeeping;
+
+    outpost::utils::SharedBufferPointer mScienceStorage[queueSize];
+    uint8_t mScienceFlags[queueSize];
+    outpost::utils::SharedRingBuffer mScience;
+
+    DownlinkScheduler<2> mScheduler;
+};
+
+constexpr size_t DownlinkSchedulerTest::queueSize;
+}  // namespace
+
+TEST_F(DownlinkSchedulerTest, shouldRejectInvalidClasses)
+{
+    EXPECT_EQ(-1, mScheduler.addClass(mHousekeeping, 0));
+    EXPECT_EQ(0, mScheduler.addClass(mHousekeeping, 100));
+    EXPECT_EQ(1, mScheduler.addClass(mScience, 100));
+    EXPECT_EQ(-1, mScheduler.addClass(mScience, 100));
+
+    EXPECT_FALSE(mScheduler.submit(2, createPacket(10, 0)));
+    EXPECT_EQ(2U, mScheduler.getNumberOfClasses());
+}
+
+TEST_F(DownlinkSchedulerTest, shouldPackSmallPacketsIntoFrame)
+{
+    mScheduler.addClass(mHousekeeping, 100);
+    for (uint8_t i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(mScheduler.submit(0, createPacket(20, i)));
+    }
+
+    uint8_t frame[100];
+    ASSERT_EQ(60U, mScheduler.fillFrame(outpost::asSlice(frame)));
+    EXPECT_EQ(0, frame[0]);
+    EXPECT_EQ(1, frame[20]);
+    EXPECT_EQ(2, frame[59]);
+
+    EXPECT_EQ(0U, mScheduler.getNumberOfPendingPackets(0));
+    EXPECT_EQ(3U, mScheduler.getNumberOfPackets(0));
+    EXPECT_EQ(60U, mScheduler.getNumberOfBytes(0));
+    EXPECT_EQ(0U, mPool.numberOfUsedElements());
+
+    EXPECT_EQ(0U, mScheduler.fillFrame(outpost::asSlice(frame)));
+}
+
+TEST_F(DownlinkSchedulerTest, shouldStartNextFrameWithPacketNotFitting)
+{
+    mScheduler.addClass(mHousekeeping, 200);
+    ASSERT_TRUE(mScheduler.submit(0, createPacket(60, 1)));
+    ASSERT_TRUE(mScheduler.submit(0, createPacket(60, 2)));
+
+    uint8_t frame[100];
+    EXPECT_EQ(60U, mScheduler.fillFrame(outpost::asSlice(frame)));
+    EXPECT_EQ(1, frame[0]);
+    EXPECT_EQ(60U, mScheduler.fillFrame(outpost::asSlice(frame)));
+    EXPECT_EQ(2, frame[0]);
+}
+
+TEST_F(DownlinkSchedulerTest, shouldDropPacketsLargerThanFrame)
+{
+    mScheduler.addClass(mHousekeeping, 200);
+    ASSERT_TRUE(mScheduler.submit(0, createPacket(150, 1)));
+    ASSERT_TRUE(mScheduler.submit(0, createPacket(50, 2)));
+
+    uint8_t frame[100];
+    EXPECT_EQ(50U, mScheduler.fillFrame(outpost::asSlice(frame)));
+    EXPECT_EQ(2, frame[0]);
+    EXPECT_EQ(1U, mScheduler.getNumberOfDroppedPackets(0));
+}
+
+TEST_F(DownlinkSchedulerTest, shouldShareLinkByQuantum)
+{
+    mScheduler.addClass(mHousekeeping, 40);
+    mScheduler.addClass(mScience, 120);
+
+    uint8_t frame[80];
+    for (size_t i = 0; i < 4; ++i)
+    {
+        for (size_t k = 0; k < queueSize / 2; ++k)
+        {
+            mScheduler.submit(0, createPacket(20, 1));
+            mScheduler.submit(1, createPacket(20, 2));
+        }
+        mScheduler.fillFrame(outpost::asSlice(frame));
+        mScheduler.fillFrame(outpost::asSlice(frame));
+        while (!mHousekeeping.isEmpty())
+        {
+            mHousekeeping.pop();
+        }
+        while (!mScience.isEmpty())
+        {
+            mScience.pop();
+        }
+    }
+
+    // 160 bytes per round, one quarter for housekeeping
+    EXPECT_EQ(4U * 40U, mScheduler.getNumberOfBytes(0));
+    EXPECT_EQ(4U * 120U, mScheduler.getNumberOfBytes(1));
+}
+
+TEST_F(DownlinkSchedulerTest, shouldLimitClassToBudget)
+{
+    mScheduler.addClass(mHousekeeping, 100, 40);
+    mScheduler.addClass(mScience, 100);
+    for (size_t k = 0; k < 4; ++k)
+    {
+        mScheduler.submit(0, createPacket(20, 1));
+    }
+
+    uint8_t frame[100];
+    EXPECT_EQ(40U, mScheduler.fillFrame(outpost::asSlice(frame)));
+    EXPECT_EQ(0U, mScheduler.fillFrame(outpost::asSlice(frame)));
+
+    // The unused budget is available to the other class
+    mScheduler.submit(1, createPacket(100, 2));
+    EXPECT_EQ(100U, mScheduler.fillFrame(outpost::asSlice(frame)));
+
+    mScheduler.startPeriod();
+    EXPECT_EQ(40U, mScheduler.fillFrame(outpost::asSlice(frame)));
+    EXPECT_EQ(0U, mScheduler.getNumberOfPendingPackets(0));
+}
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/comm/fragmentation/fragment_reassembler.h>
+#include <outpost/comm/fragmentation/fragment_sender.h>
+#include <outpost/hal/space_wire_multi_protocol_handler.h>
+#include <outpost/utils/container/shared_object_pool.h>
+
+#include <unittest/hal/spacewire_stub.h>
+#include <unittest/harness.h>
+#include <unittest/time/testing_clock.h>
+
+#include <vector>
+
+using namespace outpost::comm;
+
+namespace
+{
+char threadName[] = "Fragment";
+
+class FragmentationTest : public testing::Test
+{
+public:
+    static constexpr uint8_t targetLogicalAddress = 0xFE;
+    static constexpr uint8_t protocolId = 0xE0;
+    static constexpr size_t maximumPacketLength = 100;
+    static constexpr size_t fragmentLength = maximumPacketLength - FragmentHeader::size;
+    static constexpr size_t datasetLength = 300;
+
+    typedef FragmentReassemblerBase::Result Result;
+
+    FragmentationTest() :
+        mSpaceWire(maximumPacketLength),
+        mHandler(mSpaceWire,
+                 1,
+                 1,
+                 threadName,
+                 outpost::support::parameter::HeartbeatSource::default0,
+                 mClock),
+        mSender(mHandler, targetLogicalAddress, protocolId, maximumPacketLength),
+        mReassembler(mPool, mOutput, mClock, outpost::time::Seconds(1))
+    {
+    }
+
+    virtual void
+    SetUp() override
+    {
+        mSpaceWire.open();
+        mSpaceWire.up(outpost::time::Duration::zero());
+    }
+
+    outpost::utils::SharedBufferPointer
+    createDataset(size_t length)
+    {
+        outpost::utils::SharedBufferPointer dataset;
+        mSourcePool.allocate(dataset);
+        for (size_t i = 0; i < datasetLength; ++i)
+        {
+            dataset[i] = static_cast<uint8_t>(i * 7);
+        }
+        outpost::utils::SharedChildPointer child;
+        dataset.getChild(child, 0, 0, length);
+        return child;
+    }
+
+    std::vector<std::vector<uint8_t>>
+    takeSentPackets()
+    {
+        std::vector<std::vector<uint8_t>> packets;
+        for (const auto& packet : mSpaceWire.mSentPackets)
+        {
+            packets.push_back(packet.data);
+        }
+        mSpaceWire.mSentPackets.clear();
+        return packets;
+    }
+
+    Result
+    handle(const std::vector<uint8_t>& packet)
+    {
+        return mReassembler.handleFragment(outpost::asSlice(packet));
+    }
+
+    unittest::time::TestingClock mClock;
+    unittest::hal::SpaceWireStub mSpaceWire;
+    outpost::hal::SpaceWireMultiProtocolHandler<1> mHandler;
+    outpost::utils::SharedBufferPool<datasetLength, 2> mSourcePool;
+    outpost::utils::SharedBufferPool<datasetLength, 2> mPool;
+    outpost::utils::ReferenceQueue<outpost::utils::SharedBufferPointer, 4> mOutput;
+    FragmentSender mSender;
+    FragmentReassembler<2, 8> mReassembler;
+};
+
+constexpr uint8_t FragmentationTest::targetLogicalAddress;
+constexpr uint8_t FragmentationTest::protocolId;
+constexpr size_t FragmentationTest::maximumPacketLength;
+constexpr size_t FragmentationTest::fragmentLength;
+constexpr size_t FragmentationTest::datasetLength;
+}  // namespace
+
+TEST_F(FragmentationTest, shouldSendDatasetAsFragments)
+{
+    outpost::utils::SharedBufferPointer dataset = createDataset(200);
+    ASSERT_TRUE(mSender.send(dataset));
+
+    std::vector<std::vector<uint8_t>> packets = takeSentPackets();
+    ASSERT_EQ(3U, packets.size());
+    EXPECT_EQ(maximumPacketLength, packets[0].size());
+    EXPECT_EQ(maximumPacketLength, packets[1].size());
+    EXPECT_EQ(FragmentHeader::size + 200 - 2 * fragmentLength, packets[2].size());
+
+    for (size_t i = 0; i < packets.size(); ++i)
+    {
+        FragmentHeader header;
+        ASSERT_TRUE(header.read(outpost::asSlice(packets[i])));
+        EXPECT_EQ(targetLogicalAddress, header.mTargetLogicalAddress);
+        EXPECT_EQ(protocolId, header.mProtocolId);
+        EXPECT_EQ(0U, header.mDatasetId);
+        EXPECT_EQ(i, header.mIndex);
+        EXPECT_EQ(3U, header.mNumberOfFragments);
+        EXPECT_EQ(200U, header.mTotalLength);
+        EXPECT_EQ(i * fragmentLength, header.mOffset);
+        EXPECT_EQ(dataset[i * fragmentLength], packets[i][FragmentHeader::size]);
+    }
+    EXPECT_EQ(1U, mSender.getNextDatasetId());
+}
+
+TEST_F(FragmentationTest, shouldRejectInvalidDataset)
+{
+    EXPECT_FALSE(mSender.send(outpost::utils::SharedBufferPointer()));
+    EXPECT_EQ(0U, mSender.getNumberOfFragments(0));
+    EXPECT_TRUE(mSpaceWire.mSentPackets.empty());
+}
+
+TEST_F(FragmentationTest, shouldFailIfLinkIsDown)
+{
+    mSpaceWire.down(outpost::time::Duration::zero());
+
+    EXPECT_FALSE(mSender.send(createDataset(200)));
+}
+
+TEST_F(FragmentationTest, shouldReassembleFragmentsInAnyOrder)
+{
+    outpost::utils::SharedBufferPointer dataset = createDataset(200);
+    ASSERT_TRUE(mSender.send(dataset));
+    std::vector<std::vector<uint8_t>> packets = takeSentPackets();
+
+    EXPECT_EQ(Result::incomplete, handle(packets[2]));
+    EXPECT_EQ(Result::incomplete, handle(packets[0]));
+    EXPECT_EQ(Result::duplicate, handle(packets[0]));
+    EXPECT_EQ(1U, mPool.numberOfUsedElements());
+    EXPECT_EQ(Result::complete, handle(packets[1]));
+
+    outpost::utils::SharedBufferPointer received;
+    ASSERT_TRUE(mOutput.receive(received, outpost::time::Duration::zero()));
+    EXPECT_EQ(0U, received.getType());
+    ASSERT_EQ(200U, received.getLength());
+    EXPECT_ARRAY_EQ(uint8_t, &dataset[0], &received[0], 200);
+
+    EXPECT_EQ(0U, mReassembler.getNumberOfActiveDatasets());
+    EXPECT_EQ(1U, mReassembler.getNumberOfCompletedDatasets());
+
+    received = outpost::utils::SharedBufferPointer();
+    EXPECT_EQ(0U, mPool.numberOfUsedElements());
+}
+
+TEST_F(FragmentationTest, shouldReassembleInterleavedDatasets)
+{
+    ASSERT_TRUE(mSender.send(createDataset(100)));
+    ASSERT_TRUE(mSender.send(createDataset(150)));
+    std::vector<std::vector<uint8_t>> packets = takeSentPackets();
+    ASSERT_EQ(4U, packets.size());
+
+    EXPECT_EQ(Result::incomplete, handle(packets[0]));
+    EXPECT_EQ(Result::incomplete, handle(packets[3]));
+    EXPECT_EQ(2U, mReassembler.getNumberOfActiveDatasets());
+    EXPECT_EQ(Result::complete, handle(packets[2]));
+    EXPECT_EQ(Result::complete, handle(packets[1]));
+
+    outpost::utils::SharedBufferPointer received;
+    ASSERT_TRUE(mOutput.receive(received, outpost::time::Duration::zero()));
+    EXPECT_EQ(1U, received.getType());
+    EXPECT_EQ(150U, received.getLength());
+    ASSERT_TRUE(mOutput.receive(received, outpost::time::Duration::zero()));
+    EXPECT_EQ(0U, received.getType());
+    EXPECT_EQ(100U, received.getLength());
+}
+
+TEST_F(FragmentationTest, shouldRejectInvalidFragments)
+{
+    ASSERT_TRUE(mSender.send(createDataset(200)));
+    std::vector<std::vector<uint8_t>> packets = takeSentPackets();
+
+    std::vector<uint8_t> tooShort(packets[0].begin(), packets[0].begin() + 10);
+    EXPECT_EQ(Result::invalid, handle(tooShort));
+
+    // Data beyond the total length
+    std::vector<uint8_t> outOfRange = packets[2];
+    outOfRange[15] = 0xFF;
+    EXPECT_EQ(Result::invalid, handle(outOfRange));
+
+    // Number of fragments differs from the first fragment of the dataset
+    EXPECT_EQ(Result::incomplete, handle(packets[0]));
+    std::vector<uint8_t> mismatch = packets[1];
+    mismatch[7] = 4;
+    EXPECT_EQ(Result::invalid, handle(mismatch));
+
+    EXPECT_EQ(3U, mReassembler.getNumberOfDroppedFragments());
+}
+
+TEST_F(FragmentationTest, shouldRejectDatasetsWithTooManyFragments)
+{
+    FragmentHeader header;
+    header.mNumberOfFragments = 33;
+    header.mTotalLength = 33;
+    std::vector<uint8_t> packet(FragmentHeader::size);
+    header.write(outpost::asSlice(packet));
+
+    EXPECT_EQ(32U, mReassembler.getMaximumNumberOfFragments());
+    EXPECT_EQ(Result::invalid, handle(packet));
+}
+
+TEST_F(FragmentationTest, shouldDiscardIncompleteDatasetsAfterTimeout)
+{
+    ASSERT_TRUE(mSender.send(createDataset(200)));
+    std::vector<std::vector<uint8_t>> packets = takeSentPackets();
+
+    EXPECT_EQ(Result::incomplete, handle(packets[0]));
+    mClock.incrementBy(outpost::time::Milliseconds(500));
+    EXPECT_EQ(0U, mReassembler.cleanup());
+
+    EXPECT_EQ(Result::incomplete, handle(packets[1]));
+    mClock.incrementBy(outpost::time::Milliseconds(999));
+    EXPECT_EQ(0U, mReassembler.cleanup());
+    mClock.incrementBy(outpost::time::Milliseconds(1));
+    EXPECT_EQ(1U, mReassembler.cleanup());
+
+    EXPECT_EQ(0U, mReassembler.getNumberOfActiveDatasets());
+    EXPECT_EQ(1U, mReassembler.getNumberOfDroppedDatasets());
+    EXPECT_EQ(0U, mPool.numberOfUsedElements());
+
+    // The late fragment starts a new dataset
+    EXPECT_EQ(Result::incomplete, handle(packets[2]));
+}
+
+TEST_F(FragmentationTest, shouldReuseExpiredSlotForNewDataset)
+{
+    for (size_t i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(mSender.send(createDataset(200)));
+    }
+    std::vector<std::vector<uint8_t>> packets = takeSentPackets();
+    ASSERT_EQ(9U, packets.size());
+
+    EXPECT_EQ(Result::incomplete, handle(packets[0]));
+    EXPECT_EQ(Result::incomplete, handle(packets[3]));
+    EXPECT_EQ(Result::noFreeDataset, handle(packets[6]));
+
+    mClock.incrementBy(outpost::time::Seconds(1));
+    EXPECT_EQ(Result::incomplete, handle(packets[6]));
+    EXPECT_EQ(1U, mReassembler.getNumberOfActiveDatasets());
+    EXPECT_EQ(2U, mReassembler.getNumberOfDroppedDatasets());
+}
+
+TEST_F(FragmentationTest, shouldRejectFragmentWithoutFreeBuffer)
+{
+    for (size_t i = 0; i < 5; ++i)
+    {
+        ASSERT_TRUE(mSender.send(createDataset(50)));
+    }
+    std::vector<std::vector<uint8_t>> packets = takeSentPackets();
+    ASSERT_EQ(5U, packets.size());
+
+    // Every dataset in the queue holds a buffer of the pool
+    EXPECT_EQ(Result::complete, handle(packets[0]));
+    EXPECT_EQ(Result::complete, handle(packets[1]));
+    EXPECT_EQ(Result::noBuffer, handle(packets[2]));
+
+    outpost::utils::SharedBufferPointer received;
+    ASSERT_TRUE(mOutput.receive(received, outpost::time::Duration::zero()));
+    received = outpost::utils::SharedBufferPointer();
+    EXPECT_EQ(Result::complete, handle(packets[2]));
+}
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/base/fixpoint.h>
+#include <outpost/comm/offload/space_wire_remote_encoder.h>
+#include <outpost/compression/nls_encoder.h>
+#include <outpost/hal/space_wire_multi_protocol_handler.h>
+#include <outpost/utils/container/shared_object_pool.h>
+#include <outpost/utils/storage/serialize.h>
+
+#include <unittest/hal/spacewire_stub.h>
+#include <unittest/harness.h>
+#include <unittest/time/testing_clock.h>
+
+#include <vector>
+
+using namespace outpost::comm;
+using namespace outpost::compression;
+
+namespace
+{
+char threadName[] = "Offload";
+
+class SpaceWireRemoteEncoderTest : public testing::Test
+{
+public:
+    static constexpr uint8_t targetLogicalAddress = 0xFE;
+    static constexpr uint8_t protocolId = 0xE1;
+    static constexpr size_t maximumPacketLength = 200;
+
+    typedef SpaceWireRemoteEncoderBase::PacketType PacketType;
+
+    SpaceWireRemoteEncoderTest() :
+        mSpaceWire(maximumPacketLength),
+        mHandler(mSpaceWire,
+                 1,
+                 1,
+                 threadName,
+                 outpost::support::parameter::HeartbeatSource::default0,
+                 mClock),
+        mEncoder(mHandler,
+                 mResponses,
+                 mClock,
+                 targetLogicalAddress,
+                 protocolId,
+                 outpost::time::Seconds(1),
+                 outpost::time::Seconds(10),
+                 maximumPacketLength)
+    {
+    }
+
+    virtual void
+    SetUp() override
+    {
+        mSpaceWire.open();
+        mSpaceWire.up(outpost::time::Duration::zero());
+    }
+
+    DataBlock
+    createBlock(uint16_t parameterId, Blocksize blocksize = Blocksize::bs16)
+    {
+        outpost::utils::SharedBufferPointer p;
+        mPool.allocate(p);
+        DataBlock block(p,
+                        parameterId,
+                        outpost::time::GpsTime::afterEpoch(outpost::time::Seconds(1000)),
+                        SamplingRate::hz1,
+                        blocksize);
+        for (int32_t i = 0; i < 16; i++)
+        {
+            block.push(outpost::Fixpoint(i * 3 - 20));
+        }
+        return block;
+    }
+
+    std::vector<std::vector<uint8_t>>
+    takeSentPackets()
+    {
+        std::vector<std::vector<uint8_t>> packets;
+        for (const auto& packet : mSpaceWire.mSentPackets)
+        {
+            packets.push_back(packet.data);
+        }
+        mSpaceWire.mSentPackets.clear();
+        return packets;
+    }
+
+    // Answers a request like the compression service would
+    void
+    respond(uint16_t transactionId, PacketType type, DataBlock block)
+    {
+        outpost::utils::SharedBufferPointer packet;
+        ASSERT_TRUE(mPool.allocate(packet));
+        outpost::Serialize stream(packet.asSlice());
+        stream.store<uint8_t>(0x01);
+        stream.store<uint8_t>(protocolId);
+        stream.store<uint8_t>(static_cast<uint8_t>(type));
+        stream.store<uint16_t>(transactionId);
+
+        size_t length = SpaceWireRemoteEncoderBase::responseHeaderSize;
+        if (type == PacketType::encoded)
+        {
+            outpost::utils::SharedBufferPointer p;
+            ASSERT_TRUE(mPool.allocate(p));
+            DataBlock encoded(p,
+                              block.getParameterId(),
+                              block.getStartTime(),
+                              block.getSamplingRate(),
+                              block.getBlocksize());
+            ASSERT_TRUE(block.applyWaveletTransform());
+            ASSERT_TRUE(block.encode(encoded, mNlsEncoder));
+            stream.store(encoded.getEncodedData());
+            length += encoded.getEncodedData().getNumberOfElements();
+        }
+
+        outpost::utils::SharedChildPointer child;
+        ASSERT_TRUE(packet.getChild(child, 0, 0, length));
+        ASSERT_TRUE(mResponses.send(child));
+    }
+
+    unittest::time::TestingClock mClock;
+    unittest::hal::SpaceWireStub mSpaceWire;
+    outpost::hal::SpaceWireMultiProtocolHandler<1> mHandler;
+    outpost::utils::SharedBufferPool<1024, 8> mPool;
+    outpost::utils::ReferenceQueue<outpost::utils::SharedBufferPointer, 4> mResponses;
+    NLSEncoder mNlsEncoder;
+    SpaceWireRemoteEncoder<2> mEncoder;
+};
+
+constexpr uint8_t SpaceWireRemoteEncoderTest::targetLogicalAddress;
+constexpr uint8_t SpaceWireRemoteEncoderTest::protocolId;
+constexpr size_t SpaceWireRemoteEncoderTest::maximumPacketLength;
+}  // namespace
+
+TEST_F(SpaceWireRemoteEncoderTest, shouldSendRawBlockAsRequest)
+{
+    DataBlock block = createBlock(0x1234);
+    ASSERT_TRUE(mEncoder.submit(block, CompressionScheme::waveletNLS));
+    EXPECT_EQ(1U, mEncoder.getNumberOfPendingBlocks());
+
+    std::vector<std::vector<uint8_t>> packets = takeSentPackets();
+    ASSERT_EQ(1U, packets.size());
+    ASSERT_EQ(SpaceWireRemoteEncoderBase::requestHeaderSize + 16 * 4, packets[0].size());
+
+    outpost::Deserialize stream(outpost::asSlice(packets[0]));
+    EXPECT_EQ(targetLogicalAddress, stream.read<uint8_t>());
+    EXPECT_EQ(protocolId, stream.read<uint8_t>());
+    EXPECT_EQ(static_cast<uint8_t>(PacketType::request), stream.read<uint8_t>());
+    EXPECT_EQ(0U, stream.read<uint16_t>());
+    EXPECT_EQ(static_cast<uint8_t>(CompressionScheme::waveletNLS), stream.read<uint8_t>());
+    EXPECT_EQ(0x1234U, stream.read<uint16_t>());
+    EXPECT_EQ(1000000U, stream.read<uint64_t>());
+    EXPECT_EQ(0x41U, stream.read<uint8_t>());
+    for (int32_t i = 0; i < 16; i++)
+    {
+        EXPECT_EQ(outpost::Fixpoint(i * 3 - 20).getValue(), stream.read<int32_t>());
+    }
+}
+
+TEST_F(SpaceWireRemoteEncoderTest, shouldReturnEncodedBlock)
+{
+    DataBlock block = createBlock(7);
+    ASSERT_TRUE(mEncoder.submit(block, CompressionScheme::waveletNLS));
+    respond(0, PacketType::encoded, createBlock(7));
+
+    DataBlock received;
+    ASSERT_TRUE(mEncoder.receive(received, outpost::time::Duration::zero()));
+    EXPECT_TRUE(received.isEncoded());
+    EXPECT_EQ(7U, received.getParameterId());
+    EXPECT_EQ(CompressionScheme::waveletNLS, received.getCompressionScheme());
+    EXPECT_EQ(Blocksize::bs16, received.getBlocksize());
+    EXPECT_EQ(SamplingRate::hz1, received.getSamplingRate());
+    EXPECT_EQ(block.getStartTime(), received.getStartTime());
+    EXPECT_EQ(0U, mEncoder.getNumberOfPendingBlocks());
+
+    EXPECT_FALSE(mEncoder.receive(received, outpost::time::Duration::zero()));
+}
+
+TEST_F(SpaceWireRemoteEncoderTest, shouldLimitRequestsInFlight)
+{
+    ASSERT_TRUE(mEncoder.submit(createBlock(1), CompressionScheme::waveletNLS));
+    ASSERT_TRUE(mEncoder.submit(createBlock(2), CompressionScheme::rice));
+    EXPECT_FALSE(mEncoder.submit(createBlock(3), CompressionScheme::waveletNLS));
+    EXPECT_EQ(2U, takeSentPackets().size());
+
+    // Responses may arrive out of order
+    respond(1, PacketType::encoded, createBlock(2));
+    DataBlock received;
+    ASSERT_TRUE(mEncoder.receive(received, outpost::time::Duration::zero()));
+    EXPECT_EQ(2U, received.getParameterId());
+    EXPECT_TRUE(mEncoder.submit(createBlock(3), CompressionScheme::waveletNLS));
+}
+
+TEST_F(SpaceWireRemoteEncoderTest, shouldRejectBlocksNotFittingIntoPacket)
+{
+    DataBlock block = createBlock(1, Blocksize::bs128);
+    EXPECT_FALSE(mEncoder.submit(block, CompressionScheme::waveletNLS));
+
+    for (int32_t i = 16; i < 128; i++)
+    {
+        block.push(outpost::Fixpoint(i));
+    }
+    EXPECT_FALSE(mEncoder.submit(block, CompressionScheme::waveletNLS));
+    EXPECT_TRUE(takeSentPackets().empty());
+    EXPECT_TRUE(mEncoder.isAvailable());
+}
+
+TEST_F(SpaceWireRemoteEncoderTest, shouldReturnRawBlockIfRejected)
+{
+    ASSERT_TRUE(mEncoder.submit(createBlock(5), CompressionScheme::waveletNLS));
+    respond(0, PacketType::rejected, DataBlock());
+
+    DataBlock received;
+    ASSERT_TRUE(mEncoder.receive(received, outpost::time::Duration::zero()));
+    EXPECT_FALSE(received.isEncoded());
+    EXPECT_EQ(5U, received.getParameterId());
+    EXPECT_EQ(16U, received.getSamples().getNumberOfElements());
+    EXPECT_EQ(1U, mEncoder.getNumberOfRejectedBlocks());
+    EXPECT_TRUE(mEncoder.isAvailable());
+}
+
+TEST_F(SpaceWireRemoteEncoderTest, shouldFallBackAfterTimeout)
+{
+    ASSERT_TRUE(mEncoder.submit(createBlock(5), CompressionScheme::waveletNLS));
+
+    DataBlock received;
+    EXPECT_FALSE(mEncoder.receive(received, outpost::time::Duration::zero()));
+    mClock.incrementBy(outpost::time::Seconds(1));
+    ASSERT_TRUE(mEncoder.receive(received, outpost::time::Duration::zero()));
+    EXPECT_FALSE(received.isEncoded());
+    EXPECT_EQ(5U, received.getParameterId());
+    EXPECT_EQ(1U, mEncoder.getNumberOfTimeouts());
+
+    // The remote is considered down for the retry interval
+    EXPECT_FALSE(mEncoder.isAvailable());
+    EXPECT_FALSE(mEncoder.submit(createBlock(6), CompressionScheme::waveletNLS));
+
+    // A late response is discarded
+    respond(0, PacketType::encoded, createBlock(5));
+    EXPECT_FALSE(mEncoder.receive(received, outpost::time::Duration::zero()));
+    EXPECT_EQ(1U, mEncoder.getNumberOfDiscardedResponses());
+
+    mClock.incrementBy(outpost::time::Seconds(10));
+    EXPECT_TRUE(mEncoder.isAvailable());
+    EXPECT_TRUE(mEncoder.submit(createBlock(6), CompressionScheme::waveletNLS));
+}
+
+TEST_F(SpaceWireRemoteEncoderTest, shouldNotSubmitIfLinkIsDown)
+{
+    mSpaceWire.down(outpost::time::Duration::zero());
+
+    EXPECT_FALSE(mEncoder.submit(createBlock(1), CompressionScheme::waveletNLS));
+    EXPECT_FALSE(mEncoder.isAvailable());
+    EXPECT_EQ(0U, mEncoder.getNumberOfPendingBlocks());
+}
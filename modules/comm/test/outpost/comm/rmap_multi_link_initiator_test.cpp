@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/comm/rmap/rmap_multi_link_initiator.h>
+
+#include <unittest/hal/spacewire_stub.h>
+#include <unittest/harness.h>
+#include <unittest/time/testing_clock.h>
+
+using namespace outpost::comm;
+
+namespace
+{
+char handlerName[] = "Test";
+unittest::time::TestingClock clock;
+
+class Link
+{
+public:
+    Link() :
+        mSpaceWire(100),
+        mHandler(mSpaceWire,
+                 1,
+                 1,
+                 handlerName,
+                 outpost::support::parameter::HeartbeatSource::default0,
+                 clock),
+        mInitiator(mHandler,
+                   nullptr,
+                   100,
+                   4096,
+                   outpost::support::parameter::HeartbeatSource::default0)
+    {
+        mSpaceWire.open();
+        mSpaceWire.up(outpost::time::Duration::zero());
+    }
+
+    unittest::hal::SpaceWireStub mSpaceWire;
+    outpost::hal::SpaceWireMultiProtocolHandler<1> mHandler;
+    RmapInitiator mInitiator;
+};
+
+class RmapMultiLinkInitiatorTest : public testing::Test
+{
+public:
+    RmapMultiLinkInitiatorTest() :
+        mLinks{RmapLink(mNominal.mInitiator), RmapLink(mRedundant.mInitiator)},
+        mTarget("target", 1, 0x20, 0x11)
+    {
+        // Writes without reply finish as soon as the command is sent
+        mOptions.mIncrementMode = true;
+        mOptions.mReplyMode = false;
+        mOptions.mVerifyMode = false;
+    }
+
+    RmapResult
+    write(RmapMultiLinkInitiator& initiator)
+    {
+        return initiator.write(mTarget, mOptions, 0x1000, 0, outpost::asSlice(mData));
+    }
+
+    Link mNominal;
+    Link mRedundant;
+    RmapLink mLinks[2];
+    RmapTargetNode mTarget;
+    RMapOptions mOptions;
+    uint8_t mData[4] = {1, 2, 3, 4};
+};
+}  // namespace
+
+TEST_F(RmapMultiLinkInitiatorTest, shouldKeepTargetOnOneLink)
+{
+    RmapMultiLinkInitiator initiator(outpost::asSlice(mLinks));
+    EXPECT_EQ(2U, initiator.getNumberOfLinks());
+
+    EXPECT_TRUE(write(initiator));
+    EXPECT_TRUE(write(initiator));
+
+    // The logical address 0x20 is assigned to the first link
+    EXPECT_EQ(2U, mNominal.mSpaceWire.mSentPackets.size());
+    EXPECT_TRUE(mRedundant.mSpaceWire.mSentPackets.empty());
+    EXPECT_EQ(2U, initiator.getLink(0).mRequests);
+}
+
+TEST_F(RmapMultiLinkInitiatorTest, shouldRejectRequestsWithoutLinks)
+{
+    RmapMultiLinkInitiator initiator(outpost::Slice<RmapLink>::empty(),
+                                     RmapMultiLinkInitiator::Distribution::roundRobin);
+    EXPECT_EQ(0U, initiator.getNumberOfLinks());
+
+    RmapResult result = write(initiator);
+    EXPECT_EQ(RmapResult::Code::invalidParameters, result.getResult());
+}
+
+TEST_F(RmapMultiLinkInitiatorTest, shouldDistributeRoundRobin)
+{
+    RmapMultiLinkInitiator initiator(outpost::asSlice(mLinks),
+                                     RmapMultiLinkInitiator::Distribution::roundRobin);
+
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_TRUE(write(initiator));
+    }
+
+    EXPECT_EQ(2U, mNominal.mSpaceWire.mSentPackets.size());
+    EXPECT_EQ(2U, mRedundant.mSpaceWire.mSentPackets.size());
+}
+
+TEST_F(RmapMultiLinkInitiatorTest, shouldRetryOnOtherLink)
+{
+    RmapMultiLinkInitiator initiator(outpost::asSlice(mLinks));
+    mNominal.mSpaceWire.down(outpost::time::Duration::zero());
+
+    EXPECT_TRUE(write(initiator));
+    EXPECT_EQ(1U, mRedundant.mSpaceWire.mSentPackets.size());
+    EXPECT_EQ(1U, initiator.getLink(0).mFailures);
+    EXPECT_EQ(1U, initiator.getLink(1).mRequests);
+
+    // The failed link is skipped for the following requests
+    EXPECT_TRUE(write(initiator));
+    EXPECT_EQ(2U, mRedundant.mSpaceWire.mSentPackets.size());
+    EXPECT_EQ(1U, initiator.getLink(0).mRequests);
+}
+
+TEST_F(RmapMultiLinkInitiatorTest, shouldProbeFailedLinkAgain)
+{
+    RmapMultiLinkInitiator initiator(outpost::asSlice(mLinks));
+    mNominal.mSpaceWire.down(outpost::time::Duration::zero());
+    EXPECT_TRUE(write(initiator));
+
+    mNominal.mSpaceWire.up(outpost::time::Duration::zero());
+    for (size_t i = 0; i < RmapMultiLinkInitiator::probeInterval; i++)
+    {
+        EXPECT_TRUE(write(initiator));
+    }
+    EXPECT_TRUE(mNominal.mSpaceWire.mSentPackets.empty());
+
+    EXPECT_TRUE(write(initiator));
+    EXPECT_EQ(1U, mNominal.mSpaceWire.mSentPackets.size());
+    EXPECT_EQ(0U, initiator.getLink(0).mSkip);
+}
+
+TEST_F(RmapMultiLinkInitiatorTest, shouldFailIfAllLinksFail)
+{
+    RmapMultiLinkInitiator initiator(outpost::asSlice(mLinks));
+    mNominal.mSpaceWire.down(outpost::time::Duration::zero());
+    mRedundant.mSpaceWire.down(outpost::time::Duration::zero());
+
+    EXPECT_EQ(RmapResult::Code::sendFailed, write(initiator).getResult());
+    EXPECT_EQ(1U, initiator.getLink(0).mFailures);
+    EXPECT_EQ(1U, initiator.getLink(1).mFailures);
+}
+
+TEST_F(RmapMultiLinkInitiatorTest, shouldNotRetryInvalidParameters)
+{
+    RmapMultiLinkInitiator initiator(outpost::asSlice(mLinks));
+
+    EXPECT_EQ(RmapResult::Code::invalidParameters,
+              initiator.write(mTarget, mOptions, 0x1000, 0, outpost::Slice<const uint8_t>::empty())
+                      .getResult());
+    EXPECT_EQ(1U, initiator.getLink(0).mRequests);
+    EXPECT_EQ(0U, initiator.getLink(1).mRequests);
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/comm/rmap/rmap_packet.h>
+#include <outpost/comm/rmap/rmap_packet_view.h>
+#include <outpost/utils/coding/crc8.h>
+
+#include <unittest/harness.h>
+
+#include <vector>
+
+using namespace outpost::comm;
+
+namespace
+{
+class RmapPacketViewTest : public testing::Test
+{
+public:
+    static constexpr uint8_t initiatorLogicalAddress = 0x40;
+    static constexpr uint8_t targetLogicalAddress = 0x20;
+
+    // Reply packet, read operation, reply flag set
+    static constexpr uint8_t readReplyInstruction = 0x08;
+    // Reply packet, write operation, reply flag set
+    static constexpr uint8_t writeReplyInstruction = 0x28;
+
+    static std::vector<uint8_t>
+    createReadReply(const std::vector<uint8_t>& data, uint8_t status = 0)
+    {
+        std::vector<uint8_t> packet = {initiatorLogicalAddress,
+                                       rmap::protocolIdentifier,
+                                       readReplyInstruction,
+                                       status,
+                                       targetLogicalAddress,
+                                       0x12,
+                                       0x34,
+                                       0x00,
+                                       0x00,
+                                       0x00,
+                                       static_cast<uint8_t>(data.size())};
+        packet.push_back(outpost::Crc8CcittReversed::calculate(outpost::asSlice(packet)));
+        packet.insert(packet.end(), data.begin(), data.end());
+        packet.push_back(outpost::Crc8CcittReversed::calculate(outpost::asSlice(data)));
+        return packet;
+    }
+
+    static std::vector<uint8_t>
+    createWriteReply(uint8_t status = 0)
+    {
+        std::vector<uint8_t> packet = {initiatorLogicalAddress,
+                                       rmap::protocolIdentifier,
+                                       writeReplyInstruction,
+                                       status,
+                                       targetLogicalAddress,
+                                       0xAB,
+                                       0xCD};
+        packet.push_back(outpost::Crc8CcittReversed::calculate(outpost::asSlice(packet)));
+        return packet;
+    }
+
+    RmapPacketView mView;
+};
+
+constexpr uint8_t RmapPacketViewTest::initiatorLogicalAddress;
+constexpr uint8_t RmapPacketViewTest::targetLogicalAddress;
+constexpr uint8_t RmapPacketViewTest::readReplyInstruction;
+constexpr uint8_t RmapPacketViewTest::writeReplyInstruction;
+}  // namespace
+
+TEST_F(RmapPacketViewTest, shouldBeEmptyByDefault)
+{
+    EXPECT_FALSE(mView.isValid());
+    EXPECT_FALSE(mView.isReplyPacket());
+    EXPECT_EQ(0U, mView.getDataLength());
+    EXPECT_EQ(0U, mView.getData().getNumberOfElements());
+}
+
+TEST_F(RmapPacketViewTest, shouldReferToDataOfReadReply)
+{
+    std::vector<uint8_t> packet = createReadReply({1, 2, 3, 4, 5});
+
+    ASSERT_EQ(RmapPacket::ExtractionResult::success,
+              mView.parseReply(outpost::asSlice(packet), initiatorLogicalAddress));
+
+    EXPECT_TRUE(mView.isReplyPacket());
+    EXPECT_TRUE(mView.isRead());
+    EXPECT_EQ(0, mView.getStatus());
+    EXPECT_EQ(targetLogicalAddress, mView.getTargetLogicalAddress());
+    EXPECT_EQ(0x1234, mView.getTransactionID());
+    EXPECT_EQ(5U, mView.getDataLength());
+    EXPECT_EQ(11U, mView.getHeaderLength());
+    EXPECT_EQ(packet[11], mView.getHeaderCRC());
+    EXPECT_EQ(packet.back(), mView.getDataCRC());
+
+    // No copy, the data is a part of the received packet
+    outpost::Slice<const uint8_t> data = mView.getData();
+    ASSERT_EQ(5U, data.getNumberOfElements());
+    EXPECT_EQ(&packet[12], &data[0]);
+}
+
+TEST_F(RmapPacketViewTest, shouldParseWriteReply)
+{
+    std::vector<uint8_t> packet = createWriteReply(RmapReplyStatus::invalidKey);
+
+    ASSERT_EQ(RmapPacket::ExtractionResult::success,
+              mView.parseReply(outpost::asSlice(packet), initiatorLogicalAddress));
+
+    EXPECT_TRUE(mView.isWrite());
+    EXPECT_EQ(RmapReplyStatus::invalidKey, mView.getStatus());
+    EXPECT_EQ(0xABCD, mView.getTransactionID());
+    EXPECT_EQ(7U, mView.getHeaderLength());
+    EXPECT_EQ(0U, mView.getDataLength());
+    EXPECT_EQ(0U, mView.getData().getNumberOfElements());
+}
+
+TEST_F(RmapPacketViewTest, shouldRejectWrongInitiatorAddress)
+{
+    std::vector<uint8_t> packet = createWriteReply();
+
+    EXPECT_EQ(RmapPacket::ExtractionResult::incorrectAddress,
+              mView.parseReply(outpost::asSlice(packet), 0x41));
+    EXPECT_FALSE(mView.isValid());
+}
+
+TEST_F(RmapPacketViewTest, shouldRejectCorruptedHeader)
+{
+    std::vector<uint8_t> packet = createReadReply({1, 2, 3});
+    packet[5] ^= 0x01;
+
+    EXPECT_EQ(RmapPacket::ExtractionResult::crcError,
+              mView.parseReply(outpost::asSlice(packet), initiatorLogicalAddress));
+    EXPECT_FALSE(mView.isValid());
+}
+
+TEST_F(RmapPacketViewTest, shouldRejectCorruptedData)
+{
+    std::vector<uint8_t> packet = createReadReply({1, 2, 3});
+    packet[13] ^= 0x01;
+
+    EXPECT_EQ(RmapPacket::ExtractionResult::crcError,
+              mView.parseReply(outpost::asSlice(packet), initiatorLogicalAddress));
+    EXPECT_FALSE(mView.isValid());
+}
+
+TEST_F(RmapPacketViewTest, shouldRejectDataLengthMismatch)
+{
+    std::vector<uint8_t> packet = createReadReply({1, 2, 3});
+    packet.insert(packet.end() - 1, 4);
+
+    EXPECT_EQ(RmapPacket::ExtractionResult::invalid,
+              mView.parseReply(outpost::asSlice(packet), initiatorLogicalAddress));
+}
+
+TEST_F(RmapPacketViewTest, shouldRejectTooShortPacket)
+{
+    std::vector<uint8_t> packet = createWriteReply();
+    packet.pop_back();
+
+    EXPECT_EQ(RmapPacket::ExtractionResult::invalid,
+              mView.parseReply(outpost::asSlice(packet), initiatorLogicalAddress));
+}
+
+TEST_F(RmapPacketViewTest, shouldMatchExtractedPacket)
+{
+    std::vector<uint8_t> packet = createReadReply({9, 8, 7});
+    outpost::Slice<const uint8_t> slice = outpost::asSlice(packet);
+
+    RmapPacket extracted;
+    ASSERT_EQ(RmapPacket::ExtractionResult::success,
+              extracted.extractReplyPacket(slice, initiatorLogicalAddress));
+    ASSERT_EQ(RmapPacket::ExtractionResult::success,
+              mView.parseReply(slice, initiatorLogicalAddress));
+
+    EXPECT_EQ(extracted.getInstruction(), mView.getInstruction());
+    EXPECT_EQ(extracted.getStatus(), mView.getStatus());
+    EXPECT_EQ(extracted.getTransactionID(), mView.getTransactionID());
+    EXPECT_EQ(extracted.getDataLength(), mView.getDataLength());
+    EXPECT_EQ(&extracted.getData()[0], &mView.getData()[0]);
+    EXPECT_EQ(extracted.getHeaderCRC(), mView.getHeaderCRC());
+    EXPECT_EQ(extracted.getDataCRC(), mView.getDataCRC());
+}
@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/comm/rmap/rmap_packet.h>
+#include <outpost/comm/rmap/rmap_target.h>
+#include <outpost/utils/coding/crc8.h>
+
+#include <unittest/hal/spacewire_stub.h>
+#include <unittest/harness.h>
+#include <unittest/time/testing_clock.h>
+
+#include <vector>
+
+namespace outpost
+{
+namespace comm
+{
+class TestingRmapTarget
+{
+public:
+    static void
+    initialize(RmapTargetBase& target)
+    {
+        target.mSpW.addQueue(rmap::protocolIdentifier, &target.mPool, &target.mQueue, true);
+    }
+
+    static void
+    step(RmapTargetBase& target)
+    {
+        target.doSingleStep();
+    }
+};
+}  // namespace comm
+}  // namespace outpost
+
+using namespace outpost::comm;
+
+namespace
+{
+char handlerName[] = "Test";
+unittest::time::TestingClock clock;
+
+class RmapTargetTest : public testing::Test
+{
+public:
+    static constexpr uint8_t targetLogicalAddress = 0x20;
+    static constexpr uint8_t initiatorLogicalAddress = 0x40;
+    static constexpr uint8_t key = 0x11;
+
+    RmapTargetTest() :
+        mSpaceWire(2048),
+        mHandler(mSpaceWire,
+                 1,
+                 1,
+                 handlerName,
+                 outpost::support::parameter::HeartbeatSource::default0,
+                 clock),
+        mMemory(),
+        mReadOnly(),
+        mRegions{RmapMemoryRegion(0, 0x1000, outpost::asSlice(mMemory)),
+                 RmapMemoryRegion(0, 0x2000, outpost::asSlice(mReadOnly), false)},
+        mTarget(mHandler,
+                outpost::asSlice(mRegions),
+                targetLogicalAddress,
+                key,
+                100,
+                4096,
+                outpost::support::parameter::HeartbeatSource::default0)
+    {
+        outpost::comm::TestingRmapTarget::initialize(mTarget);
+    }
+
+    virtual void
+    SetUp() override
+    {
+        mSpaceWire.open();
+        mSpaceWire.up(outpost::time::Duration::zero());
+    }
+
+    void
+    prepareCommand(RmapPacket& command, bool write, uint32_t address, uint32_t length)
+    {
+        command.setCommand();
+        if (write)
+        {
+            command.setWrite();
+        }
+        else
+        {
+            command.setRead();
+        }
+        command.setTargetLogicalAddress(targetLogicalAddress);
+        command.setInitiatorLogicalAddress(initiatorLogicalAddress);
+        command.setKey(key);
+        command.setTransactionID(0x1234);
+        command.setExtendedAddress(0);
+        command.setAddress(address);
+        command.setDataLength(length);
+        command.setIncrementFlag(true);
+        command.setReplyFlag(true);
+    }
+
+    std::vector<uint8_t>
+    serialize(RmapPacket& command)
+    {
+        std::vector<uint8_t> buffer(2048);
+        outpost::Slice<uint8_t> packet = outpost::asSlice(buffer);
+        EXPECT_TRUE(command.constructPacket(packet));
+        buffer.resize(packet.getNumberOfElements());
+        return buffer;
+    }
+
+    /**
+     * Deliver a command to the target and extract the reply.
+     *
+     * \return
+     *      False if the target did not send a reply.
+     */
+    bool
+    execute(const std::vector<uint8_t>& command, RmapPacket& reply)
+    {
+        mSpaceWire.mSentPackets.clear();
+        mHandler.handlePackage(outpost::asSlice(command), command.size());
+        outpost::comm::TestingRmapTarget::step(mTarget);
+
+        if (mSpaceWire.mSentPackets.empty())
+        {
+            return false;
+        }
+        mReply = mSpaceWire.mSentPackets.front().data;
+        outpost::Slice<const uint8_t> data = outpost::asSlice(mReply);
+        EXPECT_EQ(RmapPacket::ExtractionResult::success,
+                  reply.extractReplyPacket(data, initiatorLogicalAddress));
+        EXPECT_EQ(0x1234, reply.getTransactionID());
+        EXPECT_EQ(targetLogicalAddress, reply.getTargetLogicalAddress());
+        return true;
+    }
+
+    std::vector<uint8_t>
+    writeCommand(uint32_t address, outpost::Slice<const uint8_t> data, bool verify)
+    {
+        RmapPacket command;
+        prepareCommand(command, true, address, data.getNumberOfElements());
+        command.setData(data);
+        command.setVerifyFlag(verify);
+        return serialize(command);
+    }
+
+    std::vector<uint8_t>
+    readCommand(uint32_t address, uint32_t length)
+    {
+        RmapPacket command;
+        prepareCommand(command, false, address, length);
+        return serialize(command);
+    }
+
+    unittest::hal::SpaceWireStub mSpaceWire;
+    outpost::hal::SpaceWireMultiProtocolHandler<1> mHandler;
+    uint8_t mMemory[64];
+    uint8_t mReadOnly[8];
+    RmapMemoryRegion mRegions[2];
+    RmapTarget mTarget;
+    std::vector<uint8_t> mReply;
+};
+
+constexpr uint8_t RmapTargetTest::targetLogicalAddress;
+constexpr uint8_t RmapTargetTest::initiatorLogicalAddress;
+constexpr uint8_t RmapTargetTest::key;
+}  // namespace
+
+TEST_F(RmapTargetTest, shouldWriteAndReadMemory)
+{
+    const uint8_t data[] = {0x01, 0x02, 0x03, 0x04, 0x05};
+    RmapPacket reply;
+    ASSERT_TRUE(execute(writeCommand(0x1004, outpost::asSlice(data), true), reply));
+    EXPECT_TRUE(reply.isWrite());
+    EXPECT_EQ(RmapReplyStatus::commandExecutedSuccessfully, reply.getStatus());
+    EXPECT_EQ(0x00, mMemory[3]);
+    EXPECT_EQ(0x01, mMemory[4]);
+    EXPECT_EQ(0x05, mMemory[8]);
+
+    RmapPacket readReply;
+    ASSERT_TRUE(execute(readCommand(0x1003, 4), readReply));
+    EXPECT_TRUE(readReply.isRead());
+    EXPECT_EQ(RmapReplyStatus::commandExecutedSuccessfully, readReply.getStatus());
+    ASSERT_EQ(4U, readReply.getDataLength());
+    EXPECT_EQ(0x00, readReply.getData()[0]);
+    EXPECT_EQ(0x03, readReply.getData()[3]);
+
+    EXPECT_EQ(2U, mTarget.getNumberOfExecutedCommands());
+}
+
+TEST_F(RmapTargetTest, shouldApplyReadModifyWrite)
+{
+    mMemory[0] = 0xF0;
+    mMemory[1] = 0xAA;
+
+    RmapPacket command;
+    prepareCommand(command, false, 0x1000, 4);
+    command.setVerifyFlag(true);
+    std::vector<uint8_t> packet = serialize(command);
+
+    // The codec only appends data to writes
+    const uint8_t data[] = {0x0F, 0x55, 0xFF, 0x0F};
+    packet.insert(packet.end(), data, data + sizeof(data));
+    packet.push_back(outpost::Crc8CcittReversed::calculate(outpost::asSlice(data)));
+
+    RmapPacket reply;
+    ASSERT_TRUE(execute(packet, reply));
+    EXPECT_EQ(RmapReplyStatus::commandExecutedSuccessfully, reply.getStatus());
+    ASSERT_EQ(2U, reply.getDataLength());
+    EXPECT_EQ(0xF0, reply.getData()[0]);
+    EXPECT_EQ(0xAA, reply.getData()[1]);
+
+    EXPECT_EQ(0x0F, mMemory[0]);
+    EXPECT_EQ(0xA5, mMemory[1]);
+}
+
+TEST_F(RmapTargetTest, shouldRejectInvalidAccesses)
+{
+    const uint8_t data[] = {0x01, 0x02};
+    RmapPacket reply;
+
+    ASSERT_TRUE(execute(writeCommand(0x2000, outpost::asSlice(data), true), reply));
+    EXPECT_EQ(RmapReplyStatus::rmapCommandNotImplemented, reply.getStatus());
+    EXPECT_EQ(0x00, mReadOnly[0]);
+
+    ASSERT_TRUE(execute(readCommand(0x103F, 2), reply));
+    EXPECT_EQ(RmapReplyStatus::rmapCommandNotImplemented, reply.getStatus());
+    EXPECT_EQ(0U, reply.getDataLength());
+
+    RmapPacket command;
+    prepareCommand(command, false, 0x1000, 2);
+    command.setKey(key + 1);
+    ASSERT_TRUE(execute(serialize(command), reply));
+    EXPECT_EQ(RmapReplyStatus::invalidKey, reply.getStatus());
+
+    RmapTargetBase::ErrorCounters counters = mTarget.getErrorCounters();
+    EXPECT_EQ(2U, counters.mRejectedCommand);
+    EXPECT_EQ(1U, counters.mInvalidCommand);
+    EXPECT_EQ(0U, mTarget.getNumberOfExecutedCommands());
+}
+
+TEST_F(RmapTargetTest, shouldOnlyWriteVerifiedDataWithValidCrc)
+{
+    const uint8_t data[] = {0x01, 0x02};
+    RmapPacket reply;
+
+    std::vector<uint8_t> verified = writeCommand(0x1000, outpost::asSlice(data), true);
+    verified.back() ^= 0xFF;
+    ASSERT_TRUE(execute(verified, reply));
+    EXPECT_EQ(RmapReplyStatus::invalidDataCrc, reply.getStatus());
+    EXPECT_EQ(0x00, mMemory[0]);
+
+    std::vector<uint8_t> unverified = writeCommand(0x1000, outpost::asSlice(data), false);
+    unverified.back() ^= 0xFF;
+    ASSERT_TRUE(execute(unverified, reply));
+    EXPECT_EQ(RmapReplyStatus::invalidDataCrc, reply.getStatus());
+    EXPECT_EQ(0x01, mMemory[0]);
+
+    std::vector<uint8_t> truncated = writeCommand(0x1010, outpost::asSlice(data), false);
+    truncated.pop_back();
+    ASSERT_TRUE(execute(truncated, reply));
+    EXPECT_EQ(RmapReplyStatus::earlyEOP, reply.getStatus());
+    EXPECT_EQ(0x00, mMemory[0x10]);
+
+    EXPECT_EQ(3U, mTarget.getErrorCounters().mDataError);
+}
+
+TEST_F(RmapTargetTest, shouldDiscardCommandWithInvalidHeader)
+{
+    std::vector<uint8_t> command = readCommand(0x1000, 4);
+    command[5] ^= 0x01;
+
+    RmapPacket reply;
+    EXPECT_FALSE(execute(command, reply));
+    EXPECT_EQ(1U, mTarget.getErrorCounters().mHeaderCrcError);
+}
+
+TEST_F(RmapTargetTest, shouldNotReplyWithoutReplyFlag)
+{
+    const uint8_t data[] = {0xAB};
+    RmapPacket command;
+    prepareCommand(command, true, 0x1000, sizeof(data));
+    command.setData(outpost::asSlice(data));
+    command.setReplyFlag(false);
+
+    RmapPacket reply;
+    EXPECT_FALSE(execute(serialize(command), reply));
+    EXPECT_EQ(0xAB, mMemory[0]);
+}
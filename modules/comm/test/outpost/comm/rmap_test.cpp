@@ -17,6 +17,7 @@
 #include <outpost/comm/rmap/rmap_initiator.h>
 #include <outpost/smpc/subscription.h>
 #include <outpost/utils/coding/crc.h>
+#include <outpost/utils/log/log.h>
 #include <outpost/utils/storage/bit_access.h>
 
 #include <unittest/hal/spacewire_stub.h>
@@ -25,6 +26,7 @@
 
 #include <cstdlib>
 #include <future>
+#include <memory>
 #include <utility>
 
 namespace outpost
@@ -72,7 +74,7 @@ public:
 
     bool
     receivePacket(RmapInitiator& init,
-                  RmapPacket* pkt,
+                  RmapPacketView* pkt,
                   outpost::utils::SharedBufferPointer& rxBuffer)
     {
         return init.receivePacket(pkt, rxBuffer);
@@ -97,6 +99,12 @@ public:
         init.doSingleStep();
     }
 
+    size_t
+    getNumberOfFreeReceiveBuffers(RmapInitiator& init)
+    {
+        return init.mPool.numberOfFreeElements();
+    }
+
     void
     clear(RmapInitiator& init)
     {
@@ -295,6 +303,31 @@ TEST_F(RmapTest, shouldRegisterRmapTargetInList)
     EXPECT_EQ(&mRmapTarget, mTargetNodes.getTargetNode(targetName));
 }
 
+TEST(RmapTargetsListTest, shouldFindTargetsByNameAndLogicalAddress)
+{
+    RmapTargetNode node0("Node", 0, 0x20, 0);
+    RmapTargetNode node1("Node1", 1, 0x21, 0);
+    RmapTargetNode node2("Node2", 2, 0x20, 0);
+    RmapTargetNode* nodes[] = {&node0, &node1, &node2};
+
+    RmapTargetsList list(outpost::asSlice(nodes));
+    EXPECT_EQ(3, list.getSize());
+
+    EXPECT_EQ(&node0, list.getTargetNode("Node"));
+    EXPECT_EQ(&node1, list.getTargetNode("Node1"));
+    EXPECT_EQ(&node2, list.getTargetNode("Node2"));
+    EXPECT_EQ(nullptr, list.getTargetNode("Node3"));
+
+    EXPECT_EQ(&node0, list.getTargetNode(static_cast<uint8_t>(0x20)));
+    EXPECT_EQ(&node1, list.getTargetNode(static_cast<uint8_t>(0x21)));
+    EXPECT_EQ(nullptr, list.getTargetNode(static_cast<uint8_t>(0x22)));
+
+    // Address changed after adding the node
+    node1.setTargetLogicalAddress(0x22);
+    EXPECT_EQ(&node1, list.getTargetNode(static_cast<uint8_t>(0x22)));
+    EXPECT_EQ(nullptr, list.getTargetNode(static_cast<uint8_t>(0x21)));
+}
+
 TEST_F(RmapTest, shouldGetEmptyTransactionsList)
 {
     EXPECT_EQ(0, mTestingRmap.getActiveTransactions(mRmapInitiator));
@@ -322,6 +355,42 @@ TEST_F(RmapTest, shouldGetUsedTransactionFromList)
     EXPECT_TRUE(mTestingRmap.isUsedTransaction(mRmapInitiator, 80));
 }
 
+TEST_F(RmapTest, shouldAssignNewTransactionIdOnReuse)
+{
+    RmapTransaction* transaction = mTestingRmap.getFreeTransaction(mRmapInitiator);
+    uint16_t first = transaction->getTransactionID();
+    mTestingRmap.removeTransaction(mRmapInitiator, first);
+
+    // the same transaction is used again with a different ID
+    EXPECT_EQ(transaction, mTestingRmap.getFreeTransaction(mRmapInitiator));
+    uint16_t second = transaction->getTransactionID();
+    EXPECT_NE(first, second);
+
+    EXPECT_EQ(transaction, mTestingRmap.getTransaction(mRmapInitiator, second));
+    EXPECT_EQ(nullptr, mTestingRmap.getTransaction(mRmapInitiator, first));
+    EXPECT_FALSE(mTestingRmap.isUsedTransaction(mRmapInitiator, first));
+}
+
+TEST_F(RmapTest, shouldReserveAllTransactions)
+{
+    RmapTransaction* transactions[rmap::maxConcurrentTransactions];
+    for (unsigned int i = 0; i < rmap::maxConcurrentTransactions; i++)
+    {
+        transactions[i] = mTestingRmap.getFreeTransaction(mRmapInitiator);
+        ASSERT_NE(nullptr, transactions[i]);
+    }
+    EXPECT_EQ(nullptr, mTestingRmap.getFreeTransaction(mRmapInitiator));
+    EXPECT_EQ(rmap::maxConcurrentTransactions, mTestingRmap.getActiveTransactions(mRmapInitiator));
+
+    for (unsigned int i = 0; i < rmap::maxConcurrentTransactions; i++)
+    {
+        uint16_t tid = transactions[i]->getTransactionID();
+        EXPECT_EQ(transactions[i], mTestingRmap.getTransaction(mRmapInitiator, tid));
+        mTestingRmap.removeTransaction(mRmapInitiator, tid);
+    }
+    EXPECT_EQ(0, mTestingRmap.getActiveTransactions(mRmapInitiator));
+}
+
 TEST_F(RmapTest, shouldSetReplyPacketType)
 {
     RmapPacket::InstructionField instruction;
@@ -462,7 +531,7 @@ TEST_F(RmapTest, shouldReceiveReplyOfWriteCommandPacket)
     mHandler.handlePackage(outpost::asSlice(reply).first(stream.getPosition()),
                            stream.getPosition());
 
-    RmapPacket receivedPacket;
+    RmapPacketView receivedPacket;
     EXPECT_TRUE(mTestingRmap.receivePacket(mRmapInitiator, &receivedPacket, rxBuffer));
     EXPECT_TRUE(receivedPacket.isReplyPacket());
     EXPECT_TRUE(receivedPacket.isWrite());
@@ -540,7 +609,7 @@ TEST_F(RmapTest, shouldReceiveReplyOfReadCommandPacket)
     mHandler.handlePackage(outpost::asSlice(reply).first(stream.getPosition()),
                            stream.getPosition());
 
-    RmapPacket rxedPacket;
+    RmapPacketView rxedPacket;
     EXPECT_TRUE(mTestingRmap.receivePacket(mRmapInitiator, &rxedPacket, rxBuffer));
     EXPECT_TRUE(rxedPacket.isReplyPacket());
 
@@ -891,9 +960,22 @@ TEST_F(RmapTest, testInvalidParameters)
             targetName, options, address, extaddress, outpost::Slice<uint8_t>::empty());
     EXPECT_EQ(RmapResult::Code::invalidParameters, ret.getResult());
 
-    uint8_t tooLong[rmap::bufferSize + 1];
-    ret = mRmapInitiator.read(targetName, options, address, extaddress, outpost::asSlice(tooLong));
+    // Larger buffers are split, only the zero-copy read is limited to a single command
+    outpost::utils::SharedChildPointer data;
+    outpost::utils::LogBuffer<4> logBuffer;
+    outpost::utils::Log::setBuffer(&logBuffer);
+    ret = mRmapInitiator.read(
+            mRmapTarget, options, address, extaddress, rmap::bufferSize + 1, data);
+    outpost::utils::Log::setBuffer(nullptr);
     EXPECT_EQ(RmapResult::Code::invalidParameters, ret.getResult());
+    EXPECT_FALSE(data.isValid());
+
+    // The reason is logged with the requested and the allowed size
+    outpost::utils::LogRecord record;
+    ASSERT_TRUE(logBuffer.read(record));
+    ASSERT_EQ(2U, record.mNumberOfArguments);
+    EXPECT_EQ(static_cast<uint32_t>(rmap::bufferSize + 1), record.mArguments[0]);
+    EXPECT_EQ(static_cast<uint32_t>(rmap::bufferSize), record.mArguments[1]);
 
     ret = mRmapInitiator.write(nullptr, options, address, extaddress, outpost::asSlice(readBuffer));
     EXPECT_EQ(RmapResult::Code::invalidParameters, ret.getResult());
@@ -1629,3 +1711,761 @@ TEST_F(RmapTest, testTooManyTransactions)
     EXPECT_EQ(1u, noFreeTransaction);
     EXPECT_EQ(rmap::maxConcurrentTransactions, timeOuted);
 }
+
+namespace
+{
+class CompletionCounter : public RmapCompletionHandler
+{
+public:
+    CompletionCounter() : mCompleted(0), mLastRequest(nullptr)
+    {
+    }
+
+    virtual void
+    onRmapCompletion(RmapRequest& request) override
+    {
+        mCompleted++;
+        mLastRequest = &request;
+    }
+
+    unsigned int mCompleted;
+    RmapRequest* mLastRequest;
+};
+}  // namespace
+
+TEST_F(RmapTest, submittedReadsShouldUseAllTransactions)
+{
+    // for easier parsing of send command
+    mRmapTarget.setReplyAddress(outpost::Slice<uint8_t>::empty());
+    mRmapTarget.setTargetSpaceWireAddress(outpost::Slice<uint8_t>::empty());
+
+    RMapOptions options;
+    options.mIncrementMode = true;
+    options.mReplyMode = true;
+    options.mVerifyMode = true;
+
+    static const uint8_t extaddress = 0x7e;
+    static const uint32_t address = 0x1000;
+
+    CompletionCounter handler;
+    std::unique_ptr<RmapRequest> requests[rmap::maxConcurrentTransactions];
+    uint8_t readBuffers[rmap::maxConcurrentTransactions][4] = {};
+
+    // all requests are issued from the same thread without waiting
+    for (unsigned int i = 0; i < rmap::maxConcurrentTransactions; i++)
+    {
+        requests[i].reset(new RmapRequest(&handler));
+        EXPECT_TRUE(mRmapInitiator.submitRead(mRmapTarget,
+                                              options,
+                                              address,
+                                              extaddress,
+                                              outpost::asSlice(readBuffers[i]),
+                                              *requests[i]));
+        EXPECT_TRUE(requests[i]->isPending());
+    }
+    EXPECT_EQ(rmap::maxConcurrentTransactions, mTestingRmap.getActiveTransactions(mRmapInitiator));
+    EXPECT_EQ(rmap::maxConcurrentTransactions, mSpaceWire.mSentPackets.size());
+
+    uint8_t otherBuffer[4];
+    RmapRequest other;
+    EXPECT_FALSE(mRmapInitiator.submitRead(
+            mRmapTarget, options, address, extaddress, outpost::asSlice(otherBuffer), other));
+    EXPECT_EQ(RmapResult::Code::noFreeTransactions, other.getResult().getResult());
+
+    // reply in reverse order, the value identifies the request
+    uint8_t value = rmap::maxConcurrentTransactions;
+    for (auto it = mSpaceWire.mSentPackets.rbegin(); it != mSpaceWire.mSentPackets.rend(); ++it)
+    {
+        value--;
+        auto answer = constructReadReplyPacket(it->data, value, 4);
+        mHandler.handlePackage(outpost::asSlice(answer), answer.size());
+        mTestingRmap.step(mRmapInitiator);
+
+        EXPECT_FALSE(requests[value]->isPending());
+        EXPECT_EQ(requests[value].get(), handler.mLastRequest);
+    }
+
+    EXPECT_EQ(rmap::maxConcurrentTransactions, handler.mCompleted);
+    EXPECT_EQ(0, mTestingRmap.getActiveTransactions(mRmapInitiator));
+    for (unsigned int i = 0; i < rmap::maxConcurrentTransactions; i++)
+    {
+        EXPECT_EQ(RmapResult::Code::success, requests[i]->getResult().getResult());
+        EXPECT_EQ(4U, requests[i]->getResult().getReadBytes());
+        for (unsigned int k = 0; k < 4; k++)
+        {
+            EXPECT_EQ(i, readBuffers[i][k]);
+        }
+    }
+}
+
+namespace
+{
+/// Submits the request again from its completion handler
+class Resubmitter : public RmapCompletionHandler
+{
+public:
+    Resubmitter(RmapInitiator& initiator, RmapTargetNode& target, outpost::Slice<uint8_t> buffer) :
+        mInitiator(initiator),
+        mTarget(target),
+        mBuffer(buffer),
+        mResubmitted(false)
+    {
+    }
+
+    virtual void
+    onRmapCompletion(RmapRequest& request) override
+    {
+        if (!mResubmitted)
+        {
+            mResubmitted = true;
+            mInitiator.submitRead(mTarget, RMapOptions(), 0x1000, 0x7e, mBuffer, request);
+        }
+    }
+
+    RmapInitiator& mInitiator;
+    RmapTargetNode& mTarget;
+    outpost::Slice<uint8_t> mBuffer;
+    bool mResubmitted;
+};
+}  // namespace
+
+TEST_F(RmapTest, resubmittedRequestShouldNotBeCompletedByEarlierReply)
+{
+    // for easier parsing of send command
+    mRmapTarget.setReplyAddress(outpost::Slice<uint8_t>::empty());
+    mRmapTarget.setTargetSpaceWireAddress(outpost::Slice<uint8_t>::empty());
+
+    uint8_t readBuffer[4] = {};
+    Resubmitter handler(mRmapInitiator, mRmapTarget, outpost::asSlice(readBuffer));
+    RmapRequest request(&handler);
+    EXPECT_TRUE(mRmapInitiator.submitRead(
+            mRmapTarget, RMapOptions(), 0x1000, 0x7e, outpost::asSlice(readBuffer), request));
+
+    auto answer = constructReadReplyPacket(mSpaceWire.mSentPackets.front().data, 0x12, 4);
+    mHandler.handlePackage(outpost::asSlice(answer), answer.size());
+    mTestingRmap.step(mRmapInitiator);
+
+    // The reply only finished the first submission
+    ASSERT_TRUE(handler.mResubmitted);
+    EXPECT_TRUE(request.isPending());
+    EXPECT_EQ(RmapResult::Code::timeout,
+              mRmapInitiator.wait(request, outpost::time::Milliseconds(10)).getResult());
+    EXPECT_EQ(0, mTestingRmap.getActiveTransactions(mRmapInitiator));
+}
+
+TEST_F(RmapTest, waitShouldReturnResultOfSubmittedWrite)
+{
+    uint8_t writeBuffer[4] = {0x01, 0x02, 0x03, 0x04};
+
+    // for easier parsing of send command
+    mRmapTarget.setReplyAddress(outpost::Slice<uint8_t>::empty());
+    mRmapTarget.setTargetSpaceWireAddress(outpost::Slice<uint8_t>::empty());
+
+    RMapOptions options;
+    options.mIncrementMode = true;
+    options.mReplyMode = true;
+    options.mVerifyMode = true;
+
+    RmapRequest request;
+    EXPECT_TRUE(mRmapInitiator.submitWrite(
+            mRmapTarget, options, 0x1000, 0x7e, outpost::asSlice(writeBuffer), request));
+
+    auto& packet = *mSpaceWire.mSentPackets.begin();
+    EXPECT_EQ(packet.data.size(), rmap::writeCommandOverhead + sizeof(writeBuffer));
+
+    auto answer = constructWriteReplyPacket(packet.data);
+    mHandler.handlePackage(outpost::asSlice(answer), answer.size());
+    mTestingRmap.step(mRmapInitiator);
+
+    EXPECT_EQ(RmapResult::Code::success,
+              mRmapInitiator.wait(request, outpost::time::Duration::zero()).getResult());
+    EXPECT_EQ(0, mTestingRmap.getActiveTransactions(mRmapInitiator));
+}
+
+TEST_F(RmapTest, submittedWriteWithoutReplyShouldCompleteImmediately)
+{
+    uint8_t writeBuffer[4] = {0x01, 0x02, 0x03, 0x04};
+
+    RMapOptions options;
+    options.mIncrementMode = true;
+    options.mReplyMode = false;
+    options.mVerifyMode = true;
+
+    CompletionCounter handler;
+    RmapRequest request(&handler);
+    EXPECT_TRUE(mRmapInitiator.submitWrite(
+            mRmapTarget, options, 0x1000, 0x7e, outpost::asSlice(writeBuffer), request));
+
+    EXPECT_FALSE(request.isPending());
+    EXPECT_EQ(1U, handler.mCompleted);
+    EXPECT_EQ(RmapResult::Code::success, request.getResult().getResult());
+    EXPECT_EQ(0, mTestingRmap.getActiveTransactions(mRmapInitiator));
+    EXPECT_EQ(1U, mSpaceWire.mSentPackets.size());
+}
+
+TEST_F(RmapTest, waitShouldCancelRequestOnTimeout)
+{
+    uint8_t readBuffer[4] = {0x00, 0x00, 0x00, 0x00};
+
+    // for easier parsing of send command
+    mRmapTarget.setReplyAddress(outpost::Slice<uint8_t>::empty());
+    mRmapTarget.setTargetSpaceWireAddress(outpost::Slice<uint8_t>::empty());
+
+    RMapOptions options;
+    options.mIncrementMode = true;
+    options.mReplyMode = true;
+    options.mVerifyMode = true;
+
+    CompletionCounter handler;
+    RmapRequest request(&handler);
+    EXPECT_TRUE(mRmapInitiator.submitRead(
+            mRmapTarget, options, 0x1000, 0x7e, outpost::asSlice(readBuffer), request));
+
+    EXPECT_EQ(RmapResult::Code::timeout,
+              mRmapInitiator.wait(request, outpost::time::Milliseconds(10)).getResult());
+    EXPECT_FALSE(request.isPending());
+    EXPECT_FALSE(mRmapInitiator.cancel(request));
+    EXPECT_EQ(0, mTestingRmap.getActiveTransactions(mRmapInitiator));
+
+    // a late reply does not belong to any transaction
+    auto& packet = *mSpaceWire.mSentPackets.begin();
+    auto answer = constructReadReplyPacket(packet.data, 0xAB, sizeof(readBuffer));
+    mHandler.handlePackage(outpost::asSlice(answer), answer.size());
+    mTestingRmap.step(mRmapInitiator);
+
+    EXPECT_EQ(0U, handler.mCompleted);
+    EXPECT_EQ(1U, mRmapInitiator.getErrorCounters().mUnknownTransactionID);
+    EXPECT_EQ(0x00, readBuffer[0]);
+}
+
+TEST_F(RmapTest, readBatchShouldCoalesceAdjacentElements)
+{
+    // for easier parsing of send command
+    mRmapTarget.setReplyAddress(outpost::Slice<uint8_t>::empty());
+    mRmapTarget.setTargetSpaceWireAddress(outpost::Slice<uint8_t>::empty());
+
+    RMapOptions options;
+    options.mIncrementMode = true;
+    options.mReplyMode = true;
+    options.mVerifyMode = true;
+
+    uint8_t first[4] = {};
+    uint8_t second[4] = {};
+    uint8_t third[2] = {};
+    RmapReadElement elements[] = {RmapReadElement(0x1000, outpost::asSlice(first)),
+                                  RmapReadElement(0x1004, outpost::asSlice(second)),
+                                  RmapReadElement(0x2000, outpost::asSlice(third))};
+
+    auto batch = std::async(std::launch::async, [&]() {
+        return mRmapInitiator.readBatch(mRmapTarget, options, 0x7e, outpost::asSlice(elements));
+    });
+    batch.wait_for(std::chrono::milliseconds(50));  // give it time to send
+
+    // both commands are sent before any reply arrived
+    ASSERT_EQ(2U, mSpaceWire.mSentPackets.size());
+    EXPECT_EQ(2U, mTestingRmap.getActiveTransactions(mRmapInitiator));
+
+    auto answer = constructReadReplyPacket(mSpaceWire.mSentPackets.front().data, 0x11, 8);
+    mHandler.handlePackage(outpost::asSlice(answer), answer.size());
+    mTestingRmap.step(mRmapInitiator);
+
+    answer = constructReadReplyPacket(mSpaceWire.mSentPackets.back().data, 0x22, 2);
+    mHandler.handlePackage(outpost::asSlice(answer), answer.size());
+    mTestingRmap.step(mRmapInitiator);
+
+    auto status = batch.wait_for(std::chrono::milliseconds(50));  // give it time process reply
+    if (status == std::future_status::ready)
+    {
+        RmapResult result = batch.get();
+        EXPECT_EQ(RmapResult::Code::success, result.getResult());
+        EXPECT_EQ(10U, result.getReadBytes());
+    }
+    else
+    {
+        EXPECT_TRUE(false);
+        exit(-1);  // no other way to stop the threads, unit tests will still fail.
+    }
+
+    for (auto& element : elements)
+    {
+        EXPECT_EQ(RmapResult::Code::success, element.mResult.getResult());
+        EXPECT_EQ(element.mBuffer.getNumberOfElements(), element.mResult.getReadBytes());
+    }
+    EXPECT_EQ(0x11, first[0]);
+    EXPECT_EQ(0x11, second[3]);
+    EXPECT_EQ(0x22, third[1]);
+    EXPECT_EQ(0, mTestingRmap.getActiveTransactions(mRmapInitiator));
+}
+
+TEST_F(RmapTest, readBatchShouldRejectEmptyElement)
+{
+    RMapOptions options;
+    uint8_t buffer[4] = {};
+    RmapReadElement elements[] = {RmapReadElement(0x1000, outpost::asSlice(buffer)),
+                                  RmapReadElement(0x2000, outpost::Slice<uint8_t>::empty())};
+
+    EXPECT_EQ(RmapResult::Code::invalidParameters,
+              mRmapInitiator.readBatch(mRmapTarget, options, 0, outpost::asSlice(elements))
+                      .getResult());
+    EXPECT_TRUE(mSpaceWire.mSentPackets.empty());
+}
+
+TEST_F(RmapTest, writeLargerThanTransmitBufferShouldFail)
+{
+    // the transmit buffers of the SpaceWire stub are limited to 100 bytes
+    uint8_t writeBuffer[100] = {};
+
+    RMapOptions options;
+    options.mIncrementMode = true;
+    options.mReplyMode = false;
+    options.mVerifyMode = true;
+
+    EXPECT_EQ(RmapResult::Code::sendFailed,
+              mRmapInitiator.write(mRmapTarget, options, 0x1000, 0x7e, outpost::asSlice(writeBuffer))
+                      .getResult());
+
+    // the transmit buffer is returned as discarded packet
+    ASSERT_EQ(1U, mSpaceWire.mSentPackets.size());
+    EXPECT_TRUE(mSpaceWire.mSentPackets.front().data.empty());
+    EXPECT_EQ(SpaceWire::eep, mSpaceWire.mSentPackets.front().end);
+    EXPECT_EQ(0, mTestingRmap.getActiveTransactions(mRmapInitiator));
+}
+
+TEST_F(RmapTest, readShouldProvideReceivedBufferWithoutCopy)
+{
+    // for easier parsing of send command
+    mRmapTarget.setReplyAddress(outpost::Slice<uint8_t>::empty());
+    mRmapTarget.setTargetSpaceWireAddress(outpost::Slice<uint8_t>::empty());
+
+    RMapOptions options;
+    options.mIncrementMode = true;
+    options.mReplyMode = true;
+    options.mVerifyMode = true;
+
+    size_t freeBuffers = mTestingRmap.getNumberOfFreeReceiveBuffers(mRmapInitiator);
+
+    outpost::utils::SharedChildPointer data;
+    auto read1 = std::async(std::launch::async, [&]() {
+        return mRmapInitiator.read(mRmapTarget, options, 0x1000, 0x7e, 16, data);
+    });
+    read1.wait_for(std::chrono::milliseconds(50));  // give it time to send
+
+    auto& packet = *mSpaceWire.mSentPackets.begin();
+    auto answer = constructReadReplyPacket(packet.data, 0x5A, 16);
+    mHandler.handlePackage(outpost::asSlice(answer), answer.size());
+    mTestingRmap.step(mRmapInitiator);
+
+    auto status = read1.wait_for(std::chrono::milliseconds(50));  // give it time process reply
+    if (status == std::future_status::ready)
+    {
+        EXPECT_EQ(RmapResult::Code::success, read1.get().getResult());
+    }
+    else
+    {
+        EXPECT_TRUE(false);
+        exit(-1);  // no other way to stop the threads, unit tests will still fail.
+    }
+
+    ASSERT_TRUE(data.isValid());
+    ASSERT_EQ(16U, data.asSlice().getNumberOfElements());
+    for (unsigned int i = 0; i < 16; i++)
+    {
+        EXPECT_EQ(0x5A, data.asSlice()[i]);
+    }
+    EXPECT_EQ(0, mTestingRmap.getActiveTransactions(mRmapInitiator));
+
+    // the receive buffer is held until the data is released
+    EXPECT_EQ(freeBuffers - 1, mTestingRmap.getNumberOfFreeReceiveBuffers(mRmapInitiator));
+    data = outpost::utils::SharedChildPointer();
+    EXPECT_EQ(freeBuffers, mTestingRmap.getNumberOfFreeReceiveBuffers(mRmapInitiator));
+}
+
+TEST_F(RmapTest, initiatorShouldUseConfiguredResources)
+{
+    GenericRmapInitiator<2, 16> initiator(mHandler,
+                                          &mTargetNodes,
+                                          100,
+                                          4096,
+                                          outpost::support::parameter::HeartbeatSource::default0);
+    EXPECT_EQ(16U, initiator.getMaximumDataLength());
+
+    RMapOptions options;
+    options.mReplyMode = true;
+
+    uint8_t tooLarge[17];
+    RmapRequest request0;
+    EXPECT_FALSE(initiator.submitRead(
+            mRmapTarget, options, 0x1000, 0, outpost::asSlice(tooLarge), request0));
+    EXPECT_EQ(RmapResult::Code::invalidParameters, request0.getResult().getResult());
+
+    uint8_t buffer[3][16];
+    RmapRequest request1;
+    RmapRequest request2;
+    EXPECT_TRUE(initiator.submitRead(
+            mRmapTarget, options, 0x1000, 0, outpost::asSlice(buffer[0]), request0));
+    EXPECT_TRUE(initiator.submitRead(
+            mRmapTarget, options, 0x1000, 0, outpost::asSlice(buffer[1]), request1));
+    EXPECT_FALSE(initiator.submitRead(
+            mRmapTarget, options, 0x1000, 0, outpost::asSlice(buffer[2]), request2));
+    EXPECT_EQ(RmapResult::Code::noFreeTransactions, request2.getResult().getResult());
+    EXPECT_EQ(2U, initiator.getActiveTransactions());
+
+    EXPECT_TRUE(initiator.cancel(request0));
+    EXPECT_TRUE(initiator.cancel(request1));
+    EXPECT_EQ(0U, initiator.getActiveTransactions());
+}
+
+TEST_F(RmapTest, readShouldSplitLargeBufferIntoConcurrentCommands)
+{
+    // for easier parsing of send command
+    mRmapTarget.setReplyAddress(outpost::Slice<uint8_t>::empty());
+    mRmapTarget.setTargetSpaceWireAddress(outpost::Slice<uint8_t>::empty());
+
+    RMapOptions options;
+    options.mIncrementMode = true;
+    options.mReplyMode = true;
+    options.mVerifyMode = true;
+
+    static const size_t length = 2 * rmap::bufferSize + 100;
+    std::vector<uint8_t> buffer(length, 0);
+    auto read = std::async(std::launch::async, [&]() {
+        return mRmapInitiator.read(mRmapTarget, options, 0x1000, 0x7e, outpost::asSlice(buffer));
+    });
+    read.wait_for(std::chrono::milliseconds(50));  // give it time to send
+
+    // all commands are sent before any reply arrived
+    ASSERT_EQ(3U, mSpaceWire.mSentPackets.size());
+    EXPECT_EQ(3U, mTestingRmap.getActiveTransactions(mRmapInitiator));
+
+    uint32_t expectedAddress = 0x1000;
+    uint8_t value = 1;
+    for (auto& packet : mSpaceWire.mSentPackets)
+    {
+        uint32_t address = (packet.data[8] << 24) | (packet.data[9] << 16) | (packet.data[10] << 8)
+                           | packet.data[11];
+        uint32_t count = (packet.data[12] << 16) | (packet.data[13] << 8) | packet.data[14];
+        EXPECT_EQ(expectedAddress, address);
+        expectedAddress += count;
+
+        auto answer = constructReadReplyPacket(packet.data, value++, count);
+        mHandler.handlePackage(outpost::asSlice(answer), answer.size());
+        mTestingRmap.step(mRmapInitiator);
+    }
+    EXPECT_EQ(0x1000 + length, expectedAddress);
+
+    auto status = read.wait_for(std::chrono::milliseconds(50));  // give it time process reply
+    if (status == std::future_status::ready)
+    {
+        RmapResult result = read.get();
+        EXPECT_EQ(RmapResult::Code::success, result.getResult());
+        EXPECT_EQ(length, result.getReadBytes());
+    }
+    else
+    {
+        EXPECT_TRUE(false);
+        exit(-1);  // no other way to stop the threads, unit tests will still fail.
+    }
+
+    EXPECT_EQ(1, buffer[0]);
+    EXPECT_EQ(1, buffer[rmap::bufferSize - 1]);
+    EXPECT_EQ(2, buffer[rmap::bufferSize]);
+    EXPECT_EQ(3, buffer[length - 1]);
+    EXPECT_EQ(0, mTestingRmap.getActiveTransactions(mRmapInitiator));
+}
+
+TEST_F(RmapTest, readShouldReportFirstFailureOfSplitRead)
+{
+    // for easier parsing of send command
+    mRmapTarget.setReplyAddress(outpost::Slice<uint8_t>::empty());
+    mRmapTarget.setTargetSpaceWireAddress(outpost::Slice<uint8_t>::empty());
+
+    RMapOptions options;
+    options.mIncrementMode = true;
+    options.mReplyMode = true;
+    options.mVerifyMode = true;
+
+    std::vector<uint8_t> buffer(2 * rmap::bufferSize, 0);
+    auto read = std::async(std::launch::async, [&]() {
+        return mRmapInitiator.read(mRmapTarget, options, 0x1000, 0x7e, outpost::asSlice(buffer));
+    });
+    read.wait_for(std::chrono::milliseconds(50));  // give it time to send
+    ASSERT_EQ(2U, mSpaceWire.mSentPackets.size());
+
+    auto answer = constructReadReplyErrorPacket(mSpaceWire.mSentPackets.front().data,
+                                                RmapReplyStatus::generalErrorCode);
+    mHandler.handlePackage(outpost::asSlice(answer), answer.size());
+    mTestingRmap.step(mRmapInitiator);
+
+    answer = constructReadReplyPacket(mSpaceWire.mSentPackets.back().data, 0x22, rmap::bufferSize);
+    mHandler.handlePackage(outpost::asSlice(answer), answer.size());
+    mTestingRmap.step(mRmapInitiator);
+
+    auto status = read.wait_for(std::chrono::milliseconds(50));  // give it time process reply
+    if (status == std::future_status::ready)
+    {
+        RmapResult result = read.get();
+        EXPECT_EQ(RmapResult::Code::executionFailed, result.getResult());
+        EXPECT_EQ(RmapReplyStatus::generalErrorCode, result.getReplyErrorCode());
+    }
+    else
+    {
+        EXPECT_TRUE(false);
+        exit(-1);  // no other way to stop the threads, unit tests will still fail.
+    }
+    EXPECT_EQ(0, mTestingRmap.getActiveTransactions(mRmapInitiator));
+}
+
+TEST_F(RmapTest, writeShouldSplitLargeData)
+{
+    GenericRmapInitiator<2, 16> initiator(mHandler,
+                                          &mTargetNodes,
+                                          100,
+                                          4096,
+                                          outpost::support::parameter::HeartbeatSource::default0);
+
+    // for easier parsing of send command
+    mRmapTarget.setReplyAddress(outpost::Slice<uint8_t>::empty());
+    mRmapTarget.setTargetSpaceWireAddress(outpost::Slice<uint8_t>::empty());
+
+    RMapOptions options;
+    options.mIncrementMode = true;
+    options.mReplyMode = false;
+    options.mVerifyMode = false;
+
+    uint8_t data[40];
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    EXPECT_EQ(RmapResult::Code::success,
+              initiator.write(mRmapTarget, options, 0x1000, 0x7e, outpost::asSlice(data))
+                      .getResult());
+
+    ASSERT_EQ(3U, mSpaceWire.mSentPackets.size());
+    uint32_t expectedAddress = 0x1000;
+    for (auto& packet : mSpaceWire.mSentPackets)
+    {
+        uint32_t address = (packet.data[8] << 24) | (packet.data[9] << 16) | (packet.data[10] << 8)
+                           | packet.data[11];
+        uint32_t count = (packet.data[12] << 16) | (packet.data[13] << 8) | packet.data[14];
+        EXPECT_EQ(expectedAddress, address);
+        ASSERT_EQ(16U + count + 1, packet.data.size());
+        EXPECT_EQ(data[address - 0x1000], packet.data[16]);
+        expectedAddress += count;
+    }
+    EXPECT_EQ(0x1000U + sizeof(data), expectedAddress);
+    EXPECT_EQ(0U, initiator.getActiveTransactions());
+}
+
+TEST(RmapTargetStatisticsTest, shouldSortLatenciesIntoBuckets)
+{
+    RmapTargetStatistics statistics;
+    EXPECT_EQ(outpost::time::Duration::zero(), statistics.getMinimumLatency());
+    EXPECT_EQ(outpost::time::Duration::zero(), statistics.getAverageLatency());
+
+    statistics.recordReply(outpost::time::Microseconds(10), 4);
+    statistics.recordReply(outpost::time::Microseconds(64), 0);
+    statistics.recordReply(outpost::time::Seconds(10), 0);
+
+    EXPECT_EQ(3U, statistics.getNumberOfReplies());
+    EXPECT_EQ(4U, statistics.getBytesRead());
+    EXPECT_EQ(1U, statistics.getLatencyBucket(0));
+    EXPECT_EQ(1U, statistics.getLatencyBucket(1));
+    EXPECT_EQ(1U, statistics.getLatencyBucket(RmapTargetStatistics::numberOfLatencyBuckets - 1));
+    EXPECT_EQ(outpost::time::Microseconds(64), RmapTargetStatistics::getLatencyBucketLimit(0));
+    EXPECT_EQ(outpost::time::Duration::infinity(),
+              RmapTargetStatistics::getLatencyBucketLimit(
+                      RmapTargetStatistics::numberOfLatencyBuckets - 1));
+
+    EXPECT_EQ(outpost::time::Microseconds(10), statistics.getMinimumLatency());
+    EXPECT_EQ(outpost::time::Seconds(10), statistics.getMaximumLatency());
+    EXPECT_EQ(outpost::time::Microseconds(10000074 / 3), statistics.getAverageLatency());
+
+    statistics.reset();
+    EXPECT_EQ(0U, statistics.getNumberOfReplies());
+    EXPECT_EQ(0U, statistics.getLatencyBucket(0));
+}
+
+TEST(RmapTargetStatisticsTest, shouldAverageLatenciesBeyond32Bit)
+{
+    RmapTargetStatistics statistics;
+    for (int i = 0; i < 4; i++)
+    {
+        // Sum of 4800 s exceeds 2^32 us
+        statistics.recordReply(outpost::time::Seconds(1200), 0);
+    }
+    EXPECT_EQ(outpost::time::Seconds(1200), statistics.getAverageLatency());
+}
+
+TEST_F(RmapTest, shouldRecordTargetStatistics)
+{
+    // for easier parsing of send command
+    mRmapTarget.setReplyAddress(outpost::Slice<uint8_t>::empty());
+    mRmapTarget.setTargetSpaceWireAddress(outpost::Slice<uint8_t>::empty());
+
+    RMapOptions options;
+    options.mIncrementMode = true;
+    options.mReplyMode = true;
+    options.mVerifyMode = true;
+
+    uint8_t first[4] = {};
+    uint8_t second[4] = {};
+    RmapRequest request0;
+    RmapRequest request1;
+    EXPECT_TRUE(mRmapInitiator.submitRead(
+            mRmapTarget, options, 0x1000, 0x7e, outpost::asSlice(first), request0));
+    EXPECT_TRUE(mRmapInitiator.submitRead(
+            mRmapTarget, options, 0x2000, 0x7e, outpost::asSlice(second), request1));
+    EXPECT_EQ(2U, mRmapInitiator.getPeakActiveTransactions());
+
+    auto answer = constructReadReplyPacket(mSpaceWire.mSentPackets.front().data, 0x11, 4);
+    mHandler.handlePackage(outpost::asSlice(answer), answer.size());
+    mTestingRmap.step(mRmapInitiator);
+    EXPECT_EQ(RmapResult::Code::success, mRmapInitiator.wait(request0).getResult());
+
+    // no reply for the second request
+    EXPECT_TRUE(mRmapInitiator.cancel(request1));
+
+    uint8_t data[3] = {1, 2, 3};
+    options.mReplyMode = false;
+    EXPECT_EQ(RmapResult::Code::success,
+              mRmapInitiator.write(mRmapTarget, options, 0x3000, 0x7e, outpost::asSlice(data))
+                      .getResult());
+
+    const RmapTargetStatistics& statistics = mRmapTarget.getStatistics();
+    EXPECT_EQ(3U, statistics.getNumberOfRequests());
+    EXPECT_EQ(1U, statistics.getNumberOfReplies());
+    EXPECT_EQ(1U, statistics.getNumberOfTimeouts());
+    EXPECT_EQ(4U, statistics.getBytesRead());
+    EXPECT_EQ(3U, statistics.getBytesWritten());
+    EXPECT_LE(statistics.getMinimumLatency(), statistics.getMaximumLatency());
+
+    uint32_t bucketed = 0;
+    for (size_t i = 0; i < RmapTargetStatistics::numberOfLatencyBuckets; i++)
+    {
+        bucketed += statistics.getLatencyBucket(i);
+    }
+    EXPECT_EQ(1U, bucketed);
+
+    EXPECT_EQ(2U, mRmapInitiator.getPeakActiveTransactions());
+    mRmapInitiator.resetPeakActiveTransactions();
+    EXPECT_EQ(0U, mRmapInitiator.getPeakActiveTransactions());
+}
+
+TEST(RmapTargetStatisticsTest, shouldSmoothLatency)
+{
+    RmapTargetStatistics statistics;
+    EXPECT_EQ(outpost::time::Duration::zero(), statistics.getSmoothedLatency());
+
+    statistics.recordReply(outpost::time::Microseconds(800), 0);
+    EXPECT_EQ(outpost::time::Microseconds(800), statistics.getSmoothedLatency());
+    EXPECT_EQ(outpost::time::Microseconds(400), statistics.getLatencyVariation());
+
+    statistics.recordReply(outpost::time::Microseconds(1600), 0);
+    EXPECT_EQ(outpost::time::Microseconds(900), statistics.getSmoothedLatency());
+    EXPECT_EQ(outpost::time::Microseconds(500), statistics.getLatencyVariation());
+
+    statistics.reset();
+    EXPECT_EQ(outpost::time::Duration::zero(), statistics.getSmoothedLatency());
+}
+
+TEST(RmapAdaptiveTimeoutTest, shouldDeriveTimeoutFromLatency)
+{
+    RmapTargetStatistics statistics;
+    RmapAdaptiveTimeout adaptiveTimeout;
+    const outpost::time::Duration limit = outpost::time::Seconds(1);
+
+    // disabled by default
+    EXPECT_EQ(limit, adaptiveTimeout.getTimeout(statistics, 0, limit));
+
+    adaptiveTimeout.mEnabled = true;
+    EXPECT_EQ(adaptiveTimeout.mInitial, adaptiveTimeout.getTimeout(statistics, 0, limit));
+
+    statistics.recordReply(outpost::time::Microseconds(800), 0);
+    EXPECT_EQ(outpost::time::Microseconds(800 + 4 * 400),
+              adaptiveTimeout.getTimeout(statistics, 0, limit));
+
+    // doubled per retry, limited by the timeout of the caller
+    EXPECT_EQ(outpost::time::Microseconds(4 * 2400),
+              adaptiveTimeout.getTimeout(statistics, 2, limit));
+    EXPECT_EQ(limit, adaptiveTimeout.getTimeout(statistics, 12, limit));
+
+    adaptiveTimeout.mMinimum = outpost::time::Milliseconds(5);
+    EXPECT_EQ(outpost::time::Milliseconds(5), adaptiveTimeout.getTimeout(statistics, 0, limit));
+}
+
+TEST_F(RmapTest, readShouldRetryWithAdaptiveTimeout)
+{
+    // for easier parsing of send command
+    mRmapTarget.setReplyAddress(outpost::Slice<uint8_t>::empty());
+    mRmapTarget.setTargetSpaceWireAddress(outpost::Slice<uint8_t>::empty());
+
+    RmapAdaptiveTimeout adaptiveTimeout;
+    adaptiveTimeout.mEnabled = true;
+    adaptiveTimeout.mRetries = 1;
+    adaptiveTimeout.mInitial = outpost::time::Milliseconds(5);
+    mRmapTarget.setAdaptiveTimeout(adaptiveTimeout);
+
+    RMapOptions options;
+    uint8_t buffer[4] = {};
+
+    // Without replies the read fails after two short attempts instead of blocking forever
+    auto read = std::async(std::launch::async, [&]() {
+        return mRmapInitiator.read(mRmapTarget, options, 0x1000, 0x7e, outpost::asSlice(buffer));
+    });
+
+    auto status = read.wait_for(std::chrono::milliseconds(500));
+    if (status == std::future_status::ready)
+    {
+        EXPECT_EQ(RmapResult::Code::timeout, read.get().getResult());
+    }
+    else
+    {
+        EXPECT_TRUE(false);
+        exit(-1);  // no other way to stop the threads, unit tests will still fail.
+    }
+
+    EXPECT_EQ(2U, mSpaceWire.mSentPackets.size());
+    EXPECT_EQ(2U, mRmapTarget.getStatistics().getNumberOfTimeouts());
+    EXPECT_EQ(0, mTestingRmap.getActiveTransactions(mRmapInitiator));
+}
+
+TEST_F(RmapTest, readRetriesShouldShareTheTimeoutOfTheCaller)
+{
+    // for easier parsing of send command
+    mRmapTarget.setReplyAddress(outpost::Slice<uint8_t>::empty());
+    mRmapTarget.setTargetSpaceWireAddress(outpost::Slice<uint8_t>::empty());
+
+    RmapAdaptiveTimeout adaptiveTimeout;
+    adaptiveTimeout.mEnabled = true;
+    adaptiveTimeout.mRetries = 5;
+    adaptiveTimeout.mInitial = outpost::time::Milliseconds(40);
+    mRmapTarget.setAdaptiveTimeout(adaptiveTimeout);
+
+    RMapOptions options;
+    uint8_t buffer[4] = {};
+
+    // The first attempt takes 40 ms, the second one only gets the remaining 20 ms
+    auto read = std::async(std::launch::async, [&]() {
+        return mRmapInitiator.read(mRmapTarget,
+                                   options,
+                                   0x1000,
+                                   0x7e,
+                                   outpost::asSlice(buffer),
+                                   outpost::time::Milliseconds(60));
+    });
+
+    auto status = read.wait_for(std::chrono::milliseconds(500));
+    if (status == std::future_status::ready)
+    {
+        EXPECT_EQ(RmapResult::Code::timeout, read.get().getResult());
+    }
+    else
+    {
+        EXPECT_TRUE(false);
+        exit(-1);  // no other way to stop the threads, unit tests will still fail.
+    }
+
+    EXPECT_EQ(2U, mSpaceWire.mSentPackets.size());
+    EXPECT_EQ(0, mTestingRmap.getActiveTransactions(mRmapInitiator));
+}
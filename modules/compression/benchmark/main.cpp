@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/*
+ * Throughput and compression ratio of the compression pipeline on the host.
+ *
+ * Every stage is measured for every Blocksize with the regression data of
+ * the unit tests and synthetic signals. One JSON record is written to
+ * stdout per measurement, see outpost::utils::BenchmarkRecord:
+ *
+ *     {"suite":"compression","benchmark":"riceEncode","signal":"sine","blocksize":1024,
+ *      "samples_per_second":21000000,"compression_ratio":2.310,"status":"ok"}
+ *
+ * The compression ratio relates 16 bit per sample to the number of bytes
+ * produced, including all headers. It is omitted for the transforms.
+ * The status is "ok" or "failed", the latter if a stage rejected its input
+ * or a decoded block did not have the expected length.
+ */
+
+#include <outpost/base/fixpoint.h>
+#include <outpost/base/slice.h>
+#include <outpost/compression/data_block.h>
+#include <outpost/compression/data_processor_thread.h>
+#include <outpost/compression/legall_wavelet.h>
+#include <outpost/compression/nls_encoder.h>
+#include <outpost/compression/rice_encoder.h>
+#include <outpost/rtos/clock.h>
+#include <outpost/utils/benchmark/benchmark_record.h>
+#include <outpost/utils/container/reference_queue.h>
+#include <outpost/utils/container/shared_object_pool.h>
+#include <outpost/utils/storage/bitstream.h>
+
+#include <math.h>
+#include <stdint.h>
+
+#include "regression_data.h"
+
+using outpost::Fixpoint;
+using namespace outpost::compression;
+
+namespace
+{
+const Blocksize blocksizes[] = {Blocksize::bs16,
+                                Blocksize::bs128,
+                                Blocksize::bs256,
+                                Blocksize::bs512,
+                                Blocksize::bs1024,
+                                Blocksize::bs2048,
+                                Blocksize::bs4096};
+
+// Number of samples processed per measurement, independent of the block size
+constexpr size_t samplesPerMeasurement = 1U << 19;
+constexpr size_t maximumLength = NLSEncoderBase::MAX_LENGTH;
+
+struct Signal
+{
+    const char* mName;
+    const int16_t* mData;
+};
+
+struct Result
+{
+    size_t mBytes;
+    bool mValid;
+};
+
+int16_t sine[maximumLength];
+int16_t noise[maximumLength];
+int16_t steps[maximumLength];
+
+const Signal signals[] = {{"regression1", regression_input1},
+                          {"regression2", regression_input2},
+                          {"sine", sine},
+                          {"noise", noise},
+                          {"steps", steps}};
+
+static_assert(sizeof(regression_input2) / sizeof(int16_t) >= maximumLength,
+              "Regression data does not cover the largest block size");
+
+outpost::rtos::SystemClock systemClock;
+NLSEncoder encoder;
+
+Fixpoint input[maximumLength];
+Fixpoint workspace[maximumLength];
+Fixpoint transformed[maximumLength];
+int16_t coefficients[maximumLength];
+int16_t integers[maximumLength];
+uint8_t streamBuffer[2 * maximumLength + outpost::Bitstream::headerSize];
+outpost::Slice<uint8_t> streamData(streamBuffer);
+outpost::Bitstream bitstream(streamData);
+
+outpost::utils::SharedBufferPool<maximumLength * sizeof(Fixpoint) + DataBlock::headerSize, 4>
+        pool;
+outpost::utils::ReferenceQueue<DataBlock, 2> inputQueue;
+outpost::utils::ReferenceQueue<DataBlock, 2> outputQueue;
+
+void
+createSignals()
+{
+    uint32_t state = 12345U;
+    for (size_t i = 0; i < maximumLength; i++)
+    {
+        // Slowly varying housekeeping value with small quantization noise
+        sine[i] = static_cast<int16_t>(500.0 * sin(i * 0.01) + (i * 7919U) % 17U);
+
+        // Uniform noise over 12 bit, the worst case for both schemes
+        state = state * 1103515245U + 12345U;
+        noise[i] = static_cast<int16_t>(((state >> 16) & 0xFFFU) - 0x800);
+
+        // Mode changes of a status parameter
+        steps[i] = static_cast<int16_t>(((i / 300U) % 4U) * 1000);
+    }
+}
+
+Result
+runForwardTransform(size_t length)
+{
+    LeGall53Wavelet::forwardTransform(outpost::Slice<Fixpoint>::unsafe(input, length),
+                                      outpost::Slice<Fixpoint>::unsafe(workspace, length));
+    Result result = {0, true};
+    return result;
+}
+
+Result
+runForwardTransformInPlace(size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        workspace[i] = input[i];
+    }
+    LeGall53Wavelet::forwardTransformInPlace(outpost::Slice<Fixpoint>::unsafe(workspace, length));
+    Result result = {0, true};
+    return result;
+}
+
+Result
+runNLSEncode(size_t length)
+{
+    // The encoder converts the coefficients to their absolute values
+    for (size_t i = 0; i < length; i++)
+    {
+        integers[i] = coefficients[i];
+    }
+    bitstream.reset();
+    encoder.encode(outpost::Slice<int16_t>::unsafe(integers, length), bitstream);
+    Result result = {bitstream.getSerializedSize(), true};
+    return result;
+}
+
+Result
+runNLSDecode(size_t length)
+{
+    outpost::Slice<int16_t> values = outpost::Slice<int16_t>::unsafe(integers, length);
+    Result result = {bitstream.getSerializedSize(),
+                     encoder.decode(bitstream, values).getNumberOfElements() == length};
+    return result;
+}
+
+Result
+runWaveletDecode(size_t length)
+{
+    outpost::Slice<int16_t> values = outpost::Slice<int16_t>::unsafe(integers, length);
+    bool valid = encoder.decode(bitstream, values).getNumberOfElements() == length
+                 && LeGall53Wavelet::backwardTransformInPlaceOrdered(
+                            values, outpost::Slice<Fixpoint>::unsafe(workspace, length))
+                                    .getNumberOfElements()
+                            == length;
+    Result result = {bitstream.getSerializedSize(), valid};
+    return result;
+}
+
+Result
+runRiceEncode(size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        integers[i] = static_cast<int16_t>(input[i]);
+    }
+    bitstream.reset();
+    RiceEncoder::encode(outpost::Slice<const int16_t>::unsafe(integers, length), bitstream);
+    Result result = {bitstream.getSerializedSize(), true};
+    return result;
+}
+
+Result
+runRiceDecode(size_t length)
+{
+    outpost::Slice<int16_t> values = outpost::Slice<int16_t>::unsafe(integers, length);
+    Result result = {bitstream.getSerializedSize(),
+                     RiceEncoder::decode(bitstream, values).getNumberOfElements() == length};
+    return result;
+}
+
+DataProcessorThread* processor = nullptr;
+
+Result
+runDataProcessorThread(size_t length)
+{
+    Result result = {0, false};
+    outpost::utils::SharedBufferPointer p;
+    if (!pool.allocate(p))
+    {
+        return result;
+    }
+
+    Blocksize bs = Blocksize::disabled;
+    for (Blocksize candidate : blocksizes)
+    {
+        if (toUInt(candidate) == length)
+        {
+            bs = candidate;
+        }
+    }
+    DataBlock block(p,
+                    1U,
+                    outpost::time::GpsTime::afterEpoch(outpost::time::Duration::zero()),
+                    SamplingRate::hz1,
+                    bs);
+    for (size_t i = 0; i < length; i++)
+    {
+        block.push(input[i]);
+    }
+
+    DataBlock encoded;
+    if (inputQueue.send(block))
+    {
+        processor->processSingleBlock(outpost::time::Duration::zero());
+        if (outputQueue.receive(encoded, outpost::time::Duration::zero()))
+        {
+            result.mBytes = encoded.getEncodedData().getNumberOfElements();
+            result.mValid = encoded.isEncoded();
+        }
+    }
+    return result;
+}
+
+struct Benchmark
+{
+    const char* mName;
+    Result (*mRun)(size_t);
+    bool mReportsRatio;
+};
+
+// Decoders operate on the bitstream left by the preceding encoder
+const Benchmark benchmarks[] = {{"forwardTransform", runForwardTransform, false},
+                                {"forwardTransformInPlace", runForwardTransformInPlace, false},
+                                {"nlsEncode", runNLSEncode, true},
+                                {"nlsDecode", runNLSDecode, true},
+                                {"waveletDecode", runWaveletDecode, true},
+                                {"riceEncode", runRiceEncode, true},
+                                {"riceDecode", runRiceDecode, true},
+                                {"dataProcessorThread", runDataProcessorThread, true}};
+
+void
+measure(const Benchmark& benchmark, const Signal& signal, size_t length)
+{
+    const size_t iterations = samplesPerMeasurement / length;
+
+    Result result = {0, true};
+    bool valid = true;
+    outpost::time::SpacecraftElapsedTime start = systemClock.now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        result = benchmark.mRun(length);
+        valid = valid && result.mValid;
+    }
+    int64_t us = (systemClock.now() - start).microseconds();
+    if (us <= 0)
+    {
+        us = 1;
+    }
+
+    outpost::utils::BenchmarkRecord record("compression", benchmark.mName);
+    record.addString("signal", signal.mName)
+            .addInteger("blocksize", length)
+            .addNumber("samples_per_second", iterations * length * 1e6 / us, 0);
+    if (benchmark.mReportsRatio && result.mBytes > 0)
+    {
+        record.addNumber("compression_ratio", 2.0 * length / result.mBytes);
+    }
+    record.write(valid);
+}
+
+}  // namespace
+
+int
+main(void)
+{
+    createSignals();
+
+    DataProcessorThread thread(
+            0U, pool, inputQueue, outputQueue, 1U, outpost::time::Duration::zero());
+    processor = &thread;
+
+    for (const Signal& signal : signals)
+    {
+        for (Blocksize bs : blocksizes)
+        {
+            size_t length = toUInt(bs);
+            for (size_t i = 0; i < length; i++)
+            {
+                input[i] = Fixpoint(signal.mData[i]);
+                transformed[i] = input[i];
+            }
+            outpost::Slice<int16_t> ordered = LeGall53Wavelet::forwardTransformInPlaceOrdered(
+                    outpost::Slice<Fixpoint>::unsafe(transformed, length));
+            for (size_t i = 0; i < length; i++)
+            {
+                coefficients[i] = ordered[i];
+            }
+
+            for (const Benchmark& benchmark : benchmarks)
+            {
+                measure(benchmark, signal, length);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMPRESSION_BLOCK_ENCODER_H_
+#define OUTPOST_COMPRESSION_BLOCK_ENCODER_H_
+
+#include "data_block.h"
+
+#include <outpost/base/slice.h>
+
+#include <stddef.h>
+
+namespace outpost
+{
+namespace compression
+{
+/**
+ * Interface for the encoding of a DataBlock by DataBlock::encode().
+ *
+ * Every implementation produces the data of one CompressionScheme, which
+ * is stored in the header of the encoded block.
+ */
+class BlockEncoder
+{
+public:
+    virtual ~BlockEncoder() = default;
+
+    /**
+     * Getter for the scheme of the encoded data
+     * @return Returns the CompressionScheme written to the header of encoded blocks.
+     */
+    virtual CompressionScheme
+    getCompressionScheme() const = 0;
+
+    /**
+     * Encodes the content of a block.
+     * @param block Block to encode. Schemes based on the wavelet transform require a transformed
+     * block, the others encode the raw samples.
+     * @param buffer Memory for the encoded data, excluding the header of the target block
+     * @return Returns the number of bytes written to buffer, 0 if the block could not be encoded.
+     */
+    virtual size_t
+    encode(const DataBlock& block, outpost::Slice<uint8_t> buffer) = 0;
+};
+
+}  // namespace compression
+}  // namespace outpost
+
+#endif /* OUTPOST_COMPRESSION_BLOCK_ENCODER_H_ */
@@ -13,6 +13,7 @@
 
 #include "data_aggregator.h"
 
+#include "data_aggregator_index.h"
 #include "data_block_sender.h"
 
 #include <outpost/base/fixpoint.h>
@@ -24,87 +25,107 @@ namespace outpost
 namespace compression
 {
 DataAggregator* DataAggregator::listOfAllDataAggregators = nullptr;
+DataAggregator::ParameterIdSet::Buckets DataAggregator::setOfAllDataAggregators = {};
+uint16_t DataAggregator::numberOfAllDataAggregators = 0;
 
 DataAggregator::DataAggregator(uint16_t paramId,
                                outpost::time::Clock& clock,
                                outpost::utils::SharedBufferPoolBase& pool,
                                DataBlockSender& sender) :
     ImplicitList<DataAggregator>(DataAggregator::listOfAllDataAggregators, this),
+    ParameterIdSet(DataAggregator::setOfAllDataAggregators, this, paramId),
     mParameterId(paramId),
     mSamplingRate(SamplingRate::disabled),
     mNextSamplingRate(SamplingRate::disabled),
     mBlocksize(Blocksize::disabled),
     mNextBlocksize(Blocksize::disabled),
     mBlock(),
+    mStartTime(),
+    mNextBuffer(),
+    mNextBufferReady(false),
+    mCompletedBlock(),
+    mCompletedStartTime(),
+    mCompletedBlockReady(false),
     mEnabled(false),
     mDisableAfterCurrentBlock(false),
+    mStreamingTransform(false),
+    mNextStreamingTransform(false),
+    mTransform(),
     mClock(clock),
     mMemoryPool(pool),
     mSender(sender),
+    mIndex(nullptr),
     mNumCompletedBlocks(0),
     mNumLostBlocks(0),
+    mNumDroppedBlocks(0),
     mNumLostSamples(0),
     mNumOverallSamples(0)
 {
+    numberOfAllDataAggregators++;
 }
 
 DataAggregator::~DataAggregator()
 {
+    if (mIndex != nullptr)
+    {
+        mIndex->remove(*this);
+    }
     removeFromList(&DataAggregator::listOfAllDataAggregators, this);
+    removeFromSet(DataAggregator::setOfAllDataAggregators, this);
+    numberOfAllDataAggregators--;
 }
 
 DataAggregator*
 DataAggregator::findDataAggregator(uint16_t paramId)
 {
-    DataAggregator* aggregator = nullptr;
-    for (DataAggregator* it = DataAggregator::listOfAllDataAggregators;
-         (it != nullptr) && (aggregator == nullptr);
-         it = it->getNext())
-    {
-        if (it->getParameterId() == paramId)
-        {
-            aggregator = it;
-        }
-    }
-    return aggregator;
+    return ParameterIdSet::find(DataAggregator::setOfAllDataAggregators, paramId);
 }
 
 uint16_t
 DataAggregator::numberOfAggregators()
 {
-    uint16_t n = 0;
-    for (DataAggregator* it = DataAggregator::listOfAllDataAggregators; it != nullptr;
-         it = it->getNext())
+    return numberOfAllDataAggregators;
+}
+
+bool
+DataAggregator::push(Fixpoint fp)
+{
+    if (isEnabled() && !mBlock.isValid())
+    {
+        prepareNextBuffer();
+    }
+    bool res = append(fp);
+    handOver();
+    if (!isEnabled())
     {
-        n++;
+        disable();
     }
-    return n;
+    return res;
 }
 
 bool
-DataAggregator::push(Fixpoint fp)
+DataAggregator::append(Fixpoint fp)
 {
     bool res = false;
     if (isEnabled())
     {
-        if (!mBlock.isValid())
+        if (!mBlock.isValid() && mNextBufferReady.load())
         {
-            outpost::utils::SharedBufferPointer p;
-            if (mMemoryPool.allocate(p))
-            {
-                mSamplingRate = mNextSamplingRate;
-                mBlocksize = mNextBlocksize;
-                mBlock = {p,
-                          mParameterId,
-                          outpost::time::TimeEpochConverter<
-                                  outpost::time::SpacecraftElapsedTimeEpoch,
-                                  outpost::time::GpsEpoch>::convert(mClock.now()),
-                          mSamplingRate,
-                          mBlocksize};
-            }
+            mSamplingRate = mNextSamplingRate;
+            mBlocksize = mNextBlocksize;
+            mStreamingTransform = mNextStreamingTransform;
+            mStartTime = mClock.now();
+            mBlock = {mNextBuffer,
+                      mParameterId,
+                      outpost::time::GpsTime(),
+                      mSamplingRate,
+                      mBlocksize};
+            mNextBuffer = outpost::utils::SharedBufferPointer();
+            mNextBufferReady.store(false);
         }
 
-        if (mBlock.push(fp))
+        bool pushed = mStreamingTransform ? mBlock.push(fp, mTransform) : mBlock.push(fp);
+        if (pushed)
         {
             res = true;
             mNumOverallSamples++;
@@ -112,16 +133,36 @@ DataAggregator::push(Fixpoint fp)
             if (mBlock.isComplete())
             {
                 mNumCompletedBlocks++;
-                if (!mSender.send(mBlock))
+                const bool dropped = mCompletedBlockReady.load();
+                if (dropped)
                 {
-                    mNumLostBlocks++;
+                    mNumDroppedBlocks++;
                 }
-                if (mDisableAfterCurrentBlock)
+                else
                 {
-                    disable();
+                    mCompletedBlock = mBlock;
+                    mCompletedStartTime = mStartTime;
+                    // Cleared before the hand-over so that the consumer holds the last reference
+                    mBlock = {};
+                    mCompletedBlockReady.store(true);
                 }
 
-                mBlock = {};
+                // Buffers are never released here, releasing the last reference would take
+                // the lock of the pool
+                if (mDisableAfterCurrentBlock)
+                {
+                    // The buffers still held are released by process()
+                    mEnabled = false;
+                }
+                else if (dropped)
+                {
+                    // Continue on the buffer of the dropped block
+                    mSamplingRate = mNextSamplingRate;
+                    mBlocksize = mNextBlocksize;
+                    mStreamingTransform = mNextStreamingTransform;
+                    mStartTime = mClock.now();
+                    mBlock.restart(outpost::time::GpsTime(), mSamplingRate, mBlocksize);
+                }
             }
         }
         else
@@ -132,6 +173,48 @@ DataAggregator::push(Fixpoint fp)
     return res;
 }
 
+void
+DataAggregator::process()
+{
+    handOver();
+    if (isEnabled())
+    {
+        prepareNextBuffer();
+    }
+    else
+    {
+        // Left by append() when it disabled the acquisition after the current block
+        disable();
+    }
+}
+
+void
+DataAggregator::prepareNextBuffer()
+{
+    if (!mNextBufferReady.load() && mMemoryPool.allocate(mNextBuffer))
+    {
+        mNextBufferReady.store(true);
+    }
+}
+
+void
+DataAggregator::handOver()
+{
+    if (mCompletedBlockReady.load())
+    {
+        mCompletedBlock.setStartTime(
+                outpost::time::TimeEpochConverter<outpost::time::SpacecraftElapsedTimeEpoch,
+                                                  outpost::time::GpsEpoch>::
+                        convert(mCompletedStartTime));
+        if (!mSender.send(mCompletedBlock))
+        {
+            mNumLostBlocks++;
+        }
+        mCompletedBlock = {};
+        mCompletedBlockReady.store(false);
+    }
+}
+
 bool
 DataAggregator::isAtStartOfNewBlock() const
 {
@@ -145,6 +228,7 @@ DataAggregator::enable(SamplingRate sr, Blocksize bs)
     setNextSamplingRate(sr);
     mEnabled = true;
     mDisableAfterCurrentBlock = false;
+    prepareNextBuffer();
 }
 
 void
@@ -154,6 +238,7 @@ DataAggregator::enableForOneBlock(SamplingRate sr, Blocksize bs)
     setNextSamplingRate(sr);
     mEnabled = true;
     mDisableAfterCurrentBlock = true;
+    prepareNextBuffer();
 }
 
 void
@@ -161,6 +246,11 @@ DataAggregator::disable()
 {
     mEnabled = false;
     mBlock = DataBlock{};
+    if (mNextBufferReady.load())
+    {
+        mNextBuffer = outpost::utils::SharedBufferPointer();
+        mNextBufferReady.store(false);
+    }
 }
 
 }  // namespace compression
@@ -15,7 +15,10 @@
 #define OUTPOST_COMPRESSION_DATA_AGGREGATOR_H_
 
 #include "data_block.h"
+#include "streaming_wavelet.h"
 
+#include <outpost/rtos/atomic.h>
+#include <outpost/utils/container/implicit_hash_set.h>
 #include <outpost/utils/container/implicit_list.h>
 
 namespace outpost
@@ -39,15 +42,26 @@ class SharedBufferPoolBase;
 
 namespace compression
 {
+class DataAggregatorIndexBase;
 class DataBlockSender;
 
 /**
  * The DataAggregator is responsible for receiving samples of a single parameter (identified by its
  * ID) and handling allocation and transmission of DataBlocks using a given DataBlockSender.
+ *
+ * The buffer for the next DataBlock is kept preallocated and completed blocks are parked in a
+ * single hand-off slot. This allows splitting the aggregator into a producer calling append(),
+ * e.g. from a sampling timer, and a consumer thread calling process() which allocates, converts
+ * the time stamps and sends the blocks. push() does both in one call.
  */
-class DataAggregator : public ImplicitList<DataAggregator>
+class DataAggregator : public ImplicitList<DataAggregator>,
+                       public ImplicitHashSet<DataAggregator, uint16_t, 32>
 {
+    friend class DataAggregatorIndexBase;
+
 public:
+    typedef ImplicitHashSet<DataAggregator, uint16_t, 32> ParameterIdSet;
+
     /**
      * Constructor for a DataAggregator of a single parameter ID.
      * @param paramId ID of the parameter to be managed by the aggregator
@@ -70,6 +84,30 @@ public:
     bool
     push(Fixpoint fp);
 
+    /**
+     * Appends a single Fixpoint to the current DataBlock without allocating or sending.
+     * A new DataBlock can only be started from the buffer preallocated by process() or enable(),
+     * completed blocks are left for process() to send. Buffers are never returned to the pool
+     * here, so neither allocation nor release takes the lock of the pool. This makes the function
+     * usable from a sampling timer or interrupt as long as only one context appends and the
+     * Atomic of the port is interrupt safe.
+     * If the previous completed block has not been handed over yet, the new one is dropped and
+     * its buffer is reused for the next block. Disabling after the current block leaves the
+     * buffers to be released by process().
+     * @param fp Fixpoint number to be added to a DataBlock
+     * @return Returns true if the Fixpoint number could be stored in a DataBlock, false otherwise.
+     */
+    bool
+    append(Fixpoint fp);
+
+    /**
+     * Consumer side of append(): sends a completed DataBlock with its start time converted to
+     * GPS time and preallocates the buffer for the next block if none is available. If the
+     * acquisition has been disabled, the buffers still held by the aggregator are released.
+     */
+    void
+    process();
+
     /**
      * Getter for the parameter ID
      * @return Parameter ID
@@ -161,6 +199,30 @@ public:
         return mBlocksize != mNextBlocksize;
     }
 
+    /**
+     * Selects whether the samples are transformed as they are pushed. This will only affect the
+     * next DataBlock being started, not the current one.
+     * Streaming spreads the wavelet transform over the sampling period, the completed blocks are
+     * forwarded already transformed and only need to be encoded.
+     * @param enabled True to transform incrementally, false to leave the transform to the
+     * DataProcessorThread.
+     */
+    inline void
+    setStreamingTransform(bool enabled)
+    {
+        mNextStreamingTransform = enabled;
+    }
+
+    /**
+     * Getter for the transformation mode of the current DataBlock.
+     * @return Returns true if the current block is transformed incrementally.
+     */
+    inline bool
+    isStreamingTransform() const
+    {
+        return mStreamingTransform;
+    }
+
     /**
      * Checks if acquisition for the DataAggregator is enabled.
      * @return Returns true if data acquisition is enabled, false otherwise.
@@ -198,7 +260,9 @@ public:
     enableForOneBlock(SamplingRate sr, Blocksize bs);
 
     /**
-     * Disables data acquisition immediately and invalidates the current block.
+     * Disables data acquisition immediately and invalidates the current block. The preallocated
+     * buffer is returned to the pool, a completed block is still handed over by process().
+     * Releases buffers and must therefore not be called from the context calling append().
      */
     void
     disable();
@@ -229,7 +293,7 @@ public:
     inline uint16_t
     getNumLostBlocks()
     {
-        return mNumLostBlocks;
+        return mNumLostBlocks + mNumDroppedBlocks;
     }
 
     /**
@@ -263,7 +327,10 @@ public:
     }
 
     /**
-     * Finds a DataAggregator by its parameterId
+     * Finds a DataAggregator by its parameterId.
+     * Uses a hash set of all DataAggregators, O(1) on average. A DataAggregatorIndex avoids
+     * the hashing for a contiguous range of parameter IDs.
+     * If several DataAggregators share the ID, the one constructed last is returned.
      * @param paramId Parameter Id of the DataAggregator to find.
      * @return Returns a pointer to the corresponding DataAggregator if it was found, nullptr
      * otherwise.
@@ -272,7 +339,7 @@ public:
     findDataAggregator(uint16_t paramId);
 
     /**
-     * Counts all DataAggregators in the system by iterating over them.
+     * Getter for the number of DataAggregators in the system.
      * @return Returns the current number of DataAggregators
      */
     static uint16_t
@@ -289,7 +356,15 @@ public:
     }
 
 protected:
+    void
+    prepareNextBuffer();
+
+    void
+    handOver();
+
     static DataAggregator* listOfAllDataAggregators;
+    static ParameterIdSet::Buckets setOfAllDataAggregators;
+    static uint16_t numberOfAllDataAggregators;
 
     uint16_t mParameterId;
     SamplingRate mSamplingRate;
@@ -299,16 +374,35 @@ protected:
     Blocksize mNextBlocksize;
 
     DataBlock mBlock;
+    outpost::time::SpacecraftElapsedTime mStartTime;
+
+    // Buffer for the next block, owned by the producer while mNextBufferReady is set
+    outpost::utils::SharedBufferPointer mNextBuffer;
+    outpost::rtos::Atomic<bool> mNextBufferReady;
+
+    // Completed block, owned by the consumer while mCompletedBlockReady is set
+    DataBlock mCompletedBlock;
+    outpost::time::SpacecraftElapsedTime mCompletedStartTime;
+    outpost::rtos::Atomic<bool> mCompletedBlockReady;
 
     bool mEnabled;
     bool mDisableAfterCurrentBlock;
 
+    bool mStreamingTransform;
+    bool mNextStreamingTransform;
+    StreamingWavelet mTransform;
+
     outpost::time::Clock& mClock;
     outpost::utils::SharedBufferPoolBase& mMemoryPool;
     DataBlockSender& mSender;
 
+    // Index the aggregator has been added to, if any
+    DataAggregatorIndexBase* mIndex;
+
     uint16_t mNumCompletedBlocks;
     uint16_t mNumLostBlocks;
+    // Counted by the producer, kept apart from mNumLostBlocks written by the consumer
+    uint16_t mNumDroppedBlocks;
     uint16_t mNumLostSamples;
     size_t mNumOverallSamples;
 };
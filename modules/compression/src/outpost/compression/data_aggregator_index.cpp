@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "data_aggregator_index.h"
+
+#include "data_aggregator.h"
+
+#include <outpost/base/fixpoint.h>
+
+namespace outpost
+{
+namespace compression
+{
+DataAggregatorIndexBase::DataAggregatorIndexBase(outpost::Slice<DataAggregator*> table,
+                                                 uint16_t firstParameterId) :
+    mTable(table), mFirstParameterId(firstParameterId), mNumberOfAggregators(0)
+{
+    for (size_t i = 0; i < mTable.getNumberOfElements(); i++)
+    {
+        mTable[i] = nullptr;
+    }
+}
+
+DataAggregatorIndexBase::~DataAggregatorIndexBase()
+{
+    for (size_t i = 0; i < mTable.getNumberOfElements(); i++)
+    {
+        if (mTable[i] != nullptr)
+        {
+            mTable[i]->mIndex = nullptr;
+            mTable[i] = nullptr;
+        }
+    }
+}
+
+bool
+DataAggregatorIndexBase::add(DataAggregator& aggregator)
+{
+    uint16_t index = aggregator.getParameterId() - mFirstParameterId;
+    if (index >= mTable.getNumberOfElements() || aggregator.mIndex != nullptr
+        || mTable[index] != nullptr)
+    {
+        return false;
+    }
+
+    mTable[index] = &aggregator;
+    aggregator.mIndex = this;
+    mNumberOfAggregators++;
+    return true;
+}
+
+size_t
+DataAggregatorIndexBase::addAll()
+{
+    size_t added = 0;
+    for (DataAggregator* it = DataAggregator::getList(); it != nullptr; it = it->getNext())
+    {
+        if (add(*it))
+        {
+            added++;
+        }
+    }
+    return added;
+}
+
+void
+DataAggregatorIndexBase::remove(DataAggregator& aggregator)
+{
+    uint16_t index = aggregator.getParameterId() - mFirstParameterId;
+    if (aggregator.mIndex == this && index < mTable.getNumberOfElements()
+        && mTable[index] == &aggregator)
+    {
+        mTable[index] = nullptr;
+        aggregator.mIndex = nullptr;
+        mNumberOfAggregators--;
+    }
+}
+
+bool
+DataAggregatorIndexBase::push(uint16_t paramId, Fixpoint fp)
+{
+    DataAggregator* aggregator = find(paramId);
+    return (aggregator != nullptr) && aggregator->push(fp);
+}
+
+size_t
+DataAggregatorIndexBase::push(outpost::Slice<const uint16_t> paramIds,
+                              outpost::Slice<const Fixpoint> values)
+{
+    size_t numberOfSamples = paramIds.getNumberOfElements();
+    if (values.getNumberOfElements() < numberOfSamples)
+    {
+        numberOfSamples = values.getNumberOfElements();
+    }
+
+    size_t stored = 0;
+    for (size_t i = 0; i < numberOfSamples; i++)
+    {
+        DataAggregator* aggregator = find(paramIds[i]);
+        if (aggregator != nullptr && aggregator->push(values[i]))
+        {
+            stored++;
+        }
+    }
+    return stored;
+}
+
+}  // namespace compression
+}  // namespace outpost
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMPRESSION_DATA_AGGREGATOR_INDEX_H_
+#define OUTPOST_COMPRESSION_DATA_AGGREGATOR_INDEX_H_
+
+#include <outpost/base/slice.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+template <unsigned PREC>
+class FP;
+typedef FP<16> Fixpoint;
+
+namespace compression
+{
+class DataAggregator;
+
+/**
+ * Direct lookup table from parameter IDs to DataAggregators.
+ *
+ * DataAggregator::findDataAggregator() walks the list of all aggregators,
+ * which becomes expensive when samples of many parameters are routed by
+ * their ID. The index covers a contiguous range of parameter IDs starting
+ * at firstParameterId, finding an aggregator is a single table access.
+ *
+ * An aggregator can be part of a single index only. Aggregators remove
+ * themselves from their index when they are destroyed. The index is not
+ * thread-safe, like the aggregators themselves.
+ *
+ * The memory of the table is provided by DataAggregatorIndex.
+ */
+class DataAggregatorIndexBase
+{
+public:
+    ~DataAggregatorIndexBase();
+
+    /**
+     * Adds an aggregator to the index
+     * @param aggregator Aggregator to add
+     * @return Returns false if the parameter ID is outside the range of the index, another
+     * aggregator with the same ID has been added before or the aggregator is part of another
+     * index, true otherwise.
+     */
+    bool
+    add(DataAggregator& aggregator);
+
+    /**
+     * Adds all aggregators of the system with a parameter ID in the range of the index
+     * @return Returns the number of aggregators newly added.
+     */
+    size_t
+    addAll();
+
+    /**
+     * Removes an aggregator from the index
+     */
+    void
+    remove(DataAggregator& aggregator);
+
+    /**
+     * Finds a DataAggregator by its parameterId
+     * @param paramId Parameter Id of the DataAggregator to find.
+     * @return Returns a pointer to the corresponding DataAggregator if it is part of the index,
+     * nullptr otherwise.
+     */
+    inline DataAggregator*
+    find(uint16_t paramId) const
+    {
+        uint16_t index = paramId - mFirstParameterId;
+        return (index < mTable.getNumberOfElements()) ? mTable[index] : nullptr;
+    }
+
+    /**
+     * Pushes a single sample to the aggregator of its parameter
+     * @param paramId Parameter Id of the sample
+     * @param fp Value of the sample
+     * @return Returns true if the sample could be stored, false if no aggregator for the
+     * parameter is part of the index or the aggregator did not accept the sample.
+     */
+    bool
+    push(uint16_t paramId, Fixpoint fp);
+
+    /**
+     * Pushes the samples of a frame of multiple parameters
+     * @param paramIds Parameter Ids of the samples
+     * @param values Values of the samples, in the same order as paramIds
+     * @return Returns the number of samples that have been stored. Samples exceeding the length
+     * of the shorter slice are ignored.
+     */
+    size_t
+    push(outpost::Slice<const uint16_t> paramIds, outpost::Slice<const Fixpoint> values);
+
+    /**
+     * Getter for the number of aggregators that are part of the index
+     */
+    inline size_t
+    getNumberOfAggregators() const
+    {
+        return mNumberOfAggregators;
+    }
+
+    inline uint16_t
+    getFirstParameterId() const
+    {
+        return mFirstParameterId;
+    }
+
+    /**
+     * Getter for the number of parameter IDs covered by the index
+     */
+    inline size_t
+    getNumberOfParameterIds() const
+    {
+        return mTable.getNumberOfElements();
+    }
+
+protected:
+    /**
+     * @param table Lookup table, one entry per parameter ID
+     * @param firstParameterId Parameter ID of the first table entry
+     */
+    DataAggregatorIndexBase(outpost::Slice<DataAggregator*> table, uint16_t firstParameterId);
+
+private:
+    DataAggregatorIndexBase(const DataAggregatorIndexBase&) = delete;
+
+    DataAggregatorIndexBase&
+    operator=(const DataAggregatorIndexBase&) = delete;
+
+    outpost::Slice<DataAggregator*> mTable;
+    const uint16_t mFirstParameterId;
+    size_t mNumberOfAggregators;
+};
+
+namespace internal
+{
+/**
+ * Table of a DataAggregatorIndex.
+ *
+ * Base class of DataAggregatorIndex so that it is constructed before
+ * DataAggregatorIndexBase refers to it.
+ */
+template <size_t numberOfParameterIds>
+class DataAggregatorIndexStorage
+{
+protected:
+    DataAggregatorIndexStorage() : mTableStorage()
+    {
+    }
+
+    DataAggregator* mTableStorage[numberOfParameterIds];
+};
+}  // namespace internal
+
+/**
+ * Index for a range of parameter IDs.
+ *
+ * @tparam numberOfParameterIds
+ *      Number of consecutive parameter IDs covered by the index. Each ID
+ *      requires one pointer of memory, whether an aggregator exists for
+ *      it or not.
+ */
+template <size_t numberOfParameterIds>
+class DataAggregatorIndex : private internal::DataAggregatorIndexStorage<numberOfParameterIds>,
+                            public DataAggregatorIndexBase
+{
+    static_assert(numberOfParameterIds > 0, "Index must cover at least one parameter ID");
+    static_assert(numberOfParameterIds <= 0x10000, "Index exceeds the range of parameter IDs");
+
+public:
+    /**
+     * @param firstParameterId Parameter ID of the first table entry
+     */
+    explicit DataAggregatorIndex(uint16_t firstParameterId = 0) :
+        internal::DataAggregatorIndexStorage<numberOfParameterIds>(),
+        DataAggregatorIndexBase(outpost::asSlice(this->mTableStorage), firstParameterId)
+    {
+    }
+};
+
+}  // namespace compression
+}  // namespace outpost
+
+#endif /* OUTPOST_COMPRESSION_DATA_AGGREGATOR_INDEX_H_ */
@@ -12,11 +12,14 @@
  */
 #include "data_block.h"
 
+#include "block_encoder.h"
+#include "data_block_decoder.h"
 #include "legall_wavelet.h"
-#include "nls_encoder.h"
+#include "streaming_wavelet.h"
 
 #include <outpost/base/fixpoint.h>
 #include <outpost/base/slice.h>
+#include <outpost/utils/container/arena.h>
 #include <outpost/utils/storage/bitfield.h>
 #include <outpost/utils/storage/bitstream.h>
 
@@ -128,14 +131,66 @@ DataBlock::applyWaveletTransform()
     if (!isTransformed() && !isEncoded() && mSampleCount > 0)
     {
         outpost::Slice<Fixpoint> samples = this->getSamples();
-        LeGall53Wavelet::forwardTransformInPlace(samples);
-        LeGall53Wavelet::reorder(samples);
+        LeGall53Wavelet::forwardTransformInPlaceOrdered(samples);
         mIsTransformed = true;
         return true;
     }
     return false;
 }
 
+bool
+DataBlock::applyWaveletTransform(outpost::Slice<DataBlock* const> blocks,
+                                 outpost::utils::Arena& scratch)
+{
+    const size_t channels = blocks.getNumberOfElements();
+    if (channels == 0)
+    {
+        return false;
+    }
+    const uint16_t length = blocks[0]->mSampleCount;
+    for (size_t c = 0; c < channels; c++)
+    {
+        const DataBlock& block = *blocks[c];
+        if (block.isTransformed() || block.isEncoded() || !block.isComplete()
+            || block.mSampleCount != length)
+        {
+            return false;
+        }
+    }
+
+    outpost::utils::ArenaScope scope(scratch);
+    outpost::Slice<Fixpoint> interleaved = scratch.allocate<Fixpoint>(channels * length);
+    if (interleaved.getNumberOfElements() == 0)
+    {
+        return false;
+    }
+
+    for (size_t c = 0; c < channels; c++)
+    {
+        const Fixpoint* samples = blocks[c]->mSampleBuffer;
+        for (size_t i = 0; i < length; i++)
+        {
+            interleaved[i * channels + c] = samples[i];
+        }
+    }
+
+    if (!LeGall53Wavelet::forwardTransformInterleaved(interleaved, channels, scratch))
+    {
+        return false;
+    }
+
+    for (size_t c = 0; c < channels; c++)
+    {
+        DataBlock& block = *blocks[c];
+        for (size_t i = 0; i < length; i++)
+        {
+            block.mCoefficientBuffer[i] = static_cast<int16_t>(interleaved[i * channels + c]);
+        }
+        block.mIsTransformed = true;
+    }
+    return true;
+}
+
 bool
 DataBlock::isComplete() const
 {
@@ -149,6 +204,13 @@ DataBlock::isValid() const
             && mPointer.getLength() >= (toUInt(mBlocksize) * sizeof(Fixpoint) + headerSize));
 }
 
+void
+DataBlock::restart(outpost::time::GpsTime startTime, SamplingRate rate, Blocksize bs)
+{
+    // The temporary holds a reference, the buffer is never released here
+    *this = DataBlock(mPointer, mParameterId, startTime, rate, bs);
+}
+
 bool
 DataBlock::push(Fixpoint f)
 {
@@ -161,18 +223,44 @@ DataBlock::push(Fixpoint f)
 }
 
 bool
-DataBlock::encode(DataBlock& b, NLSEncoder& encoder) const
+DataBlock::push(Fixpoint f, StreamingWavelet& transform)
+{
+    if (!isComplete() && isValid() && !isTransformed())
+    {
+        if (mSampleCount == 0
+            && !transform.start(
+                    outpost::Slice<Fixpoint>::unsafe(mSampleBuffer, toUInt(mBlocksize))))
+        {
+            return false;
+        }
+        if (transform.push(f))
+        {
+            mSampleCount++;
+            if (isComplete())
+            {
+                transform.finish();
+                mIsTransformed = true;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+DataBlock::encode(DataBlock& b, BlockEncoder& encoder) const
 {
-    if (isTransformed() && b.getMaximumSize() >= mSampleCount * sizeof(int16_t))
+    if (isEncoded() || !b.mPointer.isValid() || b.getMaximumSize() <= headerSize)
     {
-        outpost::Slice<uint8_t> slice = b.mPointer.asSlice().skipFirst(headerSize);
-        outpost::Bitstream bitstream(slice);
-        encoder.encode(getCoefficients(), bitstream);
-        outpost::Serialize dataStream(slice);
-        bitstream.serialize(dataStream);
-        b.mSampleCount = bitstream.getSerializedSize();
+        return false;
+    }
+
+    size_t length = encoder.encode(*this, b.mPointer.asSlice().skipFirst(headerSize));
+    if (length > 0)
+    {
+        b.mSampleCount = length;
         b.mIsEncoded = true;
-        b.mScheme = CompressionScheme::waveletNLS;
+        b.mScheme = encoder.getCompressionScheme();
 
         outpost::Serialize headerStream(&b.mPointer[0]);
         headerStream.store<uint8_t>(static_cast<uint8_t>(b.mScheme));
@@ -189,5 +277,28 @@ DataBlock::encode(DataBlock& b, NLSEncoder& encoder) const
     return false;
 }
 
+bool
+DataBlock::fromEncodedData(const outpost::utils::SharedBufferPointer& p,
+                           size_t length,
+                           DataBlock& b)
+{
+    DataBlockDecoder::Header header;
+    if (!p.isValid() || length < headerSize || length > p.getLength()
+        || length - headerSize > UINT16_MAX
+        || !DataBlockDecoder::readHeader(p.asSlice().first(length), header)
+        || header.mScheme == CompressionScheme::raw
+        || header.mScheme > CompressionScheme::rice)
+    {
+        return false;
+    }
+
+    b = DataBlock(
+            p, header.mParameterId, header.mStartTime, header.mSamplingRate, header.mBlocksize);
+    b.mSampleCount = static_cast<uint16_t>(length - headerSize);
+    b.mScheme = header.mScheme;
+    b.mIsEncoded = true;
+    return true;
+}
+
 }  // namespace compression
 }  // namespace outpost
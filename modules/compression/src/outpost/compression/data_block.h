@@ -26,9 +26,15 @@ typedef FP<16> Fixpoint;
 template <typename T>
 class Slice;
 
+namespace utils
+{
+class Arena;
+}
+
 namespace compression
 {
-class NLSEncoder;
+class BlockEncoder;
+class StreamingWavelet;
 
 /**
  * SamplingRate is the efficient encoding of certain possible cadences. Has to be enforced by the
@@ -62,12 +68,13 @@ enum class Blocksize : uint8_t
 };
 
 /**
- * For future use of additional compression schemes
+ * Encoding of the data of a DataBlock, see BlockEncoder
  */
 enum class CompressionScheme : uint8_t
 {
     raw = 0,
     waveletNLS = 1,
+    rice = 2,
 };
 
 /**
@@ -144,6 +151,26 @@ public:
         return mStartTime;
     }
 
+    /**
+     * Setter for the start time, for blocks whose time stamp is converted after sampling.
+     * @param startTime GpsTime of the timepoint at which the first sample was collected
+     */
+    inline void
+    setStartTime(outpost::time::GpsTime startTime)
+    {
+        mStartTime = startTime;
+    }
+
+    /**
+     * Discards all samples and starts an empty block on the same memory, e.g. to reuse the buffer
+     * of a dropped block without returning it to its pool.
+     * @param startTime Timepoint in GpsTime when the first sample of the new block is collected
+     * @param rate SamplingRate of the new block
+     * @param bs Blocksize of the new block
+     */
+    void
+    restart(outpost::time::GpsTime startTime, SamplingRate rate, Blocksize bs);
+
     /**
      * Getter for the current number of samples in this block
      * @return Number of collected samples, coefficients or data bytes, depending on processing step
@@ -194,6 +221,16 @@ public:
         return mIsEncoded;
     }
 
+    /**
+     * Getter for the block's compression scheme
+     * @return Returns the scheme of the encoded data, only meaningful if the block is encoded.
+     */
+    inline CompressionScheme
+    getCompressionScheme() const
+    {
+        return mScheme;
+    }
+
     /**
      * Getter for the block's memory capacity
      * @return Returns the maximum number of bytes that can be stored in the DataBlock.
@@ -208,6 +245,32 @@ public:
     bool
     applyWaveletTransform();
 
+    /**
+     * Applies the LeGall53 wavelet transform to several blocks at once.
+     * The samples of the blocks are interleaved, so that the transform processes all blocks in
+     * the same loops, see LeGall53Wavelet::forwardTransformInterleaved. The coefficients are
+     * identical to those of applyWaveletTransform.
+     * @param blocks Complete blocks of the same blocksize which have not been transformed yet
+     * @param scratch Arena for getBatchScratchSize() bytes
+     * @return Returns true if all blocks have been transformed, false if none has been.
+     */
+    static bool
+    applyWaveletTransform(outpost::Slice<DataBlock* const> blocks, outpost::utils::Arena& scratch);
+
+    /**
+     * Getter for the scratch memory required by the batched wavelet transform
+     * @param numberOfBlocks Number of blocks transformed together
+     * @param samplesPerBlock Number of samples of each block
+     * @return Returns the number of bytes required from the arena.
+     */
+    static constexpr size_t
+    getBatchScratchSize(size_t numberOfBlocks, size_t samplesPerBlock)
+    {
+        // Interleaved samples and the temporary values of the transform
+        return numberOfBlocks * samplesPerBlock * sizeof(int32_t)
+               + (numberOfBlocks * samplesPerBlock / 2 + numberOfBlocks) * sizeof(int32_t);
+    }
+
     /**
      * Getter for the block's completeness in terms of its blocksize
      * @return Returns true if the number of samples according to its blocksize has been pushed,
@@ -234,15 +297,39 @@ public:
     push(Fixpoint f);
 
     /**
-     * Encodes the block's coefficients into another block (NLSEncoding cannot be performed
-     * in-place), using a given encoder holding supporting data structures. Note that the target
-     * block's memory needs to be of the same size or larger than the current block's.
+     * Pushes a single fixpoint number to the current block and transforms it right away.
+     * The transform is started with the first sample, once the block is complete the
+     * coefficients are available and the block is marked as transformed.
+     * @param f Fixpoint to be pushed to the end of block
+     * @param transform Transformation state, must not be used for other blocks until the block
+     * is complete
+     * @return Returns true if the number could be pushed to the block, false otherwise.
+     */
+    bool
+    push(Fixpoint f, StreamingWavelet& transform);
+
+    /**
+     * Encodes the block into another block (encoding cannot be performed in-place), using a
+     * given encoder. Note that the target block's memory needs to be of the same size or larger
+     * than the current block's.
+     * The NLSEncoder requires the block to be transformed, the RiceEncoder encodes the samples
+     * of a block that has not been transformed.
      * @param b Target DataBlock
-     * @param encoder NLSEncoder holding supporting data structures that shall be used
+     * @param encoder Encoder of the desired CompressionScheme
      * @return Returns True if the encoding was successful, fals otherwise.
      */
     bool
-    encode(DataBlock& b, NLSEncoder& encoder) const;
+    encode(DataBlock& b, BlockEncoder& encoder) const;
+
+    /**
+     * Turns data encoded elsewhere, e.g. by a RemoteEncoder, into an encoded DataBlock.
+     * @param p Memory starting with the header written by encode()
+     * @param length Number of bytes of the header and the encoded bitstream
+     * @param b Target DataBlock, only changed on success
+     * @return Returns false if the memory is too short or the header is invalid.
+     */
+    static bool
+    fromEncodedData(const outpost::utils::SharedBufferPointer& p, size_t length, DataBlock& b);
 
     /**
      * Getter for a Slice of samples (in Fixpoint format).
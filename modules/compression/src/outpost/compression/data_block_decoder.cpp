@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "data_block_decoder.h"
+
+#include "legall_wavelet.h"
+#include "nls_encoder.h"
+#include "rice_encoder.h"
+
+#include <outpost/base/fixpoint.h>
+#include <outpost/utils/storage/bitfield.h>
+#include <outpost/utils/storage/bitstream.h>
+#include <outpost/utils/storage/serialize.h>
+
+namespace outpost
+{
+namespace compression
+{
+DataBlockDecoder::DataBlockDecoder(NLSEncoderBase& encoder) : mEncoder(encoder)
+{
+}
+
+bool
+DataBlockDecoder::readHeader(outpost::Slice<const uint8_t> data, Header& header)
+{
+    if (data.getNumberOfElements() < DataBlock::headerSize)
+    {
+        return false;
+    }
+
+    outpost::Deserialize stream(data);
+    header.mScheme = static_cast<CompressionScheme>(stream.read<uint8_t>());
+    header.mParameterId = stream.read<uint16_t>();
+    header.mStartTime = outpost::time::GpsTime::afterEpoch(
+            outpost::time::Milliseconds(stream.read<uint64_t>()));
+
+    const uint8_t* pos = stream.getPointerToCurrentPosition();
+    header.mSamplingRate = static_cast<SamplingRate>(outpost::Bitfield::read<0, 3>(pos));
+    header.mBlocksize = static_cast<Blocksize>(outpost::Bitfield::read<4, 7>(pos));
+    return true;
+}
+
+outpost::Slice<Fixpoint>
+DataBlockDecoder::decode(outpost::Slice<uint8_t> data,
+                         outpost::Slice<Fixpoint> samples,
+                         Header& header)
+{
+    if (!readHeader(data, header))
+    {
+        return outpost::Slice<Fixpoint>::empty();
+    }
+
+    const size_t numberOfSamples = toUInt(header.mBlocksize);
+    if (numberOfSamples == 0 || samples.getNumberOfElements() < numberOfSamples)
+    {
+        return outpost::Slice<Fixpoint>::empty();
+    }
+    samples = samples.first(numberOfSamples);
+
+    outpost::Slice<uint8_t> streamData = data.skipFirst(DataBlock::headerSize);
+    if (streamData.getNumberOfElements() < Bitstream::headerSize)
+    {
+        return outpost::Slice<Fixpoint>::empty();
+    }
+    outpost::Bitstream bitstream(streamData);
+    outpost::Deserialize stream(streamData);
+    if (!bitstream.deserialize(stream))
+    {
+        return outpost::Slice<Fixpoint>::empty();
+    }
+
+    // Integer values are decoded to the beginning of the sample buffer and widened in place
+    outpost::Slice<int16_t> values =
+            outpost::Slice<int16_t>::unsafe(reinterpret_cast<int16_t*>(samples.begin()),
+                                            numberOfSamples);
+    switch (header.mScheme)
+    {
+        case CompressionScheme::waveletNLS:
+            if (numberOfSamples > mEncoder.getMaximumLength()
+                || mEncoder.decode(bitstream, values).getNumberOfElements() != numberOfSamples)
+            {
+                return outpost::Slice<Fixpoint>::empty();
+            }
+            return LeGall53Wavelet::backwardTransformInPlaceOrdered(values, samples);
+
+        case CompressionScheme::rice:
+            if (RiceEncoder::decode(bitstream, values).getNumberOfElements() != numberOfSamples)
+            {
+                return outpost::Slice<Fixpoint>::empty();
+            }
+            // Back to front, every write only covers values which have already been read
+            for (size_t i = numberOfSamples; i > 0; i--)
+            {
+                samples[i - 1] = Fixpoint(values[i - 1]);
+            }
+            return samples;
+
+        case CompressionScheme::raw:
+        default: return outpost::Slice<Fixpoint>::empty();
+    }
+}
+
+}  // namespace compression
+}  // namespace outpost
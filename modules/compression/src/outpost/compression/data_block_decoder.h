@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMPRESSION_DATA_BLOCK_DECODER_H_
+#define OUTPOST_COMPRESSION_DATA_BLOCK_DECODER_H_
+
+#include "data_block.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/time.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+template <unsigned PREC>
+class FP;
+typedef FP<16> Fixpoint;
+
+namespace compression
+{
+class NLSEncoderBase;
+
+/**
+ * Reconstructs the samples of encoded DataBlocks, e.g. in ground tools.
+ *
+ * Blocks encoded with CompressionScheme::waveletNLS are NLS decoded and
+ * transformed back with the fixpoint inverse of the wavelet transform,
+ * blocks encoded with CompressionScheme::rice are Rice decoded. Apart from
+ * the output buffer no memory besides the state tables of the NLS encoder
+ * is required.
+ */
+class DataBlockDecoder
+{
+public:
+    /**
+     * Fields of the header written by DataBlock::encode()
+     */
+    struct Header
+    {
+        Header() :
+            mScheme(CompressionScheme::raw),
+            mParameterId(0),
+            mStartTime(),
+            mSamplingRate(SamplingRate::disabled),
+            mBlocksize(Blocksize::disabled)
+        {
+        }
+
+        CompressionScheme mScheme;
+        uint16_t mParameterId;
+        outpost::time::GpsTime mStartTime;
+        SamplingRate mSamplingRate;
+        Blocksize mBlocksize;
+    };
+
+    /** Constructor
+     * @param encoder Provides the state tables for NLS decoding, must be sized for the largest
+     * block to decode.
+     */
+    explicit DataBlockDecoder(NLSEncoderBase& encoder);
+
+    /**
+     * Parses the header of an encoded block
+     * @param data Encoded block, as provided by DataBlock::getEncodedData()
+     * @param header Parsed header
+     * @return Returns false if data is shorter than the header, true otherwise.
+     */
+    static bool
+    readHeader(outpost::Slice<const uint8_t> data, Header& header);
+
+    /**
+     * Decodes an encoded block
+     * @param data Encoded block including its header, as provided by DataBlock::getEncodedData().
+     * The data is not modified.
+     * @param samples Buffer for the reconstructed samples
+     * @param header Parsed header of the block
+     * @return Returns the reconstructed samples, an empty slice if the scheme is not supported,
+     * the data is corrupted or samples is too small for the blocksize of the block.
+     */
+    outpost::Slice<Fixpoint>
+    decode(outpost::Slice<uint8_t> data, outpost::Slice<Fixpoint> samples, Header& header);
+
+private:
+    NLSEncoderBase& mEncoder;
+};
+
+}  // namespace compression
+}  // namespace outpost
+
+#endif /* OUTPOST_COMPRESSION_DATA_BLOCK_DECODER_H_ */
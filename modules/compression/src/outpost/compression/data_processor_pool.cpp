@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "data_processor_pool.h"
+
+#include "data_block.h"
+#include "scheme_selector.h"
+
+#include <outpost/rtos/mutex_guard.h>
+#include <outpost/utils/container/reference_queue.h>
+#include <outpost/utils/container/shared_object_pool.h>
+
+namespace outpost
+{
+namespace compression
+{
+DataProcessorPool::DataProcessorPool(outpost::utils::SharedBufferPoolBase& pool,
+                                     outpost::utils::ReferenceQueueBase<DataBlock>& inputQueue,
+                                     outpost::utils::ReferenceQueueBase<DataBlock>& outputQueue,
+                                     uint8_t numOutputRetries,
+                                     outpost::time::Duration retryTimeout) :
+    mInputQueue(inputQueue),
+    mOutputQueue(outputQueue),
+    mPool(pool),
+    mCheckpoint(outpost::rtos::Checkpoint::State::suspending),
+    mReceiveMutex(),
+    mNextTicket(0),
+    mForwardMutex(),
+    mNextForwardTicket(0),
+    mWorkers(nullptr),
+    mNumIncomingBlocks(0),
+    mNumProcessedBlocks(0),
+    mNumForwardedBlocks(0),
+    mNumLostBlocks(0),
+    mRetrySendTimeout(retryTimeout),
+    mMaxSendRetries(numOutputRetries),
+    mRiceEncoder(),
+    mSelector(nullptr)
+{
+}
+
+DataProcessorPool::~DataProcessorPool()
+{
+}
+
+void
+DataProcessorPool::enable()
+{
+    mCheckpoint.resume();
+}
+
+void
+DataProcessorPool::disable()
+{
+    mCheckpoint.suspend();
+}
+
+bool
+DataProcessorPool::isEnabled() const
+{
+    return mCheckpoint.getState() == outpost::rtos::Checkpoint::State::running;
+}
+
+void
+DataProcessorPool::setSchemeSelector(const CompressionSchemeSelector* selector)
+{
+    mSelector = selector;
+}
+
+size_t
+DataProcessorPool::getNumberOfWorkers() const
+{
+    outpost::rtos::MutexGuard lock(mForwardMutex);
+    size_t count = 0;
+    for (DataProcessorWorker* worker = mWorkers; worker != nullptr; worker = worker->mNextWorker)
+    {
+        count++;
+    }
+    return count;
+}
+
+void
+DataProcessorPool::resetCounters()
+{
+    mNumIncomingBlocks = 0;
+    mNumProcessedBlocks = 0;
+    mNumForwardedBlocks = 0;
+    mNumLostBlocks = 0;
+}
+
+void
+DataProcessorPool::registerWorker(DataProcessorWorker& worker)
+{
+    outpost::rtos::MutexGuard lock(mForwardMutex);
+    worker.mNextWorker = mWorkers;
+    mWorkers = &worker;
+}
+
+void
+DataProcessorPool::unregisterWorker(DataProcessorWorker& worker)
+{
+    outpost::rtos::MutexGuard lock(mForwardMutex);
+    DataProcessorWorker** current = &mWorkers;
+    while (*current != nullptr)
+    {
+        if (*current == &worker)
+        {
+            *current = worker.mNextWorker;
+            worker.mNextWorker = nullptr;
+            return;
+        }
+        current = &(*current)->mNextWorker;
+    }
+}
+
+bool
+DataProcessorPool::receive(DataBlock& b, uint32_t& ticket, outpost::time::Duration timeout)
+{
+    outpost::rtos::MutexGuard lock(mReceiveMutex);
+    if (mInputQueue.receive(b, timeout))
+    {
+        mNumIncomingBlocks++;
+        ticket = mNextTicket++;
+        return true;
+    }
+    return false;
+}
+
+bool
+DataProcessorPool::compress(DataBlock& b, NLSEncoderBase& encoder)
+{
+    BlockEncoder* blockEncoder = &encoder;
+    if (mSelector != nullptr && mSelector->select(b) == CompressionScheme::rice)
+    {
+        blockEncoder = &mRiceEncoder;
+    }
+    // Blocks from a streaming DataAggregator are transformed already
+    else if (!(b.isTransformed() || b.applyWaveletTransform())
+             || b.getCoefficients().getNumberOfElements() == 0U)
+    {
+        return false;
+    }
+
+    outpost::utils::SharedBufferPointer p;
+    if (mPool.allocate(p))
+    {
+        DataBlock outputBlock(
+                p, b.getParameterId(), b.getStartTime(), b.getSamplingRate(), b.getBlocksize());
+        if (b.encode(outputBlock, *blockEncoder))
+        {
+            b = outputBlock;
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+DataProcessorPool::forward(DataProcessorWorker& worker,
+                           DataBlock& b,
+                           uint32_t ticket,
+                           bool compressed)
+{
+    mForwardMutex.acquire();
+    if (ticket != mNextForwardTicket)
+    {
+        worker.mWaitingTicket = ticket;
+        worker.mWaiting = true;
+        mForwardMutex.release();
+
+        // Released by the worker forwarding the previous ticket
+        worker.mTurn.acquire();
+    }
+    else
+    {
+        mForwardMutex.release();
+    }
+
+    // Only the owner of the current ticket gets here, sending is therefore
+    // done without holding the lock.
+    // Wakes up as soon as the consumer has freed a slot
+    const bool success =
+            compressed && mOutputQueue.send(b, mRetrySendTimeout * mMaxSendRetries);
+
+    outpost::rtos::MutexGuard lock(mForwardMutex);
+    if (compressed)
+    {
+        mNumProcessedBlocks++;
+        if (success)
+        {
+            mNumForwardedBlocks++;
+        }
+        else
+        {
+            mNumLostBlocks++;
+        }
+    }
+
+    mNextForwardTicket++;
+    for (DataProcessorWorker* next = mWorkers; next != nullptr; next = next->mNextWorker)
+    {
+        if (next->mWaiting && next->mWaitingTicket == mNextForwardTicket)
+        {
+            next->mWaiting = false;
+            next->mTurn.release();
+            break;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+constexpr outpost::time::Duration DataProcessorWorker::receiveTimeout;
+
+DataProcessorWorker::DataProcessorWorker(DataProcessorPool& pool, uint8_t thread_priority) :
+    outpost::rtos::Thread(thread_priority, 1024, "DPW"),
+    mProcessorPool(pool),
+    mNextWorker(nullptr),
+    mEncoder(),
+    mWaitingTicket(0),
+    mWaiting(false),
+    mTurn(outpost::rtos::BinarySemaphore::State::acquired)
+{
+    mProcessorPool.registerWorker(*this);
+}
+
+DataProcessorWorker::~DataProcessorWorker()
+{
+    mProcessorPool.unregisterWorker(*this);
+}
+
+void
+DataProcessorWorker::run()
+{
+    while (1)
+    {
+        mProcessorPool.mCheckpoint.pass();
+        processSingleBlock(receiveTimeout);
+    }
+}
+
+void
+DataProcessorWorker::processSingleBlock(outpost::time::Duration timeout)
+{
+    DataBlock b;
+    uint32_t ticket = 0;
+    if (mProcessorPool.receive(b, ticket, timeout))
+    {
+        bool compressed = mProcessorPool.compress(b, mEncoder);
+        mProcessorPool.forward(*this, b, ticket, compressed);
+    }
+}
+
+}  // namespace compression
+}  // namespace outpost
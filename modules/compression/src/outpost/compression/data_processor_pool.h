@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMPRESSION_DATA_PROCESSOR_POOL_H_
+#define OUTPOST_COMPRESSION_DATA_PROCESSOR_POOL_H_
+
+#include "nls_encoder.h"
+#include "rice_encoder.h"
+
+#include <outpost/rtos/checkpoint.h>
+#include <outpost/rtos/mutex.h>
+#include <outpost/rtos/semaphore.h>
+#include <outpost/rtos/thread.h>
+#include <outpost/time/duration.h>
+
+namespace outpost
+{
+namespace utils
+{
+template <typename T>
+class ReferenceQueueBase;
+
+class SharedBufferPoolBase;
+}  // namespace utils
+
+namespace compression
+{
+class CompressionSchemeSelector;
+class DataBlock;
+class DataProcessorWorker;
+
+/**
+ * Distributes the transformation and encoding of DataBlocks over several
+ * DataProcessorWorker threads.
+ *
+ * All workers receive from the same input queue. Every received block gets
+ * a ticket and the blocks are forwarded to the output queue in the order of
+ * their tickets, i.e. in the order they have been received. A worker which
+ * finishes before its predecessors waits until they have forwarded their
+ * blocks. Thereby the blocks of each parameter leave the pool in the same
+ * order as with a single DataProcessorThread.
+ *
+ * The pool itself does not contain a thread, the workers are created
+ * separately and register themselves at the pool.
+ */
+class DataProcessorPool
+{
+    friend class DataProcessorWorker;
+
+public:
+    /** Constructor
+     * @param pool SharedBufferPool for allocation of new DataBlocks
+     * @param inputQueue Queue to listen to for incoming raw DataBlocks
+     * @param outputQueue Queue to send encoded DataBlocks to for long-term storage or transmission
+     * to ground
+     * @param numOutputRetries Together with retryTimeout the maximum time to wait for a free slot
+     * in the output queue, numOutputRetries * retryTimeout.
+     * @param retryTimeout See numOutputRetries
+     */
+    DataProcessorPool(outpost::utils::SharedBufferPoolBase& pool,
+                      outpost::utils::ReferenceQueueBase<DataBlock>& inputQueue,
+                      outpost::utils::ReferenceQueueBase<DataBlock>& outputQueue,
+                      uint8_t numOutputRetries = 5U,
+                      outpost::time::Duration retryTimeout = outpost::time::Milliseconds(500));
+
+    ~DataProcessorPool();
+
+    /**
+     * Enables the processing of DataBlocks for all workers
+     */
+    void
+    enable();
+
+    /**
+     * Disables the processing of DataBlocks for all workers
+     */
+    void
+    disable();
+
+    /**
+     * Getter for the pool's state.
+     * @return Returns true if processing is currently enabled, false otherwise.
+     */
+    bool
+    isEnabled() const;
+
+    /**
+     * Enables the automatic selection of the compression scheme for each block.
+     * Must not be changed while the pool is enabled.
+     * @param selector Selector to use, must outlive the pool. By default, or with a nullptr,
+     * all blocks are wavelet transformed and NLS encoded.
+     */
+    void
+    setSchemeSelector(const CompressionSchemeSelector* selector);
+
+    /**
+     * Getter for the number of workers registered at the pool.
+     */
+    size_t
+    getNumberOfWorkers() const;
+
+    /**
+     * Getter for the number of DataBlocks that have been received from the input queue.
+     * @return Returns the number of incoming blocks.
+     */
+    inline uint32_t
+    getNumberOfReceivedBlocks() const
+    {
+        return mNumIncomingBlocks;
+    }
+
+    /**
+     * Getter for the number of DataBlocks that have been processed.
+     * @return Returns the number of processed blocks.
+     */
+    inline uint32_t
+    getNumberOfProcessedBlocks() const
+    {
+        return mNumProcessedBlocks;
+    }
+
+    /**
+     * Getter for the number of DataBlocks that haven been forwarded to the output queue.
+     * @return Returns the number of forwarded blocks.
+     */
+    inline uint32_t
+    getNumberOfForwardedBlocks() const
+    {
+        return mNumForwardedBlocks;
+    }
+
+    /**
+     * Getter for the number of DataBlocks that have been lost because they could not be sent to
+     * the output queue.
+     * @return Returns the number of lost blocks.
+     */
+    inline uint32_t
+    getNumberOfLostBlocks() const
+    {
+        return mNumLostBlocks;
+    }
+
+    /**
+     * Resets the counters for incoming, processed and forwarded blocks.
+     */
+    void
+    resetCounters();
+
+private:
+    void
+    registerWorker(DataProcessorWorker& worker);
+
+    void
+    unregisterWorker(DataProcessorWorker& worker);
+
+    /**
+     * Receive the next block and assign a ticket to it.
+     * @return Returns true if a block has been received.
+     */
+    bool
+    receive(DataBlock& b, uint32_t& ticket, outpost::time::Duration timeout);
+
+    bool
+    compress(DataBlock& b, NLSEncoderBase& encoder);
+
+    /**
+     * Forward a block once all blocks with a previous ticket have been forwarded.
+     * @param compressed False if the block could not be compressed, only the ticket is
+     * released then.
+     */
+    void
+    forward(DataProcessorWorker& worker, DataBlock& b, uint32_t ticket, bool compressed);
+
+    outpost::utils::ReferenceQueueBase<DataBlock>& mInputQueue;
+    outpost::utils::ReferenceQueueBase<DataBlock>& mOutputQueue;
+
+    outpost::utils::SharedBufferPoolBase& mPool;
+
+    outpost::rtos::Checkpoint mCheckpoint;
+
+    // Serializes the reception so that tickets follow the order of the input queue
+    outpost::rtos::Mutex mReceiveMutex;
+    uint32_t mNextTicket;
+
+    // Protects the worker list, the waiting state of the workers and mNextForwardTicket
+    mutable outpost::rtos::Mutex mForwardMutex;
+    uint32_t mNextForwardTicket;
+    DataProcessorWorker* mWorkers;
+
+    uint32_t mNumIncomingBlocks;
+    uint32_t mNumProcessedBlocks;
+    uint32_t mNumForwardedBlocks;
+    uint32_t mNumLostBlocks;
+
+    outpost::time::Duration mRetrySendTimeout;
+    uint8_t mMaxSendRetries;
+
+    // Stateless and therefore shared by all workers
+    RiceEncoder mRiceEncoder;
+    const CompressionSchemeSelector* mSelector;
+};
+
+/**
+ * Worker thread of a DataProcessorPool.
+ *
+ * Each worker has its own NLSEncoder, as the encoder keeps its state
+ * between calls and can not be shared between threads.
+ */
+class DataProcessorWorker : public outpost::rtos::Thread
+{
+    friend class DataProcessorPool;
+
+    // The other workers wait for the reception lock meanwhile, a finite
+    // timeout lets them pass the checkpoint regularly.
+    static constexpr outpost::time::Duration receiveTimeout = outpost::time::Milliseconds(100);
+
+public:
+    /** Constructor
+     * @param pool Pool to register at, must outlive the worker
+     * @param thread_priority Priority in the OS' scheduler
+     */
+    DataProcessorWorker(DataProcessorPool& pool, uint8_t thread_priority);
+
+    virtual ~DataProcessorWorker();
+
+    /**
+     * The method is called by the OS' scheduler. It processes blocks as long as the
+     * pool is enabled.
+     */
+    void
+    run() override;
+
+    /**
+     * Goes through the entire processing sequence for a single block,
+     * from reception from the input queue through compression to forwarding to the output queue.
+     * @param timeout Timeout for reception of a DataBlock on the input queue.
+     */
+    void
+    processSingleBlock(outpost::time::Duration timeout = outpost::time::Duration::infinity());
+
+private:
+    DataProcessorPool& mProcessorPool;
+    DataProcessorWorker* mNextWorker;
+
+    NLSEncoder mEncoder;
+
+    // Ticket the worker waits for, only valid while mWaiting is set
+    uint32_t mWaitingTicket;
+    bool mWaiting;
+    outpost::rtos::BinarySemaphore mTurn;
+};
+
+}  // namespace compression
+}  // namespace outpost
+
+#endif /* OUTPOST_COMPRESSION_DATA_PROCESSOR_POOL_H_ */
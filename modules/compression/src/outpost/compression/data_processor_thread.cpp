@@ -14,16 +14,23 @@
 #include "data_processor_thread.h"
 
 #include "data_block.h"
+#include "data_block_sender.h"
 #include "legall_wavelet.h"
+#include "remote_encoder.h"
+#include "scheme_selector.h"
 
 #include <outpost/base/fixpoint.h>
 #include <outpost/utils/container/reference_queue.h>
 #include <outpost/utils/container/shared_object_pool.h>
+#include <outpost/utils/trace/trace.h>
 
 namespace outpost
 {
 namespace compression
 {
+constexpr size_t DataProcessorThread::maximumBatchSize;
+constexpr size_t DataProcessorThread::maximumBatchBlocksize;
+
 DataProcessorThread::DataProcessorThread(uint8_t thread_priority,
                                          outpost::utils::SharedBufferPoolBase& pool,
                                          outpost::utils::ReferenceQueueBase<DataBlock>& inputQueue,
@@ -35,12 +42,17 @@ DataProcessorThread::DataProcessorThread(uint8_t thread_priority,
     mOutputQueue(outputQueue),
     mPool(pool),
     mCheckpoint(outpost::rtos::Checkpoint::State::suspending),
-    mNumIncomingBlocks(0),
-    mNumProcessedBlocks(0),
-    mNumForwardedBlocks(0),
-    mNumLostBlocks(0),
+    mCounters(),
+    mEncoder(),
+    mRiceEncoder(),
+    mSelector(nullptr),
+    mSpillSender(nullptr),
+    mRemoteEncoder(nullptr),
+    mRemotePollInterval(outpost::time::Duration::infinity()),
     mEncodingSlice(mEncodingBuffer),
     mBitstream(mEncodingSlice),
+    mBatch(),
+    mScratch(),
     mRetrySendTimeout(retryTimeout),
     mMaxSendRetries(numOutputRetries)
 {
@@ -56,7 +68,9 @@ DataProcessorThread::run()
     while (1)
     {
         mCheckpoint.pass();
-        processSingleBlock();
+        // Blocks returned by the remote encoder are collected after at most one poll interval
+        processBatch((mRemoteEncoder != nullptr) ? mRemotePollInterval
+                                                 : outpost::time::Duration::infinity());
     }
 }
 
@@ -72,6 +86,32 @@ DataProcessorThread::disable()
     mCheckpoint.suspend();
 }
 
+void
+DataProcessorThread::setSchemeSelector(const CompressionSchemeSelector* selector)
+{
+    mSelector = selector;
+}
+
+void
+DataProcessorThread::setRateControl(size_t maximumSize, uint8_t lowestBitplane)
+{
+    mEncoder.setRateControl(maximumSize, lowestBitplane);
+}
+
+void
+DataProcessorThread::setRemoteEncoder(RemoteEncoder* encoder,
+                                      outpost::time::Duration pollInterval)
+{
+    mRemoteEncoder = encoder;
+    mRemotePollInterval = pollInterval;
+}
+
+void
+DataProcessorThread::setSpillSender(DataBlockSender* sender)
+{
+    mSpillSender = sender;
+}
+
 bool
 DataProcessorThread::isEnabled() const
 {
@@ -84,49 +124,201 @@ DataProcessorThread::processSingleBlock(outpost::time::Duration timeout)
     DataBlock b;
     if (mInputQueue.receive(b, timeout))
     {
-        mNumIncomingBlocks++;
-        if (compress(b))
+        mCounters.increment(incomingBlocks);
+        const CompressionScheme scheme = selectScheme(b);
+        if (!offload(b, scheme))
+        {
+            process(b, scheme);
+        }
+    }
+    collectRemoteBlocks();
+}
+
+void
+DataProcessorThread::processBatch(outpost::time::Duration timeout)
+{
+    size_t numberOfBlocks = 0;
+    if (!mInputQueue.receive(mBatch[0], timeout))
+    {
+        collectRemoteBlocks();
+        return;
+    }
+    numberOfBlocks++;
+    while (numberOfBlocks < maximumBatchSize
+           && mInputQueue.receive(mBatch[numberOfBlocks], outpost::time::Duration::zero()))
+    {
+        numberOfBlocks++;
+    }
+
+    CompressionScheme schemes[maximumBatchSize];
+    bool offloaded[maximumBatchSize];
+    for (size_t i = 0; i < numberOfBlocks; i++)
+    {
+        mCounters.increment(incomingBlocks);
+        schemes[i] = selectScheme(mBatch[i]);
+        offloaded[i] = offload(mBatch[i], schemes[i]);
+        if (offloaded[i])
+        {
+            // The remote encoder keeps the buffer until it returns the block
+            mBatch[i] = DataBlock();
+        }
+    }
+
+    for (size_t i = 0; i < numberOfBlocks; i++)
+    {
+        transformBatch(i, numberOfBlocks, schemes);
+    }
+
+    for (size_t i = 0; i < numberOfBlocks; i++)
+    {
+        if (!offloaded[i])
+        {
+            process(mBatch[i], schemes[i]);
+        }
+        // Give the buffer back to the pool
+        mBatch[i] = DataBlock();
+    }
+    collectRemoteBlocks();
+}
+
+bool
+DataProcessorThread::offload(const DataBlock& b, CompressionScheme scheme)
+{
+    // Blocks from a streaming DataAggregator hold coefficients which are encoded locally
+    if (mRemoteEncoder == nullptr || b.isTransformed() || b.isEncoded() || !b.isComplete()
+        || !mRemoteEncoder->submit(b, scheme))
+    {
+        return false;
+    }
+    mCounters.increment(offloadedBlocks);
+    return true;
+}
+
+void
+DataProcessorThread::collectRemoteBlocks()
+{
+    if (mRemoteEncoder == nullptr)
+    {
+        return;
+    }
+
+    DataBlock b;
+    while (mRemoteEncoder->receive(b, outpost::time::Duration::zero()))
+    {
+        if (b.isEncoded())
         {
-            mNumProcessedBlocks++;
-            bool success = false;
-            for (uint8_t tries = 0; tries < mMaxSendRetries && !success; tries++)
-            {
-                if (mOutputQueue.send(b))
-                {
-                    success = true;
-                }
-                else
-                {
-                    outpost::rtos::Thread::sleep(mRetrySendTimeout);
-                }
-            }
-            if (success)
-            {
-                mNumForwardedBlocks++;
-            }
-            else
-            {
-                mNumLostBlocks++;
-            }
+            mCounters.increment(processedBlocks);
+            forward(b);
         }
+        else
+        {
+            // The remote failed, fall back to local compression
+            process(b, selectScheme(b));
+        }
+        b = DataBlock();
+    }
+}
+
+CompressionScheme
+DataProcessorThread::selectScheme(const DataBlock& b) const
+{
+    if (mSelector != nullptr && mSelector->select(b) == CompressionScheme::rice)
+    {
+        return CompressionScheme::rice;
+    }
+    return CompressionScheme::waveletNLS;
+}
+
+void
+DataProcessorThread::transformBatch(size_t first,
+                                    size_t numberOfBlocks,
+                                    const CompressionScheme* schemes)
+{
+    const DataBlock& reference = mBatch[first];
+    if (schemes[first] != CompressionScheme::waveletNLS || reference.isTransformed()
+        || !reference.isComplete()
+        || toUInt(reference.getBlocksize()) > maximumBatchBlocksize)
+    {
+        return;
+    }
+
+    DataBlock* group[maximumBatchSize];
+    size_t groupSize = 0;
+    for (size_t i = first; i < numberOfBlocks; i++)
+    {
+        DataBlock& b = mBatch[i];
+        if (schemes[i] == CompressionScheme::waveletNLS && !b.isTransformed() && !b.isEncoded()
+            && b.isComplete() && b.getBlocksize() == reference.getBlocksize())
+        {
+            group[groupSize++] = &b;
+        }
+    }
+
+    // A single block is transformed on its own by compress()
+    if (groupSize > 1)
+    {
+        DataBlock::applyWaveletTransform(
+                outpost::Slice<DataBlock* const>::unsafe(group, groupSize), mScratch);
+    }
+}
+
+void
+DataProcessorThread::process(DataBlock& b, CompressionScheme scheme)
+{
+    OUTPOST_TRACE(outpost::utils::trace::compressionBegin,
+                  b.getParameterId(),
+                  static_cast<uint32_t>(b.getBlocksize()));
+    const bool compressed = compress(b, scheme);
+    OUTPOST_TRACE(outpost::utils::trace::compressionEnd, b.getParameterId(), compressed);
+    if (compressed)
+    {
+        mCounters.increment(processedBlocks);
+        forward(b);
+    }
+}
+
+void
+DataProcessorThread::forward(DataBlock& b)
+{
+    // Wakes up as soon as the consumer has freed a slot
+    if (mOutputQueue.send(b, mRetrySendTimeout * mMaxSendRetries))
+    {
+        mCounters.increment(forwardedBlocks);
+    }
+    else if (mSpillSender != nullptr && mSpillSender->send(b))
+    {
+        mCounters.increment(spilledBlocks);
+    }
+    else
+    {
+        mCounters.increment(lostBlocks);
     }
 }
 
 bool
-DataProcessorThread::compress(DataBlock& b)
+DataProcessorThread::compress(DataBlock& b, CompressionScheme scheme)
 {
-    if (b.applyWaveletTransform() && b.getCoefficients().getNumberOfElements() > 0U)
+    BlockEncoder* blockEncoder = &mEncoder;
+    if (scheme == CompressionScheme::rice)
+    {
+        blockEncoder = &mRiceEncoder;
+    }
+    // Blocks from a streaming DataAggregator or a batch are transformed already
+    else if (!(b.isTransformed() || b.applyWaveletTransform())
+             || b.getCoefficients().getNumberOfElements() == 0U)
+    {
+        return false;
+    }
+
+    outpost::utils::SharedBufferPointer p;
+    if (mPool.allocate(p))
     {
-        outpost::utils::SharedBufferPointer p;
-        if (mPool.allocate(p))
+        DataBlock outputBlock(
+                p, b.getParameterId(), b.getStartTime(), b.getSamplingRate(), b.getBlocksize());
+        if (b.encode(outputBlock, *blockEncoder))
         {
-            DataBlock outputBlock(
-                    p, b.getParameterId(), b.getStartTime(), b.getSamplingRate(), b.getBlocksize());
-            if (b.encode(outputBlock, mEncoder))
-            {
-                b = outputBlock;
-                return true;
-            }
+            b = outputBlock;
+            return true;
         }
     }
     return false;
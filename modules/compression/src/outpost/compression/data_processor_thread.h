@@ -14,10 +14,14 @@
 #ifndef OUTPOST_COMPRESSION_DATA_PROCESSOR_THREAD_H_
 #define OUTPOST_COMPRESSION_DATA_PROCESSOR_THREAD_H_
 
+#include "data_block.h"
 #include "nls_encoder.h"
+#include "rice_encoder.h"
 
 #include <outpost/rtos/checkpoint.h>
 #include <outpost/rtos/thread.h>
+#include <outpost/utils/container/arena.h>
+#include <outpost/utils/counter_block.h>
 #include <outpost/utils/storage/bitstream.h>
 
 namespace outpost
@@ -32,7 +36,9 @@ class SharedBufferPoolBase;
 
 namespace compression
 {
-class DataBlock;
+class CompressionSchemeSelector;
+class DataBlockSender;
+class RemoteEncoder;
 
 /**
  * The DataProcessorThread is responsible for taking over the workload of transforming and encoding
@@ -47,6 +53,10 @@ public:
      * @param inputQueue Queue to listen to for incoming raw DataBlocks
      * @param outputQueue Queue to send encoded DataBlocks to for long-term storage or transmission
      * to ground
+     * @param numOutputRetries Together with retryTimeout the maximum time to wait for a free slot
+     * in the output queue, numOutputRetries * retryTimeout. The thread continues as soon as the
+     * consumer has freed a slot.
+     * @param retryTimeout See numOutputRetries
      */
     DataProcessorThread(uint8_t thread_priority,
                         outpost::utils::SharedBufferPoolBase& pool,
@@ -60,7 +70,7 @@ public:
     /**
      * The method is called by the OS' scheduler. It awaits DataBlocks on the incoming queue,
      * transforms them using the wavelet transform and then encodes the data to a newly allocated
-     * DataBlock.
+     * DataBlock. Blocks which are pending together are processed by processBatch().
      */
     void
     run() override;
@@ -84,7 +94,7 @@ public:
     inline uint32_t
     getNumberOfReceivedBlocks() const
     {
-        return mNumIncomingBlocks;
+        return mCounters.get(incomingBlocks);
     }
 
     /**
@@ -94,7 +104,7 @@ public:
     inline uint32_t
     getNumberOfProcessedBlocks() const
     {
-        return mNumProcessedBlocks;
+        return mCounters.get(processedBlocks);
     }
 
     /**
@@ -104,7 +114,7 @@ public:
     inline uint32_t
     getNumberOfForwardedBlocks() const
     {
-        return mNumForwardedBlocks;
+        return mCounters.get(forwardedBlocks);
     }
 
     /**
@@ -115,9 +125,68 @@ public:
     inline uint32_t
     getNumberOfLostBlocks() const
     {
-        return mNumLostBlocks;
+        return mCounters.get(lostBlocks);
     }
 
+    /**
+     * Getter for the number of DataBlocks that have been submitted to the remote encoder.
+     * @return Returns the number of offloaded blocks.
+     */
+    inline uint32_t
+    getNumberOfOffloadedBlocks() const
+    {
+        return mCounters.get(offloadedBlocks);
+    }
+
+    /**
+     * Getter for the number of DataBlocks that have been handed to the spill sender because the
+     * output queue stayed full.
+     * @return Returns the number of spilled blocks.
+     */
+    inline uint32_t
+    getNumberOfSpilledBlocks() const
+    {
+        return mCounters.get(spilledBlocks);
+    }
+
+    /**
+     * Sets the policy for blocks that cannot be sent to the output queue in time.
+     * @param sender Sender for these blocks, e.g. to a secondary store, must outlive the thread.
+     * By default, or with a nullptr, the blocks are dropped and counted as lost.
+     */
+    void
+    setSpillSender(DataBlockSender* sender);
+
+    /**
+     * Enables the automatic selection of the compression scheme for each block.
+     * @param selector Selector to use, must outlive the thread. By default, or with a nullptr,
+     * all blocks are wavelet transformed and NLS encoded.
+     */
+    void
+    setSchemeSelector(const CompressionSchemeSelector* selector);
+
+    /**
+     * Limits the size of NLS encoded blocks, see NLSEncoderBase::setRateControl().
+     * @param maximumSize Maximum number of bytes of the encoded data of a block, 0 for no limit.
+     * @param lowestBitplane Lowest bitplane to encode, 0 encodes all bitplanes.
+     */
+    void
+    setRateControl(size_t maximumSize, uint8_t lowestBitplane = 0);
+
+    /**
+     * Offloads the compression of raw blocks to another node.
+     * Blocks are compressed locally whenever the remote encoder does not accept them, and when
+     * the remote encoder returns them unencoded. Offloaded blocks are forwarded when the remote
+     * encoder returns them, i.e. possibly after blocks received later.
+     * @param encoder Remote encoder to use, must outlive the thread. By default, or with a
+     * nullptr, all blocks are compressed locally.
+     * @param pollInterval Maximum time run() waits for input before it checks for blocks returned
+     * by the remote encoder.
+     */
+    void
+    setRemoteEncoder(RemoteEncoder* encoder,
+                     outpost::time::Duration pollInterval = outpost::time::Milliseconds(10));
+
     /**
      * Getter for the thread's state.
      * @return Returns true if processing is currently enabled, false otherwise.
@@ -131,10 +200,7 @@ public:
     inline void
     resetCounters()
     {
-        mNumIncomingBlocks = 0;
-        mNumProcessedBlocks = 0;
-        mNumForwardedBlocks = 0;
-        mNumLostBlocks = 0;
+        mCounters.reset();
     }
 
     /**
@@ -145,9 +211,74 @@ public:
     void
     processSingleBlock(outpost::time::Duration timeout = outpost::time::Duration::infinity());
 
+    /**
+     * Like processSingleBlock, but takes all DataBlocks pending on the input queue, up to
+     * maximumBatchSize. Blocks of the same blocksize of at most maximumBatchBlocksize samples
+     * that are to be NLS encoded are wavelet transformed together, see
+     * DataBlock::applyWaveletTransform(outpost::Slice<DataBlock* const>, outpost::utils::Arena&).
+     * The blocks are forwarded in the order of their reception, except for those offloaded to the
+     * remote encoder. Blocks returned by the remote encoder are forwarded afterwards.
+     * @param timeout Timeout for reception of the first DataBlock on the input queue.
+     */
+    void
+    processBatch(outpost::time::Duration timeout = outpost::time::Duration::infinity());
+
+    /// Maximum number of DataBlocks received by one call of processBatch()
+    static constexpr size_t maximumBatchSize = 8;
+
+    /// Maximum number of samples of blocks transformed together
+    static constexpr size_t maximumBatchBlocksize = 128;
+
 private:
+    enum Counter
+    {
+        incomingBlocks,
+        processedBlocks,
+        forwardedBlocks,
+        spilledBlocks,
+        lostBlocks,
+        offloadedBlocks,
+        numberOfCounters
+    };
+
+    CompressionScheme
+    selectScheme(const DataBlock& b) const;
+
+    /**
+     * Compresses a received block and forwards it to the output queue.
+     */
+    void
+    process(DataBlock& b, CompressionScheme scheme);
+
+    /**
+     * Forwards an encoded block to the output queue or the spill sender.
+     */
+    void
+    forward(DataBlock& b);
+
+    /**
+     * Submits a raw block to the remote encoder, if there is one.
+     * @return Returns true if the block has been taken over.
+     */
+    bool
+    offload(const DataBlock& b, CompressionScheme scheme);
+
+    /**
+     * Forwards the blocks encoded by the remote encoder and compresses those it returned
+     * unencoded.
+     */
+    void
+    collectRemoteBlocks();
+
     bool
-    compress(DataBlock& b);
+    compress(DataBlock& b, CompressionScheme scheme);
+
+    /**
+     * Applies the batched wavelet transform to all blocks of the current batch which share
+     * blocksize, scheme and state with the block at the given index.
+     */
+    void
+    transformBatch(size_t first, size_t numberOfBlocks, const CompressionScheme* schemes);
 
     outpost::utils::ReferenceQueueBase<DataBlock>& mInputQueue;
     outpost::utils::ReferenceQueueBase<DataBlock>& mOutputQueue;
@@ -156,18 +287,26 @@ private:
 
     outpost::rtos::Checkpoint mCheckpoint;
 
-    uint32_t mNumIncomingBlocks;
-    uint32_t mNumProcessedBlocks;
-    uint32_t mNumForwardedBlocks;
-    uint32_t mNumLostBlocks;
+    // Written by the thread, read by others without a lock
+    outpost::utils::CounterBlock<numberOfCounters> mCounters;
 
     NLSEncoder mEncoder;
+    RiceEncoder mRiceEncoder;
+    const CompressionSchemeSelector* mSelector;
+    DataBlockSender* mSpillSender;
+    RemoteEncoder* mRemoteEncoder;
+    outpost::time::Duration mRemotePollInterval;
 
     static constexpr uint16_t maximumEncodingBufferLength = 16400;
     uint8_t mEncodingBuffer[maximumEncodingBufferLength];
     outpost::Slice<uint8_t> mEncodingSlice;
     outpost::Bitstream mBitstream;
 
+    DataBlock mBatch[maximumBatchSize];
+    outpost::utils::ArenaStorage<DataBlock::getBatchScratchSize(maximumBatchSize,
+                                                                maximumBatchBlocksize)>
+            mScratch;
+
     outpost::time::Duration mRetrySendTimeout;
     uint8_t mMaxSendRetries;
 };
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "image_compression_worker.h"
+
+#include "image_strip.h"
+
+#include <outpost/utils/container/reference_queue.h>
+#include <outpost/utils/container/shared_object_pool.h>
+
+namespace outpost
+{
+namespace compression
+{
+ImageCompressionWorker::ImageCompressionWorker(
+        uint8_t thread_priority,
+        outpost::utils::SharedBufferPoolBase& pool,
+        outpost::utils::ReferenceQueueBase<ImageStrip>& inputQueue,
+        outpost::utils::ReferenceQueueBase<ImageStrip>& outputQueue,
+        outpost::utils::Arena& scratch,
+        ImageFilter filter) :
+    outpost::rtos::Thread(thread_priority, 1024, "ICW"),
+    mPool(pool),
+    mInputQueue(inputQueue),
+    mOutputQueue(outputQueue),
+    mScratch(scratch),
+    mFilter(filter),
+    mCheckpoint(outpost::rtos::Checkpoint::State::suspending),
+    mMaximumSize(0),
+    mNumProcessedStrips(0),
+    mNumLostStrips(0)
+{
+}
+
+void
+ImageCompressionWorker::run()
+{
+    while (1)
+    {
+        mCheckpoint.pass();
+        processSingleStrip();
+    }
+}
+
+void
+ImageCompressionWorker::enable()
+{
+    mCheckpoint.resume();
+}
+
+void
+ImageCompressionWorker::disable()
+{
+    mCheckpoint.suspend();
+}
+
+bool
+ImageCompressionWorker::isEnabled() const
+{
+    return mCheckpoint.getState() == outpost::rtos::Checkpoint::State::running;
+}
+
+bool
+ImageCompressionWorker::processSingleStrip(outpost::time::Duration timeout)
+{
+    ImageStrip strip;
+    if (!mInputQueue.receive(strip, timeout))
+    {
+        return false;
+    }
+
+    mNumProcessedStrips++;
+    outpost::utils::SharedBufferPointer p;
+    ImageStrip encoded;
+    if (mPool.allocate(p))
+    {
+        // The dimensions are taken over from the encoded strip
+        encoded = ImageStrip(p, 0, 0, 0, 0);
+    }
+    if (!strip.encode(encoded, mFilter, mScratch, mMaximumSize) || !mOutputQueue.send(encoded))
+    {
+        mNumLostStrips++;
+    }
+    return true;
+}
+
+}  // namespace compression
+}  // namespace outpost
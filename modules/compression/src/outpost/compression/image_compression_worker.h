@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMPRESSION_IMAGE_COMPRESSION_WORKER_H_
+#define OUTPOST_COMPRESSION_IMAGE_COMPRESSION_WORKER_H_
+
+#include "image_wavelet.h"
+
+#include <outpost/rtos/checkpoint.h>
+#include <outpost/rtos/thread.h>
+#include <outpost/time/duration.h>
+
+namespace outpost
+{
+namespace utils
+{
+template <typename T>
+class ReferenceQueueBase;
+
+class Arena;
+class SharedBufferPoolBase;
+}  // namespace utils
+
+namespace compression
+{
+class ImageStrip;
+
+/**
+ * Thread compressing the ImageStrips of an ImageStripCollector.
+ *
+ * As the strips are independent of each other, several workers can receive from the same input
+ * queue and compress the strips of an image in parallel, e.g. one worker per core pinned with
+ * setAffinity(). The encoded strips carry their index and may leave the workers out of order.
+ */
+class ImageCompressionWorker : public outpost::rtos::Thread
+{
+public:
+    /** Constructor
+     * @param thread_priority Priority in the OS' scheduler
+     * @param pool SharedBufferPool for the encoded strips
+     * @param inputQueue Queue to listen to for complete strips
+     * @param outputQueue Queue to send encoded strips to
+     * @param scratch Arena of the worker for ImageWavelet::getScratchSize() bytes, must not be
+     * shared with other workers
+     * @param filter Wavelet filter to apply
+     */
+    ImageCompressionWorker(uint8_t thread_priority,
+                           outpost::utils::SharedBufferPoolBase& pool,
+                           outpost::utils::ReferenceQueueBase<ImageStrip>& inputQueue,
+                           outpost::utils::ReferenceQueueBase<ImageStrip>& outputQueue,
+                           outpost::utils::Arena& scratch,
+                           ImageFilter filter = ImageFilter::integer97);
+
+    virtual ~ImageCompressionWorker() = default;
+
+    /**
+     * The method is called by the OS' scheduler. It compresses strips as long as the worker is
+     * enabled.
+     */
+    void
+    run() override;
+
+    void
+    enable();
+
+    void
+    disable();
+
+    bool
+    isEnabled() const;
+
+    /**
+     * Limits the size of the encoded strips, including their header. The lowest bit planes are
+     * dropped if necessary.
+     * @param maximumSize Maximum number of bytes, 0 to use the whole buffer of the pool
+     */
+    inline void
+    setMaximumSize(size_t maximumSize)
+    {
+        mMaximumSize = maximumSize;
+    }
+
+    /**
+     * Receives, compresses and forwards a single strip.
+     * @param timeout Timeout for the reception of a strip
+     * @return Returns true if a strip has been received.
+     */
+    bool
+    processSingleStrip(outpost::time::Duration timeout = outpost::time::Duration::infinity());
+
+    inline uint32_t
+    getNumberOfProcessedStrips() const
+    {
+        return mNumProcessedStrips;
+    }
+
+    /**
+     * Getter for the number of strips which could not be encoded or sent.
+     */
+    inline uint32_t
+    getNumberOfLostStrips() const
+    {
+        return mNumLostStrips;
+    }
+
+private:
+    outpost::utils::SharedBufferPoolBase& mPool;
+    outpost::utils::ReferenceQueueBase<ImageStrip>& mInputQueue;
+    outpost::utils::ReferenceQueueBase<ImageStrip>& mOutputQueue;
+    outpost::utils::Arena& mScratch;
+    const ImageFilter mFilter;
+
+    outpost::rtos::Checkpoint mCheckpoint;
+    size_t mMaximumSize;
+
+    uint32_t mNumProcessedStrips;
+    uint32_t mNumLostStrips;
+};
+
+}  // namespace compression
+}  // namespace outpost
+
+#endif /* OUTPOST_COMPRESSION_IMAGE_COMPRESSION_WORKER_H_ */
@@ -0,0 +1,528 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "image_encoder.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/utils/storage/bit_reader.h>
+#include <outpost/utils/storage/bit_writer.h>
+#include <outpost/utils/storage/varint.h>
+
+using outpost::compression::ImageBitplaneEncoder;
+
+constexpr uint8_t ImageBitplaneEncoder::levels;
+constexpr size_t ImageBitplaneEncoder::blockSize;
+constexpr size_t ImageBitplaneEncoder::gaggleSize;
+
+namespace
+{
+// Number of bits of the header fields
+constexpr uint8_t bitDepthBits = 5;
+constexpr uint8_t riceParameterBits = 5;
+constexpr uint8_t maximumRiceParameter = 31;
+
+constexpr size_t numberOfFamilies = 3;
+// Parent, four children and four times four grandchildren
+constexpr size_t familySize = 21;
+constexpr size_t descendantsPerFamily = familySize - 1;
+constexpr size_t acPerBlock = numberOfFamilies * familySize;
+
+inline uint32_t
+magnitude(int32_t value)
+{
+    return (value < 0) ? (0U - static_cast<uint32_t>(value)) : static_cast<uint32_t>(value);
+}
+
+/**
+ * Position of a coefficient in the pyramid layout.
+ * @param family 0 for HL, 1 for LH and 2 for HH
+ */
+inline size_t
+getIndex(size_t width, size_t height, uint8_t level, size_t family, size_t row, size_t column)
+{
+    const size_t rowOffset = (family == 0) ? 0 : (height >> level);
+    const size_t columnOffset = (family == 1) ? 0 : (width >> level);
+    return (rowOffset + row) * width + columnOffset + column;
+}
+
+/**
+ * Positions of the AC coefficients of a block, family by family: the parent, the four children
+ * and the four grandchildren of each child.
+ */
+void
+getBlock(size_t* indices, size_t width, size_t height, size_t column, size_t row)
+{
+    for (size_t f = 0; f < numberOfFamilies; f++)
+    {
+        size_t* family = &indices[f * familySize];
+        family[0] = getIndex(width, height, 3, f, row, column);
+        for (size_t i = 0; i < 4; i++)
+        {
+            const size_t r = 2 * row + i / 2;
+            const size_t c = 2 * column + i % 2;
+            family[1 + i] = getIndex(width, height, 2, f, r, c);
+            for (size_t k = 0; k < 4; k++)
+            {
+                family[5 + 4 * i + k] =
+                        getIndex(width, height, 1, f, 2 * r + k / 2, 2 * c + k % 2);
+            }
+        }
+    }
+}
+
+inline bool
+isSignificant(const int32_t* data, const size_t* indices, size_t count, uint8_t plane)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if ((magnitude(data[indices[i]]) >> plane) != 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool
+isDcCoefficient(size_t width, size_t height, size_t row, size_t column)
+{
+    return (row < (height >> 3)) && (column < (width >> 3));
+}
+
+/**
+ * Encoder side of the bit plane traversal, writes the decisions taken from the coefficients.
+ */
+class BitplaneWriter
+{
+public:
+    typedef const int32_t Value;
+
+    explicit BitplaneWriter(outpost::BitWriter& writer) : mWriter(writer), mFull(false)
+    {
+    }
+
+    inline bool
+    testSet(const int32_t* data, const size_t* indices, size_t count, uint8_t plane)
+    {
+        const bool significant = isSignificant(data, indices, count, plane);
+        push(significant ? 1U : 0U, 1);
+        return significant;
+    }
+
+    inline void
+    testCoefficient(const int32_t& value, uint8_t plane)
+    {
+        if ((magnitude(value) >> plane) != 0)
+        {
+            // Significance and sign together, a truncated stream never ends in between
+            push((value < 0) ? 3U : 2U, 2);
+        }
+        else
+        {
+            push(0U, 1);
+        }
+    }
+
+    inline void
+    refine(const int32_t& value, uint8_t plane)
+    {
+        push((magnitude(value) >> plane) & 1U, 1);
+    }
+
+    inline bool
+    isDone() const
+    {
+        return mFull;
+    }
+
+private:
+    inline void
+    push(uint32_t bits, uint8_t count)
+    {
+        if (!mFull && !mWriter.pushBits(bits, count))
+        {
+            mFull = true;
+        }
+    }
+
+    outpost::BitWriter& mWriter;
+    bool mFull;
+};
+
+/**
+ * Decoder side of the bit plane traversal, reconstructs the coefficients from the decisions.
+ */
+class BitplaneReader
+{
+public:
+    typedef int32_t Value;
+
+    explicit BitplaneReader(outpost::BitReader& reader) : mReader(reader)
+    {
+    }
+
+    inline bool
+    testSet(const int32_t*, const size_t*, size_t, uint8_t)
+    {
+        return mReader.readBit();
+    }
+
+    inline void
+    testCoefficient(int32_t& value, uint8_t plane)
+    {
+        if (mReader.readBit())
+        {
+            const int32_t bit = static_cast<int32_t>(1) << plane;
+            value = mReader.readBit() ? -bit : bit;
+        }
+    }
+
+    inline void
+    refine(int32_t& value, uint8_t plane)
+    {
+        if (mReader.readBit())
+        {
+            const int32_t bit = static_cast<int32_t>(1) << plane;
+            value = (value < 0) ? (value - bit) : (value + bit);
+        }
+    }
+
+    inline bool
+    isDone() const
+    {
+        return mReader.getNumberOfRemainingBits() == 0;
+    }
+
+private:
+    outpost::BitReader& mReader;
+};
+
+template <typename Coder>
+inline void
+codeCoefficient(Coder& coder, typename Coder::Value* data, size_t index, uint8_t plane)
+{
+    // Coefficients significant in a previous bit plane are refined later
+    if ((magnitude(data[index]) >> (plane + 1)) == 0)
+    {
+        coder.testCoefficient(data[index], plane);
+    }
+}
+
+/**
+ * Tests a set of coefficients for significance in the current bit plane, unless it contains
+ * coefficients significant in a previous bit plane already.
+ */
+template <typename Coder>
+inline bool
+codeSet(Coder& coder,
+        typename Coder::Value* data,
+        const size_t* indices,
+        size_t count,
+        uint8_t plane)
+{
+    return isSignificant(data, indices, count, plane + 1)
+           || coder.testSet(data, indices, count, plane);
+}
+
+template <typename Coder>
+void
+codeBlock(Coder& coder, typename Coder::Value* data, const size_t* indices, uint8_t plane)
+{
+    if (!codeSet(coder, data, indices, acPerBlock, plane))
+    {
+        return;
+    }
+
+    for (size_t f = 0; f < numberOfFamilies; f++)
+    {
+        const size_t* family = &indices[f * familySize];
+        codeCoefficient(coder, data, family[0], plane);
+        if (!codeSet(coder, data, &family[1], descendantsPerFamily, plane))
+        {
+            continue;
+        }
+
+        for (size_t i = 0; i < 4; i++)
+        {
+            codeCoefficient(coder, data, family[1 + i], plane);
+        }
+        for (size_t i = 0; i < 4; i++)
+        {
+            const size_t* grandchildren = &family[5 + 4 * i];
+            if (codeSet(coder, data, grandchildren, 4, plane))
+            {
+                for (size_t k = 0; k < 4; k++)
+                {
+                    codeCoefficient(coder, data, grandchildren[k], plane);
+                }
+            }
+        }
+    }
+}
+
+template <typename Coder>
+void
+codeBitplane(Coder& coder, typename Coder::Value* data, size_t width, size_t height, uint8_t plane)
+{
+    size_t indices[acPerBlock];
+    const size_t blockSize = ImageBitplaneEncoder::blockSize;
+
+    // Significance pass
+    for (size_t row = 0; row < height / blockSize; row++)
+    {
+        for (size_t column = 0; column < width / blockSize; column++)
+        {
+            if (coder.isDone())
+            {
+                return;
+            }
+            getBlock(indices, width, height, column, row);
+            codeBlock(coder, data, indices, plane);
+        }
+    }
+
+    // Refinement pass
+    for (size_t row = 0; row < height; row++)
+    {
+        if (coder.isDone())
+        {
+            return;
+        }
+        for (size_t column = 0; column < width; column++)
+        {
+            const size_t index = row * width + column;
+            if (!isDcCoefficient(width, height, row, column)
+                && (magnitude(data[index]) >> (plane + 1)) != 0)
+            {
+                coder.refine(data[index], plane);
+            }
+        }
+    }
+}
+
+/**
+ * Rice parameter with the shortest code for a gaggle of values.
+ */
+uint8_t
+selectRiceParameter(const uint32_t* values, size_t count)
+{
+    uint8_t best = 0;
+    uint64_t bestLength = UINT64_MAX;
+    for (uint8_t k = 0; k <= maximumRiceParameter; k++)
+    {
+        uint64_t length = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            length += (values[i] >> k) + 1 + k;
+        }
+        if (length < bestLength)
+        {
+            bestLength = length;
+            best = k;
+        }
+    }
+    return best;
+}
+
+bool
+writeRice(outpost::BitWriter& writer, uint32_t value, uint8_t k)
+{
+    uint32_t quotient = value >> k;
+    for (; quotient >= outpost::BitWriter::maximumBitsPerAccess;
+         quotient -= outpost::BitWriter::maximumBitsPerAccess)
+    {
+        if (!writer.pushBits(0, outpost::BitWriter::maximumBitsPerAccess))
+        {
+            return false;
+        }
+    }
+    // Quotient as unary code terminated by a one
+    if (!writer.pushBits(1, static_cast<uint8_t>(quotient + 1)))
+    {
+        return false;
+    }
+    return (k == 0) || writer.pushBits(value, k);
+}
+
+bool
+readRice(outpost::BitReader& reader, uint32_t& value, uint8_t k)
+{
+    uint32_t quotient = 0;
+    while (true)
+    {
+        if (reader.getNumberOfRemainingBits() == 0)
+        {
+            return false;
+        }
+        if (reader.readBit())
+        {
+            break;
+        }
+        quotient++;
+    }
+    if (k > reader.getNumberOfRemainingBits())
+    {
+        return false;
+    }
+    value = (k == 0) ? quotient : ((quotient << k) | reader.readBits(k));
+    return true;
+}
+
+/**
+ * Differences of the DC coefficients to their predecessor, zigzag encoded.
+ */
+void
+getDcDifferences(const int32_t* data,
+                 size_t width,
+                 size_t first,
+                 size_t count,
+                 uint32_t* differences)
+{
+    const size_t dcWidth = width >> 3;
+    for (size_t i = 0; i < count; i++)
+    {
+        const size_t n = first + i;
+        const int32_t current = data[(n / dcWidth) * width + n % dcWidth];
+        const int32_t previous =
+                (n == 0) ? 0 : data[((n - 1) / dcWidth) * width + (n - 1) % dcWidth];
+        differences[i] = outpost::VarInt::zigzagEncode(static_cast<int32_t>(
+                static_cast<uint32_t>(current) - static_cast<uint32_t>(previous)));
+    }
+}
+}  // namespace
+
+bool
+ImageBitplaneEncoder::checkDimensions(size_t numberOfCoefficients, size_t width, size_t height)
+{
+    return (width > 0) && (height > 0) && (width % blockSize == 0) && (height % blockSize == 0)
+           && (numberOfCoefficients == width * height);
+}
+
+size_t
+ImageBitplaneEncoder::encode(outpost::Slice<const int32_t> coefficients,
+                             size_t width,
+                             size_t height,
+                             outpost::Slice<uint8_t> buffer)
+{
+    if (!checkDimensions(coefficients.getNumberOfElements(), width, height)
+        || buffer.getNumberOfElements() == 0)
+    {
+        return 0;
+    }
+    const int32_t* data = &coefficients[0];
+
+    uint32_t maximum = 0;
+    for (size_t row = 0; row < height; row++)
+    {
+        for (size_t column = 0; column < width; column++)
+        {
+            if (!isDcCoefficient(width, height, row, column))
+            {
+                const uint32_t m = magnitude(data[row * width + column]);
+                maximum = (m > maximum) ? m : maximum;
+            }
+        }
+    }
+    uint8_t bitDepth = 0;
+    for (; (maximum >> bitDepth) != 0; bitDepth++)
+    {
+    }
+    if (bitDepth >= (1U << bitDepthBits))
+    {
+        return 0;
+    }
+
+    outpost::BitWriter writer(buffer);
+    if (!writer.pushBits(bitDepth, bitDepthBits))
+    {
+        return 0;
+    }
+
+    const size_t numberOfBlocks = (width / blockSize) * (height / blockSize);
+    uint32_t differences[gaggleSize];
+    for (size_t first = 0; first < numberOfBlocks; first += gaggleSize)
+    {
+        const size_t count =
+                (numberOfBlocks - first < gaggleSize) ? (numberOfBlocks - first) : gaggleSize;
+        getDcDifferences(data, width, first, count, differences);
+        const uint8_t k = selectRiceParameter(differences, count);
+        if (!writer.pushBits(k, riceParameterBits))
+        {
+            return 0;
+        }
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!writeRice(writer, differences[i], k))
+            {
+                return 0;
+            }
+        }
+    }
+
+    BitplaneWriter coder(writer);
+    for (uint8_t plane = bitDepth; (plane > 0) && !coder.isDone(); plane--)
+    {
+        codeBitplane(coder, data, width, height, plane - 1);
+    }
+    return writer.flush();
+}
+
+bool
+ImageBitplaneEncoder::decode(outpost::Slice<const uint8_t> buffer,
+                             size_t width,
+                             size_t height,
+                             outpost::Slice<int32_t> coefficients)
+{
+    if (!checkDimensions(coefficients.getNumberOfElements(), width, height)
+        || buffer.getNumberOfElements() == 0)
+    {
+        return false;
+    }
+    int32_t* data = &coefficients[0];
+    for (size_t i = 0; i < width * height; i++)
+    {
+        data[i] = 0;
+    }
+
+    outpost::BitReader reader(buffer);
+    const uint8_t bitDepth = static_cast<uint8_t>(reader.readBits(bitDepthBits));
+
+    const size_t dcWidth = width >> 3;
+    const size_t numberOfBlocks = (width / blockSize) * (height / blockSize);
+    int32_t previous = 0;
+    uint8_t k = 0;
+    for (size_t n = 0; n < numberOfBlocks; n++)
+    {
+        if (n % gaggleSize == 0)
+        {
+            if (reader.getNumberOfRemainingBits() < riceParameterBits)
+            {
+                return false;
+            }
+            k = static_cast<uint8_t>(reader.readBits(riceParameterBits));
+        }
+        uint32_t difference = 0;
+        if (!readRice(reader, difference, k))
+        {
+            return false;
+        }
+        previous = static_cast<int32_t>(
+                static_cast<uint32_t>(previous)
+                + static_cast<uint32_t>(outpost::VarInt::zigzagDecode(difference)));
+        data[(n / dcWidth) * width + n % dcWidth] = previous;
+    }
+
+    BitplaneReader coder(reader);
+    for (uint8_t plane = bitDepth; (plane > 0) && !coder.isDone(); plane--)
+    {
+        codeBitplane(coder, data, width, height, plane - 1);
+    }
+    return true;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMPRESSION_IMAGE_ENCODER_H_
+#define OUTPOST_COMPRESSION_IMAGE_ENCODER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+template <typename T>
+class Slice;
+
+namespace compression
+{
+/**
+ * Bit plane encoder for wavelet transformed images in the style of CCSDS 122.0.
+ *
+ * The coefficients of a three level ImageWavelet transform are grouped into blocks of 8x8
+ * coefficients, each consisting of one DC coefficient from the LL band and three families
+ * (HL, LH, HH) of one parent, four children and sixteen grandchildren. The DC coefficients are
+ * encoded first, as differences to their predecessor with a Rice code whose parameter is chosen
+ * for each gaggle of 16 blocks. Afterwards the AC coefficients are encoded bit plane by bit
+ * plane, starting with the most significant one:
+ *  - A significance pass signals for every block, family, set of descendants and set of
+ *    grandchildren whether it contains newly significant coefficients, followed by the
+ *    significance and sign of the individual coefficients of the significant sets.
+ *  - A refinement pass adds the current bit of all coefficients significant before.
+ *
+ * Unlike CCSDS 122.0 the decisions are written as plain bits, without the variable length
+ * coding of the words, and all blocks of a strip form one segment.
+ *
+ * As the bitstream is embedded, encoding stops when the buffer is full and the decoder
+ * reconstructs the coefficients with the precision reached until then. With a large enough
+ * buffer the encoding is lossless.
+ */
+class ImageBitplaneEncoder
+{
+public:
+    /// Number of decomposition levels of the transform the encoder expects
+    static constexpr uint8_t levels = 3;
+
+    /// Width and height of a block, the image dimensions must be multiples of it
+    static constexpr size_t blockSize = 8;
+
+    /// Number of DC coefficients sharing a Rice parameter
+    static constexpr size_t gaggleSize = 16;
+
+    /**
+     * Encodes the coefficients of a strip.
+     * @param coefficients Output of ImageWavelet::forwardTransform with three levels
+     * @param width Number of columns, a multiple of blockSize
+     * @param height Number of rows, a multiple of blockSize
+     * @param buffer Memory for the bitstream. Its length limits the size of the encoded data,
+     * the remaining bit planes are dropped.
+     * @return Returns the number of bytes written to buffer, 0 if the dimensions do not fit or
+     * not even the DC coefficients fit into buffer.
+     */
+    static size_t
+    encode(outpost::Slice<const int32_t> coefficients,
+           size_t width,
+           size_t height,
+           outpost::Slice<uint8_t> buffer);
+
+    /**
+     * Decodes a bitstream created by encode, also if it has been truncated.
+     * @param buffer Encoded data
+     * @param width Number of columns, as for encode
+     * @param height Number of rows, as for encode
+     * @param coefficients Buffer for width * height coefficients, input of
+     * ImageWavelet::backwardTransform
+     * @return Returns false if the dimensions do not fit or the DC coefficients are incomplete.
+     */
+    static bool
+    decode(outpost::Slice<const uint8_t> buffer,
+           size_t width,
+           size_t height,
+           outpost::Slice<int32_t> coefficients);
+
+private:
+    static bool
+    checkDimensions(size_t numberOfCoefficients, size_t width, size_t height);
+
+    ImageBitplaneEncoder() = delete;
+    ~ImageBitplaneEncoder() = delete;
+};
+
+}  // namespace compression
+}  // namespace outpost
+
+#endif /* OUTPOST_COMPRESSION_IMAGE_ENCODER_H_ */
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "image_strip.h"
+
+#include "image_encoder.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/utils/container/reference_queue.h>
+#include <outpost/utils/container/shared_object_pool.h>
+#include <outpost/utils/storage/serialize.h>
+
+#include <string.h>
+
+namespace outpost
+{
+namespace compression
+{
+constexpr size_t ImageStripHeader::size;
+
+bool
+ImageStripHeader::read(outpost::Slice<const uint8_t> data, ImageStripHeader& header)
+{
+    if (data.getNumberOfElements() < size)
+    {
+        return false;
+    }
+
+    outpost::Deserialize stream(data);
+    header.mImageId = stream.read<uint16_t>();
+    header.mStripIndex = stream.read<uint16_t>();
+    header.mWidth = stream.read<uint16_t>();
+    header.mHeight = stream.read<uint16_t>();
+    const uint8_t filter = stream.read<uint8_t>();
+    header.mFilter = static_cast<ImageFilter>(filter);
+    return filter <= static_cast<uint8_t>(ImageFilter::integer97);
+}
+
+ImageStrip::ImageStrip() :
+    mPointer(),
+    mImageId(0),
+    mStripIndex(0),
+    mWidth(0),
+    mHeight(0),
+    mLineCount(0),
+    mEncodedSize(0),
+    mIsEncoded(false)
+{
+}
+
+ImageStrip::ImageStrip(const outpost::utils::SharedBufferPointer& p,
+                       uint16_t imageId,
+                       uint16_t stripIndex,
+                       uint16_t width,
+                       uint16_t height) :
+    mPointer(p),
+    mImageId(imageId),
+    mStripIndex(stripIndex),
+    mWidth(width),
+    mHeight(height),
+    mLineCount(0),
+    mEncodedSize(0),
+    mIsEncoded(false)
+{
+}
+
+bool
+ImageStrip::isValid() const
+{
+    const size_t blockSize = ImageBitplaneEncoder::blockSize;
+    return mPointer.isValid() && (mWidth > 0) && (mHeight > 0) && (mWidth % blockSize == 0)
+           && (mHeight % blockSize == 0)
+           && (mPointer.getLength() >= static_cast<size_t>(mWidth) * mHeight * sizeof(int32_t));
+}
+
+outpost::Slice<int32_t>
+ImageStrip::getSamples() const
+{
+    return outpost::Slice<int32_t>::unsafe(reinterpret_cast<int32_t*>(&mPointer[0]),
+                                           static_cast<size_t>(mWidth) * mHeight);
+}
+
+bool
+ImageStrip::pushLine(outpost::Slice<const uint16_t> pixels)
+{
+    if (!isValid() || isEncoded() || mLineCount >= mHeight
+        || pixels.getNumberOfElements() != mWidth)
+    {
+        return false;
+    }
+
+    int32_t* line = &getSamples()[static_cast<size_t>(mLineCount) * mWidth];
+    for (size_t i = 0; i < mWidth; i++)
+    {
+        line[i] = pixels[i];
+    }
+    mLineCount++;
+    return true;
+}
+
+bool
+ImageStrip::fill()
+{
+    if (!isValid() || isEncoded() || mLineCount == 0)
+    {
+        return false;
+    }
+
+    outpost::Slice<int32_t> samples = getSamples();
+    const int32_t* last = &samples[static_cast<size_t>(mLineCount - 1) * mWidth];
+    for (; mLineCount < mHeight; mLineCount++)
+    {
+        memcpy(&samples[static_cast<size_t>(mLineCount) * mWidth], last, mWidth * sizeof(int32_t));
+    }
+    return true;
+}
+
+bool
+ImageStrip::encode(ImageStrip& target,
+                   ImageFilter filter,
+                   outpost::utils::Arena& scratch,
+                   size_t maximumSize)
+{
+    if (!isComplete() || isEncoded() || !target.mPointer.isValid())
+    {
+        return false;
+    }
+    outpost::Slice<uint8_t> buffer = target.mPointer.asSlice();
+    if (maximumSize > 0)
+    {
+        buffer = buffer.first(maximumSize);
+    }
+    if (buffer.getNumberOfElements() <= ImageStripHeader::size)
+    {
+        return false;
+    }
+
+    outpost::Slice<int32_t> samples = getSamples();
+    if (!ImageWavelet::forwardTransform(
+                samples, mWidth, mHeight, ImageBitplaneEncoder::levels, filter, scratch))
+    {
+        return false;
+    }
+    // The samples have been replaced by the coefficients
+    mLineCount = 0;
+
+    const size_t length = ImageBitplaneEncoder::encode(
+            samples, mWidth, mHeight, buffer.skipFirst(ImageStripHeader::size));
+    if (length == 0)
+    {
+        return false;
+    }
+
+    outpost::Serialize stream(buffer);
+    stream.store<uint16_t>(mImageId);
+    stream.store<uint16_t>(mStripIndex);
+    stream.store<uint16_t>(mWidth);
+    stream.store<uint16_t>(mHeight);
+    stream.store<uint8_t>(static_cast<uint8_t>(filter));
+
+    target.mImageId = mImageId;
+    target.mStripIndex = mStripIndex;
+    target.mWidth = mWidth;
+    target.mHeight = mHeight;
+    target.mLineCount = mHeight;
+    target.mEncodedSize = ImageStripHeader::size + length;
+    target.mIsEncoded = true;
+    return true;
+}
+
+outpost::Slice<const uint8_t>
+ImageStrip::getEncodedData() const
+{
+    if (!isEncoded())
+    {
+        return outpost::Slice<const uint8_t>::empty();
+    }
+    return outpost::Slice<const uint8_t>::unsafe(&mPointer[0], mEncodedSize);
+}
+
+bool
+ImageStrip::decode(outpost::Slice<const uint8_t> data,
+                   ImageStripHeader& header,
+                   outpost::Slice<int32_t> pixels,
+                   outpost::utils::Arena& scratch)
+{
+    if (!ImageStripHeader::read(data, header)
+        || pixels.getNumberOfElements() != static_cast<size_t>(header.mWidth) * header.mHeight)
+    {
+        return false;
+    }
+
+    return ImageBitplaneEncoder::decode(
+                   data.skipFirst(ImageStripHeader::size), header.mWidth, header.mHeight, pixels)
+           && ImageWavelet::backwardTransform(pixels,
+                                              header.mWidth,
+                                              header.mHeight,
+                                              ImageBitplaneEncoder::levels,
+                                              header.mFilter,
+                                              scratch);
+}
+
+ImageStripCollector::ImageStripCollector(
+        outpost::utils::SharedBufferPoolBase& pool,
+        outpost::utils::ReferenceQueueBase<ImageStrip>& outputQueue,
+        uint16_t width,
+        uint16_t stripHeight) :
+    mPool(pool),
+    mOutputQueue(outputQueue),
+    mWidth(width),
+    mStripHeight(stripHeight),
+    mStrip(),
+    mImageId(0),
+    mNextLine(0),
+    mNumSentStrips(0),
+    mNumLostLines(0)
+{
+}
+
+void
+ImageStripCollector::startImage(uint16_t imageId)
+{
+    mStrip = ImageStrip();
+    mImageId = imageId;
+    mNextLine = 0;
+}
+
+bool
+ImageStripCollector::pushLine(outpost::Slice<const uint16_t> pixels)
+{
+    if ((mStripHeight > 0) && (mNextLine % mStripHeight == 0))
+    {
+        // The strip index is taken from the line also for lost strips, so that the position of
+        // the following ones is kept
+        mStrip = ImageStrip();
+        outpost::utils::SharedBufferPointer p;
+        if (mPool.allocate(p))
+        {
+            mStrip = ImageStrip(p, mImageId, mNextLine / mStripHeight, mWidth, mStripHeight);
+        }
+    }
+    mNextLine++;
+
+    if (!mStrip.pushLine(pixels))
+    {
+        mNumLostLines++;
+        return false;
+    }
+    return !mStrip.isComplete() || send();
+}
+
+bool
+ImageStripCollector::finishImage()
+{
+    if (!mStrip.isValid() || !mStrip.fill())
+    {
+        mStrip = ImageStrip();
+        return true;
+    }
+    return send();
+}
+
+bool
+ImageStripCollector::send()
+{
+    const bool sent = mOutputQueue.send(mStrip);
+    if (sent)
+    {
+        mNumSentStrips++;
+    }
+    mStrip = ImageStrip();
+    return sent;
+}
+
+}  // namespace compression
+}  // namespace outpost
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMPRESSION_IMAGE_STRIP_H_
+#define OUTPOST_COMPRESSION_IMAGE_STRIP_H_
+
+#include "image_wavelet.h"
+
+#include <outpost/utils/container/shared_buffer.h>
+
+namespace outpost
+{
+namespace utils
+{
+template <typename T>
+class ReferenceQueueBase;
+
+class SharedBufferPoolBase;
+}  // namespace utils
+
+namespace compression
+{
+/**
+ * Header of an encoded ImageStrip.
+ */
+struct ImageStripHeader
+{
+    static constexpr size_t size = 9;
+
+    uint16_t mImageId;
+    uint16_t mStripIndex;
+    uint16_t mWidth;
+    uint16_t mHeight;
+    ImageFilter mFilter;
+
+    /**
+     * Reads the header from the beginning of an encoded strip.
+     * @return Returns false if data is too short or the filter is unknown.
+     */
+    static bool
+    read(outpost::Slice<const uint8_t> data, ImageStripHeader& header);
+};
+
+/**
+ * A horizontal strip of an image, the unit of the image compression.
+ *
+ * Strips are compressed independently of each other, so only a strip has to be held in memory
+ * and several strips can be compressed in parallel. The lines are collected in a
+ * SharedBuffer as 32 bit samples, which are transformed in place with a three level ImageWavelet
+ * transform and encoded by the ImageBitplaneEncoder.
+ *
+ * Layout of an encoded strip, all values big endian:
+ *
+ *     imageId (2) | stripIndex (2) | width (2) | height (2) | filter (1) | bitstream
+ */
+class ImageStrip
+{
+public:
+    ImageStrip();
+
+    /**
+     * Constructor for an empty strip.
+     * @param p Memory for width * height samples of 32 bit
+     * @param imageId Identification of the image the strip belongs to
+     * @param stripIndex Position of the strip in the image, counting from the top
+     * @param width Number of pixels per line, a multiple of ImageBitplaneEncoder::blockSize
+     * @param height Number of lines, a multiple of ImageBitplaneEncoder::blockSize
+     */
+    ImageStrip(const outpost::utils::SharedBufferPointer& p,
+               uint16_t imageId,
+               uint16_t stripIndex,
+               uint16_t width,
+               uint16_t height);
+
+    ~ImageStrip() = default;
+
+    inline uint16_t
+    getImageId() const
+    {
+        return mImageId;
+    }
+
+    inline uint16_t
+    getStripIndex() const
+    {
+        return mStripIndex;
+    }
+
+    inline uint16_t
+    getWidth() const
+    {
+        return mWidth;
+    }
+
+    inline uint16_t
+    getHeight() const
+    {
+        return mHeight;
+    }
+
+    /**
+     * Getter for the number of lines pushed so far
+     */
+    inline uint16_t
+    getLineCount() const
+    {
+        return mLineCount;
+    }
+
+    /**
+     * Getter for the strip's validity
+     * @return Returns true if the dimensions fit the encoder and the memory is large enough.
+     */
+    bool
+    isValid() const;
+
+    /**
+     * Getter for the strip's completeness
+     * @return Returns true if all lines have been pushed.
+     */
+    inline bool
+    isComplete() const
+    {
+        return isValid() && (mLineCount == mHeight);
+    }
+
+    inline bool
+    isEncoded() const
+    {
+        return mIsEncoded;
+    }
+
+    /**
+     * Appends a line of pixels.
+     * @param pixels Exactly getWidth() pixels
+     * @return Returns false if the strip is invalid, complete or encoded, or the line has the
+     * wrong length.
+     */
+    bool
+    pushLine(outpost::Slice<const uint16_t> pixels);
+
+    /**
+     * Completes the strip by repeating the last line, e.g. for the last strip of an image whose
+     * height is not a multiple of the strip height.
+     * @return Returns false if no line has been pushed yet.
+     */
+    bool
+    fill();
+
+    /**
+     * Transforms and encodes the strip into another one; the samples of this strip are
+     * overwritten by the coefficients.
+     * @param target Strip with the memory for the encoded data
+     * @param filter Wavelet filter to apply
+     * @param scratch Arena for ImageWavelet::getScratchSize() bytes
+     * @param maximumSize Maximum number of bytes of the encoded strip including its header,
+     * the lowest bit planes are dropped if necessary. 0 to use all memory of target.
+     * @return Returns false if the strip is not complete or could not be encoded.
+     */
+    bool
+    encode(ImageStrip& target,
+           ImageFilter filter,
+           outpost::utils::Arena& scratch,
+           size_t maximumSize = 0);
+
+    /**
+     * Getter for the encoded strip including its header.
+     * @return Returns an empty slice if the strip is not encoded.
+     */
+    outpost::Slice<const uint8_t>
+    getEncodedData() const;
+
+    /**
+     * Decodes an encoded strip, for ground use.
+     * @param data Encoded strip as returned by getEncodedData
+     * @param header Header of the strip
+     * @param pixels Buffer for header.mWidth * header.mHeight samples
+     * @param scratch Arena for ImageWavelet::getScratchSize() bytes
+     * @return Returns false if the data is not a valid strip or pixels has the wrong size.
+     */
+    static bool
+    decode(outpost::Slice<const uint8_t> data,
+           ImageStripHeader& header,
+           outpost::Slice<int32_t> pixels,
+           outpost::utils::Arena& scratch);
+
+private:
+    outpost::Slice<int32_t>
+    getSamples() const;
+
+    outpost::utils::SharedBufferPointer mPointer;
+    uint16_t mImageId;
+    uint16_t mStripIndex;
+    uint16_t mWidth;
+    uint16_t mHeight;
+    uint16_t mLineCount;
+    size_t mEncodedSize;
+    bool mIsEncoded;
+};
+
+/**
+ * Splits the lines of images into ImageStrips.
+ *
+ * The memory of each strip is allocated from a SharedBufferPool when its first line is pushed,
+ * complete strips are sent to a queue, e.g. the input queue of several
+ * ImageCompressionWorkers.
+ */
+class ImageStripCollector
+{
+public:
+    /**
+     * @param pool Pool for the memory of the strips
+     * @param outputQueue Queue for complete strips
+     * @param width Number of pixels per line
+     * @param stripHeight Number of lines per strip
+     */
+    ImageStripCollector(outpost::utils::SharedBufferPoolBase& pool,
+                        outpost::utils::ReferenceQueueBase<ImageStrip>& outputQueue,
+                        uint16_t width,
+                        uint16_t stripHeight);
+
+    /**
+     * Starts a new image. A strip of the previous image which has not been completed is
+     * dropped, see finishImage().
+     */
+    void
+    startImage(uint16_t imageId);
+
+    /**
+     * Appends the next line of the current image.
+     * @return Returns false if the line has been lost as no memory was available, the line has
+     * the wrong length or the strip could not be sent.
+     */
+    bool
+    pushLine(outpost::Slice<const uint16_t> pixels);
+
+    /**
+     * Sends the last strip of the current image, filled up with its last line.
+     * @return Returns false if the strip could not be sent, true if it has been sent or there
+     * was no strip in progress.
+     */
+    bool
+    finishImage();
+
+    inline uint16_t
+    getNumberOfSentStrips() const
+    {
+        return mNumSentStrips;
+    }
+
+    inline uint16_t
+    getNumberOfLostLines() const
+    {
+        return mNumLostLines;
+    }
+
+private:
+    bool
+    send();
+
+    outpost::utils::SharedBufferPoolBase& mPool;
+    outpost::utils::ReferenceQueueBase<ImageStrip>& mOutputQueue;
+    const uint16_t mWidth;
+    const uint16_t mStripHeight;
+
+    ImageStrip mStrip;
+    uint16_t mImageId;
+    // Line of the current image pushed next
+    uint16_t mNextLine;
+
+    uint16_t mNumSentStrips;
+    uint16_t mNumLostLines;
+};
+
+}  // namespace compression
+}  // namespace outpost
+
+#endif /* OUTPOST_COMPRESSION_IMAGE_STRIP_H_ */
@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "image_wavelet.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/utils/container/arena.h>
+
+#include <string.h>
+
+using outpost::compression::ImageFilter;
+using outpost::compression::ImageWavelet;
+
+constexpr uint8_t ImageWavelet::maximumLevels;
+
+namespace
+{
+/**
+ * Index of line k after whole-sample symmetric extension at both borders.
+ */
+inline size_t
+mirror(ptrdiff_t k, size_t length)
+{
+    const ptrdiff_t last = static_cast<ptrdiff_t>(length) - 1;
+    while (k < 0 || k > last)
+    {
+        k = (k < 0) ? -k : 2 * last - k;
+    }
+    return static_cast<size_t>(k);
+}
+
+inline int32_t*
+line(int32_t* data, ptrdiff_t k, size_t length, size_t stride)
+{
+    return data + mirror(k, length) * stride;
+}
+}  // namespace
+
+bool
+ImageWavelet::checkDimensions(outpost::Slice<int32_t> data,
+                              size_t width,
+                              size_t height,
+                              uint8_t levels)
+{
+    if (levels == 0 || levels > maximumLevels || width == 0 || height == 0)
+    {
+        return false;
+    }
+    const size_t mask = (static_cast<size_t>(1) << levels) - 1;
+    return ((width & mask) == 0) && ((height & mask) == 0)
+           && (data.getNumberOfElements() == width * height);
+}
+
+bool
+ImageWavelet::forwardTransform(outpost::Slice<int32_t> data,
+                               size_t width,
+                               size_t height,
+                               uint8_t levels,
+                               ImageFilter filter,
+                               outpost::utils::Arena& scratch)
+{
+    if (!checkDimensions(data, width, height, levels))
+    {
+        return false;
+    }
+
+    outpost::utils::ArenaScope scope(scratch);
+    outpost::Slice<int32_t> buffer = scratch.allocate<int32_t>((height / 2) * width);
+    if (buffer.getNumberOfElements() != (height / 2) * width)
+    {
+        return false;
+    }
+
+    for (uint8_t level = 0; level < levels; level++)
+    {
+        const size_t w = width >> level;
+        const size_t h = height >> level;
+        for (size_t row = 0; row < h; row++)
+        {
+            int32_t* r = &data[row * width];
+            lift(r, w, 1, 1, filter);
+            split(r, w, 1, 1, &buffer[0]);
+        }
+        lift(&data[0], h, width, w, filter);
+        split(&data[0], h, width, w, &buffer[0]);
+    }
+    return true;
+}
+
+bool
+ImageWavelet::backwardTransform(outpost::Slice<int32_t> data,
+                                size_t width,
+                                size_t height,
+                                uint8_t levels,
+                                ImageFilter filter,
+                                outpost::utils::Arena& scratch)
+{
+    if (!checkDimensions(data, width, height, levels))
+    {
+        return false;
+    }
+
+    outpost::utils::ArenaScope scope(scratch);
+    outpost::Slice<int32_t> buffer = scratch.allocate<int32_t>((height / 2) * width);
+    if (buffer.getNumberOfElements() != (height / 2) * width)
+    {
+        return false;
+    }
+
+    for (uint8_t level = levels; level > 0; level--)
+    {
+        const size_t w = width >> (level - 1);
+        const size_t h = height >> (level - 1);
+        merge(&data[0], h, width, w, &buffer[0]);
+        unlift(&data[0], h, width, w, filter);
+        for (size_t row = 0; row < h; row++)
+        {
+            int32_t* r = &data[row * width];
+            merge(r, w, 1, 1, &buffer[0]);
+            unlift(r, w, 1, 1, filter);
+        }
+    }
+    return true;
+}
+
+void
+ImageWavelet::lift(int32_t* data, size_t length, size_t stride, size_t width, ImageFilter filter)
+{
+    const ptrdiff_t half = static_cast<ptrdiff_t>(length / 2);
+    if (filter == ImageFilter::integer97)
+    {
+        // D_j = x_2j+1 - floor(9/16 (x_2j + x_2j+2) - 1/16 (x_2j-2 + x_2j+4) + 1/2)
+        for (ptrdiff_t j = 0; j < half; j++)
+        {
+            int32_t* d = line(data, 2 * j + 1, length, stride);
+            const int32_t* a = line(data, 2 * j, length, stride);
+            const int32_t* b = line(data, 2 * j + 2, length, stride);
+            const int32_t* a2 = line(data, 2 * j - 2, length, stride);
+            const int32_t* b2 = line(data, 2 * j + 4, length, stride);
+            for (size_t c = 0; c < width; c++)
+            {
+                d[c] -= (9 * (a[c] + b[c]) - (a2[c] + b2[c]) + 8) >> 4;
+            }
+        }
+        // C_j = x_2j - floor(-1/4 (D_j-1 + D_j) + 1/2)
+        for (ptrdiff_t j = 0; j < half; j++)
+        {
+            int32_t* s = line(data, 2 * j, length, stride);
+            const int32_t* dl = line(data, 2 * j - 1, length, stride);
+            const int32_t* dr = line(data, 2 * j + 1, length, stride);
+            for (size_t c = 0; c < width; c++)
+            {
+                s[c] -= (2 - (dl[c] + dr[c])) >> 2;
+            }
+        }
+    }
+    else
+    {
+        for (ptrdiff_t j = 0; j < half; j++)
+        {
+            int32_t* d = line(data, 2 * j + 1, length, stride);
+            const int32_t* a = line(data, 2 * j, length, stride);
+            const int32_t* b = line(data, 2 * j + 2, length, stride);
+            for (size_t c = 0; c < width; c++)
+            {
+                d[c] -= (a[c] + b[c]) >> 1;
+            }
+        }
+        for (ptrdiff_t j = 0; j < half; j++)
+        {
+            int32_t* s = line(data, 2 * j, length, stride);
+            const int32_t* dl = line(data, 2 * j - 1, length, stride);
+            const int32_t* dr = line(data, 2 * j + 1, length, stride);
+            for (size_t c = 0; c < width; c++)
+            {
+                s[c] += (dl[c] + dr[c] + 2) >> 2;
+            }
+        }
+    }
+}
+
+void
+ImageWavelet::unlift(int32_t* data, size_t length, size_t stride, size_t width, ImageFilter filter)
+{
+    const ptrdiff_t half = static_cast<ptrdiff_t>(length / 2);
+    if (filter == ImageFilter::integer97)
+    {
+        for (ptrdiff_t j = 0; j < half; j++)
+        {
+            int32_t* s = line(data, 2 * j, length, stride);
+            const int32_t* dl = line(data, 2 * j - 1, length, stride);
+            const int32_t* dr = line(data, 2 * j + 1, length, stride);
+            for (size_t c = 0; c < width; c++)
+            {
+                s[c] += (2 - (dl[c] + dr[c])) >> 2;
+            }
+        }
+        for (ptrdiff_t j = 0; j < half; j++)
+        {
+            int32_t* d = line(data, 2 * j + 1, length, stride);
+            const int32_t* a = line(data, 2 * j, length, stride);
+            const int32_t* b = line(data, 2 * j + 2, length, stride);
+            const int32_t* a2 = line(data, 2 * j - 2, length, stride);
+            const int32_t* b2 = line(data, 2 * j + 4, length, stride);
+            for (size_t c = 0; c < width; c++)
+            {
+                d[c] += (9 * (a[c] + b[c]) - (a2[c] + b2[c]) + 8) >> 4;
+            }
+        }
+    }
+    else
+    {
+        for (ptrdiff_t j = 0; j < half; j++)
+        {
+            int32_t* s = line(data, 2 * j, length, stride);
+            const int32_t* dl = line(data, 2 * j - 1, length, stride);
+            const int32_t* dr = line(data, 2 * j + 1, length, stride);
+            for (size_t c = 0; c < width; c++)
+            {
+                s[c] -= (dl[c] + dr[c] + 2) >> 2;
+            }
+        }
+        for (ptrdiff_t j = 0; j < half; j++)
+        {
+            int32_t* d = line(data, 2 * j + 1, length, stride);
+            const int32_t* a = line(data, 2 * j, length, stride);
+            const int32_t* b = line(data, 2 * j + 2, length, stride);
+            for (size_t c = 0; c < width; c++)
+            {
+                d[c] += (a[c] + b[c]) >> 1;
+            }
+        }
+    }
+}
+
+void
+ImageWavelet::split(int32_t* data, size_t length, size_t stride, size_t width, int32_t* buffer)
+{
+    const size_t half = length / 2;
+    const size_t bytes = width * sizeof(int32_t);
+    for (size_t j = 0; j < half; j++)
+    {
+        memcpy(&buffer[j * width], &data[(2 * j + 1) * stride], bytes);
+    }
+    for (size_t j = 1; j < half; j++)
+    {
+        memcpy(&data[j * stride], &data[2 * j * stride], bytes);
+    }
+    for (size_t j = 0; j < half; j++)
+    {
+        memcpy(&data[(half + j) * stride], &buffer[j * width], bytes);
+    }
+}
+
+void
+ImageWavelet::merge(int32_t* data, size_t length, size_t stride, size_t width, int32_t* buffer)
+{
+    const size_t half = length / 2;
+    const size_t bytes = width * sizeof(int32_t);
+    for (size_t j = 0; j < half; j++)
+    {
+        memcpy(&buffer[j * width], &data[(half + j) * stride], bytes);
+    }
+    for (size_t j = half - 1; j > 0; j--)
+    {
+        memcpy(&data[2 * j * stride], &data[j * stride], bytes);
+    }
+    for (size_t j = 0; j < half; j++)
+    {
+        memcpy(&data[(2 * j + 1) * stride], &buffer[j * width], bytes);
+    }
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMPRESSION_IMAGE_WAVELET_H_
+#define OUTPOST_COMPRESSION_IMAGE_WAVELET_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+template <typename T>
+class Slice;
+
+namespace utils
+{
+class Arena;
+}
+
+namespace compression
+{
+/**
+ * Filters of the two dimensional wavelet transform, both reversible.
+ */
+enum class ImageFilter : uint8_t
+{
+    integer53 = 0,  // Integer Le Gall 5/3 wavelet, as LeGall53Wavelet
+    integer97 = 1   // Integer 9/7M wavelet of CCSDS 122.0
+};
+
+/**
+ * Two dimensional integer wavelet transform of images or image strips.
+ *
+ * Each level transforms the rows and then the columns of the current lowpass (LL) region with
+ * integer lifting steps. The subbands are stored in the usual pyramid layout, i.e. the LL band
+ * of the coarsest level at the top left, followed by the HL (right), LH (below) and HH bands.
+ * The image borders are extended symmetrically, so that a strip taken from a larger image can be
+ * transformed on its own and only strips have to be held in memory.
+ *
+ * The columns are transformed a whole row at a time, all lifting steps access the memory
+ * sequentially.
+ *
+ * For the CCSDS 122.0 recommendation, see:
+ * https://public.ccsds.org/Pubs/122x0b2.pdf
+ */
+class ImageWavelet
+{
+public:
+    /// Maximum number of decomposition levels
+    static constexpr uint8_t maximumLevels = 6;
+
+    /**
+     * Getter for the scratch memory of the transforms.
+     * @param width Number of columns
+     * @param height Number of rows
+     * @return Returns the number of bytes required from the arena.
+     */
+    static constexpr size_t
+    getScratchSize(size_t width, size_t height)
+    {
+        // Highpass half of the columns, more than the highpass half of a row
+        return (height / 2) * width * sizeof(int32_t);
+    }
+
+    /**
+     * Forward transformation in place.
+     * @param data
+     *     Samples of height rows of width values each, replaced by the coefficients.
+     * @param width
+     *     Number of columns, has to be a multiple of 2^levels.
+     * @param height
+     *     Number of rows, has to be a multiple of 2^levels.
+     * @param levels
+     *     Number of decomposition levels, between 1 and maximumLevels
+     * @param filter
+     *     Filter to apply
+     * @param scratch
+     *     Arena for getScratchSize() bytes, they are released again before returning.
+     * @return
+     *     False if the dimensions do not fit or the arena has not enough memory left, data is
+     *     unchanged in that case.
+     */
+    static bool
+    forwardTransform(outpost::Slice<int32_t> data,
+                     size_t width,
+                     size_t height,
+                     uint8_t levels,
+                     ImageFilter filter,
+                     outpost::utils::Arena& scratch);
+
+    /**
+     * Inverse of forwardTransform, reconstructs the samples exactly.
+     * @see forwardTransform
+     */
+    static bool
+    backwardTransform(outpost::Slice<int32_t> data,
+                      size_t width,
+                      size_t height,
+                      uint8_t levels,
+                      ImageFilter filter,
+                      outpost::utils::Arena& scratch);
+
+private:
+    static bool
+    checkDimensions(outpost::Slice<int32_t> data, size_t width, size_t height, uint8_t levels);
+
+    /**
+     * One dimensional lifting steps along length lines of width values each.
+     * Consecutive lines are stride values apart, the values of a line are contiguous. The
+     * lowpass coefficients are stored at the even and the highpass coefficients at the odd lines.
+     */
+    static void
+    lift(int32_t* data, size_t length, size_t stride, size_t width, ImageFilter filter);
+
+    /**
+     * Inverse of lift.
+     */
+    static void
+    unlift(int32_t* data, size_t length, size_t stride, size_t width, ImageFilter filter);
+
+    /**
+     * Moves the even lines to the first and the odd lines to the second half.
+     * @param buffer Memory for length / 2 lines
+     */
+    static void
+    split(int32_t* data, size_t length, size_t stride, size_t width, int32_t* buffer);
+
+    /**
+     * Inverse of split.
+     */
+    static void
+    merge(int32_t* data, size_t length, size_t stride, size_t width, int32_t* buffer);
+
+    ImageWavelet() = delete;
+    ~ImageWavelet() = delete;
+};
+
+}  // namespace compression
+}  // namespace outpost
+
+#endif /* OUTPOST_COMPRESSION_IMAGE_WAVELET_H_ */
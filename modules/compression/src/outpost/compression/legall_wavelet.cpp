@@ -15,6 +15,7 @@
 
 #include <outpost/base/fixpoint.h>
 #include <outpost/base/slice.h>
+#include <outpost/utils/container/arena.h>
 #include <outpost/utils/log2.h>
 
 #include <string.h>
@@ -68,26 +69,44 @@ LeGall53Wavelet::forwardTransform(outpost::Slice<Fixpoint> inBuffer,
         outBuffer = tmp;
     }
 
-    // With coefficients of different levels spread through both buffers, these need to be copied to
-    // outBuffer
-    size_t steps = step;
-    if (step % 2)
+    collectCoefficients(inBuffer, outBuffer, step);
+}
+
+outpost::Slice<Fixpoint>
+LeGall53Wavelet::forwardTransform(outpost::Slice<Fixpoint> inBuffer,
+                                  outpost::utils::Arena& scratch)
+{
+    outpost::Slice<Fixpoint> outBuffer =
+            scratch.allocate<Fixpoint>(inBuffer.getNumberOfElements());
+    if (outBuffer.getNumberOfElements() == inBuffer.getNumberOfElements())
     {
+        forwardTransform(inBuffer, outBuffer);
+    }
+    return outBuffer;
+}
+
+void
+LeGall53Wavelet::forwardTransformLifting(outpost::Slice<Fixpoint> inBuffer,
+                                         outpost::Slice<Fixpoint> outBuffer)
+{
+    static_assert(sizeof(Fixpoint) == sizeof(int32_t), "Fixpoint must be a plain int32_t");
+
+    size_t halfBufferLength = inBuffer.getNumberOfElements();
+
+    size_t step;
+    for (step = 0; halfBufferLength > 2; step++)
+    {
+        halfBufferLength = halfBufferLength >> 1;
+        liftingPass(reinterpret_cast<const int32_t*>(inBuffer.begin()),
+                    reinterpret_cast<int32_t*>(outBuffer.begin()),
+                    halfBufferLength);
+
         outpost::Slice<Fixpoint> tmp = inBuffer;
         inBuffer = outBuffer;
         outBuffer = tmp;
-        step = 2;
-    }
-    else
-    {
-        step = 1;
-        memcpy(&outBuffer[0], &inBuffer[0], 16);
     }
 
-    for (; step < steps; step += 2)
-    {
-        memcpy(&outBuffer[1 << step], &inBuffer[1 << step], (1 << (step + 2)));
-    }
+    collectCoefficients(inBuffer, outBuffer, step);
 }
 
 void
@@ -134,6 +153,229 @@ LeGall53Wavelet::forwardTransformInPlace(outpost::Slice<Fixpoint> inBuffer)
     }
 }
 
+void
+LeGall53Wavelet::liftingPass(const int32_t* in, int32_t* out, size_t halfBufferLength)
+{
+    int32_t* high = out + halfBufferLength;
+
+    // Predict: highpass coefficient at the odd positions
+    for (size_t i = 0; i < halfBufferLength - 1; i++)
+    {
+        high[i] = in[2 * i + 1] - ((in[2 * i] + in[2 * i + 2]) >> 1);
+    }
+    high[halfBufferLength - 1] =
+            in[2 * halfBufferLength - 1] - ((in[2 * halfBufferLength - 2] + in[0]) >> 1);
+
+    // Update: lowpass coefficient at the following even position
+    for (size_t i = 0; i < halfBufferLength - 1; i++)
+    {
+        out[i] = in[2 * i + 2] + ((high[i] + high[i + 1]) >> 2);
+    }
+    out[halfBufferLength - 1] = in[0] + ((high[halfBufferLength - 1] + high[0]) >> 2);
+}
+
+void
+LeGall53Wavelet::liftingPassInPlace(int32_t* data, size_t halfBufferLength)
+{
+    const size_t length = 2 * halfBufferLength;
+    const int32_t first = data[0];
+
+    // Predict: highpass coefficients replace the odd values
+    for (size_t i = 0; i < halfBufferLength - 1; i++)
+    {
+        data[2 * i + 1] -= (data[2 * i] + data[2 * i + 2]) >> 1;
+    }
+    data[length - 1] -= (data[length - 2] + first) >> 1;
+
+    // Update: the lowpass coefficient centered at 2 * i + 2 is stored at 2 * i, the even value
+    // at 2 * i has already been used by the previous coefficient.
+    for (size_t i = 0; i < halfBufferLength - 1; i++)
+    {
+        data[2 * i] = data[2 * i + 2] + ((data[2 * i + 1] + data[2 * i + 3]) >> 2);
+    }
+    data[length - 2] = first + ((data[length - 1] + data[1]) >> 2);
+}
+
+void
+LeGall53Wavelet::deinterleave(int32_t* data, size_t pairs)
+{
+    int32_t scratch[deinterleaveBlockPairs];
+
+    // Split small blocks using the scratch area
+    const size_t blockPairs = (pairs < deinterleaveBlockPairs) ? pairs : deinterleaveBlockPairs;
+    for (int32_t* block = data; block < data + 2 * pairs; block += 2 * blockPairs)
+    {
+        for (size_t i = 0; i < blockPairs; i++)
+        {
+            scratch[i] = block[2 * i + 1];
+            block[i] = block[2 * i];
+        }
+        memcpy(&block[blockPairs], scratch, blockPairs * sizeof(int32_t));
+    }
+
+    // Merge neighboring blocks [L1 H1 L2 H2] to [L1 L2 H1 H2] by swapping the equally sized
+    // inner parts
+    for (size_t size = blockPairs; size < pairs; size <<= 1)
+    {
+        for (int32_t* block = data; block < data + 2 * pairs; block += 4 * size)
+        {
+            for (size_t i = 0; i < size; i++)
+            {
+                int32_t tmp = block[size + i];
+                block[size + i] = block[2 * size + i];
+                block[2 * size + i] = tmp;
+            }
+        }
+    }
+}
+
+void
+LeGall53Wavelet::collectCoefficients(outpost::Slice<Fixpoint> inBuffer,
+                                     outpost::Slice<Fixpoint> outBuffer,
+                                     size_t steps)
+{
+    // With coefficients of different levels spread through both buffers, these need to be copied to
+    // outBuffer
+    size_t step;
+    if (steps % 2)
+    {
+        outpost::Slice<Fixpoint> tmp = inBuffer;
+        inBuffer = outBuffer;
+        outBuffer = tmp;
+        step = 2;
+    }
+    else
+    {
+        step = 1;
+        memcpy(&outBuffer[0], &inBuffer[0], 16);
+    }
+
+    for (; step < steps; step += 2)
+    {
+        memcpy(&outBuffer[1 << step], &inBuffer[1 << step], (1 << (step + 2)));
+    }
+}
+
+outpost::Slice<int16_t>
+LeGall53Wavelet::forwardTransformInPlaceOrdered(outpost::Slice<Fixpoint> inBuffer)
+{
+    static_assert(sizeof(Fixpoint) == sizeof(int32_t), "Fixpoint must be a plain int32_t");
+
+    int32_t* data = reinterpret_cast<int32_t*>(inBuffer.begin());
+
+    // Each pass leaves the lowpass coefficients contiguous at the beginning so that the next
+    // pass works on the first half only.
+    for (size_t length = inBuffer.getNumberOfElements(); length > 2; length >>= 1)
+    {
+        liftingPassInPlace(data, length >> 1);
+        deinterleave(data, length >> 1);
+    }
+
+    // The coefficients are now ordered like the output of forwardTransform. Narrowing them
+    // front to back only overwrites values which have already been read.
+    int16_t* outputBuffer = reinterpret_cast<int16_t*>(inBuffer.begin());
+    for (size_t i = 0; i < inBuffer.getNumberOfElements(); i++)
+    {
+        outputBuffer[i] = static_cast<int16_t>(inBuffer[i]);
+    }
+
+    return outpost::Slice<int16_t>::unsafe(outputBuffer, inBuffer.getNumberOfElements());
+}
+
+bool
+LeGall53Wavelet::forwardTransformInterleaved(outpost::Slice<Fixpoint> data,
+                                             size_t channels,
+                                             outpost::utils::Arena& scratch)
+{
+    const size_t numberOfElements = data.getNumberOfElements();
+    if (channels == 0 || numberOfElements % channels != 0)
+    {
+        return false;
+    }
+    const size_t length = numberOfElements / channels;
+    if (length == 0 || (length & (length - 1)) != 0)
+    {
+        return false;
+    }
+
+    outpost::utils::ArenaScope scope(scratch);
+    outpost::Slice<int32_t> temporary = scratch.allocate<int32_t>(numberOfElements / 2 + channels);
+    if (temporary.getNumberOfElements() == 0)
+    {
+        return false;
+    }
+
+    int32_t* rows = reinterpret_cast<int32_t*>(data.begin());
+    for (size_t l = length; l > 2; l >>= 1)
+    {
+        liftingPassInterleaved(rows, l >> 1, channels, &temporary[0]);
+        deinterleaveRows(rows, l >> 1, channels, &temporary[channels]);
+    }
+    return true;
+}
+
+void
+LeGall53Wavelet::liftingPassInterleaved(int32_t* data,
+                                        size_t halfBufferLength,
+                                        size_t channels,
+                                        int32_t* first)
+{
+    const size_t length = 2 * halfBufferLength;
+    int32_t* const last = data + (length - 1) * channels;
+    int32_t* const secondLast = data + (length - 2) * channels;
+    memcpy(first, data, channels * sizeof(int32_t));
+
+    // Predict
+    for (size_t i = 0; i < halfBufferLength - 1; i++)
+    {
+        const int32_t* even = data + 2 * i * channels;
+        const int32_t* nextEven = even + 2 * channels;
+        int32_t* odd = data + (2 * i + 1) * channels;
+        for (size_t c = 0; c < channels; c++)
+        {
+            odd[c] -= (even[c] + nextEven[c]) >> 1;
+        }
+    }
+    for (size_t c = 0; c < channels; c++)
+    {
+        last[c] -= (secondLast[c] + first[c]) >> 1;
+    }
+
+    // Update
+    for (size_t i = 0; i < halfBufferLength - 1; i++)
+    {
+        int32_t* even = data + 2 * i * channels;
+        const int32_t* nextEven = even + 2 * channels;
+        const int32_t* odd = even + channels;
+        const int32_t* nextOdd = odd + 2 * channels;
+        for (size_t c = 0; c < channels; c++)
+        {
+            even[c] = nextEven[c] + ((odd[c] + nextOdd[c]) >> 2);
+        }
+    }
+    const int32_t* second = data + channels;
+    for (size_t c = 0; c < channels; c++)
+    {
+        secondLast[c] = first[c] + ((last[c] + second[c]) >> 2);
+    }
+}
+
+void
+LeGall53Wavelet::deinterleaveRows(int32_t* data, size_t pairs, size_t channels, int32_t* scratch)
+{
+    const size_t rowSize = channels * sizeof(int32_t);
+    for (size_t i = 0; i < pairs; i++)
+    {
+        memcpy(&scratch[i * channels], &data[(2 * i + 1) * channels], rowSize);
+    }
+    // Only rows in front of row 2 * i have been overwritten so far
+    for (size_t i = 1; i < pairs; i++)
+    {
+        memcpy(&data[i * channels], &data[2 * i * channels], rowSize);
+    }
+    memcpy(&data[pairs * channels], scratch, pairs * rowSize);
+}
+
 outpost::Slice<int16_t>
 LeGall53Wavelet::reorder(outpost::Slice<Fixpoint> inBuffer)
 {
@@ -196,21 +438,106 @@ LeGall53Wavelet::backwardTransform(outpost::Slice<double> inBuffer,
     }
 }
 
-const Fixpoint LeGall53Wavelet::h0 = -0.125;
-const Fixpoint LeGall53Wavelet::h1 = 0.25;
-const Fixpoint LeGall53Wavelet::h2 = 0.75;
-const Fixpoint LeGall53Wavelet::h3 = 0.25;
-const Fixpoint LeGall53Wavelet::h4 = -0.125;
+outpost::Slice<Fixpoint>
+LeGall53Wavelet::backwardTransformInPlaceOrdered(outpost::Slice<const int16_t> coefficients,
+                                                 outpost::Slice<Fixpoint> outBuffer)
+{
+    static_assert(sizeof(Fixpoint) == sizeof(int32_t), "Fixpoint must be a plain int32_t");
+
+    const size_t length = coefficients.getNumberOfElements();
+    if (length < 4 || (length & (length - 1)) != 0 || outBuffer.getNumberOfElements() != length)
+    {
+        return outpost::Slice<Fixpoint>::empty();
+    }
+
+    // Widening back to front only overwrites coefficients which have already been read, if
+    // both share the same memory.
+    int32_t* data = reinterpret_cast<int32_t*>(outBuffer.begin());
+    for (size_t i = length; i > 0; i--)
+    {
+        data[i - 1] = Fixpoint(coefficients[i - 1]).getValue();
+    }
+
+    for (size_t pairs = 2; pairs < length; pairs <<= 1)
+    {
+        interleave(data, pairs);
+        inverseLiftingPassInPlace(data, pairs);
+    }
+
+    return outBuffer;
+}
+
+void
+LeGall53Wavelet::interleave(int32_t* data, size_t pairs)
+{
+    int32_t scratch[deinterleaveBlockPairs];
+    const size_t blockPairs = (pairs < deinterleaveBlockPairs) ? pairs : deinterleaveBlockPairs;
+
+    // Undo the merging of deinterleave from the largest blocks down, swapping is its own inverse
+    for (size_t size = pairs >> 1; size >= blockPairs; size >>= 1)
+    {
+        for (int32_t* block = data; block < data + 2 * pairs; block += 4 * size)
+        {
+            for (size_t i = 0; i < size; i++)
+            {
+                int32_t tmp = block[size + i];
+                block[size + i] = block[2 * size + i];
+                block[2 * size + i] = tmp;
+            }
+        }
+    }
+
+    // Back to front, every value is moved to a position which has already been read
+    for (int32_t* block = data; block < data + 2 * pairs; block += 2 * blockPairs)
+    {
+        memcpy(scratch, &block[blockPairs], blockPairs * sizeof(int32_t));
+        for (size_t i = blockPairs; i > 0; i--)
+        {
+            block[2 * i - 2] = block[i - 1];
+            block[2 * i - 1] = scratch[i - 1];
+        }
+    }
+}
+
+void
+LeGall53Wavelet::inverseLiftingPassInPlace(int32_t* data, size_t halfBufferLength)
+{
+    const size_t length = 2 * halfBufferLength;
+    const int32_t last = data[length - 2];
+
+    // Undo update back to front: the even value at 2 * i replaces the lowpass coefficient stored
+    // there, which has been read by the previous iteration.
+    for (size_t i = halfBufferLength - 1; i > 0; i--)
+    {
+        data[2 * i] = data[2 * i - 2] - ((data[2 * i - 1] + data[2 * i + 1]) >> 2);
+    }
+    data[0] = last - ((data[length - 1] + data[1]) >> 2);
+
+    // Undo predict
+    for (size_t i = 0; i < halfBufferLength - 1; i++)
+    {
+        data[2 * i + 1] += (data[2 * i] + data[2 * i + 2]) >> 1;
+    }
+    data[length - 1] += (data[length - 2] + data[0]) >> 1;
+}
+
+constexpr size_t LeGall53Wavelet::deinterleaveBlockPairs;
+
+constexpr Fixpoint LeGall53Wavelet::h0;
+constexpr Fixpoint LeGall53Wavelet::h1;
+constexpr Fixpoint LeGall53Wavelet::h2;
+constexpr Fixpoint LeGall53Wavelet::h3;
+constexpr Fixpoint LeGall53Wavelet::h4;
 
-const Fixpoint LeGall53Wavelet::g0 = -0.5;
-const Fixpoint LeGall53Wavelet::g1 = 1.0;
-const Fixpoint LeGall53Wavelet::g2 = -0.5;
+constexpr Fixpoint LeGall53Wavelet::g0;
+constexpr Fixpoint LeGall53Wavelet::g1;
+constexpr Fixpoint LeGall53Wavelet::g2;
 
-const Fixpoint LeGall53Wavelet::ip_g0 = 4.0;
-const Fixpoint LeGall53Wavelet::ip_g1 = 0.0;
-const Fixpoint LeGall53Wavelet::ip_g2 = -3.5;
-const Fixpoint LeGall53Wavelet::ip_g3 = -1.0;
-const Fixpoint LeGall53Wavelet::ip_g4 = 0.5;
+constexpr Fixpoint LeGall53Wavelet::ip_g0;
+constexpr Fixpoint LeGall53Wavelet::ip_g1;
+constexpr Fixpoint LeGall53Wavelet::ip_g2;
+constexpr Fixpoint LeGall53Wavelet::ip_g3;
+constexpr Fixpoint LeGall53Wavelet::ip_g4;
 
 const double LeGall53Wavelet::ih0 = -0.25;
 const double LeGall53Wavelet::ih1 = 1.0;
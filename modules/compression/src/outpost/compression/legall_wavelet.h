@@ -14,6 +14,8 @@
 #ifndef OUTPOST_UTILS_COMPRESSION_LEGALL_WAVELET_H
 #define OUTPOST_UTILS_COMPRESSION_LEGALL_WAVELET_H
 
+#include <outpost/base/fixpoint.h>
+
 #include <stddef.h>
 #include <stdint.h>
 
@@ -22,9 +24,10 @@ namespace outpost
 template <typename T>
 class Slice;
 
-template <unsigned PREC>
-class FP;
-typedef FP<16> Fixpoint;
+namespace utils
+{
+class Arena;
+}
 
 namespace compression
 {
@@ -56,6 +59,38 @@ public:
     static void
     forwardTransform(outpost::Slice<Fixpoint> inBuffer, outpost::Slice<Fixpoint> outBuffer);
 
+    /**
+     * Forward transformation taking the output buffer from scratch memory.
+     * @param inBuffer
+     *     Pointer to an array of Fixpoint that shall be transformed to wavelet coefficients.
+     *     WARNING: The array will also be used as a temporary buffer, its contents are subject to
+     * change!
+     * @param scratch
+     *     Arena from which the output buffer is allocated.
+     * @return
+     *     Resulting coefficients, valid until the arena is reset, or an empty slice if the arena
+     *     has not enough memory left.
+     */
+    static outpost::Slice<Fixpoint>
+    forwardTransform(outpost::Slice<Fixpoint> inBuffer, outpost::utils::Arena& scratch);
+
+    /**
+     * Integer lifting implementation of forwardTransform.
+     * Computes the same decomposition with one predict and one update step per level, using only
+     * additions and arithmetic shifts on the raw fixpoint values. The passes work on contiguous
+     * arrays and can be auto-vectorized by the compiler. As the products are not truncated one by
+     * one, the result may differ from forwardTransform in the least significant fixpoint bit.
+     * @param inBuffer
+     *     Pointer to an array of Fixpoint that shall be transformed to wavelet coefficients.
+     *     WARNING: The array will also be used as a temporary buffer, its contents are subject to
+     * change!
+     * @param outBuffer
+     *     Pointer to store the resulting transformed data. Needs to be able to store bufferLength
+     * elements.
+     */
+    static void
+    forwardTransformLifting(outpost::Slice<Fixpoint> inBuffer, outpost::Slice<Fixpoint> outBuffer);
+
     /**
      * Memory-optimized forward transformation requiring only one buffer.
      * Coefficients are stored according to the lifting-scheme (i.e. interleaving high- and lowpass
@@ -68,6 +103,42 @@ public:
     static void
     forwardTransformInPlace(outpost::Slice<Fixpoint> inBuffer);
 
+    /**
+     * Cache-friendly in place forward transformation.
+     * Uses the integer lifting scheme of forwardTransformLifting and splits each level into
+     * contiguous lowpass and highpass halves right away, with a small scratch area on the stack.
+     * Thereby all passes access the buffer sequentially and no call to reorder is required.
+     * @param inBuffer
+     *     Pointer to an array of Fixpoint that shall be transformed to wavelet coefficients. Its
+     *     length has to be a power of two.
+     * @return
+     *     Rounded coefficients ordered for NLS encoding, stored at the beginning of inBuffer.
+     */
+    static outpost::Slice<int16_t>
+    forwardTransformInPlaceOrdered(outpost::Slice<Fixpoint> inBuffer);
+
+    /**
+     * forwardTransformInPlaceOrdered for several channels of the same length at once.
+     * The channels are interleaved, sample i of channel c is stored at i * channels + c. Each
+     * lifting step then runs once over all channels of a row, which the compiler can vectorize,
+     * and the overhead of short blocks is shared by all channels. The result of every channel
+     * equals the result of forwardTransformInPlaceOrdered.
+     * @param data
+     *     Interleaved samples, the length of a channel has to be a power of two. Replaced by the
+     *     interleaved coefficients ordered for NLS encoding, still in Fixpoint format.
+     * @param channels
+     *     Number of channels
+     * @param scratch
+     *     Arena for data.getNumberOfElements() / 2 + channels temporary values.
+     * @return
+     *     False if the lengths do not fit or the arena has not enough memory left, data is
+     *     unchanged in that case.
+     */
+    static bool
+    forwardTransformInterleaved(outpost::Slice<Fixpoint> data,
+                                size_t channels,
+                                outpost::utils::Arena& scratch);
+
     /**
      * Reorders the coefficients after in place transformation for further coding by using the bits
      * after the comma.
@@ -89,25 +160,108 @@ public:
     static void
     backwardTransform(outpost::Slice<double> inBuffer, outpost::Slice<double> outBuffer);
 
+    /**
+     * Fixpoint backward transformation, the inverse of forwardTransformInPlaceOrdered.
+     * Undoes the integer lifting steps level by level in place, starting with the coarsest one.
+     * Apart from the rounding of the coefficients to int16_t the lifting steps are inverted
+     * exactly.
+     * @param coefficients
+     *     Coefficients in the order of forwardTransformInPlaceOrdered. They may be stored at the
+     *     beginning of the memory of outBuffer, as left by the forward transform.
+     * @param outBuffer
+     *     Buffer for the reconstructed samples, must have the same length as coefficients.
+     * @return
+     *     Reconstructed samples or an empty slice if the length is not a power of two or the
+     *     buffers do not match.
+     */
+    static outpost::Slice<Fixpoint>
+    backwardTransformInPlaceOrdered(outpost::Slice<const int16_t> coefficients,
+                                    outpost::Slice<Fixpoint> outBuffer);
+
 private:
+    /**
+     * Single decomposition level of forwardTransformLifting.
+     * Reads 2 * halfBufferLength values from in and writes the lowpass coefficients followed by
+     * the highpass coefficients to out.
+     */
+    static void
+    liftingPass(const int32_t* in, int32_t* out, size_t halfBufferLength);
+
+    /**
+     * Single decomposition level of forwardTransformInPlaceOrdered.
+     * Stores the lowpass coefficients at the even and the highpass coefficients at the odd
+     * positions of data.
+     */
+    static void
+    liftingPassInPlace(int32_t* data, size_t halfBufferLength);
+
+    /**
+     * Moves the values at the even positions to the first and the values at the odd positions
+     * to the second half of data, keeping their order.
+     * @param pairs Number of even/odd pairs, has to be a power of two
+     */
+    static void
+    deinterleave(int32_t* data, size_t pairs);
+
+    /**
+     * Single decomposition level of forwardTransformInterleaved, liftingPassInPlace applied to
+     * rows of channels values.
+     * @param first Memory for a copy of the first row
+     */
+    static void
+    liftingPassInterleaved(int32_t* data, size_t halfBufferLength, size_t channels, int32_t* first);
+
+    /**
+     * Moves the even rows to the first and the odd rows to the second half of data.
+     * @param scratch Memory for pairs rows
+     */
+    static void
+    deinterleaveRows(int32_t* data, size_t pairs, size_t channels, int32_t* scratch);
+
+    // Number of pairs split with the scratch area before blocks are merged by swapping
+    static constexpr size_t deinterleaveBlockPairs = 16;
+
+    /**
+     * Inverse of deinterleave, moves the first half of data to the even and the second half to
+     * the odd positions.
+     */
+    static void
+    interleave(int32_t* data, size_t pairs);
+
+    /**
+     * Inverse of liftingPassInPlace.
+     */
+    static void
+    inverseLiftingPassInPlace(int32_t* data, size_t halfBufferLength);
+
+    /**
+     * Copies the coefficients of the levels which have been stored in inBuffer to outBuffer.
+     * @param inBuffer Buffer written by the last pass
+     * @param steps Number of passes
+     */
+    static void
+    collectCoefficients(outpost::Slice<Fixpoint> inBuffer,
+                        outpost::Slice<Fixpoint> outBuffer,
+                        size_t steps);
+
     // Forward lowpass coefficients
-    static const Fixpoint h0;
-    static const Fixpoint h1;
-    static const Fixpoint h2;
-    static const Fixpoint h3;
-    static const Fixpoint h4;
+    static constexpr Fixpoint h0 = -0.125;
+    static constexpr Fixpoint h1 = 0.25;
+    static constexpr Fixpoint h2 = 0.75;
+    static constexpr Fixpoint h3 = 0.25;
+    static constexpr Fixpoint h4 = -0.125;
 
     // Forward highpass coefficients
-    static const Fixpoint g0;
-    static const Fixpoint g1;
-    static const Fixpoint g2;
+    static constexpr Fixpoint g0 = -0.5;
+    static constexpr Fixpoint g1 = 1.0;
+    static constexpr Fixpoint g2 = -0.5;
 
     // Forward highpass coefficients for in place calculations using the lifting scheme
-    static const Fixpoint ip_g0;
-    static const Fixpoint ip_g1;
-    static const Fixpoint ip_g2;
-    static const Fixpoint ip_g3;
-    static const Fixpoint ip_g4;
+    static constexpr Fixpoint ip_g0 = 4.0;
+    static constexpr Fixpoint ip_g1 = 0.0;
+    static constexpr Fixpoint ip_g2 = -3.5;
+    static constexpr Fixpoint ip_g3 = -1.0;
+    static constexpr Fixpoint ip_g4 = 0.5;
 
     // Backward (inverse) lowpass coefficients
     static const double ih0;
@@ -13,6 +13,8 @@
 
 #include "nls_encoder.h"
 
+#include "data_block.h"
+
 #include <outpost/base/slice.h>
 #include <outpost/utils/log2.h>
 #include <outpost/utils/minmax.h>
@@ -23,18 +25,65 @@ namespace outpost
 {
 namespace compression
 {
+constexpr uint16_t NLSEncoderBase::MAX_LENGTH;
+
+CompressionScheme
+NLSEncoderBase::getCompressionScheme() const
+{
+    return CompressionScheme::waveletNLS;
+}
+
 void
-NLSEncoder::encode(outpost::Slice<int16_t> inBuffer, Bitstream& outBuffer)
+NLSEncoderBase::setRateControl(size_t maximumSize, uint8_t lowestBitplane)
+{
+    mMaximumSize = maximumSize;
+    mLowestBitplane = lowestBitplane;
+}
+
+size_t
+NLSEncoderBase::encode(const DataBlock& block, outpost::Slice<uint8_t> buffer)
+{
+    outpost::Slice<int16_t> coefficients = block.getCoefficients();
+    size_t numberOfCoefficients = coefficients.getNumberOfElements();
+    if (numberOfCoefficients == 0 || numberOfCoefficients > mMaximumLength
+        || buffer.getNumberOfElements() < numberOfCoefficients * sizeof(int16_t))
+    {
+        return 0;
+    }
+
+    // The budget has to hold at least the header of the bitstream and of the encoding
+    if (mMaximumSize != 0 && mMaximumSize < Bitstream::headerSize + 2U)
+    {
+        return 0;
+    }
+
+    // The bitstream drops all bits beyond the end of its buffer
+    outpost::Slice<uint8_t> budget = (mMaximumSize != 0) ? buffer.first(mMaximumSize) : buffer;
+    Bitstream bitstream(budget);
+    encode(coefficients, bitstream, 2, 0, mLowestBitplane);
+    outpost::Serialize dataStream(buffer);
+    bitstream.serialize(dataStream);
+    return bitstream.getSerializedSize();
+}
+
+void
+NLSEncoderBase::encode(outpost::Slice<int16_t> inBuffer, Bitstream& outBuffer)
 {
     encode(inBuffer, outBuffer, 2, 0);
 }
 
 void
-NLSEncoder::encode(outpost::Slice<int16_t> inBuffer,
-                   Bitstream& outBuffer,
-                   uint8_t dcComponents,
-                   size_t maxBytes)
+NLSEncoderBase::encode(outpost::Slice<int16_t> inBuffer,
+                       Bitstream& outBuffer,
+                       uint8_t dcComponents,
+                       size_t maxBytes,
+                       uint8_t lowestBitplane)
 {
+    if (inBuffer.getNumberOfElements() > mMaximumLength)
+    {
+        return;
+    }
+
     if (maxBytes == 0)
     {
         maxBytes = inBuffer.getNumberOfElements() << 1;
@@ -85,25 +134,12 @@ NLSEncoder::encode(outpost::Slice<int16_t> inBuffer,
     int8_t n = Log2(max);
     uint16_t s = 1 << n;
 
-    // Put the number of bitplanes in the output stream
-    for (int8_t i = 3; i >= 0; i--)
-    {
-        outBuffer.pushBit(static_cast<uint16_t>(1 << i) & n);
-    }
-
-    // Put the number of DC components in the output stream
-    for (int8_t i = 3; i >= 0; i--)
-    {
-        outBuffer.pushBit(static_cast<uint8_t>(1 << i) & dcComponents);
-    }
-
-    // Put the number of coefficients in the output stream
-    size_t exponent = Log2(inBuffer.getNumberOfElements());
-    for (int8_t i = 3; i >= 0; i--)
-    {
-        size_t tmp = static_cast<size_t>(1 << i) & exponent;
-        outBuffer.pushBit(tmp > 0);
-    }
+    // Put the number of bitplanes, the number of DC components and the number of coefficients
+    // in the output stream
+    outpost::BitstreamWriter writer(outBuffer);
+    writer.pushBits(static_cast<uint32_t>(n), 4);
+    writer.pushBits(dcComponents, 4);
+    writer.pushBits(Log2(inBuffer.getNumberOfElements()), 4);
 
     // Initialize the state marker table
     uint16_t i = 0;
@@ -123,8 +159,8 @@ NLSEncoder::encode(outpost::Slice<int16_t> inBuffer,
         mark[i] = NM;
     }
 
-    // Iterate over all bitplanes
-    while (n >= 0)
+    // Iterate over all bitplanes down to the requested one
+    while (n >= static_cast<int8_t>(lowestBitplane))
     {
         // Insignificant Pixel Pass
         uint16_t j = 0;
@@ -136,10 +172,10 @@ NLSEncoder::encode(outpost::Slice<int16_t> inBuffer,
                 // If the coefficient is significant, mark it MNP and push this information and its
                 // sign bit to the output stream
                 bool sig = std::abs(inBuffer[j]) >= s;
-                outBuffer.pushBit(sig);
+                writer.pushBit(sig);
                 if (sig)
                 {
-                    outBuffer.pushBit(inBuffer[j] < 0);
+                    writer.pushBit(inBuffer[j] < 0);
                     mark[j] = MNP;
                     inBuffer[j] = std::abs(inBuffer[j]);
                 }
@@ -152,7 +188,8 @@ NLSEncoder::encode(outpost::Slice<int16_t> inBuffer,
         }
 
         // Break if the maximum number of output bytes is reached.
-        if (outBuffer.getSize() > maxBytes)
+        writer.flush();
+        if (outBuffer.getSize() > maxBytes || outBuffer.isFull())
         {
             break;
         }
@@ -165,7 +202,7 @@ NLSEncoder::encode(outpost::Slice<int16_t> inBuffer,
             if (mark[j] == MD)
             {
                 bool sig = dmax[j >> 1] >= s;
-                outBuffer.pushBit(sig);
+                writer.pushBit(sig);
                 if (sig)
                 {
                     mark[j] = mark[j + 1] = MCP;
@@ -182,7 +219,7 @@ NLSEncoder::encode(outpost::Slice<int16_t> inBuffer,
             else if (mark[j] == MG)
             {
                 bool sig = gmax[j >> 2] >= s;
-                outBuffer.pushBit(sig);
+                writer.pushBit(sig);
                 if (sig)
                 {
                     mark[j] = mark[j + 2] = MD;
@@ -197,10 +234,10 @@ NLSEncoder::encode(outpost::Slice<int16_t> inBuffer,
             else if (mark[j] == MCP)
             {
                 bool sig = std::abs(inBuffer[j]) >= s;
-                outBuffer.pushBit(sig);
+                writer.pushBit(sig);
                 if (sig)
                 {
-                    outBuffer.pushBit(inBuffer[j] < 0);
+                    writer.pushBit(inBuffer[j] < 0);
                     mark[j] = MNP;
                     inBuffer[j] = std::abs(inBuffer[j]);
                 }
@@ -217,7 +254,8 @@ NLSEncoder::encode(outpost::Slice<int16_t> inBuffer,
         }
 
         // Break if the maximum number of output bytes is reached.
-        if (outBuffer.getSize() > maxBytes)
+        writer.flush();
+        if (outBuffer.getSize() > maxBytes || outBuffer.isFull())
         {
             break;
         }
@@ -229,7 +267,7 @@ NLSEncoder::encode(outpost::Slice<int16_t> inBuffer,
             // Push significant coefficients to the output stream
             if (mark[j] == MSP)
             {
-                outBuffer.pushBit((inBuffer[j] & s) > 0);
+                writer.pushBit((inBuffer[j] & s) > 0);
                 j++;
             }
             // Newly identified significant coefficients shall be refined in the next pass
@@ -245,7 +283,8 @@ NLSEncoder::encode(outpost::Slice<int16_t> inBuffer,
         }
 
         // Break if the maximum number of output bytes is reached.
-        if (outBuffer.getSize() > maxBytes)
+        writer.flush();
+        if (outBuffer.getSize() > maxBytes || outBuffer.isFull())
         {
             break;
         }
@@ -257,7 +296,7 @@ NLSEncoder::encode(outpost::Slice<int16_t> inBuffer,
 }
 
 void
-NLSEncoder::push(uint16_t pI, size_t pBufferLength)
+NLSEncoderBase::push(uint16_t pI, size_t pBufferLength)
 {
     pI = pI << 1;
     uint8_t offset = 0;
@@ -269,7 +308,7 @@ NLSEncoder::push(uint16_t pI, size_t pBufferLength)
 }
 
 outpost::Slice<int16_t>
-NLSEncoder::decode(Bitstream& inBuffer, outpost::Slice<int16_t> outBuffer)
+NLSEncoderBase::decode(Bitstream& inBuffer, outpost::Slice<int16_t> outBuffer)
 {
     int8_t n;
     uint8_t dcComponents;
@@ -278,17 +317,19 @@ NLSEncoder::decode(Bitstream& inBuffer, outpost::Slice<int16_t> outBuffer)
     uint16_t s = 1 << n;
 
     size_t outBufferLength = 1 << ((inBuffer.getByte(1) >> 4) & 0x0F);
-    if (outBufferLength < 8 || outBuffer.getNumberOfElements() < outBufferLength)
+    if (outBufferLength < 8 || outBuffer.getNumberOfElements() < outBufferLength
+        || outBufferLength > mMaximumLength || dcComponents == 0
+        || static_cast<size_t>(dcComponents << 1) > outBufferLength)
     {
         return outpost::Slice<int16_t>::empty();
     }
-    bool signs[MAX_LENGTH];
 
+    // The sign of a coefficient is not stored separately, its reconstructed value is never zero
+    // once it has become significant.
     for (size_t i = 0; i < outBufferLength; i++)
     {
         mark[i] = NM;
         outBuffer[i] = 0;
-        signs[i] = 0;
     }
 
     for (uint8_t i = 0; i < dcComponents; i++)
@@ -302,7 +343,8 @@ NLSEncoder::decode(Bitstream& inBuffer, outpost::Slice<int16_t> outBuffer)
         push(i, outBufferLength);
     }
 
-    uint16_t buffer_bit_pointer = 12;
+    // Bits following the 12 bit header
+    outpost::BitstreamReader reader(inBuffer, 12);
 
     while (n >= 0)
     {
@@ -312,12 +354,11 @@ NLSEncoder::decode(Bitstream& inBuffer, outpost::Slice<int16_t> outBuffer)
         {
             if (mark[i] == MIP)
             {
-                bool sig = inBuffer.getBit(buffer_bit_pointer++);
+                bool sig = reader.getBit();
                 if (sig)
                 {
-                    signs[i] = inBuffer.getBit(buffer_bit_pointer++);
                     mark[i] = MNP;
-                    outBuffer[i] += (1 - 2 * signs[i]) * (s + (s >> 1));
+                    outBuffer[i] = reader.getBit() ? -(s + (s >> 1)) : (s + (s >> 1));
                 }
                 i++;
             }
@@ -327,7 +368,7 @@ NLSEncoder::decode(Bitstream& inBuffer, outpost::Slice<int16_t> outBuffer)
             }
         }
 
-        if (buffer_bit_pointer >> 3 > inBuffer.getSize())
+        if (reader.getPosition() >> 3 > inBuffer.getSize())
         {
             break;
         }
@@ -338,7 +379,7 @@ NLSEncoder::decode(Bitstream& inBuffer, outpost::Slice<int16_t> outBuffer)
         {
             if (mark[i] == MD)
             {
-                bool sig = inBuffer.getBit(buffer_bit_pointer++);
+                bool sig = reader.getBit();
                 if (sig)
                 {
                     mark[i] = mark[i + 1] = MCP;
@@ -354,7 +395,7 @@ NLSEncoder::decode(Bitstream& inBuffer, outpost::Slice<int16_t> outBuffer)
             }
             else if (mark[i] == MG)
             {
-                bool sig = inBuffer.getBit(buffer_bit_pointer++);
+                bool sig = reader.getBit();
                 if (sig)
                 {
                     mark[i] = mark[i + 2] = MD;
@@ -368,12 +409,11 @@ NLSEncoder::decode(Bitstream& inBuffer, outpost::Slice<int16_t> outBuffer)
             }
             else if (mark[i] == MCP)
             {
-                bool sig = inBuffer.getBit(buffer_bit_pointer++);
+                bool sig = reader.getBit();
                 if (sig)
                 {
-                    signs[i] = inBuffer.getBit(buffer_bit_pointer++);
                     mark[i] = MNP;
-                    outBuffer[i] += (1 - 2 * signs[i]) * (s + (s >> 1));
+                    outBuffer[i] = reader.getBit() ? -(s + (s >> 1)) : (s + (s >> 1));
                 }
                 else
                 {
@@ -387,7 +427,7 @@ NLSEncoder::decode(Bitstream& inBuffer, outpost::Slice<int16_t> outBuffer)
             }
         }
 
-        if (buffer_bit_pointer >> 3 > inBuffer.getSize())
+        if (reader.getPosition() >> 3 > inBuffer.getSize())
         {
             break;
         }
@@ -398,16 +438,8 @@ NLSEncoder::decode(Bitstream& inBuffer, outpost::Slice<int16_t> outBuffer)
         {
             if (mark[i] == MSP)
             {
-                bool sig = inBuffer.getBit(buffer_bit_pointer++);
-
-                if (sig)
-                {
-                    outBuffer[i] += (1 - 2 * signs[i]) * (s >> 1);
-                }
-                else
-                {
-                    outBuffer[i] += (1 - 2 * signs[i]) * ((s >> 1) - s);
-                }
+                int16_t refinement = reader.getBit() ? (s >> 1) : ((s >> 1) - s);
+                outBuffer[i] += (outBuffer[i] < 0) ? -refinement : refinement;
                 i++;
             }
             else if (mark[i] == MNP)
@@ -421,7 +453,7 @@ NLSEncoder::decode(Bitstream& inBuffer, outpost::Slice<int16_t> outBuffer)
             }
         }
 
-        if (buffer_bit_pointer >> 3 > inBuffer.getSize())
+        if (reader.getPosition() >> 3 > inBuffer.getSize())
         {
             break;
         }
@@ -14,6 +14,8 @@
 #ifndef OUTPOST_UTILS_COMPRESSION_NLS_ENCODER_H_
 #define OUTPOST_UTILS_COMPRESSION_NLS_ENCODER_H_
 
+#include "block_encoder.h"
+
 #include <stddef.h>
 #include <stdint.h>
 
@@ -33,13 +35,15 @@ namespace compression
  *
  * For the complete compression scheme, see:
  * https://elib.dlr.de/112826/
+ *
+ * The state tables are provided by GenericNLSEncoder.
  */
-class NLSEncoder
+class NLSEncoderBase : public BlockEncoder
 {
-private:
+public:
+    /// Maximum number of coefficients supported by the encoding
     static constexpr uint16_t MAX_LENGTH = 4096U;
 
-public:
     // State table markers
     enum Marker
     {
@@ -72,14 +76,62 @@ public:
         MN14
     };
 
-    NLSEncoder() = default;
+    /**
+     * Maximum number of coefficients this encoder has been sized for
+     */
+    inline size_t
+    getMaximumLength() const
+    {
+        return mMaximumLength;
+    }
+
+    /**
+     * Limits the size of the blocks encoded by encode(const DataBlock&, outpost::Slice<uint8_t>)
+     * for a guaranteed downlink budget.
+     *
+     * As the encoding is embedded, the bitstream is cut off once the budget is reached and the
+     * remaining passes are skipped. The decoder reconstructs the block with the precision
+     * reached until then.
+     * @param maximumSize Maximum number of bytes of an encoded block, including the header of
+     * the bitstream. 0 disables the limit.
+     * @param lowestBitplane Lowest bitplane to encode, coarser quantization for higher values.
+     * 0 encodes all bitplanes.
+     */
+    void
+    setRateControl(size_t maximumSize, uint8_t lowestBitplane = 0);
+
+    inline size_t
+    getMaximumSize() const
+    {
+        return mMaximumSize;
+    }
 
-    ~NLSEncoder() = default;
+    inline uint8_t
+    getLowestBitplane() const
+    {
+        return mLowestBitplane;
+    }
+
+    CompressionScheme
+    getCompressionScheme() const override;
+
+    /**
+     * Encodes the coefficients of a transformed block.
+     * WARNING: As with the encoding of a buffer, the coefficients are converted to their
+     * absolute values.
+     * @param block Transformed block with at most getMaximumLength() coefficients
+     * @param buffer Memory for the serialized bitstream, must hold at least two bytes per
+     * coefficient.
+     * @return Returns the number of bytes written to buffer, 0 if the block could not be encoded.
+     */
+    size_t
+    encode(const DataBlock& block, outpost::Slice<uint8_t> buffer) override;
 
     /**
      * Forward No List SPIHT transform
      * WARNING: For handling bits correcty, the input buffer values will, after encoding the sign
      * bits, be converted to their absolute values.
+     * Input buffers longer than getMaximumLength() are not encoded.
      * @param inBuffer
      *     Input buffer to be encoded
      * @param outBuffer
@@ -99,13 +151,17 @@ public:
      * @param dcComponents
      *     Number of components that are not encoded but rather prepend the stream
      * @param maxBytes
-     *     Maximum number of bytes to write to outBuffer
+     *     Maximum number of bytes to write to outBuffer, checked after every pass. The encoding
+     *     also stops once outBuffer is full.
+     * @param lowestBitplane
+     *     Lowest bitplane to encode
      */
     void
     encode(outpost::Slice<int16_t> inBuffer,
            outpost::Bitstream& outBuffer,
            uint8_t dcComponents,
-           size_t maxBytes);
+           size_t maxBytes,
+           uint8_t lowestBitplane = 0);
 
     /**
      * Backward transform from a No List SPIHT encoded bitstream to int16_t
@@ -119,11 +175,46 @@ public:
     outpost::Slice<int16_t>
     decode(outpost::Bitstream& inBuffer, outpost::Slice<int16_t> outBuffer);
 
-    Marker mark[MAX_LENGTH];
-    int16_t dmax[MAX_LENGTH / 2];
-    int16_t gmax[MAX_LENGTH / 4];
+protected:
+    /**
+     * @param markTable
+     *     State marker table with maximumLength entries
+     * @param dmaxTable
+     *     Maximum descendant table with maximumLength / 2 entries
+     * @param gmaxTable
+     *     Maximum granddescendant table with maximumLength / 4 entries
+     */
+    NLSEncoderBase(uint8_t* markTable,
+                   int16_t* dmaxTable,
+                   int16_t* gmaxTable,
+                   size_t maximumLength) :
+        mark(markTable),
+        dmax(dmaxTable),
+        gmax(gmaxTable),
+        mMaximumLength(maximumLength),
+        mMaximumSize(0),
+        mLowestBitplane(0)
+    {
+    }
+
+    virtual ~NLSEncoderBase() = default;
 
 private:
+    NLSEncoderBase(const NLSEncoderBase&) = delete;
+
+    NLSEncoderBase&
+    operator=(const NLSEncoderBase&) = delete;
+
+    // Markers are stored as bytes, with 20 states they do not fit into a nibble
+    uint8_t* const mark;
+    int16_t* const dmax;
+    int16_t* const gmax;
+    const size_t mMaximumLength;
+
+    // Rate control of encode(const DataBlock&, outpost::Slice<uint8_t>)
+    size_t mMaximumSize;
+    uint8_t mLowestBitplane;
+
     /**
      * Push increasing MN* markings in the state marker table down the tree of coefficients
      * @param pI
@@ -142,7 +233,7 @@ private:
      *     Number of coefficients to skip
      */
     inline static uint16_t
-    skip(Marker pM)
+    skip(uint8_t pM)
     {
         switch (pM)
         {
@@ -178,7 +269,7 @@ private:
      *     Number of coefficients to skip
      */
     inline static uint16_t
-    isSkip(Marker pM)
+    isSkip(uint8_t pM)
     {
         switch (pM)
         {
@@ -207,6 +298,60 @@ private:
     }
 };
 
+namespace internal
+{
+/**
+ * Tables of a GenericNLSEncoder.
+ *
+ * Base class of GenericNLSEncoder so that it is constructed before
+ * NLSEncoderBase refers to it.
+ */
+template <size_t maximumLength>
+class NLSEncoderStorage
+{
+protected:
+    NLSEncoderStorage() : mMarkStorage(), mDmaxStorage(), mGmaxStorage()
+    {
+    }
+
+    uint8_t mMarkStorage[maximumLength];
+    int16_t mDmaxStorage[maximumLength / 2];
+    int16_t mGmaxStorage[maximumLength / 4];
+};
+}  // namespace internal
+
+/**
+ * NLS encoder with tables for blocks of up to maximumLength coefficients.
+ *
+ * An encoder only used for small blocks can be sized accordingly, e.g.
+ * GenericNLSEncoder<256> requires 640 bytes instead of 10240 bytes for
+ * the largest block size.
+ *
+ * @tparam maximumLength
+ *      Maximum number of coefficients per block, a power of two between 16 and 4096.
+ */
+template <size_t maximumLength>
+class GenericNLSEncoder : private internal::NLSEncoderStorage<maximumLength>,
+                          public NLSEncoderBase
+{
+    static_assert(maximumLength >= 16 && maximumLength <= NLSEncoderBase::MAX_LENGTH,
+                  "Unsupported block length");
+    static_assert((maximumLength & (maximumLength - 1)) == 0,
+                  "Block length must be a power of two");
+
+public:
+    GenericNLSEncoder() :
+        internal::NLSEncoderStorage<maximumLength>(),
+        NLSEncoderBase(this->mMarkStorage, this->mDmaxStorage, this->mGmaxStorage, maximumLength)
+    {
+    }
+};
+
+/**
+ * NLS encoder for all block sizes.
+ */
+typedef GenericNLSEncoder<NLSEncoderBase::MAX_LENGTH> NLSEncoder;
+
 }  // namespace compression
 }  // namespace outpost
 
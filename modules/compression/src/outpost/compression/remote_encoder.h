@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMPRESSION_REMOTE_ENCODER_H_
+#define OUTPOST_COMPRESSION_REMOTE_ENCODER_H_
+
+#include "data_block.h"
+
+#include <outpost/time/duration.h>
+
+namespace outpost
+{
+namespace compression
+{
+/**
+ * Compression service on another node, e.g. a co-processor, to which the DataProcessorThread
+ * hands raw DataBlocks instead of compressing them itself.
+ *
+ * The blocks are compressed asynchronously. Every submitted block is returned by receive()
+ * exactly once: either encoded by the remote, or unchanged if the remote could not compress it
+ * in time, so that it can be compressed locally instead.
+ *
+ * Implementations are used by a single thread only.
+ */
+class RemoteEncoder
+{
+public:
+    RemoteEncoder() = default;
+
+    virtual ~RemoteEncoder() = default;
+
+    /**
+     * Hands a complete raw block over to the remote.
+     * @param block Block to compress, is kept referenced until it is returned by receive()
+     * @param scheme Scheme the remote shall compress the block with
+     * @return Returns false if the remote is not available or has no free slot. The block has to
+     * be compressed locally then.
+     */
+    virtual bool
+    submit(const DataBlock& block, CompressionScheme scheme) = 0;
+
+    /**
+     * Takes a block back from the remote.
+     * @param block Encoded block, or the submitted raw block if the remote failed to compress it
+     * @param timeout Timeout for the reception of an encoded block
+     * @return Returns false if no block is pending.
+     */
+    virtual bool
+    receive(DataBlock& block, outpost::time::Duration timeout) = 0;
+
+    /**
+     * Getter for the number of blocks submitted but not received yet.
+     */
+    virtual size_t
+    getNumberOfPendingBlocks() const = 0;
+};
+
+}  // namespace compression
+}  // namespace outpost
+
+#endif /* OUTPOST_COMPRESSION_REMOTE_ENCODER_H_ */
@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "rice_encoder.h"
+
+#include <outpost/base/fixpoint.h>
+#include <outpost/utils/storage/bitstream.h>
+
+namespace outpost
+{
+namespace compression
+{
+constexpr size_t RiceEncoder::samplesPerSegment;
+constexpr uint8_t RiceEncoder::sampleBits;
+constexpr uint8_t RiceEncoder::identifierBits;
+constexpr uint8_t RiceEncoder::maximumSplit;
+constexpr uint8_t RiceEncoder::noCompression;
+
+CompressionScheme
+RiceEncoder::getCompressionScheme() const
+{
+    return CompressionScheme::rice;
+}
+
+template <typename T>
+void
+RiceEncoder::encodeSamples(outpost::Slice<const T> samples, Bitstream& outBuffer)
+{
+    size_t numberOfSamples = samples.getNumberOfElements();
+    if (numberOfSamples == 0)
+    {
+        return;
+    }
+
+    BitstreamWriter writer(outBuffer);
+    int16_t prediction = static_cast<int16_t>(samples[0]);
+    writer.pushBits(static_cast<uint16_t>(prediction), sampleBits);
+
+    uint16_t values[samplesPerSegment];
+    size_t count = 0;
+    for (size_t i = 1; i < numberOfSamples; i++)
+    {
+        int16_t sample = static_cast<int16_t>(samples[i]);
+        values[count++] = map(prediction, sample);
+        prediction = sample;
+        if (count == samplesPerSegment || i == numberOfSamples - 1)
+        {
+            encodeSegment(writer, values, count);
+            count = 0;
+        }
+    }
+}
+
+size_t
+RiceEncoder::encode(const DataBlock& block, outpost::Slice<uint8_t> buffer)
+{
+    if (block.isTransformed() || block.isEncoded())
+    {
+        return 0;
+    }
+
+    outpost::Slice<const Fixpoint> samples = block.getSamples();
+    if (samples.getNumberOfElements() == 0
+        || buffer.getNumberOfElements() < getMaximumEncodedSize(samples.getNumberOfElements()))
+    {
+        return 0;
+    }
+
+    Bitstream bitstream(buffer);
+    encodeSamples(samples, bitstream);
+    outpost::Serialize stream(buffer);
+    bitstream.serialize(stream);
+    return bitstream.getSerializedSize();
+}
+
+void
+RiceEncoder::encode(outpost::Slice<const int16_t> samples, Bitstream& outBuffer)
+{
+    encodeSamples(samples, outBuffer);
+}
+
+outpost::Slice<int16_t>
+RiceEncoder::decode(const Bitstream& inBuffer, outpost::Slice<int16_t> outBuffer)
+{
+    size_t numberOfSamples = outBuffer.getNumberOfElements();
+    uint32_t numberOfBits = inBuffer.getNumberOfBits();
+    if (numberOfSamples == 0 || numberOfBits < sampleBits)
+    {
+        return outpost::Slice<int16_t>::empty();
+    }
+
+    BitstreamReader reader(inBuffer);
+    int16_t prediction = static_cast<int16_t>(reader.getBits(sampleBits));
+    outBuffer[0] = prediction;
+
+    uint16_t values[samplesPerSegment];
+    for (size_t i = 1; i < numberOfSamples;)
+    {
+        size_t count = numberOfSamples - i;
+        if (count > samplesPerSegment)
+        {
+            count = samplesPerSegment;
+        }
+
+        uint8_t identifier = reader.getBits(identifierBits);
+        if (identifier == 0)
+        {
+            return outpost::Slice<int16_t>::empty();
+        }
+        else if (identifier == noCompression + 1)
+        {
+            for (size_t j = 0; j < count; j++)
+            {
+                values[j] = reader.getBits(sampleBits);
+            }
+        }
+        else
+        {
+            uint8_t k = identifier - 1;
+            for (size_t j = 0; j < count; j++)
+            {
+                uint32_t high = 0;
+                while (!reader.getBit())
+                {
+                    high++;
+                    if (reader.getPosition() > numberOfBits)
+                    {
+                        return outpost::Slice<int16_t>::empty();
+                    }
+                }
+                if ((high << k) > 0xFFFFU)
+                {
+                    return outpost::Slice<int16_t>::empty();
+                }
+                values[j] = high << k;
+            }
+            for (size_t j = 0; j < count; j++)
+            {
+                values[j] |= reader.getBits(k);
+            }
+        }
+
+        for (size_t j = 0; j < count; j++)
+        {
+            prediction = unmap(prediction, values[j]);
+            outBuffer[i + j] = prediction;
+        }
+        i += count;
+    }
+
+    if (reader.getPosition() > numberOfBits)
+    {
+        return outpost::Slice<int16_t>::empty();
+    }
+    return outBuffer;
+}
+
+uint32_t
+RiceEncoder::getNumberOfEncodedBits(outpost::Slice<const Fixpoint> samples)
+{
+    size_t numberOfSamples = samples.getNumberOfElements();
+    if (numberOfSamples == 0)
+    {
+        return 0;
+    }
+
+    uint32_t total = sampleBits;
+    int16_t prediction = static_cast<int16_t>(samples[0]);
+    uint16_t values[samplesPerSegment];
+    size_t count = 0;
+    for (size_t i = 1; i < numberOfSamples; i++)
+    {
+        int16_t sample = static_cast<int16_t>(samples[i]);
+        values[count++] = map(prediction, sample);
+        prediction = sample;
+        if (count == samplesPerSegment || i == numberOfSamples - 1)
+        {
+            uint32_t bits = 0;
+            selectOption(values, count, bits);
+            total += identifierBits + bits;
+            count = 0;
+        }
+    }
+    return total;
+}
+
+size_t
+RiceEncoder::getMaximumEncodedSize(size_t numberOfSamples)
+{
+    if (numberOfSamples == 0)
+    {
+        return Bitstream::headerSize;
+    }
+    size_t residuals = numberOfSamples - 1;
+    size_t segments = (residuals + samplesPerSegment - 1) / samplesPerSegment;
+    size_t bits = sampleBits + segments * identifierBits + residuals * sampleBits;
+    return Bitstream::headerSize + (bits + 7) / 8;
+}
+
+uint16_t
+RiceEncoder::map(int16_t prediction, int16_t sample)
+{
+    int32_t delta = static_cast<int32_t>(sample) - prediction;
+    int32_t theta = static_cast<int32_t>(prediction) - INT16_MIN;
+    if (INT16_MAX - prediction < theta)
+    {
+        theta = INT16_MAX - prediction;
+    }
+
+    if (delta >= 0 && delta <= theta)
+    {
+        return static_cast<uint16_t>(2 * delta);
+    }
+    else if (delta < 0 && delta >= -theta)
+    {
+        return static_cast<uint16_t>(-2 * delta - 1);
+    }
+    else
+    {
+        return static_cast<uint16_t>(theta + ((delta < 0) ? -delta : delta));
+    }
+}
+
+int16_t
+RiceEncoder::unmap(int16_t prediction, uint16_t value)
+{
+    int32_t theta = static_cast<int32_t>(prediction) - INT16_MIN;
+    bool closerToMinimum = true;
+    if (INT16_MAX - prediction < theta)
+    {
+        theta = INT16_MAX - prediction;
+        closerToMinimum = false;
+    }
+
+    int32_t delta;
+    if (value <= 2 * theta)
+    {
+        delta = (value & 1) ? -((static_cast<int32_t>(value) + 1) >> 1) : (value >> 1);
+    }
+    else if (closerToMinimum)
+    {
+        // Residuals beyond theta can only be positive
+        delta = value - theta;
+    }
+    else
+    {
+        delta = theta - value;
+    }
+    return static_cast<int16_t>(prediction + delta);
+}
+
+uint8_t
+RiceEncoder::selectOption(const uint16_t* values, size_t count, uint32_t& bits)
+{
+    uint8_t option = noCompression;
+    bits = count * sampleBits;
+    for (uint8_t k = 0; k <= maximumSplit; k++)
+    {
+        uint32_t length = count * (k + 1U);
+        for (size_t i = 0; i < count; i++)
+        {
+            length += values[i] >> k;
+        }
+
+        if (length < bits)
+        {
+            bits = length;
+            option = k;
+        }
+        else if (option != noCompression)
+        {
+            // The length only grows once it has passed its minimum
+            break;
+        }
+    }
+    return option;
+}
+
+void
+RiceEncoder::encodeSegment(BitstreamWriter& writer, const uint16_t* values, size_t count)
+{
+    uint32_t bits = 0;
+    uint8_t k = selectOption(values, count, bits);
+    writer.pushBits(k + 1U, identifierBits);
+    if (k == noCompression)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            writer.pushBits(values[i], sampleBits);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t zeros = values[i] >> k;
+        while (zeros >= 31U)
+        {
+            writer.pushBits(0U, 31U);
+            zeros -= 31U;
+        }
+        writer.pushBits(1U, zeros + 1U);
+    }
+    if (k > 0)
+    {
+        uint16_t mask = (1U << k) - 1U;
+        for (size_t i = 0; i < count; i++)
+        {
+            writer.pushBits(values[i] & mask, k);
+        }
+    }
+}
+
+}  // namespace compression
+}  // namespace outpost
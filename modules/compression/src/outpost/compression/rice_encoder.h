@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMPRESSION_RICE_ENCODER_H_
+#define OUTPOST_COMPRESSION_RICE_ENCODER_H_
+
+#include "block_encoder.h"
+
+#include <outpost/base/slice.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+class Bitstream;
+class BitstreamWriter;
+
+template <unsigned PREC>
+class FP;
+typedef FP<16> Fixpoint;
+
+namespace compression
+{
+/**
+ * Lossless adaptive Rice coder with a unit-delay predictor, following the
+ * structure of CCSDS 121.0-B.
+ *
+ * Intended for slowly varying parameters, for which the wavelet transform
+ * and NLS encoding cost much more processing time for a similar ratio.
+ * The samples of a DataBlock are rounded to 16 bit integers, the same
+ * precision the wavelet coefficients are encoded with.
+ *
+ * Each sample is predicted by its predecessor and the residual is mapped
+ * to a non-negative value with the CCSDS prediction error mapper. The
+ * stream starts with the first sample as 16 bit reference, followed by
+ * segments of up to 16 mapped residuals. Each segment starts with a 4 bit
+ * option identifier:
+ * - 1: fundamental sequence, every value v as v zeros and a one
+ * - 2 to 14: split sample with k = identifier - 1, the fundamental
+ *   sequences of v >> k followed by the k lower bits of all values
+ * - 15: no compression, 16 bits per value
+ *
+ * The option with the fewest bits is selected for every segment. The low
+ * entropy options of the standard (zero block and second extension) are
+ * not used, identifier 0 is invalid.
+ *
+ * The coder does not keep any state between blocks and may be shared
+ * between threads.
+ */
+class RiceEncoder : public BlockEncoder
+{
+public:
+    /// Number of residuals coded with the same option
+    static constexpr size_t samplesPerSegment = 16U;
+
+    RiceEncoder() = default;
+
+    virtual ~RiceEncoder() = default;
+
+    CompressionScheme
+    getCompressionScheme() const override;
+
+    /**
+     * Encodes the samples of a block which has not been transformed.
+     * @param block Block to encode
+     * @param buffer Memory for the serialized bitstream, must hold the worst case given by
+     * getMaximumEncodedSize().
+     * @return Returns the number of bytes written to buffer, 0 if the block could not be encoded.
+     */
+    size_t
+    encode(const DataBlock& block, outpost::Slice<uint8_t> buffer) override;
+
+    /**
+     * Encodes integer samples.
+     * @param samples Samples to be encoded
+     * @param outBuffer Bitstream to write the encoding to
+     */
+    static void
+    encode(outpost::Slice<const int16_t> samples, Bitstream& outBuffer);
+
+    /**
+     * Decodes a bitstream created by encode().
+     * @param inBuffer Bitstream to decode
+     * @param outBuffer Buffer for the samples, its length defines the number of samples to decode
+     * @return Returns a slice of the decoded samples, an empty slice if the bitstream is invalid
+     * or too short.
+     */
+    static outpost::Slice<int16_t>
+    decode(const Bitstream& inBuffer, outpost::Slice<int16_t> outBuffer);
+
+    /**
+     * Calculates the size of the encoding without creating it.
+     * @param samples Samples of a block which has not been transformed
+     * @return Returns the number of bits of the encoded samples, excluding the Bitstream header.
+     */
+    static uint32_t
+    getNumberOfEncodedBits(outpost::Slice<const Fixpoint> samples);
+
+    /**
+     * Size of the serialized bitstream in the worst case.
+     * @param numberOfSamples Number of samples to be encoded
+     * @return Returns the maximum number of bytes including the Bitstream header.
+     */
+    static size_t
+    getMaximumEncodedSize(size_t numberOfSamples);
+
+private:
+    template <typename T>
+    static void
+    encodeSamples(outpost::Slice<const T> samples, Bitstream& outBuffer);
+
+    /**
+     * Maps the prediction residual of a sample to a non-negative value.
+     */
+    static uint16_t
+    map(int16_t prediction, int16_t sample);
+
+    static int16_t
+    unmap(int16_t prediction, uint16_t value);
+
+    /**
+     * Selects the coding option with the fewest bits.
+     * @param bits Number of bits of the selected option, excluding the identifier
+     * @return Returns k for the fundamental sequence (0) and split sample options,
+     * noCompression otherwise.
+     */
+    static uint8_t
+    selectOption(const uint16_t* values, size_t count, uint32_t& bits);
+
+    static void
+    encodeSegment(BitstreamWriter& writer, const uint16_t* values, size_t count);
+
+    static constexpr uint8_t sampleBits = 16U;
+    static constexpr uint8_t identifierBits = 4U;
+    static constexpr uint8_t maximumSplit = 13U;
+    static constexpr uint8_t noCompression = 14U;
+};
+
+}  // namespace compression
+}  // namespace outpost
+
+#endif /* OUTPOST_COMPRESSION_RICE_ENCODER_H_ */
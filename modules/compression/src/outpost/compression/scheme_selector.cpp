@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "scheme_selector.h"
+
+#include "rice_encoder.h"
+
+#include <outpost/base/fixpoint.h>
+#include <outpost/base/slice.h>
+
+namespace outpost
+{
+namespace compression
+{
+CompressionSchemeSelector::CompressionSchemeSelector(uint8_t maximumBitsPerSample) :
+    mMaximumBitsPerSample(maximumBitsPerSample)
+{
+}
+
+CompressionScheme
+CompressionSchemeSelector::select(const DataBlock& block) const
+{
+    if (!block.isTransformed() && !block.isEncoded())
+    {
+        outpost::Slice<const Fixpoint> samples = block.getSamples();
+        size_t numberOfSamples = samples.getNumberOfElements();
+        if (numberOfSamples > 0
+            && RiceEncoder::getNumberOfEncodedBits(samples)
+                       <= numberOfSamples * mMaximumBitsPerSample)
+        {
+            return CompressionScheme::rice;
+        }
+    }
+    return CompressionScheme::waveletNLS;
+}
+
+}  // namespace compression
+}  // namespace outpost
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMPRESSION_SCHEME_SELECTOR_H_
+#define OUTPOST_COMPRESSION_SCHEME_SELECTOR_H_
+
+#include "data_block.h"
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace compression
+{
+/**
+ * Chooses the CompressionScheme for every block of a parameter.
+ *
+ * The Rice coder is used if it needs at most maximumBitsPerSample bits per
+ * sample for the raw samples of the block, i.e. for slowly varying
+ * parameters. All other blocks, and blocks which have been transformed
+ * already, are wavelet transformed and NLS encoded. As the decision is
+ * based on the block itself, a parameter changes its scheme whenever its
+ * behaviour changes.
+ *
+ * The size of the Rice encoding is calculated in a single pass over the
+ * samples, without writing the encoding.
+ */
+class CompressionSchemeSelector
+{
+public:
+    /** Constructor
+     * @param maximumBitsPerSample Rice coded blocks must not need more bits per sample on average
+     */
+    explicit CompressionSchemeSelector(uint8_t maximumBitsPerSample = 8U);
+
+    /**
+     * Selects the scheme for a block
+     * @param block Block in its state before the transform
+     * @return Returns either CompressionScheme::rice or CompressionScheme::waveletNLS.
+     */
+    CompressionScheme
+    select(const DataBlock& block) const;
+
+    inline uint8_t
+    getMaximumBitsPerSample() const
+    {
+        return mMaximumBitsPerSample;
+    }
+
+private:
+    uint8_t mMaximumBitsPerSample;
+};
+
+}  // namespace compression
+}  // namespace outpost
+
+#endif /* OUTPOST_COMPRESSION_SCHEME_SELECTOR_H_ */
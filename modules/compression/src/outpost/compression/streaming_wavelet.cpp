@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "streaming_wavelet.h"
+
+#include <outpost/base/fixpoint.h>
+
+namespace outpost
+{
+namespace compression
+{
+constexpr size_t StreamingWavelet::maximumNumberOfLevels;
+
+StreamingWavelet::StreamingWavelet() :
+    mOutput(nullptr), mLength(0), mNumberOfLevels(0), mNumberOfSamples(0), mNumberOfLowpass(0)
+{
+}
+
+bool
+StreamingWavelet::start(outpost::Slice<Fixpoint> output)
+{
+    static_assert(sizeof(Fixpoint) == sizeof(int32_t), "Fixpoint must be a plain int32_t");
+
+    const size_t length = output.getNumberOfElements();
+    size_t levels = 0;
+    for (size_t l = length; l > 2; l >>= 1)
+    {
+        levels++;
+    }
+    // Blocks of 16 to 4096 samples, i.e. 3 to 11 levels
+    if ((length & (length - 1)) != 0 || levels < 3 || levels > maximumNumberOfLevels)
+    {
+        mOutput = nullptr;
+        mLength = 0;
+        return false;
+    }
+
+    mOutput = reinterpret_cast<int32_t*>(output.begin());
+    mLength = length;
+    mNumberOfLevels = levels;
+    mNumberOfSamples = 0;
+    mNumberOfLowpass = 0;
+    for (size_t i = 0; i < levels; i++)
+    {
+        mLevels[i].mCount = 0;
+    }
+    return true;
+}
+
+bool
+StreamingWavelet::push(Fixpoint sample)
+{
+    if (mOutput == nullptr || isComplete())
+    {
+        return false;
+    }
+    mNumberOfSamples++;
+    process(0, sample.getValue());
+    return true;
+}
+
+outpost::Slice<int16_t>
+StreamingWavelet::finish()
+{
+    if (!isComplete())
+    {
+        return outpost::Slice<int16_t>::empty();
+    }
+
+    // Narrowing front to back only overwrites values which have already been read
+    Fixpoint* coefficients = reinterpret_cast<Fixpoint*>(mOutput);
+    int16_t* outputBuffer = reinterpret_cast<int16_t*>(mOutput);
+    for (size_t i = 0; i < mLength; i++)
+    {
+        outputBuffer[i] = static_cast<int16_t>(coefficients[i]);
+    }
+    mOutput = nullptr;
+
+    return outpost::Slice<int16_t>::unsafe(outputBuffer, mLength);
+}
+
+void
+StreamingWavelet::process(size_t level, int32_t value)
+{
+    Level& state = mLevels[level];
+    const size_t halfLength = mLength >> (level + 1);
+    int32_t* high = mOutput + halfLength;
+
+    const size_t index = state.mCount++;
+    if (index == 0)
+    {
+        // Needed again for the lapping coefficients at the end of the level
+        state.mFirst = value;
+        state.mPreviousEven = value;
+    }
+    else if ((index & 1) == 0)
+    {
+        // Predict the highpass coefficient between the previous and the current even value
+        const size_t i = (index >> 1) - 1;
+        const int32_t h = state.mPendingOdd - ((state.mPreviousEven + value) >> 1);
+        high[i] = h;
+        if (i > 0)
+        {
+            emit(level, state.mPreviousEven + ((state.mPreviousHigh + h) >> 2));
+        }
+        state.mPreviousHigh = h;
+        state.mPreviousEven = value;
+    }
+    else if (index < 2 * halfLength - 1)
+    {
+        state.mPendingOdd = value;
+    }
+    else
+    {
+        // Last value of the level, the remaining coefficients wrap around to the beginning
+        const int32_t h = value - ((state.mPreviousEven + state.mFirst) >> 1);
+        high[halfLength - 1] = h;
+        emit(level, state.mPreviousEven + ((state.mPreviousHigh + h) >> 2));
+        emit(level, state.mFirst + ((h + high[0]) >> 2));
+    }
+}
+
+void
+StreamingWavelet::emit(size_t level, int32_t lowpass)
+{
+    if (level + 1 < mNumberOfLevels)
+    {
+        process(level + 1, lowpass);
+    }
+    else
+    {
+        mOutput[mNumberOfLowpass++] = lowpass;
+    }
+}
+
+}  // namespace compression
+}  // namespace outpost
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_COMPRESSION_STREAMING_WAVELET_H_
+#define OUTPOST_COMPRESSION_STREAMING_WAVELET_H_
+
+#include <outpost/base/slice.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+template <unsigned PREC>
+class FP;
+typedef FP<16> Fixpoint;
+
+namespace compression
+{
+/**
+ * Incremental variant of LeGall53Wavelet::forwardTransformInPlaceOrdered.
+ *
+ * Samples are transformed level by level as they arrive, so that the work
+ * of the transformation is spread over the sampling period of a block
+ * instead of being done at once when the block is complete. Each level
+ * keeps only the few values required by the next lifting step, the
+ * highpass coefficients are written directly to their final position in
+ * the output buffer. The resulting coefficients are identical to the ones
+ * of forwardTransformInPlaceOrdered.
+ *
+ * The raw samples are not stored, therefore the output buffer can be the
+ * sample buffer of the DataBlock receiving the samples.
+ */
+class StreamingWavelet
+{
+public:
+    /// Number of levels of the largest supported block size (4096 samples)
+    static constexpr size_t maximumNumberOfLevels = 11;
+
+    StreamingWavelet();
+
+    /**
+     * Start the transformation of a new block.
+     * @param output Buffer for the coefficients of the block, its length defines the block size
+     * and has to be a power of two between 16 and 4096.
+     * @return Returns false if the length is not supported.
+     */
+    bool
+    start(outpost::Slice<Fixpoint> output);
+
+    /**
+     * Add the next sample of the current block.
+     * @return Returns false if no block has been started or the block is complete already.
+     */
+    bool
+    push(Fixpoint sample);
+
+    /**
+     * Checks whether all samples of the current block have been pushed.
+     */
+    inline bool
+    isComplete() const
+    {
+        return mNumberOfSamples == mLength && mLength > 0;
+    }
+
+    /**
+     * Rounds the coefficients of a complete block to int16_t.
+     * @return Coefficients ordered for NLS encoding at the beginning of the output buffer, an
+     * empty slice if the block is not complete.
+     */
+    outpost::Slice<int16_t>
+    finish();
+
+private:
+    struct Level
+    {
+        size_t mCount;
+        int32_t mFirst;
+        int32_t mPreviousEven;
+        int32_t mPreviousHigh;
+        int32_t mPendingOdd;
+    };
+
+    void
+    process(size_t level, int32_t value);
+
+    void
+    emit(size_t level, int32_t lowpass);
+
+    int32_t* mOutput;
+    size_t mLength;
+    size_t mNumberOfLevels;
+    size_t mNumberOfSamples;
+    size_t mNumberOfLowpass;
+
+    Level mLevels[maximumNumberOfLevels];
+};
+
+}  // namespace compression
+}  // namespace outpost
+
+#endif /* OUTPOST_COMPRESSION_STREAMING_WAVELET_H_ */
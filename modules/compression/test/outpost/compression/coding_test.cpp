@@ -314,4 +314,78 @@ TEST_F(CodingTest, WaveletTestWithCompression)
     EXPECT_LE(mse, 3.0f);
 }
 
+TEST_F(CodingTest, shouldStopAtLowestBitplane)
+{
+    int16_t fullInput[bufferLength];
+    for (uint32_t i = 0; i < bufferLength; i++)
+    {
+        inputBuffer[i] = static_cast<int16_t>((i * 7919) % 2001) - 1000;
+        fullInput[i] = inputBuffer[i];
+        inputReference[i] = inputBuffer[i];
+    }
+
+    uint8_t fullBitStreamBuffer[2 * bufferLength + Bitstream::headerSize];
+    outpost::Slice<uint8_t> fullBitStreamData(fullBitStreamBuffer);
+    outpost::Bitstream full(fullBitStreamData);
+    encoder.encode(outpost::Slice<int16_t>(fullInput), full);
+
+    const uint8_t lowestBitplane = 4;
+    outpost::Bitstream bitstream(bitStreamData);
+    encoder.encode(inputData, bitstream, 2, 0, lowestBitplane);
+
+    // The embedded encoding is truncated after the lowest bitplane
+    ASSERT_LT(bitstream.getSize(), full.getSize());
+    for (size_t i = 0; i < bitstream.getNumberOfBits(); i++)
+    {
+        ASSERT_EQ(full.getBit(i), bitstream.getBit(i)) << i;
+    }
+
+    outpost::Slice<int16_t> res = encoder.decode(bitstream, outputData);
+    ASSERT_EQ(res.getNumberOfElements(), bufferLength);
+    for (uint32_t i = 0; i < bufferLength; i++)
+    {
+        EXPECT_LE(std::abs(outputBuffer[i] - inputReference[i]), 1 << (lowestBitplane + 1)) << i;
+    }
+}
+
+TEST_F(CodingTest, shouldEncodeIdenticallyWithSmallEncoder)
+{
+    outpost::compression::GenericNLSEncoder<bufferLength> smallEncoder;
+    EXPECT_EQ(bufferLength, smallEncoder.getMaximumLength());
+
+    int16_t smallInput[bufferLength];
+    uint8_t smallBitStreamBuffer[2 * bufferLength];
+    for (uint32_t i = 0; i < bufferLength; i++)
+    {
+        inputBuffer[i] = static_cast<int16_t>((i * 37) % 101) - 50;
+        smallInput[i] = inputBuffer[i];
+    }
+
+    outpost::Bitstream bitstream(bitStreamData);
+    encoder.encode(inputData, bitstream);
+
+    outpost::Slice<uint8_t> smallBitStreamData(smallBitStreamBuffer);
+    outpost::Bitstream smallBitstream(smallBitStreamData);
+    smallEncoder.encode(outpost::Slice<int16_t>(smallInput), smallBitstream);
+
+    ASSERT_EQ(bitstream.getSize(), smallBitstream.getSize());
+    for (size_t i = 0; i < bitstream.getSize(); i++)
+    {
+        EXPECT_EQ(bitstream.getByte(i), smallBitstream.getByte(i));
+    }
+}
+
+TEST_F(CodingTest, shouldRejectBlocksLargerThanEncoder)
+{
+    outpost::compression::GenericNLSEncoder<16> smallEncoder;
+    for (uint32_t i = 0; i < bufferLength; i++)
+    {
+        inputBuffer[i] = 100;
+    }
+
+    outpost::Bitstream bitstream(bitStreamData);
+    smallEncoder.encode(inputData, bitstream);
+    EXPECT_TRUE(bitstream.isEmpty());
+}
+
 }  // namespace coding_test
@@ -357,4 +357,142 @@ TEST_F(DataAggregationTest, FullQueue)
     EXPECT_EQ(aggregator.getNumCompletedBlocks(), 3U);
 }
 
+TEST_F(DataAggregationTest, StreamingTransform)
+{
+    OneTimeQueueSender ots(mQueue);
+    DataAggregator aggregator(123U, mClock, mPool, ots);
+
+    aggregator.setStreamingTransform(true);
+    aggregator.enable(SamplingRate::hz05, Blocksize::bs128);
+
+    // Reference block transformed at once
+    outpost::utils::SharedBufferPointer p;
+    ASSERT_TRUE(mPool.allocate(p));
+    DataBlock reference(p,
+                        123U,
+                        outpost::time::GpsTime::afterEpoch(outpost::time::Seconds(0)),
+                        SamplingRate::hz05,
+                        Blocksize::bs128);
+
+    for (int32_t i = 0; i < 128; i++)
+    {
+        Fixpoint f = static_cast<int16_t>((i * 29) % 200 - 100);
+        ASSERT_TRUE(reference.push(f));
+        ASSERT_TRUE(aggregator.push(f));
+        EXPECT_TRUE(aggregator.isStreamingTransform());
+    }
+    ASSERT_TRUE(reference.applyWaveletTransform());
+
+    DataBlock b;
+    ASSERT_TRUE(mQueue.receive(b, outpost::time::Duration::zero()));
+    EXPECT_TRUE(b.isComplete());
+    EXPECT_TRUE(b.isTransformed());
+    EXPECT_FALSE(b.applyWaveletTransform());
+
+    outpost::Slice<int16_t> expected = reference.getCoefficients();
+    outpost::Slice<int16_t> coefficients = b.getCoefficients();
+    ASSERT_EQ(expected.getNumberOfElements(), coefficients.getNumberOfElements());
+    for (size_t i = 0; i < expected.getNumberOfElements(); i++)
+    {
+        EXPECT_EQ(expected[i], coefficients[i]) << "at index " << i;
+    }
+}
+
+TEST_F(DataAggregationTest, AppendWithPreallocatedBlocks)
+{
+    OneTimeQueueSender ots(mQueue);
+    DataAggregator aggregator(123U, mClock, mPool, ots);
+
+    Fixpoint f = 1.5f;
+    aggregator.enable(SamplingRate::hz05, Blocksize::bs16);
+    EXPECT_EQ(mPool.numberOfElements(), mPool.numberOfFreeElements() + 1U);
+
+    mClock.setTime(outpost::time::SpacecraftElapsedTime::afterEpoch(outpost::time::Seconds(10)));
+    for (size_t i = 0; i < 16U; i++)
+    {
+        EXPECT_TRUE(aggregator.append(f));
+    }
+
+    // Completed blocks stay with the aggregator until handed over
+    DataBlock b;
+    EXPECT_FALSE(mQueue.receive(b, outpost::time::Duration::zero()));
+
+    // No buffer has been prepared for the second block
+    EXPECT_FALSE(aggregator.append(f));
+    EXPECT_EQ(aggregator.getNumLostSamples(), 1U);
+
+    aggregator.process();
+    ASSERT_TRUE(mQueue.receive(b, outpost::time::Duration::zero()));
+    EXPECT_TRUE(b.isComplete());
+    EXPECT_EQ(b.getStartTime(),
+              (outpost::time::TimeEpochConverter<outpost::time::SpacecraftElapsedTimeEpoch,
+                                                 outpost::time::GpsEpoch>::
+                       convert(outpost::time::SpacecraftElapsedTime::afterEpoch(
+                               outpost::time::Seconds(10)))));
+    EXPECT_EQ(mPool.numberOfElements(), mPool.numberOfFreeElements() + 2U);
+
+    EXPECT_TRUE(aggregator.append(f));
+    EXPECT_EQ(mPool.numberOfElements(), mPool.numberOfFreeElements() + 2U);
+}
+
+TEST_F(DataAggregationTest, AppendDropsBlockIfNotHandedOver)
+{
+    OneTimeQueueSender ots(mQueue);
+    DataAggregator aggregator(123U, mClock, mPool, ots);
+
+    Fixpoint f = 1.5f;
+    aggregator.enable(SamplingRate::hz05, Blocksize::bs16);
+    for (size_t i = 0; i < 16U; i++)
+    {
+        EXPECT_TRUE(aggregator.append(f));
+    }
+
+    // Enabling again prepares a buffer while the hand-off slot is still occupied
+    aggregator.enable(SamplingRate::hz05, Blocksize::bs16);
+    for (size_t i = 0; i < 16U; i++)
+    {
+        EXPECT_TRUE(aggregator.append(f));
+    }
+    EXPECT_EQ(aggregator.getNumLostBlocks(), 1U);
+    EXPECT_EQ(aggregator.getNumCompletedBlocks(), 2U);
+
+    // The buffer of the dropped block is kept for the next block instead of being released
+    EXPECT_EQ(mPool.numberOfElements(), mPool.numberOfFreeElements() + 2U);
+    EXPECT_TRUE(aggregator.append(f));
+    EXPECT_EQ(mPool.numberOfElements(), mPool.numberOfFreeElements() + 2U);
+
+    aggregator.process();
+    DataBlock b;
+    EXPECT_TRUE(mQueue.receive(b, outpost::time::Duration::zero()));
+    EXPECT_FALSE(mQueue.receive(b, outpost::time::Duration::zero()));
+}
+
+TEST_F(DataAggregationTest, AppendLeavesBuffersToProcessWhenDisabled)
+{
+    OneTimeQueueSender ots(mQueue);
+    DataAggregator aggregator(123U, mClock, mPool, ots);
+
+    Fixpoint f = 1.5f;
+    aggregator.enable(SamplingRate::hz05, Blocksize::bs16);
+    for (size_t i = 0; i < 16U; i++)
+    {
+        EXPECT_TRUE(aggregator.append(f));
+    }
+
+    aggregator.enableForOneBlock(SamplingRate::hz05, Blocksize::bs16);
+    for (size_t i = 0; i < 16U; i++)
+    {
+        EXPECT_TRUE(aggregator.append(f));
+    }
+    EXPECT_FALSE(aggregator.isEnabled());
+    EXPECT_EQ(aggregator.getNumLostBlocks(), 1U);
+    EXPECT_EQ(mPool.numberOfElements(), mPool.numberOfFreeElements() + 2U);
+
+    aggregator.process();
+    DataBlock b;
+    EXPECT_TRUE(mQueue.receive(b, outpost::time::Duration::zero()));
+    b = DataBlock();
+    EXPECT_EQ(mPool.numberOfElements(), mPool.numberOfFreeElements());
+}
+
 }  // namespace data_aggregation_test
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/base/fixpoint.h>
+#include <outpost/compression/data_aggregator.h>
+#include <outpost/compression/data_aggregator_index.h>
+#include <outpost/compression/data_block_sender.h>
+#include <outpost/utils/container/reference_queue.h>
+#include <outpost/utils/container/shared_object_pool.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <unittest/time/testing_clock.h>
+
+using namespace testing;
+using namespace outpost;
+using namespace outpost::compression;
+
+namespace
+{
+class DataAggregatorIndexTest : public ::testing::Test
+{
+public:
+    DataAggregatorIndexTest() : mSender(mQueue)
+    {
+    }
+
+    virtual void
+    SetUp() override
+    {
+        mClock.setTime(
+                outpost::time::SpacecraftElapsedTime::afterEpoch(outpost::time::Duration::zero()));
+    }
+
+    outpost::utils::SharedBufferPool<1024, 4> mPool;
+    outpost::utils::ReferenceQueue<DataBlock, 4> mQueue;
+    OneTimeQueueSender mSender;
+
+    unittest::time::TestingClock mClock;
+};
+}  // namespace
+
+TEST_F(DataAggregatorIndexTest, shouldFindAggregatorsInRange)
+{
+    DataAggregator first(1000U, mClock, mPool, mSender);
+    DataAggregator last(1015U, mClock, mPool, mSender);
+    DataAggregator outside(1016U, mClock, mPool, mSender);
+    EXPECT_EQ(3U, DataAggregator::numberOfAggregators());
+
+    DataAggregatorIndex<16> index(1000U);
+    EXPECT_EQ(2U, index.addAll());
+    EXPECT_EQ(2U, index.getNumberOfAggregators());
+
+    EXPECT_EQ(&first, index.find(1000U));
+    EXPECT_EQ(&last, index.find(1015U));
+    EXPECT_EQ(nullptr, index.find(1001U));
+    EXPECT_EQ(nullptr, index.find(1016U));
+    EXPECT_EQ(nullptr, index.find(999U));
+
+    // Already part of the index
+    EXPECT_FALSE(index.add(first));
+    EXPECT_FALSE(index.add(outside));
+
+    DataAggregatorIndex<16> other(1000U);
+    DataAggregator duplicate(1000U, mClock, mPool, mSender);
+    EXPECT_FALSE(other.add(first));
+    EXPECT_TRUE(other.add(duplicate));
+    EXPECT_FALSE(index.add(duplicate));
+
+    index.remove(first);
+    EXPECT_EQ(nullptr, index.find(1000U));
+    EXPECT_EQ(1U, index.getNumberOfAggregators());
+}
+
+TEST_F(DataAggregatorIndexTest, shouldRemoveDestroyedAggregators)
+{
+    DataAggregatorIndex<4> index(10U);
+    {
+        DataAggregator aggregator(12U, mClock, mPool, mSender);
+        ASSERT_TRUE(index.add(aggregator));
+        EXPECT_EQ(&aggregator, index.find(12U));
+        EXPECT_EQ(1U, DataAggregator::numberOfAggregators());
+    }
+    EXPECT_EQ(nullptr, index.find(12U));
+    EXPECT_EQ(0U, index.getNumberOfAggregators());
+    EXPECT_EQ(0U, DataAggregator::numberOfAggregators());
+}
+
+TEST_F(DataAggregatorIndexTest, shouldPushFrameOfParameters)
+{
+    DataAggregator a(5U, mClock, mPool, mSender);
+    DataAggregator b(7U, mClock, mPool, mSender);
+    DataAggregatorIndex<8> index;
+    ASSERT_EQ(2U, index.addAll());
+
+    a.enable(SamplingRate::hz1, Blocksize::bs16);
+    b.enable(SamplingRate::hz1, Blocksize::bs16);
+
+    const uint16_t ids[] = {5U, 6U, 7U, 5U};
+    const Fixpoint values[] = {Fixpoint(1), Fixpoint(2), Fixpoint(3), Fixpoint(4)};
+    EXPECT_EQ(3U, index.push(outpost::asSlice(ids), outpost::asSlice(values)));
+    EXPECT_EQ(2U, a.getNumOverallSamples());
+    EXPECT_EQ(1U, b.getNumOverallSamples());
+
+    EXPECT_TRUE(index.push(7U, Fixpoint(5)));
+    EXPECT_FALSE(index.push(6U, Fixpoint(5)));
+    EXPECT_EQ(2U, b.getNumOverallSamples());
+
+    // Only complete pairs are pushed
+    EXPECT_EQ(1U, index.push(outpost::asSlice(ids).first(1), outpost::asSlice(values)));
+}
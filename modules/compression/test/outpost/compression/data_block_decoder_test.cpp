@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/base/fixpoint.h>
+#include <outpost/compression/data_block.h>
+#include <outpost/compression/data_block_decoder.h>
+#include <outpost/compression/nls_encoder.h>
+#include <outpost/compression/rice_encoder.h>
+#include <outpost/utils/container/shared_object_pool.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace outpost;
+using namespace outpost::compression;
+
+namespace
+{
+class DataBlockDecoderTest : public ::testing::Test
+{
+public:
+    DataBlockDecoderTest() : mDecoder(mEncoder)
+    {
+    }
+
+    bool
+    encodeBlock(DataBlock& encoded, Blocksize bs, BlockEncoder& encoder, bool transform)
+    {
+        outpost::utils::SharedBufferPointer p;
+        outpost::utils::SharedBufferPointer pOut;
+        if (!mPool.allocate(p) || !mPool.allocate(pOut))
+        {
+            return false;
+        }
+
+        DataBlock block(p,
+                        42U,
+                        outpost::time::GpsTime::afterEpoch(outpost::time::Seconds(1000U)),
+                        SamplingRate::hz10,
+                        bs);
+        for (size_t i = 0; i < toUInt(bs); i++)
+        {
+            mSamples[i] = Fixpoint(static_cast<int16_t>((i * 37) % 200 - 100));
+            block.push(mSamples[i]);
+        }
+        if (transform && !block.applyWaveletTransform())
+        {
+            return false;
+        }
+
+        encoded = DataBlock(
+                pOut, block.getParameterId(), block.getStartTime(), block.getSamplingRate(), bs);
+        return block.encode(encoded, encoder);
+    }
+
+    NLSEncoder mEncoder;
+    DataBlockDecoder mDecoder;
+    outpost::utils::SharedBufferPool<4096 * sizeof(Fixpoint) + DataBlock::headerSize, 4> mPool;
+    Fixpoint mSamples[4096];
+    Fixpoint mDecoded[4096];
+};
+
+TEST_F(DataBlockDecoderTest, shouldReadHeader)
+{
+    DataBlock encoded;
+    ASSERT_TRUE(encodeBlock(encoded, Blocksize::bs128, mEncoder, true));
+
+    DataBlockDecoder::Header header;
+    ASSERT_TRUE(DataBlockDecoder::readHeader(encoded.getEncodedData(), header));
+    EXPECT_EQ(CompressionScheme::waveletNLS, header.mScheme);
+    EXPECT_EQ(42U, header.mParameterId);
+    EXPECT_EQ(outpost::time::GpsTime::afterEpoch(outpost::time::Seconds(1000U)),
+              header.mStartTime);
+    EXPECT_EQ(SamplingRate::hz10, header.mSamplingRate);
+    EXPECT_EQ(Blocksize::bs128, header.mBlocksize);
+
+    EXPECT_FALSE(DataBlockDecoder::readHeader(encoded.getEncodedData().first(11), header));
+}
+
+TEST_F(DataBlockDecoderTest, shouldReconstructWaveletNLSBlocks)
+{
+    const Blocksize sizes[] = {Blocksize::bs16,
+                               Blocksize::bs128,
+                               Blocksize::bs256,
+                               Blocksize::bs512,
+                               Blocksize::bs1024,
+                               Blocksize::bs2048,
+                               Blocksize::bs4096};
+    for (Blocksize bs : sizes)
+    {
+        DataBlock encoded;
+        ASSERT_TRUE(encodeBlock(encoded, bs, mEncoder, true));
+
+        DataBlockDecoder::Header header;
+        outpost::Slice<Fixpoint> decoded =
+                mDecoder.decode(encoded.getEncodedData(), outpost::asSlice(mDecoded), header);
+        ASSERT_EQ(toUInt(bs), decoded.getNumberOfElements());
+        for (size_t i = 0; i < decoded.getNumberOfElements(); i++)
+        {
+            EXPECT_NEAR(static_cast<double>(mSamples[i]), static_cast<double>(decoded[i]), 2.0)
+                    << "at index " << i << " of " << toUInt(bs);
+        }
+    }
+}
+
+TEST_F(DataBlockDecoderTest, shouldReconstructRiceBlocksLosslessly)
+{
+    RiceEncoder rice;
+    DataBlock encoded;
+    ASSERT_TRUE(encodeBlock(encoded, Blocksize::bs512, rice, false));
+
+    DataBlockDecoder::Header header;
+    outpost::Slice<Fixpoint> decoded =
+            mDecoder.decode(encoded.getEncodedData(), outpost::asSlice(mDecoded), header);
+    EXPECT_EQ(CompressionScheme::rice, header.mScheme);
+    ASSERT_EQ(512U, decoded.getNumberOfElements());
+    for (size_t i = 0; i < decoded.getNumberOfElements(); i++)
+    {
+        EXPECT_EQ(mSamples[i], decoded[i]);
+    }
+}
+
+TEST_F(DataBlockDecoderTest, shouldRejectInsufficientBuffers)
+{
+    DataBlock encoded;
+    ASSERT_TRUE(encodeBlock(encoded, Blocksize::bs256, mEncoder, true));
+
+    DataBlockDecoder::Header header;
+    outpost::Slice<Fixpoint> tooSmall = outpost::asSlice(mDecoded).first(128);
+    EXPECT_EQ(0U,
+              mDecoder.decode(encoded.getEncodedData(), tooSmall, header).getNumberOfElements());
+
+    GenericNLSEncoder<128> smallEncoder;
+    DataBlockDecoder smallDecoder(smallEncoder);
+    EXPECT_EQ(0U,
+              smallDecoder.decode(encoded.getEncodedData(), outpost::asSlice(mDecoded), header)
+                      .getNumberOfElements());
+}
+
+}  // namespace
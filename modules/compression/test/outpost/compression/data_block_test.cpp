@@ -10,6 +10,7 @@
 #include <outpost/base/fixpoint.h>
 #include <outpost/compression/data_block.h>
 #include <outpost/compression/nls_encoder.h>
+#include <outpost/utils/container/arena.h>
 #include <outpost/utils/container/shared_buffer.h>
 #include <outpost/utils/container/shared_object_pool.h>
 
@@ -190,6 +191,59 @@ TEST_F(DataBlockTest, GetCoefficients)
     EXPECT_EQ(coefficients.getNumberOfElements(), 16U);
 }
 
+TEST_F(DataBlockTest, shouldTransformBatchLikeSingleBlocks)
+{
+    constexpr size_t numberOfBlocks = 3;
+    DataBlock batch[numberOfBlocks];
+    DataBlock single[numberOfBlocks];
+    DataBlock* group[numberOfBlocks];
+    for (size_t c = 0; c < numberOfBlocks; c++)
+    {
+        outpost::utils::SharedBufferPointer p;
+        ASSERT_TRUE(mPool.allocate(p));
+        batch[c] = DataBlock(p,
+                             123U,
+                             outpost::time::GpsTime::afterEpoch(outpost::time::Hours(3U)),
+                             SamplingRate::hz05,
+                             Blocksize::bs16);
+        ASSERT_TRUE(mPool.allocate(p));
+        single[c] = DataBlock(p,
+                              123U,
+                              outpost::time::GpsTime::afterEpoch(outpost::time::Hours(3U)),
+                              SamplingRate::hz05,
+                              Blocksize::bs16);
+        for (int32_t i = 0; i < 16; i++)
+        {
+            const Fixpoint sample = Fixpoint((i * 37 + static_cast<int32_t>(c) * 101) % 67 - 30);
+            batch[c].push(sample);
+            single[c].push(sample);
+        }
+        group[c] = &batch[c];
+    }
+
+    outpost::utils::ArenaStorage<DataBlock::getBatchScratchSize(numberOfBlocks, 16)> scratch;
+    ASSERT_TRUE(DataBlock::applyWaveletTransform(
+            outpost::Slice<DataBlock* const>(group), scratch));
+    EXPECT_EQ(0U, scratch.getUsedBytes());
+
+    for (size_t c = 0; c < numberOfBlocks; c++)
+    {
+        ASSERT_TRUE(single[c].applyWaveletTransform());
+        ASSERT_TRUE(batch[c].isTransformed());
+        outpost::Slice<int16_t> expected = single[c].getCoefficients();
+        outpost::Slice<int16_t> actual = batch[c].getCoefficients();
+        ASSERT_EQ(expected.getNumberOfElements(), actual.getNumberOfElements());
+        for (size_t i = 0; i < expected.getNumberOfElements(); i++)
+        {
+            EXPECT_EQ(expected[i], actual[i]) << c << " " << i;
+        }
+    }
+
+    // Transformed blocks are rejected
+    EXPECT_FALSE(
+            DataBlock::applyWaveletTransform(outpost::Slice<DataBlock* const>(group), scratch));
+}
+
 TEST_F(DataBlockTest, Encode)
 {
     outpost::compression::NLSEncoder encoder;
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/base/fixpoint.h>
+#include <outpost/compression/data_block.h>
+#include <outpost/compression/data_processor_pool.h>
+#include <outpost/utils/container/reference_queue.h>
+#include <outpost/utils/container/shared_object_pool.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace outpost;
+using namespace outpost::compression;
+
+namespace
+{
+class DataProcessorPoolTest : public ::testing::Test
+{
+public:
+    bool
+    sendBlock(uint16_t parameterId, Blocksize blocksize, size_t numberOfSamples)
+    {
+        outpost::utils::SharedBufferPointer p;
+        if (!mPool.allocate(p))
+        {
+            return false;
+        }
+
+        DataBlock block(p,
+                        parameterId,
+                        outpost::time::GpsTime::afterEpoch(outpost::time::Hours(3U)),
+                        SamplingRate::hz05,
+                        blocksize);
+        for (size_t i = 0; i < numberOfSamples; i++)
+        {
+            block.push(outpost::Fixpoint(static_cast<int32_t>(i % 37)));
+        }
+        return mInputQueue.send(block);
+    }
+
+    outpost::utils::SharedBufferPool<16384, 20> mPool;
+    outpost::utils::ReferenceQueue<DataBlock, 8> mInputQueue;
+    outpost::utils::ReferenceQueue<DataBlock, 8> mOutputQueue;
+};
+}  // namespace
+
+TEST_F(DataProcessorPoolTest, shouldRegisterWorkers)
+{
+    DataProcessorPool pool(mPool, mInputQueue, mOutputQueue);
+    EXPECT_EQ(0U, pool.getNumberOfWorkers());
+    EXPECT_FALSE(pool.isEnabled());
+    {
+        DataProcessorWorker worker1(pool, 123U);
+        DataProcessorWorker worker2(pool, 123U);
+        EXPECT_EQ(2U, pool.getNumberOfWorkers());
+    }
+    EXPECT_EQ(0U, pool.getNumberOfWorkers());
+
+    pool.enable();
+    EXPECT_TRUE(pool.isEnabled());
+    pool.disable();
+    EXPECT_FALSE(pool.isEnabled());
+}
+
+TEST_F(DataProcessorPoolTest, shouldCountBlocksOfAllWorkers)
+{
+    DataProcessorPool pool(mPool, mInputQueue, mOutputQueue, 1U, outpost::time::Duration::zero());
+    DataProcessorWorker worker1(pool, 123U);
+    DataProcessorWorker worker2(pool, 123U);
+
+    // Invalid block is released without blocking the following ones
+    mInputQueue.send(DataBlock());
+    ASSERT_TRUE(sendBlock(1U, Blocksize::bs16, 16U));
+    ASSERT_TRUE(sendBlock(2U, Blocksize::bs16, 16U));
+
+    worker1.processSingleBlock(outpost::time::Duration::zero());
+    worker2.processSingleBlock(outpost::time::Duration::zero());
+    worker1.processSingleBlock(outpost::time::Duration::zero());
+    worker2.processSingleBlock(outpost::time::Duration::zero());
+
+    EXPECT_EQ(3U, pool.getNumberOfReceivedBlocks());
+    EXPECT_EQ(2U, pool.getNumberOfProcessedBlocks());
+    EXPECT_EQ(2U, pool.getNumberOfForwardedBlocks());
+    EXPECT_EQ(0U, pool.getNumberOfLostBlocks());
+
+    DataBlock b;
+    ASSERT_TRUE(mOutputQueue.receive(b, outpost::time::Duration::zero()));
+    EXPECT_TRUE(b.isEncoded());
+    EXPECT_EQ(1U, b.getParameterId());
+    ASSERT_TRUE(mOutputQueue.receive(b, outpost::time::Duration::zero()));
+    EXPECT_EQ(2U, b.getParameterId());
+    EXPECT_FALSE(mOutputQueue.receive(b, outpost::time::Duration::zero()));
+
+    pool.resetCounters();
+    EXPECT_EQ(0U, pool.getNumberOfReceivedBlocks());
+    EXPECT_EQ(0U, pool.getNumberOfProcessedBlocks());
+}
+
+TEST_F(DataProcessorPoolTest, shouldPreserveOrderWithConcurrentWorkers)
+{
+    DataProcessorPool pool(mPool, mInputQueue, mOutputQueue);
+    DataProcessorWorker worker1(pool, 123U);
+    DataProcessorWorker worker2(pool, 123U);
+    DataProcessorWorker worker3(pool, 123U);
+
+    pool.enable();
+    worker1.start();
+    worker2.start();
+    worker3.start();
+
+    // Large and small blocks alternate so that later blocks are finished first
+    const size_t numberOfBlocks = 12;
+    size_t received = 0;
+    DataBlock b;
+    for (size_t i = 0; i < numberOfBlocks; i++)
+    {
+        if (i % 2 == 0)
+        {
+            ASSERT_TRUE(sendBlock(i / 2, Blocksize::bs2048, 2048U));
+        }
+        else
+        {
+            ASSERT_TRUE(sendBlock(i / 2, Blocksize::bs16, 16U));
+        }
+
+        if (i >= 4)
+        {
+            ASSERT_TRUE(mOutputQueue.receive(b, outpost::time::Seconds(10)));
+            EXPECT_EQ(received / 2, b.getParameterId());
+            EXPECT_EQ((received % 2 == 0) ? Blocksize::bs2048 : Blocksize::bs16,
+                      b.getBlocksize());
+            received++;
+        }
+    }
+    while (received < numberOfBlocks)
+    {
+        ASSERT_TRUE(mOutputQueue.receive(b, outpost::time::Seconds(10)));
+        EXPECT_EQ(received / 2, b.getParameterId());
+        received++;
+    }
+
+    // The counter is updated after the block has been sent
+    for (size_t i = 0; i < 100 && pool.getNumberOfForwardedBlocks() < numberOfBlocks; i++)
+    {
+        outpost::rtos::Thread::sleep(outpost::time::Milliseconds(10));
+    }
+    EXPECT_EQ(numberOfBlocks, pool.getNumberOfForwardedBlocks());
+    EXPECT_EQ(0U, pool.getNumberOfLostBlocks());
+}
@@ -9,7 +9,11 @@
 
 #include <outpost/base/fixpoint.h>
 #include <outpost/compression/data_block.h>
+#include <outpost/compression/data_block_sender.h>
 #include <outpost/compression/data_processor_thread.h>
+#include <outpost/compression/nls_encoder.h>
+#include <outpost/compression/remote_encoder.h>
+#include <outpost/compression/scheme_selector.h>
 #include <outpost/utils/container/reference_queue.h>
 #include <outpost/utils/container/shared_object_pool.h>
 
@@ -18,12 +22,84 @@
 
 #include <unittest/time/testing_clock.h>
 
+#include <deque>
+
 using namespace testing;
 using namespace outpost;
 using namespace outpost::compression;
 
 namespace data_aggregation_test
 {
+class RemoteEncoderStub : public RemoteEncoder
+{
+public:
+    RemoteEncoderStub(outpost::utils::SharedBufferPoolBase& pool, size_t window) :
+        mPool(pool), mWindow(window)
+    {
+    }
+
+    bool
+    submit(const DataBlock& block, CompressionScheme) override
+    {
+        if (mSubmitted.size() >= mWindow)
+        {
+            return false;
+        }
+        mSubmitted.push_back(block);
+        return true;
+    }
+
+    bool
+    receive(DataBlock& block, outpost::time::Duration) override
+    {
+        if (mReturned.empty())
+        {
+            return false;
+        }
+        block = mReturned.front();
+        mReturned.pop_front();
+        return true;
+    }
+
+    size_t
+    getNumberOfPendingBlocks() const override
+    {
+        return mSubmitted.size();
+    }
+
+    // Compresses the oldest submitted block like the remote node would
+    bool
+    encodeNext()
+    {
+        DataBlock b = mSubmitted.front();
+        mSubmitted.pop_front();
+
+        outpost::utils::SharedBufferPointer p;
+        mPool.allocate(p);
+        DataBlock encoded(
+                p, b.getParameterId(), b.getStartTime(), b.getSamplingRate(), b.getBlocksize());
+        if (!b.applyWaveletTransform() || !b.encode(encoded, mEncoder))
+        {
+            return false;
+        }
+        mReturned.push_back(encoded);
+        return true;
+    }
+
+    void
+    failNext()
+    {
+        mReturned.push_back(mSubmitted.front());
+        mSubmitted.pop_front();
+    }
+
+    outpost::utils::SharedBufferPoolBase& mPool;
+    const size_t mWindow;
+    NLSEncoder mEncoder;
+    std::deque<DataBlock> mSubmitted;
+    std::deque<DataBlock> mReturned;
+};
+
 class DataProcessorThreadTest : public ::testing::Test
 {
 public:
@@ -191,4 +267,219 @@ TEST_F(DataProcessorThreadTest, processMultipleBlocks)
     EXPECT_EQ(thread.getNumberOfLostBlocks(), 0U);
 }
 
+TEST_F(DataProcessorThreadTest, processBlockWithSelectedScheme)
+{
+    DataProcessorThread thread(
+            123U, mPool, mInputQueue, mOutputQueue, 2U, outpost::time::Duration::zero());
+    CompressionSchemeSelector selector;
+    thread.setSchemeSelector(&selector);
+
+    for (int32_t step = 1; step <= 1000; step += 999)
+    {
+        outpost::utils::SharedBufferPointer p;
+        ASSERT_TRUE(mPool.allocate(p));
+
+        outpost::compression::DataBlock block(
+                p,
+                123U,
+                outpost::time::GpsTime::afterEpoch(outpost::time::Hours(3U)),
+                outpost::compression::SamplingRate::hz05,
+                outpost::compression::Blocksize::bs16);
+
+        for (int32_t i = 0; i < 16; i++)
+        {
+            block.push(outpost::Fixpoint((i % 2 == 0) ? i * step : -i * step));
+        }
+        mInputQueue.send(block);
+
+        thread.processSingleBlock(outpost::time::Duration::zero());
+    }
+    EXPECT_EQ(thread.getNumberOfForwardedBlocks(), 2U);
+
+    DataBlock b;
+    ASSERT_TRUE(mOutputQueue.receive(b, outpost::time::Duration::zero()));
+    EXPECT_EQ(CompressionScheme::rice, b.getCompressionScheme());
+    ASSERT_TRUE(mOutputQueue.receive(b, outpost::time::Duration::zero()));
+    EXPECT_EQ(CompressionScheme::waveletNLS, b.getCompressionScheme());
+}
+
+TEST_F(DataProcessorThreadTest, processBatchLikeSingleBlocks)
+{
+    DataProcessorThread thread(
+            123U, mPool, mInputQueue, mOutputQueue, 2U, outpost::time::Duration::zero());
+
+    // Two blocks of each size, interleaved, to be transformed in two batches
+    const Blocksize sizes[] = {
+            Blocksize::bs16, Blocksize::bs128, Blocksize::bs16, Blocksize::bs128};
+    uint8_t expected[4][1024];
+    size_t expectedLength[4];
+    for (size_t round = 0; round < 2; round++)
+    {
+        for (size_t n = 0; n < 4; n++)
+        {
+            outpost::utils::SharedBufferPointer p;
+            ASSERT_TRUE(mPool.allocate(p));
+            DataBlock block(p,
+                            static_cast<uint16_t>(n),
+                            outpost::time::GpsTime::afterEpoch(outpost::time::Hours(3U)),
+                            SamplingRate::hz05,
+                            sizes[n]);
+            for (size_t i = 0; i < toUInt(sizes[n]); i++)
+            {
+                block.push(outpost::Fixpoint(static_cast<int32_t>((i * 37 + n * 11) % 97) - 48));
+            }
+            ASSERT_TRUE(mInputQueue.send(block));
+        }
+
+        if (round == 0)
+        {
+            for (size_t n = 0; n < 4; n++)
+            {
+                thread.processSingleBlock(outpost::time::Duration::zero());
+            }
+        }
+        else
+        {
+            thread.processBatch(outpost::time::Duration::zero());
+        }
+        EXPECT_EQ(thread.getNumberOfForwardedBlocks(), 4U * (round + 1));
+
+        for (size_t n = 0; n < 4; n++)
+        {
+            DataBlock b;
+            ASSERT_TRUE(mOutputQueue.receive(b, outpost::time::Duration::zero()));
+            EXPECT_EQ(n, b.getParameterId());
+            outpost::Slice<uint8_t> data = b.getEncodedData();
+            if (round == 0)
+            {
+                expectedLength[n] = data.getNumberOfElements();
+                memcpy(expected[n], data.begin(), expectedLength[n]);
+            }
+            else
+            {
+                ASSERT_EQ(expectedLength[n], data.getNumberOfElements());
+                EXPECT_EQ(0, memcmp(expected[n], data.begin(), expectedLength[n])) << n;
+            }
+        }
+    }
+}
+
+TEST_F(DataProcessorThreadTest, spillBlocksIfOutputQueueIsFull)
+{
+    outpost::utils::ReferenceQueue<DataBlock, 1> outputQueue;
+    outpost::utils::ReferenceQueue<DataBlock, 2> spillQueue;
+    OneTimeQueueSender spill(spillQueue);
+
+    DataProcessorThread thread(
+            123U, mPool, mInputQueue, outputQueue, 2U, outpost::time::Milliseconds(1));
+    thread.setSpillSender(&spill);
+
+    for (size_t n = 0; n < 4; n++)
+    {
+        outpost::utils::SharedBufferPointer p;
+        ASSERT_TRUE(mPool.allocate(p));
+        DataBlock block(p,
+                        static_cast<uint16_t>(n),
+                        outpost::time::GpsTime::afterEpoch(outpost::time::Hours(3U)),
+                        SamplingRate::hz05,
+                        Blocksize::bs16);
+        for (int32_t i = 0; i < 16; i++)
+        {
+            block.push(outpost::Fixpoint(i));
+        }
+        ASSERT_TRUE(mInputQueue.send(block));
+    }
+    thread.processBatch(outpost::time::Duration::zero());
+
+    EXPECT_EQ(thread.getNumberOfProcessedBlocks(), 4U);
+    EXPECT_EQ(thread.getNumberOfForwardedBlocks(), 1U);
+    EXPECT_EQ(thread.getNumberOfSpilledBlocks(), 2U);
+    EXPECT_EQ(thread.getNumberOfLostBlocks(), 1U);
+
+    DataBlock b;
+    ASSERT_TRUE(outputQueue.receive(b, outpost::time::Duration::zero()));
+    EXPECT_EQ(0U, b.getParameterId());
+    ASSERT_TRUE(spillQueue.receive(b, outpost::time::Duration::zero()));
+    EXPECT_EQ(1U, b.getParameterId());
+    EXPECT_TRUE(b.isEncoded());
+}
+
+TEST_F(DataProcessorThreadTest, processBlockWithinRateBudget)
+{
+    DataProcessorThread thread(
+            123U, mPool, mInputQueue, mOutputQueue, 2U, outpost::time::Duration::zero());
+    const size_t budget = Bitstream::headerSize + 6U;
+    thread.setRateControl(budget);
+
+    outpost::utils::SharedBufferPointer p;
+    ASSERT_TRUE(mPool.allocate(p));
+
+    outpost::compression::DataBlock block(
+            p,
+            123U,
+            outpost::time::GpsTime::afterEpoch(outpost::time::Hours(3U)),
+            outpost::compression::SamplingRate::hz05,
+            outpost::compression::Blocksize::bs16);
+
+    for (int32_t i = 0; i < 16; i++)
+    {
+        block.push(outpost::Fixpoint((i * 7919) % 1000 - 500));
+    }
+    mInputQueue.send(block);
+
+    thread.processSingleBlock(outpost::time::Duration::zero());
+    ASSERT_EQ(thread.getNumberOfForwardedBlocks(), 1U);
+
+    ASSERT_TRUE(mOutputQueue.receive(block, outpost::time::Duration::zero()));
+    EXPECT_EQ(CompressionScheme::waveletNLS, block.getCompressionScheme());
+    EXPECT_EQ(block.getEncodedData().getNumberOfElements(), DataBlock::headerSize + budget);
+}
+
+TEST_F(DataProcessorThreadTest, offloadBlocksToRemoteEncoder)
+{
+    DataProcessorThread thread(
+            123U, mPool, mInputQueue, mOutputQueue, 2U, outpost::time::Duration::zero());
+    RemoteEncoderStub remote(mPool, 2U);
+    thread.setRemoteEncoder(&remote);
+
+    for (uint16_t n = 0; n < 3; n++)
+    {
+        outpost::utils::SharedBufferPointer p;
+        ASSERT_TRUE(mPool.allocate(p));
+        DataBlock block(p,
+                        n,
+                        outpost::time::GpsTime::afterEpoch(outpost::time::Hours(3U)),
+                        SamplingRate::hz05,
+                        Blocksize::bs16);
+        for (int32_t i = 0; i < 16; i++)
+        {
+            block.push(outpost::Fixpoint(i * n));
+        }
+        ASSERT_TRUE(mInputQueue.send(block));
+    }
+
+    // The third block does not fit into the window and is compressed locally
+    thread.processBatch(outpost::time::Duration::zero());
+    EXPECT_EQ(thread.getNumberOfOffloadedBlocks(), 2U);
+    EXPECT_EQ(thread.getNumberOfForwardedBlocks(), 1U);
+    EXPECT_EQ(remote.getNumberOfPendingBlocks(), 2U);
+
+    // The remote fails for the second block, which falls back to local compression
+    ASSERT_TRUE(remote.encodeNext());
+    remote.failNext();
+    thread.processBatch(outpost::time::Duration::zero());
+    EXPECT_EQ(thread.getNumberOfProcessedBlocks(), 3U);
+    EXPECT_EQ(thread.getNumberOfForwardedBlocks(), 3U);
+    EXPECT_EQ(thread.getNumberOfLostBlocks(), 0U);
+
+    for (uint16_t parameterId : {2U, 0U, 1U})
+    {
+        DataBlock b;
+        ASSERT_TRUE(mOutputQueue.receive(b, outpost::time::Duration::zero()));
+        EXPECT_EQ(parameterId, b.getParameterId());
+        EXPECT_TRUE(b.isEncoded());
+        EXPECT_EQ(CompressionScheme::waveletNLS, b.getCompressionScheme());
+    }
+}
+
 }  // namespace data_aggregation_test
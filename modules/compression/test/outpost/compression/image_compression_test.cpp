@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/compression/image_compression_worker.h>
+#include <outpost/compression/image_encoder.h>
+#include <outpost/compression/image_strip.h>
+#include <outpost/compression/image_wavelet.h>
+#include <outpost/utils/container/arena.h>
+#include <outpost/utils/container/reference_queue.h>
+#include <outpost/utils/container/shared_object_pool.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+using namespace outpost;
+using namespace outpost::compression;
+
+namespace
+{
+constexpr size_t width = 32;
+constexpr size_t height = 16;
+
+uint16_t
+getPixel(size_t row, size_t column)
+{
+    // Smooth gradient with some texture
+    return static_cast<uint16_t>(1000 + 20 * row + 7 * column + ((row * 31 + column * 17) % 23));
+}
+
+class ImageCompressionTest : public ::testing::Test
+{
+public:
+    void
+    SetUp() override
+    {
+        for (size_t row = 0; row < height; row++)
+        {
+            for (size_t column = 0; column < width; column++)
+            {
+                mImage[row * width + column] = getPixel(row, column);
+            }
+        }
+    }
+
+    uint64_t
+    getSquaredError(const int32_t* decoded) const
+    {
+        uint64_t error = 0;
+        for (size_t i = 0; i < width * height; i++)
+        {
+            const int64_t d = decoded[i] - mImage[i];
+            error += static_cast<uint64_t>(d * d);
+        }
+        return error;
+    }
+
+    int32_t mImage[width * height];
+    outpost::utils::ArenaStorage<ImageWavelet::getScratchSize(width, height)> mScratch;
+};
+}  // namespace
+
+TEST_F(ImageCompressionTest, transformShouldBeReversible)
+{
+    for (ImageFilter filter : {ImageFilter::integer53, ImageFilter::integer97})
+    {
+        int32_t data[width * height];
+        memcpy(data, mImage, sizeof(data));
+
+        ASSERT_TRUE(ImageWavelet::forwardTransform(
+                outpost::asSlice(data), width, height, 3, filter, mScratch));
+        EXPECT_EQ(0U, mScratch.getUsedBytes());
+        EXPECT_NE(0, memcmp(data, mImage, sizeof(data)));
+
+        ASSERT_TRUE(ImageWavelet::backwardTransform(
+                outpost::asSlice(data), width, height, 3, filter, mScratch));
+        for (size_t i = 0; i < width * height; i++)
+        {
+            EXPECT_EQ(mImage[i], data[i]) << "at index " << i;
+        }
+    }
+}
+
+TEST_F(ImageCompressionTest, transformOfConstantImageShouldOnlyHaveDcCoefficients)
+{
+    for (ImageFilter filter : {ImageFilter::integer53, ImageFilter::integer97})
+    {
+        int32_t data[width * height];
+        for (size_t i = 0; i < width * height; i++)
+        {
+            data[i] = 500;
+        }
+
+        ASSERT_TRUE(ImageWavelet::forwardTransform(
+                outpost::asSlice(data), width, height, 3, filter, mScratch));
+        for (size_t row = 0; row < height; row++)
+        {
+            for (size_t column = 0; column < width; column++)
+            {
+                const bool dc = (row < height / 8) && (column < width / 8);
+                EXPECT_EQ(dc ? 500 : 0, data[row * width + column]);
+            }
+        }
+    }
+}
+
+TEST_F(ImageCompressionTest, transformShouldRejectInvalidDimensions)
+{
+    int32_t data[width * height];
+    EXPECT_FALSE(ImageWavelet::forwardTransform(
+            outpost::asSlice(data), width, height, 0, ImageFilter::integer53, mScratch));
+    EXPECT_FALSE(ImageWavelet::forwardTransform(
+            outpost::asSlice(data), width, height, 5, ImageFilter::integer53, mScratch));
+    EXPECT_FALSE(ImageWavelet::forwardTransform(
+            outpost::asSlice(data), width / 2, height, 3, ImageFilter::integer53, mScratch));
+
+    outpost::utils::ArenaStorage<16> small;
+    EXPECT_FALSE(ImageWavelet::forwardTransform(
+            outpost::asSlice(data), width, height, 3, ImageFilter::integer53, small));
+}
+
+TEST_F(ImageCompressionTest, bitplaneEncodingShouldBeLossless)
+{
+    int32_t coefficients[width * height];
+    memcpy(coefficients, mImage, sizeof(coefficients));
+    ASSERT_TRUE(ImageWavelet::forwardTransform(
+            outpost::asSlice(coefficients), width, height, 3, ImageFilter::integer97, mScratch));
+
+    uint8_t buffer[4096];
+    const size_t length = ImageBitplaneEncoder::encode(
+            outpost::asSlice(coefficients), width, height, outpost::asSlice(buffer));
+    ASSERT_GT(length, 0U);
+    // Raw pixels would need 16 bits each
+    EXPECT_LT(length, width * height * 2);
+
+    int32_t decoded[width * height];
+    ASSERT_TRUE(ImageBitplaneEncoder::decode(
+            outpost::asSlice(buffer).first(length), width, height, outpost::asSlice(decoded)));
+    for (size_t i = 0; i < width * height; i++)
+    {
+        EXPECT_EQ(coefficients[i], decoded[i]) << "at index " << i;
+    }
+}
+
+TEST_F(ImageCompressionTest, truncatedBitstreamShouldReduceQuality)
+{
+    int32_t coefficients[width * height];
+    memcpy(coefficients, mImage, sizeof(coefficients));
+    ASSERT_TRUE(ImageWavelet::forwardTransform(
+            outpost::asSlice(coefficients), width, height, 3, ImageFilter::integer53, mScratch));
+
+    uint8_t buffer[4096];
+    const size_t length = ImageBitplaneEncoder::encode(
+            outpost::asSlice(coefficients), width, height, outpost::asSlice(buffer));
+    ASSERT_GT(length, 0U);
+
+    uint64_t previousError = UINT64_MAX;
+    for (size_t budget : {length / 4, length / 2, length})
+    {
+        uint8_t truncated[4096];
+        ASSERT_EQ(budget,
+                  ImageBitplaneEncoder::encode(outpost::asSlice(coefficients),
+                                               width,
+                                               height,
+                                               outpost::asSlice(truncated).first(budget)));
+
+        int32_t decoded[width * height];
+        ASSERT_TRUE(ImageBitplaneEncoder::decode(outpost::asSlice(truncated).first(budget),
+                                                 width,
+                                                 height,
+                                                 outpost::asSlice(decoded)));
+        ASSERT_TRUE(ImageWavelet::backwardTransform(
+                outpost::asSlice(decoded), width, height, 3, ImageFilter::integer53, mScratch));
+
+        const uint64_t error = getSquaredError(decoded);
+        EXPECT_LT(error, previousError);
+        previousError = error;
+    }
+    EXPECT_EQ(0U, previousError);
+
+    // Not even the DC coefficients fit
+    EXPECT_EQ(0U,
+              ImageBitplaneEncoder::encode(outpost::asSlice(coefficients),
+                                           width,
+                                           height,
+                                           outpost::asSlice(buffer).first(2)));
+}
+
+TEST_F(ImageCompressionTest, shouldCompressStripsOfImage)
+{
+    constexpr uint16_t stripHeight = 8;
+    outpost::utils::SharedBufferPool<4096, 8> pool;
+    outpost::utils::ReferenceQueue<ImageStrip, 4> stripQueue;
+    outpost::utils::ReferenceQueue<ImageStrip, 4> encodedQueue;
+
+    ImageStripCollector collector(pool, stripQueue, width, stripHeight);
+    ImageCompressionWorker worker1(
+            123U, pool, stripQueue, encodedQueue, mScratch, ImageFilter::integer97);
+    outpost::utils::ArenaStorage<ImageWavelet::getScratchSize(width, stripHeight)> scratch;
+    ImageCompressionWorker worker2(
+            123U, pool, stripQueue, encodedQueue, scratch, ImageFilter::integer97);
+
+    // Two complete strips and one which has to be filled up
+    constexpr size_t numberOfLines = 2 * stripHeight + 3;
+    collector.startImage(7U);
+    for (size_t row = 0; row < numberOfLines; row++)
+    {
+        uint16_t line[width];
+        for (size_t column = 0; column < width; column++)
+        {
+            line[column] = getPixel(row, column);
+        }
+        EXPECT_TRUE(collector.pushLine(outpost::asSlice(line)));
+    }
+    EXPECT_EQ(2U, collector.getNumberOfSentStrips());
+    EXPECT_TRUE(collector.finishImage());
+    EXPECT_EQ(3U, collector.getNumberOfSentStrips());
+    EXPECT_EQ(0U, collector.getNumberOfLostLines());
+
+    EXPECT_TRUE(worker1.processSingleStrip(outpost::time::Duration::zero()));
+    EXPECT_TRUE(worker2.processSingleStrip(outpost::time::Duration::zero()));
+    EXPECT_TRUE(worker1.processSingleStrip(outpost::time::Duration::zero()));
+    EXPECT_FALSE(worker2.processSingleStrip(outpost::time::Duration::zero()));
+    EXPECT_EQ(0U, worker1.getNumberOfLostStrips());
+    EXPECT_EQ(0U, worker2.getNumberOfLostStrips());
+
+    for (uint16_t i = 0; i < 3; i++)
+    {
+        ImageStrip encoded;
+        ASSERT_TRUE(encodedQueue.receive(encoded, outpost::time::Duration::zero()));
+        ASSERT_TRUE(encoded.isEncoded());
+
+        ImageStripHeader header;
+        int32_t pixels[width * stripHeight];
+        ASSERT_TRUE(ImageStrip::decode(
+                encoded.getEncodedData(), header, outpost::asSlice(pixels), mScratch));
+        EXPECT_EQ(7U, header.mImageId);
+        EXPECT_EQ(i, header.mStripIndex);
+        EXPECT_EQ(width, header.mWidth);
+        EXPECT_EQ(stripHeight, header.mHeight);
+        EXPECT_EQ(ImageFilter::integer97, header.mFilter);
+
+        for (size_t row = 0; row < stripHeight; row++)
+        {
+            size_t imageRow = i * stripHeight + row;
+            imageRow = (imageRow < numberOfLines) ? imageRow : (numberOfLines - 1);
+            for (size_t column = 0; column < width; column++)
+            {
+                EXPECT_EQ(getPixel(imageRow, column), pixels[row * width + column]);
+            }
+        }
+    }
+    EXPECT_EQ(pool.numberOfElements(), pool.numberOfFreeElements());
+}
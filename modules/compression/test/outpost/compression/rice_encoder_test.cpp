@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/base/fixpoint.h>
+#include <outpost/compression/data_block.h>
+#include <outpost/compression/rice_encoder.h>
+#include <outpost/compression/scheme_selector.h>
+#include <outpost/utils/container/shared_object_pool.h>
+#include <outpost/utils/storage/bitstream.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace outpost;
+using namespace outpost::compression;
+
+namespace
+{
+constexpr size_t numberOfSamples = 128U;
+
+class RiceEncoderTest : public ::testing::Test
+{
+public:
+    RiceEncoderTest() : mStreamData(mStreamBuffer), mStream(mStreamData)
+    {
+    }
+
+    void
+    expectRoundTrip(const int16_t* samples)
+    {
+        RiceEncoder::encode(outpost::Slice<const int16_t>::unsafe(samples, numberOfSamples),
+                            mStream);
+        EXPECT_LE(mStream.getSerializedSize(),
+                  RiceEncoder::getMaximumEncodedSize(numberOfSamples));
+
+        int16_t decoded[numberOfSamples];
+        outpost::Slice<int16_t> result = RiceEncoder::decode(mStream, outpost::asSlice(decoded));
+        ASSERT_EQ(numberOfSamples, result.getNumberOfElements());
+        for (size_t i = 0; i < numberOfSamples; i++)
+        {
+            EXPECT_EQ(samples[i], decoded[i]);
+        }
+    }
+
+    bool
+    createBlock(DataBlock& block, int32_t step)
+    {
+        outpost::utils::SharedBufferPointer p;
+        if (!mPool.allocate(p))
+        {
+            return false;
+        }
+        block = DataBlock(p,
+                          12U,
+                          outpost::time::GpsTime::afterEpoch(outpost::time::Hours(3U)),
+                          SamplingRate::hz1,
+                          Blocksize::bs128);
+        for (size_t i = 0; i < numberOfSamples; i++)
+        {
+            int32_t value = static_cast<int32_t>(i) * step;
+            block.push(Fixpoint((i % 2 == 0) ? value : -value));
+        }
+        return true;
+    }
+
+    uint8_t mStreamBuffer[2 * numberOfSamples + 64];
+    outpost::Slice<uint8_t> mStreamData;
+    outpost::Bitstream mStream;
+    outpost::utils::SharedBufferPool<1024, 4> mPool;
+};
+}  // namespace
+
+TEST_F(RiceEncoderTest, shouldCompressSlowlyVaryingSamples)
+{
+    int16_t samples[numberOfSamples];
+    for (size_t i = 0; i < numberOfSamples; i++)
+    {
+        samples[i] = static_cast<int16_t>(1000 + i / 4 - (i % 3));
+    }
+
+    expectRoundTrip(samples);
+    EXPECT_LT(mStream.getNumberOfBits(), numberOfSamples * 4U);
+}
+
+TEST_F(RiceEncoderTest, shouldRoundTripExtremeValues)
+{
+    int16_t samples[numberOfSamples];
+    uint32_t state = 12345U;
+    for (size_t i = 0; i < numberOfSamples; i++)
+    {
+        state = state * 1103515245U + 12345U;
+        switch (i % 4)
+        {
+            case 0: samples[i] = INT16_MIN; break;
+            case 1: samples[i] = INT16_MAX; break;
+            default: samples[i] = static_cast<int16_t>(state >> 16); break;
+        }
+    }
+
+    expectRoundTrip(samples);
+}
+
+TEST_F(RiceEncoderTest, shouldRejectTruncatedStream)
+{
+    int16_t samples[numberOfSamples];
+    for (size_t i = 0; i < numberOfSamples; i++)
+    {
+        samples[i] = static_cast<int16_t>(i * i);
+    }
+    RiceEncoder::encode(outpost::Slice<const int16_t>::unsafe(samples, numberOfSamples), mStream);
+
+    uint8_t truncatedBuffer[2 * numberOfSamples + 64];
+    outpost::Slice<uint8_t> truncatedData(truncatedBuffer);
+    outpost::Bitstream truncated(truncatedData);
+    for (uint32_t i = 0; i < mStream.getNumberOfBits() / 2; i++)
+    {
+        truncated.pushBit(mStream.getBit(i));
+    }
+
+    int16_t decoded[numberOfSamples];
+    EXPECT_EQ(0U, RiceEncoder::decode(truncated, outpost::asSlice(decoded)).getNumberOfElements());
+}
+
+TEST_F(RiceEncoderTest, shouldEncodeRawSamplesOfDataBlock)
+{
+    RiceEncoder encoder;
+    DataBlock block;
+    ASSERT_TRUE(createBlock(block, 1));
+
+    DataBlock encoded;
+    ASSERT_TRUE(createBlock(encoded, 0));
+    ASSERT_TRUE(block.encode(encoded, encoder));
+    EXPECT_TRUE(encoded.isEncoded());
+    EXPECT_EQ(CompressionScheme::rice, encoded.getCompressionScheme());
+
+    outpost::Slice<uint8_t> data = encoded.getEncodedData();
+    EXPECT_EQ(static_cast<uint8_t>(CompressionScheme::rice), data[0]);
+
+    outpost::Slice<uint8_t> streamData = data.skipFirst(DataBlock::headerSize);
+    outpost::Bitstream stream(streamData);
+    outpost::Deserialize deserialize(streamData);
+    ASSERT_TRUE(stream.deserialize(deserialize));
+
+    int16_t decoded[numberOfSamples];
+    ASSERT_EQ(numberOfSamples,
+              RiceEncoder::decode(stream, outpost::asSlice(decoded)).getNumberOfElements());
+    for (size_t i = 0; i < numberOfSamples; i++)
+    {
+        int16_t value = static_cast<int16_t>(i);
+        EXPECT_EQ((i % 2 == 0) ? value : -value, decoded[i]);
+    }
+
+    // The wavelet coefficients are encoded by the NLS encoder only
+    ASSERT_TRUE(block.applyWaveletTransform());
+    DataBlock target;
+    ASSERT_TRUE(createBlock(target, 0));
+    EXPECT_FALSE(block.encode(target, encoder));
+}
+
+TEST_F(RiceEncoderTest, shouldSelectSchemeFromSamples)
+{
+    CompressionSchemeSelector selector(6U);
+
+    DataBlock slow;
+    ASSERT_TRUE(createBlock(slow, 0));
+    EXPECT_EQ(CompressionScheme::rice, selector.select(slow));
+
+    DataBlock fast;
+    ASSERT_TRUE(createBlock(fast, 200));
+    EXPECT_EQ(CompressionScheme::waveletNLS, selector.select(fast));
+
+    ASSERT_TRUE(slow.applyWaveletTransform());
+    EXPECT_EQ(CompressionScheme::waveletNLS, selector.select(slow));
+}
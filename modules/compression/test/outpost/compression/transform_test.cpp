@@ -10,6 +10,8 @@
 #include <outpost/base/fixpoint.h>
 #include <outpost/base/slice.h>
 #include <outpost/compression/legall_wavelet.h>
+#include <outpost/compression/streaming_wavelet.h>
+#include <outpost/utils/container/arena.h>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -341,4 +343,176 @@ TEST_F(TransformTest, ReorderTest)
     }
 }
 
+TEST_F(TransformTest, LiftingMatchesReference)
+{
+    constexpr size_t bufferLength = 4096;
+    for (size_t i = 0; i < bufferLength; i++)
+    {
+        inputBuffer[i] = static_cast<int16_t>((i * 37) % 1024 + 512);
+        inputReference[i] = inputBuffer[i];
+    }
+
+    outpost::compression::LeGall53Wavelet::forwardTransform(inputReference.first(bufferLength),
+                                                            outputReference.first(bufferLength));
+    outpost::compression::LeGall53Wavelet::forwardTransformLifting(
+            inputData.first(bufferLength), outputData.first(bufferLength));
+
+    for (size_t i = 0; i < bufferLength; i++)
+    {
+        EXPECT_NEAR(static_cast<double>(outputReference[i]),
+                    static_cast<double>(outputBuffer[i]),
+                    0.01)
+                << "at index " << i;
+    }
+}
+
+TEST_F(TransformTest, LiftingIsExactForIntegerSteps)
+{
+    constexpr size_t bufferLength = 16;
+    for (size_t i = 0; i < bufferLength; i++)
+    {
+        inputBuffer[i] = static_cast<int16_t>(4 * i);
+        inputReference[i] = inputBuffer[i];
+    }
+
+    outpost::compression::LeGall53Wavelet::forwardTransform(inputReference.first(bufferLength),
+                                                            outputReference.first(bufferLength));
+    outpost::compression::LeGall53Wavelet::forwardTransformLifting(
+            inputData.first(bufferLength), outputData.first(bufferLength));
+
+    for (size_t i = 0; i < bufferLength; i++)
+    {
+        EXPECT_EQ(outputReference[i].getValue(), outputBuffer[i].getValue()) << "at index " << i;
+    }
+}
+
+TEST_F(TransformTest, InPlaceOrderedMatchesLifting)
+{
+    for (size_t bufferLength = 16; bufferLength <= 4096; bufferLength <<= 1)
+    {
+        for (size_t i = 0; i < bufferLength; i++)
+        {
+            inputBuffer[i] = static_cast<int16_t>((i * 113) % 2048 - 1024);
+            inputReference[i] = inputBuffer[i];
+            intermediateReference[i] = inputBuffer[i];
+        }
+
+        outpost::compression::LeGall53Wavelet::forwardTransformLifting(
+                inputReference.first(bufferLength), outputReference.first(bufferLength));
+        outpost::compression::LeGall53Wavelet::forwardTransform(
+                intermediateReference.first(bufferLength), intermediateData.first(bufferLength));
+        outpost::Slice<int16_t> coefficients =
+                outpost::compression::LeGall53Wavelet::forwardTransformInPlaceOrdered(
+                        inputData.first(bufferLength));
+
+        ASSERT_EQ(bufferLength, coefficients.getNumberOfElements());
+        for (size_t i = 0; i < bufferLength; i++)
+        {
+            EXPECT_EQ(static_cast<int16_t>(outputReference[i]), coefficients[i])
+                    << "at index " << i << " of " << bufferLength;
+            EXPECT_NEAR(static_cast<int16_t>(intermediateBuffer[i]), coefficients[i], 1)
+                    << "at index " << i << " of " << bufferLength;
+        }
+    }
+}
+
+TEST_F(TransformTest, StreamingMatchesInPlaceOrdered)
+{
+    outpost::compression::StreamingWavelet transform;
+    for (size_t bufferLength = 16; bufferLength <= 4096; bufferLength <<= 1)
+    {
+        ASSERT_TRUE(transform.start(outputData.first(bufferLength)));
+        for (size_t i = 0; i < bufferLength; i++)
+        {
+            inputBuffer[i] = static_cast<int16_t>((i * 113) % 2048 - 1024);
+            EXPECT_FALSE(transform.isComplete());
+            EXPECT_EQ(0U, transform.finish().getNumberOfElements());
+            ASSERT_TRUE(transform.push(inputBuffer[i]));
+        }
+        EXPECT_TRUE(transform.isComplete());
+        EXPECT_FALSE(transform.push(inputBuffer[0]));
+
+        outpost::Slice<int16_t> expected =
+                outpost::compression::LeGall53Wavelet::forwardTransformInPlaceOrdered(
+                        inputData.first(bufferLength));
+        outpost::Slice<int16_t> coefficients = transform.finish();
+
+        ASSERT_EQ(bufferLength, coefficients.getNumberOfElements());
+        for (size_t i = 0; i < bufferLength; i++)
+        {
+            EXPECT_EQ(expected[i], coefficients[i]) << "at index " << i << " of " << bufferLength;
+        }
+    }
+
+    EXPECT_FALSE(transform.start(outputData.first(8)));
+    EXPECT_FALSE(transform.start(outputData.first(48)));
+    EXPECT_FALSE(transform.start(outputData.first(8192)));
+}
+
+TEST_F(TransformTest, BackwardInPlaceOrderedReconstructsSamples)
+{
+    for (size_t bufferLength = 4; bufferLength <= 4096; bufferLength <<= 1)
+    {
+        for (size_t i = 0; i < bufferLength; i++)
+        {
+            inputBuffer[i] = static_cast<int16_t>((i * 113) % 2048 - 1024);
+            inputReference[i] = inputBuffer[i];
+        }
+
+        // Reconstruct in the memory of the coefficients, as done by the decoder
+        outpost::Slice<int16_t> coefficients =
+                outpost::compression::LeGall53Wavelet::forwardTransformInPlaceOrdered(
+                        inputData.first(bufferLength));
+        outpost::Slice<FP<16>> samples =
+                outpost::compression::LeGall53Wavelet::backwardTransformInPlaceOrdered(
+                        coefficients, inputData.first(bufferLength));
+
+        ASSERT_EQ(bufferLength, samples.getNumberOfElements());
+        for (size_t i = 0; i < bufferLength; i++)
+        {
+            EXPECT_NEAR(static_cast<double>(inputReference[i]),
+                        static_cast<double>(samples[i]),
+                        2.0)
+                    << "at index " << i << " of " << bufferLength;
+        }
+    }
+
+    EXPECT_EQ(0U,
+              outpost::compression::LeGall53Wavelet::backwardTransformInPlaceOrdered(
+                      outpost::Slice<const int16_t>::empty(), inputData.first(0))
+                      .getNumberOfElements());
+}
+
+TEST_F(TransformTest, ForwardTransformWithScratchArenaMatchesBuffers)
+{
+    constexpr size_t bufferLength = 256;
+    for (size_t i = 0; i < bufferLength; i++)
+    {
+        inputBuffer[i] = 1024 + rand() % 2048;
+        inputReference[i] = inputBuffer[i];
+    }
+    outpost::compression::LeGall53Wavelet::forwardTransform(inputReference.first(bufferLength),
+                                                            outputReference.first(bufferLength));
+
+    outpost::utils::ArenaStorage<bufferLength * sizeof(FP<16>)> scratch;
+    outpost::Slice<FP<16>> coefficients = outpost::compression::LeGall53Wavelet::forwardTransform(
+            inputData.first(bufferLength), scratch);
+    ASSERT_EQ(bufferLength, coefficients.getNumberOfElements());
+    for (size_t i = 0; i < bufferLength; i++)
+    {
+        EXPECT_EQ(outputReference[i], coefficients[i]) << i;
+    }
+
+    // The arena is exhausted until it is reset
+    EXPECT_EQ(0U,
+              outpost::compression::LeGall53Wavelet::forwardTransform(
+                      inputData.first(bufferLength), scratch)
+                      .getNumberOfElements());
+    scratch.reset();
+    EXPECT_EQ(bufferLength,
+              outpost::compression::LeGall53Wavelet::forwardTransform(
+                      inputData.first(bufferLength), scratch)
+                      .getNumberOfElements());
+}
+
 }  // namespace transform_test
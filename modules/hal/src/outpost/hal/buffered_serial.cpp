@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "buffered_serial.h"
+
+#include <outpost/utils/minmax.h>
+
+using outpost::hal::BufferedSerial;
+
+BufferedSerial::BufferedSerial(outpost::Slice<uint8_t> receiveStorage,
+                               outpost::Slice<uint8_t> transmitStorage,
+                               size_t receiveWatermark,
+                               size_t transmitWatermark) :
+    mReceiveRing(receiveStorage),
+    mTransmitRing(transmitStorage),
+    mReceiveWatermark((receiveWatermark > 0) ? receiveWatermark : 1),
+    // A writer waiting for a full ring must be woken eventually
+    mTransmitWatermark(outpost::utils::min<size_t>(transmitWatermark,
+                                                   mTransmitRing.getCapacity() - 1)),
+    mReceiveThreshold(0),
+    mTransmitLevel(0),
+    mReceiverIdle(0),
+    mNumberOfLostBytes(0),
+    mDataAvailable(outpost::rtos::BinarySemaphore::State::acquired),
+    mSpaceAvailable(outpost::rtos::BinarySemaphore::State::acquired)
+{
+}
+
+BufferedSerial::~BufferedSerial()
+{
+}
+
+bool
+BufferedSerial::isAvailable()
+{
+    return !mReceiveRing.isEmpty();
+}
+
+size_t
+BufferedSerial::getNumberOfBytesAvailable()
+{
+    return mReceiveRing.getNumberOfBytes();
+}
+
+size_t
+BufferedSerial::read(outpost::Slice<uint8_t> data, outpost::time::Duration timeout)
+{
+    if (data.getNumberOfElements() == 0)
+    {
+        return 0;
+    }
+
+    waitForReceivedData(outpost::utils::min<size_t>(mReceiveWatermark, data.getNumberOfElements()),
+                        timeout);
+    return mReceiveRing.read(data);
+}
+
+size_t
+BufferedSerial::write(outpost::Slice<const uint8_t> data, outpost::time::Duration timeout)
+{
+    const size_t length = data.getNumberOfElements();
+    size_t written = 0;
+    while (written < length)
+    {
+        written += mTransmitRing.write(data.subSlice(written, length - written));
+        startTransmission();
+
+        if (written < length && !waitForTransmitLevel(mTransmitWatermark, timeout))
+        {
+            break;
+        }
+    }
+    return written;
+}
+
+void
+BufferedSerial::flushReceiver()
+{
+    mReceiveRing.consume(mReceiveRing.getNumberOfBytes());
+}
+
+void
+BufferedSerial::flushTransmitter()
+{
+    startTransmission();
+    waitForTransmitLevel(0, outpost::time::Duration::infinity());
+}
+
+outpost::Slice<const uint8_t>
+BufferedSerial::peek(outpost::time::Duration timeout)
+{
+    waitForReceivedData(mReceiveWatermark, timeout);
+    return mReceiveRing.getReadableSpan();
+}
+
+void
+BufferedSerial::consume(size_t count)
+{
+    mReceiveRing.consume(outpost::utils::min<size_t>(count, mReceiveRing.getNumberOfBytes()));
+}
+
+// ----------------------------------------------------------------------------
+void
+BufferedSerial::commitReceived(size_t count)
+{
+    mReceiveRing.commitWrite(count);
+    wakeReader();
+}
+
+size_t
+BufferedSerial::receive(outpost::Slice<const uint8_t> data)
+{
+    const size_t written = mReceiveRing.write(data);
+    if (written < data.getNumberOfElements())
+    {
+        // Only written here, a load and a store are ISR-safe on all targets
+        // unlike a read-modify-write
+        mNumberOfLostBytes.store(mNumberOfLostBytes.load() + data.getNumberOfElements()
+                                 - written);
+    }
+    wakeReader();
+    return written;
+}
+
+void
+BufferedSerial::notifyReceiverIdle()
+{
+    mReceiverIdle.store(1);
+    wakeReader();
+}
+
+void
+BufferedSerial::commitTransmitted(size_t count)
+{
+    mTransmitRing.consume(count);
+
+    const size_t level = mTransmitLevel.load();
+    if ((level != 0) && (mTransmitRing.getNumberOfBytes() < level))
+    {
+        mSpaceAvailable.releaseFromInterrupt();
+    }
+}
+
+// ----------------------------------------------------------------------------
+bool
+BufferedSerial::isReceiveThresholdReached(size_t threshold) const
+{
+    const size_t available = mReceiveRing.getNumberOfBytes();
+    return (available >= threshold) || ((available > 0) && (mReceiverIdle.load() != 0));
+}
+
+void
+BufferedSerial::wakeReader()
+{
+    const size_t threshold = mReceiveThreshold.load();
+    if ((threshold != 0) && isReceiveThresholdReached(threshold))
+    {
+        mDataAvailable.releaseFromInterrupt();
+    }
+}
+
+void
+BufferedSerial::waitForReceivedData(size_t threshold, outpost::time::Duration timeout)
+{
+    while (!isReceiveThresholdReached(threshold))
+    {
+        // Announce the threshold before checking again, otherwise data
+        // arriving in between would not wake this thread
+        mReceiveThreshold.store(threshold);
+        if (isReceiveThresholdReached(threshold) || !mDataAvailable.acquire(timeout))
+        {
+            break;
+        }
+    }
+    mReceiveThreshold.store(0);
+    mReceiverIdle.store(0);
+}
+
+bool
+BufferedSerial::waitForTransmitLevel(size_t level, outpost::time::Duration timeout)
+{
+    bool reached = true;
+    while (mTransmitRing.getNumberOfBytes() > level)
+    {
+        mTransmitLevel.store(level + 1);
+        if (mTransmitRing.getNumberOfBytes() <= level)
+        {
+            break;
+        }
+        if (!mSpaceAvailable.acquire(timeout))
+        {
+            reached = false;
+            break;
+        }
+    }
+    mTransmitLevel.store(0);
+    return reached;
+}
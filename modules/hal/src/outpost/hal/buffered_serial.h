@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_HAL_BUFFERED_SERIAL_H
+#define OUTPOST_HAL_BUFFERED_SERIAL_H
+
+#include "serial.h"
+
+#include <outpost/rtos/atomic.h>
+#include <outpost/rtos/semaphore.h>
+#include <outpost/utils/container/spsc_byte_ring.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace hal
+{
+/**
+ * Base class for interrupt or DMA driven serial drivers.
+ *
+ * Received and transmitted data is kept in two lock-free byte rings. The
+ * driver fills the receive ring from its ISR or DMA completion handler
+ * and empties the transmit ring the same way, the application side uses
+ * the Serial interface or reads the received data in place with peek()
+ * and consume().
+ *
+ * Waiting threads are only woken when a watermark is crossed instead of
+ * for every byte: a reader waits until at least the receive watermark is
+ * available (or the driver reports an idle line), a writer waits until
+ * the transmit ring has drained down to the transmit watermark.
+ *
+ * A driver implements close() and startTransmission() and uses the
+ * protected functions from its interrupt context:
+ *
+ * \code
+ * void
+ * Uart::handleReceiveInterrupt()
+ * {
+ *     while (hasReceivedByte())
+ *     {
+ *         uint8_t byte = readReceivedByte();
+ *         receive(outpost::Slice<const uint8_t>::unsafe(&byte, 1));
+ *     }
+ * }
+ * \endcode
+ *
+ * \warning
+ *      Only one thread may read and only one thread may write at the same
+ *      time.
+ */
+class BufferedSerial : public Serial
+{
+public:
+    /**
+     * \param receiveStorage
+     *      Memory of the receive ring.
+     * \param transmitStorage
+     *      Memory of the transmit ring.
+     * \param receiveWatermark
+     *      Number of bytes which have to be available before a waiting
+     *      reader is woken, at least one.
+     * \param transmitWatermark
+     *      Fill level of the transmit ring at which a writer waiting for
+     *      free space is woken.
+     */
+    BufferedSerial(outpost::Slice<uint8_t> receiveStorage,
+                   outpost::Slice<uint8_t> transmitStorage,
+                   size_t receiveWatermark = 1,
+                   size_t transmitWatermark = 0);
+
+    virtual ~BufferedSerial();
+
+    virtual bool
+    isAvailable() override;
+
+    virtual size_t
+    getNumberOfBytesAvailable() override;
+
+    /**
+     * Copy received bytes.
+     *
+     * Waits until at least the smaller one of the receive watermark and
+     * \p data.getNumberOfElements() bytes are available, the driver reports
+     * an idle line or the timeout occurs.
+     */
+    virtual size_t
+    read(outpost::Slice<uint8_t> data,
+         outpost::time::Duration timeout = outpost::time::Duration::maximum()) override;
+
+    /**
+     * Queue bytes for transmission.
+     *
+     * Waits for free space in the transmit ring if necessary, at most
+     * \p timeout for every time the ring runs full.
+     */
+    virtual size_t
+    write(outpost::Slice<const uint8_t> data,
+          outpost::time::Duration timeout = outpost::time::Duration::maximum()) override;
+
+    virtual void
+    flushReceiver() override;
+
+    /**
+     * Wait until the driver has taken all bytes from the transmit ring.
+     */
+    virtual void
+    flushTransmitter() override;
+
+    /**
+     * Access the received bytes without copying.
+     *
+     * Waits like read() with the receive watermark. The returned span
+     * stays valid until consume() is called and may hold less than
+     * getNumberOfBytesAvailable() bytes if the data wraps around the end
+     * of the ring.
+     *
+     * \return  Contiguous span of the oldest received bytes, empty after a
+     *          timeout.
+     */
+    outpost::Slice<const uint8_t>
+    peek(outpost::time::Duration timeout = outpost::time::Duration::maximum());
+
+    /**
+     * Release bytes obtained by peek().
+     */
+    void
+    consume(size_t count);
+
+    inline void
+    setReceiveWatermark(size_t watermark)
+    {
+        mReceiveWatermark = (watermark > 0) ? watermark : 1;
+    }
+
+    /**
+     * Number of received bytes dropped because the receive ring was full.
+     */
+    inline uint32_t
+    getNumberOfLostBytes() const
+    {
+        return mNumberOfLostBytes.load();
+    }
+
+protected:
+    // ------------------------------------------------------------------------
+    // Driver side, called from the ISR or DMA completion handler
+    //
+    // The waiting threads are woken with
+    // BinarySemaphore::releaseFromInterrupt(), the functions therefore
+    // must be called from interrupt context and not from a thread. They
+    // only use loads and stores of outpost::rtos::Atomic, which are
+    // ISR-safe on all targets.
+
+    /**
+     * Contiguous free region of the receive ring, e.g. as DMA target.
+     */
+    inline outpost::Slice<uint8_t>
+    getReceiveSpan() const
+    {
+        return mReceiveRing.getWritableSpan();
+    }
+
+    /**
+     * Publish \p count bytes written to getReceiveSpan().
+     */
+    void
+    commitReceived(size_t count);
+
+    /**
+     * Copy received bytes into the receive ring.
+     *
+     * Bytes which do not fit are dropped and counted.
+     */
+    size_t
+    receive(outpost::Slice<const uint8_t> data);
+
+    /**
+     * Wake a waiting reader even if the receive watermark is not reached,
+     * e.g. on a receiver timeout or idle line interrupt.
+     */
+    void
+    notifyReceiverIdle();
+
+    /**
+     * Contiguous region of the transmit ring to send next.
+     */
+    inline outpost::Slice<const uint8_t>
+    getTransmitSpan() const
+    {
+        return mTransmitRing.getReadableSpan();
+    }
+
+    /**
+     * Release \p count bytes of getTransmitSpan() after they have been
+     * sent.
+     */
+    void
+    commitTransmitted(size_t count);
+
+    /**
+     * Called after data has been added to the transmit ring, e.g. to
+     * enable the transmit interrupt or to start a DMA transfer of
+     * getTransmitSpan() if the transmitter is idle.
+     *
+     * Called by the writing thread, the bytes are released with
+     * commitTransmitted() from the following interrupt.
+     */
+    virtual void
+    startTransmission() = 0;
+
+private:
+    /// At least \p threshold bytes or, after an idle line, any bytes available
+    bool
+    isReceiveThresholdReached(size_t threshold) const;
+
+    void
+    wakeReader();
+
+    /// Wait until at least \p threshold bytes are available
+    void
+    waitForReceivedData(size_t threshold, outpost::time::Duration timeout);
+
+    /// Wait until at most \p level bytes are left in the transmit ring
+    bool
+    waitForTransmitLevel(size_t level, outpost::time::Duration timeout);
+
+    outpost::utils::SpscByteRing mReceiveRing;
+    outpost::utils::SpscByteRing mTransmitRing;
+
+    size_t mReceiveWatermark;
+    const size_t mTransmitWatermark;
+
+    /// Threshold of the waiting reader, zero if no reader is waiting
+    outpost::rtos::Atomic<size_t> mReceiveThreshold;
+
+    /// Fill level awaited by the waiting writer plus one, zero if none
+    outpost::rtos::Atomic<size_t> mTransmitLevel;
+
+    outpost::rtos::Atomic<uint32_t> mReceiverIdle;
+    outpost::rtos::Atomic<uint32_t> mNumberOfLostBytes;
+
+    outpost::rtos::BinarySemaphore mDataAvailable;
+    outpost::rtos::BinarySemaphore mSpaceAvailable;
+};
+
+}  // namespace hal
+}  // namespace outpost
+
+#endif
@@ -14,6 +14,86 @@
 
 #include "datagram_transport.h"
 
-outpost::hal::DatagramTransport::~DatagramTransport()
+#include <outpost/utils/minmax.h>
+
+using outpost::hal::DatagramTransport;
+
+DatagramTransport::~DatagramTransport()
 {
 }
+
+size_t
+DatagramTransport::sendBatchTo(outpost::Slice<const outpost::Slice<const uint8_t>> data,
+                               outpost::Slice<const Address> addresses,
+                               outpost::time::Duration timeout)
+{
+    const size_t maximum = outpost::utils::min<size_t>(data.getNumberOfElements(),
+                                                       addresses.getNumberOfElements());
+    size_t count = 0;
+    while (count < maximum)
+    {
+        if (sendTo(data[count], addresses[count], timeout) != data[count].getNumberOfElements())
+        {
+            break;
+        }
+        count++;
+    }
+    return count;
+}
+
+size_t
+DatagramTransport::receiveBatchFrom(outpost::Slice<const outpost::Slice<uint8_t>> data,
+                                    outpost::Slice<size_t> lengths,
+                                    outpost::Slice<Address> addresses,
+                                    outpost::time::Duration timeout)
+{
+    const size_t maximum = outpost::utils::min<size_t>(data.getNumberOfElements(),
+                                                       lengths.getNumberOfElements(),
+                                                       addresses.getNumberOfElements());
+    size_t count = 0;
+    outpost::time::Duration wait = timeout;
+    while (count < maximum)
+    {
+        outpost::Slice<uint8_t> buffer = data[count];
+        size_t received = receiveFrom(buffer, addresses[count], wait);
+        if (received == 0)
+        {
+            break;
+        }
+        lengths[count] = received;
+        count++;
+
+        // only drain what is already there
+        wait = outpost::time::Duration::zero();
+    }
+    return count;
+}
+
+size_t
+DatagramTransport::receiveBuffersFrom(
+        outpost::Slice<const outpost::utils::SharedBufferPointer> buffers,
+        outpost::Slice<size_t> lengths,
+        outpost::Slice<Address> addresses,
+        outpost::time::Duration timeout)
+{
+    const size_t maximum = outpost::utils::min<size_t>(buffers.getNumberOfElements(),
+                                                       lengths.getNumberOfElements(),
+                                                       addresses.getNumberOfElements());
+    size_t count = 0;
+    outpost::time::Duration wait = timeout;
+    while (count < maximum)
+    {
+        outpost::Slice<uint8_t> buffer = buffers[count].asSlice();
+        size_t received = receiveFrom(buffer, addresses[count], wait);
+        if (received == 0)
+        {
+            break;
+        }
+        lengths[count] = received;
+        count++;
+
+        // only drain what is already there
+        wait = outpost::time::Duration::zero();
+    }
+    return count;
+}
@@ -19,6 +19,7 @@
 #include <outpost/base/slice.h>
 #include <outpost/time/duration.h>
 #include <outpost/utils/container/fixed_size_array.h>
+#include <outpost/utils/container/shared_buffer.h>
 
 #include <array>
 
@@ -242,6 +243,83 @@ public:
                 Address& address,
                 outpost::time::Duration timeout = outpost::time::Duration::maximum()) = 0;
 
+    /**
+     * Send several datagrams in one call.
+     *
+     * Datagram \c i contains \p data[i] and is sent to \p addresses[i].
+     * The number of datagrams is the smaller one of both lengths. The
+     * default implementation calls \ref sendTo for every datagram,
+     * implementations with a cheaper multi-datagram path (e.g. \c sendmmsg
+     * on Linux) should override it.
+     *
+     * \param data
+     *      Contents of the datagrams.
+     * \param addresses
+     *      Destination of every datagram.
+     * \param timeout
+     *      Maximum time to wait for sending each datagram.
+     * \return
+     *      Number of datagrams sent completely, starting with the first one.
+     *      Sending stops at the first datagram which could not be sent
+     *      completely.
+     */
+    virtual size_t
+    sendBatchTo(outpost::Slice<const outpost::Slice<const uint8_t>> data,
+                outpost::Slice<const Address> addresses,
+                outpost::time::Duration timeout = outpost::time::Duration::maximum());
+
+    /**
+     * Read several datagrams in one call.
+     *
+     * Waits at most \p timeout for the first datagram, all further
+     * datagrams are only read if already available. The default
+     * implementation calls \ref receiveFrom repeatedly, implementations
+     * with a cheaper multi-datagram path (e.g. \c recvmmsg on Linux)
+     * should override it.
+     *
+     * \param data
+     *      Buffers to write the datagrams to, one per datagram. Datagrams
+     *      longer than their buffer are cut as with \ref receiveFrom.
+     * \param lengths
+     *      Number of bytes written to each buffer.
+     * \param addresses
+     *      Address from which each datagram was received.
+     * \param timeout
+     *      Maximum time to wait for the first datagram.
+     * \return
+     *      Number of received datagrams, i.e. valid entries in \p data,
+     *      \p lengths and \p addresses.
+     */
+    virtual size_t
+    receiveBatchFrom(outpost::Slice<const outpost::Slice<uint8_t>> data,
+                     outpost::Slice<size_t> lengths,
+                     outpost::Slice<Address> addresses,
+                     outpost::time::Duration timeout = outpost::time::Duration::maximum());
+
+    /**
+     * Read several datagrams directly into shared buffers.
+     *
+     * Same as \ref receiveBatchFrom but the buffers are given as
+     * SharedBufferPointers, which can be handed on to e.g. a
+     * ProtocolDispatcher without copying.
+     *
+     * \param buffers
+     *      Valid buffers to write the datagrams to, one per datagram.
+     * \param lengths
+     *      Number of bytes written to each buffer.
+     * \param addresses
+     *      Address from which each datagram was received.
+     * \param timeout
+     *      Maximum time to wait for the first datagram.
+     * \return
+     *      Number of received datagrams.
+     */
+    virtual size_t
+    receiveBuffersFrom(outpost::Slice<const outpost::utils::SharedBufferPointer> buffers,
+                       outpost::Slice<size_t> lengths,
+                       outpost::Slice<Address> addresses,
+                       outpost::time::Duration timeout = outpost::time::Duration::maximum());
+
     /**
      * Drop all datagrams which are currently in the receive buffer
      */
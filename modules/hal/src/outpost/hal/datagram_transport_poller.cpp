@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "datagram_transport_poller.h"
+
+#include <outpost/rtos/mutex_guard.h>
+#include <outpost/utils/counter_block.h>
+#include <outpost/utils/minmax.h>
+
+using namespace outpost::hal;
+using outpost::rtos::MutexGuard;
+using outpost::utils::SharedBufferPointer;
+
+internal::DatagramTransportPollerThread::DatagramTransportPollerThread(
+        DatagramTransportPollerBase& poller,
+        uint8_t priority,
+        size_t stackSize,
+        const char* name) :
+    Thread(priority, stackSize, name),
+    mPoller(poller)
+{
+}
+
+void
+internal::DatagramTransportPollerThread::run()
+{
+    mPoller.run();
+}
+
+// ----------------------------------------------------------------------------
+DatagramEndpoint::DatagramEndpoint(DatagramTransport& transport,
+                                   ProtocolDispatcherInterfaceBase& dispatcher) :
+    mTransport(transport),
+    mDispatcher(dispatcher),
+    mNext(nullptr),
+    mNumberOfReceivedDatagrams(0)
+{
+}
+
+uint32_t
+DatagramEndpoint::getNumberOfReceivedDatagrams() const
+{
+    return outpost::utils::internal::counterLoad(mNumberOfReceivedDatagrams);
+}
+
+// ----------------------------------------------------------------------------
+DatagramTransportPollerBase::DatagramTransportPollerBase(
+        outpost::utils::SharedBufferPoolBase& pool,
+        outpost::Slice<SharedBufferPointer> buffers,
+        outpost::Slice<size_t> lengths,
+        outpost::Slice<uint32_t> readBytes,
+        outpost::Slice<DatagramTransport::Address> addresses,
+        outpost::time::Duration idleTime,
+        uint8_t priority,
+        size_t stackSize,
+        const char* name) :
+    mPool(pool),
+    mBuffers(buffers),
+    mLengths(lengths),
+    mReadBytes(readBytes),
+    mAddresses(addresses),
+    mBatchSize(outpost::utils::min<size_t>(buffers.getNumberOfElements(),
+                                           lengths.getNumberOfElements(),
+                                           readBytes.getNumberOfElements(),
+                                           addresses.getNumberOfElements())),
+    mIdleTime(idleTime),
+    mMutex(),
+    mHead(nullptr),
+    mTail(nullptr),
+    mNumberOfPoolExhaustions(0),
+    mThread(*this, priority, stackSize, name)
+{
+}
+
+void
+DatagramTransportPollerBase::addEndpoint(DatagramEndpoint& endpoint)
+{
+    MutexGuard lock(mMutex);
+    endpoint.mNext = nullptr;
+    if (mTail == nullptr)
+    {
+        mHead = &endpoint;
+    }
+    else
+    {
+        mTail->mNext = &endpoint;
+    }
+    mTail = &endpoint;
+}
+
+void
+DatagramTransportPollerBase::start()
+{
+    mThread.start();
+}
+
+size_t
+DatagramTransportPollerBase::poll()
+{
+    MutexGuard lock(mMutex);
+
+    size_t dispatched = 0;
+    for (DatagramEndpoint* endpoint = mHead; endpoint != nullptr; endpoint = endpoint->mNext)
+    {
+        if (!endpoint->mTransport.isAvailable())
+        {
+            continue;
+        }
+
+        const size_t available = refillBuffers();
+        if (available == 0)
+        {
+            // all buffers still in use by the listeners
+            outpost::utils::internal::counterAdd(mNumberOfPoolExhaustions, 1);
+            break;
+        }
+        dispatched += receiveBatch(*endpoint, available);
+    }
+    return dispatched;
+}
+
+uint32_t
+DatagramTransportPollerBase::getNumberOfPoolExhaustions() const
+{
+    return outpost::utils::internal::counterLoad(mNumberOfPoolExhaustions);
+}
+
+size_t
+DatagramTransportPollerBase::refillBuffers()
+{
+    // buffers not handed on by the previous batch are kept
+    size_t available = 0;
+    while (available < mBatchSize
+           && (mBuffers[available].isValid() || mPool.allocate(mBuffers[available])))
+    {
+        available++;
+    }
+    return available;
+}
+
+size_t
+DatagramTransportPollerBase::receiveBatch(DatagramEndpoint& endpoint, size_t available)
+{
+    const size_t received = endpoint.mTransport.receiveBuffersFrom(
+            mBuffers.first(available), mLengths, mAddresses, outpost::time::Duration::zero());
+    if (received == 0)
+    {
+        return 0;
+    }
+
+    for (size_t i = 0; i < received; i++)
+    {
+        mReadBytes[i] = static_cast<uint32_t>(mLengths[i]);
+    }
+    endpoint.mDispatcher.handlePackages(mBuffers.first(received), mReadBytes.first(received));
+    outpost::utils::internal::counterAdd(endpoint.mNumberOfReceivedDatagrams,
+                                         static_cast<uint32_t>(received));
+
+    // Buffers referenced by a queue are handed over, buffers the dispatcher
+    // only copied from are moved to the front and reused
+    size_t kept = 0;
+    for (size_t i = 0; i < available; i++)
+    {
+        if (i >= received || mBuffers[i].isExclusive())
+        {
+            if (kept != i)
+            {
+                mBuffers[kept] = mBuffers[i];
+            }
+            kept++;
+        }
+    }
+    for (size_t i = kept; i < available; i++)
+    {
+        mBuffers[i] = SharedBufferPointer();
+    }
+    return received;
+}
+
+void
+DatagramTransportPollerBase::run()
+{
+    while (true)
+    {
+        if (poll() == 0)
+        {
+            outpost::rtos::Thread::sleep(mIdleTime);
+        }
+    }
+}
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_HAL_DATAGRAM_TRANSPORT_POLLER_H
+#define OUTPOST_HAL_DATAGRAM_TRANSPORT_POLLER_H
+
+#include "datagram_transport.h"
+#include "protocol_dispatcher_interface.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/rtos/mutex.h>
+#include <outpost/rtos/thread.h>
+#include <outpost/time/duration.h>
+#include <outpost/utils/container/shared_object_pool.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace hal
+{
+class DatagramTransportPollerBase;
+
+namespace internal
+{
+class DatagramTransportPollerThread : public rtos::Thread
+{
+public:
+    DatagramTransportPollerThread(DatagramTransportPollerBase& poller,
+                                  uint8_t priority,
+                                  size_t stackSize,
+                                  const char* name);
+
+protected:
+    virtual void
+    run() override;
+
+private:
+    DatagramTransportPollerBase& mPoller;
+};
+}  // namespace internal
+
+/**
+ * Transport read by a DatagramTransportPoller together with the
+ * dispatcher receiving its datagrams.
+ */
+class DatagramEndpoint
+{
+public:
+    DatagramEndpoint(DatagramTransport& transport, ProtocolDispatcherInterfaceBase& dispatcher);
+
+    // disable copy constructor
+    DatagramEndpoint(const DatagramEndpoint& other) = delete;
+
+    // disable assignment operator
+    DatagramEndpoint&
+    operator=(const DatagramEndpoint& other) = delete;
+
+    uint32_t
+    getNumberOfReceivedDatagrams() const;
+
+private:
+    friend class DatagramTransportPollerBase;
+
+    DatagramTransport& mTransport;
+    ProtocolDispatcherInterfaceBase& mDispatcher;
+    DatagramEndpoint* mNext;
+
+    uint32_t mNumberOfReceivedDatagrams;
+};
+
+/**
+ * Reads many datagram transports from a single thread.
+ *
+ * Instead of one thread blocking in DatagramTransport::receiveFrom per
+ * transport, the poller checks every registered endpoint with
+ * DatagramTransport::isAvailable and drains the ready ones without
+ * waiting. The datagrams are received directly into buffers of a shared
+ * pool (DatagramTransport::receiveBuffersFrom) and handed to the
+ * dispatcher of the endpoint with
+ * ProtocolDispatcherInterfaceBase::handlePackages, so listeners
+ * registered without a pool get the received buffer without a copy.
+ * Buffers the dispatcher only copied from are kept for the next batch.
+ *
+ * At most one batch is read per endpoint and round, a busy endpoint
+ * therefore cannot starve the others. If no endpoint had data in a round
+ * the thread sleeps for the idle time, which bounds the latency of the
+ * first datagram after an idle phase.
+ *
+ * \see DatagramTransportPoller
+ */
+class DatagramTransportPollerBase
+{
+public:
+    /**
+     * \param pool
+     *      Pool to receive the datagrams into, the buffers should be at
+     *      least DatagramTransport::getMaximumDatagramSize bytes. Longer
+     *      datagrams are cut without being reported as partial.
+     * \param buffers, lengths, readBytes, addresses
+     *      Storage for one batch, the smallest one defines the batch size.
+     * \param idleTime
+     *      Time to sleep after a round without any datagram, also used as
+     *      retry interval if the pool is exhausted.
+     */
+    DatagramTransportPollerBase(outpost::utils::SharedBufferPoolBase& pool,
+                                outpost::Slice<outpost::utils::SharedBufferPointer> buffers,
+                                outpost::Slice<size_t> lengths,
+                                outpost::Slice<uint32_t> readBytes,
+                                outpost::Slice<DatagramTransport::Address> addresses,
+                                time::Duration idleTime,
+                                uint8_t priority,
+                                size_t stackSize,
+                                const char* name);
+
+    // disable copy constructor
+    DatagramTransportPollerBase(const DatagramTransportPollerBase& other) = delete;
+
+    // disable assignment operator
+    DatagramTransportPollerBase&
+    operator=(const DatagramTransportPollerBase& other) = delete;
+
+    /**
+     * Add an endpoint, it stays registered for the lifetime of the poller.
+     *
+     * Endpoints are polled in the order they have been added.
+     */
+    void
+    addEndpoint(DatagramEndpoint& endpoint);
+
+    /**
+     * Start the poller thread.
+     */
+    void
+    start();
+
+    /**
+     * Poll every endpoint once.
+     *
+     * Called by the poller thread, can be called directly if the poller
+     * is driven by another thread instead.
+     *
+     * \return  Number of dispatched datagrams.
+     */
+    size_t
+    poll();
+
+    /**
+     * Number of rounds stopped because no buffer could be allocated.
+     */
+    uint32_t
+    getNumberOfPoolExhaustions() const;
+
+private:
+    friend class internal::DatagramTransportPollerThread;
+
+    void
+    run();
+
+    /// Receive and dispatch one batch of \p endpoint
+    size_t
+    receiveBatch(DatagramEndpoint& endpoint, size_t available);
+
+    /// Allocate buffers for the next batch, returns the number of valid ones
+    size_t
+    refillBuffers();
+
+    outpost::utils::SharedBufferPoolBase& mPool;
+    const outpost::Slice<outpost::utils::SharedBufferPointer> mBuffers;
+    const outpost::Slice<size_t> mLengths;
+    const outpost::Slice<uint32_t> mReadBytes;
+    const outpost::Slice<DatagramTransport::Address> mAddresses;
+    const size_t mBatchSize;
+    const time::Duration mIdleTime;
+
+    rtos::Mutex mMutex;
+    DatagramEndpoint* mHead;
+    DatagramEndpoint* mTail;
+    uint32_t mNumberOfPoolExhaustions;
+
+    // Declared last so that the thread is destroyed first
+    internal::DatagramTransportPollerThread mThread;
+};
+
+namespace internal
+{
+/// Storage for one batch, a base class of DatagramTransportPoller so that
+/// it is constructed before and destroyed after the poller thread
+template <size_t batchSize>
+struct DatagramTransportPollerStorage
+{
+    outpost::utils::SharedBufferPointer mBatchBuffers[batchSize];
+    size_t mBatchLengths[batchSize];
+    uint32_t mBatchReadBytes[batchSize];
+    DatagramTransport::Address mBatchAddresses[batchSize];
+};
+}  // namespace internal
+
+/**
+ * DatagramTransportPollerBase with the storage for batches of up to
+ * \p batchSize datagrams.
+ *
+ * \code
+ * outpost::utils::SharedBufferPool<1500, 64> pool;
+ * outpost::hal::DatagramEndpoint telemetry(telemetrySocket, telemetryDispatcher);
+ * outpost::hal::DatagramEndpoint telecommand(telecommandSocket, telecommandDispatcher);
+ *
+ * outpost::hal::DatagramTransportPoller<8> poller(pool, Milliseconds(5), priority);
+ * poller.addEndpoint(telemetry);
+ * poller.addEndpoint(telecommand);
+ * poller.start();
+ * \endcode
+ */
+template <size_t batchSize>
+class DatagramTransportPoller : private internal::DatagramTransportPollerStorage<batchSize>,
+                                public DatagramTransportPollerBase
+{
+public:
+    static_assert(batchSize > 0, "Batch size must be at least one datagram");
+
+    DatagramTransportPoller(outpost::utils::SharedBufferPoolBase& pool,
+                            time::Duration idleTime,
+                            uint8_t priority,
+                            size_t stackSize = rtos::Thread::defaultStackSize,
+                            const char* name = "DPOL") :
+        internal::DatagramTransportPollerStorage<batchSize>(),
+        DatagramTransportPollerBase(pool,
+                                    outpost::asSlice(this->mBatchBuffers),
+                                    outpost::asSlice(this->mBatchLengths),
+                                    outpost::asSlice(this->mBatchReadBytes),
+                                    outpost::asSlice(this->mBatchAddresses),
+                                    idleTime,
+                                    priority,
+                                    stackSize,
+                                    name)
+    {
+    }
+};
+
+}  // namespace hal
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_HAL_NAND_FLASH_H
+#define OUTPOST_HAL_NAND_FLASH_H
+
+#include <outpost/base/slice.h>
+#include <outpost/time/duration.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace hal
+{
+/**
+ * NAND flash device.
+ *
+ * Pages are addressed by block and page within the block. A page holds
+ * its data and spare area, getPageSize() bytes in total. Pages can only
+ * be programmed once after the erase of their block and have to be
+ * programmed in ascending order within a block.
+ *
+ * Programming a page takes several hundred microseconds. The program
+ * operation is therefore started by startProgramPage() and finished by
+ * waitForCompletion(), the caller can prepare the next page in the
+ * meantime. A started program operation has to be finished before any
+ * other operation.
+ */
+class NandFlash
+{
+public:
+    struct Result
+    {
+        enum Type
+        {
+            success,
+            failure,
+            timeout,
+            invalidAddress
+        };
+    };
+
+    virtual ~NandFlash() = 0;
+
+    /**
+     * Number of bytes of a page including the spare area.
+     */
+    virtual uint32_t
+    getPageSize() const = 0;
+
+    virtual uint32_t
+    getPagesPerBlock() const = 0;
+
+    virtual uint32_t
+    getNumberOfBlocks() const = 0;
+
+    /**
+     * Read a complete page.
+     *
+     * \param data
+     *      Receives the page, at least getPageSize() bytes.
+     */
+    virtual Result::Type
+    readPage(uint32_t block, uint32_t page, outpost::Slice<uint8_t> data) = 0;
+
+    /**
+     * Start programming a page.
+     *
+     * \p data has to stay unchanged until waitForCompletion() returned.
+     * Only one program operation can be in progress.
+     *
+     * \param data
+     *      Page to program, getPageSize() bytes.
+     */
+    virtual Result::Type
+    startProgramPage(uint32_t block, uint32_t page, outpost::Slice<const uint8_t> data) = 0;
+
+    /**
+     * Wait until the started program operation has finished.
+     *
+     * \return  Result of the program operation, success if none was
+     *          started.
+     */
+    virtual Result::Type
+    waitForCompletion(outpost::time::Duration timeout = outpost::time::Duration::maximum()) = 0;
+
+    /**
+     * Erase a block, all bytes of its pages are set to 0xFF.
+     */
+    virtual Result::Type
+    eraseBlock(uint32_t block) = 0;
+};
+
+}  // namespace hal
+}  // namespace outpost
+
+#endif
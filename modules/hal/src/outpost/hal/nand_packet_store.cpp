@@ -0,0 +1,553 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "nand_packet_store.h"
+
+#include <string.h>
+
+using outpost::hal::NandPacketStoreBase;
+using outpost::time::SpacecraftElapsedTime;
+
+constexpr size_t NandPacketStoreBase::pageHeaderSize;
+constexpr size_t NandPacketStoreBase::recordHeaderSize;
+constexpr uint16_t NandPacketStoreBase::magic;
+constexpr size_t NandPacketStoreBase::noBlock;
+
+static inline void
+writeWord(uint8_t* data, uint32_t value)
+{
+    data[0] = static_cast<uint8_t>(value >> 24);
+    data[1] = static_cast<uint8_t>(value >> 16);
+    data[2] = static_cast<uint8_t>(value >> 8);
+    data[3] = static_cast<uint8_t>(value);
+}
+
+static inline uint32_t
+readWord(const uint8_t* data)
+{
+    return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16)
+           | (static_cast<uint32_t>(data[2]) << 8) | data[3];
+}
+
+static inline void
+writeTime(uint8_t* data, SpacecraftElapsedTime time)
+{
+    const uint64_t value = static_cast<uint64_t>(time.timeSinceEpoch().microseconds());
+    writeWord(&data[0], static_cast<uint32_t>(value >> 32));
+    writeWord(&data[4], static_cast<uint32_t>(value));
+}
+
+static inline SpacecraftElapsedTime
+readTime(const uint8_t* data)
+{
+    const uint64_t value = (static_cast<uint64_t>(readWord(&data[0])) << 32) | readWord(&data[4]);
+    return SpacecraftElapsedTime::afterEpoch(
+            outpost::time::Microseconds(static_cast<int64_t>(value)));
+}
+
+static bool
+isErased(outpost::Slice<const uint8_t> page)
+{
+    for (const uint8_t value : page)
+    {
+        if (value != 0xFF)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+NandPacketStoreBase::NandPacketStoreBase(NandFlash& flash,
+                                         outpost::utils::NandBCHInterface& bch,
+                                         outpost::Slice<Block> blocks,
+                                         outpost::Slice<uint8_t> workspace) :
+    mFlash(flash),
+    mBch(bch),
+    mBlocks(blocks),
+    mWorkspace(workspace),
+    mPage(workspace.first(bch.getNumberOfDatabytes())),
+    mReadData(workspace.skipFirst(bch.getNumberOfDatabytes()).first(bch.getNumberOfDatabytes())),
+    mPosition(pageHeaderSize),
+    mStagedRecords(0),
+    mStagedFirst(),
+    mStagedLast(),
+    mActiveBlock(noBlock),
+    mProgramBlock(noBlock),
+    mCurrentBuffer(0),
+    mNextSequence(0),
+    mReserve(0),
+    mNumberOfDiscardedBlocks(0),
+    mNumberOfFailedOperations(0),
+    mNumberOfCorrectedPages(0),
+    mNumberOfUncorrectablePages(0)
+{
+}
+
+bool
+NandPacketStoreBase::mount()
+{
+    const size_t dataSize = mBch.getNumberOfDatabytes();
+    const size_t pageSize = dataSize + mBch.getNumberOfSparebytes();
+    if ((mFlash.getPageSize() != pageSize)
+        || (mFlash.getNumberOfBlocks() != mBlocks.getNumberOfElements())
+        || (mFlash.getPagesPerBlock() == 0) || (mFlash.getPagesPerBlock() > UINT16_MAX)
+        || (dataSize <= pageHeaderSize + recordHeaderSize)
+        || (mWorkspace.getNumberOfElements()
+            < getWorkspaceSize(dataSize, mBch.getNumberOfSparebytes())))
+    {
+        return false;
+    }
+
+    finishProgram();
+    mPosition = pageHeaderSize;
+    mStagedRecords = 0;
+    mActiveBlock = noBlock;
+    mNextSequence = 0;
+
+    const outpost::Slice<uint8_t> raw = getCodedBuffer(2);
+    const uint32_t pagesPerBlock = mFlash.getPagesPerBlock();
+    uint32_t highestEraseCount = 0;
+    for (size_t i = 0; i < mBlocks.getNumberOfElements(); ++i)
+    {
+        Block& block = mBlocks[i];
+        block = Block();
+        if (mFlash.readPage(i, 0, raw) != NandFlash::Result::success)
+        {
+            continue;
+        }
+        if (isErased(raw))
+        {
+            block.mState = BlockState::erased;
+            continue;
+        }
+        if (loadPage(i, 0) < 0)
+        {
+            continue;
+        }
+
+        block.mState = BlockState::used;
+        block.mSequence = readWord(&mReadData[4]);
+        block.mEraseCount = readWord(&mReadData[8]);
+        block.mFirst = readTime(&mReadData[12]);
+
+        // Pages are programmed in ascending order, search the first
+        // erased page
+        uint32_t written = 1;
+        uint32_t erased = pagesPerBlock;
+        while (written < erased)
+        {
+            const uint32_t page = written + (erased - written) / 2;
+            if ((mFlash.readPage(i, page, raw) == NandFlash::Result::success) && isErased(raw))
+            {
+                erased = page;
+            }
+            else
+            {
+                written = page + 1;
+            }
+        }
+        block.mWrittenPages = static_cast<uint16_t>(written);
+        block.mLast = block.mFirst;
+        for (uint32_t page = written; page > 0; --page)
+        {
+            if (loadPage(i, page - 1) >= 0)
+            {
+                block.mLast = readTime(&mReadData[20]);
+                break;
+            }
+        }
+
+        if (block.mSequence >= mNextSequence)
+        {
+            mNextSequence = block.mSequence + 1;
+        }
+        if (block.mEraseCount > highestEraseCount)
+        {
+            highestEraseCount = block.mEraseCount;
+        }
+    }
+
+    for (Block& block : mBlocks)
+    {
+        if (block.mState != BlockState::used)
+        {
+            block.mEraseCount = highestEraseCount;
+        }
+    }
+    return true;
+}
+
+bool
+NandPacketStoreBase::append(outpost::Slice<const uint8_t> packet, SpacecraftElapsedTime time)
+{
+    const size_t length = packet.getNumberOfElements();
+    const size_t capacity = mPage.getNumberOfElements() - pageHeaderSize;
+    if ((length == 0) || ((recordHeaderSize + length) > capacity))
+    {
+        return false;
+    }
+    if ((mPosition + recordHeaderSize + length) > mPage.getNumberOfElements())
+    {
+        if (!flushPage())
+        {
+            return false;
+        }
+    }
+
+    uint8_t* record = &mPage[mPosition];
+    record[0] = static_cast<uint8_t>(length >> 8);
+    record[1] = static_cast<uint8_t>(length);
+    writeTime(&record[2], time);
+    memcpy(&record[recordHeaderSize], &packet[0], length);
+    mPosition += recordHeaderSize + length;
+
+    if ((mStagedRecords == 0) || (time < mStagedFirst))
+    {
+        mStagedFirst = time;
+    }
+    if ((mStagedRecords == 0) || (time > mStagedLast))
+    {
+        mStagedLast = time;
+    }
+    mStagedRecords++;
+    return true;
+}
+
+bool
+NandPacketStoreBase::sync()
+{
+    const bool written = flushPage();
+    finishProgram();
+    return written;
+}
+
+size_t
+NandPacketStoreBase::release(SpacecraftElapsedTime until)
+{
+    size_t released = 0;
+    for (Block& block : mBlocks)
+    {
+        if ((block.mState == BlockState::used) && (block.mLast <= until))
+        {
+            block.mState = BlockState::obsolete;
+            released++;
+        }
+    }
+    return released;
+}
+
+bool
+NandPacketStoreBase::collectGarbage()
+{
+    for (size_t i = 0; i < mBlocks.getNumberOfElements(); ++i)
+    {
+        if ((mBlocks[i].mState == BlockState::obsolete) || (mBlocks[i].mState == BlockState::dirty))
+        {
+            erase(i);
+            return true;
+        }
+    }
+
+    if (getNumberOfBlocks(BlockState::erased) < mReserve)
+    {
+        const size_t oldest = findOldestBlock();
+        if (oldest != noBlock)
+        {
+            mNumberOfDiscardedBlocks++;
+            erase(oldest);
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t
+NandPacketStoreBase::getNumberOfBlocks(BlockState state) const
+{
+    size_t count = 0;
+    for (const Block& block : mBlocks)
+    {
+        if (block.mState == state)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+bool
+NandPacketStoreBase::flushPage()
+{
+    if (mStagedRecords == 0)
+    {
+        return true;
+    }
+
+    // A failed program operation retires the block, the page is then
+    // written to the next block
+    for (size_t attempt = 0; attempt < 3; ++attempt)
+    {
+        if (!prepareActiveBlock())
+        {
+            return false;
+        }
+
+        Block& block = mBlocks[mActiveBlock];
+        mPage[0] = static_cast<uint8_t>(magic >> 8);
+        mPage[1] = static_cast<uint8_t>(magic);
+        mPage[2] = static_cast<uint8_t>(mStagedRecords >> 8);
+        mPage[3] = static_cast<uint8_t>(mStagedRecords);
+        writeWord(&mPage[4], block.mSequence);
+        writeWord(&mPage[8], block.mEraseCount);
+        writeTime(&mPage[12], mStagedFirst);
+        writeTime(&mPage[20], mStagedLast);
+
+        const outpost::Slice<uint8_t> coded = getCodedBuffer(mCurrentBuffer);
+        if (!mBch.encode(mPage, coded))
+        {
+            return false;
+        }
+
+        // The previous page was programmed while this one was encoded
+        finishProgram();
+        if (block.mState != BlockState::active)
+        {
+            continue;
+        }
+
+        const uint32_t page = block.mWrittenPages;
+        if (mFlash.startProgramPage(mActiveBlock, page, coded) != NandFlash::Result::success)
+        {
+            mNumberOfFailedOperations++;
+            retire(mActiveBlock);
+            continue;
+        }
+        mProgramBlock = mActiveBlock;
+        mCurrentBuffer ^= 1;
+
+        if ((block.mWrittenPages == 0) || (mStagedFirst < block.mFirst))
+        {
+            block.mFirst = mStagedFirst;
+        }
+        if ((block.mWrittenPages == 0) || (mStagedLast > block.mLast))
+        {
+            block.mLast = mStagedLast;
+        }
+        block.mWrittenPages++;
+
+        mPosition = pageHeaderSize;
+        mStagedRecords = 0;
+        return true;
+    }
+    return false;
+}
+
+bool
+NandPacketStoreBase::prepareActiveBlock()
+{
+    if (mActiveBlock != noBlock)
+    {
+        Block& block = mBlocks[mActiveBlock];
+        if (block.mWrittenPages < mFlash.getPagesPerBlock())
+        {
+            return true;
+        }
+        block.mState = BlockState::used;
+        mActiveBlock = noBlock;
+    }
+    return openBlock();
+}
+
+bool
+NandPacketStoreBase::openBlock()
+{
+    for (size_t attempt = 0; attempt < mBlocks.getNumberOfElements(); ++attempt)
+    {
+        size_t selected = noBlock;
+        for (size_t i = 0; i < mBlocks.getNumberOfElements(); ++i)
+        {
+            if ((mBlocks[i].mState == BlockState::erased)
+                && ((selected == noBlock)
+                    || (mBlocks[i].mEraseCount < mBlocks[selected].mEraseCount)))
+            {
+                selected = i;
+            }
+        }
+
+        if (selected == noBlock)
+        {
+            // Erase blocks which are no longer needed, discard the oldest
+            // data if there are none
+            if (!collectGarbage())
+            {
+                const size_t oldest = findOldestBlock();
+                if (oldest == noBlock)
+                {
+                    return false;
+                }
+                mNumberOfDiscardedBlocks++;
+                erase(oldest);
+            }
+            continue;
+        }
+
+        Block& block = mBlocks[selected];
+        block.mState = BlockState::active;
+        block.mSequence = mNextSequence++;
+        block.mWrittenPages = 0;
+        mActiveBlock = selected;
+        return true;
+    }
+    return false;
+}
+
+bool
+NandPacketStoreBase::erase(size_t index)
+{
+    finishProgram();
+
+    Block& block = mBlocks[index];
+    block.mEraseCount++;
+    block.mWrittenPages = 0;
+    if (mFlash.eraseBlock(index) != NandFlash::Result::success)
+    {
+        mNumberOfFailedOperations++;
+        retire(index);
+        return false;
+    }
+    block.mState = BlockState::erased;
+    return true;
+}
+
+void
+NandPacketStoreBase::retire(size_t index)
+{
+    mBlocks[index].mState = BlockState::bad;
+    if (index == mActiveBlock)
+    {
+        mActiveBlock = noBlock;
+    }
+}
+
+void
+NandPacketStoreBase::finishProgram()
+{
+    if (mProgramBlock == noBlock)
+    {
+        return;
+    }
+    if (mFlash.waitForCompletion() != NandFlash::Result::success)
+    {
+        // The pages written before stay readable
+        mNumberOfFailedOperations++;
+        retire(mProgramBlock);
+    }
+    mProgramBlock = noBlock;
+}
+
+size_t
+NandPacketStoreBase::findOldestBlock() const
+{
+    size_t oldest = noBlock;
+    for (size_t i = 0; i < mBlocks.getNumberOfElements(); ++i)
+    {
+        if ((mBlocks[i].mState == BlockState::used)
+            && ((oldest == noBlock) || (mBlocks[i].mSequence < mBlocks[oldest].mSequence)))
+        {
+            oldest = i;
+        }
+    }
+    return oldest;
+}
+
+size_t
+NandPacketStoreBase::findNextBlock(uint32_t sequence, bool first) const
+{
+    size_t next = noBlock;
+    for (size_t i = 0; i < mBlocks.getNumberOfElements(); ++i)
+    {
+        const Block& block = mBlocks[i];
+        const bool hasData = (block.mState == BlockState::active)
+                             || (block.mState == BlockState::used)
+                             || (block.mState == BlockState::obsolete)
+                             || (block.mState == BlockState::bad);
+        if (hasData && (block.mWrittenPages > 0) && (first || (block.mSequence > sequence))
+            && ((next == noBlock) || (block.mSequence < mBlocks[next].mSequence)))
+        {
+            next = i;
+        }
+    }
+    return next;
+}
+
+int32_t
+NandPacketStoreBase::loadPage(size_t block, uint32_t page)
+{
+    finishProgram();
+
+    const outpost::Slice<uint8_t> raw = getCodedBuffer(2);
+    if (mFlash.readPage(block, page, raw) != NandFlash::Result::success)
+    {
+        return -1;
+    }
+
+    const outpost::utils::DecodeStatus status = mBch.decode(raw, mReadData);
+    if (status == outpost::utils::DecodeStatus::corrected)
+    {
+        mNumberOfCorrectedPages++;
+    }
+    else if (status != outpost::utils::DecodeStatus::noError)
+    {
+        mNumberOfUncorrectablePages++;
+        return -1;
+    }
+
+    if (static_cast<uint16_t>((mReadData[0] << 8) | mReadData[1]) != magic)
+    {
+        return -1;
+    }
+    const int32_t records = (mReadData[2] << 8) | mReadData[3];
+
+    // Check that all records are inside the page
+    size_t offset = pageHeaderSize;
+    for (int32_t i = 0; i < records; ++i)
+    {
+        if ((offset + recordHeaderSize) > mReadData.getNumberOfElements())
+        {
+            return -1;
+        }
+        offset += recordHeaderSize + ((mReadData[offset] << 8) | mReadData[offset + 1]);
+        if (offset > mReadData.getNumberOfElements())
+        {
+            return -1;
+        }
+    }
+    return records;
+}
+
+void
+NandPacketStoreBase::readRecord(size_t& offset,
+                                outpost::Slice<const uint8_t>& packet,
+                                SpacecraftElapsedTime& time) const
+{
+    const size_t length = (mReadData[offset] << 8) | mReadData[offset + 1];
+    time = readTime(&mReadData[offset + 2]);
+    packet = mReadData.subSlice(offset + recordHeaderSize, length);
+    offset += recordHeaderSize + length;
+}
+
+outpost::Slice<uint8_t>
+NandPacketStoreBase::getCodedBuffer(size_t index) const
+{
+    const size_t dataSize = mBch.getNumberOfDatabytes();
+    const size_t pageSize = dataSize + mBch.getNumberOfSparebytes();
+    return mWorkspace.skipFirst(2 * dataSize + index * pageSize).first(pageSize);
+}
@@ -0,0 +1,390 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_HAL_NAND_PACKET_STORE_H
+#define OUTPOST_HAL_NAND_PACKET_STORE_H
+
+#include "nand_flash.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/time/time_point.h>
+#include <outpost/utils/coding/nand_bch_interface.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace hal
+{
+/**
+ * Append-only store for telemetry packets on NAND flash.
+ *
+ * Packets are appended together with their time to a page buffer. A
+ * page is only written when the next packet does not fit any more, so
+ * small packets share the page programs. Every page is protected by
+ * the BCH code. While the flash programs a page the next one is filled
+ * and encoded, the store only waits for the program operation when the
+ * following page is ready.
+ *
+ * The blocks are written as a log: the active block is filled page by
+ * page, then the next erased block is opened. Every block gets a
+ * sequence number, oldest data has the lowest number. For every block
+ * the time of its first and last packet is kept in memory, this index
+ * selects the blocks for a retrieval by time range. The page headers on
+ * the flash contain the same information, mount() rebuilds the index
+ * from them.
+ *
+ * Blocks whose data has been downlinked are released with release()
+ * and erased by collectGarbage(), which is intended to be called in the
+ * idle phases of the thread using the store. It also erases the oldest
+ * blocks in advance to keep a reserve of erased blocks, so that
+ * appending does not have to wait for an erase. The erased block with
+ * the lowest erase count is opened next to spread the wear over all
+ * blocks. If no erased block is left when a block is needed the oldest
+ * data is discarded.
+ *
+ * A block with a failed program or erase operation is not written
+ * again. Bad block markers are not evaluated, a block which cannot be
+ * erased is detected on its first use.
+ *
+ * The store has no internal locking. If it is used by more than one
+ * thread, e.g. with collectGarbage() called from a background thread,
+ * the caller has to serialize all calls including collectGarbage().
+ *
+ * \see NandPacketStore
+ */
+class NandPacketStoreBase
+{
+public:
+    enum class BlockState : uint8_t
+    {
+        /// Erased and available for writing
+        erased,
+
+        /// Currently written
+        active,
+
+        /// Contains packets
+        used,
+
+        /// Contains released packets, to be erased
+        obsolete,
+
+        /// Unknown content, to be erased
+        dirty,
+
+        /// Program or erase failed
+        bad
+    };
+
+    struct Block
+    {
+        Block() :
+            mFirst(outpost::time::SpacecraftElapsedTime::startOfEpoch()),
+            mLast(outpost::time::SpacecraftElapsedTime::startOfEpoch()),
+            mSequence(0),
+            mEraseCount(0),
+            mWrittenPages(0),
+            mState(BlockState::dirty)
+        {
+        }
+
+        /// Time of the first and last packet in the block
+        outpost::time::SpacecraftElapsedTime mFirst;
+        outpost::time::SpacecraftElapsedTime mLast;
+
+        uint32_t mSequence;
+        uint32_t mEraseCount;
+        uint16_t mWrittenPages;
+        BlockState mState;
+    };
+
+    /// magic, records, sequence, erase count, first and last time
+    static constexpr size_t pageHeaderSize = 28;
+
+    /// length and time of a packet
+    static constexpr size_t recordHeaderSize = 10;
+
+    static constexpr uint16_t magic = 0x5053;
+
+    static constexpr size_t noBlock = SIZE_MAX;
+
+    /**
+     * Size of the memory needed for the page buffers.
+     */
+    static constexpr size_t
+    getWorkspaceSize(size_t dataSize, size_t spareSize)
+    {
+        return 2 * dataSize + 3 * (dataSize + spareSize);
+    }
+
+    /**
+     * \param flash
+     *      Flash device, its page size has to match the encoded page
+     *      size of \p bch.
+     * \param bch
+     *      BCH code of a page.
+     * \param blocks
+     *      Index, one entry per block of the flash.
+     * \param workspace
+     *      Page buffers, getWorkspaceSize() bytes.
+     */
+    NandPacketStoreBase(NandFlash& flash,
+                        outpost::utils::NandBCHInterface& bch,
+                        outpost::Slice<Block> blocks,
+                        outpost::Slice<uint8_t> workspace);
+
+    // disable copy constructor
+    NandPacketStoreBase(const NandPacketStoreBase&) = delete;
+
+    // disable assignment operator
+    NandPacketStoreBase&
+    operator=(const NandPacketStoreBase&) = delete;
+
+    /**
+     * Build the index from the page headers on the flash.
+     *
+     * Has to be called before the store is used. Blocks with invalid
+     * headers are marked as dirty and erased by collectGarbage(). The
+     * erase count of an erased block is not stored on the flash, it is
+     * assumed to be the highest erase count found.
+     *
+     * \retval false  The geometry of flash, BCH code and storage do not
+     *                match.
+     */
+    bool
+    mount();
+
+    /**
+     * Append a packet.
+     *
+     * The packet is copied into the page buffer. A SharedBufferPointer
+     * converts implicitly.
+     *
+     * \retval false  Packet is empty or does not fit into a page, or the
+     *                full page buffer could not be written.
+     */
+    bool
+    append(outpost::Slice<const uint8_t> packet, outpost::time::SpacecraftElapsedTime time);
+
+    /**
+     * Write the partially filled page buffer and wait until all pages
+     * are programmed.
+     */
+    bool
+    sync();
+
+    /**
+     * Call \p visitor for every stored packet with a time in
+     * [\p begin, \p end], oldest block first.
+     *
+     * \p visitor has the signature
+     * bool(outpost::Slice<const uint8_t>, outpost::time::SpacecraftElapsedTime)
+     * and returns false to stop the retrieval. The packet is only valid
+     * during the call. Packets still in the page
+     * buffer are not visible, see sync(). Pages which cannot be decoded
+     * are skipped.
+     *
+     * \return  Number of packets passed to \p visitor.
+     */
+    template <typename Visitor>
+    size_t
+    retrieve(outpost::time::SpacecraftElapsedTime begin,
+             outpost::time::SpacecraftElapsedTime end,
+             Visitor visitor);
+
+    /**
+     * Release all blocks which only contain packets up to \p until.
+     *
+     * \return  Number of released blocks.
+     */
+    size_t
+    release(outpost::time::SpacecraftElapsedTime until);
+
+    /**
+     * Erase one obsolete or dirty block. If there are none and less
+     * erased blocks than the reserve, the oldest block is discarded and
+     * erased.
+     *
+     * \retval true   A block was erased, call again to erase more.
+     */
+    bool
+    collectGarbage();
+
+    /**
+     * Number of erased blocks collectGarbage() keeps available.
+     */
+    inline void
+    setReserve(size_t blocks)
+    {
+        mReserve = blocks;
+    }
+
+    inline const Block&
+    getBlock(size_t index) const
+    {
+        return mBlocks[index];
+    }
+
+    size_t
+    getNumberOfBlocks(BlockState state) const;
+
+    /**
+     * Blocks whose packets were erased before they were released.
+     */
+    inline uint32_t
+    getNumberOfDiscardedBlocks() const
+    {
+        return mNumberOfDiscardedBlocks;
+    }
+
+    inline uint32_t
+    getNumberOfFailedOperations() const
+    {
+        return mNumberOfFailedOperations;
+    }
+
+    inline uint32_t
+    getNumberOfCorrectedPages() const
+    {
+        return mNumberOfCorrectedPages;
+    }
+
+    inline uint32_t
+    getNumberOfUncorrectablePages() const
+    {
+        return mNumberOfUncorrectablePages;
+    }
+
+private:
+    bool
+    flushPage();
+
+    bool
+    prepareActiveBlock();
+
+    bool
+    openBlock();
+
+    bool
+    erase(size_t block);
+
+    void
+    retire(size_t block);
+
+    void
+    finishProgram();
+
+    size_t
+    findOldestBlock() const;
+
+    /**
+     * Block with the lowest sequence number larger than \p sequence,
+     * or with any sequence number if \p first.
+     */
+    size_t
+    findNextBlock(uint32_t sequence, bool first) const;
+
+    /**
+     * Read and decode a page into mReadData.
+     *
+     * \return  Number of records, -1 if the page is invalid.
+     */
+    int32_t
+    loadPage(size_t block, uint32_t page);
+
+    /**
+     * Record at \p offset in mReadData, \p offset is advanced to the
+     * next record.
+     */
+    void
+    readRecord(size_t& offset,
+               outpost::Slice<const uint8_t>& packet,
+               outpost::time::SpacecraftElapsedTime& time) const;
+
+    outpost::Slice<uint8_t>
+    getCodedBuffer(size_t index) const;
+
+    NandFlash& mFlash;
+    outpost::utils::NandBCHInterface& mBch;
+    const outpost::Slice<Block> mBlocks;
+    const outpost::Slice<uint8_t> mWorkspace;
+
+    // Page buffer collecting the packets
+    const outpost::Slice<uint8_t> mPage;
+    const outpost::Slice<uint8_t> mReadData;
+    size_t mPosition;
+    uint16_t mStagedRecords;
+    outpost::time::SpacecraftElapsedTime mStagedFirst;
+    outpost::time::SpacecraftElapsedTime mStagedLast;
+
+    size_t mActiveBlock;
+    size_t mProgramBlock;
+    size_t mCurrentBuffer;
+    uint32_t mNextSequence;
+    size_t mReserve;
+
+    uint32_t mNumberOfDiscardedBlocks;
+    uint32_t mNumberOfFailedOperations;
+    uint32_t mNumberOfCorrectedPages;
+    uint32_t mNumberOfUncorrectablePages;
+};
+
+namespace internal
+{
+/**
+ * Memory of a NandPacketStore.
+ *
+ * Base class of NandPacketStore so that it is constructed before
+ * NandPacketStoreBase refers to it.
+ */
+template <size_t numberOfBlocks, size_t dataSize, size_t spareSize>
+class NandPacketStoreStorage
+{
+protected:
+    NandPacketStoreStorage() : mBlockStorage(), mWorkspaceStorage()
+    {
+    }
+
+    NandPacketStoreBase::Block mBlockStorage[numberOfBlocks];
+    uint8_t mWorkspaceStorage[NandPacketStoreBase::getWorkspaceSize(dataSize, spareSize)];
+};
+}  // namespace internal
+
+/**
+ * Packet store for a flash with \p numberOfBlocks blocks and pages of
+ * \p dataSize bytes data and \p spareSize bytes spare area.
+ */
+template <size_t numberOfBlocks, size_t dataSize, size_t spareSize>
+class NandPacketStore
+    : private internal::NandPacketStoreStorage<numberOfBlocks, dataSize, spareSize>,
+      public NandPacketStoreBase
+{
+    static_assert(numberOfBlocks > 1, "At least two blocks required");
+    static_assert(dataSize > pageHeaderSize + recordHeaderSize, "Page too small");
+
+public:
+    NandPacketStore(NandFlash& flash, outpost::utils::NandBCHInterface& bch) :
+        internal::NandPacketStoreStorage<numberOfBlocks, dataSize, spareSize>(),
+        NandPacketStoreBase(flash,
+                            bch,
+                            outpost::asSlice(this->mBlockStorage),
+                            outpost::asSlice(this->mWorkspaceStorage))
+    {
+    }
+};
+
+}  // namespace hal
+}  // namespace outpost
+
+#include "nand_packet_store_impl.h"
+
+#endif
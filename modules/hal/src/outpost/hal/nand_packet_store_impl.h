@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_HAL_NAND_PACKET_STORE_IMPL_H
+#define OUTPOST_HAL_NAND_PACKET_STORE_IMPL_H
+
+#include "nand_packet_store.h"
+
+namespace outpost
+{
+namespace hal
+{
+template <typename Visitor>
+size_t
+NandPacketStoreBase::retrieve(outpost::time::SpacecraftElapsedTime begin,
+                              outpost::time::SpacecraftElapsedTime end,
+                              Visitor visitor)
+{
+    size_t count = 0;
+    for (size_t block = findNextBlock(0, true); block != noBlock;
+         block = findNextBlock(mBlocks[block].mSequence, false))
+    {
+        const Block& entry = mBlocks[block];
+        if ((entry.mLast < begin) || (entry.mFirst > end))
+        {
+            continue;
+        }
+
+        for (uint32_t page = 0; page < entry.mWrittenPages; ++page)
+        {
+            const int32_t records = loadPage(block, page);
+            size_t offset = pageHeaderSize;
+            for (int32_t i = 0; i < records; ++i)
+            {
+                outpost::Slice<const uint8_t> packet = outpost::Slice<const uint8_t>::empty();
+                outpost::time::SpacecraftElapsedTime time;
+                readRecord(offset, packet, time);
+                if ((time >= begin) && (time <= end))
+                {
+                    count++;
+                    if (!visitor(packet, time))
+                    {
+                        return count;
+                    }
+                }
+            }
+        }
+    }
+    return count;
+}
+
+}  // namespace hal
+}  // namespace outpost
+
+#endif
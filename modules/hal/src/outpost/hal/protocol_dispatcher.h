@@ -15,10 +15,13 @@
 #define OUTPOST_HAL_PROTOCOL_DISPATCHER_H_
 
 #include "protocol_dispatcher_interface.h"
+#include "protocol_id_index.h"
+#include "protocol_match_table.h"
 #include "receiver_interface.h"
 
 #include <outpost/base/slice.h>
 #include <outpost/rtos.h>
+#include <outpost/rtos/atomic.h>
 #include <outpost/support/heartbeat.h>
 #include <outpost/time/duration.h>
 #include <outpost/utils/container/reference_queue.h>
@@ -32,6 +35,73 @@ namespace outpost
 {
 namespace hal
 {
+/**
+ * Overload handling of a ProtocolDispatcher listener.
+ *
+ * All checks are done before a buffer is allocated and the package is
+ * copied, a shed package therefore costs only the comparisons. The default
+ * policy never sheds packages.
+ */
+struct ListenerPolicy
+{
+    ListenerPolicy() :
+        mHighWatermark(0), mLowWatermark(0), mPoolReserve(0), mBorrowFromDefaultPool(false)
+    {
+    }
+
+    /**
+     * Shed packages once the queue holds \p high packages until it has
+     * been drained to \p low packages again. A \p high of 0 disables the
+     * watermarks.
+     */
+    inline ListenerPolicy&
+    watermarks(uint16_t high, uint16_t low)
+    {
+        mHighWatermark = high;
+        mLowWatermark = low;
+        return *this;
+    }
+
+    /**
+     * Shed packages while no more than \p reserve buffers of the pool are
+     * free. Listeners for bulk traffic sharing a pool with critical
+     * protocols leave the last buffers to the latter this way.
+     */
+    inline ListenerPolicy&
+    poolReserve(size_t reserve)
+    {
+        mPoolReserve = reserve;
+        return *this;
+    }
+
+    /**
+     * Take a buffer from the pool of the default queue if the own pool
+     * has none left, or only its reserve.
+     */
+    inline ListenerPolicy&
+    borrowFromDefaultPool(bool borrow = true)
+    {
+        mBorrowFromDefaultPool = borrow;
+        return *this;
+    }
+
+    uint16_t mHighWatermark;
+    uint16_t mLowWatermark;
+    size_t mPoolReserve;
+    bool mBorrowFromDefaultPool;
+};
+
+/**
+ * Distributes received packages to queues by their protocol id or by ProtocolMatchRules.
+ *
+ * Listeners can only be added, never removed. Every listener is written completely before the
+ * number of listeners is published, handlePackage() therefore takes no lock and sees either the
+ * listeners before or after a concurrent addQueue(). The configuration calls are serialized by a
+ * mutex. The error counters are atomics so that they can be read while packages are handled.
+ *
+ * Overloaded listeners shed packages cheaply according to their ListenerPolicy, so that the
+ * listeners of critical protocols keep receiving packages.
+ */
 template <typename protocolType,   // pod and must support operator=, operator==, and default
                                    // constructor
           uint32_t numberOfQueues  // how many queues can be included
@@ -41,14 +111,21 @@ class ProtocolDispatcher : public virtual ProtocolDispatcherInterface<protocolTy
 public:
     /**
      * @param offset	      number of bytes before the protocol identifier
+     * @param sharedDelivery  if true, a package matched by several listeners with an own pool is
+     * copied only once, into a buffer of the first matching listener's pool, and all of them get
+     * a child pointer to that buffer. If that buffer is too short for the package, the next
+     * listener copies into its own pool instead, so a package is never cut shorter than by the
+     * pool of the listener itself. If false, every listener gets its own copy.
      */
-    ProtocolDispatcher(uint32_t offSet) :
+    explicit ProtocolDispatcher(uint32_t offSet, bool sharedDelivery = false) :
         mNumberOfListeners(0),
+        mHasDefaultListener(false),
         mNumberOfDroppedPackages(0),
         mNumberOfUnmatchedPackages(0),
         mNumberOfPartialPackages(0),
         mNumberOfOverflowedBytes(0),
-        mOffset(offSet)
+        mOffset(offSet),
+        mSharedDelivery(sharedDelivery)
     {
     }
 
@@ -63,11 +140,12 @@ public:
      * @param[in] queue	The queue that will get all packages that are not matched by any regular
      * queue
      * @param[in] pool the pool to get the storage from, the provided memories shall be large enough
-     * to fit a package
+     * to fit a package. If nullptr, the queue gets a child pointer to the received buffer instead
+     * of a copy (zero-copy), this requires packages to be handled as SharedBufferPointer.
      * @param[in] dropPartial   if true only complete packages will be put into the queue
      *
      * @return	True 	if successfull
-     * 			false 	if nullptr oder already set
+     * 			false 	if queue is nullptr oder already set
      */
     bool
     setDefaultQueue(outpost::utils::SharedBufferPoolBase* pool,
@@ -80,12 +158,17 @@ public:
      *
      * @param[in] id	The id value to listen to
      * @param[in] pool	The pool to allocate memory from, the provided memories shall be large
-     * enough to fit a package of the specific protocol
+     * enough to fit a package of the specific protocol. If nullptr, the queue gets a child pointer
+     * to the received buffer instead of a copy (zero-copy), this requires packages to be handled
+     * as SharedBufferPointer.
+     * The buffer is allocated with SharedBufferPoolBase::allocateForLength(), a
+     * utils::SizeClassSharedBufferPool therefore provides small or large buffers depending on
+     * the length of the package.
      * @param[in] queue	The queue to write the values to
      * @param[in] dropPartial   if true only complete packages will be put into the queue
      *
      * @return	true if successful
-     * 			false	if nullpointer or all queue places filled up
+     * 			false	if queue is nullpointer or all queue places filled up
      */
     bool
     addQueue(protocolType id,
@@ -93,6 +176,61 @@ public:
              outpost::utils::SharedBufferQueueBase* queue,
              bool dropPartial = false) override;
 
+    /**
+     * Adds a queue for a specific protocol id with an overload policy.
+     *
+     * @param[in] id	The id value to listen to
+     * @param[in] pool	See addQueue(protocolType, ...)
+     * @param[in] queue	The queue to write the values to
+     * @param[in] policy	When to shed packages for the queue
+     * @param[in] dropPartial   if true only complete packages will be put into the queue
+     *
+     * @return	true if successful
+     * 			false	if queue is nullpointer, the watermarks are invalid or all queue places
+     * 			filled up
+     */
+    bool
+    addQueue(protocolType id,
+             outpost::utils::SharedBufferPoolBase* pool,
+             outpost::utils::SharedBufferQueueBase* queue,
+             const ListenerPolicy& policy,
+             bool dropPartial = false);
+
+    /**
+     * Adds a queue for the packages matching a rule of several fields, e.g. protocol id and
+     * sub-type, independent of the offset of the dispatcher.
+     * Shares the numberOfQueues places with addQueue(protocolType, ...). A package matching
+     * several listeners is delivered to the listeners for its protocol id first and then to
+     * those with a matching rule, in the order they were added.
+     *
+     * @param[in] rule	The fields to match
+     * @param[in] pool	See addQueue(protocolType, ...)
+     * @param[in] queue	The queue to write the values to
+     * @param[in] dropPartial   if true only complete packages will be put into the queue
+     *
+     * @return	true if successful
+     * 			false	if the rule is invalid, queue is nullpointer or all queue places filled up
+     */
+    bool
+    addQueue(const ProtocolMatchRule& rule,
+             outpost::utils::SharedBufferPoolBase* pool,
+             outpost::utils::SharedBufferQueueBase* queue,
+             bool dropPartial = false);
+
+    /**
+     * Adds a queue for the packages matching a rule with an overload policy.
+     *
+     * @return	true if successful
+     * 			false	if the rule or the watermarks are invalid, queue is nullpointer or all
+     * 			queue places filled up
+     */
+    bool
+    addQueue(const ProtocolMatchRule& rule,
+             outpost::utils::SharedBufferPoolBase* pool,
+             outpost::utils::SharedBufferQueueBase* queue,
+             const ListenerPolicy& policy,
+             bool dropPartial = false);
+
     /**
      * Return the number of packages that were dropped for a given queue.
      * If a queue is listening to different protocol the sum is returned
@@ -103,6 +241,16 @@ public:
     inline uint32_t
     getNumberOfDroppedPackages(outpost::utils::SharedBufferQueueBase* queue) override;
 
+    /**
+     * Return the number of packages that were shed for a given queue by its ListenerPolicy,
+     * these are included in getNumberOfDroppedPackages(queue).
+     *
+     * @param queue the queue
+     * @return	sum of all packages shed for the given queue
+     */
+    inline uint32_t
+    getNumberOfShedPackages(outpost::utils::SharedBufferQueueBase* queue);
+
     /**
      * @return	Returns the number of packages the were totally dropped,
      * 			i.e. don't got any queue or all queues where full
@@ -165,6 +313,29 @@ public:
     void
     handlePackage(const outpost::Slice<const uint8_t>& package, uint32_t readBytes) override;
 
+    /**
+     * Handles a package that has been received directly into a shared buffer.
+     *
+     * Listeners without a pool get a child pointer to \p package, all others
+     * get a copy from their own pool.
+     *
+     * @param package	The shared buffer containing the package
+     * @param readBytes	The number of bytes in the packages may be larger then the buffer, in that
+     * case the package has been cut
+     */
+    void
+    handlePackage(const outpost::utils::SharedBufferPointer& package, uint32_t readBytes) override;
+
+    /**
+     * Handles several packages in one call.
+     *
+     * @param packages	The shared buffers containing the packages
+     * @param readBytes	The number of bytes of each package
+     */
+    void
+    handlePackages(outpost::Slice<const outpost::utils::SharedBufferPointer> packages,
+                   outpost::Slice<const uint32_t> readBytes) override;
+
 private:
     struct Listener
     {
@@ -175,32 +346,87 @@ private:
             mNumberOfDroppedPackages(0),
             mNumberOfPartialPackages(0),
             mNumberOfOverflowedBytes(0),
+            mNumberOfShedPackages(0),
+            mPolicy(),
+            mShedding(false),
             mDropPartial(false){};
         outpost::utils::SharedBufferQueueBase* mQueue;
         outpost::utils::SharedBufferPoolBase* mPool;
         protocolType mId;
+        // Relaxed statistics, see outpost::utils::internal::counterAdd()
         uint32_t mNumberOfDroppedPackages;
         uint32_t mNumberOfPartialPackages;
         uint32_t mNumberOfOverflowedBytes;
+        uint32_t mNumberOfShedPackages;
+        ListenerPolicy mPolicy;
+        // Between reaching the high and the low watermark
+        outpost::rtos::Atomic<bool> mShedding;
         bool mDropPartial;
     };
 
+    static inline bool
+    isValid(const ListenerPolicy& policy);
+
+    /**
+     * Whether the queue of \p listener is above its watermarks.
+     */
+    inline bool
+    isOverloaded(Listener& listener);
+
+    /**
+     * Allocates a buffer for a copy of the package from the pool of
+     * \p listener, or from the pool of the default queue if allowed.
+     * A package refused because of the pool reserve is counted as shed.
+     */
+    inline bool
+    allocate(Listener& listener,
+             outpost::utils::SharedBufferPointer& buffer,
+             uint32_t readBytes);
+
+    /**
+     * Common dispatch logic, \p shared may be nullptr if the package is not
+     * held in a shared buffer.
+     */
+    void
+    dispatch(const outpost::Slice<const uint8_t>& package,
+             const outpost::utils::SharedBufferPointer* shared,
+             uint32_t readBytes);
+
+    void
+    dispatchShared(const outpost::utils::SharedBufferPointer& package, uint32_t readBytes);
+
+    /**
+     * \param copy  Copy of the package made for a previous listener, only
+     *              used and set in shared delivery mode.
+     */
     bool
     insertIntoQueue(Listener& listener,
                     const outpost::Slice<const uint8_t>& package,
+                    const outpost::utils::SharedBufferPointer* shared,
+                    outpost::utils::SharedBufferPointer& copy,
                     uint32_t readBytes);
 
     // one additional for the match rest one
     std::array<Listener, numberOfQueues> mListeners;
+    ProtocolIdIndex<protocolType, numberOfQueues> mIndex;
+    ProtocolMatchTable<numberOfQueues> mMatchTable;
     Listener mDefaultListener;
-    uint32_t mNumberOfListeners;
+
+    // Published after the listener has been written
+    outpost::rtos::Atomic<uint32_t> mNumberOfListeners;
+    outpost::rtos::Atomic<bool> mHasDefaultListener;
+
+    // Relaxed statistics, see outpost::utils::internal::counterAdd()
     uint32_t mNumberOfDroppedPackages;
     uint32_t mNumberOfUnmatchedPackages;
     uint32_t mNumberOfPartialPackages;
     uint32_t mNumberOfOverflowedBytes;
+
+    // Serializes the configuration, not taken by handlePackage()
     outpost::rtos::Mutex mMutex;
 
     const uint32_t mOffset;
+    const bool mSharedDelivery;
 };
 
 }  // namespace hal
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "protocol_dispatcher_batch_thread.h"
+
+#include <outpost/utils/minmax.h>
+#include <outpost/utils/trace/trace.h>
+
+namespace outpost
+{
+namespace hal
+{
+void
+ProtocolDispatcherBatchThread::run()
+{
+    while (true)
+    {
+        mHeartbeat.send(mWaitTime + mDispatchTime);
+        step();
+    }
+}
+
+size_t
+ProtocolDispatcherBatchThread::step()
+{
+    const size_t batchSize = outpost::utils::min<size_t>(mBuffers.getNumberOfElements(),
+                                                         mLengths.getNumberOfElements());
+
+    // buffers not used by the previous batch are kept, only refill the rest
+    size_t available = 0;
+    while (available < batchSize
+           && (mBuffers[available].isValid() || mPool.allocate(mBuffers[available])))
+    {
+        available++;
+    }
+
+    if (available == 0)
+    {
+        // all buffers still in use by the listeners
+        outpost::rtos::Thread::sleep(mDispatchTime);
+        return 0;
+    }
+
+    size_t received = mReceiver.receiveBatch(mBuffers.first(available), mLengths, mWaitTime);
+    if (received > 0)
+    {
+        OUTPOST_TRACE(outpost::utils::trace::packetReceived, mLengths[0], received);
+        mPD.handlePackages(mBuffers.first(received), mLengths.first(received));
+
+        // move the unused buffers to the front and hand back the dispatched ones
+        for (size_t i = 0; i < available; i++)
+        {
+            if (i + received < available)
+            {
+                mBuffers[i] = mBuffers[i + received];
+            }
+            else
+            {
+                mBuffers[i] = outpost::utils::SharedBufferPointer();
+            }
+        }
+    }
+    return received;
+}
+
+}  // namespace hal
+}  // namespace outpost
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_HAL_PROTOCOL_DISPATCHER_BATCH_THREAD_H_
+#define OUTPOST_HAL_PROTOCOL_DISPATCHER_BATCH_THREAD_H_
+
+#include "protocol_dispatcher_interface.h"
+#include "receiver_interface.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/rtos.h>
+#include <outpost/support/heartbeat_limiter.h>
+#include <outpost/time/clock.h>
+#include <outpost/time/duration.h>
+#include <outpost/utils/container/shared_object_pool.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace hal
+{
+/**
+ * Dispatcher thread for high packet rates.
+ *
+ * Drains up to batchBuffers.getNumberOfElements() packages per iteration via
+ * ReceiverInterface::receiveBatch, hands them to the dispatcher in one call
+ * and rate-limits the heartbeat with a HeartbeatLimiter instead of sending
+ * one per package. Packages are received directly into buffers of the given
+ * pool (see ProtocolDispatcherThread for the zero-copy semantics).
+ */
+class ProtocolDispatcherBatchThread : public outpost::rtos::Thread
+{
+public:
+    /**
+     * @param receiver          the object used to receive packages
+     * @param pool              pool to receive the packages into
+     * @param batchBuffers      storage for the buffers of one batch, defines the batch size
+     * @param batchLengths      storage for the package lengths of one batch, at least as large as
+     * batchBuffers
+     * @param clock             clock used for the heartbeat limiter
+     * @param priority          see outpost::rtos::Thread
+     * @param stackSize         see outpost::rtos::Thread
+     * @param threadName        see outpost::rtos::Thread
+     * @param heartbeatSource   heartbeat id for the worker thread
+     * @param heartbeatInterval minimum time between two heartbeats
+     * @param waitTime		    Time to wait on a receive
+     * @param dispatchTime      Time to insert a full batch into the queues, must be larger than
+     * zero, also used as retry interval if the pool is exhausted
+     */
+    ProtocolDispatcherBatchThread(ProtocolDispatcherInterfaceBase& pd,
+                                  ReceiverInterface& receiver,
+                                  outpost::utils::SharedBufferPoolBase& pool,
+                                  outpost::Slice<outpost::utils::SharedBufferPointer> batchBuffers,
+                                  outpost::Slice<uint32_t> batchLengths,
+                                  outpost::time::Clock& clock,
+                                  uint8_t priority,
+                                  size_t stackSize,
+                                  char* threadName,
+                                  outpost::support::parameter::HeartbeatSource heartbeatSource,
+                                  outpost::time::Duration heartbeatInterval,
+                                  outpost::time::Duration waitTime = outpost::time::Seconds(10),
+                                  outpost::time::Duration dispatchTime = outpost::time::Seconds(1)) :
+        outpost::rtos::Thread(priority, stackSize, threadName),
+        mPD(pd),
+        mReceiver(receiver),
+        mPool(pool),
+        mBuffers(batchBuffers),
+        mLengths(batchLengths),
+        mHeartbeat(clock, heartbeatInterval, heartbeatSource),
+        mWaitTime(waitTime),
+        mDispatchTime(dispatchTime)
+    {
+    }
+
+    /**
+     * Receive and dispatch one batch, exposed for testing.
+     *
+     * @return number of packages dispatched
+     */
+    size_t
+    step();
+
+protected:
+    void
+    run() override;
+
+private:
+    ProtocolDispatcherInterfaceBase& mPD;
+
+    ReceiverInterface& mReceiver;
+
+    outpost::utils::SharedBufferPoolBase& mPool;
+
+    outpost::Slice<outpost::utils::SharedBufferPointer> mBuffers;
+    outpost::Slice<uint32_t> mLengths;
+
+    outpost::support::HeartbeatLimiter mHeartbeat;
+
+    const outpost::time::Duration mWaitTime;
+    const outpost::time::Duration mDispatchTime;
+};
+
+}  // namespace hal
+}  // namespace outpost
+
+#endif /* OUTPOST_HAL_PROTOCOL_DISPATCHER_BATCH_THREAD_H_ */
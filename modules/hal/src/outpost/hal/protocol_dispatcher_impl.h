@@ -16,10 +16,14 @@
 
 #include "protocol_dispatcher.h"
 
+#include <outpost/utils/counter_block.h>
 #include <outpost/utils/minmax.h>
+#include <outpost/utils/trace/trace.h>
 
 #include <string.h>  // for memcpy
 
+#include <utility>
+
 namespace outpost
 {
 namespace hal
@@ -31,12 +35,14 @@ ProtocolDispatcher<protocolType, numberOfQueues>::setDefaultQueue(
         outpost::utils::SharedBufferQueueBase* queue,
         bool dropPartial)
 {
+    using outpost::utils::internal::counterStore;
+
     outpost::rtos::MutexGuard lock(mMutex);
-    if (queue == nullptr || pool == nullptr)
+    if (queue == nullptr)
     {
         return false;
     }
-    else if (mDefaultListener.mQueue != nullptr)
+    else if (mHasDefaultListener.load())
     {
         // only one default queue allowed
         return false;
@@ -46,9 +52,10 @@ ProtocolDispatcher<protocolType, numberOfQueues>::setDefaultQueue(
         mDefaultListener.mQueue = queue;
         mDefaultListener.mPool = pool;
         mDefaultListener.mDropPartial = dropPartial;
-        mDefaultListener.mNumberOfDroppedPackages = 0;
-        mDefaultListener.mNumberOfPartialPackages = 0;
-        mDefaultListener.mNumberOfOverflowedBytes = 0;
+        counterStore(mDefaultListener.mNumberOfDroppedPackages, 0);
+        counterStore(mDefaultListener.mNumberOfPartialPackages, 0);
+        counterStore(mDefaultListener.mNumberOfOverflowedBytes, 0);
+        mHasDefaultListener.store(true);
         return true;
     }
 }
@@ -60,24 +67,77 @@ ProtocolDispatcher<protocolType, numberOfQueues>::addQueue(
         outpost::utils::SharedBufferPoolBase* pool,
         outpost::utils::SharedBufferQueueBase* queue,
         bool dropPartial)
+{
+    return addQueue(id, pool, queue, ListenerPolicy(), dropPartial);
+}
+
+template <typename protocolType, uint32_t numberOfQueues>
+bool
+ProtocolDispatcher<protocolType, numberOfQueues>::addQueue(
+        protocolType id,
+        outpost::utils::SharedBufferPoolBase* pool,
+        outpost::utils::SharedBufferQueueBase* queue,
+        const ListenerPolicy& policy,
+        bool dropPartial)
 {
     outpost::rtos::MutexGuard lock(mMutex);
-    if (queue == nullptr || pool == nullptr)
+    const uint32_t index = mNumberOfListeners.load();
+    if (queue == nullptr || !isValid(policy))
     {
         return false;
     }
-    else if (mNumberOfListeners >= numberOfQueues)
+    else if (index >= numberOfQueues)
     {
         // no free space
         return false;
     }
     else
     {
-        mListeners[mNumberOfListeners].mQueue = queue;
-        mListeners[mNumberOfListeners].mPool = pool;
-        mListeners[mNumberOfListeners].mId = id;
-        mListeners[mNumberOfListeners].mDropPartial = dropPartial;
-        mNumberOfListeners++;
+        mListeners[index].mQueue = queue;
+        mListeners[index].mPool = pool;
+        mListeners[index].mId = id;
+        mListeners[index].mPolicy = policy;
+        mListeners[index].mDropPartial = dropPartial;
+        mIndex.add(id, index);
+        mNumberOfListeners.store(index + 1);
+        return true;
+    }
+}
+
+template <typename protocolType, uint32_t numberOfQueues>
+bool
+ProtocolDispatcher<protocolType, numberOfQueues>::addQueue(
+        const ProtocolMatchRule& rule,
+        outpost::utils::SharedBufferPoolBase* pool,
+        outpost::utils::SharedBufferQueueBase* queue,
+        bool dropPartial)
+{
+    return addQueue(rule, pool, queue, ListenerPolicy(), dropPartial);
+}
+
+template <typename protocolType, uint32_t numberOfQueues>
+bool
+ProtocolDispatcher<protocolType, numberOfQueues>::addQueue(
+        const ProtocolMatchRule& rule,
+        outpost::utils::SharedBufferPoolBase* pool,
+        outpost::utils::SharedBufferQueueBase* queue,
+        const ListenerPolicy& policy,
+        bool dropPartial)
+{
+    outpost::rtos::MutexGuard lock(mMutex);
+    const uint32_t index = mNumberOfListeners.load();
+    if (queue == nullptr || !isValid(policy) || index >= numberOfQueues
+        || !mMatchTable.add(rule, index))
+    {
+        return false;
+    }
+    else
+    {
+        mListeners[index].mQueue = queue;
+        mListeners[index].mPool = pool;
+        mListeners[index].mPolicy = policy;
+        mListeners[index].mDropPartial = dropPartial;
+        mNumberOfListeners.store(index + 1);
         return true;
     }
 }
@@ -87,14 +147,36 @@ inline uint32_t
 ProtocolDispatcher<protocolType, numberOfQueues>::getNumberOfDroppedPackages(
         outpost::utils::SharedBufferQueueBase* queue)
 {
-    outpost::rtos::MutexGuard lock(mMutex);
-    uint32_t ret = (mDefaultListener.mQueue == queue) ? mDefaultListener.mNumberOfDroppedPackages
-                                                      : 0;
-    for (uint32_t i = 0; i < mNumberOfListeners; i++)
+    using outpost::utils::internal::counterLoad;
+
+    uint32_t ret = (mHasDefaultListener.load() && mDefaultListener.mQueue == queue)
+                           ? counterLoad(mDefaultListener.mNumberOfDroppedPackages)
+                           : 0;
+    const uint32_t numberOfListeners = mNumberOfListeners.load();
+    for (uint32_t i = 0; i < numberOfListeners; i++)
+    {
+        if (mListeners[i].mQueue == queue)
+        {
+            ret += counterLoad(mListeners[i].mNumberOfDroppedPackages);
+        }
+    }
+    return ret;
+}
+
+template <typename protocolType, uint32_t numberOfQueues>
+inline uint32_t
+ProtocolDispatcher<protocolType, numberOfQueues>::getNumberOfShedPackages(
+        outpost::utils::SharedBufferQueueBase* queue)
+{
+    using outpost::utils::internal::counterLoad;
+
+    uint32_t ret = 0;
+    const uint32_t numberOfListeners = mNumberOfListeners.load();
+    for (uint32_t i = 0; i < numberOfListeners; i++)
     {
         if (mListeners[i].mQueue == queue)
         {
-            ret += mListeners[i].mNumberOfDroppedPackages;
+            ret += counterLoad(mListeners[i].mNumberOfShedPackages);
         }
     }
     return ret;
@@ -104,16 +186,14 @@ template <typename protocolType, uint32_t numberOfQueues>
 inline uint32_t
 ProtocolDispatcher<protocolType, numberOfQueues>::getNumberOfDroppedPackages()
 {
-    outpost::rtos::MutexGuard lock(mMutex);
-    return mNumberOfDroppedPackages;
+    return outpost::utils::internal::counterLoad(mNumberOfDroppedPackages);
 }
 
 template <typename protocolType, uint32_t numberOfQueues>
 inline uint32_t
 ProtocolDispatcher<protocolType, numberOfQueues>::getNumberOfPartialPackages()
 {
-    outpost::rtos::MutexGuard lock(mMutex);
-    return mNumberOfPartialPackages;
+    return outpost::utils::internal::counterLoad(mNumberOfPartialPackages);
 }
 
 template <typename protocolType, uint32_t numberOfQueues>
@@ -121,14 +201,17 @@ inline uint32_t
 ProtocolDispatcher<protocolType, numberOfQueues>::getNumberOfPartialPackages(
         outpost::utils::SharedBufferQueueBase* queue)
 {
-    outpost::rtos::MutexGuard lock(mMutex);
-    uint32_t ret = (mDefaultListener.mQueue == queue) ? mDefaultListener.mNumberOfPartialPackages
-                                                      : 0;
-    for (uint32_t i = 0; i < mNumberOfListeners; i++)
+    using outpost::utils::internal::counterLoad;
+
+    uint32_t ret = (mHasDefaultListener.load() && mDefaultListener.mQueue == queue)
+                           ? counterLoad(mDefaultListener.mNumberOfPartialPackages)
+                           : 0;
+    const uint32_t numberOfListeners = mNumberOfListeners.load();
+    for (uint32_t i = 0; i < numberOfListeners; i++)
     {
         if (mListeners[i].mQueue == queue)
         {
-            ret += mListeners[i].mNumberOfPartialPackages;
+            ret += counterLoad(mListeners[i].mNumberOfPartialPackages);
         }
     }
     return ret;
@@ -138,8 +221,7 @@ template <typename protocolType, uint32_t numberOfQueues>
 inline uint32_t
 ProtocolDispatcher<protocolType, numberOfQueues>::getNumberOfOverflowedBytes()
 {
-    outpost::rtos::MutexGuard lock(mMutex);
-    return mNumberOfOverflowedBytes;
+    return outpost::utils::internal::counterLoad(mNumberOfOverflowedBytes);
 }
 
 template <typename protocolType, uint32_t numberOfQueues>
@@ -147,14 +229,17 @@ inline uint32_t
 ProtocolDispatcher<protocolType, numberOfQueues>::getNumberOfOverflowedBytes(
         outpost::utils::SharedBufferQueueBase* queue)
 {
-    outpost::rtos::MutexGuard lock(mMutex);
-    uint32_t ret = (mDefaultListener.mQueue == queue) ? mDefaultListener.mNumberOfOverflowedBytes
-                                                      : 0;
-    for (uint32_t i = 0; i < mNumberOfListeners; i++)
+    using outpost::utils::internal::counterLoad;
+
+    uint32_t ret = (mHasDefaultListener.load() && mDefaultListener.mQueue == queue)
+                           ? counterLoad(mDefaultListener.mNumberOfOverflowedBytes)
+                           : 0;
+    const uint32_t numberOfListeners = mNumberOfListeners.load();
+    for (uint32_t i = 0; i < numberOfListeners; i++)
     {
         if (mListeners[i].mQueue == queue)
         {
-            ret += mListeners[i].mNumberOfOverflowedBytes;
+            ret += counterLoad(mListeners[i].mNumberOfOverflowedBytes);
         }
     }
     return ret;
@@ -164,29 +249,31 @@ template <typename protocolType, uint32_t numberOfQueues>
 inline uint32_t
 ProtocolDispatcher<protocolType, numberOfQueues>::getNumberOfUnmatchedPackages()
 {
-    outpost::rtos::MutexGuard lock(mMutex);
-    return mNumberOfUnmatchedPackages;
+    return outpost::utils::internal::counterLoad(mNumberOfUnmatchedPackages);
 }
 
 template <typename protocolType, uint32_t numberOfQueues>
 inline void
 ProtocolDispatcher<protocolType, numberOfQueues>::resetErrorCounters()
 {
-    outpost::rtos::MutexGuard lock(mMutex);
-    mNumberOfDroppedPackages = 0;
-    mNumberOfPartialPackages = 0;
-    mNumberOfOverflowedBytes = 0;
-    mNumberOfUnmatchedPackages = 0;
+    using outpost::utils::internal::counterStore;
+
+    // Increments by a concurrent handlePackage() may survive the reset
+    counterStore(mNumberOfDroppedPackages, 0);
+    counterStore(mNumberOfPartialPackages, 0);
+    counterStore(mNumberOfOverflowedBytes, 0);
+    counterStore(mNumberOfUnmatchedPackages, 0);
 
     for (unsigned int i = 0; i < numberOfQueues; i++)
     {
-        mListeners[i].mNumberOfDroppedPackages = 0;
-        mListeners[i].mNumberOfPartialPackages = 0;
-        mListeners[i].mNumberOfOverflowedBytes = 0;
+        counterStore(mListeners[i].mNumberOfDroppedPackages, 0);
+        counterStore(mListeners[i].mNumberOfPartialPackages, 0);
+        counterStore(mListeners[i].mNumberOfOverflowedBytes, 0);
+        counterStore(mListeners[i].mNumberOfShedPackages, 0);
     }
-    mDefaultListener.mNumberOfDroppedPackages = 0;
-    mDefaultListener.mNumberOfPartialPackages = 0;
-    mDefaultListener.mNumberOfOverflowedBytes = 0;
+    counterStore(mDefaultListener.mNumberOfDroppedPackages, 0);
+    counterStore(mDefaultListener.mNumberOfPartialPackages, 0);
+    counterStore(mDefaultListener.mNumberOfOverflowedBytes, 0);
 }
 
 template <typename protocolType, uint32_t numberOfQueues>
@@ -194,18 +281,70 @@ void
 ProtocolDispatcher<protocolType, numberOfQueues>::handlePackage(
         const outpost::Slice<const uint8_t>& package, uint32_t readBytes)
 {
+    dispatch(package, nullptr, readBytes);
+}
+
+template <typename protocolType, uint32_t numberOfQueues>
+void
+ProtocolDispatcher<protocolType, numberOfQueues>::handlePackage(
+        const outpost::utils::SharedBufferPointer& package, uint32_t readBytes)
+{
+    dispatchShared(package, readBytes);
+}
+
+template <typename protocolType, uint32_t numberOfQueues>
+void
+ProtocolDispatcher<protocolType, numberOfQueues>::handlePackages(
+        outpost::Slice<const outpost::utils::SharedBufferPointer> packages,
+        outpost::Slice<const uint32_t> readBytes)
+{
+    const size_t count = outpost::utils::min<size_t>(packages.getNumberOfElements(),
+                                                     readBytes.getNumberOfElements());
+    for (size_t i = 0; i < count; i++)
+    {
+        dispatchShared(packages[i], readBytes[i]);
+    }
+}
+
+template <typename protocolType, uint32_t numberOfQueues>
+void
+ProtocolDispatcher<protocolType, numberOfQueues>::dispatchShared(
+        const outpost::utils::SharedBufferPointer& package, uint32_t readBytes)
+{
+    if (package.isValid())
+    {
+        outpost::Slice<const uint8_t> data = package.asSlice();
+        dispatch(data, &package, readBytes);
+    }
+    else
+    {
+        dispatch(outpost::Slice<const uint8_t>::empty(), nullptr, readBytes);
+    }
+}
+
+template <typename protocolType, uint32_t numberOfQueues>
+void
+ProtocolDispatcher<protocolType, numberOfQueues>::dispatch(
+        const outpost::Slice<const uint8_t>& package,
+        const outpost::utils::SharedBufferPointer* shared,
+        uint32_t readBytes)
+{
+    using outpost::utils::internal::counterAdd;
+
     if (readBytes > 0)  // just to be save
     {
-        outpost::rtos::MutexGuard lock(mMutex);
         if (readBytes > package.getNumberOfElements())
         {
             uint32_t cut = readBytes - package.getNumberOfElements();
-            mNumberOfPartialPackages++;
-            mNumberOfOverflowedBytes += cut;
+            counterAdd(mNumberOfPartialPackages, 1);
+            counterAdd(mNumberOfOverflowedBytes, cut);
         }
 
+        // Listeners added concurrently are not visible before they are complete
+        const uint32_t numberOfListeners = mNumberOfListeners.load();
         bool dropped = true;
         bool found = false;
+        outpost::utils::SharedBufferPointer copy;
         uint32_t effectiveLength =
                 outpost::utils::min<uint32_t>(package.getNumberOfElements(), readBytes);
         if (effectiveLength >= mOffset + sizeof(protocolType))
@@ -215,37 +354,44 @@ ProtocolDispatcher<protocolType, numberOfQueues>::handlePackage(
             // aligned in buffer
             memcpy(&id, &package[mOffset], sizeof(protocolType));
 
-            for (unsigned int i = 0; i < mNumberOfListeners; i++)
+            for (uint32_t i = mIndex.first(id); i < numberOfListeners; i = mIndex.next(id, i))
             {
-                if (mListeners[i].mId == id)
+                found = true;
+                if (insertIntoQueue(mListeners[i], package, shared, copy, readBytes))
                 {
+                    dropped = false;
+                }
+            }
+        }
+
+        // All rules are evaluated in the same pass over the received package
+        mMatchTable.forEachMatch(
+                package.first(effectiveLength), numberOfListeners, [&](uint32_t i) {
                     found = true;
-                    if (insertIntoQueue(mListeners[i], package, readBytes))
+                    if (insertIntoQueue(mListeners[i], package, shared, copy, readBytes))
                     {
                         dropped = false;
                     }
-                }
-            }
-        }
+                });
 
         if (!found)
         {
-            if (mDefaultListener.mQueue != nullptr)
+            if (mHasDefaultListener.load())
             {
-                if (insertIntoQueue(mDefaultListener, package, readBytes))
+                if (insertIntoQueue(mDefaultListener, package, shared, copy, readBytes))
                 {
                     dropped = false;
                 }
             }
             else
             {
-                mNumberOfUnmatchedPackages++;
+                counterAdd(mNumberOfUnmatchedPackages, 1);
             }
         }
 
         if (dropped)
         {
-            mNumberOfDroppedPackages++;
+            counterAdd(mNumberOfDroppedPackages, 1);
         }
     }
 }
@@ -255,44 +401,147 @@ bool
 ProtocolDispatcher<protocolType, numberOfQueues>::insertIntoQueue(
         ProtocolDispatcher<protocolType, numberOfQueues>::Listener& listener,
         const outpost::Slice<const uint8_t>& package,
+        const outpost::utils::SharedBufferPointer* shared,
+        outpost::utils::SharedBufferPointer& copy,
         uint32_t readBytes)
 {
+    using outpost::utils::internal::counterAdd;
+
     bool inserted = false;
+    bool stored = false;
+    uint32_t effectiveSize = 0;
+    const uint32_t receivedSize =
+            outpost::utils::min<uint32_t>(readBytes, package.getNumberOfElements());
+    outpost::utils::SharedChildPointer child;
 
-    outpost::utils::SharedBufferPointer sharedBuffer;
-    if (listener.mPool->allocate(sharedBuffer))
+    if (isOverloaded(listener))
     {
-        uint32_t effectiveSize = outpost::utils::min<uint32_t>(
-                readBytes, sharedBuffer.getLength(), package.getNumberOfElements());
-
-        memcpy(&sharedBuffer->getPointer()[0], &package[0], effectiveSize);
-        outpost::utils::SharedChildPointer child;
-        sharedBuffer.getChild(child, 0, 0, effectiveSize);
-        if (!listener.mDropPartial || effectiveSize >= readBytes)
+        // early discard, before a buffer is allocated and the package is copied
+        counterAdd(listener.mNumberOfShedPackages, 1);
+    }
+    else if (listener.mPool == nullptr)
+    {
+        // zero-copy, hand out a reference to the received buffer
+        if (shared != nullptr)
         {
-            inserted = listener.mQueue->send(child);
+            effectiveSize = receivedSize;
+            stored = shared->getChild(child, 0, 0, effectiveSize);
         }
-
-        if (inserted)
+    }
+    else if (mSharedDelivery && copy.isValid() && (copy.getLength() >= receivedSize))
+    {
+        // reuse the copy made for a previous listener, it holds the whole package
+        effectiveSize = receivedSize;
+        stored = copy.getChild(child, 0, 0, effectiveSize);
+    }
+    else
+    {
+        outpost::utils::SharedBufferPointer sharedBuffer;
+        if (allocate(listener, sharedBuffer, readBytes))
         {
-            if (effectiveSize < readBytes)
+            effectiveSize = outpost::utils::min<uint32_t>(receivedSize, sharedBuffer.getLength());
+
+            memcpy(&sharedBuffer->getPointer()[0], &package[0], effectiveSize);
+            stored = sharedBuffer.getChild(child, 0, 0, effectiveSize);
+
+            // A cut copy is replaced by a longer one for the following listeners
+            if (mSharedDelivery
+                && (!copy.isValid() || (sharedBuffer.getLength() > copy.getLength())))
             {
-                listener.mNumberOfOverflowedBytes += readBytes - effectiveSize;
-                listener.mNumberOfPartialPackages++;
+                copy = sharedBuffer;
             }
         }
-        else
+    }
+
+    if (stored && (!listener.mDropPartial || effectiveSize >= readBytes))
+    {
+        inserted = listener.mQueue->send(std::move(child));
+    }
+
+    if (inserted)
+    {
+        OUTPOST_TRACE(outpost::utils::trace::packetQueued, effectiveSize, 0);
+        if (effectiveSize < readBytes)
         {
-            listener.mNumberOfDroppedPackages++;
+            counterAdd(listener.mNumberOfOverflowedBytes, readBytes - effectiveSize);
+            counterAdd(listener.mNumberOfPartialPackages, 1);
         }
     }
     else
     {
-        listener.mNumberOfDroppedPackages++;
+        counterAdd(listener.mNumberOfDroppedPackages, 1);
     }
     return inserted;
 };
 
+template <typename protocolType, uint32_t numberOfQueues>
+inline bool
+ProtocolDispatcher<protocolType, numberOfQueues>::isValid(const ListenerPolicy& policy)
+{
+    return (policy.mHighWatermark == 0) || (policy.mLowWatermark < policy.mHighWatermark);
+}
+
+template <typename protocolType, uint32_t numberOfQueues>
+inline bool
+ProtocolDispatcher<protocolType, numberOfQueues>::isOverloaded(
+        ProtocolDispatcher<protocolType, numberOfQueues>::Listener& listener)
+{
+    const ListenerPolicy& policy = listener.mPolicy;
+    if (policy.mHighWatermark == 0)
+    {
+        return false;
+    }
+
+    // Concurrent dispatches may both toggle the state, the hysteresis only
+    // has to be approximate
+    const uint16_t items = listener.mQueue->getNumberOfItems();
+    if (listener.mShedding.load())
+    {
+        if (items <= policy.mLowWatermark)
+        {
+            listener.mShedding.store(false);
+        }
+    }
+    else if (items >= policy.mHighWatermark)
+    {
+        listener.mShedding.store(true);
+    }
+    return listener.mShedding.load();
+}
+
+template <typename protocolType, uint32_t numberOfQueues>
+inline bool
+ProtocolDispatcher<protocolType, numberOfQueues>::allocate(
+        ProtocolDispatcher<protocolType, numberOfQueues>::Listener& listener,
+        outpost::utils::SharedBufferPointer& buffer,
+        uint32_t readBytes)
+{
+    using outpost::utils::internal::counterAdd;
+
+    const ListenerPolicy& policy = listener.mPolicy;
+    const bool reserved = (policy.mPoolReserve != 0)
+                          && (listener.mPool->numberOfFreeElements() <= policy.mPoolReserve);
+    if (!reserved && listener.mPool->allocateForLength(buffer, readBytes))
+    {
+        return true;
+    }
+
+    outpost::utils::SharedBufferPoolBase* fallback =
+            (policy.mBorrowFromDefaultPool && mHasDefaultListener.load()) ? mDefaultListener.mPool
+                                                                           : nullptr;
+    if ((fallback != nullptr) && (fallback != listener.mPool)
+        && fallback->allocateForLength(buffer, readBytes))
+    {
+        return true;
+    }
+
+    if (reserved)
+    {
+        counterAdd(listener.mNumberOfShedPackages, 1);
+    }
+    return false;
+}
+
 }  // namespace hal
 }  // namespace outpost
 
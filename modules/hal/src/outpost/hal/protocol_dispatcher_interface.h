@@ -101,6 +101,31 @@ public:
      */
     virtual void
     handlePackage(const outpost::Slice<const uint8_t>& package, uint32_t readBytes) = 0;
+
+    /**
+     * Handles a package that has been received directly into a shared buffer.
+     *
+     * Listeners registered without a pool receive a child pointer to the
+     * given buffer instead of a copy.
+     *
+     * @param package	The shared buffer containing the package
+     * @param readBytes	The number of bytes in the packages may be larger then the buffer, in that
+     * case the package has been cut
+     */
+    virtual void
+    handlePackage(const outpost::utils::SharedBufferPointer& package, uint32_t readBytes) = 0;
+
+    /**
+     * Handles several packages at once, equal to calling
+     * handlePackage(package[i], readBytes[i]) for each of them but
+     * without re-acquiring internal locks per package.
+     *
+     * @param packages	The shared buffers containing the packages
+     * @param readBytes	The number of bytes of each package
+     */
+    virtual void
+    handlePackages(outpost::Slice<const outpost::utils::SharedBufferPointer> packages,
+                   outpost::Slice<const uint32_t> readBytes) = 0;
 };
 
 template <typename protocolType  // pod and must support operator=, operator==, and default
@@ -119,11 +144,12 @@ public:
      * @param[in] queue	The queue that will get all packages that are not matched by any regular
      * queue
      * @param[in] pool the pool to get the storage from, the provided memories shall be large enough
-     * to fit a package
+     * to fit a package. If nullptr, the queue gets a child pointer to the received buffer instead
+     * of a copy (zero-copy), this requires packages to be handled as SharedBufferPointer.
      * @param[in] dropPartial   if true only complete packages will be put into the queue
      *
      * @return	True 	if successfull
-     * 			false 	if nullptr or already set
+     * 			false 	if queue is nullptr or already set
      */
     virtual bool
     setDefaultQueue(outpost::utils::SharedBufferPoolBase* pool,
@@ -136,12 +162,17 @@ public:
      *
      * @param[in] id	The id value to listen to
      * @param[in] pool	The pool to allocate memory from, the provided memories shall be large
-     * enough to fit a package of the specific protocol
+     * enough to fit a package of the specific protocol. If nullptr, the queue gets a child pointer
+     * to the received buffer instead of a copy (zero-copy), this requires packages to be handled
+     * as SharedBufferPointer.
+     * The buffer is allocated with SharedBufferPoolBase::allocateForLength(), a
+     * utils::SizeClassSharedBufferPool therefore provides small or large buffers depending on
+     * the length of the package.
      * @param[in] queue	The queue to write the values to
      * @param[in] dropPartial   if true only complete packages will be put into the queue
      *
      * @return	true if successful
-     * 			false	if nullpointer or all queue places filled up
+     * 			false	if queue is nullpointer or all queue places filled up
      */
     virtual bool
     addQueue(protocolType id,
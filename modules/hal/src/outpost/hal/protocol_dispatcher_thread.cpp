@@ -13,6 +13,8 @@
 
 #include "protocol_dispatcher_thread.h"
 
+#include <outpost/utils/trace/trace.h>
+
 namespace outpost
 {
 namespace hal
@@ -22,16 +24,67 @@ ProtocolDispatcherThread::run()
 {
     while (true)
     {
-        outpost::support::Heartbeat::send(mHeartbeatSource, mWaitTime + mDispatchTime);
+        mHeartbeat.send(mWaitTime + mDispatchTime);
+
+        if (mPool != nullptr)
+        {
+            receiveIntoPool();
+        }
+        else if (mBuffer.getNumberOfElements() > 0)
+        {
+            receiveIntoBuffer();
+        }
+        else
+        {
+            receiveLoaned();
+        }
+    }
+}
 
-        // ensures receive does not change the mBuffer length.
-        outpost::Slice<uint8_t> tmp = mBuffer;
+void
+ProtocolDispatcherThread::receiveIntoBuffer()
+{
+    // ensures receive does not change the mBuffer length.
+    outpost::Slice<uint8_t> tmp = mBuffer;
+    uint32_t readByte = mReceiver.receive(tmp, mWaitTime);
+    if (readByte > 0)
+    {
+        OUTPOST_TRACE(outpost::utils::trace::packetReceived, readByte, 1);
+        mPD.handlePackage(mBuffer, readByte);
+    }
+}
+
+void
+ProtocolDispatcherThread::receiveIntoPool()
+{
+    outpost::utils::SharedBufferPointer buffer;
+    if (mPool->allocate(buffer))
+    {
+        outpost::Slice<uint8_t> tmp = buffer.asSlice();
         uint32_t readByte = mReceiver.receive(tmp, mWaitTime);
         if (readByte > 0)
         {
-            mPD.handlePackage(mBuffer, readByte);
+            OUTPOST_TRACE(outpost::utils::trace::packetReceived, readByte, 1);
+            mPD.handlePackage(buffer, readByte);
         }
     }
+    else
+    {
+        // all buffers still in use by the listeners
+        outpost::rtos::Thread::sleep(mDispatchTime);
+    }
+}
+
+void
+ProtocolDispatcherThread::receiveLoaned()
+{
+    outpost::utils::SharedBufferPointer buffer;
+    uint32_t readByte = mReceiver.receiveLoaned(buffer, mWaitTime);
+    if (readByte > 0)
+    {
+        OUTPOST_TRACE(outpost::utils::trace::packetReceived, readByte, 1);
+        mPD.handlePackage(buffer, readByte);
+    }
 }
 
 }  // namespace hal
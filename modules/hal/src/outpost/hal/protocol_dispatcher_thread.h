@@ -19,7 +19,8 @@
 
 #include <outpost/base/slice.h>
 #include <outpost/rtos.h>
-#include <outpost/support/heartbeat.h>
+#include <outpost/support/heartbeat_limiter.h>
+#include <outpost/time/clock.h>
 #include <outpost/time/duration.h>
 
 #include <stdint.h>
@@ -57,24 +58,122 @@ public:
         mPD(pd),
         mReceiver(receiver),
         mBuffer(buffer),
-        mHeartbeatSource(heartbeatSource),
+        mPool(nullptr),
+        mHeartbeat(heartbeatSource),
         mWaitTime(waitTime),
         mDispatchTime(dispatchTime)
     {
     }
 
+    /**
+     * Zero-copy variant, every package is received directly into a buffer
+     * from \p pool and handed to the dispatcher as SharedBufferPointer.
+     * Listeners registered without an own pool then share that buffer.
+     *
+     * @param receiver        the object used to receive packages
+     * @param pool            pool to receive the packages into, the buffers should be equal or
+     * larger than the largest package that can be received, or data will be dropped
+     * @param priority        see outpost::rtos::Thread
+     * @param stackSize       see outpost::rtos::Thread
+     * @param threadName      see outpost::rtos::Thread
+     * @param heartbeatSource heartbeat id for the worker thread
+     * @param waitTime		  Time to wait on a receive
+     * @param dispatchTime    Small time addition to insert data into the queues, must be larger
+     * than zero), also used as retry interval if the pool is exhausted
+     */
+    ProtocolDispatcherThread(ProtocolDispatcherInterfaceBase& pd,
+                             ReceiverInterface& receiver,
+                             outpost::utils::SharedBufferPoolBase& pool,
+                             uint8_t priority,
+                             size_t stackSize,
+                             char* threadName,
+                             outpost::support::parameter::HeartbeatSource heartbeatSource,
+                             outpost::time::Duration waitTime = outpost::time::Seconds(10),
+                             outpost::time::Duration dispatchTime = outpost::time::Seconds(1)) :
+        outpost::rtos::Thread(priority, stackSize, threadName),
+        mPD(pd),
+        mReceiver(receiver),
+        mBuffer(outpost::Slice<uint8_t>::empty()),
+        mPool(&pool),
+        mHeartbeat(heartbeatSource),
+        mWaitTime(waitTime),
+        mDispatchTime(dispatchTime)
+    {
+    }
+
+    /**
+     * Loaning variant, every package is received into a buffer provided by
+     * \p receiver, see ReceiverInterface::receiveLoaned(), and handed to
+     * the dispatcher as SharedBufferPointer. Listeners registered without
+     * an own pool then share the buffer of the receiver, which gets it back
+     * once the last listener has dropped it.
+     *
+     * @param receiver        the object used to receive packages, must support loaning
+     * @param priority        see outpost::rtos::Thread
+     * @param stackSize       see outpost::rtos::Thread
+     * @param threadName      see outpost::rtos::Thread
+     * @param heartbeatSource heartbeat id for the worker thread
+     * @param waitTime		  Time to wait on a receive
+     * @param dispatchTime    Small time addition to insert data into the queues, must be larger
+     * than zero)
+     */
+    ProtocolDispatcherThread(ProtocolDispatcherInterfaceBase& pd,
+                             ReceiverInterface& receiver,
+                             uint8_t priority,
+                             size_t stackSize,
+                             char* threadName,
+                             outpost::support::parameter::HeartbeatSource heartbeatSource,
+                             outpost::time::Duration waitTime = outpost::time::Seconds(10),
+                             outpost::time::Duration dispatchTime = outpost::time::Seconds(1)) :
+        outpost::rtos::Thread(priority, stackSize, threadName),
+        mPD(pd),
+        mReceiver(receiver),
+        mBuffer(outpost::Slice<uint8_t>::empty()),
+        mPool(nullptr),
+        mHeartbeat(heartbeatSource),
+        mWaitTime(waitTime),
+        mDispatchTime(dispatchTime)
+    {
+    }
+
+    /**
+     * Limit the heartbeat ticks to one per \p interval.
+     *
+     * By default a tick is sent for every received package, which results
+     * in a high rate of ticks for high package rates.
+     *
+     * \warning Must be called before the thread is started.
+     */
+    inline void
+    setHeartbeatInterval(outpost::time::Clock& clock, outpost::time::Duration interval)
+    {
+        mHeartbeat.setInterval(clock, interval);
+    }
+
 protected:
     void
     run() override;
 
 private:
+    void
+    receiveIntoBuffer();
+
+    void
+    receiveIntoPool();
+
+    void
+    receiveLoaned();
+
     ProtocolDispatcherInterfaceBase& mPD;
 
     ReceiverInterface& mReceiver;
 
     outpost::Slice<uint8_t> mBuffer;
 
-    const outpost::support::parameter::HeartbeatSource mHeartbeatSource;
+    // nullptr if receiving into mBuffer or loaning from the receiver (mBuffer empty)
+    outpost::utils::SharedBufferPoolBase* const mPool;
+
+    outpost::support::HeartbeatLimiter mHeartbeat;
 
     const outpost::time::Duration mWaitTime;
     const outpost::time::Duration mDispatchTime;
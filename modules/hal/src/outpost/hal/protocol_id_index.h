@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_HAL_PROTOCOL_ID_INDEX_H_
+#define OUTPOST_HAL_PROTOCOL_ID_INDEX_H_
+
+#include <stdint.h>
+
+#include <array>
+
+namespace outpost
+{
+namespace hal
+{
+/**
+ * Maps protocol ids to the indices of the listeners registered for them.
+ *
+ * Listeners for one id are visited in the order they were added:
+ *
+ * \code
+ * for (uint32_t i = index.first(id); i != index.end(); i = index.next(id, i))
+ * {
+ *     ...
+ * }
+ * \endcode
+ *
+ * The generic version only requires operator== on \p protocolType and
+ * searches linearly. uint8_t ids use a direct-mapped table, see the
+ * specialization below.
+ *
+ * add() is not synchronized with the lookups, the fields are plain
+ * values. A lookup concurrent to add() may read the entry being added,
+ * which can only yield the new, highest listener index. The
+ * ProtocolDispatcher publishes a listener through its atomic listener
+ * count after add() and ignores all indices at or above the count it
+ * loaded before the lookup. This relies on aligned loads and stores of
+ * the 16 and 32 bit listener indices not being torn, which holds for all
+ * supported targets.
+ *
+ * \tparam protocolType
+ *      Type of the protocol id.
+ * \tparam numberOfQueues
+ *      Maximum number of listeners.
+ */
+template <typename protocolType, uint32_t numberOfQueues>
+class ProtocolIdIndex
+{
+public:
+    ProtocolIdIndex() : mIds(), mListeners(), mNumberOfEntries(0)
+    {
+        mListeners.fill(end());
+    }
+
+    /**
+     * Add a listener, must be called with ascending listener indices.
+     * Listener indices without an id, e.g. listeners with a
+     * ProtocolMatchRule, may be skipped.
+     */
+    inline void
+    add(protocolType id, uint32_t listener)
+    {
+        // The listener is written last, an entry only becomes visible with it
+        mIds[mNumberOfEntries] = id;
+        mListeners[mNumberOfEntries] = listener;
+        mNumberOfEntries++;
+    }
+
+    inline uint32_t
+    first(protocolType id) const
+    {
+        return find(id, 0);
+    }
+
+    inline uint32_t
+    next(protocolType id, uint32_t current) const
+    {
+        return find(id, current + 1);
+    }
+
+    static constexpr uint32_t
+    end()
+    {
+        return numberOfQueues;
+    }
+
+private:
+    inline uint32_t
+    find(protocolType id, uint32_t start) const
+    {
+        for (uint32_t i = 0; (i < numberOfQueues) && (mListeners[i] != end()); i++)
+        {
+            if ((mListeners[i] >= start) && (mIds[i] == id))
+            {
+                return mListeners[i];
+            }
+        }
+        return end();
+    }
+
+    std::array<protocolType, numberOfQueues> mIds;
+    std::array<uint32_t, numberOfQueues> mListeners;
+    uint32_t mNumberOfEntries;
+};
+
+/**
+ * Direct-mapped index for 8 bit protocol ids.
+ *
+ * Holds the first listener of every id and a chain to the following
+ * listeners for the same id, lookup is O(1) independent of the number of
+ * registered listeners. Concurrent lookups follow the same rules as for
+ * the generic version.
+ */
+template <uint32_t numberOfQueues>
+class ProtocolIdIndex<uint8_t, numberOfQueues>
+{
+    static_assert(numberOfQueues < 0xFFFF, "Too many queues for the index type");
+
+public:
+    ProtocolIdIndex()
+    {
+        mFirst.fill(endIndex);
+        mNext.fill(endIndex);
+    }
+
+    /**
+     * Add a listener, must be called with ascending listener indices.
+     */
+    inline void
+    add(uint8_t id, uint32_t listener)
+    {
+        uint16_t* slot = &mFirst[id];
+        while (*slot != endIndex)
+        {
+            slot = &mNext[*slot];
+        }
+        *slot = static_cast<uint16_t>(listener);
+    }
+
+    inline uint32_t
+    first(uint8_t id) const
+    {
+        return mFirst[id];
+    }
+
+    inline uint32_t
+    next(uint8_t /*id*/, uint32_t current) const
+    {
+        return mNext[current];
+    }
+
+    static constexpr uint32_t
+    end()
+    {
+        return numberOfQueues;
+    }
+
+private:
+    static constexpr uint16_t endIndex = static_cast<uint16_t>(numberOfQueues);
+
+    std::array<uint16_t, 256> mFirst;
+    std::array<uint16_t, numberOfQueues> mNext;
+};
+
+template <uint32_t numberOfQueues>
+constexpr uint16_t ProtocolIdIndex<uint8_t, numberOfQueues>::endIndex;
+
+}  // namespace hal
+}  // namespace outpost
+
+#endif /* OUTPOST_HAL_PROTOCOL_ID_INDEX_H_ */
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_HAL_PROTOCOL_MATCH_TABLE_H_
+#define OUTPOST_HAL_PROTOCOL_MATCH_TABLE_H_
+
+#include <outpost/base/slice.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+
+namespace outpost
+{
+namespace hal
+{
+/**
+ * Rule matching a package by several fields.
+ *
+ * A field is the big endian value of 1 to 4 bytes at an offset, masked
+ * before the comparison. A package matches if all fields match, e.g. a
+ * protocol id and a sub-type:
+ *
+ * \code
+ * ProtocolMatchRule rule = ProtocolMatchRule().field(1, 1, 0xFF, 0xE0).field(3, 1, 0xFF, 2);
+ * \endcode
+ *
+ * or the 11 bit APID of a CCSDS space packet following a one byte
+ * header:
+ *
+ * \code
+ * ProtocolMatchRule rule = ProtocolMatchRule().field(1, 2, 0x07FF, apid);
+ * \endcode
+ */
+class ProtocolMatchRule
+{
+public:
+    static constexpr size_t maximumNumberOfFields = 4;
+
+    struct Field
+    {
+        Field() : mOffset(0), mMask(0), mValue(0), mLength(0)
+        {
+        }
+
+        uint32_t mOffset;
+        uint32_t mMask;
+        uint32_t mValue;
+        uint8_t mLength;
+    };
+
+    ProtocolMatchRule() : mFields(), mNumberOfFields(0), mValid(true)
+    {
+    }
+
+    /**
+     * Add a field to the rule.
+     *
+     * The rule becomes invalid if it has too many fields, the length is
+     * not between 1 and 4, or \p value has bits outside of \p mask.
+     *
+     * \return  The rule for chaining.
+     */
+    inline ProtocolMatchRule&
+    field(uint32_t offset, uint8_t length, uint32_t mask, uint32_t value)
+    {
+        if ((mNumberOfFields >= maximumNumberOfFields) || (length == 0) || (length > 4)
+            || ((value & ~mask) != 0))
+        {
+            mValid = false;
+        }
+        else
+        {
+            Field& f = mFields[mNumberOfFields++];
+            f.mOffset = offset;
+            f.mLength = length;
+            f.mMask = mask;
+            f.mValue = value;
+        }
+        return *this;
+    }
+
+    /**
+     * Whether all fields were accepted and there is at least one.
+     */
+    inline bool
+    isValid() const
+    {
+        return mValid && (mNumberOfFields > 0);
+    }
+
+    inline size_t
+    getNumberOfFields() const
+    {
+        return mNumberOfFields;
+    }
+
+    inline const Field&
+    getField(size_t index) const
+    {
+        return mFields[index];
+    }
+
+private:
+    std::array<Field, maximumNumberOfFields> mFields;
+    size_t mNumberOfFields;
+    bool mValid;
+};
+
+/**
+ * Decision table of the match rules of a ProtocolDispatcher.
+ *
+ * The fields of all rules are compiled into a list of distinct keys
+ * (offset, length and mask) when a rule is added. A package is matched
+ * by reading every key once from the package and comparing the values
+ * of each rule against them, fields shared by several rules, e.g. the
+ * protocol id, are therefore extracted only once.
+ *
+ * \tparam numberOfRules
+ *      Maximum number of rules.
+ */
+template <uint32_t numberOfRules>
+class ProtocolMatchTable
+{
+public:
+    static constexpr size_t maximumNumberOfKeys =
+            numberOfRules * ProtocolMatchRule::maximumNumberOfFields;
+
+    ProtocolMatchTable() : mKeys(), mEntries(), mNumberOfKeys(0), mNumberOfEntries(0)
+    {
+    }
+
+    /**
+     * Add a rule for a listener, must be called with ascending listener
+     * indices and not concurrently with other calls of add().
+     *
+     * \retval false  Rule is invalid or the table is full.
+     */
+    bool
+    add(const ProtocolMatchRule& rule, uint32_t listener)
+    {
+        if (!rule.isValid() || (mNumberOfEntries >= numberOfRules))
+        {
+            return false;
+        }
+
+        Entry& entry = mEntries[mNumberOfEntries];
+        entry.mNumberOfFields = rule.getNumberOfFields();
+        for (size_t i = 0; i < entry.mNumberOfFields; i++)
+        {
+            const ProtocolMatchRule::Field& field = rule.getField(i);
+            entry.mKeys[i] = getKey(field);
+            entry.mValues[i] = field.mValue;
+        }
+        entry.mListener = listener;
+        mNumberOfEntries++;
+        return true;
+    }
+
+    inline bool
+    isEmpty() const
+    {
+        return mNumberOfEntries == 0;
+    }
+
+    /**
+     * Call \p function with the listener index of every rule matching
+     * \p package, in the order the rules were added.
+     *
+     * Only rules of listeners below \p numberOfListeners are evaluated.
+     * Rules are written completely before the listener count is
+     * published, a concurrent add() is therefore not visible to an
+     * ongoing match. The keys, the key count and Entry::mListener are
+     * plain fields nevertheless read while add() may write them: a key
+     * being added is only used by the new rule, and the listener index
+     * of the new rule is at least \p numberOfListeners, which stops the
+     * evaluation. As for ProtocolIdIndex this relies on aligned 32 bit
+     * loads and stores not being torn.
+     *
+     * Fields beyond the end of the package do not match.
+     */
+    template <typename Function>
+    void
+    forEachMatch(const outpost::Slice<const uint8_t>& package,
+                 uint32_t numberOfListeners,
+                 Function function) const
+    {
+        if ((numberOfListeners == 0) || (mEntries[0].mListener >= numberOfListeners))
+        {
+            return;
+        }
+
+        uint32_t values[maximumNumberOfKeys];
+        bool present[maximumNumberOfKeys];
+        const size_t numberOfKeys = mNumberOfKeys;
+        for (size_t k = 0; k < numberOfKeys; k++)
+        {
+            present[k] = read(package, mKeys[k], values[k]);
+        }
+
+        for (size_t e = 0; (e < numberOfRules) && (mEntries[e].mListener < numberOfListeners);
+             e++)
+        {
+            const Entry& entry = mEntries[e];
+            bool match = true;
+            for (size_t i = 0; match && (i < entry.mNumberOfFields); i++)
+            {
+                const size_t k = entry.mKeys[i];
+                match = (k < numberOfKeys) && present[k] && (values[k] == entry.mValues[i]);
+            }
+            if (match)
+            {
+                function(entry.mListener);
+            }
+        }
+    }
+
+private:
+    struct Key
+    {
+        Key() : mOffset(0), mMask(0), mLength(0)
+        {
+        }
+
+        uint32_t mOffset;
+        uint32_t mMask;
+        uint8_t mLength;
+    };
+
+    static constexpr uint32_t unused = UINT32_MAX;
+
+    struct Entry
+    {
+        Entry() : mKeys(), mValues(), mListener(unused), mNumberOfFields(0)
+        {
+        }
+
+        std::array<uint16_t, ProtocolMatchRule::maximumNumberOfFields> mKeys;
+        std::array<uint32_t, ProtocolMatchRule::maximumNumberOfFields> mValues;
+        uint32_t mListener;
+        size_t mNumberOfFields;
+    };
+
+    uint16_t
+    getKey(const ProtocolMatchRule::Field& field)
+    {
+        for (size_t k = 0; k < mNumberOfKeys; k++)
+        {
+            if ((mKeys[k].mOffset == field.mOffset) && (mKeys[k].mLength == field.mLength)
+                && (mKeys[k].mMask == field.mMask))
+            {
+                return static_cast<uint16_t>(k);
+            }
+        }
+        Key& key = mKeys[mNumberOfKeys];
+        key.mOffset = field.mOffset;
+        key.mLength = field.mLength;
+        key.mMask = field.mMask;
+        return static_cast<uint16_t>(mNumberOfKeys++);
+    }
+
+    static inline bool
+    read(const outpost::Slice<const uint8_t>& package, const Key& key, uint32_t& value)
+    {
+        if (static_cast<size_t>(key.mOffset) + key.mLength > package.getNumberOfElements())
+        {
+            return false;
+        }
+        uint32_t raw = 0;
+        for (size_t i = 0; i < key.mLength; i++)
+        {
+            raw = (raw << 8) | package[key.mOffset + i];
+        }
+        value = raw & key.mMask;
+        return true;
+    }
+
+    std::array<Key, maximumNumberOfKeys> mKeys;
+    std::array<Entry, numberOfRules> mEntries;
+    size_t mNumberOfKeys;
+    size_t mNumberOfEntries;
+};
+
+template <uint32_t numberOfRules>
+constexpr size_t ProtocolMatchTable<numberOfRules>::maximumNumberOfKeys;
+
+template <uint32_t numberOfRules>
+constexpr uint32_t ProtocolMatchTable<numberOfRules>::unused;
+
+}  // namespace hal
+}  // namespace outpost
+
+#endif /* OUTPOST_HAL_PROTOCOL_MATCH_TABLE_H_ */
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "receiver_interface.h"
+
+#include <outpost/utils/minmax.h>
+
+namespace outpost
+{
+namespace hal
+{
+size_t
+ReceiverInterface::receiveBatch(outpost::Slice<outpost::utils::SharedBufferPointer> buffers,
+                                outpost::Slice<uint32_t> readBytes,
+                                outpost::time::Duration timeout)
+{
+    const size_t maximum = outpost::utils::min<size_t>(buffers.getNumberOfElements(),
+                                                       readBytes.getNumberOfElements());
+    size_t count = 0;
+    outpost::time::Duration wait = timeout;
+    while (count < maximum)
+    {
+        outpost::Slice<uint8_t> buffer = buffers[count].asSlice();
+        uint32_t received = receive(buffer, wait);
+        if (received == 0)
+        {
+            break;
+        }
+        readBytes[count] = received;
+        count++;
+
+        // only drain what is already there
+        wait = outpost::time::Duration::zero();
+    }
+    return count;
+}
+
+uint32_t
+ReceiverInterface::receiveLoaned(outpost::utils::SharedBufferPointer& /*buffer*/,
+                                 outpost::time::Duration /*timeout*/)
+{
+    return 0;
+}
+
+}  // namespace hal
+}  // namespace outpost
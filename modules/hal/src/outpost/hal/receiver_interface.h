@@ -16,6 +16,7 @@
 
 #include <outpost/base/slice.h>
 #include <outpost/time/duration.h>
+#include <outpost/utils/container/shared_buffer.h>
 
 #include <stdint.h>
 
@@ -40,6 +41,43 @@ public:
      */
     virtual uint32_t
     receive(outpost::Slice<uint8_t>& buffer, outpost::time::Duration timeout) = 0;
+
+    /**
+     * receives up to buffers.getNumberOfElements() packages in one call.
+     *
+     * Waits at most timeout for the first package, all further packages are
+     * only taken if already available. The default implementation calls
+     * receive() repeatedly, receivers that can drain their hardware buffers
+     * more efficiently should override it.
+     *
+     * @param buffers	  valid buffers to write the packages to, one per package
+     * @param readBytes   number of bytes received per package, see receive()
+     * @param timeout	  max timeout to wait for the first package
+     *
+     * @return number of received packages, i.e. valid entries in buffers and readBytes
+     */
+    virtual size_t
+    receiveBatch(outpost::Slice<outpost::utils::SharedBufferPointer> buffers,
+                 outpost::Slice<uint32_t> readBytes,
+                 outpost::time::Duration timeout);
+
+    /**
+     * receives a data package into a buffer provided by the receiver
+     *
+     * Allows receivers to hand out their own memory (e.g. DMA buffers)
+     * instead of copying the package. The memory is returned to the
+     * receiver when the last reference to the buffer is dropped. The
+     * default implementation does not support loaning and returns 0.
+     *
+     * @param buffer 	set to the buffer containing the package
+     * @param timeout	max timeout to wait for data
+     *
+     * @return 0	If no package received in the time, failure in underlying receiver or
+     * 				loaning not supported
+     * 		   >0   Number of bytes received in package
+     */
+    virtual uint32_t
+    receiveLoaned(outpost::utils::SharedBufferPointer& buffer, outpost::time::Duration timeout);
 };
 
 }  // namespace hal
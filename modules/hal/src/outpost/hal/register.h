@@ -22,6 +22,65 @@ namespace outpost
 {
 namespace hal
 {
+namespace internal
+{
+/// Mask of a Register::Bitfield or Register::SingleBit within its register
+template <typename T>
+constexpr uint32_t
+getFieldMask()
+{
+    return static_cast<uint32_t>(((static_cast<uint64_t>(1) << ((T::start - T::end) + 1)) - 1)
+                                 << T::end);
+}
+
+template <typename T>
+struct FieldValue
+{
+    typedef uint32_t Type;
+};
+
+/// Combined mask and value of several fields of the same register
+template <typename... Fields>
+struct FieldSet;
+
+template <typename Field>
+struct FieldSet<Field>
+{
+    typedef typename Field::Type Type;
+    static constexpr uint32_t address = Field::address;
+    static constexpr uint32_t mask = getFieldMask<Field>();
+
+    static inline uint32_t
+    compose(uint32_t value)
+    {
+        return (value << Field::end) & mask;
+    }
+};
+
+template <typename Field, typename Next, typename... Fields>
+struct FieldSet<Field, Next, Fields...>
+{
+    typedef FieldSet<Next, Fields...> Others;
+
+    static_assert(Field::address == Others::address
+                          && sizeof(typename Field::Type) == sizeof(typename Others::Type),
+                  "All fields must belong to the same register");
+    static_assert((getFieldMask<Field>() & Others::mask) == 0, "Fields must not overlap");
+
+    typedef typename Field::Type Type;
+    static constexpr uint32_t address = Field::address;
+    static constexpr uint32_t mask = getFieldMask<Field>() | Others::mask;
+
+    static inline uint32_t
+    compose(uint32_t value,
+            typename FieldValue<Next>::Type next,
+            typename FieldValue<Fields>::Type... values)
+    {
+        return ((value << Field::end) & getFieldMask<Field>()) | Others::compose(next, values...);
+    }
+};
+}  // namespace internal
+
 /**
  * Register access.
  *
@@ -119,6 +178,106 @@ public:
     static inline uint32_t
     getMask();
 
+    /**
+     * Update several fields of one register with a single read and a
+     * single write.
+     *
+     * The mask of the fields is calculated at compile time. If the fields
+     * cover the complete register the read is skipped. For example:
+     * \code
+     * Register::modify<General::Prescaler, General::Enable>(100, 1);
+     * \endcode
+     *
+     * \tparam Fields
+     *      Non-overlapping fields of the same register.
+     * \param values
+     *      One value for every field, in the order of \p Fields.
+     */
+    template <typename... Fields>
+    static inline void
+    modify(typename internal::FieldValue<Fields>::Type... values);
+
+    /**
+     * Update several fields of a register value stored in memory.
+     *
+     * \see modify()
+     */
+    template <typename... Fields>
+    static inline void
+    modifyMemory(uint32_t& memory, typename internal::FieldValue<Fields>::Type... values);
+
+    /**
+     * Collect field updates of one register, e.g. depending on runtime
+     * configuration, and apply them with a single read-modify-write.
+     *
+     * \code
+     * Register::Batch<uint32_t, General::address> batch;
+     * batch.set<General::Prescaler>(prescaler);
+     * if (invert)
+     * {
+     *     batch.set<General::Polarity>(1);
+     * }
+     * batch.apply();
+     * \endcode
+     *
+     * The register is only accessed in apply().
+     */
+    template <typename RegisterType, uint32_t registerAddress>
+    class Batch
+    {
+    public:
+        Batch() : mMask(0), mValue(0)
+        {
+        }
+
+        /**
+         * Set a field, replaces an earlier value set for the same field.
+         */
+        template <typename T>
+        inline Batch&
+        set(uint32_t value);
+
+        /**
+         * Read-modify-write all collected fields.
+         *
+         * Only writes the register if the fields cover all its bits and
+         * does nothing if no field was set.
+         */
+        inline void
+        apply() const;
+
+        /**
+         * Write the collected fields, all other bits are set to zero.
+         */
+        inline void
+        overwrite() const;
+
+        /**
+         * Apply the collected fields to a register value stored in memory.
+         */
+        inline void
+        applyTo(uint32_t& memory) const;
+
+        inline uint32_t
+        getMask() const
+        {
+            return mMask;
+        }
+
+        inline uint32_t
+        getValue() const
+        {
+            return mValue;
+        }
+
+    private:
+        static constexpr uint32_t registerMask =
+                static_cast<uint32_t>(static_cast<RegisterType>(~static_cast<RegisterType>(0)));
+
+        uint32_t mMask;
+        uint32_t mValue;
+    };
+
 private:
     // Disable destructor, copy-constructor and copy assignment operator
     Register();
@@ -101,20 +101,89 @@ template <typename T>
 uint32_t
 outpost::hal::Register::getValue(uint32_t value)
 {
-    const int width = (T::end - T::start) + 1;
-    typename T::Type mask = outpost::BitAccess::getMask<typename T::Type>(width);
-    uint32_t t = (value & mask) << T::start;
-    return t;
+    return (value << T::end) & internal::getFieldMask<T>();
 }
 
 template <typename T>
 uint32_t
 outpost::hal::Register::getMask()
 {
-    const int width = (T::end - T::start) + 1;
-    typename T::Type mask = outpost::BitAccess::getMask<typename T::Type>(width);
-    mask <<= T::start;
-    return mask;
+    return internal::getFieldMask<T>();
+}
+
+template <typename... Fields>
+void
+outpost::hal::Register::modify(typename internal::FieldValue<Fields>::Type... values)
+{
+    typedef internal::FieldSet<Fields...> Set;
+    typedef typename Set::Type Type;
+
+    const uint32_t value = Set::compose(values...);
+    const uint32_t registerMask = static_cast<Type>(~static_cast<Type>(0));
+    if (Set::mask == registerMask)
+    {
+        access<Type>(Set::address) = static_cast<Type>(value);
+    }
+    else
+    {
+        const uint32_t registerValue = access<Type>(Set::address);
+        access<Type>(Set::address) = static_cast<Type>((registerValue & ~Set::mask) | value);
+    }
+}
+
+template <typename... Fields>
+void
+outpost::hal::Register::modifyMemory(uint32_t& memory,
+                                     typename internal::FieldValue<Fields>::Type... values)
+{
+    typedef internal::FieldSet<Fields...> Set;
+    memory = (memory & ~Set::mask) | Set::compose(values...);
+}
+
+// ----------------------------------------------------------------------------
+template <typename RegisterType, uint32_t registerAddress>
+template <typename T>
+outpost::hal::Register::Batch<RegisterType, registerAddress>&
+outpost::hal::Register::Batch<RegisterType, registerAddress>::set(uint32_t value)
+{
+    static_assert(T::address == registerAddress, "Field must belong to the register");
+    static_assert(sizeof(typename T::Type) == sizeof(RegisterType),
+                  "Field must have the type of the register");
+
+    const uint32_t mask = internal::getFieldMask<T>();
+    mMask |= mask;
+    mValue = (mValue & ~mask) | ((value << T::end) & mask);
+    return *this;
+}
+
+template <typename RegisterType, uint32_t registerAddress>
+void
+outpost::hal::Register::Batch<RegisterType, registerAddress>::apply() const
+{
+    if (mMask == registerMask)
+    {
+        overwrite();
+    }
+    else if (mMask != 0)
+    {
+        const uint32_t registerValue = access<RegisterType>(registerAddress);
+        access<RegisterType>(registerAddress) =
+                static_cast<RegisterType>((registerValue & ~mMask) | mValue);
+    }
+}
+
+template <typename RegisterType, uint32_t registerAddress>
+void
+outpost::hal::Register::Batch<RegisterType, registerAddress>::overwrite() const
+{
+    access<RegisterType>(registerAddress) = static_cast<RegisterType>(mValue);
+}
+
+template <typename RegisterType, uint32_t registerAddress>
+void
+outpost::hal::Register::Batch<RegisterType, registerAddress>::applyTo(uint32_t& memory) const
+{
+    memory = (memory & ~mMask) | mValue;
 }
 
 #endif
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "scrub_region.h"
+
+#include <outpost/utils/counter_block.h>
+
+using namespace outpost::hal;
+using outpost::utils::DecodeStatus;
+
+static ScrubResult
+toScrubResult(DecodeStatus status)
+{
+    switch (status)
+    {
+        case DecodeStatus::noError: return ScrubResult::clean;
+        case DecodeStatus::corrected: return ScrubResult::corrected;
+        case DecodeStatus::uncorrectable: return ScrubResult::uncorrectable;
+        default: return ScrubResult::failed;
+    }
+}
+
+ScrubRegion::ScrubRegion() :
+    mNext(nullptr),
+    mNextChunk(0),
+    mNumberOfPasses(0),
+    mNumberOfScrubbedChunks(0),
+    mNumberOfCorrectedChunks(0),
+    mNumberOfUncorrectableChunks(0),
+    mNumberOfFailedChunks(0)
+{
+}
+
+uint32_t
+ScrubRegion::getNumberOfPasses() const
+{
+    return outpost::utils::internal::counterLoad(mNumberOfPasses);
+}
+
+uint32_t
+ScrubRegion::getNumberOfScrubbedChunks() const
+{
+    return outpost::utils::internal::counterLoad(mNumberOfScrubbedChunks);
+}
+
+uint32_t
+ScrubRegion::getNumberOfCorrectedChunks() const
+{
+    return outpost::utils::internal::counterLoad(mNumberOfCorrectedChunks);
+}
+
+uint32_t
+ScrubRegion::getNumberOfUncorrectableChunks() const
+{
+    return outpost::utils::internal::counterLoad(mNumberOfUncorrectableChunks);
+}
+
+uint32_t
+ScrubRegion::getNumberOfFailedChunks() const
+{
+    return outpost::utils::internal::counterLoad(mNumberOfFailedChunks);
+}
+
+void
+ScrubRegion::account(ScrubResult result)
+{
+    using outpost::utils::internal::counterAdd;
+
+    counterAdd(mNumberOfScrubbedChunks, 1);
+    switch (result)
+    {
+        case ScrubResult::corrected: counterAdd(mNumberOfCorrectedChunks, 1); break;
+        case ScrubResult::uncorrectable: counterAdd(mNumberOfUncorrectableChunks, 1); break;
+        case ScrubResult::failed: counterAdd(mNumberOfFailedChunks, 1); break;
+        case ScrubResult::clean: break;
+    }
+
+    mNextChunk++;
+    if (mNextChunk >= getNumberOfChunks())
+    {
+        mNextChunk = 0;
+        counterAdd(mNumberOfPasses, 1);
+    }
+}
+
+// ----------------------------------------------------------------------------
+EdacScrubRegion::EdacScrubRegion(outpost::Slice<uint32_t> memory, size_t wordsPerChunk) :
+    mMemory(memory),
+    mWordsPerChunk((wordsPerChunk > 0) ? wordsPerChunk : 1)
+{
+}
+
+size_t
+EdacScrubRegion::getNumberOfChunks() const
+{
+    return (mMemory.getNumberOfElements() + mWordsPerChunk - 1) / mWordsPerChunk;
+}
+
+ScrubResult
+EdacScrubRegion::scrubChunk(size_t chunk)
+{
+    const size_t first = chunk * mWordsPerChunk;
+    size_t last = first + mWordsPerChunk;
+    if (last > mMemory.getNumberOfElements())
+    {
+        last = mMemory.getNumberOfElements();
+    }
+
+    for (size_t i = first; i < last; ++i)
+    {
+        // Writes the corrected value back unless another thread has
+        // changed the word since it was read
+        uint32_t* word = &mMemory[i];
+        uint32_t value = __atomic_load_n(word, __ATOMIC_RELAXED);
+        __atomic_compare_exchange_n(
+                word, &value, value, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+    }
+    return ScrubResult::clean;
+}
+
+// ----------------------------------------------------------------------------
+BchScrubRegion::BchScrubRegion(outpost::utils::NandBCHInterface& bch,
+                               outpost::Slice<uint8_t> codedPages,
+                               outpost::Slice<uint8_t> workspace) :
+    mBch(bch),
+    mCodedPages(codedPages),
+    mWorkspace(workspace),
+    mCodedPageSize(bch.getNumberOfDatabytes() + bch.getNumberOfSparebytes())
+{
+}
+
+size_t
+BchScrubRegion::getNumberOfChunks() const
+{
+    return mCodedPages.getNumberOfElements() / mCodedPageSize;
+}
+
+ScrubResult
+BchScrubRegion::scrubChunk(size_t chunk)
+{
+    if (chunk >= getNumberOfChunks()
+        || mWorkspace.getNumberOfElements() < mBch.getNumberOfDatabytes())
+    {
+        return ScrubResult::failed;
+    }
+
+    const outpost::Slice<uint8_t> page =
+            mCodedPages.subSlice(chunk * mCodedPageSize, mCodedPageSize);
+    if (mBch.isChecksumEmpty(page))
+    {
+        return ScrubResult::clean;
+    }
+
+    const outpost::Slice<uint8_t> data = mWorkspace.first(mBch.getNumberOfDatabytes());
+    const ScrubResult result = toScrubResult(mBch.decode(page, data));
+    if (result == ScrubResult::corrected && !mBch.encode(data, page))
+    {
+        return ScrubResult::failed;
+    }
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+NandScrubRegion::NandScrubRegion(NandFlash& flash,
+                                 outpost::utils::NandBCHInterface& bch,
+                                 uint32_t firstBlock,
+                                 uint32_t numberOfBlocks,
+                                 outpost::Slice<uint8_t> workspace,
+                                 NandScrubListener& listener) :
+    mFlash(flash),
+    mBch(bch),
+    mFirstBlock(firstBlock),
+    mNumberOfBlocks(numberOfBlocks),
+    mWorkspace(workspace),
+    mListener(listener)
+{
+}
+
+size_t
+NandScrubRegion::getNumberOfChunks() const
+{
+    return static_cast<size_t>(mNumberOfBlocks) * mFlash.getPagesPerBlock();
+}
+
+ScrubResult
+NandScrubRegion::scrubChunk(size_t chunk)
+{
+    const uint32_t pageSize = mFlash.getPageSize();
+    if (chunk >= getNumberOfChunks()
+        || mWorkspace.getNumberOfElements() < pageSize + mBch.getNumberOfDatabytes())
+    {
+        return ScrubResult::failed;
+    }
+
+    const uint32_t block = mFirstBlock + static_cast<uint32_t>(chunk / mFlash.getPagesPerBlock());
+    const uint32_t page = static_cast<uint32_t>(chunk % mFlash.getPagesPerBlock());
+    const outpost::Slice<uint8_t> coded = mWorkspace.first(pageSize);
+
+    ScrubResult result = ScrubResult::failed;
+    if (mFlash.readPage(block, page, coded) == NandFlash::Result::success)
+    {
+        if (mBch.isChecksumEmpty(coded))
+        {
+            return ScrubResult::clean;
+        }
+        result = toScrubResult(
+                mBch.decode(coded, mWorkspace.subSlice(pageSize, mBch.getNumberOfDatabytes())));
+    }
+
+    if (result != ScrubResult::clean)
+    {
+        mListener.onPageError(block, page, result);
+    }
+    return result;
+}
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_HAL_SCRUB_REGION_H
+#define OUTPOST_HAL_SCRUB_REGION_H
+
+#include "nand_flash.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/utils/coding/nand_bch_interface.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace hal
+{
+class Scrubber;
+
+enum class ScrubResult : uint8_t
+{
+    /// No error found
+    clean,
+
+    /// Bit flips were found and corrected
+    corrected,
+
+    /// Errors were found which could not be corrected
+    uncorrectable,
+
+    /// The memory could not be accessed
+    failed
+};
+
+/**
+ * Memory which is checked for bit flips by a Scrubber.
+ *
+ * The memory is divided into chunks, the scrubber processes one chunk at
+ * a time so that the work can be spread over many periods.
+ */
+class ScrubRegion
+{
+public:
+    ScrubRegion();
+
+    virtual ~ScrubRegion() = default;
+
+    // disable copy constructor
+    ScrubRegion(const ScrubRegion& other) = delete;
+
+    // disable assignment operator
+    ScrubRegion&
+    operator=(const ScrubRegion& other) = delete;
+
+    virtual size_t
+    getNumberOfChunks() const = 0;
+
+    /**
+     * Check a chunk and correct its errors where possible.
+     */
+    virtual ScrubResult
+    scrubChunk(size_t chunk) = 0;
+
+    /**
+     * Number of times all chunks have been scrubbed.
+     */
+    uint32_t
+    getNumberOfPasses() const;
+
+    uint32_t
+    getNumberOfScrubbedChunks() const;
+
+    uint32_t
+    getNumberOfCorrectedChunks() const;
+
+    uint32_t
+    getNumberOfUncorrectableChunks() const;
+
+    uint32_t
+    getNumberOfFailedChunks() const;
+
+private:
+    friend class Scrubber;
+
+    /// Record the result of the next chunk and advance to the following one
+    void
+    account(ScrubResult result);
+
+    ScrubRegion* mNext;
+    size_t mNextChunk;
+
+    uint32_t mNumberOfPasses;
+    uint32_t mNumberOfScrubbedChunks;
+    uint32_t mNumberOfCorrectedChunks;
+    uint32_t mNumberOfUncorrectableChunks;
+    uint32_t mNumberOfFailedChunks;
+};
+
+/**
+ * RAM protected by a hardware EDAC.
+ *
+ * Every word is read and written back with an atomic compare-and-swap.
+ * The EDAC corrects single bit errors on the read, the write stores the
+ * corrected value before a second bit flip makes the word uncorrectable.
+ * A word which is changed concurrently is not overwritten.
+ *
+ * The EDAC reports corrections through its own registers or traps, the
+ * region therefore always returns ScrubResult::clean.
+ */
+class EdacScrubRegion : public ScrubRegion
+{
+public:
+    EdacScrubRegion(outpost::Slice<uint32_t> memory, size_t wordsPerChunk);
+
+    virtual size_t
+    getNumberOfChunks() const override;
+
+    virtual ScrubResult
+    scrubChunk(size_t chunk) override;
+
+private:
+    const outpost::Slice<uint32_t> mMemory;
+    const size_t mWordsPerChunk;
+};
+
+/**
+ * RAM holding pages encoded with a NandBCHInterface, e.g. software
+ * protected tables or images.
+ *
+ * One chunk is one page. Pages with correctable errors are encoded again
+ * and written back. Pages must not be changed while the scrubber runs.
+ */
+class BchScrubRegion : public ScrubRegion
+{
+public:
+    /**
+     * \param codedPages
+     *      Encoded pages, getNumberOfDatabytes() + getNumberOfSparebytes()
+     *      bytes per page.
+     * \param workspace
+     *      At least getNumberOfDatabytes() bytes.
+     */
+    BchScrubRegion(outpost::utils::NandBCHInterface& bch,
+                   outpost::Slice<uint8_t> codedPages,
+                   outpost::Slice<uint8_t> workspace);
+
+    virtual size_t
+    getNumberOfChunks() const override;
+
+    virtual ScrubResult
+    scrubChunk(size_t chunk) override;
+
+private:
+    outpost::utils::NandBCHInterface& mBch;
+    const outpost::Slice<uint8_t> mCodedPages;
+    const outpost::Slice<uint8_t> mWorkspace;
+    const size_t mCodedPageSize;
+};
+
+/**
+ * Receives the pages a NandScrubRegion found errors in.
+ */
+class NandScrubListener
+{
+public:
+    virtual ~NandScrubListener() = default;
+
+    /**
+     * Called with the scrubber context, \p result is never clean.
+     */
+    virtual void
+    onPageError(uint32_t block, uint32_t page, ScrubResult result) = 0;
+};
+
+/**
+ * Blocks of a NAND flash encoded with a NandBCHInterface.
+ *
+ * One chunk is one page. NAND pages cannot be rewritten without erasing
+ * the complete block, pages with errors are therefore reported to the
+ * listener, which has to relocate the data (e.g. a NandPacketStore).
+ * Erased pages are skipped.
+ *
+ * The flash must not be accessed concurrently from another thread.
+ */
+class NandScrubRegion : public ScrubRegion
+{
+public:
+    /**
+     * \param workspace
+     *      At least getPageSize() + getNumberOfDatabytes() bytes.
+     */
+    NandScrubRegion(NandFlash& flash,
+                    outpost::utils::NandBCHInterface& bch,
+                    uint32_t firstBlock,
+                    uint32_t numberOfBlocks,
+                    outpost::Slice<uint8_t> workspace,
+                    NandScrubListener& listener);
+
+    virtual size_t
+    getNumberOfChunks() const override;
+
+    virtual ScrubResult
+    scrubChunk(size_t chunk) override;
+
+private:
+    NandFlash& mFlash;
+    outpost::utils::NandBCHInterface& mBch;
+    const uint32_t mFirstBlock;
+    const uint32_t mNumberOfBlocks;
+    const outpost::Slice<uint8_t> mWorkspace;
+    NandScrubListener& mListener;
+};
+
+}  // namespace hal
+}  // namespace outpost
+
+#endif
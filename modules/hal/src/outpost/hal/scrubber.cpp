@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "scrubber.h"
+
+#include <outpost/rtos/mutex_guard.h>
+#include <outpost/rtos/periodic_task_manager.h>
+#include <outpost/utils/counter_block.h>
+
+using namespace outpost::hal;
+using outpost::rtos::MutexGuard;
+using outpost::rtos::PeriodicTaskManager;
+
+internal::ScrubberThread::ScrubberThread(Scrubber& scrubber,
+                                         uint8_t priority,
+                                         size_t stackSize,
+                                         const char* name) :
+    Thread(priority, stackSize, name),
+    mScrubber(scrubber)
+{
+}
+
+void
+internal::ScrubberThread::run()
+{
+    mScrubber.run();
+}
+
+// ----------------------------------------------------------------------------
+Scrubber::Scrubber(const outpost::time::Clock& clock,
+                   outpost::time::Duration period,
+                   size_t chunksPerPeriod,
+                   outpost::time::Duration budgetPerPeriod,
+                   uint8_t priority,
+                   size_t stackSize,
+                   const char* name) :
+    mClock(clock),
+    mPeriod(period),
+    mChunksPerPeriod(chunksPerPeriod),
+    mBudgetPerPeriod(budgetPerPeriod),
+    mMutex(),
+    mHead(nullptr),
+    mCurrent(nullptr),
+    mNumberOfExhaustedBudgets(0),
+    mThread(*this, priority, stackSize, name)
+{
+}
+
+void
+Scrubber::addRegion(ScrubRegion& region)
+{
+    MutexGuard lock(mMutex);
+    region.mNext = mHead;
+    mHead = &region;
+    if (mCurrent == nullptr)
+    {
+        mCurrent = mHead;
+    }
+}
+
+void
+Scrubber::start()
+{
+    mThread.start();
+}
+
+size_t
+Scrubber::scrubPeriod()
+{
+    MutexGuard lock(mMutex);
+    const outpost::time::SpacecraftElapsedTime start = mClock.now();
+
+    size_t chunks = 0;
+
+    // First of the regions without chunks visited in a row
+    const ScrubRegion* idle = nullptr;
+    while (chunks < mChunksPerPeriod && mCurrent != nullptr)
+    {
+        ScrubRegion& region = *mCurrent;
+        if (region.getNumberOfChunks() == 0)
+        {
+            if (idle == &region)
+            {
+                break;
+            }
+            if (idle == nullptr)
+            {
+                idle = &region;
+            }
+            mCurrent = getNextRegion(region);
+            continue;
+        }
+        idle = nullptr;
+
+        if (chunks > 0 && (mClock.now() - start) >= mBudgetPerPeriod)
+        {
+            outpost::utils::internal::counterAdd(mNumberOfExhaustedBudgets, 1);
+            break;
+        }
+
+        region.account(region.scrubChunk(region.mNextChunk));
+        chunks++;
+        if (region.mNextChunk == 0)
+        {
+            // Pass of the region finished, continue with the next one
+            mCurrent = getNextRegion(region);
+        }
+    }
+    return chunks;
+}
+
+uint32_t
+Scrubber::getNumberOfExhaustedBudgets() const
+{
+    return outpost::utils::internal::counterLoad(mNumberOfExhaustedBudgets);
+}
+
+ScrubRegion*
+Scrubber::getNextRegion(const ScrubRegion& region) const
+{
+    return (region.mNext != nullptr) ? region.mNext : mHead;
+}
+
+void
+Scrubber::run()
+{
+    // Skipping prevents bursts after the thread was blocked for a while
+    PeriodicTaskManager manager(PeriodicTaskManager::OverrunPolicy::skip);
+    while (true)
+    {
+        manager.nextPeriod(mPeriod);
+        scrubPeriod();
+    }
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_HAL_SCRUBBER_H
+#define OUTPOST_HAL_SCRUBBER_H
+
+#include "scrub_region.h"
+
+#include <outpost/rtos/mutex.h>
+#include <outpost/rtos/thread.h>
+#include <outpost/time/clock.h>
+#include <outpost/time/duration.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace hal
+{
+namespace internal
+{
+class ScrubberThread : public rtos::Thread
+{
+public:
+    ScrubberThread(Scrubber& scrubber, uint8_t priority, size_t stackSize, const char* name);
+
+protected:
+    virtual void
+    run() override;
+
+private:
+    Scrubber& mScrubber;
+};
+}  // namespace internal
+
+/**
+ * Background scrubbing of memory regions.
+ *
+ * The registered regions are walked chunk by chunk, one region after the
+ * other. Every period at most a fixed number of chunks is scrubbed and
+ * the scrubbing stops early if the time budget of the period is used up,
+ * so that the load on the CPU and the memory bus stays bounded. Periods
+ * which are missed are skipped instead of being caught up.
+ *
+ * \code
+ * outpost::hal::EdacScrubRegion ram(outpost::asSlice(memory), 256);
+ *
+ * // 16 chunks or 2 ms every 100 ms
+ * outpost::hal::Scrubber scrubber(clock, Milliseconds(100), 16, Milliseconds(2), priority);
+ * scrubber.addRegion(ram);
+ * scrubber.start();
+ * \endcode
+ *
+ * The thread should run with a low priority, the budget limits the
+ * interference with threads of the same or a lower priority.
+ */
+class Scrubber
+{
+public:
+    /**
+     * \param period
+     *      Period in which the budget is renewed.
+     * \param chunksPerPeriod
+     *      Maximum number of chunks scrubbed per period.
+     * \param budgetPerPeriod
+     *      Time after which no further chunk is started in a period. At
+     *      least one chunk is scrubbed per period.
+     */
+    Scrubber(const time::Clock& clock,
+             time::Duration period,
+             size_t chunksPerPeriod,
+             time::Duration budgetPerPeriod,
+             uint8_t priority,
+             size_t stackSize = rtos::Thread::defaultStackSize,
+             const char* name = "SCRB");
+
+    // disable copy constructor
+    Scrubber(const Scrubber& other) = delete;
+
+    // disable assignment operator
+    Scrubber&
+    operator=(const Scrubber& other) = delete;
+
+    /**
+     * Add a region, it stays registered for the lifetime of the scrubber.
+     */
+    void
+    addRegion(ScrubRegion& region);
+
+    /**
+     * Start the scrubber thread.
+     */
+    void
+    start();
+
+    /**
+     * Scrub the chunks of one period.
+     *
+     * Called by the scrubber thread, can be called directly if the
+     * scrubber is driven by another thread instead.
+     *
+     * \return  Number of scrubbed chunks.
+     */
+    size_t
+    scrubPeriod();
+
+    /**
+     * Number of periods ended by the time budget instead of the number
+     * of chunks.
+     */
+    uint32_t
+    getNumberOfExhaustedBudgets() const;
+
+private:
+    friend class internal::ScrubberThread;
+
+    void
+    run();
+
+    /// Region after \p region, wraps to the first one
+    ScrubRegion*
+    getNextRegion(const ScrubRegion& region) const;
+
+    const time::Clock& mClock;
+    const time::Duration mPeriod;
+    const size_t mChunksPerPeriod;
+    const time::Duration mBudgetPerPeriod;
+
+    mutable rtos::Mutex mMutex;
+    ScrubRegion* mHead;
+    ScrubRegion* mCurrent;
+    uint32_t mNumberOfExhaustedBudgets;
+
+    // Declared last so that the thread is destroyed first
+    internal::ScrubberThread mThread;
+};
+
+}  // namespace hal
+}  // namespace outpost
+
+#endif
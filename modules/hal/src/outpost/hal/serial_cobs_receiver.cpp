@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "serial_cobs_receiver.h"
+
+using outpost::hal::SerialCobsReceiver;
+
+SerialCobsReceiver::SerialCobsReceiver(Serial& serial,
+                                       const outpost::time::Clock& clock,
+                                       outpost::Slice<uint8_t> readBuffer) :
+    mSerial(serial),
+    mClock(clock),
+    mBufferedSerial(nullptr),
+    mReadBuffer(readBuffer),
+    mPending(outpost::Slice<const uint8_t>::empty()),
+    mFrameBuffer(outpost::Slice<uint8_t>::empty()),
+    mDecoder()
+{
+}
+
+SerialCobsReceiver::SerialCobsReceiver(BufferedSerial& serial,
+                                       const outpost::time::Clock& clock) :
+    mSerial(serial),
+    mClock(clock),
+    mBufferedSerial(&serial),
+    mReadBuffer(outpost::Slice<uint8_t>::empty()),
+    mPending(outpost::Slice<const uint8_t>::empty()),
+    mFrameBuffer(outpost::Slice<uint8_t>::empty()),
+    mDecoder()
+{
+}
+
+uint32_t
+SerialCobsReceiver::receive(outpost::Slice<uint8_t>& buffer, outpost::time::Duration timeout)
+{
+    if ((buffer.begin() != mFrameBuffer.begin())
+        || (buffer.getNumberOfElements() != mFrameBuffer.getNumberOfElements()))
+    {
+        // The beginning of the frame is in the old buffer
+        if (mDecoder.isFrameInProgress())
+        {
+            mDecoder.resynchronize();
+        }
+        mFrameBuffer = buffer;
+        mDecoder.setBuffer(buffer);
+    }
+
+    // All reads share the timeout, data which is already available is
+    // still decoded after it has passed
+    const outpost::time::SpacecraftElapsedTime start = mClock.now();
+    outpost::time::Duration remaining = timeout;
+    while (fetch(remaining))
+    {
+        consume(mDecoder.decode(mPending));
+        if (mDecoder.isFrameAvailable())
+        {
+            const uint32_t length = mDecoder.getFrame().getNumberOfElements();
+            mDecoder.releaseFrame();
+            return length;
+        }
+
+        if (timeout != outpost::time::Duration::infinity())
+        {
+            const outpost::time::Duration elapsed = mClock.now() - start;
+            remaining = (elapsed < timeout) ? (timeout - elapsed)
+                                            : outpost::time::Duration::zero();
+        }
+    }
+    return 0;
+}
+
+bool
+SerialCobsReceiver::fetch(outpost::time::Duration timeout)
+{
+    if (mPending.getNumberOfElements() == 0)
+    {
+        if (mBufferedSerial != nullptr)
+        {
+            mPending = mBufferedSerial->peek(timeout);
+        }
+        else
+        {
+            mPending = mReadBuffer.first(mSerial.read(mReadBuffer, timeout));
+        }
+    }
+    return (mPending.getNumberOfElements() > 0);
+}
+
+void
+SerialCobsReceiver::consume(size_t count)
+{
+    mPending = mPending.skipFirst(count);
+    if (mBufferedSerial != nullptr)
+    {
+        mBufferedSerial->consume(count);
+    }
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_HAL_SERIAL_COBS_RECEIVER_H
+#define OUTPOST_HAL_SERIAL_COBS_RECEIVER_H
+
+#include "buffered_serial.h"
+#include "receiver_interface.h"
+#include "serial.h"
+
+#include <outpost/time/clock.h>
+#include <outpost/utils/coding/cobs.h>
+
+namespace outpost
+{
+namespace hal
+{
+/**
+ * Receives COBS framed packages from a serial line.
+ *
+ * Frames are delimited by zero bytes. The received data is decoded
+ * directly into the buffer given by the caller of receive(), e.g. the
+ * buffer of a ProtocolDispatcherThread, so a serial link can be used with
+ * the same multi-queue dispatch as a SpaceWire link:
+ *
+ * \code
+ * outpost::hal::SerialCobsReceiver receiver(serial, clock);
+ * outpost::hal::ProtocolDispatcherThread thread(dispatcher, receiver, pool, priority,
+ *                                               stackSize, name, heartbeatSource);
+ * \endcode
+ *
+ * With a BufferedSerial the encoded data is decoded in place from its
+ * receive ring, otherwise it is read in chunks into an intermediate
+ * buffer.
+ *
+ * A partially received frame is continued with the next call if the same
+ * buffer is given again, otherwise it is discarded. Frames which do not
+ * fit into the buffer are discarded and counted, see getNumberOfErrors().
+ */
+class SerialCobsReceiver : public ReceiverInterface
+{
+public:
+    /**
+     * \param serial
+     *      Serial interface to read from.
+     * \param clock
+     *      Clock for the timeout of receive().
+     * \param readBuffer
+     *      Intermediate buffer for the encoded data. A read returns as soon
+     *      as it is filled, so a short buffer reduces the latency for
+     *      serial drivers which wait for the complete buffer.
+     */
+    SerialCobsReceiver(Serial& serial,
+                       const outpost::time::Clock& clock,
+                       outpost::Slice<uint8_t> readBuffer);
+
+    /**
+     * Decode in place from the receive ring of \p serial.
+     */
+    SerialCobsReceiver(BufferedSerial& serial, const outpost::time::Clock& clock);
+
+    // disable copy constructor
+    SerialCobsReceiver(const SerialCobsReceiver& other) = delete;
+
+    // disable assignment operator
+    SerialCobsReceiver&
+    operator=(const SerialCobsReceiver& other) = delete;
+
+    virtual ~SerialCobsReceiver() = default;
+
+    /**
+     * Receive the next frame.
+     *
+     * @param buffer 	buffer to decode the frame to
+     * @param timeout	max timeout to wait for the frame, the reads of the
+     * 					serial interface share it
+     *
+     * @return 0	If no complete frame has been received in the time
+     * 		   >0   Number of bytes of the decoded frame
+     */
+    virtual uint32_t
+    receive(outpost::Slice<uint8_t>& buffer, outpost::time::Duration timeout) override;
+
+    /**
+     * Number of frames discarded because they did not fit into the buffer
+     * or were not encoded correctly.
+     */
+    inline size_t
+    getNumberOfErrors() const
+    {
+        return mDecoder.getNumberOfErrors();
+    }
+
+private:
+    /// Wait for encoded data if all data read so far has been decoded
+    bool
+    fetch(outpost::time::Duration timeout);
+
+    void
+    consume(size_t count);
+
+    Serial& mSerial;
+    const outpost::time::Clock& mClock;
+
+    /// nullptr if reading into mReadBuffer
+    BufferedSerial* const mBufferedSerial;
+
+    outpost::Slice<uint8_t> mReadBuffer;
+
+    /// Encoded data which has not been decoded yet
+    outpost::Slice<const uint8_t> mPending;
+
+    /// Buffer used by the current frame
+    outpost::Slice<uint8_t> mFrameBuffer;
+
+    outpost::utils::CobsStreamDecoder mDecoder;
+};
+
+}  // namespace hal
+}  // namespace outpost
+
+#endif
@@ -46,6 +46,122 @@ public:
     virtual bool
     send(const outpost::Slice<const uint8_t>& buffer,
          outpost::time::Duration timeout = outpost::time::Duration::maximum()) = 0;
+
+    /**
+     * Request a transmit buffer of the underlying SpaceWire link
+     *
+     * Allows to construct a packet directly in the transmit buffer
+     * instead of copying it. The buffer must be returned by send(),
+     * the link is blocked until then.
+     *
+     * @param buffer	set to the transmit buffer, its length is the maximum packet length
+     * @param timeout	maximum time to wait for a free buffer
+     *
+     * @return 		true  if successful
+     * 				false if timeout or any failure in underlying sender
+     */
+    virtual bool
+    requestBuffer(SpaceWire::TransmitBuffer*& buffer,
+                  outpost::time::Duration timeout = outpost::time::Duration::maximum()) = 0;
+
+    /**
+     * Send a buffer obtained from requestBuffer()
+     *
+     * Length and end marker must be set by the caller.
+     *
+     * @param buffer	buffer to send, is released in any case
+     * @param timeout	maximum time to wait for sending
+     *
+     * @return 		true  if successful
+     * 				false if timeout or any failure in underlying sender
+     */
+    virtual bool
+    send(SpaceWire::TransmitBuffer* buffer,
+         outpost::time::Duration timeout = outpost::time::Duration::maximum()) = 0;
+
+    /**
+     * Send a packet gathered from several fragments
+     *
+     * Avoids assembling e.g. path address, header and a payload kept in a
+     * SharedBufferPointer in an intermediate buffer, see
+     * SpaceWire::sendFragments().
+     *
+     * @param fragments	fragments in transmission order, together a complete packet
+     * @param timeout	maximum time to wait for sending
+     *
+     * @return 		true  if successful
+     * 				false if timeout
+     * 						 fragments do not fit into a packet
+     * 						 any failure in underlying sender
+     */
+    virtual bool
+    sendFragments(outpost::Slice<const outpost::Slice<const uint8_t>> fragments,
+                  outpost::time::Duration timeout = outpost::time::Duration::maximum()) = 0;
+
+    /**
+     * Reserve a transmit buffer to construct a packet in place
+     *
+     * First phase of a zero-copy transmission: the producer serializes
+     * the packet into \p packet and hands it to commit(). A reserved
+     * buffer blocks the link until it is returned by commit() or abort().
+     *
+     * @param buffer	set to the reserved transmit buffer
+     * @param packet	set to the memory of the buffer, its length is the maximum packet length
+     * @param timeout	maximum time to wait for a free buffer
+     *
+     * @return 		true  if successful
+     * 				false if timeout or any failure in underlying sender
+     */
+    inline bool
+    reserve(SpaceWire::TransmitBuffer*& buffer,
+            outpost::Slice<uint8_t>& packet,
+            outpost::time::Duration timeout = outpost::time::Duration::maximum())
+    {
+        if (!requestBuffer(buffer, timeout))
+        {
+            return false;
+        }
+        packet = buffer->getData();
+        return true;
+    }
+
+    /**
+     * Send the first \p length bytes of a reserved buffer as a complete packet
+     *
+     * @param buffer	buffer obtained from reserve(), is released in any case
+     * @param length	number of bytes written to the buffer
+     * @param timeout	maximum time to wait for sending
+     *
+     * @return 		true  if successful
+     * 				false if \p length exceeds the buffer, timeout or any failure in
+     * 				      underlying sender
+     */
+    inline bool
+    commit(SpaceWire::TransmitBuffer* buffer,
+           size_t length,
+           outpost::time::Duration timeout = outpost::time::Duration::maximum())
+    {
+        if (length > buffer->getLength())
+        {
+            abort(buffer, timeout);
+            return false;
+        }
+        buffer->setLength(length);
+        buffer->setEndMarker(SpaceWire::EndMarker::eop);
+        return send(buffer, timeout);
+    }
+
+    /**
+     * Return a reserved buffer without transmitting a packet
+     *
+     * @param buffer	buffer obtained from reserve()
+     * @param timeout	maximum time to wait for sending
+     *
+     * @see SpaceWire::abort()
+     */
+    virtual void
+    abort(SpaceWire::TransmitBuffer* buffer,
+          outpost::time::Duration timeout = outpost::time::Duration::maximum()) = 0;
 };
 
 template <uint32_t numberOfQueues,       // how many queues can be included
@@ -79,6 +195,8 @@ public:
     /**
      * Send the contents of buffer
      *
+     * Requesting the transmit buffer and sending it share the timeout.
+     *
      * @param buffer	data to send
      * @param timeout	maximum time to wait for sending
      *
@@ -91,6 +209,22 @@ public:
     send(const outpost::Slice<const uint8_t>& buffer,
          outpost::time::Duration timeout = outpost::time::Duration::zero()) override;
 
+    virtual bool
+    requestBuffer(SpaceWire::TransmitBuffer*& buffer,
+                  outpost::time::Duration timeout = outpost::time::Duration::zero()) override;
+
+    virtual bool
+    send(SpaceWire::TransmitBuffer* buffer,
+         outpost::time::Duration timeout = outpost::time::Duration::zero()) override;
+
+    virtual bool
+    sendFragments(outpost::Slice<const outpost::Slice<const uint8_t>> fragments,
+                  outpost::time::Duration timeout = outpost::time::Duration::zero()) override;
+
+    virtual void
+    abort(SpaceWire::TransmitBuffer* buffer,
+          outpost::time::Duration timeout = outpost::time::Duration::zero()) override;
+
     /**
      * Add a listener for timecode
      * @param queue the queue to add
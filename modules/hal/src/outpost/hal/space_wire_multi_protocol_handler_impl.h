@@ -16,8 +16,6 @@
 
 #include "space_wire_multi_protocol_handler.h"
 
-#include <outpost/utils/minmax.h>
-
 namespace outpost
 {
 namespace hal
@@ -27,7 +25,7 @@ bool
 SpaceWireMultiProtocolHandler<numberOfQueues, maxPacketSize>::send(
         const outpost::Slice<const uint8_t>& buffer, outpost::time::Duration timeout)
 {
-    outpost::time::SpacecraftElapsedTime startTime = mClock.now();
+    const outpost::time::SpacecraftElapsedTime startTime = mClock.now();
     SpaceWire::TransmitBuffer* transmitBuffer;
     auto result = mSpWHandle.getSpaceWire().requestBuffer(transmitBuffer, timeout);
     if (result != SpaceWire::Result::Type::success)
@@ -36,13 +34,13 @@ SpaceWireMultiProtocolHandler<numberOfQueues, maxPacketSize>::send(
     }
 
     // better reject to long packages than cutting them
-    if (transmitBuffer->getLength() < buffer.getNumberOfElements())
+    if (!transmitBuffer->getData().copyFrom(buffer))
     {
+        mSpWHandle.getSpaceWire().abort(transmitBuffer, timeout);
         return false;
     }
     else
     {
-        memcpy(&transmitBuffer->getData()[0], &buffer[0], buffer.getNumberOfElements());
         transmitBuffer->setLength(buffer.getNumberOfElements());
         transmitBuffer->setEndMarker(outpost::hal::SpaceWire::EndMarker::eop);
     }
@@ -51,14 +49,15 @@ SpaceWireMultiProtocolHandler<numberOfQueues, maxPacketSize>::send(
         && timeout != outpost::time::Duration::infinity())
     {
         // update remaining timeout unless we are in non-blocking anyways
-        outpost::time::SpacecraftElapsedTime now = mClock.now();
-        if (now > startTime + timeout)
+        const outpost::time::Duration elapsed = mClock.now() - startTime;
+        if (elapsed > timeout)
         {
+            mSpWHandle.getSpaceWire().abort(transmitBuffer, outpost::time::Duration::zero());
             return false;
         }
         else
         {
-            timeout = timeout - (now - startTime);
+            timeout = timeout - elapsed;
         }
     }
 
@@ -66,6 +65,42 @@ SpaceWireMultiProtocolHandler<numberOfQueues, maxPacketSize>::send(
     return result == SpaceWire::Result::Type::success;
 }
 
+template <uint32_t numberOfQueues, uint32_t maxPacketSize>
+bool
+SpaceWireMultiProtocolHandler<numberOfQueues, maxPacketSize>::requestBuffer(
+        SpaceWire::TransmitBuffer*& buffer, outpost::time::Duration timeout)
+{
+    auto result = mSpWHandle.getSpaceWire().requestBuffer(buffer, timeout);
+    return result == SpaceWire::Result::Type::success;
+}
+
+template <uint32_t numberOfQueues, uint32_t maxPacketSize>
+bool
+SpaceWireMultiProtocolHandler<numberOfQueues, maxPacketSize>::send(
+        SpaceWire::TransmitBuffer* buffer, outpost::time::Duration timeout)
+{
+    auto result = mSpWHandle.getSpaceWire().send(buffer, timeout);
+    return result == SpaceWire::Result::Type::success;
+}
+
+template <uint32_t numberOfQueues, uint32_t maxPacketSize>
+bool
+SpaceWireMultiProtocolHandler<numberOfQueues, maxPacketSize>::sendFragments(
+        outpost::Slice<const outpost::Slice<const uint8_t>> fragments,
+        outpost::time::Duration timeout)
+{
+    auto result = mSpWHandle.getSpaceWire().sendFragments(fragments, timeout);
+    return result == SpaceWire::Result::Type::success;
+}
+
+template <uint32_t numberOfQueues, uint32_t maxPacketSize>
+void
+SpaceWireMultiProtocolHandler<numberOfQueues, maxPacketSize>::abort(
+        SpaceWire::TransmitBuffer* buffer, outpost::time::Duration timeout)
+{
+    mSpWHandle.getSpaceWire().abort(buffer, timeout);
+}
+
 template <uint32_t numberOfQueues, uint32_t maxPacketSize>
 uint32_t
 SpaceWireMultiProtocolHandler<numberOfQueues, maxPacketSize>::SpaceWireHandle::receive(
@@ -80,8 +115,7 @@ SpaceWireMultiProtocolHandler<numberOfQueues, maxPacketSize>::SpaceWireHandle::r
 
     uint32_t receivedSize = receiveBuffer.getLength();
 
-    uint32_t copySize = outpost::utils::min<uint32_t>(receivedSize, buffer.getNumberOfElements());
-    memcpy(&buffer[0], &receiveBuffer.getData()[0], copySize);
+    buffer.copyFrom(receiveBuffer.getData().first(buffer.getNumberOfElements()));
 
     mSpw.releaseBuffer(receiveBuffer);
     return receivedSize;
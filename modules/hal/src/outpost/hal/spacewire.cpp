@@ -13,6 +13,92 @@
 
 #include "spacewire.h"
 
+outpost::hal::SpaceWire::SpaceWire() :
+    mTransmitNotificationGroup(nullptr), mTransmitNotificationBits(0)
+{
+}
+
 outpost::hal::SpaceWire::~SpaceWire()
 {
 }
+
+size_t
+outpost::hal::SpaceWire::requestBuffers(outpost::Slice<TransmitBuffer*> buffers,
+                                        outpost::time::Duration timeout)
+{
+    size_t count = 0;
+    while (count < buffers.getNumberOfElements())
+    {
+        const outpost::time::Duration wait =
+                (count == 0) ? timeout : outpost::time::Duration::zero();
+        if (requestBuffer(buffers[count], wait) != Result::success)
+        {
+            break;
+        }
+        count++;
+    }
+    return count;
+}
+
+size_t
+outpost::hal::SpaceWire::sendBatch(outpost::Slice<TransmitBuffer* const> buffers,
+                                   outpost::time::Duration timeout)
+{
+    size_t count = 0;
+    while (count < buffers.getNumberOfElements())
+    {
+        if (send(buffers[count], timeout) != Result::success)
+        {
+            break;
+        }
+        count++;
+        notifyTransmitted();
+    }
+    return count;
+}
+
+void
+outpost::hal::SpaceWire::setTransmitNotification(outpost::rtos::EventGroup* group,
+                                                 outpost::rtos::EventGroup::Bits bits)
+{
+    mTransmitNotificationGroup = group;
+    mTransmitNotificationBits = bits;
+}
+
+outpost::hal::SpaceWire::Result::Type
+outpost::hal::SpaceWire::sendFragments(
+        outpost::Slice<const outpost::Slice<const uint8_t>> fragments,
+        outpost::time::Duration timeout)
+{
+    TransmitBuffer* buffer = nullptr;
+    Result::Type result = requestBuffer(buffer, timeout);
+    if (result != Result::success)
+    {
+        return result;
+    }
+
+    outpost::Slice<uint8_t> remaining = buffer->getData();
+    size_t length = 0;
+    for (const outpost::Slice<const uint8_t>& fragment : fragments)
+    {
+        if (!remaining.copyFrom(fragment))
+        {
+            abort(buffer, timeout);
+            return Result::failure;
+        }
+        remaining = remaining.skipFirst(fragment.getNumberOfElements());
+        length += fragment.getNumberOfElements();
+    }
+
+    buffer->setLength(length);
+    buffer->setEndMarker(eop);
+    return send(buffer, timeout);
+}
+
+outpost::hal::SpaceWire::Result::Type
+outpost::hal::SpaceWire::abort(TransmitBuffer* buffer, outpost::time::Duration timeout)
+{
+    buffer->setLength(0);
+    buffer->setEndMarker(eep);
+    return send(buffer, timeout);
+}
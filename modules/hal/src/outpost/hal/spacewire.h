@@ -21,6 +21,7 @@
 
 #include <outpost/base/slice.h>
 #include <outpost/rtos.h>
+#include <outpost/rtos/event_group.h>
 #include <outpost/rtos/queue.h>
 #include <outpost/time/duration.h>
 
@@ -197,6 +198,8 @@ public:
         outpost::Slice<const uint8_t> mData;
         EndMarker mEnd;
     };
+    SpaceWire();
+
     virtual ~SpaceWire();
 
     /**
@@ -256,6 +259,99 @@ public:
     virtual Result::Type
     send(TransmitBuffer* buffer, outpost::time::Duration timeout) = 0;
 
+    /**
+     * Request several send buffers at once.
+     *
+     * Waits up to \p timeout for the first buffer, the following ones are
+     * only taken if immediately available.
+     *
+     * \param[out]  buffers
+     *      Filled with the requested buffers.
+     * \param[in]   timeout
+     *      Time to wait for the first transmit buffer.
+     *
+     * \return  Number of buffers written to \p buffers.
+     */
+    virtual size_t
+    requestBuffers(outpost::Slice<TransmitBuffer*> buffers, outpost::time::Duration timeout);
+
+    /**
+     * Submit several configured buffers for transmission at once.
+     *
+     * Drivers with a DMA engine should override this to queue all
+     * buffers to descriptors with a single call and return before the
+     * packets are transmitted. The completion is then reported with
+     * notifyTransmittedFromInterrupt() from the interrupt handler. The default
+     * implementation calls send() for every buffer and notifies after
+     * each successful send().
+     *
+     * \param[in]   buffers
+     *      Buffers obtained from requestBuffer() or requestBuffers().
+     * \param[in]   timeout
+     *      Time to wait for every single buffer to be accepted.
+     *
+     * \return  Number of buffers accepted, starting with the first one.
+     *          The buffer which was not accepted is released as with
+     *          send(), the buffers following it are still owned by the
+     *          caller.
+     */
+    virtual size_t
+    sendBatch(outpost::Slice<TransmitBuffer* const> buffers, outpost::time::Duration timeout);
+
+    /**
+     * Set bits of an event group whenever packets have been transmitted.
+     *
+     * The sender can wait for the completion together with other events,
+     * see outpost::rtos::EventGroup::waitAny(), and request new buffers
+     * afterwards.
+     *
+     * \param group
+     *      Event group to notify, nullptr to disable the notification.
+     * \param bits
+     *      Bits to set.
+     */
+    void
+    setTransmitNotification(outpost::rtos::EventGroup* group,
+                            outpost::rtos::EventGroup::Bits bits);
+
+    /**
+     * Send a packet gathered from several fragments.
+     *
+     * Protocols commonly keep the path address, header, payload and
+     * trailer CRC in separate buffers. The default implementation copies
+     * the fragments into a transmit buffer. Drivers which support DMA
+     * descriptor chains should override it and transmit the fragments
+     * directly.
+     *
+     * \param[in]   fragments
+     *      Fragments in transmission order, together they form a
+     *      complete packet terminated by an end of packet marker.
+     * \param[in]   timeout
+     *      Time to wait for a free transmit buffer and for the packet to
+     *      be sent.
+     *
+     * \retval  Result::failure
+     *      The fragments do not fit into a single packet.
+     */
+    virtual Result::Type
+    sendFragments(outpost::Slice<const outpost::Slice<const uint8_t>> fragments,
+                  outpost::time::Duration timeout);
+
+    /**
+     * Return a requested buffer without transmitting a packet.
+     *
+     * A transmit buffer can only be returned by sending it, an empty
+     * packet terminated by an error end marker is sent which the receiver
+     * discards.
+     *
+     * \param[in]   buffer
+     *      Buffer obtained from requestBuffer().
+     * \param[in]   timeout
+     *      Time to wait for the empty packet to be sent.
+     */
+    Result::Type
+    abort(TransmitBuffer* buffer, outpost::time::Duration timeout);
+
     /**
      * Receive data.
      *
@@ -290,6 +386,37 @@ public:
      */
     virtual bool
     addTimeCodeListener(outpost::rtos::Queue<TimeCode>* queue) = 0;
+
+protected:
+    /**
+     * Report transmitted packets, to be called by the driver from a
+     * thread.
+     */
+    inline void
+    notifyTransmitted()
+    {
+        if (mTransmitNotificationGroup != nullptr)
+        {
+            mTransmitNotificationGroup->set(mTransmitNotificationBits);
+        }
+    }
+
+    /**
+     * Report transmitted packets, to be called by the driver from its
+     * interrupt handler.
+     */
+    inline void
+    notifyTransmittedFromInterrupt()
+    {
+        if (mTransmitNotificationGroup != nullptr)
+        {
+            mTransmitNotificationGroup->setFromInterrupt(mTransmitNotificationBits);
+        }
+    }
+
+private:
+    outpost::rtos::EventGroup* mTransmitNotificationGroup;
+    outpost::rtos::EventGroup::Bits mTransmitNotificationBits;
 };
 
 }  // namespace hal
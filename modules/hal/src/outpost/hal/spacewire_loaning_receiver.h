@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_HAL_SPACEWIRE_LOANING_RECEIVER_H
+#define OUTPOST_HAL_SPACEWIRE_LOANING_RECEIVER_H
+
+#include "receiver_interface.h"
+#include "spacewire.h"
+
+#include <outpost/rtos/mutex_guard.h>
+#include <outpost/rtos/semaphore.h>
+#include <outpost/utils/container/shared_object_pool.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace hal
+{
+/**
+ * Hands out the receive buffers of a SpaceWire driver as SharedBuffers.
+ *
+ * Every received packet stays in the memory of the driver (e.g. the DMA
+ * buffer), the SharedBuffer only refers to it. When the last
+ * SharedBufferPointer to the packet is dropped the buffer is given back
+ * to the driver with SpaceWire::releaseBuffer(), in the context of the
+ * thread dropping the reference. The driver must therefore allow
+ * releaseBuffer() to be called from other threads than receive().
+ *
+ * Used as receiver of a ProtocolDispatcherThread in loaning mode, packets
+ * then travel from the driver to the listeners without any copy:
+ *
+ * \code
+ * outpost::hal::SpaceWireLoaningReceiver<8> receiver(spw);
+ * outpost::hal::ProtocolDispatcherThread thread(dispatcher, receiver, priority,
+ *                                               stackSize, name, heartbeatSource);
+ * \endcode
+ *
+ * \warning
+ *      The driver may hold back new packets while all its buffers are
+ *      loaned out. Listeners should drop packets they do not need anymore
+ *      soon or copy them into their own pool.
+ *
+ * \tparam numberOfLoans
+ *      Maximum number of driver buffers loaned out at the same time.
+ */
+template <size_t numberOfLoans>
+class SpaceWireLoaningReceiver : public ReceiverInterface,
+                                 public outpost::utils::SharedBufferPoolBase
+{
+    static_assert(numberOfLoans > 0, "At least one loan is required");
+
+public:
+    explicit SpaceWireLoaningReceiver(SpaceWire& spw) :
+        mSpw(spw),
+        mNumberOfFreeLoans(numberOfLoans),
+        mMutex(),
+        mLoanReturned(outpost::rtos::BinarySemaphore::State::acquired)
+    {
+        for (size_t i = 0; i < numberOfLoans; ++i)
+        {
+            adopt(mBuffers[i]);
+            mFreeLoans[i] = numberOfLoans - 1 - i;
+        }
+    }
+
+    // disable copy constructor
+    SpaceWireLoaningReceiver(const SpaceWireLoaningReceiver& other) = delete;
+
+    // disable assignment operator
+    SpaceWireLoaningReceiver&
+    operator=(const SpaceWireLoaningReceiver& other) = delete;
+
+    virtual ~SpaceWireLoaningReceiver() = default;
+
+    /**
+     * Receive a package by copying it, the driver buffer is released
+     * immediately.
+     *
+     * @param buffer 	buffer to write the data to
+     * @param timeout	max timeout to wait for data
+     *
+     * @return 0	If no package received in the time or failure in underlying receiver
+     * 		   >0   Number of bytes received in package, if larger then
+     * buffer.getNumberOfElements(), data has been lost
+     */
+    virtual uint32_t
+    receive(outpost::Slice<uint8_t>& buffer, outpost::time::Duration timeout) override;
+
+    /**
+     * Receive a package and loan the driver buffer containing it.
+     *
+     * If all loans are in use, waits at most \p timeout for one to be
+     * returned before waiting for the package.
+     *
+     * @param buffer 	set to the loaned buffer, its length is the length of the package
+     * @param timeout	max timeout to wait for a free loan and for data
+     *
+     * @return 0	If no package received in the time, failure in underlying receiver or
+     * 				all loans are still in use after the timeout
+     * 		   >0   Number of bytes received in package
+     */
+    virtual uint32_t
+    receiveLoaned(outpost::utils::SharedBufferPointer& buffer,
+                  outpost::time::Duration timeout) override;
+
+    /**
+     * Buffers can only be obtained by receiving a package.
+     *
+     * @return always false
+     */
+    virtual bool
+    allocate(outpost::utils::SharedBufferPointer& pointer) override;
+
+    virtual size_t
+    numberOfElements() const override
+    {
+        return numberOfLoans;
+    }
+
+    virtual size_t
+    numberOfFreeElements() const override
+    {
+        return mNumberOfFreeLoans;
+    }
+
+protected:
+    virtual void
+    release(outpost::utils::SharedBuffer& buffer) override;
+
+private:
+    bool
+    takeLoan(size_t& index);
+
+    void
+    returnLoan(size_t index);
+
+    SpaceWire& mSpw;
+
+    outpost::utils::SharedBuffer mBuffers[numberOfLoans];
+    SpaceWire::ReceiveBuffer mReceiveBuffers[numberOfLoans];
+
+    /// Stack of the indices of the unused loans
+    size_t mFreeLoans[numberOfLoans];
+    size_t mNumberOfFreeLoans;
+
+    outpost::rtos::Mutex mMutex;
+
+    /// Released whenever a loan is returned
+    outpost::rtos::BinarySemaphore mLoanReturned;
+};
+
+}  // namespace hal
+}  // namespace outpost
+
+#include "spacewire_loaning_receiver_impl.h"
+
+#endif
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_HAL_SPACEWIRE_LOANING_RECEIVER_IMPL_H
+#define OUTPOST_HAL_SPACEWIRE_LOANING_RECEIVER_IMPL_H
+
+#include "spacewire_loaning_receiver.h"
+
+namespace outpost
+{
+namespace hal
+{
+template <size_t numberOfLoans>
+uint32_t
+SpaceWireLoaningReceiver<numberOfLoans>::receive(outpost::Slice<uint8_t>& buffer,
+                                                 outpost::time::Duration timeout)
+{
+    SpaceWire::ReceiveBuffer receiveBuffer;
+    if (mSpw.receive(receiveBuffer, timeout) != SpaceWire::Result::success)
+    {
+        return 0;
+    }
+
+    uint32_t receivedSize = receiveBuffer.getLength();
+    buffer.copyFrom(receiveBuffer.getData().first(buffer.getNumberOfElements()));
+
+    mSpw.releaseBuffer(receiveBuffer);
+    return receivedSize;
+}
+
+template <size_t numberOfLoans>
+uint32_t
+SpaceWireLoaningReceiver<numberOfLoans>::receiveLoaned(outpost::utils::SharedBufferPointer& buffer,
+                                                       outpost::time::Duration timeout)
+{
+    // Block until a loan is returned instead of failing at once, a
+    // dispatcher thread would otherwise spin and starve the listeners
+    // which have to return the loans
+    size_t index = 0;
+    bool available = takeLoan(index);
+    if (!available && mLoanReturned.acquire(timeout))
+    {
+        available = takeLoan(index);
+    }
+
+    {
+        outpost::rtos::MutexGuard lock(mMutex);
+        updateAllocationCounters(available, numberOfLoans - mNumberOfFreeLoans);
+    }
+    if (!available)
+    {
+        return 0;
+    }
+
+    SpaceWire::ReceiveBuffer& receiveBuffer = mReceiveBuffers[index];
+    if (mSpw.receive(receiveBuffer, timeout) != SpaceWire::Result::success)
+    {
+        returnLoan(index);
+        return 0;
+    }
+
+    const uint32_t receivedSize = receiveBuffer.getLength();
+    if (receivedSize == 0)
+    {
+        // an empty buffer is invalid, there is nothing to hand out
+        mSpw.releaseBuffer(receiveBuffer);
+        returnLoan(index);
+        return 0;
+    }
+
+    // The driver hands out read-only memory, the SharedBuffer interface
+    // requires mutable memory. Listeners must not modify the package.
+    mBuffers[index].setPointer(outpost::Slice<uint8_t>::unsafe(
+            const_cast<uint8_t*>(&receiveBuffer.getData()[0]), receivedSize));
+
+    // Assign outside of the lock, overwriting the previous content of
+    // buffer may release another loan.
+    buffer = outpost::utils::SharedBufferPointer(&mBuffers[index]);
+    return receivedSize;
+}
+
+template <size_t numberOfLoans>
+bool
+SpaceWireLoaningReceiver<numberOfLoans>::allocate(outpost::utils::SharedBufferPointer& /*pointer*/)
+{
+    return false;
+}
+
+template <size_t numberOfLoans>
+void
+SpaceWireLoaningReceiver<numberOfLoans>::release(outpost::utils::SharedBuffer& buffer)
+{
+    const size_t index = static_cast<size_t>(&buffer - &mBuffers[0]);
+    mSpw.releaseBuffer(mReceiveBuffers[index]);
+    returnLoan(index);
+}
+
+template <size_t numberOfLoans>
+bool
+SpaceWireLoaningReceiver<numberOfLoans>::takeLoan(size_t& index)
+{
+    outpost::rtos::MutexGuard lock(mMutex);
+    if (mNumberOfFreeLoans == 0)
+    {
+        return false;
+    }
+    mNumberOfFreeLoans--;
+    index = mFreeLoans[mNumberOfFreeLoans];
+    return true;
+}
+
+template <size_t numberOfLoans>
+void
+SpaceWireLoaningReceiver<numberOfLoans>::returnLoan(size_t index)
+{
+    {
+        outpost::rtos::MutexGuard lock(mMutex);
+        mFreeLoans[mNumberOfFreeLoans] = index;
+        mNumberOfFreeLoans++;
+    }
+    mLoanReturned.release();
+}
+
+}  // namespace hal
+}  // namespace outpost
+
+#endif
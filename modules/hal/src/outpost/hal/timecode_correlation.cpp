@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "timecode_correlation.h"
+
+using namespace outpost::hal;
+
+constexpr uint32_t TimeCodeCorrelation::minimumBaselinePeriods;
+constexpr int32_t TimeCodeCorrelation::maximumDrift;
+constexpr size_t TimeCodeCorrelationService::queueSize;
+
+// Unit of the drift
+static constexpr int64_t driftScale = int64_t(1) << 32;
+
+// The baseline is restarted before the drift calculation could overflow
+static constexpr int64_t maximumBaseline = int64_t(1) << 31;
+
+// Range of the 6 bit timecode value
+static constexpr int64_t timeCodeRange = 64;
+
+static inline int64_t
+toMicroseconds(outpost::time::SpacecraftElapsedTime time)
+{
+    return time.timeSinceEpoch().microseconds();
+}
+
+TimeCodeCorrelation::TimeCodeCorrelation(outpost::time::Duration timeCodePeriod,
+                                         outpost::time::Duration maximumJitter) :
+    mPeriod(timeCodePeriod.microseconds()),
+    mMaximumJitter(maximumJitter.microseconds()),
+    mOffset(0),
+    mCounter(0),
+    mLastLocalTime(0),
+    mLastValue(0),
+    mAnchorCounter(0),
+    mAnchorLocalTime(0),
+    mDrift(0),
+    mStarted(false),
+    mNumberOfResynchronizations(0),
+    mModel(TimeCorrelationModel{0, 0, 0, 0})
+{
+}
+
+void
+TimeCodeCorrelation::setOffset(outpost::time::Duration offset)
+{
+    mOffset = offset.microseconds();
+}
+
+void
+TimeCodeCorrelation::onTimeCode(const TimeCode& timeCode,
+                                outpost::time::SpacecraftElapsedTime localTime)
+{
+    const int64_t local = toMicroseconds(localTime);
+    const uint8_t value = static_cast<uint8_t>(timeCode.mValue & (timeCodeRange - 1));
+    if (!mStarted)
+    {
+        mStarted = true;
+        mLastValue = value;
+        restart(value, local);
+        return;
+    }
+
+    const int64_t elapsed = local - mLastLocalTime;
+    const int64_t difference = (value - mLastValue) & (timeCodeRange - 1);
+    mLastValue = value;
+
+    // Number of periods which have passed according to the local clock,
+    // used to detect timecodes which were lost including complete wraps
+    const int64_t elapsedOnboard = elapsed + (elapsed * mDrift) / driftScale;
+    const int64_t periods = (elapsedOnboard + mPeriod / 2) / mPeriod;
+    int64_t increment = difference;
+    if (periods > difference)
+    {
+        increment += timeCodeRange * ((periods - difference + timeCodeRange / 2) / timeCodeRange);
+    }
+
+    const int64_t deviation = increment * mPeriod - elapsedOnboard;
+    if (elapsed < 0 || deviation > mMaximumJitter || deviation < -mMaximumJitter)
+    {
+        mNumberOfResynchronizations.fetchAdd(1);
+        restart(value, local);
+        return;
+    }
+
+    mCounter += increment;
+    mLastLocalTime = local;
+
+    const int64_t localSpan = local - mAnchorLocalTime;
+    if (mCounter - mAnchorCounter >= minimumBaselinePeriods && localSpan > 0)
+    {
+        int64_t spanDifference = (mCounter - mAnchorCounter) * mPeriod - localSpan;
+
+        // Limit before scaling, so that the multiplication cannot overflow
+        const int64_t limit = localSpan / 64;
+        if (spanDifference > limit)
+        {
+            spanDifference = limit;
+        }
+        else if (spanDifference < -limit)
+        {
+            spanDifference = -limit;
+        }
+
+        int64_t drift = (spanDifference * driftScale) / localSpan;
+        if (drift > maximumDrift)
+        {
+            drift = maximumDrift;
+        }
+        else if (drift < -maximumDrift)
+        {
+            drift = -maximumDrift;
+        }
+        mDrift = static_cast<int32_t>(drift);
+    }
+
+    if (localSpan >= maximumBaseline)
+    {
+        // The current drift is kept until the new baseline is long enough
+        mAnchorCounter = mCounter;
+        mAnchorLocalTime = local;
+    }
+
+    publish(local, mOffset + mCounter * mPeriod);
+}
+
+bool
+TimeCodeCorrelation::toOnboardTime(outpost::time::SpacecraftElapsedTime localTime,
+                                   outpost::time::SpacecraftElapsedTime& onboardTime) const
+{
+    const TimeCorrelationModel model = mModel.read();
+    if (model.mValid == 0)
+    {
+        return false;
+    }
+
+    onboardTime = outpost::time::SpacecraftElapsedTime::afterEpoch(
+            outpost::time::Microseconds(apply(model, toMicroseconds(localTime))));
+    return true;
+}
+
+int32_t
+TimeCodeCorrelation::getDriftInPartsPerBillion() const
+{
+    return static_cast<int32_t>((mModel.read().mDrift * int64_t(1000000000)) / driftScale);
+}
+
+int64_t
+TimeCodeCorrelation::apply(const TimeCorrelationModel& model, int64_t localTime)
+{
+    const int64_t delta = localTime - model.mLocalReference;
+    return model.mOnboardReference + delta + (delta * model.mDrift) / driftScale;
+}
+
+void
+TimeCodeCorrelation::restart(int64_t counter, int64_t localTime)
+{
+    mCounter = counter;
+    mLastLocalTime = localTime;
+    mAnchorCounter = counter;
+    mAnchorLocalTime = localTime;
+    publish(localTime, mOffset + counter * mPeriod);
+}
+
+void
+TimeCodeCorrelation::publish(int64_t localTime, int64_t onboardTime)
+{
+    mModel.write(TimeCorrelationModel{localTime, onboardTime, mDrift, 1});
+}
+
+// ----------------------------------------------------------------------------
+internal::TimeCodeCorrelationThread::TimeCodeCorrelationThread(
+        TimeCodeCorrelationService& service,
+        uint8_t priority,
+        size_t stackSize,
+        const char* name) :
+    Thread(priority, stackSize, name),
+    mService(service)
+{
+}
+
+void
+internal::TimeCodeCorrelationThread::run()
+{
+    mService.run();
+}
+
+// ----------------------------------------------------------------------------
+TimeCodeCorrelationService::TimeCodeCorrelationService(const outpost::time::Clock& clock,
+                                                       outpost::time::Duration timeCodePeriod,
+                                                       outpost::time::Duration maximumJitter,
+                                                       uint8_t priority,
+                                                       size_t stackSize,
+                                                       const char* name) :
+    mClock(clock),
+    mCorrelation(timeCodePeriod, maximumJitter),
+    mQueue(queueSize),
+    mThread(*this, priority, stackSize, name)
+{
+}
+
+bool
+TimeCodeCorrelationService::start(TimeCodeDispatcherInterface& dispatcher)
+{
+    if (!dispatcher.addListener(&mQueue))
+    {
+        return false;
+    }
+    mThread.start();
+    return true;
+}
+
+void
+TimeCodeCorrelationService::run()
+{
+    while (true)
+    {
+        TimeCode timeCode;
+        if (mQueue.receive(timeCode, outpost::time::Duration::infinity()))
+        {
+            mCorrelation.onTimeCode(timeCode, mClock.now());
+        }
+    }
+}
@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_HAL_TIMECODE_CORRELATION_H
+#define OUTPOST_HAL_TIMECODE_CORRELATION_H
+
+#include "timecode.h"
+#include "timecode_dispatcher.h"
+
+#include <outpost/rtos/atomic.h>
+#include <outpost/rtos/queue.h>
+#include <outpost/rtos/seqlock.h>
+#include <outpost/rtos/thread.h>
+#include <outpost/time/clock.h>
+#include <outpost/time/duration.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace hal
+{
+/**
+ * Linear model between the local clock and the onboard time.
+ *
+ *     onboard = onboardReference + (local - localReference) * (1 + drift)
+ *
+ * All times are in microseconds, the drift is in units of 2^-32.
+ */
+struct TimeCorrelationModel
+{
+    int64_t mLocalReference;
+    int64_t mOnboardReference;
+    int32_t mDrift;
+
+    /// Zero until the first timecode has been received
+    uint32_t mValid;
+};
+
+/**
+ * Correlation of the local clock with the onboard time distributed by
+ * SpaceWire timecodes.
+ *
+ * Every timecode marks the begin of a timecode period of the onboard
+ * time. The 6 bit timecode values are unwrapped into a continuous
+ * counter, the onboard time of a timecode is
+ *
+ *     offset + counter * timeCodePeriod
+ *
+ * The drift of the local clock is measured over a baseline of many
+ * timecodes, so that the jitter of the individual timestamps is averaged.
+ * The baseline is restarted after about 35 minutes to keep the fixed
+ * point arithmetic within 64 bit. The offset of the model is taken from
+ * the latest timecode, conversions are therefore as accurate as the
+ * timestamps of the timecodes.
+ *
+ * The model is published through a SeqLock, any thread can convert
+ * timestamps without locks. Readers with a higher priority than the
+ * context calling onTimeCode() may be delayed by a clock tick if they
+ * interrupt an update, see outpost::rtos::SeqLock.
+ *
+ * If a timecode deviates more than the allowed jitter from the expected
+ * time (e.g. because the timecode source was reset), the correlation is
+ * restarted with the new timecode. The last drift is kept in this case.
+ *
+ * Only one context may call onTimeCode().
+ */
+class TimeCodeCorrelation
+{
+public:
+    /// Minimum number of timecode periods between two points for a drift estimate
+    static constexpr uint32_t minimumBaselinePeriods = 16;
+
+    /// Limit of the drift estimate, about 1 %
+    static constexpr int32_t maximumDrift = 42949673;
+
+    /**
+     * \param timeCodePeriod
+     *      Onboard time between two timecodes.
+     * \param maximumJitter
+     *      Maximum deviation of a timestamp from the expected time before
+     *      the correlation is restarted.
+     */
+    TimeCodeCorrelation(time::Duration timeCodePeriod, time::Duration maximumJitter);
+
+    // disable copy constructor
+    TimeCodeCorrelation(const TimeCodeCorrelation& other) = delete;
+
+    // disable assignment operator
+    TimeCodeCorrelation&
+    operator=(const TimeCodeCorrelation& other) = delete;
+
+    /**
+     * Set the onboard time of the timecode counter value zero.
+     *
+     * Takes effect with the next timecode. Must be called from the same
+     * context as onTimeCode().
+     */
+    void
+    setOffset(time::Duration offset);
+
+    /**
+     * Add a received timecode.
+     *
+     * \param localTime
+     *      Time of the local clock at which the timecode was received.
+     */
+    void
+    onTimeCode(const TimeCode& timeCode, time::SpacecraftElapsedTime localTime);
+
+    /**
+     * Convert a local timestamp into onboard time.
+     *
+     * \retval true     \p onboardTime was set.
+     * \retval false    No timecode has been received yet.
+     */
+    bool
+    toOnboardTime(time::SpacecraftElapsedTime localTime,
+                  time::SpacecraftElapsedTime& onboardTime) const;
+
+    inline bool
+    isSynchronized() const
+    {
+        return mModel.read().mValid != 0;
+    }
+
+    inline TimeCorrelationModel
+    getModel() const
+    {
+        return mModel.read();
+    }
+
+    /**
+     * Drift of the local clock relative to the onboard time.
+     *
+     * Positive if the local clock is slower than the onboard time.
+     */
+    int32_t
+    getDriftInPartsPerBillion() const;
+
+    /**
+     * Number of times the correlation was restarted because of a
+     * timecode outside of the allowed jitter.
+     */
+    inline uint32_t
+    getNumberOfResynchronizations() const
+    {
+        return mNumberOfResynchronizations.load();
+    }
+
+    /**
+     * Convert microseconds of the local clock with a model.
+     */
+    static int64_t
+    apply(const TimeCorrelationModel& model, int64_t localTime);
+
+private:
+    void
+    restart(int64_t counter, int64_t localTime);
+
+    void
+    publish(int64_t localTime, int64_t onboardTime);
+
+    const int64_t mPeriod;
+    const int64_t mMaximumJitter;
+
+    int64_t mOffset;
+
+    /// Unwrapped timecode counter and local time of the last timecode
+    int64_t mCounter;
+    int64_t mLastLocalTime;
+    uint8_t mLastValue;
+
+    /// Start of the baseline for the drift estimate
+    int64_t mAnchorCounter;
+    int64_t mAnchorLocalTime;
+
+    int32_t mDrift;
+    bool mStarted;
+    rtos::Atomic<uint32_t> mNumberOfResynchronizations;
+
+    rtos::SeqLock<TimeCorrelationModel> mModel;
+};
+
+class TimeCodeCorrelationService;
+
+namespace internal
+{
+class TimeCodeCorrelationThread : public rtos::Thread
+{
+public:
+    TimeCodeCorrelationThread(TimeCodeCorrelationService& service,
+                              uint8_t priority,
+                              size_t stackSize,
+                              const char* name);
+
+protected:
+    virtual void
+    run() override;
+
+private:
+    TimeCodeCorrelationService& mService;
+};
+}  // namespace internal
+
+/**
+ * Thread which subscribes to the timecodes of a dispatcher and feeds them
+ * into a TimeCodeCorrelation.
+ *
+ * The timecodes are timestamped when the thread takes them from its
+ * queue, not when they arrive. The latency of the dispatcher, the queue
+ * and the scheduling of the thread therefore goes directly into the
+ * model: a constant latency shows as a constant offset, a varying one as
+ * jitter. The thread should run with a high priority, at least as high as
+ * the threads converting timestamps. Drivers which timestamp the
+ * timecode in their interrupt should call
+ * TimeCodeCorrelation::onTimeCode() with that timestamp instead.
+ *
+ * \code
+ * outpost::hal::TimeCodeCorrelationService correlation(
+ *         clock, Milliseconds(1000), Milliseconds(5), priority);
+ * correlation.start(dispatcher);
+ *
+ * // any thread
+ * SpacecraftElapsedTime onboard;
+ * if (correlation.getCorrelation().toOnboardTime(clock.now(), onboard))
+ * {
+ *     ...
+ * }
+ * \endcode
+ */
+class TimeCodeCorrelationService
+{
+public:
+    TimeCodeCorrelationService(const time::Clock& clock,
+                               time::Duration timeCodePeriod,
+                               time::Duration maximumJitter,
+                               uint8_t priority,
+                               size_t stackSize = rtos::Thread::defaultStackSize,
+                               const char* name = "TCOR");
+
+    // disable copy constructor
+    TimeCodeCorrelationService(const TimeCodeCorrelationService& other) = delete;
+
+    // disable assignment operator
+    TimeCodeCorrelationService&
+    operator=(const TimeCodeCorrelationService& other) = delete;
+
+    /**
+     * Register with the dispatcher and start the thread.
+     *
+     * \return  false if the dispatcher has no space for another listener,
+     *          the thread is not started in this case.
+     */
+    bool
+    start(TimeCodeDispatcherInterface& dispatcher);
+
+    inline TimeCodeCorrelation&
+    getCorrelation()
+    {
+        return mCorrelation;
+    }
+
+    inline const TimeCodeCorrelation&
+    getCorrelation() const
+    {
+        return mCorrelation;
+    }
+
+private:
+    friend class internal::TimeCodeCorrelationThread;
+
+    static constexpr size_t queueSize = 4;
+
+    void
+    run();
+
+    const time::Clock& mClock;
+    TimeCodeCorrelation mCorrelation;
+    rtos::Queue<TimeCode> mQueue;
+
+    // Declared last so that the thread is destroyed first
+    internal::TimeCodeCorrelationThread mThread;
+};
+
+}  // namespace hal
+}  // namespace outpost
+
+#endif
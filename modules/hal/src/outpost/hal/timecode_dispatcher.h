@@ -15,9 +15,11 @@
 #define OUTPOST_HAL_TIMECODE_DISPATCHER_H_
 
 #include "timecode.h"
+#include "timecode_mailbox.h"
 
 #include <outpost/rtos.h>
 #include <outpost/rtos/queue.h>
+#include <outpost/utils/container/spsc_queue.h>
 
 #include <stdint.h>
 
@@ -53,15 +55,42 @@ public:
      */
     virtual bool
     addListener(outpost::rtos::Queue<TimeCode>* queue) = 0;
+
+    /**
+     * Add a lock-free listener for timecode, the dispatcher is its only producer.
+     * Timecodes are sent with SpscQueue::sendFromInterrupt().
+     * @param queue the queue to add
+     * @return false if queue == nullptr or all places for Listener are filled
+     */
+    virtual bool
+    addListener(outpost::utils::SpscQueue<TimeCode>* queue) = 0;
+
+    /**
+     * Latest dispatched timecode.
+     *
+     * Can be read lock-free by any number of consumers which only need the
+     * most recent timecode, without registering a listener.
+     */
+    virtual const TimeCodeMailbox&
+    getLatestTimeCode() const = 0;
 };
 
+/**
+ * Every timecode is stored in a mailbox, which takes constant time, and
+ * then sent to the registered queues.
+ *
+ * Sending to an outpost::rtos::Queue may take a lock inside the operating
+ * system, the time spent in the ISR then grows with every such listener.
+ * Consumers should prefer getLatestTimeCode() or a SpscQueue listener.
+ */
 template <uint32_t numberOfQueues>  // how many queues can be included
 class TimeCodeDispatcher : public TimeCodeDispatcherInterface
 {
 public:
-    TimeCodeDispatcher() : mNumberOfListeners(0)
+    TimeCodeDispatcher() : mNumberOfListeners(0), mNumberOfSpscListeners(0)
     {
         mListener.fill(nullptr);
+        mSpscListener.fill(nullptr);
     };
     virtual ~TimeCodeDispatcher() = default;
 
@@ -70,10 +99,15 @@ public:
     {
         // For one we are in a ISR and also nNumberOfListener only increments to
         // we don't need any mutex as worst case a just added listener don't get a notify.
+        mLatest.publish(tc);
         for (uint32_t i = 0; i < mNumberOfListeners; i++)
         {
             mListener[i]->send(tc);
         }
+        for (uint32_t i = 0; i < mNumberOfSpscListeners; i++)
+        {
+            mSpscListener[i]->sendFromInterrupt(tc);
+        }
     }
 
     virtual bool
@@ -85,7 +119,7 @@ public:
         }
 
         outpost::rtos::MutexGuard lock(mMutex);
-        if (mNumberOfListeners >= numberOfQueues)
+        if (mNumberOfListeners + mNumberOfSpscListeners >= numberOfQueues)
         {
             return false;
         }
@@ -95,9 +129,37 @@ public:
         return true;
     }
 
+    virtual bool
+    addListener(outpost::utils::SpscQueue<TimeCode>* queue)
+    {
+        if (queue == nullptr)
+        {
+            return false;
+        }
+
+        outpost::rtos::MutexGuard lock(mMutex);
+        if (mNumberOfListeners + mNumberOfSpscListeners >= numberOfQueues)
+        {
+            return false;
+        }
+
+        mSpscListener[mNumberOfSpscListeners] = queue;
+        mNumberOfSpscListeners++;
+        return true;
+    }
+
+    virtual const TimeCodeMailbox&
+    getLatestTimeCode() const
+    {
+        return mLatest;
+    }
+
 private:
+    TimeCodeMailbox mLatest;
     std::array<outpost::rtos::Queue<TimeCode>*, numberOfQueues> mListener;
+    std::array<outpost::utils::SpscQueue<TimeCode>*, numberOfQueues> mSpscListener;
     uint32_t mNumberOfListeners;
+    uint32_t mNumberOfSpscListeners;
     outpost::rtos::Mutex mMutex;
 };
 
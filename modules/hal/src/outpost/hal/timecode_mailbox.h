@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_HAL_TIMECODE_MAILBOX_H
+#define OUTPOST_HAL_TIMECODE_MAILBOX_H
+
+#include "timecode.h"
+
+#include <outpost/rtos/atomic.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace hal
+{
+/**
+ * Holds the most recent timecode for any number of readers.
+ *
+ * The timecode and a sequence number are packed into a single atomic
+ * word, so publishing is one store and readers always see a consistent
+ * pair without locking or retrying. The sequence number is incremented
+ * with every timecode and allows readers to detect new timecodes,
+ * including repetitions of the same value.
+ *
+ * Safe to publish from an ISR. Only one context may publish.
+ */
+class TimeCodeMailbox
+{
+public:
+    /// Sequence number before the first timecode is published
+    static constexpr uint16_t noTimeCode = 0;
+
+    TimeCodeMailbox() : mWord(0)
+    {
+    }
+
+    // disable copy constructor
+    TimeCodeMailbox(const TimeCodeMailbox& other) = delete;
+
+    // disable assignment operator
+    TimeCodeMailbox&
+    operator=(const TimeCodeMailbox& other) = delete;
+
+    /**
+     * Replace the stored timecode.
+     */
+    inline void
+    publish(const TimeCode& tc)
+    {
+        uint16_t sequence = getSequence(mWord.load()) + 1;
+        if (sequence == noTimeCode)
+        {
+            sequence++;
+        }
+        mWord.store((static_cast<uint32_t>(sequence) << 16)
+                    | (static_cast<uint32_t>(tc.mControl) << 8) | tc.mValue);
+    }
+
+    /**
+     * Read the latest timecode.
+     *
+     * \param tc
+     *      Set to the latest timecode, unchanged if none was published yet.
+     * \param sequence
+     *      Set to the sequence number of the returned timecode.
+     *
+     * \return  false if no timecode was published yet.
+     */
+    inline bool
+    read(TimeCode& tc, uint16_t& sequence) const
+    {
+        const uint32_t word = mWord.load();
+        sequence = getSequence(word);
+        if (sequence == noTimeCode)
+        {
+            return false;
+        }
+        tc.mValue = static_cast<uint8_t>(word);
+        tc.mControl = static_cast<uint8_t>(word >> 8);
+        return true;
+    }
+
+    /**
+     * Read the latest timecode if it is newer than the one a reader has
+     * seen before.
+     *
+     * \param tc
+     *      Set to the latest timecode if it is new.
+     * \param lastSequence
+     *      Sequence number of the last timecode seen by the reader, use
+     *      #noTimeCode initially. Updated if a new timecode is returned.
+     *
+     * \return  true if a new timecode was returned.
+     */
+    inline bool
+    readIfNew(TimeCode& tc, uint16_t& lastSequence) const
+    {
+        uint16_t sequence;
+        TimeCode latest;
+        if (!read(latest, sequence) || sequence == lastSequence)
+        {
+            return false;
+        }
+        tc = latest;
+        lastSequence = sequence;
+        return true;
+    }
+
+    inline uint16_t
+    getSequence() const
+    {
+        return getSequence(mWord.load());
+    }
+
+private:
+    static inline uint16_t
+    getSequence(uint32_t word)
+    {
+        return static_cast<uint16_t>(word >> 16);
+    }
+
+    outpost::rtos::Atomic<uint32_t> mWord;
+};
+
+}  // namespace hal
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/hal/buffered_serial.h>
+#include <outpost/rtos.h>
+
+#include <unittest/harness.h>
+
+#include <vector>
+
+namespace
+{
+/**
+ * Driver which "transmits" synchronously into a vector, the test plays
+ * the receive interrupt.
+ */
+class BufferedSerialDriver : public outpost::hal::BufferedSerial
+{
+public:
+    BufferedSerialDriver() :
+        BufferedSerial(outpost::asSlice(mReceiveStorage), outpost::asSlice(mTransmitStorage), 4),
+        mTransmitEnabled(true)
+    {
+    }
+
+    void
+    close() override
+    {
+    }
+
+    void
+    startTransmission() override
+    {
+        while (mTransmitEnabled && getTransmitSpan().getNumberOfElements() > 0)
+        {
+            outpost::Slice<const uint8_t> span = getTransmitSpan();
+            mTransmitted.insert(mTransmitted.end(), span.begin(), span.end());
+            commitTransmitted(span.getNumberOfElements());
+        }
+    }
+
+    using BufferedSerial::commitReceived;
+    using BufferedSerial::commitTransmitted;
+    using BufferedSerial::getReceiveSpan;
+    using BufferedSerial::getTransmitSpan;
+    using BufferedSerial::notifyReceiverIdle;
+    using BufferedSerial::receive;
+
+    uint8_t mReceiveStorage[8];
+    uint8_t mTransmitStorage[4];
+    bool mTransmitEnabled;
+    std::vector<uint8_t> mTransmitted;
+};
+
+/**
+ * Plays the interrupts of a driver in a separate thread: received bursts
+ * of three bytes are stored alternately by DMA and by copying, each
+ * followed by an idle line. The transmit ring is drained two bytes at a
+ * time.
+ */
+class Interrupt : public outpost::rtos::Thread
+{
+public:
+    Interrupt(BufferedSerialDriver& serial, size_t numberOfBursts) :
+        Thread(0, defaultStackSize, "IRQ"),
+        mSerial(serial),
+        mNumberOfBursts(numberOfBursts)
+    {
+    }
+
+    std::vector<uint8_t> mTransmitted;
+
+protected:
+    virtual void
+    run() override
+    {
+        uint8_t value = 0;
+        for (size_t burst = 0; burst < mNumberOfBursts; ++burst)
+        {
+            // The next burst only follows after the reader has taken
+            // the previous one
+            while (mSerial.getNumberOfBytesAvailable() > 0)
+            {
+                drainTransmitter();
+            }
+
+            if (burst % 2 == 0)
+            {
+                // The free region may wrap at the end of the ring
+                size_t remaining = 3;
+                while (remaining > 0)
+                {
+                    outpost::Slice<uint8_t> dma = mSerial.getReceiveSpan();
+                    const size_t count = (dma.getNumberOfElements() < remaining)
+                                                 ? dma.getNumberOfElements()
+                                                 : remaining;
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        dma[i] = value++;
+                    }
+                    mSerial.commitReceived(count);
+                    remaining -= count;
+                }
+            }
+            else
+            {
+                const uint8_t bytes[] = {value, static_cast<uint8_t>(value + 1),
+                                         static_cast<uint8_t>(value + 2)};
+                value += 3;
+                mSerial.receive(outpost::asSlice(bytes));
+            }
+
+            // Below the watermark of four bytes
+            mSerial.notifyReceiverIdle();
+        }
+
+        // Returning from a thread is fatal, wait for the destructor
+        while (true)
+        {
+            drainTransmitter();
+        }
+    }
+
+private:
+    void
+    drainTransmitter()
+    {
+        outpost::Slice<const uint8_t> span = mSerial.getTransmitSpan();
+        if (span.getNumberOfElements() > 2)
+        {
+            span = span.first(2);
+        }
+        if (span.getNumberOfElements() > 0)
+        {
+            mTransmitted.insert(mTransmitted.end(), span.begin(), span.end());
+            mSerial.commitTransmitted(span.getNumberOfElements());
+        }
+        sleep(outpost::time::Milliseconds(1));
+    }
+
+    BufferedSerialDriver& mSerial;
+    const size_t mNumberOfBursts;
+};
+}  // namespace
+
+TEST(BufferedSerialTest, shouldReadReceivedDataInPlace)
+{
+    BufferedSerialDriver serial;
+
+    const uint8_t bytes[] = {1, 2, 3};
+    EXPECT_EQ(3U, serial.receive(outpost::asSlice(bytes)));
+
+    // below the watermark of four bytes
+    EXPECT_TRUE(serial.peek(outpost::time::Duration::zero()).getNumberOfElements() == 3);
+
+    outpost::Slice<uint8_t> dma = serial.getReceiveSpan();
+    ASSERT_EQ(5U, dma.getNumberOfElements());
+    dma[0] = 4;
+    serial.commitReceived(1);
+
+    outpost::Slice<const uint8_t> span = serial.peek(outpost::time::Duration::zero());
+    ASSERT_EQ(4U, span.getNumberOfElements());
+    EXPECT_EQ(4, span[3]);
+    serial.consume(4);
+    EXPECT_FALSE(serial.isAvailable());
+}
+
+TEST(BufferedSerialTest, shouldCountLostBytes)
+{
+    BufferedSerialDriver serial;
+
+    const uint8_t bytes[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    EXPECT_EQ(8U, serial.receive(outpost::asSlice(bytes)));
+    EXPECT_EQ(2U, serial.getNumberOfLostBytes());
+
+    uint8_t data[3];
+    EXPECT_EQ(3U, serial.read(outpost::asSlice(data), outpost::time::Duration::zero()));
+    EXPECT_EQ(3, data[2]);
+    EXPECT_EQ(5U, serial.getNumberOfBytesAvailable());
+
+    serial.flushReceiver();
+    EXPECT_EQ(0U, serial.getNumberOfBytesAvailable());
+}
+
+TEST(BufferedSerialTest, shouldWriteMoreThanTheRingHolds)
+{
+    BufferedSerialDriver serial;
+
+    const uint8_t bytes[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    EXPECT_EQ(10U, serial.write(outpost::asSlice(bytes), outpost::time::Duration::zero()));
+    EXPECT_EQ(std::vector<uint8_t>(bytes, bytes + 10), serial.mTransmitted);
+}
+
+TEST(BufferedSerialTest, shouldStopWritingOnTimeout)
+{
+    BufferedSerialDriver serial;
+    serial.mTransmitEnabled = false;
+
+    const uint8_t bytes[] = {1, 2, 3, 4, 5, 6};
+    EXPECT_EQ(4U, serial.write(outpost::asSlice(bytes), outpost::time::Duration::zero()));
+
+    serial.mTransmitEnabled = true;
+    serial.flushTransmitter();
+    EXPECT_EQ(4U, serial.mTransmitted.size());
+}
+
+TEST(BufferedSerialTest, shouldExchangeDataWithInterrupt)
+{
+    BufferedSerialDriver serial;
+    serial.mTransmitEnabled = false;
+    Interrupt interrupt(serial, 10);
+    interrupt.start();
+
+    // Blocks whenever the four byte transmit ring is full
+    uint8_t bytes[20];
+    for (size_t i = 0; i < sizeof(bytes); ++i)
+    {
+        bytes[i] = static_cast<uint8_t>(100 + i);
+    }
+    EXPECT_EQ(20U, serial.write(outpost::asSlice(bytes), outpost::time::Seconds(10)));
+    serial.flushTransmitter();
+
+    // Every burst is returned on its idle line notification
+    std::vector<uint8_t> received;
+    for (size_t burst = 0; burst < 10; ++burst)
+    {
+        uint8_t data[8];
+        ASSERT_EQ(3U, serial.read(outpost::asSlice(data), outpost::time::Seconds(10)));
+        received.insert(received.end(), data, data + 3);
+    }
+
+    for (size_t i = 0; i < received.size(); ++i)
+    {
+        EXPECT_EQ(i, received[i]);
+    }
+    EXPECT_EQ(30U, received.size());
+    EXPECT_EQ(std::vector<uint8_t>(bytes, bytes + 20), interrupt.mTransmitted);
+    EXPECT_EQ(0U, serial.getNumberOfLostBytes());
+}
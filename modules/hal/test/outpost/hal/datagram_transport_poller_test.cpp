@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/hal/datagram_transport_poller.h>
+#include <outpost/hal/protocol_dispatcher.h>
+
+#include <unittest/harness.h>
+
+#include <string.h>
+
+#include <vector>
+
+using namespace outpost::hal;
+
+namespace
+{
+/// Receives the datagrams given to push(), counts the receive calls
+class DatagramSource : public DatagramTransport
+{
+public:
+    DatagramSource() : mNumberOfReceiveCalls(0)
+    {
+    }
+
+    void
+    push(uint8_t protocol, uint8_t value)
+    {
+        mDatagrams.push_back({protocol, value});
+    }
+
+    bool
+    connect() override
+    {
+        return true;
+    }
+
+    void
+    close() override
+    {
+    }
+
+    Address
+    getAddress() const override
+    {
+        return Address();
+    }
+
+    void
+    setAddress(const Address&) override
+    {
+    }
+
+    bool
+    isAvailable() override
+    {
+        return !mDatagrams.empty();
+    }
+
+    size_t
+    getNumberOfBytesAvailable() override
+    {
+        return mDatagrams.empty() ? 0 : mDatagrams.front().size();
+    }
+
+    size_t
+    getMaximumDatagramSize() const override
+    {
+        return 8;
+    }
+
+    size_t
+    sendTo(outpost::Slice<const uint8_t>, const Address&, outpost::time::Duration) override
+    {
+        return 0;
+    }
+
+    size_t
+    receiveFrom(outpost::Slice<uint8_t>& data,
+                Address& address,
+                outpost::time::Duration) override
+    {
+        mNumberOfReceiveCalls++;
+        if (mDatagrams.empty())
+        {
+            return 0;
+        }
+        size_t length = std::min(data.getNumberOfElements(), mDatagrams.front().size());
+        memcpy(data.begin(), mDatagrams.front().data(), length);
+        address = Address(IpAddress(10, 0, 0, 1), 1000);
+        mDatagrams.erase(mDatagrams.begin());
+        return length;
+    }
+
+    void
+    clearReceiveBuffer() override
+    {
+        mDatagrams.clear();
+    }
+
+    std::vector<std::vector<uint8_t>> mDatagrams;
+    size_t mNumberOfReceiveCalls;
+};
+}  // namespace
+
+class DatagramTransportPollerTest : public testing::Test
+{
+public:
+    DatagramTransportPollerTest() :
+        mFirstDispatcher(0),
+        mSecondDispatcher(0),
+        mFirst(mFirstSource, mFirstDispatcher),
+        mSecond(mSecondSource, mSecondDispatcher)
+    {
+        mFirstDispatcher.addQueue(1, nullptr, &mFirstQueue);
+        mSecondDispatcher.addQueue(2, nullptr, &mSecondQueue);
+    }
+
+    DatagramSource mFirstSource;
+    DatagramSource mSecondSource;
+    ProtocolDispatcher<uint8_t, 1> mFirstDispatcher;
+    ProtocolDispatcher<uint8_t, 1> mSecondDispatcher;
+    outpost::utils::SharedBufferQueue<8> mFirstQueue;
+    outpost::utils::SharedBufferQueue<8> mSecondQueue;
+    DatagramEndpoint mFirst;
+    DatagramEndpoint mSecond;
+};
+
+TEST_F(DatagramTransportPollerTest, shouldDispatchFromAllReadyEndpoints)
+{
+    outpost::utils::SharedBufferPool<8, 6> pool;
+    DatagramTransportPoller<4> poller(pool, outpost::time::Milliseconds(1), 0);
+    poller.addEndpoint(mFirst);
+    poller.addEndpoint(mSecond);
+
+    EXPECT_EQ(0U, poller.poll());
+
+    mFirstSource.push(1, 10);
+    mFirstSource.push(1, 11);
+    mSecondSource.push(2, 20);
+    EXPECT_EQ(3U, poller.poll());
+    EXPECT_EQ(2U, mFirst.getNumberOfReceivedDatagrams());
+    EXPECT_EQ(1U, mSecond.getNumberOfReceivedDatagrams());
+
+    ASSERT_EQ(2U, mFirstQueue.getNumberOfItems());
+    ASSERT_EQ(1U, mSecondQueue.getNumberOfItems());
+
+    outpost::utils::SharedBufferPointer buffer;
+    ASSERT_TRUE(mSecondQueue.receive(buffer, outpost::time::Duration::zero()));
+    EXPECT_EQ(20, buffer[1]);
+    EXPECT_EQ(0U, mFirstDispatcher.getNumberOfDroppedPackages());
+}
+
+TEST_F(DatagramTransportPollerTest, shouldNotReceiveFromIdleEndpoints)
+{
+    outpost::utils::SharedBufferPool<8, 6> pool;
+    DatagramTransportPoller<4> poller(pool, outpost::time::Milliseconds(1), 0);
+    poller.addEndpoint(mFirst);
+    poller.addEndpoint(mSecond);
+
+    mSecondSource.push(2, 20);
+    EXPECT_EQ(1U, poller.poll());
+    EXPECT_EQ(0U, mFirstSource.mNumberOfReceiveCalls);
+}
+
+TEST_F(DatagramTransportPollerTest, shouldReadOneBatchPerEndpointAndRound)
+{
+    outpost::utils::SharedBufferPool<8, 6> pool;
+    DatagramTransportPoller<2> poller(pool, outpost::time::Milliseconds(1), 0);
+    poller.addEndpoint(mFirst);
+    poller.addEndpoint(mSecond);
+
+    for (uint8_t i = 0; i < 3; ++i)
+    {
+        mFirstSource.push(1, i);
+    }
+    mSecondSource.push(2, 20);
+
+    EXPECT_EQ(3U, poller.poll());
+    EXPECT_EQ(2U, mFirst.getNumberOfReceivedDatagrams());
+    EXPECT_EQ(1U, mSecond.getNumberOfReceivedDatagrams());
+
+    EXPECT_EQ(1U, poller.poll());
+    EXPECT_EQ(3U, mFirstQueue.getNumberOfItems());
+}
+
+TEST_F(DatagramTransportPollerTest, shouldReuseBuffersCopiedByTheDispatcher)
+{
+    outpost::utils::SharedBufferPool<8, 4> pool;
+    outpost::utils::SharedBufferPool<8, 4> copies;
+    outpost::utils::SharedBufferQueue<8> queue;
+    ProtocolDispatcher<uint8_t, 1> dispatcher(0);
+    dispatcher.addQueue(3, &copies, &queue);
+    DatagramEndpoint endpoint(mFirstSource, dispatcher);
+
+    DatagramTransportPoller<2> poller(pool, outpost::time::Milliseconds(1), 0);
+    poller.addEndpoint(endpoint);
+
+    mFirstSource.push(3, 30);
+    mFirstSource.push(3, 31);
+    EXPECT_EQ(2U, poller.poll());
+    EXPECT_EQ(2U, queue.getNumberOfItems());
+    EXPECT_EQ(2U, pool.numberOfFreeElements());
+
+    mFirstSource.push(3, 32);
+    EXPECT_EQ(1U, poller.poll());
+    EXPECT_EQ(2U, pool.numberOfFreeElements());
+    EXPECT_EQ(3U, queue.getNumberOfItems());
+}
+
+TEST_F(DatagramTransportPollerTest, shouldStopRoundIfPoolIsExhausted)
+{
+    outpost::utils::SharedBufferPool<8, 1> pool;
+    DatagramTransportPoller<2> poller(pool, outpost::time::Milliseconds(1), 0);
+    poller.addEndpoint(mFirst);
+
+    mFirstSource.push(1, 10);
+    mFirstSource.push(1, 11);
+    EXPECT_EQ(1U, poller.poll());
+    EXPECT_EQ(0U, poller.getNumberOfPoolExhaustions());
+
+    // The only buffer is held by the queue
+    EXPECT_EQ(0U, poller.poll());
+    EXPECT_EQ(1U, poller.getNumberOfPoolExhaustions());
+
+    outpost::utils::SharedBufferPointer buffer;
+    ASSERT_TRUE(mFirstQueue.receive(buffer, outpost::time::Duration::zero()));
+    buffer = outpost::utils::SharedBufferPointer();
+    EXPECT_EQ(1U, poller.poll());
+    EXPECT_EQ(2U, mFirst.getNumberOfReceivedDatagrams());
+}
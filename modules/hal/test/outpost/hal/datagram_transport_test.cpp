@@ -13,10 +13,114 @@
 
 #include <outpost/hal/datagram_transport.h>
 
+#include <outpost/utils/container/shared_object_pool.h>
+
 #include <unittest/harness.h>
 
+#include <string.h>
+
+#include <vector>
+
 using outpost::hal::DatagramTransport;
 
+namespace
+{
+/**
+ * Loopback without an own batch implementation, every datagram sent is
+ * received again in the same order.
+ */
+class LoopbackTransport : public DatagramTransport
+{
+public:
+    LoopbackTransport() : mMaximumDatagramsToSend(100)
+    {
+    }
+
+    bool
+    connect() override
+    {
+        return true;
+    }
+
+    void
+    close() override
+    {
+    }
+
+    Address
+    getAddress() const override
+    {
+        return Address();
+    }
+
+    void
+    setAddress(const Address&) override
+    {
+    }
+
+    bool
+    isAvailable() override
+    {
+        return !mDatagrams.empty();
+    }
+
+    size_t
+    getNumberOfBytesAvailable() override
+    {
+        return mDatagrams.empty() ? 0 : mDatagrams.front().size();
+    }
+
+    size_t
+    getMaximumDatagramSize() const override
+    {
+        return 1500;
+    }
+
+    size_t
+    sendTo(outpost::Slice<const uint8_t> data,
+           const Address& address,
+           outpost::time::Duration) override
+    {
+        if (mMaximumDatagramsToSend == 0)
+        {
+            return 0;
+        }
+        mMaximumDatagramsToSend--;
+        mDatagrams.emplace_back(data.begin(), data.end());
+        mAddresses.push_back(address);
+        return data.getNumberOfElements();
+    }
+
+    size_t
+    receiveFrom(outpost::Slice<uint8_t>& data,
+                Address& address,
+                outpost::time::Duration) override
+    {
+        if (mDatagrams.empty())
+        {
+            return 0;
+        }
+        size_t length = std::min(data.getNumberOfElements(), mDatagrams.front().size());
+        memcpy(data.begin(), mDatagrams.front().data(), length);
+        address = mAddresses.front();
+        mDatagrams.erase(mDatagrams.begin());
+        mAddresses.erase(mAddresses.begin());
+        return length;
+    }
+
+    void
+    clearReceiveBuffer() override
+    {
+        mDatagrams.clear();
+        mAddresses.clear();
+    }
+
+    size_t mMaximumDatagramsToSend;
+    std::vector<std::vector<uint8_t>> mDatagrams;
+    std::vector<Address> mAddresses;
+};
+}  // namespace
+
 TEST(DatagramTransportTest, shouldAllowToComposeAddressConstants)
 {
     constexpr DatagramTransport::Address address(DatagramTransport::IpAddress(127, 0, 0, 1), 8080);
@@ -30,3 +134,64 @@ TEST(DatagramTransportTest, shouldAllowToComposeAddressConstants)
         EXPECT_EQ(Ip[i], refIp[i]);
     }
 }
+
+TEST(DatagramTransportTest, shouldSendAndReceiveBatches)
+{
+    LoopbackTransport transport;
+    transport.mMaximumDatagramsToSend = 2;
+
+    const uint8_t first[] = {1, 2, 3};
+    const uint8_t second[] = {4, 5};
+    const uint8_t third[] = {6};
+    const outpost::Slice<const uint8_t> data[] = {
+            outpost::asSlice(first), outpost::asSlice(second), outpost::asSlice(third)};
+    const DatagramTransport::Address destinations[] = {
+            DatagramTransport::Address(DatagramTransport::IpAddress(10, 0, 0, 1), 1),
+            DatagramTransport::Address(DatagramTransport::IpAddress(10, 0, 0, 2), 2),
+            DatagramTransport::Address(DatagramTransport::IpAddress(10, 0, 0, 3), 3)};
+
+    EXPECT_EQ(2U, transport.sendBatchTo(outpost::asSlice(data), outpost::asSlice(destinations)));
+
+    uint8_t buffer0[4];
+    uint8_t buffer1[4];
+    uint8_t buffer2[4];
+    const outpost::Slice<uint8_t> buffers[] = {
+            outpost::asSlice(buffer0), outpost::asSlice(buffer1), outpost::asSlice(buffer2)};
+    size_t lengths[3] = {0, 0, 0};
+    DatagramTransport::Address sources[3];
+    ASSERT_EQ(2U,
+              transport.receiveBatchFrom(outpost::asSlice(buffers),
+                                         outpost::asSlice(lengths),
+                                         outpost::asSlice(sources),
+                                         outpost::time::Duration::zero()));
+    EXPECT_EQ(3U, lengths[0]);
+    EXPECT_EQ(2U, lengths[1]);
+    EXPECT_EQ(3, buffer0[2]);
+    EXPECT_EQ(5, buffer1[1]);
+    EXPECT_EQ(2, sources[1].getPort());
+}
+
+TEST(DatagramTransportTest, shouldReceiveIntoSharedBuffers)
+{
+    LoopbackTransport transport;
+    const uint8_t payload[] = {7, 8, 9};
+    transport.sendTo(outpost::asSlice(payload),
+                     DatagramTransport::Address(DatagramTransport::IpAddress(10, 0, 0, 1), 5),
+                     outpost::time::Duration::zero());
+
+    outpost::utils::SharedBufferPool<8, 2> pool;
+    outpost::utils::SharedBufferPointer buffers[2];
+    ASSERT_TRUE(pool.allocate(buffers[0]));
+    ASSERT_TRUE(pool.allocate(buffers[1]));
+    size_t lengths[2] = {0, 0};
+    DatagramTransport::Address sources[2];
+
+    ASSERT_EQ(1U,
+              transport.receiveBuffersFrom(outpost::asSlice(buffers),
+                                           outpost::asSlice(lengths),
+                                           outpost::asSlice(sources),
+                                           outpost::time::Duration::zero()));
+    EXPECT_EQ(3U, lengths[0]);
+    EXPECT_EQ(9, buffers[0][2]);
+    EXPECT_EQ(5, sources[0].getPort());
+}
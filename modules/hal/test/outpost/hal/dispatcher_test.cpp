@@ -113,6 +113,29 @@ TEST_F(ProtocolDispatcherTest, queueOverfull)
     EXPECT_TRUE(!queue.isEmpty());
 }
 
+TEST_F(ProtocolDispatcherTest, sizeClassPoolAvoidsPartialPackages)
+{
+    const uint8_t ID = 1;
+    outpost::utils::SizeClassSharedBufferPool<4, 2, 8, 1> pool;
+    outpost::utils::SharedBufferQueue<4> queue;
+    buffer.fill(ID);
+
+    EXPECT_TRUE(dispatcher->addQueue(ID, &pool, &queue, true));
+
+    dispatcher->handlePackage(outpost::asSlice(buffer), 3);
+    dispatcher->handlePackage(outpost::asSlice(buffer), 8);
+    dispatcher->handlePackage(outpost::asSlice(buffer), 8);
+    EXPECT_EQ(1u, dispatcher->getNumberOfDroppedPackages());
+    EXPECT_EQ(0u, dispatcher->getNumberOfPartialPackages(&queue));
+
+    outpost::utils::SharedBufferPointer data;
+    ASSERT_TRUE(queue.receive(data));
+    EXPECT_EQ(3u, data.getLength());
+    ASSERT_TRUE(queue.receive(data));
+    EXPECT_EQ(8u, data.getLength());
+    EXPECT_EQ(0u, pool.getLargePool().numberOfFreeElements());
+}
+
 TEST_F(ProtocolDispatcherTest, poolOverfull)
 {
     const uint8_t ID = 1;
@@ -434,3 +457,324 @@ TEST_F(ProtocolDispatcherTest, testCopy)
     EXPECT_ARRAY_EQ(uint8_t, &buffer[0], &data[0], 6);
     EXPECT_EQ(data.getLength(), 6u);
 }
+
+TEST_F(ProtocolDispatcherTest, zeroCopyQueueSharesBuffer)
+{
+    const uint8_t ID = 1;
+    outpost::utils::SharedBufferPool<8, 1> receivePool;
+    outpost::utils::SharedBufferQueue<1> queue;
+
+    EXPECT_TRUE(dispatcher->addQueue(ID, nullptr, &queue));
+
+    outpost::utils::SharedBufferPointer received;
+    ASSERT_TRUE(receivePool.allocate(received));
+    memset(received.asSlice().begin(), ID, 8);
+
+    dispatcher->handlePackage(received, 6);
+    EXPECT_EQ(0u, dispatcher->getNumberOfDroppedPackages());
+    EXPECT_EQ(0u, dispatcher->getNumberOfPartialPackages());
+
+    outpost::utils::SharedBufferPointer data;
+    ASSERT_TRUE(queue.receive(data));
+    EXPECT_EQ(6u, data.getLength());
+    EXPECT_EQ(received.asSlice().begin(), data.asSlice().begin());
+
+    // buffer is only released once the listener is done
+    received = outpost::utils::SharedBufferPointer();
+    EXPECT_EQ(0u, receivePool.numberOfFreeElements());
+    data = outpost::utils::SharedBufferPointer();
+    EXPECT_EQ(1u, receivePool.numberOfFreeElements());
+}
+
+TEST_F(ProtocolDispatcherTest, zeroCopyAndCopyingQueue)
+{
+    const uint8_t ID = 1;
+    outpost::utils::SharedBufferPool<8, 1> receivePool;
+    outpost::utils::SharedBufferPool<8, 1> pool;
+    outpost::utils::SharedBufferQueue<1> sharingQueue;
+    outpost::utils::SharedBufferQueue<1> copyingQueue;
+
+    EXPECT_TRUE(dispatcher->addQueue(ID, nullptr, &sharingQueue));
+    EXPECT_TRUE(dispatcher->addQueue(ID, &pool, &copyingQueue));
+
+    outpost::utils::SharedBufferPointer received;
+    ASSERT_TRUE(receivePool.allocate(received));
+    memset(received.asSlice().begin(), ID, 8);
+
+    dispatcher->handlePackage(received, 8);
+    EXPECT_EQ(0u, dispatcher->getNumberOfDroppedPackages());
+
+    outpost::utils::SharedBufferPointer shared;
+    outpost::utils::SharedBufferPointer copy;
+    ASSERT_TRUE(sharingQueue.receive(shared));
+    ASSERT_TRUE(copyingQueue.receive(copy));
+    EXPECT_EQ(received.asSlice().begin(), shared.asSlice().begin());
+    EXPECT_NE(received.asSlice().begin(), copy.asSlice().begin());
+    EXPECT_EQ(8u, copy.getLength());
+    EXPECT_EQ(ID, copy[7]);
+}
+
+TEST_F(ProtocolDispatcherTest, zeroCopyQueueDropsUnsharedPackages)
+{
+    const uint8_t ID = 1;
+    outpost::utils::SharedBufferQueue<1> queue;
+    buffer.fill(ID);
+
+    EXPECT_TRUE(dispatcher->addQueue(ID, nullptr, &queue));
+
+    dispatcher->handlePackage(outpost::asSlice(buffer), 8);
+    EXPECT_EQ(1u, dispatcher->getNumberOfDroppedPackages());
+    EXPECT_EQ(1u, dispatcher->getNumberOfDroppedPackages(&queue));
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(ProtocolDispatcherSharedDeliveryTest, matchingListenersShareOneCopy)
+{
+    const uint8_t ID = 1;
+    outpost::hal::ProtocolDispatcher<uint8_t, 3> dispatcher(1, true);
+    outpost::utils::SharedBufferPool<8, 3> pool;
+    outpost::utils::SharedBufferQueue<1> queue1;
+    outpost::utils::SharedBufferQueue<1> queue2;
+    outpost::utils::SharedBufferQueue<1> queue3;
+    std::array<uint8_t, 8> buffer;
+    buffer.fill(ID);
+
+    EXPECT_TRUE(dispatcher.addQueue(ID, &pool, &queue1));
+    EXPECT_TRUE(dispatcher.addQueue(ID, &pool, &queue2));
+    EXPECT_TRUE(dispatcher.addQueue(ID, &pool, &queue3));
+
+    dispatcher.handlePackage(outpost::asSlice(buffer), 8);
+    EXPECT_EQ(0u, dispatcher.getNumberOfDroppedPackages());
+    EXPECT_EQ(2u, pool.numberOfFreeElements());
+
+    outpost::utils::SharedBufferPointer data1;
+    outpost::utils::SharedBufferPointer data2;
+    outpost::utils::SharedBufferPointer data3;
+    ASSERT_TRUE(queue1.receive(data1));
+    ASSERT_TRUE(queue2.receive(data2));
+    ASSERT_TRUE(queue3.receive(data3));
+    EXPECT_EQ(data1.asSlice().begin(), data2.asSlice().begin());
+    EXPECT_EQ(data1.asSlice().begin(), data3.asSlice().begin());
+    EXPECT_EQ(ID, data3[7]);
+}
+
+TEST(ProtocolDispatcherSharedDeliveryTest, shortCopyIsNotSharedWithLargerPools)
+{
+    const uint8_t ID = 1;
+    outpost::hal::ProtocolDispatcher<uint8_t, 3> dispatcher(1, true);
+    outpost::utils::SharedBufferPool<4, 2> smallPool;
+    outpost::utils::SharedBufferPool<8, 2> largePool;
+    outpost::utils::SharedBufferQueue<1> smallQueue;
+    outpost::utils::SharedBufferQueue<1> largeQueue1;
+    outpost::utils::SharedBufferQueue<1> largeQueue2;
+    std::array<uint8_t, 8> buffer;
+    buffer.fill(ID);
+
+    EXPECT_TRUE(dispatcher.addQueue(ID, &smallPool, &smallQueue));
+    EXPECT_TRUE(dispatcher.addQueue(ID, &largePool, &largeQueue1));
+    EXPECT_TRUE(dispatcher.addQueue(ID, &largePool, &largeQueue2));
+
+    dispatcher.handlePackage(outpost::asSlice(buffer), 8);
+    EXPECT_EQ(1u, smallPool.numberOfFreeElements());
+    EXPECT_EQ(1u, largePool.numberOfFreeElements());
+
+    outpost::utils::SharedBufferPointer data;
+    ASSERT_TRUE(smallQueue.receive(data));
+    EXPECT_EQ(4u, data.getLength());
+    ASSERT_TRUE(largeQueue1.receive(data));
+    EXPECT_EQ(8u, data.getLength());
+    ASSERT_TRUE(largeQueue2.receive(data));
+    EXPECT_EQ(8u, data.getLength());
+    EXPECT_EQ(1u, dispatcher.getNumberOfPartialPackages(&smallQueue));
+    EXPECT_EQ(0u, dispatcher.getNumberOfPartialPackages(&largeQueue2));
+}
+
+TEST_F(ProtocolDispatcherTest, copyPerListenerByDefault)
+{
+    const uint8_t ID = 1;
+    outpost::utils::SharedBufferPool<8, 2> pool;
+    outpost::utils::SharedBufferQueue<1> queue1;
+    outpost::utils::SharedBufferQueue<1> queue2;
+    buffer.fill(ID);
+
+    EXPECT_TRUE(dispatcher->addQueue(ID, &pool, &queue1));
+    EXPECT_TRUE(dispatcher->addQueue(ID, &pool, &queue2));
+
+    dispatcher->handlePackage(outpost::asSlice(buffer), 8);
+    EXPECT_EQ(0u, pool.numberOfFreeElements());
+}
+
+TEST_F(ProtocolDispatcherTest, matchRuleSelectsBySeveralFields)
+{
+    outpost::utils::SharedBufferPool<8, 4> pool;
+    outpost::utils::SharedBufferQueue<2> subTypeQueue;
+    outpost::utils::SharedBufferQueue<2> defaultQueue;
+
+    // Protocol id 1 at the offset and sub-type 5 in the lower nibble of byte 3
+    EXPECT_TRUE(dispatcher->addQueue(
+            outpost::hal::ProtocolMatchRule().field(offset, 1, 0xFF, 1).field(3, 1, 0x0F, 5),
+            &pool,
+            &subTypeQueue));
+    EXPECT_TRUE(dispatcher->setDefaultQueue(&pool, &defaultQueue));
+
+    buffer.fill(0);
+    buffer[offset] = 1;
+    buffer[3] = 0xA5;
+    dispatcher->handlePackage(outpost::asSlice(buffer), 8);
+    buffer[3] = 0xA6;
+    dispatcher->handlePackage(outpost::asSlice(buffer), 8);
+
+    outpost::utils::SharedBufferPointer data;
+    ASSERT_TRUE(subTypeQueue.receive(data, outpost::time::Duration::zero()));
+    EXPECT_EQ(0xA5, data[3]);
+    EXPECT_TRUE(subTypeQueue.isEmpty());
+    ASSERT_TRUE(defaultQueue.receive(data, outpost::time::Duration::zero()));
+    EXPECT_EQ(0xA6, data[3]);
+    EXPECT_EQ(0u, dispatcher->getNumberOfDroppedPackages());
+}
+
+TEST_F(ProtocolDispatcherTest, matchRulesAndIdsShareOnePass)
+{
+    outpost::utils::SharedBufferPool<8, 4> pool;
+    outpost::utils::SharedBufferQueue<2> idQueue;
+    outpost::utils::SharedBufferQueue<2> apidQueue;
+
+    // 11 bit field across bytes 2 and 3
+    EXPECT_TRUE(dispatcher->addQueue(
+            outpost::hal::ProtocolMatchRule().field(2, 2, 0x07FF, 0x123), &pool, &apidQueue));
+    EXPECT_TRUE(dispatcher->addQueue(1, &pool, &idQueue));
+    EXPECT_FALSE(dispatcher->addQueue(2, &pool, &idQueue));
+
+    buffer.fill(0);
+    buffer[offset] = 1;
+    buffer[2] = 0xF9;
+    buffer[3] = 0x23;
+    dispatcher->handlePackage(outpost::asSlice(buffer), 8);
+
+    EXPECT_FALSE(idQueue.isEmpty());
+    EXPECT_FALSE(apidQueue.isEmpty());
+
+    // Too short for the field
+    dispatcher->handlePackage(outpost::asSlice(buffer).first(3), 3);
+    EXPECT_EQ(1u, apidQueue.getNumberOfItems());
+    EXPECT_EQ(2u, idQueue.getNumberOfItems());
+}
+
+TEST_F(ProtocolDispatcherTest, invalidMatchRulesAreRejected)
+{
+    outpost::utils::SharedBufferQueue<1> queue;
+
+    EXPECT_FALSE(dispatcher->addQueue(outpost::hal::ProtocolMatchRule(), nullptr, &queue));
+    EXPECT_FALSE(dispatcher->addQueue(
+            outpost::hal::ProtocolMatchRule().field(0, 5, 0xFF, 1), nullptr, &queue));
+    EXPECT_FALSE(dispatcher->addQueue(
+            outpost::hal::ProtocolMatchRule().field(0, 1, 0x0F, 0x10), nullptr, &queue));
+    EXPECT_FALSE(dispatcher->addQueue(
+            outpost::hal::ProtocolMatchRule().field(0, 1, 0xFF, 1), nullptr, nullptr));
+
+    outpost::hal::ProtocolMatchRule rule;
+    for (size_t i = 0; i <= outpost::hal::ProtocolMatchRule::maximumNumberOfFields; i++)
+    {
+        rule.field(i, 1, 0xFF, 0);
+    }
+    EXPECT_FALSE(rule.isValid());
+}
+
+TEST_F(ProtocolDispatcherTest, listenerAddedLaterReceivesFollowingPackages)
+{
+    const uint8_t ID = 1;
+    outpost::utils::SharedBufferPool<8, 2> pool;
+    outpost::utils::SharedBufferQueue<2> queue;
+    buffer.fill(ID);
+
+    dispatcher->handlePackage(outpost::asSlice(buffer), 8);
+    EXPECT_EQ(1u, dispatcher->getNumberOfUnmatchedPackages());
+
+    EXPECT_TRUE(dispatcher->addQueue(ID, &pool, &queue));
+    dispatcher->handlePackage(outpost::asSlice(buffer), 8);
+    EXPECT_EQ(1u, queue.getNumberOfItems());
+    EXPECT_EQ(1u, dispatcher->getNumberOfDroppedPackages());
+
+    dispatcher->resetErrorCounters();
+    EXPECT_EQ(0u, dispatcher->getNumberOfUnmatchedPackages());
+    EXPECT_EQ(0u, dispatcher->getNumberOfDroppedPackages());
+}
+
+TEST_F(ProtocolDispatcherTest, shedPackagesBetweenWatermarks)
+{
+    const uint8_t ID = 1;
+    outpost::utils::SharedBufferPool<8, 4> pool;
+    outpost::utils::SharedBufferQueue<4> queue;
+    buffer.fill(ID);
+
+    EXPECT_FALSE(dispatcher->addQueue(
+            ID, &pool, &queue, outpost::hal::ListenerPolicy().watermarks(2, 2)));
+    EXPECT_TRUE(dispatcher->addQueue(
+            ID, &pool, &queue, outpost::hal::ListenerPolicy().watermarks(2, 0)));
+
+    for (int i = 0; i < 3; i++)
+    {
+        dispatcher->handlePackage(outpost::asSlice(buffer), 8);
+    }
+    EXPECT_EQ(2u, queue.getNumberOfItems());
+    EXPECT_EQ(1u, dispatcher->getNumberOfShedPackages(&queue));
+    EXPECT_EQ(1u, dispatcher->getNumberOfDroppedPackages(&queue));
+    // the shed package has not taken a buffer
+    EXPECT_EQ(2u, pool.numberOfFreeElements());
+
+    // shedding continues until the queue is drained to the low watermark
+    outpost::utils::SharedBufferPointer p;
+    EXPECT_TRUE(queue.receive(p));
+    dispatcher->handlePackage(outpost::asSlice(buffer), 8);
+    EXPECT_EQ(2u, dispatcher->getNumberOfShedPackages(&queue));
+
+    EXPECT_TRUE(queue.receive(p));
+    dispatcher->handlePackage(outpost::asSlice(buffer), 8);
+    EXPECT_EQ(1u, queue.getNumberOfItems());
+    EXPECT_EQ(2u, dispatcher->getNumberOfShedPackages(&queue));
+}
+
+TEST_F(ProtocolDispatcherTest, poolReserveKeepsBuffersForCriticalListener)
+{
+    outpost::utils::SharedBufferPool<8, 2> pool;
+    outpost::utils::SharedBufferQueue<4> bulkQueue;
+    outpost::utils::SharedBufferQueue<4> criticalQueue;
+
+    EXPECT_TRUE(dispatcher->addQueue(
+            1, &pool, &bulkQueue, outpost::hal::ListenerPolicy().poolReserve(1)));
+    EXPECT_TRUE(dispatcher->addQueue(2, &pool, &criticalQueue));
+
+    buffer.fill(1);
+    dispatcher->handlePackage(outpost::asSlice(buffer), 8);
+    dispatcher->handlePackage(outpost::asSlice(buffer), 8);
+    EXPECT_EQ(1u, bulkQueue.getNumberOfItems());
+    EXPECT_EQ(1u, dispatcher->getNumberOfDroppedPackages(&bulkQueue));
+    EXPECT_EQ(1u, dispatcher->getNumberOfShedPackages(&bulkQueue));
+
+    buffer.fill(2);
+    dispatcher->handlePackage(outpost::asSlice(buffer), 8);
+    EXPECT_EQ(1u, criticalQueue.getNumberOfItems());
+}
+
+TEST_F(ProtocolDispatcherTest, borrowBufferFromDefaultPool)
+{
+    const uint8_t ID = 1;
+    outpost::utils::SharedBufferPool<8, 1> pool;
+    outpost::utils::SharedBufferPool<8, 1> defaultPool;
+    outpost::utils::SharedBufferQueue<4> queue;
+    outpost::utils::SharedBufferQueue<4> defaultQueue;
+    buffer.fill(ID);
+
+    EXPECT_TRUE(dispatcher->addQueue(
+            ID, &pool, &queue, outpost::hal::ListenerPolicy().borrowFromDefaultPool()));
+    EXPECT_TRUE(dispatcher->setDefaultQueue(&defaultPool, &defaultQueue));
+
+    for (int i = 0; i < 3; i++)
+    {
+        dispatcher->handlePackage(outpost::asSlice(buffer), 8);
+    }
+    EXPECT_EQ(2u, queue.getNumberOfItems());
+    EXPECT_EQ(0u, defaultPool.numberOfFreeElements());
+    EXPECT_EQ(1u, dispatcher->getNumberOfDroppedPackages(&queue));
+    EXPECT_EQ(0u, dispatcher->getNumberOfShedPackages(&queue));
+}
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/hal/nand_packet_store.h>
+#include <outpost/utils/coding/nand_bch_runtime.h>
+
+#include <unittest/hal/nand_flash_stub.h>
+#include <unittest/harness.h>
+
+#include <vector>
+
+using outpost::hal::NandPacketStoreBase;
+using outpost::time::Seconds;
+using outpost::time::SpacecraftElapsedTime;
+
+namespace
+{
+constexpr uint32_t dataSize = 512;
+constexpr uint32_t spareSize = 16;
+constexpr uint32_t pagesPerBlock = 4;
+constexpr uint32_t numberOfBlocks = 4;
+
+// Four packets fit into a page
+constexpr size_t packetLength = 100;
+constexpr size_t packetsPerPage = 4;
+constexpr size_t packetsPerBlock = packetsPerPage * pagesPerBlock;
+
+typedef outpost::utils::NandBCHRTime<outpost::utils::NandBCHInterface::DEF_GALIOS_DIMENISIONS,
+                                     outpost::utils::NandBCHInterface::DEF_ERROR_CORRECTION,
+                                     dataSize,
+                                     spareSize>
+        Bch;
+typedef outpost::hal::NandPacketStore<numberOfBlocks, dataSize, spareSize> Store;
+
+outpost::utils::NandBCHRTimeTables<outpost::utils::NandBCHInterface::DEF_GALIOS_DIMENISIONS,
+                                   outpost::utils::NandBCHInterface::DEF_ERROR_CORRECTION>
+        tables;
+
+struct Packet
+{
+    std::vector<uint8_t> mData;
+    SpacecraftElapsedTime mTime;
+};
+
+class NandPacketStoreTest : public testing::Test
+{
+public:
+    NandPacketStoreTest() :
+        mFlash(dataSize + spareSize, pagesPerBlock, numberOfBlocks),
+        mBch(tables),
+        mStore(mFlash, mBch)
+    {
+    }
+
+    virtual void
+    SetUp() override
+    {
+        ASSERT_TRUE(mStore.mount());
+    }
+
+    virtual void
+    TearDown() override
+    {
+        EXPECT_FALSE(mFlash.mError);
+    }
+
+    static SpacecraftElapsedTime
+    at(int64_t seconds)
+    {
+        return SpacecraftElapsedTime::afterEpoch(Seconds(seconds));
+    }
+
+    /**
+     * Append packets with the times first to first + count - 1 seconds,
+     * the content of every packet is its time.
+     */
+    void
+    appendPackets(int64_t first, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::vector<uint8_t> packet(packetLength, static_cast<uint8_t>(first + i));
+            ASSERT_TRUE(mStore.append(outpost::asSlice(packet), at(first + i)));
+        }
+    }
+
+    std::vector<Packet>
+    retrieve(NandPacketStoreBase& store, int64_t begin, int64_t end)
+    {
+        std::vector<Packet> packets;
+        store.retrieve(at(begin),
+                       at(end),
+                       [&packets](outpost::Slice<const uint8_t> data, SpacecraftElapsedTime time) {
+                           Packet packet;
+                           packet.mData.assign(data.begin(), data.end());
+                           packet.mTime = time;
+                           packets.push_back(packet);
+                           return true;
+                       });
+        return packets;
+    }
+
+    unittest::hal::NandFlashStub mFlash;
+    Bch mBch;
+    Store mStore;
+};
+}  // namespace
+
+TEST_F(NandPacketStoreTest, shouldRejectInvalidGeometry)
+{
+    unittest::hal::NandFlashStub flash(dataSize, pagesPerBlock, numberOfBlocks);
+    Store store(flash, mBch);
+
+    EXPECT_FALSE(store.mount());
+}
+
+TEST_F(NandPacketStoreTest, shouldInitializeEmptyFlash)
+{
+    EXPECT_EQ(numberOfBlocks, mStore.getNumberOfBlocks(NandPacketStoreBase::BlockState::erased));
+    EXPECT_TRUE(retrieve(mStore, 0, 1000).empty());
+}
+
+TEST_F(NandPacketStoreTest, shouldRejectEmptyAndTooLargePackets)
+{
+    std::vector<uint8_t> packet(dataSize);
+
+    EXPECT_FALSE(mStore.append(outpost::asSlice(packet).first(0), at(0)));
+    EXPECT_FALSE(mStore.append(outpost::asSlice(packet), at(0)));
+    EXPECT_TRUE(mStore.append(
+            outpost::asSlice(packet).first(dataSize - NandPacketStoreBase::pageHeaderSize
+                                           - NandPacketStoreBase::recordHeaderSize),
+            at(0)));
+}
+
+TEST_F(NandPacketStoreTest, shouldCombinePacketsIntoPages)
+{
+    appendPackets(0, packetsPerPage);
+    EXPECT_EQ(0U, mFlash.mNumberOfPrograms);
+
+    appendPackets(packetsPerPage, 1);
+    EXPECT_EQ(1U, mFlash.mNumberOfPrograms);
+
+    ASSERT_TRUE(mStore.sync());
+    EXPECT_EQ(2U, mFlash.mNumberOfPrograms);
+
+    std::vector<Packet> packets = retrieve(mStore, 0, 1000);
+    ASSERT_EQ(packetsPerPage + 1, packets.size());
+    for (size_t i = 0; i < packets.size(); ++i)
+    {
+        EXPECT_EQ(at(i), packets[i].mTime);
+        ASSERT_EQ(packetLength, packets[i].mData.size());
+        EXPECT_EQ(i, packets[i].mData[0]);
+        EXPECT_EQ(i, packets[i].mData[packetLength - 1]);
+    }
+}
+
+TEST_F(NandPacketStoreTest, shouldRetrieveTimeRange)
+{
+    appendPackets(0, 2 * packetsPerBlock);
+    ASSERT_TRUE(mStore.sync());
+
+    std::vector<Packet> packets = retrieve(mStore, 18, 22);
+    ASSERT_EQ(5U, packets.size());
+    EXPECT_EQ(at(18), packets.front().mTime);
+    EXPECT_EQ(at(22), packets.back().mTime);
+
+    const NandPacketStoreBase::Block& first = mStore.getBlock(0);
+    EXPECT_EQ(at(0), first.mFirst);
+    EXPECT_EQ(at(packetsPerBlock - 1), first.mLast);
+    EXPECT_EQ(pagesPerBlock, first.mWrittenPages);
+}
+
+TEST_F(NandPacketStoreTest, shouldStopRetrievalOnRequest)
+{
+    appendPackets(0, 10);
+    ASSERT_TRUE(mStore.sync());
+
+    size_t visited = 0;
+    const size_t count = mStore.retrieve(
+            at(0), at(100), [&visited](outpost::Slice<const uint8_t>, SpacecraftElapsedTime) {
+                return ++visited < 3;
+            });
+    EXPECT_EQ(3U, count);
+}
+
+TEST_F(NandPacketStoreTest, shouldRebuildIndexOnMount)
+{
+    appendPackets(0, packetsPerBlock + 2 * packetsPerPage);
+    ASSERT_TRUE(mStore.sync());
+
+    Store store(mFlash, mBch);
+    ASSERT_TRUE(store.mount());
+    EXPECT_EQ(2U, store.getNumberOfBlocks(NandPacketStoreBase::BlockState::used));
+    EXPECT_EQ(2U, store.getBlock(1).mWrittenPages);
+    EXPECT_EQ(at(packetsPerBlock + 2 * packetsPerPage - 1), store.getBlock(1).mLast);
+
+    // New packets are written to a new block after the existing ones
+    std::vector<uint8_t> packet(packetLength, 0xAA);
+    ASSERT_TRUE(store.append(outpost::asSlice(packet), at(1000)));
+    ASSERT_TRUE(store.sync());
+    EXPECT_EQ(2U, store.getBlock(2).mSequence);
+
+    std::vector<Packet> packets = retrieve(store, 0, 2000);
+    ASSERT_EQ(packetsPerBlock + 2 * packetsPerPage + 1, packets.size());
+    EXPECT_EQ(at(1000), packets.back().mTime);
+}
+
+TEST_F(NandPacketStoreTest, shouldCorrectBitErrors)
+{
+    appendPackets(0, packetsPerPage);
+    ASSERT_TRUE(mStore.sync());
+
+    mFlash.getPage(0, 0)[100] ^= 0x10;
+    mFlash.getPage(0, 0)[300] ^= 0x01;
+
+    std::vector<Packet> packets = retrieve(mStore, 0, 100);
+    ASSERT_EQ(packetsPerPage, packets.size());
+    EXPECT_EQ(1U, mStore.getNumberOfCorrectedPages());
+    EXPECT_EQ(2, packets[2].mData[50]);
+}
+
+TEST_F(NandPacketStoreTest, shouldEraseReleasedBlocks)
+{
+    appendPackets(0, 2 * packetsPerBlock);
+    ASSERT_TRUE(mStore.sync());
+
+    EXPECT_EQ(1U, mStore.release(at(packetsPerBlock)));
+    EXPECT_EQ(1U, mStore.getNumberOfBlocks(NandPacketStoreBase::BlockState::obsolete));
+
+    EXPECT_TRUE(mStore.collectGarbage());
+    EXPECT_FALSE(mStore.collectGarbage());
+    EXPECT_EQ(1U, mFlash.mEraseCounts[0]);
+    EXPECT_EQ(NandPacketStoreBase::BlockState::erased, mStore.getBlock(0).mState);
+
+    std::vector<Packet> packets = retrieve(mStore, 0, 1000);
+    ASSERT_EQ(packetsPerBlock, packets.size());
+    EXPECT_EQ(at(packetsPerBlock), packets.front().mTime);
+    EXPECT_EQ(0U, mStore.getNumberOfDiscardedBlocks());
+}
+
+TEST_F(NandPacketStoreTest, shouldDiscardOldestDataIfFull)
+{
+    appendPackets(0, (numberOfBlocks + 1) * packetsPerBlock);
+    ASSERT_TRUE(mStore.sync());
+
+    EXPECT_EQ(1U, mStore.getNumberOfDiscardedBlocks());
+    std::vector<Packet> packets = retrieve(mStore, 0, 1000);
+    ASSERT_EQ(numberOfBlocks * packetsPerBlock, packets.size());
+    EXPECT_EQ(at(packetsPerBlock), packets.front().mTime);
+}
+
+TEST_F(NandPacketStoreTest, shouldKeepReserveAndSpreadWear)
+{
+    mStore.setReserve(1);
+    for (int64_t i = 0; i < 12; ++i)
+    {
+        appendPackets(i * packetsPerBlock, packetsPerBlock);
+        while (mStore.collectGarbage())
+        {
+        }
+        EXPECT_LE(1U, mStore.getNumberOfBlocks(NandPacketStoreBase::BlockState::erased));
+    }
+
+    for (uint32_t block = 0; block < numberOfBlocks; ++block)
+    {
+        EXPECT_LE(2U, mFlash.mEraseCounts[block]);
+        EXPECT_GE(3U, mFlash.mEraseCounts[block]);
+    }
+}
+
+TEST_F(NandPacketStoreTest, shouldRetireBlockAfterProgramFailure)
+{
+    mFlash.mFailingPrograms.insert(0);
+
+    appendPackets(0, 3 * packetsPerPage);
+    ASSERT_TRUE(mStore.sync());
+
+    EXPECT_EQ(NandPacketStoreBase::BlockState::bad, mStore.getBlock(0).mState);
+    EXPECT_EQ(1U, mStore.getNumberOfFailedOperations());
+
+    // The page of the failed operation is lost, the following are stored
+    std::vector<Packet> packets = retrieve(mStore, 0, 1000);
+    ASSERT_EQ(2 * packetsPerPage, packets.size());
+    EXPECT_EQ(at(packetsPerPage), packets.front().mTime);
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/hal/protocol_dispatcher.h>
+#include <outpost/hal/protocol_dispatcher_batch_thread.h>
+
+#include <unittest/harness.h>
+#include <unittest/time/testing_clock.h>
+
+#include <string.h>
+
+#include <array>
+
+namespace
+{
+class PackageSource : public outpost::hal::ReceiverInterface
+{
+public:
+    PackageSource() : mPending(0), mCalls(0)
+    {
+    }
+
+    uint32_t
+    receive(outpost::Slice<uint8_t>& buffer, outpost::time::Duration) override
+    {
+        mCalls++;
+        if (mPending == 0 || buffer.getNumberOfElements() < 4)
+        {
+            return 0;
+        }
+        mPending--;
+        memset(buffer.begin(), 1, 4);
+        return 4;
+    }
+
+    size_t mPending;
+    size_t mCalls;
+};
+}  // namespace
+
+class ProtocolDispatcherBatchThreadTest : public testing::Test
+{
+public:
+    ProtocolDispatcherBatchThreadTest() :
+        dispatcher(1),
+        thread(dispatcher,
+               source,
+               pool,
+               outpost::asSlice(buffers),
+               outpost::asSlice(lengths),
+               clock,
+               0,
+               0,
+               nullptr,
+               outpost::support::parameter::HeartbeatSource::default0,
+               outpost::time::Seconds(1))
+    {
+        dispatcher.addQueue(1, nullptr, &queue);
+    }
+
+    PackageSource source;
+    outpost::hal::ProtocolDispatcher<uint8_t, 1> dispatcher;
+    outpost::utils::SharedBufferPool<8, 6> pool;
+    outpost::utils::SharedBufferQueue<8> queue;
+    std::array<outpost::utils::SharedBufferPointer, 3> buffers;
+    std::array<uint32_t, 3> lengths;
+    unittest::time::TestingClock clock;
+    outpost::hal::ProtocolDispatcherBatchThread thread;
+};
+
+TEST_F(ProtocolDispatcherBatchThreadTest, drainsUpToBatchSize)
+{
+    source.mPending = 5;
+
+    EXPECT_EQ(3u, thread.step());
+    EXPECT_EQ(3u, source.mCalls);
+    EXPECT_EQ(3u, queue.getNumberOfItems());
+
+    EXPECT_EQ(2u, thread.step());
+    EXPECT_EQ(5u, queue.getNumberOfItems());
+    EXPECT_EQ(0u, dispatcher.getNumberOfDroppedPackages());
+}
+
+TEST_F(ProtocolDispatcherBatchThreadTest, unusedBuffersAreKept)
+{
+    source.mPending = 1;
+
+    EXPECT_EQ(1u, thread.step());
+    // one buffer in the queue, two kept for the next batch
+    EXPECT_EQ(3u, pool.numberOfFreeElements());
+
+    // only the dispatched buffer is replaced
+    EXPECT_EQ(0u, thread.step());
+    EXPECT_EQ(2u, pool.numberOfFreeElements());
+    EXPECT_EQ(0u, thread.step());
+    EXPECT_EQ(2u, pool.numberOfFreeElements());
+}
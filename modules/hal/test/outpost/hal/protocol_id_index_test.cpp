@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/hal/protocol_id_index.h>
+
+#include <unittest/harness.h>
+
+#include <vector>
+
+template <typename T>
+class ProtocolIdIndexTest : public testing::Test
+{
+public:
+    std::vector<uint32_t>
+    lookup(T id)
+    {
+        std::vector<uint32_t> result;
+        for (uint32_t i = index.first(id); i != index.end(); i = index.next(id, i))
+        {
+            result.push_back(i);
+        }
+        return result;
+    }
+
+    outpost::hal::ProtocolIdIndex<T, 4> index;
+};
+
+typedef testing::Types<uint8_t, uint16_t> IdTypes;
+TYPED_TEST_CASE(ProtocolIdIndexTest, IdTypes);
+
+TYPED_TEST(ProtocolIdIndexTest, emptyIndexFindsNothing)
+{
+    EXPECT_TRUE(this->lookup(0).empty());
+    EXPECT_TRUE(this->lookup(255).empty());
+}
+
+TYPED_TEST(ProtocolIdIndexTest, listenersAreVisitedInInsertionOrder)
+{
+    this->index.add(7, 0);
+    this->index.add(3, 1);
+    this->index.add(7, 2);
+    this->index.add(255, 3);
+
+    EXPECT_EQ(std::vector<uint32_t>({0, 2}), this->lookup(7));
+    EXPECT_EQ(std::vector<uint32_t>({1}), this->lookup(3));
+    EXPECT_EQ(std::vector<uint32_t>({3}), this->lookup(255));
+    EXPECT_TRUE(this->lookup(4).empty());
+}
+
+TYPED_TEST(ProtocolIdIndexTest, skippedListenersAreNotFound)
+{
+    // Listeners 0 and 2 have match rules instead of an id
+    this->index.add(0, 1);
+    this->index.add(0, 3);
+
+    EXPECT_EQ(std::vector<uint32_t>({1, 3}), this->lookup(0));
+}
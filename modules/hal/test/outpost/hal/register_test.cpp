@@ -94,3 +94,51 @@ TEST(RegisterTest, shouldCastToPointer)
             TestRegister::General::address + 4 * sizeof(uint32_t));
     EXPECT_EQ(expected, output);
 }
+
+TEST(RegisterTest, shouldCalculateMaskAndValueOfBitfields)
+{
+    EXPECT_EQ(0xFF000000U, Register::getMask<TestRegister::General::Prescaler>());
+    EXPECT_EQ(0x00010000U, Register::getMask<TestRegister::General::Enable>());
+    EXPECT_EQ(0xFFFFFFFFU, Register::getMask<TestRegister::General::All>());
+
+    EXPECT_EQ(0x64000000U, Register::getValue<TestRegister::General::Prescaler>(100));
+    EXPECT_EQ(0x00010000U, Register::getValue<TestRegister::General::Enable>(3));
+}
+
+TEST(RegisterTest, shouldModifyMultipleFieldsInMemory)
+{
+    uint32_t value = 0xFFFFFFFF;
+    Register::modifyMemory<TestRegister::General::Prescaler,
+                           TestRegister::General::Enable,
+                           TestRegister::General::DecoderEnable>(value, 100, 0, 0);
+    EXPECT_EQ(0x64FEFFFEU, value);
+
+    if (false)
+    {
+        Register::modify<TestRegister::General::Prescaler, TestRegister::General::Enable>(100, 1);
+        Register::modify<TestRegister::General::All>(0);
+    }
+}
+
+TEST(RegisterTest, shouldCollectFieldsInBatch)
+{
+    Register::Batch<uint32_t, TestRegister::General::address> batch;
+    EXPECT_EQ(0U, batch.getMask());
+
+    batch.set<TestRegister::General::Prescaler>(0xFF).set<TestRegister::General::Bypass>(1);
+
+    // a later value replaces the earlier one
+    batch.set<TestRegister::General::Prescaler>(100);
+    EXPECT_EQ(0xFF000010U, batch.getMask());
+    EXPECT_EQ(0x64000010U, batch.getValue());
+
+    uint32_t value = 0x00000001;
+    batch.applyTo(value);
+    EXPECT_EQ(0x64000011U, value);
+
+    if (false)
+    {
+        batch.apply();
+        batch.overwrite();
+    }
+}
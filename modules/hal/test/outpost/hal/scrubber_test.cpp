@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/hal/scrubber.h>
+#include <outpost/utils/coding/nand_bch_runtime.h>
+
+#include <unittest/hal/nand_flash_stub.h>
+#include <unittest/harness.h>
+#include <unittest/time/testing_clock.h>
+
+#include <vector>
+
+using namespace outpost::hal;
+using outpost::time::Milliseconds;
+
+namespace
+{
+constexpr uint32_t dataSize = 512;
+constexpr uint32_t spareSize = 16;
+constexpr uint32_t pageSize = dataSize + spareSize;
+
+typedef outpost::utils::NandBCHRTime<outpost::utils::NandBCHInterface::DEF_GALIOS_DIMENISIONS,
+                                     outpost::utils::NandBCHInterface::DEF_ERROR_CORRECTION,
+                                     dataSize,
+                                     spareSize>
+        Bch;
+
+outpost::utils::NandBCHRTimeTables<outpost::utils::NandBCHInterface::DEF_GALIOS_DIMENISIONS,
+                                   outpost::utils::NandBCHInterface::DEF_ERROR_CORRECTION>
+        tables;
+
+/// Advances the clock with every chunk
+class CountingRegion : public ScrubRegion
+{
+public:
+    CountingRegion(size_t numberOfChunks, unittest::time::TestingClock* clock) :
+        mNumberOfChunks(numberOfChunks),
+        mClock(clock)
+    {
+    }
+
+    virtual size_t
+    getNumberOfChunks() const override
+    {
+        return mNumberOfChunks;
+    }
+
+    virtual ScrubResult
+    scrubChunk(size_t chunk) override
+    {
+        mChunks.push_back(chunk);
+        if (mClock != nullptr)
+        {
+            mClock->incrementBy(Milliseconds(1));
+        }
+        return ScrubResult::clean;
+    }
+
+    size_t mNumberOfChunks;
+    unittest::time::TestingClock* mClock;
+    std::vector<size_t> mChunks;
+};
+
+class Listener : public NandScrubListener
+{
+public:
+    virtual void
+    onPageError(uint32_t block, uint32_t page, ScrubResult result) override
+    {
+        mBlock = block;
+        mPage = page;
+        mResult = result;
+        mCalls++;
+    }
+
+    uint32_t mBlock = 0;
+    uint32_t mPage = 0;
+    ScrubResult mResult = ScrubResult::clean;
+    uint32_t mCalls = 0;
+};
+}  // namespace
+
+class ScrubberTest : public testing::Test
+{
+public:
+    ScrubberTest() : mBch(tables), mData(dataSize), mWorkspace(pageSize + dataSize)
+    {
+        for (size_t i = 0; i < mData.size(); ++i)
+        {
+            mData[i] = static_cast<uint8_t>(i * 7);
+        }
+    }
+
+    Bch mBch;
+    std::vector<uint8_t> mData;
+    std::vector<uint8_t> mWorkspace;
+    unittest::time::TestingClock mClock;
+};
+
+TEST_F(ScrubberTest, shouldKeepContentOfEdacRegion)
+{
+    uint32_t memory[10];
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        memory[i] = i * 0x01010101;
+    }
+
+    EdacScrubRegion region(outpost::asSlice(memory), 4);
+    ASSERT_EQ(3U, region.getNumberOfChunks());
+    for (size_t i = 0; i < region.getNumberOfChunks(); ++i)
+    {
+        EXPECT_EQ(ScrubResult::clean, region.scrubChunk(i));
+    }
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(i * 0x01010101, memory[i]);
+    }
+}
+
+TEST_F(ScrubberTest, shouldRewriteCorrectedBchPages)
+{
+    std::vector<uint8_t> pages(2 * pageSize, 0xFF);
+    ASSERT_TRUE(mBch.encode(outpost::asSlice(mData), outpost::asSlice(pages).first(pageSize)));
+    const std::vector<uint8_t> original = pages;
+
+    pages[10] ^= 0x04;
+    pages[300] ^= 0x80;
+
+    BchScrubRegion region(mBch, outpost::asSlice(pages), outpost::asSlice(mWorkspace));
+    ASSERT_EQ(2U, region.getNumberOfChunks());
+    EXPECT_EQ(ScrubResult::corrected, region.scrubChunk(0));
+    EXPECT_EQ(original, pages);
+
+    EXPECT_EQ(ScrubResult::clean, region.scrubChunk(0));
+
+    // Erased page
+    EXPECT_EQ(ScrubResult::clean, region.scrubChunk(1));
+}
+
+TEST_F(ScrubberTest, shouldReportNandPagesWithErrors)
+{
+    unittest::hal::NandFlashStub flash(pageSize, 4, 2);
+    std::vector<uint8_t> coded(pageSize);
+    ASSERT_TRUE(mBch.encode(outpost::asSlice(mData), outpost::asSlice(coded)));
+    ASSERT_EQ(NandFlash::Result::success,
+              flash.startProgramPage(1, 2, outpost::asSlice(coded)));
+    ASSERT_EQ(NandFlash::Result::success, flash.waitForCompletion(Milliseconds(10)));
+    flash.getPage(1, 2)[100] ^= 0x01;
+
+    Listener listener;
+    NandScrubRegion region(flash, mBch, 1, 1, outpost::asSlice(mWorkspace), listener);
+    ASSERT_EQ(4U, region.getNumberOfChunks());
+
+    EXPECT_EQ(ScrubResult::clean, region.scrubChunk(0));
+    EXPECT_EQ(0U, listener.mCalls);
+
+    EXPECT_EQ(ScrubResult::corrected, region.scrubChunk(2));
+    EXPECT_EQ(1U, listener.mCalls);
+    EXPECT_EQ(1U, listener.mBlock);
+    EXPECT_EQ(2U, listener.mPage);
+    EXPECT_EQ(ScrubResult::corrected, listener.mResult);
+    EXPECT_FALSE(flash.mError);
+}
+
+TEST_F(ScrubberTest, shouldLimitChunksPerPeriod)
+{
+    CountingRegion first(3, nullptr);
+    CountingRegion second(2, nullptr);
+    Scrubber scrubber(mClock, Milliseconds(100), 4, Milliseconds(10), 0);
+    scrubber.addRegion(first);
+    scrubber.addRegion(second);
+
+    // Scrubbing starts with the region added first
+    EXPECT_EQ(4U, scrubber.scrubPeriod());
+    EXPECT_EQ(3U, first.mChunks.size());
+    EXPECT_EQ(1U, second.mChunks.size());
+    EXPECT_EQ(1U, first.getNumberOfPasses());
+    EXPECT_EQ(0U, second.getNumberOfPasses());
+
+    // Continues with the rest of the second region and wraps around
+    EXPECT_EQ(4U, scrubber.scrubPeriod());
+    const std::vector<size_t> expected = {0, 1};
+    EXPECT_EQ(expected, second.mChunks);
+    EXPECT_EQ(6U, first.mChunks.size());
+    EXPECT_EQ(2U, first.getNumberOfPasses());
+    EXPECT_EQ(1U, second.getNumberOfPasses());
+    EXPECT_EQ(6U, first.getNumberOfScrubbedChunks());
+    EXPECT_EQ(0U, scrubber.getNumberOfExhaustedBudgets());
+}
+
+TEST_F(ScrubberTest, shouldStopWhenBudgetIsUsedUp)
+{
+    CountingRegion region(100, &mClock);
+    Scrubber scrubber(mClock, Milliseconds(100), 10, Milliseconds(2), 0);
+    scrubber.addRegion(region);
+
+    EXPECT_EQ(2U, scrubber.scrubPeriod());
+    EXPECT_EQ(1U, scrubber.getNumberOfExhaustedBudgets());
+}
+
+TEST_F(ScrubberTest, shouldSkipEmptyRegions)
+{
+    CountingRegion first(0, nullptr);
+    CountingRegion second(0, nullptr);
+    Scrubber scrubber(mClock, Milliseconds(100), 4, Milliseconds(10), 0);
+    EXPECT_EQ(0U, scrubber.scrubPeriod());
+
+    scrubber.addRegion(first);
+    scrubber.addRegion(second);
+    EXPECT_EQ(0U, scrubber.scrubPeriod());
+
+    second.mNumberOfChunks = 1;
+    EXPECT_EQ(4U, scrubber.scrubPeriod());
+    EXPECT_EQ(4U, second.getNumberOfPasses());
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/hal/serial_cobs_receiver.h>
+
+#include <unittest/hal/serial_stub.h>
+#include <unittest/harness.h>
+#include <unittest/time/testing_clock.h>
+
+#include <vector>
+
+namespace
+{
+/// Receives one byte every 10 ms
+class SlowSerial : public unittest::hal::SerialStub
+{
+public:
+    explicit SlowSerial(unittest::time::TestingClock& clock) :
+        mClock(clock),
+        mNextByte(clock.now() + outpost::time::Milliseconds(10))
+    {
+    }
+
+    size_t
+    read(outpost::Slice<uint8_t> data, outpost::time::Duration timeout) override
+    {
+        mTimeouts.push_back(timeout);
+        const outpost::time::Duration wait = mNextByte - mClock.now();
+        if (wait > timeout)
+        {
+            mClock.incrementBy(timeout);
+            return 0;
+        }
+        if (wait > outpost::time::Duration::zero())
+        {
+            mClock.incrementBy(wait);
+        }
+        mNextByte = mClock.now() + outpost::time::Milliseconds(10);
+        return SerialStub::read(data.first(1), timeout);
+    }
+
+    unittest::time::TestingClock& mClock;
+    outpost::time::SpacecraftElapsedTime mNextByte;
+    std::vector<outpost::time::Duration> mTimeouts;
+};
+}  // namespace
+
+class SerialCobsReceiverTest : public testing::Test
+{
+public:
+    SerialCobsReceiverTest() : mReceiver(mSerial, mClock, outpost::asSlice(mReadBuffer))
+    {
+    }
+
+    void
+    addFrame(std::vector<uint8_t> frame)
+    {
+        uint8_t encoded[32];
+        size_t length = outpost::utils::Cobs::encode(outpost::asSlice(frame),
+                                                     outpost::asSlice(encoded));
+        mSerial.mDataToReceive.insert(mSerial.mDataToReceive.end(), encoded, encoded + length);
+        mSerial.mDataToReceive.push_back(0);
+    }
+
+    unittest::hal::SerialStub mSerial;
+    unittest::time::TestingClock mClock;
+    uint8_t mReadBuffer[5];
+    outpost::hal::SerialCobsReceiver mReceiver;
+};
+
+TEST_F(SerialCobsReceiverTest, shouldDecodeFramesSpanningSeveralReads)
+{
+    addFrame({1, 0, 2, 3, 0, 4, 5, 6});
+    addFrame({7, 8});
+
+    uint8_t data[16];
+    outpost::Slice<uint8_t> buffer = outpost::asSlice(data);
+    ASSERT_EQ(8U, mReceiver.receive(buffer, outpost::time::Duration::zero()));
+    EXPECT_EQ(std::vector<uint8_t>({1, 0, 2, 3, 0, 4, 5, 6}), std::vector<uint8_t>(data, data + 8));
+
+    ASSERT_EQ(2U, mReceiver.receive(buffer, outpost::time::Duration::zero()));
+    EXPECT_EQ(7, data[0]);
+    EXPECT_EQ(8, data[1]);
+
+    EXPECT_EQ(0U, mReceiver.receive(buffer, outpost::time::Duration::zero()));
+}
+
+TEST_F(SerialCobsReceiverTest, shouldDiscardFramesExceedingTheBuffer)
+{
+    addFrame({1, 2, 3, 4, 5, 6});
+    addFrame({9});
+
+    uint8_t data[4];
+    outpost::Slice<uint8_t> buffer = outpost::asSlice(data);
+    ASSERT_EQ(1U, mReceiver.receive(buffer, outpost::time::Duration::zero()));
+    EXPECT_EQ(9, data[0]);
+    EXPECT_EQ(1U, mReceiver.getNumberOfErrors());
+}
+
+TEST_F(SerialCobsReceiverTest, shouldContinuePartialFrameInSameBuffer)
+{
+    addFrame({1, 2, 3, 4, 5, 6, 7});
+    std::vector<uint8_t> rest(mSerial.mDataToReceive.begin() + 5, mSerial.mDataToReceive.end());
+    mSerial.mDataToReceive.resize(5);
+
+    uint8_t data[16];
+    outpost::Slice<uint8_t> buffer = outpost::asSlice(data);
+    EXPECT_EQ(0U, mReceiver.receive(buffer, outpost::time::Duration::zero()));
+
+    mSerial.mDataToReceive = rest;
+    ASSERT_EQ(7U, mReceiver.receive(buffer, outpost::time::Duration::zero()));
+    EXPECT_EQ(7, data[6]);
+}
+
+TEST_F(SerialCobsReceiverTest, shouldShareTimeoutBetweenReads)
+{
+    SlowSerial serial(mClock);
+    outpost::hal::SerialCobsReceiver receiver(serial, mClock, outpost::asSlice(mReadBuffer));
+
+    // Frame of 9 bytes, 10 bytes encoded plus the delimiter
+    uint8_t encoded[16];
+    const uint8_t frame[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    size_t length = outpost::utils::Cobs::encode(outpost::asSlice(frame),
+                                                 outpost::asSlice(encoded));
+    serial.mDataToReceive.assign(encoded, encoded + length);
+    serial.mDataToReceive.push_back(0);
+
+    uint8_t data[16];
+    outpost::Slice<uint8_t> buffer = outpost::asSlice(data);
+    EXPECT_EQ(0U, receiver.receive(buffer, outpost::time::Milliseconds(35)));
+
+    // Three bytes are received, the fourth one is not reached anymore
+    EXPECT_EQ(std::vector<outpost::time::Duration>({outpost::time::Milliseconds(35),
+                                                    outpost::time::Milliseconds(25),
+                                                    outpost::time::Milliseconds(15),
+                                                    outpost::time::Milliseconds(5)}),
+              serial.mTimeouts);
+
+    // The frame is continued with the next call
+    EXPECT_EQ(9U, receiver.receive(buffer, outpost::time::Duration::infinity()));
+    EXPECT_EQ(9, data[8]);
+}
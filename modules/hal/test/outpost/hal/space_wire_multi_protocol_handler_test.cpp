@@ -18,6 +18,30 @@
 #include <unittest/hal/spacewire_stub.h>
 #include <unittest/harness.h>
 
+#include <vector>
+
+namespace
+{
+class TimeoutRecordingSpaceWire : public unittest::hal::SpaceWireStub
+{
+public:
+    explicit TimeoutRecordingSpaceWire(size_t maximumLength) :
+        SpaceWireStub(maximumLength),
+        mSendTimeout(outpost::time::Duration::zero())
+    {
+    }
+
+    virtual Result::Type
+    send(TransmitBuffer* buffer, outpost::time::Duration timeout) override
+    {
+        mSendTimeout = timeout;
+        return SpaceWireStub::send(buffer, timeout);
+    }
+
+    outpost::time::Duration mSendTimeout;
+};
+}  // namespace
+
 TEST(SpaceWireMultiProtocolHandlerTest, construct)
 {
     char name[] = "test";
@@ -28,3 +52,155 @@ TEST(SpaceWireMultiProtocolHandlerTest, construct)
     outpost::hal::SpaceWireMultiProtocolHandlerInterface& ref = spwmp;
     (void) ref;
 }
+
+TEST(SpaceWireMultiProtocolHandlerTest, shouldSendRequestedBuffer)
+{
+    char name[] = "test";
+    outpost::rtos::SystemClock clock;
+    unittest::hal::SpaceWireStub spw(16);
+    outpost::hal::SpaceWireMultiProtocolHandler<2> spwmp(
+            spw, 1, 1024, name, outpost::support::parameter::HeartbeatSource::default0, clock);
+    spw.open();
+    spw.up(outpost::time::Duration::zero());
+
+    outpost::hal::SpaceWire::TransmitBuffer* buffer = nullptr;
+    ASSERT_TRUE(spwmp.requestBuffer(buffer));
+    ASSERT_EQ(16U, buffer->getLength());
+
+    // construct the packet in place
+    buffer->getData()[0] = 0x12;
+    buffer->getData()[1] = 0x34;
+    buffer->setLength(2);
+    buffer->setEndMarker(outpost::hal::SpaceWire::eop);
+    EXPECT_TRUE(spwmp.send(buffer));
+
+    ASSERT_EQ(1U, spw.mSentPackets.size());
+    EXPECT_EQ(std::vector<uint8_t>({0x12, 0x34}), spw.mSentPackets.front().data);
+}
+
+TEST(SpaceWireMultiProtocolHandlerTest, shouldSendCommittedPacket)
+{
+    char name[] = "test";
+    outpost::rtos::SystemClock clock;
+    unittest::hal::SpaceWireStub spw(16);
+    outpost::hal::SpaceWireMultiProtocolHandler<2> spwmp(
+            spw, 1, 1024, name, outpost::support::parameter::HeartbeatSource::default0, clock);
+    spw.open();
+    spw.up(outpost::time::Duration::zero());
+
+    outpost::hal::SpaceWire::TransmitBuffer* buffer = nullptr;
+    outpost::Slice<uint8_t> packet = outpost::Slice<uint8_t>::empty();
+    ASSERT_TRUE(spwmp.reserve(buffer, packet));
+    ASSERT_EQ(16U, packet.getNumberOfElements());
+
+    packet[0] = 0xAB;
+    packet[1] = 0xCD;
+    packet[2] = 0xEF;
+    EXPECT_TRUE(spwmp.commit(buffer, 3));
+
+    ASSERT_EQ(1U, spw.mSentPackets.size());
+    EXPECT_EQ(std::vector<uint8_t>({0xAB, 0xCD, 0xEF}), spw.mSentPackets.front().data);
+    EXPECT_EQ(outpost::hal::SpaceWire::eop, spw.mSentPackets.front().end);
+}
+
+TEST(SpaceWireMultiProtocolHandlerTest, shouldDiscardAbortedAndOversizedPackets)
+{
+    char name[] = "test";
+    outpost::rtos::SystemClock clock;
+    unittest::hal::SpaceWireStub spw(16);
+    outpost::hal::SpaceWireMultiProtocolHandler<2> spwmp(
+            spw, 1, 1024, name, outpost::support::parameter::HeartbeatSource::default0, clock);
+    spw.open();
+    spw.up(outpost::time::Duration::zero());
+
+    outpost::hal::SpaceWire::TransmitBuffer* buffer = nullptr;
+    outpost::Slice<uint8_t> packet = outpost::Slice<uint8_t>::empty();
+    ASSERT_TRUE(spwmp.reserve(buffer, packet));
+    spwmp.abort(buffer);
+
+    ASSERT_TRUE(spwmp.reserve(buffer, packet));
+    EXPECT_FALSE(spwmp.commit(buffer, 17));
+
+    // Both buffers are returned as empty packets with an error end marker
+    ASSERT_EQ(2U, spw.mSentPackets.size());
+    for (auto& sent : spw.mSentPackets)
+    {
+        EXPECT_TRUE(sent.data.empty());
+        EXPECT_EQ(outpost::hal::SpaceWire::eep, sent.end);
+    }
+}
+
+TEST(SpaceWireMultiProtocolHandlerTest, shouldReturnBufferOfOversizedPacket)
+{
+    char name[] = "test";
+    outpost::rtos::SystemClock clock;
+    unittest::hal::SpaceWireStub spw(4);
+    outpost::hal::SpaceWireMultiProtocolHandler<2> spwmp(
+            spw, 1, 1024, name, outpost::support::parameter::HeartbeatSource::default0, clock);
+    spw.open();
+    spw.up(outpost::time::Duration::zero());
+
+    const uint8_t data[] = {1, 2, 3, 4, 5};
+    EXPECT_FALSE(spwmp.send(outpost::asSlice(data)));
+    EXPECT_TRUE(spw.noUsedTransmitBuffers());
+
+    ASSERT_EQ(1U, spw.mSentPackets.size());
+    EXPECT_TRUE(spw.mSentPackets.front().data.empty());
+    EXPECT_EQ(outpost::hal::SpaceWire::eep, spw.mSentPackets.front().end);
+}
+
+TEST(SpaceWireMultiProtocolHandlerTest, shouldKeepLongTimeouts)
+{
+    char name[] = "test";
+    outpost::rtos::SystemClock clock;
+    TimeoutRecordingSpaceWire spw(16);
+    outpost::hal::SpaceWireMultiProtocolHandler<2> spwmp(
+            spw, 1, 1024, name, outpost::support::parameter::HeartbeatSource::default0, clock);
+    spw.open();
+    spw.up(outpost::time::Duration::zero());
+
+    const uint8_t data[] = {1, 2, 3};
+    EXPECT_TRUE(spwmp.send(outpost::asSlice(data), outpost::time::Hours(2)));
+    EXPECT_GT(spw.mSendTimeout, outpost::time::Hours(1));
+    EXPECT_LE(spw.mSendTimeout, outpost::time::Hours(2));
+
+    EXPECT_TRUE(spwmp.send(outpost::asSlice(data), outpost::time::Seconds(10)));
+    EXPECT_GT(spw.mSendTimeout, outpost::time::Seconds(9));
+    EXPECT_LE(spw.mSendTimeout, outpost::time::Seconds(10));
+}
+
+TEST(SpaceWireMultiProtocolHandlerTest, shouldGatherFragmentsIntoOnePacket)
+{
+    char name[] = "test";
+    outpost::rtos::SystemClock clock;
+    unittest::hal::SpaceWireStub spw(6);
+    outpost::hal::SpaceWireMultiProtocolHandler<2> spwmp(
+            spw, 1, 1024, name, outpost::support::parameter::HeartbeatSource::default0, clock);
+    spw.open();
+    spw.up(outpost::time::Duration::zero());
+
+    const uint8_t path[] = {0x05};
+    const uint8_t header[] = {0xFE, 0x01};
+    const uint8_t payload[] = {0x10, 0x20};
+    const uint8_t crc[] = {0x99};
+    const outpost::Slice<const uint8_t> fragments[] = {
+            outpost::asSlice(path),
+            outpost::asSlice(header),
+            outpost::Slice<const uint8_t>::empty(),
+            outpost::asSlice(payload),
+            outpost::asSlice(crc)};
+    EXPECT_TRUE(spwmp.sendFragments(outpost::asSlice(fragments)));
+
+    // One fragment too many for the maximum packet length
+    const outpost::Slice<const uint8_t> tooLong[] = {
+            outpost::asSlice(header), outpost::asSlice(payload), outpost::asSlice(header),
+            outpost::asSlice(path)};
+    EXPECT_FALSE(spwmp.sendFragments(outpost::asSlice(tooLong)));
+
+    ASSERT_EQ(2U, spw.mSentPackets.size());
+    EXPECT_EQ(std::vector<uint8_t>({0x05, 0xFE, 0x01, 0x10, 0x20, 0x99}),
+              spw.mSentPackets.front().data);
+    EXPECT_EQ(outpost::hal::SpaceWire::eop, spw.mSentPackets.front().end);
+    EXPECT_TRUE(spw.mSentPackets.back().data.empty());
+    EXPECT_EQ(outpost::hal::SpaceWire::eep, spw.mSentPackets.back().end);
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/hal/spacewire_loaning_receiver.h>
+
+#include <outpost/rtos/thread.h>
+
+#include <unittest/hal/spacewire_stub.h>
+#include <unittest/harness.h>
+
+using outpost::hal::SpaceWire;
+
+namespace
+{
+/// Drops a loaned packet after a short time
+class LoanReturner : public outpost::rtos::Thread
+{
+public:
+    explicit LoanReturner(outpost::utils::SharedBufferPointer& packet) :
+        Thread(0, defaultStackSize, "LOAN"),
+        mPacket(packet)
+    {
+    }
+
+protected:
+    virtual void
+    run() override
+    {
+        sleep(outpost::time::Milliseconds(10));
+        mPacket = outpost::utils::SharedBufferPointer();
+
+        // Returning from a thread is fatal, wait for the destructor
+        while (true)
+        {
+            sleep(outpost::time::Seconds(1));
+        }
+    }
+
+private:
+    outpost::utils::SharedBufferPointer& mPacket;
+};
+}  // namespace
+
+class SpaceWireLoaningReceiverTest : public testing::Test
+{
+public:
+    SpaceWireLoaningReceiverTest() : mSpaceWire(100), mReceiver(mSpaceWire)
+    {
+    }
+
+    virtual void
+    SetUp() override
+    {
+        mSpaceWire.open();
+        mSpaceWire.up(outpost::time::Duration::zero());
+    }
+
+    void
+    addPacket(uint8_t value)
+    {
+        mSpaceWire.mPacketsToReceive.emplace_back(
+                unittest::hal::SpaceWireStub::Packet{{value, value, value}, SpaceWire::eop});
+    }
+
+    unittest::hal::SpaceWireStub mSpaceWire;
+    outpost::hal::SpaceWireLoaningReceiver<2> mReceiver;
+};
+
+TEST_F(SpaceWireLoaningReceiverTest, shouldReleaseDriverBufferWithLastReference)
+{
+    addPacket(7);
+
+    outpost::utils::SharedBufferPointer packet;
+    ASSERT_EQ(3U, mReceiver.receiveLoaned(packet, outpost::time::Duration::zero()));
+    EXPECT_EQ(3U, packet.getLength());
+    EXPECT_EQ(7, packet[2]);
+    EXPECT_EQ(1U, mReceiver.numberOfFreeElements());
+
+    outpost::utils::SharedChildPointer child;
+    ASSERT_TRUE(packet.getChild(child, 0, 1, 2));
+    packet = outpost::utils::SharedBufferPointer();
+    EXPECT_FALSE(mSpaceWire.noUsedReceiveBuffers());
+
+    child = outpost::utils::SharedChildPointer();
+    EXPECT_TRUE(mSpaceWire.noUsedReceiveBuffers());
+    EXPECT_EQ(2U, mReceiver.numberOfFreeElements());
+}
+
+TEST_F(SpaceWireLoaningReceiverTest, shouldRejectWhenAllLoansAreInUse)
+{
+    addPacket(1);
+    addPacket(2);
+    addPacket(3);
+
+    outpost::utils::SharedBufferPointer first;
+    outpost::utils::SharedBufferPointer second;
+    outpost::utils::SharedBufferPointer third;
+    EXPECT_EQ(3U, mReceiver.receiveLoaned(first, outpost::time::Duration::zero()));
+    EXPECT_EQ(3U, mReceiver.receiveLoaned(second, outpost::time::Duration::zero()));
+    EXPECT_EQ(0U, mReceiver.receiveLoaned(third, outpost::time::Duration::zero()));
+    EXPECT_EQ(1U, mReceiver.getNumberOfFailedAllocations());
+
+    first = outpost::utils::SharedBufferPointer();
+    ASSERT_EQ(3U, mReceiver.receiveLoaned(third, outpost::time::Duration::zero()));
+    EXPECT_EQ(3, third[0]);
+    EXPECT_EQ(2, second[0]);
+}
+
+TEST_F(SpaceWireLoaningReceiverTest, shouldWaitForReturnedLoan)
+{
+    addPacket(1);
+    addPacket(2);
+    addPacket(3);
+
+    outpost::utils::SharedBufferPointer first;
+    outpost::utils::SharedBufferPointer second;
+    outpost::utils::SharedBufferPointer third;
+    ASSERT_EQ(3U, mReceiver.receiveLoaned(first, outpost::time::Duration::zero()));
+    ASSERT_EQ(3U, mReceiver.receiveLoaned(second, outpost::time::Duration::zero()));
+
+    LoanReturner returner(first);
+    returner.start();
+    ASSERT_EQ(3U, mReceiver.receiveLoaned(third, outpost::time::Seconds(10)));
+    EXPECT_EQ(3, third[0]);
+    EXPECT_EQ(0U, mReceiver.getNumberOfFailedAllocations());
+}
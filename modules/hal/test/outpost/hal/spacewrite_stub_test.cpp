@@ -109,6 +109,39 @@ TEST_F(SpaceWireStubTest, shouldReleaseTransmitBuffer)
     EXPECT_TRUE(mSpaceWire.noUsedTransmitBuffers());
 }
 
+TEST_F(SpaceWireStubTest, shouldTransmitBatchAndNotify)
+{
+    outpost::rtos::EventGroup events;
+    mSpaceWire.setTransmitNotification(&events, 0x10);
+
+    SpaceWire::TransmitBuffer* buffers[3] = {nullptr, nullptr, nullptr};
+    ASSERT_EQ(3U,
+              mSpaceWire.requestBuffers(outpost::asSlice(buffers),
+                                        outpost::time::Duration::zero()));
+    for (uint8_t i = 0; i < 3; ++i)
+    {
+        buffers[i]->getData()[0] = i;
+        buffers[i]->setLength(1);
+        buffers[i]->setEndMarker(SpaceWire::eop);
+    }
+
+    SpaceWire::TransmitBuffer* const* submitted = buffers;
+    EXPECT_EQ(3U,
+              mSpaceWire.sendBatch(outpost::Slice<SpaceWire::TransmitBuffer* const>::unsafe(
+                                           submitted, 3),
+                                   outpost::time::Duration::zero()));
+    EXPECT_TRUE(mSpaceWire.noUsedTransmitBuffers());
+    EXPECT_EQ(0x10U, events.waitAny(0x10, outpost::time::Duration::zero()));
+
+    ASSERT_EQ(3U, mSpaceWire.mSentPackets.size());
+    uint8_t expected = 0;
+    for (auto& packet : mSpaceWire.mSentPackets)
+    {
+        EXPECT_EQ(std::vector<uint8_t>({expected}), packet.data);
+        expected++;
+    }
+}
+
 TEST_F(SpaceWireStubTest, shouldTransmitData)
 {
     std::vector<uint8_t> expectedData = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xAB, 0xCD};
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/hal/timecode_correlation.h>
+#include <outpost/rtos/thread.h>
+
+#include <unittest/harness.h>
+#include <unittest/time/testing_clock.h>
+
+using namespace outpost::time;
+using outpost::hal::TimeCode;
+using outpost::hal::TimeCodeCorrelation;
+
+class TimeCodeCorrelationTest : public testing::Test
+{
+public:
+    TimeCodeCorrelationTest() : mCorrelation(Seconds(1), Milliseconds(5))
+    {
+    }
+
+    void
+    sendTimeCode(uint8_t value, int64_t localMicroseconds)
+    {
+        TimeCode timeCode;
+        timeCode.mValue = value & 0x3F;
+        timeCode.mControl = 0;
+        mCorrelation.onTimeCode(timeCode, local(localMicroseconds));
+    }
+
+    static SpacecraftElapsedTime
+    local(int64_t microseconds)
+    {
+        return SpacecraftElapsedTime::afterEpoch(Microseconds(microseconds));
+    }
+
+    int64_t
+    toOnboard(int64_t localMicroseconds)
+    {
+        SpacecraftElapsedTime onboard;
+        EXPECT_TRUE(mCorrelation.toOnboardTime(local(localMicroseconds), onboard));
+        return onboard.timeSinceEpoch().microseconds();
+    }
+
+    TimeCodeCorrelation mCorrelation;
+};
+
+TEST_F(TimeCodeCorrelationTest, shouldNotConvertBeforeFirstTimeCode)
+{
+    SpacecraftElapsedTime onboard;
+    EXPECT_FALSE(mCorrelation.isSynchronized());
+    EXPECT_FALSE(mCorrelation.toOnboardTime(local(1000), onboard));
+}
+
+TEST_F(TimeCodeCorrelationTest, shouldConvertRelativeToFirstTimeCode)
+{
+    mCorrelation.setOffset(Seconds(1000));
+    sendTimeCode(5, 100000000);
+
+    EXPECT_TRUE(mCorrelation.isSynchronized());
+    EXPECT_EQ(1005500000, toOnboard(100500000));
+    EXPECT_EQ(1004000000, toOnboard(99000000));
+}
+
+TEST_F(TimeCodeCorrelationTest, shouldCompensateDriftOfLocalClock)
+{
+    // The local clock is 100 ppm slow, the timecodes wrap in between
+    const int64_t localPeriod = 999900;
+    for (int64_t i = 0; i <= 40; ++i)
+    {
+        sendTimeCode(static_cast<uint8_t>(50 + i), 1000000000 + i * localPeriod);
+    }
+
+    EXPECT_NEAR(100010, mCorrelation.getDriftInPartsPerBillion(), 10);
+    EXPECT_EQ(0U, mCorrelation.getNumberOfResynchronizations());
+
+    const int64_t last = 1000000000 + 40 * localPeriod;
+    EXPECT_EQ(90000000, toOnboard(last));
+    EXPECT_NEAR(90500000, toOnboard(last + localPeriod / 2), 1);
+}
+
+TEST_F(TimeCodeCorrelationTest, shouldUnwrapLostTimeCodes)
+{
+    sendTimeCode(10, 0);
+    sendTimeCode(11, 1000000);
+
+    // 70 timecodes are lost, more than the range of the timecode values
+    sendTimeCode(11 + 71, 72000000);
+
+    EXPECT_EQ(0U, mCorrelation.getNumberOfResynchronizations());
+    EXPECT_EQ(82000000, toOnboard(72000000));
+}
+
+TEST_F(TimeCodeCorrelationTest, shouldResynchronizeOnUnexpectedTimeCode)
+{
+    sendTimeCode(10, 0);
+    sendTimeCode(11, 1000000);
+
+    // Timecode source restarted with a different phase
+    sendTimeCode(0, 1500000);
+
+    EXPECT_EQ(1U, mCorrelation.getNumberOfResynchronizations());
+    EXPECT_EQ(100000, toOnboard(1600000));
+}
+
+TEST(TimeCodeCorrelationServiceTest, shouldCorrelateDispatchedTimeCodes)
+{
+    unittest::time::TestingClock clock;
+    outpost::hal::TimeCodeDispatcher<1> dispatcher;
+    outpost::hal::TimeCodeCorrelationService service(clock, Seconds(1), Milliseconds(5), 0);
+    ASSERT_TRUE(service.start(dispatcher));
+
+    clock.setTime(SpacecraftElapsedTime::afterEpoch(Seconds(10)));
+    TimeCode timeCode;
+    timeCode.mValue = 3;
+    timeCode.mControl = 0;
+    dispatcher.dispatchTimeCode(timeCode);
+
+    for (int i = 0; i < 100 && !service.getCorrelation().isSynchronized(); ++i)
+    {
+        outpost::rtos::Thread::sleep(Milliseconds(10));
+    }
+
+    SpacecraftElapsedTime onboard;
+    ASSERT_TRUE(service.getCorrelation().toOnboardTime(clock.now(), onboard));
+    EXPECT_EQ(Seconds(3), onboard.timeSinceEpoch());
+
+    // Only one listener fits into the dispatcher
+    outpost::hal::TimeCodeCorrelationService second(clock, Seconds(1), Milliseconds(5), 0);
+    EXPECT_FALSE(second.start(dispatcher));
+}
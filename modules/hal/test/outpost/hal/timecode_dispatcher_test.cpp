@@ -25,7 +25,7 @@ operator==(const outpost::hal::TimeCode& a, const outpost::hal::TimeCode& b)
 
 TEST(TimeCodeDispatcherTest, dispatchWithoutQueue)
 {
-    outpost::hal::TimeCode tc;
+    outpost::hal::TimeCode tc = outpost::hal::TimeCode();
     outpost::hal::TimeCodeDispatcher<2> tcd;
     tcd.dispatchTimeCode(tc);
 }
@@ -89,3 +89,92 @@ TEST(TimeCodeDispatcherTest, tooManyQueues)
     EXPECT_TRUE(tcd.addListener(&queue));
     EXPECT_FALSE(tcd.addListener(&queue));
 }
+
+TEST(TimeCodeDispatcherTest, dispatchSpscQueue)
+{
+    outpost::hal::TimeCode tc;
+
+    tc.mControl = 1;
+    tc.mValue = 14;
+
+    outpost::hal::TimeCodeDispatcher<2> tcd;
+    outpost::rtos::Queue<outpost::hal::TimeCode> queue(2);
+    outpost::hal::TimeCode storage[2];
+    outpost::utils::SpscQueue<outpost::hal::TimeCode> spscQueue(outpost::asSlice(storage));
+
+    EXPECT_TRUE(tcd.addListener(&queue));
+    EXPECT_TRUE(tcd.addListener(&spscQueue));
+    EXPECT_FALSE(tcd.addListener(&spscQueue));
+    tcd.dispatchTimeCode(tc);
+
+    outpost::hal::TimeCode tmp;
+    tmp.mControl = 0;
+    tmp.mValue = 0;
+    EXPECT_TRUE(spscQueue.receive(tmp, outpost::time::Duration::zero()));
+    EXPECT_TRUE(tc == tmp);
+    EXPECT_TRUE(queue.receive(tmp, outpost::time::Seconds(1)));
+    EXPECT_TRUE(tc == tmp);
+}
+
+TEST(TimeCodeDispatcherTest, latestTimeCodeIsAvailableWithoutListener)
+{
+    outpost::hal::TimeCodeDispatcher<1> tcd;
+    outpost::hal::TimeCode tmp;
+    uint16_t sequence;
+    EXPECT_FALSE(tcd.getLatestTimeCode().read(tmp, sequence));
+
+    outpost::hal::TimeCode tc;
+    tc.mControl = 2;
+    tc.mValue = 63;
+    tcd.dispatchTimeCode(tc);
+
+    tmp.mControl = 0;
+    tmp.mValue = 0;
+    EXPECT_TRUE(tcd.getLatestTimeCode().read(tmp, sequence));
+    EXPECT_TRUE(tc == tmp);
+    EXPECT_EQ(1U, sequence);
+}
+
+TEST(TimeCodeDispatcherTest, mailboxDetectsRepeatedTimeCode)
+{
+    outpost::hal::TimeCodeMailbox mailbox;
+    outpost::hal::TimeCode tc;
+    tc.mControl = 0;
+    tc.mValue = 5;
+
+    uint16_t lastSequence = 0;
+    outpost::hal::TimeCode tmp;
+    EXPECT_FALSE(mailbox.readIfNew(tmp, lastSequence));
+
+    mailbox.publish(tc);
+    EXPECT_TRUE(mailbox.readIfNew(tmp, lastSequence));
+    EXPECT_TRUE(tc == tmp);
+    EXPECT_FALSE(mailbox.readIfNew(tmp, lastSequence));
+
+    // the same value again is a new timecode
+    mailbox.publish(tc);
+    EXPECT_TRUE(mailbox.readIfNew(tmp, lastSequence));
+    EXPECT_EQ(2U, lastSequence);
+}
+
+TEST(TimeCodeDispatcherTest, mailboxSequenceSkipsZeroOnWrapAround)
+{
+    outpost::hal::TimeCodeMailbox mailbox;
+    outpost::hal::TimeCode tc;
+    tc.mControl = 1;
+    tc.mValue = 7;
+
+    for (uint32_t i = 0; i < 0xFFFF; i++)
+    {
+        mailbox.publish(tc);
+    }
+    EXPECT_EQ(0xFFFFU, mailbox.getSequence());
+
+    mailbox.publish(tc);
+    EXPECT_EQ(1U, mailbox.getSequence());
+
+    outpost::hal::TimeCode tmp;
+    uint16_t sequence;
+    EXPECT_TRUE(mailbox.read(tmp, sequence));
+    EXPECT_TRUE(tc == tmp);
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "nand_flash_stub.h"
+
+#include <string.h>
+
+using unittest::hal::NandFlashStub;
+
+NandFlashStub::NandFlashStub(uint32_t pageSize, uint32_t pagesPerBlock, uint32_t numberOfBlocks) :
+    mFailingPrograms(),
+    mFailingErases(),
+    mError(false),
+    mNumberOfPrograms(0),
+    mEraseCounts(numberOfBlocks, 0),
+    mPageSize(pageSize),
+    mPagesPerBlock(pagesPerBlock),
+    mNumberOfBlocks(numberOfBlocks),
+    mProgramPending(false),
+    mProgramResult(Result::success),
+    mMemory(pageSize * pagesPerBlock * numberOfBlocks, 0xFF)
+{
+}
+
+uint32_t
+NandFlashStub::getPageSize() const
+{
+    return mPageSize;
+}
+
+uint32_t
+NandFlashStub::getPagesPerBlock() const
+{
+    return mPagesPerBlock;
+}
+
+uint32_t
+NandFlashStub::getNumberOfBlocks() const
+{
+    return mNumberOfBlocks;
+}
+
+NandFlashStub::Result::Type
+NandFlashStub::readPage(uint32_t block, uint32_t page, outpost::Slice<uint8_t> data)
+{
+    if (mProgramPending)
+    {
+        mError = true;
+    }
+    if (!isValid(block, page) || (data.getNumberOfElements() < mPageSize))
+    {
+        return Result::invalidAddress;
+    }
+    memcpy(&data[0], getPage(block, page), mPageSize);
+    return Result::success;
+}
+
+NandFlashStub::Result::Type
+NandFlashStub::startProgramPage(uint32_t block, uint32_t page, outpost::Slice<const uint8_t> data)
+{
+    if (mProgramPending)
+    {
+        mError = true;
+    }
+    if (!isValid(block, page) || (data.getNumberOfElements() != mPageSize))
+    {
+        return Result::invalidAddress;
+    }
+
+    uint8_t* content = getPage(block, page);
+    for (uint32_t i = 0; i < mPageSize; ++i)
+    {
+        if (content[i] != 0xFF)
+        {
+            mError = true;
+        }
+    }
+
+    mNumberOfPrograms++;
+    mProgramPending = true;
+    if (mFailingPrograms.count(block) > 0)
+    {
+        mProgramResult = Result::failure;
+    }
+    else
+    {
+        memcpy(content, &data[0], mPageSize);
+        mProgramResult = Result::success;
+    }
+    return Result::success;
+}
+
+NandFlashStub::Result::Type
+NandFlashStub::waitForCompletion(outpost::time::Duration /*timeout*/)
+{
+    const Result::Type result = mProgramPending ? mProgramResult : Result::success;
+    mProgramPending = false;
+    return result;
+}
+
+NandFlashStub::Result::Type
+NandFlashStub::eraseBlock(uint32_t block)
+{
+    if (mProgramPending)
+    {
+        mError = true;
+    }
+    if (!isValid(block, 0))
+    {
+        return Result::invalidAddress;
+    }
+    if (mFailingErases.count(block) > 0)
+    {
+        return Result::failure;
+    }
+    mEraseCounts[block]++;
+    memset(getPage(block, 0), 0xFF, mPageSize * mPagesPerBlock);
+    return Result::success;
+}
+
+uint8_t*
+NandFlashStub::getPage(uint32_t block, uint32_t page)
+{
+    return &mMemory[(block * mPagesPerBlock + page) * mPageSize];
+}
+
+bool
+NandFlashStub::isValid(uint32_t block, uint32_t page) const
+{
+    return (block < mNumberOfBlocks) && (page < mPagesPerBlock);
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef UNITTEST_HAL_NAND_FLASH_STUB_H
+#define UNITTEST_HAL_NAND_FLASH_STUB_H
+
+#include <outpost/hal/nand_flash.h>
+
+#include <set>
+#include <vector>
+
+namespace unittest
+{
+namespace hal
+{
+/**
+ * NAND flash in memory.
+ *
+ * Checks that only erased pages are programmed and that a program
+ * operation is finished before the next operation starts. Program and
+ * erase operations can be made to fail for selected blocks.
+ */
+class NandFlashStub : public outpost::hal::NandFlash
+{
+public:
+    NandFlashStub(uint32_t pageSize, uint32_t pagesPerBlock, uint32_t numberOfBlocks);
+
+    virtual ~NandFlashStub() = default;
+
+    virtual uint32_t
+    getPageSize() const override;
+
+    virtual uint32_t
+    getPagesPerBlock() const override;
+
+    virtual uint32_t
+    getNumberOfBlocks() const override;
+
+    virtual Result::Type
+    readPage(uint32_t block, uint32_t page, outpost::Slice<uint8_t> data) override;
+
+    virtual Result::Type
+    startProgramPage(uint32_t block, uint32_t page, outpost::Slice<const uint8_t> data) override;
+
+    virtual Result::Type
+    waitForCompletion(outpost::time::Duration timeout) override;
+
+    virtual Result::Type
+    eraseBlock(uint32_t block) override;
+
+    /**
+     * Content of a page.
+     */
+    uint8_t*
+    getPage(uint32_t block, uint32_t page);
+
+    /// Blocks whose program operations fail
+    std::set<uint32_t> mFailingPrograms;
+
+    /// Blocks whose erase operations fail
+    std::set<uint32_t> mFailingErases;
+
+    /// Set if an operation violated the rules of the flash
+    bool mError;
+
+    uint32_t mNumberOfPrograms;
+    std::vector<uint32_t> mEraseCounts;
+
+private:
+    bool
+    isValid(uint32_t block, uint32_t page) const;
+
+    const uint32_t mPageSize;
+    const uint32_t mPagesPerBlock;
+    const uint32_t mNumberOfBlocks;
+    bool mProgramPending;
+    Result::Type mProgramResult;
+    std::vector<uint8_t> mMemory;
+};
+
+}  // namespace hal
+}  // namespace unittest
+
+#endif
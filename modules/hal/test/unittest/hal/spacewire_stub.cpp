@@ -19,7 +19,10 @@ using unittest::hal::SpaceWireStub;
 SpaceWireStub::SpaceWireStub(size_t maximumLength) :
     mMaximumLength(maximumLength),
     mOpen(false),
-    mUp(false)
+    mUp(false),
+    mPeer(nullptr),
+    mReceiveWaiting(false),
+    mPacketsAvailable(0)
 {
 }
 
@@ -87,20 +90,30 @@ SpaceWireStub::send(TransmitBuffer* buffer, outpost::time::Duration /*timeout*/)
     Result::Type result = Result::success;
     if (mUp)
     {
+        Packet packet;
         try
         {
             outpost::rtos::MutexGuard lock(mOperationLock);
             std::unique_ptr<TransmitBufferEntry>& entry = mTransmitBuffers.at(buffer);
-            mSentPackets.emplace_back(
-                    Packet{std::vector<uint8_t>(&entry->buffer.front(),
-                                                &entry->buffer.front() + entry->header.getLength()),
-                           entry->header.getEndMarker()});
+            const uint8_t* data = &entry->buffer.front();
+            packet.data.assign(data, data + entry->header.getLength());
+            packet.end = entry->header.getEndMarker();
             mTransmitBuffers.erase(buffer);
+            if (mPeer == nullptr)
+            {
+                mSentPackets.emplace_back(std::move(packet));
+            }
         }
         catch (std::out_of_range&)
         {
             result = Result::failure;
         }
+
+        // Outside of the lock, the peer may send to this stub at the same time
+        if ((result == Result::success) && (mPeer != nullptr))
+        {
+            mPeer->addPacketToReceive(std::move(packet.data), packet.end);
+        }
     }
     else
     {
@@ -111,10 +124,20 @@ SpaceWireStub::send(TransmitBuffer* buffer, outpost::time::Duration /*timeout*/)
 }
 
 SpaceWireStub::Result::Type
-SpaceWireStub::receive(ReceiveBuffer& buffer, outpost::time::Duration /*timeout*/)
+SpaceWireStub::receive(ReceiveBuffer& buffer, outpost::time::Duration timeout)
 {
+    if (mReceiveWaiting && mUp && !mPacketsAvailable.acquire(timeout))
+    {
+        return Result::timeout;
+    }
+
     Result::Type result = Result::success;
-    if (mUp)
+    outpost::rtos::MutexGuard lock(mOperationLock);
+    if (mUp && mPacketsToReceive.empty())
+    {
+        result = Result::timeout;
+    }
+    else if (mUp)
     {
         std::unique_ptr<ReceiveBufferEntry> entry(new ReceiveBufferEntry(
                 std::move(mPacketsToReceive.front().data), mPacketsToReceive.front().end));
@@ -133,9 +156,31 @@ SpaceWireStub::receive(ReceiveBuffer& buffer, outpost::time::Duration /*timeout*
 void
 SpaceWireStub::releaseBuffer(const ReceiveBuffer& buffer)
 {
+    outpost::rtos::MutexGuard lock(mOperationLock);
     mReceiveBuffers.erase(buffer.getData().begin());
 }
 
+void
+SpaceWireStub::addPacketToReceive(std::vector<uint8_t> data, EndMarker end)
+{
+    outpost::rtos::MutexGuard lock(mOperationLock);
+    mPacketsToReceive.emplace_back(Packet{std::move(data), end});
+    mPacketsAvailable.release();
+}
+
+void
+SpaceWireStub::connect(SpaceWireStub& peer)
+{
+    outpost::rtos::MutexGuard lock(mOperationLock);
+    mPeer = &peer;
+}
+
+void
+SpaceWireStub::setReceiveWaiting(bool enabled)
+{
+    mReceiveWaiting = enabled;
+}
+
 void
 SpaceWireStub::flushReceiveBuffer()
 {
@@ -145,6 +190,6 @@ SpaceWireStub::flushReceiveBuffer()
 void
 SpaceWireStub::triggerSpWInterrupt(void)
 {
-    outpost::hal::TimeCode tc;
+    outpost::hal::TimeCode tc = outpost::hal::TimeCode();
     mTCD.dispatchTimeCode(tc);
 }
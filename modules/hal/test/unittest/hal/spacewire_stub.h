@@ -125,10 +125,42 @@ public:
     /**
      * Packets which can be received through the receive() function.
      *
-     * Fill with data before starting the operation.
+     * Fill with data before starting the operation, or use
+     * addPacketToReceive() while another thread is receiving. receive()
+     * returns a timeout if no packet is available.
      */
     std::list<Packet> mPacketsToReceive;
 
+    /**
+     * Add a packet to mPacketsToReceive, thread-safe against receive().
+     *
+     * Used to inject packets while a ProtocolDispatcherThread is
+     * running, e.g. by a l3test::script::LoadGenerator.
+     */
+    void
+    addPacketToReceive(std::vector<uint8_t> data, EndMarker end = eop);
+
+    /**
+     * Deliver all packets sent through this stub to \p peer instead of
+     * storing them in mSentPackets.
+     *
+     * Two connected stubs form a link, e.g. between an RMAP initiator and
+     * an RMAP target running in the same process.
+     */
+    void
+    connect(SpaceWireStub& peer);
+
+    /**
+     * Let receive() wait up to its timeout for a packet instead of
+     * returning a timeout immediately.
+     *
+     * Avoids a busy ProtocolDispatcherThread if packets are only added
+     * with addPacketToReceive() or by a connected stub. Must be enabled
+     * before the first packet is added.
+     */
+    void
+    setReceiveWaiting(bool enabled);
+
     /*
      * Simulates an SpWInterrupt
      */
@@ -173,6 +205,12 @@ private:
     std::map<TransmitBuffer*, std::unique_ptr<TransmitBufferEntry>> mTransmitBuffers;
     std::map<const uint8_t*, std::unique_ptr<ReceiveBufferEntry>> mReceiveBuffers;
     outpost::rtos::Mutex mOperationLock;
+
+    SpaceWireStub* mPeer;
+    bool mReceiveWaiting;
+
+    /// Released for every packet added by addPacketToReceive()
+    outpost::rtos::Semaphore mPacketsAvailable;
 };
 
 }  // namespace hal
@@ -13,6 +13,8 @@
 
 #include "bitstream.h"
 
+#include "../buffer/buffer.h"
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -82,26 +84,24 @@ l_bitstream_new(lua_State* L)
             (*b)->values[i] = 0;
         }
     }
-    else if (type == LUA_TSTRING)
+    else if ((type == LUA_TSTRING) || (l3test_buffer_test(L, 1) != nullptr))
     {
-        const char* s = luaL_checkstring(L, 1);
-        int string_length = luaL_len(L, 1);
+        outpost::Slice<const uint8_t> bytes = l3test_buffer_checkbytes(L, 1);
+        int string_length = bytes.getNumberOfElements();
 
         size_t nbytes = sizeof(Bitstream) - sizeof(uint8_t) + string_length;
 
         Bitstream** b = (Bitstream **) lua_newuserdata(L, sizeof(Bitstream *));
         *b = (Bitstream *) malloc(nbytes);
 
-        // Initialize content to zero
         (*b)->size = string_length * 8;
-        for (int i = 0; i < string_length; ++i)
-        {
-            (*b)->values[i] = s[i];
-        }
+        memcpy((*b)->values, bytes.begin(), string_length);
     }
     else
     {
-        luaL_argcheck(L, false, 1, "Invalid type, expected string with values or number of bits to store");
+        luaL_argcheck(L, false, 1,
+                      "Invalid type, expected string or buffer with values or number of bits "
+                      "to store");
     }
 
 
@@ -270,7 +270,7 @@ concat(lua_State* L, Bitstream** own)
     Bitstream* field = 0;
 
     int type = lua_type(L, 2);
-    if (type == LUA_TUSERDATA)
+    if ((type == LUA_TUSERDATA) && (l3test_buffer_test(L, 2) == nullptr))
     {
         Bitstream** other = (Bitstream **) luaL_checkudata(L, 2, "dlr.bitstream");
 
@@ -293,7 +293,7 @@ concat(lua_State* L, Bitstream** own)
             set_bit(field->values, i + offset, get_bit((*other)->values, i));
         }
     }
-    else if (type == LUA_TSTRING)
+    else if ((type == LUA_TSTRING) || (type == LUA_TUSERDATA))
     {
         div_t d = div((*own)->size, 8);
         if (d.rem != 0)
@@ -301,8 +301,9 @@ concat(lua_State* L, Bitstream** own)
             luaL_error(L, "bitstream size (here: %d) must be divisible by 8", (*own)->size);
         }
 
-        const char* s = luaL_checkstring(L, 2);
-        int string_length = luaL_len(L, 2);
+        outpost::Slice<const uint8_t> bytes = l3test_buffer_checkbytes(L, 2);
+        const uint8_t* s = bytes.begin();
+        int string_length = bytes.getNumberOfElements();
 
         int old_size = sizeof(Bitstream) - sizeof(uint8_t) + d.quot;
         int new_size = old_size + string_length;
@@ -581,6 +582,28 @@ l_bitstream_to_string(lua_State* L)
 	return 1;
 }
 
+/**
+ * Copy the content into a new buffer.
+ *
+ * Works only for bitstreams whose size is divisible by eight.
+ */
+static int
+l_bitstream_to_buffer(lua_State* L)
+{
+	Bitstream** b = (Bitstream **) luaL_checkudata(L, 1, "dlr.bitstream");
+
+	div_t d = div((*b)->size, 8);
+	if (d.rem != 0)
+	{
+		luaL_error(L, "bitstream size (here: %d) must be divisible by 8", (*b)->size);
+	}
+
+	outpost::Slice<uint8_t> buffer = l3test_buffer_push(L, d.quot);
+	memcpy(buffer.begin(), (*b)->values, d.quot);
+
+	return 1;
+}
+
 // ----------------------------------------------------------------------------
 static int
 l_bitstream_gc(lua_State* L)
@@ -613,6 +636,7 @@ static const struct luaL_Reg arraylib_m[] = {
 	{ "to_hex", l_bitstream_to_hex },
 	{ "to_string", l_bitstream_to_string },
 	{ "bytes", l_bitstream_bytes },
+	{ "buffer", l_bitstream_to_buffer },
 
 	// TODO why doesn't this work?
 	//{ "__newindex", l_bitstream_set },
@@ -630,6 +654,8 @@ extern "C"
 int
 luaopen_bitstream(lua_State* L)
 {
+	l3test_buffer_open(L);
+
 	luaL_newmetatable(L, "dlr.bitstream");
 
 	// metatable.__index = metatable
@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef LUA_BUFFER_BUFFER_H
+#define LUA_BUFFER_BUFFER_H
+
+#include <outpost/base/slice.h>
+
+#include <lua.hpp>
+
+#include <new>
+#include <string.h>
+
+/**
+ * Mutable byte buffer shared by the bitstream, cobs, crc16 and l3test
+ * modules.
+ *
+ * Lua strings are immutable, every transformation of a string creates a
+ * new copy. A buffer is created once and then written, checksummed and
+ * encoded in place. Views created with `buffer:view(start, end)` refer to
+ * the memory of the original buffer without copying it and keep the
+ * original buffer alive.
+ *
+ *   local b = buffer.new(16)       -- 16 zero bytes, or buffer.new("...")
+ *   b:write(1, "\x01\x02")
+ *   local header = b:view(1, 2)
+ *   header:set(1, 0xff)            -- changes b as well
+ *
+ * The modules are separate shared libraries and each one contains a copy
+ * of these functions. The metatable is registered only by the first module
+ * loaded, all others reuse it.
+ */
+struct LuaBuffer
+{
+    /// Memory of the buffer, either owned or a view into another buffer
+    outpost::Slice<uint8_t> data;
+};
+
+static const char* const luaBufferMetatable = "dlr.buffer";
+
+/**
+ * Get the buffer at the given stack index or nullptr if the value is
+ * not a buffer.
+ */
+static inline LuaBuffer*
+l3test_buffer_test(lua_State* L, int index)
+{
+    return reinterpret_cast<LuaBuffer*>(luaL_testudata(L, index, luaBufferMetatable));
+}
+
+static inline LuaBuffer*
+l3test_buffer_check(lua_State* L, int index)
+{
+    return reinterpret_cast<LuaBuffer*>(luaL_checkudata(L, index, luaBufferMetatable));
+}
+
+/**
+ * Push a new zero-initialized buffer with the given length.
+ *
+ * The memory is part of the userdata object and managed by the Lua
+ * garbage collector.
+ */
+static inline outpost::Slice<uint8_t>
+l3test_buffer_push(lua_State* L, size_t length)
+{
+    void* memory = lua_newuserdata(L, sizeof(LuaBuffer) + length);
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(memory) + sizeof(LuaBuffer);
+    memset(bytes, 0, length);
+
+    LuaBuffer* buffer =
+            new (memory) LuaBuffer{outpost::Slice<uint8_t>::unsafe(bytes, length)};
+
+    luaL_setmetatable(L, luaBufferMetatable);
+    return buffer->data;
+}
+
+/**
+ * Push a view of the buffer at the stack index \p parent.
+ *
+ * The view keeps the parent alive through its user value.
+ */
+static inline void
+l3test_buffer_push_view(lua_State* L, int parent, outpost::Slice<uint8_t> data)
+{
+    parent = lua_absindex(L, parent);
+
+    void* memory = lua_newuserdata(L, sizeof(LuaBuffer));
+    new (memory) LuaBuffer{data};
+
+    luaL_setmetatable(L, luaBufferMetatable);
+    lua_pushvalue(L, parent);
+    lua_setuservalue(L, -2);
+}
+
+/**
+ * Get the bytes of a string or a buffer without copying them.
+ *
+ * Raises a Lua error for all other types.
+ */
+static inline outpost::Slice<const uint8_t>
+l3test_buffer_checkbytes(lua_State* L, int index)
+{
+    LuaBuffer* buffer = l3test_buffer_test(L, index);
+    if (buffer != nullptr)
+    {
+        return buffer->data;
+    }
+
+    if (lua_type(L, index) != LUA_TSTRING)
+    {
+        luaL_argerror(L, index, "expected a string or a buffer");
+    }
+
+    size_t length;
+    const char* str = lua_tolstring(L, index, &length);
+    return outpost::Slice<const uint8_t>::unsafe(reinterpret_cast<const uint8_t*>(str), length);
+}
+
+/**
+ * Converts the optional `start` and `end` arguments (1-based, inclusive,
+ * negative values count from the end) into an offset and a length.
+ */
+static inline void
+l3test_buffer_range(lua_State* L, int index, size_t length, size_t& offset, size_t& count)
+{
+    lua_Integer start = luaL_optinteger(L, index, 1);
+    lua_Integer end = luaL_optinteger(L, index + 1, -1);
+    lua_Integer size = static_cast<lua_Integer>(length);
+
+    if (start < 0)
+    {
+        start = size + start + 1;
+    }
+    if (end < 0)
+    {
+        end = size + end + 1;
+    }
+    luaL_argcheck(L, (start >= 1) && (start <= size + 1), index, "start out of range");
+    luaL_argcheck(L, (end >= start - 1) && (end <= size), index + 1, "end out of range");
+
+    offset = static_cast<size_t>(start - 1);
+    count = static_cast<size_t>(end - start + 1);
+}
+
+// ----------------------------------------------------------------------------
+/**
+ * Create a new buffer.
+ *
+ *   b = buffer.new(length)
+ *   b = buffer.new(string or buffer)   -- copy of the content
+ */
+static inline int
+l3test_buffer_new(lua_State* L)
+{
+    if (lua_type(L, 1) == LUA_TNUMBER)
+    {
+        lua_Integer length = luaL_checkinteger(L, 1);
+        luaL_argcheck(L, length >= 0, 1, "invalid length");
+        l3test_buffer_push(L, static_cast<size_t>(length));
+    }
+    else
+    {
+        outpost::Slice<const uint8_t> source = l3test_buffer_checkbytes(L, 1);
+        l3test_buffer_push(L, source.getNumberOfElements()).copyFrom(source);
+    }
+
+    return 1;
+}
+
+static inline int
+l3test_buffer_length(lua_State* L)
+{
+    LuaBuffer* b = l3test_buffer_check(L, 1);
+    lua_pushinteger(L, static_cast<lua_Integer>(b->data.getNumberOfElements()));
+
+    return 1;
+}
+
+static inline int
+l3test_buffer_string_representation(lua_State* L)
+{
+    LuaBuffer* b = l3test_buffer_check(L, 1);
+    lua_pushfstring(L, "buffer(%d)", static_cast<int>(b->data.getNumberOfElements()));
+
+    return 1;
+}
+
+/**
+ * Get a single byte (index starting with 1).
+ */
+static inline int
+l3test_buffer_get(lua_State* L)
+{
+    LuaBuffer* b = l3test_buffer_check(L, 1);
+    lua_Integer index = luaL_checkinteger(L, 2);
+    luaL_argcheck(L,
+                  (index >= 1) && (static_cast<size_t>(index) <= b->data.getNumberOfElements()),
+                  2,
+                  "index out of range");
+
+    lua_pushinteger(L, b->data[index - 1]);
+
+    return 1;
+}
+
+/**
+ * Set a single byte, anything bigger than a byte is cropped.
+ *
+ *   b:set(index, value)
+ */
+static inline int
+l3test_buffer_set(lua_State* L)
+{
+    LuaBuffer* b = l3test_buffer_check(L, 1);
+    lua_Integer index = luaL_checkinteger(L, 2);
+    luaL_argcheck(L,
+                  (index >= 1) && (static_cast<size_t>(index) <= b->data.getNumberOfElements()),
+                  2,
+                  "index out of range");
+
+    b->data[index - 1] = static_cast<uint8_t>(luaL_checkinteger(L, 3));
+
+    return 0;
+}
+
+/**
+ * Copy a string or a buffer into the buffer.
+ *
+ *   self = b:write(offset, data)
+ *
+ * The data is written starting at the byte \c offset (starting with 1).
+ */
+static inline int
+l3test_buffer_write(lua_State* L)
+{
+    LuaBuffer* b = l3test_buffer_check(L, 1);
+    lua_Integer offset = luaL_checkinteger(L, 2);
+    outpost::Slice<const uint8_t> source = l3test_buffer_checkbytes(L, 3);
+
+    luaL_argcheck(L,
+                  (offset >= 1)
+                          && (static_cast<size_t>(offset - 1) + source.getNumberOfElements()
+                              <= b->data.getNumberOfElements()),
+                  2,
+                  "data does not fit into the buffer");
+
+    // move instead of copy, the source may be a view of the same buffer
+    b->data.skipFirst(offset - 1).move(source);
+
+    lua_settop(L, 1);
+    return 1;
+}
+
+static inline int
+l3test_buffer_fill(lua_State* L)
+{
+    LuaBuffer* b = l3test_buffer_check(L, 1);
+    b->data.fill(static_cast<uint8_t>(luaL_optinteger(L, 2, 0)));
+
+    lua_settop(L, 1);
+    return 1;
+}
+
+/**
+ * Create a view of a part of the buffer without copying.
+ *
+ *   v = b:view([start [, end]])
+ */
+static inline int
+l3test_buffer_view(lua_State* L)
+{
+    LuaBuffer* b = l3test_buffer_check(L, 1);
+
+    size_t offset;
+    size_t count;
+    l3test_buffer_range(L, 2, b->data.getNumberOfElements(), offset, count);
+
+    l3test_buffer_push_view(L, 1, b->data.subSlice(offset, count));
+    return 1;
+}
+
+/**
+ * Copy (a part of) the buffer into a binary string.
+ *
+ *   s = b:string([start [, end]])
+ */
+static inline int
+l3test_buffer_to_string(lua_State* L)
+{
+    LuaBuffer* b = l3test_buffer_check(L, 1);
+
+    size_t offset;
+    size_t count;
+    l3test_buffer_range(L, 2, b->data.getNumberOfElements(), offset, count);
+
+    lua_pushlstring(L, reinterpret_cast<const char*>(b->data.begin() + offset), count);
+    return 1;
+}
+
+/**
+ * Create a table with an entry per byte.
+ */
+static inline int
+l3test_buffer_bytes(lua_State* L)
+{
+    LuaBuffer* b = l3test_buffer_check(L, 1);
+
+    int length = static_cast<int>(b->data.getNumberOfElements());
+    lua_createtable(L, length, 0);
+    for (int i = 0; i < length; ++i)
+    {
+        lua_pushinteger(L, b->data[i]);
+        lua_rawseti(L, -2, i + 1);
+    }
+
+    return 1;
+}
+
+// ----------------------------------------------------------------------------
+static const struct luaL_Reg l3test_buffer_functions[] = {
+    { "new", l3test_buffer_new },
+    { NULL, NULL }
+};
+
+static const struct luaL_Reg l3test_buffer_methods[] = {
+    { "length", l3test_buffer_length },
+    { "get", l3test_buffer_get },
+    { "set", l3test_buffer_set },
+    { "write", l3test_buffer_write },
+    { "fill", l3test_buffer_fill },
+    { "view", l3test_buffer_view },
+    { "string", l3test_buffer_to_string },
+    { "bytes", l3test_buffer_bytes },
+
+    { "__len", l3test_buffer_length },
+    { "__tostring", l3test_buffer_string_representation },
+
+    { NULL, NULL },
+};
+
+/**
+ * Register the buffer metatable if no other module has done so before.
+ *
+ * \param L
+ *      Lua state
+ */
+static inline void
+l3test_buffer_open(lua_State* L)
+{
+    if (luaL_newmetatable(L, luaBufferMetatable))
+    {
+        // metatable.__index = metatable
+        lua_pushvalue(L, -1);   // duplicate the metatable
+        lua_setfield(L, -2, "__index");
+
+        luaL_setfuncs(L, l3test_buffer_methods, 0);
+    }
+    lua_pop(L, 1);
+}
+
+/**
+ * Open the buffer library, can be used with luaL_requiref().
+ */
+static inline int
+l3test_buffer_library(lua_State* L)
+{
+    l3test_buffer_open(L);
+
+    luaL_newlib(L, l3test_buffer_functions);
+    return 1;
+}
+
+#endif // LUA_BUFFER_BUFFER_H
@@ -13,6 +13,8 @@
 
 #include "cobs.h"
 
+#include "../buffer/buffer.h"
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -24,37 +26,92 @@
 
 using outpost::utils::Cobs;
 
+/**
+ * COBS encode a string or a buffer.
+ *
+ *   encoded = cobs.encode(data [, output])
+ *
+ * Strings are returned as strings, buffers as new buffer. If an output
+ * buffer is given, the data is encoded into it and a view of the encoded
+ * part is returned. The output buffer must have a length of at least
+ * `#data + math.ceil(#data / 254)` bytes.
+ */
 static int
 l_cobs_encode(lua_State* L)
 {
-	size_t length;
-    const uint8_t* str = reinterpret_cast<const uint8_t*>(lua_tolstring(L, 1, &length));
+    outpost::Slice<const uint8_t> input = l3test_buffer_checkbytes(L, 1);
 
     // The encoding adds at maximum 1 byte plus and additional byte
     // per 254 bytes of input.
-    size_t maxiumLength = Cobs::getMaximumSizeOfEncodedData(length);
-
-    luaL_Buffer b;
-    uint8_t* dst = reinterpret_cast<uint8_t*>(luaL_buffinitsize(L, &b, maxiumLength));
-
-    size_t encodedLength = Cobs::encode(outpost::Slice<const uint8_t>::unsafe(str, length),
-                                        outpost::Slice<uint8_t>::unsafe(dst, maxiumLength));
-    luaL_pushresultsize(&b, encodedLength);
+    size_t maxiumLength = Cobs::getMaximumSizeOfEncodedData(input.getNumberOfElements());
+
+    if (!lua_isnoneornil(L, 2))
+    {
+        LuaBuffer* output = l3test_buffer_check(L, 2);
+        luaL_argcheck(L, output->data.getNumberOfElements() >= maxiumLength, 2,
+                      "output buffer too small");
+
+        size_t encodedLength = Cobs::encode(input, output->data);
+        l3test_buffer_push_view(L, 2, output->data.first(encodedLength));
+    }
+    else if (l3test_buffer_test(L, 1) != nullptr)
+    {
+        outpost::Slice<uint8_t> output = l3test_buffer_push(L, maxiumLength);
+
+        size_t encodedLength = Cobs::encode(input, output);
+        l3test_buffer_push_view(L, -1, output.first(encodedLength));
+    }
+    else
+    {
+        luaL_Buffer b;
+        uint8_t* dst = reinterpret_cast<uint8_t*>(luaL_buffinitsize(L, &b, maxiumLength));
+
+        size_t encodedLength =
+                Cobs::encode(input, outpost::Slice<uint8_t>::unsafe(dst, maxiumLength));
+        luaL_pushresultsize(&b, encodedLength);
+    }
 
     return 1;
 }
 
+/**
+ * Decode a COBS encoded string or buffer.
+ *
+ *   decoded = cobs.decode(data [, output])
+ *
+ * Works like cobs.encode(). The output buffer needs the same length
+ * as the input, `cobs.decode(b, b)` decodes a buffer in place.
+ */
 static int
 l_cobs_decode(lua_State* L)
 {
-    size_t length;
-    const uint8_t* str = reinterpret_cast<const uint8_t*>(lua_tolstring(L, 1, &length));
-
-    luaL_Buffer b;
-    uint8_t* dst = reinterpret_cast<uint8_t*>(luaL_buffinitsize(L, &b, length));
-
-    size_t encodedLength = Cobs::decode(outpost::Slice<const uint8_t>::unsafe(str, length), dst);
-    luaL_pushresultsize(&b, encodedLength);
+    outpost::Slice<const uint8_t> input = l3test_buffer_checkbytes(L, 1);
+    size_t length = input.getNumberOfElements();
+
+    if (!lua_isnoneornil(L, 2))
+    {
+        LuaBuffer* output = l3test_buffer_check(L, 2);
+        luaL_argcheck(L, output->data.getNumberOfElements() >= length, 2,
+                      "output buffer too small");
+
+        size_t decodedLength = Cobs::decode(input, output->data.begin());
+        l3test_buffer_push_view(L, 2, output->data.first(decodedLength));
+    }
+    else if (l3test_buffer_test(L, 1) != nullptr)
+    {
+        outpost::Slice<uint8_t> output = l3test_buffer_push(L, length);
+
+        size_t decodedLength = Cobs::decode(input, output.begin());
+        l3test_buffer_push_view(L, -1, output.first(decodedLength));
+    }
+    else
+    {
+        luaL_Buffer b;
+        uint8_t* dst = reinterpret_cast<uint8_t*>(luaL_buffinitsize(L, &b, length));
+
+        size_t decodedLength = Cobs::decode(input, dst);
+        luaL_pushresultsize(&b, decodedLength);
+    }
 
     return 1;
 }
@@ -71,6 +128,8 @@ extern "C"
 int
 luaopen_cobs(lua_State* L)
 {
+	l3test_buffer_open(L);
+
 	luaL_newlib(L, lib_functions);
 	return 1;
 }
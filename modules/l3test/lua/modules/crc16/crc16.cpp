@@ -14,6 +14,8 @@
 #include <outpost/utils/coding/crc16.h>
 #include "crc16.h"
 
+#include "../buffer/buffer.h"
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -108,7 +110,16 @@ static void
 calculate(lua_State* L, int offset, Crc16Ccitt* d)
 {
     int type = lua_type(L, offset);
-    if (type == LUA_TTABLE)
+    LuaBuffer* buffer = l3test_buffer_test(L, offset);
+    if (buffer != nullptr)
+    {
+        size_t start;
+        size_t count;
+        l3test_buffer_range(L, offset + 1, buffer->data.getNumberOfElements(), start, count);
+
+        d->update(buffer->data.subSlice(start, count));
+    }
+    else if (type == LUA_TTABLE)
     {
         int start = luaL_optinteger(L, offset + 1, 1);
         int end = luaL_optinteger(L, offset + 2, -1);
@@ -169,8 +180,8 @@ calculate(lua_State* L, int offset, Crc16Ccitt* d)
  * If \c end is absent, it defaults to -1, the end of the bytes.
  * If \c start is absent, it defaults to 1, the start of the bytes.
  *
- * \c bytes can either be an array table with each byte as a separate entry or
- * a string.
+ * \c bytes can either be an array table with each byte as a separate entry,
+ * a string or a buffer. Buffers are processed without a copy.
  *
  * Returns the crc object.
  */
@@ -269,6 +280,8 @@ extern "C"
 int
 luaopen_crc16(lua_State* L)
 {
+	l3test_buffer_open(L);
+
 	luaL_newmetatable(L, "dlr.crc16");
 
 	// metatable.__index = metatable
@@ -13,6 +13,8 @@
 
 #include "channel.h"
 
+#include "../buffer/buffer.h"
+
 #include <cstdlib>
 #include <cstdio>
 
@@ -74,7 +76,12 @@ l_append(lua_State* L)
 {
     Channel* c = getChannel(L);
 
-    if (lua_istable(L, 2))
+    LuaBuffer* buffer = l3test_buffer_test(L, 2);
+    if (buffer != nullptr)
+    {
+        c->append(buffer->data.begin(), buffer->data.getNumberOfElements());
+    }
+    else if (lua_istable(L, 2))
     {
         lua_len(L, 2);
         int length = lua_tointeger(L, -1);
@@ -90,6 +97,13 @@ l_append(lua_State* L)
 
         c->append(a, length);
     }
+    else if (lua_type(L, 2) == LUA_TSTRING)
+    {
+        // strings are appended directly without a conversion per byte
+        size_t length;
+        const char* data = lua_tolstring(L, 2, &length);
+        c->append(reinterpret_cast<const uint8_t*>(data), length);
+    }
     else if (lua_isnumber(L, 2))
     {
         // anything bigger than a byte is cropped
@@ -98,7 +112,8 @@ l_append(lua_State* L)
     }
     else
     {
-        return luaL_argerror(L, 2, "Argument type must be a table or an integer");
+        return luaL_argerror(
+                L, 2, "Argument type must be a table, a string, a buffer or an integer");
     }
 
     return 0;
@@ -155,11 +170,11 @@ l_get_packet(lua_State* L)
     }
 
     // create a new table with the matching number of entries.
-    int length = c->getPacketLength();
+    outpost::Slice<const uint8_t> packet = c->getPacketData();
+    int length = packet.getNumberOfElements();
     lua_createtable(L, length, 0);
 
-    // convert vector into a lua table with one entry per byte
-    std::vector<uint8_t> packet = c->getPacket();
+    // convert the packet into a lua table with one entry per byte
     for (int i = 0; i < length; ++i)
     {
         lua_pushinteger(L, packet[i]);
@@ -169,6 +184,83 @@ l_get_packet(lua_State* L)
     return 1;
 }
 
+/*
+ * Returns the packet as binary string, copied in one piece.
+ */
+static int
+l_get_packet_string(lua_State* L)
+{
+    Channel* c = getChannel(L);
+
+    if (!c->hasPacket())
+    {
+        luaL_error(L, "No packet available");
+    }
+
+    outpost::Slice<const uint8_t> packet = c->getPacketData();
+    lua_pushlstring(L, reinterpret_cast<const char*>(packet.begin()), packet.getNumberOfElements());
+
+    return 1;
+}
+
+/*
+ * Returns the packet as buffer, copied in one piece.
+ */
+static int
+l_get_packet_buffer(lua_State* L)
+{
+    Channel* c = getChannel(L);
+
+    if (!c->hasPacket())
+    {
+        luaL_error(L, "No packet available");
+    }
+
+    outpost::Slice<const uint8_t> packet = c->getPacketData();
+    l3test_buffer_push(L, packet.getNumberOfElements()).copyFrom(packet);
+
+    return 1;
+}
+
+static int
+l_get_packet_length(lua_State* L)
+{
+    Channel* c = getChannel(L);
+
+    if (!c->hasPacket())
+    {
+        luaL_error(L, "No packet available");
+    }
+
+    lua_pushinteger(L, c->getPacketLength());
+
+    return 1;
+}
+
+/*
+ * Returns a single byte of the packet (index starting with 1) without
+ * copying the packet.
+ */
+static int
+l_get_packet_byte(lua_State* L)
+{
+    Channel* c = getChannel(L);
+
+    if (!c->hasPacket())
+    {
+        luaL_error(L, "No packet available");
+    }
+
+    outpost::Slice<const uint8_t> packet = c->getPacketData();
+    lua_Integer index = luaL_checkinteger(L, 2);
+    luaL_argcheck(L, (index >= 1) && (static_cast<size_t>(index) <= packet.getNumberOfElements()),
+                  2, "index out of range");
+
+    lua_pushinteger(L, packet[index - 1]);
+
+    return 1;
+}
+
 static int
 l_next_packet(lua_State* L)
 {
@@ -191,6 +283,10 @@ static const struct luaL_Reg arraylib_m[] = {
     { "getNumberOfPackets", l_number_of_packets },
 
     { "get", l_get_packet },
+    { "getString", l_get_packet_string },
+    { "getBuffer", l_get_packet_buffer },
+    { "getLength", l_get_packet_length },
+    { "getByte", l_get_packet_byte },
     { "next", l_next_packet },
 
 	{ NULL, NULL },
@@ -207,6 +303,8 @@ l3test_channel_open(lua_State* L)
 
     luaL_setfuncs(L, arraylib_m, 0);
     lua_pop(L, 1);
+
+    l3test_buffer_open(L);
 }
 
 void
@@ -15,8 +15,11 @@
 
 #include "channel.h"
 
+#include "../buffer/buffer.h"
+
 static const struct luaL_Reg arraylib_f[] = {
     { "channel", l3test_channel_new },
+    { "buffer", l3test_buffer_new },
     { NULL, NULL }
 };
 
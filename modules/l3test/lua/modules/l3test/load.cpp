@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "load.h"
+
+#include "../buffer/buffer.h"
+
+#include <l3test/script/channel.h>
+
+using namespace l3test::script;
+
+static inline LoadGenerator*
+getGenerator(lua_State* L)
+{
+    LoadGenerator::Ptr* ptr =
+            reinterpret_cast<LoadGenerator::Ptr*>(luaL_checkudata(L, 1, "dlr.l3test.load"));
+    return ptr->get();
+}
+
+static int
+l_destroy(lua_State* L)
+{
+    LoadGenerator::Ptr* g =
+            reinterpret_cast<LoadGenerator::Ptr*>(luaL_checkudata(L, 1, "dlr.l3test.load"));
+
+    typedef LoadGenerator::Ptr LoadGeneratorPtr;
+    g->~LoadGeneratorPtr();
+
+    return 0;
+}
+
+static int
+l_string_representation(lua_State* L)
+{
+    LoadGenerator* g = getGenerator(L);
+    lua_pushfstring(L, "l3test.load(%d)", static_cast<int>(g->getNumberOfTemplates()));
+
+    return 1;
+}
+
+// ---------------------------------------------------------------------------
+/*
+ * Adds a packet template, the sequence number is overwritten when sent.
+ */
+static int
+l_add(lua_State* L)
+{
+    LoadGenerator* g = getGenerator(L);
+
+    outpost::Slice<const uint8_t> packet = l3test_buffer_checkbytes(L, 2);
+    luaL_argcheck(L, g->addTemplate(packet), 2, "packet too short for the sequence number");
+
+    return 0;
+}
+
+static lua_Number
+getNumberField(lua_State* L, const char* key, lua_Number defaultValue)
+{
+    lua_getfield(L, 2, key);
+    lua_Number value = luaL_optnumber(L, -1, defaultValue);
+    lua_pop(L, 1);
+
+    return value;
+}
+
+/*
+ * Sends packets, blocks until all packets are sent.
+ *
+ *   accepted = load:run{ rate = packets per second, burst = n, count = n }
+ */
+static int
+l_run(lua_State* L)
+{
+    LoadGenerator* g = getGenerator(L);
+    luaL_checktype(L, 2, LUA_TTABLE);
+
+    lua_Number rate = getNumberField(L, "rate", 0);
+    lua_Number burst = getNumberField(L, "burst", 1);
+    lua_Number count = getNumberField(L, "count", 1);
+    luaL_argcheck(L, (rate >= 0) && (burst >= 1) && (count >= 0), 2, "invalid profile");
+
+    LoadGenerator::Profile profile = {
+            rate, static_cast<size_t>(burst), static_cast<size_t>(count)};
+    lua_pushinteger(L, static_cast<lua_Integer>(g->run(profile)));
+
+    return 1;
+}
+
+/*
+ * Passes all packets of a channel to the latency probe and removes them.
+ *
+ * Returns the number of packets with a valid sequence number.
+ */
+static int
+l_collect(lua_State* L)
+{
+    LoadGenerator* g = getGenerator(L);
+    Channel::Ptr* c = reinterpret_cast<Channel::Ptr*>(luaL_checkudata(L, 2, "dlr.l3test.channel"));
+
+    lua_Integer valid = 0;
+    while ((*c)->hasPacket())
+    {
+        if (g->getProbe().received((*c)->getPacketData(), g->getSequenceOffset()))
+        {
+            valid++;
+        }
+        (*c)->nextPacket();
+    }
+    lua_pushinteger(L, valid);
+
+    return 1;
+}
+
+static void
+setField(lua_State* L, const char* key, lua_Number value)
+{
+    lua_pushnumber(L, value);
+    lua_setfield(L, -2, key);
+}
+
+static void
+setField(lua_State* L, const char* key, size_t value)
+{
+    lua_pushinteger(L, static_cast<lua_Integer>(value));
+    lua_setfield(L, -2, key);
+}
+
+/*
+ * Returns a table with the packet counts and the latencies in microseconds.
+ */
+static int
+l_statistics(lua_State* L)
+{
+    LoadGenerator* g = getGenerator(L);
+    LatencyProbe::Statistics statistics = g->getProbe().getStatistics();
+
+    lua_createtable(L, 0, 9);
+    setField(L, "sent", statistics.sent);
+    setField(L, "received", statistics.received);
+    setField(L, "dropped", statistics.dropped);
+    setField(L, "unexpected", statistics.unexpected);
+    setField(L, "minimum", statistics.minimum);
+    setField(L, "mean", statistics.mean);
+    setField(L, "median", statistics.median);
+    setField(L, "percentile99", statistics.percentile99);
+    setField(L, "maximum", statistics.maximum);
+
+    return 1;
+}
+
+static int
+l_reset(lua_State* L)
+{
+    LoadGenerator* g = getGenerator(L);
+    g->getProbe().reset();
+
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+static const struct luaL_Reg loadlib_m[] = {
+    { "__gc", l_destroy },
+    { "__tostring", l_string_representation },
+
+    { "add", l_add },
+    { "run", l_run },
+    { "collect", l_collect },
+    { "statistics", l_statistics },
+    { "reset", l_reset },
+
+    { NULL, NULL },
+};
+
+void
+l3test_load_open(lua_State* L)
+{
+    luaL_newmetatable(L, "dlr.l3test.load");
+
+    // metatable.__index = metatable
+    lua_pushvalue(L, -1);   // duplicate the metatable
+    lua_setfield(L, -2, "__index");
+
+    luaL_setfuncs(L, loadlib_m, 0);
+    lua_pop(L, 1);
+
+    l3test_buffer_open(L);
+}
+
+void
+l3test_load_register(lua_State* L, LoadGenerator::Ptr generator)
+{
+    void* ptr = lua_newuserdata(L, sizeof(LoadGenerator::Ptr));
+    new (ptr) LoadGenerator::Ptr(generator);
+
+    luaL_getmetatable(L, "dlr.l3test.load");
+    lua_setmetatable(L, -2);
+}
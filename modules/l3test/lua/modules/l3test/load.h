@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef LUA_L3TEST_LOAD_H
+#define LUA_L3TEST_LOAD_H
+
+#include <l3test/script/load_generator.h>
+
+#include <lua.hpp>
+
+/**
+ * Opens the l3test.load library.
+ *
+ * Load generators are created in C++ because the sink is connected to the
+ * component under test. Scripts configure and start them:
+ *
+ *   load:add(packet)                                -- string or buffer
+ *   load:run{ rate = 1000, burst = 10, count = 5000 }
+ *   load:collect(tm)                                -- received packets
+ *   local s = load:statistics()
+ *   print(s.sent, s.received, s.dropped, s.mean, s.percentile99)
+ *
+ * \param L
+ *      Lua state
+ */
+void
+l3test_load_open(lua_State* L);
+
+/**
+ * Pushes a load generator on the current Lua stack.
+ *
+ * \param L
+ *      Lua state.
+ * \param generator
+ *      Generator which should be used from within Lua.
+ */
+void
+l3test_load_register(lua_State* L, l3test::script::LoadGenerator::Ptr generator);
+
+#endif // LUA_L3TEST_LOAD_H
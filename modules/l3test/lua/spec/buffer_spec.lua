@@ -0,0 +1,72 @@
+--[[
+Copyright (c) 2020, German Aerospace Center (DLR)
+
+This file is part of the development version of OUTPOST.
+
+This Source Code Form is subject to the terms of the Mozilla Public
+License, v. 2.0. If a copy of the MPL was not distributed with this
+file, You can obtain one at http://mozilla.org/MPL/2.0/.
+--]]
+
+require("busted")
+
+local buffer = require "l3test".buffer
+local bitstream = require "bitstream"
+local cobs = require "cobs"
+local crc16 = require "crc16"
+
+describe("Lua modules", function()
+
+	describe("Buffer", function()
+		it("should create a zero initialized buffer", function()
+			local b = buffer(3)
+
+			assert.equals(3, #b)
+			assert.equals('\x00\x00\x00', b:string())
+		end)
+
+		it("should share the memory with a view", function()
+			local b = buffer('\x01\x02\x03\x04')
+			local v = b:view(2, 3)
+
+			v:set(1, 0xff)
+
+			assert.equals(2, #v)
+			assert.equals('\x01\xff\x03\x04', b:string())
+		end)
+
+		it("should write data at an offset", function()
+			local b = buffer(4)
+			b:write(2, '\x01\x02')
+
+			assert.equals('\x00\x01\x02\x00', b:string())
+			assert.has_error(function() b:write(4, '\x01\x02') end)
+		end)
+
+		it("should be accepted by the crc16 module", function()
+			local b = buffer('123456789')
+
+			assert.equals(crc16.calculate('123456789'), crc16.calculate(b))
+			assert.equals(crc16.calculate('2345'), crc16.calculate(b, 2, 5))
+		end)
+
+		it("should encode and decode COBS in place", function()
+			local i = 'Hello World!\x00This is a abitrary string.'
+			local b = buffer(#i + 1)
+
+			local e = cobs.encode(i, b)
+			assert.equals(cobs.encode(i), e:string())
+
+			local o = cobs.decode(e, e)
+			assert.equals(i, o:string())
+			assert.equals(i, b:string(1, #i))
+		end)
+
+		it("should convert from and to bitstreams", function()
+			local s = bitstream.new(buffer('\x0f\xf0'))
+
+			assert.equals(16, s:bit_length())
+			assert.equals('\x0f\xf0', s:buffer():string())
+		end)
+	end)
+end)
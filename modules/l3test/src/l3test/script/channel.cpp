@@ -13,9 +13,22 @@
 
 #include "channel.h"
 
+#include <string.h>
+
+#include <algorithm>
+
 using namespace l3test::script;
 
-Channel::Channel()
+static constexpr size_t initialStorageSize = 256;
+
+Channel::Channel() :
+    storage(initialStorageSize),
+    head(0),
+    tail(0),
+    wrapEnd(0),
+    wrapped(false),
+    numberOfPackets(0),
+    currentLength(0)
 {
 }
 
@@ -27,54 +40,65 @@ Channel::~Channel()
 void
 Channel::append(const uint8_t* data, size_t numberOfBytes)
 {
-    currentPacket.reserve(currentPacket.size() + numberOfBytes);
+    reserve(sizeof(Header) + currentLength + numberOfBytes);
 
-    for (size_t i = 0; i < numberOfBytes; ++i)
-    {
-        currentPacket.push_back(data[i]);
-    }
+    memcpy(storage.data() + tail + sizeof(Header) + currentLength, data, numberOfBytes);
+    currentLength += numberOfBytes;
 }
 
 void
 Channel::finishPacket()
 {
-    packets.push_back(currentPacket);
-    currentPacket.clear();
+    reserve(sizeof(Header) + currentLength);
+
+    const Header length = static_cast<Header>(currentLength);
+    memcpy(&storage[tail], &length, sizeof(Header));
+
+    tail += sizeof(Header) + currentLength;
+    currentLength = 0;
+    numberOfPackets++;
 }
 
 // ----------------------------------------------------------------------------
 bool
 Channel::hasPacket() const
 {
-    return (packets.size() > 0);
+    return (numberOfPackets > 0);
 }
 
 size_t
 Channel::getNumberOfPackets() const
 {
-    return packets.size();
+    return numberOfPackets;
 }
 
 size_t
 Channel::getPacketLength() const
 {
-    return packets.front().size();
+    Header length;
+    memcpy(&length, &storage[head], sizeof(Header));
+    return length;
+}
+
+outpost::Slice<const uint8_t>
+Channel::getPacketData() const
+{
+    return outpost::Slice<const uint8_t>::unsafe(storage.data() + head + sizeof(Header),
+                                                 getPacketLength());
 }
 
-Channel::Packet&
-Channel::getPacket()
+Channel::Packet
+Channel::getPacket() const
 {
-    return packets.front();
+    outpost::Slice<const uint8_t> data = getPacketData();
+    return Packet(data.begin(), data.end());
 }
 
 size_t
 Channel::getPacket(uint8_t* data, size_t numberOfBytes) const
 {
     auto length = std::min(numberOfBytes, getPacketLength());
-    for (size_t i = 0; i < length; ++i)
-    {
-        data[i] = packets.front()[i];
-    }
+    memcpy(data, storage.data() + head + sizeof(Header), length);
 
     return length;
 }
@@ -82,5 +106,85 @@ Channel::getPacket(uint8_t* data, size_t numberOfBytes) const
 void
 Channel::nextPacket()
 {
-    packets.pop_front();
+    head += sizeof(Header) + getPacketLength();
+    numberOfPackets--;
+
+    if (wrapped && (head == wrapEnd))
+    {
+        head = 0;
+        wrapped = false;
+    }
+}
+
+// ----------------------------------------------------------------------------
+void
+Channel::reserve(size_t numberOfBytes)
+{
+    if (wrapped)
+    {
+        // Free space is between the current and the oldest packet
+        if (tail + numberOfBytes > head)
+        {
+            grow(numberOfBytes);
+        }
+    }
+    else if (tail + numberOfBytes > storage.size())
+    {
+        if (numberOfPackets == 0)
+        {
+            // Nothing stored, restart at the beginning
+            moveCurrentPacket(0);
+            head = 0;
+        }
+        else if (numberOfBytes <= head)
+        {
+            // Continue at the beginning of the storage
+            wrapEnd = tail;
+            wrapped = true;
+            moveCurrentPacket(0);
+        }
+
+        if (tail + numberOfBytes > storage.size())
+        {
+            grow(numberOfBytes);
+        }
+    }
+}
+
+void
+Channel::grow(size_t numberOfBytes)
+{
+    const size_t used = wrapped ? (wrapEnd - head + tail) : (tail - head);
+
+    std::vector<uint8_t> newStorage(std::max(2 * storage.size(), used + numberOfBytes));
+
+    // Linearize the stored packets, followed by the current packet
+    const uint8_t* data = storage.data();
+    if (wrapped)
+    {
+        memcpy(newStorage.data(), data + head, wrapEnd - head);
+        memcpy(newStorage.data() + wrapEnd - head, data, tail);
+    }
+    else
+    {
+        memcpy(newStorage.data(), data + head, tail - head);
+    }
+    memcpy(newStorage.data() + used + sizeof(Header),
+           data + tail + sizeof(Header),
+           currentLength);
+
+    storage.swap(newStorage);
+    head = 0;
+    tail = used;
+    wrapped = false;
+}
+
+void
+Channel::moveCurrentPacket(size_t position)
+{
+    // The header is only written by finishPacket()
+    memmove(storage.data() + position + sizeof(Header),
+            storage.data() + tail + sizeof(Header),
+            currentLength);
+    tail = position;
 }
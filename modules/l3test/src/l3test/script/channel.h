@@ -14,10 +14,11 @@
 #ifndef L3TEST_SCRIPT_CHANNEL_H
 #define L3TEST_SCRIPT_CHANNEL_H
 
+#include <outpost/base/slice.h>
+
 #include <stddef.h>
 #include <stdint.h>
 
-#include <list>
 #include <memory>
 #include <vector>
 
@@ -31,6 +32,11 @@ namespace script
  * Channels are used to communicate between Lua and C++. They provide a packet
  * based communication of raw (binary) data. Channels are implemented as Fifos.
  *
+ * All packets are stored as (length, data) records in a single contiguous
+ * ring buffer which is reused for the following packets and only grows if
+ * the stored packets do not fit. Every packet stays contiguous, the current
+ * packet can therefore be accessed in place with getPacketData().
+ *
  * \author  Fabian Greif
  */
 class Channel
@@ -82,15 +88,32 @@ public:
     size_t
     getPacketLength() const;
 
-    Packet&
-    getPacket();
+    /**
+     * Get the data of the current packet without copying it.
+     *
+     * Only valid when hasPacket() returns \c true. The data stays valid
+     * until nextPacket() or append() is called.
+     */
+    outpost::Slice<const uint8_t>
+    getPacketData() const;
+
+    /**
+     * Get a copy of the current packet.
+     *
+     * Prefer getPacketData() to avoid the allocation of the copy.
+     */
+    Packet
+    getPacket() const;
 
     /**
      * Copy packet data in the supplied array.
      *
      * \param data
-     * \param
+     *      Destination of the packet data.
+     * \param numberOfBytes
+     *      Size of \p data.
      * \return
+     *      Number of bytes copied, at most \p numberOfBytes.
      */
     size_t
     getPacket(uint8_t* data, size_t numberOfBytes) const;
@@ -102,8 +125,42 @@ public:
     nextPacket();
 
 private:
-    Packet currentPacket;
-    std::list<Packet> packets;
+    /// Length field stored in front of every packet
+    typedef uint32_t Header;
+
+    /**
+     * Make sure that \p numberOfBytes contiguous bytes starting at the
+     * current packet are available.
+     *
+     * Moves the current packet to the beginning of the storage if the end
+     * is reached, or grows the storage if there is not enough free space.
+     */
+    void
+    reserve(size_t numberOfBytes);
+
+    void
+    grow(size_t numberOfBytes);
+
+    /// Move the data of the current packet to \p position
+    void
+    moveCurrentPacket(size_t position);
+
+    std::vector<uint8_t> storage;
+
+    /// Offset of the oldest packet
+    size_t head;
+
+    /// Offset of the current (unfinished) packet
+    size_t tail;
+
+    /// End of the packets before the wrap-around, only valid if wrapped
+    size_t wrapEnd;
+
+    /// The current packet is stored in front of the oldest packet
+    bool wrapped;
+
+    size_t numberOfPackets;
+    size_t currentLength;
 };
 }  // namespace script
 }  // namespace l3test
@@ -14,7 +14,9 @@
 #include "engine.h"
 
 #include <lua/exception.h>
+#include <modules/buffer/buffer.h>
 #include <modules/l3test/channel.h>
+#include <modules/l3test/load.h>
 
 #include <array>
 #include <sstream>
@@ -40,6 +42,8 @@ const std::string Engine::defaultCPath[] = {
         "../../bin/lua/?.so",
 };
 
+const Engine::Chunk Engine::invalidChunk = LUA_NOREF;
+
 namespace
 {
 int
@@ -86,12 +90,22 @@ appendPath(lua_State* L, const char* field, const std::string path)
 }
 
 // ----------------------------------------------------------------------------
-Engine::Engine() : L(luaL_newstate())
+Engine::Engine() :
+    L(luaL_newstate()),
+    globalsSnapshot(LUA_NOREF),
+    modulesSnapshot(LUA_NOREF),
+    channelsSnapshot(0)
 {
     luaL_openlibs(L);
     lua_atpanic(L, atpanic);
 
     l3test_channel_open(L);
+    l3test_load_open(L);
+
+    // The buffer module is part of the engine, `require "buffer"` works
+    // without the shared library.
+    luaL_requiref(L, "buffer", l3test_buffer_library, 0);
+    lua_pop(L, 1);
 
     // clear the include path
     setPath(L, "path", "./?.lua");
@@ -186,14 +200,29 @@ Engine::registerChannel(Channel::Ptr channel, const char* name)
         }
     }
 
+    channels.push_back(std::make_pair(std::string(name), channel));
+
+    l3test_channel_register(L, channel);
+    setGlobal(name);
+
+    return true;
+}
+
+void
+Engine::registerLoadGenerator(LoadGenerator::Ptr generator, const char* name)
+{
+    l3test_load_register(L, generator);
+    setGlobal(name);
+}
+
+void
+Engine::setGlobal(const char* name)
+{
     auto strName = std::string(name);
     auto nameElements = split(strName, '.');
 
-    channels.push_back(std::make_pair(strName, channel));
-
     if (nameElements.size() == 1)
     {
-        l3test_channel_register(L, channel);
         lua_setglobal(L, name);
     }
     else
@@ -224,23 +253,182 @@ Engine::registerChannel(Channel::Ptr channel, const char* name)
             }
         }
 
-        l3test_channel_register(L, channel);
+        // move the value above the tables
+        lua_rotate(L, -static_cast<int>(nameElements.size()), -1);
         lua_setfield(L, -2, nameElements[nameElements.size() - 1].c_str());
 
         // clean up the stack
         lua_pop(L, nameElements.size() - 1);
     }
+}
 
-    return true;
+Channel::Ptr
+Engine::getChannel(const char* name) const
+{
+    for (auto& c : channels)
+    {
+        if (c.first.compare(name) == 0)
+        {
+            return c.second;
+        }
+    }
+    return Channel::Ptr();
 }
 
 bool
 Engine::execute(std::string code)
 {
-    int error = luaL_dostring(L, code.c_str());
-    if (error)
+    auto cached = cachedChunks.find(code);
+    if (cached != cachedChunks.end())
+    {
+        return execute(cached->second);
+    }
+
+    if (luaL_loadstring(L, code.c_str()) != LUA_OK)
+    {
+        lua_error(L);
+    }
+    Chunk chunk = luaL_ref(L, LUA_REGISTRYINDEX);
+    cachedChunks.emplace(std::move(code), chunk);
+
+    return execute(chunk);
+}
+
+Engine::Chunk
+Engine::compile(const std::string& code, const char* chunkName)
+{
+    const char* name = (chunkName != nullptr) ? chunkName : code.c_str();
+    if (luaL_loadbuffer(L, code.data(), code.size(), name) != LUA_OK)
+    {
+        lua_pop(L, 1);
+        return invalidChunk;
+    }
+    return luaL_ref(L, LUA_REGISTRYINDEX);
+}
+
+bool
+Engine::execute(Chunk chunk)
+{
+    const int top = lua_gettop(L);
+    if (lua_rawgeti(L, LUA_REGISTRYINDEX, chunk) != LUA_TFUNCTION)
+    {
+        lua_pop(L, 1);
+        throw lua::Exception("invalid chunk");
+    }
+
+    if (lua_pcall(L, 0, LUA_MULTRET, 0) != LUA_OK)
     {
         lua_error(L);
     }
+    // Drop the results, the stack is left as before the call
+    lua_settop(L, top);
     return false;
 }
+
+void
+Engine::release(Chunk chunk)
+{
+    luaL_unref(L, LUA_REGISTRYINDEX, chunk);
+}
+
+// ----------------------------------------------------------------------------
+void
+Engine::snapshot()
+{
+    luaL_unref(L, LUA_REGISTRYINDEX, globalsSnapshot);
+    luaL_unref(L, LUA_REGISTRYINDEX, modulesSnapshot);
+
+    lua_pushglobaltable(L);
+    copyTable();
+    globalsSnapshot = luaL_ref(L, LUA_REGISTRYINDEX);
+    lua_pop(L, 1);
+
+    luaL_getsubtable(L, LUA_REGISTRYINDEX, LUA_LOADED_TABLE);
+    copyTable();
+    modulesSnapshot = luaL_ref(L, LUA_REGISTRYINDEX);
+    lua_pop(L, 1);
+
+    channelsSnapshot = channels.size();
+}
+
+bool
+Engine::restore()
+{
+    if (globalsSnapshot == LUA_NOREF)
+    {
+        return false;
+    }
+
+    lua_pushglobaltable(L);
+    restoreTable(globalsSnapshot);
+    lua_pop(L, 1);
+
+    luaL_getsubtable(L, LUA_REGISTRYINDEX, LUA_LOADED_TABLE);
+    restoreTable(modulesSnapshot);
+    lua_pop(L, 1);
+
+    channels.resize(channelsSnapshot);
+    return true;
+}
+
+void
+Engine::copyTable()
+{
+    lua_newtable(L);
+    lua_pushnil(L);
+    while (lua_next(L, -3) != 0)
+    {
+        // copy table[key] = value, keep the key for the next iteration
+        lua_pushvalue(L, -2);
+        lua_insert(L, -2);
+        lua_rawset(L, -4);
+    }
+}
+
+void
+Engine::restoreTable(int reference)
+{
+    lua_rawgeti(L, LUA_REGISTRYINDEX, reference);
+
+    // Remove or reset entries which differ from the snapshot. Existing
+    // fields may be changed during the traversal.
+    lua_pushnil(L);
+    while (lua_next(L, -3) != 0)
+    {
+        lua_pushvalue(L, -2);
+        lua_rawget(L, -4);
+        if (!lua_rawequal(L, -1, -2))
+        {
+            lua_pushvalue(L, -3);
+            lua_insert(L, -2);
+            lua_rawset(L, -6);
+        }
+        else
+        {
+            lua_pop(L, 1);
+        }
+        lua_pop(L, 1);
+    }
+
+    // Add the entries removed since the snapshot
+    lua_pushnil(L);
+    while (lua_next(L, -2) != 0)
+    {
+        lua_pushvalue(L, -2);
+        lua_rawget(L, -5);
+        const bool missing = lua_isnil(L, -1);
+        lua_pop(L, 1);
+        if (missing)
+        {
+            lua_pushvalue(L, -2);
+            lua_insert(L, -2);
+            lua_rawset(L, -5);
+        }
+        else
+        {
+            lua_pop(L, 1);
+        }
+    }
+
+    lua_pop(L, 1);
+}
@@ -15,9 +15,11 @@
 #define SCRIPT_ENGINE_H
 
 #include "channel.h"
+#include "load_generator.h"
 
 #include <list>
 #include <string>
+#include <unordered_map>
 
 extern "C"
 {
@@ -34,11 +36,36 @@ namespace script
  * Controls the Lua execution environment and provides means of communication
  * between Lua and C++.
  *
+ * Scripts which are executed repeatedly are only compiled once: execute()
+ * keeps the compiled chunk of every code string, compile() returns a handle
+ * to a chunk which can be called with execute(Chunk).
+ *
+ * To avoid creating and configuring a new Lua state for every test, an
+ * engine can be shared between tests. After the common setup (paths,
+ * modules, channels) a snapshot() is taken, restore() then reverts the
+ * globals, the loaded modules and the channels to that snapshot:
+ *
+ * \code
+ * static Engine engine;
+ * engine.appendDefaultLuaPath(path);
+ * engine.execute("bitstream = require 'bitstream'");
+ * engine.snapshot();
+ *
+ * // before every test
+ * engine.restore();
+ * \endcode
+ *
  * \author  Fabian Greif
  */
 class Engine
 {
 public:
+    /// Handle of a compiled chunk, stored in the Lua registry
+    typedef int Chunk;
+
+    /// Returned by compile() if the code could not be compiled
+    static const Chunk invalidChunk;
+
     Engine();
 
     ~Engine();
@@ -79,16 +106,116 @@ public:
     bool
     registerChannel(Channel::Ptr channel, const char* name);
 
+    /**
+     * Get a channel registered with registerChannel().
+     *
+     * 
+eturn Channel or an empty pointer if no channel with the given
+     *         name is registered.
+     */
+    Channel::Ptr
+    getChannel(const char* name) const;
+
+    /**
+     * Make a load generator available to scripts.
+     *
+     * \param generator
+     *     Generator to register.
+     * \param name
+     *     Name of the global variable, may contain dots like channel names.
+     */
+    void
+    registerLoadGenerator(LoadGenerator::Ptr generator, const char* name);
+
+    /**
+     * Execute Lua code.
+     *
+     * The code is compiled on the first call, later calls with the same
+     * code reuse the compiled chunk.
+     *
+     * \throw lua::Exception
+     *      If the code could not be compiled or raised an error.
+     */
     bool
     execute(std::string code);
 
+    /**
+     * Compile Lua code without executing it.
+     *
+     * \param code
+     *     Lua code.
+     * \param chunkName
+     *     Name used in error messages, the code itself if nullptr.
+     *
+     * \return Handle for execute(Chunk), invalidChunk if the code contains
+     *         a syntax error.
+     */
+    Chunk
+    compile(const std::string& code, const char* chunkName = nullptr);
+
+    /**
+     * Execute a compiled chunk.
+     *
+     * \throw lua::Exception
+     *      If the chunk raised an error or the handle is invalid.
+     */
+    bool
+    execute(Chunk chunk);
+
+    /**
+     * Release a chunk returned by compile().
+     */
+    void
+    release(Chunk chunk);
+
+    /**
+     * Store the current globals, loaded modules and channels.
+     *
+     * Replaces a previous snapshot.
+     */
+    void
+    snapshot();
+
+    /**
+     * Revert to the state stored by snapshot().
+     *
+     * Globals and entries of `package.loaded` are reset to the values they
+     * had in the snapshot, new ones are removed. Channels registered after
+     * the snapshot are dropped. The restore is shallow, changes inside
+     * tables which existed at the snapshot are kept.
+     *
+     * \retval true  State was restored.
+     * \retval false No snapshot available.
+     */
+    bool
+    restore();
+
 private:
+    /// Assign the value at the top of the stack to a (dotted) global name
+    void
+    setGlobal(const char* name);
+
+    /// Reset the table at the top of the stack to the table referenced by \p reference
+    void
+    restoreTable(int reference);
+
+    /// Push a shallow copy of the table at the top of the stack
+    void
+    copyTable();
+
     static const std::string defaultPath[];
     static const std::string defaultCPath[];
 
     lua_State* L;
 
     std::list<std::pair<std::string, Channel::Ptr>> channels;
+
+    /// Compiled chunks of execute(std::string)
+    std::unordered_map<std::string, Chunk> cachedChunks;
+
+    int globalsSnapshot;
+    int modulesSnapshot;
+    size_t channelsSnapshot;
 };
 }  // namespace script
 }  // namespace l3test
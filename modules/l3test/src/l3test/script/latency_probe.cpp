@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "latency_probe.h"
+
+#include <outpost/utils/storage/serialize.h>
+
+#include <algorithm>
+
+using namespace l3test::script;
+
+LatencyProbe::LatencyProbe() : numberOfSentPackets(0), numberOfUnexpectedPackets(0)
+{
+}
+
+void
+LatencyProbe::sent(uint32_t sequence)
+{
+    Clock::time_point now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    outstanding[sequence] = now;
+    numberOfSentPackets++;
+}
+
+bool
+LatencyProbe::received(uint32_t sequence)
+{
+    Clock::time_point now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = outstanding.find(sequence);
+    if (it == outstanding.end())
+    {
+        numberOfUnexpectedPackets++;
+        return false;
+    }
+
+    latencies.push_back(std::chrono::duration<double, std::micro>(now - it->second).count());
+    outstanding.erase(it);
+    return true;
+}
+
+bool
+LatencyProbe::received(outpost::Slice<const uint8_t> packet, size_t offset)
+{
+    if (packet.getNumberOfElements() < offset + sizeof(uint32_t))
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        numberOfUnexpectedPackets++;
+        return false;
+    }
+
+    outpost::Deserialize payload(packet.skipFirst(offset));
+    return received(payload.read<uint32_t>());
+}
+
+LatencyProbe::Statistics
+LatencyProbe::getStatistics() const
+{
+    std::vector<double> sorted;
+    Statistics statistics = Statistics();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        sorted = latencies;
+        statistics.sent = numberOfSentPackets;
+        statistics.dropped = outstanding.size();
+        statistics.unexpected = numberOfUnexpectedPackets;
+    }
+    statistics.received = sorted.size();
+
+    if (!sorted.empty())
+    {
+        std::sort(sorted.begin(), sorted.end());
+
+        double sum = 0;
+        for (double latency : sorted)
+        {
+            sum += latency;
+        }
+
+        statistics.minimum = sorted.front();
+        statistics.maximum = sorted.back();
+        statistics.mean = sum / sorted.size();
+        statistics.median = sorted[sorted.size() / 2];
+        statistics.percentile99 = sorted[(sorted.size() * 99) / 100];
+    }
+    return statistics;
+}
+
+void
+LatencyProbe::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    outstanding.clear();
+    latencies.clear();
+    numberOfSentPackets = 0;
+    numberOfUnexpectedPackets = 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SCRIPT_LATENCY_PROBE_H
+#define SCRIPT_LATENCY_PROBE_H
+
+#include <outpost/base/slice.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace l3test
+{
+namespace script
+{
+/**
+ * Measures the end-to-end latency of packets.
+ *
+ * Every packet carries a sequence number. The sender calls sent() when
+ * a packet leaves and the receiver calls received() when it arrives, the
+ * time in between is the latency of the packet. Packets which have been
+ * sent but not received are counted as dropped.
+ *
+ * All functions are thread-safe, sender and receiver are usually running
+ * in different threads.
+ */
+class LatencyProbe
+{
+public:
+    typedef std::shared_ptr<LatencyProbe> Ptr;
+    typedef std::chrono::steady_clock Clock;
+
+    struct Statistics
+    {
+        size_t sent;
+        size_t received;
+
+        /// Packets sent but not (yet) received
+        size_t dropped;
+
+        /// Received packets with an unknown or duplicated sequence number
+        size_t unexpected;
+
+        /// Latencies in microseconds, zero if no packet has been received
+        double minimum;
+        double mean;
+        double median;
+        double percentile99;
+        double maximum;
+    };
+
+    LatencyProbe();
+
+    // disable copy constructor
+    LatencyProbe(const LatencyProbe&) = delete;
+
+    // disable assignment operator
+    LatencyProbe&
+    operator=(const LatencyProbe&) = delete;
+
+    void
+    sent(uint32_t sequence);
+
+    /**
+     * \retval false The sequence number has not been sent or has already
+     *               been received.
+     */
+    bool
+    received(uint32_t sequence);
+
+    /**
+     * Read the sequence number from a received packet.
+     *
+     * \param offset
+     *      Position of the 32 bit big-endian sequence number in the packet.
+     *
+     * \retval false The packet is too short or the sequence number unknown.
+     */
+    bool
+    received(outpost::Slice<const uint8_t> packet, size_t offset);
+
+    Statistics
+    getStatistics() const;
+
+    void
+    reset();
+
+private:
+    mutable std::mutex mutex;
+
+    std::unordered_map<uint32_t, Clock::time_point> outstanding;
+    std::vector<double> latencies;
+
+    size_t numberOfSentPackets;
+    size_t numberOfUnexpectedPackets;
+};
+}  // namespace script
+}  // namespace l3test
+
+#endif  // SCRIPT_LATENCY_PROBE_H
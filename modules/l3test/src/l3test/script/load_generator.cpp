@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "load_generator.h"
+
+#include <outpost/utils/storage/serialize.h>
+
+#include <thread>
+
+using namespace l3test::script;
+
+LoadGenerator::LoadGenerator(Sink packetSink, size_t offset) :
+    sink(packetSink), sequenceOffset(offset), nextTemplate(0), nextSequence(0)
+{
+}
+
+bool
+LoadGenerator::addTemplate(outpost::Slice<const uint8_t> packet)
+{
+    if (packet.getNumberOfElements() < sequenceOffset + sizeof(uint32_t))
+    {
+        return false;
+    }
+    templates.emplace_back(packet.begin(), packet.end());
+    return true;
+}
+
+size_t
+LoadGenerator::run(const Profile& profile)
+{
+    if (templates.empty())
+    {
+        return 0;
+    }
+
+    const size_t burstSize = (profile.burstSize > 0) ? profile.burstSize : 1;
+
+    // Bursts start at fixed points in time, a late burst does not delay
+    // the following ones
+    std::chrono::duration<double> burstInterval(0);
+    if (profile.rate > 0)
+    {
+        burstInterval = std::chrono::duration<double>(burstSize / profile.rate);
+    }
+    const LatencyProbe::Clock::time_point start = LatencyProbe::Clock::now();
+
+    size_t accepted = 0;
+    for (size_t sent = 0; sent < profile.numberOfPackets; ++sent)
+    {
+        size_t burst = sent / burstSize;
+        if ((sent % burstSize == 0) && (burst > 0) && (profile.rate > 0))
+        {
+            std::this_thread::sleep_until(
+                    start
+                    + std::chrono::duration_cast<LatencyProbe::Clock::duration>(burstInterval
+                                                                                * burst));
+        }
+
+        if (sendNext())
+        {
+            accepted++;
+        }
+    }
+    return accepted;
+}
+
+bool
+LoadGenerator::sendNext()
+{
+    std::vector<uint8_t>& packet = templates[nextTemplate];
+    nextTemplate = (nextTemplate + 1) % templates.size();
+
+    uint32_t sequence = nextSequence++;
+    outpost::Serialize payload(outpost::asSlice(packet).skipFirst(sequenceOffset));
+    payload.store<uint32_t>(sequence);
+
+    // Register before sending, the receiver may run before the sink returns
+    probe.sent(sequence);
+    return sink(outpost::asSlice(packet));
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SCRIPT_LOAD_GENERATOR_H
+#define SCRIPT_LOAD_GENERATOR_H
+
+#include "latency_probe.h"
+
+#include <outpost/base/slice.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace l3test
+{
+namespace script
+{
+/**
+ * Injects packets into a component under test at a configured rate.
+ *
+ * The packets are copies of templates given by addTemplate(), used in
+ * round robin. A 32 bit big-endian sequence number is written into every
+ * packet at a fixed offset, the receiving side hands the packet to the
+ * LatencyProbe of the generator to measure the end-to-end latency.
+ *
+ * The sink connects the generator with the component under test, e.g. the
+ * SpaceWire stub read by a ProtocolDispatcherThread:
+ *
+ * \code
+ * unittest::hal::SpaceWireStub spacewire(1024);
+ * LoadGenerator::Ptr generator(new LoadGenerator(
+ *         [&](outpost::Slice<const uint8_t> packet) {
+ *             spacewire.addPacketToReceive(
+ *                     std::vector<uint8_t>(packet.begin(), packet.end()));
+ *             return true;
+ *         },
+ *         sequenceOffset));
+ *
+ * // in the listener thread of the dispatcher
+ * generator->getProbe().received(packet, sequenceOffset);
+ * \endcode
+ *
+ * Scripts access the generator after Engine::registerLoadGenerator().
+ */
+class LoadGenerator
+{
+public:
+    typedef std::shared_ptr<LoadGenerator> Ptr;
+
+    /**
+     * Injects a single packet.
+     *
+     * \retval false The packet has been rejected, it is counted as
+     *               dropped.
+     */
+    typedef std::function<bool(outpost::Slice<const uint8_t> packet)> Sink;
+
+    struct Profile
+    {
+        /// Packets per second, zero to send as fast as possible
+        double rate;
+
+        /// Packets sent back to back. The average rate is kept.
+        size_t burstSize;
+
+        size_t numberOfPackets;
+    };
+
+    /**
+     * \param sink
+     *      Receives every generated packet.
+     * \param sequenceOffset
+     *      Position of the sequence number in the packets.
+     */
+    LoadGenerator(Sink sink, size_t sequenceOffset);
+
+    // disable copy constructor
+    LoadGenerator(const LoadGenerator&) = delete;
+
+    // disable assignment operator
+    LoadGenerator&
+    operator=(const LoadGenerator&) = delete;
+
+    /**
+     * \retval false The template is too short to contain the sequence
+     *               number.
+     */
+    bool
+    addTemplate(outpost::Slice<const uint8_t> packet);
+
+    inline size_t
+    getNumberOfTemplates() const
+    {
+        return templates.size();
+    }
+
+    inline size_t
+    getSequenceOffset() const
+    {
+        return sequenceOffset;
+    }
+
+    /**
+     * Send packets following the profile, blocks until all are sent.
+     *
+     * \return Number of packets accepted by the sink.
+     */
+    size_t
+    run(const Profile& profile);
+
+    inline LatencyProbe&
+    getProbe()
+    {
+        return probe;
+    }
+
+private:
+    bool
+    sendNext();
+
+    Sink sink;
+    const size_t sequenceOffset;
+
+    std::vector<std::vector<uint8_t>> templates;
+    size_t nextTemplate;
+    uint32_t nextSequence;
+
+    LatencyProbe probe;
+};
+}  // namespace script
+}  // namespace l3test
+
+#endif  // SCRIPT_LOAD_GENERATOR_H
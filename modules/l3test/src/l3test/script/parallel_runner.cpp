@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "parallel_runner.h"
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+
+using namespace l3test::script;
+
+ParallelRunner::ParallelRunner(size_t workers) : numberOfWorkers(workers)
+{
+    if (numberOfWorkers == 0)
+    {
+        numberOfWorkers = std::thread::hardware_concurrency();
+    }
+    if (numberOfWorkers == 0)
+    {
+        // Number of cores is unknown
+        numberOfWorkers = 1;
+    }
+}
+
+void
+ParallelRunner::setSetup(Hook hook)
+{
+    setup = hook;
+}
+
+void
+ParallelRunner::setVerify(Hook hook)
+{
+    verify = hook;
+}
+
+void
+ParallelRunner::addScenario(std::string name, std::string code)
+{
+    scenarios.push_back(Scenario{std::move(name), std::move(code)});
+}
+
+std::vector<ParallelRunner::Result>
+ParallelRunner::run() const
+{
+    std::vector<Result> results(scenarios.size());
+    std::atomic<size_t> next(0);
+
+    size_t workers = std::min(numberOfWorkers, scenarios.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < workers; ++i)
+    {
+        threads.emplace_back(&ParallelRunner::work, this, std::ref(results), std::ref(next));
+    }
+
+    // The calling thread is used as one of the workers
+    work(results, next);
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    return results;
+}
+
+size_t
+ParallelRunner::getNumberOfFailures(const std::vector<Result>& results)
+{
+    size_t failures = 0;
+    for (auto& result : results)
+    {
+        if (!result.passed)
+        {
+            failures++;
+        }
+    }
+    return failures;
+}
+
+void
+ParallelRunner::work(std::vector<Result>& results, std::atomic<size_t>& next) const
+{
+    // Every result is written by exactly one worker, no locking required
+    for (size_t index = next++; index < scenarios.size(); index = next++)
+    {
+        results[index] = execute(scenarios[index]);
+    }
+}
+
+ParallelRunner::Result
+ParallelRunner::execute(const Scenario& scenario) const
+{
+    Result result{scenario.name, true, std::string()};
+    try
+    {
+        Engine engine;
+        if (setup)
+        {
+            setup(engine, scenario);
+        }
+        engine.execute(scenario.code);
+        if (verify)
+        {
+            verify(engine, scenario);
+        }
+    }
+    catch (std::exception& e)
+    {
+        result.passed = false;
+        result.message = e.what();
+    }
+    return result;
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef SCRIPT_PARALLEL_RUNNER_H
+#define SCRIPT_PARALLEL_RUNNER_H
+
+#include "engine.h"
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace l3test
+{
+namespace script
+{
+/**
+ * Runs independent Lua scenarios in parallel.
+ *
+ * Every scenario is executed in a new Engine, i.e. with its own Lua state
+ * and channels, scenarios can not influence each other. The scenarios are
+ * distributed over a number of worker threads, the results are returned in
+ * the order the scenarios were added.
+ *
+ * The setup function is called in the worker thread before a scenario is
+ * executed, e.g. to set the Lua path and register channels. The verify
+ * function is called afterwards and can check the channels. Both have to
+ * be thread-safe, a scenario fails if one of them throws an exception.
+ *
+ * \code
+ * ParallelRunner runner;
+ * runner.setSetup([](Engine& engine, const ParallelRunner::Scenario&) {
+ *     engine.appendDefaultLuaPath(path);
+ * });
+ * runner.addScenario("telecommand", code);
+ *
+ * std::vector<ParallelRunner::Result> results = runner.run();
+ * size_t failures = ParallelRunner::getNumberOfFailures(results);
+ * \endcode
+ */
+class ParallelRunner
+{
+public:
+    struct Scenario
+    {
+        std::string name;
+        std::string code;
+    };
+
+    struct Result
+    {
+        std::string name;
+        bool passed;
+
+        /// Error message of a failed scenario
+        std::string message;
+    };
+
+    typedef std::function<void(Engine& engine, const Scenario& scenario)> Hook;
+
+    /**
+     * \param numberOfWorkers
+     *      Number of worker threads, 0 to use one thread per core.
+     */
+    explicit ParallelRunner(size_t numberOfWorkers = 0);
+
+    // disable copy constructor
+    ParallelRunner(const ParallelRunner&) = delete;
+
+    // disable assignment operator
+    ParallelRunner&
+    operator=(const ParallelRunner&) = delete;
+
+    void
+    setSetup(Hook hook);
+
+    void
+    setVerify(Hook hook);
+
+    void
+    addScenario(std::string name, std::string code);
+
+    inline size_t
+    getNumberOfScenarios() const
+    {
+        return scenarios.size();
+    }
+
+    inline size_t
+    getNumberOfWorkers() const
+    {
+        return numberOfWorkers;
+    }
+
+    /**
+     * Execute all scenarios and wait until they have finished.
+     *
+     * \return One result per scenario in the order of addScenario().
+     */
+    std::vector<Result>
+    run() const;
+
+    static size_t
+    getNumberOfFailures(const std::vector<Result>& results);
+
+private:
+    void
+    work(std::vector<Result>& results, std::atomic<size_t>& next) const;
+
+    Result
+    execute(const Scenario& scenario) const;
+
+    size_t numberOfWorkers;
+    std::vector<Scenario> scenarios;
+
+    Hook setup;
+    Hook verify;
+};
+}  // namespace script
+}  // namespace l3test
+
+#endif  // SCRIPT_PARALLEL_RUNNER_H
@@ -116,3 +116,75 @@ TEST(ChannelTest, receiveMultiplePacketsAndValidateData)
 
     EXPECT_FALSE(channel.hasPacket());
 }
+
+TEST(ChannelTest, packetDataIsAccessibleInPlace)
+{
+    Channel channel;
+
+    uint8_t data[5] = {1, 2, 3, 4, 5};
+    channel.append(data, 2);
+    channel.append(data + 2, 3);
+    channel.finishPacket();
+
+    outpost::Slice<const uint8_t> packet = channel.getPacketData();
+    ASSERT_EQ(5U, packet.getNumberOfElements());
+    EXPECT_ARRAY_EQ(uint8_t, data, packet.begin(), 5);
+
+    uint8_t copy[3];
+    EXPECT_EQ(3U, channel.getPacket(copy, sizeof(copy)));
+    EXPECT_ARRAY_EQ(uint8_t, data, copy, 3);
+}
+
+TEST(ChannelTest, emptyPacketsAreStored)
+{
+    Channel channel;
+
+    channel.finishPacket();
+    channel.finishPacket();
+
+    ASSERT_EQ(2U, channel.getNumberOfPackets());
+    EXPECT_EQ(0U, channel.getPacketLength());
+    EXPECT_EQ(0U, channel.getPacket().size());
+}
+
+/*
+ * Pump packets of varying length through the channel while keeping a
+ * varying number of them stored, which exercises the wrap-around and the
+ * growing of the storage.
+ */
+TEST(ChannelTest, manyPacketsKeepOrderAndContent)
+{
+    Channel channel;
+    uint8_t data[300];
+    for (size_t i = 0; i < sizeof(data); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    size_t sent = 0;
+    size_t received = 0;
+    for (size_t round = 0; round < 2000; ++round)
+    {
+        const size_t burst = (round % 7) + 1;
+        for (size_t n = 0; n < burst; ++n)
+        {
+            const size_t length = (sent * 37) % sizeof(data);
+            channel.append(data, length / 2);
+            channel.append(data + length / 2, length - length / 2);
+            channel.finishPacket();
+            sent++;
+        }
+
+        const size_t drain = (round % 5) + 1;
+        for (size_t n = 0; (n < drain) && channel.hasPacket(); ++n)
+        {
+            const size_t length = (received * 37) % sizeof(data);
+            outpost::Slice<const uint8_t> packet = channel.getPacketData();
+            ASSERT_EQ(length, packet.getNumberOfElements());
+            EXPECT_ARRAY_EQ(uint8_t, data, packet.begin(), length);
+            channel.nextPacket();
+            received++;
+        }
+        ASSERT_EQ(sent - received, channel.getNumberOfPackets());
+    }
+}
@@ -12,6 +12,7 @@
  */
 
 #include <l3test/script/engine.h>
+#include <lua/exception.h>
 
 #include <unittest/harness.h>
 
@@ -161,3 +162,146 @@ assert(packet[5], 4)
 assert(packet[6], 3)
 )--");
 }
+
+TEST(EngineTest, exchangeStringsWithLua)
+{
+    Engine engine;
+    Channel::Ptr tc(new Channel);
+    Channel::Ptr tm(new Channel);
+
+    engine.registerChannel(tc, "tc");
+    engine.registerChannel(tm, "tm");
+
+    uint8_t data[4] = {0x41, 0x00, 0xFF, 0x42};
+    tc->append(data, sizeof(data));
+    tc->finishPacket();
+
+    engine.execute(R"--(
+assert(tc:getLength() == 4, "wrong packet length")
+assert(tc:getByte(3) == 255, "wrong byte")
+
+packet = tc:getString()
+tc:next()
+
+assert(#packet == 4, "wrong packet size")
+tm:send(packet)
+)--");
+
+    ASSERT_TRUE(tm->hasPacket());
+    outpost::Slice<const uint8_t> packet = tm->getPacketData();
+    ASSERT_EQ(4U, packet.getNumberOfElements());
+    EXPECT_ARRAY_EQ(uint8_t, data, packet.begin(), 4);
+}
+
+TEST(EngineTest, exchangeBuffersWithLua)
+{
+    Engine engine;
+    Channel::Ptr tc(new Channel);
+    Channel::Ptr tm(new Channel);
+
+    engine.registerChannel(tc, "tc");
+    engine.registerChannel(tm, "tm");
+
+    uint8_t data[4] = {0x41, 0x00, 0xFF, 0x42};
+    tc->append(data, sizeof(data));
+    tc->finishPacket();
+
+    engine.execute(R"--(
+local buffer = require "buffer"
+
+local packet = tc:getBuffer()
+tc:next()
+assert(#packet == 4, "wrong packet size")
+
+-- views share the memory of the packet
+local payload = packet:view(2, 3)
+payload:set(1, 0x10)
+assert(packet:get(2) == 0x10, "view is not shared")
+assert(payload:string() == "\x10\xFF", "wrong view content")
+
+local frame = buffer.new(6)
+frame:write(2, packet)
+tm:send(frame:view(2, 5))
+)--");
+
+    ASSERT_TRUE(tm->hasPacket());
+    outpost::Slice<const uint8_t> packet = tm->getPacketData();
+    ASSERT_EQ(4U, packet.getNumberOfElements());
+    EXPECT_EQ(0x41, packet[0]);
+    EXPECT_EQ(0x10, packet[1]);
+    EXPECT_EQ(0xFF, packet[2]);
+    EXPECT_EQ(0x42, packet[3]);
+}
+
+TEST(EngineTest, compiledChunkCanBeExecutedRepeatedly)
+{
+    Engine engine;
+    Channel::Ptr channel(new Channel);
+    engine.registerChannel(channel, "tm");
+
+    engine.execute("counter = 0");
+    Engine::Chunk chunk = engine.compile("counter = counter + 1; tm:send(counter)", "step");
+    ASSERT_NE(Engine::invalidChunk, chunk);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        engine.execute(chunk);
+    }
+    engine.release(chunk);
+
+    ASSERT_EQ(3U, channel->getNumberOfPackets());
+    channel->nextPacket();
+    channel->nextPacket();
+    EXPECT_EQ(3U, channel->getPacketData()[0]);
+}
+
+TEST(EngineTest, invalidCodeIsNotCompiled)
+{
+    Engine engine;
+
+    EXPECT_EQ(Engine::invalidChunk, engine.compile("this is not lua"));
+    EXPECT_THROW(engine.execute(Engine::invalidChunk), lua::Exception);
+}
+
+TEST(EngineTest, repeatedCodeReusesCompiledChunk)
+{
+    Engine engine;
+    Channel::Ptr channel(new Channel);
+    engine.registerChannel(channel, "tm");
+
+    engine.execute("value = 1");
+    for (int i = 0; i < 2; ++i)
+    {
+        engine.execute("tm:send(value); value = value + 1");
+    }
+
+    ASSERT_EQ(2U, channel->getNumberOfPackets());
+    EXPECT_EQ(1U, channel->getPacketData()[0]);
+    channel->nextPacket();
+    EXPECT_EQ(2U, channel->getPacketData()[0]);
+}
+
+TEST(EngineTest, restoreRevertsGlobalsAndModules)
+{
+    Engine engine;
+    EXPECT_FALSE(engine.restore());
+
+    engine.execute("kept = 1; changed = 1; removed = 1");
+    engine.snapshot();
+
+    engine.execute(R"--(
+changed = 2
+removed = nil
+added = 3
+package.loaded.testmodule = {}
+)--");
+    ASSERT_TRUE(engine.restore());
+
+    engine.execute(R"--(
+assert(kept == 1, "kept global lost")
+assert(changed == 1, "changed global not reverted")
+assert(removed == 1, "removed global not restored")
+assert(added == nil, "added global not removed")
+assert(package.loaded.testmodule == nil, "module not unloaded")
+)--");
+}
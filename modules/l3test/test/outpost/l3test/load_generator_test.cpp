@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <l3test/script/engine.h>
+#include <l3test/script/load_generator.h>
+
+#include <unittest/harness.h>
+
+#include <chrono>
+#include <vector>
+
+using namespace l3test::script;
+
+class LoadGeneratorTest : public testing::Test
+{
+public:
+    LoadGeneratorTest() :
+        generator(new LoadGenerator(
+                [this](outpost::Slice<const uint8_t> packet) {
+                    packets.emplace_back(packet.begin(), packet.end());
+                    return accept;
+                },
+                1)),
+        accept(true)
+    {
+    }
+
+    LoadGenerator::Ptr generator;
+    std::vector<std::vector<uint8_t>> packets;
+    bool accept;
+};
+
+TEST_F(LoadGeneratorTest, shouldRejectTemplatesWithoutSpaceForTheSequenceNumber)
+{
+    uint8_t shortPacket[4] = {};
+    uint8_t packet[5] = {};
+
+    EXPECT_FALSE(generator->addTemplate(outpost::asSlice(shortPacket)));
+    EXPECT_TRUE(generator->addTemplate(outpost::asSlice(packet)));
+    EXPECT_EQ(1U, generator->getNumberOfTemplates());
+}
+
+TEST_F(LoadGeneratorTest, shouldSendTemplatesInRoundRobinWithSequenceNumbers)
+{
+    uint8_t first[6] = {0xA0, 0, 0, 0, 0, 0xA5};
+    uint8_t second[5] = {0xB0, 0, 0, 0, 0};
+    generator->addTemplate(outpost::asSlice(first));
+    generator->addTemplate(outpost::asSlice(second));
+
+    LoadGenerator::Profile profile = {0, 1, 3};
+    EXPECT_EQ(3U, generator->run(profile));
+
+    ASSERT_EQ(3U, packets.size());
+    EXPECT_EQ((std::vector<uint8_t>{0xA0, 0, 0, 0, 0, 0xA5}), packets[0]);
+    EXPECT_EQ((std::vector<uint8_t>{0xB0, 0, 0, 0, 1}), packets[1]);
+    EXPECT_EQ((std::vector<uint8_t>{0xA0, 0, 0, 0, 2, 0xA5}), packets[2]);
+}
+
+TEST_F(LoadGeneratorTest, shouldKeepTheConfiguredRate)
+{
+    uint8_t packet[5] = {};
+    generator->addTemplate(outpost::asSlice(packet));
+
+    // Three bursts of ten packets, 10 ms apart
+    LoadGenerator::Profile profile = {1000, 10, 30};
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(30U, generator->run(profile));
+    auto duration = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(30U, packets.size());
+    EXPECT_LE(std::chrono::milliseconds(20), duration);
+}
+
+TEST_F(LoadGeneratorTest, shouldCountLatenciesAndDrops)
+{
+    uint8_t packet[5] = {};
+    generator->addTemplate(outpost::asSlice(packet));
+
+    LoadGenerator::Profile profile = {0, 1, 4};
+    generator->run(profile);
+
+    accept = false;
+    EXPECT_EQ(0U, generator->run(profile));
+
+    LatencyProbe& probe = generator->getProbe();
+    EXPECT_TRUE(probe.received(outpost::asSlice(packets[0]), 1));
+    EXPECT_TRUE(probe.received(outpost::asSlice(packets[2]), 1));
+
+    // Duplicates and truncated packets
+    EXPECT_FALSE(probe.received(outpost::asSlice(packets[2]), 1));
+    EXPECT_FALSE(probe.received(outpost::asSlice(packets[1]).first(4), 1));
+
+    LatencyProbe::Statistics statistics = probe.getStatistics();
+    EXPECT_EQ(8U, statistics.sent);
+    EXPECT_EQ(2U, statistics.received);
+    EXPECT_EQ(6U, statistics.dropped);
+    EXPECT_EQ(2U, statistics.unexpected);
+    EXPECT_LE(statistics.minimum, statistics.mean);
+    EXPECT_LE(statistics.mean, statistics.maximum);
+
+    probe.reset();
+    EXPECT_EQ(0U, probe.getStatistics().sent);
+}
+
+TEST_F(LoadGeneratorTest, shouldBeControlledFromLua)
+{
+    Engine engine;
+    Channel::Ptr tm(new Channel);
+    engine.registerChannel(tm, "tm");
+    engine.registerLoadGenerator(generator, "probe.load");
+
+    engine.execute(R"--(
+probe.load:add("\x01\x00\x00\x00\x00\x02")
+assert(probe.load:run{ rate = 0, burst = 2, count = 4 } == 4)
+)--");
+
+    // Loop back the first three packets
+    ASSERT_EQ(4U, packets.size());
+    for (size_t i = 0; i < 3; ++i)
+    {
+        tm->append(&packets[i].front(), packets[i].size());
+        tm->finishPacket();
+    }
+
+    engine.execute(R"--(
+assert(probe.load:collect(tm) == 3)
+assert(not tm:hasPacket())
+
+local s = probe.load:statistics()
+assert(s.sent == 4, "sent")
+assert(s.received == 3, "received")
+assert(s.dropped == 1, "dropped")
+assert(s.minimum <= s.percentile99)
+)--");
+}
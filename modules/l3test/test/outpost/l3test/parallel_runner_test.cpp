@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <l3test/script/parallel_runner.h>
+
+#include <unittest/harness.h>
+
+#include <stdexcept>
+
+using namespace l3test::script;
+
+TEST(ParallelRunnerTest, shouldUseAtLeastOneWorker)
+{
+    ParallelRunner runner;
+    EXPECT_LE(1U, runner.getNumberOfWorkers());
+
+    ParallelRunner single(1);
+    EXPECT_EQ(1U, single.getNumberOfWorkers());
+    EXPECT_TRUE(single.run().empty());
+}
+
+TEST(ParallelRunnerTest, shouldReturnResultsInOrderOfScenarios)
+{
+    ParallelRunner runner(4);
+    runner.addScenario("first", "x = 1");
+    runner.addScenario("failing", "error('scenario failed')");
+    runner.addScenario("syntax", "x = ");
+    runner.addScenario("last", "x = 2");
+
+    std::vector<ParallelRunner::Result> results = runner.run();
+
+    ASSERT_EQ(4U, results.size());
+    EXPECT_EQ("first", results[0].name);
+    EXPECT_TRUE(results[0].passed);
+    EXPECT_EQ("failing", results[1].name);
+    EXPECT_FALSE(results[1].passed);
+    EXPECT_NE(std::string::npos, results[1].message.find("scenario failed"));
+    EXPECT_FALSE(results[2].passed);
+    EXPECT_TRUE(results[3].passed);
+
+    EXPECT_EQ(2U, ParallelRunner::getNumberOfFailures(results));
+}
+
+TEST(ParallelRunnerTest, shouldIsolateScenarios)
+{
+    ParallelRunner runner(2);
+    runner.setSetup([](Engine& engine, const ParallelRunner::Scenario&) {
+        engine.registerChannel(Channel::Ptr(new Channel), "tm");
+    });
+    runner.setVerify([](Engine& engine, const ParallelRunner::Scenario&) {
+        if (engine.getChannel("tm")->getNumberOfPackets() != 1)
+        {
+            throw std::runtime_error("expected a single packet");
+        }
+    });
+
+    // Every scenario sees a fresh state, the global is never set before
+    for (int i = 0; i < 16; ++i)
+    {
+        runner.addScenario("scenario", R"--(
+assert(counter == nil, "state shared between scenarios")
+counter = 1
+tm:send(counter)
+)--");
+    }
+
+    std::vector<ParallelRunner::Result> results = runner.run();
+    ASSERT_EQ(16U, results.size());
+    for (auto& result : results)
+    {
+        EXPECT_TRUE(result.passed) << result.message;
+    }
+}
+
+TEST(ParallelRunnerTest, shouldFailScenarioIfVerifyThrows)
+{
+    ParallelRunner runner(1);
+    runner.setVerify([](Engine&, const ParallelRunner::Scenario& scenario) {
+        throw std::runtime_error(scenario.name + " not verified");
+    });
+    runner.addScenario("a", "");
+
+    std::vector<ParallelRunner::Result> results = runner.run();
+    ASSERT_EQ(1U, results.size());
+    EXPECT_FALSE(results[0].passed);
+    EXPECT_EQ("a not verified", results[0].message);
+}
@@ -48,6 +48,11 @@ endif
 # Filter for the Unittest runners.
 GTEST_FILTER ?= *
 
+# Benchmark programs of the module, relative to the module folder. Each one
+# writes JSON records (see outpost/utils/benchmark/benchmark_record.h) to
+# `$(BUILDPATH)/benchmark/<module>-<folder>.json`.
+BENCHMARKS ?= benchmark
+
 LCOV_DEFAULT_REMOVE_PATTERN = "/usr*" "test/*" "default/*" "tools/*" "utils-ext/*"
 
 # Path relative from the module folders (e.g. '/trunk/modules/pus').
@@ -90,6 +95,13 @@ test-verbose-default:
 	@mkdir -p $(BUILDPATH)/test
 	@python3 $(ROOTPATH)/tools/gtest_process_skipped.py $(BUILDPATH)/$(MODULE)/test/unittest/coverage.xml $(BUILDPATH)/test/$(MODULE).xml
     
+benchmark-default:
+	@mkdir -p $(BUILDPATH)/benchmark
+	@for b in $(BENCHMARKS); do \
+		scons -C $$b -Q $(MAKEJOBS) install || return 1 ; \
+		$$b/bin/benchmark > $(BUILDPATH)/benchmark/$(MODULE)-$$(echo $$b | tr / -).json || return 1 ; \
+	done
+
 cppcheck:
 	@scons -C test/ compiledb -D append_buildpath=compiledb
 	@mkdir -p $(BUILDPATH)/cppcheck;
@@ -220,4 +232,4 @@ clean-default:
 distclean-default:
 	@scons build coverage=1 -Q -C test/unit -c
 
-.PHONY: build-lua test-default coverage-default coverage-html-default cppcheck cppcheck-tests cppcheck-unittests
+.PHONY: build-lua test-default benchmark-default coverage-default coverage-html-default cppcheck cppcheck-tests cppcheck-unittests
@@ -23,6 +23,9 @@
  */
 
 #include "rtos/clock.h"
+#include "rtos/cycle_clock.h"
+#include "rtos/event_group.h"
+#include "rtos/memory.h"
 #include "rtos/mutex.h"
 #include "rtos/periodic_task_manager.h"
 #include "rtos/queue.h"
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_FREERTOS_ATOMIC_H
+#define OUTPOST_RTOS_FREERTOS_ATOMIC_H
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Atomic integral value.
+ *
+ * Provides the atomic operations needed by the library (e.g. for
+ * reference counting) without taking a mutex.
+ *
+ * For values up to the size of a machine word, load() and store() are
+ * single aligned accesses with memory barriers (GCC __atomic builtins).
+ * They can also be used from an ISR, e.g. for the indices of a
+ * single-producer single-consumer ring shared with a driver.
+ *
+ * Not all FreeRTOS targets provide atomic read-modify-write instructions
+ * (e.g. Cortex-M0). Where the core has them, the read-modify-write
+ * operations use them as well and are ISR-safe. Otherwise, and for loads
+ * and stores of wider values, the operations are implemented as short
+ * FreeRTOS critical sections (interrupt masking) and must not be called
+ * from an ISR.
+ *
+ * \tparam T
+ *      Integral type of the stored value.
+ *
+ * \ingroup    rtos
+ */
+template <typename T>
+class Atomic
+{
+public:
+    constexpr explicit Atomic(T value = T()) : mValue(value)
+    {
+    }
+
+    // disable copy constructor
+    Atomic(const Atomic& other) = delete;
+
+    // disable assignment operator
+    Atomic&
+    operator=(const Atomic& other) = delete;
+
+    inline T
+    load() const
+    {
+        if (isWordSized())
+        {
+            return __atomic_load_n(&mValue, __ATOMIC_SEQ_CST);
+        }
+        taskENTER_CRITICAL();
+        T value = mValue;
+        taskEXIT_CRITICAL();
+        return value;
+    }
+
+    inline void
+    store(T value)
+    {
+        if (isWordSized())
+        {
+            __atomic_store_n(&mValue, value, __ATOMIC_SEQ_CST);
+            return;
+        }
+        taskENTER_CRITICAL();
+        mValue = value;
+        taskEXIT_CRITICAL();
+    }
+
+    /**
+     * Add \p value and return the value held previously.
+     */
+    inline T
+    fetchAdd(T value)
+    {
+        if (hasAtomicInstructions())
+        {
+            return __atomic_fetch_add(&mValue, value, __ATOMIC_SEQ_CST);
+        }
+        taskENTER_CRITICAL();
+        T previous = mValue;
+        mValue = previous + value;
+        taskEXIT_CRITICAL();
+        return previous;
+    }
+
+    /**
+     * Subtract \p value and return the value held previously.
+     */
+    inline T
+    fetchSub(T value)
+    {
+        if (hasAtomicInstructions())
+        {
+            return __atomic_fetch_sub(&mValue, value, __ATOMIC_SEQ_CST);
+        }
+        taskENTER_CRITICAL();
+        T previous = mValue;
+        mValue = previous - value;
+        taskEXIT_CRITICAL();
+        return previous;
+    }
+
+    /**
+     * Replace the value with \p desired if it currently equals \p expected.
+     *
+     * \param expected
+     *      Expected value. Is updated with the current value if the
+     *      exchange fails.
+     * \param desired
+     *      New value.
+     *
+     * \retval true     Value was exchanged.
+     * \retval false    Value differed from \p expected.
+     */
+    inline bool
+    compareAndSwap(T& expected, T desired)
+    {
+        if (hasAtomicInstructions())
+        {
+            return __atomic_compare_exchange_n(
+                    &mValue, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+        }
+        bool exchanged = false;
+        taskENTER_CRITICAL();
+        if (mValue == expected)
+        {
+            mValue = desired;
+            exchanged = true;
+        }
+        else
+        {
+            expected = mValue;
+        }
+        taskEXIT_CRITICAL();
+        return exchanged;
+    }
+
+private:
+    /**
+     * Loads and stores of \p T are single accesses.
+     *
+     * Evaluated at compile time like hasAtomicInstructions(), the unused
+     * branch is removed.
+     */
+    static constexpr bool
+    isWordSized()
+    {
+        return sizeof(T) <= sizeof(void*);
+    }
+
+    /**
+     * Read-modify-write instructions are available for \p T.
+     */
+    static constexpr bool
+    hasAtomicInstructions()
+    {
+        return __atomic_always_lock_free(sizeof(T), 0);
+    }
+
+    volatile T mValue;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
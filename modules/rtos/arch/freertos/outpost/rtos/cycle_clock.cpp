@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "cycle_clock.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace
+{
+// Tick count of the last call and the ticks of all previous wraps
+portTickType lastTickCount = 0;
+outpost::rtos::CycleClock::Ticks wrappedTicks = 0;
+}  // namespace
+
+outpost::rtos::CycleClock::Ticks __attribute__((weak)) outpost::rtos::CycleClock::now()
+{
+    // Range of the tick count, zero for a 64 bit tick count which never wraps
+    const Ticks range = static_cast<Ticks>(portMAX_DELAY) + 1;
+
+    taskENTER_CRITICAL();
+    const portTickType ticks = xTaskGetTickCount();
+    if (ticks < lastTickCount)
+    {
+        wrappedTicks += range;
+    }
+    lastTickCount = ticks;
+    const Ticks result = wrappedTicks + ticks;
+    taskEXIT_CRITICAL();
+
+    return result;
+}
+
+uint64_t __attribute__((weak)) outpost::rtos::CycleClock::getFrequency()
+{
+    return configTICK_RATE_HZ;
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_FREERTOS_CYCLE_CLOCK_H
+#define OUTPOST_RTOS_FREERTOS_CYCLE_CLOCK_H
+
+#include <outpost/rtos/cycle_clock_conversion.h>
+#include <outpost/time/duration.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Cheap timestamps for fine-grained time measurements.
+ *
+ * In contrast to SystemClock the functions are not virtual.
+ *
+ * The default implementation uses the FreeRTOS tick count, which has only
+ * the resolution of the scheduler tick. The tick count is extended to
+ * 64 bit so that differences stay valid across a wrap of the tick count.
+ * This requires now() to be called at least once per wrap period (about
+ * 49 days for a 32 bit tick count at 1 kHz), it must not be called from
+ * an interrupt.
+ *
+ * Boards with a free-running hardware counter (e.g. the Cortex-M DWT
+ * cycle counter) should provide their own now() and getFrequency(), both
+ * are weak symbols. Such an implementation has to return 64 bit values as
+ * well.
+ *
+ * \code
+ * CycleClock::Ticks start = CycleClock::now();
+ * ...
+ * time::Duration elapsed = CycleClock::toDuration(CycleClock::now() - start);
+ * \endcode
+ *
+ * \ingroup    rtos
+ */
+class CycleClock
+{
+public:
+    typedef uint64_t Ticks;
+
+    static Ticks
+    now();
+
+    /**
+     * Number of ticks per second.
+     */
+    static uint64_t
+    getFrequency();
+
+    static inline time::Duration
+    toDuration(Ticks ticks)
+    {
+        return convertTicksToDuration(ticks, getFrequency());
+    }
+
+private:
+    // Only static functions
+    CycleClock() = delete;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
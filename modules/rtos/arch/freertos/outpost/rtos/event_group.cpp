@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "event_group.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+
+#include <outpost/rtos/failure_handler.h>
+
+using outpost::rtos::EventGroup;
+
+constexpr EventGroup::Bits EventGroup::usableBits;
+
+static portTickType
+toTicks(outpost::time::Duration timeout)
+{
+    if (timeout == outpost::time::Duration::infinity())
+    {
+        return portMAX_DELAY;
+    }
+    return (timeout.milliseconds() * configTICK_RATE_HZ) / 1000;
+}
+
+EventGroup::EventGroup()
+{
+    mHandle = xEventGroupCreate();
+    if (mHandle == 0)
+    {
+        FailureHandler::fatal(FailureCode::resourceAllocationFailed(Resource::eventGroup));
+    }
+}
+
+EventGroup::~EventGroup()
+{
+    vEventGroupDelete(static_cast<EventGroupHandle_t>(mHandle));
+}
+
+void
+EventGroup::set(Bits bits)
+{
+    xEventGroupSetBits(static_cast<EventGroupHandle_t>(mHandle), bits & usableBits);
+}
+
+void
+EventGroup::setFromInterrupt(Bits bits)
+{
+    portBASE_TYPE higherPriorityTaskWoken = pdFALSE;
+    xEventGroupSetBitsFromISR(
+            static_cast<EventGroupHandle_t>(mHandle), bits & usableBits, &higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+void
+EventGroup::clear(Bits bits)
+{
+    xEventGroupClearBits(static_cast<EventGroupHandle_t>(mHandle), bits & usableBits);
+}
+
+EventGroup::Bits
+EventGroup::get() const
+{
+    return xEventGroupGetBits(static_cast<EventGroupHandle_t>(mHandle));
+}
+
+EventGroup::Bits
+EventGroup::waitAny(Bits bits, outpost::time::Duration timeout, bool clearOnExit)
+{
+    const EventBits_t result = xEventGroupWaitBits(static_cast<EventGroupHandle_t>(mHandle),
+                                                   bits & usableBits,
+                                                   clearOnExit ? pdTRUE : pdFALSE,
+                                                   pdFALSE,
+                                                   toTicks(timeout));
+    return (result & bits);
+}
+
+EventGroup::Bits
+EventGroup::waitAll(Bits bits, outpost::time::Duration timeout, bool clearOnExit)
+{
+    const EventBits_t result = xEventGroupWaitBits(static_cast<EventGroupHandle_t>(mHandle),
+                                                   bits & usableBits,
+                                                   clearOnExit ? pdTRUE : pdFALSE,
+                                                   pdTRUE,
+                                                   toTicks(timeout));
+    return ((result & bits) == bits) ? bits : 0;
+}
@@ -23,11 +23,22 @@
 
 using namespace outpost::rtos;
 
-PeriodicTaskManager::PeriodicTaskManager() :
+typedef Traits<portTickType>::SignedType SignedTickType;
+
+static outpost::time::Duration
+toDuration(int64_t ticks)
+{
+    return outpost::time::Microseconds((ticks * 1000000) / configTICK_RATE_HZ);
+}
+
+PeriodicTaskManager::PeriodicTaskManager(OverrunPolicy::Type policy) :
     mMutex(),
+    mPolicy(policy),
     mTimerRunning(false),
     mLastWakeTime(),
-    mCurrentPeriod()
+    mCurrentPeriod(),
+    mPeriodStart(),
+    mStatistics()
 {
 }
 
@@ -42,20 +53,40 @@ PeriodicTaskManager::nextPeriod(time::Duration period)
     Status::Type currentStatus = Status::running;
 
     const portTickType nextPeriodTicks = (period.milliseconds() * configTICK_RATE_HZ) / 1000;
+    const portTickType currentTime = xTaskGetTickCount();
     if (mTimerRunning)
     {
-        if (static_cast<Traits<portTickType>::SignedType>(xTaskGetTickCount() - mLastWakeTime)
-            > static_cast<Traits<portTickType>::SignedType>(mCurrentPeriod))
+        const SignedTickType lateness =
+                static_cast<SignedTickType>(currentTime - mLastWakeTime)
+                - static_cast<SignedTickType>(mCurrentPeriod);
+        const portTickType executionTime = currentTime - mPeriodStart;
+        mStatistics.recordEnd(toDuration(executionTime), toDuration(lateness));
+
+        if (lateness > 0)
         {
             currentStatus = Status::timeout;
+            if ((mPolicy == OverrunPolicy::skip) && (mCurrentPeriod > 0))
+            {
+                // Move the wake time forward to the period which contains
+                // the current tick, vTaskDelayUntil() then returns
+                // immediately
+                const portTickType skipped = static_cast<portTickType>(lateness) / mCurrentPeriod;
+                mLastWakeTime += skipped * mCurrentPeriod;
+                mStatistics.recordSkippedPeriods(skipped);
+            }
         }
 
         vTaskDelayUntil(&mLastWakeTime, mCurrentPeriod);
+
+        mPeriodStart = xTaskGetTickCount();
+        const portTickType jitter = mPeriodStart - mLastWakeTime;
+        mStatistics.recordStart(toDuration(jitter));
     }
     else
     {
         // period is started now, no need to wait
-        mLastWakeTime = xTaskGetTickCount();
+        mLastWakeTime = currentTime;
+        mPeriodStart = currentTime;
         mTimerRunning = true;
     }
 
@@ -89,3 +120,17 @@ PeriodicTaskManager::cancel()
     MutexGuard lock(mMutex);
     mTimerRunning = false;
 }
+
+PeriodicTaskStatistics
+PeriodicTaskManager::getStatistics()
+{
+    MutexGuard lock(mMutex);
+    return mStatistics;
+}
+
+void
+PeriodicTaskManager::resetStatistics()
+{
+    MutexGuard lock(mMutex);
+    mStatistics.reset();
+}
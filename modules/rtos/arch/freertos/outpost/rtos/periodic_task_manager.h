@@ -18,6 +18,7 @@
 
 #include <outpost/rtos/failure_handler.h>
 #include <outpost/rtos/mutex.h>
+#include <outpost/rtos/periodic_task_statistics.h>
 #include <outpost/time/duration.h>
 
 namespace outpost
@@ -50,7 +51,28 @@ public:
         };
     };
 
-    PeriodicTaskManager();
+    /**
+     * Handling of periods which have passed when nextPeriod() is called
+     * too late.
+     *
+     * In both cases the periods stay aligned to the tick of the first
+     * call of nextPeriod(), overruns do not introduce a drift.
+     */
+    struct OverrunPolicy
+    {
+        enum Type
+        {
+            /// Every missed period is started immediately, until the task
+            /// is back on schedule
+            catchUp,
+
+            /// Periods which have already ended are dropped, the period
+            /// in which nextPeriod() is called is started immediately
+            skip
+        };
+    };
+
+    explicit PeriodicTaskManager(OverrunPolicy::Type policy = OverrunPolicy::catchUp);
 
     ~PeriodicTaskManager();
 
@@ -106,11 +128,29 @@ public:
     void
     cancel();
 
+    /**
+     * Get the timing statistics since the creation or the last call of
+     * resetStatistics().
+     *
+     * The values have the resolution of the system tick.
+     */
+    PeriodicTaskStatistics
+    getStatistics();
+
+    void
+    resetStatistics();
+
 private:
     Mutex mMutex;
+    const OverrunPolicy::Type mPolicy;
     bool mTimerRunning;
     portTickType mLastWakeTime;
     portTickType mCurrentPeriod;
+
+    /// Tick at which nextPeriod() returned
+    portTickType mPeriodStart;
+
+    PeriodicTaskStatistics mStatistics;
 };
 }  // namespace rtos
 }  // namespace outpost
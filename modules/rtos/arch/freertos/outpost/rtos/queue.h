@@ -15,6 +15,9 @@
 #ifndef OUTPOST_RTOS_FREERTOS_QUEUE_H
 #define OUTPOST_RTOS_FREERTOS_QUEUE_H
 
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
 #include <outpost/time/duration.h>
 
 #include <stddef.h>
@@ -92,10 +95,65 @@ public:
     bool
     receive(T& data, outpost::time::Duration timeout);
 
+protected:
+    /**
+     * Create a Queue which uses the given storage, see StaticQueue.
+     *
+     * Requires \c configSUPPORT_STATIC_ALLOCATION, otherwise the queue
+     * is allocated from the FreeRTOS heap.
+     *
+     * \param numberOfItems
+     *      The maximum number of items that the queue can contain.
+     * \param storage
+     *      Buffer for \p numberOfItems items, must outlive the queue.
+     * \param control
+     *      Memory for the queue control block.
+     */
+    Queue(size_t numberOfItems, uint8_t* storage, StaticQueue_t* control);
+
 private:
     void* mHandle;
 };
 
+namespace internal
+{
+/**
+ * Storage of a StaticQueue.
+ *
+ * Base class of StaticQueue so that it is constructed before the queue.
+ */
+template <typename T, size_t N>
+struct StaticQueueStorage
+{
+    uint8_t mItems[N * sizeof(T)];
+    StaticQueue_t mControl;
+};
+}  // namespace internal
+
+/**
+ * Queue with the buffer inside the object.
+ *
+ * Same as Queue but created with xQueueCreateStatic(), the FreeRTOS heap
+ * is not used.
+ *
+ * \tparam T
+ *      Type of the items, limited to POD types.
+ * \tparam N
+ *      The maximum number of items that the queue can contain.
+ *
+ * \ingroup rtos
+ */
+template <typename T, size_t N>
+class StaticQueue : private internal::StaticQueueStorage<T, N>, public Queue<T>
+{
+    static_assert(N > 0, "Queue must hold at least one item");
+
+public:
+    StaticQueue() : Queue<T>(N, this->mItems, &this->mControl)
+    {
+    }
+};
+
 }  // namespace rtos
 }  // namespace outpost
 
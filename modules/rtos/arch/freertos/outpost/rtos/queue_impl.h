@@ -32,6 +32,23 @@ outpost::rtos::Queue<T>::Queue(size_t numberOfItems)
     }
 }
 
+template <typename T>
+outpost::rtos::Queue<T>::Queue(size_t numberOfItems, uint8_t* storage, StaticQueue_t* control)
+{
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    mHandle = xQueueCreateStatic(numberOfItems, sizeof(T), storage, control);
+#else
+    (void) storage;
+    (void) control;
+    mHandle = xQueueCreate(numberOfItems, sizeof(T));
+#endif
+
+    if (mHandle == 0)
+    {
+        FailureHandler::fatal(FailureCode::resourceAllocationFailed(Resource::messageQueue));
+    }
+}
+
 template <typename T>
 outpost::rtos::Queue<T>::~Queue()
 {
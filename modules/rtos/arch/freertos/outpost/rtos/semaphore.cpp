@@ -108,3 +108,11 @@ outpost::rtos::BinarySemaphore::release()
 {
     xSemaphoreGive(mHandle);
 }
+
+void
+outpost::rtos::BinarySemaphore::releaseFromInterrupt()
+{
+    portBASE_TYPE higherPriorityTaskWoken = pdFALSE;
+    xSemaphoreGiveFromISR(mHandle, &higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
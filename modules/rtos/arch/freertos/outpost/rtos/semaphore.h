@@ -181,6 +181,16 @@ public:
     void
     release();
 
+    /**
+     * Increment the count from an interrupt handler.
+     *
+     * Same as release() but may only be called from interrupt context.
+     * Requests a context switch at the end of the interrupt if a thread
+     * with a higher priority has been woken.
+     */
+    void
+    releaseFromInterrupt();
+
 private:
     void* mHandle;
 };
@@ -20,12 +20,21 @@
 #include <freertos/task.h>
 
 #include <outpost/rtos/failure_handler.h>
+#include <outpost/rtos/thread_profiler.h>
 
 #include <stdio.h>
 
 /// Minimum stack size configured through the FreeRTOS configuration.
 static const size_t minimumStackSize = configMINIMAL_STACK_SIZE * sizeof(portSTACK_TYPE);
 
+/**
+ * Frequency of the counter used for the run time statistics
+ * (portGET_RUN_TIME_COUNTER_VALUE()) in Hz.
+ */
+#ifndef OUTPOST_RTOS_FREERTOS_RUN_TIME_COUNTER_FREQUENCY
+#define OUTPOST_RTOS_FREERTOS_RUN_TIME_COUNTER_FREQUENCY 1000000
+#endif
+
 // ----------------------------------------------------------------------------
 void
 outpost::rtos::Thread::wrapper(void* object)
@@ -58,6 +67,7 @@ outpost::rtos::Thread::~Thread()
 {
     if (mHandle != 0)
     {
+        ThreadProfiler::unregisterThread(*this);
         vTaskDelete(mHandle);
     }
 }
@@ -81,6 +91,8 @@ outpost::rtos::Thread::start()
         {
             FailureHandler::fatal(FailureCode::resourceAllocationFailed(Resource::thread));
         }
+
+        ThreadProfiler::registerThread(*this);
     }
 }
 
@@ -104,6 +116,38 @@ outpost::rtos::Thread::getCurrentThreadIdentifier()
     return reinterpret_cast<Identifier>(xTaskGetCurrentTaskHandle());
 }
 
+void
+outpost::rtos::Thread::getProfile(ThreadProfile& profile) const
+{
+    profile = ThreadProfile();
+    profile.setName(mName);
+    profile.identifier = getIdentifier();
+    profile.priority = mPriority;
+
+    // Size as passed to xTaskCreate()
+    profile.stackSize = ((mStackSize / sizeof(portSTACK_TYPE)) + 1) * sizeof(portSTACK_TYPE);
+
+    if (mHandle == 0)
+    {
+        return;
+    }
+
+#if (INCLUDE_uxTaskGetStackHighWaterMark == 1)
+    // FreeRTOS fills the stack with a pattern on creation, the high-water
+    // mark is the minimum number of words which were never overwritten
+    const size_t unused = uxTaskGetStackHighWaterMark(mHandle) * sizeof(portSTACK_TYPE);
+    profile.stackUsage = profile.stackSize - unused;
+#endif
+
+#if (configUSE_TRACE_FACILITY == 1) && (configGENERATE_RUN_TIME_STATS == 1) \
+        && (tskKERNEL_VERSION_MAJOR >= 9)
+    TaskStatus_t status;
+    vTaskGetInfo(mHandle, &status, pdFALSE, eInvalid);
+    profile.cpuTime = time::Microseconds((static_cast<int64_t>(status.ulRunTimeCounter) * 1000000)
+                                         / OUTPOST_RTOS_FREERTOS_RUN_TIME_COUNTER_FREQUENCY);
+#endif
+}
+
 // ----------------------------------------------------------------------------
 void
 outpost::rtos::Thread::setPriority(uint8_t priority)
@@ -25,6 +25,8 @@ namespace outpost
 {
 namespace rtos
 {
+struct ThreadProfile;
+
 /**
  * Wrapper class for the Thread function of the Operating System.
  *
@@ -135,6 +137,14 @@ public:
     static Identifier
     getCurrentThreadIdentifier();
 
+    /**
+     * Query the processor time and stack usage of the thread.
+     *
+     * \see ThreadProfiler
+     */
+    void
+    getProfile(ThreadProfile& profile) const;
+
     /**
      * Set a new priority for the thread.
      *
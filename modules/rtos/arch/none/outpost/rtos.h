@@ -22,9 +22,13 @@
  */
 
 #include "rtos/clock.h"
+#include "rtos/cycle_clock.h"
+#include "rtos/event_group.h"
+#include "rtos/memory.h"
 #include "rtos/mutex.h"
 #include "rtos/periodic_task_manager.h"
 #include "rtos/semaphore.h"
+#include "rtos/task_scheduler.h"
 #include "rtos/thread.h"
 #include "rtos/timer.h"
 
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_NONE_ATOMIC_H
+#define OUTPOST_RTOS_NONE_ATOMIC_H
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Atomic integral value.
+ *
+ * Without an operating system there is no preemption, therefore
+ * the operations are implemented as plain accesses.
+ *
+ * \tparam T
+ *      Integral type of the stored value.
+ *
+ * \ingroup    rtos
+ */
+template <typename T>
+class Atomic
+{
+public:
+    constexpr explicit Atomic(T value = T()) : mValue(value)
+    {
+    }
+
+    // disable copy constructor
+    Atomic(const Atomic& other) = delete;
+
+    // disable assignment operator
+    Atomic&
+    operator=(const Atomic& other) = delete;
+
+    inline T
+    load() const
+    {
+        return mValue;
+    }
+
+    inline void
+    store(T value)
+    {
+        mValue = value;
+    }
+
+    /**
+     * Add \p value and return the value held previously.
+     */
+    inline T
+    fetchAdd(T value)
+    {
+        T previous = mValue;
+        mValue = previous + value;
+        return previous;
+    }
+
+    /**
+     * Subtract \p value and return the value held previously.
+     */
+    inline T
+    fetchSub(T value)
+    {
+        T previous = mValue;
+        mValue = previous - value;
+        return previous;
+    }
+
+    /**
+     * Replace the value with \p desired if it currently equals \p expected.
+     *
+     * \param expected
+     *      Expected value. Is updated with the current value if the
+     *      exchange fails.
+     * \param desired
+     *      New value.
+     *
+     * \retval true     Value was exchanged.
+     * \retval false    Value differed from \p expected.
+     */
+    inline bool
+    compareAndSwap(T& expected, T desired)
+    {
+        if (mValue == expected)
+        {
+            mValue = desired;
+            return true;
+        }
+        expected = mValue;
+        return false;
+    }
+
+private:
+    T mValue;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
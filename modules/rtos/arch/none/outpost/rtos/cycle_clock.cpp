@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "cycle_clock.h"
+
+outpost::rtos::CycleClock::Ticks __attribute__((weak)) outpost::rtos::CycleClock::now()
+{
+    return 0;
+}
+
+uint64_t __attribute__((weak)) outpost::rtos::CycleClock::getFrequency()
+{
+    // Avoid a division by zero in toDuration()
+    return 1;
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_NONE_CYCLE_CLOCK_H
+#define OUTPOST_RTOS_NONE_CYCLE_CLOCK_H
+
+#include <outpost/rtos/cycle_clock_conversion.h>
+#include <outpost/time/duration.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Cheap timestamps for fine-grained time measurements.
+ *
+ * In contrast to SystemClock the functions are not virtual.
+ *
+ * now() and getFrequency() are weak symbols which have to be provided by
+ * the board support, e.g. reading a free-running hardware timer. The
+ * default implementation always returns zero.
+ *
+ * \code
+ * CycleClock::Ticks start = CycleClock::now();
+ * ...
+ * time::Duration elapsed = CycleClock::toDuration(CycleClock::now() - start);
+ * \endcode
+ *
+ * \ingroup    rtos
+ */
+class CycleClock
+{
+public:
+    typedef uint64_t Ticks;
+
+    static Ticks
+    now();
+
+    /**
+     * Number of ticks per second.
+     */
+    static uint64_t
+    getFrequency();
+
+    static inline time::Duration
+    toDuration(Ticks ticks)
+    {
+        return convertTicksToDuration(ticks, getFrequency());
+    }
+
+private:
+    // Only static functions
+    CycleClock() = delete;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
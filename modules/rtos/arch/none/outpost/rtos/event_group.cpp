@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "event_group.h"
+
+using outpost::rtos::EventGroup;
+
+constexpr EventGroup::Bits EventGroup::usableBits;
+
+EventGroup::EventGroup() : mBits(0)
+{
+}
+
+EventGroup::~EventGroup()
+{
+}
+
+void
+EventGroup::set(Bits bits)
+{
+    mBits |= bits;
+}
+
+void
+EventGroup::setFromInterrupt(Bits bits)
+{
+    set(bits);
+}
+
+void
+EventGroup::clear(Bits bits)
+{
+    mBits &= ~bits;
+}
+
+EventGroup::Bits
+EventGroup::get() const
+{
+    return mBits;
+}
+
+EventGroup::Bits
+EventGroup::waitAny(Bits bits, outpost::time::Duration timeout, bool clearOnExit)
+{
+    (void) timeout;
+    return wait(bits, false, clearOnExit);
+}
+
+EventGroup::Bits
+EventGroup::waitAll(Bits bits, outpost::time::Duration timeout, bool clearOnExit)
+{
+    (void) timeout;
+    return wait(bits, true, clearOnExit);
+}
+
+EventGroup::Bits
+EventGroup::wait(Bits bits, bool all, bool clearOnExit)
+{
+    const Bits matched = mBits & bits;
+    if ((all && (matched != bits)) || (!all && (matched == 0)))
+    {
+        return 0;
+    }
+    if (clearOnExit)
+    {
+        mBits &= ~matched;
+    }
+    return matched;
+}
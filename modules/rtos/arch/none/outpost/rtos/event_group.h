@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_NONE_EVENT_GROUP_H
+#define OUTPOST_RTOS_NONE_EVENT_GROUP_H
+
+#include <outpost/time/duration.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Set of event flags threads can wait for.
+ *
+ * Allows a thread to block until one of several sources has work, e.g.
+ * a queue has received an element or a stop has been requested, instead
+ * of polling each source with a short timeout. Any number of threads may
+ * set bits and wait.
+ *
+ * Only the lower 24 bits are available on all operating systems
+ * (FreeRTOS restriction), see \c usableBits.
+ *
+ * Without an operating system there are no other threads to wait for,
+ * the wait functions return the current state of the bits immediately.
+ *
+ * \ingroup    rtos
+ */
+class EventGroup
+{
+public:
+    typedef uint32_t Bits;
+
+    /// Bits which can be used on all operating systems
+    static constexpr Bits usableBits = 0x00FFFFFF;
+
+    EventGroup();
+
+    // disable copy constructor
+    EventGroup(const EventGroup& other) = delete;
+
+    // disable assignment operator
+    EventGroup&
+    operator=(const EventGroup& other) = delete;
+
+    ~EventGroup();
+
+    /**
+     * Set bits and wake up the threads waiting for them.
+     */
+    void
+    set(Bits bits);
+
+    /**
+     * Set bits from an interrupt handler.
+     *
+     * Same as set() but may only be called from interrupt context.
+     */
+    void
+    setFromInterrupt(Bits bits);
+
+    /**
+     * Clear bits.
+     */
+    void
+    clear(Bits bits);
+
+    /**
+     * Current value of all bits.
+     */
+    Bits
+    get() const;
+
+    /**
+     * Wait until at least one of the given bits is set.
+     *
+     * \param bits
+     *         Bits to wait for.
+     * \param timeout
+     *         Maximum time to wait.
+     * \param clearOnExit
+     *         Clear the bits for which the wait has returned. Whether
+     *         other threads waiting for the same bits see them as well
+     *         depends on the operating system.
+     *
+     * \return  Subset of \p bits which was set, zero on timeout.
+     */
+    Bits
+    waitAny(Bits bits,
+            outpost::time::Duration timeout = outpost::time::Duration::infinity(),
+            bool clearOnExit = true);
+
+    /**
+     * Wait until all given bits are set.
+     *
+     * \return  \p bits if all were set, zero on timeout.
+     * \see     waitAny()
+     */
+    Bits
+    waitAll(Bits bits,
+            outpost::time::Duration timeout = outpost::time::Duration::infinity(),
+            bool clearOnExit = true);
+
+private:
+    Bits
+    wait(Bits bits, bool all, bool clearOnExit);
+
+    volatile Bits mBits;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
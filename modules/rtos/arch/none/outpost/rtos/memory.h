@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_NONE_MEMORY_H
+#define OUTPOST_RTOS_NONE_MEMORY_H
+
+#include <outpost/base/slice.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Avoid page faults in the real-time paths.
+ *
+ * All memory is resident on this target, the functions do nothing. See
+ * the POSIX implementation.
+ *
+ * \ingroup    rtos
+ */
+class Memory
+{
+public:
+    static inline bool
+    lockAll()
+    {
+        return true;
+    }
+
+    static inline void
+    unlockAll()
+    {
+    }
+
+    static inline void
+    prefault(outpost::Slice<uint8_t> /*memory*/)
+    {
+    }
+
+    static inline bool
+    adviseHugePages(outpost::Slice<uint8_t> /*memory*/)
+    {
+        return false;
+    }
+
+    static inline void
+    setThreadStackPrefault(bool /*enable*/)
+    {
+    }
+
+    static inline bool
+    isThreadStackPrefaultEnabled()
+    {
+        return false;
+    }
+
+private:
+    // Only static functions
+    Memory() = delete;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
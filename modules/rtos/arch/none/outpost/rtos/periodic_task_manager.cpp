@@ -15,8 +15,9 @@
 
 using namespace outpost::rtos;
 
-PeriodicTaskManager::PeriodicTaskManager()
+PeriodicTaskManager::PeriodicTaskManager(OverrunPolicy::Type policy)
 {
+    (void) policy;
 }
 
 PeriodicTaskManager::~PeriodicTaskManager()
@@ -40,3 +41,14 @@ void
 PeriodicTaskManager::cancel()
 {
 }
+
+PeriodicTaskStatistics
+PeriodicTaskManager::getStatistics()
+{
+    return PeriodicTaskStatistics();
+}
+
+void
+PeriodicTaskManager::resetStatistics()
+{
+}
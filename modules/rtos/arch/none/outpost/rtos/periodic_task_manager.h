@@ -16,6 +16,7 @@
 
 #include <outpost/rtos/failure_handler.h>
 #include <outpost/rtos/mutex.h>
+#include <outpost/rtos/periodic_task_statistics.h>
 #include <outpost/time/duration.h>
 
 namespace outpost
@@ -49,7 +50,21 @@ public:
         };
     };
 
-    PeriodicTaskManager();
+    struct OverrunPolicy
+    {
+        enum Type
+        {
+            /// Every missed period is started immediately, until the task
+            /// is back on schedule
+            catchUp,
+
+            /// Periods which have already ended are dropped, the period
+            /// in which nextPeriod() is called is started immediately
+            skip
+        };
+    };
+
+    explicit PeriodicTaskManager(OverrunPolicy::Type policy = OverrunPolicy::catchUp);
 
     ~PeriodicTaskManager();
 
@@ -105,6 +120,12 @@ public:
     void
     cancel();
 
+    PeriodicTaskStatistics
+    getStatistics();
+
+    void
+    resetStatistics();
+
 private:
 };
 }  // namespace rtos
@@ -25,6 +25,8 @@ namespace outpost
 {
 namespace rtos
 {
+class ScheduledTask;
+
 /**
  * Atomic Queue.
  *
@@ -91,17 +93,83 @@ public:
     bool
     receive(T& data, outpost::time::Duration timeout);
 
+    /**
+     * Trigger \p task whenever an item has been stored in the queue, the
+     * task then has to receive all items.
+     *
+     * \param task
+     *      Receiving task of the TaskScheduler, nullptr to remove it.
+     */
+    inline void
+    setReceiver(ScheduledTask* task)
+    {
+        mReceiver = task;
+    }
+
+protected:
+    /**
+     * Create a Queue which uses the given storage, see StaticQueue.
+     *
+     * \param numberOfItems
+     *      The maximum number of items that the queue can contain.
+     * \param storage
+     *      Buffer for \p numberOfItems items, must outlive the queue.
+     */
+    Queue(size_t numberOfItems, T* storage);
+
 private:
     size_t
     increment(size_t index) const;
 
     T* mBuffer;
+    ScheduledTask* mReceiver;
+
+    /// Buffer has been allocated by the queue
+    const bool mOwnsBuffer;
+
     const size_t mMaximumSize;
     size_t mItemsInBuffer;
     size_t mHead;
     size_t mTail;
 };
 
+namespace internal
+{
+/**
+ * Storage of a StaticQueue.
+ *
+ * Base class of StaticQueue so that it is constructed before the queue.
+ */
+template <typename T, size_t N>
+struct StaticQueueStorage
+{
+    T mItems[N];
+};
+}  // namespace internal
+
+/**
+ * Queue with the buffer inside the object.
+ *
+ * Same as Queue but no memory is allocated at construction.
+ *
+ * \tparam T
+ *      Type of the items, limited to POD types.
+ * \tparam N
+ *      The maximum number of items that the queue can contain.
+ *
+ * \ingroup rtos
+ */
+template <typename T, size_t N>
+class StaticQueue : private internal::StaticQueueStorage<T, N>, public Queue<T>
+{
+    static_assert(N > 0, "Queue must hold at least one item");
+
+public:
+    StaticQueue() : Queue<T>(N, this->mItems)
+    {
+    }
+};
+
 }  // namespace rtos
 }  // namespace outpost
 
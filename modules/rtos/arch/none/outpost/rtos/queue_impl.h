@@ -16,11 +16,27 @@
 
 #include "queue.h"
 
+#include "task_scheduler.h"
+
 #include <outpost/rtos/failure_handler.h>
 
 template <typename T>
 outpost::rtos::Queue<T>::Queue(size_t numberOfItems) :
     mBuffer(new T[numberOfItems]),
+    mReceiver(nullptr),
+    mOwnsBuffer(true),
+    mMaximumSize(numberOfItems),
+    mItemsInBuffer(0),
+    mHead(0),
+    mTail(0)
+{
+}
+
+template <typename T>
+outpost::rtos::Queue<T>::Queue(size_t numberOfItems, T* storage) :
+    mBuffer(storage),
+    mReceiver(nullptr),
+    mOwnsBuffer(false),
     mMaximumSize(numberOfItems),
     mItemsInBuffer(0),
     mHead(0),
@@ -31,7 +47,10 @@ outpost::rtos::Queue<T>::Queue(size_t numberOfItems) :
 template <typename T>
 outpost::rtos::Queue<T>::~Queue()
 {
-    delete[] mBuffer;
+    if (mOwnsBuffer)
+    {
+        delete[] mBuffer;
+    }
 }
 
 template <typename T>
@@ -46,6 +65,11 @@ outpost::rtos::Queue<T>::send(const T& data)
         mBuffer[mHead] = data;
         mItemsInBuffer++;
         itemStored = true;
+
+        if (mReceiver != nullptr)
+        {
+            mReceiver->trigger();
+        }
     }
 
     return itemStored;
@@ -76,3 +76,8 @@ void
 outpost::rtos::BinarySemaphore::release()
 {
 }
+
+void
+outpost::rtos::BinarySemaphore::releaseFromInterrupt()
+{
+}
@@ -182,6 +182,12 @@ public:
      */
     void
     release();
+
+    /**
+     * Increment the count from an interrupt handler.
+     */
+    void
+    releaseFromInterrupt();
 };
 
 }  // namespace rtos
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "task_scheduler.h"
+
+#include "timer.h"
+
+using outpost::rtos::ScheduledTask;
+using outpost::rtos::TaskScheduler;
+using outpost::rtos::Timer;
+
+ScheduledTask* TaskScheduler::tasks = nullptr;
+Timer* TaskScheduler::timers = nullptr;
+outpost::time::Duration TaskScheduler::tickPeriod = outpost::time::Milliseconds(1);
+volatile uint32_t TaskScheduler::ticks = 0;
+uint32_t TaskScheduler::processedTicks = 0;
+
+// ----------------------------------------------------------------------------
+ScheduledTask::ScheduledTask(uint8_t priority) :
+    mNext(nullptr),
+    mPending(false),
+    mPriority(priority)
+{
+}
+
+ScheduledTask::~ScheduledTask()
+{
+    TaskScheduler::remove(*this);
+}
+
+// ----------------------------------------------------------------------------
+void
+TaskScheduler::add(ScheduledTask& task)
+{
+    remove(task);
+
+    // Sorted by descending priority, behind the tasks of the same priority
+    ScheduledTask** position = &tasks;
+    while ((*position != nullptr) && ((*position)->mPriority >= task.mPriority))
+    {
+        position = &(*position)->mNext;
+    }
+    task.mNext = *position;
+    *position = &task;
+}
+
+void
+TaskScheduler::remove(ScheduledTask& task)
+{
+    for (ScheduledTask** position = &tasks; *position != nullptr; position = &(*position)->mNext)
+    {
+        if (*position == &task)
+        {
+            *position = task.mNext;
+            task.mNext = nullptr;
+            return;
+        }
+    }
+}
+
+bool
+TaskScheduler::runNext()
+{
+    processTimers();
+
+    for (ScheduledTask* task = tasks; task != nullptr; task = task->mNext)
+    {
+        if (task->mPending)
+        {
+            // Cleared before the execution, so that a trigger during the
+            // execution is not lost
+            task->mPending = false;
+            task->execute();
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+TaskScheduler::run()
+{
+    while (true)
+    {
+        if (!runNext())
+        {
+            idle();
+        }
+    }
+}
+
+void __attribute__((weak)) TaskScheduler::idle()
+{
+}
+
+void
+TaskScheduler::setTickPeriod(time::Duration period)
+{
+    tickPeriod = period;
+}
+
+uint32_t
+TaskScheduler::toTicks(time::Duration duration)
+{
+    const int64_t period = tickPeriod.microseconds();
+    const int64_t value = duration.microseconds();
+    if ((period <= 0) || (value <= period))
+    {
+        return 1;
+    }
+    return static_cast<uint32_t>((value + period - 1) / period);
+}
+
+// ----------------------------------------------------------------------------
+void
+TaskScheduler::addTimer(Timer& timer)
+{
+    if (!timer.mLinked)
+    {
+        timer.mNext = timers;
+        timers = &timer;
+        timer.mLinked = true;
+    }
+}
+
+void
+TaskScheduler::removeTimer(Timer& timer)
+{
+    for (Timer** position = &timers; *position != nullptr; position = &(*position)->mNext)
+    {
+        if (*position == &timer)
+        {
+            *position = timer.mNext;
+            timer.mNext = nullptr;
+            timer.mLinked = false;
+            return;
+        }
+    }
+}
+
+void
+TaskScheduler::processTimers()
+{
+    // Unsigned arithmetic handles the overflow of the tick counter
+    const uint32_t now = ticks;
+    const uint32_t elapsed = now - processedTicks;
+    processedTicks = now;
+
+    // Timers are advanced before the callbacks are executed, so that the
+    // timers started by a callback are not advanced in the same pass
+    if (elapsed > 0)
+    {
+        for (Timer* timer = timers; timer != nullptr; timer = timer->mNext)
+        {
+            if (timer->mRunning)
+            {
+                if (timer->mRemaining <= elapsed)
+                {
+                    timer->mRemaining = 0;
+                    timer->mExpired = true;
+                }
+                else
+                {
+                    timer->mRemaining -= elapsed;
+                }
+            }
+        }
+    }
+
+    Timer** position = &timers;
+    while (*position != nullptr)
+    {
+        Timer* timer = *position;
+        if (timer->mExpired)
+        {
+            // The callback may restart the timer
+            timer->mExpired = false;
+            timer->mRunning = false;
+            (timer->mObject->*(timer->mFunction))(timer);
+
+            // Timers started by the callback are inserted at the front
+            while (*position != timer)
+            {
+                position = &(*position)->mNext;
+            }
+        }
+
+        if (timer->mRunning)
+        {
+            position = &timer->mNext;
+        }
+        else
+        {
+            *position = timer->mNext;
+            timer->mNext = nullptr;
+            timer->mLinked = false;
+        }
+    }
+}
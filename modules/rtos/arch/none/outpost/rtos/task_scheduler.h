@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_NONE_TASK_SCHEDULER_H
+#define OUTPOST_RTOS_NONE_TASK_SCHEDULER_H
+
+#include <outpost/time/duration.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+class Timer;
+
+/**
+ * Activity executed by the TaskScheduler.
+ *
+ * A task is executed once after it has been triggered and runs to
+ * completion, it must therefore never block. All tasks share the stack of
+ * the main loop, there is no context switch.
+ *
+ * Several triggers before the task is executed are merged into a single
+ * execution, execute() has to process all data which is available, e.g.
+ * empty its queue.
+ *
+ * \ingroup    rtos
+ */
+class ScheduledTask
+{
+public:
+    /**
+     * \param priority
+     *      Higher values represent a higher priority, same as for Thread.
+     */
+    explicit ScheduledTask(uint8_t priority);
+
+    virtual ~ScheduledTask();
+
+    // disable copy constructor
+    ScheduledTask(const ScheduledTask& other) = delete;
+
+    // disable assignment operator
+    ScheduledTask&
+    operator=(const ScheduledTask& other) = delete;
+
+    /**
+     * Mark the task as ready.
+     *
+     * Can be called from interrupt service routines and from other tasks.
+     */
+    inline void
+    trigger()
+    {
+        mPending = true;
+    }
+
+    inline bool
+    isPending() const
+    {
+        return mPending;
+    }
+
+    inline uint8_t
+    getPriority() const
+    {
+        return mPriority;
+    }
+
+protected:
+    /**
+     * Working method of the task, called by the TaskScheduler after the
+     * task has been triggered.
+     */
+    virtual void
+    execute() = 0;
+
+private:
+    friend class TaskScheduler;
+
+    ScheduledTask* mNext;
+    volatile bool mPending;
+    const uint8_t mPriority;
+};
+
+/**
+ * Cooperative run-to-completion scheduler for targets without an operating
+ * system.
+ *
+ * The ready tasks are executed one after another in the order of their
+ * priority, a task is never preempted by another task. Interrupts only
+ * trigger tasks, so that the work is done on the stack of the main loop:
+ *
+ * \code
+ * int
+ * main()
+ * {
+ *     TaskScheduler::setTickPeriod(outpost::time::Milliseconds(1));
+ *     TaskScheduler::add(telemetryTask);
+ *     TaskScheduler::add(housekeepingTask);
+ *
+ *     // Calls TaskScheduler::tick() every millisecond
+ *     startTickInterrupt();
+ *
+ *     TaskScheduler::run();
+ * }
+ * \endcode
+ *
+ * Tasks are triggered by interrupts, by other tasks, by sending to a Queue
+ * with a receiving task (see Queue::setReceiver()) and by the callbacks of
+ * a Timer. Timers are handled by the scheduler based on the ticks counted
+ * by tick(), their callbacks are executed before the tasks.
+ *
+ * Except trigger() and tick() no function may be called from interrupts.
+ *
+ * \ingroup    rtos
+ */
+class TaskScheduler
+{
+public:
+    /**
+     * Register a task, before or while the scheduler is running.
+     *
+     * Tasks of the same priority are executed in the order they were
+     * added.
+     */
+    static void
+    add(ScheduledTask& task);
+
+    /**
+     * Unregister a task.
+     */
+    static void
+    remove(ScheduledTask& task);
+
+    /**
+     * Execute the expired timers and the ready task with the highest
+     * priority.
+     *
+     * \retval false  No task was ready.
+     */
+    static bool
+    runNext();
+
+    /**
+     * Execute the ready tasks forever, calls idle() if no task is ready.
+     */
+    static void
+    run();
+
+    /**
+     * Called by run() if no task is ready.
+     *
+     * Weak symbol which can be replaced by the board support, e.g. to wait
+     * for the next interrupt. The default implementation returns
+     * immediately.
+     *
+     * An interrupt shortly before the call may trigger a task which is then
+     * only executed after the next interrupt, the latency is bounded by the
+     * tick period.
+     */
+    static void
+    idle();
+
+    /**
+     * Count a tick, to be called from a periodic interrupt.
+     */
+    static inline void
+    tick()
+    {
+        ticks = ticks + 1;
+    }
+
+    /**
+     * Set the period in which tick() is called.
+     */
+    static void
+    setTickPeriod(time::Duration period);
+
+    static inline time::Duration
+    getTickPeriod()
+    {
+        return tickPeriod;
+    }
+
+    /**
+     * Number of ticks after which a timer started for \p duration expires,
+     * at least one.
+     */
+    static uint32_t
+    toTicks(time::Duration duration);
+
+private:
+    friend class Timer;
+
+    // Only static functions
+    TaskScheduler() = delete;
+
+    static void
+    addTimer(Timer& timer);
+
+    static void
+    removeTimer(Timer& timer);
+
+    /**
+     * Execute the callbacks of the timers which have expired since the
+     * last call.
+     */
+    static void
+    processTimers();
+
+    static ScheduledTask* tasks;
+    static Timer* timers;
+    static time::Duration tickPeriod;
+    static volatile uint32_t ticks;
+    static uint32_t processedTicks;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
@@ -14,6 +14,7 @@
 #include "thread.h"
 
 #include <outpost/rtos/failure_handler.h>
+#include <outpost/rtos/thread_profiler.h>
 
 #include <stdio.h>
 
@@ -51,6 +52,12 @@ outpost::rtos::Thread::getCurrentThreadIdentifier()
     return 0;
 }
 
+void
+outpost::rtos::Thread::getProfile(ThreadProfile& profile) const
+{
+    profile = ThreadProfile();
+}
+
 // ----------------------------------------------------------------------------
 void
 outpost::rtos::Thread::setPriority(uint8_t priority)
@@ -13,26 +13,41 @@
 
 #include "timer.h"
 
+#include "task_scheduler.h"
+
+outpost::rtos::Timer::~Timer()
+{
+    TaskScheduler::removeTimer(*this);
+}
+
 void
 outpost::rtos::Timer::start(time::Duration duration)
 {
-    (void) duration;
+    mDuration = TaskScheduler::toTicks(duration);
+    mRemaining = mDuration;
+    mRunning = true;
+    mExpired = false;
+    TaskScheduler::addTimer(*this);
 }
 
 void
 outpost::rtos::Timer::reset()
 {
+    mRemaining = mDuration;
 }
 
 void
 outpost::rtos::Timer::cancel()
 {
+    // Unlinked by the scheduler
+    mRunning = false;
+    mExpired = false;
 }
 
 bool
 outpost::rtos::Timer::isRunning()
 {
-    return false;
+    return mRunning;
 }
 
 void
@@ -18,6 +18,7 @@
 #include <outpost/time/duration.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
 namespace outpost
 {
@@ -26,14 +27,14 @@ namespace rtos
 /**
  * Software timer.
  *
- * The timer callback functions are called in the context of the
- * timer server thread.
+ * The timer callback functions are called by the TaskScheduler, before
+ * the ready tasks are executed. The resolution is the tick period of the
+ * scheduler.
  *
- * The Timer Server thread is responsible for executing the timer
- * service routines associated with all task-based timers.
+ * The callbacks may start, reset or cancel timers, but must not destroy
+ * them.
  *
- * The Timer Server is designed to remain blocked until a task-based
- * timer fires. This reduces the execution overhead of the Timer Server.
+ * \see TaskScheduler
  *
  * \author    Fabian Greif
  * \ingroup    rtos
@@ -75,7 +76,7 @@ public:
      * allocated resources are reclaimed and can be used for another
      * timer.
      */
-    ~Timer() = default;
+    ~Timer();
 
     /**
      * Start the timer.
@@ -115,12 +116,25 @@ public:
     isRunning();
 
 private:
+    friend class TaskScheduler;
+
     void
     createTimer(const char* name);
 
     /// Object and member function to call when the timer expires.
     Callable* const mObject;
     Function const mFunction;
+
+    Timer* mNext;
+    uint32_t mDuration;
+    uint32_t mRemaining;
+    bool mRunning;
+
+    /// Callback has to be executed
+    bool mExpired;
+
+    /// Part of the timer list of the TaskScheduler
+    bool mLinked;
 };
 
 // ----------------------------------------------------------------------------
@@ -128,7 +142,13 @@ private:
 template <typename T>
 Timer::Timer(T* object, void (T::*function)(Timer* timer), const char* name) :
     mObject(reinterpret_cast<Callable*>(object)),
-    mFunction(reinterpret_cast<Function>(function))
+    mFunction(reinterpret_cast<Function>(function)),
+    mNext(nullptr),
+    mDuration(0),
+    mRemaining(0),
+    mRunning(false),
+    mExpired(false),
+    mLinked(false)
 {
     this->createTimer(name);
 }
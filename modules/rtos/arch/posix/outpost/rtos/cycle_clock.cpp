@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "cycle_clock.h"
+
+#include "internal/time.h"
+
+namespace outpost
+{
+namespace rtos
+{
+#if defined(__x86_64__) || defined(__i386__)
+static uint64_t
+calibrateFrequency()
+{
+    constexpr int64_t nanosecondsPerSecond = 1000000000;
+
+    const timespec startTime = getTime(CLOCK_MONOTONIC);
+    const CycleClock::Ticks startTicks = CycleClock::now();
+
+    timespec delay{0, 10000000};
+    while (nanosleep(&delay, &delay) != 0)
+    {
+    }
+
+    const timespec endTime = getTime(CLOCK_MONOTONIC);
+    const CycleClock::Ticks endTicks = CycleClock::now();
+
+    const int64_t nanoseconds = (endTime.tv_sec - startTime.tv_sec) * nanosecondsPerSecond
+                                + (endTime.tv_nsec - startTime.tv_nsec);
+    return ((endTicks - startTicks) * static_cast<uint64_t>(nanosecondsPerSecond))
+           / static_cast<uint64_t>(nanoseconds);
+}
+#endif
+
+uint64_t
+CycleClock::getFrequency()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    // Thread-safe initialization on the first call
+    static const uint64_t frequency = calibrateFrequency();
+    return frequency;
+#elif defined(__aarch64__)
+    uint64_t frequency;
+    asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+    return frequency;
+#else
+    return 1000000000UL;
+#endif
+}
+
+}  // namespace rtos
+}  // namespace outpost
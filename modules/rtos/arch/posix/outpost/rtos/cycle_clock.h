@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_POSIX_CYCLE_CLOCK_H
+#define OUTPOST_RTOS_POSIX_CYCLE_CLOCK_H
+
+#include <outpost/rtos/cycle_clock_conversion.h>
+#include <outpost/time/duration.h>
+
+#include <stdint.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Cheap timestamps for fine-grained time measurements.
+ *
+ * In contrast to SystemClock the functions are not virtual and now()
+ * reads a hardware counter without a system call:
+ * - x86: time stamp counter, calibrated against CLOCK_MONOTONIC on the
+ *   first call of getFrequency(), which takes ~10 ms.
+ * - AArch64: virtual count of the generic timer.
+ * - otherwise: CLOCK_MONOTONIC in nanoseconds.
+ *
+ * Timestamps are only meaningful relative to each other, store the ticks
+ * and convert the difference later:
+ *
+ * \code
+ * CycleClock::Ticks start = CycleClock::now();
+ * ...
+ * time::Duration elapsed = CycleClock::toDuration(CycleClock::now() - start);
+ * \endcode
+ *
+ * \warning
+ *      On x86 the time stamp counter must be invariant (constant rate and
+ *      synchronized between cores), which is the case for all recent
+ *      processors.
+ *
+ * \ingroup    rtos
+ */
+class CycleClock
+{
+public:
+    typedef uint64_t Ticks;
+
+    static inline Ticks
+    now()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t value;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+        return value;
+#else
+        timespec time;
+        clock_gettime(CLOCK_MONOTONIC, &time);
+        return static_cast<uint64_t>(time.tv_sec) * 1000000000UL + time.tv_nsec;
+#endif
+    }
+
+    /**
+     * Number of ticks per second.
+     */
+    static uint64_t
+    getFrequency();
+
+    static inline time::Duration
+    toDuration(Ticks ticks)
+    {
+        return convertTicksToDuration(ticks, getFrequency());
+    }
+
+private:
+    // Only static functions
+    CycleClock() = delete;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
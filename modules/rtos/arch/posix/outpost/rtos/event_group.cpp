@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "event_group.h"
+
+#include "internal/futex.h"
+#include "internal/time.h"
+
+#include <limits.h>
+
+using outpost::rtos::EventGroup;
+using outpost::rtos::internal::Futex;
+
+constexpr EventGroup::Bits EventGroup::usableBits;
+
+EventGroup::EventGroup() : mBits(0), mWaiters(0)
+{
+}
+
+EventGroup::~EventGroup()
+{
+}
+
+void
+EventGroup::set(Bits bits)
+{
+    const Bits previous = mBits.fetch_or(bits);
+    if (((previous | bits) != previous) && (mWaiters.load() != 0))
+    {
+        // The waiting threads wait for different bits, all of them have
+        // to check the new value
+        Futex::wake(mBits, INT_MAX);
+    }
+}
+
+void
+EventGroup::setFromInterrupt(Bits bits)
+{
+    set(bits);
+}
+
+void
+EventGroup::clear(Bits bits)
+{
+    mBits.fetch_and(~bits);
+}
+
+EventGroup::Bits
+EventGroup::get() const
+{
+    return mBits.load();
+}
+
+EventGroup::Bits
+EventGroup::waitAny(Bits bits, outpost::time::Duration timeout, bool clearOnExit)
+{
+    return wait(bits, false, timeout, clearOnExit);
+}
+
+EventGroup::Bits
+EventGroup::waitAll(Bits bits, outpost::time::Duration timeout, bool clearOnExit)
+{
+    return wait(bits, true, timeout, clearOnExit);
+}
+
+EventGroup::Bits
+EventGroup::wait(Bits bits, bool all, outpost::time::Duration timeout, bool clearOnExit)
+{
+    timespec deadline = {0, 0};
+    const bool waitForever = (timeout == outpost::time::Duration::infinity());
+    if (!waitForever)
+    {
+        deadline = toAbsoluteTime(CLOCK_MONOTONIC, timeout);
+    }
+
+    Bits current = mBits.load();
+    while (true)
+    {
+        const Bits matched = current & bits;
+        if ((all && (matched == bits)) || (!all && (matched != 0)))
+        {
+            if (!clearOnExit)
+            {
+                return matched;
+            }
+            if (mBits.compare_exchange_weak(current, current & ~matched))
+            {
+                return matched;
+            }
+            // Value has changed in between, check again
+            continue;
+        }
+
+        // The futex only sleeps while the word still holds the checked
+        // value, a concurrent set() is never missed.
+        mWaiters.fetch_add(1);
+        const bool woken = Futex::wait(mBits, current, waitForever ? nullptr : &deadline);
+        mWaiters.fetch_sub(1);
+
+        current = mBits.load();
+        if (!woken)
+        {
+            const Bits remaining = current & bits;
+            if ((all && (remaining == bits)) || (!all && (remaining != 0)))
+            {
+                continue;
+            }
+            return 0;
+        }
+    }
+}
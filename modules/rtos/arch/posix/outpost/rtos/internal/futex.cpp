@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "futex.h"
+
+#include "time.h"
+
+#include <errno.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using outpost::rtos::internal::Futex;
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "Futex word must be a plain 32 bit integer");
+
+thread_local uint32_t Futex::currentThreadId = 0;
+
+static inline long
+futex(std::atomic<uint32_t>& word, int operation, uint32_t value, const timespec* timeout,
+      uint32_t value3)
+{
+    return syscall(SYS_futex,
+                   reinterpret_cast<uint32_t*>(&word),
+                   operation | FUTEX_PRIVATE_FLAG,
+                   value,
+                   timeout,
+                   nullptr,
+                   value3);
+}
+
+/**
+ * Blocking futex operation which is a cancellation point.
+ *
+ * A blocking wait has to stay a cancellation point like sem_wait(),
+ * otherwise Thread::~Thread() can not cancel a thread waiting for a
+ * semaphore or mutex. Only the system call itself runs with asynchronous
+ * cancellation enabled.
+ */
+static inline long
+cancelableFutex(std::atomic<uint32_t>& word, int operation, uint32_t value,
+                const timespec* timeout, uint32_t value3)
+{
+    int previousType;
+    pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, &previousType);
+    const long result = futex(word, operation, value, timeout, value3);
+    const int error = errno;
+    pthread_setcanceltype(previousType, nullptr);
+    errno = error;
+    return result;
+}
+
+bool
+Futex::wait(std::atomic<uint32_t>& word, uint32_t expected, const timespec* deadline)
+{
+    // Unlike FUTEX_WAIT the bitset variant takes an absolute timeout,
+    // measured with CLOCK_MONOTONIC
+    const long result =
+            cancelableFutex(word, FUTEX_WAIT_BITSET, expected, deadline, FUTEX_BITSET_MATCH_ANY);
+    if (result != 0)
+    {
+        return (errno != ETIMEDOUT);
+    }
+    return true;
+}
+
+void
+Futex::wake(std::atomic<uint32_t>& word, int numberOfThreads)
+{
+    futex(word, FUTEX_WAKE, static_cast<uint32_t>(numberOfThreads), nullptr, 0);
+}
+
+bool
+Futex::lockPriorityInheritance(std::atomic<uint32_t>& word, const timespec* deadline)
+{
+    long result;
+#ifdef FUTEX_LOCK_PI2
+    // FUTEX_LOCK_PI2 measures the timeout with CLOCK_MONOTONIC (Linux 5.14)
+    result = cancelableFutex(word, FUTEX_LOCK_PI2, 0, deadline, 0);
+    if ((result == 0) || (errno != ENOSYS))
+    {
+        return (result == 0);
+    }
+#endif
+
+    if (deadline != nullptr)
+    {
+        const timespec realtimeDeadline = toRealtimeDeadline(*deadline);
+        result = cancelableFutex(word, FUTEX_LOCK_PI, 0, &realtimeDeadline, 0);
+    }
+    else
+    {
+        result = cancelableFutex(word, FUTEX_LOCK_PI, 0, nullptr, 0);
+    }
+    return (result == 0);
+}
+
+void
+Futex::unlockPriorityInheritance(std::atomic<uint32_t>& word)
+{
+    futex(word, FUTEX_UNLOCK_PI, 0, nullptr, 0);
+}
+
+bool
+Futex::isSpinningUseful()
+{
+    static const bool multiprocessor = (sysconf(_SC_NPROCESSORS_ONLN) > 1);
+    return multiprocessor;
+}
+
+uint32_t
+Futex::queryCurrentThreadId()
+{
+    currentThreadId = static_cast<uint32_t>(syscall(SYS_gettid));
+    return currentThreadId;
+}
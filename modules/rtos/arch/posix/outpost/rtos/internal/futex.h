@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_POSIX_FUTEX_H
+#define OUTPOST_RTOS_POSIX_FUTEX_H
+
+#include <stdint.h>
+#include <time.h>
+
+#include <atomic>
+
+namespace outpost
+{
+namespace rtos
+{
+namespace internal
+{
+/**
+ * Linux futex operations on a 32 bit word.
+ *
+ * All futexes are process private. Deadlines are absolute times of
+ * CLOCK_MONOTONIC, \c nullptr waits forever.
+ */
+class Futex
+{
+public:
+    /**
+     * Sleep as long as \p word contains \p expected.
+     *
+     * May return spuriously, the caller has to check the word again.
+     *
+     * \retval true     Woken up or the word did not contain \p expected.
+     * \retval false    Deadline has passed.
+     */
+    static bool
+    wait(std::atomic<uint32_t>& word, uint32_t expected, const timespec* deadline);
+
+    /**
+     * Wake up to \p numberOfThreads threads sleeping on \p word.
+     */
+    static void
+    wake(std::atomic<uint32_t>& word, int numberOfThreads);
+
+    /**
+     * Lock a priority inheritance futex in the kernel.
+     *
+     * To be called after the userspace fast path (0 -> thread id) failed.
+     * The owner inherits the priority of the waiting thread.
+     *
+     * \retval true     Lock acquired, \p word contains the thread id.
+     * \retval false    Deadline has passed or error.
+     */
+    static bool
+    lockPriorityInheritance(std::atomic<uint32_t>& word, const timespec* deadline);
+
+    /**
+     * Unlock a priority inheritance futex which has waiters.
+     */
+    static void
+    unlockPriorityInheritance(std::atomic<uint32_t>& word);
+
+    /**
+     * Kernel id of the calling thread, as used for the priority
+     * inheritance futexes. Never zero.
+     */
+    static inline uint32_t
+    getCurrentThreadId()
+    {
+        uint32_t id = currentThreadId;
+        if (id == 0)
+        {
+            id = queryCurrentThreadId();
+        }
+        return id;
+    }
+
+    /**
+     * Hint to the processor that the calling thread is busy waiting.
+     */
+    static inline void
+    pause()
+    {
+#if defined(__i386__) || defined(__x86_64__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        __asm__ volatile("yield");
+#endif
+    }
+
+    /**
+     * Check whether busy waiting can succeed, i.e. whether more than one
+     * processor is available.
+     */
+    static bool
+    isSpinningUseful();
+
+private:
+    static uint32_t
+    queryCurrentThreadId();
+
+    /// Cache for getCurrentThreadId()
+    static thread_local uint32_t currentThreadId;
+};
+
+}  // namespace internal
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
@@ -19,6 +19,10 @@
 
 #include <errno.h>
 
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || ((__GLIBC__ == 2) && (__GLIBC_MINOR__ >= 30)))
+#define OUTPOST_RTOS_POSIX_HAS_CLOCKWAIT
+#endif
+
 namespace outpost
 {
 namespace rtos
@@ -90,6 +94,66 @@ addTime(timespec& result, const timespec& increment)
     result.tv_sec += increment.tv_sec;
 }
 
+time::Duration
+getDifference(const timespec& time, const timespec& reference)
+{
+    const int64_t microseconds =
+            (static_cast<int64_t>(time.tv_sec) - reference.tv_sec) * 1000000
+            + (static_cast<int64_t>(time.tv_nsec) - reference.tv_nsec) / 1000;
+    return time::Microseconds(microseconds);
+}
+
+timespec
+toRealtimeDeadline(const timespec& deadline)
+{
+    const timespec now = getTime(CLOCK_MONOTONIC);
+    timespec remaining = {deadline.tv_sec - now.tv_sec, deadline.tv_nsec - now.tv_nsec};
+
+    timespec result = getTime(CLOCK_REALTIME);
+    addTime(result, remaining);
+    return result;
+}
+
+void
+initializeMonotonicCondition(pthread_cond_t& condition)
+{
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    if (pthread_cond_init(&condition, &attr) != 0)
+    {
+        FailureHandler::fatal(FailureCode::resourceAllocationFailed(Resource::semaphore));
+    }
+    pthread_condattr_destroy(&attr);
+}
+
+bool
+waitUntilAbsoluteTime(sem_t& semaphore, const timespec& deadline)
+{
+    int result;
+    do
+    {
+#ifdef OUTPOST_RTOS_POSIX_HAS_CLOCKWAIT
+        result = sem_clockwait(&semaphore, CLOCK_MONOTONIC, &deadline);
+#else
+        const timespec realtimeDeadline = toRealtimeDeadline(deadline);
+        result = sem_timedwait(&semaphore, &realtimeDeadline);
+#endif
+    } while ((result != 0) && (errno == EINTR));
+    return (result == 0);
+}
+
+bool
+lockUntilAbsoluteTime(pthread_mutex_t& mutex, const timespec& deadline)
+{
+#ifdef OUTPOST_RTOS_POSIX_HAS_CLOCKWAIT
+    return (pthread_mutex_clocklock(&mutex, CLOCK_MONOTONIC, &deadline) == 0);
+#else
+    const timespec realtimeDeadline = toRealtimeDeadline(deadline);
+    return (pthread_mutex_timedlock(&mutex, &realtimeDeadline) == 0);
+#endif
+}
+
 void
 sleepUntilAbsoluteTime(clockid_t clock, const timespec& deadline)
 {
@@ -16,6 +16,8 @@
 
 #include <outpost/time/duration.h>
 
+#include <pthread.h>
+#include <semaphore.h>
 #include <time.h>
 
 namespace outpost
@@ -56,6 +58,15 @@ toAbsoluteTime(clockid_t clock, time::Duration duration);
 void
 addTime(timespec& result, const timespec& increment);
 
+/**
+ * Calculate the duration from \p reference to \p time.
+ *
+ * Negative if \p time lies before \p reference. Truncated to
+ * microseconds.
+ */
+time::Duration
+getDifference(const timespec& time, const timespec& reference);
+
 /**
  * Compare two times.
  *
@@ -83,6 +94,51 @@ isBigger(const timespec& time, const timespec& other)
     return false;
 }
 
+/**
+ * Convert an absolute time of CLOCK_MONOTONIC to CLOCK_REALTIME.
+ *
+ * For interfaces which only accept CLOCK_REALTIME deadlines. The result
+ * is only valid as long as the system time is not set.
+ */
+timespec
+toRealtimeDeadline(const timespec& deadline);
+
+/**
+ * Initialize a condition variable which measures timeouts with
+ * CLOCK_MONOTONIC.
+ *
+ * The deadlines for `pthread_cond_timedwait()` have to be calculated with
+ * `toAbsoluteTime(CLOCK_MONOTONIC, ...)`. Unlike CLOCK_REALTIME the clock
+ * is not stepped when the system time is set.
+ */
+void
+initializeMonotonicCondition(pthread_cond_t& condition);
+
+/**
+ * Wait for a semaphore until an absolute time of CLOCK_MONOTONIC.
+ *
+ * Uses `sem_clockwait()` if available (glibc 2.30 and newer), otherwise
+ * the deadline is converted to CLOCK_REALTIME for `sem_timedwait()`.
+ * Handles interruptions through signals by restarting the wait.
+ *
+ * \retval true    The semaphore has been acquired.
+ * \retval false   Timeout or error
+ */
+bool
+waitUntilAbsoluteTime(sem_t& semaphore, const timespec& deadline);
+
+/**
+ * Lock a mutex until an absolute time of CLOCK_MONOTONIC.
+ *
+ * Uses `pthread_mutex_clocklock()` if available, see
+ * waitUntilAbsoluteTime().
+ *
+ * \retval true    The mutex has been locked.
+ * \retval false   Timeout or error
+ */
+bool
+lockUntilAbsoluteTime(pthread_mutex_t& mutex, const timespec& deadline);
+
 /**
  * Sleep until the supplied absolute time.
  *
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "timer_wheel.h"
+
+using outpost::rtos::internal::TimerWheel;
+using outpost::rtos::internal::TimerWheelNode;
+
+constexpr size_t TimerWheel::numberOfLevels;
+constexpr size_t TimerWheel::bitsPerLevel;
+constexpr size_t TimerWheel::slotsPerLevel;
+constexpr uint64_t TimerWheel::noEvent;
+
+static constexpr uint64_t slotMask = TimerWheel::slotsPerLevel - 1;
+
+TimerWheel::TimerWheel(uint64_t currentTick) : mSlots(), mExpired(), mCurrentTick(currentTick)
+{
+}
+
+void
+TimerWheel::add(TimerWheelNode& node, uint64_t expiry)
+{
+    node.unlink();
+    node.mExpiry = expiry;
+    insert(node);
+}
+
+void
+TimerWheel::advance(uint64_t tick)
+{
+    while (mCurrentTick < tick)
+    {
+        // Nothing has to be done for the ticks without an event
+        const uint64_t next = getNextTick();
+        if (next > tick)
+        {
+            mCurrentTick = tick;
+        }
+        else
+        {
+            mCurrentTick = next;
+            processTick();
+        }
+    }
+}
+
+TimerWheelNode*
+TimerWheel::popExpired()
+{
+    if (isEmpty(mExpired))
+    {
+        return nullptr;
+    }
+
+    TimerWheelNode* node = mExpired.mNext;
+    node->unlink();
+    return node;
+}
+
+uint64_t
+TimerWheel::getNextEvent() const
+{
+    if (!isEmpty(mExpired))
+    {
+        return mCurrentTick;
+    }
+    return getNextTick();
+}
+
+uint64_t
+TimerWheel::getNextTick() const
+{
+    const bool higherLevelTimers = hasHigherLevelTimers();
+    for (uint64_t t = mCurrentTick + 1; t <= mCurrentTick + slotsPerLevel; ++t)
+    {
+        if (!isEmpty(mSlots[0][t & slotMask]))
+        {
+            return t;
+        }
+        if (((t & slotMask) == 0) && higherLevelTimers)
+        {
+            // Timers of the higher levels have to be moved down
+            return t;
+        }
+    }
+    return noEvent;
+}
+
+void
+TimerWheel::insert(TimerWheelNode& node)
+{
+    if (node.mExpiry <= mCurrentTick)
+    {
+        append(mExpired, node);
+        return;
+    }
+
+    const uint64_t delta = node.mExpiry - mCurrentTick;
+    for (size_t level = 0; level < numberOfLevels; ++level)
+    {
+        const size_t shift = level * bitsPerLevel;
+        if ((delta >> shift) < slotsPerLevel)
+        {
+            append(mSlots[level][(node.mExpiry >> shift) & slotMask], node);
+            return;
+        }
+    }
+
+    // Out of range, park it in the last slot of the top level which is
+    // still in range. It is inserted again when that slot is processed.
+    const size_t shift = (numberOfLevels - 1) * bitsPerLevel;
+    const uint64_t limit = mCurrentTick + (static_cast<uint64_t>(slotsPerLevel) << shift) - 1;
+    append(mSlots[numberOfLevels - 1][(limit >> shift) & slotMask], node);
+}
+
+void
+TimerWheel::cascade(TimerWheelNode& slot)
+{
+    while (!isEmpty(slot))
+    {
+        TimerWheelNode& node = *slot.mNext;
+        node.unlink();
+        insert(node);
+    }
+}
+
+void
+TimerWheel::processTick()
+{
+    // Move the timers of the higher levels down when the lower levels wrap
+    // around, starting with the top level.
+    for (size_t level = numberOfLevels - 1; level > 0; --level)
+    {
+        const size_t shift = level * bitsPerLevel;
+        if ((mCurrentTick & ((static_cast<uint64_t>(1) << shift) - 1)) == 0)
+        {
+            cascade(mSlots[level][(mCurrentTick >> shift) & slotMask]);
+        }
+    }
+
+    // All timers of the slot expire with this tick
+    TimerWheelNode& slot = mSlots[0][mCurrentTick & slotMask];
+    if (!isEmpty(slot))
+    {
+        TimerWheelNode* first = slot.mNext;
+        TimerWheelNode* last = slot.mPrevious;
+
+        first->mPrevious = mExpired.mPrevious;
+        mExpired.mPrevious->mNext = first;
+        last->mNext = &mExpired;
+        mExpired.mPrevious = last;
+
+        slot.mNext = &slot;
+        slot.mPrevious = &slot;
+    }
+}
+
+bool
+TimerWheel::hasHigherLevelTimers() const
+{
+    for (size_t level = 1; level < numberOfLevels; ++level)
+    {
+        for (size_t index = 0; index < slotsPerLevel; ++index)
+        {
+            if (!isEmpty(mSlots[level][index]))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_POSIX_TIMER_WHEEL_H
+#define OUTPOST_RTOS_POSIX_TIMER_WHEEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+namespace internal
+{
+/**
+ * Element of a TimerWheel, provided by the timer.
+ *
+ * Unlinked nodes point to themself.
+ */
+class TimerWheelNode
+{
+public:
+    TimerWheelNode() : mNext(this), mPrevious(this), mExpiry(0)
+    {
+    }
+
+    // disable copy constructor
+    TimerWheelNode(const TimerWheelNode&) = delete;
+
+    // disable copy assignment operator
+    TimerWheelNode&
+    operator=(const TimerWheelNode&) = delete;
+
+    /**
+     * Check whether the node is part of a wheel, either waiting for its
+     * expiry or expired but not yet taken by popExpired().
+     */
+    inline bool
+    isLinked() const
+    {
+        return (mNext != this);
+    }
+
+    /**
+     * Remove the node from its wheel, O(1). Does nothing if the node is
+     * not linked.
+     */
+    inline void
+    unlink()
+    {
+        mPrevious->mNext = mNext;
+        mNext->mPrevious = mPrevious;
+        mNext = this;
+        mPrevious = this;
+    }
+
+    inline uint64_t
+    getExpiry() const
+    {
+        return mExpiry;
+    }
+
+private:
+    friend class TimerWheel;
+
+    TimerWheelNode* mNext;
+    TimerWheelNode* mPrevious;
+
+    /// Absolute expiry tick
+    uint64_t mExpiry;
+};
+
+/**
+ * Hierarchical timing wheel.
+ *
+ * Four levels of 64 slots each, a slot of level n covers 64^n ticks.
+ * Adding and removing a timer is O(1), a timer is moved down at most three
+ * times before it expires. All timers of a tick are expired together by
+ * moving the whole slot into the list of expired timers.
+ *
+ * Expiries beyond 64^4 ticks are parked in the top level and moved again
+ * until they are in range.
+ *
+ * The wheel only works with ticks and is not thread-safe, see the POSIX
+ * Timer for the service which drives it.
+ */
+class TimerWheel
+{
+public:
+    static constexpr size_t numberOfLevels = 4;
+    static constexpr size_t bitsPerLevel = 6;
+    static constexpr size_t slotsPerLevel = 1U << bitsPerLevel;
+
+    /// Returned by getNextEvent() if no timer is part of the wheel
+    static constexpr uint64_t noEvent = UINT64_MAX;
+
+    /**
+     * \param currentTick
+     *      Tick up to which the timers have been processed.
+     */
+    explicit TimerWheel(uint64_t currentTick = 0);
+
+    // disable copy constructor
+    TimerWheel(const TimerWheel&) = delete;
+
+    // disable copy assignment operator
+    TimerWheel&
+    operator=(const TimerWheel&) = delete;
+
+    /**
+     * Add a timer, O(1).
+     *
+     * A timer which is already part of the wheel is moved to the new
+     * expiry. A timer with an expiry which is not after the current tick is
+     * expired immediately.
+     */
+    void
+    add(TimerWheelNode& node, uint64_t expiry);
+
+    /**
+     * Process all ticks up to and including \p tick.
+     *
+     * Ticks without an event are skipped.
+     */
+    void
+    advance(uint64_t tick);
+
+    /**
+     * Take the next expired timer.
+     *
+     * \return  Expired timer or nullptr if no timer has expired.
+     */
+    TimerWheelNode*
+    popExpired();
+
+    /**
+     * Tick at which advance() has to be called next.
+     *
+     * The current tick if expired timers are waiting, noEvent if the wheel
+     * is empty. The result can be earlier than the next expiry, e.g. when
+     * a timer has to be moved down a level.
+     */
+    uint64_t
+    getNextEvent() const;
+
+    inline uint64_t
+    getCurrentTick() const
+    {
+        return mCurrentTick;
+    }
+
+private:
+    static inline void
+    append(TimerWheelNode& list, TimerWheelNode& node)
+    {
+        node.mNext = &list;
+        node.mPrevious = list.mPrevious;
+        list.mPrevious->mNext = &node;
+        list.mPrevious = &node;
+    }
+
+    static inline bool
+    isEmpty(const TimerWheelNode& list)
+    {
+        return !list.isLinked();
+    }
+
+    void
+    insert(TimerWheelNode& node);
+
+    /// Re-insert all timers of a slot relative to the current tick
+    void
+    cascade(TimerWheelNode& slot);
+
+    void
+    processTick();
+
+    bool
+    hasHigherLevelTimers() const;
+
+    /// Next tick at which a timer expires or has to be moved down
+    uint64_t
+    getNextTick() const;
+
+    /// Sentinels of the lists of each slot
+    TimerWheelNode mSlots[numberOfLevels][slotsPerLevel];
+    TimerWheelNode mExpired;
+
+    uint64_t mCurrentTick;
+};
+
+}  // namespace internal
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
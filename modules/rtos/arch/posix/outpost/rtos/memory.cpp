@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "memory.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+using outpost::rtos::Memory;
+
+/// Size of a transparent huge page on x86 and ARM with 4 KiB pages
+static const uintptr_t hugePageSize = 2 * 1024 * 1024;
+
+bool Memory::threadStackPrefault = false;
+
+bool
+Memory::lockAll()
+{
+    return mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+}
+
+void
+Memory::unlockAll()
+{
+    munlockall();
+}
+
+void
+Memory::prefault(outpost::Slice<uint8_t> memory)
+{
+    static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+    if (memory.getNumberOfElements() == 0)
+    {
+        return;
+    }
+
+    // A read would only map the shared zero page, write the value back
+    volatile uint8_t* data = &memory[0];
+    const uintptr_t start = reinterpret_cast<uintptr_t>(&memory[0]);
+    for (size_t offset = 0; offset < memory.getNumberOfElements();
+         offset += pageSize - ((start + offset) % pageSize))
+    {
+        data[offset] = data[offset];
+    }
+}
+
+bool
+Memory::adviseHugePages(outpost::Slice<uint8_t> memory)
+{
+#ifdef MADV_HUGEPAGE
+    const uintptr_t start = reinterpret_cast<uintptr_t>(memory.begin());
+    const uintptr_t end = start + memory.getNumberOfElements();
+    const uintptr_t first = (start + hugePageSize - 1) & ~(hugePageSize - 1);
+    const uintptr_t last = end & ~(hugePageSize - 1);
+    if (first >= last)
+    {
+        return false;
+    }
+    return madvise(reinterpret_cast<void*>(first), last - first, MADV_HUGEPAGE) == 0;
+#else
+    (void) memory;
+    return false;
+#endif
+}
+
+void
+Memory::setThreadStackPrefault(bool enable)
+{
+    threadStackPrefault = enable;
+}
+
+bool
+Memory::isThreadStackPrefaultEnabled()
+{
+    return threadStackPrefault;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_POSIX_MEMORY_H
+#define OUTPOST_RTOS_POSIX_MEMORY_H
+
+#include <outpost/base/slice.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Avoid page faults in the real-time paths.
+ *
+ * Linux maps memory on the first access, the first write to a pool
+ * buffer, queue or stack page therefore takes a page fault of up to
+ * hundreds of microseconds. Call lockAll() during the initialization,
+ * before the threads are started:
+ *
+ * \code
+ * outpost::rtos::Memory::setThreadStackPrefault(true);
+ * outpost::rtos::Memory::lockAll();
+ * \endcode
+ *
+ * On the other targets all memory is resident and the functions do
+ * nothing.
+ *
+ * \ingroup    rtos
+ */
+class Memory
+{
+public:
+    /**
+     * Lock all current and future mappings of the process into memory.
+     *
+     * Faults in all memory which is already mapped, e.g. statically
+     * allocated pools and queues, and every later mapping when it is
+     * created, e.g. thread stacks.
+     *
+     * \retval false  Missing permission (CAP_IPC_LOCK) or the limit of
+     *                locked memory (RLIMIT_MEMLOCK) is too low.
+     */
+    static bool
+    lockAll();
+
+    /**
+     * Release the locks of lockAll().
+     */
+    static void
+    unlockAll();
+
+    /**
+     * Touch every page of \p memory, the content is not changed.
+     *
+     * Every page is written with its current value, \p memory must
+     * therefore not be changed concurrently.
+     */
+    static void
+    prefault(outpost::Slice<uint8_t> memory);
+
+    /**
+     * Ask for transparent huge pages for the parts of \p memory which
+     * cover complete huge pages.
+     *
+     * Has to be called before the memory is touched for the first time.
+     *
+     * \retval false  \p memory does not cover a huge page or huge pages
+     *                are not supported.
+     */
+    static bool
+    adviseHugePages(outpost::Slice<uint8_t> memory);
+
+    /**
+     * Fault in the complete stack of threads started afterwards before
+     * their run() function is called.
+     *
+     * The stack usage reported by ThreadProfiler is then always the
+     * stack size.
+     */
+    static void
+    setThreadStackPrefault(bool enable);
+
+    static bool
+    isThreadStackPrefaultEnabled();
+
+private:
+    // Only static functions
+    Memory() = delete;
+
+    static bool threadStackPrefault;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
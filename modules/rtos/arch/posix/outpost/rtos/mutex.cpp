@@ -16,41 +16,93 @@
 
 #include "internal/time.h"
 
-#include <outpost/rtos/failure_handler.h>
+using outpost::rtos::Mutex;
+using outpost::rtos::internal::Futex;
 
-#include <time.h>
+constexpr uint32_t Mutex::unlocked;
+constexpr uint32_t Mutex::locked;
+constexpr uint32_t Mutex::contended;
 
-using namespace outpost::rtos;
+/// Upper limit for the number of iterations spent spinning
+static constexpr uint32_t maximumSpinIterations = 100;
 
-Mutex::Mutex()
+bool
+Mutex::acquire(outpost::time::Duration timeout)
 {
-    pthread_mutexattr_t attr;
-    if (pthread_mutexattr_init(&attr) != 0)
+    if (timeout == time::Duration::infinity())
     {
-        FailureHandler::fatal(FailureCode::resourceAllocationFailed(Resource::mutex));
+        return acquire();
     }
 
-    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
-    pthread_mutex_init(&mMutex, &attr);
+    const uint32_t self = Futex::getCurrentThreadId();
+    if (isOwnedBy(self))
+    {
+        mCount++;
+        return true;
+    }
 
-    if (pthread_mutexattr_destroy(&attr) != 0)
+    uint32_t expected = unlocked;
+    if (!mState.compare_exchange_strong(expected, getLockedState(self), std::memory_order_acquire))
     {
-        FailureHandler::fatal(FailureCode::resourceAllocationFailed(Resource::mutex));
+        const timespec deadline = toAbsoluteTime(CLOCK_MONOTONIC, timeout);
+        if (!lockContended(self, &deadline))
+        {
+            return false;
+        }
     }
+    setOwner(self);
+    return true;
 }
 
 bool
-Mutex::acquire(outpost::time::Duration timeout)
+Mutex::lockContended(uint32_t self, const timespec* deadline)
 {
-    bool success = false;
-    if (timeout == time::Duration::infinity())
+    const uint32_t lockedState = getLockedState(self);
+    if (Futex::isSpinningUseful())
     {
-        success = acquire();
+        // Same adaption as the adaptive mutexes of glibc: spin up to twice
+        // the average number of iterations needed before
+        const uint32_t average = mSpinIterations.load(std::memory_order_relaxed);
+        uint32_t limit = average * 2 + 10;
+        if (limit > maximumSpinIterations)
+        {
+            limit = maximumSpinIterations;
+        }
+
+        for (uint32_t i = 0; i < limit; ++i)
+        {
+            if (mState.load(std::memory_order_relaxed) == unlocked)
+            {
+                uint32_t expected = unlocked;
+                if (mState.compare_exchange_weak(
+                            expected, lockedState, std::memory_order_acquire))
+                {
+                    mSpinIterations.store(average + (static_cast<int32_t>(i - average) / 8),
+                                          std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            Futex::pause();
+        }
+        mSpinIterations.store(average + (static_cast<int32_t>(limit - average) / 8),
+                              std::memory_order_relaxed);
     }
-    else
+
+#ifdef OUTPOST_RTOS_POSIX_MUTEX_PRIORITY_INHERITANCE
+    return Futex::lockPriorityInheritance(mState, deadline);
+#else
+    // Mark the mutex as contended, so that the owner wakes up a waiting
+    // thread when releasing it. After waking up the state has to stay
+    // contended as long as other threads might be waiting.
+    uint32_t state = mState.exchange(contended, std::memory_order_acquire);
+    while (state != unlocked)
     {
-        timespec time = toAbsoluteTime(CLOCK_REALTIME, timeout);
-        success = (pthread_mutex_timedlock(&mMutex, &time) == 0);
+        if (!Futex::wait(mState, contended, deadline))
+        {
+            return false;
+        }
+        state = mState.exchange(contended, std::memory_order_acquire);
     }
-    return success;
+    return true;
+#endif
 }
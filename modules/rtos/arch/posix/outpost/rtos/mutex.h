@@ -15,10 +15,14 @@
 #ifndef OUTPOST_RTOS_POSIX_MUTEX_HPP
 #define OUTPOST_RTOS_POSIX_MUTEX_HPP
 
-#include <pthread.h>
+#include "internal/futex.h"
 
 #include <outpost/time/duration.h>
 
+#include <stdint.h>
+
+#include <atomic>
+
 namespace outpost
 {
 namespace rtos
@@ -26,12 +30,25 @@ namespace rtos
 /**
  * Mutex
  *
+ * Recursive mutex based on a Linux futex. Acquiring and releasing an
+ * uncontended mutex is a single atomic operation in userspace, the
+ * kernel is only involved if a thread has to sleep. A contended mutex is
+ * spun on for a short time on multiprocessor systems before sleeping.
+ * The number of iterations adapts to how long the mutex was held
+ * previously.
+ *
+ * With \c OUTPOST_RTOS_POSIX_MUTEX_PRIORITY_INHERITANCE defined the
+ * mutexes use the priority inheritance futexes of the kernel: a thread
+ * holding a mutex runs with the priority of the highest waiting thread.
+ *
  * \author    Fabian Greif
  */
 class Mutex
 {
 public:
-    Mutex();
+    constexpr Mutex() : mState(unlocked), mOwner(0), mCount(0), mSpinIterations(0)
+    {
+    }
 
     // disable copy constructor
     Mutex(const Mutex& other) = delete;
@@ -42,7 +59,6 @@ public:
 
     inline ~Mutex()
     {
-        pthread_mutex_destroy(&mMutex);
     }
 
     /**
@@ -56,7 +72,24 @@ public:
     inline bool
     acquire()
     {
-        return (pthread_mutex_lock(&mMutex) == 0);
+        const uint32_t self = internal::Futex::getCurrentThreadId();
+        if (isOwnedBy(self))
+        {
+            mCount++;
+            return true;
+        }
+
+        uint32_t expected = unlocked;
+        if (!mState.compare_exchange_strong(
+                    expected, getLockedState(self), std::memory_order_acquire))
+        {
+            if (!lockContended(self, nullptr))
+            {
+                return false;
+            }
+        }
+        setOwner(self);
+        return true;
     }
 
     /**
@@ -75,15 +108,87 @@ public:
 
     /**
      * Release the mutex.
+     *
+     * Does nothing if the calling thread does not hold the mutex.
      */
     inline void
     release()
     {
-        pthread_mutex_unlock(&mMutex);
+        const uint32_t self = internal::Futex::getCurrentThreadId();
+        if (!isOwnedBy(self))
+        {
+            return;
+        }
+
+        mCount--;
+        if (mCount == 0)
+        {
+            mOwner.store(0, std::memory_order_relaxed);
+#ifdef OUTPOST_RTOS_POSIX_MUTEX_PRIORITY_INHERITANCE
+            uint32_t expected = self;
+            if (!mState.compare_exchange_strong(expected, unlocked, std::memory_order_release))
+            {
+                internal::Futex::unlockPriorityInheritance(mState);
+            }
+#else
+            if (mState.exchange(unlocked, std::memory_order_release) == contended)
+            {
+                internal::Futex::wake(mState, 1);
+            }
+#endif
+        }
     }
 
 private:
-    pthread_mutex_t mMutex;
+    /// Values of the futex word, with priority inheritance the word of a
+    /// locked mutex contains the thread id of the owner instead.
+    static constexpr uint32_t unlocked = 0;
+    static constexpr uint32_t locked = 1;
+    static constexpr uint32_t contended = 2;
+
+    static inline uint32_t
+    getLockedState(uint32_t self)
+    {
+#ifdef OUTPOST_RTOS_POSIX_MUTEX_PRIORITY_INHERITANCE
+        return self;
+#else
+        (void) self;
+        return locked;
+#endif
+    }
+
+    inline bool
+    isOwnedBy(uint32_t self) const
+    {
+        // Only the thread itself can write its own id
+        return (mOwner.load(std::memory_order_relaxed) == self);
+    }
+
+    inline void
+    setOwner(uint32_t self)
+    {
+        mOwner.store(self, std::memory_order_relaxed);
+        mCount = 1;
+    }
+
+    /**
+     * Slow path if the mutex is held by another thread.
+     *
+     * \retval false   Deadline has passed or error.
+     */
+    bool
+    lockContended(uint32_t self, const timespec* deadline);
+
+    std::atomic<uint32_t> mState;
+
+    /// Thread id of the owner, zero if unlocked
+    std::atomic<uint32_t> mOwner;
+
+    /// Recursion depth, only accessed by the owner
+    uint32_t mCount;
+
+    /// Moving average of the number of iterations needed while spinning
+    std::atomic<uint32_t> mSpinIterations;
 };
 
 }  // namespace rtos
@@ -22,7 +22,13 @@
 
 using namespace outpost::rtos;
 
-PeriodicTaskManager::PeriodicTaskManager() : mMutex(), mTimerRunning(false), mNextWakeTime()
+PeriodicTaskManager::PeriodicTaskManager(OverrunPolicy::Type policy) :
+    mMutex(),
+    mPolicy(policy),
+    mTimerRunning(false),
+    mNextWakeTime(),
+    mPeriodStart(),
+    mStatistics()
 {
 }
 
@@ -32,24 +38,42 @@ PeriodicTaskManager::nextPeriod(time::Duration period)
     MutexGuard lock(mMutex);
     Status::Type currentStatus = Status::running;
 
+    const timespec currentTime = getTime(CLOCK_MONOTONIC);
     if (mTimerRunning)
     {
-        timespec currentTime = getTime(CLOCK_MONOTONIC);
+        const time::Duration lateness = getDifference(currentTime, mNextWakeTime);
+        mStatistics.recordEnd(getDifference(currentTime, mPeriodStart), lateness);
 
         // Check if the time is in the current period
         if (isBigger(currentTime, mNextWakeTime))
         {
             currentStatus = Status::timeout;
+            if ((mPolicy == OverrunPolicy::skip) && (period > time::Duration::zero()))
+            {
+                // Start the period which contains the current time
+                const int64_t skipped = lateness.microseconds() / period.microseconds();
+                if (skipped > 0)
+                {
+                    timespec skippedTime =
+                            toRelativeTime(time::Microseconds(period.microseconds() * skipped));
+                    addTime(mNextWakeTime, skippedTime);
+                    mStatistics.recordSkippedPeriods(static_cast<uint32_t>(skipped));
+                }
+            }
+            mPeriodStart = currentTime;
         }
         else
         {
             sleepUntilAbsoluteTime(CLOCK_MONOTONIC, mNextWakeTime);
+            mPeriodStart = getTime(CLOCK_MONOTONIC);
         }
+        mStatistics.recordStart(getDifference(mPeriodStart, mNextWakeTime));
     }
     else
     {
         // period is started now, no need to wait
-        mNextWakeTime = getTime(CLOCK_MONOTONIC);
+        mNextWakeTime = currentTime;
+        mPeriodStart = currentTime;
         mTimerRunning = true;
     }
 
@@ -90,3 +114,17 @@ PeriodicTaskManager::cancel()
     MutexGuard lock(mMutex);
     mTimerRunning = false;
 }
+
+PeriodicTaskStatistics
+PeriodicTaskManager::getStatistics()
+{
+    MutexGuard lock(mMutex);
+    return mStatistics;
+}
+
+void
+PeriodicTaskManager::resetStatistics()
+{
+    MutexGuard lock(mMutex);
+    mStatistics.reset();
+}
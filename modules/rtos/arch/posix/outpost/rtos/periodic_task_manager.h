@@ -15,6 +15,7 @@
 #define OUTPOST_RTOS_POSIX_PERIODIC_TASK_MANAGER_H
 
 #include <outpost/rtos/mutex.h>
+#include <outpost/rtos/periodic_task_statistics.h>
 #include <outpost/time/duration.h>
 
 #include <time.h>
@@ -50,7 +51,28 @@ public:
         };
     };
 
-    PeriodicTaskManager();
+    /**
+     * Handling of periods which have passed when nextPeriod() is called
+     * too late.
+     *
+     * In both cases the periods stay aligned to the time of the first
+     * call of nextPeriod(), overruns do not introduce a drift.
+     */
+    struct OverrunPolicy
+    {
+        enum Type
+        {
+            /// Every missed period is started immediately, until the task
+            /// is back on schedule
+            catchUp,
+
+            /// Periods which have already ended are dropped, the period
+            /// in which nextPeriod() is called is started immediately
+            skip
+        };
+    };
+
+    explicit PeriodicTaskManager(OverrunPolicy::Type policy = OverrunPolicy::catchUp);
 
     ~PeriodicTaskManager() = default;
 
@@ -106,10 +128,28 @@ public:
     void
     cancel();
 
+    /**
+     * Get the timing statistics since the creation or the last call of
+     * resetStatistics().
+     */
+    PeriodicTaskStatistics
+    getStatistics();
+
+    void
+    resetStatistics();
+
 private:
     Mutex mMutex;
+    const OverrunPolicy::Type mPolicy;
     bool mTimerRunning;
+
+    /// End of the current period
     timespec mNextWakeTime;
+
+    /// Time at which nextPeriod() returned
+    timespec mPeriodStart;
+
+    PeriodicTaskStatistics mStatistics;
 };
 
 }  // namespace rtos
@@ -96,6 +96,17 @@ public:
     bool
     receive(T& data, outpost::time::Duration timeout);
 
+protected:
+    /**
+     * Create a Queue which uses the given storage, see StaticQueue.
+     *
+     * \param numberOfItems
+     *      The maximum number of items that the queue can contain.
+     * \param storage
+     *      Buffer for \p numberOfItems items, must outlive the queue.
+     */
+    Queue(size_t numberOfItems, T* storage);
+
 private:
     size_t
     increment(size_t index) const;
@@ -105,12 +116,53 @@ private:
     pthread_cond_t mSignal;
 
     T* mBuffer;
+
+    /// Buffer has been allocated by the queue
+    const bool mOwnsBuffer;
+
     const size_t mMaximumSize;
     size_t mItemsInBuffer;
     size_t mHead;
     size_t mTail;
 };
 
+namespace internal
+{
+/**
+ * Storage of a StaticQueue.
+ *
+ * Base class of StaticQueue so that it is constructed before the queue.
+ */
+template <typename T, size_t N>
+struct StaticQueueStorage
+{
+    T mItems[N];
+};
+}  // namespace internal
+
+/**
+ * Queue with the buffer inside the object.
+ *
+ * Same as Queue but no memory is allocated at construction.
+ *
+ * \tparam T
+ *      Type of the items, limited to POD types.
+ * \tparam N
+ *      The maximum number of items that the queue can contain.
+ *
+ * \ingroup rtos
+ */
+template <typename T, size_t N>
+class StaticQueue : private internal::StaticQueueStorage<T, N>, public Queue<T>
+{
+    static_assert(N > 0, "Queue must hold at least one item");
+
+public:
+    StaticQueue() : Queue<T>(N, this->mItems)
+    {
+    }
+};
+
 }  // namespace rtos
 }  // namespace outpost
 
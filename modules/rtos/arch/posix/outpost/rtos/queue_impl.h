@@ -19,16 +19,49 @@
 
 #include <outpost/rtos/failure_handler.h>
 
+namespace outpost
+{
+namespace rtos
+{
+namespace internal
+{
+/**
+ * Cleanup handler for a thread which is cancelled while it waits for the
+ * queue, otherwise the thread would terminate holding the mutex.
+ */
+inline void
+unlockQueueMutex(void* mutex)
+{
+    pthread_mutex_unlock(static_cast<pthread_mutex_t*>(mutex));
+}
+}  // namespace internal
+}  // namespace rtos
+}  // namespace outpost
+
 template <typename T>
 outpost::rtos::Queue<T>::Queue(size_t numberOfItems) :
     mBuffer(new T[numberOfItems]),
+    mOwnsBuffer(true),
+    mMaximumSize(numberOfItems),
+    mItemsInBuffer(0),
+    mHead(0),
+    mTail(0)
+{
+    pthread_mutex_init(&mMutex, nullptr);
+    initializeMonotonicCondition(mSignal);
+}
+
+template <typename T>
+outpost::rtos::Queue<T>::Queue(size_t numberOfItems, T* storage) :
+    mBuffer(storage),
+    mOwnsBuffer(false),
     mMaximumSize(numberOfItems),
     mItemsInBuffer(0),
     mHead(0),
     mTail(0)
 {
     pthread_mutex_init(&mMutex, nullptr);
-    pthread_cond_init(&mSignal, nullptr);
+    initializeMonotonicCondition(mSignal);
 }
 
 template <typename T>
@@ -39,7 +72,10 @@ outpost::rtos::Queue<T>::~Queue()
     mItemsInBuffer = 0;
     mHead = 0;
     mTail = 0;
-    delete[] mBuffer;
+    if (mOwnsBuffer)
+    {
+        delete[] mBuffer;
+    }
 
     pthread_mutex_unlock(&mMutex);
 
@@ -76,7 +112,15 @@ outpost::rtos::Queue<T>::receive(T& data, outpost::time::Duration timeout)
     bool itemRetrieved = false;
     bool timeoutOrErrorOccured = false;
 
+    // Calculated once, spurious wake-ups must not extend the timeout
+    timespec deadline = {0, 0};
+    if (timeout != outpost::time::Duration::infinity())
+    {
+        deadline = toAbsoluteTime(CLOCK_MONOTONIC, timeout);
+    }
+
     pthread_mutex_lock(&mMutex);
+    pthread_cleanup_push(&internal::unlockQueueMutex, &mMutex);
     while ((mItemsInBuffer == 0) && !timeoutOrErrorOccured)
     {
         if (timeout == outpost::time::Duration::infinity())
@@ -89,8 +133,7 @@ outpost::rtos::Queue<T>::receive(T& data, outpost::time::Duration timeout)
         }
         else
         {
-            timespec time = toAbsoluteTime(CLOCK_REALTIME, timeout);
-            if (pthread_cond_timedwait(&mSignal, &mMutex, &time) != 0)
+            if (pthread_cond_timedwait(&mSignal, &mMutex, &deadline) != 0)
             {
                 // Timeout or other error has occurred
                 timeoutOrErrorOccured = true;
@@ -107,7 +150,8 @@ outpost::rtos::Queue<T>::receive(T& data, outpost::time::Duration timeout)
         itemRetrieved = true;
     }
 
-    pthread_mutex_unlock(&mMutex);
+    // Releases the mutex
+    pthread_cleanup_pop(1);
     return itemRetrieved;
 }
 
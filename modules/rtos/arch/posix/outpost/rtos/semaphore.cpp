@@ -47,80 +47,69 @@ Semaphore::acquire(time::Duration timeout)
     }
     else
     {
-        timespec t = toAbsoluteTime(CLOCK_REALTIME, timeout);
-        success = (sem_timedwait(&mSid, &t) == 0);
+        timespec t = toAbsoluteTime(CLOCK_MONOTONIC, timeout);
+        success = waitUntilAbsoluteTime(mSid, t);
     }
     return success;
 }
 
 // ----------------------------------------------------------------------------
-BinarySemaphore::BinarySemaphore() : mValue(BinarySemaphore::State::released)
-{
-    pthread_mutex_init(&mMutex, NULL);
-    pthread_cond_init(&mSignal, NULL);
-}
+constexpr uint32_t BinarySemaphore::acquiredState;
+constexpr uint32_t BinarySemaphore::releasedState;
+constexpr uint32_t BinarySemaphore::waitingState;
 
-BinarySemaphore::BinarySemaphore(State::Type initial) : mValue(initial)
+BinarySemaphore::BinarySemaphore() : mValue(releasedState)
 {
-    pthread_mutex_init(&mMutex, NULL);
-    pthread_cond_init(&mSignal, NULL);
 }
 
-BinarySemaphore::~BinarySemaphore()
+BinarySemaphore::BinarySemaphore(State::Type initial) :
+    mValue((initial == State::released) ? releasedState : acquiredState)
 {
-    pthread_cond_destroy(&mSignal);
-    pthread_mutex_destroy(&mMutex);
 }
 
 bool
-BinarySemaphore::acquire()
+BinarySemaphore::acquire(time::Duration timeout)
 {
-    pthread_mutex_lock(&mMutex);
-    while (mValue == State::acquired)
+    if (timeout == time::Duration::infinity())
+    {
+        return acquire();
+    }
+
+    uint32_t expected = releasedState;
+    if (mValue.compare_exchange_strong(expected, acquiredState, std::memory_order_acquire))
     {
-        pthread_cond_wait(&mSignal, &mMutex);
+        return true;
     }
-    mValue = State::acquired;
-    pthread_mutex_unlock(&mMutex);
 
-    return true;
+    // Calculated once, spurious wake-ups must not extend the timeout
+    const timespec deadline = toAbsoluteTime(CLOCK_MONOTONIC, timeout);
+    return acquireContended(&deadline);
 }
 
 bool
-BinarySemaphore::acquire(time::Duration timeout)
+BinarySemaphore::acquireContended(const timespec* deadline)
 {
-    bool success = false;
-    if (timeout == time::Duration::infinity())
+    uint32_t state = mValue.load(std::memory_order_relaxed);
+    while (true)
     {
-        success = acquire();
-    }
-    else
-    {
-        timespec time = toAbsoluteTime(CLOCK_REALTIME, timeout);
-        pthread_mutex_lock(&mMutex);
-        while (mValue == State::acquired)
+        if (state == releasedState)
+        {
+            // Other threads might still be waiting, keep the waiting state
+            // so that they are woken up by the next release
+            if (mValue.compare_exchange_weak(state, waitingState, std::memory_order_acquire))
+            {
+                return true;
+            }
+        }
+        else if ((state == waitingState)
+                 || mValue.compare_exchange_weak(
+                         state, waitingState, std::memory_order_relaxed))
         {
-            if (pthread_cond_timedwait(&mSignal, &mMutex, &time) != 0)
+            if (!internal::Futex::wait(mValue, waitingState, deadline))
             {
-                // Timeout or other error has occurred
-                // => semaphore can't be acquired
-                pthread_mutex_unlock(&mMutex);
                 return false;
             }
+            state = mValue.load(std::memory_order_relaxed);
         }
-        mValue = State::acquired;
-        pthread_mutex_unlock(&mMutex);
-
-        success = true;
     }
-    return success;
-}
-
-void
-BinarySemaphore::release()
-{
-    pthread_mutex_lock(&mMutex);
-    mValue = State::released;
-    pthread_cond_signal(&mSignal);
-    pthread_mutex_unlock(&mMutex);
 }
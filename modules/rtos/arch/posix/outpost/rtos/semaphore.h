@@ -14,13 +14,16 @@
 #ifndef OUTPOST_RTOS_POSIX_SEMAPHORE_HPP
 #define OUTPOST_RTOS_POSIX_SEMAPHORE_HPP
 
-#include <pthread.h>
+#include "internal/futex.h"
+
 #include <semaphore.h>
 
 #include <outpost/time/duration.h>
 
 #include <stdint.h>
 
+#include <atomic>
+
 namespace outpost
 {
 namespace rtos
@@ -101,6 +104,9 @@ private:
  *
  * Restricts the value of the semaphore to 0 and 1.
  *
+ * Based on a Linux futex, the kernel is only involved if a thread has to
+ * sleep or has to be woken up.
+ *
  * \author    Fabian Greif
  */
 class BinarySemaphore
@@ -138,19 +144,22 @@ public:
     BinarySemaphore&
     operator=(const BinarySemaphore& other) = delete;
 
-    /**
-     * Destroy the semaphore and release it's resources.
-     */
-    ~BinarySemaphore();
-
     /**
      * Decrement the count.
      *
      * Blocks if the count is currently zero until it is incremented
      * by another thread calling the release() method.
      */
-    bool
-    acquire();
+    inline bool
+    acquire()
+    {
+        uint32_t expected = releasedState;
+        if (mValue.compare_exchange_strong(expected, acquiredState, std::memory_order_acquire))
+        {
+            return true;
+        }
+        return acquireContended(nullptr);
+    }
 
     /**
      * Decrement the count.
@@ -172,14 +181,43 @@ public:
      * This function will never block, but may preempt if an other
      * thread waiting for this semaphore has a higher priority.
      */
-    void
-    release();
+    inline void
+    release()
+    {
+        if (mValue.exchange(releasedState, std::memory_order_release) == waitingState)
+        {
+            internal::Futex::wake(mValue, 1);
+        }
+    }
+
+    /**
+     * Increment the count from an interrupt handler.
+     *
+     * There are no interrupts on POSIX, identical to release().
+     */
+    inline void
+    releaseFromInterrupt()
+    {
+        release();
+    }
 
 private:
-    // POSIX handles
-    pthread_mutex_t mMutex;
-    pthread_cond_t mSignal;
-    State::Type mValue;
+    /// Values of the futex word
+    static constexpr uint32_t acquiredState = 0;
+    static constexpr uint32_t releasedState = 1;
+
+    /// Acquired and threads might be waiting
+    static constexpr uint32_t waitingState = 2;
+
+    /**
+     * Slow path if the semaphore is not released.
+     *
+     * \retval false   Deadline has passed.
+     */
+    bool
+    acquireContended(const timespec* deadline);
+
+    std::atomic<uint32_t> mValue;
 };
 
 }  // namespace rtos
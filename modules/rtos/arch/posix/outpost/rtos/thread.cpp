@@ -23,16 +23,167 @@
 #include "internal/time.h"
 
 #include <outpost/rtos/failure_handler.h>
+#include <outpost/rtos/memory.h>
+#include <outpost/rtos/thread_profiler.h>
 
+#include <errno.h>
+#include <limits.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
 #include <time.h>
 
 using outpost::rtos::Thread;
 
+Thread::SchedulingPolicy Thread::defaultSchedulingPolicy = Thread::timeSharing;
+
+/**
+ * Number of bytes between the lowest resident page of the stack and its
+ * top.
+ *
+ * Untouched stack pages are not backed by memory, the result is therefore
+ * an upper bound of the used stack with page granularity. A cached stack
+ * of a terminated thread may already be resident.
+ */
+static size_t
+getResidentStackSize(void* stackAddress, size_t stackSize)
+{
+    static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+    uint8_t* const bottom = reinterpret_cast<uint8_t*>(stackAddress);
+    const size_t numberOfPages = stackSize / pageSize;
+
+    // Query in chunks to get along with a small buffer on the stack
+    unsigned char residency[256];
+    for (size_t page = 0; page < numberOfPages; page += sizeof(residency))
+    {
+        size_t count = numberOfPages - page;
+        if (count > sizeof(residency))
+        {
+            count = sizeof(residency);
+        }
+
+        if (mincore(bottom + page * pageSize, count * pageSize, residency) != 0)
+        {
+            return 0;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if ((residency[i] & 1) != 0)
+            {
+                return stackSize - (page + i) * pageSize;
+            }
+        }
+    }
+    return 0;
+}
+
+static uint32_t
+getContextSwitches(Thread::Identifier tid)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/self/task/%u/status", static_cast<unsigned int>(tid));
+
+    FILE* file = fopen(path, "r");
+    if (file == NULL)
+    {
+        return 0;
+    }
+
+    uint32_t contextSwitches = 0;
+    char line[128];
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        unsigned int value;
+        if ((sscanf(line, "voluntary_ctxt_switches: %u", &value) == 1)
+            || (sscanf(line, "nonvoluntary_ctxt_switches: %u", &value) == 1))
+        {
+            contextSwitches += value;
+        }
+    }
+    fclose(file);
+    return contextSwitches;
+}
+
+static bool
+applyAffinity(pthread_t thread, pthread_attr_t* attr, uint32_t cpuMask)
+{
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (size_t cpu = 0; cpu < 32; ++cpu)
+    {
+        if ((cpuMask == 0) || ((cpuMask & (1UL << cpu)) != 0))
+        {
+            CPU_SET(cpu, &cpus);
+        }
+    }
+
+    int result;
+    if (attr != NULL)
+    {
+        // The attribute accepts any mask, pthread_create() would then fail
+        // if none of the processors is available to the process
+        cpu_set_t available;
+        if (sched_getaffinity(0, sizeof(available), &available) == 0)
+        {
+            CPU_AND(&available, &available, &cpus);
+            if (CPU_COUNT(&available) == 0)
+            {
+                return false;
+            }
+        }
+        result = pthread_attr_setaffinity_np(attr, sizeof(cpus), &cpus);
+    }
+    else
+    {
+        result = pthread_setaffinity_np(thread, sizeof(cpus), &cpus);
+    }
+    return (result == 0);
+}
+
+/**
+ * Fault in the stack pages below the calling function, so that run() does
+ * not take page faults when its stack grows.
+ */
+static void __attribute__((noinline))
+prefaultStack()
+{
+    static const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) != 0)
+    {
+        return;
+    }
+
+    void* stackAddress;
+    size_t stackSize;
+    if (pthread_attr_getstack(&attr, &stackAddress, &stackSize) == 0)
+    {
+        // Leave a margin below the current frame, the stack grows downwards
+        volatile uint8_t marker = 0;
+        const uintptr_t bottom = reinterpret_cast<uintptr_t>(stackAddress);
+        const uintptr_t top = (reinterpret_cast<uintptr_t>(&marker) & ~(pageSize - 1)) - pageSize;
+        for (uintptr_t page = bottom; page < top; page += pageSize)
+        {
+            *reinterpret_cast<volatile uint8_t*>(page) = 0;
+        }
+    }
+    pthread_attr_destroy(&attr);
+}
+
 void*
 Thread::wrapper(void* object)
 {
     Thread* thread = reinterpret_cast<Thread*>(object);
 
+    if (Memory::isThreadStackPrefaultEnabled())
+    {
+        prefaultStack();
+    }
+
     thread->mTid = Thread::getCurrentThreadIdentifier();
     thread->run();
 
@@ -44,11 +195,18 @@ Thread::wrapper(void* object)
     return NULL;
 }
 
-Thread::Thread(uint8_t, size_t, const char* name, FloatingPointSupport /*floatingPointSupport*/) :
+Thread::Thread(uint8_t priority,
+               size_t stack,
+               const char* name,
+               FloatingPointSupport /*floatingPointSupport*/) :
     mIsRunning(false),
     mPthreadId(),
     mTid(),
-    mName()
+    mName(),
+    mPriority(priority),
+    mStackSize(stack),
+    mSchedulingPolicy(defaultSchedulingPolicy),
+    mCpuMask(0)
 {
     if (name != 0)
     {
@@ -60,6 +218,7 @@ Thread::~Thread()
 {
     if (mIsRunning)
     {
+        ThreadProfiler::unregisterThread(*this);
         pthread_cancel(mPthreadId);
         pthread_join(mPthreadId, NULL);
     }
@@ -82,6 +241,50 @@ Thread::getCurrentThreadIdentifier()
 #endif
 }
 
+void
+Thread::getProfile(ThreadProfile& profile) const
+{
+    profile.setName(mName.c_str());
+    profile.identifier = mTid;
+    profile.priority = mPriority;
+    profile.cpuTime = time::Duration::zero();
+    profile.stackSize = 0;
+    profile.stackUsage = 0;
+    profile.contextSwitches = 0;
+
+    if (!mIsRunning)
+    {
+        return;
+    }
+
+    clockid_t clock;
+    timespec cpuTime;
+    if ((pthread_getcpuclockid(mPthreadId, &clock) == 0) && (clock_gettime(clock, &cpuTime) == 0))
+    {
+        profile.cpuTime =
+                time::Seconds(cpuTime.tv_sec) + time::Microseconds(cpuTime.tv_nsec / 1000);
+    }
+
+    pthread_attr_t attr;
+    if (pthread_getattr_np(mPthreadId, &attr) == 0)
+    {
+        void* stackAddress;
+        size_t stackSize;
+        if (pthread_attr_getstack(&attr, &stackAddress, &stackSize) == 0)
+        {
+            profile.stackSize = stackSize;
+            profile.stackUsage = getResidentStackSize(stackAddress, stackSize);
+        }
+        pthread_attr_destroy(&attr);
+    }
+
+    // The identifier is set by the thread itself after its start
+    if (mTid != 0)
+    {
+        profile.contextSwitches = getContextSwitches(mTid);
+    }
+}
+
 void
 Thread::start()
 {
@@ -89,7 +292,44 @@ Thread::start()
     pthread_attr_t attr;
     pthread_attr_init(&attr);
 
+    if (mStackSize != defaultStackSize)
+    {
+        size_t stackSize = mStackSize;
+        if (stackSize < static_cast<size_t>(PTHREAD_STACK_MIN))
+        {
+            stackSize = PTHREAD_STACK_MIN;
+        }
+        pthread_attr_setstacksize(&attr, stackSize);
+    }
+
+    if (mSchedulingPolicy != timeSharing)
+    {
+        sched_param parameter;
+        memset(&parameter, 0, sizeof(parameter));
+        parameter.sched_priority = toPosixPriority(mPriority, mSchedulingPolicy);
+
+        pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(&attr, toPosixPolicy(mSchedulingPolicy));
+        pthread_attr_setschedparam(&attr, &parameter);
+    }
+
+    if ((mCpuMask != 0) && !applyAffinity(mPthreadId, &attr, mCpuMask))
+    {
+        std::cerr << "Processor affinity of thread '" << mName << "' rejected, "
+                  << "using the inherited affinity" << std::endl;
+        mCpuMask = 0;
+    }
+
     int ret = pthread_create(&mPthreadId, &attr, &Thread::wrapper, reinterpret_cast<void*>(this));
+    if ((ret == EPERM) && (mSchedulingPolicy != timeSharing))
+    {
+        std::cerr << "Missing permission for real-time scheduling of thread '" << mName
+                  << "', using the inherited scheduling parameters" << std::endl;
+
+        pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+        ret = pthread_create(&mPthreadId, &attr, &Thread::wrapper, reinterpret_cast<void*>(this));
+    }
+
     if (ret != 0)
     {
         FailureHandler::fatal(FailureCode::resourceAllocationFailed(Resource::thread));
@@ -105,19 +345,86 @@ Thread::start()
     }
 
     pthread_attr_destroy(&attr);
+
+    ThreadProfiler::registerThread(*this);
 }
 
 void
 Thread::setPriority(uint8_t priority)
 {
-    // No priority defined for POSIX!
-    (void) priority;
+    mPriority = priority;
+    if (mIsRunning && (mSchedulingPolicy != timeSharing))
+    {
+        // Fails without permission for real-time scheduling, the thread
+        // then keeps its inherited priority.
+        pthread_setschedprio(mPthreadId, toPosixPriority(priority, mSchedulingPolicy));
+    }
 }
 
 uint8_t
 Thread::getPriority() const
 {
-    return 0;
+    return mPriority;
+}
+
+void
+Thread::setDefaultSchedulingPolicy(SchedulingPolicy policy)
+{
+    defaultSchedulingPolicy = policy;
+}
+
+Thread::SchedulingPolicy
+Thread::getDefaultSchedulingPolicy()
+{
+    return defaultSchedulingPolicy;
+}
+
+void
+Thread::setSchedulingPolicy(SchedulingPolicy policy)
+{
+    if (!mIsRunning)
+    {
+        mSchedulingPolicy = policy;
+    }
+}
+
+bool
+Thread::setAffinity(uint32_t cpuMask)
+{
+    bool result = true;
+    if (mIsRunning)
+    {
+        result = applyAffinity(mPthreadId, NULL, cpuMask);
+    }
+
+    if (result)
+    {
+        mCpuMask = cpuMask;
+    }
+    return result;
+}
+
+int
+Thread::toPosixPriority(uint8_t priority, SchedulingPolicy policy)
+{
+    const int policyValue = toPosixPolicy(policy);
+    const int minimum = sched_get_priority_min(policyValue);
+    const int maximum = sched_get_priority_max(policyValue);
+
+    return minimum + (static_cast<int>(priority) * (maximum - minimum)) / 255;
+}
+
+int
+Thread::toPosixPolicy(SchedulingPolicy policy)
+{
+    int result = SCHED_OTHER;
+    switch (policy)
+    {
+        case fifo: result = SCHED_FIFO; break;
+        case roundRobin: result = SCHED_RR; break;
+        case timeSharing: result = SCHED_OTHER; break;
+    }
+    return result;
 }
 
 void
@@ -27,6 +27,8 @@ namespace outpost
 {
 namespace rtos
 {
+struct ThreadProfile;
+
 /**
  * Wrapper class for the Thread function of the Operating System.
  *
@@ -49,6 +51,21 @@ public:
         floatingPoint
     };
 
+    /**
+     * Scheduling policy of the POSIX thread.
+     */
+    enum SchedulingPolicy
+    {
+        /// SCHED_OTHER, the priority is stored but not used by the scheduler
+        timeSharing,
+
+        /// SCHED_FIFO, real-time scheduling with the mapped priority
+        fifo,
+
+        /// SCHED_RR, like fifo but threads of equal priority share the processor
+        roundRobin
+    };
+
     /**
      * Initial return value of getIdentifier() before the
      * thread have been started and an associated thread id.
@@ -66,13 +83,18 @@ public:
      * Create a new thread.
      *
      * \param priority
-     *         Not used for POSIX.
+     *         Thread priority. A higher value represents a higher priority.
+     *         Mapped linearly to the priority range of the scheduling policy,
+     *         only used by the real-time policies.
      * \param stack
-     *         Not used for POSIX.
+     *         Stack size in bytes. Rounded up to PTHREAD_STACK_MIN, the
+     *         default stack size of the system is used for
+     *         \c defaultStackSize.
      * \param name
      *         Name of the thread. Must not be longer than 16 characters.
      *
      * \see    rtos::FailureHandler::fatal()
+     * \see    setDefaultSchedulingPolicy()
      */
     explicit Thread(uint8_t priority,
                     size_t stack = defaultStackSize,
@@ -92,10 +114,65 @@ public:
      *
      * This may preempt the current thread if the thread to be executed
      * has a higher priority.
+     *
+     * If the process is not allowed to use the real-time scheduling policy
+     * (e.g. missing CAP_SYS_NICE or RLIMIT_RTPRIO) a warning is printed and
+     * the thread is started with the scheduling parameters inherited from
+     * the creating thread.
      */
     void
     start();
 
+    /**
+     * Set the scheduling policy for threads constructed afterwards.
+     *
+     * Defaults to \c timeSharing. Applications with real-time requirements
+     * should select \c fifo or \c roundRobin before creating their threads.
+     */
+    static void
+    setDefaultSchedulingPolicy(SchedulingPolicy policy);
+
+    static SchedulingPolicy
+    getDefaultSchedulingPolicy();
+
+    /**
+     * Set the scheduling policy of the thread.
+     *
+     * Must be called before the thread is started.
+     */
+    void
+    setSchedulingPolicy(SchedulingPolicy policy);
+
+    inline SchedulingPolicy
+    getSchedulingPolicy() const
+    {
+        return mSchedulingPolicy;
+    }
+
+    /**
+     * Restrict the thread to a set of processors.
+     *
+     * Can be called before or after the thread is started. A stored mask
+     * without any processor available to the process is dropped by
+     * start(), the thread then keeps the inherited affinity like it keeps
+     * the inherited priority without permission for real-time scheduling.
+     *
+     * \param cpuMask
+     *         Bit \c n selects processor \c n. 0 allows all processors.
+     *
+     * \return \c true if the affinity has been applied or stored for the
+     *         start of the thread, \c false if the mask is rejected by the
+     *         system.
+     */
+    bool
+    setAffinity(uint32_t cpuMask);
+
+    inline uint32_t
+    getAffinity() const
+    {
+        return mCpuMask;
+    }
+
     /**
      * Get a unique identifier for this thread.
      *
@@ -115,13 +192,29 @@ public:
     getCurrentThreadIdentifier();
 
     /**
-     * Unused for POSIX.
+     * Query the processor time and stack usage of the thread.
+     *
+     * \see ThreadProfiler
+     */
+    void
+    getProfile(ThreadProfile& profile) const;
+
+    /**
+     * Set a new priority for the thread.
+     *
+     * Applied immediately to a started thread with a real-time scheduling
+     * policy, otherwise only stored.
+     *
+     * \param priority
+     *         Thread priority. Higher values represent a higher priority.
      */
     void
     setPriority(uint8_t priority);
 
     /**
-     * Unused for POSIX.
+     * Read the priority.
+     *
+     * \return    Priority of the thread
      */
     uint8_t
     getPriority() const;
@@ -156,10 +249,27 @@ private:
     static void*
     wrapper(void* object);
 
+    /**
+     * Map the 0..255 priority to the priority range of the policy,
+     * 0 is the lowest and 255 the highest priority.
+     */
+    static int
+    toPosixPriority(uint8_t priority, SchedulingPolicy policy);
+
+    static int
+    toPosixPolicy(SchedulingPolicy policy);
+
+    static SchedulingPolicy defaultSchedulingPolicy;
+
     bool mIsRunning;
     pthread_t mPthreadId;
     Identifier mTid;
     std::string mName;
+
+    uint8_t mPriority;
+    size_t mStackSize;
+    SchedulingPolicy mSchedulingPolicy;
+    uint32_t mCpuMask;
 };
 
 }  // namespace rtos
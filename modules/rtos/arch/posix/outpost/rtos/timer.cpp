@@ -14,109 +14,268 @@
 #include "timer.h"
 
 #include "internal/time.h"
+#include "thread.h"
 
 #include <outpost/rtos/failure_handler.h>
 
-#include <cstring>
+#include <pthread.h>
+#include <time.h>
 
 using outpost::rtos::Timer;
+using outpost::rtos::internal::TimerWheel;
+using outpost::rtos::internal::TimerWheelNode;
 
-Timer::~Timer()
+namespace outpost
 {
-    timer_delete(mTid);
-}
-
-void
-Timer::start(time::Duration duration)
+namespace rtos
+{
+namespace internal
+{
+/**
+ * Timer daemon thread driving the timing wheel of all timers.
+ *
+ * One tick of the wheel is one millisecond of CLOCK_MONOTONIC, counted
+ * from the creation of the service. The thread sleeps until the next
+ * event of the wheel and is only woken up early if a timer is started
+ * which expires before that.
+ */
+class TimerService : public Thread
 {
-    // initial expiration
-    timespec relative = toRelativeTime(duration);
+public:
+    /**
+     * Get the service, it is created with the given parameters if it does
+     * not exist yet. The service is never destroyed, timers with static
+     * storage duration may use it until the end of the program.
+     */
+    static TimerService&
+    getInstance(uint8_t priority, size_t stack);
 
-    itimerspec time;
-    time.it_interval.tv_sec = 0;
-    time.it_interval.tv_nsec = 0;
+    /// Get the service if it has been created before, otherwise nullptr
+    static TimerService*
+    findInstance();
 
-    time.it_value.tv_sec = relative.tv_sec;
-    time.it_value.tv_nsec = relative.tv_nsec;
+    void
+    add(Timer& timer, time::Duration duration);
 
-    memcpy(&mInterval, &time, sizeof(itimerspec));
+    void
+    remove(Timer& timer);
 
-    if (timer_settime(mTid, 0, &time, NULL) != 0)
-    {
-        // Could not set the timer valuell
-        FailureHandler::fatal(FailureCode::genericRuntimeError(Resource::timer));
-    }
+    bool
+    isRunning(const Timer& timer);
+
+protected:
+    virtual void
+    run() override;
+
+private:
+    TimerService(uint8_t priority, size_t stack);
+
+    /// Number of microseconds since the creation of the service
+    int64_t
+    getMicroseconds() const;
+
+    static pthread_mutex_t instanceMutex;
+    static TimerService* instance;
+
+    pthread_mutex_t mMutex;
+    pthread_cond_t mSignal;
+    timespec mEpoch;
+    TimerWheel mWheel;
+
+    /// Tick until which the thread sleeps, 0 while it is processing
+    uint64_t mWakeupTick;
+};
+
+pthread_mutex_t TimerService::instanceMutex = PTHREAD_MUTEX_INITIALIZER;
+TimerService* TimerService::instance = nullptr;
+
+static constexpr int64_t microsecondsPerTick = time::Duration::microsecondsPerMillisecond;
+
+TimerService::TimerService(uint8_t priority, size_t stack) :
+    Thread(priority, stack, "TIMER"),
+    mMutex(),
+    mSignal(),
+    mEpoch(getTime(CLOCK_MONOTONIC)),
+    mWheel(0),
+    mWakeupTick(0)
+{
+    pthread_mutex_init(&mMutex, NULL);
+    initializeMonotonicCondition(mSignal);
 }
 
-void
-Timer::reset()
+TimerService&
+TimerService::getInstance(uint8_t priority, size_t stack)
 {
-    if (timer_settime(mTid, 0, &mInterval, NULL) != 0)
+    pthread_mutex_lock(&instanceMutex);
+    if (instance == nullptr)
     {
-        // Could not set the timer value
-        FailureHandler::fatal(FailureCode::genericRuntimeError(Resource::timer));
+        instance = new TimerService(priority, stack);
+        instance->start();
     }
+    TimerService* service = instance;
+    pthread_mutex_unlock(&instanceMutex);
+    return *service;
+}
+
+TimerService*
+TimerService::findInstance()
+{
+    pthread_mutex_lock(&instanceMutex);
+    TimerService* service = instance;
+    pthread_mutex_unlock(&instanceMutex);
+    return service;
 }
 
 void
-Timer::cancel()
+TimerService::add(Timer& timer, time::Duration duration)
 {
-    struct itimerspec time;
+    pthread_mutex_lock(&mMutex);
+    if (duration == time::Duration::infinity())
+    {
+        timer.unlink();
+    }
+    else
+    {
+        // Limited to about 290000 years to avoid an overflow below
+        int64_t microseconds = duration.microseconds();
+        if (microseconds < 0)
+        {
+            microseconds = 0;
+        }
+        else if (microseconds > (INT64_MAX / 2))
+        {
+            microseconds = INT64_MAX / 2;
+        }
 
-    memset(&time, 0, sizeof(time));
+        // Round up, the timer must not expire before the duration has passed
+        const int64_t end = getMicroseconds() + microseconds;
+        const uint64_t expiry = static_cast<uint64_t>((end + microsecondsPerTick - 1)
+                                                      / microsecondsPerTick);
+        mWheel.add(timer, expiry);
 
-    if (timer_settime(mTid, 0, &time, NULL) != 0)
-    {
-        // Could not set the timer value
-        FailureHandler::fatal(FailureCode::genericRuntimeError(Resource::timer));
+        if (expiry < mWakeupTick)
+        {
+            pthread_cond_signal(&mSignal);
+        }
     }
+    pthread_mutex_unlock(&mMutex);
+}
+
+void
+TimerService::remove(Timer& timer)
+{
+    pthread_mutex_lock(&mMutex);
+    timer.unlink();
+    pthread_mutex_unlock(&mMutex);
 }
 
 bool
-Timer::isRunning()
+TimerService::isRunning(const Timer& timer)
 {
-    itimerspec value;
+    pthread_mutex_lock(&mMutex);
+    const bool running = timer.isLinked();
+    pthread_mutex_unlock(&mMutex);
+    return running;
+}
 
-    if (timer_gettime(mTid, &value) != 0)
+void
+TimerService::run()
+{
+    pthread_mutex_lock(&mMutex);
+    while (true)
     {
-        FailureHandler::fatal(FailureCode::genericRuntimeError(Resource::timer));
+        mWheel.advance(static_cast<uint64_t>(getMicroseconds() / microsecondsPerTick));
+
+        TimerWheelNode* node = mWheel.popExpired();
+        if (node != nullptr)
+        {
+            // The callback may start or cancel timers
+            Timer* timer = static_cast<Timer*>(node);
+            pthread_mutex_unlock(&mMutex);
+            timer->invoke();
+            pthread_mutex_lock(&mMutex);
+        }
+        else
+        {
+            mWakeupTick = mWheel.getNextEvent();
+            if (mWakeupTick == TimerWheel::noEvent)
+            {
+                pthread_cond_wait(&mSignal, &mMutex);
+            }
+            else
+            {
+                timespec wakeup = mEpoch;
+                const int64_t microseconds =
+                        static_cast<int64_t>(mWakeupTick) * microsecondsPerTick;
+                const timespec increment = {
+                        static_cast<time_t>(microseconds / 1000000),
+                        static_cast<long>((microseconds % 1000000) * 1000)};
+                addTime(wakeup, increment);
+                pthread_cond_timedwait(&mSignal, &mMutex, &wakeup);
+            }
+            mWakeupTick = 0;
+        }
     }
+}
 
-    bool running = (value.it_value.tv_sec != 0) || (value.it_value.tv_nsec != 0);
-    return running;
+int64_t
+TimerService::getMicroseconds() const
+{
+    const timespec now = getTime(CLOCK_MONOTONIC);
+    return (static_cast<int64_t>(now.tv_sec) - mEpoch.tv_sec) * 1000000
+           + (static_cast<int64_t>(now.tv_nsec) - mEpoch.tv_nsec) / 1000;
 }
 
-void Timer::startTimerDaemonThread(uint8_t /*priority*/, size_t /*stack*/)
+}  // namespace internal
+}  // namespace rtos
+}  // namespace outpost
+
+using outpost::rtos::internal::TimerService;
+
+// Highest priority for a daemon thread started implicitly by the first timer
+static constexpr uint8_t defaultDaemonPriority = 255;
+
+Timer::~Timer()
 {
-    // do nothing here for POSIX, only used for RTEMS
+    cancel();
 }
 
 void
-Timer::createTimer(const char* /*name*/)
+Timer::start(time::Duration duration)
 {
-    sigevent event;
-    memset(&event, 0, sizeof(event));
+    mDuration = duration;
+    TimerService::getInstance(defaultDaemonPriority, 0).add(*this, duration);
+}
 
-    // Set the sigevent structure to cause the signal to be
-    // delivered by creating a new thread.
-    event.sigev_notify = SIGEV_THREAD;
-    event.sigev_notify_function = Timer::invokeTimer;
-    event.sigev_notify_attributes = NULL;
-    event.sigev_value.sival_ptr = this;
+void
+Timer::reset()
+{
+    if (mDuration != time::Duration::infinity())
+    {
+        TimerService::getInstance(defaultDaemonPriority, 0).add(*this, mDuration);
+    }
+}
 
-    if (timer_create(CLOCK_MONOTONIC, &event, &mTid) != 0)
+void
+Timer::cancel()
+{
+    // Without the service no timer can be running
+    TimerService* service = TimerService::findInstance();
+    if (service != nullptr)
     {
-        // Could not allocate a new timer
-        FailureHandler::fatal(FailureCode::resourceAllocationFailed(Resource::timer));
+        service->remove(*this);
     }
+}
 
-    // Disable timer for now
-    this->cancel();
+bool
+Timer::isRunning()
+{
+    TimerService* service = TimerService::findInstance();
+    return (service != nullptr) && service->isRunning(*this);
 }
 
 void
-Timer::invokeTimer(union sigval parameter)
+Timer::startTimerDaemonThread(uint8_t priority, size_t stack)
 {
-    Timer* timer = reinterpret_cast<Timer*>(parameter.sival_ptr);
-    (timer->mObject->*(timer->mFunction))(timer);
+    TimerService::getInstance(priority, stack).setPriority(priority);
 }
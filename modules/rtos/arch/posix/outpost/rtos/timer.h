@@ -14,23 +14,41 @@
 #ifndef OUTPOST_RTOS_POSIX_TIMER_H
 #define OUTPOST_RTOS_POSIX_TIMER_H
 
+#include "internal/timer_wheel.h"
+
 #include <outpost/base/callable.h>
 #include <outpost/time/duration.h>
 
-#include <signal.h>
-#include <time.h>
+#include <stddef.h>
+#include <stdint.h>
 
 namespace outpost
 {
 namespace rtos
 {
+namespace internal
+{
+class TimerService;
+}
+
 /**
  * Software timer.
  *
+ * All timers share a hierarchical timing wheel with a resolution of one
+ * millisecond, which is driven by a single timer daemon thread. Starting,
+ * resetting and canceling a timer is O(1) independent of the number of
+ * timers, no kernel timer is allocated per instance.
+ *
+ * The timer callback functions are called in the context of the timer
+ * daemon thread, one after the other. They should be short and must not
+ * block, otherwise the expiry of the other timers is delayed. The daemon
+ * thread is started with the first timer, or explicitly with
+ * startTimerDaemonThread() to choose its priority.
+ *
  * \author    Fabian Greif
  * \ingroup    rtos
  */
-class Timer
+class Timer : private internal::TimerWheelNode
 {
 public:
     /**
@@ -121,28 +139,35 @@ public:
     /**
      * Start the timer daemon.
      *
-     * Not used for the POSIX implementation.
+     * Optional for the POSIX implementation, the daemon is otherwise
+     * started with the highest priority when the first timer is started.
+     * Changes the priority if the daemon is already running.
+     *
+     * \param priority
+     *         Thread priority, see outpost::rtos::Thread. To ensure that
+     *         the handler-function is called at the exact time it is
+     *         a good idea to give the timer daemon thread a high priority.
+     * \param stack
+     *         Stack size in bytes.
      */
     static void
     startTimerDaemonThread(uint8_t priority, size_t stack = 0);
 
 private:
-    void
-    createTimer(const char* name);
+    friend class internal::TimerService;
 
-    /**
-     * Helper function to map the void-pointer to a
-     * member function pointer and call the member function.
-     */
-    static void
-    invokeTimer(union sigval parameter);
+    inline void
+    invoke()
+    {
+        (mObject->*mFunction)(this);
+    }
 
     /// Object and member function to call when the timer expires.
     Callable* const mObject;
     Function const mFunction;
 
-    timer_t mTid;
-    itimerspec mInterval;
+    /// Duration of the last start(), infinity if the timer was never started
+    time::Duration mDuration;
 };
 
 // ----------------------------------------------------------------------------
@@ -151,9 +176,9 @@ template <typename T>
 Timer::Timer(T* object, typename TimerFunction<T>::type function, const char* name) :
     mObject(reinterpret_cast<Callable*>(object)),
     mFunction(reinterpret_cast<Function>(function)),
-    mTid()
+    mDuration(time::Duration::infinity())
 {
-    this->createTimer(name);
+    (void) name;
 }
 
 }  // namespace rtos
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_RTEMS_ATOMIC_H
+#define OUTPOST_RTOS_RTEMS_ATOMIC_H
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Lock-free integral value.
+ *
+ * Provides the atomic operations needed by the library (e.g. for
+ * reference counting) without taking a mutex. Implemented with the GCC
+ * __atomic builtins, which map to the CAS instructions of the LEON3/4
+ * processors. All operations are sequentially consistent.
+ *
+ * \tparam T
+ *      Integral type of the stored value.
+ *
+ * \ingroup    rtos
+ */
+template <typename T>
+class Atomic
+{
+public:
+    constexpr explicit Atomic(T value = T()) : mValue(value)
+    {
+    }
+
+    // disable copy constructor
+    Atomic(const Atomic& other) = delete;
+
+    // disable assignment operator
+    Atomic&
+    operator=(const Atomic& other) = delete;
+
+    inline T
+    load() const
+    {
+        return __atomic_load_n(&mValue, __ATOMIC_SEQ_CST);
+    }
+
+    inline void
+    store(T value)
+    {
+        __atomic_store_n(&mValue, value, __ATOMIC_SEQ_CST);
+    }
+
+    /**
+     * Add \p value and return the value held previously.
+     */
+    inline T
+    fetchAdd(T value)
+    {
+        return __atomic_fetch_add(&mValue, value, __ATOMIC_SEQ_CST);
+    }
+
+    /**
+     * Subtract \p value and return the value held previously.
+     */
+    inline T
+    fetchSub(T value)
+    {
+        return __atomic_fetch_sub(&mValue, value, __ATOMIC_SEQ_CST);
+    }
+
+    /**
+     * Replace the value with \p desired if it currently equals \p expected.
+     *
+     * \param expected
+     *      Expected value. Is updated with the current value if the
+     *      exchange fails.
+     * \param desired
+     *      New value.
+     *
+     * \retval true     Value was exchanged.
+     * \retval false    Value differed from \p expected.
+     */
+    inline bool
+    compareAndSwap(T& expected, T desired)
+    {
+        return __atomic_compare_exchange_n(
+                &mValue, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    }
+
+private:
+    T mValue;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
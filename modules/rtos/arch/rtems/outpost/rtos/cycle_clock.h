@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_RTEMS_CYCLE_CLOCK_H
+#define OUTPOST_RTOS_RTEMS_CYCLE_CLOCK_H
+
+#include <outpost/time/duration.h>
+
+#include <rtems/counter.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Cheap timestamps for fine-grained time measurements.
+ *
+ * In contrast to SystemClock the functions are not virtual and now()
+ * reads the CPU counter of the BSP (e.g. the LEON up-counter or the
+ * timer unit) without a system call.
+ *
+ * The counter is only 32 bit wide on most targets and wraps within
+ * minutes, measure short intervals only. Timestamps are only meaningful
+ * relative to each other:
+ *
+ * \code
+ * CycleClock::Ticks start = CycleClock::now();
+ * ...
+ * time::Duration elapsed = CycleClock::toDuration(CycleClock::now() - start);
+ * \endcode
+ *
+ * \ingroup    rtos
+ */
+class CycleClock
+{
+public:
+    typedef rtems_counter_ticks Ticks;
+
+    static inline Ticks
+    now()
+    {
+        return rtems_counter_read();
+    }
+
+    /**
+     * Number of ticks per second.
+     */
+    static inline uint64_t
+    getFrequency()
+    {
+        return rtems_counter_nanoseconds_to_ticks(1000000000U);
+    }
+
+    static inline time::Duration
+    toDuration(Ticks ticks)
+    {
+        return time::Microseconds(rtems_counter_ticks_to_nanoseconds(ticks)
+                                  / time::Duration::nanosecondsPerMicrosecond);
+    }
+
+private:
+    // Only static functions
+    CycleClock() = delete;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
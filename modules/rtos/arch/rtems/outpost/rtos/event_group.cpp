@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "event_group.h"
+
+#include "rtems/interval.h"
+
+#include <outpost/rtos/mutex_guard.h>
+
+using outpost::rtos::EventGroup;
+
+constexpr EventGroup::Bits EventGroup::usableBits;
+
+static inline bool
+isSatisfied(EventGroup::Bits current, EventGroup::Bits bits, bool all)
+{
+    const EventGroup::Bits matched = current & bits;
+    return all ? (matched == bits) : (matched != 0);
+}
+
+EventGroup::EventGroup() : mMutex(), mBits(0), mWaiters(nullptr)
+{
+    rtems_interrupt_lock_initialize(&mLock, "EventGroup");
+}
+
+EventGroup::~EventGroup()
+{
+    rtems_interrupt_lock_destroy(&mLock);
+}
+
+void
+EventGroup::set(Bits bits)
+{
+    MutexGuard lock(mMutex);
+
+    rtems_interrupt_lock_context context;
+    rtems_interrupt_lock_acquire(&mLock, &context);
+    mBits |= bits;
+    rtems_interrupt_lock_release(&mLock, &context);
+
+    // The list is only changed with the mutex held, the events are sent
+    // with interrupts enabled
+    for (Waiter* waiter = mWaiters; waiter != nullptr; waiter = waiter->mNext)
+    {
+        rtems_event_transient_send(waiter->mTask);
+    }
+}
+
+void
+EventGroup::setFromInterrupt(Bits bits)
+{
+    // The list is only changed with the interrupt lock held as well
+    rtems_interrupt_lock_context context;
+    rtems_interrupt_lock_acquire(&mLock, &context);
+    mBits |= bits;
+    for (Waiter* waiter = mWaiters; waiter != nullptr; waiter = waiter->mNext)
+    {
+        rtems_event_transient_send(waiter->mTask);
+    }
+    rtems_interrupt_lock_release(&mLock, &context);
+}
+
+void
+EventGroup::clear(Bits bits)
+{
+    rtems_interrupt_lock_context context;
+    rtems_interrupt_lock_acquire(&mLock, &context);
+    mBits &= ~bits;
+    rtems_interrupt_lock_release(&mLock, &context);
+}
+
+EventGroup::Bits
+EventGroup::get() const
+{
+    rtems_interrupt_lock_context context;
+    rtems_interrupt_lock_acquire(&mLock, &context);
+    const Bits bits = mBits;
+    rtems_interrupt_lock_release(&mLock, &context);
+    return bits;
+}
+
+EventGroup::Bits
+EventGroup::waitAny(Bits bits, outpost::time::Duration timeout, bool clearOnExit)
+{
+    return wait(bits, false, timeout, clearOnExit);
+}
+
+EventGroup::Bits
+EventGroup::waitAll(Bits bits, outpost::time::Duration timeout, bool clearOnExit)
+{
+    return wait(bits, true, timeout, clearOnExit);
+}
+
+EventGroup::Bits
+EventGroup::wait(Bits bits, bool all, outpost::time::Duration timeout, bool clearOnExit)
+{
+    const bool waitForever = (timeout == outpost::time::Duration::infinity());
+    const rtems_interval start = rtems_clock_get_ticks_since_boot();
+    const rtems_interval ticks = rtems::getInterval(timeout);
+
+    Waiter waiter = {rtems_task_self(), nullptr};
+    bool registered = false;
+    while (true)
+    {
+        mMutex.acquire();
+        if (!registered)
+        {
+            // Discard a stale event of an earlier wait, the setters send a
+            // new one once the task is part of the list
+            rtems_event_transient_clear();
+        }
+        const rtems_interval elapsed = rtems_clock_get_ticks_since_boot() - start;
+
+        rtems_interrupt_lock_context context;
+        rtems_interrupt_lock_acquire(&mLock, &context);
+        if (isSatisfied(mBits, bits, all))
+        {
+            const Bits matched = mBits & bits;
+            if (clearOnExit)
+            {
+                mBits &= ~matched;
+            }
+            if (registered)
+            {
+                removeWaiter(waiter);
+            }
+            rtems_interrupt_lock_release(&mLock, &context);
+            mMutex.release();
+            return matched;
+        }
+
+        if ((timeout == outpost::time::Duration::zero()) || (!waitForever && (elapsed >= ticks)))
+        {
+            if (registered)
+            {
+                removeWaiter(waiter);
+            }
+            rtems_interrupt_lock_release(&mLock, &context);
+            mMutex.release();
+            return 0;
+        }
+
+        if (!registered)
+        {
+            waiter.mNext = mWaiters;
+            mWaiters = &waiter;
+            registered = true;
+        }
+        rtems_interrupt_lock_release(&mLock, &context);
+        mMutex.release();
+
+        rtems_event_transient_receive(RTEMS_WAIT,
+                                      waitForever ? RTEMS_NO_TIMEOUT : (ticks - elapsed));
+    }
+}
+
+void
+EventGroup::removeWaiter(Waiter& waiter)
+{
+    Waiter** node = &mWaiters;
+    while (*node != &waiter)
+    {
+        node = &(*node)->mNext;
+    }
+    *node = waiter.mNext;
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_RTEMS_EVENT_GROUP_H
+#define OUTPOST_RTOS_RTEMS_EVENT_GROUP_H
+
+#include "mutex.h"
+
+#include <rtems.h>
+
+#include <outpost/time/duration.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Set of event flags threads can wait for.
+ *
+ * Allows a thread to block until one of several sources has work, e.g.
+ * a queue has received an element or a stop has been requested, instead
+ * of polling each source with a short timeout. Any number of threads may
+ * set bits and wait.
+ *
+ * Only the lower 24 bits are available on all operating systems
+ * (FreeRTOS restriction), see \c usableBits.
+ *
+ * RTEMS events are bound to a task, therefore the bits are kept in the
+ * object and the waiting tasks are woken up with the transient event.
+ * The transient event must not be used otherwise while waiting. The
+ * waiting tasks are added and removed with the mutex and an interrupt
+ * lock held: set() holds only the mutex while waking them, so that no
+ * directive is called with interrupts disabled from a task, and
+ * setFromInterrupt() holds only the interrupt lock.
+ *
+ * Requires RTEMS 4.11 or later for the interrupt lock.
+ *
+ * \ingroup    rtos
+ */
+class EventGroup
+{
+public:
+    typedef uint32_t Bits;
+
+    /// Bits which can be used on all operating systems
+    static constexpr Bits usableBits = 0x00FFFFFF;
+
+    EventGroup();
+
+    // disable copy constructor
+    EventGroup(const EventGroup& other) = delete;
+
+    // disable assignment operator
+    EventGroup&
+    operator=(const EventGroup& other) = delete;
+
+    ~EventGroup();
+
+    /**
+     * Set bits and wake up the threads waiting for them.
+     */
+    void
+    set(Bits bits);
+
+    /**
+     * Set bits from an interrupt handler.
+     *
+     * Same as set() but may only be called from interrupt context.
+     */
+    void
+    setFromInterrupt(Bits bits);
+
+    /**
+     * Clear bits.
+     */
+    void
+    clear(Bits bits);
+
+    /**
+     * Current value of all bits.
+     */
+    Bits
+    get() const;
+
+    /**
+     * Wait until at least one of the given bits is set.
+     *
+     * \param bits
+     *         Bits to wait for.
+     * \param timeout
+     *         Maximum time to wait.
+     * \param clearOnExit
+     *         Clear the bits for which the wait has returned. Whether
+     *         other threads waiting for the same bits see them as well
+     *         depends on the operating system.
+     *
+     * \return  Subset of \p bits which was set, zero on timeout.
+     */
+    Bits
+    waitAny(Bits bits,
+            outpost::time::Duration timeout = outpost::time::Duration::infinity(),
+            bool clearOnExit = true);
+
+    /**
+     * Wait until all given bits are set.
+     *
+     * \return  \p bits if all were set, zero on timeout.
+     * \see     waitAny()
+     */
+    Bits
+    waitAll(Bits bits,
+            outpost::time::Duration timeout = outpost::time::Duration::infinity(),
+            bool clearOnExit = true);
+
+private:
+    Bits
+    wait(Bits bits, bool all, outpost::time::Duration timeout, bool clearOnExit);
+
+    /// Waiting task, allocated on its stack
+    struct Waiter
+    {
+        rtems_id mTask;
+        Waiter* mNext;
+    };
+
+    void
+    removeWaiter(Waiter& waiter);
+
+    /// Serializes the tasks, keeps the waiters registered while set()
+    /// wakes them
+    mutable Mutex mMutex;
+
+    /// Protects the bits and the list of waiters against interrupts
+    mutable rtems_interrupt_lock mLock;
+    Bits mBits;
+
+    /// Singly linked list of the waiting tasks
+    Waiter* mWaiters;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
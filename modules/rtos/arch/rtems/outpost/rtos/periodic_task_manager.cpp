@@ -15,7 +15,21 @@
 
 using namespace outpost::rtos;
 
-PeriodicTaskManager::PeriodicTaskManager() : mId()
+static outpost::time::Duration
+getUptime()
+{
+    timespec time;
+    rtems_clock_get_uptime(&time);
+    return outpost::time::Seconds(time.tv_sec) + outpost::time::Microseconds(time.tv_nsec / 1000);
+}
+
+PeriodicTaskManager::PeriodicTaskManager(OverrunPolicy::Type policy) :
+    mId(),
+    mPolicy(policy),
+    mTimerRunning(false),
+    mPeriodEnd(time::Duration::zero()),
+    mPeriodStart(time::Duration::zero()),
+    mStatistics()
 {
     rtems_name name = rtems_build_name('P', 'E', 'R', 'D');
     rtems_status_code result = rtems_rate_monotonic_create(name, &mId);
@@ -35,3 +49,60 @@ PeriodicTaskManager::~PeriodicTaskManager()
         FailureHandler::fatal(FailureCode::genericRuntimeError(Resource::periodicTask));
     }
 }
+
+PeriodicTaskManager::Status::Type
+PeriodicTaskManager::nextPeriod(time::Duration period)
+{
+    const rtems_interval interval = rtems::getInterval(period);
+    const time::Duration periodLength =
+            time::Microseconds(interval * rtems_configuration_get_microseconds_per_tick());
+
+    const time::Duration currentTime = getUptime();
+    const bool firstPeriod = !mTimerRunning;
+    if (!firstPeriod)
+    {
+        mStatistics.recordEnd(currentTime - mPeriodStart, currentTime - mPeriodEnd);
+    }
+
+    // RTEMS_NOT_OWNER_OF_RESOURCE (called from wrong thread)
+    // not especially handled has no corresponding status flag exists.
+    Status::Type currentStatus = Status::running;
+    rtems_status_code result = rtems_rate_monotonic_period(mId, interval);
+    if (firstPeriod)
+    {
+        // period is started now, no need to wait
+        mPeriodEnd = currentTime;
+        mTimerRunning = true;
+    }
+    else if (result == RTEMS_TIMEOUT)
+    {
+        currentStatus = Status::timeout;
+#if defined(__RTEMS_MAJOR__) && (__RTEMS_MAJOR__ >= 5)
+        if (mPolicy == OverrunPolicy::skip)
+        {
+            // Every further call releases one of the postponed jobs
+            // without blocking
+            rtems_rate_monotonic_period_status periodStatus;
+            while ((rtems_rate_monotonic_get_status(mId, &periodStatus) == RTEMS_SUCCESSFUL)
+                   && (periodStatus.postponed_jobs_count > 0))
+            {
+                rtems_rate_monotonic_period(mId, interval);
+                mStatistics.recordSkippedPeriods(1);
+                mPeriodEnd += periodLength;
+            }
+        }
+#else
+        // The period is restarted at the current time
+        mPeriodEnd = currentTime;
+#endif
+    }
+
+    mPeriodStart = getUptime();
+    if (!firstPeriod)
+    {
+        mStatistics.recordStart(mPeriodStart - mPeriodEnd);
+    }
+    mPeriodEnd += periodLength;
+
+    return currentStatus;
+}
@@ -19,6 +19,7 @@
 #include "rtems/interval.h"
 
 #include <outpost/rtos/failure_handler.h>
+#include <outpost/rtos/periodic_task_statistics.h>
 
 namespace outpost
 {
@@ -48,13 +49,36 @@ public:
         };
     };
 
+    /**
+     * Handling of periods which have passed when nextPeriod() is called
+     * too late.
+     *
+     * Both policies need the postponed jobs of the rate monotonic manager
+     * (RTEMS 5 or later). Older versions restart the period when it is
+     * called too late, which corresponds to OverrunPolicy::skip with a
+     * phase shift.
+     */
+    struct OverrunPolicy
+    {
+        enum Type
+        {
+            /// Every missed period is started immediately, until the task
+            /// is back on schedule
+            catchUp,
+
+            /// Periods which have already ended are dropped, the period
+            /// in which nextPeriod() is called is started immediately
+            skip
+        };
+    };
+
     /**
      * Create a new periodic task manager.
      *
      * The periodic task manager has to be created in the thread which will
      * be used later to call the nextPeriod function.
      */
-    PeriodicTaskManager();
+    explicit PeriodicTaskManager(OverrunPolicy::Type policy = OverrunPolicy::catchUp);
 
     ~PeriodicTaskManager();
 
@@ -89,21 +113,8 @@ public:
      *      Last period was missed, this may require some different
      *      handling from the user.
      */
-    inline Status::Type
-    nextPeriod(time::Duration period)
-    {
-        rtems_status_code result = rtems_rate_monotonic_period(mId, rtems::getInterval(period));
-        if (result == RTEMS_TIMEOUT)
-        {
-            return Status::timeout;
-        }
-        else
-        {
-            // RTEMS_NOT_OWNER_OF_RESOURCE (called from wrong thread)
-            // not especially handled has no corresponding status flag exists.
-            return Status::running;
-        }
-    }
+    Status::Type
+    nextPeriod(time::Duration period);
 
     /**
      * Check the status of the current period.
@@ -143,10 +154,41 @@ public:
     cancel()
     {
         rtems_rate_monotonic_cancel(mId);
+        mTimerRunning = false;
+    }
+
+    /**
+     * Get the timing statistics since the creation or the last call of
+     * resetStatistics().
+     *
+     * \warning
+     *      The statistics are not locked, the values are only consistent
+     *      if read from the thread which calls nextPeriod().
+     */
+    inline PeriodicTaskStatistics
+    getStatistics() const
+    {
+        return mStatistics;
+    }
+
+    inline void
+    resetStatistics()
+    {
+        mStatistics.reset();
     }
 
 private:
     rtems_id mId;
+    const OverrunPolicy::Type mPolicy;
+    bool mTimerRunning;
+
+    /// Uptime at the end of the current period
+    time::Duration mPeriodEnd;
+
+    /// Uptime at which nextPeriod() returned
+    time::Duration mPeriodStart;
+
+    PeriodicTaskStatistics mStatistics;
 };
 
 }  // namespace rtos
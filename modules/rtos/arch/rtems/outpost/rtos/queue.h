@@ -95,10 +95,69 @@ public:
     bool
     receive(T& data, outpost::time::Duration timeout);
 
+protected:
+    /**
+     * Create a Queue which uses the given storage, see StaticQueue.
+     *
+     * Requires rtems_message_queue_construct() (RTEMS 6), otherwise the
+     * message buffers are allocated from the RTEMS workspace.
+     *
+     * \param numberOfItems
+     *      The maximum number of items that the queue can contain.
+     * \param storage
+     *      Message buffers for \p numberOfItems items, must outlive the
+     *      queue.
+     * \param storageSize
+     *      Size of \p storage in bytes.
+     */
+    Queue(size_t numberOfItems, void* storage, size_t storageSize);
+
 private:
     rtems_id mId;
 };
 
+namespace internal
+{
+/**
+ * Storage of a StaticQueue.
+ *
+ * Base class of StaticQueue so that it is constructed before the queue.
+ */
+template <typename T, size_t N>
+struct StaticQueueStorage
+{
+#ifdef RTEMS_MESSAGE_QUEUE_BUFFER
+    RTEMS_MESSAGE_QUEUE_BUFFER(sizeof(T)) mItems[N];
+#else
+    uint8_t mItems[1];
+#endif
+};
+}  // namespace internal
+
+/**
+ * Queue with the buffer inside the object.
+ *
+ * Same as Queue but the message buffers are part of the object and the
+ * queue is created with rtems_message_queue_construct().
+ *
+ * \tparam T
+ *      Type of the items, limited to POD types.
+ * \tparam N
+ *      The maximum number of items that the queue can contain.
+ *
+ * \ingroup rtos
+ */
+template <typename T, size_t N>
+class StaticQueue : private internal::StaticQueueStorage<T, N>, public Queue<T>
+{
+    static_assert(N > 0, "Queue must hold at least one item");
+
+public:
+    StaticQueue() : Queue<T>(N, this->mItems, sizeof(this->mItems))
+    {
+    }
+};
+
 }  // namespace rtos
 }  // namespace outpost
 
@@ -40,6 +40,42 @@ outpost::rtos::Queue<T>::Queue(size_t numberOfItems) : mId()
     }
 }
 
+template <typename T>
+outpost::rtos::Queue<T>::Queue(size_t numberOfItems, void* storage, size_t storageSize) : mId()
+{
+// RTEMS is C, thus, old-style-casts need to be allowed here.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+
+#ifdef RTEMS_MESSAGE_QUEUE_BUFFER
+    rtems_message_queue_config config;
+    config.name = rtems_build_name('R', 'T', 'Q', 'S');
+    config.maximum_pending_messages = numberOfItems;
+    config.maximum_message_size = sizeof(T);
+    config.storage_area = storage;
+    config.storage_size = storageSize;
+    config.storage_free = nullptr;
+    config.attributes = RTEMS_FIFO | RTEMS_LOCAL;
+
+    rtems_status_code result = rtems_message_queue_construct(&config, &mId);
+#else
+    (void) storage;
+    (void) storageSize;
+    rtems_status_code result = rtems_message_queue_create(rtems_build_name('R', 'T', 'Q', 'S'),
+                                                          numberOfItems,
+                                                          sizeof(T),
+                                                          RTEMS_FIFO | RTEMS_LOCAL,
+                                                          &mId);
+#endif
+
+#pragma GCC diagnostic pop
+
+    if (result != RTEMS_SUCCESSFUL)
+    {
+        FailureHandler::fatal(FailureCode::resourceAllocationFailed(Resource::messageQueue));
+    }
+}
+
 template <typename T>
 outpost::rtos::Queue<T>::~Queue()
 {
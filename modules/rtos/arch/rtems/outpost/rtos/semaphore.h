@@ -198,6 +198,19 @@ public:
         rtems_semaphore_release(mId);
     }
 
+    /**
+     * Increment the count from an interrupt handler.
+     *
+     * Same as release() but may only be called from interrupt context.
+     * Simple binary semaphores may be released from interrupt context,
+     * the function is therefore identical to release().
+     */
+    inline void
+    releaseFromInterrupt()
+    {
+        rtems_semaphore_release(mId);
+    }
+
 private:
     rtems_id mId;
 };
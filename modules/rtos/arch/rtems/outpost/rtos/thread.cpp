@@ -15,6 +15,14 @@
 #include "thread.h"
 
 #include <outpost/rtos/failure_handler.h>
+#include <outpost/rtos/thread_profiler.h>
+
+#if defined(__RTEMS_MAJOR__) && (__RTEMS_MAJOR__ >= 5)
+#include <rtems/score/threadimpl.h>
+#endif
+#if defined(__RTEMS_MAJOR__) && (__RTEMS_MAJOR__ >= 6)
+#include <rtems/stackchk.h>
+#endif
 
 #include <stdio.h>
 
@@ -54,7 +62,9 @@ fromRtemsPriority(uint8_t rtemsPriority)
 Thread::Thread(uint8_t priority,
                size_t stack,
                const char* name,
-               FloatingPointSupport floatingPointSupport)
+               FloatingPointSupport floatingPointSupport) :
+    mTid(),
+    mName(name)
 {
     rtems_name taskName = 0;
     if (name == 0)
@@ -97,6 +107,7 @@ Thread::Thread(uint8_t priority,
 
 Thread::~Thread()
 {
+    ThreadProfiler::unregisterThread(*this);
     rtems_task_delete(mTid);
 }
 
@@ -119,11 +130,76 @@ Thread::getCurrentThreadIdentifier()
     return current;
 }
 
+// ----------------------------------------------------------------------------
+namespace
+{
+struct ProfileQuery
+{
+    rtems_id id;
+    outpost::rtos::ThreadProfile* profile;
+};
+
+#if defined(__RTEMS_MAJOR__) && (__RTEMS_MAJOR__ >= 5)
+bool
+queryCpuTime(rtems_tcb* thread, void* argument)
+{
+    ProfileQuery* query = reinterpret_cast<ProfileQuery*>(argument);
+    if (thread->Object.id != query->id)
+    {
+        return false;
+    }
+
+    Timestamp_Control used;
+    _Thread_Get_CPU_time_used(thread, &used);
+    query->profile->cpuTime = outpost::time::Microseconds(_Timestamp_Get_as_nanoseconds(&used)
+                                                          / 1000);
+    return true;
+}
+#endif
+
+#if defined(__RTEMS_MAJOR__) && (__RTEMS_MAJOR__ >= 6)
+void
+queryStackUsage(const rtems_stack_checker_info* info, void* argument)
+{
+    ProfileQuery* query = reinterpret_cast<ProfileQuery*>(argument);
+    if (info->id == query->id)
+    {
+        query->profile->stackSize = info->size;
+        query->profile->stackUsage = info->used;
+    }
+}
+#endif
+}  // namespace
+
+void
+Thread::getProfile(ThreadProfile& profile) const
+{
+    profile = ThreadProfile();
+    profile.setName(mName);
+    profile.identifier = mTid;
+    profile.priority = getPriority();
+
+    ProfileQuery query = {mTid, &profile};
+    (void) query;
+#if defined(__RTEMS_MAJOR__) && (__RTEMS_MAJOR__ >= 5)
+    rtems_task_iterate(queryCpuTime, &query);
+#endif
+#if defined(__RTEMS_MAJOR__) && (__RTEMS_MAJOR__ >= 6)
+    // Needs the stack checker (CONFIGURE_STACK_CHECKER_ENABLED), which
+    // fills the stacks with a pattern
+    rtems_stack_checker_iterate(queryStackUsage, &query);
+#endif
+}
+
 // ----------------------------------------------------------------------------
 void
 Thread::start()
 {
-    rtems_task_start(mTid, wrapper, reinterpret_cast<rtems_task_argument>(this));
+    if (rtems_task_start(mTid, wrapper, reinterpret_cast<rtems_task_argument>(this))
+        == RTEMS_SUCCESSFUL)
+    {
+        ThreadProfiler::registerThread(*this);
+    }
 }
 
 // ----------------------------------------------------------------------------
@@ -27,6 +27,8 @@ namespace outpost
 {
 namespace rtos
 {
+struct ThreadProfile;
+
 /**
  * Wrapper class for the Thread function of the Operating System.
  *
@@ -132,6 +134,14 @@ public:
     static Identifier
     getCurrentThreadIdentifier();
 
+    /**
+     * Query the processor time and stack usage of the thread.
+     *
+     * \see ThreadProfiler
+     */
+    void
+    getProfile(ThreadProfile& profile) const;
+
     /**
      * Set a new priority for the thread.
      *
@@ -212,6 +222,7 @@ private:
     wrapper(rtems_task_argument object);
 
     rtems_id mTid;
+    const char* const mName;
 };
 
 }  // namespace rtos
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_H
+#define OUTPOST_RTOS_H
+
+/**
+ * \defgroup rtos   RTOS Wrappers
+ * \brief    Real Time Operating System
+ *
+ * This library provide an operating system abstraction layer.
+ *
+ * The simulation implementation runs all blocking operations in a
+ * virtual time, see outpost::rtos::internal::Kernel.
+ */
+
+#include "rtos/clock.h"
+#include "rtos/cycle_clock.h"
+#include "rtos/event_group.h"
+#include "rtos/memory.h"
+#include "rtos/mutex.h"
+#include "rtos/periodic_task_manager.h"
+#include "rtos/queue.h"
+#include "rtos/semaphore.h"
+#include "rtos/thread.h"
+#include "rtos/timer.h"
+
+#include <outpost/base/callable.h>
+#include <outpost/rtos/failure_handler.h>
+#include <outpost/rtos/mutex_guard.h>
+
+#endif
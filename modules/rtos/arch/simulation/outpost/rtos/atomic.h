@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_SIMULATION_ATOMIC_H
+#define OUTPOST_RTOS_SIMULATION_ATOMIC_H
+
+#include <atomic>
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Lock-free integral value.
+ *
+ * Provides the atomic operations needed by the library (e.g. for
+ * reference counting) without taking a mutex. The simulation
+ * implementation is a thin wrapper around std::atomic. All operations
+ * are sequentially consistent.
+ *
+ * \tparam T
+ *      Integral type of the stored value.
+ *
+ * \ingroup    rtos
+ */
+template <typename T>
+class Atomic
+{
+public:
+    constexpr explicit Atomic(T value = T()) : mValue(value)
+    {
+    }
+
+    // disable copy constructor
+    Atomic(const Atomic& other) = delete;
+
+    // disable assignment operator
+    Atomic&
+    operator=(const Atomic& other) = delete;
+
+    inline T
+    load() const
+    {
+        return mValue.load();
+    }
+
+    inline void
+    store(T value)
+    {
+        mValue.store(value);
+    }
+
+    /**
+     * Add \p value and return the value held previously.
+     */
+    inline T
+    fetchAdd(T value)
+    {
+        return mValue.fetch_add(value);
+    }
+
+    /**
+     * Subtract \p value and return the value held previously.
+     */
+    inline T
+    fetchSub(T value)
+    {
+        return mValue.fetch_sub(value);
+    }
+
+    /**
+     * Replace the value with \p desired if it currently equals \p expected.
+     *
+     * \param expected
+     *      Expected value. Is updated with the current value if the
+     *      exchange fails.
+     * \param desired
+     *      New value.
+     *
+     * \retval true     Value was exchanged.
+     * \retval false    Value differed from \p expected.
+     */
+    inline bool
+    compareAndSwap(T& expected, T desired)
+    {
+        return mValue.compare_exchange_strong(expected, desired);
+    }
+
+private:
+    std::atomic<T> mValue;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
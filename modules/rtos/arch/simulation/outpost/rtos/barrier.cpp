@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "barrier.h"
+
+#include "internal/kernel.h"
+
+using outpost::rtos::Barrier;
+using outpost::rtos::internal::Kernel;
+
+Barrier::Barrier(uint32_t numberOfThreads) :
+    mNumberOfThreads(numberOfThreads), mWaiting(0), mGeneration(0)
+{
+}
+
+Barrier::~Barrier()
+{
+}
+
+void
+Barrier::wait()
+{
+    Kernel::Lock lock;
+    mWaiting++;
+    if (mWaiting >= mNumberOfThreads)
+    {
+        mWaiting = 0;
+        mGeneration++;
+        Kernel::notify(lock);
+        return;
+    }
+
+    const uint32_t generation = mGeneration;
+    Kernel::wait(lock, Kernel::infinity, [&] { return mGeneration != generation; });
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_SIMULATION_BARRIER_H
+#define OUTPOST_RTOS_SIMULATION_BARRIER_H
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Barrier class.
+ *
+ * Barrier are used to ensure that a set of threads are at a defined
+ * position before continuing.
+ *
+ * \ingroup    rtos
+ */
+class Barrier
+{
+public:
+    /**
+     * Create a new Barrier.
+     *
+     * \param numberOfThreads
+     *      Number of threads that must wait on the barrier for them to
+     *      continue.
+     */
+    explicit Barrier(uint32_t numberOfThreads);
+
+    // disable copy constructor
+    Barrier(const Barrier& other) = delete;
+
+    // disable assignment operator
+    Barrier&
+    operator=(const Barrier& other) = delete;
+
+    ~Barrier();
+
+    /**
+     * Waits till the set amount of threads are waiting.
+     */
+    void
+    wait();
+
+private:
+    const uint32_t mNumberOfThreads;
+    uint32_t mWaiting;
+
+    /// Incremented every time the barrier opens
+    uint32_t mGeneration;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
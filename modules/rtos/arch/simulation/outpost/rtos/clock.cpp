@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "clock.h"
+
+#include "internal/kernel.h"
+
+outpost::time::SpacecraftElapsedTime
+outpost::rtos::SystemClock::now() const
+{
+    return outpost::time::SpacecraftElapsedTime::afterEpoch(
+            outpost::time::Microseconds(internal::Kernel::now()));
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_SIMULATION_CYCLE_CLOCK_H
+#define OUTPOST_RTOS_SIMULATION_CYCLE_CLOCK_H
+
+#include <outpost/rtos/cycle_clock_conversion.h>
+#include <outpost/time/duration.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Cheap timestamps for fine-grained time measurements.
+ *
+ * The ticks are the microseconds of the virtual time. Code between two
+ * blocking calls therefore takes no time at all in the simulation.
+ *
+ * \ingroup    rtos
+ */
+class CycleClock
+{
+public:
+    typedef uint64_t Ticks;
+
+    static Ticks
+    now();
+
+    /**
+     * Number of ticks per second.
+     */
+    static inline uint64_t
+    getFrequency()
+    {
+        return 1000000;
+    }
+
+    static inline time::Duration
+    toDuration(Ticks ticks)
+    {
+        return convertTicksToDuration(ticks, getFrequency());
+    }
+
+private:
+    // Only static functions
+    CycleClock() = delete;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "event_group.h"
+
+#include "internal/kernel.h"
+
+using outpost::rtos::EventGroup;
+using outpost::rtos::internal::Kernel;
+
+constexpr EventGroup::Bits EventGroup::usableBits;
+
+EventGroup::EventGroup() : mBits(0)
+{
+}
+
+EventGroup::~EventGroup()
+{
+}
+
+void
+EventGroup::set(Bits bits)
+{
+    Kernel::Lock lock;
+    mBits |= (bits & usableBits);
+    Kernel::notify(lock);
+}
+
+void
+EventGroup::setFromInterrupt(Bits bits)
+{
+    set(bits);
+}
+
+void
+EventGroup::clear(Bits bits)
+{
+    Kernel::Lock lock;
+    mBits &= ~bits;
+}
+
+EventGroup::Bits
+EventGroup::get() const
+{
+    Kernel::Lock lock;
+    return mBits;
+}
+
+EventGroup::Bits
+EventGroup::waitAny(Bits bits, outpost::time::Duration timeout, bool clearOnExit)
+{
+    return wait(bits, false, timeout, clearOnExit);
+}
+
+EventGroup::Bits
+EventGroup::waitAll(Bits bits, outpost::time::Duration timeout, bool clearOnExit)
+{
+    return wait(bits, true, timeout, clearOnExit);
+}
+
+EventGroup::Bits
+EventGroup::wait(Bits bits, bool all, outpost::time::Duration timeout, bool clearOnExit)
+{
+    bits &= usableBits;
+    if (bits == 0)
+    {
+        return 0;
+    }
+
+    Kernel::Lock lock;
+    if (!Kernel::wait(lock, Kernel::getDeadline(lock, timeout), [&] {
+            const Bits matching = mBits & bits;
+            return all ? (matching == bits) : (matching != 0);
+        }))
+    {
+        return 0;
+    }
+
+    const Bits matching = mBits & bits;
+    if (clearOnExit)
+    {
+        mBits &= ~matching;
+    }
+    return matching;
+}
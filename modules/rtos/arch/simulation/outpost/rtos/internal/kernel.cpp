@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "kernel.h"
+
+#include <atomic>
+
+using outpost::rtos::internal::Kernel;
+
+constexpr Kernel::Time Kernel::infinity;
+
+/// Blocked thread, part of a list on the stack of the blocked threads
+struct Kernel::Waiter
+{
+    Time deadline;
+    bool blocked;
+    Waiter* previous;
+    Waiter* next;
+};
+
+pthread_mutex_t Kernel::mutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t Kernel::signal = PTHREAD_COND_INITIALIZER;
+
+Kernel::Time Kernel::currentTime = 0;
+
+// The main thread is running from the start
+size_t Kernel::numberOfThreads = 1;
+size_t Kernel::numberOfBlockedThreads = 0;
+Kernel::Waiter* Kernel::waiters = nullptr;
+
+// ----------------------------------------------------------------------------
+Kernel::Lock::Lock() : mLocked(false)
+{
+    lock();
+}
+
+Kernel::Lock::~Lock()
+{
+    if (mLocked)
+    {
+        unlock();
+    }
+}
+
+void
+Kernel::Lock::lock()
+{
+    pthread_mutex_lock(&mutex);
+    mLocked = true;
+}
+
+void
+Kernel::Lock::unlock()
+{
+    mLocked = false;
+    pthread_mutex_unlock(&mutex);
+}
+
+// ----------------------------------------------------------------------------
+Kernel::Time
+Kernel::now()
+{
+    Lock lock;
+    return currentTime;
+}
+
+Kernel::Time
+Kernel::getTime(const Lock& /*lock*/)
+{
+    return currentTime;
+}
+
+Kernel::Time
+Kernel::getDeadline(const Lock& /*lock*/, time::Duration timeout)
+{
+    if (timeout == time::Duration::infinity())
+    {
+        return infinity;
+    }
+
+    const int64_t microseconds = timeout.microseconds();
+    if (microseconds <= 0)
+    {
+        return currentTime;
+    }
+    if (microseconds >= (infinity - currentTime))
+    {
+        return infinity;
+    }
+    return currentTime + microseconds;
+}
+
+void
+Kernel::notify(const Lock& /*lock*/)
+{
+    for (Waiter* waiter = waiters; waiter != nullptr; waiter = waiter->next)
+    {
+        if (waiter->blocked)
+        {
+            unblock(*waiter);
+        }
+    }
+    pthread_cond_broadcast(&signal);
+}
+
+void
+Kernel::addThread()
+{
+    Lock lock;
+    numberOfThreads++;
+}
+
+void
+Kernel::removeThread()
+{
+    Lock lock;
+    numberOfThreads--;
+
+    // The remaining threads might all be blocked
+    advanceIfIdle();
+}
+
+uint32_t
+Kernel::getCurrentThreadId()
+{
+    static std::atomic<uint32_t> lastId(0);
+    static thread_local uint32_t id = 0;
+    if (id == 0)
+    {
+        id = lastId.fetch_add(1) + 1;
+    }
+    return id;
+}
+
+size_t
+Kernel::getNumberOfThreads()
+{
+    Lock lock;
+    return numberOfThreads;
+}
+
+// ----------------------------------------------------------------------------
+void
+Kernel::block(Lock& /*lock*/, Time deadline)
+{
+    Waiter waiter = {deadline, true, nullptr, waiters};
+    if (waiters != nullptr)
+    {
+        waiters->previous = &waiter;
+    }
+    waiters = &waiter;
+    numberOfBlockedThreads++;
+
+    // Removes the waiter from the list also if the thread is cancelled
+    // while blocked. The mutex is locked again before unwinding.
+    struct Registration
+    {
+        ~Registration()
+        {
+            if (mWaiter.blocked)
+            {
+                unblock(mWaiter);
+            }
+            if (mWaiter.previous != nullptr)
+            {
+                mWaiter.previous->next = mWaiter.next;
+            }
+            else
+            {
+                waiters = mWaiter.next;
+            }
+            if (mWaiter.next != nullptr)
+            {
+                mWaiter.next->previous = mWaiter.previous;
+            }
+        }
+
+        Waiter& mWaiter;
+    } registration = {waiter};
+
+    advanceIfIdle();
+    while (waiter.blocked)
+    {
+        pthread_cond_wait(&signal, &mutex);
+    }
+}
+
+void
+Kernel::advanceIfIdle()
+{
+    if (numberOfBlockedThreads < numberOfThreads)
+    {
+        return;
+    }
+
+    Time next = infinity;
+    for (Waiter* waiter = waiters; waiter != nullptr; waiter = waiter->next)
+    {
+        if (waiter->blocked && (waiter->deadline < next))
+        {
+            next = waiter->deadline;
+        }
+    }
+
+    if (next == infinity)
+    {
+        // All threads wait without a timeout, nothing will ever change
+        return;
+    }
+
+    if (next > currentTime)
+    {
+        currentTime = next;
+    }
+    for (Waiter* waiter = waiters; waiter != nullptr; waiter = waiter->next)
+    {
+        if (waiter->blocked && (waiter->deadline <= currentTime))
+        {
+            unblock(*waiter);
+        }
+    }
+    pthread_cond_broadcast(&signal);
+}
+
+void
+Kernel::unblock(Waiter& waiter)
+{
+    waiter.blocked = false;
+    numberOfBlockedThreads--;
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_SIMULATION_KERNEL_H
+#define OUTPOST_RTOS_SIMULATION_KERNEL_H
+
+#include <outpost/time/duration.h>
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+namespace internal
+{
+/**
+ * Virtual time and blocking of the simulated-time backend.
+ *
+ * All threads run as ordinary POSIX threads, but every blocking operation
+ * of the RTOS wrappers waits here. The virtual time only advances if all
+ * known threads (the main thread and all started outpost::rtos::Thread
+ * objects) are blocked. It then jumps to the earliest deadline of the
+ * blocked threads and wakes them. A sleep of one hour therefore returns
+ * immediately, but any other thread which is able to run is executed
+ * before.
+ *
+ * The state of all primitives is protected by the single kernel lock.
+ * Every change which may unblock a thread is followed by notify(), which
+ * wakes all blocked threads to check their condition again.
+ *
+ * Threads not created through outpost::rtos::Thread (e.g. std::thread)
+ * are unknown to the kernel and must not use the RTOS primitives.
+ */
+class Kernel
+{
+public:
+    /// Virtual time in microseconds since the start of the program
+    typedef int64_t Time;
+
+    static constexpr Time infinity = INT64_MAX;
+
+    /**
+     * Holds the kernel lock.
+     */
+    class Lock
+    {
+    public:
+        Lock();
+
+        ~Lock();
+
+        // disable copy constructor
+        Lock(const Lock& other) = delete;
+
+        // disable assignment operator
+        Lock&
+        operator=(const Lock& other) = delete;
+
+        void
+        lock();
+
+        void
+        unlock();
+
+    private:
+        bool mLocked;
+    };
+
+    /**
+     * Get the current virtual time, the kernel lock must not be held.
+     */
+    static Time
+    now();
+
+    /**
+     * Get the current virtual time, called with the kernel lock held.
+     */
+    static Time
+    getTime(const Lock& lock);
+
+    /**
+     * Convert a timeout into an absolute deadline.
+     *
+     * Negative timeouts result in the current time, an infinite timeout
+     * in the deadline \c infinity.
+     */
+    static Time
+    getDeadline(const Lock& lock, time::Duration timeout);
+
+    /**
+     * Block until the condition is true or the deadline has passed.
+     *
+     * \param lock
+     *      Lock of the kernel, released while blocked.
+     * \param deadline
+     *      Absolute virtual time, \c infinity to wait without timeout.
+     * \param condition
+     *      Checked with the lock held, after every notify().
+     *
+     * \retval true     Condition is true.
+     * \retval false    Deadline has passed.
+     */
+    template <typename Condition>
+    static inline bool
+    wait(Lock& lock, Time deadline, Condition condition)
+    {
+        while (!condition())
+        {
+            if (getTime(lock) >= deadline)
+            {
+                return false;
+            }
+            block(lock, deadline);
+        }
+        return true;
+    }
+
+    /**
+     * Wake up all blocked threads to check their conditions again.
+     */
+    static void
+    notify(const Lock& lock);
+
+    /**
+     * Register a thread which is about to be started.
+     */
+    static void
+    addThread();
+
+    /**
+     * Unregister a thread which has been terminated.
+     */
+    static void
+    removeThread();
+
+    /**
+     * Identifier of the calling thread, unique for the process lifetime.
+     *
+     * Not zero, the value is used to mark a free mutex.
+     */
+    static uint32_t
+    getCurrentThreadId();
+
+    /**
+     * Number of threads known to the kernel, including the main thread.
+     */
+    static size_t
+    getNumberOfThreads();
+
+private:
+    struct Waiter;
+
+    static void
+    block(Lock& lock, Time deadline);
+
+    /// Advance the time to the next deadline if no thread can run
+    static void
+    advanceIfIdle();
+
+    static void
+    unblock(Waiter& waiter);
+
+    static pthread_mutex_t mutex;
+    static pthread_cond_t signal;
+
+    static Time currentTime;
+    static size_t numberOfThreads;
+    static size_t numberOfBlockedThreads;
+    static Waiter* waiters;
+};
+
+}  // namespace internal
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
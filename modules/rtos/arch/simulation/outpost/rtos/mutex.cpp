@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "mutex.h"
+
+#include "internal/kernel.h"
+
+using outpost::rtos::Mutex;
+using outpost::rtos::internal::Kernel;
+
+Mutex::Mutex() : mOwner(0), mCount(0)
+{
+}
+
+Mutex::~Mutex()
+{
+}
+
+bool
+Mutex::acquire()
+{
+    return acquire(time::Duration::infinity());
+}
+
+bool
+Mutex::acquire(time::Duration timeout)
+{
+    const uint32_t self = Kernel::getCurrentThreadId();
+
+    Kernel::Lock lock;
+    if (mOwner == self)
+    {
+        mCount++;
+        return true;
+    }
+
+    if (!Kernel::wait(lock, Kernel::getDeadline(lock, timeout), [this] { return mOwner == 0; }))
+    {
+        return false;
+    }
+    mOwner = self;
+    mCount = 1;
+    return true;
+}
+
+void
+Mutex::release()
+{
+    Kernel::Lock lock;
+    if (mOwner != Kernel::getCurrentThreadId())
+    {
+        return;
+    }
+
+    mCount--;
+    if (mCount == 0)
+    {
+        mOwner = 0;
+        Kernel::notify(lock);
+    }
+}
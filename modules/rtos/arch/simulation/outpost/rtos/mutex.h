@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_SIMULATION_MUTEX_H
+#define OUTPOST_RTOS_SIMULATION_MUTEX_H
+
+#include <outpost/time/duration.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Mutex
+ *
+ * Recursive mutex, waiting threads block in the simulation kernel.
+ */
+class Mutex
+{
+public:
+    Mutex();
+
+    // disable copy constructor
+    Mutex(const Mutex& other) = delete;
+
+    // disable assignment operator
+    Mutex&
+    operator=(const Mutex& other) = delete;
+
+    ~Mutex();
+
+    /**
+     * Acquire the mutex.
+     *
+     * This function may block if the mutex is currently held by an
+     * other thread.
+     *
+     * \returns    \c true if the mutex could be acquired.
+     */
+    bool
+    acquire();
+
+    /**
+     * Acquire the mutex.
+     *
+     * Same as acquire() but blocks only for \p timeout of virtual time.
+     *
+     * \return    \c true if the mutex could be acquired, \c false in
+     *             case of an error or timeout.
+     */
+    bool
+    acquire(::outpost::time::Duration timeout);
+
+    /**
+     * Release the mutex.
+     *
+     * Does nothing if the calling thread does not hold the mutex.
+     */
+    void
+    release();
+
+private:
+    /// Thread id of the owner, zero if unlocked
+    uint32_t mOwner;
+
+    /// Recursion depth
+    uint32_t mCount;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "periodic_task_manager.h"
+
+#include "internal/kernel.h"
+
+#include <outpost/rtos/mutex_guard.h>
+
+using namespace outpost::rtos;
+using outpost::rtos::internal::Kernel;
+
+static inline outpost::time::Duration
+getDifference(int64_t end, int64_t start)
+{
+    return outpost::time::Microseconds(end - start);
+}
+
+PeriodicTaskManager::PeriodicTaskManager(OverrunPolicy::Type policy) :
+    mMutex(),
+    mPolicy(policy),
+    mTimerRunning(false),
+    mNextWakeTime(0),
+    mPeriodStart(0),
+    mStatistics()
+{
+}
+
+PeriodicTaskManager::Status::Type
+PeriodicTaskManager::nextPeriod(time::Duration period)
+{
+    MutexGuard lock(mMutex);
+    Status::Type currentStatus = Status::running;
+
+    const int64_t currentTime = Kernel::now();
+    if (mTimerRunning)
+    {
+        const time::Duration lateness = getDifference(currentTime, mNextWakeTime);
+        mStatistics.recordEnd(getDifference(currentTime, mPeriodStart), lateness);
+
+        // Check if the time is in the current period
+        if (currentTime > mNextWakeTime)
+        {
+            currentStatus = Status::timeout;
+            if ((mPolicy == OverrunPolicy::skip) && (period > time::Duration::zero()))
+            {
+                // Start the period which contains the current time
+                const int64_t skipped = lateness.microseconds() / period.microseconds();
+                if (skipped > 0)
+                {
+                    mNextWakeTime += period.microseconds() * skipped;
+                    mStatistics.recordSkippedPeriods(static_cast<uint32_t>(skipped));
+                }
+            }
+            mPeriodStart = currentTime;
+        }
+        else
+        {
+            Kernel::Lock kernelLock;
+            Kernel::wait(kernelLock, mNextWakeTime, [] { return false; });
+            mPeriodStart = Kernel::getTime(kernelLock);
+        }
+        mStatistics.recordStart(getDifference(mPeriodStart, mNextWakeTime));
+    }
+    else
+    {
+        // period is started now, no need to wait
+        mNextWakeTime = currentTime;
+        mPeriodStart = currentTime;
+        mTimerRunning = true;
+    }
+
+    // calculate the next wake-up time
+    mNextWakeTime += period.microseconds();
+
+    return currentStatus;
+}
+
+PeriodicTaskManager::Status::Type
+PeriodicTaskManager::status()
+{
+    MutexGuard lock(mMutex);
+    if (!mTimerRunning)
+    {
+        return Status::idle;
+    }
+    else if (Kernel::now() > mNextWakeTime)
+    {
+        return Status::timeout;
+    }
+    else
+    {
+        return Status::running;
+    }
+}
+
+void
+PeriodicTaskManager::cancel()
+{
+    MutexGuard lock(mMutex);
+    mTimerRunning = false;
+}
+
+PeriodicTaskStatistics
+PeriodicTaskManager::getStatistics()
+{
+    MutexGuard lock(mMutex);
+    return mStatistics;
+}
+
+void
+PeriodicTaskManager::resetStatistics()
+{
+    MutexGuard lock(mMutex);
+    mStatistics.reset();
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_SIMULATION_PERIODIC_TASK_MANAGER_H
+#define OUTPOST_RTOS_SIMULATION_PERIODIC_TASK_MANAGER_H
+
+#include <outpost/rtos/mutex.h>
+#include <outpost/rtos/periodic_task_statistics.h>
+#include <outpost/time/duration.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Helper class for Rate-Monotonic Scheduling (RMS).
+ *
+ * Periods are measured in the virtual time of the simulation.
+ *
+ * \ingroup    rtos
+ */
+class PeriodicTaskManager
+{
+public:
+    struct Status
+    {
+        enum Type
+        {
+            /// Period has not been started
+            idle,
+
+            /// Period is currently running
+            running,
+
+            /// Period has expired
+            timeout
+        };
+    };
+
+    /**
+     * Handling of periods which have passed when nextPeriod() is called
+     * too late.
+     *
+     * In both cases the periods stay aligned to the time of the first
+     * call of nextPeriod(), overruns do not introduce a drift.
+     */
+    struct OverrunPolicy
+    {
+        enum Type
+        {
+            /// Every missed period is started immediately, until the task
+            /// is back on schedule
+            catchUp,
+
+            /// Periods which have already ended are dropped, the period
+            /// in which nextPeriod() is called is started immediately
+            skip
+        };
+    };
+
+    explicit PeriodicTaskManager(OverrunPolicy::Type policy = OverrunPolicy::catchUp);
+
+    ~PeriodicTaskManager() = default;
+
+    /**
+     * Start next period.
+     *
+     * If the PeriodicTaskManager is running, the calling thread will
+     * be blocked for the remainder of the outstanding period and,
+     * upon completion of that period, the period will be reinitialized
+     * with the specified period.
+     *
+     * If the PeriodicTaskManager is not currently running and has
+     * not expired, it is initiated with a length of period ticks and
+     * the calling task returns immediately.
+     *
+     * If the PeriodicTaskManager has expired before the thread invokes
+     * the \c nextPeriod method, the period will be initiated with a
+     * length of *period* and the calling task returns immediately with
+     * a timeout error status.
+     *
+     * \param  period
+     *     Length of the next period. Can be different from the
+     *     previous one.
+     *
+     * \retval    Status::running
+     *     Period is currently running.
+     * \retval  Status::timeout
+     *     Last period was missed, this may require some different
+     *     handling from the user.
+     */
+    Status::Type
+    nextPeriod(time::Duration period);
+
+    /**
+     * Check the status of the current period.
+     *
+     * \retval  Status::idle
+     *     Period has not been started.
+     * \retval    Status::running
+     *     Period is currently running.
+     * \retval  Status::timeout
+     *     Last period was missed, this may require some different
+     *     handling from the user.
+     */
+    Status::Type
+    status();
+
+    /**
+     * Period measurement is stopped.
+     *
+     * Can be restarted with the invocation of \c nextPeriod.
+     */
+    void
+    cancel();
+
+    /**
+     * Get the timing statistics since the creation or the last call of
+     * resetStatistics().
+     */
+    PeriodicTaskStatistics
+    getStatistics();
+
+    void
+    resetStatistics();
+
+private:
+    Mutex mMutex;
+    const OverrunPolicy::Type mPolicy;
+    bool mTimerRunning;
+
+    /// End of the current period, virtual time in microseconds
+    int64_t mNextWakeTime;
+
+    /// Time at which nextPeriod() returned
+    int64_t mPeriodStart;
+
+    PeriodicTaskStatistics mStatistics;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_SIMULATION_QUEUE_H
+#define OUTPOST_RTOS_SIMULATION_QUEUE_H
+
+#include <outpost/time/duration.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <type_traits>
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Atomic Queue.
+ *
+ * Can be used to exchange data between different threads.
+ *
+ * \warning
+ *      Limited to POD types (see http://en.cppreference.com/w/cpp/concept/PODType)
+ *      for compatibility with the FreeRTOS and RTEMS implementations.
+ *
+ * Waiting threads block in the simulation kernel.
+ *
+ * \ingroup rtos
+ */
+template <typename T>
+class Queue
+{
+    static_assert(std::is_pod<T>::value, "T must be POD");
+
+public:
+    /**
+     * Create a Queue.
+     *
+     * \param numberOfItems
+     *      The maximum number of items that the queue can contain.
+     */
+    Queue(size_t numberOfItems);
+
+    // disable copy constructor
+    Queue(const Queue& other) = delete;
+
+    // disable assignment operator
+    Queue&
+    operator=(const Queue& other) = delete;
+
+    /**
+     * Destroy the queue.
+     */
+    ~Queue();
+
+    /**
+     * Send data to the queue.
+     *
+     * \param data
+     *      Reference to the item that is to be placed on the queue.
+     *
+     * \retval true     Value was successfully stored in the queue.
+     * \retval false    Timeout occurred. Queue is full and data could not be
+     *                  appended in the specified time.
+     */
+    bool
+    send(const T& data);
+
+    /**
+     * Receive data from the queue.
+     *
+     * \param data
+     *      Reference to the buffer into which the received item will be copied.
+     * \param timeout
+     *      Timeout in virtual time.
+     *
+     * \retval true     Value was received correctly and put in \p data.
+     * \retval false    Timeout occurred, \p data was not changed.
+     */
+    bool
+    receive(T& data, outpost::time::Duration timeout);
+
+protected:
+    /**
+     * Create a Queue which uses the given storage, see StaticQueue.
+     *
+     * \param numberOfItems
+     *      The maximum number of items that the queue can contain.
+     * \param storage
+     *      Buffer for \p numberOfItems items, must outlive the queue.
+     */
+    Queue(size_t numberOfItems, T* storage);
+
+private:
+    size_t
+    increment(size_t index) const;
+
+    T* mBuffer;
+
+    /// Buffer has been allocated by the queue
+    const bool mOwnsBuffer;
+
+    const size_t mMaximumSize;
+    size_t mItemsInBuffer;
+    size_t mHead;
+    size_t mTail;
+};
+
+namespace internal
+{
+/**
+ * Storage of a StaticQueue.
+ *
+ * Base class of StaticQueue so that it is constructed before the queue.
+ */
+template <typename T, size_t N>
+struct StaticQueueStorage
+{
+    T mItems[N];
+};
+}  // namespace internal
+
+/**
+ * Queue with the buffer inside the object.
+ *
+ * Same as Queue but no memory is allocated at construction.
+ *
+ * \tparam T
+ *      Type of the items, limited to POD types.
+ * \tparam N
+ *      The maximum number of items that the queue can contain.
+ *
+ * \ingroup rtos
+ */
+template <typename T, size_t N>
+class StaticQueue : private internal::StaticQueueStorage<T, N>, public Queue<T>
+{
+    static_assert(N > 0, "Queue must hold at least one item");
+
+public:
+    StaticQueue() : Queue<T>(N, this->mItems)
+    {
+    }
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#include "queue_impl.h"
+
+#endif
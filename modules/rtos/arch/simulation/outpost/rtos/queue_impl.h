@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_SIMULATION_QUEUE_IMPL_H
+#define OUTPOST_RTOS_SIMULATION_QUEUE_IMPL_H
+
+#include "internal/kernel.h"
+#include "queue.h"
+
+template <typename T>
+outpost::rtos::Queue<T>::Queue(size_t numberOfItems) :
+    mBuffer(new T[numberOfItems]),
+    mOwnsBuffer(true),
+    mMaximumSize(numberOfItems),
+    mItemsInBuffer(0),
+    mHead(0),
+    mTail(0)
+{
+}
+
+template <typename T>
+outpost::rtos::Queue<T>::Queue(size_t numberOfItems, T* storage) :
+    mBuffer(storage),
+    mOwnsBuffer(false),
+    mMaximumSize(numberOfItems),
+    mItemsInBuffer(0),
+    mHead(0),
+    mTail(0)
+{
+}
+
+template <typename T>
+outpost::rtos::Queue<T>::~Queue()
+{
+    if (mOwnsBuffer)
+    {
+        delete[] mBuffer;
+    }
+}
+
+template <typename T>
+bool
+outpost::rtos::Queue<T>::send(const T& data)
+{
+    internal::Kernel::Lock lock;
+    if (mItemsInBuffer >= mMaximumSize)
+    {
+        return false;
+    }
+
+    mHead = increment(mHead);
+    mBuffer[mHead] = data;
+    mItemsInBuffer++;
+
+    internal::Kernel::notify(lock);
+    return true;
+}
+
+template <typename T>
+bool
+outpost::rtos::Queue<T>::receive(T& data, outpost::time::Duration timeout)
+{
+    internal::Kernel::Lock lock;
+    if (!internal::Kernel::wait(lock, internal::Kernel::getDeadline(lock, timeout), [this] {
+            return mItemsInBuffer > 0;
+        }))
+    {
+        return false;
+    }
+
+    mTail = increment(mTail);
+    data = mBuffer[mTail];
+    mItemsInBuffer--;
+    return true;
+}
+
+template <typename T>
+size_t
+outpost::rtos::Queue<T>::increment(size_t index) const
+{
+    if (index >= (mMaximumSize - 1))
+    {
+        index = 0;
+    }
+    else
+    {
+        index++;
+    }
+
+    return index;
+}
+
+#endif
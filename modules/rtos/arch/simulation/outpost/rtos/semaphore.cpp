@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "semaphore.h"
+
+#include "internal/kernel.h"
+
+using outpost::rtos::BinarySemaphore;
+using outpost::rtos::Semaphore;
+using outpost::rtos::internal::Kernel;
+
+Semaphore::Semaphore(uint32_t count) : mCount(count)
+{
+}
+
+Semaphore::~Semaphore()
+{
+}
+
+bool
+Semaphore::acquire()
+{
+    return acquire(time::Duration::infinity());
+}
+
+bool
+Semaphore::acquire(time::Duration timeout)
+{
+    Kernel::Lock lock;
+    if (!Kernel::wait(lock, Kernel::getDeadline(lock, timeout), [this] { return mCount > 0; }))
+    {
+        return false;
+    }
+    mCount--;
+    return true;
+}
+
+void
+Semaphore::release()
+{
+    Kernel::Lock lock;
+    mCount++;
+    Kernel::notify(lock);
+}
+
+// ----------------------------------------------------------------------------
+BinarySemaphore::BinarySemaphore() : mValue(State::released)
+{
+}
+
+BinarySemaphore::BinarySemaphore(State::Type initial) : mValue(initial)
+{
+}
+
+BinarySemaphore::~BinarySemaphore()
+{
+}
+
+bool
+BinarySemaphore::acquire()
+{
+    return acquire(time::Duration::infinity());
+}
+
+bool
+BinarySemaphore::acquire(time::Duration timeout)
+{
+    Kernel::Lock lock;
+    if (!Kernel::wait(lock, Kernel::getDeadline(lock, timeout), [this] {
+            return mValue == State::released;
+        }))
+    {
+        return false;
+    }
+    mValue = State::acquired;
+    return true;
+}
+
+void
+BinarySemaphore::release()
+{
+    Kernel::Lock lock;
+    mValue = State::released;
+    Kernel::notify(lock);
+}
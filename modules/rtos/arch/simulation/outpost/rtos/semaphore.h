@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_SIMULATION_SEMAPHORE_H
+#define OUTPOST_RTOS_SIMULATION_SEMAPHORE_H
+
+#include <outpost/time/duration.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Counting Semaphore.
+ *
+ * Waiting threads block in the simulation kernel.
+ */
+class Semaphore
+{
+public:
+    /**
+     * Create a Semaphore.
+     *
+     * \param count
+     *         Initial value for the semaphore.
+     */
+    explicit Semaphore(uint32_t count);
+
+    // disable copy constructor
+    Semaphore(const Semaphore& other) = delete;
+
+    // disable assignment operator
+    Semaphore&
+    operator=(const Semaphore& other) = delete;
+
+    ~Semaphore();
+
+    /**
+     * Decrement the count.
+     *
+     * Blocks if the count is currently zero until it is incremented
+     * by another thread calling the release() method.
+     */
+    bool
+    acquire();
+
+    /**
+     * Decrement the count.
+     *
+     * Same a acquire() but abort after \p timeout of virtual time.
+     *
+     * \return    \c true if the semaphore could be successfully acquired,
+     *             \c false in case of an error or timeout.
+     */
+    bool
+    acquire(time::Duration timeout);
+
+    /**
+     * Increment the count.
+     *
+     * This function will never block.
+     */
+    void
+    release();
+
+private:
+    uint32_t mCount;
+};
+
+/**
+ * Binary semaphore.
+ *
+ * Restricts the value of the semaphore to 0 and 1.
+ */
+class BinarySemaphore
+{
+public:
+    struct State
+    {
+        enum Type
+        {
+            acquired,
+            released
+        };
+    };
+
+    /**
+     * Create a binary semaphore in the released state.
+     */
+    BinarySemaphore();
+
+    /**
+     * Create a binary semaphore.
+     *
+     * \param    initial
+     *         Initial value of the semaphore.
+     */
+    explicit BinarySemaphore(State::Type initial);
+
+    // disable copy constructor
+    BinarySemaphore(const BinarySemaphore& other) = delete;
+
+    // disable assignment operator
+    BinarySemaphore&
+    operator=(const BinarySemaphore& other) = delete;
+
+    ~BinarySemaphore();
+
+    /**
+     * Decrement the count.
+     *
+     * Blocks if the count is currently zero until it is incremented
+     * by another thread calling the release() method.
+     */
+    bool
+    acquire();
+
+    /**
+     * Decrement the count.
+     *
+     * Same a acquire() but abort after \p timeout of virtual time.
+     *
+     * \return    \c true if the semaphore could be successfully acquired,
+     *             \c false in case of an error or timeout.
+     */
+    bool
+    acquire(time::Duration timeout);
+
+    /**
+     * Increment the count.
+     *
+     * This function will never block.
+     */
+    void
+    release();
+
+    /**
+     * Increment the count from an interrupt handler.
+     *
+     * Interrupts are simulated by threads, identical to release().
+     */
+    inline void
+    releaseFromInterrupt()
+    {
+        release();
+    }
+
+private:
+    State::Type mValue;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
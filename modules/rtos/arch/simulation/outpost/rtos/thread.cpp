@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "thread.h"
+
+#include "internal/kernel.h"
+
+#include <outpost/rtos/failure_handler.h>
+#include <outpost/rtos/thread_profiler.h>
+
+#include <limits.h>
+#include <sched.h>
+
+using outpost::rtos::Thread;
+using outpost::rtos::internal::Kernel;
+
+void*
+Thread::wrapper(void* object)
+{
+    Thread* thread = reinterpret_cast<Thread*>(object);
+
+    // Unregisters the thread also if it is cancelled
+    struct Registration
+    {
+        ~Registration()
+        {
+            Kernel::removeThread();
+        }
+    } registration;
+
+    thread->mTid = Thread::getCurrentThreadIdentifier();
+    thread->run();
+
+    // Returning from a thread is a fatal error, nothing more to
+    // do here than call the fatal error handler.
+    rtos::FailureHandler::fatal(rtos::FailureCode::returnFromThread());
+
+    return NULL;
+}
+
+Thread::Thread(uint8_t priority,
+               size_t stack,
+               const char* name,
+               FloatingPointSupport /*floatingPointSupport*/) :
+    mIsRunning(false),
+    mPthreadId(),
+    mTid(invalidIdentifier),
+    mName(),
+    mPriority(priority),
+    mStackSize(stack)
+{
+    if (name != 0)
+    {
+        mName = std::string(name);
+    }
+}
+
+Thread::~Thread()
+{
+    if (mIsRunning)
+    {
+        ThreadProfiler::unregisterThread(*this);
+        pthread_cancel(mPthreadId);
+        pthread_join(mPthreadId, NULL);
+    }
+}
+
+Thread::Identifier
+Thread::getIdentifier() const
+{
+    return mTid;
+}
+
+Thread::Identifier
+Thread::getCurrentThreadIdentifier()
+{
+    return Kernel::getCurrentThreadId();
+}
+
+void
+Thread::getProfile(ThreadProfile& profile) const
+{
+    profile.setName(mName.c_str());
+    profile.identifier = mTid;
+    profile.priority = mPriority;
+    profile.cpuTime = time::Duration::zero();
+    profile.stackSize = mStackSize;
+    profile.stackUsage = 0;
+    profile.contextSwitches = 0;
+}
+
+void
+Thread::start()
+{
+    mIsRunning = true;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+
+    if (mStackSize != defaultStackSize)
+    {
+        size_t stackSize = mStackSize;
+        if (stackSize < static_cast<size_t>(PTHREAD_STACK_MIN))
+        {
+            stackSize = PTHREAD_STACK_MIN;
+        }
+        pthread_attr_setstacksize(&attr, stackSize);
+    }
+
+    // Counted before it runs, the time must not advance until the new
+    // thread had the chance to block
+    Kernel::addThread();
+    int ret = pthread_create(&mPthreadId, &attr, &Thread::wrapper, reinterpret_cast<void*>(this));
+    if (ret != 0)
+    {
+        FailureHandler::fatal(FailureCode::resourceAllocationFailed(Resource::thread));
+    }
+
+    if (!mName.empty())
+    {
+        // Names are limited to 16 characters
+        pthread_setname_np(mPthreadId, mName.substr(0, 15).c_str());
+    }
+
+    pthread_attr_destroy(&attr);
+
+    ThreadProfiler::registerThread(*this);
+}
+
+void
+Thread::setPriority(uint8_t priority)
+{
+    mPriority = priority;
+}
+
+uint8_t
+Thread::getPriority() const
+{
+    return mPriority;
+}
+
+void
+Thread::yield()
+{
+    sched_yield();
+}
+
+void
+Thread::sleep(::outpost::time::Duration timeout)
+{
+    Kernel::Lock lock;
+    Kernel::wait(lock, Kernel::getDeadline(lock, timeout), [] { return false; });
+}
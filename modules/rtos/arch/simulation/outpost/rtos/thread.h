@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_SIMULATION_THREAD_H
+#define OUTPOST_RTOS_SIMULATION_THREAD_H
+
+#include <pthread.h>
+
+#include <outpost/time/duration.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+namespace outpost
+{
+namespace rtos
+{
+struct ThreadProfile;
+
+/**
+ * Wrapper class for the Thread function of the Operating System.
+ *
+ * The run()-method of a derived class is invoked in the newly created
+ * thread context. The derived class can also hold data members
+ * associated with the specific thread.
+ *
+ * Threads are POSIX threads, but sleep() and all timeouts use the
+ * virtual time of the simulation (see internal::Kernel). The priority is
+ * stored but not used for scheduling.
+ *
+ * \ingroup    rtos
+ */
+class Thread
+{
+public:
+    /// Unique identifier to identify a thread.
+    typedef uint32_t Identifier;
+
+    enum FloatingPointSupport
+    {
+        noFloatingPoint,
+        floatingPoint
+    };
+
+    /**
+     * Initial return value of getIdentifier() before the
+     * thread have been started and an associated thread id.
+     */
+    static const Identifier invalidIdentifier = 0xFFFFFFFF;
+
+    /**
+     * Use the default value for the stack size.
+     *
+     * The default value is depending on the project settings.
+     */
+    static const size_t defaultStackSize = 0;
+
+    /**
+     * Create a new thread.
+     *
+     * \param priority
+     *         Thread priority, not used by the simulation.
+     * \param stack
+     *         Stack size in bytes. Rounded up to PTHREAD_STACK_MIN, the
+     *         default stack size of the system is used for
+     *         \c defaultStackSize.
+     * \param name
+     *         Name of the thread.
+     */
+    explicit Thread(uint8_t priority,
+                    size_t stack = defaultStackSize,
+                    const char* name = 0,
+                    FloatingPointSupport floatingPointSupport = noFloatingPoint);
+
+    /**
+     * Destructor.
+     *
+     * Cancels the thread, it is terminated at its next blocking call.
+     */
+    virtual ~Thread();
+
+    /**
+     * Start the execution of the thread.
+     */
+    void
+    start();
+
+    /**
+     * Get a unique identifier for this thread.
+     *
+     * \return  Unique identifier, invalidIdentifier until the thread
+     *          is running.
+     */
+    Identifier
+    getIdentifier() const;
+
+    /**
+     * Get the unique identifier for the currently executed thread.
+     *
+     * \return  Unique identifier.
+     */
+    static Identifier
+    getCurrentThreadIdentifier();
+
+    /**
+     * Query the stack usage of the thread.
+     *
+     * The simulation reports no processor time, the processor time of
+     * a simulated thread is not related to the virtual time.
+     *
+     * \see ThreadProfiler
+     */
+    void
+    getProfile(ThreadProfile& profile) const;
+
+    void
+    setPriority(uint8_t priority);
+
+    uint8_t
+    getPriority() const;
+
+    /**
+     * Give up the processor but remain in ready state.
+     *
+     * Does not advance the virtual time.
+     */
+    static void
+    yield();
+
+    /**
+     * Suspend the current thread for the given virtual time.
+     *
+     * \param timeout
+     *         Time to sleep.
+     */
+    static void
+    sleep(::outpost::time::Duration timeout);
+
+protected:
+    /**
+     * Working method of the thread.
+     *
+     * This method is called after the thread is started. It may never
+     * return (endless loop). On a return the fatal error
+     * handler will be called.
+     */
+    virtual void
+    run() = 0;
+
+private:
+    static void*
+    wrapper(void* object);
+
+    bool mIsRunning;
+    pthread_t mPthreadId;
+    Identifier mTid;
+    std::string mName;
+    uint8_t mPriority;
+    size_t mStackSize;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
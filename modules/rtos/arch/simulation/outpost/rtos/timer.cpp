@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "timer.h"
+
+#include "internal/kernel.h"
+#include "thread.h"
+
+using outpost::rtos::Timer;
+using outpost::rtos::internal::Kernel;
+
+namespace outpost
+{
+namespace rtos
+{
+namespace internal
+{
+/**
+ * Timer daemon thread calling the expired timers.
+ *
+ * The thread blocks in the kernel until the earliest expiry, the kernel
+ * lock protects the list of running timers.
+ */
+class TimerService : public Thread
+{
+public:
+    /**
+     * Get the service, it is created if it does not exist yet. The
+     * service is never destroyed, timers with static storage duration may
+     * use it until the end of the program.
+     */
+    static TimerService&
+    getInstance(uint8_t priority, size_t stack);
+
+    void
+    add(const Kernel::Lock& lock, Timer& timer, time::Duration duration);
+
+    void
+    remove(const Kernel::Lock& lock, Timer& timer);
+
+protected:
+    virtual void
+    run() override;
+
+private:
+    TimerService(uint8_t priority, size_t stack);
+
+    /// Expired timer with the earliest expiry, nullptr if none
+    Timer*
+    findExpired(const Kernel::Lock& lock) const;
+
+    Kernel::Time
+    getNextExpiry() const;
+
+    Timer* mTimers;
+
+    /// Set when the list has been changed while the thread is blocked
+    bool mChanged;
+};
+
+TimerService::TimerService(uint8_t priority, size_t stack) :
+    Thread(priority, stack, "TIMER"), mTimers(nullptr), mChanged(false)
+{
+}
+
+TimerService&
+TimerService::getInstance(uint8_t priority, size_t stack)
+{
+    // Thread-safe initialization on the first call
+    static TimerService* instance = [=] {
+        TimerService* service = new TimerService(priority, stack);
+        service->start();
+        return service;
+    }();
+    return *instance;
+}
+
+void
+TimerService::add(const Kernel::Lock& lock, Timer& timer, time::Duration duration)
+{
+    remove(lock, timer);
+    if (duration == time::Duration::infinity())
+    {
+        return;
+    }
+
+    timer.mExpiry = Kernel::getDeadline(lock, duration);
+    timer.mRunning = true;
+    timer.mPrevious = nullptr;
+    timer.mNext = mTimers;
+    if (mTimers != nullptr)
+    {
+        mTimers->mPrevious = &timer;
+    }
+    mTimers = &timer;
+
+    mChanged = true;
+    Kernel::notify(lock);
+}
+
+void
+TimerService::remove(const Kernel::Lock& /*lock*/, Timer& timer)
+{
+    if (!timer.mRunning)
+    {
+        return;
+    }
+
+    if (timer.mPrevious != nullptr)
+    {
+        timer.mPrevious->mNext = timer.mNext;
+    }
+    else
+    {
+        mTimers = timer.mNext;
+    }
+    if (timer.mNext != nullptr)
+    {
+        timer.mNext->mPrevious = timer.mPrevious;
+    }
+    timer.mRunning = false;
+    timer.mPrevious = nullptr;
+    timer.mNext = nullptr;
+
+    // A removed timer can only delay the wake-up, the thread is not
+    // notified
+}
+
+Timer*
+TimerService::findExpired(const Kernel::Lock& lock) const
+{
+    const Kernel::Time now = Kernel::getTime(lock);
+    Timer* expired = nullptr;
+    for (Timer* timer = mTimers; timer != nullptr; timer = timer->mNext)
+    {
+        if ((timer->mExpiry <= now)
+            && ((expired == nullptr) || (timer->mExpiry < expired->mExpiry)))
+        {
+            expired = timer;
+        }
+    }
+    return expired;
+}
+
+Kernel::Time
+TimerService::getNextExpiry() const
+{
+    Kernel::Time next = Kernel::infinity;
+    for (Timer* timer = mTimers; timer != nullptr; timer = timer->mNext)
+    {
+        if (timer->mExpiry < next)
+        {
+            next = timer->mExpiry;
+        }
+    }
+    return next;
+}
+
+void
+TimerService::run()
+{
+    Kernel::Lock lock;
+    while (true)
+    {
+        Timer* timer = findExpired(lock);
+        if (timer != nullptr)
+        {
+            // The callback may start or cancel timers
+            remove(lock, *timer);
+            lock.unlock();
+            timer->invoke();
+            lock.lock();
+        }
+        else
+        {
+            mChanged = false;
+            Kernel::wait(lock, getNextExpiry(), [this] { return mChanged; });
+        }
+    }
+}
+
+}  // namespace internal
+}  // namespace rtos
+}  // namespace outpost
+
+using outpost::rtos::internal::TimerService;
+
+static constexpr uint8_t defaultDaemonPriority = 255;
+
+Timer::~Timer()
+{
+    cancel();
+}
+
+void
+Timer::start(time::Duration duration)
+{
+    TimerService& service = TimerService::getInstance(defaultDaemonPriority, 0);
+
+    Kernel::Lock lock;
+    mDuration = duration;
+    service.add(lock, *this, duration);
+}
+
+void
+Timer::reset()
+{
+    TimerService& service = TimerService::getInstance(defaultDaemonPriority, 0);
+
+    Kernel::Lock lock;
+    if (mDuration != time::Duration::infinity())
+    {
+        service.add(lock, *this, mDuration);
+    }
+}
+
+void
+Timer::cancel()
+{
+    Kernel::Lock lock;
+    if (mRunning)
+    {
+        // A running timer implies an existing service
+        TimerService::getInstance(defaultDaemonPriority, 0).remove(lock, *this);
+    }
+}
+
+bool
+Timer::isRunning()
+{
+    Kernel::Lock lock;
+    return mRunning;
+}
+
+void
+Timer::startTimerDaemonThread(uint8_t priority, size_t stack)
+{
+    TimerService::getInstance(priority, stack);
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_SIMULATION_TIMER_H
+#define OUTPOST_RTOS_SIMULATION_TIMER_H
+
+#include <outpost/base/callable.h>
+#include <outpost/time/duration.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+namespace internal
+{
+class TimerService;
+}
+
+/**
+ * Software timer.
+ *
+ * The timers expire in the virtual time of the simulation. All running
+ * timers are kept in a list which is processed by a single timer daemon
+ * thread. The timer callback functions are called in the context of this
+ * thread, one after the other.
+ *
+ * \ingroup    rtos
+ */
+class Timer
+{
+public:
+    /**
+     * Type of the timer handler function.
+     *
+     * \param timer
+     *         Timer which caused the function to be called. Can be used
+     *         to restart the timer.
+     */
+    typedef void (Callable::*Function)(Timer* timer);
+
+    template <typename T>
+    struct TimerFunction
+    {
+        typedef void (T::*type)(Timer* timer);
+    };
+
+    /**
+     * Create a timer.
+     *
+     * \param object
+     *         Instance to with the function to be called belongs. Must
+     *         be sub-class of outpost::rtos::Callable.
+     * \param function
+     *         Member function of \p object to call when the timer
+     *         expires.
+     * \param name
+     *         Name of the timer. Maximum length is four characters. Longer
+     *         names will be truncated.
+     *
+     * \see    outpost::Callable
+     */
+    template <typename T>
+    Timer(T* object, typename TimerFunction<T>::type function, const char* name = "TIM-");
+
+    // disable copy-constructor and assignment operator
+    Timer(const Timer& other) = delete;
+
+    Timer&
+    operator=(const Timer& other) = delete;
+
+    /**
+     * Delete the timer.
+     *
+     * If the timer is running, it is automatically canceled. All it's
+     * allocated resources are reclaimed and can be used for another
+     * timer.
+     */
+    ~Timer();
+
+    /**
+     * Start the timer.
+     *
+     * If the timer is running it is automatically reset before being
+     * initiated.
+     *
+     * \param duration
+     *         Runtime duration.
+     */
+    void
+    start(time::Duration duration);
+
+    /**
+     * Reset the timer interval to it's original value when it is
+     * currently running.
+     */
+    void
+    reset();
+
+    /**
+     * Abort operation.
+     *
+     * The timer will not fire until the next invocation of reset() or
+     * start().
+     */
+    void
+    cancel();
+
+    /**
+     * Check whether the timer is currently running.
+     *
+     * \retval  true    Timer is running
+     * \retval  false   Timer has not been started or was stopped.
+     */
+    bool
+    isRunning();
+
+    /**
+     * Start the timer daemon.
+     *
+     * Optional, the daemon is otherwise started when the first timer is
+     * started.
+     *
+     * \param priority
+     *         Thread priority, not used by the simulation.
+     * \param stack
+     *         Stack size in bytes.
+     */
+    static void
+    startTimerDaemonThread(uint8_t priority, size_t stack = 0);
+
+private:
+    friend class internal::TimerService;
+
+    inline void
+    invoke()
+    {
+        (mObject->*mFunction)(this);
+    }
+
+    /// Object and member function to call when the timer expires.
+    Callable* const mObject;
+    Function const mFunction;
+
+    /// Duration of the last start(), infinity if the timer was never started
+    time::Duration mDuration;
+
+    /// Virtual time of the expiry, only valid while the timer is running
+    int64_t mExpiry;
+
+    /// List of the running timers, protected by the simulation kernel
+    bool mRunning;
+    Timer* mPrevious;
+    Timer* mNext;
+};
+
+// ----------------------------------------------------------------------------
+// Implementation of the template constructor
+template <typename T>
+Timer::Timer(T* object, typename TimerFunction<T>::type function, const char* name) :
+    mObject(reinterpret_cast<Callable*>(object)),
+    mFunction(reinterpret_cast<Function>(function)),
+    mDuration(time::Duration::infinity()),
+    mExpiry(0),
+    mRunning(false),
+    mPrevious(nullptr),
+    mNext(nullptr)
+{
+    (void) name;
+}
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
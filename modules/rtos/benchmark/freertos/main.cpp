@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * \file
+ * \brief   RTOS benchmark for the STM32F4Discovery Board.
+ *
+ * Uses the xpcc library to provide the STM32F4xx hardware drivers. The
+ * results are written to USART2 (PA2, 115200 baud).
+ */
+
+#include <outpost/rtos/failure_handler.h>
+
+#include <xpcc/architecture.hpp>
+#include <xpcc/processing/rtos.hpp>
+
+#include "../reference/rtos_benchmark.h"
+
+using namespace xpcc::stm32;
+
+typedef GpioOutputD12 LedGreen;  // User LED 4
+typedef GpioOutputD14 LedRed;    // User LED 5
+
+/// STM32F4 running at 168MHz (USB Clock at 48MHz) generated from the
+/// external on-board 8MHz crystal
+typedef SystemClock<Pll<ExternalCrystal<MHz8>, MHz168, MHz48> > DefaultSystemClock;
+
+RtosBenchmark benchmark(100);
+
+/**
+ * Sets the green LED after the last measurement.
+ */
+class Indicator : public outpost::rtos::Thread
+{
+public:
+    Indicator() : Thread(50, defaultStackSize, "IND")
+    {
+    }
+
+private:
+    virtual void
+    run() override
+    {
+        benchmark.waitForCompletion();
+        LedGreen::set();
+        while (1)
+        {
+            sleep(outpost::time::Seconds(1));
+        }
+    }
+};
+
+Indicator indicator;
+
+// Output of printf
+extern "C" int
+_write(int /*file*/, const char* ptr, int length)
+{
+    for (int i = 0; i < length; ++i)
+    {
+        while (!Usart2::write(static_cast<uint8_t>(ptr[i])))
+        {
+        }
+    }
+    return length;
+}
+
+static void
+failureHandler(outpost::rtos::FailureCode code)
+{
+    (void) code;
+
+    LedRed::set();
+
+    while (1)
+    {
+        // wait forever
+    }
+}
+
+int
+main(void)
+{
+    DefaultSystemClock::enable();
+
+    LedGreen::setOutput(xpcc::Gpio::Low);
+    LedRed::setOutput(xpcc::Gpio::Low);
+
+    GpioOutputA2::connect(Usart2::Tx);
+    Usart2::initialize<DefaultSystemClock, 115200>(10);
+
+    outpost::rtos::FailureHandler::setFailureHandlerFunction(&failureHandler);
+
+    benchmark.start();
+    indicator.start();
+
+    xpcc::rtos::Scheduler::schedule();
+    LedRed::set();
+}
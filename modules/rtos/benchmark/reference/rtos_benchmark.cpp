@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "rtos_benchmark.h"
+
+#include <outpost/rtos/cycle_clock.h>
+#include <outpost/rtos/mutex.h>
+#include <outpost/rtos/periodic_task_manager.h>
+#include <outpost/rtos/queue.h>
+#include <outpost/rtos/timer.h>
+#include <outpost/utils/benchmark/benchmark_runner.h>
+
+#include <stdint.h>
+
+using outpost::rtos::CycleClock;
+using outpost::rtos::Thread;
+
+namespace
+{
+constexpr size_t numberOfSamples = 1000;
+
+// Calls before the measured samples, the second thread has to answer them too
+constexpr size_t numberOfWarmupCalls = 10;
+constexpr size_t numberOfCalls = numberOfWarmupCalls + numberOfSamples;
+
+// The jitter measurements take one period per sample
+constexpr size_t numberOfPeriods = 200;
+
+// Operations per sample of the measurements which do not block
+constexpr size_t operationsPerSample = 32;
+
+const outpost::time::Duration period = outpost::time::Milliseconds(1);
+const outpost::time::Duration timeout = outpost::time::Seconds(1);
+
+// Global instead of on the stack of the benchmark thread
+CycleClock::Ticks sampleStorage[numberOfSamples];
+
+outpost::rtos::Mutex mutex;
+outpost::rtos::Semaphore ping(0);
+outpost::rtos::Semaphore pong(0);
+outpost::rtos::Queue<uint32_t> requests(1);
+outpost::rtos::Queue<uint32_t> responses(1);
+
+// Time of the last expiry of the timer, written by the timer handler
+outpost::rtos::Semaphore expired(0);
+CycleClock::Ticks expiry = 0;
+
+class TimerHandler
+{
+public:
+    void
+    onExpiry(outpost::rtos::Timer* /*timer*/)
+    {
+        expiry = CycleClock::now();
+        expired.release();
+    }
+};
+
+CycleClock::Ticks
+getPeriodTicks()
+{
+    return static_cast<CycleClock::Ticks>(CycleClock::getFrequency() / 1000);
+}
+
+/**
+ * Absolute difference of two durations given in ticks.
+ */
+CycleClock::Ticks
+getDeviation(CycleClock::Ticks actual, CycleClock::Ticks nominal)
+{
+    return (actual >= nominal) ? (actual - nominal) : (nominal - actual);
+}
+
+// ---------------------------------------------------------------------------
+// One sample each, called by the BenchmarkRunner
+bool
+lockMutex(bool yield)
+{
+    for (size_t k = 0; k < operationsPerSample; ++k)
+    {
+        mutex.acquire();
+        if (yield)
+        {
+            Thread::yield();
+        }
+        mutex.release();
+    }
+    return true;
+}
+
+bool
+pingSemaphore()
+{
+    ping.release();
+    return pong.acquire(timeout);
+}
+
+bool
+sendAndReceive()
+{
+    bool valid = true;
+    for (uint32_t k = 0; k < operationsPerSample; ++k)
+    {
+        uint32_t value = 0;
+        valid = requests.send(k) && valid;
+        valid = requests.receive(value, outpost::time::Duration::zero()) && (value == k) && valid;
+    }
+    return valid;
+}
+
+bool
+sendRequest()
+{
+    static uint32_t request = 0;
+    uint32_t value = 0;
+
+    ++request;
+    return requests.send(request) && responses.receive(value, timeout) && (value == request + 1);
+}
+
+bool
+yieldThread()
+{
+    for (size_t k = 0; k < operationsPerSample; ++k)
+    {
+        Thread::yield();
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Jitter measurements, recording one sample per period themselves
+bool
+measureTimerJitter(outpost::Slice<CycleClock::Ticks> samples)
+{
+    TimerHandler handler;
+    outpost::rtos::Timer timer(&handler, &TimerHandler::onExpiry, "BNCH");
+    const CycleClock::Ticks periodTicks = getPeriodTicks();
+
+    bool valid = true;
+    for (size_t i = 0; i < numberOfPeriods; ++i)
+    {
+        const CycleClock::Ticks start = CycleClock::now();
+        timer.start(period);
+        if (expired.acquire(timeout))
+        {
+            samples[i] = getDeviation(expiry - start, periodTicks);
+        }
+        else
+        {
+            samples[i] = 0;
+            valid = false;
+        }
+    }
+    return valid;
+}
+
+bool
+measurePeriodicTaskJitter(outpost::Slice<CycleClock::Ticks> samples)
+{
+    outpost::rtos::PeriodicTaskManager manager;
+    const CycleClock::Ticks periodTicks = getPeriodTicks();
+
+    // The first call starts the periods
+    manager.nextPeriod(period);
+    const CycleClock::Ticks start = CycleClock::now();
+    for (size_t i = 0; i < numberOfPeriods; ++i)
+    {
+        manager.nextPeriod(period);
+        samples[i] = getDeviation(CycleClock::now() - start,
+                                  periodTicks * static_cast<CycleClock::Ticks>(i + 1));
+    }
+    manager.cancel();
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Counterparts executed by the second thread
+void
+contendMutex()
+{
+    for (size_t i = 0; i < numberOfCalls * operationsPerSample; ++i)
+    {
+        mutex.acquire();
+        Thread::yield();
+        mutex.release();
+    }
+}
+
+void
+answerPing()
+{
+    for (size_t i = 0; i < numberOfCalls; ++i)
+    {
+        if (ping.acquire(timeout))
+        {
+            pong.release();
+        }
+    }
+}
+
+void
+answerRequests()
+{
+    for (size_t i = 0; i < numberOfCalls; ++i)
+    {
+        uint32_t value = 0;
+        if (requests.receive(value, timeout))
+        {
+            responses.send(value + 1);
+        }
+    }
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------------
+RtosBenchmark::RtosBenchmark(uint8_t priority) :
+    Thread(priority, defaultStackSize, "BNCH"),
+    mPartner(priority),
+    mCompleted(0)
+{
+}
+
+void
+RtosBenchmark::waitForCompletion()
+{
+    mCompleted.acquire();
+}
+
+void
+RtosBenchmark::run()
+{
+    mPartner.start();
+
+    outpost::utils::BenchmarkRunner runner("rtos", outpost::asSlice(sampleStorage));
+    runner.setWarmup(numberOfWarmupCalls);
+
+    runner.run("mutexUncontended", [] { return lockMutex(false); }, operationsPerSample);
+
+    mPartner.execute(contendMutex);
+    runner.run("mutexContended", [] { return lockMutex(true); }, operationsPerSample);
+    mPartner.wait();
+
+    mPartner.execute(answerPing);
+    runner.run("semaphorePingPong", pingSemaphore);
+    mPartner.wait();
+
+    runner.run("queueSendReceive", sendAndReceive, operationsPerSample);
+
+    mPartner.execute(answerRequests);
+    runner.run("queueRoundTrip", sendRequest);
+    mPartner.wait();
+
+    runner.run("threadYield", yieldThread, operationsPerSample);
+
+    outpost::utils::BenchmarkRecord timerRecord = runner.createRecord("timerJitter");
+    runner.report(timerRecord, numberOfPeriods, 1, measureTimerJitter(runner.getSamples()));
+
+    outpost::utils::BenchmarkRecord periodicRecord = runner.createRecord("periodicTaskJitter");
+    runner.report(
+            periodicRecord, numberOfPeriods, 1, measurePeriodicTaskJitter(runner.getSamples()));
+
+    mCompleted.release();
+
+    // Threads must not return
+    while (true)
+    {
+        sleep(outpost::time::Seconds(1));
+    }
+}
+
+// ----------------------------------------------------------------------------
+RtosBenchmark::Partner::Partner(uint8_t priority) :
+    Thread(priority, defaultStackSize, "BNCP"),
+    mStart(0),
+    mDone(0),
+    mFunction(nullptr)
+{
+}
+
+void
+RtosBenchmark::Partner::execute(Function function)
+{
+    mFunction = function;
+    mStart.release();
+}
+
+void
+RtosBenchmark::Partner::wait()
+{
+    mDone.acquire();
+}
+
+void
+RtosBenchmark::Partner::run()
+{
+    while (true)
+    {
+        mStart.acquire();
+        mFunction();
+        mDone.release();
+    }
+}
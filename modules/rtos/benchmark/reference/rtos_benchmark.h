@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTOS_BENCHMARK_H
+#define RTOS_BENCHMARK_H
+
+#include <outpost/rtos/semaphore.h>
+#include <outpost/rtos/thread.h>
+
+/**
+ * Latency of the outpost::rtos primitives.
+ *
+ * Runs all measurements once in its own thread and writes one JSON record
+ * per measurement with printf, see outpost::utils::BenchmarkRecord:
+ *
+ *     {"suite":"rtos","benchmark":"mutexUncontended","samples":1000,...,"status":"ok"}
+ *
+ * The statistics are given per operation, i.e. the duration of a sample
+ * divided by the number of operations it contains:
+ *
+ * - mutexUncontended: Mutex::acquire() and release() without a second thread.
+ * - mutexContended: as above, but a second thread of the same priority
+ *   uses the same mutex. Both threads call Thread::yield() while holding
+ *   the mutex, so that the other thread blocks on it also on a single
+ *   core. Compare with threadYield.
+ * - semaphorePingPong: Semaphore::release() to wake the second thread and
+ *   acquire() of a second semaphore released by it.
+ * - queueSendReceive: Queue::send() and receive() without a second thread.
+ * - queueRoundTrip: a value sent to the second thread, which sends it
+ *   back through another queue.
+ * - threadYield: Thread::yield() without another thread ready to run.
+ * - timerJitter: absolute deviation of a one-shot Timer of 1 ms from its
+ *   nominal expiry, measured in the timer handler.
+ * - periodicTaskJitter: absolute deviation of the return of
+ *   PeriodicTaskManager::nextPeriod() with a period of 1 ms from the
+ *   nominal start of the period.
+ *
+ * All times are measured with outpost::rtos::CycleClock. The status is
+ * "ok" or "failed", the latter if an operation did not return the
+ * expected result.
+ *
+ * Only outpost::rtos, outpost::time, outpost::utils and printf are used,
+ * the class must be usable by all OS without any changes. The OS specific
+ * set-up is done in the corresponding folders.
+ */
+class RtosBenchmark : public outpost::rtos::Thread
+{
+public:
+    /**
+     * \param priority
+     *      Priority of the benchmark thread and of the second thread used
+     *      by the contended measurements.
+     */
+    explicit RtosBenchmark(uint8_t priority);
+
+    // disable copy constructor
+    RtosBenchmark(const RtosBenchmark&) = delete;
+
+    // disable assignment operator
+    RtosBenchmark&
+    operator=(const RtosBenchmark&) = delete;
+
+    /**
+     * Block until all measurements have been written.
+     */
+    void
+    waitForCompletion();
+
+private:
+    /// Function executed by the second thread
+    typedef void (*Function)();
+
+    /**
+     * Second thread of the contended measurements.
+     */
+    class Partner : public outpost::rtos::Thread
+    {
+    public:
+        explicit Partner(uint8_t priority);
+
+        /**
+         * Start the execution of \p function, returns immediately.
+         */
+        void
+        execute(Function function);
+
+        /**
+         * Block until the function has returned.
+         */
+        void
+        wait();
+
+    private:
+        virtual void
+        run() override;
+
+        outpost::rtos::Semaphore mStart;
+        outpost::rtos::Semaphore mDone;
+        Function mFunction;
+    };
+
+    virtual void
+    run() override;
+
+    Partner mPartner;
+    outpost::rtos::Semaphore mCompleted;
+};
+
+#endif  // RTOS_BENCHMARK_H
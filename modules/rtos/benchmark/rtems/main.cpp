@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * \file
+ * \brief   RTOS benchmark for the Nexys3 (LEON3).
+ *
+ * The results are written to the console UART.
+ */
+
+#include <stdint.h>
+
+#include <outpost/rtos/timer.h>
+
+#include <bsp.h>
+#include <rtems.h>
+
+#include "../reference/rtos_benchmark.h"
+
+void
+fatalErrorHandler(Internal_errors_Source source, bool isInternal, uint32_t errorCode);
+
+rtems_extensions_table User_extensions = {
+    NULL,    // task_create_extension,
+    NULL,    // task_start_extension
+    NULL,    // task_restart_extension
+    NULL,    // task_delete_extension,
+    NULL,    // task_switch_extension,
+    NULL,    // task_begin_extension
+    NULL,    // task_exitted_extension
+    &fatalErrorHandler        // fatal_extension
+};
+
+#define CONFIGURE_INITIAL_EXTENSIONS    User_extensions
+
+#define CONFIGURE_INIT
+#include "system.h"
+
+void
+fatalErrorHandler(Internal_errors_Source source, bool isInternal, uint32_t errorCode)
+{
+    printk("Fatal error handler: %i, %i, %ld\n", source, isInternal, errorCode);
+    while (1)
+    {
+    }
+}
+
+RtosBenchmark benchmark(100);
+
+// ----------------------------------------------------------------------------
+rtems_task
+task_system_init(rtems_task_argument /*ignored*/)
+{
+    // The timer server must be started before the first timer is used,
+    // its priority above the benchmark keeps the timer jitter low
+    outpost::rtos::Timer::startTimerDaemonThread(200);
+
+    benchmark.start();
+    benchmark.waitForCompletion();
+
+    rtems_task_delete(RTEMS_SELF);
+}
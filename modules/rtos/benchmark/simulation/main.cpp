@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <stdlib.h>
+
+#include "../reference/rtos_benchmark.h"
+
+// All times are virtual and only advance if every thread is blocked, so
+// every measurement must result in zero. Other values show an error of
+// the simulation backend.
+RtosBenchmark benchmark(100);
+
+int
+main(void)
+{
+    benchmark.start();
+    benchmark.waitForCompletion();
+
+    // outpost Threads cannot end
+    exit(0);
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos.h>
+#include <outpost/rtos/executor.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static constexpr uint32_t numberOfBlocks = 64;
+static constexpr uint32_t numberOfSubBlocks = 4;
+
+/**
+ * Processes blocks in parallel, every block spawns further tasks from
+ * within the executor.
+ */
+class BlockProcessor : public outpost::Callable
+{
+public:
+    explicit BlockProcessor(outpost::rtos::ExecutorBase& executor) :
+        mExecutor(executor), mGroup(), mRejected(0)
+    {
+        for (uint32_t i = 0; i < numberOfBlocks * numberOfSubBlocks; ++i)
+        {
+            mProcessed[i].store(0);
+        }
+    }
+
+    void
+    processBlock(uint32_t block)
+    {
+        for (uint32_t i = 0; i < numberOfSubBlocks; ++i)
+        {
+            outpost::rtos::Task task(
+                    this, &BlockProcessor::processSubBlock, block * numberOfSubBlocks + i);
+            if (!mExecutor.submit(task, mGroup))
+            {
+                mRejected.fetchAdd(1);
+                task.execute();
+            }
+        }
+    }
+
+    void
+    processSubBlock(uint32_t index)
+    {
+        // Some work to keep the workers busy
+        volatile uint32_t value = index;
+        for (uint32_t i = 0; i < 10000; ++i)
+        {
+            value = value * 1103515245U + 12345U;
+        }
+        mProcessed[index].fetchAdd(1);
+    }
+
+    outpost::rtos::ExecutorBase& mExecutor;
+    outpost::rtos::TaskGroup mGroup;
+    outpost::rtos::Atomic<uint32_t> mProcessed[numberOfBlocks * numberOfSubBlocks];
+    outpost::rtos::Atomic<uint32_t> mRejected;
+};
+
+outpost::rtos::Executor<4, 16> executor(100);
+BlockProcessor processor(executor);
+
+int
+main(void)
+{
+    executor.start();
+
+    for (uint32_t round = 0; round < 10; ++round)
+    {
+        for (uint32_t i = 0; i < numberOfBlocks; ++i)
+        {
+            outpost::rtos::Task task(&processor, &BlockProcessor::processBlock, i);
+            if (!executor.submit(task, processor.mGroup))
+            {
+                processor.mRejected.fetchAdd(1);
+                task.execute();
+            }
+        }
+        processor.mGroup.wait();
+
+        for (uint32_t i = 0; i < numberOfBlocks * numberOfSubBlocks; ++i)
+        {
+            if (processor.mProcessed[i].load() != round + 1)
+            {
+                printf("Sub-block %u processed %u times in round %u\n",
+                       static_cast<unsigned int>(i),
+                       static_cast<unsigned int>(processor.mProcessed[i].load()),
+                       static_cast<unsigned int>(round));
+                exit(1);
+            }
+        }
+        printf("Round %u done, %u tasks executed by the submitter\n",
+               static_cast<unsigned int>(round),
+               static_cast<unsigned int>(processor.mRejected.load()));
+    }
+
+    printf("Done\n");
+
+    // outpost Threads cannot end
+    exit(0);
+
+    // prevents warning
+    return 0;
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <outpost/rtos/clock.h>
+
+#include "../reference/consumer.h"
+#include "../reference/producer.h"
+
+outpost::rtos::Queue<uint32_t> queue(10);
+
+Producer producer(queue);
+Consumer consumer(queue);
+
+int
+main(void)
+{
+    outpost::rtos::SystemClock clock;
+
+    producer.start();
+    consumer.start();
+
+    // The producer sends a value every 500 ms of virtual time, the
+    // program finishes without any real delay
+    for (uint32_t i = 0; i < 7200; ++i)
+    {
+        consumer.waitForNewValue();
+    }
+
+    uint32_t value = consumer.getCurrentValue();
+    int64_t seconds = clock.now().timeSinceEpoch().seconds();
+    printf("value: %i after %lli s\n", static_cast<int>(value), static_cast<long long>(seconds));
+
+    // outpost Threads cannot end
+    exit((value == 7199) && (seconds == 3600) ? 0 : 1);
+}
@@ -31,9 +31,9 @@ void
 Checkpoint::resume()
 {
     mMutex.acquire();
-    if (mState != running)
+    if (mState.load() != running)
     {
-        mState = running;
+        mState.store(running);
         mSemaphore.release();
     }
     mMutex.release();
@@ -43,9 +43,9 @@ void
 Checkpoint::suspend()
 {
     mMutex.acquire();
-    if (mState == running)
+    if (mState.load() == running)
     {
-        mState = suspending;
+        mState.store(suspending);
         mSemaphore.acquire();
     }
     mMutex.release();
@@ -54,32 +54,36 @@ Checkpoint::suspend()
 Checkpoint::State
 Checkpoint::getState() const
 {
-    MutexGuard lock(mMutex);
-    return mState;
+    return static_cast<State>(mState.load());
 }
 
 bool
 Checkpoint::shouldSuspend() const
 {
-    MutexGuard lock(mMutex);
-    return (mState == suspending);
+    return (mState.load() == suspending);
 }
 
 void
 Checkpoint::pass()
 {
+    // Fast path, no state change is requested
+    if (mState.load() == running)
+    {
+        return;
+    }
+
     bool waiting = true;
     do
     {
         mMutex.acquire();
-        if (mState == running)
+        if (mState.load() == running)
         {
             mMutex.release();
             waiting = false;
         }
         else
         {
-            mState = suspended;
+            mState.store(suspended);
             mMutex.release();
 
             mSemaphore.acquire();
@@ -14,10 +14,13 @@
 #ifndef OUTPOST_RTOS_CHECKPOINT_H
 #define OUTPOST_RTOS_CHECKPOINT_H
 
+#include <outpost/rtos/atomic.h>
 #include <outpost/rtos/mutex.h>
 #include <outpost/rtos/mutex_guard.h>
 #include <outpost/rtos/semaphore.h>
 
+#include <stdint.h>
+
 namespace outpost
 {
 namespace rtos
@@ -33,6 +36,10 @@ namespace rtos
  * use of this checkpoint class allows to properly release resources before
  * suspending the thread.
  *
+ * Passing a running checkpoint only reads the atomic state, the mutex and
+ * the semaphore are only used when the state changes. pass() can therefore
+ * be called in every iteration of a worker loop.
+ *
  * \author  Fabian Greif
  */
 class Checkpoint
@@ -96,9 +103,10 @@ public:
     pass();
 
 private:
-    mutable Mutex mMutex;
+    /// Serializes the state changes, not needed for reading the state
+    Mutex mMutex;
     BinarySemaphore mSemaphore;
-    State mState;
+    Atomic<uint32_t> mState;
 };
 
 }  // namespace rtos
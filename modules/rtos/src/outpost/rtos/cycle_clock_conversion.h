@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_CYCLE_CLOCK_CONVERSION_H
+#define OUTPOST_RTOS_CYCLE_CLOCK_CONVERSION_H
+
+#include <outpost/time/duration.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Convert a number of counter ticks to a duration.
+ *
+ * Splits the ticks into full seconds and a remainder so that the
+ * multiplication can not overflow for any 64 bit tick count.
+ *
+ * \param ticks
+ *      Number of counter ticks.
+ * \param frequency
+ *      Counter frequency in Hz, must not be zero.
+ */
+inline time::Duration
+convertTicksToDuration(uint64_t ticks, uint64_t frequency)
+{
+    constexpr uint64_t microsecondsPerSecond =
+            time::Duration::microsecondsPerMillisecond * time::Duration::millisecondsPerSecond;
+
+    const uint64_t seconds = ticks / frequency;
+    const uint64_t remainder = ticks - seconds * frequency;
+    return time::Microseconds(seconds * microsecondsPerSecond
+                              + (remainder * microsecondsPerSecond) / frequency);
+}
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
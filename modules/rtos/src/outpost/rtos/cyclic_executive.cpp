@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "cyclic_executive.h"
+
+#include <outpost/rtos/failure_handler.h>
+#include <outpost/rtos/mutex_guard.h>
+#include <outpost/rtos/periodic_task_manager.h>
+
+using outpost::rtos::CyclicExecutiveBase;
+using outpost::rtos::ScheduleSlotStatistics;
+using outpost::rtos::internal::CyclicExecutiveThread;
+using outpost::time::Duration;
+using outpost::time::SpacecraftElapsedTime;
+
+// ----------------------------------------------------------------------------
+CyclicExecutiveThread::CyclicExecutiveThread(CyclicExecutiveBase& executive,
+                                             uint8_t priority,
+                                             size_t stackSize,
+                                             const char* name) :
+    Thread(priority, stackSize, name),
+    mExecutive(executive)
+{
+}
+
+void
+CyclicExecutiveThread::run()
+{
+    mExecutive.run();
+}
+
+// ----------------------------------------------------------------------------
+CyclicExecutiveBase::CyclicExecutiveBase(const time::Clock& clock,
+                                         time::Duration minorFrame,
+                                         uint16_t minorFramesPerMajorFrame,
+                                         outpost::Slice<const ScheduleSlot> table,
+                                         outpost::Slice<ScheduleSlotStatistics> statistics,
+                                         uint8_t priority,
+                                         size_t stackSize,
+                                         const char* name) :
+    mClock(clock),
+    mMinorFrameDuration(minorFrame),
+    mMinorFramesPerMajorFrame(minorFramesPerMajorFrame),
+    mTable(table),
+    mStatistics(statistics),
+    mListener(nullptr),
+    mMutex(),
+    mMinorFrame(0),
+    mNumberOfMajorFrames(0),
+    mNumberOfFrameOverruns(0),
+    mNumberOfSkippedFrames(0),
+    mThread(*this, priority, stackSize, name)
+{
+}
+
+bool
+CyclicExecutiveBase::isValid() const
+{
+    if ((mMinorFramesPerMajorFrame == 0) || (mMinorFrameDuration <= Duration::zero()))
+    {
+        return false;
+    }
+
+    for (const ScheduleSlot& slot : mTable)
+    {
+        if ((slot.mPeriod == 0) || ((mMinorFramesPerMajorFrame % slot.mPeriod) != 0)
+            || (slot.mOffset >= slot.mPeriod) || (slot.mObject == nullptr))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+CyclicExecutiveBase::start()
+{
+    if (!isValid())
+    {
+        FailureHandler::fatal(FailureCode::genericRuntimeError(Resource::periodicTask));
+    }
+    mThread.start();
+}
+
+void
+CyclicExecutiveBase::executeMinorFrame()
+{
+    const uint32_t minorFrame = getMinorFrame();
+    const SpacecraftElapsedTime frameStart = mClock.now();
+
+    SpacecraftElapsedTime slotStart = frameStart;
+    for (size_t i = 0; i < mTable.getNumberOfElements(); ++i)
+    {
+        const ScheduleSlot& slot = mTable[i];
+        if (slot.isScheduledIn(minorFrame))
+        {
+            (slot.mObject->*(slot.mFunction))();
+
+            const SpacecraftElapsedTime slotEnd = mClock.now();
+            const Duration executionTime = slotEnd - slotStart;
+            slotStart = slotEnd;
+
+            const bool overrun = (executionTime > slot.mBudget);
+            {
+                MutexGuard lock(mMutex);
+                ScheduleSlotStatistics& statistics = mStatistics[i];
+                statistics.mNumberOfExecutions++;
+                if (executionTime > statistics.mMaxExecutionTime)
+                {
+                    statistics.mMaxExecutionTime = executionTime;
+                }
+                if (overrun)
+                {
+                    statistics.mNumberOfOverruns++;
+                }
+            }
+            if (overrun && (mListener != nullptr))
+            {
+                mListener->onSlotOverrun(i, executionTime);
+            }
+        }
+    }
+
+    const Duration frameTime = slotStart - frameStart;
+    const bool overrun = (frameTime > mMinorFrameDuration);
+    {
+        MutexGuard lock(mMutex);
+        if (overrun)
+        {
+            mNumberOfFrameOverruns++;
+        }
+        advanceFrames(1);
+    }
+    if (overrun && (mListener != nullptr))
+    {
+        mListener->onFrameOverrun(minorFrame, frameTime);
+    }
+}
+
+uint32_t
+CyclicExecutiveBase::getMinorFrame() const
+{
+    MutexGuard lock(mMutex);
+    return mMinorFrame;
+}
+
+uint32_t
+CyclicExecutiveBase::getNumberOfMajorFrames() const
+{
+    MutexGuard lock(mMutex);
+    return mNumberOfMajorFrames;
+}
+
+uint32_t
+CyclicExecutiveBase::getNumberOfFrameOverruns() const
+{
+    MutexGuard lock(mMutex);
+    return mNumberOfFrameOverruns;
+}
+
+uint32_t
+CyclicExecutiveBase::getNumberOfSkippedFrames() const
+{
+    MutexGuard lock(mMutex);
+    return mNumberOfSkippedFrames;
+}
+
+ScheduleSlotStatistics
+CyclicExecutiveBase::getSlotStatistics(size_t index) const
+{
+    MutexGuard lock(mMutex);
+    ScheduleSlotStatistics statistics;
+    if (index < mStatistics.getNumberOfElements())
+    {
+        statistics = mStatistics[index];
+    }
+    return statistics;
+}
+
+void
+CyclicExecutiveBase::resetStatistics()
+{
+    MutexGuard lock(mMutex);
+    for (ScheduleSlotStatistics& statistics : mStatistics)
+    {
+        statistics = ScheduleSlotStatistics();
+    }
+    mNumberOfFrameOverruns = 0;
+    mNumberOfSkippedFrames = 0;
+}
+
+void
+CyclicExecutiveBase::run()
+{
+    // Skipping keeps the minor frames aligned to the start of the executive
+    PeriodicTaskManager manager(PeriodicTaskManager::OverrunPolicy::skip);
+    uint32_t skipped = 0;
+    while (true)
+    {
+        if (manager.nextPeriod(mMinorFrameDuration) == PeriodicTaskManager::Status::timeout)
+        {
+            const uint32_t total = manager.getStatistics().getNumberOfSkippedPeriods();
+            {
+                MutexGuard lock(mMutex);
+                advanceFrames(total - skipped);
+                mNumberOfSkippedFrames += (total - skipped);
+            }
+            skipped = total;
+        }
+        executeMinorFrame();
+    }
+}
+
+void
+CyclicExecutiveBase::advanceFrames(uint32_t frames)
+{
+    for (uint32_t i = 0; i < frames; ++i)
+    {
+        mMinorFrame++;
+        if (mMinorFrame >= mMinorFramesPerMajorFrame)
+        {
+            mMinorFrame = 0;
+            mNumberOfMajorFrames++;
+        }
+    }
+}
@@ -0,0 +1,377 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_CYCLIC_EXECUTIVE_H
+#define OUTPOST_RTOS_CYCLIC_EXECUTIVE_H
+
+#include <outpost/base/callable.h>
+#include <outpost/base/slice.h>
+#include <outpost/rtos/mutex.h>
+#include <outpost/rtos/thread.h>
+#include <outpost/time/clock.h>
+#include <outpost/time/duration.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+class CyclicExecutiveBase;
+
+/**
+ * Entry of the schedule table of a CyclicExecutive.
+ *
+ * The function is executed in every minor frame \c n of the major frame
+ * with <tt>n % period == offset</tt>.
+ *
+ * \ingroup    rtos
+ */
+class ScheduleSlot
+{
+public:
+    typedef void (Callable::*Function)();
+
+    template <typename T>
+    struct SlotFunction
+    {
+        typedef void (T::*type)();
+    };
+
+    /**
+     * \param object
+     *         Instance to which the function belongs. Must be sub-class
+     *         of outpost::Callable.
+     * \param function
+     *         Member function of \p object to execute.
+     * \param period
+     *         Number of minor frames between two executions, must divide
+     *         the number of minor frames of the major frame.
+     * \param offset
+     *         Minor frame of the first execution, smaller than \p period.
+     * \param budget
+     *         Maximum execution time, exceeding it is reported as an
+     *         overrun.
+     */
+    template <typename T>
+    inline ScheduleSlot(T* object,
+                        typename SlotFunction<T>::type function,
+                        uint16_t period,
+                        uint16_t offset,
+                        time::Duration budget) :
+        mObject(reinterpret_cast<Callable*>(object)),
+        mFunction(reinterpret_cast<Function>(function)),
+        mPeriod(period),
+        mOffset(offset),
+        mBudget(budget)
+    {
+    }
+
+    inline bool
+    isScheduledIn(uint32_t minorFrame) const
+    {
+        return (minorFrame % mPeriod) == mOffset;
+    }
+
+private:
+    friend class CyclicExecutiveBase;
+
+    Callable* mObject;
+    Function mFunction;
+    uint16_t mPeriod;
+    uint16_t mOffset;
+    time::Duration mBudget;
+};
+
+/**
+ * Execution statistics of a single slot.
+ *
+ * \ingroup    rtos
+ */
+struct ScheduleSlotStatistics
+{
+    ScheduleSlotStatistics() :
+        mNumberOfExecutions(0),
+        mNumberOfOverruns(0),
+        mMaxExecutionTime(time::Duration::zero())
+    {
+    }
+
+    uint32_t mNumberOfExecutions;
+
+    /// Number of executions exceeding the budget of the slot
+    uint32_t mNumberOfOverruns;
+    time::Duration mMaxExecutionTime;
+};
+
+/**
+ * Receives the overruns of a CyclicExecutive.
+ *
+ * Called from the thread of the executive, the functions must be short.
+ *
+ * \ingroup    rtos
+ */
+class CyclicExecutiveListener
+{
+public:
+    virtual ~CyclicExecutiveListener() = default;
+
+    /**
+     * A slot has exceeded its budget.
+     *
+     * \param index
+     *      Index of the slot in the schedule table.
+     */
+    virtual void
+    onSlotOverrun(size_t index, time::Duration executionTime) = 0;
+
+    /**
+     * The slots of a minor frame took longer than the minor frame.
+     */
+    virtual void
+    onFrameOverrun(uint32_t minorFrame, time::Duration executionTime) = 0;
+};
+
+namespace internal
+{
+/**
+ * Thread of a CyclicExecutive.
+ */
+class CyclicExecutiveThread : public Thread
+{
+public:
+    CyclicExecutiveThread(CyclicExecutiveBase& executive,
+                          uint8_t priority,
+                          size_t stackSize,
+                          const char* name);
+
+protected:
+    virtual void
+    run() override;
+
+private:
+    CyclicExecutiveBase& mExecutive;
+};
+}  // namespace internal
+
+/**
+ * Non-template part of the CyclicExecutive.
+ *
+ * \ingroup    rtos
+ */
+class CyclicExecutiveBase
+{
+public:
+    // disable copy constructor
+    CyclicExecutiveBase(const CyclicExecutiveBase& other) = delete;
+
+    // disable assignment operator
+    CyclicExecutiveBase&
+    operator=(const CyclicExecutiveBase& other) = delete;
+
+    /**
+     * Check the periods and offsets of the schedule table.
+     */
+    bool
+    isValid() const;
+
+    /**
+     * Start the thread of the executive.
+     *
+     * Calls the FailureHandler if the schedule table is invalid.
+     */
+    void
+    start();
+
+    /**
+     * Execute the slots of the current minor frame and advance to the
+     * next one.
+     *
+     * Called by the thread of the executive. Can be called directly
+     * instead of start(), e.g. from the loop of an existing thread.
+     */
+    void
+    executeMinorFrame();
+
+    /**
+     * Set the receiver of the overruns, must be called before start().
+     */
+    inline void
+    setListener(CyclicExecutiveListener* listener)
+    {
+        mListener = listener;
+    }
+
+    /**
+     * Index of the next minor frame in the major frame.
+     */
+    uint32_t
+    getMinorFrame() const;
+
+    inline time::Duration
+    getMinorFrameDuration() const
+    {
+        return mMinorFrameDuration;
+    }
+
+    uint32_t
+    getNumberOfMajorFrames() const;
+
+    /**
+     * Number of minor frames which took longer than the minor frame.
+     */
+    uint32_t
+    getNumberOfFrameOverruns() const;
+
+    /**
+     * Number of minor frames which have not been executed because of an
+     * overrun.
+     */
+    uint32_t
+    getNumberOfSkippedFrames() const;
+
+    ScheduleSlotStatistics
+    getSlotStatistics(size_t index) const;
+
+    void
+    resetStatistics();
+
+protected:
+    CyclicExecutiveBase(const time::Clock& clock,
+                        time::Duration minorFrame,
+                        uint16_t minorFramesPerMajorFrame,
+                        outpost::Slice<const ScheduleSlot> table,
+                        outpost::Slice<ScheduleSlotStatistics> statistics,
+                        uint8_t priority,
+                        size_t stackSize,
+                        const char* name);
+
+    ~CyclicExecutiveBase() = default;
+
+private:
+    friend class internal::CyclicExecutiveThread;
+
+    void
+    run();
+
+    /// Advance the minor frame counter, the mutex must be held
+    void
+    advanceFrames(uint32_t frames);
+
+    const time::Clock& mClock;
+    const time::Duration mMinorFrameDuration;
+    const uint16_t mMinorFramesPerMajorFrame;
+    const outpost::Slice<const ScheduleSlot> mTable;
+    const outpost::Slice<ScheduleSlotStatistics> mStatistics;
+
+    CyclicExecutiveListener* mListener;
+
+    /// Protects the frame counters and the statistics
+    mutable Mutex mMutex;
+
+    uint32_t mMinorFrame;
+    uint32_t mNumberOfMajorFrames;
+    uint32_t mNumberOfFrameOverruns;
+    uint32_t mNumberOfSkippedFrames;
+
+    // Declared last so that the thread is destroyed first
+    internal::CyclicExecutiveThread mThread;
+};
+
+namespace internal
+{
+/**
+ * Memory of a CyclicExecutive.
+ *
+ * Base class of CyclicExecutive so that it is constructed before
+ * CyclicExecutiveBase refers to it.
+ */
+template <size_t numberOfSlots>
+class CyclicExecutiveStorage
+{
+protected:
+    ScheduleSlotStatistics mStatisticsStorage[numberOfSlots];
+};
+}  // namespace internal
+
+/**
+ * Time-triggered cyclic executive.
+ *
+ * Executes a fixed schedule table of functions with different rates in a
+ * single thread, instead of a thread with a PeriodicTaskManager per rate.
+ * The thread wakes up once per minor frame and executes the slots
+ * scheduled in it in the order of the table. The major frame repeats
+ * the minor frames.
+ *
+ * \code
+ * // Minor frame of 62.5 ms (16 Hz), major frame of 16 minor frames (1 s)
+ * const outpost::rtos::ScheduleSlot table[] = {
+ *     {&attitude, &Attitude::control, 1, 0, Milliseconds(10)},      // 16 Hz
+ *     {&sensors, &Sensors::sample, 2, 1, Milliseconds(5)},          //  8 Hz
+ *     {&thermal, &Thermal::control, 8, 3, Milliseconds(5)},         //  2 Hz
+ *     {&housekeeping, &Hk::collect, 16, 5, Milliseconds(20)},       //  1 Hz
+ * };
+ *
+ * outpost::rtos::CyclicExecutive<4> executive(
+ *         clock, Microseconds(62500), 16, table, 250);
+ * executive.start();
+ * \endcode
+ *
+ * Slots are not preempted, the execution time of every slot is checked
+ * against its budget after it has returned. Overruns are counted and
+ * reported to the listener. If a minor frame takes so long that later
+ * minor frames have already ended, these are skipped so that the
+ * schedule keeps its phase.
+ *
+ * \tparam numberOfSlots
+ *      Number of entries of the schedule table.
+ *
+ * \ingroup    rtos
+ */
+template <size_t numberOfSlots>
+class CyclicExecutive : private internal::CyclicExecutiveStorage<numberOfSlots>,
+                        public CyclicExecutiveBase
+{
+public:
+    /**
+     * \param clock
+     *      Clock for measuring the execution times.
+     * \param minorFrame
+     *      Duration of a minor frame.
+     * \param minorFramesPerMajorFrame
+     *      Number of minor frames of the major frame.
+     * \param table
+     *      Schedule table, must outlive the executive.
+     */
+    CyclicExecutive(const time::Clock& clock,
+                    time::Duration minorFrame,
+                    uint16_t minorFramesPerMajorFrame,
+                    const ScheduleSlot (&table)[numberOfSlots],
+                    uint8_t priority,
+                    size_t stackSize = Thread::defaultStackSize,
+                    const char* name = "CYCL") :
+        internal::CyclicExecutiveStorage<numberOfSlots>(),
+        CyclicExecutiveBase(clock,
+                            minorFrame,
+                            minorFramesPerMajorFrame,
+                            outpost::asSlice(table),
+                            outpost::asSlice(this->mStatisticsStorage),
+                            priority,
+                            stackSize,
+                            name)
+    {
+    }
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "deadline_scheduler.h"
+
+#include <outpost/rtos/mutex_guard.h>
+
+using outpost::rtos::Deadline;
+using outpost::rtos::DeadlineScheduler;
+using outpost::rtos::internal::DeadlineSchedulerThread;
+
+Deadline::Deadline() :
+    mTime(),
+    mNext(nullptr),
+    mScheduled(false),
+    mExpired(0),
+    mSignal(BinarySemaphore::State::acquired)
+{
+}
+
+bool
+Deadline::wait(time::Duration timeout)
+{
+    return mSignal.acquire(timeout);
+}
+
+bool
+Deadline::isExpired() const
+{
+    return (mExpired.load() != 0);
+}
+
+// ----------------------------------------------------------------------------
+DeadlineSchedulerThread::DeadlineSchedulerThread(DeadlineScheduler& scheduler,
+                                                 uint8_t priority,
+                                                 size_t stackSize,
+                                                 const char* name) :
+    Thread(priority, stackSize, name),
+    mScheduler(scheduler)
+{
+}
+
+void
+DeadlineSchedulerThread::run()
+{
+    mScheduler.run();
+}
+
+// ----------------------------------------------------------------------------
+DeadlineScheduler::DeadlineScheduler(const time::Clock& clock,
+                                     time::Duration coalescingWindow,
+                                     uint8_t priority,
+                                     size_t stackSize,
+                                     const char* name) :
+    mClock(clock),
+    mCoalescingWindow(coalescingWindow),
+    mMutex(),
+    mHead(nullptr),
+    mNumberOfWakeups(0),
+    mWakeup(BinarySemaphore::State::acquired),
+    mThread(*this, priority, stackSize, name)
+{
+}
+
+void
+DeadlineScheduler::start()
+{
+    mThread.start();
+}
+
+void
+DeadlineScheduler::schedule(Deadline& deadline, time::SpacecraftElapsedTime time)
+{
+    MutexGuard lock(mMutex);
+    if (deadline.mScheduled)
+    {
+        remove(deadline);
+    }
+
+    // Discard a signal of the previous time
+    deadline.mSignal.acquire(time::Duration::zero());
+    deadline.mExpired.store(0);
+    deadline.mTime = time;
+    deadline.mScheduled = true;
+
+    // Insert behind all deadlines with the same or an earlier time
+    Deadline** position = &mHead;
+    while ((*position != nullptr) && ((*position)->mTime <= time))
+    {
+        position = &(*position)->mNext;
+    }
+    deadline.mNext = *position;
+    *position = &deadline;
+
+    if (mHead == &deadline)
+    {
+        mWakeup.release();
+    }
+}
+
+void
+DeadlineScheduler::scheduleAfter(Deadline& deadline, time::Duration duration)
+{
+    schedule(deadline, mClock.now() + duration);
+}
+
+void
+DeadlineScheduler::cancel(Deadline& deadline)
+{
+    MutexGuard lock(mMutex);
+    if (deadline.mScheduled)
+    {
+        remove(deadline);
+    }
+}
+
+uint32_t
+DeadlineScheduler::getNumberOfWakeups() const
+{
+    MutexGuard lock(mMutex);
+    return mNumberOfWakeups;
+}
+
+void
+DeadlineScheduler::remove(Deadline& deadline)
+{
+    Deadline** position = &mHead;
+    while (*position != &deadline)
+    {
+        position = &(*position)->mNext;
+    }
+    *position = deadline.mNext;
+    deadline.mNext = nullptr;
+    deadline.mScheduled = false;
+}
+
+void
+DeadlineScheduler::run()
+{
+    while (true)
+    {
+        time::Duration sleep = time::Duration::infinity();
+        {
+            MutexGuard lock(mMutex);
+            const time::SpacecraftElapsedTime now = mClock.now();
+            if ((mHead != nullptr) && (mHead->mTime <= now))
+            {
+                mNumberOfWakeups++;
+                while ((mHead != nullptr) && (mHead->mTime <= now))
+                {
+                    Deadline& deadline = *mHead;
+                    mHead = deadline.mNext;
+                    deadline.mNext = nullptr;
+                    deadline.mScheduled = false;
+                    deadline.mExpired.store(1);
+                    deadline.mSignal.release();
+                }
+            }
+
+            if (mHead != nullptr)
+            {
+                // Wait for the end of the window of the earliest deadline
+                // to handle all deadlines within the window together
+                sleep = (mHead->mTime - now) + mCoalescingWindow;
+            }
+        }
+        mWakeup.acquire(sleep);
+    }
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_DEADLINE_SCHEDULER_H
+#define OUTPOST_RTOS_DEADLINE_SCHEDULER_H
+
+#include <outpost/rtos/atomic.h>
+#include <outpost/rtos/mutex.h>
+#include <outpost/rtos/semaphore.h>
+#include <outpost/rtos/thread.h>
+#include <outpost/time/clock.h>
+#include <outpost/time/duration.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+class DeadlineScheduler;
+
+/**
+ * Deadline of a single owner, registered with a DeadlineScheduler.
+ *
+ * Provided by the owner, the scheduler does not allocate memory. Must
+ * not be destroyed while it is scheduled.
+ *
+ * \ingroup    rtos
+ */
+class Deadline
+{
+public:
+    Deadline();
+
+    // disable copy constructor
+    Deadline(const Deadline& other) = delete;
+
+    // disable assignment operator
+    Deadline&
+    operator=(const Deadline& other) = delete;
+
+    /**
+     * Block until the deadline has passed.
+     *
+     * \retval true    Deadline has passed.
+     * \retval false   Timeout occurred or the deadline was cancelled.
+     */
+    bool
+    wait(time::Duration timeout = time::Duration::infinity());
+
+    /**
+     * Check whether the deadline has passed since it was scheduled.
+     *
+     * Does not block, a following wait() returns immediately.
+     */
+    bool
+    isExpired() const;
+
+    inline time::SpacecraftElapsedTime
+    getTime() const
+    {
+        return mTime;
+    }
+
+private:
+    friend class DeadlineScheduler;
+
+    time::SpacecraftElapsedTime mTime;
+
+    /// Next later deadline
+    Deadline* mNext;
+    bool mScheduled;
+    Atomic<uint32_t> mExpired;
+
+    BinarySemaphore mSignal;
+};
+
+namespace internal
+{
+class DeadlineSchedulerThread : public Thread
+{
+public:
+    DeadlineSchedulerThread(DeadlineScheduler& scheduler,
+                            uint8_t priority,
+                            size_t stackSize,
+                            const char* name);
+
+protected:
+    virtual void
+    run() override;
+
+private:
+    DeadlineScheduler& mScheduler;
+};
+}  // namespace internal
+
+/**
+ * Central timer for many deadlines.
+ *
+ * Instead of waking up periodically to poll a time::Timeout, owners
+ * register a Deadline and are woken by the scheduler thread when it has
+ * passed. The scheduler thread only wakes for the earliest deadline.
+ *
+ * Deadlines are coalesced: a deadline may be signalled up to the
+ * coalescing window late, so that all deadlines within the window after
+ * the earliest one are handled by a single wakeup. Deadlines are never
+ * signalled early.
+ *
+ * \code
+ * outpost::rtos::DeadlineScheduler scheduler(clock, Milliseconds(10), priority);
+ * scheduler.start();
+ *
+ * // in the owner thread
+ * scheduler.scheduleAfter(mDeadline, Seconds(1));
+ * mDeadline.wait();
+ * \endcode
+ *
+ * Deadlines are kept in an intrusive list sorted by time, scheduling is
+ * linear in the number of pending deadlines.
+ *
+ * \ingroup    rtos
+ */
+class DeadlineScheduler
+{
+public:
+    /**
+     * \param clock
+     *      Clock for the deadlines.
+     * \param coalescingWindow
+     *      Maximum delay of a deadline to share a wakeup with an earlier
+     *      deadline. Zero disables coalescing.
+     */
+    DeadlineScheduler(const time::Clock& clock,
+                      time::Duration coalescingWindow,
+                      uint8_t priority,
+                      size_t stackSize = Thread::defaultStackSize,
+                      const char* name = "DEAD");
+
+    // disable copy constructor
+    DeadlineScheduler(const DeadlineScheduler& other) = delete;
+
+    // disable assignment operator
+    DeadlineScheduler&
+    operator=(const DeadlineScheduler& other) = delete;
+
+    /**
+     * Start the scheduler thread.
+     */
+    void
+    start();
+
+    /**
+     * Schedule a deadline at an absolute time.
+     *
+     * A deadline which is already scheduled is moved to the new time.
+     */
+    void
+    schedule(Deadline& deadline, time::SpacecraftElapsedTime time);
+
+    /**
+     * Schedule a deadline relative to the current time.
+     */
+    void
+    scheduleAfter(Deadline& deadline, time::Duration duration);
+
+    /**
+     * Remove a deadline without signalling it.
+     */
+    void
+    cancel(Deadline& deadline);
+
+    /**
+     * Number of times the scheduler thread has woken up and signalled
+     * deadlines.
+     */
+    uint32_t
+    getNumberOfWakeups() const;
+
+private:
+    friend class internal::DeadlineSchedulerThread;
+
+    void
+    run();
+
+    /// Remove a deadline from the list, the mutex must be held
+    void
+    remove(Deadline& deadline);
+
+    const time::Clock& mClock;
+    const time::Duration mCoalescingWindow;
+
+    mutable Mutex mMutex;
+
+    /// Earliest deadline
+    Deadline* mHead;
+    uint32_t mNumberOfWakeups;
+
+    /// Released when the earliest deadline changes
+    BinarySemaphore mWakeup;
+
+    // Declared last so that the thread is destroyed first
+    internal::DeadlineSchedulerThread mThread;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
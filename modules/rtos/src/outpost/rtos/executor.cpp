@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "executor.h"
+
+#include <outpost/rtos/mutex_guard.h>
+
+using outpost::rtos::ExecutorBase;
+using outpost::rtos::Task;
+using outpost::rtos::TaskGroup;
+using outpost::rtos::internal::ExecutorWorker;
+using outpost::rtos::internal::TaskDeque;
+
+// ----------------------------------------------------------------------------
+TaskGroup::TaskGroup() : mPending(1), mFinished(BinarySemaphore::State::acquired)
+{
+}
+
+void
+TaskGroup::wait()
+{
+    // Drop the reference of the group, if tasks are left the last one
+    // releases the semaphore
+    if (mPending.fetchSub(1) != 1)
+    {
+        mFinished.acquire();
+    }
+
+    // No task accesses the group any more, take the reference again so
+    // that the group can be reused
+    mPending.fetchAdd(1);
+}
+
+void
+TaskGroup::finish()
+{
+    if (mPending.fetchSub(1) == 1)
+    {
+        // Last access to the group, the waiter may destroy it afterwards
+        mFinished.release();
+    }
+}
+
+// ----------------------------------------------------------------------------
+TaskDeque::TaskDeque(Task* storage, size_t capacity) :
+    mMutex(), mTasks(storage), mCapacity(capacity), mHead(0), mCount(0)
+{
+}
+
+bool
+TaskDeque::pushBack(const Task& task)
+{
+    MutexGuard lock(mMutex);
+    if (mCount == mCapacity)
+    {
+        return false;
+    }
+
+    size_t index = mHead + mCount;
+    if (index >= mCapacity)
+    {
+        index -= mCapacity;
+    }
+    mTasks[index] = task;
+    mCount++;
+    return true;
+}
+
+bool
+TaskDeque::popBack(Task& task)
+{
+    MutexGuard lock(mMutex);
+    if (mCount == 0)
+    {
+        return false;
+    }
+
+    mCount--;
+    size_t index = mHead + mCount;
+    if (index >= mCapacity)
+    {
+        index -= mCapacity;
+    }
+    task = mTasks[index];
+    return true;
+}
+
+bool
+TaskDeque::popFront(Task& task)
+{
+    MutexGuard lock(mMutex);
+    if (mCount == 0)
+    {
+        return false;
+    }
+
+    task = mTasks[mHead];
+    mHead++;
+    if (mHead == mCapacity)
+    {
+        mHead = 0;
+    }
+    mCount--;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+ExecutorWorker::ExecutorWorker(ExecutorBase& executor,
+                               size_t index,
+                               uint8_t priority,
+                               size_t stackSize,
+                               const char* name,
+                               Task* storage,
+                               size_t capacity) :
+    Thread(priority, stackSize, name),
+    mExecutor(executor),
+    mIndex(index),
+    mIdentifier(0),
+    mRunning(0),
+    mDeque(storage, capacity)
+{
+}
+
+void
+ExecutorWorker::run()
+{
+    mIdentifier.store(getCurrentThreadIdentifier());
+    mRunning.store(1);
+
+    mExecutor.runWorker(mIndex);
+}
+
+// ----------------------------------------------------------------------------
+ExecutorBase::ExecutorBase(internal::ExecutorWorker* workers, size_t numberOfWorkers) :
+    mWorkers(workers), mNumberOfWorkers(numberOfWorkers), mAvailableTasks(0), mNextWorker(0)
+{
+}
+
+void
+ExecutorBase::start()
+{
+    for (size_t i = 0; i < mNumberOfWorkers; ++i)
+    {
+        mWorkers[i].start();
+    }
+}
+
+bool
+ExecutorBase::submit(const Task& task)
+{
+    size_t first = getCurrentWorker();
+    if (first == mNumberOfWorkers)
+    {
+        first = mNextWorker.fetchAdd(1) % mNumberOfWorkers;
+    }
+
+    // Fall back to the other workers if the selected deque is full
+    size_t index = first;
+    for (size_t i = 0; i < mNumberOfWorkers; ++i)
+    {
+        if (mWorkers[index].getDeque().pushBack(task))
+        {
+            mAvailableTasks.release();
+            return true;
+        }
+
+        index++;
+        if (index == mNumberOfWorkers)
+        {
+            index = 0;
+        }
+    }
+    return false;
+}
+
+bool
+ExecutorBase::submit(const Task& task, TaskGroup& group)
+{
+    Task groupTask = task;
+    groupTask.mGroup = &group;
+
+    group.add();
+    if (!submit(groupTask))
+    {
+        group.finish();
+        return false;
+    }
+    return true;
+}
+
+void
+ExecutorBase::runWorker(size_t index)
+{
+    while (1)
+    {
+        mAvailableTasks.acquire();
+
+        // For every count of the semaphore a task has been queued. It may
+        // be taken from another deque than the one it was pushed to, but
+        // there is always at least one task for every worker which has
+        // acquired the semaphore.
+        Task task;
+        while (!takeTask(index, task))
+        {
+            // Another worker has taken a task from a deque which was not
+            // scanned yet, the remaining task is in one which was scanned
+            // already. Scan again.
+        }
+
+        task.execute();
+        if (task.mGroup != nullptr)
+        {
+            task.mGroup->finish();
+        }
+    }
+}
+
+bool
+ExecutorBase::takeTask(size_t index, Task& task)
+{
+    // Newest task of the own deque first, it is most likely still in the
+    // cache of the processor
+    if (mWorkers[index].getDeque().popBack(task))
+    {
+        return true;
+    }
+
+    size_t victim = index;
+    for (size_t i = 1; i < mNumberOfWorkers; ++i)
+    {
+        victim++;
+        if (victim == mNumberOfWorkers)
+        {
+            victim = 0;
+        }
+
+        if (mWorkers[victim].getDeque().popFront(task))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t
+ExecutorBase::getCurrentWorker() const
+{
+    const Thread::Identifier identifier = Thread::getCurrentThreadIdentifier();
+    for (size_t i = 0; i < mNumberOfWorkers; ++i)
+    {
+        if (mWorkers[i].isWorkerThread(identifier))
+        {
+            return i;
+        }
+    }
+    return mNumberOfWorkers;
+}
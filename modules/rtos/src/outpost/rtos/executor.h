@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_EXECUTOR_H
+#define OUTPOST_RTOS_EXECUTOR_H
+
+#include <outpost/base/callable.h>
+#include <outpost/rtos/atomic.h>
+#include <outpost/rtos/mutex.h>
+#include <outpost/rtos/semaphore.h>
+#include <outpost/rtos/thread.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <new>
+
+namespace outpost
+{
+namespace rtos
+{
+class ExecutorBase;
+class TaskGroup;
+
+/**
+ * Short job executed by an Executor.
+ *
+ * Binds a member function and an argument, e.g. the index of the block
+ * to process. Tasks are copied into the executor, the object has to
+ * outlive the execution.
+ *
+ * \ingroup    rtos
+ */
+class Task
+{
+public:
+    typedef void (Callable::*Function)(uint32_t argument);
+
+    template <typename T>
+    struct TaskFunction
+    {
+        typedef void (T::*type)(uint32_t argument);
+    };
+
+    inline Task() : mObject(nullptr), mFunction(nullptr), mArgument(0), mGroup(nullptr)
+    {
+    }
+
+    /**
+     * Create a task.
+     *
+     * \param object
+     *         Instance to which the function belongs. Must be sub-class
+     *         of outpost::Callable.
+     * \param function
+     *         Member function of \p object to execute.
+     * \param argument
+     *         Value passed to \p function.
+     */
+    template <typename T>
+    inline Task(T* object, typename TaskFunction<T>::type function, uint32_t argument = 0) :
+        mObject(reinterpret_cast<Callable*>(object)),
+        mFunction(reinterpret_cast<Function>(function)),
+        mArgument(argument),
+        mGroup(nullptr)
+    {
+    }
+
+    inline void
+    execute() const
+    {
+        (mObject->*mFunction)(mArgument);
+    }
+
+private:
+    friend class ExecutorBase;
+
+    Callable* mObject;
+    Function mFunction;
+    uint32_t mArgument;
+
+    /// Group to notify after the execution, set by the executor
+    TaskGroup* mGroup;
+};
+
+/**
+ * Set of tasks which can be waited for.
+ *
+ * \code
+ * outpost::rtos::TaskGroup group;
+ * for (uint32_t block = 0; block < numberOfBlocks; ++block)
+ * {
+ *     executor.submit(Task(&compressor, &Compressor::compressBlock, block), group);
+ * }
+ * group.wait();
+ * \endcode
+ *
+ * \ingroup    rtos
+ */
+class TaskGroup
+{
+public:
+    TaskGroup();
+
+    // disable copy constructor
+    TaskGroup(const TaskGroup& other) = delete;
+
+    // disable assignment operator
+    TaskGroup&
+    operator=(const TaskGroup& other) = delete;
+
+    /**
+     * Block until all tasks submitted with this group have been executed.
+     *
+     * \warning
+     *      Must not be called from a task of the same executor. The worker
+     *      would be blocked and is not available for executing the tasks
+     *      of the group.
+     */
+    void
+    wait();
+
+    /**
+     * Check whether all tasks submitted with this group have been executed.
+     */
+    inline bool
+    isFinished() const
+    {
+        return mPending.load() == 1;
+    }
+
+private:
+    friend class ExecutorBase;
+
+    inline void
+    add()
+    {
+        mPending.fetchAdd(1);
+    }
+
+    void
+    finish();
+
+    /// Number of unfinished tasks plus one for the group itself. Only the
+    /// waiter drops the reference of the group, the semaphore is therefore
+    /// released exactly once per blocking wait() and the release is the
+    /// last access of the task to the group.
+    Atomic<uint32_t> mPending;
+    BinarySemaphore mFinished;
+};
+
+namespace internal
+{
+/**
+ * Fixed size double ended queue of tasks of a single worker.
+ *
+ * The worker takes its tasks from the back, other workers steal from the
+ * front. Every deque is protected by its own mutex, so workers contend
+ * only while stealing.
+ */
+class TaskDeque
+{
+public:
+    TaskDeque(Task* storage, size_t capacity);
+
+    // disable copy constructor
+    TaskDeque(const TaskDeque& other) = delete;
+
+    // disable assignment operator
+    TaskDeque&
+    operator=(const TaskDeque& other) = delete;
+
+    /**
+     * \retval false    Deque is full.
+     */
+    bool
+    pushBack(const Task& task);
+
+    /**
+     * \retval false    Deque is empty.
+     */
+    bool
+    popBack(Task& task);
+
+    /**
+     * \retval false    Deque is empty.
+     */
+    bool
+    popFront(Task& task);
+
+private:
+    Mutex mMutex;
+    Task* const mTasks;
+    const size_t mCapacity;
+
+    /// Index of the first task
+    size_t mHead;
+    size_t mCount;
+};
+
+/**
+ * Worker thread of an Executor.
+ */
+class ExecutorWorker : public Thread
+{
+public:
+    ExecutorWorker(ExecutorBase& executor,
+                   size_t index,
+                   uint8_t priority,
+                   size_t stackSize,
+                   const char* name,
+                   Task* storage,
+                   size_t capacity);
+
+    inline TaskDeque&
+    getDeque()
+    {
+        return mDeque;
+    }
+
+    /**
+     * Check whether the worker runs in the thread with the given identifier.
+     */
+    inline bool
+    isWorkerThread(Identifier identifier) const
+    {
+        return (mRunning.load() != 0) && (mIdentifier.load() == identifier);
+    }
+
+protected:
+    virtual void
+    run() override;
+
+private:
+    ExecutorBase& mExecutor;
+    const size_t mIndex;
+    Atomic<Identifier> mIdentifier;
+
+    /// Set after mIdentifier is valid
+    Atomic<uint32_t> mRunning;
+    TaskDeque mDeque;
+};
+}  // namespace internal
+
+/**
+ * Non-template part of the Executor.
+ *
+ * Tasks are placed in the deque of the calling worker if submitted from
+ * a task, otherwise in the deques of the workers in turn. A counting
+ * semaphore holds the number of queued tasks, idle workers sleep on it.
+ * A woken worker takes the newest task of its own deque or, if empty,
+ * steals the oldest task of another worker.
+ *
+ * \ingroup    rtos
+ */
+class ExecutorBase
+{
+public:
+    // disable copy constructor
+    ExecutorBase(const ExecutorBase& other) = delete;
+
+    // disable assignment operator
+    ExecutorBase&
+    operator=(const ExecutorBase& other) = delete;
+
+    /**
+     * Start the worker threads.
+     */
+    void
+    start();
+
+    /**
+     * Queue a task for execution.
+     *
+     * Never blocks.
+     *
+     * \retval true     Task has been queued.
+     * \retval false    The deques of all workers are full. The caller
+     *                  may execute the task itself.
+     */
+    bool
+    submit(const Task& task);
+
+    /**
+     * Queue a task for execution as part of a group.
+     *
+     * \see submit(const Task&)
+     */
+    bool
+    submit(const Task& task, TaskGroup& group);
+
+    inline size_t
+    getNumberOfWorkers() const
+    {
+        return mNumberOfWorkers;
+    }
+
+protected:
+    ExecutorBase(internal::ExecutorWorker* workers, size_t numberOfWorkers);
+
+    ~ExecutorBase() = default;
+
+private:
+    friend class internal::ExecutorWorker;
+
+    /// Main loop of the worker with the given index
+    void
+    runWorker(size_t index);
+
+    bool
+    takeTask(size_t index, Task& task);
+
+    /// Index of the worker executing the calling thread or
+    /// mNumberOfWorkers if called from another thread
+    size_t
+    getCurrentWorker() const;
+
+    internal::ExecutorWorker* const mWorkers;
+    const size_t mNumberOfWorkers;
+
+    /// Number of tasks in all deques
+    Semaphore mAvailableTasks;
+
+    /// Next worker for tasks submitted from other threads
+    Atomic<uint32_t> mNextWorker;
+};
+
+/**
+ * Statically sized executor with work stealing.
+ *
+ * Executes short tasks (e.g. compressing a single block, decoding a
+ * sector) on a fixed set of worker threads, instead of a dedicated
+ * thread per component. No memory is allocated.
+ *
+ * \code
+ * outpost::rtos::Executor<4, 16> executor(100);
+ * executor.start();
+ * \endcode
+ *
+ * \tparam numberOfWorkers
+ *      Number of worker threads.
+ * \tparam tasksPerWorker
+ *      Capacity of the task deque of each worker.
+ *
+ * \ingroup    rtos
+ */
+template <size_t numberOfWorkers, size_t tasksPerWorker>
+class Executor : public ExecutorBase
+{
+    static_assert(numberOfWorkers > 0, "At least one worker is required");
+    static_assert(tasksPerWorker > 0, "Deque capacity must not be zero");
+
+public:
+    /**
+     * Create the worker threads, they are started by start().
+     *
+     * \param priority
+     *         Priority of all worker threads.
+     * \param stackSize
+     *         Stack size of each worker thread.
+     * \param name
+     *         Name of the worker threads.
+     */
+    explicit Executor(uint8_t priority,
+                      size_t stackSize = Thread::defaultStackSize,
+                      const char* name = "EXEC") :
+        ExecutorBase(reinterpret_cast<internal::ExecutorWorker*>(mWorkerStorage), numberOfWorkers)
+    {
+        for (size_t i = 0; i < numberOfWorkers; ++i)
+        {
+            new (&mWorkerStorage[i]) internal::ExecutorWorker(
+                    *this, i, priority, stackSize, name, mTasks[i], tasksPerWorker);
+        }
+    }
+
+    ~Executor()
+    {
+        for (size_t i = 0; i < numberOfWorkers; ++i)
+        {
+            reinterpret_cast<internal::ExecutorWorker*>(&mWorkerStorage[i])->~ExecutorWorker();
+        }
+    }
+
+private:
+    struct WorkerStorage
+    {
+        alignas(internal::ExecutorWorker) uint8_t data[sizeof(internal::ExecutorWorker)];
+    };
+
+    WorkerStorage mWorkerStorage[numberOfWorkers];
+    Task mTasks[numberOfWorkers][tasksPerWorker];
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
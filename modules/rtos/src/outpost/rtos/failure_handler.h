@@ -42,7 +42,8 @@ struct Resource
         clock = 7,
         periodicTask = 8,
         driverManager = 9,
-        barrier = 10
+        barrier = 10,
+        eventGroup = 11
     };
 };
 
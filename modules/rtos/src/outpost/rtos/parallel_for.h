@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_PARALLEL_FOR_H
+#define OUTPOST_RTOS_PARALLEL_FOR_H
+
+#include <outpost/base/callable.h>
+#include <outpost/rtos/atomic.h>
+#include <outpost/rtos/executor.h>
+#include <outpost/rtos/spin_barrier.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+namespace internal
+{
+/**
+ * State of a single parallelFor() call, lives on the stack of the caller.
+ *
+ * The chunks are claimed with an atomic counter by the caller and by the
+ * helper tasks, it does not matter which of them executes a chunk.
+ */
+template <typename T>
+class ParallelForJob : public Callable
+{
+public:
+    typedef void (T::*Function)(size_t first, size_t last);
+
+    ParallelForJob(T& object,
+                   Function function,
+                   size_t first,
+                   size_t last,
+                   size_t chunkSize) :
+        mObject(object),
+        mFunction(function),
+        mFirst(first),
+        mLast(last),
+        mChunkSize(chunkSize),
+        mNumberOfChunks(static_cast<uint32_t>((last - first + chunkSize - 1) / chunkSize)),
+        mNextChunk(0)
+    {
+    }
+
+    inline uint32_t
+    getNumberOfChunks() const
+    {
+        return mNumberOfChunks;
+    }
+
+    /**
+     * Execute chunks until all have been claimed.
+     */
+    void
+    executeChunks(uint32_t /*argument*/)
+    {
+        uint32_t chunk = mNextChunk.fetchAdd(1);
+        while (chunk < mNumberOfChunks)
+        {
+            const size_t begin = mFirst + chunk * mChunkSize;
+            const size_t remaining = mLast - begin;
+            const size_t end = begin + ((remaining < mChunkSize) ? remaining : mChunkSize);
+            (mObject.*mFunction)(begin, end);
+
+            chunk = mNextChunk.fetchAdd(1);
+        }
+    }
+
+private:
+    T& mObject;
+    const Function mFunction;
+    const size_t mFirst;
+    const size_t mLast;
+    const size_t mChunkSize;
+    const uint32_t mNumberOfChunks;
+    Atomic<uint32_t> mNextChunk;
+};
+}  // namespace internal
+
+/**
+ * Execute \p function for the range [first, last) in parallel.
+ *
+ * The range is split into chunks of at least \p grainSize elements which
+ * are executed by the calling thread and the workers of \p executor. The
+ * function is called with the sub-range of a chunk:
+ *
+ * \code
+ * void
+ * Transform::filterRows(size_t first, size_t last);
+ *
+ * outpost::rtos::parallelFor(executor, 0, rows, transform, &Transform::filterRows, 16);
+ * \endcode
+ *
+ * Returns after all chunks have been executed. The calling thread spins
+ * for a short time on the completion of the last chunks before it blocks.
+ *
+ * \warning
+ *      Must not be called from a task of the same executor, the same as
+ *      TaskGroup::wait().
+ *
+ * \ingroup    rtos
+ */
+template <typename T>
+void
+parallelFor(ExecutorBase& executor,
+            size_t first,
+            size_t last,
+            T& object,
+            typename internal::ParallelForJob<T>::Function function,
+            size_t grainSize = 1)
+{
+    if (last <= first)
+    {
+        return;
+    }
+
+    // One chunk per worker and one for the calling thread
+    const size_t length = last - first;
+    const size_t participants = executor.getNumberOfWorkers() + 1;
+    size_t chunkSize = (length + participants - 1) / participants;
+    if (chunkSize < grainSize)
+    {
+        chunkSize = grainSize;
+    }
+
+    internal::ParallelForJob<T> job(object, function, first, last, chunkSize);
+
+    TaskGroup group;
+    const Task task(&job, &internal::ParallelForJob<T>::executeChunks);
+    for (uint32_t i = 1; i < job.getNumberOfChunks(); ++i)
+    {
+        if (!executor.submit(task, group))
+        {
+            // Deques are full, the remaining chunks are executed by the
+            // calling thread and the helpers which have been submitted
+            break;
+        }
+    }
+    job.executeChunks(0);
+
+    // The other chunks are usually about to finish, spin before blocking
+    for (uint32_t i = 0; (i < SpinBarrier::defaultSpinIterations) && !group.isFinished(); ++i)
+    {
+    }
+    group.wait();
+}
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "periodic_task_statistics.h"
+
+using outpost::rtos::PeriodicTaskStatistics;
+using outpost::time::Duration;
+
+PeriodicTaskStatistics::PeriodicTaskStatistics() :
+    mNumberOfPeriods(0),
+    mNumberOfOverruns(0),
+    mNumberOfSkippedPeriods(0),
+    mMinimumExecutionTime(Duration::zero()),
+    mMaximumExecutionTime(Duration::zero()),
+    mTotalExecutionTime(Duration::zero()),
+    mMaximumJitter(Duration::zero()),
+    mMaximumLateness(Duration::zero())
+{
+}
+
+void
+PeriodicTaskStatistics::reset()
+{
+    *this = PeriodicTaskStatistics();
+}
+
+Duration
+PeriodicTaskStatistics::getAverageExecutionTime() const
+{
+    if (mNumberOfPeriods == 0)
+    {
+        return Duration::zero();
+    }
+    return time::Microseconds(mTotalExecutionTime.microseconds() / mNumberOfPeriods);
+}
+
+void
+PeriodicTaskStatistics::recordStart(Duration jitter)
+{
+    if (jitter > mMaximumJitter)
+    {
+        mMaximumJitter = jitter;
+    }
+}
+
+void
+PeriodicTaskStatistics::recordEnd(Duration executionTime, Duration lateness)
+{
+    if ((mNumberOfPeriods == 0) || (executionTime < mMinimumExecutionTime))
+    {
+        mMinimumExecutionTime = executionTime;
+    }
+    if (executionTime > mMaximumExecutionTime)
+    {
+        mMaximumExecutionTime = executionTime;
+    }
+    mTotalExecutionTime += executionTime;
+    mNumberOfPeriods++;
+
+    if (lateness > Duration::zero())
+    {
+        mNumberOfOverruns++;
+        if (lateness > mMaximumLateness)
+        {
+            mMaximumLateness = lateness;
+        }
+    }
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_PERIODIC_TASK_STATISTICS_H
+#define OUTPOST_RTOS_PERIODIC_TASK_STATISTICS_H
+
+#include <outpost/time/duration.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+class PeriodicTaskManager;
+
+/**
+ * Timing statistics of a PeriodicTaskManager for scheduling analysis.
+ *
+ * A period starts when nextPeriod() returns and its execution ends with
+ * the next call of nextPeriod(). Measured are:
+ *
+ * - Execution time: time between the start of a period and the next call
+ *   of nextPeriod().
+ * - Jitter: delay between the scheduled and the actual start of a period.
+ * - Lateness: time by which the end of a period was missed (overrun).
+ *
+ * Only a few additions and comparisons are necessary per period, the
+ * values are updated by the PeriodicTaskManager.
+ *
+ * \ingroup    rtos
+ */
+class PeriodicTaskStatistics
+{
+public:
+    PeriodicTaskStatistics();
+
+    /**
+     * Clear all values.
+     */
+    void
+    reset();
+
+    /**
+     * Number of periods for which the execution time has been recorded.
+     */
+    inline uint32_t
+    getNumberOfPeriods() const
+    {
+        return mNumberOfPeriods;
+    }
+
+    /**
+     * Number of periods in which nextPeriod() was called too late.
+     */
+    inline uint32_t
+    getNumberOfOverruns() const
+    {
+        return mNumberOfOverruns;
+    }
+
+    /**
+     * Number of periods dropped with OverrunPolicy::skip.
+     */
+    inline uint32_t
+    getNumberOfSkippedPeriods() const
+    {
+        return mNumberOfSkippedPeriods;
+    }
+
+    /**
+     * \return  Zero if no period has been recorded.
+     */
+    inline time::Duration
+    getMinimumExecutionTime() const
+    {
+        return (mNumberOfPeriods == 0) ? time::Duration::zero() : mMinimumExecutionTime;
+    }
+
+    inline time::Duration
+    getMaximumExecutionTime() const
+    {
+        return mMaximumExecutionTime;
+    }
+
+    /**
+     * \return  Zero if no period has been recorded.
+     */
+    time::Duration
+    getAverageExecutionTime() const;
+
+    inline time::Duration
+    getMaximumJitter() const
+    {
+        return mMaximumJitter;
+    }
+
+    /**
+     * \return  Zero if no overrun happened.
+     */
+    inline time::Duration
+    getMaximumLateness() const
+    {
+        return mMaximumLateness;
+    }
+
+private:
+    friend class PeriodicTaskManager;
+
+    void
+    recordStart(time::Duration jitter);
+
+    /**
+     * \param lateness
+     *      Time since the end of the period, negative or zero if the
+     *      period was not overrun.
+     */
+    void
+    recordEnd(time::Duration executionTime, time::Duration lateness);
+
+    inline void
+    recordSkippedPeriods(uint32_t count)
+    {
+        mNumberOfSkippedPeriods += count;
+    }
+
+    uint32_t mNumberOfPeriods;
+    uint32_t mNumberOfOverruns;
+    uint32_t mNumberOfSkippedPeriods;
+
+    time::Duration mMinimumExecutionTime;
+    time::Duration mMaximumExecutionTime;
+    time::Duration mTotalExecutionTime;
+    time::Duration mMaximumJitter;
+    time::Duration mMaximumLateness;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "priority_queue.h"
+
+using outpost::rtos::internal::PriorityQueueIndex;
+
+constexpr uint16_t PriorityQueueIndex::invalid;
+constexpr uint8_t PriorityQueueIndex::maximumNumberOfLevels;
+
+PriorityQueueIndex::PriorityQueueIndex(uint16_t* next,
+                                       uint16_t numberOfSlots,
+                                       uint16_t* levels,
+                                       uint8_t numberOfLevels) :
+    mNext(next),
+    mLevels(levels),
+    mNumberOfLevels(numberOfLevels),
+    mFree(0),
+    mNumberOfItems(0),
+    mNonEmpty(0)
+{
+    for (uint16_t i = 0; i < numberOfSlots; ++i)
+    {
+        mNext[i] = (i + 1 < numberOfSlots) ? static_cast<uint16_t>(i + 1) : invalid;
+    }
+    for (uint8_t level = 0; level < numberOfLevels; ++level)
+    {
+        head(level) = invalid;
+        tail(level) = invalid;
+    }
+}
+
+uint16_t
+PriorityQueueIndex::push(uint8_t level)
+{
+    const uint16_t slot = mFree;
+    if (slot == invalid)
+    {
+        return invalid;
+    }
+    mFree = mNext[slot];
+
+    mNext[slot] = invalid;
+    if (head(level) == invalid)
+    {
+        head(level) = slot;
+        mNonEmpty |= (1UL << level);
+    }
+    else
+    {
+        mNext[tail(level)] = slot;
+    }
+    tail(level) = slot;
+    mNumberOfItems++;
+    return slot;
+}
+
+uint16_t
+PriorityQueueIndex::pop()
+{
+    if (mNonEmpty == 0)
+    {
+        return invalid;
+    }
+
+    const uint8_t level = static_cast<uint8_t>(31 - __builtin_clz(mNonEmpty));
+    const uint16_t slot = head(level);
+    head(level) = mNext[slot];
+    if (head(level) == invalid)
+    {
+        tail(level) = invalid;
+        mNonEmpty &= ~(1UL << level);
+    }
+    mNumberOfItems--;
+    return slot;
+}
+
+void
+PriorityQueueIndex::release(uint16_t slot)
+{
+    mNext[slot] = mFree;
+    mFree = slot;
+}
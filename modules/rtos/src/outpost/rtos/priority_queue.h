@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_PRIORITY_QUEUE_H
+#define OUTPOST_RTOS_PRIORITY_QUEUE_H
+
+#include <outpost/rtos/mutex.h>
+#include <outpost/rtos/mutex_guard.h>
+#include <outpost/rtos/semaphore.h>
+#include <outpost/time/duration.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+namespace internal
+{
+/**
+ * Slot management of a PriorityQueue, independent of the type of the
+ * elements.
+ *
+ * The slots form one singly linked FIFO per priority level and a free
+ * list. A bitmap marks the levels which are not empty, so that the
+ * highest one is found with a single instruction.
+ */
+class PriorityQueueIndex
+{
+public:
+    static constexpr uint16_t invalid = 0xFFFF;
+    static constexpr uint8_t maximumNumberOfLevels = 32;
+
+    /**
+     * \param next
+     *      Link of every slot, \p numberOfSlots elements.
+     * \param levels
+     *      First and last slot of every level, 2 * \p numberOfLevels
+     *      elements.
+     */
+    PriorityQueueIndex(uint16_t* next,
+                       uint16_t numberOfSlots,
+                       uint16_t* levels,
+                       uint8_t numberOfLevels);
+
+    // disable copy constructor
+    PriorityQueueIndex(const PriorityQueueIndex& other) = delete;
+
+    // disable assignment operator
+    PriorityQueueIndex&
+    operator=(const PriorityQueueIndex& other) = delete;
+
+    /**
+     * Take a free slot and append it to the FIFO of \p level.
+     *
+     * \return  Index of the slot, invalid if all slots are in use.
+     */
+    uint16_t
+    push(uint8_t level);
+
+    /**
+     * Remove the oldest slot of the highest non-empty level.
+     *
+     * The slot has to be returned with release() after its content has
+     * been copied.
+     *
+     * \return  Index of the slot, invalid if the queue is empty.
+     */
+    uint16_t
+    pop();
+
+    void
+    release(uint16_t slot);
+
+    inline uint16_t
+    getNumberOfItems() const
+    {
+        return mNumberOfItems;
+    }
+
+    inline uint8_t
+    getNumberOfLevels() const
+    {
+        return mNumberOfLevels;
+    }
+
+private:
+    inline uint16_t&
+    head(uint8_t level)
+    {
+        return mLevels[2 * level];
+    }
+
+    inline uint16_t&
+    tail(uint8_t level)
+    {
+        return mLevels[2 * level + 1];
+    }
+
+    uint16_t* const mNext;
+    uint16_t* const mLevels;
+    const uint8_t mNumberOfLevels;
+
+    uint16_t mFree;
+    uint16_t mNumberOfItems;
+
+    /// Bit n is set if level n is not empty
+    uint32_t mNonEmpty;
+};
+}  // namespace internal
+
+/**
+ * Bounded queue in which items of a higher priority overtake the items of
+ * a lower priority.
+ *
+ * Items of the same priority are received in the order they were sent.
+ * Higher values represent a higher priority, the same as for threads.
+ * All levels share the \p numberOfItems slots. Sending and receiving is
+ * O(1), independent of the number of items and levels.
+ *
+ * The blocking and timeout behaviour is the same as for Queue.
+ *
+ * \code
+ * outpost::rtos::PriorityQueue<Command, 16, 3> commands;
+ *
+ * commands.send(housekeepingRequest, 0);
+ * commands.send(abortRequest, 2);
+ *
+ * Command command;
+ * commands.receive(command, outpost::time::Seconds(1));    // abortRequest
+ * \endcode
+ *
+ * \tparam T
+ *      Type of the items, must be default constructible and copyable.
+ * \tparam numberOfItems
+ *      Maximum number of items in the queue.
+ * \tparam numberOfLevels
+ *      Number of priority levels, at most 32.
+ *
+ * \ingroup    rtos
+ */
+template <typename T, size_t numberOfItems, uint8_t numberOfLevels = 4>
+class PriorityQueue
+{
+    static_assert(numberOfItems > 0, "Queue must hold at least one item");
+    static_assert(numberOfItems < internal::PriorityQueueIndex::invalid, "Too many items");
+    static_assert(numberOfLevels > 0, "At least one priority level required");
+    static_assert(numberOfLevels <= internal::PriorityQueueIndex::maximumNumberOfLevels,
+                  "Too many priority levels");
+
+public:
+    PriorityQueue() :
+        mMutex(),
+        mItems(0),
+        mIndex(mNext, numberOfItems, mLevels, numberOfLevels),
+        mData()
+    {
+    }
+
+    // disable copy constructor
+    PriorityQueue(const PriorityQueue& other) = delete;
+
+    // disable assignment operator
+    PriorityQueue&
+    operator=(const PriorityQueue& other) = delete;
+
+    /**
+     * Send data to the queue.
+     *
+     * \param priority
+     *      Priority level, values above the highest level are sent with
+     *      the highest level.
+     *
+     * \retval true     Value was successfully stored in the queue.
+     * \retval false    Queue is full.
+     */
+    bool
+    send(const T& data, uint8_t priority)
+    {
+        if (priority >= numberOfLevels)
+        {
+            priority = numberOfLevels - 1;
+        }
+
+        {
+            MutexGuard lock(mMutex);
+            const uint16_t slot = mIndex.push(priority);
+            if (slot == internal::PriorityQueueIndex::invalid)
+            {
+                return false;
+            }
+            mData[slot] = data;
+        }
+        mItems.release();
+        return true;
+    }
+
+    /**
+     * Receive the oldest item of the highest priority.
+     *
+     * \param timeout
+     *      Maximum time to wait for an item.
+     *
+     * \retval true     Value was received correctly and put in \p data.
+     * \retval false    Timeout occurred, \p data was not changed.
+     */
+    bool
+    receive(T& data, time::Duration timeout)
+    {
+        if (!mItems.acquire(timeout))
+        {
+            return false;
+        }
+
+        // Every count of the semaphore belongs to an item in the index
+        MutexGuard lock(mMutex);
+        const uint16_t slot = mIndex.pop();
+        data = mData[slot];
+        mIndex.release(slot);
+        return true;
+    }
+
+    size_t
+    getNumberOfItems() const
+    {
+        MutexGuard lock(mMutex);
+        return mIndex.getNumberOfItems();
+    }
+
+private:
+    mutable Mutex mMutex;
+
+    /// Number of items which can be received
+    Semaphore mItems;
+
+    uint16_t mNext[numberOfItems];
+    uint16_t mLevels[2 * numberOfLevels];
+    internal::PriorityQueueIndex mIndex;
+    T mData[numberOfItems];
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
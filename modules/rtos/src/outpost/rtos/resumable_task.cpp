@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "resumable_task.h"
+
+using outpost::rtos::ResumableTask;
+using outpost::rtos::ResumableTaskRunner;
+using outpost::time::Duration;
+
+// ----------------------------------------------------------------------------
+ResumableTask::ResumableTask() :
+    mResumePoint(0),
+    mRunner(nullptr),
+    mNext(nullptr),
+    mTimeout(),
+    mTimeoutActive(false),
+    mFinished(false)
+{
+}
+
+void
+ResumableTask::startTimeout(time::Duration timeout)
+{
+    mTimeout = mRunner->getTimeOfPass() + timeout;
+    mTimeoutActive = true;
+}
+
+bool
+ResumableTask::isTimeoutExpired() const
+{
+    return mRunner->getTimeOfPass() >= mTimeout;
+}
+
+// ----------------------------------------------------------------------------
+ResumableTaskRunner::ResumableTaskRunner(const time::Clock& clock, time::Duration pollPeriod) :
+    mClock(clock),
+    mPollPeriod(pollPeriod),
+    mWakeup(BinarySemaphore::State::acquired),
+    mTasks(nullptr),
+    mNumberOfTasks(0),
+    mNow(clock.now())
+{
+}
+
+void
+ResumableTaskRunner::add(ResumableTask& task)
+{
+    remove(task);
+
+    task.mResumePoint = 0;
+    task.mTimeoutActive = false;
+    task.mFinished = false;
+    task.mRunner = this;
+
+    // Appended, so that the tasks are resumed in the order they were added
+    ResumableTask** position = &mTasks;
+    while (*position != nullptr)
+    {
+        position = &(*position)->mNext;
+    }
+    task.mNext = nullptr;
+    *position = &task;
+    mNumberOfTasks++;
+}
+
+void
+ResumableTaskRunner::remove(ResumableTask& task)
+{
+    for (ResumableTask** position = &mTasks; *position != nullptr;
+         position = &(*position)->mNext)
+    {
+        if (*position == &task)
+        {
+            *position = task.mNext;
+            task.mNext = nullptr;
+            mNumberOfTasks--;
+            return;
+        }
+    }
+}
+
+Duration
+ResumableTaskRunner::runOnce()
+{
+    mNow = mClock.now();
+
+    Duration wait = mPollPeriod;
+    ResumableTask** position = &mTasks;
+    while (*position != nullptr)
+    {
+        ResumableTask* task = *position;
+        if (task->resume() == ResumableTask::Status::finished)
+        {
+            task->mFinished = true;
+            task->mTimeoutActive = false;
+            remove(*task);
+        }
+        else
+        {
+            if (task->mTimeoutActive)
+            {
+                const Duration remaining = task->mTimeout - mNow;
+                if (remaining < wait)
+                {
+                    wait = remaining;
+                }
+            }
+            position = &task->mNext;
+        }
+    }
+
+    if (wait < Duration::zero())
+    {
+        wait = Duration::zero();
+    }
+    return wait;
+}
+
+void
+ResumableTaskRunner::run()
+{
+    while (true)
+    {
+        const Duration wait = runOnce();
+        if (wait > Duration::zero())
+        {
+            // Returns early if notified, the state is checked in the next pass
+            mWakeup.acquire(wait);
+        }
+    }
+}
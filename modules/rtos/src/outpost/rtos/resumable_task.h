@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_RESUMABLE_TASK_H
+#define OUTPOST_RTOS_RESUMABLE_TASK_H
+
+#include <outpost/rtos/semaphore.h>
+#include <outpost/time/clock.h>
+#include <outpost/time/duration.h>
+
+#include <stdint.h>
+
+/**
+ * Start of the body of ResumableTask::resume().
+ *
+ * \ingroup    rtos
+ */
+#define OUTPOST_RESUMABLE_BEGIN() \
+    switch (this->mResumePoint)   \
+    {                             \
+        case 0:
+
+/**
+ * Suspend the task until \p condition is true.
+ *
+ * The condition is evaluated again every time the task is resumed.
+ *
+ * \ingroup    rtos
+ */
+#define OUTPOST_RESUMABLE_WAIT_UNTIL(condition)                         \
+    do                                                                  \
+    {                                                                   \
+        this->mResumePoint = __LINE__;                                  \
+        /* Label in a block, avoids the warning about a fall through */ \
+        if (false)                                                      \
+        {                                                               \
+            case __LINE__:;                                             \
+        }                                                               \
+        if (!(condition))                                               \
+        {                                                               \
+            return ::outpost::rtos::ResumableTask::Status::waiting;     \
+        }                                                               \
+    } while (false)
+
+/**
+ * Suspend the task for \p duration.
+ *
+ * \ingroup    rtos
+ */
+#define OUTPOST_RESUMABLE_SLEEP(duration)                              \
+    do                                                                 \
+    {                                                                  \
+        this->startTimeout(duration);                                  \
+        OUTPOST_RESUMABLE_WAIT_UNTIL(this->isTimeoutExpired());        \
+        this->stopTimeout();                                           \
+    } while (false)
+
+/**
+ * Give the other tasks of the runner the chance to execute.
+ *
+ * \ingroup    rtos
+ */
+#define OUTPOST_RESUMABLE_YIELD()                                      \
+    do                                                                 \
+    {                                                                  \
+        this->startTimeout(::outpost::time::Duration::zero());         \
+        this->mResumePoint = __LINE__;                                 \
+        return ::outpost::rtos::ResumableTask::Status::waiting;        \
+        case __LINE__:                                                 \
+            this->stopTimeout();                                       \
+    } while (false)
+
+/**
+ * Suspend the task until an element has been received from \p queue.
+ *
+ * Works with every queue providing `bool receive(T&, Duration)`, e.g.
+ * outpost::rtos::Queue or outpost::utils::SharedBufferQueue.
+ *
+ * \ingroup    rtos
+ */
+#define OUTPOST_RESUMABLE_RECEIVE(queue, data) \
+    OUTPOST_RESUMABLE_WAIT_UNTIL((queue).receive(data, ::outpost::time::Duration::zero()))
+
+/**
+ * Suspend the task until an element has been received from \p queue or
+ * \p timeout has passed.
+ *
+ * \param received
+ *      Boolean lvalue, set to false if the timeout occurred.
+ *
+ * \ingroup    rtos
+ */
+#define OUTPOST_RESUMABLE_RECEIVE_TIMEOUT(queue, data, timeout, received)                 \
+    do                                                                                    \
+    {                                                                                     \
+        this->startTimeout(timeout);                                                      \
+        OUTPOST_RESUMABLE_WAIT_UNTIL(                                                     \
+                ((received) = (queue).receive(data, ::outpost::time::Duration::zero()))  \
+                || this->isTimeoutExpired());                                             \
+        this->stopTimeout();                                                              \
+    } while (false)
+
+/**
+ * End of the body of ResumableTask::resume(), the task is finished.
+ *
+ * \ingroup    rtos
+ */
+#define OUTPOST_RESUMABLE_END()   \
+    }                             \
+    this->mResumePoint = 0;       \
+    return ::outpost::rtos::ResumableTask::Status::finished
+
+namespace outpost
+{
+namespace rtos
+{
+class ResumableTaskRunner;
+
+/**
+ * Stackless task which is suspended and resumed at defined points.
+ *
+ * A resumable task implements a sequential state machine, e.g. of a
+ * protocol handler, without a stack of its own. All tasks of a
+ * ResumableTaskRunner share the thread of the runner, a suspended task
+ * only needs the memory of its object.
+ *
+ * The body of resume() is enclosed by OUTPOST_RESUMABLE_BEGIN() and
+ * OUTPOST_RESUMABLE_END() and suspends the task with the other
+ * OUTPOST_RESUMABLE_* macros:
+ *
+ * \code
+ * class Handler : public outpost::rtos::ResumableTask
+ * {
+ *     ...
+ * protected:
+ *     Status
+ *     resume() override
+ *     {
+ *         OUTPOST_RESUMABLE_BEGIN();
+ *         while (true)
+ *         {
+ *             OUTPOST_RESUMABLE_RECEIVE(mQueue, mRequest);
+ *             sendCommand(mRequest);
+ *             OUTPOST_RESUMABLE_RECEIVE_TIMEOUT(mReplies, mReply, mTimeout, mReceived);
+ *             if (!mReceived)
+ *             {
+ *                 ++mNumberOfTimeouts;
+ *             }
+ *         }
+ *         OUTPOST_RESUMABLE_END();
+ *     }
+ * };
+ * \endcode
+ *
+ * The macros are implemented with a switch statement on the line numbers
+ * of the suspension points (protothreads). Therefore:
+ * - Local variables are not preserved while the task is suspended, state
+ *   has to be kept in members.
+ * - The macros must not be used inside a switch statement of resume()
+ *   and only once per source line.
+ *
+ * \ingroup    rtos
+ */
+class ResumableTask
+{
+public:
+    enum class Status
+    {
+        waiting,
+        finished
+    };
+
+    ResumableTask();
+
+    virtual ~ResumableTask() = default;
+
+    // disable copy constructor
+    ResumableTask(const ResumableTask& other) = delete;
+
+    // disable assignment operator
+    ResumableTask&
+    operator=(const ResumableTask& other) = delete;
+
+    /**
+     * Check whether the task has reached OUTPOST_RESUMABLE_END().
+     */
+    inline bool
+    isFinished() const
+    {
+        return mFinished;
+    }
+
+protected:
+    /**
+     * Body of the task, called by the runner until it is finished.
+     */
+    virtual Status
+    resume() = 0;
+
+    /**
+     * Start a timeout relative to the time of the current pass of the
+     * runner.
+     */
+    void
+    startTimeout(time::Duration timeout);
+
+    inline void
+    stopTimeout()
+    {
+        mTimeoutActive = false;
+    }
+
+    bool
+    isTimeoutExpired() const;
+
+    /// Suspension point, the line of the macro, 0 at the beginning
+    uint32_t mResumePoint;
+
+private:
+    friend class ResumableTaskRunner;
+
+    ResumableTaskRunner* mRunner;
+    ResumableTask* mNext;
+    time::SpacecraftElapsedTime mTimeout;
+    bool mTimeoutActive;
+    bool mFinished;
+};
+
+/**
+ * Executes a number of resumable tasks in a single thread.
+ *
+ * Every pass resumes all tasks once. Between the passes the runner sleeps
+ * until the earliest timeout of a task, at most for the poll period.
+ * Conditions and queues are checked at least once per poll period,
+ * producers can call notify() to have them checked immediately, e.g.
+ * after sending to a queue or from the callback of a Timer.
+ *
+ * \code
+ * class ProtocolThread : public outpost::rtos::Thread
+ * {
+ *     ...
+ *     void
+ *     run() override
+ *     {
+ *         mRunner.add(mRmapHandler);
+ *         mRunner.add(mHousekeepingHandler);
+ *         mRunner.run();
+ *     }
+ *
+ *     outpost::rtos::ResumableTaskRunner mRunner;
+ * };
+ * \endcode
+ *
+ * Except notify() all functions must be called from the thread of the
+ * runner.
+ *
+ * \ingroup    rtos
+ */
+class ResumableTaskRunner
+{
+public:
+    /**
+     * \param clock
+     *      Clock for the timeouts of the tasks.
+     * \param pollPeriod
+     *      Maximum time between two passes.
+     */
+    ResumableTaskRunner(const time::Clock& clock, time::Duration pollPeriod);
+
+    // disable copy constructor
+    ResumableTaskRunner(const ResumableTaskRunner& other) = delete;
+
+    // disable assignment operator
+    ResumableTaskRunner&
+    operator=(const ResumableTaskRunner& other) = delete;
+
+    /**
+     * Add a task, it starts at OUTPOST_RESUMABLE_BEGIN() in the next pass.
+     *
+     * A finished task can be added again to restart it.
+     */
+    void
+    add(ResumableTask& task);
+
+    /**
+     * Remove a task, must not be called by the task itself.
+     */
+    void
+    remove(ResumableTask& task);
+
+    /**
+     * Resume all tasks once, finished tasks are removed.
+     *
+     * \return  Time until the next pass is required, at most the poll
+     *          period.
+     */
+    time::Duration
+    runOnce();
+
+    /**
+     * Execute the tasks forever.
+     */
+    void
+    run();
+
+    /**
+     * Start the next pass immediately, can be called from any thread.
+     */
+    inline void
+    notify()
+    {
+        mWakeup.release();
+    }
+
+    inline time::SpacecraftElapsedTime
+    getTimeOfPass() const
+    {
+        return mNow;
+    }
+
+    inline size_t
+    getNumberOfTasks() const
+    {
+        return mNumberOfTasks;
+    }
+
+private:
+    const time::Clock& mClock;
+    const time::Duration mPollPeriod;
+    BinarySemaphore mWakeup;
+
+    ResumableTask* mTasks;
+    size_t mNumberOfTasks;
+    time::SpacecraftElapsedTime mNow;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_SEQLOCK_H
+#define OUTPOST_RTOS_SEQLOCK_H
+
+#include <outpost/rtos/atomic.h>
+#include <outpost/rtos/thread.h>
+#include <outpost/time/duration.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Value with a single writer and any number of lock-free readers.
+ *
+ * The writer increments a sequence number before and after it updates
+ * the value. A reader copies the value and retries if the sequence number
+ * was odd or has changed in the meantime, it never blocks the writer.
+ * Writing therefore takes constant time and is safe from an ISR, reading
+ * is constant time as long as it does not collide with a write.
+ *
+ * The value is kept in atomic 32 bit words, so that concurrent reads and
+ * writes are well defined on all ports without additional fences.
+ *
+ * On a single processor a reader which has preempted the writer in the
+ * middle of write() cannot succeed until the writer continues. The writer
+ * should therefore run in an ISR or with at least the priority of the
+ * readers. Otherwise read() sleeps after a few retries so that the writer
+ * can finish, which delays the reader by a clock tick.
+ *
+ * \code
+ * outpost::rtos::SeqLock<Model> model;
+ *
+ * // writer
+ * model.write(newModel);
+ *
+ * // any reader
+ * Model current = model.read();
+ * \endcode
+ *
+ * \tparam T
+ *      Trivially copyable type, its size must be a multiple of 4 bytes.
+ *
+ * \ingroup    rtos
+ */
+template <typename T>
+class SeqLock
+{
+    static_assert(sizeof(T) % sizeof(uint32_t) == 0, "Size must be a multiple of 32 bit");
+
+public:
+    explicit SeqLock(const T& value = T()) : mSequence(0)
+    {
+        storeWords(value);
+    }
+
+    // disable copy constructor
+    SeqLock(const SeqLock& other) = delete;
+
+    // disable assignment operator
+    SeqLock&
+    operator=(const SeqLock& other) = delete;
+
+    /**
+     * Replace the value, only one context may write.
+     */
+    inline void
+    write(const T& value)
+    {
+        mSequence.fetchAdd(1);
+        storeWords(value);
+        mSequence.fetchAdd(1);
+    }
+
+    /**
+     * Read a consistent copy of the value.
+     *
+     * Must not be called from an ISR, use tryRead() there.
+     */
+    inline T
+    read() const
+    {
+        T value;
+        uint32_t retries = 0;
+        while (!tryRead(value))
+        {
+            retries++;
+            if (retries >= spinRetries)
+            {
+                // The writer may have been preempted by this reader, let
+                // it finish its write
+                Thread::sleep(time::Milliseconds(1));
+            }
+        }
+        return value;
+    }
+
+    /**
+     * Read the value once without retrying.
+     *
+     * \retval true     \p value holds a consistent copy.
+     * \retval false    A write was in progress, \p value is undefined.
+     */
+    inline bool
+    tryRead(T& value) const
+    {
+        const uint32_t sequence = mSequence.load();
+        if ((sequence & 1) != 0)
+        {
+            return false;
+        }
+
+        uint32_t words[numberOfWords];
+        for (size_t i = 0; i < numberOfWords; ++i)
+        {
+            words[i] = mWords[i].load();
+        }
+        if (mSequence.load() != sequence)
+        {
+            return false;
+        }
+        memcpy(&value, words, sizeof(T));
+        return true;
+    }
+
+    /**
+     * Number of completed writes.
+     */
+    inline uint32_t
+    getNumberOfWrites() const
+    {
+        return mSequence.load() / 2;
+    }
+
+private:
+    static constexpr size_t numberOfWords = sizeof(T) / sizeof(uint32_t);
+
+    /// Failed reads before the reader backs off
+    static constexpr uint32_t spinRetries = 16;
+
+    inline void
+    storeWords(const T& value)
+    {
+        uint32_t words[numberOfWords];
+        memcpy(words, &value, sizeof(T));
+        for (size_t i = 0; i < numberOfWords; ++i)
+        {
+            mWords[i].store(words[i]);
+        }
+    }
+
+    Atomic<uint32_t> mSequence;
+    Atomic<uint32_t> mWords[numberOfWords];
+};
+
+template <typename T>
+constexpr size_t SeqLock<T>::numberOfWords;
+
+template <typename T>
+constexpr uint32_t SeqLock<T>::spinRetries;
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
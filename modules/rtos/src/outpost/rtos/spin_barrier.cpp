@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "spin_barrier.h"
+
+using outpost::rtos::SpinBarrier;
+
+constexpr uint32_t SpinBarrier::defaultSpinIterations;
+
+SpinBarrier::SpinBarrier(uint16_t numberOfThreads, uint32_t spinIterations) :
+    mNumberOfThreads(numberOfThreads),
+    mSpinIterations(spinIterations),
+    mArrived(0),
+    mState(0),
+    mWakeupEven(0),
+    mWakeupOdd(0),
+    mNumberOfBlockingWaits(0)
+{
+}
+
+void
+SpinBarrier::wait()
+{
+    // A thread enters the next round only after it has seen the new
+    // generation, the value read here is the one of the current round
+    const uint32_t generation = getGeneration(mState.load());
+
+    if (mArrived.fetchAdd(1) + 1 >= mNumberOfThreads)
+    {
+        // Reset before the new generation is published, the other threads
+        // can arrive for the next round afterwards
+        mArrived.store(0);
+
+        const uint32_t next = ((generation + 1) & 0xFFFF) << 16;
+        uint32_t state = mState.load();
+        while (!mState.compareAndSwap(state, next))
+        {
+            // A thread has blocked in the meantime, retry with its count
+        }
+
+        for (uint32_t i = 0; i < getNumberOfBlockedThreads(state); ++i)
+        {
+            getWakeup(generation).release();
+        }
+        return;
+    }
+
+    for (uint32_t i = 0; i < mSpinIterations; ++i)
+    {
+        if (getGeneration(mState.load()) != generation)
+        {
+            return;
+        }
+    }
+
+    uint32_t state = mState.load();
+    do
+    {
+        if (getGeneration(state) != generation)
+        {
+            return;
+        }
+    } while (!mState.compareAndSwap(state, state + 1));
+
+    // Counted by the last thread, which releases the semaphore once for us
+    mNumberOfBlockingWaits.fetchAdd(1);
+    getWakeup(generation).acquire();
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_SPIN_BARRIER_H
+#define OUTPOST_RTOS_SPIN_BARRIER_H
+
+#include <outpost/rtos/atomic.h>
+#include <outpost/rtos/semaphore.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Low latency barrier for the phases of parallel computations.
+ *
+ * The threads arriving at the barrier busy wait for the last one, which
+ * avoids the context switches of a Barrier when all threads arrive
+ * within a short time. A thread which has spun for the configured
+ * number of iterations blocks on a semaphore instead, the last thread
+ * only releases the semaphore if a thread is actually blocked.
+ *
+ * The barrier is reusable, it is sense reversing: a generation counter
+ * is incremented by the last thread of every round, the waiting threads
+ * leave the barrier when it changes.
+ *
+ * \warning
+ *      Spinning only helps if every thread has its own core. With more
+ *      threads than cores use a small number of spin iterations.
+ *
+ * \ingroup    rtos
+ */
+class SpinBarrier
+{
+public:
+    static constexpr uint32_t defaultSpinIterations = 10000;
+
+    /**
+     * \param numberOfThreads
+     *      Number of threads that must wait on the barrier for them to
+     *      continue.
+     * \param spinIterations
+     *      Number of checks of the generation before a thread blocks, 0
+     *      blocks immediately.
+     */
+    explicit SpinBarrier(uint16_t numberOfThreads,
+                         uint32_t spinIterations = defaultSpinIterations);
+
+    // disable copy constructor
+    SpinBarrier(const SpinBarrier& other) = delete;
+
+    // disable assignment operator
+    SpinBarrier&
+    operator=(const SpinBarrier& other) = delete;
+
+    /**
+     * Wait until all threads have arrived.
+     */
+    void
+    wait();
+
+    /**
+     * Number of waits which have blocked after spinning.
+     */
+    inline uint32_t
+    getNumberOfBlockingWaits() const
+    {
+        return mNumberOfBlockingWaits.load();
+    }
+
+private:
+    static inline uint32_t
+    getGeneration(uint32_t state)
+    {
+        return state >> 16;
+    }
+
+    static inline uint32_t
+    getNumberOfBlockedThreads(uint32_t state)
+    {
+        return state & 0xFFFF;
+    }
+
+    inline Semaphore&
+    getWakeup(uint32_t generation)
+    {
+        return ((generation & 1) == 0) ? mWakeupEven : mWakeupOdd;
+    }
+
+    const uint32_t mNumberOfThreads;
+    const uint32_t mSpinIterations;
+
+    /// Threads which have arrived in the current generation
+    Atomic<uint32_t> mArrived;
+
+    /// Generation in the upper and number of blocked threads in the lower
+    /// 16 bit. Updated together, so that a thread is either released by
+    /// the last thread or sees the new generation before it blocks.
+    Atomic<uint32_t> mState;
+
+    /// Used alternately by the generations. A thread may otherwise take
+    /// the release of a thread of the previous generation which has not
+    /// yet woken up.
+    Semaphore mWakeupEven;
+    Semaphore mWakeupOdd;
+    Atomic<uint32_t> mNumberOfBlockingWaits;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "thread_profiler.h"
+
+#include <outpost/rtos/mutex_guard.h>
+#include <outpost/rtos/thread.h>
+
+#include <new>
+
+using outpost::rtos::Thread;
+using outpost::rtos::ThreadProfile;
+using outpost::rtos::ThreadProfiler;
+
+constexpr size_t ThreadProfile::maximumNameLength;
+constexpr size_t ThreadProfiler::capacity;
+
+Thread* ThreadProfiler::threads[(capacity > 0) ? capacity : 1];
+size_t ThreadProfiler::numberOfThreads = 0;
+
+static outpost::rtos::Mutex&
+getRegistryMutex()
+{
+    // Created on first use as threads may be started from constructors of
+    // other static objects. Never destroyed, threads unregister during the
+    // static destruction.
+    alignas(outpost::rtos::Mutex) static uint8_t storage[sizeof(outpost::rtos::Mutex)];
+    static outpost::rtos::Mutex* mutex = new (storage) outpost::rtos::Mutex();
+    return *mutex;
+}
+
+size_t
+ThreadProfiler::getSnapshot(ThreadProfile* profiles, size_t maximumNumberOfProfiles)
+{
+    MutexGuard lock(getRegistryMutex());
+
+    size_t count = 0;
+    while ((count < numberOfThreads) && (count < maximumNumberOfProfiles))
+    {
+        threads[count]->getProfile(profiles[count]);
+        count++;
+    }
+    return count;
+}
+
+size_t
+ThreadProfiler::getNumberOfThreads()
+{
+    MutexGuard lock(getRegistryMutex());
+    return numberOfThreads;
+}
+
+void
+ThreadProfiler::registerThread(Thread& thread)
+{
+    MutexGuard lock(getRegistryMutex());
+    if (numberOfThreads < capacity)
+    {
+        threads[numberOfThreads] = &thread;
+        numberOfThreads++;
+    }
+}
+
+void
+ThreadProfiler::unregisterThread(Thread& thread)
+{
+    MutexGuard lock(getRegistryMutex());
+    for (size_t i = 0; i < numberOfThreads; ++i)
+    {
+        if (threads[i] == &thread)
+        {
+            numberOfThreads--;
+            threads[i] = threads[numberOfThreads];
+            return;
+        }
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_THREAD_PROFILER_H
+#define OUTPOST_RTOS_THREAD_PROFILER_H
+
+#include <outpost/time/duration.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Maximum number of threads tracked by the ThreadProfiler.
+ *
+ * Threads started after the registry is full are not profiled. Can be
+ * overwritten by the build system, zero disables the registry.
+ */
+#ifndef OUTPOST_RTOS_THREAD_PROFILER_CAPACITY
+#define OUTPOST_RTOS_THREAD_PROFILER_CAPACITY 32
+#endif
+
+namespace outpost
+{
+namespace rtos
+{
+class Thread;
+
+/**
+ * Runtime information of a single thread.
+ *
+ * Values which are not provided by the operating system are zero.
+ *
+ * \ingroup    rtos
+ */
+struct ThreadProfile
+{
+    /// Longer names are shortened, matches the limit of pthread_setname_np()
+    static constexpr size_t maximumNameLength = 15;
+
+    inline ThreadProfile() :
+        name(),
+        identifier(0),
+        priority(0),
+        cpuTime(time::Duration::zero()),
+        stackSize(0),
+        stackUsage(0),
+        contextSwitches(0)
+    {
+    }
+
+    /**
+     * Copy \p threadName, shortened to maximumNameLength characters.
+     *
+     * A nullptr results in an empty name.
+     */
+    inline void
+    setName(const char* threadName)
+    {
+        name[0] = '\0';
+        if (threadName != nullptr)
+        {
+            strncat(name, threadName, maximumNameLength);
+        }
+    }
+
+    /// Copy of the name of the thread, empty if none was given, so that
+    /// the profile stays valid after the thread has been destroyed
+    char name[maximumNameLength + 1];
+    uint32_t identifier;
+    uint8_t priority;
+
+    /// Processor time used by the thread since its start
+    time::Duration cpuTime;
+
+    /// Size of the stack in bytes
+    size_t stackSize;
+
+    /// Maximum number of stack bytes used so far (high-water mark)
+    size_t stackUsage;
+
+    /// Number of times the thread has been switched out
+    uint32_t contextSwitches;
+};
+
+/**
+ * Registry of all started threads to find processor hogs and to right-size
+ * the stacks.
+ *
+ * Threads register in Thread::start() and unregister when destroyed. The
+ * values are queried from the operating system when a snapshot is taken:
+ *
+ * - POSIX: CPU time clock of the thread (pthread_getcpuclockid()),
+ *   resident stack pages (mincore(), page granularity) and the context
+ *   switch counters of /proc.
+ * - RTEMS: CPU usage and, with the stack checker enabled, stack usage.
+ *   No context switch counter.
+ * - FreeRTOS: run time counter (configGENERATE_RUN_TIME_STATS) and the
+ *   stack high-water mark. No context switch counter.
+ *
+ * \ingroup    rtos
+ */
+class ThreadProfiler
+{
+public:
+    static constexpr size_t capacity = OUTPOST_RTOS_THREAD_PROFILER_CAPACITY;
+
+    /**
+     * Query the profiles of the registered threads.
+     *
+     * \param profiles
+     *      Buffer for the profiles.
+     * \param maximumNumberOfProfiles
+     *      Number of elements of \p profiles.
+     *
+     * \return  Number of profiles written.
+     */
+    static size_t
+    getSnapshot(ThreadProfile* profiles, size_t maximumNumberOfProfiles);
+
+    static size_t
+    getNumberOfThreads();
+
+private:
+    friend class Thread;
+
+    static void
+    registerThread(Thread& thread);
+
+    static void
+    unregisterThread(Thread& thread);
+
+    static Thread* threads[(capacity > 0) ? capacity : 1];
+    static size_t numberOfThreads;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
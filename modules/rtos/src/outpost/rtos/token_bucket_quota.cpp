@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "token_bucket_quota.h"
+
+using outpost::rtos::TokenBucketQuota;
+
+TokenBucketQuota::TokenBucketQuota(outpost::time::Duration interval, size_t numberOfResources) :
+    mNumberOfResources(static_cast<int64_t>(numberOfResources)),
+    mInterval(interval.microseconds()),
+    mFullAt(0)
+{
+}
+
+void
+TokenBucketQuota::setTimeInterval(outpost::time::Duration interval)
+{
+    mInterval.store(interval.microseconds());
+}
+
+bool
+TokenBucketQuota::access(outpost::time::SpacecraftElapsedTime now)
+{
+    const int64_t interval = mInterval.load();
+    const int64_t scaledNow = now.timeSinceEpoch().microseconds() * mNumberOfResources;
+
+    // Every access uses up one interval, scaled by the number of resources
+    // this is the time to refill a single resource. At most all resources,
+    // i.e. the scaled interval times the number of resources, may be in use.
+    int64_t fullAt = mFullAt.load();
+    while (true)
+    {
+        const int64_t newFullAt = ((fullAt > scaledNow) ? fullAt : scaledNow) + interval;
+        if (newFullAt - scaledNow > interval * mNumberOfResources)
+        {
+            return false;
+        }
+        if (mFullAt.compareAndSwap(fullAt, newFullAt))
+        {
+            return true;
+        }
+    }
+}
+
+void
+TokenBucketQuota::reset()
+{
+    mFullAt.store(0);
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_RTOS_TOKEN_BUCKET_QUOTA_H
+#define OUTPOST_RTOS_TOKEN_BUCKET_QUOTA_H
+
+#include <outpost/rtos/atomic.h>
+#include <outpost/time/quota.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace rtos
+{
+/**
+ * Token bucket quota which can be shared between threads.
+ *
+ * Allows bursts of up to \p numberOfResources accesses, after that the
+ * resources are refilled continuously at a rate of \p numberOfResources
+ * per interval. In contrast to time::ContinuousIntervalQuota the memory
+ * does not depend on the number of resources.
+ *
+ * Implemented as generic cell rate algorithm: only the time at which the
+ * bucket will be full again (the theoretical arrival time) is stored in
+ * a single atomic value and updated with compare-and-swap, access() never
+ * blocks. Times are scaled by the number of resources to avoid rounding
+ * errors, \p now times \p numberOfResources has to fit into 64 bit.
+ *
+ * \ingroup    rtos
+ */
+class TokenBucketQuota : public outpost::time::Quota
+{
+public:
+    TokenBucketQuota(outpost::time::Duration interval, size_t numberOfResources);
+
+    // disable copy constructor
+    TokenBucketQuota(const TokenBucketQuota& other) = delete;
+
+    // disable assignment operator
+    TokenBucketQuota&
+    operator=(const TokenBucketQuota& other) = delete;
+
+    /**
+     * Change the refill interval, resources used up so far are kept.
+     */
+    void
+    setTimeInterval(outpost::time::Duration interval) override;
+
+    /**
+     * Take one resource.
+     *
+     * Lock-free, may be called from several threads at the same time.
+     */
+    bool
+    access(outpost::time::SpacecraftElapsedTime now) override;
+
+    /**
+     * Refill all resources.
+     */
+    void
+    reset() override;
+
+private:
+    const int64_t mNumberOfResources;
+
+    /// Interval in microseconds
+    outpost::rtos::Atomic<int64_t> mInterval;
+
+    /// Time in microseconds times the number of resources at which all
+    /// resources are available again
+    outpost::rtos::Atomic<int64_t> mFullAt;
+};
+
+}  // namespace rtos
+}  // namespace outpost
+
+#endif
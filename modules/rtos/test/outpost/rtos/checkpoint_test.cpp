@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos/atomic.h>
+#include <outpost/rtos/checkpoint.h>
+#include <outpost/rtos/thread.h>
+
+#include <unittest/harness.h>
+
+using outpost::rtos::Checkpoint;
+
+namespace
+{
+class Worker : public outpost::rtos::Thread
+{
+public:
+    explicit Worker(Checkpoint& checkpoint) :
+        outpost::rtos::Thread(0, 0, "CHKP"), mCheckpoint(checkpoint), mIterations(0)
+    {
+    }
+
+    void
+    run() override
+    {
+        while (true)
+        {
+            mCheckpoint.pass();
+            mIterations.fetchAdd(1);
+            Thread::sleep(outpost::time::Milliseconds(1));
+        }
+    }
+
+    Checkpoint& mCheckpoint;
+    outpost::rtos::Atomic<uint32_t> mIterations;
+};
+
+bool
+waitForState(const Checkpoint& checkpoint, Checkpoint::State state)
+{
+    for (int i = 0; i < 1000; ++i)
+    {
+        if (checkpoint.getState() == state)
+        {
+            return true;
+        }
+        outpost::rtos::Thread::sleep(outpost::time::Milliseconds(1));
+    }
+    return false;
+}
+}  // namespace
+
+TEST(CheckpointTest, shouldPassWhileRunning)
+{
+    Checkpoint checkpoint(Checkpoint::running);
+
+    checkpoint.pass();
+    checkpoint.pass();
+
+    EXPECT_EQ(Checkpoint::running, checkpoint.getState());
+    EXPECT_FALSE(checkpoint.shouldSuspend());
+}
+
+TEST(CheckpointTest, shouldRequestSuspension)
+{
+    Checkpoint checkpoint(Checkpoint::running);
+
+    checkpoint.suspend();
+    EXPECT_EQ(Checkpoint::suspending, checkpoint.getState());
+    EXPECT_TRUE(checkpoint.shouldSuspend());
+
+    checkpoint.resume();
+    EXPECT_EQ(Checkpoint::running, checkpoint.getState());
+    checkpoint.pass();
+}
+
+TEST(CheckpointTest, shouldBlockWorkerUntilResumed)
+{
+    Checkpoint checkpoint(Checkpoint::suspending);
+    Worker worker(checkpoint);
+    worker.start();
+
+    ASSERT_TRUE(waitForState(checkpoint, Checkpoint::suspended));
+    EXPECT_EQ(0U, worker.mIterations.load());
+
+    checkpoint.resume();
+    for (int i = 0; (i < 1000) && (worker.mIterations.load() == 0); ++i)
+    {
+        outpost::rtos::Thread::sleep(outpost::time::Milliseconds(1));
+    }
+    EXPECT_LT(0U, worker.mIterations.load());
+
+    checkpoint.suspend();
+    ASSERT_TRUE(waitForState(checkpoint, Checkpoint::suspended));
+    const uint32_t iterations = worker.mIterations.load();
+    outpost::rtos::Thread::sleep(outpost::time::Milliseconds(10));
+    EXPECT_EQ(iterations, worker.mIterations.load());
+}
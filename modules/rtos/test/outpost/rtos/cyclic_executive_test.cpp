@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos/atomic.h>
+#include <outpost/rtos/clock.h>
+#include <outpost/rtos/cyclic_executive.h>
+
+#include <unittest/harness.h>
+#include <unittest/time/testing_clock.h>
+
+using namespace outpost::time;
+using outpost::rtos::CyclicExecutive;
+using outpost::rtos::ScheduleSlot;
+
+namespace
+{
+class Component : public outpost::Callable
+{
+public:
+    explicit Component(unittest::time::TestingClock& clock) :
+        mClock(clock),
+        mExecutionTime(Duration::zero()),
+        mFastCalls(0),
+        mSlowCalls(0)
+    {
+    }
+
+    void
+    fast()
+    {
+        mFastCalls++;
+        mClock.incrementBy(mExecutionTime);
+    }
+
+    void
+    slow()
+    {
+        mSlowCalls++;
+        mClock.incrementBy(mExecutionTime);
+    }
+
+    unittest::time::TestingClock& mClock;
+    Duration mExecutionTime;
+    uint32_t mFastCalls;
+    uint32_t mSlowCalls;
+};
+
+class Listener : public outpost::rtos::CyclicExecutiveListener
+{
+public:
+    Listener() : mSlotOverruns(0), mLastSlot(0), mFrameOverruns(0), mLastFrame(0)
+    {
+    }
+
+    void
+    onSlotOverrun(size_t index, Duration) override
+    {
+        mSlotOverruns++;
+        mLastSlot = index;
+    }
+
+    void
+    onFrameOverrun(uint32_t minorFrame, Duration) override
+    {
+        mFrameOverruns++;
+        mLastFrame = minorFrame;
+    }
+
+    uint32_t mSlotOverruns;
+    size_t mLastSlot;
+    uint32_t mFrameOverruns;
+    uint32_t mLastFrame;
+};
+}  // namespace
+
+class CyclicExecutiveTest : public ::testing::Test
+{
+public:
+    CyclicExecutiveTest() : mFirst(mClock), mSecond(mClock)
+    {
+    }
+
+    unittest::time::TestingClock mClock;
+    Component mFirst;
+    Component mSecond;
+};
+
+TEST_F(CyclicExecutiveTest, shouldExecuteSlotsAtTheirRates)
+{
+    const ScheduleSlot table[] = {
+            {&mFirst, &Component::fast, 1, 0, Milliseconds(1)},
+            {&mFirst, &Component::slow, 4, 1, Milliseconds(1)},
+            {&mSecond, &Component::fast, 2, 1, Milliseconds(1)},
+            {&mSecond, &Component::slow, 4, 3, Milliseconds(1)},
+    };
+    CyclicExecutive<4> executive(mClock, Milliseconds(10), 4, table, 0);
+    ASSERT_TRUE(executive.isValid());
+
+    executive.executeMinorFrame();
+    EXPECT_EQ(1U, mFirst.mFastCalls);
+    EXPECT_EQ(0U, mSecond.mFastCalls);
+    EXPECT_EQ(1U, executive.getMinorFrame());
+
+    for (size_t i = 0; i < 7; ++i)
+    {
+        executive.executeMinorFrame();
+    }
+    EXPECT_EQ(8U, mFirst.mFastCalls);
+    EXPECT_EQ(2U, mFirst.mSlowCalls);
+    EXPECT_EQ(4U, mSecond.mFastCalls);
+    EXPECT_EQ(2U, mSecond.mSlowCalls);
+    EXPECT_EQ(0U, executive.getMinorFrame());
+    EXPECT_EQ(2U, executive.getNumberOfMajorFrames());
+    EXPECT_EQ(8U, executive.getSlotStatistics(0).mNumberOfExecutions);
+    EXPECT_EQ(0U, executive.getNumberOfFrameOverruns());
+}
+
+TEST_F(CyclicExecutiveTest, shouldReportSlotAndFrameOverruns)
+{
+    const ScheduleSlot table[] = {
+            {&mFirst, &Component::fast, 1, 0, Milliseconds(2)},
+            {&mSecond, &Component::fast, 2, 1, Milliseconds(5)},
+    };
+    CyclicExecutive<2> executive(mClock, Milliseconds(5), 2, table, 0);
+    Listener listener;
+    executive.setListener(&listener);
+
+    mFirst.mExecutionTime = Milliseconds(3);
+    mSecond.mExecutionTime = Milliseconds(4);
+    executive.executeMinorFrame();
+    EXPECT_EQ(1U, listener.mSlotOverruns);
+    EXPECT_EQ(0U, listener.mLastSlot);
+    EXPECT_EQ(0U, listener.mFrameOverruns);
+
+    // 3 ms + 4 ms exceed the minor frame, the second slot is within its budget
+    executive.executeMinorFrame();
+    EXPECT_EQ(2U, listener.mSlotOverruns);
+    EXPECT_EQ(1U, listener.mFrameOverruns);
+    EXPECT_EQ(1U, listener.mLastFrame);
+    EXPECT_EQ(1U, executive.getNumberOfFrameOverruns());
+
+    const outpost::rtos::ScheduleSlotStatistics statistics = executive.getSlotStatistics(0);
+    EXPECT_EQ(2U, statistics.mNumberOfOverruns);
+    EXPECT_EQ(Milliseconds(3), statistics.mMaxExecutionTime);
+    EXPECT_EQ(0U, executive.getSlotStatistics(1).mNumberOfOverruns);
+
+    executive.resetStatistics();
+    EXPECT_EQ(0U, executive.getSlotStatistics(0).mNumberOfExecutions);
+    EXPECT_EQ(0U, executive.getNumberOfFrameOverruns());
+}
+
+TEST_F(CyclicExecutiveTest, shouldRejectInvalidTable)
+{
+    const ScheduleSlot periodNotDividing[] = {
+            {&mFirst, &Component::fast, 3, 0, Milliseconds(1)},
+    };
+    EXPECT_FALSE(CyclicExecutive<1>(mClock, Milliseconds(10), 4, periodNotDividing, 0).isValid());
+
+    const ScheduleSlot offsetTooLarge[] = {
+            {&mFirst, &Component::fast, 2, 2, Milliseconds(1)},
+    };
+    EXPECT_FALSE(CyclicExecutive<1>(mClock, Milliseconds(10), 4, offsetTooLarge, 0).isValid());
+}
+
+namespace
+{
+class Counter : public outpost::Callable
+{
+public:
+    Counter() : mCalls(0)
+    {
+    }
+
+    void
+    count()
+    {
+        mCalls.fetchAdd(1);
+    }
+
+    outpost::rtos::Atomic<uint32_t> mCalls;
+};
+}  // namespace
+
+TEST(CyclicExecutiveThreadTest, shouldExecuteMinorFramesPeriodically)
+{
+    outpost::rtos::SystemClock clock;
+    Counter counter;
+    const ScheduleSlot table[] = {
+            {&counter, &Counter::count, 1, 0, Milliseconds(5)},
+    };
+    CyclicExecutive<1> executive(clock, Milliseconds(5), 1, table, 0);
+    executive.start();
+
+    outpost::rtos::Thread::sleep(Milliseconds(100));
+    EXPECT_GE(counter.mCalls.load(), 5U);
+    EXPECT_GE(executive.getNumberOfMajorFrames(), 5U);
+}
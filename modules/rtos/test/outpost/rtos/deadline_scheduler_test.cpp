@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos/clock.h>
+#include <outpost/rtos/deadline_scheduler.h>
+
+#include <unittest/harness.h>
+
+using namespace outpost::time;
+using outpost::rtos::Deadline;
+using outpost::rtos::DeadlineScheduler;
+
+class DeadlineSchedulerTest : public ::testing::Test
+{
+public:
+    outpost::rtos::SystemClock mClock;
+};
+
+TEST_F(DeadlineSchedulerTest, shouldSignalDeadlinesNotEarly)
+{
+    DeadlineScheduler scheduler(mClock, Duration::zero(), 0);
+    scheduler.start();
+
+    Deadline deadline;
+    const SpacecraftElapsedTime start = mClock.now();
+    scheduler.scheduleAfter(deadline, Milliseconds(20));
+    EXPECT_FALSE(deadline.isExpired());
+
+    EXPECT_TRUE(deadline.wait(Seconds(5)));
+    EXPECT_TRUE(deadline.isExpired());
+    EXPECT_GE(mClock.now() - start, Milliseconds(20));
+}
+
+TEST_F(DeadlineSchedulerTest, shouldCoalesceDeadlinesWithinTheWindow)
+{
+    DeadlineScheduler scheduler(mClock, Milliseconds(50), 0);
+    scheduler.start();
+
+    Deadline deadlines[3];
+    const SpacecraftElapsedTime start = mClock.now();
+    scheduler.schedule(deadlines[2], start + Milliseconds(30));
+    scheduler.schedule(deadlines[0], start + Milliseconds(10));
+    scheduler.schedule(deadlines[1], start + Milliseconds(20));
+
+    for (Deadline& deadline : deadlines)
+    {
+        EXPECT_TRUE(deadline.wait(Seconds(5)));
+        EXPECT_GE(mClock.now() - start, Milliseconds(30));
+    }
+    EXPECT_EQ(1U, scheduler.getNumberOfWakeups());
+}
+
+TEST_F(DeadlineSchedulerTest, shouldNotSignalCancelledDeadline)
+{
+    DeadlineScheduler scheduler(mClock, Duration::zero(), 0);
+    scheduler.start();
+
+    Deadline cancelled;
+    Deadline later;
+    scheduler.scheduleAfter(cancelled, Milliseconds(10));
+    scheduler.scheduleAfter(later, Milliseconds(30));
+    scheduler.cancel(cancelled);
+
+    EXPECT_TRUE(later.wait(Seconds(5)));
+    EXPECT_FALSE(cancelled.wait(Duration::zero()));
+    EXPECT_FALSE(cancelled.isExpired());
+}
+
+TEST_F(DeadlineSchedulerTest, shouldMoveRescheduledDeadline)
+{
+    DeadlineScheduler scheduler(mClock, Duration::zero(), 0);
+    scheduler.start();
+
+    Deadline deadline;
+    scheduler.scheduleAfter(deadline, Seconds(100));
+    scheduler.scheduleAfter(deadline, Milliseconds(10));
+
+    EXPECT_TRUE(deadline.wait(Seconds(5)));
+}
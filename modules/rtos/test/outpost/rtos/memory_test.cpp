@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos/memory.h>
+#include <outpost/rtos/semaphore.h>
+#include <outpost/rtos/thread.h>
+#include <outpost/rtos/thread_profiler.h>
+
+#include <unittest/harness.h>
+
+#include <unistd.h>
+
+#include <vector>
+
+using outpost::rtos::Memory;
+
+namespace
+{
+class IdleThread : public outpost::rtos::Thread
+{
+public:
+    static constexpr size_t stackSize = 256 * 1024;
+
+    IdleThread() :
+        outpost::rtos::Thread(0, stackSize, "IDLE"),
+        mStarted(outpost::rtos::BinarySemaphore::State::acquired)
+    {
+    }
+
+    void
+    waitUntilStarted()
+    {
+        mStarted.acquire();
+    }
+
+    void
+    run() override
+    {
+        mStarted.release();
+        while (true)
+        {
+            Thread::sleep(outpost::time::Milliseconds(10));
+        }
+    }
+
+private:
+    outpost::rtos::BinarySemaphore mStarted;
+};
+
+constexpr size_t IdleThread::stackSize;
+}  // namespace
+
+TEST(MemoryTest, prefaultKeepsContent)
+{
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    std::vector<uint8_t> data(3 * pageSize + 17);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    // unaligned start and end
+    Memory::prefault(outpost::asSlice(data).skipFirst(5));
+    Memory::prefault(outpost::Slice<uint8_t>::empty());
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        ASSERT_EQ(static_cast<uint8_t>(i * 7), data[i]);
+    }
+}
+
+TEST(MemoryTest, hugePagesNeedCompleteHugePage)
+{
+    uint8_t data[4096];
+    EXPECT_FALSE(Memory::adviseHugePages(outpost::asSlice(data)));
+}
+
+TEST(MemoryTest, prefaultThreadStack)
+{
+    EXPECT_FALSE(Memory::isThreadStackPrefaultEnabled());
+    Memory::setThreadStackPrefault(true);
+    {
+        IdleThread thread;
+        thread.start();
+        thread.waitUntilStarted();
+
+        outpost::rtos::ThreadProfile profile;
+        thread.getProfile(profile);
+        const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        EXPECT_GE(profile.stackUsage + 2 * pageSize, profile.stackSize);
+    }
+    Memory::setThreadStackPrefault(false);
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos/clock.h>
+#include <outpost/rtos/mutex.h>
+#include <outpost/rtos/semaphore.h>
+#include <outpost/rtos/thread.h>
+
+#include <unittest/harness.h>
+
+using outpost::rtos::BinarySemaphore;
+using outpost::rtos::Mutex;
+using outpost::time::Milliseconds;
+
+namespace
+{
+/// Holds the mutex until it is told to release it
+class Holder : public outpost::rtos::Thread
+{
+public:
+    explicit Holder(Mutex& mutex) :
+        Thread(0, defaultStackSize, "HOLD"),
+        mMutex(mutex),
+        mAcquired(BinarySemaphore::State::acquired),
+        mRelease(BinarySemaphore::State::acquired)
+    {
+    }
+
+    void
+    waitUntilAcquired()
+    {
+        mAcquired.acquire();
+    }
+
+    void
+    releaseMutex()
+    {
+        mRelease.release();
+    }
+
+protected:
+    void
+    run() override
+    {
+        mMutex.acquire();
+        mAcquired.release();
+        mRelease.acquire();
+        mMutex.release();
+
+        // Returning from a thread is fatal, wait for the destructor
+        while (true)
+        {
+            sleep(Milliseconds(10));
+        }
+    }
+
+private:
+    Mutex& mMutex;
+    BinarySemaphore mAcquired;
+    BinarySemaphore mRelease;
+};
+
+/// Blocks in acquire() until it is canceled by the destructor
+class Waiter : public outpost::rtos::Thread
+{
+public:
+    explicit Waiter(Mutex& mutex) : Thread(0, defaultStackSize, "WAIT"), mMutex(mutex)
+    {
+    }
+
+protected:
+    void
+    run() override
+    {
+        mMutex.acquire();
+        mMutex.release();
+        while (true)
+        {
+            sleep(Milliseconds(10));
+        }
+    }
+
+private:
+    Mutex& mMutex;
+};
+}  // namespace
+
+TEST(MutexTest, shouldBeRecursive)
+{
+    Mutex mutex;
+    EXPECT_TRUE(mutex.acquire());
+    EXPECT_TRUE(mutex.acquire());
+    EXPECT_TRUE(mutex.acquire(Milliseconds(0)));
+    mutex.release();
+    mutex.release();
+    mutex.release();
+
+    // Released completely, another thread gets it immediately
+    Holder holder(mutex);
+    holder.start();
+    holder.waitUntilAcquired();
+    EXPECT_FALSE(mutex.acquire(Milliseconds(0)));
+    holder.releaseMutex();
+    EXPECT_TRUE(mutex.acquire(outpost::time::Seconds(10)));
+    mutex.release();
+}
+
+TEST(MutexTest, shouldIgnoreReleaseByNonOwner)
+{
+    Mutex mutex;
+    Holder holder(mutex);
+    holder.start();
+    holder.waitUntilAcquired();
+
+    mutex.release();
+    EXPECT_FALSE(mutex.acquire(Milliseconds(0)));
+
+    holder.releaseMutex();
+    EXPECT_TRUE(mutex.acquire(outpost::time::Seconds(10)));
+    mutex.release();
+}
+
+TEST(MutexTest, shouldTimeOutWhileHeldByAnotherThread)
+{
+    outpost::rtos::SystemClock clock;
+    Mutex mutex;
+    Holder holder(mutex);
+    holder.start();
+    holder.waitUntilAcquired();
+
+    const outpost::time::SpacecraftElapsedTime start = clock.now();
+    EXPECT_FALSE(mutex.acquire(Milliseconds(50)));
+    const outpost::time::Duration elapsed = clock.now() - start;
+    EXPECT_GE(elapsed, Milliseconds(50));
+    EXPECT_LT(elapsed, outpost::time::Seconds(5));
+
+    holder.releaseMutex();
+    EXPECT_TRUE(mutex.acquire(outpost::time::Seconds(10)));
+    mutex.release();
+}
+
+TEST(MutexTest, shouldCancelThreadBlockedInAcquire)
+{
+    Mutex mutex;
+    mutex.acquire();
+    {
+        Waiter waiter(mutex);
+        waiter.start();
+        outpost::rtos::Thread::sleep(Milliseconds(20));
+
+        // The destructor has to cancel the waiting thread
+    }
+    mutex.release();
+
+    // Still usable by other threads
+    Holder holder(mutex);
+    holder.start();
+    holder.waitUntilAcquired();
+    holder.releaseMutex();
+}
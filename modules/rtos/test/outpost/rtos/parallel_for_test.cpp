@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos/atomic.h>
+#include <outpost/rtos/parallel_for.h>
+
+#include <unittest/harness.h>
+
+namespace
+{
+class Kernel
+{
+public:
+    static constexpr size_t size = 1000;
+
+    Kernel() : mValues(), mNumberOfCalls(0)
+    {
+    }
+
+    void
+    square(size_t first, size_t last)
+    {
+        mNumberOfCalls.fetchAdd(1);
+        for (size_t i = first; i < last; ++i)
+        {
+            mValues[i] += static_cast<uint32_t>(i * i);
+        }
+    }
+
+    uint32_t mValues[size];
+    outpost::rtos::Atomic<uint32_t> mNumberOfCalls;
+};
+
+constexpr size_t Kernel::size;
+}  // namespace
+
+class ParallelForTest : public ::testing::Test
+{
+public:
+    ParallelForTest() : mExecutor(0)
+    {
+    }
+
+    void
+    SetUp() override
+    {
+        mExecutor.start();
+    }
+
+    outpost::rtos::Executor<3, 4> mExecutor;
+    Kernel mKernel;
+};
+
+TEST_F(ParallelForTest, shouldProcessEveryElementOnce)
+{
+    for (size_t iteration = 0; iteration < 50; ++iteration)
+    {
+        outpost::rtos::parallelFor(mExecutor, 0, Kernel::size, mKernel, &Kernel::square);
+    }
+
+    for (size_t i = 0; i < Kernel::size; ++i)
+    {
+        ASSERT_EQ(static_cast<uint32_t>(50 * i * i), mKernel.mValues[i]);
+    }
+    EXPECT_EQ(50U * 4U, mKernel.mNumberOfCalls.load());
+}
+
+TEST_F(ParallelForTest, shouldRespectGrainSize)
+{
+    outpost::rtos::parallelFor(mExecutor, 100, 300, mKernel, &Kernel::square, 150);
+
+    EXPECT_EQ(2U, mKernel.mNumberOfCalls.load());
+    EXPECT_EQ(0U, mKernel.mValues[99]);
+    EXPECT_EQ(100U * 100U, mKernel.mValues[100]);
+    EXPECT_EQ(299U * 299U, mKernel.mValues[299]);
+    EXPECT_EQ(0U, mKernel.mValues[300]);
+}
+
+TEST_F(ParallelForTest, shouldIgnoreEmptyRange)
+{
+    outpost::rtos::parallelFor(mExecutor, 10, 10, mKernel, &Kernel::square);
+    EXPECT_EQ(0U, mKernel.mNumberOfCalls.load());
+}
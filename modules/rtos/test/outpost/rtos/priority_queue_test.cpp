@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos/priority_queue.h>
+#include <outpost/rtos/thread.h>
+
+#include <unittest/harness.h>
+
+using namespace outpost::time;
+using outpost::rtos::PriorityQueue;
+
+TEST(PriorityQueueTest, shouldReceiveHigherPriorityFirst)
+{
+    PriorityQueue<uint32_t, 8, 3> queue;
+    EXPECT_TRUE(queue.send(1, 0));
+    EXPECT_TRUE(queue.send(2, 0));
+    EXPECT_TRUE(queue.send(10, 1));
+    EXPECT_TRUE(queue.send(20, 2));
+    EXPECT_TRUE(queue.send(11, 1));
+    EXPECT_EQ(5U, queue.getNumberOfItems());
+
+    const uint32_t expected[] = {20, 10, 11, 1, 2};
+    for (uint32_t value : expected)
+    {
+        uint32_t data = 0;
+        ASSERT_TRUE(queue.receive(data, Duration::zero()));
+        EXPECT_EQ(value, data);
+    }
+    EXPECT_EQ(0U, queue.getNumberOfItems());
+}
+
+TEST(PriorityQueueTest, shouldShareCapacityBetweenLevels)
+{
+    PriorityQueue<uint32_t, 3, 2> queue;
+    EXPECT_TRUE(queue.send(1, 0));
+    EXPECT_TRUE(queue.send(2, 1));
+    EXPECT_TRUE(queue.send(3, 0));
+    EXPECT_FALSE(queue.send(4, 1));
+
+    uint32_t data = 0;
+    ASSERT_TRUE(queue.receive(data, Duration::zero()));
+    EXPECT_EQ(2U, data);
+
+    // the freed slot can be used by any level
+    EXPECT_TRUE(queue.send(5, 0));
+    ASSERT_TRUE(queue.receive(data, Duration::zero()));
+    EXPECT_EQ(1U, data);
+    ASSERT_TRUE(queue.receive(data, Duration::zero()));
+    EXPECT_EQ(3U, data);
+    ASSERT_TRUE(queue.receive(data, Duration::zero()));
+    EXPECT_EQ(5U, data);
+}
+
+TEST(PriorityQueueTest, shouldLimitPriorityToHighestLevel)
+{
+    PriorityQueue<uint32_t, 4, 2> queue;
+    EXPECT_TRUE(queue.send(1, 1));
+    EXPECT_TRUE(queue.send(2, 200));
+    EXPECT_TRUE(queue.send(3, 0));
+
+    uint32_t data = 0;
+    ASSERT_TRUE(queue.receive(data, Duration::zero()));
+    EXPECT_EQ(1U, data);
+    ASSERT_TRUE(queue.receive(data, Duration::zero()));
+    EXPECT_EQ(2U, data);
+}
+
+TEST(PriorityQueueTest, shouldTimeoutOnEmptyQueue)
+{
+    PriorityQueue<uint32_t, 4> queue;
+    uint32_t data = 7;
+    EXPECT_FALSE(queue.receive(data, Milliseconds(10)));
+    EXPECT_EQ(7U, data);
+}
+
+namespace
+{
+class Sender : public outpost::rtos::Thread
+{
+public:
+    explicit Sender(PriorityQueue<uint32_t, 4>& queue) : Thread(0), mQueue(queue)
+    {
+    }
+
+protected:
+    void
+    run() override
+    {
+        outpost::rtos::Thread::sleep(Milliseconds(20));
+        mQueue.send(42, 3);
+
+        // Returning from a thread is not allowed, wait to be cancelled by the destructor
+        while (true)
+        {
+            outpost::rtos::Thread::sleep(Milliseconds(10));
+        }
+    }
+
+private:
+    PriorityQueue<uint32_t, 4>& mQueue;
+};
+}  // namespace
+
+TEST(PriorityQueueTest, shouldBlockUntilItemIsSent)
+{
+    PriorityQueue<uint32_t, 4> queue;
+    Sender sender(queue);
+    sender.start();
+
+    uint32_t data = 0;
+    EXPECT_TRUE(queue.receive(data, Seconds(5)));
+    EXPECT_EQ(42U, data);
+}
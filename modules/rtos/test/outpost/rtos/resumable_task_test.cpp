@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos/queue.h>
+#include <outpost/rtos/resumable_task.h>
+
+#include <unittest/harness.h>
+#include <unittest/time/testing_clock.h>
+
+using namespace outpost::time;
+using outpost::rtos::ResumableTask;
+using outpost::rtos::ResumableTaskRunner;
+
+namespace
+{
+class SleepingTask : public ResumableTask
+{
+public:
+    SleepingTask() : mSteps(0)
+    {
+    }
+
+    size_t mSteps;
+
+protected:
+    Status
+    resume() override
+    {
+        OUTPOST_RESUMABLE_BEGIN();
+        mSteps++;
+        OUTPOST_RESUMABLE_SLEEP(Milliseconds(10));
+        mSteps++;
+        OUTPOST_RESUMABLE_YIELD();
+        mSteps++;
+        OUTPOST_RESUMABLE_END();
+    }
+};
+
+class EchoTask : public ResumableTask
+{
+public:
+    EchoTask(outpost::rtos::Queue<uint32_t>& requests, outpost::rtos::Queue<uint32_t>& replies) :
+        mNumberOfTimeouts(0),
+        mRequests(requests),
+        mReplies(replies),
+        mValue(0),
+        mReceived(false)
+    {
+    }
+
+    size_t mNumberOfTimeouts;
+
+protected:
+    Status
+    resume() override
+    {
+        OUTPOST_RESUMABLE_BEGIN();
+        while (true)
+        {
+            OUTPOST_RESUMABLE_RECEIVE_TIMEOUT(mRequests, mValue, Milliseconds(50), mReceived);
+            if (mReceived)
+            {
+                mReplies.send(mValue + 1);
+            }
+            else
+            {
+                mNumberOfTimeouts++;
+            }
+        }
+        OUTPOST_RESUMABLE_END();
+    }
+
+private:
+    outpost::rtos::Queue<uint32_t>& mRequests;
+    outpost::rtos::Queue<uint32_t>& mReplies;
+    uint32_t mValue;
+    bool mReceived;
+};
+
+class CountingTask : public ResumableTask
+{
+public:
+    explicit CountingTask(outpost::rtos::Queue<uint32_t>& queue) :
+        mSum(0),
+        mQueue(queue),
+        mValue(0)
+    {
+    }
+
+    uint32_t mSum;
+
+protected:
+    Status
+    resume() override
+    {
+        OUTPOST_RESUMABLE_BEGIN();
+        while (mSum < 10)
+        {
+            OUTPOST_RESUMABLE_RECEIVE(mQueue, mValue);
+            mSum += mValue;
+        }
+        OUTPOST_RESUMABLE_END();
+    }
+
+private:
+    outpost::rtos::Queue<uint32_t>& mQueue;
+    uint32_t mValue;
+};
+}  // namespace
+
+class ResumableTaskTest : public ::testing::Test
+{
+public:
+    ResumableTaskTest() : mRunner(mClock, Milliseconds(100))
+    {
+    }
+
+    unittest::time::TestingClock mClock;
+    ResumableTaskRunner mRunner;
+};
+
+TEST_F(ResumableTaskTest, shouldSleepAndYield)
+{
+    SleepingTask task;
+    mRunner.add(task);
+
+    EXPECT_EQ(Milliseconds(10), mRunner.runOnce());
+    EXPECT_EQ(1U, task.mSteps);
+
+    mClock.incrementBy(Milliseconds(9));
+    EXPECT_EQ(Milliseconds(1), mRunner.runOnce());
+    EXPECT_EQ(1U, task.mSteps);
+
+    mClock.incrementBy(Milliseconds(1));
+    EXPECT_EQ(Duration::zero(), mRunner.runOnce());
+    EXPECT_EQ(2U, task.mSteps);
+    EXPECT_FALSE(task.isFinished());
+
+    EXPECT_EQ(Milliseconds(100), mRunner.runOnce());
+    EXPECT_EQ(3U, task.mSteps);
+    EXPECT_TRUE(task.isFinished());
+    EXPECT_EQ(0U, mRunner.getNumberOfTasks());
+}
+
+TEST_F(ResumableTaskTest, shouldRestartFinishedTask)
+{
+    SleepingTask task;
+    mRunner.add(task);
+    for (size_t i = 0; i < 3; ++i)
+    {
+        mRunner.runOnce();
+        mClock.incrementBy(Milliseconds(10));
+    }
+    ASSERT_TRUE(task.isFinished());
+
+    mRunner.add(task);
+    EXPECT_FALSE(task.isFinished());
+    mRunner.runOnce();
+    EXPECT_EQ(4U, task.mSteps);
+}
+
+TEST_F(ResumableTaskTest, shouldMultiplexTasksWaitingOnQueues)
+{
+    outpost::rtos::Queue<uint32_t> requests(4);
+    outpost::rtos::Queue<uint32_t> replies(4);
+    EchoTask echo(requests, replies);
+    CountingTask counter(replies);
+    mRunner.add(echo);
+    mRunner.add(counter);
+
+    EXPECT_EQ(Milliseconds(50), mRunner.runOnce());
+    EXPECT_EQ(0U, counter.mSum);
+
+    // the reply is received in the same pass, the counter is resumed after the echo task
+    requests.send(3);
+    mRunner.runOnce();
+    EXPECT_EQ(4U, counter.mSum);
+
+    requests.send(5);
+    mRunner.runOnce();
+    EXPECT_EQ(10U, counter.mSum);
+    EXPECT_TRUE(counter.isFinished());
+    EXPECT_EQ(1U, mRunner.getNumberOfTasks());
+    EXPECT_EQ(0U, echo.mNumberOfTimeouts);
+}
+
+TEST_F(ResumableTaskTest, shouldTimeoutWhileWaitingForQueue)
+{
+    outpost::rtos::Queue<uint32_t> requests(4);
+    outpost::rtos::Queue<uint32_t> replies(4);
+    EchoTask echo(requests, replies);
+    mRunner.add(echo);
+
+    mRunner.runOnce();
+    mClock.incrementBy(Milliseconds(30));
+    EXPECT_EQ(Milliseconds(20), mRunner.runOnce());
+
+    mClock.incrementBy(Milliseconds(20));
+    mRunner.runOnce();
+    EXPECT_EQ(1U, echo.mNumberOfTimeouts);
+
+    // the next receive starts a new timeout
+    mClock.incrementBy(Milliseconds(49));
+    mRunner.runOnce();
+    EXPECT_EQ(1U, echo.mNumberOfTimeouts);
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos/clock.h>
+#include <outpost/rtos/semaphore.h>
+#include <outpost/rtos/thread.h>
+
+#include <unittest/harness.h>
+
+using outpost::rtos::BinarySemaphore;
+using outpost::time::Milliseconds;
+
+namespace
+{
+/// Answers every ping with a pong
+class Ponger : public outpost::rtos::Thread
+{
+public:
+    Ponger(BinarySemaphore& ping, BinarySemaphore& pong) :
+        Thread(0, defaultStackSize, "PONG"),
+        mPing(ping),
+        mPong(pong)
+    {
+    }
+
+protected:
+    void
+    run() override
+    {
+        // Blocks in acquire() until canceled by the destructor
+        while (true)
+        {
+            mPing.acquire();
+            mPong.release();
+        }
+    }
+
+private:
+    BinarySemaphore& mPing;
+    BinarySemaphore& mPong;
+};
+}  // namespace
+
+TEST(BinarySemaphoreTest, shouldStartInRequestedState)
+{
+    BinarySemaphore released;
+    EXPECT_TRUE(released.acquire(Milliseconds(0)));
+    EXPECT_FALSE(released.acquire(Milliseconds(0)));
+
+    BinarySemaphore acquired(BinarySemaphore::State::acquired);
+    EXPECT_FALSE(acquired.acquire(Milliseconds(0)));
+}
+
+TEST(BinarySemaphoreTest, shouldNotCountReleases)
+{
+    BinarySemaphore semaphore(BinarySemaphore::State::acquired);
+    semaphore.release();
+    semaphore.release();
+    EXPECT_TRUE(semaphore.acquire(Milliseconds(0)));
+    EXPECT_FALSE(semaphore.acquire(Milliseconds(0)));
+}
+
+TEST(BinarySemaphoreTest, shouldTimeOut)
+{
+    outpost::rtos::SystemClock clock;
+    BinarySemaphore semaphore(BinarySemaphore::State::acquired);
+
+    const outpost::time::SpacecraftElapsedTime start = clock.now();
+    EXPECT_FALSE(semaphore.acquire(Milliseconds(50)));
+    const outpost::time::Duration elapsed = clock.now() - start;
+    EXPECT_GE(elapsed, Milliseconds(50));
+    EXPECT_LT(elapsed, outpost::time::Seconds(5));
+}
+
+TEST(BinarySemaphoreTest, shouldPingPong)
+{
+    BinarySemaphore ping(BinarySemaphore::State::acquired);
+    BinarySemaphore pong(BinarySemaphore::State::acquired);
+    Ponger ponger(ping, pong);
+    ponger.start();
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        ping.release();
+        ASSERT_TRUE(pong.acquire(outpost::time::Seconds(10)));
+    }
+
+    // The ponger is waiting for the next ping, the release has to wake it
+    // although the semaphore was left in the waiting state
+    outpost::rtos::Thread::sleep(Milliseconds(20));
+    ping.release();
+    EXPECT_TRUE(pong.acquire(outpost::time::Seconds(10)));
+
+    // No pong without a ping
+    EXPECT_FALSE(pong.acquire(Milliseconds(10)));
+}
+
+TEST(BinarySemaphoreTest, shouldStayUsableAfterCanceledWaiter)
+{
+    BinarySemaphore ping(BinarySemaphore::State::acquired);
+    BinarySemaphore pong(BinarySemaphore::State::acquired);
+    {
+        Ponger ponger(ping, pong);
+        ponger.start();
+        outpost::rtos::Thread::sleep(Milliseconds(20));
+
+        // The destructor has to cancel the thread blocked in acquire()
+    }
+
+    // The canceled waiter leaves the semaphore in the waiting state, a
+    // release must still be taken by the next acquire
+    ping.release();
+    EXPECT_TRUE(ping.acquire(Milliseconds(0)));
+    EXPECT_FALSE(ping.acquire(Milliseconds(0)));
+}
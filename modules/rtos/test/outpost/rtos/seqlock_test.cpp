@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos/seqlock.h>
+#include <outpost/rtos/thread.h>
+
+#include <unittest/harness.h>
+
+using outpost::rtos::SeqLock;
+
+namespace
+{
+struct Pair
+{
+    uint32_t mFirst;
+    uint32_t mSecond;
+};
+
+class Writer : public outpost::rtos::Thread
+{
+public:
+    explicit Writer(SeqLock<Pair>& value) : Thread(0), mValue(value), mDone(0)
+    {
+    }
+
+    bool
+    isDone() const
+    {
+        return mDone.load() != 0;
+    }
+
+protected:
+    void
+    run() override
+    {
+        for (uint32_t i = 1; i <= 20000; ++i)
+        {
+            mValue.write(Pair{i, ~i});
+            if ((i % 1000) == 0)
+            {
+                outpost::rtos::Thread::yield();
+            }
+        }
+        mDone.store(1);
+
+        // Returning from a thread is not allowed, wait to be cancelled by the destructor
+        while (true)
+        {
+            outpost::rtos::Thread::sleep(outpost::time::Milliseconds(10));
+        }
+    }
+
+private:
+    SeqLock<Pair>& mValue;
+    outpost::rtos::Atomic<uint32_t> mDone;
+};
+}  // namespace
+
+TEST(SeqLockTest, shouldReadWrittenValue)
+{
+    SeqLock<Pair> value(Pair{1, 2});
+    EXPECT_EQ(1U, value.read().mFirst);
+    EXPECT_EQ(2U, value.read().mSecond);
+    EXPECT_EQ(0U, value.getNumberOfWrites());
+
+    value.write(Pair{3, 4});
+    Pair pair = {0, 0};
+    EXPECT_TRUE(value.tryRead(pair));
+    EXPECT_EQ(3U, pair.mFirst);
+    EXPECT_EQ(4U, pair.mSecond);
+    EXPECT_EQ(1U, value.getNumberOfWrites());
+}
+
+TEST(SeqLockTest, shouldNeverReadTornValue)
+{
+    SeqLock<Pair> value(Pair{0, ~0U});
+    Writer writer(value);
+    writer.start();
+
+    uint32_t last = 0;
+    for (uint32_t i = 0; !writer.isDone(); ++i)
+    {
+        const Pair pair = value.read();
+        ASSERT_EQ(~pair.mFirst, pair.mSecond);
+        ASSERT_LE(last, pair.mFirst);
+        last = pair.mFirst;
+
+        // Let the writer run independent of the priorities of the threads
+        if ((i % 64) == 0)
+        {
+            outpost::rtos::Thread::sleep(outpost::time::Microseconds(100));
+        }
+    }
+    EXPECT_EQ(20000U, value.read().mFirst);
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos/atomic.h>
+#include <outpost/rtos/semaphore.h>
+#include <outpost/rtos/spin_barrier.h>
+#include <outpost/rtos/thread.h>
+
+#include <unittest/harness.h>
+
+using outpost::rtos::SpinBarrier;
+
+namespace
+{
+static constexpr uint32_t numberOfThreads = 4;
+static constexpr uint32_t numberOfRounds = 200;
+
+/**
+ * Increments the counter once per round, checks after every barrier that
+ * all threads have finished the previous round.
+ */
+class PhaseThread : public outpost::rtos::Thread
+{
+public:
+    PhaseThread(SpinBarrier& barrier, outpost::rtos::Atomic<uint32_t>& counter) :
+        Thread(0),
+        mErrors(0),
+        mBarrier(barrier),
+        mCounter(counter),
+        mDone(outpost::rtos::BinarySemaphore::State::acquired)
+    {
+    }
+
+    void
+    waitUntilDone()
+    {
+        mDone.acquire();
+    }
+
+    uint32_t mErrors;
+
+protected:
+    void
+    run() override
+    {
+        for (uint32_t round = 0; round < numberOfRounds; ++round)
+        {
+            mCounter.fetchAdd(1);
+            mBarrier.wait();
+            if (mCounter.load() != numberOfThreads * (round + 1))
+            {
+                mErrors++;
+            }
+            mBarrier.wait();
+        }
+        mDone.release();
+
+        // Returning from a thread is not allowed, wait to be cancelled by the destructor
+        while (true)
+        {
+            outpost::rtos::Thread::sleep(outpost::time::Milliseconds(10));
+        }
+    }
+
+private:
+    SpinBarrier& mBarrier;
+    outpost::rtos::Atomic<uint32_t>& mCounter;
+    outpost::rtos::BinarySemaphore mDone;
+};
+
+uint32_t
+runRounds(SpinBarrier& barrier)
+{
+    outpost::rtos::Atomic<uint32_t> counter(0);
+    PhaseThread thread0(barrier, counter);
+    PhaseThread thread1(barrier, counter);
+    PhaseThread thread2(barrier, counter);
+    PhaseThread thread3(barrier, counter);
+    PhaseThread* threads[numberOfThreads] = {&thread0, &thread1, &thread2, &thread3};
+
+    for (PhaseThread* thread : threads)
+    {
+        thread->start();
+    }
+
+    uint32_t errors = 0;
+    for (PhaseThread* thread : threads)
+    {
+        thread->waitUntilDone();
+        errors += thread->mErrors;
+    }
+    EXPECT_EQ(numberOfThreads * numberOfRounds, counter.load());
+    return errors;
+}
+}  // namespace
+
+TEST(SpinBarrierTest, shouldSynchronizePhasesWhileSpinning)
+{
+    SpinBarrier barrier(numberOfThreads, 1000000);
+    EXPECT_EQ(0U, runRounds(barrier));
+}
+
+TEST(SpinBarrierTest, shouldSynchronizePhasesWhenBlocking)
+{
+    SpinBarrier barrier(numberOfThreads, 0);
+    EXPECT_EQ(0U, runRounds(barrier));
+    EXPECT_GT(barrier.getNumberOfBlockingWaits(), 0U);
+}
+
+TEST(SpinBarrierTest, shouldNotBlockSingleThread)
+{
+    SpinBarrier barrier(1, 0);
+    barrier.wait();
+    barrier.wait();
+    EXPECT_EQ(0U, barrier.getNumberOfBlockingWaits());
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos/semaphore.h>
+#include <outpost/rtos/thread.h>
+#include <outpost/rtos/thread_profiler.h>
+
+#include <unittest/harness.h>
+
+#include <string>
+
+namespace
+{
+class NamedThread : public outpost::rtos::Thread
+{
+public:
+    explicit NamedThread(const char* name) :
+        outpost::rtos::Thread(0, defaultStackSize, name),
+        mStarted(outpost::rtos::BinarySemaphore::State::acquired)
+    {
+    }
+
+    void
+    waitUntilStarted()
+    {
+        mStarted.acquire();
+    }
+
+    void
+    run() override
+    {
+        mStarted.release();
+        while (true)
+        {
+            Thread::sleep(outpost::time::Milliseconds(10));
+        }
+    }
+
+private:
+    outpost::rtos::BinarySemaphore mStarted;
+};
+}  // namespace
+
+TEST(ThreadProfilerTest, shouldKeepNameAfterThreadIsDestroyed)
+{
+    outpost::rtos::ThreadProfile profile;
+    {
+        NamedThread thread("PROF");
+        thread.start();
+        thread.waitUntilStarted();
+        thread.getProfile(profile);
+    }
+    EXPECT_EQ(std::string("PROF"), profile.name);
+}
+
+TEST(ThreadProfilerTest, shouldShortenLongNames)
+{
+    outpost::rtos::ThreadProfile profile;
+    profile.setName("A name longer than the limit");
+    EXPECT_EQ(outpost::rtos::ThreadProfile::maximumNameLength, std::string(profile.name).size());
+
+    profile.setName(nullptr);
+    EXPECT_EQ(std::string(), profile.name);
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos/semaphore.h>
+#include <outpost/rtos/thread.h>
+
+#include <unittest/harness.h>
+
+#include <sched.h>
+
+namespace
+{
+class StartedThread : public outpost::rtos::Thread
+{
+public:
+    StartedThread() :
+        outpost::rtos::Thread(0, defaultStackSize, "START"),
+        mStarted(outpost::rtos::BinarySemaphore::State::acquired)
+    {
+    }
+
+    void
+    waitUntilStarted()
+    {
+        mStarted.acquire();
+    }
+
+    void
+    run() override
+    {
+        mStarted.release();
+        while (true)
+        {
+            Thread::sleep(outpost::time::Milliseconds(10));
+        }
+    }
+
+private:
+    outpost::rtos::BinarySemaphore mStarted;
+};
+}  // namespace
+
+TEST(ThreadTest, shouldStartWithUnavailableAffinity)
+{
+    cpu_set_t available;
+    ASSERT_EQ(0, sched_getaffinity(0, sizeof(available), &available));
+    if (CPU_ISSET(31, &available))
+    {
+        // No unavailable processor to select
+        return;
+    }
+
+    StartedThread thread;
+    EXPECT_TRUE(thread.setAffinity(1UL << 31));
+    thread.start();
+    thread.waitUntilStarted();
+    EXPECT_EQ(0U, thread.getAffinity());
+}
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos/internal/timer_wheel.h>
+
+#include <unittest/harness.h>
+
+#include <random>
+#include <set>
+#include <vector>
+
+using outpost::rtos::internal::TimerWheel;
+using outpost::rtos::internal::TimerWheelNode;
+
+namespace
+{
+/// Ticks covered by all levels of the wheel
+constexpr uint64_t wheelRange = 1ULL << (TimerWheel::numberOfLevels * TimerWheel::bitsPerLevel);
+
+constexpr size_t numberOfNodes = 32;
+
+/// Brute-force reference: every active node with its expiry
+class Model
+{
+public:
+    Model() : mActive(numberOfNodes, false), mExpiry(numberOfNodes, 0)
+    {
+    }
+
+    void
+    add(size_t node, uint64_t expiry)
+    {
+        mActive[node] = true;
+        mExpiry[node] = expiry;
+    }
+
+    void
+    cancel(size_t node)
+    {
+        mActive[node] = false;
+    }
+
+    /// Nodes expired at \p tick, they are removed from the model
+    std::set<size_t>
+    expire(uint64_t tick)
+    {
+        std::set<size_t> expired;
+        for (size_t i = 0; i < numberOfNodes; ++i)
+        {
+            if (mActive[i] && (mExpiry[i] <= tick))
+            {
+                expired.insert(i);
+                mActive[i] = false;
+            }
+        }
+        return expired;
+    }
+
+    bool
+    isActive(size_t node) const
+    {
+        return mActive[node];
+    }
+
+    /// Earliest expiry of all active nodes
+    uint64_t
+    getNextExpiry() const
+    {
+        uint64_t next = TimerWheel::noEvent;
+        for (size_t i = 0; i < numberOfNodes; ++i)
+        {
+            if (mActive[i] && (mExpiry[i] < next))
+            {
+                next = mExpiry[i];
+            }
+        }
+        return next;
+    }
+
+private:
+    std::vector<bool> mActive;
+    std::vector<uint64_t> mExpiry;
+};
+
+class TimerWheelTest : public testing::Test
+{
+public:
+    TimerWheelTest() : mNodes(numberOfNodes)
+    {
+    }
+
+    std::set<size_t>
+    popAll()
+    {
+        std::set<size_t> expired;
+        TimerWheelNode* node = mWheel.popExpired();
+        while (node != nullptr)
+        {
+            EXPECT_FALSE(node->isLinked());
+            EXPECT_LE(node->getExpiry(), mWheel.getCurrentTick());
+            expired.insert(static_cast<size_t>(node - &mNodes[0]));
+            node = mWheel.popExpired();
+        }
+        return expired;
+    }
+
+    /// Random delay with short, level-crossing and out of range values
+    uint64_t
+    randomDelay()
+    {
+        switch (mRandom() % 5)
+        {
+            case 0: return mRandom() % 4;
+            case 1: return mRandom() % TimerWheel::slotsPerLevel;
+            case 2: return mRandom() % (TimerWheel::slotsPerLevel * TimerWheel::slotsPerLevel);
+            case 3: return mRandom() % wheelRange;
+            default: return wheelRange + (mRandom() % (4 * wheelRange));
+        }
+    }
+
+    std::mt19937 mRandom;
+    TimerWheel mWheel;
+    std::vector<TimerWheelNode> mNodes;
+    Model mModel;
+};
+}  // namespace
+
+TEST_F(TimerWheelTest, shouldExpireTimersAtTheirTick)
+{
+    mWheel.add(mNodes[0], 1);
+    mWheel.add(mNodes[1], 100);
+    mWheel.add(mNodes[2], 100);
+    mWheel.add(mNodes[3], 5000);
+    EXPECT_EQ(1U, mWheel.getNextEvent());
+
+    mWheel.advance(99);
+    EXPECT_EQ(std::set<size_t>({0}), popAll());
+
+    mWheel.advance(100);
+    EXPECT_EQ(std::set<size_t>({1, 2}), popAll());
+
+    mWheel.advance(4999);
+    EXPECT_TRUE(popAll().empty());
+    mWheel.advance(5000);
+    EXPECT_EQ(std::set<size_t>({3}), popAll());
+    EXPECT_EQ(TimerWheel::noEvent, mWheel.getNextEvent());
+}
+
+TEST_F(TimerWheelTest, shouldExpirePastTimersImmediately)
+{
+    mWheel.advance(10);
+    mWheel.add(mNodes[0], 10);
+    mWheel.add(mNodes[1], 3);
+    EXPECT_EQ(10U, mWheel.getNextEvent());
+    EXPECT_EQ(std::set<size_t>({0, 1}), popAll());
+}
+
+TEST_F(TimerWheelTest, shouldMoveTimersBeyondTheRange)
+{
+    const uint64_t expiry = 3 * wheelRange + 17;
+    mWheel.add(mNodes[0], expiry);
+
+    mWheel.advance(expiry - 1);
+    EXPECT_TRUE(popAll().empty());
+    EXPECT_TRUE(mNodes[0].isLinked());
+
+    mWheel.advance(expiry);
+    EXPECT_EQ(std::set<size_t>({0}), popAll());
+}
+
+TEST_F(TimerWheelTest, shouldNeverSkipAnExpiry)
+{
+    for (size_t i = 0; i < numberOfNodes; ++i)
+    {
+        const uint64_t expiry = 1 + randomDelay();
+        mWheel.add(mNodes[i], expiry);
+        mModel.add(i, expiry);
+    }
+
+    // Advancing from event to event has to hit every expiry exactly
+    size_t expired = 0;
+    while (mWheel.getNextEvent() != TimerWheel::noEvent)
+    {
+        const uint64_t next = mWheel.getNextEvent();
+        ASSERT_LE(next, mModel.getNextExpiry());
+        mWheel.advance(next);
+
+        const std::set<size_t> popped = popAll();
+        for (size_t node : popped)
+        {
+            EXPECT_EQ(mWheel.getCurrentTick(), mNodes[node].getExpiry());
+        }
+        EXPECT_EQ(mModel.expire(mWheel.getCurrentTick()), popped);
+        expired += popped.size();
+    }
+    EXPECT_EQ(numberOfNodes, expired);
+}
+
+TEST_F(TimerWheelTest, shouldMatchModelForRandomOperations)
+{
+    for (size_t step = 0; step < 20000; ++step)
+    {
+        const size_t node = mRandom() % numberOfNodes;
+        switch (mRandom() % 4)
+        {
+            case 0:
+            case 1:
+            {
+                const uint64_t expiry = mWheel.getCurrentTick() + randomDelay();
+                mWheel.add(mNodes[node], expiry);
+                mModel.add(node, expiry);
+                if (expiry <= mWheel.getCurrentTick())
+                {
+                    // Expired immediately, taken by the next popAll()
+                    mModel.cancel(node);
+                    EXPECT_EQ(std::set<size_t>({node}), popAll());
+                }
+                break;
+            }
+            case 2:
+                mNodes[node].unlink();
+                mModel.cancel(node);
+                break;
+            default:
+            {
+                // Mostly short steps, sometimes across the third level. Each
+                // cascade costs a step, far jumps are tested separately.
+                const uint64_t step3 = TimerWheel::slotsPerLevel * TimerWheel::slotsPerLevel
+                                       * TimerWheel::slotsPerLevel;
+                const uint64_t tick = mWheel.getCurrentTick() + ((mRandom() % 8 == 0)
+                                                                         ? (mRandom() % step3)
+                                                                         : (mRandom() % 200));
+                mWheel.advance(tick);
+                EXPECT_EQ(mModel.expire(tick), popAll());
+                break;
+            }
+        }
+
+        for (size_t i = 0; i < numberOfNodes; ++i)
+        {
+            ASSERT_EQ(mModel.isActive(i), mNodes[i].isLinked()) << "step " << step;
+        }
+
+        const uint64_t next = mWheel.getNextEvent();
+        if (mModel.getNextExpiry() == TimerWheel::noEvent)
+        {
+            ASSERT_EQ(TimerWheel::noEvent, next);
+        }
+        else
+        {
+            ASSERT_LE(next, mModel.getNextExpiry());
+            ASSERT_GT(next, mWheel.getCurrentTick());
+        }
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos/token_bucket_quota.h>
+
+#include <unittest/harness.h>
+#include <unittest/time/testing_clock.h>
+
+using namespace outpost::time;
+using outpost::rtos::TokenBucketQuota;
+
+class TokenBucketQuotaTest : public ::testing::Test
+{
+public:
+    TokenBucketQuotaTest() : mQuota(Seconds(1), 5)
+    {
+        mClock.incrementBy(Seconds(10));
+    }
+
+    size_t
+    accessTimes(size_t n)
+    {
+        size_t granted = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (mQuota.access(mClock.now()))
+            {
+                granted++;
+            }
+        }
+        return granted;
+    }
+
+    unittest::time::TestingClock mClock;
+    TokenBucketQuota mQuota;
+};
+
+TEST_F(TokenBucketQuotaTest, shouldAllowBurstUpToTheLimit)
+{
+    EXPECT_EQ(5U, accessTimes(10));
+}
+
+TEST_F(TokenBucketQuotaTest, shouldRefillContinuously)
+{
+    accessTimes(5);
+
+    // One resource every 200 ms
+    mClock.incrementBy(Milliseconds(199));
+    EXPECT_FALSE(mQuota.access(mClock.now()));
+
+    mClock.incrementBy(Milliseconds(1));
+    EXPECT_TRUE(mQuota.access(mClock.now()));
+    EXPECT_FALSE(mQuota.access(mClock.now()));
+
+    mClock.incrementBy(Milliseconds(600));
+    EXPECT_EQ(3U, accessTimes(5));
+}
+
+TEST_F(TokenBucketQuotaTest, shouldNotSaveUpMoreThanTheLimit)
+{
+    mClock.incrementBy(Seconds(100));
+    EXPECT_EQ(5U, accessTimes(10));
+}
+
+TEST_F(TokenBucketQuotaTest, shouldHandleIntervalsNotDivisibleByTheLimit)
+{
+    TokenBucketQuota quota(Microseconds(10), 3);
+    size_t granted = 0;
+    for (int64_t us = 0; us < 1000; ++us)
+    {
+        if (quota.access(SpacecraftElapsedTime::afterEpoch(Microseconds(1000 + us))))
+        {
+            granted++;
+        }
+    }
+
+    // Initial burst plus three resources every 10 us
+    EXPECT_EQ(3U + 300U - 1U, granted);
+}
+
+TEST_F(TokenBucketQuotaTest, shouldRefillAllResourcesOnReset)
+{
+    accessTimes(5);
+    mQuota.reset();
+    EXPECT_EQ(5U, accessTimes(10));
+}
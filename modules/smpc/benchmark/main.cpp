@@ -0,0 +1,508 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/*
+ * Publish throughput and latency of outpost::smpc.
+ *
+ * One JSON record is written to stdout per measurement, see
+ * outpost::utils::BenchmarkRecord:
+ *
+ *     {"suite":"smpc","benchmark":"Topic","message_size":64,"subscribers":8,
+ *      "publishers":2,"publishes":200000,"publishes_per_second":...,
+ *      "deliveries_per_second":...,"publish_samples":200000,...,"status":"ok"}
+ *
+ * The benchmark is "Topic" for smpc::Topic<T> with smpc::Subscription and
+ * "TopicRaw" for smpc::TopicRaw with smpc::SubscriptionRaw. Every
+ * publisher thread publishes the given number of messages to the same
+ * topic, a single publish is measured from the call until all subscribers
+ * have returned. The subscribers only check and count the message, so
+ * the results show the cost of the dispatch through the subscription list
+ * and the functor of every subscription. A delivery is the call of one
+ * subscriber. The status is "ok" or "failed", the latter if a subscriber
+ * did not receive every message exactly once. The latency statistics of a
+ * single publish have the prefix "publish_".
+ *
+ * Built with OUTPOST_SMPC_STATISTICS the results include the recording
+ * of the statistics.
+ *
+ * Usage:
+ *
+ *     benchmark [subscriber counts [publisher counts [publishes]]]
+ *
+ * with comma separated lists, e.g. "benchmark 1,64 1,4 100000". The
+ * default measures 1 to 64 subscribers with 1, 2 and 4 publishers, each
+ * for messages of 4, 64 and 1024 bytes.
+ */
+
+#include <outpost/rtos/cycle_clock.h>
+#include <outpost/rtos/semaphore.h>
+#include <outpost/rtos/thread.h>
+#include <outpost/smpc/subscription.h>
+#include <outpost/smpc/subscription_raw.h>
+#include <outpost/smpc/topic.h>
+#include <outpost/smpc/topic_raw.h>
+#include <outpost/utils/benchmark/benchmark_record.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+using namespace outpost;
+
+namespace
+{
+constexpr size_t maximumNumberOfSubscribers = 64;
+constexpr size_t maximumNumberOfPublishers = 8;
+
+const size_t defaultSubscriberCounts[] = {1, 2, 4, 8, 16, 32, 64};
+const size_t defaultPublisherCounts[] = {1, 2, 4};
+constexpr size_t defaultNumberOfPublishes = 20000;
+
+// Last byte of every message, the first byte is the index of the publisher
+constexpr uint8_t marker = 0xA5;
+
+// Parameters of the current measurement, set before the publishers are started
+size_t currentNumberOfPublishes = 0;
+
+// Messages received per publisher and subscriber. Each row is only written
+// by the thread of one publisher, as the subscribers are called from there.
+uint32_t received[maximumNumberOfPublishers][maximumNumberOfSubscribers];
+
+template <size_t N>
+struct Message
+{
+    uint8_t mData[N];
+};
+
+class Receiver : public smpc::Subscriber
+{
+public:
+    Receiver() : mIndex(0)
+    {
+    }
+
+    void
+    initialize(size_t index)
+    {
+        mIndex = index;
+    }
+
+    template <size_t N>
+    void
+    receiveMessage(const Message<N>* message)
+    {
+        receive(message->mData, N);
+    }
+
+    void
+    receiveRaw(const void* message, size_t length)
+    {
+        receive(static_cast<const uint8_t*>(message), length);
+    }
+
+private:
+    inline void
+    receive(const uint8_t* data, size_t length)
+    {
+        if ((length >= 2) && (data[length - 1] == marker) && (data[0] < maximumNumberOfPublishers))
+        {
+            received[data[0]][mIndex]++;
+        }
+    }
+
+    size_t mIndex;
+};
+
+Receiver receivers[maximumNumberOfSubscribers];
+
+// Latency of every publish, one list per publisher
+std::vector<rtos::CycleClock::Ticks> samples[maximumNumberOfPublishers];
+
+template <typename Subscription>
+void
+select(Subscription* const* subscriptions, size_t numberOfSubscribers)
+{
+    for (size_t i = 0; i < maximumNumberOfSubscribers; ++i)
+    {
+        if (i < numberOfSubscribers)
+        {
+            subscriptions[i]->connect();
+        }
+        else
+        {
+            subscriptions[i]->disconnect();
+        }
+    }
+}
+
+template <size_t N>
+void
+initializeMessage(Message<N>& message, size_t publisher)
+{
+    memset(message.mData, 0, N);
+    message.mData[0] = static_cast<uint8_t>(publisher);
+    message.mData[N - 1] = marker;
+}
+
+// ---------------------------------------------------------------------------
+/**
+ * smpc::Topic<T> with one smpc::Subscription per receiver.
+ */
+template <size_t N>
+struct TypedTopic
+{
+    static void
+    initialize()
+    {
+        for (size_t i = 0; i < maximumNumberOfSubscribers; ++i)
+        {
+            subscriptions[i] = new smpc::Subscription(
+                    topic, &receivers[i], &Receiver::receiveMessage<N>);
+        }
+    }
+
+    static void
+    selectSubscribers(size_t numberOfSubscribers)
+    {
+        select(subscriptions, numberOfSubscribers);
+    }
+
+    static void
+    publish(size_t publisher)
+    {
+        Message<N> message;
+        initializeMessage(message, publisher);
+        for (size_t i = 0; i < currentNumberOfPublishes; ++i)
+        {
+            const rtos::CycleClock::Ticks start = rtos::CycleClock::now();
+            topic.publish(message);
+            samples[publisher].push_back(rtos::CycleClock::now() - start);
+        }
+    }
+
+    static smpc::Topic<const Message<N>> topic;
+    static smpc::Subscription* subscriptions[maximumNumberOfSubscribers];
+};
+
+template <size_t N>
+smpc::Topic<const Message<N>> TypedTopic<N>::topic;
+
+template <size_t N>
+smpc::Subscription* TypedTopic<N>::subscriptions[maximumNumberOfSubscribers];
+
+/**
+ * smpc::TopicRaw with one smpc::SubscriptionRaw per receiver.
+ */
+template <size_t N>
+struct RawTopic
+{
+    static void
+    initialize()
+    {
+        for (size_t i = 0; i < maximumNumberOfSubscribers; ++i)
+        {
+            subscriptions[i] =
+                    new smpc::SubscriptionRaw(topic, &receivers[i], &Receiver::receiveRaw);
+        }
+    }
+
+    static void
+    selectSubscribers(size_t numberOfSubscribers)
+    {
+        select(subscriptions, numberOfSubscribers);
+    }
+
+    static void
+    publish(size_t publisher)
+    {
+        Message<N> message;
+        initializeMessage(message, publisher);
+        for (size_t i = 0; i < currentNumberOfPublishes; ++i)
+        {
+            const rtos::CycleClock::Ticks start = rtos::CycleClock::now();
+            topic.publish(message.mData, N);
+            samples[publisher].push_back(rtos::CycleClock::now() - start);
+        }
+    }
+
+    static smpc::TopicRaw topic;
+    static smpc::SubscriptionRaw* subscriptions[maximumNumberOfSubscribers];
+};
+
+template <size_t N>
+smpc::TopicRaw RawTopic<N>::topic;
+
+template <size_t N>
+smpc::SubscriptionRaw* RawTopic<N>::subscriptions[maximumNumberOfSubscribers];
+
+struct Benchmark
+{
+    const char* mTopic;
+    size_t mMessageSize;
+    void (*mInitialize)();
+    void (*mSelectSubscribers)(size_t numberOfSubscribers);
+    void (*mPublish)(size_t publisher);
+};
+
+template <template <size_t> class Implementation, size_t N>
+constexpr Benchmark
+makeBenchmark(const char* name)
+{
+    return {name,
+            N,
+            &Implementation<N>::initialize,
+            &Implementation<N>::selectSubscribers,
+            &Implementation<N>::publish};
+}
+
+const Benchmark benchmarks[] = {
+        makeBenchmark<TypedTopic, 4>("Topic"),
+        makeBenchmark<TypedTopic, 64>("Topic"),
+        makeBenchmark<TypedTopic, 1024>("Topic"),
+        makeBenchmark<RawTopic, 4>("TopicRaw"),
+        makeBenchmark<RawTopic, 64>("TopicRaw"),
+        makeBenchmark<RawTopic, 1024>("TopicRaw"),
+};
+
+// ---------------------------------------------------------------------------
+typedef void (*Function)(size_t publisher);
+
+class Publisher : public rtos::Thread
+{
+public:
+    Publisher() :
+        Thread(100, defaultStackSize, "publisher"),
+        mStart(0),
+        mDone(0),
+        mIndex(0),
+        mFunction(nullptr)
+    {
+    }
+
+    void
+    initialize(size_t index)
+    {
+        mIndex = index;
+    }
+
+    void
+    execute(Function function)
+    {
+        mFunction = function;
+        mStart.release();
+    }
+
+    void
+    wait()
+    {
+        mDone.acquire();
+    }
+
+private:
+    virtual void
+    run() override
+    {
+        while (true)
+        {
+            mStart.acquire();
+            mFunction(mIndex);
+            mDone.release();
+        }
+    }
+
+    rtos::Semaphore mStart;
+    rtos::Semaphore mDone;
+    size_t mIndex;
+    Function mFunction;
+};
+
+Publisher publishers[maximumNumberOfPublishers];
+
+double
+toMicroseconds(rtos::CycleClock::Ticks ticks)
+{
+    return static_cast<double>(ticks) * 1e6
+           / static_cast<double>(rtos::CycleClock::getFrequency());
+}
+
+void
+measure(const Benchmark& benchmark,
+        size_t numberOfSubscribers,
+        size_t numberOfPublishers,
+        size_t numberOfPublishes)
+{
+    benchmark.mSelectSubscribers(numberOfSubscribers);
+    memset(received, 0, sizeof(received));
+    for (std::vector<rtos::CycleClock::Ticks>& list : samples)
+    {
+        list.clear();
+        list.reserve(numberOfPublishes);
+    }
+    currentNumberOfPublishes = numberOfPublishes;
+
+    const rtos::CycleClock::Ticks start = rtos::CycleClock::now();
+    for (size_t i = 0; i < numberOfPublishers; ++i)
+    {
+        publishers[i].execute(benchmark.mPublish);
+    }
+    for (size_t i = 0; i < numberOfPublishers; ++i)
+    {
+        publishers[i].wait();
+    }
+    double seconds = toMicroseconds(rtos::CycleClock::now() - start) / 1e6;
+    if (seconds <= 0)
+    {
+        seconds = 1e-6;
+    }
+
+    bool valid = true;
+    for (size_t p = 0; p < maximumNumberOfPublishers; ++p)
+    {
+        for (size_t s = 0; s < maximumNumberOfSubscribers; ++s)
+        {
+            const bool active = (p < numberOfPublishers) && (s < numberOfSubscribers);
+            valid = (received[p][s] == (active ? numberOfPublishes : 0)) && valid;
+        }
+    }
+
+    std::vector<rtos::CycleClock::Ticks> latencies;
+    latencies.reserve(numberOfPublishers * numberOfPublishes);
+    for (size_t i = 0; i < numberOfPublishers; ++i)
+    {
+        latencies.insert(latencies.end(), samples[i].begin(), samples[i].end());
+    }
+    const utils::BenchmarkStatistics statistics = utils::BenchmarkStatistics::calculate(
+            Slice<rtos::CycleClock::Ticks>::unsafe(latencies.data(), latencies.size()), 1);
+
+    const size_t publishes = numberOfPublishers * numberOfPublishes;
+    utils::BenchmarkRecord record("smpc", benchmark.mTopic);
+    record.addInteger("message_size", benchmark.mMessageSize)
+            .addInteger("subscribers", numberOfSubscribers)
+            .addInteger("publishers", numberOfPublishers)
+            .addInteger("publishes", publishes)
+            .addNumber("publishes_per_second", publishes / seconds, 0)
+            .addNumber("deliveries_per_second", (publishes * numberOfSubscribers) / seconds, 0)
+            .addStatistics(statistics, "publish_")
+            .write(valid);
+    fflush(stdout);
+}
+
+/**
+ * Parse a comma separated list of numbers into \p values.
+ *
+ * \return  Number of values, zero if the list is invalid.
+ */
+size_t
+parseList(const char* list, size_t* values, size_t maximumNumberOfValues)
+{
+    size_t count = 0;
+    while ((*list != '\0') && (count < maximumNumberOfValues))
+    {
+        char* end = nullptr;
+        const unsigned long value = strtoul(list, &end, 10);
+        if ((end == list) || ((*end != ',') && (*end != '\0')))
+        {
+            return 0;
+        }
+        values[count++] = value;
+        list = (*end == ',') ? end + 1 : end;
+    }
+    return count;
+}
+
+}  // namespace
+
+int
+main(int argc, char** argv)
+{
+    size_t subscriberCounts[16];
+    size_t numberOfSubscriberCounts =
+            sizeof(defaultSubscriberCounts) / sizeof(defaultSubscriberCounts[0]);
+    std::copy(defaultSubscriberCounts,
+              defaultSubscriberCounts + numberOfSubscriberCounts,
+              subscriberCounts);
+
+    size_t publisherCounts[16];
+    size_t numberOfPublisherCounts =
+            sizeof(defaultPublisherCounts) / sizeof(defaultPublisherCounts[0]);
+    std::copy(defaultPublisherCounts,
+              defaultPublisherCounts + numberOfPublisherCounts,
+              publisherCounts);
+
+    size_t numberOfPublishes = defaultNumberOfPublishes;
+
+    if (argc > 1)
+    {
+        numberOfSubscriberCounts = parseList(argv[1], subscriberCounts, 16);
+    }
+    if (argc > 2)
+    {
+        numberOfPublisherCounts = parseList(argv[2], publisherCounts, 16);
+    }
+    if (argc > 3)
+    {
+        numberOfPublishes = strtoul(argv[3], nullptr, 10);
+    }
+
+    bool validArguments = (numberOfSubscriberCounts > 0) && (numberOfPublisherCounts > 0)
+                          && (numberOfPublishes > 0) && (numberOfPublishes <= UINT32_MAX);
+    for (size_t i = 0; i < numberOfSubscriberCounts; ++i)
+    {
+        validArguments = (subscriberCounts[i] >= 1)
+                         && (subscriberCounts[i] <= maximumNumberOfSubscribers) && validArguments;
+    }
+    for (size_t i = 0; i < numberOfPublisherCounts; ++i)
+    {
+        validArguments = (publisherCounts[i] >= 1)
+                         && (publisherCounts[i] <= maximumNumberOfPublishers) && validArguments;
+    }
+    if (!validArguments)
+    {
+        fprintf(stderr,
+                "usage: %s [subscriber counts [publisher counts [publishes]]]\n"
+                "  subscriber counts: 1..%zu, comma separated\n"
+                "  publisher counts:  1..%zu, comma separated\n",
+                argv[0],
+                maximumNumberOfSubscribers,
+                maximumNumberOfPublishers);
+        return 1;
+    }
+
+    for (size_t i = 0; i < maximumNumberOfSubscribers; ++i)
+    {
+        receivers[i].initialize(i);
+    }
+    for (const Benchmark& benchmark : benchmarks)
+    {
+        benchmark.mInitialize();
+    }
+    for (size_t i = 0; i < maximumNumberOfPublishers; ++i)
+    {
+        publishers[i].initialize(i);
+        publishers[i].start();
+    }
+
+    for (const Benchmark& benchmark : benchmarks)
+    {
+        for (size_t i = 0; i < numberOfPublisherCounts; ++i)
+        {
+            for (size_t k = 0; k < numberOfSubscriberCounts; ++k)
+            {
+                measure(benchmark, subscriberCounts[k], publisherCounts[i], numberOfPublishes);
+            }
+        }
+    }
+
+    // The publisher threads cannot end
+    exit(0);
+}
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_SMPC_ASYNC_SUBSCRIPTION_H
+#define OUTPOST_SMPC_ASYNC_SUBSCRIPTION_H
+
+#include "subscriber.h"
+#include "subscription.h"
+#include "topic.h"
+
+#include <outpost/rtos/mutex.h>
+#include <outpost/rtos/mutex_guard.h>
+#include <outpost/rtos/semaphore.h>
+#include <outpost/time/duration.h>
+#include <outpost/utils/functor.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <utility>
+
+namespace outpost
+{
+namespace smpc
+{
+/**
+ * Behavior of an AsyncSubscription if its mailbox is full.
+ */
+struct OverflowPolicy
+{
+    enum Type
+    {
+        /// Discard the message that is currently published
+        dropNewest,
+        /// Discard the oldest message in the mailbox
+        dropOldest,
+        /// Let the publisher wait for free space
+        block
+    };
+};
+
+/**
+ * Subscription with deferred delivery.
+ *
+ * Published messages are copied into a bounded mailbox in the publisher's
+ * thread and delivered later by calling deliver() from the subscriber's own
+ * worker thread. The publisher latency is therefore independent of the
+ * processing time of the subscriber.
+ *
+ * Uses a regular Subscription internally, so connectSubscriptionsToTopics()
+ * has to be called as for any other subscription. The mailbox state is
+ * reported to Topic::tryPublish(), a full mailbox counts as congested.
+ *
+ * \code
+ * class Component : public outpost::smpc::Subscriber
+ * {
+ *     ...
+ *     outpost::smpc::AsyncSubscription<const Data, 8> mSubscription;
+ * };
+ *
+ * // in the worker thread of Component
+ * while (1)
+ * {
+ *     mSubscription.deliver(outpost::time::Seconds(1));
+ * }
+ * \endcode
+ *
+ * \tparam T
+ *      Type of the topic, must be copyable.
+ * \tparam N
+ *      Number of messages the mailbox can hold.
+ *
+ * \ingroup smpc
+ */
+template <typename T, size_t N>
+class AsyncSubscription : public Subscriber, public CongestionIndicator
+{
+    static_assert(N > 0, "Mailbox must hold at least one message");
+
+public:
+    typedef typename Topic<T>::NonConstType NonConstType;
+
+    /**
+     * \param[in]    topic
+     *         Topic to subscribe to
+     * \param[in]    subscriber
+     *         Subscribing class. Must be a subclass of outpost::smpc::Subscriber.
+     * \param[in]    function
+     *         Member function pointer of the subscribing class, called from deliver().
+     * \param[in]    policy
+     *         Behavior if the mailbox is full.
+     * \param[in]    blockTimeout
+     *         Maximum time a publisher waits for free space with OverflowPolicy::block. The
+     *         message is dropped afterwards.
+     */
+    template <typename S>
+    AsyncSubscription(Topic<T>& topic,
+                      S* subscriber,
+                      typename Subscription::SubscriberFunction<T, S>::Type function,
+                      OverflowPolicy::Type policy = OverflowPolicy::dropNewest,
+                      outpost::time::Duration blockTimeout = outpost::time::Duration::infinity()) :
+        mTarget(*reinterpret_cast<Subscriber*>(subscriber),
+                reinterpret_cast<Function>(function)),
+        mPolicy(policy),
+        mBlockTimeout(blockTimeout),
+        mItems(0),
+        mFreeSlots(N),
+        mHead(0),
+        mNumberOfItems(0),
+        mMaximumNumberOfItems(0),
+        mNumberOfDroppedMessages(0),
+        mSubscription(topic, this, &AsyncSubscription::onMessage)
+    {
+        mSubscription.setCongestionIndicator(this);
+    }
+
+    // disable copy constructor
+    AsyncSubscription(const AsyncSubscription&) = delete;
+
+    // disable assignment operator
+    AsyncSubscription&
+    operator=(const AsyncSubscription&) = delete;
+
+    /**
+     * Deliver the oldest message to the subscriber.
+     *
+     * \param timeout
+     *      Maximum time to wait for a message.
+     *
+     * \retval true     A message was delivered.
+     * \retval false    Timeout occurred.
+     */
+    bool
+    deliver(outpost::time::Duration timeout = outpost::time::Duration::zero())
+    {
+        if (!mItems.acquire(timeout))
+        {
+            return false;
+        }
+
+        NonConstType message;
+        {
+            outpost::rtos::MutexGuard lock(mMutex);
+            // Moving releases resources held by the slot, e.g. the
+            // reference of a SharedBufferPointer
+            message = std::move(mMailbox[mHead]);
+            mHead = (mHead + 1) % N;
+            mNumberOfItems--;
+        }
+        if (mPolicy == OverflowPolicy::block)
+        {
+            mFreeSlots.release();
+        }
+
+        mTarget.execute(&message);
+        return true;
+    }
+
+    /**
+     * Deliver all pending messages without waiting.
+     *
+     * \return Number of delivered messages.
+     */
+    size_t
+    deliverAll()
+    {
+        size_t count = 0;
+        while (deliver(outpost::time::Duration::zero()))
+        {
+            count++;
+        }
+        return count;
+    }
+
+    inline size_t
+    getNumberOfPendingMessages()
+    {
+        outpost::rtos::MutexGuard lock(mMutex);
+        return mNumberOfItems;
+    }
+
+    static constexpr size_t
+    getCapacity()
+    {
+        return N;
+    }
+
+    /**
+     * \return Highest number of pending messages since the last call of
+     *         resetErrorCounters().
+     */
+    inline size_t
+    getMaximumNumberOfPendingMessages()
+    {
+        outpost::rtos::MutexGuard lock(mMutex);
+        return mMaximumNumberOfItems;
+    }
+
+    /**
+     * \retval true    The mailbox is full, the next message is dropped or
+     *                  blocks the publisher depending on the policy.
+     */
+    virtual bool
+    isCongested() const override
+    {
+        outpost::rtos::MutexGuard lock(mMutex);
+        return mNumberOfItems >= N;
+    }
+
+    /**
+     * \return Number of messages lost because the mailbox was full.
+     */
+    inline uint32_t
+    getNumberOfDroppedMessages()
+    {
+        outpost::rtos::MutexGuard lock(mMutex);
+        return mNumberOfDroppedMessages;
+    }
+
+    inline void
+    resetErrorCounters()
+    {
+        outpost::rtos::MutexGuard lock(mMutex);
+        mNumberOfDroppedMessages = 0;
+        mMaximumNumberOfItems = mNumberOfItems;
+    }
+
+private:
+    typedef void (Subscriber::*Function)(void*);
+
+    void
+    onMessage(T* message)
+    {
+        if (mPolicy == OverflowPolicy::block && !mFreeSlots.acquire(mBlockTimeout))
+        {
+            outpost::rtos::MutexGuard lock(mMutex);
+            mNumberOfDroppedMessages++;
+            return;
+        }
+
+        bool stored = true;
+        {
+            outpost::rtos::MutexGuard lock(mMutex);
+            if (mNumberOfItems < N)
+            {
+                mMailbox[(mHead + mNumberOfItems) % N] = *message;
+                mNumberOfItems++;
+                if (mNumberOfItems > mMaximumNumberOfItems)
+                {
+                    mMaximumNumberOfItems = mNumberOfItems;
+                }
+            }
+            else if (mPolicy == OverflowPolicy::dropOldest)
+            {
+                // overwrite the oldest message, the number of items is unchanged
+                mMailbox[mHead] = *message;
+                mHead = (mHead + 1) % N;
+                mNumberOfDroppedMessages++;
+                stored = false;
+            }
+            else
+            {
+                mNumberOfDroppedMessages++;
+                stored = false;
+            }
+        }
+
+        if (stored)
+        {
+            mItems.release();
+        }
+    }
+
+    const Functor1<void(void*)> mTarget;
+    const OverflowPolicy::Type mPolicy;
+    const outpost::time::Duration mBlockTimeout;
+
+    mutable outpost::rtos::Mutex mMutex;
+    outpost::rtos::Semaphore mItems;
+    outpost::rtos::Semaphore mFreeSlots;
+
+    std::array<NonConstType, N> mMailbox;
+    size_t mHead;
+    size_t mNumberOfItems;
+    size_t mMaximumNumberOfItems;
+    uint32_t mNumberOfDroppedMessages;
+
+    Subscription mSubscription;
+};
+
+}  // namespace smpc
+}  // namespace outpost
+
+#endif
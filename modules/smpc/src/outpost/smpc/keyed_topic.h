@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_SMPC_KEYED_TOPIC_H
+#define OUTPOST_SMPC_KEYED_TOPIC_H
+
+#include "topic.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/rtos/atomic.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+
+namespace outpost
+{
+namespace smpc
+{
+/**
+ * %Topic with targeted delivery.
+ *
+ * Every message carries a key, e.g. the source of a heartbeat, which is
+ * extracted by a user supplied function. Subscriptions created with a key
+ * are only called for messages with the same key, they are kept in a hash
+ * table so a publish operation only visits the subscriptions of one bucket
+ * instead of all subscriptions.
+ *
+ * Subscriptions without a key receive all messages as for a normal topic.
+ *
+ * \code
+ * uint32_t
+ * getSource(const Heartbeat& heartbeat)
+ * {
+ *     return heartbeat.mSource;
+ * }
+ *
+ * outpost::smpc::KeyedTopic<const Heartbeat> heartbeatTopic(&getSource);
+ *
+ * outpost::smpc::Subscription subscription(
+ *         heartbeatTopic, mySource, this, &Component::onHeartbeat);
+ * \endcode
+ *
+ * \tparam T
+ *      Type of the topic.
+ * \tparam numberOfBuckets
+ *      Size of the hash table. Keys are mapped with key % numberOfBuckets.
+ *
+ * \ingroup smpc
+ */
+template <typename T, size_t numberOfBuckets = 8>
+class KeyedTopic : public Topic<T>
+{
+    static_assert(numberOfBuckets > 0, "At least one bucket required");
+
+public:
+    typedef uint32_t (*KeyFunction)(const typename Topic<T>::NonConstType& message);
+
+    explicit KeyedTopic(KeyFunction keyFunction) : Topic<T>(), mBuckets(), mKeyFunction(keyFunction)
+    {
+        TopicBase::setKeyIndex(outpost::asSlice(mBuckets), &KeyedTopic::getKey);
+    }
+
+    ~KeyedTopic() = default;
+
+    // disable copy constructor
+    KeyedTopic(const KeyedTopic&) = delete;
+
+    // disable assignment operator
+    KeyedTopic&
+    operator=(const KeyedTopic&) = delete;
+
+private:
+    static uint32_t
+    getKey(const TopicBase& topic, const void* message)
+    {
+        typedef typename Topic<T>::NonConstType NonConstType;
+        return static_cast<const KeyedTopic&>(topic).mKeyFunction(
+                *static_cast<const NonConstType*>(message));
+    }
+
+    std::array<rtos::Atomic<Subscription*>, numberOfBuckets> mBuckets;
+    const KeyFunction mKeyFunction;
+};
+
+}  // namespace smpc
+}  // namespace outpost
+
+#endif
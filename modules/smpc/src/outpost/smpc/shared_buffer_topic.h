@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_SMPC_SHARED_BUFFER_TOPIC_H
+#define OUTPOST_SMPC_SHARED_BUFFER_TOPIC_H
+
+#include "topic.h"
+
+#include <outpost/utils/container/shared_buffer.h>
+
+namespace outpost
+{
+namespace smpc
+{
+/**
+ * %Topic distributing reference counted buffers.
+ *
+ * In contrast to TopicRaw the payload stays valid after the publish
+ * operation: a subscriber keeps the data by copying the received
+ * SharedBufferPointer, which only increments the reference counter. The
+ * buffer returns to its pool once the last copy is destroyed.
+ *
+ * Combined with an AsyncSubscription the payload is passed to other
+ * threads without copying it:
+ *
+ * \code
+ * outpost::smpc::SharedBufferTopic telemetryTopic;
+ *
+ * class Downlink : public outpost::smpc::Subscriber
+ * {
+ *     ...
+ *     void
+ *     onPacket(const outpost::utils::SharedBufferPointer* packet);
+ *
+ *     outpost::smpc::AsyncSubscription<const outpost::utils::SharedBufferPointer, 16>
+ *             mSubscription;
+ * };
+ * \endcode
+ *
+ * \warning
+ *      All subscribers share the same memory. Subscribers must not
+ *      modify the payload, publishers must not modify it after the
+ *      publish operation.
+ *
+ * \ingroup smpc
+ */
+typedef Topic<const outpost::utils::SharedBufferPointer> SharedBufferTopic;
+
+}  // namespace smpc
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_SMPC_STATIC_TOPIC_H
+#define OUTPOST_SMPC_STATIC_TOPIC_H
+
+namespace outpost
+{
+namespace smpc
+{
+/**
+ * Subscription known at compile time.
+ *
+ * Binds a member function of an object with static storage duration.
+ * Only used as type in the subscriber list of a StaticTopic, no instance
+ * is ever created.
+ *
+ * \tparam T
+ *      Type of the topic.
+ * \tparam S
+ *      Subscribing class.
+ * \tparam object
+ *      Subscribing object.
+ * \tparam function
+ *      Member function called for every message.
+ *
+ * \ingroup smpc
+ */
+template <typename T, typename S, S& object, void (S::*function)(T* message)>
+struct StaticSubscription
+{
+    static inline void
+    execute(T* message)
+    {
+        (object.*function)(message);
+    }
+};
+
+namespace internal
+{
+template <typename T, typename... Subscriptions>
+struct StaticDispatcher;
+
+template <typename T>
+struct StaticDispatcher<T>
+{
+    static inline void
+    execute(T*)
+    {
+    }
+};
+
+template <typename T, typename First, typename... Others>
+struct StaticDispatcher<T, First, Others...>
+{
+    static inline void
+    execute(T* message)
+    {
+        First::execute(message);
+        StaticDispatcher<T, Others...>::execute(message);
+    }
+};
+}  // namespace internal
+
+/**
+ * %Topic with a subscriber list fixed at compile time.
+ *
+ * All subscriptions are part of the type, a publish operation expands to
+ * direct calls of the subscriber functions in the given order. The
+ * compiler can inline them, there is neither a list walk nor an indirect
+ * call. Intended for fixed configurations where all connections are known
+ * when building the software.
+ *
+ * The topic itself has no state. No registration and no call to
+ * Subscription::connectSubscriptionsToTopics() is necessary, also the
+ * topic can not be changed at runtime.
+ *
+ * \code
+ * Component component;
+ * Logger logger;
+ *
+ * typedef outpost::smpc::StaticTopic<
+ *         const Data,
+ *         outpost::smpc::StaticSubscription<const Data, Component, component,
+ *                                           &Component::onData>,
+ *         outpost::smpc::StaticSubscription<const Data, Logger, logger, &Logger::onData>>
+ *         DataTopic;
+ *
+ * DataTopic::publish(data);
+ * \endcode
+ *
+ * \tparam T
+ *      Type of the topic.
+ * \tparam Subscriptions
+ *      Types providing a static execute(T*) function, see
+ *      StaticSubscription.
+ *
+ * \ingroup smpc
+ */
+template <typename T, typename... Subscriptions>
+class StaticTopic
+{
+public:
+    /// Type of the data distributed by this topic.
+    typedef T Type;
+
+    static constexpr unsigned int numberOfSubscriptions = sizeof...(Subscriptions);
+
+    /**
+     * Forward the message to all subscribers.
+     */
+    static inline void
+    publish(T& message)
+    {
+        internal::StaticDispatcher<T, Subscriptions...>::execute(&message);
+    }
+};
+
+template <typename T, typename... Subscriptions>
+constexpr unsigned int StaticTopic<T, Subscriptions...>::numberOfSubscriptions;
+
+}  // namespace smpc
+}  // namespace outpost
+
+#endif
@@ -35,6 +35,28 @@ class Subscriber
 {
 };
 
+/**
+ * Reports whether a subscriber currently falls behind.
+ *
+ * Implemented by subscribers that buffer messages, e.g.
+ * AsyncSubscription. Queried by Topic::tryPublish() before a message is
+ * published.
+ *
+ * \ingroup smpc
+ */
+class CongestionIndicator
+{
+public:
+    virtual ~CongestionIndicator() = default;
+
+    /**
+     * \retval true    The next message would be dropped or block the
+     *                  publisher.
+     */
+    virtual bool
+    isCongested() const = 0;
+};
+
 }  // namespace smpc
 }  // namespace outpost
 
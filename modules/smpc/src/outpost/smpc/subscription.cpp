@@ -13,36 +13,157 @@
 
 #include "subscription.h"
 
+#include <outpost/rtos/mutex_guard.h>
+
 outpost::smpc::Subscription* outpost::smpc::Subscription::listOfAllSubscriptions = 0;
 
+constexpr outpost::smpc::Subscription::Priority outpost::smpc::Subscription::defaultPriority;
+
 outpost::smpc::Subscription::~Subscription()
 {
     removeFromList(&Subscription::listOfAllSubscriptions, this);
+    disconnect();
+}
 
-    // TODO
-    releaseAllSubscriptions();
-    connectSubscriptionsToTopics();
+void
+outpost::smpc::Subscription::connect()
+{
+#ifdef OUTPOST_SMPC_STATISTICS
+    const time::SpacecraftElapsedTime start = StatisticsClock::now();
+    rtos::MutexGuard lock(mTopic->mMutex);
+    mTopic->mStatistics.recordMutexWait(StatisticsClock::now() - start);
+#else
+    rtos::MutexGuard lock(mTopic->mMutex);
+#endif
+    attach();
+}
+
+void
+outpost::smpc::Subscription::disconnect()
+{
+    // Subscriptions released by releaseAllSubscriptions() do not touch
+    // their topic, it might already be destroyed.
+    if (mConnected)
+    {
+#ifdef OUTPOST_SMPC_STATISTICS
+        const time::SpacecraftElapsedTime start = StatisticsClock::now();
+        rtos::MutexGuard lock(mTopic->mMutex);
+        mTopic->mStatistics.recordMutexWait(StatisticsClock::now() - start);
+#else
+        rtos::MutexGuard lock(mTopic->mMutex);
+#endif
+        detach();
+    }
+}
+
+void
+outpost::smpc::Subscription::attach()
+{
+    if (!mConnected)
+    {
+        // Insert in front of the first subscription with the same or a
+        // lower priority
+        rtos::Atomic<Subscription*>& list = getTopicList();
+        Subscription* previous = nullptr;
+        Subscription* next = list.load();
+        while (next != nullptr && next->mPriority > mPriority)
+        {
+            previous = next;
+            next = next->mNextTopicSubscription.load();
+        }
+
+        // link before publishing to keep the list consistent for publishers
+        mPreviousTopicSubscription = previous;
+        mNextTopicSubscription.store(next);
+        if (next != nullptr)
+        {
+            next->mPreviousTopicSubscription = this;
+        }
+        if (previous != nullptr)
+        {
+            previous->mNextTopicSubscription.store(this);
+        }
+        else
+        {
+            list.store(this);
+        }
+        mConnected = true;
+    }
+}
+
+void
+outpost::smpc::Subscription::detach()
+{
+    if (mConnected)
+    {
+        Subscription* next = mNextTopicSubscription.load();
+        if (mPreviousTopicSubscription != nullptr)
+        {
+            mPreviousTopicSubscription->mNextTopicSubscription.store(next);
+        }
+        else
+        {
+            getTopicList().store(next);
+        }
+        if (next != nullptr)
+        {
+            next->mPreviousTopicSubscription = mPreviousTopicSubscription;
+        }
+
+        // mNextTopicSubscription is kept for publishers currently
+        // delivering to this subscription
+        mPreviousTopicSubscription = nullptr;
+        mConnected = false;
+    }
+}
+
+void
+outpost::smpc::Subscription::setPriority(Priority priority)
+{
+    rtos::MutexGuard lock(mTopic->mMutex);
+    if (mConnected)
+    {
+        detach();
+        mPriority = priority;
+        attach();
+    }
+    else
+    {
+        mPriority = priority;
+    }
+}
+
+outpost::rtos::Atomic<outpost::smpc::Subscription*>&
+outpost::smpc::Subscription::getTopicList()
+{
+    if (mKeyed)
+    {
+        const size_t numberOfBuckets = mTopic->mKeyedSubscriptions.getNumberOfElements();
+        return mTopic->mKeyedSubscriptions[mKey % numberOfBuckets];
+    }
+    return mTopic->mSubscriptions;
 }
 
 void
 outpost::smpc::Subscription::connectSubscriptionsToTopics()
 {
     // Reset the lists in the topics
-    TopicBase::clearSubscriptions();
+    releaseAllSubscriptions();
 
-    for (Subscription* it = Subscription::listOfAllSubscriptions; it != 0; it = it->getNext())
+    for (Subscription* it = listOfAllSubscriptions; it != 0; it = it->getNext())
     {
-        it->mNextTopicSubscription = it->mTopic->mSubscriptions;
-        it->mTopic->mSubscriptions = it;
+        it->connect();
     }
 }
 
 void
 outpost::smpc::Subscription::releaseAllSubscriptions()
 {
-    for (Subscription* it = Subscription::listOfAllSubscriptions; it != 0; it = it->getNext())
+    for (Subscription* it = listOfAllSubscriptions; it != 0; it = it->getNext())
     {
-        it->mNextTopicSubscription = 0;
+        it->mNextTopicSubscription.store(nullptr);
+        it->mPreviousTopicSubscription = nullptr;
+        it->mConnected = false;
     }
 
     TopicBase::clearSubscriptions();
@@ -18,12 +18,20 @@
 #include "subscriber.h"
 #include "topic.h"
 
+#include <outpost/base/slice.h>
 #include <outpost/utils/functor.h>
 
+#include <stddef.h>
+#include <stdint.h>
+
 namespace outpost
 {
 namespace smpc
 {
+// forward declaration
+template <typename T, size_t numberOfBuckets>
+class KeyedTopic;
+
 /**
  * Subscription to a topic.
  *
@@ -47,12 +55,23 @@ public:
     friend class SubscriptionRaw;
     friend class ImplicitList<Subscription>;
 
+    /// Subscriptions with a higher priority are called first
+    typedef uint8_t Priority;
+
+    static constexpr Priority defaultPriority = 0;
+
     template <typename T, typename S>
     struct SubscriberFunction
     {
         typedef void (S::*Type)(typename Topic<T>::Type* message);
     };
 
+    template <typename T, typename S>
+    struct SubscriberBatchFunction
+    {
+        typedef void (S::*Type)(outpost::Slice<typename Topic<T>::Type> messages);
+    };
+
     /**
      * Constructor.
      *
@@ -68,9 +87,53 @@ public:
     template <typename T, typename S>
     Subscription(Topic<T>& topic, S* subscriber, typename SubscriberFunction<T, S>::Type function);
 
+    /**
+     * Constructor for subscribers that accept several messages at once.
+     *
+     * A batch published with Topic::publishBatch() is handed to the
+     * function in a single call, a single published message is passed
+     * as slice of length one.
+     *
+     * \param[in]    topic
+     *         Topic to subscribe to
+     * \param[in]    subscriber
+     *         Subscribing class. Must be a subclass of outpost::smpc::Subscriber.
+     * \param[in]    function
+     *         Member function pointer of the subscribing class.
+     */
+    template <typename T, typename S>
+    Subscription(Topic<T>& topic,
+                 S* subscriber,
+                 typename SubscriberBatchFunction<T, S>::Type function);
+
+    /**
+     * Constructor for a filtered subscription.
+     *
+     * Only messages for which the key function of the topic returns
+     * \p key are delivered. The topic does not call this subscription
+     * for other messages at all.
+     *
+     * \param[in]    topic
+     *         Keyed topic to subscribe to
+     * \param[in]    key
+     *         Key of the messages to receive
+     * \param[in]    subscriber
+     *         Subscribing class. Must be a subclass of outpost::smpc::Subscriber.
+     * \param[in]    function
+     *         Member function pointer of the subscribing class.
+     */
+    template <typename T, size_t numberOfBuckets, typename S>
+    Subscription(KeyedTopic<T, numberOfBuckets>& topic,
+                 uint32_t key,
+                 S* subscriber,
+                 typename SubscriberFunction<T, S>::Type function);
+
     /**
      * Destroy the subscription
      *
+     * Detaches the subscription from its topic, see disconnect(). Other
+     * subscriptions are not affected.
+     *
      * \warning
      *     The destruction and creation of subscriptions during the normal
      *     runtime is not thread-safe. If topics need to be
@@ -80,6 +143,31 @@ public:
      */
     ~Subscription();
 
+    /**
+     * Attach this subscription to its topic.
+     *
+     * Only modifies the list of the subscribed topic. The subscription
+     * is placed behind all subscriptions with a higher priority, so the
+     * effort grows with their number. May be used during operation to
+     * activate a subscription, publishers on the topic are not blocked.
+     * Does nothing if the subscription is already connected.
+     */
+    void
+    connect();
+
+    /**
+     * Detach this subscription from its topic.
+     *
+     * Counterpart to connect(), O(1).
+     *
+     * \warning
+     *     A publisher of the topic running concurrently might still
+     *     deliver one last message. The subscriber must therefore stay
+     *     valid until such publish operations have finished.
+     */
+    void
+    disconnect();
+
     /**
      * Connect all subscriptions to it's assigned topic.
      *
@@ -92,6 +180,49 @@ public:
     static void
     connectSubscriptionsToTopics();
 
+    /**
+     * Change the position of this subscription in the delivery order.
+     *
+     * The topic calls subscriptions with a higher priority first,
+     * subscriptions with the same priority in the reverse order of
+     * connecting them. Use this to keep the latency low for critical
+     * subscribers (e.g. FDIR) without splitting a topic. Work that can be
+     * postponed is better handled with an AsyncSubscription.
+     *
+     * Should be set before connecting the subscription. A connected
+     * subscription is moved, a publish operation running at the same time
+     * may then call some subscriptions twice or not at all.
+     */
+    void
+    setPriority(Priority priority);
+
+    inline Priority
+    getPriority() const
+    {
+        return mPriority;
+    }
+
+    /**
+     * Let Topic::tryPublish() query the state of this subscriber.
+     *
+     * \param indicator
+     *      Must stay valid while the subscription exists, nullptr to
+     *      remove it.
+     */
+    inline void
+    setCongestionIndicator(const CongestionIndicator* indicator)
+    {
+        mCongestionIndicator = indicator;
+    }
+
+#ifdef OUTPOST_SMPC_STATISTICS
+    inline const CallbackStatistics&
+    getStatistics() const
+    {
+        return mStatistics;
+    }
+#endif
+
     /**
      * Release all subscriptions.
      *
@@ -112,10 +243,51 @@ protected:
     inline void
     execute(void* message) const
     {
-        mFunctor.execute(message);
+        if (mBatchInvoker != nullptr)
+        {
+            mBatchInvoker(*mSubscriber, mBatchFunction, message, 1);
+        }
+        else
+        {
+            mFunctor.execute(message);
+        }
+    }
+
+    /**
+     * Relay several messages, one call for batch subscribers and one
+     * call per message otherwise.
+     */
+    inline void
+    executeBatch(void* messages, size_t numberOfMessages, size_t elementSize) const
+    {
+        if (mBatchInvoker != nullptr)
+        {
+            mBatchInvoker(*mSubscriber, mBatchFunction, messages, numberOfMessages);
+        }
+        else
+        {
+            uint8_t* message = static_cast<uint8_t*>(messages);
+            for (size_t i = 0; i < numberOfMessages; i++)
+            {
+                mFunctor.execute(message);
+                message += elementSize;
+            }
+        }
     }
 
 private:
+    /// Link into the topic list, the topic mutex must be held
+    void
+    attach();
+
+    /// Unlink from the topic list, the topic mutex must be held
+    void
+    detach();
+
+    /// Head of the topic list this subscription belongs to
+    rtos::Atomic<Subscription*>&
+    getTopicList();
+
     // Disable default constructor
     Subscription();
 
@@ -134,7 +306,27 @@ private:
      * subscriptions to their corresponding topics.
      */
     TopicBase* const mTopic;
-    Subscription* mNextTopicSubscription;
+
+    /// Read by publishers without a lock
+    rtos::Atomic<Subscription*> mNextTopicSubscription;
+
+    /// Only used to detach in O(1), protected by the topic mutex
+    Subscription* mPreviousTopicSubscription;
+    bool mConnected;
+
+    /// Only messages with this key are delivered if mKeyed is set
+    const uint32_t mKey;
+    const bool mKeyed;
+
+    /// Protected by the topic mutex
+    Priority mPriority;
+
+    const CongestionIndicator* mCongestionIndicator;
+
+#ifdef OUTPOST_SMPC_STATISTICS
+    /// Updated by the publishers of the topic
+    CallbackStatistics mStatistics;
+#endif
 
     /**
      * Base-type to cast all member function pointers to. The correct type
@@ -145,7 +337,41 @@ private:
      */
     typedef void (Subscriber::*Function)(void*);
 
+    /**
+     * Restores the types of a batch subscriber function, one instance
+     * per topic and subscriber type.
+     */
+    // Generic member function type, only used to store the batch function
+    typedef void (Subscriber::*BatchFunctionBase)();
+
+    typedef void (*BatchInvoker)(Subscriber& subscriber,
+                                 BatchFunctionBase function,
+                                 void* messages,
+                                 size_t numberOfMessages);
+
+// The batch function is cast back to its original type before the call.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wcast-function-type"
+    template <typename T, typename S>
+    static void
+    invokeBatch(Subscriber& subscriber,
+                BatchFunctionBase function,
+                void* messages,
+                size_t numberOfMessages)
+    {
+        typedef typename Topic<T>::Type Type;
+        typedef typename SubscriberBatchFunction<T, S>::Type BatchFunction;
+        (reinterpret_cast<S&>(subscriber).*reinterpret_cast<BatchFunction>(function))(
+                outpost::Slice<Type>::unsafe(static_cast<Type*>(messages), numberOfMessages));
+    }
+#pragma GCC diagnostic pop
+
     const Functor1<void(void*)> mFunctor;
+
+    /// Only used by batch subscriptions, otherwise nullptr
+    Subscriber* const mSubscriber;
+    const BatchFunctionBase mBatchFunction;
+    const BatchInvoker mBatchInvoker;
 };
 
 }  // namespace smpc
@@ -159,8 +385,61 @@ outpost::smpc::Subscription::Subscription(Topic<T>& topic,
                                           typename SubscriberFunction<T, S>::Type function) :
     ImplicitList<Subscription>(listOfAllSubscriptions, this),
     mTopic(&topic),
-    mNextTopicSubscription(0),
-    mFunctor(*reinterpret_cast<Subscriber*>(subscriber), reinterpret_cast<Function>(function))
+    mNextTopicSubscription(nullptr),
+    mPreviousTopicSubscription(nullptr),
+    mConnected(false),
+    mKey(0),
+    mKeyed(false),
+    mPriority(defaultPriority),
+    mCongestionIndicator(nullptr),
+    mFunctor(*reinterpret_cast<Subscriber*>(subscriber), reinterpret_cast<Function>(function)),
+    mSubscriber(nullptr),
+    mBatchFunction(nullptr),
+    mBatchInvoker(nullptr)
+{
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wcast-function-type"
+template <typename T, typename S>
+outpost::smpc::Subscription::Subscription(Topic<T>& topic,
+                                          S* subscriber,
+                                          typename SubscriberBatchFunction<T, S>::Type function) :
+    ImplicitList<Subscription>(listOfAllSubscriptions, this),
+    mTopic(&topic),
+    mNextTopicSubscription(nullptr),
+    mPreviousTopicSubscription(nullptr),
+    mConnected(false),
+    mKey(0),
+    mKeyed(false),
+    mPriority(defaultPriority),
+    mCongestionIndicator(nullptr),
+    mFunctor(),
+    mSubscriber(reinterpret_cast<Subscriber*>(subscriber)),
+    mBatchFunction(reinterpret_cast<BatchFunctionBase>(function)),
+    mBatchInvoker(&Subscription::invokeBatch<T, S>)
+{
+}
+#pragma GCC diagnostic pop
+
+template <typename T, size_t numberOfBuckets, typename S>
+outpost::smpc::Subscription::Subscription(KeyedTopic<T, numberOfBuckets>& topic,
+                                          uint32_t key,
+                                          S* subscriber,
+                                          typename SubscriberFunction<T, S>::Type function) :
+    ImplicitList<Subscription>(listOfAllSubscriptions, this),
+    mTopic(&static_cast<Topic<T>&>(topic)),
+    mNextTopicSubscription(nullptr),
+    mPreviousTopicSubscription(nullptr),
+    mConnected(false),
+    mKey(key),
+    mKeyed(true),
+    mPriority(defaultPriority),
+    mCongestionIndicator(nullptr),
+    mFunctor(*reinterpret_cast<Subscriber*>(subscriber), reinterpret_cast<Function>(function)),
+    mSubscriber(nullptr),
+    mBatchFunction(nullptr),
+    mBatchInvoker(nullptr)
 {
 }
 
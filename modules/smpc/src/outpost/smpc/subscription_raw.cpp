@@ -13,25 +13,100 @@
 
 #include "subscription_raw.h"
 
+#include <outpost/rtos/mutex_guard.h>
+
 outpost::smpc::SubscriptionRaw* outpost::smpc::SubscriptionRaw::listOfAllSubscriptions = 0;
 
 outpost::smpc::SubscriptionRaw::~SubscriptionRaw()
 {
     removeFromList(&SubscriptionRaw::listOfAllSubscriptions, this);
+    disconnect();
+}
 
-    releaseAllSubscriptions();
-    connectSubscriptionsToTopics();
+void
+outpost::smpc::SubscriptionRaw::connect()
+{
+#ifdef OUTPOST_SMPC_STATISTICS
+    const time::SpacecraftElapsedTime start = StatisticsClock::now();
+    rtos::MutexGuard lock(mTopic->mMutex);
+    mTopic->mStatistics.recordMutexWait(StatisticsClock::now() - start);
+#else
+    rtos::MutexGuard lock(mTopic->mMutex);
+#endif
+    attach();
+}
+
+void
+outpost::smpc::SubscriptionRaw::disconnect()
+{
+    // Subscriptions released by releaseAllSubscriptions() do not touch
+    // their topic, it might already be destroyed.
+    if (mConnected)
+    {
+#ifdef OUTPOST_SMPC_STATISTICS
+        const time::SpacecraftElapsedTime start = StatisticsClock::now();
+        rtos::MutexGuard lock(mTopic->mMutex);
+        mTopic->mStatistics.recordMutexWait(StatisticsClock::now() - start);
+#else
+        rtos::MutexGuard lock(mTopic->mMutex);
+#endif
+        detach();
+    }
+}
+
+void
+outpost::smpc::SubscriptionRaw::attach()
+{
+    if (!mConnected)
+    {
+        // link before publishing to keep the list consistent for publishers
+        SubscriptionRaw* head = mTopic->mSubscriptions.load();
+        mPreviousTopicSubscription = nullptr;
+        mNextTopicSubscription.store(head);
+        if (head != nullptr)
+        {
+            head->mPreviousTopicSubscription = this;
+        }
+        mTopic->mSubscriptions.store(this);
+        mConnected = true;
+    }
+}
+
+void
+outpost::smpc::SubscriptionRaw::detach()
+{
+    if (mConnected)
+    {
+        SubscriptionRaw* next = mNextTopicSubscription.load();
+        if (mPreviousTopicSubscription != nullptr)
+        {
+            mPreviousTopicSubscription->mNextTopicSubscription.store(next);
+        }
+        else
+        {
+            mTopic->mSubscriptions.store(next);
+        }
+        if (next != nullptr)
+        {
+            next->mPreviousTopicSubscription = mPreviousTopicSubscription;
+        }
+
+        // mNextTopicSubscription is kept for publishers currently
+        // delivering to this subscription
+        mPreviousTopicSubscription = nullptr;
+        mConnected = false;
+    }
 }
 
 void
 outpost::smpc::SubscriptionRaw::connectSubscriptionsToTopics()
 {
-    TopicRaw::clearSubscriptions();
+    // Reset the lists in the topics
+    releaseAllSubscriptions();
 
     for (SubscriptionRaw* it = listOfAllSubscriptions; it != 0; it = it->getNext())
     {
-        it->mNextTopicSubscription = it->mTopic->mSubscriptions;
-        it->mTopic->mSubscriptions = it;
+        it->connect();
     }
 }
 
@@ -40,7 +115,9 @@ outpost::smpc::SubscriptionRaw::releaseAllSubscriptions()
 {
     for (SubscriptionRaw* it = listOfAllSubscriptions; it != 0; it = it->getNext())
     {
-        it->mNextTopicSubscription = 0;
+        it->mNextTopicSubscription.store(nullptr);
+        it->mPreviousTopicSubscription = nullptr;
+        it->mConnected = false;
     }
 
     TopicRaw::clearSubscriptions();
@@ -64,6 +64,9 @@ public:
     /**
      * Destroy the subscription
      *
+     * Detaches the subscription from its topic, see disconnect(). Other
+     * subscriptions are not affected.
+     *
      * \warning    The destruction and creation of subscriptions during the normal
      *             runtime is not thread-safe. If topics need to be
      *             destroyed outside the initialization of the application
@@ -72,6 +75,30 @@ public:
      */
     ~SubscriptionRaw();
 
+    /**
+     * Attach this subscription to its topic.
+     *
+     * Only modifies the list of the subscribed topic, O(1). May be used
+     * during operation to activate a subscription, publishers on the topic
+     * are not blocked. Does nothing if the subscription is already
+     * connected.
+     */
+    void
+    connect();
+
+    /**
+     * Detach this subscription from its topic.
+     *
+     * Counterpart to connect(), O(1).
+     *
+     * \warning
+     *     A publisher of the topic running concurrently might still
+     *     deliver one last message. The subscriber must therefore stay
+     *     valid until such publish operations have finished.
+     */
+    void
+    disconnect();
+
     /**
      * Connect all subscriptions to it's assigned topic.
      *
@@ -84,6 +111,14 @@ public:
     static void
     connectSubscriptionsToTopics();
 
+#ifdef OUTPOST_SMPC_STATISTICS
+    inline const CallbackStatistics&
+    getStatistics() const
+    {
+        return mStatistics;
+    }
+#endif
+
 protected:
     /**
      * Release all subscriptions.
@@ -96,6 +131,14 @@ protected:
     releaseAllSubscriptions();
 
 private:
+    /// Link into the topic list, the topic mutex must be held
+    void
+    attach();
+
+    /// Unlink from the topic list, the topic mutex must be held
+    void
+    detach();
+
     // Disable default constructor
     SubscriptionRaw();
 
@@ -112,7 +155,18 @@ private:
     // Used by Subscription::connect to map the subscriptions to
     // their corresponding topics.
     TopicRaw* const mTopic;
-    SubscriptionRaw* mNextTopicSubscription;
+
+    /// Read by publishers without a lock
+    rtos::Atomic<SubscriptionRaw*> mNextTopicSubscription;
+
+    /// Only used to detach in O(1), protected by the topic mutex
+    SubscriptionRaw* mPreviousTopicSubscription;
+    bool mConnected;
+
+#ifdef OUTPOST_SMPC_STATISTICS
+    /// Updated by the publishers of the topic
+    CallbackStatistics mStatistics;
+#endif
 };
 
 // ----------------------------------------------------------------------------
@@ -124,7 +178,9 @@ SubscriptionRaw::SubscriptionRaw(TopicRaw& topic,
     ImplicitList<SubscriptionRaw>(listOfAllSubscriptions, this),
     Functor2<void(const void* message, size_t length)>(*subscriber, function),
     mTopic(&topic),
-    mNextTopicSubscription(0)
+    mNextTopicSubscription(nullptr),
+    mPreviousTopicSubscription(nullptr),
+    mConnected(false)
 {
 }
 
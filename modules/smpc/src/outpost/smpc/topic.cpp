@@ -16,12 +16,15 @@
 #include "subscription.h"
 
 #include <outpost/rtos/mutex_guard.h>
+#include <outpost/utils/trace/trace.h>
 
 outpost::smpc::TopicBase* outpost::smpc::TopicBase::listOfAllTopics = nullptr;
 
 outpost::smpc::TopicBase::TopicBase() :
     ImplicitList<TopicBase>(listOfAllTopics, this),
-    mSubscriptions(nullptr)
+    mSubscriptions(nullptr),
+    mKeyedSubscriptions(outpost::Slice<rtos::Atomic<Subscription*>>::empty()),
+    mKeyFunction(nullptr)
 {
 }
 
@@ -33,13 +36,141 @@ outpost::smpc::TopicBase::~TopicBase()
 void
 outpost::smpc::TopicBase::publishTypeUnsafe(void* message) const
 {
-    rtos::MutexGuard lock(mMutex);
+    OUTPOST_TRACE(outpost::utils::trace::publishBegin,
+                  static_cast<uint32_t>(reinterpret_cast<uintptr_t>(this)),
+                  0);
+#ifdef OUTPOST_SMPC_STATISTICS
+    mStatistics.recordPublish();
+#endif
+    for (Subscription* subscription = mSubscriptions.load(); subscription != nullptr;
+         subscription = subscription->mNextTopicSubscription.load())
+    {
+        deliver(*subscription, message);
+    }
+
+    if (mKeyFunction != nullptr)
+    {
+        deliverToKeyedSubscriptions(message);
+    }
+    OUTPOST_TRACE(outpost::utils::trace::publishEnd,
+                  static_cast<uint32_t>(reinterpret_cast<uintptr_t>(this)),
+                  0);
+}
+
+void
+outpost::smpc::TopicBase::publishBatchTypeUnsafe(void* messages,
+                                                 size_t numberOfMessages,
+                                                 size_t elementSize) const
+{
+    if (numberOfMessages == 0)
+    {
+        return;
+    }
+#ifdef OUTPOST_SMPC_STATISTICS
+    mStatistics.recordPublish();
+#endif
+    for (Subscription* subscription = mSubscriptions.load(); subscription != nullptr;
+         subscription = subscription->mNextTopicSubscription.load())
+    {
+#ifdef OUTPOST_SMPC_STATISTICS
+        const time::SpacecraftElapsedTime start = StatisticsClock::now();
+        subscription->executeBatch(messages, numberOfMessages, elementSize);
+        subscription->mStatistics.record(StatisticsClock::now() - start);
+#else
+        subscription->executeBatch(messages, numberOfMessages, elementSize);
+#endif
+    }
+
+    if (mKeyFunction != nullptr)
+    {
+        // Messages of one batch may have different keys
+        uint8_t* message = static_cast<uint8_t*>(messages);
+        for (size_t i = 0; i < numberOfMessages; i++)
+        {
+            deliverToKeyedSubscriptions(message);
+            message += elementSize;
+        }
+    }
+}
 
-    for (Subscription* subscription = mSubscriptions; subscription != nullptr;
-         subscription = subscription->mNextTopicSubscription)
+bool
+outpost::smpc::TopicBase::tryPublishTypeUnsafe(void* message) const
+{
+    if (isCongested(message))
     {
-        subscription->execute(message);
+        return false;
     }
+    publishTypeUnsafe(message);
+    return true;
+}
+
+void
+outpost::smpc::TopicBase::setKeyIndex(outpost::Slice<rtos::Atomic<Subscription*>> buckets,
+                                      KeyFunction keyFunction)
+{
+    mKeyedSubscriptions = buckets;
+    mKeyFunction = keyFunction;
+}
+
+void
+outpost::smpc::TopicBase::deliver(Subscription& subscription, void* message)
+{
+#ifdef OUTPOST_SMPC_STATISTICS
+    const time::SpacecraftElapsedTime start = StatisticsClock::now();
+    subscription.execute(message);
+    subscription.mStatistics.record(StatisticsClock::now() - start);
+#else
+    subscription.execute(message);
+#endif
+}
+
+void
+outpost::smpc::TopicBase::deliverToKeyedSubscriptions(void* message) const
+{
+    const uint32_t key = mKeyFunction(*this, message);
+    const rtos::Atomic<Subscription*>& bucket =
+            mKeyedSubscriptions[key % mKeyedSubscriptions.getNumberOfElements()];
+
+    for (Subscription* subscription = bucket.load(); subscription != nullptr;
+         subscription = subscription->mNextTopicSubscription.load())
+    {
+        // Different keys may share a bucket
+        if (subscription->mKey == key)
+        {
+            deliver(*subscription, message);
+        }
+    }
+}
+
+bool
+outpost::smpc::TopicBase::isCongested(void* message) const
+{
+    for (Subscription* subscription = mSubscriptions.load(); subscription != nullptr;
+         subscription = subscription->mNextTopicSubscription.load())
+    {
+        const CongestionIndicator* indicator = subscription->mCongestionIndicator;
+        if (indicator != nullptr && indicator->isCongested())
+        {
+            return true;
+        }
+    }
+
+    if (mKeyFunction != nullptr)
+    {
+        const uint32_t key = mKeyFunction(*this, message);
+        const rtos::Atomic<Subscription*>& bucket =
+                mKeyedSubscriptions[key % mKeyedSubscriptions.getNumberOfElements()];
+        for (Subscription* subscription = bucket.load(); subscription != nullptr;
+             subscription = subscription->mNextTopicSubscription.load())
+        {
+            const CongestionIndicator* indicator = subscription->mCongestionIndicator;
+            if (subscription->mKey == key && indicator != nullptr && indicator->isCongested())
+            {
+                return true;
+            }
+        }
+    }
+    return false;
 }
 
 void
@@ -47,6 +178,70 @@ outpost::smpc::TopicBase::clearSubscriptions()
 {
     for (TopicBase* it = listOfAllTopics; it != nullptr; it = it->getNext())
     {
-        it->mSubscriptions = nullptr;
+        for (size_t list = 0; list < it->getNumberOfLists(); list++)
+        {
+            it->getList(list).store(nullptr);
+        }
+    }
+}
+
+#ifdef OUTPOST_SMPC_STATISTICS
+size_t
+outpost::smpc::TopicBase::getNumberOfSubscriptions()
+{
+    rtos::MutexGuard lock(mMutex);
+    size_t count = 0;
+    for (size_t list = 0; list < getNumberOfLists(); list++)
+    {
+        for (Subscription* subscription = getList(list).load(); subscription != nullptr;
+             subscription = subscription->mNextTopicSubscription.load())
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+void
+outpost::smpc::TopicBase::resetStatistics()
+{
+    rtos::MutexGuard lock(mMutex);
+    mStatistics.reset();
+    for (size_t list = 0; list < getNumberOfLists(); list++)
+    {
+        for (Subscription* subscription = getList(list).load(); subscription != nullptr;
+             subscription = subscription->mNextTopicSubscription.load())
+        {
+            subscription->mStatistics.reset();
+        }
+    }
+}
+
+void
+outpost::smpc::TopicBase::visitStatistics(StatisticsVisitor& visitor)
+{
+    for (TopicBase* it = listOfAllTopics; it != nullptr; it = it->getNext())
+    {
+        rtos::MutexGuard lock(it->mMutex);
+        size_t numberOfSubscriptions = 0;
+        for (size_t list = 0; list < it->getNumberOfLists(); list++)
+        {
+            for (Subscription* subscription = it->getList(list).load(); subscription != nullptr;
+                 subscription = subscription->mNextTopicSubscription.load())
+            {
+                numberOfSubscriptions++;
+            }
+        }
+
+        visitor.visitTopic(it, it->mStatistics, numberOfSubscriptions);
+        for (size_t list = 0; list < it->getNumberOfLists(); list++)
+        {
+            for (Subscription* subscription = it->getList(list).load(); subscription != nullptr;
+                 subscription = subscription->mNextTopicSubscription.load())
+            {
+                visitor.visitSubscription(subscription, subscription->mStatistics);
+            }
+        }
     }
 }
+#endif
@@ -14,10 +14,15 @@
 #ifndef OUTPOST_SMPC_TOPIC_H
 #define OUTPOST_SMPC_TOPIC_H
 
+#include "topic_statistics.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/rtos/atomic.h>
 #include <outpost/rtos/mutex.h>
 #include <outpost/utils/container/implicit_list.h>
 #include <outpost/utils/meta.h>
 
+#include <stddef.h>
 #include <stdint.h>
 
 namespace outpost
@@ -74,12 +79,85 @@ public:
      * Publish new data.
      *
      * Forwards the pointer to all connected subscribers. This
-     * function is thread safe.
+     * function is thread safe and does not take a lock, publishers
+     * on different threads do not block each other. Subscribers
+     * may therefore be called concurrently from several threads.
      */
     void
     publishTypeUnsafe(void* message) const;
 
+    /**
+     * Publish several messages stored consecutively in memory.
+     *
+     * Walks the subscription list only once. Batch subscribers get all
+     * messages in a single call, all other subscribers once per message.
+     *
+     * \param messages
+     *      Pointer to the first message.
+     * \param numberOfMessages
+     *      Number of messages.
+     * \param elementSize
+     *      Distance between two messages in bytes.
+     */
+    void
+    publishBatchTypeUnsafe(void* messages, size_t numberOfMessages, size_t elementSize) const;
+
+    /**
+     * Publish only if no subscriber that would receive the message is
+     * congested, never blocks.
+     *
+     * \retval true    Message was published.
+     * \retval false   At least one subscriber is congested, the message
+     *                  was not published.
+     */
+    bool
+    tryPublishTypeUnsafe(void* message) const;
+
+#ifdef OUTPOST_SMPC_STATISTICS
+    inline const TopicStatistics&
+    getStatistics() const
+    {
+        return mStatistics;
+    }
+
+    /**
+     * Number of subscriptions currently connected to this topic.
+     */
+    size_t
+    getNumberOfSubscriptions();
+
+    /**
+     * Reset the statistics of the topic and all connected subscriptions.
+     */
+    void
+    resetStatistics();
+
+    /**
+     * Report the statistics of all typed topics and their connected subscriptions.
+     *
+     * Holds the mutex of each topic while it is visited, subscriptions
+     * can not be connected or disconnected from within the visitor.
+     */
+    static void
+    visitStatistics(StatisticsVisitor& visitor);
+#endif
+
 protected:
+    /// Extracts the key of a message, see KeyedTopic
+    typedef uint32_t (*KeyFunction)(const TopicBase& topic, const void* message);
+
+    /**
+     * Enable targeted delivery to subscriptions with a key.
+     *
+     * \param buckets
+     *      Hash table for the keyed subscriptions, must stay valid for the
+     *      lifetime of the topic.
+     * \param keyFunction
+     *      Called once per published message.
+     */
+    void
+    setKeyIndex(outpost::Slice<rtos::Atomic<Subscription*>> buckets, KeyFunction keyFunction);
+
     /// List of all topics currently active.
     static TopicBase* listOfAllTopics;
 
@@ -87,11 +165,48 @@ private:
     static void
     clearSubscriptions();
 
-    /// Used to protect the publish() method
-    mutable rtos::Mutex mMutex;
+    /// Call a subscription and record its statistics if enabled
+    static void
+    deliver(Subscription& subscription, void* message);
 
-    /// Pointer to the list of subscriptions
-    Subscription* mSubscriptions;
+    void
+    deliverToKeyedSubscriptions(void* message) const;
+
+    bool
+    isCongested(void* message) const;
+
+    /// Number of subscription lists, the unkeyed list plus one per bucket
+    inline size_t
+    getNumberOfLists() const
+    {
+        return 1 + mKeyedSubscriptions.getNumberOfElements();
+    }
+
+    inline rtos::Atomic<Subscription*>&
+    getList(size_t index)
+    {
+        return (index == 0) ? mSubscriptions : mKeyedSubscriptions[index - 1];
+    }
+
+    /// Serializes modifications of the subscription list, not used by publishers
+    rtos::Mutex mMutex;
+
+    /**
+     * Pointer to the list of subscriptions.
+     *
+     * Subscriptions are prepended and unlinked without modifying their
+     * own successor, a publisher reading the head therefore always walks
+     * a consistent list.
+     */
+    rtos::Atomic<Subscription*> mSubscriptions;
+
+    /// Subscriptions with a key, empty for topics without key function
+    outpost::Slice<rtos::Atomic<Subscription*>> mKeyedSubscriptions;
+    KeyFunction mKeyFunction;
+
+#ifdef OUTPOST_SMPC_STATISTICS
+    mutable TopicStatistics mStatistics;
+#endif
 };
 
 /**
@@ -123,6 +238,12 @@ public:
     typedef T Type;
     typedef typename outpost::remove_const<T>::type NonConstType;
 
+#ifdef OUTPOST_SMPC_STATISTICS
+    using TopicBase::getNumberOfSubscriptions;
+    using TopicBase::getStatistics;
+    using TopicBase::resetStatistics;
+#endif
+
     /**
      * Constructor.
      */
@@ -153,7 +274,7 @@ public:
      * Publish new data.
      *
      * Forwards the pointer to all connected subscribers. This
-     * function is thread safe.
+     * function is thread safe and lock-free.
      */
     inline void
     publish(T& message) const
@@ -167,6 +288,45 @@ public:
         NonConstType* ptr = const_cast<NonConstType*>(&message);
         TopicBase::publishTypeUnsafe(reinterpret_cast<void*>(ptr));
     }
+
+    /**
+     * Publish the message unless a subscriber falls behind.
+     *
+     * Checks the subscriptions with a CongestionIndicator, e.g.
+     * AsyncSubscription, before publishing. Lets a producer react to
+     * slow consumers, e.g. by reducing its sampling rate, instead of
+     * losing messages. Another publisher on the same topic may still
+     * fill a mailbox between the check and the delivery.
+     *
+     * \retval true    Message was published.
+     * \retval false   Not published because of a congested subscriber.
+     */
+    inline bool
+    tryPublish(T& message) const
+    {
+        NonConstType* ptr = const_cast<NonConstType*>(&message);
+        return TopicBase::tryPublishTypeUnsafe(reinterpret_cast<void*>(ptr));
+    }
+
+    /**
+     * Publish several messages at once.
+     *
+     * Subscriptions created with a batch function receive the whole
+     * slice in one call, other subscribers are called once per element
+     * in order. Thread safe and lock-free as publish().
+     */
+    inline void
+    publishBatch(outpost::Slice<T> messages) const
+    {
+        if (messages.getNumberOfElements() == 0)
+        {
+            return;
+        }
+        // Qualifiers are stripped as in publish()
+        NonConstType* ptr = const_cast<NonConstType*>(&messages[0]);
+        TopicBase::publishBatchTypeUnsafe(
+                reinterpret_cast<void*>(ptr), messages.getNumberOfElements(), sizeof(T));
+    }
 };
 
 }  // namespace smpc
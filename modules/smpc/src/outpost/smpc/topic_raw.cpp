@@ -33,12 +33,48 @@ outpost::smpc::TopicRaw::~TopicRaw()
 void
 outpost::smpc::TopicRaw::publish(const void* message, size_t length)
 {
-    rtos::MutexGuard lock(mMutex);
-
-    for (SubscriptionRaw* subscription = mSubscriptions; subscription != 0;
-         subscription = subscription->mNextTopicSubscription)
+#ifdef OUTPOST_SMPC_STATISTICS
+    mStatistics.recordPublish();
+#endif
+    for (SubscriptionRaw* subscription = mSubscriptions.load(); subscription != 0;
+         subscription = subscription->mNextTopicSubscription.load())
     {
+#ifdef OUTPOST_SMPC_STATISTICS
+        const time::SpacecraftElapsedTime start = StatisticsClock::now();
         subscription->execute(message, length);
+        subscription->mStatistics.record(StatisticsClock::now() - start);
+#else
+        subscription->execute(message, length);
+#endif
+    }
+}
+
+void
+outpost::smpc::TopicRaw::publish(outpost::Slice<const outpost::Slice<const uint8_t>> messages)
+{
+    if (messages.getNumberOfElements() == 0)
+    {
+        return;
+    }
+#ifdef OUTPOST_SMPC_STATISTICS
+    mStatistics.recordPublish();
+#endif
+    for (SubscriptionRaw* subscription = mSubscriptions.load(); subscription != 0;
+         subscription = subscription->mNextTopicSubscription.load())
+    {
+#ifdef OUTPOST_SMPC_STATISTICS
+        const time::SpacecraftElapsedTime start = StatisticsClock::now();
+#endif
+        for (const outpost::Slice<const uint8_t>& message : messages)
+        {
+            // An empty message has no first element to take the address of
+            const uint8_t* data =
+                    (message.getNumberOfElements() > 0) ? &message[0] : nullptr;
+            subscription->execute(data, message.getNumberOfElements());
+        }
+#ifdef OUTPOST_SMPC_STATISTICS
+        subscription->mStatistics.record(StatisticsClock::now() - start);
+#endif
     }
 }
 
@@ -47,6 +83,55 @@ outpost::smpc::TopicRaw::clearSubscriptions()
 {
     for (TopicRaw* it = listOfAllTopics; it != 0; it = it->getNext())
     {
-        it->mSubscriptions = 0;
+        it->mSubscriptions.store(nullptr);
+    }
+}
+
+#ifdef OUTPOST_SMPC_STATISTICS
+size_t
+outpost::smpc::TopicRaw::getNumberOfSubscriptions()
+{
+    rtos::MutexGuard lock(mMutex);
+    size_t count = 0;
+    for (SubscriptionRaw* subscription = mSubscriptions.load(); subscription != nullptr;
+         subscription = subscription->mNextTopicSubscription.load())
+    {
+        count++;
+    }
+    return count;
+}
+
+void
+outpost::smpc::TopicRaw::resetStatistics()
+{
+    rtos::MutexGuard lock(mMutex);
+    mStatistics.reset();
+    for (SubscriptionRaw* subscription = mSubscriptions.load(); subscription != nullptr;
+         subscription = subscription->mNextTopicSubscription.load())
+    {
+        subscription->mStatistics.reset();
+    }
+}
+
+void
+outpost::smpc::TopicRaw::visitStatistics(StatisticsVisitor& visitor)
+{
+    for (TopicRaw* it = listOfAllTopics; it != nullptr; it = it->getNext())
+    {
+        rtos::MutexGuard lock(it->mMutex);
+        size_t numberOfSubscriptions = 0;
+        for (SubscriptionRaw* subscription = it->mSubscriptions.load(); subscription != nullptr;
+             subscription = subscription->mNextTopicSubscription.load())
+        {
+            numberOfSubscriptions++;
+        }
+
+        visitor.visitTopic(it, it->mStatistics, numberOfSubscriptions);
+        for (SubscriptionRaw* subscription = it->mSubscriptions.load(); subscription != nullptr;
+             subscription = subscription->mNextTopicSubscription.load())
+        {
+            visitor.visitSubscription(subscription, subscription->mStatistics);
+        }
     }
 }
+#endif
@@ -14,6 +14,10 @@
 #ifndef OUTPOST_SMPC_TOPIC_RAW_H
 #define OUTPOST_SMPC_TOPIC_RAW_H
 
+#include "topic_statistics.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/rtos/atomic.h>
 #include <outpost/rtos/mutex.h>
 #include <outpost/utils/container/implicit_list.h>
 #include <outpost/utils/meta.h>
@@ -72,11 +76,52 @@ public:
     /**
      * Publish new data.
      *
-     * Forwards the pointer to all connected subscribers.
+     * Forwards the pointer to all connected subscribers. Does not
+     * take a lock, subscribers may be called concurrently from several
+     * publishing threads.
      */
     void
     publish(const void* message, size_t length);
 
+    /**
+     * Publish several messages.
+     *
+     * The subscription list is walked only once, every subscriber is
+     * called for all messages in order before the next subscriber is
+     * notified.
+     */
+    void
+    publish(outpost::Slice<const outpost::Slice<const uint8_t>> messages);
+
+#ifdef OUTPOST_SMPC_STATISTICS
+    inline const TopicStatistics&
+    getStatistics() const
+    {
+        return mStatistics;
+    }
+
+    /**
+     * Number of subscriptions currently connected to this topic.
+     */
+    size_t
+    getNumberOfSubscriptions();
+
+    /**
+     * Reset the statistics of the topic and all connected subscriptions.
+     */
+    void
+    resetStatistics();
+
+    /**
+     * Report the statistics of all raw topics and their connected subscriptions.
+     *
+     * Holds the mutex of each topic while it is visited, subscriptions
+     * can not be connected or disconnected from within the visitor.
+     */
+    static void
+    visitStatistics(StatisticsVisitor& visitor);
+#endif
+
 private:
     // disable copy constructor
     TopicRaw(const TopicRaw&);
@@ -91,11 +136,15 @@ private:
     /// List of all raw topics currently active.
     static TopicRaw* listOfAllTopics;
 
-    /// Mutex used to protect the publish() method.
+    /// Serializes modifications of the subscription list, not used by publishers
     rtos::Mutex mMutex;
 
     /// Pointer to the list of mSubscriptions
-    SubscriptionRaw* mSubscriptions;
+    rtos::Atomic<SubscriptionRaw*> mSubscriptions;
+
+#ifdef OUTPOST_SMPC_STATISTICS
+    TopicStatistics mStatistics;
+#endif
 };
 
 }  // namespace smpc
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "topic_statistics.h"
+
+#include <outpost/rtos/clock.h>
+
+namespace
+{
+constexpr int64_t maximumMicroseconds = 0xFFFFFFFF;
+
+uint32_t
+toMicroseconds(outpost::time::Duration duration)
+{
+    const int64_t microseconds = duration.microseconds();
+    if (microseconds < 0)
+    {
+        return 0;
+    }
+    else if (microseconds > maximumMicroseconds)
+    {
+        return static_cast<uint32_t>(maximumMicroseconds);
+    }
+    return static_cast<uint32_t>(microseconds);
+}
+}  // namespace
+
+outpost::smpc::CallbackStatistics::CallbackStatistics() :
+    mNumberOfCalls(0),
+    mMaximumExecutionTime(0),
+    mTotalExecutionTime(0)
+{
+}
+
+void
+outpost::smpc::CallbackStatistics::record(time::Duration executionTime)
+{
+    const uint32_t microseconds = toMicroseconds(executionTime);
+
+    mNumberOfCalls.fetchAdd(1);
+    mTotalExecutionTime.fetchAdd(microseconds);
+
+    uint32_t maximum = mMaximumExecutionTime.load();
+    while (microseconds > maximum && !mMaximumExecutionTime.compareAndSwap(maximum, microseconds))
+    {
+        // maximum was updated by the failed exchange, try again
+    }
+}
+
+void
+outpost::smpc::CallbackStatistics::reset()
+{
+    mNumberOfCalls.store(0);
+    mMaximumExecutionTime.store(0);
+    mTotalExecutionTime.store(0);
+}
+
+outpost::smpc::TopicStatistics::TopicStatistics() : mNumberOfPublishes(0), mMutexWaitTime(0)
+{
+}
+
+void
+outpost::smpc::TopicStatistics::recordMutexWait(time::Duration waitTime)
+{
+    mMutexWaitTime.fetchAdd(toMicroseconds(waitTime));
+}
+
+void
+outpost::smpc::TopicStatistics::reset()
+{
+    mNumberOfPublishes.store(0);
+    mMutexWaitTime.store(0);
+}
+
+outpost::time::SpacecraftElapsedTime
+outpost::smpc::StatisticsClock::now()
+{
+    static outpost::rtos::SystemClock clock;
+    return clock.now();
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_SMPC_TOPIC_STATISTICS_H
+#define OUTPOST_SMPC_TOPIC_STATISTICS_H
+
+#include <outpost/rtos/atomic.h>
+#include <outpost/time/duration.h>
+#include <outpost/time/time_epoch.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * \def OUTPOST_SMPC_STATISTICS
+ *
+ * Define to record publish and callback statistics for all topics and
+ * subscriptions. Disabled by default, topics and subscriptions then contain
+ * no additional members and publishing is not slowed down.
+ *
+ * Changes the layout of the smpc classes, the library and all users must be
+ * compiled with the same setting.
+ */
+
+namespace outpost
+{
+namespace smpc
+{
+/**
+ * Execution time statistics of a single subscription.
+ *
+ * One call is recorded per publish operation, a batch delivered to a
+ * subscriber without batch function therefore counts as a single call.
+ *
+ * Updated lock-free by the publishing threads. Times are accumulated with
+ * microsecond resolution in 32 bit, the total therefore wraps after about
+ * 71 minutes of accumulated callback time.
+ *
+ * \ingroup smpc
+ */
+class CallbackStatistics
+{
+public:
+    CallbackStatistics();
+
+    /**
+     * Record the time spent in the subscriber for one publish operation.
+     */
+    void
+    record(time::Duration executionTime);
+
+    inline uint32_t
+    getNumberOfCalls() const
+    {
+        return mNumberOfCalls.load();
+    }
+
+    inline time::Duration
+    getMaximumExecutionTime() const
+    {
+        return time::Microseconds(mMaximumExecutionTime.load());
+    }
+
+    inline time::Duration
+    getTotalExecutionTime() const
+    {
+        return time::Microseconds(mTotalExecutionTime.load());
+    }
+
+    void
+    reset();
+
+private:
+    rtos::Atomic<uint32_t> mNumberOfCalls;
+    rtos::Atomic<uint32_t> mMaximumExecutionTime;
+    rtos::Atomic<uint32_t> mTotalExecutionTime;
+};
+
+/**
+ * Publish statistics of a single topic.
+ *
+ * The mutex of a topic is only used when subscriptions are connected or
+ * disconnected, its wait time shows how much these operations are delayed
+ * by each other.
+ *
+ * \ingroup smpc
+ */
+class TopicStatistics
+{
+public:
+    TopicStatistics();
+
+    inline void
+    recordPublish()
+    {
+        mNumberOfPublishes.fetchAdd(1);
+    }
+
+    void
+    recordMutexWait(time::Duration waitTime);
+
+    inline uint32_t
+    getNumberOfPublishes() const
+    {
+        return mNumberOfPublishes.load();
+    }
+
+    inline time::Duration
+    getMutexWaitTime() const
+    {
+        return time::Microseconds(mMutexWaitTime.load());
+    }
+
+    void
+    reset();
+
+private:
+    rtos::Atomic<uint32_t> mNumberOfPublishes;
+    rtos::Atomic<uint32_t> mMutexWaitTime;
+};
+
+/**
+ * Receives the statistics of all topics and their subscriptions.
+ *
+ * Topics and subscriptions are identified by their address. Every topic is
+ * reported before its subscriptions.
+ *
+ * \see TopicBase::visitStatistics()
+ * \see TopicRaw::visitStatistics()
+ *
+ * \ingroup smpc
+ */
+class StatisticsVisitor
+{
+public:
+    virtual ~StatisticsVisitor() = default;
+
+    virtual void
+    visitTopic(const void* topic,
+               const TopicStatistics& statistics,
+               size_t numberOfSubscriptions) = 0;
+
+    virtual void
+    visitSubscription(const void* subscription, const CallbackStatistics& statistics) = 0;
+};
+
+/**
+ * Time base used for the statistics.
+ */
+class StatisticsClock
+{
+public:
+    static time::SpacecraftElapsedTime
+    now();
+};
+
+}  // namespace smpc
+}  // namespace outpost
+
+#endif
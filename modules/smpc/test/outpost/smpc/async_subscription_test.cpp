@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/smpc/async_subscription.h>
+#include <outpost/smpc/topic.h>
+
+#include <unittest/harness.h>
+#include <unittest/smpc/testing_subscription.h>
+
+#include <stdint.h>
+
+#include <vector>
+
+using outpost::smpc::OverflowPolicy;
+
+namespace
+{
+class AsyncComponent : public outpost::smpc::Subscriber
+{
+public:
+    AsyncComponent(outpost::smpc::Topic<const uint32_t>& topic, OverflowPolicy::Type policy) :
+        mSubscription(topic,
+                      this,
+                      &AsyncComponent::onReceive,
+                      policy,
+                      outpost::time::Milliseconds(1))
+    {
+    }
+
+    void
+    onReceive(const uint32_t* value)
+    {
+        mReceived.push_back(*value);
+    }
+
+    std::vector<uint32_t> mReceived;
+    outpost::smpc::AsyncSubscription<const uint32_t, 2> mSubscription;
+};
+
+class AsyncSubscriptionTest : public testing::Test
+{
+public:
+    virtual void
+    TearDown() override
+    {
+        unittest::smpc::TestingSubscription::releaseAllSubscriptions();
+    }
+
+    void
+    publish(uint32_t value)
+    {
+        mTopic.publish(value);
+    }
+
+    outpost::smpc::Topic<const uint32_t> mTopic;
+};
+}  // namespace
+
+TEST_F(AsyncSubscriptionTest, deliveryIsDeferred)
+{
+    AsyncComponent component(mTopic, OverflowPolicy::dropNewest);
+    outpost::smpc::Subscription::connectSubscriptionsToTopics();
+
+    publish(1);
+    publish(2);
+    EXPECT_TRUE(component.mReceived.empty());
+    EXPECT_EQ(2U, component.mSubscription.getNumberOfPendingMessages());
+
+    EXPECT_TRUE(component.mSubscription.deliver());
+    EXPECT_EQ(std::vector<uint32_t>({1}), component.mReceived);
+    EXPECT_EQ(1U, component.mSubscription.deliverAll());
+    EXPECT_EQ(std::vector<uint32_t>({1, 2}), component.mReceived);
+    EXPECT_FALSE(component.mSubscription.deliver(outpost::time::Milliseconds(1)));
+}
+
+TEST_F(AsyncSubscriptionTest, dropNewest)
+{
+    AsyncComponent component(mTopic, OverflowPolicy::dropNewest);
+    outpost::smpc::Subscription::connectSubscriptionsToTopics();
+
+    publish(1);
+    publish(2);
+    publish(3);
+    EXPECT_EQ(1U, component.mSubscription.getNumberOfDroppedMessages());
+
+    component.mSubscription.deliverAll();
+    EXPECT_EQ(std::vector<uint32_t>({1, 2}), component.mReceived);
+
+    component.mSubscription.resetErrorCounters();
+    EXPECT_EQ(0U, component.mSubscription.getNumberOfDroppedMessages());
+}
+
+TEST_F(AsyncSubscriptionTest, dropOldest)
+{
+    AsyncComponent component(mTopic, OverflowPolicy::dropOldest);
+    outpost::smpc::Subscription::connectSubscriptionsToTopics();
+
+    publish(1);
+    publish(2);
+    publish(3);
+    EXPECT_EQ(1U, component.mSubscription.getNumberOfDroppedMessages());
+
+    EXPECT_EQ(2U, component.mSubscription.deliverAll());
+    EXPECT_EQ(std::vector<uint32_t>({2, 3}), component.mReceived);
+}
+
+TEST_F(AsyncSubscriptionTest, blockTimesOutOnFullMailbox)
+{
+    AsyncComponent component(mTopic, OverflowPolicy::block);
+    outpost::smpc::Subscription::connectSubscriptionsToTopics();
+
+    publish(1);
+    publish(2);
+    // waits for the block timeout, then drops
+    publish(3);
+    EXPECT_EQ(1U, component.mSubscription.getNumberOfDroppedMessages());
+
+    EXPECT_TRUE(component.mSubscription.deliver());
+    publish(4);
+    component.mSubscription.deliverAll();
+    EXPECT_EQ(std::vector<uint32_t>({1, 2, 4}), component.mReceived);
+}
+
+TEST_F(AsyncSubscriptionTest, tryPublishReportsCongestion)
+{
+    AsyncComponent component(mTopic, OverflowPolicy::block);
+    outpost::smpc::Subscription::connectSubscriptionsToTopics();
+
+    const uint32_t values[] = {1, 2, 3};
+    EXPECT_TRUE(mTopic.tryPublish(values[0]));
+    EXPECT_FALSE(component.mSubscription.isCongested());
+    EXPECT_TRUE(mTopic.tryPublish(values[1]));
+    EXPECT_TRUE(component.mSubscription.isCongested());
+
+    // not published at all, neither dropped nor blocking
+    EXPECT_FALSE(mTopic.tryPublish(values[2]));
+    EXPECT_EQ(0U, component.mSubscription.getNumberOfDroppedMessages());
+
+    component.mSubscription.deliverAll();
+    EXPECT_TRUE(mTopic.tryPublish(values[2]));
+    component.mSubscription.deliverAll();
+    EXPECT_EQ(std::vector<uint32_t>({1, 2, 3}), component.mReceived);
+}
+
+TEST_F(AsyncSubscriptionTest, tracksMaximumFillLevel)
+{
+    AsyncComponent component(mTopic, OverflowPolicy::dropNewest);
+    outpost::smpc::Subscription::connectSubscriptionsToTopics();
+
+    EXPECT_EQ(2U, component.mSubscription.getCapacity());
+
+    publish(1);
+    publish(2);
+    component.mSubscription.deliverAll();
+    publish(3);
+    EXPECT_EQ(1U, component.mSubscription.getNumberOfPendingMessages());
+    EXPECT_EQ(2U, component.mSubscription.getMaximumNumberOfPendingMessages());
+
+    component.mSubscription.resetErrorCounters();
+    EXPECT_EQ(1U, component.mSubscription.getMaximumNumberOfPendingMessages());
+}
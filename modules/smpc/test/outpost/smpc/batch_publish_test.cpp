@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/smpc/subscription.h>
+#include <outpost/smpc/subscription_raw.h>
+#include <outpost/smpc/topic.h>
+#include <outpost/smpc/topic_raw.h>
+
+#include <unittest/harness.h>
+#include <unittest/smpc/testing_subscription.h>
+#include <unittest/smpc/testing_subscription_raw.h>
+
+#include <stdint.h>
+
+#include <vector>
+
+namespace
+{
+class BatchComponent : public outpost::smpc::Subscriber
+{
+public:
+    BatchComponent() : mNumberOfBatchCalls(0)
+    {
+    }
+
+    void
+    onSample(const uint16_t* sample)
+    {
+        mSamples.push_back(*sample);
+    }
+
+    void
+    onBatch(outpost::Slice<const uint16_t> samples)
+    {
+        mNumberOfBatchCalls++;
+        for (uint16_t sample : samples)
+        {
+            mBatchSamples.push_back(sample);
+        }
+    }
+
+    void
+    onRaw(const void* message, size_t length)
+    {
+        mRawLengths.push_back(length);
+        if (length > 0)
+        {
+            mRawFirstBytes.push_back(*static_cast<const uint8_t*>(message));
+        }
+    }
+
+    std::vector<uint16_t> mSamples;
+    std::vector<uint16_t> mBatchSamples;
+    size_t mNumberOfBatchCalls;
+
+    std::vector<size_t> mRawLengths;
+    std::vector<uint8_t> mRawFirstBytes;
+};
+
+class BatchPublishTest : public ::testing::Test
+{
+public:
+    virtual void
+    TearDown()
+    {
+        unittest::smpc::TestingSubscription::releaseAllSubscriptions();
+        unittest::smpc::TestingSubscriptionRaw::releaseAllSubscriptions();
+    }
+
+    BatchComponent mComponent;
+};
+}  // namespace
+
+TEST_F(BatchPublishTest, shouldDeliverWholeSliceToBatchSubscriber)
+{
+    outpost::smpc::Topic<const uint16_t> topic;
+    outpost::smpc::Subscription batch(topic, &mComponent, &BatchComponent::onBatch);
+    outpost::smpc::Subscription single(topic, &mComponent, &BatchComponent::onSample);
+    unittest::smpc::TestingSubscription::connectSubscriptionsToTopics();
+
+    const uint16_t samples[] = {1, 2, 3, 4, 5};
+    topic.publishBatch(outpost::asSlice(samples));
+
+    EXPECT_EQ(1U, mComponent.mNumberOfBatchCalls);
+    EXPECT_EQ(std::vector<uint16_t>({1, 2, 3, 4, 5}), mComponent.mBatchSamples);
+    EXPECT_EQ(std::vector<uint16_t>({1, 2, 3, 4, 5}), mComponent.mSamples);
+}
+
+TEST_F(BatchPublishTest, shouldPassSingleMessageAsSliceOfOne)
+{
+    outpost::smpc::Topic<const uint16_t> topic;
+    outpost::smpc::Subscription batch(topic, &mComponent, &BatchComponent::onBatch);
+    unittest::smpc::TestingSubscription::connectSubscriptionsToTopics();
+
+    const uint16_t sample = 42;
+    topic.publish(sample);
+
+    EXPECT_EQ(1U, mComponent.mNumberOfBatchCalls);
+    EXPECT_EQ(std::vector<uint16_t>({42}), mComponent.mBatchSamples);
+}
+
+TEST_F(BatchPublishTest, shouldIgnoreEmptyBatch)
+{
+    outpost::smpc::Topic<const uint16_t> topic;
+    outpost::smpc::Subscription batch(topic, &mComponent, &BatchComponent::onBatch);
+    unittest::smpc::TestingSubscription::connectSubscriptionsToTopics();
+
+    topic.publishBatch(outpost::Slice<const uint16_t>::empty());
+
+    EXPECT_EQ(0U, mComponent.mNumberOfBatchCalls);
+}
+
+TEST_F(BatchPublishTest, shouldPublishRawBatchInOrder)
+{
+    outpost::smpc::TopicRaw topic;
+    outpost::smpc::SubscriptionRaw subscription(topic, &mComponent, &BatchComponent::onRaw);
+    unittest::smpc::TestingSubscriptionRaw::connectSubscriptionsToTopics();
+
+    const uint8_t first[] = {10, 11};
+    const uint8_t second[] = {20, 21, 22};
+    const outpost::Slice<const uint8_t> messages[] = {outpost::asSlice(first),
+                                                      outpost::asSlice(second)};
+    topic.publish(outpost::asSlice(messages));
+
+    EXPECT_EQ(std::vector<size_t>({2, 3}), mComponent.mRawLengths);
+    EXPECT_EQ(std::vector<uint8_t>({10, 20}), mComponent.mRawFirstBytes);
+}
+
+TEST_F(BatchPublishTest, shouldPublishEmptyRawMessages)
+{
+    outpost::smpc::TopicRaw topic;
+    outpost::smpc::SubscriptionRaw subscription(topic, &mComponent, &BatchComponent::onRaw);
+    unittest::smpc::TestingSubscriptionRaw::connectSubscriptionsToTopics();
+
+    topic.publish(outpost::Slice<const outpost::Slice<const uint8_t>>::empty());
+    EXPECT_TRUE(mComponent.mRawLengths.empty());
+
+    const uint8_t second[] = {20};
+    const outpost::Slice<const uint8_t> messages[] = {outpost::Slice<const uint8_t>::empty(),
+                                                      outpost::asSlice(second)};
+    topic.publish(outpost::asSlice(messages));
+
+    EXPECT_EQ(std::vector<size_t>({0, 1}), mComponent.mRawLengths);
+    EXPECT_EQ(std::vector<uint8_t>({20}), mComponent.mRawFirstBytes);
+}
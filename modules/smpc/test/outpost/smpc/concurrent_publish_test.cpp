@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos/atomic.h>
+#include <outpost/rtos/semaphore.h>
+#include <outpost/rtos/thread.h>
+#include <outpost/smpc/subscription.h>
+#include <outpost/smpc/topic.h>
+
+#include <unittest/harness.h>
+#include <unittest/smpc/testing_subscription.h>
+
+#include <stdint.h>
+
+namespace
+{
+/// Blocks inside the callback for message 1 until released.
+class SlowComponent : public outpost::smpc::Subscriber
+{
+public:
+    explicit SlowComponent(outpost::smpc::Topic<const uint32_t>& topic) :
+        mEntered(outpost::rtos::BinarySemaphore::State::acquired),
+        mRelease(outpost::rtos::BinarySemaphore::State::acquired),
+        mNumberOfMessages(0),
+        mSubscription(topic, this, &SlowComponent::onReceive)
+    {
+    }
+
+    void
+    onReceive(const uint32_t* value)
+    {
+        if (*value == 1)
+        {
+            mEntered.release();
+            mRelease.acquire();
+        }
+        mNumberOfMessages.fetchAdd(1);
+    }
+
+    outpost::rtos::BinarySemaphore mEntered;
+    outpost::rtos::BinarySemaphore mRelease;
+    outpost::rtos::Atomic<uint32_t> mNumberOfMessages;
+
+private:
+    outpost::smpc::Subscription mSubscription;
+};
+
+class PublisherThread : public outpost::rtos::Thread
+{
+public:
+    explicit PublisherThread(outpost::smpc::Topic<const uint32_t>& topic) :
+        Thread(0),
+        mTopic(topic),
+        mDone(outpost::rtos::BinarySemaphore::State::acquired)
+    {
+    }
+
+    void
+    waitUntilDone()
+    {
+        mDone.acquire();
+    }
+
+protected:
+    void
+    run() override
+    {
+        const uint32_t value = 1;
+        mTopic.publish(value);
+        mDone.release();
+
+        // Returning from a thread is not allowed, wait to be cancelled by the destructor
+        while (true)
+        {
+            outpost::rtos::Thread::sleep(outpost::time::Milliseconds(10));
+        }
+    }
+
+private:
+    outpost::smpc::Topic<const uint32_t>& mTopic;
+    outpost::rtos::BinarySemaphore mDone;
+};
+}  // namespace
+
+TEST(ConcurrentPublishTest, slowSubscriberDoesNotBlockOtherPublishers)
+{
+    outpost::smpc::Topic<const uint32_t> topic;
+    SlowComponent component(topic);
+    outpost::smpc::Subscription::connectSubscriptionsToTopics();
+
+    {
+        PublisherThread publisher(topic);
+        publisher.start();
+        component.mEntered.acquire();
+
+        // the other publisher is still inside the callback
+        const uint32_t value = 2;
+        topic.publish(value);
+        EXPECT_EQ(1U, component.mNumberOfMessages.load());
+
+        component.mRelease.release();
+        publisher.waitUntilDone();
+    }
+    EXPECT_EQ(2U, component.mNumberOfMessages.load());
+
+    unittest::smpc::TestingSubscription::releaseAllSubscriptions();
+}
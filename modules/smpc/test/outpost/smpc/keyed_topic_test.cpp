@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/smpc/keyed_topic.h>
+#include <outpost/smpc/subscription.h>
+
+#include <unittest/harness.h>
+#include <unittest/smpc/testing_subscription.h>
+
+#include <stdint.h>
+
+namespace
+{
+struct Heartbeat
+{
+    uint32_t source;
+    uint32_t counter;
+};
+
+uint32_t
+getSource(const Heartbeat& heartbeat)
+{
+    return heartbeat.source;
+}
+
+class Monitor : public outpost::smpc::Subscriber
+{
+public:
+    Monitor() : mReceived()
+    {
+    }
+
+    void
+    onHeartbeat0(const Heartbeat*)
+    {
+        mReceived[0]++;
+    }
+
+    void
+    onHeartbeat1(const Heartbeat*)
+    {
+        mReceived[1]++;
+    }
+
+    void
+    onHeartbeat2(const Heartbeat*)
+    {
+        mReceived[2]++;
+    }
+
+    void
+    onAny(const Heartbeat*)
+    {
+        mReceived[3]++;
+    }
+
+    uint32_t mReceived[4];
+};
+
+class KeyedTopicTest : public ::testing::Test
+{
+public:
+    KeyedTopicTest() : mTopic(&getSource)
+    {
+    }
+
+    virtual void
+    TearDown()
+    {
+        unittest::smpc::TestingSubscription::releaseAllSubscriptions();
+    }
+
+    Monitor mMonitor;
+
+    // Two buckets so that keys 1 and 3 collide
+    outpost::smpc::KeyedTopic<const Heartbeat, 2> mTopic;
+};
+}  // namespace
+
+TEST_F(KeyedTopicTest, shouldDeliverOnlyMatchingKeys)
+{
+    outpost::smpc::Subscription s0(mTopic, 1, &mMonitor, &Monitor::onHeartbeat0);
+    outpost::smpc::Subscription s1(mTopic, 2, &mMonitor, &Monitor::onHeartbeat1);
+    outpost::smpc::Subscription s2(mTopic, 3, &mMonitor, &Monitor::onHeartbeat2);
+    outpost::smpc::Subscription any(mTopic, &mMonitor, &Monitor::onAny);
+    unittest::smpc::TestingSubscription::connectSubscriptionsToTopics();
+
+    mTopic.publish(Heartbeat{1, 0});
+    mTopic.publish(Heartbeat{3, 0});
+    mTopic.publish(Heartbeat{3, 1});
+    mTopic.publish(Heartbeat{4, 0});
+
+    EXPECT_EQ(1U, mMonitor.mReceived[0]);
+    EXPECT_EQ(0U, mMonitor.mReceived[1]);
+    EXPECT_EQ(2U, mMonitor.mReceived[2]);
+    EXPECT_EQ(4U, mMonitor.mReceived[3]);
+}
+
+TEST_F(KeyedTopicTest, shouldDeliverThroughTopicReference)
+{
+    outpost::smpc::Subscription s0(mTopic, 1, &mMonitor, &Monitor::onHeartbeat0);
+    unittest::smpc::TestingSubscription::connectSubscriptionsToTopics();
+
+    const outpost::smpc::Topic<const Heartbeat>& topic = mTopic;
+    topic.publish(Heartbeat{1, 0});
+    topic.publish(Heartbeat{2, 0});
+
+    EXPECT_EQ(1U, mMonitor.mReceived[0]);
+}
+
+TEST_F(KeyedTopicTest, shouldSplitBatchByKey)
+{
+    outpost::smpc::Subscription s0(mTopic, 1, &mMonitor, &Monitor::onHeartbeat0);
+    outpost::smpc::Subscription s1(mTopic, 2, &mMonitor, &Monitor::onHeartbeat1);
+    unittest::smpc::TestingSubscription::connectSubscriptionsToTopics();
+
+    const Heartbeat heartbeats[] = {{1, 0}, {2, 0}, {1, 1}};
+    mTopic.publishBatch(outpost::asSlice(heartbeats));
+
+    EXPECT_EQ(2U, mMonitor.mReceived[0]);
+    EXPECT_EQ(1U, mMonitor.mReceived[1]);
+}
+
+TEST_F(KeyedTopicTest, shouldDisconnectKeyedSubscription)
+{
+    outpost::smpc::Subscription s0(mTopic, 1, &mMonitor, &Monitor::onHeartbeat0);
+    outpost::smpc::Subscription s2(mTopic, 3, &mMonitor, &Monitor::onHeartbeat2);
+    unittest::smpc::TestingSubscription::connectSubscriptionsToTopics();
+
+    s0.disconnect();
+    mTopic.publish(Heartbeat{1, 0});
+    mTopic.publish(Heartbeat{3, 0});
+    EXPECT_EQ(0U, mMonitor.mReceived[0]);
+    EXPECT_EQ(1U, mMonitor.mReceived[2]);
+
+    s0.connect();
+    mTopic.publish(Heartbeat{1, 0});
+    EXPECT_EQ(1U, mMonitor.mReceived[0]);
+}
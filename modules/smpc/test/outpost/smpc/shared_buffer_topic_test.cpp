@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/smpc/async_subscription.h>
+#include <outpost/smpc/shared_buffer_topic.h>
+#include <outpost/smpc/subscription.h>
+#include <outpost/utils/container/shared_object_pool.h>
+
+#include <unittest/harness.h>
+#include <unittest/smpc/testing_subscription.h>
+
+using outpost::utils::SharedBufferPointer;
+
+namespace
+{
+class PacketStore : public outpost::smpc::Subscriber
+{
+public:
+    void
+    onPacket(const SharedBufferPointer* packet)
+    {
+        // Keeps the payload without copying it
+        mPacket = *packet;
+    }
+
+    SharedBufferPointer mPacket;
+};
+
+class SharedBufferTopicTest : public ::testing::Test
+{
+public:
+    virtual void
+    TearDown()
+    {
+        unittest::smpc::TestingSubscription::releaseAllSubscriptions();
+    }
+
+    outpost::utils::SharedBufferPool<16, 2> mPool;
+    outpost::smpc::SharedBufferTopic mTopic;
+    PacketStore mStore;
+};
+}  // namespace
+
+TEST_F(SharedBufferTopicTest, subscriberShouldRetainPayload)
+{
+    outpost::smpc::Subscription subscription(mTopic, &mStore, &PacketStore::onPacket);
+    unittest::smpc::TestingSubscription::connectSubscriptionsToTopics();
+
+    const uint8_t* payload;
+    {
+        SharedBufferPointer packet;
+        ASSERT_TRUE(mPool.allocate(packet));
+        packet.asSlice()[0] = 0xAB;
+        payload = &packet.asSlice()[0];
+
+        mTopic.publish(packet);
+    }
+
+    ASSERT_TRUE(mStore.mPacket.isValid());
+    EXPECT_EQ(payload, &mStore.mPacket.asSlice()[0]);
+    EXPECT_EQ(0xAB, mStore.mPacket.asSlice()[0]);
+    EXPECT_EQ(1U, mPool.numberOfFreeElements());
+
+    mStore.mPacket = SharedBufferPointer();
+    EXPECT_EQ(2U, mPool.numberOfFreeElements());
+}
+
+TEST_F(SharedBufferTopicTest, asyncDeliveryShouldReleaseBuffer)
+{
+    outpost::smpc::AsyncSubscription<const SharedBufferPointer, 4> subscription(
+            mTopic, &mStore, &PacketStore::onPacket);
+    unittest::smpc::TestingSubscription::connectSubscriptionsToTopics();
+
+    {
+        SharedBufferPointer packet;
+        ASSERT_TRUE(mPool.allocate(packet));
+        mTopic.publish(packet);
+    }
+
+    // held by the mailbox
+    EXPECT_EQ(1U, mPool.numberOfFreeElements());
+
+    EXPECT_TRUE(subscription.deliver());
+    mStore.mPacket = SharedBufferPointer();
+
+    // neither the mailbox nor the subscriber hold a reference any more
+    EXPECT_EQ(2U, mPool.numberOfFreeElements());
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/smpc/static_topic.h>
+
+#include <unittest/harness.h>
+
+#include <stdint.h>
+
+#include <vector>
+
+namespace
+{
+std::vector<int> callOrder;
+
+class Consumer
+{
+public:
+    explicit Consumer(int id) : mId(id), mLastValue(0)
+    {
+    }
+
+    void
+    onValue(const uint32_t* value)
+    {
+        mLastValue = *value;
+        callOrder.push_back(mId);
+    }
+
+    int mId;
+    uint32_t mLastValue;
+};
+
+Consumer first(1);
+Consumer second(2);
+
+typedef outpost::smpc::StaticTopic<
+        const uint32_t,
+        outpost::smpc::StaticSubscription<const uint32_t, Consumer, first, &Consumer::onValue>,
+        outpost::smpc::StaticSubscription<const uint32_t, Consumer, second, &Consumer::onValue>>
+        ValueTopic;
+
+typedef outpost::smpc::StaticTopic<const uint32_t> EmptyTopic;
+}  // namespace
+
+TEST(StaticTopicTest, shouldCallSubscribersInOrder)
+{
+    callOrder.clear();
+
+    const uint32_t value = 123;
+    ValueTopic::publish(value);
+
+    EXPECT_EQ(123U, first.mLastValue);
+    EXPECT_EQ(123U, second.mLastValue);
+    EXPECT_EQ(std::vector<int>({1, 2}), callOrder);
+    EXPECT_EQ(2U, ValueTopic::numberOfSubscriptions);
+}
+
+TEST(StaticTopicTest, shouldAcceptEmptySubscriberList)
+{
+    const uint32_t value = 1;
+    EmptyTopic::publish(value);
+
+    EXPECT_EQ(0U, EmptyTopic::numberOfSubscriptions);
+}
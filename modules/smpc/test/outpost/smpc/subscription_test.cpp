@@ -20,6 +20,7 @@
 #include <stdint.h>
 
 #include <cstring>
+#include <vector>
 
 struct Data
 {
@@ -207,3 +208,109 @@ TEST_F(SubscriptionTest, receiveFourWithDelete2)
     delete subscription1;
     delete subscription2;
 }
+
+TEST_F(SubscriptionTest, connectAndDisconnectSingleSubscription)
+{
+    outpost::smpc::Subscription subscription0(topic, &component, &Component::onReceiveData0);
+    unittest::smpc::TestingSubscription::connectSubscriptionsToTopics();
+
+    // created after the global connect
+    outpost::smpc::Subscription subscription1(topic, &component, &Component::onReceiveData1);
+    topic.publish(data);
+    EXPECT_TRUE(component.received[0]);
+    EXPECT_FALSE(component.received[1]);
+
+    component.reset();
+    subscription1.connect();
+    subscription1.connect();
+    topic.publish(data);
+    EXPECT_TRUE(component.received[0]);
+    EXPECT_TRUE(component.received[1]);
+
+    component.reset();
+    subscription0.disconnect();
+    topic.publish(data);
+    EXPECT_FALSE(component.received[0]);
+    EXPECT_TRUE(component.received[1]);
+
+    component.reset();
+    subscription0.connect();
+    subscription1.disconnect();
+    topic.publish(data);
+    EXPECT_TRUE(component.received[0]);
+    EXPECT_FALSE(component.received[1]);
+}
+
+TEST_F(SubscriptionTest, deleteOnlyDetachesItself)
+{
+    outpost::smpc::Topic<const Data> otherTopic;
+    outpost::smpc::Subscription subscription0(topic, &component, &Component::onReceiveData0);
+    outpost::smpc::Subscription subscription2(otherTopic, &component, &Component::onReceiveData2);
+    unittest::smpc::TestingSubscription::connectSubscriptionsToTopics();
+
+    outpost::smpc::Subscription* subscription1 =
+            new outpost::smpc::Subscription(topic, &component, &Component::onReceiveData1);
+    delete subscription1;
+
+    topic.publish(data);
+    otherTopic.publish(data);
+    EXPECT_TRUE(component.received[0]);
+    EXPECT_FALSE(component.received[1]);
+    EXPECT_TRUE(component.received[2]);
+}
+
+class OrderedComponent : public outpost::smpc::Subscriber
+{
+public:
+    void
+    onReceive0(const Data*)
+    {
+        order.push_back(0);
+    }
+
+    void
+    onReceive1(const Data*)
+    {
+        order.push_back(1);
+    }
+
+    void
+    onReceive2(const Data*)
+    {
+        order.push_back(2);
+    }
+
+    std::vector<int> order;
+};
+
+TEST_F(SubscriptionTest, shouldCallHigherPriorityFirst)
+{
+    OrderedComponent ordered;
+    outpost::smpc::Subscription low(topic, &ordered, &OrderedComponent::onReceive0);
+    outpost::smpc::Subscription high(topic, &ordered, &OrderedComponent::onReceive1);
+    outpost::smpc::Subscription medium(topic, &ordered, &OrderedComponent::onReceive2);
+    high.setPriority(200);
+    medium.setPriority(100);
+    unittest::smpc::TestingSubscription::connectSubscriptionsToTopics();
+
+    topic.publish(data);
+    EXPECT_EQ(std::vector<int>({1, 2, 0}), ordered.order);
+}
+
+TEST_F(SubscriptionTest, shouldReorderConnectedSubscription)
+{
+    OrderedComponent ordered;
+    outpost::smpc::Subscription first(topic, &ordered, &OrderedComponent::onReceive0);
+    outpost::smpc::Subscription second(topic, &ordered, &OrderedComponent::onReceive1);
+    unittest::smpc::TestingSubscription::connectSubscriptionsToTopics();
+
+    first.setPriority(10);
+    topic.publish(data);
+    EXPECT_EQ(std::vector<int>({0, 1}), ordered.order);
+    EXPECT_EQ(10, first.getPriority());
+
+    ordered.order.clear();
+    second.setPriority(20);
+    topic.publish(data);
+    EXPECT_EQ(std::vector<int>({1, 0}), ordered.order);
+}
@@ -34,8 +34,8 @@ TestingTopicBase::dumpConnectedSubscriptions(outpost::smpc::TopicBase& base)
 {
     printf("topic %p\n", reinterpret_cast<void*>(this));
 
-    for (Subscription* topic = base.mSubscriptions; topic != 0;
-         topic = topic->mNextTopicSubscription)
+    for (Subscription* topic = base.mSubscriptions.load(); topic != 0;
+         topic = topic->mNextTopicSubscription.load())
     {
         printf("- %p\n", reinterpret_cast<void*>(topic));
     }
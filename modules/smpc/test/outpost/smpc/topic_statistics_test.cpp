@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/smpc/subscription.h>
+#include <outpost/smpc/subscription_raw.h>
+#include <outpost/smpc/topic.h>
+#include <outpost/smpc/topic_raw.h>
+#include <outpost/smpc/topic_statistics.h>
+
+#include <unittest/harness.h>
+#include <unittest/smpc/testing_subscription.h>
+#include <unittest/smpc/testing_subscription_raw.h>
+
+#include <stdint.h>
+
+#include <vector>
+
+// Without the define the statistics tests below would silently compile to
+// nothing, test/SConstruct enables it for the unit tests.
+#ifndef OUTPOST_SMPC_STATISTICS
+#error "The smpc unit tests have to be built with OUTPOST_SMPC_STATISTICS"
+#endif
+
+using outpost::smpc::CallbackStatistics;
+using outpost::time::Microseconds;
+using outpost::time::Milliseconds;
+
+TEST(CallbackStatisticsTest, shouldTrackMaximumAndTotal)
+{
+    CallbackStatistics statistics;
+    statistics.record(Microseconds(30));
+    statistics.record(Microseconds(100));
+    statistics.record(Microseconds(20));
+
+    EXPECT_EQ(3U, statistics.getNumberOfCalls());
+    EXPECT_EQ(Microseconds(100), statistics.getMaximumExecutionTime());
+    EXPECT_EQ(Microseconds(150), statistics.getTotalExecutionTime());
+
+    statistics.reset();
+    EXPECT_EQ(0U, statistics.getNumberOfCalls());
+    EXPECT_EQ(Microseconds(0), statistics.getMaximumExecutionTime());
+    EXPECT_EQ(Microseconds(0), statistics.getTotalExecutionTime());
+}
+
+TEST(CallbackStatisticsTest, shouldIgnoreNegativeDurations)
+{
+    CallbackStatistics statistics;
+    statistics.record(Microseconds(-5));
+
+    EXPECT_EQ(1U, statistics.getNumberOfCalls());
+    EXPECT_EQ(Microseconds(0), statistics.getTotalExecutionTime());
+}
+
+namespace
+{
+class SlowComponent : public outpost::smpc::Subscriber
+{
+public:
+    void
+    onFast(const uint32_t*)
+    {
+    }
+
+    void
+    onSlow(const uint32_t*)
+    {
+        const outpost::time::SpacecraftElapsedTime start = outpost::smpc::StatisticsClock::now();
+        while (outpost::smpc::StatisticsClock::now() - start < Milliseconds(2))
+        {
+        }
+    }
+
+    void
+    onBatch(outpost::Slice<const uint32_t>)
+    {
+    }
+
+    void
+    onRaw(const void*, size_t)
+    {
+    }
+};
+
+class RecordingVisitor : public outpost::smpc::StatisticsVisitor
+{
+public:
+    struct Topic
+    {
+        const void* topic;
+        uint32_t numberOfPublishes;
+        size_t numberOfSubscriptions;
+    };
+
+    virtual void
+    visitTopic(const void* topic,
+               const outpost::smpc::TopicStatistics& statistics,
+               size_t numberOfSubscriptions) override
+    {
+        mTopics.push_back({topic, statistics.getNumberOfPublishes(), numberOfSubscriptions});
+    }
+
+    virtual void
+    visitSubscription(const void* subscription, const CallbackStatistics& statistics) override
+    {
+        mSubscriptions.push_back(subscription);
+        mCalls.push_back(statistics.getNumberOfCalls());
+    }
+
+    std::vector<Topic> mTopics;
+    std::vector<const void*> mSubscriptions;
+    std::vector<uint32_t> mCalls;
+};
+
+class TopicStatisticsTest : public ::testing::Test
+{
+public:
+    virtual void
+    TearDown()
+    {
+        unittest::smpc::TestingSubscription::releaseAllSubscriptions();
+        unittest::smpc::TestingSubscriptionRaw::releaseAllSubscriptions();
+    }
+
+    SlowComponent mComponent;
+};
+}  // namespace
+
+TEST_F(TopicStatisticsTest, shouldCountPublishesAndCallbacks)
+{
+    outpost::smpc::Topic<const uint32_t> topic;
+    outpost::smpc::Subscription fast(topic, &mComponent, &SlowComponent::onFast);
+    outpost::smpc::Subscription slow(topic, &mComponent, &SlowComponent::onSlow);
+    unittest::smpc::TestingSubscription::connectSubscriptionsToTopics();
+
+    const uint32_t value = 1;
+    topic.publish(value);
+    topic.publish(value);
+
+    EXPECT_EQ(2U, topic.getStatistics().getNumberOfPublishes());
+    EXPECT_EQ(2U, topic.getNumberOfSubscriptions());
+    EXPECT_EQ(2U, fast.getStatistics().getNumberOfCalls());
+    EXPECT_EQ(2U, slow.getStatistics().getNumberOfCalls());
+    EXPECT_GE(slow.getStatistics().getMaximumExecutionTime(), Milliseconds(2));
+    EXPECT_GE(slow.getStatistics().getTotalExecutionTime(), Milliseconds(4));
+    EXPECT_LT(fast.getStatistics().getMaximumExecutionTime(),
+              slow.getStatistics().getMaximumExecutionTime());
+
+    topic.resetStatistics();
+    EXPECT_EQ(0U, topic.getStatistics().getNumberOfPublishes());
+    EXPECT_EQ(0U, slow.getStatistics().getNumberOfCalls());
+}
+
+TEST_F(TopicStatisticsTest, shouldVisitAllTopics)
+{
+    outpost::smpc::Topic<const uint32_t> topic;
+    outpost::smpc::Topic<const uint32_t> unusedTopic;
+    outpost::smpc::Subscription subscription(topic, &mComponent, &SlowComponent::onFast);
+    unittest::smpc::TestingSubscription::connectSubscriptionsToTopics();
+
+    const uint32_t value = 1;
+    topic.publish(value);
+
+    RecordingVisitor visitor;
+    outpost::smpc::TopicBase::visitStatistics(visitor);
+
+    bool foundTopic = false;
+    bool foundUnusedTopic = false;
+    for (const RecordingVisitor::Topic& entry : visitor.mTopics)
+    {
+        if (entry.topic == static_cast<const void*>(&topic))
+        {
+            foundTopic = true;
+            EXPECT_EQ(1U, entry.numberOfPublishes);
+            EXPECT_EQ(1U, entry.numberOfSubscriptions);
+        }
+        else if (entry.topic == static_cast<const void*>(&unusedTopic))
+        {
+            foundUnusedTopic = true;
+            EXPECT_EQ(0U, entry.numberOfPublishes);
+            EXPECT_EQ(0U, entry.numberOfSubscriptions);
+        }
+    }
+    EXPECT_TRUE(foundTopic);
+    EXPECT_TRUE(foundUnusedTopic);
+
+    ASSERT_EQ(1U, visitor.mSubscriptions.size());
+    EXPECT_EQ(static_cast<const void*>(&subscription), visitor.mSubscriptions[0]);
+    EXPECT_EQ(1U, visitor.mCalls[0]);
+}
+
+TEST_F(TopicStatisticsTest, shouldRecordRawTopics)
+{
+    outpost::smpc::TopicRaw topic;
+    outpost::smpc::SubscriptionRaw subscription(topic, &mComponent, &SlowComponent::onRaw);
+    unittest::smpc::TestingSubscriptionRaw::connectSubscriptionsToTopics();
+
+    const uint8_t data[2] = {1, 2};
+    topic.publish(data, sizeof(data));
+
+    RecordingVisitor visitor;
+    outpost::smpc::TopicRaw::visitStatistics(visitor);
+
+    ASSERT_EQ(1U, visitor.mTopics.size());
+    EXPECT_EQ(static_cast<const void*>(&topic), visitor.mTopics[0].topic);
+    EXPECT_EQ(1U, visitor.mTopics[0].numberOfPublishes);
+    EXPECT_EQ(1U, subscription.getStatistics().getNumberOfCalls());
+}
+
+TEST_F(TopicStatisticsTest, shouldCountBatchAsOnePublish)
+{
+    outpost::smpc::Topic<const uint32_t> topic;
+    outpost::smpc::Subscription batch(topic, &mComponent, &SlowComponent::onBatch);
+    unittest::smpc::TestingSubscription::connectSubscriptionsToTopics();
+
+    const uint32_t values[] = {1, 2, 3};
+    topic.publishBatch(outpost::asSlice(values));
+    topic.publishBatch(outpost::Slice<const uint32_t>::empty());
+
+    EXPECT_EQ(1U, topic.getStatistics().getNumberOfPublishes());
+    EXPECT_EQ(1U, batch.getStatistics().getNumberOfCalls());
+}
+
+TEST_F(TopicStatisticsTest, shouldCountRawBatchAsOnePublish)
+{
+    outpost::smpc::TopicRaw topic;
+    outpost::smpc::SubscriptionRaw subscription(topic, &mComponent, &SlowComponent::onRaw);
+    unittest::smpc::TestingSubscriptionRaw::connectSubscriptionsToTopics();
+
+    const uint8_t first[] = {1, 2};
+    const uint8_t second[] = {3};
+    const outpost::Slice<const uint8_t> messages[] = {outpost::asSlice(first),
+                                                      outpost::asSlice(second)};
+    topic.publish(outpost::asSlice(messages));
+    topic.publish(outpost::Slice<const outpost::Slice<const uint8_t>>::empty());
+
+    EXPECT_EQ(1U, topic.getStatistics().getNumberOfPublishes());
+    EXPECT_EQ(1U, subscription.getStatistics().getNumberOfCalls());
+}
@@ -17,6 +17,8 @@
 #ifndef OUTPOST_SUPPORT_HEARTBEAT_H
 #define OUTPOST_SUPPORT_HEARTBEAT_H
 
+#include "heartbeat_registry.h"
+
 #include <outpost/parameter/support.h>
 #include <outpost/smpc/topic.h>
 #include <outpost/time/time_epoch.h>
@@ -87,6 +89,12 @@ namespace support
  *     }
  * }
  * \endcode
+ *
+ * ## Delivery
+ *
+ * By default every tick is published on the watchdogHeartbeat topic. If
+ * the HeartbeatRegistry is enabled the ticks are only stored as the
+ * latest deadline of the source, which the watchdog scans periodically.
  */
 struct Heartbeat
 {
@@ -145,6 +153,11 @@ void
 Heartbeat::send(outpost::support::parameter::HeartbeatSource source,
                 outpost::time::Duration timeToNextTick)
 {
+    if (HeartbeatRegistry::updateAfter(source, timeToNextTick))
+    {
+        return;
+    }
+
     Heartbeat trigger{source,
                       TimeoutType::relativeTime,
                       outpost::time::SpacecraftElapsedTime::afterEpoch(timeToNextTick)};
@@ -155,6 +168,12 @@ void
 Heartbeat::send(outpost::support::parameter::HeartbeatSource source,
                 outpost::time::SpacecraftElapsedTime nextTick)
 {
+    if (HeartbeatRegistry::isEnabled())
+    {
+        HeartbeatRegistry::update(source, nextTick);
+        return;
+    }
+
     Heartbeat trigger{source, TimeoutType::absoluteTime, nextTick};
     watchdogHeartbeat.publish(trigger);
 }
@@ -162,6 +181,12 @@ Heartbeat::send(outpost::support::parameter::HeartbeatSource source,
 void
 Heartbeat::suspend(outpost::support::parameter::HeartbeatSource source)
 {
+    if (HeartbeatRegistry::isEnabled())
+    {
+        HeartbeatRegistry::suspend(source);
+        return;
+    }
+
     // The heartbeat is suspended by setting the next time to
     // the highest possible relative time.
     Heartbeat trigger{source, TimeoutType::suspended, time::SpacecraftElapsedTime::endOfEpoch()};
@@ -22,7 +22,13 @@ namespace support
 void
 HeartbeatLimiter::send(outpost::time::Duration processingTimeout)
 {
-    outpost::time::SpacecraftElapsedTime currentTime = mClock.now();
+    if (mClock == nullptr)
+    {
+        Heartbeat::send(mSource, processingTimeout);
+        return;
+    }
+
+    outpost::time::SpacecraftElapsedTime currentTime = mClock->now();
     outpost::time::Duration timeout =
             mHeartbeatInterval + processingTimeout + parameter::heartbeatTolerance;
 
@@ -36,5 +42,12 @@ HeartbeatLimiter::send(outpost::time::Duration processingTimeout)
     }
 }
 
+void
+HeartbeatLimiter::suspend()
+{
+    mTimeout = time::SpacecraftElapsedTime::startOfEpoch();
+    Heartbeat::suspend(mSource);
+}
+
 }  // namespace support
 }  // namespace outpost
@@ -41,6 +41,10 @@ namespace support
  * can be called after each processing step, but the heartbeat tick will
  * only be sent when necessary.
  *
+ * A limiter constructed without a clock forwards every tick unchanged until
+ * setInterval() is called. Threads use this to provide rate limiting as an
+ * option without changing their heartbeat behavior by default.
+ *
  * \see outpost::support::Heartbeat for a more detailed description of the
  *      heartbeat timing.
  */
@@ -50,13 +54,39 @@ public:
     inline HeartbeatLimiter(outpost::time::Clock& clock,
                             const outpost::time::Duration heartbeatInterval,
                             const outpost::support::parameter::HeartbeatSource source) :
-        mClock(clock),
+        mClock(&clock),
         mHeartbeatInterval(heartbeatInterval),
         mSource(source),
         mTimeout(time::SpacecraftElapsedTime::startOfEpoch())
     {
     }
 
+    /**
+     * Create a limiter which sends every heartbeat tick.
+     */
+    explicit inline HeartbeatLimiter(const outpost::support::parameter::HeartbeatSource source) :
+        mClock(nullptr),
+        mHeartbeatInterval(outpost::time::Duration::zero()),
+        mSource(source),
+        mTimeout(time::SpacecraftElapsedTime::startOfEpoch())
+    {
+    }
+
+    /**
+     * Change the heartbeat interval.
+     *
+     * The next call of send() always generates a heartbeat tick.
+     *
+     * \warning Must not be called concurrently with send().
+     */
+    inline void
+    setInterval(outpost::time::Clock& clock, const outpost::time::Duration heartbeatInterval)
+    {
+        mClock = &clock;
+        mHeartbeatInterval = heartbeatInterval;
+        mTimeout = time::SpacecraftElapsedTime::startOfEpoch();
+    }
+
     /**
      * Send a heartbeat signal (if required)
      *
@@ -66,11 +96,18 @@ public:
     void
     send(outpost::time::Duration processingTimeout);
 
+    /**
+     * Suspend the heartbeat, the next call of send() generates a tick again.
+     */
+    void
+    suspend();
+
 private:
-    outpost::time::Clock& mClock;
+    /// nullptr if every heartbeat tick is sent
+    outpost::time::Clock* mClock;
 
     /// A new heartbeat will only be generated after this duration
-    const outpost::time::Duration mHeartbeatInterval;
+    outpost::time::Duration mHeartbeatInterval;
     const outpost::support::parameter::HeartbeatSource mSource;
 
     /// Time at which the heartbeat will expire
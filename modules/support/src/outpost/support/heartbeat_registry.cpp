@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "heartbeat_registry.h"
+
+using outpost::support::HeartbeatRegistry;
+using outpost::support::parameter::HeartbeatSource;
+
+constexpr size_t HeartbeatRegistry::numberOfSources;
+constexpr int64_t HeartbeatRegistry::notReported;
+
+outpost::rtos::Atomic<const outpost::time::Clock*> HeartbeatRegistry::clock(nullptr);
+outpost::rtos::Atomic<int64_t> HeartbeatRegistry::slots[HeartbeatRegistry::numberOfSources];
+
+void
+HeartbeatRegistry::enable(const outpost::time::Clock& c)
+{
+    for (size_t i = 0; i < numberOfSources; ++i)
+    {
+        slots[i].store(notReported);
+    }
+    clock.store(&c);
+}
+
+void
+HeartbeatRegistry::disable()
+{
+    clock.store(nullptr);
+}
+
+bool
+HeartbeatRegistry::hasReported(HeartbeatSource source)
+{
+    return (slots[static_cast<size_t>(source)].load() != notReported);
+}
+
+outpost::time::SpacecraftElapsedTime
+HeartbeatRegistry::getDeadline(HeartbeatSource source)
+{
+    return outpost::time::SpacecraftElapsedTime::afterEpoch(
+            outpost::time::Microseconds(slots[static_cast<size_t>(source)].load()));
+}
+
+size_t
+HeartbeatRegistry::getExpiredSources(outpost::time::SpacecraftElapsedTime now,
+                                     outpost::Slice<HeartbeatSource> expired)
+{
+    const int64_t current = now.timeSinceEpoch().microseconds();
+    size_t count = 0;
+    for (size_t i = 0; i < numberOfSources; ++i)
+    {
+        const int64_t deadline = slots[i].load();
+        if ((deadline != notReported) && (deadline < current))
+        {
+            if (count < expired.getNumberOfElements())
+            {
+                expired[count] = static_cast<HeartbeatSource>(i);
+            }
+            count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_SUPPORT_HEARTBEAT_REGISTRY_H
+#define OUTPOST_SUPPORT_HEARTBEAT_REGISTRY_H
+
+#include <outpost/base/slice.h>
+#include <outpost/parameter/support.h>
+#include <outpost/rtos/atomic.h>
+#include <outpost/time/clock.h>
+#include <outpost/time/time_epoch.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace support
+{
+/**
+ * Latest heartbeat deadline of every heartbeat source.
+ *
+ * Alternative to publishing every heartbeat tick on the
+ * outpost::support::watchdogHeartbeat topic. Once enabled,
+ * Heartbeat::send() and Heartbeat::suspend() only store the absolute
+ * deadline of the source in a lock-free slot instead of taking the topic
+ * mutex and running all subscribers. The watchdog scans the slots
+ * periodically:
+ *
+ * \code
+ * HeartbeatRegistry::enable(clock);
+ * ...
+ * parameter::HeartbeatSource expired[HeartbeatRegistry::numberOfSources];
+ * size_t count = HeartbeatRegistry::getExpiredSources(clock.now(), asSlice(expired));
+ * \endcode
+ *
+ * Relative heartbeat times are converted with the clock given to
+ * enable(). While the registry is disabled (the default) heartbeats are
+ * published on the topic as before.
+ */
+class HeartbeatRegistry
+{
+public:
+    static constexpr size_t numberOfSources =
+            static_cast<size_t>(parameter::HeartbeatSource::lastId);
+
+    /**
+     * Store heartbeats in the registry instead of publishing them.
+     *
+     * Resets all sources to not reported. Must be called before the
+     * threads sending heartbeats are started.
+     */
+    static void
+    enable(const outpost::time::Clock& clock);
+
+    /**
+     * Publish heartbeats on the topic again.
+     */
+    static void
+    disable();
+
+    static inline bool
+    isEnabled()
+    {
+        return (clock.load() != nullptr);
+    }
+
+    /**
+     * Store the deadline of the next heartbeat of a source.
+     */
+    static inline void
+    update(parameter::HeartbeatSource source, outpost::time::SpacecraftElapsedTime nextTick)
+    {
+        slots[static_cast<size_t>(source)].store(nextTick.timeSinceEpoch().microseconds());
+    }
+
+    /**
+     * Store the deadline relative to the current time of the clock given
+     * to enable().
+     *
+     * \retval false  The registry is disabled, nothing has been stored.
+     */
+    static inline bool
+    updateAfter(parameter::HeartbeatSource source, outpost::time::Duration timeToNextTick)
+    {
+        // Loaded once, disable() may be called concurrently
+        const outpost::time::Clock* current = clock.load();
+        if (current == nullptr)
+        {
+            return false;
+        }
+        update(source, current->now() + timeToNextTick);
+        return true;
+    }
+
+    static inline void
+    suspend(parameter::HeartbeatSource source)
+    {
+        update(source, outpost::time::SpacecraftElapsedTime::endOfEpoch());
+    }
+
+    /**
+     * Check whether a heartbeat was reported since enable().
+     */
+    static bool
+    hasReported(parameter::HeartbeatSource source);
+
+    /**
+     * Deadline of the next heartbeat, only valid if hasReported().
+     */
+    static outpost::time::SpacecraftElapsedTime
+    getDeadline(parameter::HeartbeatSource source);
+
+    /**
+     * Find all sources whose deadline has passed.
+     *
+     * Sources which have not reported a heartbeat yet or are suspended are
+     * not expired.
+     *
+     * \param now
+     *      Current time.
+     * \param expired
+     *      Receives the expired sources.
+     *
+     * \return  Number of expired sources, may be larger than \p expired if
+     *          not all of them fit.
+     */
+    static size_t
+    getExpiredSources(outpost::time::SpacecraftElapsedTime now,
+                      outpost::Slice<parameter::HeartbeatSource> expired);
+
+private:
+    /// Slot value of a source which has not reported a heartbeat
+    static constexpr int64_t notReported = INT64_MIN;
+
+    static outpost::rtos::Atomic<const outpost::time::Clock*> clock;
+
+    /// Deadline in microseconds for every source
+    static outpost::rtos::Atomic<int64_t> slots[numberOfSources];
+};
+
+}  // namespace support
+}  // namespace outpost
+
+#endif
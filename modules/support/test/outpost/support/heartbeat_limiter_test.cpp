@@ -118,3 +118,52 @@ TEST_F(HeartbeatLimiterTest, shouldResendOnShorterExecutionTimeout)
     mLogger.dropNext();
     EXPECT_TRUE(mLogger.isEmpty());
 }
+
+TEST_F(HeartbeatLimiterTest, shouldResendAfterSuspend)
+{
+    mHeartbeat.send(executionTimeoutShort);
+    mLogger.clear();
+
+    mHeartbeat.suspend();
+    ASSERT_FALSE(mLogger.isEmpty());
+    EXPECT_EQ(Heartbeat::TimeoutType::suspended, mLogger.getNext().mTimeoutType);
+    mLogger.dropNext();
+
+    // The suspension must be released by the next tick
+    mHeartbeat.send(executionTimeoutShort);
+    ASSERT_FALSE(mLogger.isEmpty());
+    EXPECT_EQ(Heartbeat::TimeoutType::relativeTime, mLogger.getNext().mTimeoutType);
+}
+
+TEST_F(HeartbeatLimiterTest, shouldForwardEveryTickWithoutClock)
+{
+    HeartbeatLimiter limiter(source);
+
+    limiter.send(executionTimeoutShort);
+    limiter.send(executionTimeoutShort);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        ASSERT_FALSE(mLogger.isEmpty());
+        EXPECT_EQ(outpost::time::SpacecraftElapsedTime::afterEpoch(executionTimeoutShort),
+                  mLogger.getNext().mTimeout);
+        mLogger.dropNext();
+    }
+    EXPECT_TRUE(mLogger.isEmpty());
+}
+
+TEST_F(HeartbeatLimiterTest, shouldLimitTicksAfterSettingInterval)
+{
+    HeartbeatLimiter limiter(source);
+    limiter.setInterval(mClock, heartbeatInterval);
+
+    limiter.send(executionTimeoutShort);
+    limiter.send(executionTimeoutShort);
+
+    ASSERT_FALSE(mLogger.isEmpty());
+    EXPECT_EQ(outpost::time::SpacecraftElapsedTime::afterEpoch(
+                      heartbeatInterval + executionTimeoutShort + parameter::heartbeatTolerance),
+              mLogger.getNext().mTimeout);
+    mLogger.dropNext();
+    EXPECT_TRUE(mLogger.isEmpty());
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/support/heartbeat.h>
+#include <outpost/support/heartbeat_registry.h>
+
+#include <unittest/harness.h>
+#include <unittest/smpc/topic_logger.h>
+#include <unittest/time/testing_clock.h>
+
+using namespace outpost::support;
+using outpost::support::parameter::HeartbeatSource;
+using outpost::time::Seconds;
+using outpost::time::SpacecraftElapsedTime;
+
+class HeartbeatRegistryTest : public testing::Test
+{
+public:
+    HeartbeatRegistryTest() : mClock(), mLogger(watchdogHeartbeat)
+    {
+        mClock.incrementBy(Seconds(100));
+    }
+
+    virtual void
+    SetUp() override
+    {
+        unittest::smpc::TestingSubscription::connectSubscriptionsToTopics();
+        HeartbeatRegistry::enable(mClock);
+    }
+
+    virtual void
+    TearDown() override
+    {
+        HeartbeatRegistry::disable();
+        unittest::smpc::TestingSubscription::releaseAllSubscriptions();
+    }
+
+    unittest::time::TestingClock mClock;
+    unittest::smpc::TopicLogger<const Heartbeat> mLogger;
+};
+
+TEST_F(HeartbeatRegistryTest, shouldStoreDeadlineInsteadOfPublishing)
+{
+    EXPECT_FALSE(HeartbeatRegistry::hasReported(HeartbeatSource::default0));
+
+    Heartbeat::send(HeartbeatSource::default0, Seconds(5));
+    EXPECT_TRUE(mLogger.isEmpty());
+    EXPECT_TRUE(HeartbeatRegistry::hasReported(HeartbeatSource::default0));
+    EXPECT_EQ(SpacecraftElapsedTime::afterEpoch(Seconds(105)),
+              HeartbeatRegistry::getDeadline(HeartbeatSource::default0));
+
+    Heartbeat::send(HeartbeatSource::default0, SpacecraftElapsedTime::afterEpoch(Seconds(200)));
+    EXPECT_EQ(SpacecraftElapsedTime::afterEpoch(Seconds(200)),
+              HeartbeatRegistry::getDeadline(HeartbeatSource::default0));
+}
+
+TEST_F(HeartbeatRegistryTest, shouldFindExpiredSources)
+{
+    Heartbeat::send(HeartbeatSource::default0, Seconds(5));
+    Heartbeat::send(HeartbeatSource::default1, Seconds(10));
+
+    HeartbeatSource expired[HeartbeatRegistry::numberOfSources];
+    EXPECT_EQ(0U, HeartbeatRegistry::getExpiredSources(mClock.now(), outpost::asSlice(expired)));
+
+    mClock.incrementBy(Seconds(6));
+    ASSERT_EQ(1U, HeartbeatRegistry::getExpiredSources(mClock.now(), outpost::asSlice(expired)));
+    EXPECT_EQ(HeartbeatSource::default0, expired[0]);
+
+    // A new tick revives the source
+    Heartbeat::send(HeartbeatSource::default0, Seconds(5));
+    mClock.incrementBy(Seconds(5));
+    ASSERT_EQ(1U, HeartbeatRegistry::getExpiredSources(mClock.now(), outpost::asSlice(expired)));
+    EXPECT_EQ(HeartbeatSource::default1, expired[0]);
+}
+
+TEST_F(HeartbeatRegistryTest, shouldNotExpireSuspendedOrUnreportedSources)
+{
+    Heartbeat::suspend(HeartbeatSource::default0);
+    mClock.incrementBy(Seconds(1000));
+
+    HeartbeatSource expired[HeartbeatRegistry::numberOfSources];
+    EXPECT_EQ(0U, HeartbeatRegistry::getExpiredSources(mClock.now(), outpost::asSlice(expired)));
+    EXPECT_TRUE(mLogger.isEmpty());
+}
+
+TEST_F(HeartbeatRegistryTest, shouldPublishWhenDisabled)
+{
+    HeartbeatRegistry::disable();
+    Heartbeat::send(HeartbeatSource::default1, Seconds(5));
+
+    ASSERT_FALSE(mLogger.isEmpty());
+    EXPECT_EQ(HeartbeatSource::default1, mLogger.getNext().mSource);
+    EXPECT_FALSE(HeartbeatRegistry::hasReported(HeartbeatSource::default1));
+}
@@ -130,31 +130,35 @@ DateUtils::getDay(Date date)
 /**
  * Calculate a Gregorian date from a the day count.
  *
- * In the Gregorian calendar the length of a year is defined as
- * 365.2425 days (= 365 + 1/4 - 1/100 + 1/400).
+ * The day count is split into centuries, years and days with Euclidean
+ * affine functions, all divisions are by constants and can be replaced by
+ * multiplications by the compiler. Valid for all days representable by
+ * Date (year 0 to 65535).
  */
 Date
 DateUtils::getDate(int64_t day)
 {
-    // Guess the year from the day count
-    int y = (10000 * day + 14780) / 3652425;
+    const uint32_t n1 = 4 * static_cast<uint32_t>(day) + 3;
+    const uint32_t century = n1 / 146097;
 
-    int daysInYear = day - getDaysBeforeYear(y);
-    if (daysInYear < 0)
-    {
-        // Correct the year if the guess was not correct
-        y = y - 1;
-        daysInYear = day - getDaysBeforeYear(y);
-    }
+    // Equal to 4 * ((n1 % 146097) / 4) + 3
+    const uint32_t n2 = (n1 % 146097) | 3;
+    const uint32_t yearOfCentury = n2 / 1461;
+    const uint32_t dayOfYear = (n2 % 1461) / 4;
 
-    int mi = getMonthFromDayOfYear(daysInYear);
+    // Month from 3 (March) to 14 (February of the following year) and
+    // the day of the month starting with zero
+    const uint32_t n3 = 2141 * dayOfYear + 197913;
+    const uint32_t month = n3 / 65536;
+    const uint32_t dayOfMonth = (n3 % 65536) / 2141;
 
-    Date date;
+    // January and February belong to the next Gregorian year
+    const bool nextYear = (dayOfYear >= 306);
 
-    // Correct date from month=0 -> March to month=0 -> January
-    date.year = y + (mi + 2) / 12;
-    date.month = (mi + 2) % 12 + 1;
-    date.day = daysInYear - getDaysBeforeMonth(mi) + 1;
+    Date date;
+    date.year = 100 * century + yearOfCentury + (nextYear ? 1 : 0);
+    date.month = nextYear ? (month - 12) : month;
+    date.day = dayOfMonth + 1;
     date.hour = 0;
     date.minute = 0;
     date.second = 0;
@@ -232,6 +236,101 @@ Date::isValid() const
     return valid;
 }
 
+// ----------------------------------------------------------------------------
+constexpr size_t Date::iso8601Length;
+
+static inline void
+writeDigits(char* buffer, unsigned int value, size_t numberOfDigits)
+{
+    for (size_t i = numberOfDigits; i > 0; --i)
+    {
+        buffer[i - 1] = static_cast<char>('0' + (value % 10));
+        value /= 10;
+    }
+}
+
+static inline bool
+readDigits(const char* text, size_t numberOfDigits, unsigned int& value)
+{
+    unsigned int result = 0;
+    for (size_t i = 0; i < numberOfDigits; ++i)
+    {
+        const unsigned int digit = static_cast<unsigned char>(text[i]) - '0';
+        if (digit > 9)
+        {
+            return false;
+        }
+        result = result * 10 + digit;
+    }
+    value = result;
+    return true;
+}
+
+size_t
+Date::toIso8601(outpost::Slice<char> buffer) const
+{
+    if ((buffer.getNumberOfElements() < iso8601Length) || (year > 9999))
+    {
+        return 0;
+    }
+
+    char* out = &buffer[0];
+    writeDigits(&out[0], year, 4);
+    out[4] = '-';
+    writeDigits(&out[5], month, 2);
+    out[7] = '-';
+    writeDigits(&out[8], day, 2);
+    out[10] = 'T';
+    writeDigits(&out[11], hour, 2);
+    out[13] = ':';
+    writeDigits(&out[14], minute, 2);
+    out[16] = ':';
+    writeDigits(&out[17], second, 2);
+    out[19] = 'Z';
+
+    return iso8601Length;
+}
+
+bool
+Date::fromIso8601(outpost::Slice<const char> text, Date& date)
+{
+    const size_t length = text.getNumberOfElements();
+    if ((length != iso8601Length - 1) && !((length == iso8601Length) && (text[19] == 'Z')))
+    {
+        return false;
+    }
+
+    const char* in = &text[0];
+    if ((in[4] != '-') || (in[7] != '-') || (in[10] != 'T') || (in[13] != ':')
+        || (in[16] != ':'))
+    {
+        return false;
+    }
+
+    unsigned int values[6];
+    if (!readDigits(&in[0], 4, values[0]) || !readDigits(&in[5], 2, values[1])
+        || !readDigits(&in[8], 2, values[2]) || !readDigits(&in[11], 2, values[3])
+        || !readDigits(&in[14], 2, values[4]) || !readDigits(&in[17], 2, values[5]))
+    {
+        return false;
+    }
+
+    Date parsed;
+    parsed.year = values[0];
+    parsed.month = values[1];
+    parsed.day = values[2];
+    parsed.hour = values[3];
+    parsed.minute = values[4];
+    parsed.second = values[5];
+    if (!parsed.isValid())
+    {
+        return false;
+    }
+
+    date = parsed;
+    return true;
+}
+
 // ----------------------------------------------------------------------------
 GpsDate
 GpsDate::fromGpsTime(GpsTime time)
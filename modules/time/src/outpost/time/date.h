@@ -16,6 +16,10 @@
 
 #include "time_epoch.h"
 
+#include <outpost/base/slice.h>
+
+#include <stddef.h>
+
 namespace outpost
 {
 namespace time
@@ -26,8 +30,13 @@ struct Date;
 /**
  * Helper class to simplify the calculation of dates.
  *
- * Based on the following algorithm:
+ * getDay() is based on the following algorithm:
  * https://alcor.concordia.ca/~gpkatch/gdate-method.html
+ *
+ * getDate() uses the Euclidean affine functions from C. Neri and
+ * L. Schneider, "Euclidean affine functions and their application to
+ * calendar algorithms" (2022), which avoid divisions by non-constant values
+ * and the correction step of the year estimate.
  */
 struct DateUtils
 {
@@ -49,12 +58,39 @@ struct DateUtils
  */
 struct Date
 {
+    /// Length of "YYYY-MM-DDThh:mm:ssZ"
+    static constexpr size_t iso8601Length = 20;
+
     static Date
     fromUnixTime(UnixTime time);
 
     static UnixTime
     toUnixTime(const Date& date);
 
+    /**
+     * Format as ISO 8601 "YYYY-MM-DDThh:mm:ssZ".
+     *
+     * Does not allocate memory, use printf or append a terminating zero.
+     *
+     * \param buffer
+     *      Output buffer, at least #iso8601Length characters.
+     *
+     * \return Number of characters written, zero if the buffer is too
+     *         small or the year has more than four digits.
+     */
+    size_t
+    toIso8601(outpost::Slice<char> buffer) const;
+
+    /**
+     * Parse an ISO 8601 date in the format "YYYY-MM-DDThh:mm:ss" with an
+     * optional trailing 'Z'.
+     *
+     * \retval true   \p text holds a valid date, stored in \p date.
+     * \retval false  Invalid format or date, \p date is unchanged.
+     */
+    static bool
+    fromIso8601(outpost::Slice<const char> text, Date& date);
+
     /**
      * Check that given value represent a valid date.
      */
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "leap_second_converter.h"
+
+#include <limits>
+
+using namespace outpost::time;
+
+typedef TimeEpochConverter<TaiEpoch, UnixEpoch> TaiToUnix;
+
+LeapSecondConverter::LeapSecondConverter() :
+    // Empty intervals, the first conversion has to search the table
+    mRemoveInterval{0, 0, 0},
+    mAddInterval{0, 0, 0}
+{
+}
+
+UnixTime
+LeapSecondConverter::toUnixTime(AtomicTime from)
+{
+    const int64_t correction = getCorrectionFactorForLeapSeconds(
+            from.timeSinceEpoch().seconds(), LeapSecondCorrection::remove);
+    return UnixTime::afterEpoch(from.timeSinceEpoch()
+                                - Seconds(TaiToUnix::initialOffsetInSeconds + correction));
+}
+
+UnixTime
+LeapSecondConverter::toUnixTime(GpsTime from)
+{
+    return toUnixTime(from.convertTo<AtomicTime>());
+}
+
+AtomicTime
+LeapSecondConverter::toAtomicTime(UnixTime from)
+{
+    const int64_t seconds = from.timeSinceEpoch().seconds() + TaiToUnix::initialOffsetInSeconds;
+    const int64_t correction =
+            getCorrectionFactorForLeapSeconds(seconds, LeapSecondCorrection::add);
+    return AtomicTime::afterEpoch(from.timeSinceEpoch()
+                                  + Seconds(TaiToUnix::initialOffsetInSeconds + correction));
+}
+
+GpsTime
+LeapSecondConverter::toGpsTime(UnixTime from)
+{
+    return toAtomicTime(from).convertTo<GpsTime>();
+}
+
+int64_t
+LeapSecondConverter::getCorrectionFactorForLeapSeconds(int64_t seconds,
+                                                       LeapSecondCorrection::Type correction)
+{
+    Interval& cached =
+            (correction == LeapSecondCorrection::add) ? mAddInterval : mRemoveInterval;
+    if (!cached.contains(seconds))
+    {
+        cached = findInterval(seconds, correction);
+    }
+    return cached.mCorrectionFactor;
+}
+
+LeapSecondConverter::Interval
+LeapSecondConverter::findInterval(int64_t seconds, LeapSecondCorrection::Type correction)
+{
+    const outpost::Slice<const int64_t> leapSeconds = TaiToUnix::getLeapSeconds();
+    const size_t numberOfLeapSeconds = leapSeconds.getNumberOfElements();
+
+    // Index of the newest leap second not after the given time, the table
+    // is sorted newest first.
+    size_t first = 0;
+    size_t last = numberOfLeapSeconds;
+    while (first < last)
+    {
+        const size_t middle = first + (last - first) / 2;
+        if (seconds >= leapSeconds[middle])
+        {
+            last = middle;
+        }
+        else
+        {
+            first = middle + 1;
+        }
+    }
+    const size_t index = first;
+
+    Interval interval;
+    interval.mBegin = (index < numberOfLeapSeconds) ? leapSeconds[index]
+                                                    : std::numeric_limits<int64_t>::min();
+    interval.mEnd = (index > 0) ? leapSeconds[index - 1] : std::numeric_limits<int64_t>::max();
+    interval.mCorrectionFactor = static_cast<int64_t>(numberOfLeapSeconds - index);
+
+    // Same as in getCorrectionFactorForLeapSeconds(): adding the leap
+    // seconds can lead into the next leap second, which splits the interval.
+    if ((correction == LeapSecondCorrection::add) && (index > 0)
+        && (index < numberOfLeapSeconds))
+    {
+        const int64_t split = interval.mEnd - interval.mCorrectionFactor;
+        if (seconds < split)
+        {
+            interval.mEnd = split;
+        }
+        else
+        {
+            interval.mBegin = split;
+            interval.mCorrectionFactor += 1;
+        }
+    }
+    return interval;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_TIME_LEAP_SECOND_CONVERTER_H
+#define OUTPOST_TIME_LEAP_SECOND_CONVERTER_H
+
+#include "time_epoch.h"
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace time
+{
+/**
+ * Conversion between TAI, GPS and Unix time with a cached leap second
+ * lookup.
+ *
+ * Gives the same results as TimePoint::convertTo(). The interval between
+ * two leap seconds used by the last conversion is remembered, further
+ * time points within the same interval are converted without searching
+ * the leap second table. Otherwise the table is searched with a binary
+ * search. This makes converting monotonically increasing time stamps,
+ * e.g. for every generated packet, a constant time operation.
+ *
+ * \warning
+ *      The cache is not synchronized, every thread has to use its own
+ *      converter.
+ */
+class LeapSecondConverter
+{
+public:
+    typedef TimeEpochConverter<TaiEpoch, UnixEpoch>::LeapSecondCorrection LeapSecondCorrection;
+
+    LeapSecondConverter();
+
+    // disable copy constructor
+    LeapSecondConverter(const LeapSecondConverter& other) = delete;
+
+    // disable assignment operator
+    LeapSecondConverter&
+    operator=(const LeapSecondConverter& other) = delete;
+
+    UnixTime
+    toUnixTime(AtomicTime from);
+
+    UnixTime
+    toUnixTime(GpsTime from);
+
+    AtomicTime
+    toAtomicTime(UnixTime from);
+
+    GpsTime
+    toGpsTime(UnixTime from);
+
+    /**
+     * Cached version of
+     * TimeEpochConverter<TaiEpoch, UnixEpoch>::getCorrectionFactorForLeapSeconds().
+     */
+    int64_t
+    getCorrectionFactorForLeapSeconds(int64_t seconds, LeapSecondCorrection::Type correction);
+
+private:
+    /// Time span with a constant correction factor, in seconds since the TAI epoch
+    struct Interval
+    {
+        int64_t mBegin;
+        int64_t mEnd;
+        int64_t mCorrectionFactor;
+
+        inline bool
+        contains(int64_t seconds) const
+        {
+            return (seconds >= mBegin) && (seconds < mEnd);
+        }
+    };
+
+    static Interval
+    findInterval(int64_t seconds, LeapSecondCorrection::Type correction);
+
+    Interval mRemoveInterval;
+    Interval mAddInterval;
+};
+
+}  // namespace time
+}  // namespace outpost
+
+#endif
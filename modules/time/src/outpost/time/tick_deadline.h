@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_TIME_TICK_DEADLINE_H
+#define OUTPOST_TIME_TICK_DEADLINE_H
+
+#include <outpost/time/clock.h>
+#include <outpost/time/duration.h>
+#include <outpost/time/time_epoch.h>
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace time
+{
+/**
+ * Point in time for short relative timeouts based on 32 bit ticks.
+ *
+ * Duration and TimePoint use 64 bit arithmetic, which is comparably
+ * expensive on 32 bit targets. A TickDeadline keeps only the lower 32 bit
+ * of the microseconds since the epoch, all comparisons are done with one
+ * wrap-safe 32 bit subtraction.
+ *
+ * The ticks wrap after roughly 71 minutes, timeouts are therefore limited
+ * to maximumTimeout() (roughly 35 minutes) and longer timeouts are
+ * shortened to it. Duration::infinity() is kept as a deadline which
+ * never expires.
+ *
+ * \code
+ * outpost::time::TickDeadline deadline(clock.now(), timeout);
+ * while (!deadline.isExpired(clock.now()))
+ * {
+ *     if (queue.receive(data, deadline.getRemainingTime(clock.now())))
+ *     {
+ *         ...
+ *     }
+ * }
+ * \endcode
+ */
+class TickDeadline
+{
+public:
+    /**
+     * Longest timeout which can be represented.
+     */
+    static inline constexpr Duration
+    maximumTimeout()
+    {
+        return Microseconds(INT32_MAX);
+    }
+
+    /**
+     * Lower 32 bit of the microseconds since the epoch.
+     */
+    static inline uint32_t
+    toTicks(SpacecraftElapsedTime time)
+    {
+        return static_cast<uint32_t>(time.timeSinceEpoch().microseconds());
+    }
+
+    /**
+     * Create an expired deadline.
+     */
+    inline constexpr TickDeadline() : mTicks(0), mInfinite(false), mExpired(true)
+    {
+    }
+
+    /**
+     * Create a deadline \p timeout after \p now.
+     */
+    inline TickDeadline(SpacecraftElapsedTime now, Duration timeout) :
+        mTicks(toTicks(now)),
+        mInfinite(timeout == Duration::infinity()),
+        mExpired(false)
+    {
+        if (timeout > maximumTimeout())
+        {
+            timeout = maximumTimeout();
+        }
+        else if (timeout < Duration::zero())
+        {
+            timeout = Duration::zero();
+        }
+        mTicks += static_cast<uint32_t>(timeout.microseconds());
+    }
+
+    inline TickDeadline(const Clock& clock, Duration timeout) :
+        TickDeadline(clock.now(), timeout)
+    {
+    }
+
+    inline bool
+    isInfinite() const
+    {
+        return mInfinite;
+    }
+
+    /**
+     * Check the deadline against the lower 32 bit of the current time.
+     *
+     * Has to be called at least once every maximumTimeout(), otherwise
+     * the wrap of the ticks hides that the deadline has passed.
+     */
+    inline bool
+    isExpired(uint32_t now) const
+    {
+        return !mInfinite && (mExpired || static_cast<int32_t>(now - mTicks) >= 0);
+    }
+
+    inline bool
+    isExpired(SpacecraftElapsedTime now) const
+    {
+        return isExpired(toTicks(now));
+    }
+
+    /**
+     * Remaining time, suitable to be passed to the timeouts of the
+     * RTOS wait functions and the HAL.
+     *
+     * \return  Duration::infinity() for an infinite deadline,
+     *          Duration::zero() if the deadline has passed.
+     */
+    inline Duration
+    getRemainingTime(uint32_t now) const
+    {
+        if (mInfinite)
+        {
+            return Duration::infinity();
+        }
+        const int32_t remaining = static_cast<int32_t>(mTicks - now);
+        if (mExpired || remaining <= 0)
+        {
+            return Duration::zero();
+        }
+        return Microseconds(remaining);
+    }
+
+    inline Duration
+    getRemainingTime(SpacecraftElapsedTime now) const
+    {
+        return getRemainingTime(toTicks(now));
+    }
+
+private:
+    uint32_t mTicks;
+    bool mInfinite;
+
+    /// Set only for the default constructed deadline
+    bool mExpired;
+};
+
+}  // namespace time
+}  // namespace outpost
+
+#endif
@@ -104,6 +104,12 @@ TimeEpochConverter<TaiEpoch, UnixEpoch>::getCorrectionFactorForLeapSeconds(
     return correctionFactor;
 }
 
+outpost::Slice<const int64_t>
+TimeEpochConverter<TaiEpoch, UnixEpoch>::getLeapSeconds()
+{
+    return outpost::asSlice(leapSecondArray);
+}
+
 TimePoint<UnixEpoch>
 TimeEpochConverter<TaiEpoch, UnixEpoch>::convert(TimePoint<TaiEpoch> from)
 {
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "time_epoch_batch.h"
+
+#include "leap_second_converter.h"
+
+using namespace outpost::time;
+
+namespace
+{
+template <typename From, typename To>
+size_t
+getCount(outpost::Slice<const TimePoint<From>> from, outpost::Slice<TimePoint<To>> to)
+{
+    return (from.getNumberOfElements() < to.getNumberOfElements()) ? from.getNumberOfElements()
+                                                                   : to.getNumberOfElements();
+}
+}  // namespace
+
+namespace outpost
+{
+namespace time
+{
+template <>
+size_t
+TimeEpochBatchConverter<TaiEpoch, UnixEpoch>::convert(outpost::Slice<const AtomicTime> from,
+                                                      outpost::Slice<UnixTime> to)
+{
+    LeapSecondConverter converter;
+    const size_t count = getCount(from, to);
+    for (size_t i = 0; i < count; ++i)
+    {
+        to[i] = converter.toUnixTime(from[i]);
+    }
+    return count;
+}
+
+template <>
+size_t
+TimeEpochBatchConverter<UnixEpoch, TaiEpoch>::convert(outpost::Slice<const UnixTime> from,
+                                                      outpost::Slice<AtomicTime> to)
+{
+    LeapSecondConverter converter;
+    const size_t count = getCount(from, to);
+    for (size_t i = 0; i < count; ++i)
+    {
+        to[i] = converter.toAtomicTime(from[i]);
+    }
+    return count;
+}
+
+template <>
+size_t
+TimeEpochBatchConverter<GpsEpoch, UnixEpoch>::convert(outpost::Slice<const GpsTime> from,
+                                                      outpost::Slice<UnixTime> to)
+{
+    LeapSecondConverter converter;
+    const size_t count = getCount(from, to);
+    for (size_t i = 0; i < count; ++i)
+    {
+        to[i] = converter.toUnixTime(from[i]);
+    }
+    return count;
+}
+
+template <>
+size_t
+TimeEpochBatchConverter<UnixEpoch, GpsEpoch>::convert(outpost::Slice<const UnixTime> from,
+                                                      outpost::Slice<GpsTime> to)
+{
+    LeapSecondConverter converter;
+    const size_t count = getCount(from, to);
+    for (size_t i = 0; i < count; ++i)
+    {
+        to[i] = converter.toGpsTime(from[i]);
+    }
+    return count;
+}
+
+}  // namespace time
+}  // namespace outpost
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_TIME_TIME_EPOCH_BATCH_H
+#define OUTPOST_TIME_TIME_EPOCH_BATCH_H
+
+#include "time_epoch.h"
+
+#include <outpost/base/slice.h>
+
+#include <stddef.h>
+
+namespace outpost
+{
+namespace time
+{
+/**
+ * Convert arrays of time points between two epochs.
+ *
+ * Gives the same results as calling TimePoint::convertTo() for every
+ * element. Conversions with a constant offset calculate the offset once
+ * and only add it in the loop, conversions involving leap seconds use a
+ * LeapSecondConverter. Sorted input is fastest for the latter.
+ *
+ * \code
+ * size_t converted = TimeEpochBatchConverter<GpsEpoch, UnixEpoch>::convert(gps, unixTimes);
+ * \endcode
+ */
+template <typename From, typename To>
+class TimeEpochBatchConverter
+{
+public:
+    /**
+     * \param from
+     *      Time points to convert.
+     * \param to
+     *      Converted time points, may not overlap with \p from.
+     *
+     * \return  Number of converted time points, the smaller one of the two
+     *          array lengths.
+     */
+    static size_t
+    convert(outpost::Slice<const TimePoint<From>> from, outpost::Slice<TimePoint<To>> to);
+};
+
+/**
+ * Batch conversion for epochs which differ by a constant offset.
+ */
+template <typename From, typename To>
+class ConstantOffsetBatchConverter
+{
+public:
+    static size_t
+    convert(outpost::Slice<const TimePoint<From>> from, outpost::Slice<TimePoint<To>> to)
+    {
+        const size_t count = (from.getNumberOfElements() < to.getNumberOfElements())
+                                     ? from.getNumberOfElements()
+                                     : to.getNumberOfElements();
+        const Duration offset = TimeEpochConverter<From, To>::convert(
+                                        TimePoint<From>::startOfEpoch())
+                                        .timeSinceEpoch();
+        for (size_t i = 0; i < count; ++i)
+        {
+            to[i] = TimePoint<To>::afterEpoch(from[i].timeSinceEpoch() + offset);
+        }
+        return count;
+    }
+};
+
+template <>
+class TimeEpochBatchConverter<SpacecraftElapsedTimeEpoch, GpsEpoch>
+    : public ConstantOffsetBatchConverter<SpacecraftElapsedTimeEpoch, GpsEpoch>
+{
+};
+
+template <>
+class TimeEpochBatchConverter<GpsEpoch, SpacecraftElapsedTimeEpoch>
+    : public ConstantOffsetBatchConverter<GpsEpoch, SpacecraftElapsedTimeEpoch>
+{
+};
+
+template <>
+class TimeEpochBatchConverter<GpsEpoch, TaiEpoch>
+    : public ConstantOffsetBatchConverter<GpsEpoch, TaiEpoch>
+{
+};
+
+template <>
+class TimeEpochBatchConverter<TaiEpoch, GpsEpoch>
+    : public ConstantOffsetBatchConverter<TaiEpoch, GpsEpoch>
+{
+};
+
+// Conversions involving leap seconds, see time_epoch_batch.cpp
+template <>
+size_t
+TimeEpochBatchConverter<TaiEpoch, UnixEpoch>::convert(outpost::Slice<const AtomicTime> from,
+                                                      outpost::Slice<UnixTime> to);
+
+template <>
+size_t
+TimeEpochBatchConverter<UnixEpoch, TaiEpoch>::convert(outpost::Slice<const UnixTime> from,
+                                                      outpost::Slice<AtomicTime> to);
+
+template <>
+size_t
+TimeEpochBatchConverter<GpsEpoch, UnixEpoch>::convert(outpost::Slice<const GpsTime> from,
+                                                      outpost::Slice<UnixTime> to);
+
+template <>
+size_t
+TimeEpochBatchConverter<UnixEpoch, GpsEpoch>::convert(outpost::Slice<const UnixTime> from,
+                                                      outpost::Slice<GpsTime> to);
+
+}  // namespace time
+}  // namespace outpost
+
+#endif
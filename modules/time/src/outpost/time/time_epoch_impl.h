@@ -16,6 +16,8 @@
 
 #include "time_epoch.h"
 
+#include <outpost/base/slice.h>
+
 namespace outpost
 {
 namespace time
@@ -85,6 +87,13 @@ public:
     static int64_t
     getCorrectionFactorForLeapSeconds(int64_t seconds, LeapSecondCorrection::Type correction);
 
+    /**
+     * Start of every leap second in seconds since the TAI epoch, newest
+     * first.
+     */
+    static outpost::Slice<const int64_t>
+    getLeapSeconds();
+
     static TimePoint<UnixEpoch>
     convert(TimePoint<TaiEpoch> from);
 };
@@ -15,6 +15,8 @@
 
 #include <unittest/harness.h>
 
+#include <string.h>
+
 using namespace outpost::time;
 
 TEST(DateTest, shouldDetectValidDates)
@@ -170,3 +172,60 @@ TEST(DateTest, shouldDoDateRoundtripForAllValidDates)
         }
     }
 }
+
+TEST(DateTest, shouldFormatIso8601)
+{
+    char buffer[Date::iso8601Length + 1] = {};
+    Date date{2016, 12, 31, 23, 59, 60};
+    EXPECT_EQ(Date::iso8601Length, date.toIso8601(outpost::asSlice(buffer)));
+    EXPECT_STREQ("2016-12-31T23:59:60Z", buffer);
+
+    date = Date{987, 3, 4, 5, 6, 7};
+    date.toIso8601(outpost::asSlice(buffer));
+    EXPECT_STREQ("0987-03-04T05:06:07Z", buffer);
+
+    EXPECT_EQ(0U, date.toIso8601(outpost::asSlice(buffer).first(Date::iso8601Length - 1)));
+    date.year = 10000;
+    EXPECT_EQ(0U, date.toIso8601(outpost::asSlice(buffer)));
+}
+
+TEST(DateTest, shouldParseIso8601)
+{
+    Date date{1, 1, 1, 0, 0, 0};
+    const char text[] = "2015-06-30T23:59:60Z";
+    EXPECT_TRUE(Date::fromIso8601(outpost::asSlice(text).first(20), date));
+    EXPECT_EQ((Date{2015, 6, 30, 23, 59, 60}), date);
+
+    // the time zone designator is optional
+    EXPECT_TRUE(Date::fromIso8601(outpost::asSlice(text).first(19), date));
+
+    const Date unchanged = date;
+    const char* invalid[] = {"2015-06-30 23:59:60Z",
+                             "2015-06-30T23:59:60X",
+                             "2015-6-30T23:59:600Z",
+                             "2015-13-30T23:59:60Z",
+                             "2015-06-30T24:00:00Z",
+                             "2015-06-30T23:59",
+                             "2015-06-3aT23:59:60Z"};
+    for (const char* entry : invalid)
+    {
+        EXPECT_FALSE(
+                Date::fromIso8601(outpost::Slice<const char>::unsafe(entry, strlen(entry)), date));
+        EXPECT_EQ(unchanged, date);
+    }
+}
+
+TEST(DateTest, shouldDoIso8601Roundtrip)
+{
+    const Date dates[] = {
+            {1970, 1, 1, 0, 0, 0}, {2000, 2, 29, 12, 30, 45}, {9999, 12, 31, 23, 59, 59}};
+    for (const Date& expect : dates)
+    {
+        char buffer[Date::iso8601Length];
+        const size_t length = expect.toIso8601(outpost::asSlice(buffer));
+
+        Date actual;
+        EXPECT_TRUE(Date::fromIso8601(outpost::asSlice(buffer).first(length), actual));
+        EXPECT_EQ(expect, actual);
+    }
+}
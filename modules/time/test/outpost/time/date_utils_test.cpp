@@ -73,3 +73,20 @@ TEST(DateUtilsTest, shouldCalculateTaiOffsetsForLeapSeconds)
               (DateUtils::getDay(Date{1972, 6, 30, 0, 0, 0}) - taiDayOffset + 1)
                       * 86400);  // 1972-06-30T23:59:60Z
 }
+
+TEST(DateUtilsTest, shouldCalculateDateForEveryDay)
+{
+    // The day count of the first of every month must match getDay()
+    for (int year = 0; year < 10000; ++year)
+    {
+        for (uint8_t month = 1; month <= 12; ++month)
+        {
+            Date expect{static_cast<uint16_t>(year), month, 1, 0, 0, 0};
+            int64_t day = DateUtils::getDay(expect);
+            if (day >= 0)
+            {
+                EXPECT_EQ(expect, DateUtils::getDate(day));
+            }
+        }
+    }
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/time/leap_second_converter.h>
+
+#include <unittest/harness.h>
+
+using namespace outpost::time;
+
+typedef TimeEpochConverter<TaiEpoch, UnixEpoch> TaiToUnix;
+
+TEST(LeapSecondConverterTest, shouldMatchUncachedCorrectionAroundEveryLeapSecond)
+{
+    LeapSecondConverter converter;
+    outpost::Slice<const int64_t> leapSeconds = TaiToUnix::getLeapSeconds();
+
+    // Oldest to newest, as for monotonically increasing time stamps
+    for (size_t i = leapSeconds.getNumberOfElements(); i > 0; --i)
+    {
+        for (int64_t offset = -50; offset <= 50; ++offset)
+        {
+            const int64_t seconds = leapSeconds[i - 1] + offset;
+            EXPECT_EQ(TaiToUnix::getCorrectionFactorForLeapSeconds(
+                              seconds, TaiToUnix::LeapSecondCorrection::remove),
+                      converter.getCorrectionFactorForLeapSeconds(
+                              seconds, TaiToUnix::LeapSecondCorrection::remove));
+            EXPECT_EQ(TaiToUnix::getCorrectionFactorForLeapSeconds(
+                              seconds, TaiToUnix::LeapSecondCorrection::add),
+                      converter.getCorrectionFactorForLeapSeconds(
+                              seconds, TaiToUnix::LeapSecondCorrection::add));
+        }
+    }
+}
+
+TEST(LeapSecondConverterTest, shouldMatchUncachedCorrectionForRandomAccess)
+{
+    LeapSecondConverter converter;
+    const int64_t samples[] = {2000000000, 0, 1861920035, 457488009, 1861920036, -100, 946684823};
+    for (int64_t seconds : samples)
+    {
+        EXPECT_EQ(TaiToUnix::getCorrectionFactorForLeapSeconds(
+                          seconds, TaiToUnix::LeapSecondCorrection::remove),
+                  converter.getCorrectionFactorForLeapSeconds(
+                          seconds, TaiToUnix::LeapSecondCorrection::remove));
+        EXPECT_EQ(TaiToUnix::getCorrectionFactorForLeapSeconds(
+                          seconds, TaiToUnix::LeapSecondCorrection::add),
+                  converter.getCorrectionFactorForLeapSeconds(
+                          seconds, TaiToUnix::LeapSecondCorrection::add));
+    }
+}
+
+TEST(LeapSecondConverterTest, shouldConvertLikeTimePoint)
+{
+    LeapSecondConverter converter;
+    const int64_t gpsSeconds[] = {0, 315187205, 315187206, 820108813, 1119744016, 1119744017};
+    for (int64_t seconds : gpsSeconds)
+    {
+        GpsTime gps = GpsTime::afterEpoch(Seconds(seconds));
+        UnixTime unixTime = converter.toUnixTime(gps);
+        EXPECT_EQ(gps.convertTo<UnixTime>(), unixTime);
+        EXPECT_EQ(unixTime.convertTo<GpsTime>(), converter.toGpsTime(unixTime));
+        EXPECT_EQ(unixTime.convertTo<AtomicTime>(), converter.toAtomicTime(unixTime));
+        EXPECT_EQ(gps.convertTo<AtomicTime>().convertTo<UnixTime>(),
+                  converter.toUnixTime(gps.convertTo<AtomicTime>()));
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/time/tick_deadline.h>
+
+#include <unittest/harness.h>
+#include <unittest/time/testing_clock.h>
+
+using namespace outpost::time;
+
+class TickDeadlineTest : public testing::Test
+{
+public:
+    unittest::time::TestingClock mClock;
+};
+
+TEST_F(TickDeadlineTest, shouldBeExpiredAfterDefaultConstruction)
+{
+    TickDeadline deadline;
+
+    EXPECT_TRUE(deadline.isExpired(mClock.now()));
+    EXPECT_EQ(Duration::zero(), deadline.getRemainingTime(mClock.now()));
+}
+
+TEST_F(TickDeadlineTest, shouldExpireAfterTimeout)
+{
+    TickDeadline deadline(mClock, Milliseconds(100));
+
+    mClock.incrementBy(Milliseconds(40));
+    EXPECT_FALSE(deadline.isExpired(mClock.now()));
+    EXPECT_EQ(Milliseconds(60), deadline.getRemainingTime(mClock.now()));
+
+    mClock.incrementBy(Milliseconds(60));
+    EXPECT_TRUE(deadline.isExpired(mClock.now()));
+    EXPECT_EQ(Duration::zero(), deadline.getRemainingTime(mClock.now()));
+}
+
+TEST_F(TickDeadlineTest, shouldHandleWrapOfTicks)
+{
+    // The lower 32 bit of the time are 10 ms before the wrap
+    mClock.setTime(SpacecraftElapsedTime::afterEpoch(Microseconds(0x1FFFFFFFFLL)
+                                                     - Milliseconds(10)));
+
+    TickDeadline deadline(mClock, Milliseconds(30));
+    mClock.incrementBy(Milliseconds(20));
+    EXPECT_FALSE(deadline.isExpired(mClock.now()));
+    EXPECT_EQ(Milliseconds(10), deadline.getRemainingTime(mClock.now()));
+
+    mClock.incrementBy(Milliseconds(10));
+    EXPECT_TRUE(deadline.isExpired(mClock.now()));
+}
+
+TEST_F(TickDeadlineTest, shouldNeverExpireWithInfiniteTimeout)
+{
+    TickDeadline deadline(mClock, Duration::infinity());
+
+    mClock.incrementBy(Hours(10));
+    EXPECT_TRUE(deadline.isInfinite());
+    EXPECT_FALSE(deadline.isExpired(mClock.now()));
+    EXPECT_EQ(Duration::infinity(), deadline.getRemainingTime(mClock.now()));
+}
+
+TEST_F(TickDeadlineTest, shouldLimitLongTimeouts)
+{
+    TickDeadline deadline(mClock, Hours(1));
+
+    EXPECT_FALSE(deadline.isInfinite());
+    EXPECT_EQ(TickDeadline::maximumTimeout(), deadline.getRemainingTime(mClock.now()));
+}
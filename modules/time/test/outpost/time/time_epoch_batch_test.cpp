@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/time/time_epoch_batch.h>
+
+#include <unittest/harness.h>
+
+using namespace outpost::time;
+
+TEST(TimeEpochBatchTest, shouldConvertGpsToUnixLikeSingleConversion)
+{
+    GpsTime gps[] = {GpsTime::afterEpoch(Seconds(0)),
+                     GpsTime::afterEpoch(Seconds(315187205)),
+                     GpsTime::afterEpoch(Seconds(315187206)),
+                     GpsTime::afterEpoch(Seconds(820108813)),
+                     GpsTime::afterEpoch(Seconds(1119744017))};
+    UnixTime unixTimes[5];
+
+    EXPECT_EQ(5U,
+              (TimeEpochBatchConverter<GpsEpoch, UnixEpoch>::convert(outpost::asSlice(gps),
+                                                                     outpost::asSlice(unixTimes))));
+    for (size_t i = 0; i < 5; ++i)
+    {
+        EXPECT_EQ(gps[i].convertTo<UnixTime>(), unixTimes[i]);
+    }
+
+    GpsTime back[5];
+    TimeEpochBatchConverter<UnixEpoch, GpsEpoch>::convert(outpost::asSlice(unixTimes),
+                                                          outpost::asSlice(back));
+    for (size_t i = 0; i < 5; ++i)
+    {
+        EXPECT_EQ(unixTimes[i].convertTo<GpsTime>(), back[i]);
+    }
+}
+
+TEST(TimeEpochBatchTest, shouldConvertBetweenTaiAndUnix)
+{
+    AtomicTime tai[] = {AtomicTime::afterEpoch(Seconds(1861920035)),
+                        AtomicTime::afterEpoch(Seconds(1861920036)),
+                        AtomicTime::afterEpoch(Seconds(457488009))};
+    UnixTime unixTimes[3];
+    TimeEpochBatchConverter<TaiEpoch, UnixEpoch>::convert(outpost::asSlice(tai),
+                                                          outpost::asSlice(unixTimes));
+
+    AtomicTime back[3];
+    TimeEpochBatchConverter<UnixEpoch, TaiEpoch>::convert(outpost::asSlice(unixTimes),
+                                                          outpost::asSlice(back));
+    for (size_t i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(tai[i].convertTo<UnixTime>(), unixTimes[i]);
+        EXPECT_EQ(unixTimes[i].convertTo<AtomicTime>(), back[i]);
+    }
+}
+
+TEST(TimeEpochBatchTest, shouldApplyConstantOffset)
+{
+    setOffsetBetweenScetAndGps(SpacecraftElapsedTime::afterEpoch(Seconds(10)),
+                               GpsTime::afterEpoch(Seconds(1000)));
+
+    SpacecraftElapsedTime scet[] = {SpacecraftElapsedTime::afterEpoch(Seconds(10)),
+                                    SpacecraftElapsedTime::afterEpoch(Milliseconds(12500))};
+    GpsTime gps[3];
+
+    // Only as many as fit into the smaller array
+    EXPECT_EQ(2U,
+              (TimeEpochBatchConverter<SpacecraftElapsedTimeEpoch, GpsEpoch>::convert(
+                      outpost::asSlice(scet), outpost::asSlice(gps))));
+    EXPECT_EQ(GpsTime::afterEpoch(Seconds(1000)), gps[0]);
+    EXPECT_EQ(GpsTime::afterEpoch(Milliseconds(1002500)), gps[1]);
+
+    AtomicTime tai[2];
+    TimeEpochBatchConverter<GpsEpoch, TaiEpoch>::convert(outpost::asSlice(gps).first(2),
+                                                         outpost::asSlice(tai));
+    EXPECT_EQ(gps[1].convertTo<AtomicTime>(), tai[1]);
+
+    setOffsetBetweenScetAndGps(SpacecraftElapsedTime::startOfEpoch(), GpsTime::startOfEpoch());
+}
@@ -0,0 +1,642 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/*
+ * Operations per second of the containers of outpost::utils.
+ *
+ * One JSON record is written to stdout per measurement, see
+ * outpost::utils::BenchmarkRecord:
+ *
+ *     {"suite":"utils","benchmark":"appendRemoveFront","container":"Deque","size":16,
+ *      "threads":1,"operations_per_second":41000000,"cycles_per_operation":12.5,
+ *      "status":"ok"}
+ *
+ * An operation is a single insert, remove or lookup. The size is the
+ * number of elements in the container while it is measured, for the
+ * queues and pools it is the number of elements a thread holds at once.
+ * The thread safe containers (ReferenceQueue and SharedBufferPool) are
+ * additionally shared between several threads, each thread executes the
+ * same loop. The status is "ok" or "failed", the latter if an operation
+ * did not return the expected result.
+ *
+ * Besides printf only outpost::rtos and BenchmarkRecord are used, so the
+ * file can also be added to a target build (see modules/rtos/it). On the
+ * target OUTPOST_BENCHMARK_CYCLE_COUNTER may be defined to an expression
+ * which reads a free running 32 bit cycle counter, e.g. a performance
+ * counter register of the processor. Otherwise the cycles_per_operation
+ * key is omitted.
+ */
+
+#include <outpost/base/slice.h>
+#include <outpost/rtos/clock.h>
+#include <outpost/rtos/semaphore.h>
+#include <outpost/rtos/thread.h>
+#include <outpost/utils/benchmark/benchmark_record.h>
+#include <outpost/utils/container/circular_singly_linked_list.h>
+#include <outpost/utils/container/deque.h>
+#include <outpost/utils/container/eytzinger_index.h>
+#include <outpost/utils/container/fixed_ordered_map.h>
+#include <outpost/utils/container/list.h>
+#include <outpost/utils/container/reference_queue.h>
+#include <outpost/utils/container/shared_object_pool.h>
+#include <outpost/utils/container/shared_ring_buffer.h>
+
+#include <stdint.h>
+
+using namespace outpost;
+using namespace outpost::utils;
+
+namespace
+{
+// Number of operations per measurement for containers with O(1) operations,
+// the containers with O(N) operations execute proportionally less.
+constexpr size_t operationsPerMeasurement = 1U << 21;
+
+constexpr size_t maximumSize = 4096;
+const size_t sizes[] = {16, 256, maximumSize};
+
+// Sizes for the O(N) lists, the larger lists only take longer
+const size_t listSizes[] = {16, 256, 1024};
+
+constexpr size_t maximumNumberOfThreads = 4;
+const size_t threadCounts[] = {1, 2, maximumNumberOfThreads};
+
+// Number of elements a thread holds at once in the queue and pool benchmarks
+const size_t burstSizes[] = {1, 16};
+constexpr size_t maximumBurstSize = 16;
+
+outpost::rtos::SystemClock systemClock;
+
+// Parameters of the current measurement, set before the workers are started
+size_t currentSize = 0;
+size_t currentIterations = 0;
+
+uint32_t
+getRandomValue(uint32_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// ---------------------------------------------------------------------------
+uint32_t dequeStorage[maximumSize];
+uint32_t values[maximumSize];
+Deque<uint32_t> deque(outpost::asSlice(dequeStorage));
+
+bool
+runDequeAppendRemoveFront()
+{
+    bool valid = true;
+    for (size_t i = 0; i < currentIterations; ++i)
+    {
+        for (size_t k = 0; k < currentSize; ++k)
+        {
+            valid = deque.append(k) && valid;
+        }
+        for (size_t k = 0; k < currentSize; ++k)
+        {
+            valid = (deque.getFront() == k) && valid;
+            deque.removeFront();
+        }
+    }
+    return valid;
+}
+
+bool
+runDequePrependRemoveBack()
+{
+    bool valid = true;
+    for (size_t i = 0; i < currentIterations; ++i)
+    {
+        for (size_t k = 0; k < currentSize; ++k)
+        {
+            valid = deque.prepend(k) && valid;
+        }
+        for (size_t k = 0; k < currentSize; ++k)
+        {
+            valid = (deque.getBack() == k) && valid;
+            deque.removeBack();
+        }
+    }
+    return valid;
+}
+
+bool
+runDequeAppendPopSlice()
+{
+    // Operations are counted per element
+    bool valid = true;
+    for (size_t i = 0; i < currentIterations; ++i)
+    {
+        outpost::Slice<uint32_t> slice = outpost::Slice<uint32_t>::unsafe(values, currentSize);
+        valid = (deque.append(outpost::Slice<const uint32_t>(slice)) == currentSize) && valid;
+        valid = (deque.pop(slice) == currentSize) && valid;
+    }
+    return valid;
+}
+
+// ---------------------------------------------------------------------------
+struct ListNode : public ListElement
+{
+    bool
+    operator<(const ListNode& other) const
+    {
+        return mKey < other.mKey;
+    }
+
+    uint32_t mKey;
+};
+
+struct RingNode
+{
+    bool
+    operator<(const RingNode& other) const
+    {
+        return mKey < other.mKey;
+    }
+
+    RingNode* mNext;
+    uint32_t mKey;
+};
+
+template <typename Node>
+struct HasKey
+{
+    explicit HasKey(uint32_t key) : mKey(key)
+    {
+    }
+
+    bool
+    operator()(const Node& node) const
+    {
+        return node.mKey == mKey;
+    }
+
+    uint32_t mKey;
+};
+
+ListNode listNodes[maximumSize];
+RingNode ringNodes[maximumSize];
+
+List<ListNode> list;
+CircularSinglyLinkedList<RingNode> ring;
+
+// Order in which the nodes are inserted, removed and searched
+size_t permutation[maximumSize];
+
+void
+createPermutation(size_t size)
+{
+    uint32_t state = 12345;
+    for (size_t i = 0; i < size; ++i)
+    {
+        permutation[i] = i;
+    }
+    for (size_t i = size - 1; i > 0; --i)
+    {
+        const size_t k = getRandomValue(state) % (i + 1);
+        const size_t swap = permutation[i];
+        permutation[i] = permutation[k];
+        permutation[k] = swap;
+    }
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        listNodes[i].mKey = static_cast<uint32_t>(i * 2);
+        ringNodes[i].mKey = static_cast<uint32_t>(i * 2);
+    }
+}
+
+template <typename Container, typename Node>
+void
+fill(Container& container, Node* nodes)
+{
+    container.reset();
+    for (size_t k = 0; k < currentSize; ++k)
+    {
+        container.insert(&nodes[permutation[k]]);
+    }
+}
+
+template <typename Container, typename Node>
+bool
+isSorted(Container& container)
+{
+    bool valid = (container.size() == currentSize);
+    const Node* previous = nullptr;
+    for (typename Container::Iterator it = container.begin(); it != container.end(); ++it)
+    {
+        valid = ((previous == nullptr) || !(*it < *previous)) && valid;
+        previous = &(*it);
+    }
+    return valid;
+}
+
+template <typename Container, typename Node, Container& container, Node* nodes>
+bool
+runInsert()
+{
+    for (size_t i = 0; i < currentIterations; ++i)
+    {
+        fill(container, nodes);
+    }
+    return isSorted<Container, Node>(container);
+}
+
+template <typename Container, typename Node, Container& container, Node* nodes>
+bool
+runFind()
+{
+    fill(container, nodes);
+    bool valid = true;
+    for (size_t i = 0; i < currentIterations; ++i)
+    {
+        for (size_t k = 0; k < currentSize; ++k)
+        {
+            const size_t index = permutation[k];
+            valid = (container.get(HasKey<Node>(nodes[index].mKey)) == &nodes[index]) && valid;
+        }
+    }
+    return valid;
+}
+
+template <typename Container, typename Node, Container& container, Node* nodes>
+bool
+runRemoveNode()
+{
+    // Filling the container is part of the measurement, operations are
+    // counted for the insert and the remove.
+    bool valid = true;
+    for (size_t i = 0; i < currentIterations; ++i)
+    {
+        fill(container, nodes);
+        for (size_t k = currentSize; k > 0; --k)
+        {
+            valid = container.removeNode(&nodes[permutation[k - 1]]) && valid;
+        }
+        valid = container.isEmpty() && valid;
+    }
+    return valid;
+}
+
+template <typename Container, typename Node, Container& container, Node* nodes>
+bool
+runRemoveFirst()
+{
+    bool valid = true;
+    for (size_t i = 0; i < currentIterations; ++i)
+    {
+        fill(container, nodes);
+        uint32_t previous = 0;
+        for (size_t k = 0; k < currentSize; ++k)
+        {
+            Node* node = container.first();
+            valid = (node != nullptr) && (node->mKey >= previous) && valid;
+            previous = (node != nullptr) ? node->mKey : previous;
+            container.removeFirst();
+        }
+    }
+    return valid;
+}
+
+// ---------------------------------------------------------------------------
+struct MapEntry
+{
+    uint32_t mKey;
+    uint32_t mValue;
+};
+
+MapEntry mapEntries[maximumSize];
+uint32_t indexKeys[maximumSize + 1];
+size_t indexPositions[maximumSize + 1];
+EytzingerIndex<uint32_t> eytzingerIndex(outpost::asSlice(indexKeys),
+                                        outpost::asSlice(indexPositions));
+FixedOrderedMap<MapEntry, uint32_t>* map = nullptr;
+
+bool
+runMapLookup()
+{
+    bool valid = true;
+    const uint32_t mask = static_cast<uint32_t>(currentSize * 2 - 1);
+    uint32_t state = 12345;
+    for (size_t i = 0; i < currentIterations; ++i)
+    {
+        // Every second key is missing
+        const uint32_t key = getRandomValue(state) & mask;
+        const MapEntry* entry = map->getEntry(key);
+        valid = ((key % 2 == 0) ? ((entry != nullptr) && (entry->mValue == key / 2))
+                                : (entry == nullptr))
+                && valid;
+    }
+    return valid;
+}
+
+// ---------------------------------------------------------------------------
+constexpr size_t poolSize = maximumNumberOfThreads * maximumBurstSize;
+
+SharedBufferPool<32, poolSize> pool;
+SharedBufferQueue<poolSize> queue;
+SharedRingBufferStorage<poolSize> ringBuffer;
+
+bool
+runPoolAllocateRelease()
+{
+    bool valid = true;
+    SharedBufferPointer pointers[maximumBurstSize];
+    for (size_t i = 0; i < currentIterations; ++i)
+    {
+        for (size_t k = 0; k < currentSize; ++k)
+        {
+            valid = pool.allocate(pointers[k]) && valid;
+        }
+        for (size_t k = 0; k < currentSize; ++k)
+        {
+            pointers[k] = SharedBufferPointer();
+        }
+    }
+    return valid;
+}
+
+bool
+runQueueSendReceive()
+{
+    bool valid = true;
+    SharedBufferPointer pointer;
+    valid = pool.allocate(pointer) && valid;
+    for (size_t i = 0; i < currentIterations; ++i)
+    {
+        for (size_t k = 0; k < currentSize; ++k)
+        {
+            valid = queue.send(pointer) && valid;
+        }
+        for (size_t k = 0; k < currentSize; ++k)
+        {
+            // Other threads may receive the own elements, the own elements
+            // guarantee that enough elements are available.
+            SharedBufferPointer received;
+            valid = queue.receive(received) && received.isValid() && valid;
+        }
+    }
+    return valid;
+}
+
+bool
+runRingBufferAppendPop()
+{
+    bool valid = true;
+    SharedBufferPointer pointer;
+    valid = pool.allocate(pointer) && valid;
+    for (size_t i = 0; i < currentIterations; ++i)
+    {
+        for (size_t k = 0; k < currentSize; ++k)
+        {
+            valid = ringBuffer.append(pointer) && valid;
+        }
+        for (size_t k = 0; k < currentSize; ++k)
+        {
+            SharedBufferPointer received;
+            valid = ringBuffer.pop(received) && (received == pointer) && valid;
+        }
+    }
+    return valid;
+}
+
+// ---------------------------------------------------------------------------
+typedef bool (*Function)();
+
+class Worker : public outpost::rtos::Thread
+{
+public:
+    Worker() :
+        Thread(100, defaultStackSize, "benchmark"),
+        mStart(0),
+        mDone(0),
+        mFunction(nullptr),
+        mValid(false)
+    {
+    }
+
+    void
+    execute(Function function)
+    {
+        mFunction = function;
+        mStart.release();
+    }
+
+    bool
+    wait()
+    {
+        mDone.acquire();
+        return mValid;
+    }
+
+private:
+    virtual void
+    run() override
+    {
+        while (true)
+        {
+            mStart.acquire();
+            mValid = mFunction();
+            mDone.release();
+        }
+    }
+
+    outpost::rtos::Semaphore mStart;
+    outpost::rtos::Semaphore mDone;
+    Function mFunction;
+    bool mValid;
+};
+
+Worker workers[maximumNumberOfThreads];
+
+#ifdef OUTPOST_BENCHMARK_CYCLE_COUNTER
+uint32_t
+readCycleCounter()
+{
+    return static_cast<uint32_t>(OUTPOST_BENCHMARK_CYCLE_COUNTER);
+}
+#endif
+
+/**
+ * \param operationsPerIteration
+ *      Number of operations of a single iteration of the function.
+ * \param workPerOperation
+ *      Relative cost of an operation, 1 for O(1) operations.
+ */
+void
+measure(const char* benchmark,
+        const char* container,
+        Function function,
+        size_t size,
+        size_t operationsPerIteration,
+        size_t workPerOperation = 1,
+        size_t threads = 0)
+{
+    currentSize = size;
+    currentIterations = operationsPerMeasurement / (operationsPerIteration * workPerOperation);
+    if (currentIterations == 0)
+    {
+        currentIterations = 1;
+    }
+
+    bool valid = true;
+#ifdef OUTPOST_BENCHMARK_CYCLE_COUNTER
+    const uint32_t startCycles = readCycleCounter();
+#endif
+    const outpost::time::SpacecraftElapsedTime start = systemClock.now();
+    if (threads == 0)
+    {
+        valid = function();
+    }
+    else
+    {
+        for (size_t i = 0; i < threads; ++i)
+        {
+            workers[i].execute(function);
+        }
+        for (size_t i = 0; i < threads; ++i)
+        {
+            valid = workers[i].wait() && valid;
+        }
+    }
+    int64_t us = (systemClock.now() - start).microseconds();
+#ifdef OUTPOST_BENCHMARK_CYCLE_COUNTER
+    const uint32_t cycles = readCycleCounter() - startCycles;
+#endif
+    if (us <= 0)
+    {
+        us = 1;
+    }
+
+    const size_t operations =
+            currentIterations * operationsPerIteration * ((threads == 0) ? 1 : threads);
+    BenchmarkRecord record("utils", benchmark);
+    record.addString("container", container)
+            .addInteger("size", size)
+            .addInteger("threads", (threads == 0) ? 1 : threads)
+            .addNumber("operations_per_second", static_cast<double>(operations) * 1e6 / us, 0);
+#ifdef OUTPOST_BENCHMARK_CYCLE_COUNTER
+    record.addNumber("cycles_per_operation", static_cast<double>(cycles) / operations, 1);
+#endif
+    record.write(valid);
+}
+
+void
+measureDeque()
+{
+    for (size_t size : sizes)
+    {
+        measure("appendRemoveFront", "Deque", runDequeAppendRemoveFront, size, size * 2);
+        measure("prependRemoveBack", "Deque", runDequePrependRemoveBack, size, size * 2);
+        measure("appendPopSlice", "Deque", runDequeAppendPopSlice, size, size * 2);
+    }
+}
+
+template <typename Container, typename Node, Container& container, Node* nodes>
+void
+measureList(const char* name)
+{
+    for (size_t size : listSizes)
+    {
+        createPermutation(size);
+
+        // Inserting and searching walks half of the list on average
+        measure("insert",
+                name,
+                runInsert<Container, Node, container, nodes>,
+                size,
+                size,
+                size / 2);
+        measure("find", name, runFind<Container, Node, container, nodes>, size, size, size / 2);
+        measure("insertRemoveNode",
+                name,
+                runRemoveNode<Container, Node, container, nodes>,
+                size,
+                size * 2,
+                size / 2);
+        measure("insertRemoveFirst",
+                name,
+                runRemoveFirst<Container, Node, container, nodes>,
+                size,
+                size * 2,
+                size / 4);
+    }
+}
+
+void
+measureFixedOrderedMap()
+{
+    for (size_t size : sizes)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            mapEntries[i].mKey = static_cast<uint32_t>(i * 2);
+            mapEntries[i].mValue = static_cast<uint32_t>(i);
+        }
+        outpost::Slice<MapEntry> entries = outpost::Slice<MapEntry>::unsafe(mapEntries, size);
+
+        FixedOrderedMap<MapEntry, uint32_t> binarySearch(entries);
+        map = &binarySearch;
+        measure("lookup", "FixedOrderedMap", runMapLookup, size, 1);
+
+        FixedOrderedMap<MapEntry, uint32_t> indexed(entries, eytzingerIndex);
+        map = &indexed;
+        measure("lookupEytzinger", "FixedOrderedMap", runMapLookup, size, 1);
+    }
+}
+
+void
+measureSharedBuffers()
+{
+    for (size_t burst : burstSizes)
+    {
+        measure("appendPop", "SharedRingBuffer", runRingBufferAppendPop, burst, burst * 2);
+
+        for (size_t threads : threadCounts)
+        {
+            measure("allocateRelease",
+                    "SharedBufferPool",
+                    runPoolAllocateRelease,
+                    burst,
+                    burst * 2,
+                    threads,
+                    threads);
+            measure("sendReceive",
+                    "ReferenceQueue",
+                    runQueueSendReceive,
+                    burst,
+                    burst * 2,
+                    threads,
+                    threads);
+        }
+    }
+}
+
+}  // namespace
+
+int
+main(void)
+{
+    for (Worker& worker : workers)
+    {
+        worker.start();
+    }
+
+    measureDeque();
+    measureList<List<ListNode>, ListNode, list, listNodes>("List");
+    measureList<CircularSinglyLinkedList<RingNode>, RingNode, ring, ringNodes>(
+            "CircularSinglyLinkedList");
+    measureFixedOrderedMap();
+    measureSharedBuffers();
+    return 0;
+}
@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/*
+ * Throughput of the coding kernels (CRC, COBS, NAND BCH and Reed-Solomon).
+ *
+ * One JSON record is written to stdout per measurement, see
+ * outpost::utils::BenchmarkRecord:
+ *
+ *     {"suite":"utils","benchmark":"crc32Reversed","input":"random","bytes":4096,
+ *      "megabytes_per_second":512.3,"status":"ok"}
+ *
+ * The throughput relates to the unencoded data, i.e. to the page data for
+ * the BCH coders. The status is "ok" or "failed", the latter if a result
+ * did not match the reference computed before the measurement. The compile
+ * time BCH coder needs C++14 and is skipped by older compilers.
+ *
+ * Inputs:
+ *  - random:   uniformly distributed bytes
+ *  - zeroFree: no zero bytes, i.e. COBS blocks of maximum length
+ *  - zeros:    only zero bytes, the worst case for COBS with one block per byte
+ *  - Nerrors:  N bit flips in every sector of a NAND page, N symbol errors
+ *              in every Reed-Solomon code word
+ *
+ * Besides printf only the clock of outpost::rtos and BenchmarkRecord are
+ * used, so the file can also be added to a target build (see
+ * modules/rtos/it) to measure on the flight hardware.
+ */
+
+#include <outpost/base/slice.h>
+#include <outpost/rtos/clock.h>
+#include <outpost/utils/benchmark/benchmark_record.h>
+#include <outpost/utils/coding/cobs.h>
+#include <outpost/utils/coding/crc16.h>
+#include <outpost/utils/coding/crc32.h>
+#include <outpost/utils/coding/crc8.h>
+#if __cplusplus >= 201402L
+#include <outpost/utils/coding/nand_bch_compiletime.h>
+#endif
+#include <outpost/utils/coding/nand_bch_runtime.h>
+#include <outpost/utils/coding/reed_solomon_ccsds.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+using namespace outpost;
+using namespace outpost::utils;
+
+namespace
+{
+constexpr size_t dataSize = 4096;
+constexpr size_t spareSize = 128;
+
+// Number of bytes processed per measurement
+constexpr size_t bytesPerMeasurement = 1U << 23;
+
+enum class InputType
+{
+    random,
+    zeroFree,
+    zeros
+};
+
+struct Input
+{
+    const char* mName;
+    InputType mType;
+};
+
+const Input inputs[] = {{"random", InputType::random},
+                        {"zeroFree", InputType::zeroFree},
+                        {"zeros", InputType::zeros}};
+
+outpost::rtos::SystemClock systemClock;
+
+uint8_t data[dataSize];
+uint8_t encoded[dataSize + dataSize / 254 + 2 + spareSize];
+uint8_t decoded[dataSize + spareSize];
+uint8_t streamBuffer[dataSize];
+size_t encodedLength = 0;
+
+CobsStreamDecoder streamDecoder(outpost::asSlice(streamBuffer));
+
+NandBCHRTimeTables<NandBCHInterface::DEF_GALIOS_DIMENISIONS, NandBCHInterface::DEF_ERROR_CORRECTION>
+        bchTables;
+NandBCHRTime<NandBCHInterface::DEF_GALIOS_DIMENISIONS,
+             NandBCHInterface::DEF_ERROR_CORRECTION,
+             dataSize,
+             spareSize>
+        bchRuntime(bchTables);
+#if __cplusplus >= 201402L
+NandBCHCTime<NandBCHInterface::DEF_GALIOS_DIMENISIONS,
+             NandBCHInterface::DEF_ERROR_CORRECTION,
+             dataSize,
+             spareSize>
+        bchCompiletime;
+#endif
+
+const uint32_t errorCounts[] = {0, 1, NandBCHInterface::DEF_ERROR_CORRECTION};
+
+typedef ReedSolomonCcsds<5> ReedSolomon;
+
+const uint32_t symbolErrorCounts[] = {0, 1, 16};
+
+NandBCHInterface* bch = nullptr;
+DecodeStatus expectedStatus = DecodeStatus::noError;
+uint32_t crcReference = 0;
+
+void
+createInput(InputType type)
+{
+    uint32_t state = 12345U;
+    for (size_t i = 0; i < dataSize; i++)
+    {
+        state = state * 1103515245U + 12345U;
+        uint8_t value = static_cast<uint8_t>(state >> 16);
+        switch (type)
+        {
+            case InputType::random: data[i] = value; break;
+            case InputType::zeroFree: data[i] = (value == 0) ? 1 : value; break;
+            case InputType::zeros: data[i] = 0; break;
+        }
+    }
+}
+
+template <typename Crc>
+uint32_t
+calculateBytewise()
+{
+    Crc crc;
+    for (size_t i = 0; i < dataSize; i++)
+    {
+        crc.update(data[i]);
+    }
+    return crc.getValue();
+}
+
+template <typename Crc>
+bool
+runCrc()
+{
+    return Crc::calculate(outpost::asSlice(data)) == crcReference;
+}
+
+bool
+runCobsEncode()
+{
+    return Cobs::encode(outpost::asSlice(data), outpost::asSlice(encoded)) == encodedLength;
+}
+
+bool
+runCobsDecode()
+{
+    return Cobs::decode(outpost::Slice<const uint8_t>::unsafe(encoded, encodedLength), decoded)
+           == dataSize;
+}
+
+bool
+runCobsStreamDecode()
+{
+    // The encoded frame is followed by the delimiter
+    outpost::Slice<const uint8_t> input =
+            outpost::Slice<const uint8_t>::unsafe(encoded, encodedLength + 1);
+    input = input.skipFirst(streamDecoder.decode(input));
+    bool valid = streamDecoder.isFrameAvailable()
+                 && (streamDecoder.getFrame().getNumberOfElements() == dataSize)
+                 && (input.getNumberOfElements() == 0);
+    streamDecoder.releaseFrame();
+    return valid;
+}
+
+bool
+runBchEncode()
+{
+    return bch->encode(outpost::asSlice(data), outpost::asSlice(decoded));
+}
+
+bool
+runBchDecode()
+{
+    return bch->decode(outpost::Slice<const uint8_t>::unsafe(encoded, dataSize + spareSize),
+                       outpost::Slice<uint8_t>::unsafe(decoded, dataSize))
+           == expectedStatus;
+}
+
+bool
+runReedSolomonEncode()
+{
+    return ReedSolomon::encode(
+            outpost::Slice<const uint8_t>::unsafe(data, ReedSolomon::numberOfDataBytes),
+            outpost::asSlice(decoded));
+}
+
+bool
+runReedSolomonDecode()
+{
+    return ReedSolomon::decode(
+                   outpost::Slice<const uint8_t>::unsafe(encoded, ReedSolomon::codeBlockSize),
+                   outpost::Slice<uint8_t>::unsafe(decoded, ReedSolomon::numberOfDataBytes))
+           == expectedStatus;
+}
+
+typedef bool (*Function)();
+
+void
+measure(const char* benchmark,
+        const char* input,
+        Function function,
+        size_t bytesPerIteration = dataSize)
+{
+    const size_t iterations = bytesPerMeasurement / bytesPerIteration;
+
+    bool valid = true;
+    outpost::time::SpacecraftElapsedTime start = systemClock.now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        valid = function() && valid;
+    }
+    int64_t us = (systemClock.now() - start).microseconds();
+    if (us <= 0)
+    {
+        us = 1;
+    }
+
+    BenchmarkRecord record("utils", benchmark);
+    record.addString("input", input)
+            .addInteger("bytes", bytesPerIteration)
+            .addNumber("megabytes_per_second",
+                       static_cast<double>(iterations * bytesPerIteration) / us,
+                       1)
+            .write(valid);
+}
+
+template <typename Crc>
+void
+measureCrc(const char* benchmark, const char* input)
+{
+    crcReference = calculateBytewise<Crc>();
+    measure(benchmark, input, runCrc<Crc>);
+}
+
+void
+measureCobs(const char* input)
+{
+    encodedLength = Cobs::encode(outpost::asSlice(data), outpost::asSlice(encoded));
+    encoded[encodedLength] = 0;
+
+    measure("cobsEncode", input, runCobsEncode);
+    measure("cobsDecode", input, runCobsDecode);
+    measure("cobsStreamDecode", input, runCobsStreamDecode);
+}
+
+void
+measureBch(const char* name, NandBCHInterface& coder)
+{
+    char benchmark[32];
+    char input[24];
+
+    bch = &coder;
+    createInput(InputType::random);
+    snprintf(benchmark, sizeof(benchmark), "%sEncode", name);
+    measure(benchmark, "random", runBchEncode);
+
+    snprintf(benchmark, sizeof(benchmark), "%sDecode", name);
+    for (uint32_t errors : errorCounts)
+    {
+        memset(encoded, 0xFF, dataSize + spareSize);
+        coder.encode(outpost::asSlice(data),
+                     outpost::Slice<uint8_t>::unsafe(encoded, dataSize + spareSize));
+
+        // Spread the bit flips over the data of every sector
+        for (uint32_t sector = 0; sector < coder.getNumberOfSectors(); sector++)
+        {
+            for (uint32_t k = 0; k < errors; k++)
+            {
+                size_t position = sector * NandBCHInterface::sectorSize + (k * 61 + 7) % 512;
+                encoded[position] ^= static_cast<uint8_t>(1 << (k % 8));
+            }
+        }
+        expectedStatus = (errors == 0) ? DecodeStatus::noError : DecodeStatus::corrected;
+
+        snprintf(input, sizeof(input), "%luerrors", static_cast<unsigned long>(errors));
+        measure(benchmark, input, runBchDecode);
+    }
+}
+
+void
+measureReedSolomon()
+{
+    char input[24];
+
+    createInput(InputType::random);
+    measure("reedSolomonEncode", "random", runReedSolomonEncode, ReedSolomon::numberOfDataBytes);
+
+    for (uint32_t errors : symbolErrorCounts)
+    {
+        ReedSolomon::encode(
+                outpost::Slice<const uint8_t>::unsafe(data, ReedSolomon::numberOfDataBytes),
+                outpost::asSlice(encoded));
+        for (size_t k = 0; k < errors * 5; k++)
+        {
+            // Consecutive symbols belong to different code words
+            encoded[k * 7] ^= 0xA5;
+        }
+        expectedStatus = (errors == 0) ? DecodeStatus::noError : DecodeStatus::corrected;
+
+        snprintf(input, sizeof(input), "%luerrors", static_cast<unsigned long>(errors));
+        measure("reedSolomonDecode", input, runReedSolomonDecode, ReedSolomon::numberOfDataBytes);
+    }
+}
+
+}  // namespace
+
+int
+main(void)
+{
+    for (const Input& input : inputs)
+    {
+        createInput(input.mType);
+
+        measureCrc<Crc8Ccitt>("crc8Ccitt", input.mName);
+        measureCrc<Crc8CcittReversed>("crc8CcittReversed", input.mName);
+        measureCrc<Crc16Ccitt>("crc16Ccitt", input.mName);
+        measureCrc<Crc16X25>("crc16X25", input.mName);
+        measureCrc<Crc32Reversed>("crc32Reversed", input.mName);
+        measureCrc<Crc32Castagnoli>("crc32Castagnoli", input.mName);
+
+        measureCobs(input.mName);
+    }
+
+    measureBch("bchRuntime", bchRuntime);
+#if __cplusplus >= 201402L
+    measureBch("bchCompiletime", bchCompiletime);
+#endif
+    measureReedSolomon();
+    return 0;
+}
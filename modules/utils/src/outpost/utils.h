@@ -14,6 +14,7 @@
 #include "utils/base_member_pair.h"
 #include "utils/coding/coding.h"
 #include "utils/container/container.h"
+#include "utils/delegate.h"
 #include "utils/error_code.h"
 #include "utils/functor.h"
 #include "utils/iterator.h"
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "benchmark_record.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <cmath>
+
+using outpost::utils::BenchmarkRecord;
+
+constexpr size_t BenchmarkRecord::maximumLength;
+
+namespace
+{
+// Space kept free for the status, the closing brace and the terminator
+constexpr size_t statusReserve = sizeof(",\"status\":\"truncated\"}");
+}  // namespace
+
+BenchmarkRecord::BenchmarkRecord(const char* suite, const char* benchmark) :
+    mLength(0),
+    mFieldStart(0),
+    mTruncated(false),
+    mFinished(false)
+{
+    mBuffer[0] = '\0';
+    append("{");
+    addString("suite", suite);
+    addString("benchmark", benchmark);
+}
+
+BenchmarkRecord&
+BenchmarkRecord::addString(const char* key, const char* value)
+{
+    if (beginField("", key))
+    {
+        endField(append("\"") && appendEscaped(value) && append("\""));
+    }
+    return *this;
+}
+
+BenchmarkRecord&
+BenchmarkRecord::addInteger(const char* key, uint64_t value)
+{
+    if (beginField("", key))
+    {
+        endField(appendFormatted("%llu", static_cast<unsigned long long>(value)));
+    }
+    return *this;
+}
+
+BenchmarkRecord&
+BenchmarkRecord::addNumber(const char* key, double value, unsigned int decimals)
+{
+    if (beginField("", key))
+    {
+        if (std::isfinite(value))
+        {
+            endField(appendFormatted("%.*f", static_cast<int>(decimals), value));
+        }
+        else
+        {
+            endField(append("null"));
+        }
+    }
+    return *this;
+}
+
+BenchmarkRecord&
+BenchmarkRecord::addStatistics(const BenchmarkStatistics& statistics, const char* prefix)
+{
+    const struct
+    {
+        const char* mKey;
+        size_t mValue;
+    } counts[] = {
+            {"samples", statistics.mNumberOfSamples},
+            {"operations_per_sample", statistics.mOperationsPerSample},
+    };
+    for (const auto& count : counts)
+    {
+        if (beginField(prefix, count.mKey))
+        {
+            endField(appendFormatted("%llu", static_cast<unsigned long long>(count.mValue)));
+        }
+    }
+
+    const struct
+    {
+        const char* mKey;
+        double mValue;
+    } durations[] = {
+            {"mean_ns", statistics.mMean},
+            {"min_ns", statistics.mMinimum},
+            {"p50_ns", statistics.mMedian},
+            {"p99_ns", statistics.mPercentile99},
+            {"max_ns", statistics.mMaximum},
+    };
+    for (const auto& duration : durations)
+    {
+        if (beginField(prefix, duration.mKey))
+        {
+            endField(appendFormatted("%.1f", duration.mValue));
+        }
+    }
+    return *this;
+}
+
+const char*
+BenchmarkRecord::finish(bool valid)
+{
+    if (!mFinished)
+    {
+        // Always fits, the space is reserved by append()
+        const char* status = mTruncated ? "truncated" : (valid ? "ok" : "failed");
+        const int length = snprintf(&mBuffer[mLength],
+                                    maximumLength - mLength,
+                                    ",\"status\":\"%s\"}",
+                                    status);
+        mLength += static_cast<size_t>(length);
+        mFinished = true;
+    }
+    return mBuffer;
+}
+
+void
+BenchmarkRecord::write(bool valid, Output output)
+{
+    output(finish(valid));
+}
+
+void
+BenchmarkRecord::writeLine(const char* line)
+{
+    printf("%s\n", line);
+}
+
+// ----------------------------------------------------------------------------
+bool
+BenchmarkRecord::beginField(const char* prefix, const char* key)
+{
+    if (mFinished)
+    {
+        return false;
+    }
+
+    mFieldStart = mLength;
+    const bool first = (mLength == 1);
+    const bool complete = append(first ? "\"" : ",\"") && append(prefix) && append(key)
+                          && append("\":");
+    if (!complete)
+    {
+        endField(false);
+    }
+    return complete;
+}
+
+void
+BenchmarkRecord::endField(bool complete)
+{
+    if (!complete)
+    {
+        mLength = mFieldStart;
+        mBuffer[mLength] = '\0';
+        mTruncated = true;
+    }
+}
+
+bool
+BenchmarkRecord::append(const char* text)
+{
+    const size_t length = strlen(text);
+    if (mLength + length > maximumLength - statusReserve)
+    {
+        return false;
+    }
+    memcpy(&mBuffer[mLength], text, length + 1);
+    mLength += length;
+    return true;
+}
+
+bool
+BenchmarkRecord::appendEscaped(const char* text)
+{
+    for (const char* c = text; *c != '\0'; ++c)
+    {
+        const unsigned char value = static_cast<unsigned char>(*c);
+        bool appended;
+        if ((value == '"') || (value == '\\'))
+        {
+            const char escaped[3] = {'\\', static_cast<char>(value), '\0'};
+            appended = append(escaped);
+        }
+        else if (value < 0x20)
+        {
+            appended = appendFormatted("\\u%04x", static_cast<unsigned int>(value));
+        }
+        else
+        {
+            const char plain[2] = {static_cast<char>(value), '\0'};
+            appended = append(plain);
+        }
+
+        if (!appended)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+BenchmarkRecord::appendFormatted(const char* format, ...)
+{
+    char text[64];
+    va_list arguments;
+    va_start(arguments, format);
+    const int length = vsnprintf(text, sizeof(text), format, arguments);
+    va_end(arguments);
+
+    if ((length < 0) || (static_cast<size_t>(length) >= sizeof(text)))
+    {
+        return false;
+    }
+    return append(text);
+}
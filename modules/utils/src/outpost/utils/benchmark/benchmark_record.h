@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_BENCHMARK_RECORD_H
+#define OUTPOST_UTILS_BENCHMARK_RECORD_H
+
+#include "benchmark_statistics.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace utils
+{
+/**
+ * Result of a single measurement as a JSON object.
+ *
+ * All benchmarks write one record per measurement and line (JSON Lines),
+ * so the results of all modules can be collected and compared across
+ * releases with the same tools:
+ *
+ *     {"suite":"rtos","benchmark":"mutexUncontended",<parameters>,<results>,"status":"ok"}
+ *
+ * - \c suite names the benchmark program, e.g. the module.
+ * - \c benchmark names the measurement within the suite.
+ * - The parameters (e.g. \c message_size, \c threads) follow. Together with
+ *   suite and benchmark they identify the measurement.
+ * - The results carry the unit in their name, e.g. \c megabytes_per_second.
+ *   addStatistics() adds the keys \c samples, \c operations_per_sample,
+ *   \c mean_ns, \c min_ns, \c p50_ns, \c p99_ns and \c max_ns, all
+ *   durations per operation.
+ * - \c status is the last key, \c "ok" or \c "failed" if the benchmark
+ *   did not produce the expected results, \c "truncated" if fields
+ *   had to be dropped because the record exceeded maximumLength.
+ *
+ * Keys are not escaped and must be plain identifiers, string values are.
+ */
+class BenchmarkRecord
+{
+public:
+    /// Receives a finished record without trailing newline
+    typedef void (*Output)(const char* line);
+
+    static constexpr size_t maximumLength = 1024;
+
+    BenchmarkRecord(const char* suite, const char* benchmark);
+
+    BenchmarkRecord&
+    addString(const char* key, const char* value);
+
+    BenchmarkRecord&
+    addInteger(const char* key, uint64_t value);
+
+    /**
+     * Add a number with a fixed number of decimals. Values which are not
+     * finite are written as \c null.
+     */
+    BenchmarkRecord&
+    addNumber(const char* key, double value, unsigned int decimals = 3);
+
+    /**
+     * Add the summary of a measurement.
+     *
+     * \param prefix
+     *      Put in front of all keys, to add more than one set of
+     *      statistics, e.g. "dispatch_".
+     */
+    BenchmarkRecord&
+    addStatistics(const BenchmarkStatistics& statistics, const char* prefix = "");
+
+    /**
+     * Add the status and close the record. No fields can be added
+     * afterwards.
+     *
+     * \return  Finished record.
+     */
+    const char*
+    finish(bool valid);
+
+    /**
+     * Finish the record and pass it to \p output.
+     */
+    void
+    write(bool valid, Output output = &writeLine);
+
+    inline bool
+    isTruncated() const
+    {
+        return mTruncated;
+    }
+
+    /**
+     * Write a line to stdout with printf.
+     */
+    static void
+    writeLine(const char* line);
+
+private:
+    /// Append the separator and the key, false if the record is finished
+    bool
+    beginField(const char* prefix, const char* key);
+
+    /// Remove the current field again if it did not fit
+    void
+    endField(bool complete);
+
+    bool
+    append(const char* text);
+
+    bool
+    appendEscaped(const char* text);
+
+    bool
+    appendFormatted(const char* format, ...);
+
+    char mBuffer[maximumLength];
+    size_t mLength;
+
+    /// Length before the field which is currently appended
+    size_t mFieldStart;
+    bool mTruncated;
+    bool mFinished;
+};
+
+}  // namespace utils
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "benchmark_runner.h"
+
+using outpost::utils::BenchmarkRunner;
+
+constexpr size_t BenchmarkRunner::defaultWarmup;
+
+BenchmarkRunner::BenchmarkRunner(const char* suite,
+                                 outpost::Slice<Ticks> samples,
+                                 BenchmarkRecord::Output output) :
+    mSuite(suite),
+    mSamples(samples),
+    mOutput(output),
+    mWarmup(defaultWarmup)
+{
+}
+
+bool
+BenchmarkRunner::report(BenchmarkRecord& record,
+                        size_t numberOfSamples,
+                        size_t operationsPerSample,
+                        bool valid)
+{
+    const BenchmarkStatistics statistics = BenchmarkStatistics::calculate(
+            mSamples.first(getNumberOfSamples(numberOfSamples)), operationsPerSample);
+    record.addStatistics(statistics);
+    record.write(valid, mOutput);
+    return valid;
+}
+
+size_t
+BenchmarkRunner::getNumberOfSamples(size_t requested) const
+{
+    const size_t available = mSamples.getNumberOfElements();
+    return ((requested == 0) || (requested > available)) ? available : requested;
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_BENCHMARK_RUNNER_H
+#define OUTPOST_UTILS_BENCHMARK_RUNNER_H
+
+#include "benchmark_record.h"
+#include "benchmark_statistics.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/rtos/cycle_clock.h>
+
+#include <stddef.h>
+
+namespace outpost
+{
+namespace utils
+{
+/**
+ * Measure a function repeatedly and write the statistics as a
+ * BenchmarkRecord.
+ *
+ * Every call of the function is one sample and executes a fixed number
+ * of operations, e.g. a loop of 32 mutex lock/unlock pairs. Batching
+ * operations into one sample keeps the overhead of reading the clock
+ * small for operations of a few nanoseconds. The samples are preceded by
+ * warm-up calls which are not measured, to fill the caches and fault in
+ * the pages of the used memory.
+ *
+ * \code
+ * outpost::rtos::CycleClock::Ticks samples[1000];
+ * BenchmarkRunner runner("rtos", outpost::asSlice(samples));
+ *
+ * runner.run("mutexUncontended", [] { ...; return true; }, 32);
+ * \endcode
+ *
+ * The storage of the samples is given by the caller, nothing is
+ * allocated. Measurements which record their samples themselves (e.g.
+ * the jitter of a timer) write into getSamples() and call report().
+ */
+class BenchmarkRunner
+{
+public:
+    typedef outpost::rtos::CycleClock::Ticks Ticks;
+
+    static constexpr size_t defaultWarmup = 10;
+
+    /**
+     * \param suite
+     *      Name of the benchmark program, see BenchmarkRecord.
+     * \param samples
+     *      Storage for the samples, its size is the maximum number of
+     *      samples of a measurement.
+     * \param output
+     *      Receives the records.
+     */
+    BenchmarkRunner(const char* suite,
+                    outpost::Slice<Ticks> samples,
+                    BenchmarkRecord::Output output = &BenchmarkRecord::writeLine);
+
+    // disable copy constructor
+    BenchmarkRunner(const BenchmarkRunner&) = delete;
+
+    // disable assignment operator
+    BenchmarkRunner&
+    operator=(const BenchmarkRunner&) = delete;
+
+    /**
+     * Set the number of calls before the measured samples.
+     */
+    inline void
+    setWarmup(size_t calls)
+    {
+        mWarmup = calls;
+    }
+
+    inline const char*
+    getSuite() const
+    {
+        return mSuite;
+    }
+
+    /**
+     * Create a record for the suite, to add parameters before run().
+     */
+    inline BenchmarkRecord
+    createRecord(const char* benchmark) const
+    {
+        return BenchmarkRecord(mSuite, benchmark);
+    }
+
+    inline outpost::Slice<Ticks>
+    getSamples()
+    {
+        return mSamples;
+    }
+
+    /**
+     * Measure \p function and write the record.
+     *
+     * \param record
+     *      Record with the parameters of the measurement, finished and
+     *      written by this function.
+     * \param function
+     *      Callable with the signature bool(), executes
+     *      \p operationsPerSample operations and returns false if a
+     *      result was not as expected.
+     * \param operationsPerSample
+     *      Operations executed by one call of \p function.
+     * \param numberOfSamples
+     *      Number of measured calls, limited to the size of the sample
+     *      storage. Zero uses the whole storage.
+     *
+     * \return  true if all calls of \p function returned true.
+     */
+    template <typename Function>
+    bool
+    run(BenchmarkRecord& record,
+        Function function,
+        size_t operationsPerSample = 1,
+        size_t numberOfSamples = 0)
+    {
+        const size_t count = getNumberOfSamples(numberOfSamples);
+
+        bool valid = true;
+        for (size_t i = 0; i < mWarmup; ++i)
+        {
+            valid = function() && valid;
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Ticks start = outpost::rtos::CycleClock::now();
+            valid = function() && valid;
+            mSamples[i] = outpost::rtos::CycleClock::now() - start;
+        }
+        return report(record, count, operationsPerSample, valid);
+    }
+
+    /**
+     * Measure \p function without additional parameters.
+     */
+    template <typename Function>
+    inline bool
+    run(const char* benchmark,
+        Function function,
+        size_t operationsPerSample = 1,
+        size_t numberOfSamples = 0)
+    {
+        BenchmarkRecord record = createRecord(benchmark);
+        return run(record, function, operationsPerSample, numberOfSamples);
+    }
+
+    /**
+     * Write the statistics of samples recorded by the caller in
+     * getSamples().
+     *
+     * \return  \p valid
+     */
+    bool
+    report(BenchmarkRecord& record, size_t numberOfSamples, size_t operationsPerSample, bool valid);
+
+private:
+    size_t
+    getNumberOfSamples(size_t requested) const;
+
+    const char* const mSuite;
+    const outpost::Slice<Ticks> mSamples;
+    const BenchmarkRecord::Output mOutput;
+    size_t mWarmup;
+};
+
+}  // namespace utils
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "benchmark_statistics.h"
+
+#include <algorithm>
+
+using outpost::utils::BenchmarkStatistics;
+
+BenchmarkStatistics
+BenchmarkStatistics::calculate(outpost::Slice<outpost::rtos::CycleClock::Ticks> samples,
+                               size_t operationsPerSample,
+                               uint64_t frequency)
+{
+    if (operationsPerSample == 0)
+    {
+        operationsPerSample = 1;
+    }
+
+    BenchmarkStatistics statistics = {
+            samples.getNumberOfElements(), operationsPerSample, 0, 0, 0, 0, 0};
+    if ((samples.getNumberOfElements() == 0) || (frequency == 0))
+    {
+        return statistics;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    double sum = 0;
+    for (outpost::rtos::CycleClock::Ticks sample : samples)
+    {
+        sum += static_cast<double>(sample);
+    }
+
+    // Nanoseconds per operation
+    const double scale =
+            1e9 / (static_cast<double>(frequency) * static_cast<double>(operationsPerSample));
+    const size_t last = samples.getNumberOfElements() - 1;
+
+    statistics.mMean = sum * scale / static_cast<double>(samples.getNumberOfElements());
+    statistics.mMinimum = static_cast<double>(samples[0]) * scale;
+    statistics.mMedian = static_cast<double>(samples[last / 2]) * scale;
+    statistics.mPercentile99 = static_cast<double>(samples[(last * 99) / 100]) * scale;
+    statistics.mMaximum = static_cast<double>(samples[last]) * scale;
+    return statistics;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_BENCHMARK_STATISTICS_H
+#define OUTPOST_UTILS_BENCHMARK_STATISTICS_H
+
+#include <outpost/base/slice.h>
+#include <outpost/rtos/cycle_clock.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace utils
+{
+/**
+ * Summary of the samples of a measurement.
+ *
+ * A sample is the duration of a fixed number of operations in
+ * outpost::rtos::CycleClock ticks. All times are converted to nanoseconds
+ * per operation.
+ */
+struct BenchmarkStatistics
+{
+    size_t mNumberOfSamples;
+    size_t mOperationsPerSample;
+    double mMean;
+    double mMinimum;
+    double mMedian;
+    double mPercentile99;
+    double mMaximum;
+
+    /**
+     * Calculate the statistics, sorts the samples.
+     *
+     * \param samples
+     *      Durations in ticks, may be empty.
+     * \param operationsPerSample
+     *      Number of operations measured by every sample, at least one.
+     * \param frequency
+     *      Ticks per second.
+     */
+    static BenchmarkStatistics
+    calculate(outpost::Slice<outpost::rtos::CycleClock::Ticks> samples,
+              size_t operationsPerSample,
+              uint64_t frequency);
+
+    /**
+     * Calculate the statistics of samples measured with
+     * outpost::rtos::CycleClock.
+     */
+    static inline BenchmarkStatistics
+    calculate(outpost::Slice<outpost::rtos::CycleClock::Ticks> samples, size_t operationsPerSample)
+    {
+        return calculate(samples, operationsPerSample, outpost::rtos::CycleClock::getFrequency());
+    }
+};
+
+}  // namespace utils
+}  // namespace outpost
+
+#endif
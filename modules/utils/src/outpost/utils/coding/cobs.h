@@ -30,9 +30,9 @@ namespace utils
  * any additional buffer memory and outputs one byte at a time. It needs access
  * to the complete input array to calculate the COBS block sizes.
  *
- * Use this function only if you need the encoded data on a byte by byte base,
- * e.g. when loading a FIFO. The Cobs::encode() function is faster when
- * generating the data into an array in the memory.
+ * Use this function only if you need the encoded data on a byte by byte base
+ * or in chunks, e.g. when loading a FIFO or a DMA buffer. The Cobs::encode()
+ * function is faster when generating the data into an array in the memory.
  *
  * \author  Fabian Greif
  */
@@ -67,6 +67,22 @@ public:
     uint8_t
     getNextByte();
 
+    /**
+     * Generate the next chunk of encoded data.
+     *
+     * Gives the same result as calling getNextByte() until either the
+     * output is full or isFinished() returns true. The data of a block is
+     * copied at once.
+     *
+     * \param output
+     *     Buffer for the encoded data.
+     *
+     * \return
+     *     Number of bytes written to \p output.
+     */
+    size_t
+    getNextBytes(outpost::Slice<uint8_t> output);
+
 private:
     uint8_t
     findNextBlock();
@@ -114,6 +130,34 @@ public:
     static size_t
     encode(outpost::Slice<const uint8_t> input, outpost::Slice<uint8_t> output);
 
+    /**
+     * Encode a frame consisting of the data and its checksum in a single pass.
+     *
+     * The checksum is calculated over the data while it is copied into the
+     * output buffer. It is appended in big endian byte order, encoded
+     * together with the data, and the frame is terminated with a zero byte.
+     * The result is identical to calculating the checksum, appending it,
+     * encoding the combined buffer with encode() and adding the delimiter,
+     * without the intermediate buffers.
+     *
+     * \tparam Crc
+     *     Checksum engine, e.g. outpost::Crc16Ccitt.
+     *
+     * \param input
+     *     Data to be framed.
+     * \param output
+     *     Frame buffer, e.g. the transmit buffer of the driver. Must hold
+     *     at least getMaximumSizeOfEncodedData() of the data plus the
+     *     checksum and one additional byte for the delimiter.
+     *
+     * \return
+     *     Length of the frame including the delimiter or zero if the output
+     *     buffer is too small.
+     */
+    template <typename Crc>
+    static size_t
+    encodeFrame(outpost::Slice<const uint8_t> input, outpost::Slice<uint8_t> output);
+
     static size_t
     getMaximumSizeOfEncodedData(size_t inputLength);
 
@@ -135,8 +179,167 @@ public:
     decode(outpost::Slice<const uint8_t> input, uint8_t* output);
 };
 
+/**
+ * Incremental COBS decoder for a stream of frames.
+ *
+ * Frames are delimited by zero bytes, as usual for COBS over a serial
+ * line. The received data can be passed in chunks of arbitrary size, e.g.
+ * as returned by outpost::hal::Serial::read(), and is decoded directly
+ * into the frame buffer. No copy of the encoded frame is needed.
+ *
+ * After a complete frame has been decoded, decode() stops consuming data
+ * until the frame is released. The buffer can then be reused with
+ * releaseFrame() or exchanged with setBuffer(), e.g. to hand the frame
+ * over in a SharedBufferPointer and continue with a newly allocated one:
+ *
+ * \code
+ * while (data.getNumberOfElements() > 0)
+ * {
+ *     data = data.skipFirst(decoder.decode(data));
+ *     if (decoder.isFrameAvailable())
+ *     {
+ *         SharedChildPointer frame;
+ *         pointer.getChild(frame, type, 0, decoder.getFrame().getNumberOfElements());
+ *         queue.send(frame);
+ *
+ *         pool.allocate(pointer);
+ *         decoder.setBuffer(pointer.asSlice());
+ *     }
+ * }
+ * \endcode
+ *
+ * Frames which do not fit into the buffer or which end within a block
+ * are discarded and counted as errors. Empty frames, i.e. consecutive
+ * delimiters, are skipped.
+ */
+template <uint8_t blockLength>
+class CobsStreamDecoderBase
+{
+public:
+    /// Maximum length of a COBS block
+    static const uint8_t maximumBlockLength = 254;
+
+    /**
+     * Construct a decoder without a frame buffer.
+     *
+     * All frames are discarded until a buffer is set with setBuffer().
+     */
+    CobsStreamDecoderBase();
+
+    /**
+     * \param buffer
+     *     Buffer for the decoded frames.
+     */
+    explicit CobsStreamDecoderBase(outpost::Slice<uint8_t> buffer);
+
+    /**
+     * Set a new buffer for the decoded frames.
+     *
+     * Releases an available frame. Data of a partially received frame is
+     * kept in the old buffer and the frame is decoded into the new
+     * buffer, i.e. the new buffer should only be set between frames.
+     */
+    void
+    setBuffer(outpost::Slice<uint8_t> buffer);
+
+    /**
+     * Decode received data.
+     *
+     * Stops at the end of a frame so that the frame can be processed
+     * before the buffer is overwritten by the next one.
+     *
+     * \param input
+     *     Received data, may start or end at any position within a frame.
+     *
+     * \return
+     *     Number of bytes consumed from \p input. Zero if a frame is still
+     *     available.
+     */
+    size_t
+    decode(outpost::Slice<const uint8_t> input);
+
+    /**
+     * Check whether a complete frame has been decoded.
+     */
+    inline bool
+    isFrameAvailable() const
+    {
+        return mFrameAvailable;
+    }
+
+    /**
+     * Check whether a frame has been started but not completed yet.
+     */
+    inline bool
+    isFrameInProgress() const
+    {
+        return mStarted && !mFrameAvailable;
+    }
+
+    /**
+     * Access the decoded frame.
+     *
+     * \return
+     *     Decoded frame, empty if no frame is available.
+     */
+    outpost::Slice<uint8_t>
+    getFrame() const;
+
+    /**
+     * Release the decoded frame and start the next one in the same buffer.
+     */
+    void
+    releaseFrame();
+
+    /**
+     * Discard a partially received frame.
+     *
+     * The following data is ignored up to and including the next
+     * delimiter. Use this e.g. after a timeout while waiting for the rest
+     * of a frame.
+     */
+    void
+    resynchronize();
+
+    /**
+     * Number of frames discarded because of an overflow of the buffer or
+     * an invalid encoding.
+     */
+    inline size_t
+    getNumberOfErrors() const
+    {
+        return mErrors;
+    }
+
+private:
+    void
+    startFrame();
+
+    void
+    discardFrame();
+
+    outpost::Slice<uint8_t> mBuffer;
+    size_t mLength;
+
+    /// Number of data bytes remaining in the current block
+    uint8_t mRemaining;
+
+    /// A zero has to be inserted before the next block
+    bool mZeroPending;
+
+    /// At least one block of the current frame has been received
+    bool mStarted;
+
+    /// The current frame is ignored up to the next delimiter
+    bool mDiscarding;
+
+    bool mFrameAvailable;
+    size_t mErrors;
+};
+
 typedef CobsEncodingGeneratorBase<254> CobsEncodingGenerator;
 typedef CobsBase<254> Cobs;
+typedef CobsStreamDecoderBase<254> CobsStreamDecoder;
 
 }  // namespace utils
 }  // namespace outpost
@@ -18,10 +18,174 @@
 
 #include <string.h>  // for memcpy
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace outpost
 {
 namespace utils
 {
+namespace internal
+{
+/**
+ * Find the first zero byte in [begin, end).
+ *
+ * Tests a machine word at a time for a zero byte, or 16 bytes at a time
+ * with SSE2 where available.
+ *
+ * \return
+ *     Pointer to the first zero byte or \p end if there is none.
+ */
+inline const uint8_t*
+findZeroByte(const uint8_t* begin, const uint8_t* end)
+{
+    const uint8_t* it = begin;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    while (end - it >= 16)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, zero));
+        if (mask != 0)
+        {
+            return it + __builtin_ctz(static_cast<unsigned int>(mask));
+        }
+        it += 16;
+    }
+#endif
+
+    // (w - 0x01..01) & ~w & 0x80..80 is not zero iff one of the bytes of w is zero
+    const size_t low = static_cast<size_t>(-1) / 0xFF;
+    const size_t high = low * 0x80;
+    while (static_cast<size_t>(end - it) >= sizeof(size_t))
+    {
+        size_t word;
+        memcpy(&word, it, sizeof(word));
+        if (((word - low) & ~word & high) != 0)
+        {
+            break;
+        }
+        it += sizeof(size_t);
+    }
+
+    while ((it < end) && (*it != 0))
+    {
+        it++;
+    }
+    return it;
+}
+
+/// Consumer for CobsEncoder::append() which does not look at the data
+struct IgnoreData
+{
+    inline void
+    operator()(const uint8_t*, size_t) const
+    {
+    }
+};
+
+/**
+ * Encoder state shared by Cobs::encode() and Cobs::encodeFrame().
+ *
+ * Allows encoding input which is not available as one contiguous buffer
+ * and passes every consumed chunk of input to a consumer, e.g. to calculate
+ * a checksum while the data is copied.
+ */
+template <uint8_t blockLength>
+class CobsEncoder
+{
+public:
+    /**
+     * \param output
+     *     Output buffer.
+     * \param capacity
+     *     Number of bytes of \p output which may be used.
+     */
+    inline CobsEncoder(outpost::Slice<uint8_t> output, size_t capacity) :
+        mOutputPtr(&output[0]),
+        mBlockLengthPtr(mOutputPtr++),
+        mLength(1),
+        mCapacity(capacity),
+        mCurrentBlockLength(0)
+    {
+    }
+
+    /**
+     * Encode the bytes [inputPtr, inputEnd).
+     *
+     * Stops when the capacity of the output buffer is reached.
+     */
+    template <typename Consumer>
+    inline void
+    append(const uint8_t* inputPtr, const uint8_t* inputEnd, Consumer consumer)
+    {
+        while ((inputPtr < inputEnd) && (mLength < mCapacity))
+        {
+            // Copy the bytes up to the next zero at once, limited by the end of
+            // the block, the input and the output buffer
+            size_t limit = blockLength - mCurrentBlockLength;
+            if (limit > static_cast<size_t>(inputEnd - inputPtr))
+            {
+                limit = inputEnd - inputPtr;
+            }
+            if (limit > mCapacity - mLength)
+            {
+                limit = mCapacity - mLength;
+            }
+
+            const uint8_t* zeroPtr = findZeroByte(inputPtr, inputPtr + limit);
+            size_t count = zeroPtr - inputPtr;
+            memcpy(mOutputPtr, inputPtr, count);
+            mOutputPtr += count;
+            mLength += count;
+            mCurrentBlockLength += static_cast<uint8_t>(count);
+
+            if (count < limit)
+            {
+                // Zero byte, replaced by the length of the block it terminates
+                consumer(inputPtr, count + 1);
+                *mBlockLengthPtr = mCurrentBlockLength + 1;
+                mBlockLengthPtr = mOutputPtr++;
+                mLength++;
+                mCurrentBlockLength = 0;
+                inputPtr += count + 1;
+            }
+            else
+            {
+                consumer(inputPtr, count);
+                inputPtr += count;
+                if ((mCurrentBlockLength == blockLength) && (mLength < mCapacity))
+                {
+                    *mBlockLengthPtr = mCurrentBlockLength + 1;
+                    mBlockLengthPtr = mOutputPtr++;
+                    mLength++;
+                    mCurrentBlockLength = 0;
+                }
+            }
+        }
+    }
+
+    /// Finish the last block and return the number of bytes used.
+    inline size_t
+    finish()
+    {
+        *mBlockLengthPtr = mCurrentBlockLength + 1;
+        return mLength;
+    }
+
+private:
+    uint8_t* mOutputPtr;
+
+    // Pointer to the position where later the block length is inserted
+    uint8_t* mBlockLengthPtr;
+    size_t mLength;
+    size_t mCapacity;
+    uint8_t mCurrentBlockLength;
+};
+
+}  // namespace internal
+
 // ----------------------------------------------------------------------------
 template <uint8_t blockLength>
 CobsEncodingGeneratorBase<blockLength>::CobsEncodingGeneratorBase(
@@ -102,24 +266,52 @@ CobsEncodingGeneratorBase<blockLength>::getNextByte()
     return value;
 }
 
+template <uint8_t blockLength>
+size_t
+CobsEncodingGeneratorBase<blockLength>::getNextBytes(outpost::Slice<uint8_t> output)
+{
+    uint8_t* outputPtr = output.begin();
+    size_t remaining = output.getNumberOfElements();
+    while ((remaining > 0) && !isFinished())
+    {
+        if (mNextBlock == 0)
+        {
+            *outputPtr++ = getNextByte();
+            remaining--;
+        }
+        else
+        {
+            size_t length = (mNextBlock < remaining) ? mNextBlock : remaining;
+            memcpy(outputPtr, &mData[mCurrentPosition], length);
+            outputPtr += length;
+            remaining -= length;
+            mCurrentPosition += length;
+            mNextBlock -= static_cast<uint8_t>(length);
+        }
+    }
+
+    return output.getNumberOfElements() - remaining;
+}
+
 template <uint8_t blockLength>
 uint8_t
 CobsEncodingGeneratorBase<blockLength>::findNextBlock()
 {
     uint8_t blockSize = 0;
-    size_t position = mCurrentPosition;
 
-    // Loop until either:
-    // - A zero is found which determines the block length
-    // - No zero is found for 254 consecutive bytes
-    // - The end of the input array is reached.
+    // The block ends either:
+    // - At a zero which determines the block length
+    // - If no zero is found for 254 consecutive bytes
+    // - At the end of the input array.
     if (mData != nullptr)
     {
-        while ((position < mLength) && (mData[position] != 0) && (blockSize < blockLength))
+        size_t limit = mLength - mCurrentPosition;
+        if (limit > blockLength)
         {
-            position++;
-            blockSize++;
+            limit = blockLength;
         }
+        const uint8_t* begin = &mData[mCurrentPosition];
+        blockSize = static_cast<uint8_t>(internal::findZeroByte(begin, begin + limit) - begin);
     }
 
     return blockSize;
@@ -130,42 +322,45 @@ template <uint8_t blockLength>
 size_t
 CobsBase<blockLength>::encode(outpost::Slice<const uint8_t> input, outpost::Slice<uint8_t> output)
 {
-    const uint8_t* inputPtr = &input[0];
-    const uint8_t* inputEnd = inputPtr + input.getNumberOfElements();
-    uint8_t* outputPtr = &output[0];
+    internal::CobsEncoder<blockLength> encoder(output, output.getNumberOfElements());
+    encoder.append(&input[0], &input[0] + input.getNumberOfElements(), internal::IgnoreData());
+    return encoder.finish();
+}
 
-    // Pointer to the position where later the block length is inserted
-    uint8_t* blockLengthPtr = outputPtr++;
-    size_t length = 1;
-    uint8_t currentBlockLength = 0;
+template <uint8_t blockLength>
+template <typename Crc>
+size_t
+CobsBase<blockLength>::encodeFrame(outpost::Slice<const uint8_t> input,
+                                   outpost::Slice<uint8_t> output)
+{
+    typedef typename Crc::ValueType ValueType;
+    const size_t checksumLength = sizeof(ValueType);
+    const size_t encodedLength =
+            getMaximumSizeOfEncodedData(input.getNumberOfElements() + checksumLength);
+    if (output.getNumberOfElements() < encodedLength + 1)
+    {
+        return 0;
+    }
 
-    while ((inputPtr < inputEnd) && (length < output.getNumberOfElements()))
+    Crc crc;
+    internal::CobsEncoder<blockLength> encoder(output, encodedLength);
+    encoder.append(&input[0],
+                   &input[0] + input.getNumberOfElements(),
+                   [&crc](const uint8_t* data, size_t length) {
+                       crc.update(outpost::Slice<const uint8_t>::unsafe(data, length));
+                   });
+
+    const ValueType value = crc.getValue();
+    uint8_t checksum[checksumLength];
+    for (size_t i = 0; i < checksumLength; ++i)
     {
-        if (*inputPtr == 0)
-        {
-            *blockLengthPtr = currentBlockLength + 1;
-            blockLengthPtr = outputPtr++;
-            length++;
-            currentBlockLength = 0;
-        }
-        else
-        {
-            *outputPtr++ = *inputPtr;
-            length++;
-            currentBlockLength++;
-            if ((currentBlockLength == blockLength) && (length < output.getNumberOfElements()))
-            {
-                *blockLengthPtr = currentBlockLength + 1;
-                blockLengthPtr = outputPtr++;
-                length++;
-                currentBlockLength = 0;
-            }
-        }
-        inputPtr++;
+        checksum[i] = static_cast<uint8_t>(value >> (8 * (checksumLength - 1 - i)));
     }
-    *blockLengthPtr = currentBlockLength + 1;
+    encoder.append(&checksum[0], &checksum[checksumLength], internal::IgnoreData());
 
-    return length;
+    const size_t length = encoder.finish();
+    output[length] = 0;
+    return length + 1;
 }
 
 template <uint8_t blockLength>
@@ -226,6 +421,180 @@ CobsBase<blockLength>::decode(outpost::Slice<const uint8_t> input, uint8_t* outp
     return outputPosition;
 }
 
+// ----------------------------------------------------------------------------
+template <uint8_t blockLength>
+CobsStreamDecoderBase<blockLength>::CobsStreamDecoderBase() :
+    mBuffer(outpost::Slice<uint8_t>::empty()),
+    mLength(0),
+    mRemaining(0),
+    mZeroPending(false),
+    mStarted(false),
+    mDiscarding(false),
+    mFrameAvailable(false),
+    mErrors(0)
+{
+}
+
+template <uint8_t blockLength>
+CobsStreamDecoderBase<blockLength>::CobsStreamDecoderBase(outpost::Slice<uint8_t> buffer) :
+    mBuffer(buffer),
+    mLength(0),
+    mRemaining(0),
+    mZeroPending(false),
+    mStarted(false),
+    mDiscarding(false),
+    mFrameAvailable(false),
+    mErrors(0)
+{
+}
+
+template <uint8_t blockLength>
+void
+CobsStreamDecoderBase<blockLength>::setBuffer(outpost::Slice<uint8_t> buffer)
+{
+    mBuffer = buffer;
+    if (mFrameAvailable)
+    {
+        startFrame();
+    }
+}
+
+template <uint8_t blockLength>
+outpost::Slice<uint8_t>
+CobsStreamDecoderBase<blockLength>::getFrame() const
+{
+    if (!mFrameAvailable)
+    {
+        return outpost::Slice<uint8_t>::empty();
+    }
+    return mBuffer.first(mLength);
+}
+
+template <uint8_t blockLength>
+void
+CobsStreamDecoderBase<blockLength>::releaseFrame()
+{
+    if (mFrameAvailable)
+    {
+        startFrame();
+    }
+}
+
+template <uint8_t blockLength>
+void
+CobsStreamDecoderBase<blockLength>::resynchronize()
+{
+    if (!mFrameAvailable)
+    {
+        startFrame();
+        mDiscarding = true;
+    }
+}
+
+template <uint8_t blockLength>
+void
+CobsStreamDecoderBase<blockLength>::startFrame()
+{
+    mLength = 0;
+    mRemaining = 0;
+    mZeroPending = false;
+    mStarted = false;
+    mDiscarding = false;
+    mFrameAvailable = false;
+}
+
+template <uint8_t blockLength>
+void
+CobsStreamDecoderBase<blockLength>::discardFrame()
+{
+    mErrors++;
+    startFrame();
+    mDiscarding = true;
+}
+
+template <uint8_t blockLength>
+size_t
+CobsStreamDecoderBase<blockLength>::decode(outpost::Slice<const uint8_t> input)
+{
+    const uint8_t* inputPtr = input.begin();
+    const uint8_t* inputEnd = inputPtr + input.getNumberOfElements();
+
+    while ((inputPtr < inputEnd) && !mFrameAvailable)
+    {
+        if (mDiscarding)
+        {
+            const uint8_t* delimiter = internal::findZeroByte(inputPtr, inputEnd);
+            if (delimiter == inputEnd)
+            {
+                inputPtr = inputEnd;
+            }
+            else
+            {
+                inputPtr = delimiter + 1;
+                startFrame();
+            }
+        }
+        else if (mRemaining > 0)
+        {
+            // Copy the data of the current block, limited by the received data
+            size_t count = inputEnd - inputPtr;
+            if (count > mRemaining)
+            {
+                count = mRemaining;
+            }
+            const uint8_t* delimiter = internal::findZeroByte(inputPtr, inputPtr + count);
+            if (delimiter < inputPtr + count)
+            {
+                // Frame ends within a block
+                inputPtr = delimiter + 1;
+                discardFrame();
+                mDiscarding = false;
+            }
+            else if (count > mBuffer.getNumberOfElements() - mLength)
+            {
+                inputPtr += count;
+                discardFrame();
+            }
+            else
+            {
+                memcpy(&mBuffer[mLength], inputPtr, count);
+                mLength += count;
+                inputPtr += count;
+                mRemaining -= static_cast<uint8_t>(count);
+            }
+        }
+        else
+        {
+            uint8_t code = *inputPtr++;
+            if (code == 0)
+            {
+                if (mStarted)
+                {
+                    // The zero after the last block is implicit and not output
+                    mFrameAvailable = true;
+                }
+            }
+            else if (mZeroPending && (mLength >= mBuffer.getNumberOfElements()))
+            {
+                discardFrame();
+            }
+            else
+            {
+                if (mZeroPending)
+                {
+                    mBuffer[mLength] = 0;
+                    mLength++;
+                }
+                mStarted = true;
+                mRemaining = code - 1;
+                mZeroPending = (mRemaining < blockLength);
+            }
+        }
+    }
+
+    return inputPtr - input.begin();
+}
+
 }  // namespace utils
 }  // namespace outpost
 
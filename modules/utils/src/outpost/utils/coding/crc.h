@@ -22,5 +22,6 @@
  */
 
 #include "crc16.h"
+#include "crc_engine.h"
 #include "crc32.h"
 #include "crc8.h"
@@ -14,10 +14,7 @@
 #ifndef OUTPOST_CRC16_H
 #define OUTPOST_CRC16_H
 
-#include <outpost/base/slice.h>
-
-#include <stddef.h>
-#include <stdint.h>
+#include "crc_engine.h"
 
 namespace outpost
 {
@@ -27,80 +24,26 @@ namespace outpost
  * Polynomial    : x^16 + x^12 + x^5 + 1 (0x1021, MSB first)
  * Initial value : 0xFFFF
  *
- * Used for space packet transfer frames.
+ * Used for space packet transfer frames. Blocks are processed with
+ * slice-by-4.
  *
  * \ingroup crc
  * \author  Fabian Greif
  */
-class Crc16Ccitt
-{
-public:
-    inline Crc16Ccitt() : mCrc(initialValue)
-    {
-    }
-
-    inline ~Crc16Ccitt()
-    {
-    }
-
-    /**
-     * Calculate CRC from a block of data.
-     *
-     * \param data
-     *     address
-     * \param length
-     *     length
-     *
-     * \retval crc
-     *     calculated checksum
-     */
-    static uint16_t
-    calculate(outpost::Slice<const uint8_t> data);
-
-    /**
-     * Reset CRC calculation
-     */
-    inline void
-    reset()
-    {
-        mCrc = initialValue;
-    }
-
-    /**
-     * CRC update.
-     *
-     * \param data
-     *     byte
-     */
-    void
-    update(uint8_t data);
-
-    /**
-     * Get result of CRC calculation.
-     */
-    inline uint16_t
-    getValue() const
-    {
-        return mCrc;
-    }
-
-private:
-    // disable copy constructor
-    Crc16Ccitt(const Crc16Ccitt&);
-
-    // disable copy-assignment operator
-    Crc16Ccitt&
-    operator=(const Crc16Ccitt&);
+typedef CrcEngine<16, 0x1021, 0xFFFF, false, false, 0x0000, 4> Crc16Ccitt;
 
-    static const uint16_t initialValue = 0xFFFF;
-    static const int numberOfBitsPerByte = 8;
-    static const int numberOfValuesPerByte = 256;
-
-    /// Pre-calculated CRC table for one byte
-    static const uint16_t crcTable[numberOfValuesPerByte];
-
-    uint16_t mCrc;
-};
+/**
+ * CRC-16/X-25 calculation.
+ *
+ * Polynomial    : x^16 + x^12 + x^5 + 1 (0x8408, LSB first)
+ * Initial value : 0xFFFF
+ * Final XOR     : 0xFFFF
+ *
+ * Used in HDLC (ISO/IEC 13239) based links, also known as CRC-16/IBM-SDLC.
+ *
+ * \ingroup crc
+ */
+typedef CrcEngine<16, 0x1021, 0xFFFF, true, true, 0xFFFF, 4> Crc16X25;
 }  // namespace outpost
 
 #endif
@@ -14,10 +14,7 @@
 #ifndef OUTPOST_CRC32_H
 #define OUTPOST_CRC32_H
 
-#include <outpost/base/slice.h>
-
-#include <stddef.h>
-#include <stdint.h>
+#include "crc_engine.h"
 
 namespace outpost
 {
@@ -36,80 +33,28 @@ namespace outpost
  * [2] http://www.w3.org/TR/PNG/#D-CRCAppendix
  * [3] http://www.greenend.org.uk/rjk/tech/crc.html
  *
+ * Blocks are processed with slice-by-8 (8 KiB of tables) or the ARMv8
+ * CRC32 instructions where available.
+ *
  * \ingroup crc
  * \author  Fabian Greif
  */
-class Crc32Reversed
-{
-public:
-    inline Crc32Reversed() : mCrc(initialValue)
-    {
-    }
-
-    inline ~Crc32Reversed()
-    {
-    }
-
-    /**
-     * Calculate CRC from a block of data.
-     *
-     * \param data
-     *     address
-     * \param length
-     *     length
-     *
-     * \retval crc
-     *     calculated checksum
-     */
-    static uint32_t
-    calculate(outpost::Slice<const uint8_t> data);
-
-    /**
-     * Reset CRC calculation
-     */
-    inline void
-    reset()
-    {
-        mCrc = initialValue;
-    }
-
-    /**
-     * CRC update.
-     *
-     * \param data
-     *     byte
-     */
-    void
-    update(uint8_t data);
-
-    /**
-     * Get result of CRC calculation.
-     */
-    inline uint32_t
-    getValue() const
-    {
-        return mCrc ^ finalXor;
-    }
-
-private:
-    // disable copy constructor
-    Crc32Reversed(const Crc32Reversed&);
-
-    // disable copy-assignment operator
-    Crc32Reversed&
-    operator=(const Crc32Reversed&);
-
-    static const uint32_t initialValue = 0xFFFFFFFF;
-    static const uint32_t finalXor = 0xFFFFFFFF;
+typedef CrcEngine<32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 8> Crc32Reversed;
 
-    static const int numberOfBitsPerByte = 8;
-    static const int numberOfValuesPerByte = 256;
-
-    /// Pre-calculated CRC table for one byte
-    static const uint32_t crcTable[numberOfValuesPerByte];
-
-    uint32_t mCrc;
-};
+/**
+ * CRC-32C (Castagnoli) calculation.
+ *
+ * Polynomial    : 0x1EDC6F41 (0x82F63B78, LSB first)
+ * Initial value : 0xFFFFFFFF
+ * Final XOR     : 0xFFFFFFFF
+ *
+ * Better error detection than CRC-32 for the block lengths of storage
+ * systems, used in iSCSI and SCTP. Blocks are processed with slice-by-8 or
+ * the SSE4.2 and ARMv8 CRC32 instructions where available.
+ *
+ * \ingroup crc
+ */
+typedef CrcEngine<32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 8> Crc32Castagnoli;
 }  // namespace outpost
 
 #endif
@@ -14,10 +14,7 @@
 #ifndef OUTPOST_CRC8_H
 #define OUTPOST_CRC8_H
 
-#include <outpost/base/slice.h>
-
-#include <stddef.h>
-#include <stdint.h>
+#include "crc_engine.h"
 
 namespace outpost
 {
@@ -27,77 +24,12 @@ namespace outpost
  * Polynomial    : x^8 + x^2 + x + 1 (0x07, MSB first)
  * Initial value : 0x00
  *
+ * Blocks are processed with slice-by-4.
+ *
  * \ingroup crc
  * \author  Fabian Greif
  */
-class Crc8Ccitt
-{
-public:
-    inline Crc8Ccitt() : mCrc(initialValue)
-    {
-    }
-
-    inline ~Crc8Ccitt()
-    {
-    }
-
-    /**
-     * Calculate CRC from a block of data.
-     *
-     * \param data
-     *     address
-     * \param length
-     *     length
-     *
-     * \retval crc
-     *     calculated checksum
-     */
-    static uint8_t
-    calculate(outpost::Slice<const uint8_t> data);
-
-    /**
-     * Reset CRC calculation
-     */
-    inline void
-    reset()
-    {
-        mCrc = initialValue;
-    }
-
-    /**
-     * CRC update.
-     *
-     * \param data
-     *     byte
-     */
-    void
-    update(uint8_t data);
-
-    /**
-     * Get result of CRC calculation.
-     */
-    inline uint8_t
-    getValue() const
-    {
-        return mCrc;
-    }
-
-private:
-    // disable copy constructor
-    Crc8Ccitt(const Crc8Ccitt&);
-
-    // disable copy-assignment operator
-    Crc8Ccitt&
-    operator=(const Crc8Ccitt&);
-
-    static const uint8_t initialValue = 0x00;
-    static const int numberOfValuesPerByte = 256;
-
-    /// Pre-calculated CRC table for one byte
-    static const uint8_t crcTable[numberOfValuesPerByte];
-
-    uint8_t mCrc;
-};
+typedef CrcEngine<8, 0x07, 0x00, false, false, 0x00, 4> Crc8Ccitt;
 
 /**
  * CRC-8 calculation for RMAP.
@@ -105,79 +37,14 @@ private:
  * Polynomial    : x^8 + x^2 + x + 1 (0xE0, LSB first)
  * Initial value : 0x00
  *
+ * Blocks are processed with slice-by-4.
+ *
  * \see     ECSS-E-50-11 SpaceWire RMAP Protocol
  *
  * \ingroup crc
  * \author  Fabian Greif
  */
-class Crc8CcittReversed
-{
-public:
-    inline Crc8CcittReversed() : mCrc(initialValue)
-    {
-    }
-
-    inline ~Crc8CcittReversed()
-    {
-    }
-
-    /**
-     * Calculate CRC from a block of data.
-     *
-     * \param data
-     *     address
-     * \param length
-     *     length
-     *
-     * \retval crc
-     *     calculated checksum
-     */
-    static uint8_t
-    calculate(outpost::Slice<const uint8_t> data);
-
-    /**
-     * Reset CRC calculation
-     */
-    inline void
-    reset()
-    {
-        mCrc = initialValue;
-    }
-
-    /**
-     * CRC update.
-     *
-     * \param data
-     *     byte
-     */
-    void
-    update(uint8_t data);
-
-    /**
-     * Get result of CRC calculation.
-     */
-    inline uint8_t
-    getValue() const
-    {
-        return mCrc;
-    }
-
-private:
-    // disable copy constructor
-    Crc8CcittReversed(const Crc8CcittReversed&);
-
-    // disable copy-assignment operator
-    Crc8CcittReversed&
-    operator=(const Crc8CcittReversed&);
-
-    static const uint8_t initialValue = 0x00;
-    static const int numberOfValuesPerByte = 256;
-
-    /// Pre-calculated CRC table for one byte
-    static const uint8_t crcTable[numberOfValuesPerByte];
-
-    uint8_t mCrc;
-};
+typedef CrcEngine<8, 0x07, 0x00, true, true, 0x00, 4> Crc8CcittReversed;
 }  // namespace outpost
 
 #endif
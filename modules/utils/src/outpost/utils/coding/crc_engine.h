@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_CODING_CRC_ENGINE_H
+#define OUTPOST_UTILS_CODING_CRC_ENGINE_H
+
+#include <outpost/base/slice.h>
+#include <outpost/utils/meta.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace internal
+{
+template <uint8_t width>
+struct CrcValue;
+
+template <>
+struct CrcValue<8>
+{
+    typedef uint8_t Type;
+};
+
+template <>
+struct CrcValue<16>
+{
+    typedef uint16_t Type;
+};
+
+template <>
+struct CrcValue<32>
+{
+    typedef uint32_t Type;
+};
+
+constexpr uint32_t
+crcMask(uint8_t width)
+{
+    return (width >= 32) ? 0xFFFFFFFFUL : ((static_cast<uint32_t>(1) << width) - 1);
+}
+
+constexpr uint32_t
+crcReflect(uint32_t value, uint8_t bits)
+{
+    return (bits == 0) ? 0
+                       : (((value & 1) << (bits - 1)) | crcReflect(value >> 1, bits - 1));
+}
+
+constexpr uint32_t
+crcShiftBits(uint32_t crc, uint8_t bits, uint8_t width, uint32_t polynomial, bool reflected)
+{
+    return (bits == 0)
+                   ? crc
+                   : crcShiftBits(
+                             reflected ? (((crc & 1) != 0) ? ((crc >> 1) ^ polynomial)
+                                                           : (crc >> 1))
+                                       : (((crc & (static_cast<uint32_t>(1) << (width - 1))) != 0)
+                                                  ? (((crc << 1) ^ polynomial) & crcMask(width))
+                                                  : ((crc << 1) & crcMask(width))),
+                             bits - 1,
+                             width,
+                             polynomial,
+                             reflected);
+}
+
+/**
+ * CRC register after processing a single byte, starting from zero.
+ */
+constexpr uint32_t
+crcByteEntry(uint32_t byte, uint8_t width, uint32_t polynomial, bool reflected)
+{
+    return crcShiftBits(reflected ? byte : (byte << (width - 8)), 8, width, polynomial, reflected);
+}
+
+/**
+ * CRC register after processing a single byte followed by the given number of zero bytes.
+ */
+constexpr uint32_t
+crcTableEntry(size_t zeros, uint32_t byte, uint8_t width, uint32_t polynomial, bool reflected)
+{
+    return (zeros == 0)
+                   ? crcByteEntry(byte, width, polynomial, reflected)
+                   : crcShiftBits(crcTableEntry(zeros - 1, byte, width, polynomial, reflected),
+                                  8,
+                                  width,
+                                  polynomial,
+                                  reflected);
+}
+
+/**
+ * Lookup tables for slice-by-N, generated by the compiler.
+ *
+ * Entry 256 * k + i is the CRC register of byte i followed by k zero bytes.
+ * The tables only depend on the polynomial and the bit order, engines
+ * differing in the initial value or the final XOR share them.
+ */
+template <uint8_t width,
+          uint32_t polynomial,
+          bool reflected,
+          size_t slices,
+          typename Sequence = typename MakeIndexSequence<slices * 256>::Type>
+struct CrcTable;
+
+template <uint8_t width, uint32_t polynomial, bool reflected, size_t slices, size_t... I>
+struct CrcTable<width, polynomial, reflected, slices, IndexSequence<I...>>
+{
+    typedef typename CrcValue<width>::Type ValueType;
+
+    static constexpr ValueType values[sizeof...(I)] = {static_cast<ValueType>(
+            crcTableEntry(I / 256, I % 256, width, polynomial, reflected))...};
+};
+
+template <uint8_t width, uint32_t polynomial, bool reflected, size_t slices, size_t... I>
+constexpr typename CrcValue<width>::Type
+        CrcTable<width, polynomial, reflected, slices, IndexSequence<I...>>::values
+                [sizeof...(I)];
+
+/**
+ * Hardware implementation of a CRC, not available by default.
+ */
+template <uint8_t width, uint32_t polynomial, bool reflected>
+struct CrcHardware
+{
+    static constexpr bool available = false;
+
+    static inline uint32_t
+    update(uint32_t crc, const uint8_t* /*data*/, size_t /*length*/)
+    {
+        return crc;
+    }
+};
+}  // namespace internal
+
+/**
+ * Table driven CRC calculation for arbitrary polynomials.
+ *
+ * The parameters follow the Rocksoft model of Ross N. Williams [1], which
+ * is also used by the CRC catalogue [2]. The lookup tables are generated
+ * at compile time.
+ *
+ * Blocks of data are processed with the slice-by-N algorithm [3], which
+ * uses N tables of 256 entries and handles N bytes per iteration. A
+ * larger N trades memory for speed, e.g. CRC-32 with slice-by-8 requires
+ * 8 KiB of tables. Where the target provides instructions for a
+ * polynomial (ARMv8 CRC32 for CRC-32 and CRC-32C, SSE4.2 for CRC-32C)
+ * these are used for blocks instead of the tables.
+ *
+ * [1] http://www.ross.net/crc/download/crc_v3.txt
+ * [2] https://reveng.sourceforge.io/crc-catalogue/
+ * [3] M. E. Kounavis and F. L. Berry, "A Systematic Approach to Building
+ *     High Performance Software-Based CRC Generators", ISCC 2005
+ *
+ * \tparam width
+ *      Width of the CRC in bits: 8, 16 or 32
+ * \tparam polynomial
+ *      Generator polynomial in normal (MSB first) notation, without the
+ *      leading x^width term
+ * \tparam initialValue
+ *      Initial value of the CRC register
+ * \tparam reflectInput
+ *      Process the bits of every byte LSB first
+ * \tparam reflectOutput
+ *      Reflect the CRC register before the final XOR
+ * \tparam finalXor
+ *      Value XORed to the result
+ * \tparam slices
+ *      Number of bytes processed per iteration by update(Slice), 1 to 8
+ *
+ * \ingroup crc
+ */
+template <uint8_t width,
+          uint32_t polynomial,
+          uint32_t initialValue,
+          bool reflectInput,
+          bool reflectOutput,
+          uint32_t finalXor,
+          size_t slices = 1>
+class CrcEngine
+{
+    static_assert(width == 8 || width == 16 || width == 32, "Unsupported CRC width");
+    static_assert(slices >= 1 && slices <= 8, "Unsupported number of slices");
+    static_assert((polynomial & ~internal::crcMask(width)) == 0, "Polynomial exceeds the width");
+
+public:
+    typedef typename internal::CrcValue<width>::Type ValueType;
+
+    inline CrcEngine() : mCrc(initialRegister)
+    {
+    }
+
+    inline ~CrcEngine()
+    {
+    }
+
+    /**
+     * Calculate CRC from a block of data.
+     *
+     * \param data
+     *     block of data
+     *
+     * \retval crc
+     *     calculated checksum
+     */
+    static ValueType
+    calculate(outpost::Slice<const uint8_t> data);
+
+    /**
+     * Copy a block of data and calculate its CRC in the same pass.
+     *
+     * Avoids reading the data a second time when it has to be copied
+     * anyway, e.g. into a transmit buffer.
+     *
+     * \param data
+     *     Data to copy and to calculate the checksum of.
+     * \param destination
+     *     Start of the destination, must provide space for
+     *     data.getNumberOfElements() bytes and must not overlap with data.
+     *
+     * \retval crc
+     *     calculated checksum
+     */
+    static ValueType
+    calculateAndCopy(outpost::Slice<const uint8_t> data, uint8_t* destination);
+
+    /**
+     * Checksum of two consecutive blocks from the checksums of the blocks.
+     *
+     * Allows splitting a large block, e.g. a software image, into parts
+     * whose checksums are calculated in parallel by several threads and
+     * merged afterwards:
+     *
+     * \code
+     * crc = Crc32Reversed::combine(crcOfFirstPart, crcOfSecondPart, lengthOfSecondPart);
+     * \endcode
+     *
+     * The data itself is not needed. The CRC register is multiplied with
+     * x^(8 * lengthB) modulo the polynomial, the power is calculated by
+     * repeated squaring. The effort therefore grows with log2(lengthB).
+     *
+     * \param crcA
+     *     Checksum of the first block, as returned by calculate()
+     * \param crcB
+     *     Checksum of the second block
+     * \param lengthB
+     *     Length of the second block in bytes
+     *
+     * \retval crc
+     *     checksum of the first block followed by the second block
+     */
+    static ValueType
+    combine(ValueType crcA, ValueType crcB, size_t lengthB);
+
+    /**
+     * Reset CRC calculation
+     */
+    inline void
+    reset()
+    {
+        mCrc = initialRegister;
+    }
+
+    /**
+     * CRC update.
+     *
+     * \param data
+     *     byte
+     */
+    inline void
+    update(uint8_t data)
+    {
+        mCrc = static_cast<ValueType>(updateByte(mCrc, data));
+    }
+
+    /**
+     * CRC update with a block of data.
+     *
+     * Gives the same result as calling update(uint8_t) for every byte,
+     * the data may be split at arbitrary positions.
+     *
+     * \param data
+     *     block of data
+     */
+    void
+    update(outpost::Slice<const uint8_t> data);
+
+    /**
+     * Get result of CRC calculation.
+     */
+    inline ValueType
+    getValue() const
+    {
+        return static_cast<ValueType>(
+                ((reflectInput != reflectOutput) ? internal::crcReflect(mCrc, width) : mCrc)
+                ^ finalXor);
+    }
+
+private:
+    // disable copy constructor
+    CrcEngine(const CrcEngine&);
+
+    // disable copy-assignment operator
+    CrcEngine&
+    operator=(const CrcEngine&);
+
+    static constexpr uint32_t registerPolynomial =
+            reflectInput ? internal::crcReflect(polynomial, width) : polynomial;
+    static constexpr ValueType initialRegister = static_cast<ValueType>(
+            reflectInput ? internal::crcReflect(initialValue, width) : initialValue);
+
+    /// Polynomial x^0 in the bit order of the register
+    static constexpr uint32_t registerOne =
+            reflectInput ? (static_cast<uint32_t>(1) << (width - 1)) : 1;
+
+    typedef internal::CrcTable<width, registerPolynomial, reflectInput, slices> Table;
+    typedef internal::CrcHardware<width, polynomial, reflectInput> Hardware;
+
+    static inline uint32_t
+    updateByte(uint32_t crc, uint8_t data);
+
+    /**
+     * Processes `slices` bytes.
+     */
+    static inline uint32_t
+    updateBlock(uint32_t crc, const uint8_t* data);
+
+    /**
+     * Product of two polynomials in the bit order of the register, modulo
+     * the polynomial of the CRC.
+     */
+    static uint32_t
+    multiplyModulo(uint32_t a, uint32_t b);
+
+    ValueType mCrc;
+};
+}  // namespace outpost
+
+#include "crc_engine_impl.h"
+
+#endif
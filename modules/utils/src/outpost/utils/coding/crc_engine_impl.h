@@ -0,0 +1,421 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_CODING_CRC_ENGINE_IMPL_H
+#define OUTPOST_UTILS_CODING_CRC_ENGINE_IMPL_H
+
+#include "crc_engine.h"
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#elif defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+namespace outpost
+{
+namespace internal
+{
+/// Bytes are assembled individually, the data may be unaligned and the byte order is irrelevant
+static inline uint32_t
+crcReadLittleEndian32(const uint8_t* data)
+{
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8)
+           | (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+#if defined(__ARM_FEATURE_CRC32)
+/// CRC-32 (IEEE 802.3) with the ARMv8 CRC32 instructions
+template <>
+struct CrcHardware<32, 0x04C11DB7, true>
+{
+    static constexpr bool available = true;
+
+    static inline uint32_t
+    update(uint32_t crc, const uint8_t* data, size_t length)
+    {
+        for (; length >= 4; length -= 4, data += 4)
+        {
+            crc = __crc32w(crc, crcReadLittleEndian32(data));
+        }
+        for (; length > 0; length--, data++)
+        {
+            crc = __crc32b(crc, *data);
+        }
+        return crc;
+    }
+};
+
+/// CRC-32C (Castagnoli) with the ARMv8 CRC32 instructions
+template <>
+struct CrcHardware<32, 0x1EDC6F41, true>
+{
+    static constexpr bool available = true;
+
+    static inline uint32_t
+    update(uint32_t crc, const uint8_t* data, size_t length)
+    {
+        for (; length >= 4; length -= 4, data += 4)
+        {
+            crc = __crc32cw(crc, crcReadLittleEndian32(data));
+        }
+        for (; length > 0; length--, data++)
+        {
+            crc = __crc32cb(crc, *data);
+        }
+        return crc;
+    }
+};
+#elif defined(__SSE4_2__)
+/// CRC-32C (Castagnoli) with the SSE4.2 crc32 instruction
+template <>
+struct CrcHardware<32, 0x1EDC6F41, true>
+{
+    static constexpr bool available = true;
+
+    static inline uint32_t
+    update(uint32_t crc, const uint8_t* data, size_t length)
+    {
+        for (; length >= 4; length -= 4, data += 4)
+        {
+            crc = _mm_crc32_u32(crc, crcReadLittleEndian32(data));
+        }
+        for (; length > 0; length--, data++)
+        {
+            crc = _mm_crc32_u8(crc, *data);
+        }
+        return crc;
+    }
+};
+#endif
+
+/// Shifts which are valid for every CRC width, counts of 32 and above yield zero
+static inline uint32_t
+crcShiftRight(uint32_t value, size_t bits)
+{
+    return (bits >= 32) ? 0 : (value >> bits);
+}
+
+static inline uint32_t
+crcShiftLeft(uint32_t value, size_t bits)
+{
+    return (bits >= 32) ? 0 : (value << bits);
+}
+
+/**
+ * Table lookups of one slice-by-N block, unrolled by recursion.
+ *
+ * The bytes of the CRC register are combined with the first bytes of the
+ * block, after that the lookups of all bytes are independent of each
+ * other.
+ */
+template <typename ValueType,
+          uint8_t width,
+          bool reflected,
+          size_t slices,
+          size_t index = 0,
+          bool done = (index == slices)>
+struct CrcSliceLookup
+{
+    static inline uint32_t
+    apply(const ValueType* table, uint32_t crc, const uint8_t* data)
+    {
+        uint32_t byte = data[index];
+        if (index < width / 8U)
+        {
+            byte ^= (reflected ? crcShiftRight(crc, 8 * index)
+                               : crcShiftRight(crc, width - 8 * (index + 1)))
+                    & 0xFF;
+        }
+        return table[256 * (slices - 1 - index) + byte]
+               ^ CrcSliceLookup<ValueType, width, reflected, slices, index + 1>::apply(
+                       table, crc, data);
+    }
+};
+
+template <typename ValueType, uint8_t width, bool reflected, size_t slices, size_t index>
+struct CrcSliceLookup<ValueType, width, reflected, slices, index, true>
+{
+    static inline uint32_t
+    apply(const ValueType* /*table*/, uint32_t /*crc*/, const uint8_t* /*data*/)
+    {
+        return 0;
+    }
+};
+}  // namespace internal
+
+template <uint8_t width,
+          uint32_t polynomial,
+          uint32_t initialValue,
+          bool reflectInput,
+          bool reflectOutput,
+          uint32_t finalXor,
+          size_t slices>
+constexpr uint32_t CrcEngine<width,
+                             polynomial,
+                             initialValue,
+                             reflectInput,
+                             reflectOutput,
+                             finalXor,
+                             slices>::registerPolynomial;
+
+template <uint8_t width,
+          uint32_t polynomial,
+          uint32_t initialValue,
+          bool reflectInput,
+          bool reflectOutput,
+          uint32_t finalXor,
+          size_t slices>
+constexpr typename CrcEngine<width,
+                             polynomial,
+                             initialValue,
+                             reflectInput,
+                             reflectOutput,
+                             finalXor,
+                             slices>::ValueType
+        CrcEngine<width, polynomial, initialValue, reflectInput, reflectOutput, finalXor, slices>::
+                initialRegister;
+
+template <uint8_t width,
+          uint32_t polynomial,
+          uint32_t initialValue,
+          bool reflectInput,
+          bool reflectOutput,
+          uint32_t finalXor,
+          size_t slices>
+constexpr uint32_t
+        CrcEngine<width, polynomial, initialValue, reflectInput, reflectOutput, finalXor, slices>::
+                registerOne;
+
+template <uint8_t width,
+          uint32_t polynomial,
+          uint32_t initialValue,
+          bool reflectInput,
+          bool reflectOutput,
+          uint32_t finalXor,
+          size_t slices>
+inline uint32_t
+CrcEngine<width, polynomial, initialValue, reflectInput, reflectOutput, finalXor, slices>::
+        updateByte(uint32_t crc, uint8_t data)
+{
+    if (reflectInput)
+    {
+        return internal::crcShiftRight(crc, 8) ^ Table::values[(crc ^ data) & 0xFF];
+    }
+    else
+    {
+        return (internal::crcShiftLeft(crc, 8) & internal::crcMask(width))
+               ^ Table::values[((crc >> (width - 8)) ^ data) & 0xFF];
+    }
+}
+
+template <uint8_t width,
+          uint32_t polynomial,
+          uint32_t initialValue,
+          bool reflectInput,
+          bool reflectOutput,
+          uint32_t finalXor,
+          size_t slices>
+inline uint32_t
+CrcEngine<width, polynomial, initialValue, reflectInput, reflectOutput, finalXor, slices>::
+        updateBlock(uint32_t crc, const uint8_t* data)
+{
+    // Bytes of the register which are not covered by the block remain in the register
+    uint32_t remaining = reflectInput
+                                 ? internal::crcShiftRight(crc, 8 * slices)
+                                 : (internal::crcShiftLeft(crc, 8 * slices)
+                                    & internal::crcMask(width));
+    return remaining
+           ^ internal::CrcSliceLookup<ValueType, width, reflectInput, slices>::apply(
+                   Table::values, crc, data);
+}
+
+template <uint8_t width,
+          uint32_t polynomial,
+          uint32_t initialValue,
+          bool reflectInput,
+          bool reflectOutput,
+          uint32_t finalXor,
+          size_t slices>
+void
+CrcEngine<width, polynomial, initialValue, reflectInput, reflectOutput, finalXor, slices>::update(
+        outpost::Slice<const uint8_t> data)
+{
+    const uint8_t* it = data.begin();
+    size_t remaining = data.getNumberOfElements();
+    uint32_t crc = mCrc;
+
+    if (Hardware::available)
+    {
+        mCrc = static_cast<ValueType>(Hardware::update(crc, it, remaining));
+        return;
+    }
+
+    while (remaining >= slices)
+    {
+        crc = updateBlock(crc, it);
+        it += slices;
+        remaining -= slices;
+    }
+
+    while (remaining > 0)
+    {
+        crc = updateByte(crc, *it);
+        it++;
+        remaining--;
+    }
+    mCrc = static_cast<ValueType>(crc);
+}
+
+template <uint8_t width,
+          uint32_t polynomial,
+          uint32_t initialValue,
+          bool reflectInput,
+          bool reflectOutput,
+          uint32_t finalXor,
+          size_t slices>
+typename CrcEngine<width,
+                   polynomial,
+                   initialValue,
+                   reflectInput,
+                   reflectOutput,
+                   finalXor,
+                   slices>::ValueType
+CrcEngine<width, polynomial, initialValue, reflectInput, reflectOutput, finalXor, slices>::
+        calculate(outpost::Slice<const uint8_t> data)
+{
+    CrcEngine generator;
+    generator.update(data);
+
+    ValueType value = generator.getValue();
+    return value;
+}
+
+template <uint8_t width,
+          uint32_t polynomial,
+          uint32_t initialValue,
+          bool reflectInput,
+          bool reflectOutput,
+          uint32_t finalXor,
+          size_t slices>
+typename CrcEngine<width,
+                   polynomial,
+                   initialValue,
+                   reflectInput,
+                   reflectOutput,
+                   finalXor,
+                   slices>::ValueType
+CrcEngine<width, polynomial, initialValue, reflectInput, reflectOutput, finalXor, slices>::
+        calculateAndCopy(outpost::Slice<const uint8_t> data, uint8_t* destination)
+{
+    const uint8_t* it = data.begin();
+    size_t remaining = data.getNumberOfElements();
+
+    CrcEngine generator;
+    uint32_t crc = generator.mCrc;
+    while (remaining >= slices)
+    {
+        for (size_t i = 0; i < slices; i++)
+        {
+            destination[i] = it[i];
+        }
+        crc = updateBlock(crc, it);
+        it += slices;
+        destination += slices;
+        remaining -= slices;
+    }
+
+    while (remaining > 0)
+    {
+        const uint8_t value = *it++;
+        *destination++ = value;
+        crc = updateByte(crc, value);
+        remaining--;
+    }
+    generator.mCrc = static_cast<ValueType>(crc);
+
+    ValueType value = generator.getValue();
+    return value;
+}
+
+template <uint8_t width,
+          uint32_t polynomial,
+          uint32_t initialValue,
+          bool reflectInput,
+          bool reflectOutput,
+          uint32_t finalXor,
+          size_t slices>
+uint32_t
+CrcEngine<width, polynomial, initialValue, reflectInput, reflectOutput, finalXor, slices>::
+        multiplyModulo(uint32_t a, uint32_t b)
+{
+    // Horner scheme over the coefficients of a, starting with x^(width - 1)
+    uint32_t product = 0;
+    for (size_t i = 0; i < width; i++)
+    {
+        product = internal::crcShiftBits(product, 1, width, registerPolynomial, reflectInput);
+        const uint32_t coefficient = reflectInput ? (static_cast<uint32_t>(1) << i)
+                                                  : (static_cast<uint32_t>(1) << (width - 1 - i));
+        if ((a & coefficient) != 0)
+        {
+            product ^= b;
+        }
+    }
+    return product;
+}
+
+template <uint8_t width,
+          uint32_t polynomial,
+          uint32_t initialValue,
+          bool reflectInput,
+          bool reflectOutput,
+          uint32_t finalXor,
+          size_t slices>
+typename CrcEngine<width,
+                   polynomial,
+                   initialValue,
+                   reflectInput,
+                   reflectOutput,
+                   finalXor,
+                   slices>::ValueType
+CrcEngine<width, polynomial, initialValue, reflectInput, reflectOutput, finalXor, slices>::
+        combine(ValueType crcA, ValueType crcB, size_t lengthB)
+{
+    // x^(8 * lengthB), square and multiply starting with x^8
+    uint32_t shift = registerOne;
+    uint32_t power =
+            internal::crcShiftBits(registerOne, 8, width, registerPolynomial, reflectInput);
+    for (size_t n = lengthB; n != 0; n >>= 1)
+    {
+        if ((n & 1) != 0)
+        {
+            shift = multiplyModulo(shift, power);
+        }
+        power = multiplyModulo(power, power);
+    }
+
+    // The register after both blocks is the register after block B plus the
+    // difference of the register after block A to the initial value, shifted
+    // through block B. This holds because the CRC is linear in the register.
+    const uint32_t registerA = ((reflectInput != reflectOutput)
+                                        ? internal::crcReflect(crcA ^ finalXor, width)
+                                        : (crcA ^ finalXor))
+                               ^ initialRegister;
+    const uint32_t registerB = (reflectInput != reflectOutput)
+                                       ? internal::crcReflect(crcB ^ finalXor, width)
+                                       : (crcB ^ finalXor);
+    const uint32_t crc = multiplyModulo(registerA, shift) ^ registerB;
+    return static_cast<ValueType>(
+            ((reflectInput != reflectOutput) ? internal::crcReflect(crc, width) : crc) ^ finalXor);
+}
+
+}  // namespace outpost
+
+#endif
@@ -53,6 +53,12 @@ public:
     decode(const outpost::Slice<const uint8_t>& coded_data,
            const outpost::Slice<uint8_t>& dst_data) override;
 
+    DecodeStatus
+    decodeSectors(const outpost::Slice<const uint8_t>& coded_data,
+                  const outpost::Slice<uint8_t>& dst_data,
+                  uint32_t firstSector,
+                  uint32_t numberOfSectors) override;
+
     inline uint32_t
     getNumberOfRedundantBytes(void) const override
     {
@@ -65,6 +71,12 @@ public:
         return mNandDataSize;
     }
 
+    inline uint32_t
+    getNumberOfSparebytes(void) const override
+    {
+        return mNandSpareSize;
+    }
+
     inline bool
     isTemplateParameterValid(void) const override
     {
@@ -81,6 +93,7 @@ private:
     struct QuadCompTable;
     struct Polynom;
     struct EncodeTable;
+    struct SyndromeTable;
 
     static constexpr ALogTable
     buildALogTable(void);
@@ -121,6 +134,9 @@ private:
     static constexpr EncodeTable
     generateEncodeTables(void);
 
+    static constexpr SyndromeTable
+    generateSyndromeTables(void);
+
     static constexpr void
     convertGenPolyBitToWord(Polynom& poly, const uint32_t* genPolyBitArray);
 
@@ -156,6 +172,8 @@ private:
     static constexpr QuadCompTable mQuadCompTable = genQuadCompTable();
 
     static constexpr uint32_t BYTESTATES = 256;
+    // Number of data bytes processed per step when computing the remainder
+    static constexpr uint32_t SLICES = 4;
 
     static constexpr uint32_t ZERO_DIV_RETURN_VALUE = 1;
 
@@ -167,8 +185,11 @@ private:
     constexpr void
     bchEncode(void);
 
+    constexpr void
+    updateRemainder(uint32_t SR[], const uint8_t* data);
+
     constexpr int32_t
-    computeRemainder(void);
+    computeRemainder(const uint8_t* data, const uint8_t* redundancy);
 
     constexpr void
     computeSyndromes(void);
@@ -269,10 +290,14 @@ private:
                                                            ? (mNumRedundantBytes / 4) + 1
                                                            : (mNumRedundantBytes / 4);
 
+    /**
+     * Entry (z * BYTESTATES + i) is the shift register after processing
+     * byte i followed by z zero bytes.
+     */
     struct EncodeTable
     {
         constexpr EncodeTable() : encodeTable{} {};
-        uint32_t encodeTable[BYTESTATES * mNumRedundantWords];
+        uint32_t encodeTable[SLICES * BYTESTATES * mNumRedundantWords];
 
         struct Column
         {
@@ -319,6 +344,17 @@ private:
     };
 
     static constexpr EncodeTable encodeTable = generateEncodeTables();
+
+    /**
+     * Contribution of each remainder byte value to the odd syndromes.
+     */
+    struct SyndromeTable
+    {
+        constexpr SyndromeTable() : table{} {};
+        uint16_t table[mTParam][BYTESTATES];
+    };
+
+    static constexpr SyndromeTable syndromeTable = generateSyndromeTables();
 };
 
 }  // namespace utils
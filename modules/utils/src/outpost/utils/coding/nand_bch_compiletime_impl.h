@@ -47,6 +47,10 @@ template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t m
 constexpr typename NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::EncodeTable
         NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::encodeTable;
 
+template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+constexpr typename NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::SyndromeTable
+        NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::syndromeTable;
+
 template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
 constexpr uint32_t NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::mLogZVal;
 
@@ -640,9 +644,77 @@ NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::generateEncodeTab
         }
     }
 
+    // Tables for processing several bytes at once: The byte followed by
+    // zero bytes, i.e. one more byte shift of the previous table entry.
+    for (uint32_t z = 1; z < SLICES; z++)
+    {
+        for (uint32_t i = 0; i < BYTESTATES; i++)
+        {
+            uint32_t previous = (z - 1) * BYTESTATES + i;
+            uint32_t fdbk = ret[previous][0] >> 24;
+            for (uint32_t k = 0; k < mNumRedundantWords; k++)
+            {
+                uint32_t next = (k + 1 < mNumRedundantWords) ? (ret[previous][k + 1] >> 24) : 0;
+                ret[z * BYTESTATES + i][k] = (ret[previous][k] << 8) ^ next ^ ret[fdbk][k];
+            }
+        }
+    }
+
+    return ret;
+}
+
+template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+constexpr typename NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::SyndromeTable
+NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::generateSyndromeTables(void)
+{
+    SyndromeTable ret;
+
+    // Odd syndrome S(2k+1) receives alpha^((2k+1)j) for every set bit j of a remainder byte
+    for (uint32_t k = 0; k < mTParam; k++)
+    {
+        for (uint32_t i = 0; i < BYTESTATES; i++)
+        {
+            uint16_t value = 0;
+            for (uint32_t j = 0; j < 8; j++)
+            {
+                if (i & (1 << j))
+                {
+                    value ^= aLogTable[((2 * k + 1) * j) % mNParam];
+                }
+            }
+            ret.table[k][i] = value;
+        }
+    }
+
     return ret;
 }
 
+template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+constexpr void
+NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::updateRemainder(
+        uint32_t SR[], const uint8_t* data)
+{
+    // Equivalent to shifting the register byte by byte with the first
+    // encode table, but the feedback of SLICES bytes is looked up at once.
+    // The data length is a multiple of SLICES.
+    for (uint32_t addr = 0; addr < mNumDataBytes; addr += SLICES)
+    {
+        uint32_t fdbk = SR[0]
+                        ^ ((static_cast<uint32_t>(data[addr]) << 24)
+                           | (static_cast<uint32_t>(data[addr + 1]) << 16)
+                           | (static_cast<uint32_t>(data[addr + 2]) << 8) | data[addr + 3]);
+        const uint32_t* t3 = encodeTable[3 * BYTESTATES + (fdbk >> 24)].p;
+        const uint32_t* t2 = encodeTable[2 * BYTESTATES + ((fdbk >> 16) & 0xff)].p;
+        const uint32_t* t1 = encodeTable[BYTESTATES + ((fdbk >> 8) & 0xff)].p;
+        const uint32_t* t0 = encodeTable[fdbk & 0xff].p;
+        for (uint32_t k = 0; k < mNumRedundantWords; k++)
+        {
+            uint32_t next = (k + 1 < mNumRedundantWords) ? SR[k + 1] : 0;
+            SR[k] = next ^ t3[k] ^ t2[k] ^ t1[k] ^ t0[k];
+        }
+    }
+}
+
 template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
 constexpr void
 NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::bchEncode(void)
@@ -670,28 +742,13 @@ NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::bchEncode(void)
     //  from a paper by Hsiao and Sih titled "Serial-to-Parrallel Transformation
     //  of Linear-Feedback Shift-Register Circuits" which appeared in
     //  IEEE. Trans. on Elec. Comp., 738-740 (Dec. 1964).
+    //
+    //  The shift register is advanced by four bytes at once with one table
+    //  per byte position, see updateRemainder.
     //****************************************************************
     uint32_t SR[mNumRedundantWords] = {};
 
-    for (uint16_t writeCWAddr = 0; writeCWAddr < mNumDataBytes; writeCWAddr++)
-    {  // index to write data buffer
-        uint32_t fdbk = 0;
-        for (int32_t i = mNumRedundantWords - 1; i >= 0; i--)
-        {
-            // IT IS POSSIBLE TO UNROLL THIS LOOP USING A SWITCH STATEMENT.
-            // WILL HAVE TO PROCESS FROM HIGH ADDRESS BACK TOWARDS ZERO
-            uint32_t fdbkSav = fdbk;
-            // 32 bits per int32_t - but process 8 bits at a time (8 bits unrelated to "m")
-            fdbk = (SR[i] >> 24) & 0x000000ff;
-            SR[i] = (SR[i] << 8) ^ fdbkSav;  // 8 # bits in parallel - unrelated to "m"
-        }
-        fdbk ^= mCodeWord[writeCWAddr];
-        // IT IS POSSIBLE TO UNROLL THIS LOOP USING A SWITCH STATEMENT
-        for (uint32_t kx = 0; kx < mNumRedundantWords; kx++)
-        {
-            SR[kx] ^= encodeTable[fdbk][kx];
-        }
-    }
+    updateRemainder(SR, mCodeWord);
 
     // +5 So that we can temporarily keep remainder bytes in whole words
     int32_t redunByteArray[(mTParam * mMParam) / 8 + 5];
@@ -713,7 +770,8 @@ NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::bchEncode(void)
 
 template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
 constexpr int32_t
-NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::computeRemainder(void)
+NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::computeRemainder(
+        const uint8_t* data, const uint8_t* redundancy)
 {
     //****************************************************************
     //  Function: computeRemainder
@@ -750,36 +808,21 @@ NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::computeRemainder(
     //  from a paper by Hsiao and Sih titled "Serial-to-Parrallel Transformation
     //  of Linear-Feedback Shift-Register Circuits" which appeared in
     //  IEEE. Trans. on Elec. Comp., 738-740 (Dec. 1964).
+    //
+    //  The data is read directly from the given buffers so that an error
+    //  free code word does not have to be copied.
     //****************************************************************
     uint32_t SR[mNumRedundantWords] = {};
 
     // SHIFTS WITH FEEDBACK
-    for (uint32_t readCWAddr = 0; readCWAddr < mNumDataBytes; readCWAddr++)
-    {  // index to write data buffer
-        uint32_t fdbk = 0;
-        for (int32_t nnn = mNumRedundantWords - 1; nnn >= 0; nnn--)
-        {
-            // IT IS POSSIBLE TO UNROLL THIS LOOP USING A SWITCH STATEMENT.
-            // WILL HAVE TO PROCESS FROM HIGH ADDRESS BACK TOWARDS ZERO
-            uint32_t fdbkSav = fdbk;
-            fdbk = (SR[nnn] >> 24);              // 32 - # bits in word (unrelated to "m")
-            SR[nnn] = (SR[nnn] << 8) ^ fdbkSav;  // 8 # bits in parallel - unrelated to "m"
-        }
-        fdbk ^= mCodeWord[readCWAddr];
-        for (uint32_t k = 0; k < mNumRedundantWords; k++)
-        {
-            // IT IS POSSIBLE TO UNROLL THIS LOOP
-            SR[k] ^= encodeTable[fdbk][k];
-        }
-    }
+    updateRemainder(SR, data);
     // SHIFTS WITHOUT FEEDBACK
     // Line below - This flag will be set later if the remainder is non zero.
     // Non-zero means either corr or uncorr err.  We will know which after decoding.
     int32_t remainderDetdErr = 0;
 
     // index to code word buffer
-    for (uint32_t readCWAddr = mNumDataBytes; readCWAddr < mNumDataBytes + mNumRedundantBytes;
-         readCWAddr++)
+    for (uint32_t readCWAddr = 0; readCWAddr < mNumRedundantBytes; readCWAddr++)
     {
         uint32_t fdbk = 0;
         for (int32_t nnn = mNumRedundantWords - 1; nnn >= 0; nnn--)
@@ -788,8 +831,8 @@ NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::computeRemainder(
             fdbk = (SR[nnn] >> 24);              // 32 - # bits in parallel (unrelated to "m")
             SR[nnn] = (SR[nnn] << 8) ^ fdbkSav;  // 8 # bits in parallel - unrelated to "m"
         }
-        fdbk ^= mCodeWord[readCWAddr];
-        mRemainderBytes[readCWAddr - mNumDataBytes] = static_cast<int32_t>(fdbk);
+        fdbk ^= redundancy[readCWAddr];
+        mRemainderBytes[readCWAddr] = static_cast<int32_t>(fdbk);
         if (fdbk != 0)
         {
             remainderDetdErr = 1;
@@ -821,33 +864,27 @@ NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::computeSyndromes(
     //  a remainder is page 160 of the Glover-Dudley 1991 book
     //  "Practical Error Correction Design for Engineers"
     //  REVISED SECOND EDITION.
+    //
+    //  The contribution of every remainder byte value is taken from a
+    //  table instead of processing the remainder bit by bit.
     //****************************************************************
 
-    // Clear syndromes array
-    outpost::asSlice(mSyndromes).fill(0);
-
-    for (uint32_t i = 0; i < mNumRedundantBytes; i++)
+    // The odd syndromes are evaluated byte wise with Horner's scheme, each
+    // byte of the remainder shifts the previous value by alpha^(8(2k+1)).
+    for (uint32_t k = 0; k < mTParam; k++)
     {
-        uint8_t mask = 0x01;
-        for (uint32_t j = 0; j < 8; j++)
+        uint32_t shift = (8 * (2 * k + 1)) % mNParam;
+        uint32_t value = 0;
+        for (uint32_t i = 0; i < mNumRedundantBytes; i++)
         {
-            uint8_t data = mRemainderBytes[i] & mask;
-            if (data > 0)
+            if (value > 0)
             {
-                // 9-10-10 Changed for speed
-                uint32_t accumVal = (((mNumRedundantBytes - 1) - i) * 8 + j);  // Initialize
-                uint32_t bumpVal = 2 * accumVal;                               // Initialize
-                // Note increment by 2
-                for (uint32_t k = 0; k < numSyndromes; k += 2)
-                {
-                    //  "+1" is for syndrome offset
-                    mSyndromes[k] ^= aLogTable[accumVal];
-                    accumVal += bumpVal;  // Add 2*preComputeVal
-                    accumVal = accumVal % mNParam;
-                }
+                // The alog table has twice the field size, no modulo needed
+                value = aLogTable[logTable[value] + shift];
             }
-            mask *= 2;
+            value ^= syndromeTable.table[k][mRemainderBytes[i]];
         }
+        mSyndromes[2 * k] = value;
     }
     // Compute even syndromes from the odd syndromes
     for (uint32_t k = 0; k < numSyndromes; k += 2)
@@ -1487,7 +1524,6 @@ NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::bchDecode(void)
     //  Function: bchDecode
     //
     //  This function performs decoding by calling -
-    //  - a function to compute a remainder
     //  - a function to compute obj->mSyndromes from the remainder
     //  - a Berlekamp-Massey function to compute an error
     //    locator polynomial
@@ -1498,44 +1534,33 @@ NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::bchDecode(void)
     //  this function then you may want to remove the test code after
     //  testing is complete.  All such code is commented "For testing only"
     //
-    //  Array addresses for syndrome symbols and remainder bytes are passed
-    //  to this function but on entry to this function these arrays do not
-    //  contain useful data.
+    //  The remainder is computed by the caller, this function is only
+    //  called with the code word in mCodeWord if the remainder is not
+    //  zero, i.e. the code word contains errors.
     //****************************************************************
     int32_t sigmaN[mTParam + 1];
     bool success = true;
-    DecodeStatus status = DecodeStatus::noError;
+    DecodeStatus status = DecodeStatus::corrected;
 
     outpost::asSlice(mLoc).fill(mLogZVal);
 
-    int32_t remainderDetdErr = computeRemainder();
+    computeSyndromes();
 
-    // If remainderDetdErr is not 0, CW is not err free - could be corr or uncorr
-    if (remainderDetdErr != 0)
-    {
-        // GET HERE IF REMAINDER INDICATES AN ERROR (NON-ZERO REMAINDER)
-        status = DecodeStatus::corrected;
-        computeSyndromes();
+    //  Compute coeff's of ELP using Berlekamp/Massey
+    uint32_t Ln = berMas(sigmaN, success);
 
-        //  Compute coeff's of ELP using Berlekamp/Massey
-        uint32_t Ln = berMas(sigmaN, success);
+    if (success)
+    {
+        //  Find the roots of the ELP
+        success &= rootFindChien(sigmaN, Ln);
 
         if (success)
         {
-            //  Find the roots of the ELP
-            success &= rootFindChien(sigmaN, Ln);
-
-            if (success)
-            {
-                //  Fix the errors in the data buffer
-                success &= fixErrors(Ln);
-            }
+            //  Fix the errors in the data buffer
+            success &= fixErrors(Ln);
         }
     }
-    else
-    {
-        outpost::asSlice(mSyndromes).fill(0);
-    }
+
     if (!success)
     {
         status = DecodeStatus::uncorrectable;
@@ -1567,7 +1592,7 @@ NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::encode(
             // all data fits
             memcpy(mCodeWord, &src_data[i * mNumDataBytes], mNumDataBytes);
         }
-        else if ((i * mNumDataBytes) <= src_data.getNumberOfElements())
+        else if (src_data.getNumberOfElements() <= (i * mNumDataBytes))
         {
             // fill up all remaining data
             outpost::asSlice(mCodeWord).first(mNumDataBytes).fill(NandBCHInterface::fillValue);
@@ -1600,6 +1625,17 @@ template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t m
 DecodeStatus
 NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::decode(
         const outpost::Slice<const uint8_t>& coded_data, const outpost::Slice<uint8_t>& dest_data)
+{
+    return decodeSectors(coded_data, dest_data, 0, mNandDataSize / mNumDataBytes);
+}
+
+template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+DecodeStatus
+NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::decodeSectors(
+        const outpost::Slice<const uint8_t>& coded_data,
+        const outpost::Slice<uint8_t>& dest_data,
+        uint32_t firstSector,
+        uint32_t numberOfSectors)
 {
     if (coded_data.getNumberOfElements() < mNandDataSize + mNandSpareSize)
     {
@@ -1607,27 +1643,38 @@ NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::decode(
         return DecodeStatus::invalidParameters;
     }
 
-    DecodeStatus status = DecodeStatus::noError;
-
     uint32_t iteration_count = (mNandDataSize * 8) / mNumDataBits;
+    if (firstSector > iteration_count || numberOfSectors > iteration_count - firstSector)
+    {
+        return DecodeStatus::invalidParameters;
+    }
+
+    DecodeStatus status = DecodeStatus::noError;
 
     /* Convert k size information in bits format */
-    for (uint32_t i = 0; i < iteration_count; i++)
+    for (uint32_t i = firstSector; i < firstSector + numberOfSectors; i++)
     {
         /* Retrieving data incrementally from beginning and checksum at the end */
-        memcpy(mCodeWord, &coded_data[i * mNumDataBytes], mNumDataBytes);
-        memcpy(&mCodeWord[mNumDataBytes],
-               &coded_data[i * (mNumRedundantBytes) + mNandDataSize],
-               (mNumRedundantBytes));
+        const uint8_t* data = &coded_data[i * mNumDataBytes];
+        const uint8_t* redundancy = &coded_data[i * (mNumRedundantBytes) + mNandDataSize];
 
-        /* Perform decoding */
-        status = combine(status, bchDecode());
+        // Error free code words are copied directly to the destination
+        const uint8_t* result = data;
+        if (computeRemainder(data, redundancy) != 0)
+        {
+            memcpy(mCodeWord, data, mNumDataBytes);
+            memcpy(&mCodeWord[mNumDataBytes], redundancy, (mNumRedundantBytes));
+
+            /* Perform decoding */
+            status = combine(status, bchDecode());
+            result = mCodeWord;
+        }
 
         // Copy anyways, we tell them whether it is correct or not
         if (dest_data.getNumberOfElements() >= ((i + 1) * mNumDataBytes))
         {
             // all data fitting
-            memcpy(&dest_data[0] + (i * mNumDataBytes), mCodeWord, mNumDataBytes);
+            memcpy(&dest_data[0] + (i * mNumDataBytes), result, mNumDataBytes);
         }
         else if (dest_data.getNumberOfElements() <= (i * mNumDataBytes))
         {
@@ -1637,7 +1684,7 @@ NandBCHCTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::decode(
         {
             // partial
             uint32_t sizeRemaining = dest_data.getNumberOfElements() - (i * mNumDataBytes);
-            memcpy(&dest_data[0] + (i * mNumDataBytes), mCodeWord, sizeRemaining);
+            memcpy(&dest_data[0] + (i * mNumDataBytes), result, sizeRemaining);
         }
     }
     return status;
@@ -43,10 +43,56 @@ combine(DecodeStatus a, DecodeStatus b)
     }
 }
 
+bool
+NandBCHInterface::encodePages(const outpost::Slice<const uint8_t>& src_data,
+                              const outpost::Slice<uint8_t>& coded_data,
+                              uint32_t numberOfPages)
+{
+    const size_t dataSize = getNumberOfDatabytes();
+    const size_t pageSize = dataSize + getNumberOfSparebytes();
+    if (coded_data.getNumberOfElements() < numberOfPages * pageSize)
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < numberOfPages; i++)
+    {
+        if (!encode(src_data.skipFirst(i * dataSize).first(dataSize),
+                    coded_data.subSlice(i * pageSize, pageSize)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+DecodeStatus
+NandBCHInterface::decodePages(const outpost::Slice<const uint8_t>& coded_data,
+                              const outpost::Slice<uint8_t>& dst_data,
+                              uint32_t numberOfPages)
+{
+    const size_t dataSize = getNumberOfDatabytes();
+    const size_t pageSize = dataSize + getNumberOfSparebytes();
+    if (coded_data.getNumberOfElements() < numberOfPages * pageSize)
+    {
+        return DecodeStatus::invalidParameters;
+    }
+
+    DecodeStatus status = DecodeStatus::noError;
+    for (uint32_t i = 0; i < numberOfPages; i++)
+    {
+        status = combine(status,
+                         decode(coded_data.subSlice(i * pageSize, pageSize),
+                                dst_data.skipFirst(i * dataSize).first(dataSize)));
+    }
+    return status;
+}
+
 // default values
 constexpr uint32_t NandBCHInterface::DEF_GALIOS_DIMENISIONS;
 constexpr uint32_t NandBCHInterface::DEF_ERROR_CORRECTION;
 constexpr uint8_t NandBCHInterface::fillValue;
+constexpr uint32_t NandBCHInterface::sectorSize;
 
 }  // namespace utils
 }  // namespace outpost
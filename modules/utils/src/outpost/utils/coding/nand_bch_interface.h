@@ -45,6 +45,8 @@ public:
     static constexpr uint32_t DEF_ERROR_CORRECTION = 8;  // Default error correction power in bits
     static constexpr uint8_t fillValue =
             0x00;  // value to fill up if less data then nand page data size s provided
+    // Number of data bytes protected by a single code word
+    static constexpr uint32_t sectorSize = 512;
 
     NandBCHInterface() = default;
 
@@ -61,12 +63,91 @@ public:
     decode(const outpost::Slice<const uint8_t>& coded_data,
            const outpost::Slice<uint8_t>& src_data) = 0;
 
+    /**
+     * Decode a range of the sectors of a page.
+     *
+     * Sectors are independent of each other, different ranges of the same
+     * page can be decoded concurrently by different instances, e.g. from
+     * several worker threads. Only the data of the given sectors is written
+     * to dst_data.
+     *
+     * \param coded_data
+     *      Complete encoded page as for decode()
+     * \param dst_data
+     *      Decoded data of the complete page, may be shorter as for decode()
+     * \param firstSector
+     *      Index of the first sector to decode
+     * \param numberOfSectors
+     *      Number of sectors to decode
+     *
+     * \return
+     *      Combined status of the decoded sectors, invalidParameters if the
+     *      range exceeds the sectors of the page
+     */
+    virtual DecodeStatus
+    decodeSectors(const outpost::Slice<const uint8_t>& coded_data,
+                  const outpost::Slice<uint8_t>& dst_data,
+                  uint32_t firstSector,
+                  uint32_t numberOfSectors) = 0;
+
+    /**
+     * Encode several consecutive pages.
+     *
+     * \param src_data
+     *      Data of the pages, getNumberOfDatabytes() bytes per page. Missing
+     *      data at the end is filled up with fillValue as for encode().
+     * \param coded_data
+     *      Encoded pages, getNumberOfDatabytes() + getNumberOfSparebytes()
+     *      bytes per page
+     * \param numberOfPages
+     *      Number of pages to encode
+     *
+     * \return
+     *      false if coded_data is too small or the template parameters are invalid
+     */
+    bool
+    encodePages(const outpost::Slice<const uint8_t>& src_data,
+                const outpost::Slice<uint8_t>& coded_data,
+                uint32_t numberOfPages);
+
+    /**
+     * Decode several consecutive pages.
+     *
+     * \param coded_data
+     *      Encoded pages, getNumberOfDatabytes() + getNumberOfSparebytes()
+     *      bytes per page
+     * \param dst_data
+     *      Decoded data, getNumberOfDatabytes() bytes per page. If it is
+     *      shorter the remaining pages are still checked.
+     * \param numberOfPages
+     *      Number of pages to decode
+     *
+     * \return
+     *      Combined status of all pages
+     */
+    DecodeStatus
+    decodePages(const outpost::Slice<const uint8_t>& coded_data,
+                const outpost::Slice<uint8_t>& dst_data,
+                uint32_t numberOfPages);
+
     virtual uint32_t
     getNumberOfRedundantBytes(void) const = 0;
 
     virtual uint32_t
     getNumberOfDatabytes(void) const = 0;
 
+    virtual uint32_t
+    getNumberOfSparebytes(void) const = 0;
+
+    /**
+     * Number of sectors (code words) of a page.
+     */
+    inline uint32_t
+    getNumberOfSectors(void) const
+    {
+        return getNumberOfDatabytes() / sectorSize;
+    }
+
     virtual bool
     isTemplateParameterValid(void) const = 0;
 };
@@ -26,62 +26,54 @@ namespace outpost
 {
 namespace utils
 {
+template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+class NandBCHRTime;
+
 /**
- * Class to encode/decode nand pages with BCH error correction.
- * Warning: Functions not thread-safe add mutexes or us different instances of class.
+ * Finite field and generator polynomial tables of NandBCHRTime.
  *
- * Note: For use different instance  compile time version is suggested as this (with default values)
- *       only requires 704 bytes per instance, compared to this class with 98656 bytes per instance
- *       (for default values)
+ * The tables only depend on the field and the number of correctable errors
+ * and are not modified after construction. A single instance can therefore
+ * be shared by all NandBCHRTime instances with the same parameters, also when
+ * they are used concurrently from different threads. With the default values
+ * the tables require 71 KiB.
  */
-template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
-class NandBCHRTime : public NandBCHInterface
+template <uint32_t mMParam, uint32_t mTParam>
+class NandBCHRTimeTables
 {
-    static constexpr uint32_t mNumDataBytes = 512;
-    static constexpr uint32_t mNumDataBits = mNumDataBytes * 8;
-
     static_assert(mTParam >= 4, "Min Supported value for mTParam is 4");
-    static_assert((mNandDataSize % mNumDataBytes) == 0, "mNandDataSize shall be multiple of 512");
     static_assert(mMParam >= 2, "Minimal supported value for mMParam = 2");
     static_assert(mMParam <= 15, "Maximal supported value for mMParam =  15");
 
 public:
-    NandBCHRTime(void);
-
-    bool
-    encode(const outpost::Slice<const uint8_t>& src_data,
-           const outpost::Slice<uint8_t>& coded_data) override;
-
-    DecodeStatus
-    decode(const outpost::Slice<const uint8_t>& coded_data,
-           const outpost::Slice<uint8_t>& dst_data) override;
-
-    inline uint32_t
-    getNumberOfRedundantBytes(void) const override
-    {
-        return mNumRedundantBytes * (mNandDataSize / mNumDataBytes);
-    }
-
-    inline uint32_t
-    getNumberOfDatabytes(void) const override
-    {
-        return mNandDataSize;
-    }
+    NandBCHRTimeTables(void);
 
+    /**
+     * Check whether the tables could be generated for the parameters.
+     */
     inline bool
-    isTemplateParameterValid(void) const override
+    isValid(void) const
     {
         return mValid;
     }
 
-    bool
-    isChecksumEmpty(const outpost::Slice<const uint8_t>& data) override;
-
 private:
+    template <uint32_t, uint32_t, uint32_t, uint32_t>
+    friend class NandBCHRTime;
+
+    // disable copy constructor
+    NandBCHRTimeTables(const NandBCHRTimeTables&);
+
+    // disable copy-assignment operator
+    NandBCHRTimeTables&
+    operator=(const NandBCHRTimeTables&);
+
+    static constexpr uint32_t mNumDataBytes = 512;
     static constexpr uint32_t mFFSize = outpost::PowerOfTwo<mMParam>::value;
     static constexpr uint32_t MAX_REDUN_WORDS = (((mTParam * mMParam) / 8 + 1) / 4 + 1);
     static constexpr uint32_t BYTESTATES = 256;
-    static constexpr uint32_t MAX_NUM_SYM = (2 * mTParam);
+    // Number of data bytes processed per step when computing the remainder
+    static constexpr uint32_t SLICES = 4;
 
     static constexpr uint32_t ZERO_DIV_RETURN_VALUE = 1;
 
@@ -104,36 +96,34 @@ private:
 
     static constexpr uint32_t mFFPoly = fieldPolyTable[mMParam];
 
-    static constexpr uint32_t mMOddParam = mMParam % 2;
     static constexpr uint32_t mNParam = mFFSize - 1;
     static constexpr uint32_t mLogZVal = 2 * mNParam;
 
     uint32_t mNumRedundantBits, mNumRedundantBytes;
-    uint32_t mNumCodeWordBytes, mNumRedundantWords;
-    uint32_t mLoc[mTParam];
-    uint32_t mSyndromes[MAX_NUM_SYM];
+    uint32_t mNumRedundantWords;
     uint32_t mTraceTestVal;
     uint32_t mQuadCompTable[mMParam];
     bool mValid;
-    uint8_t mCodeWord[mNumDataBytes + 4 * MAX_REDUN_WORDS];
-    uint8_t mRemainderBytes[(mTParam * mMParam) / 8 + 1];
 
     uint16_t aLogTable[2 * mFFSize];
     uint16_t logTable[mFFSize];
     uint32_t genPolyBitArray[mTParam * mMParam + 1];
     uint32_t genPolyDegree;
     uint32_t genPolyFdbkWords[((mTParam * mMParam) / 8 + 1) / 4 + 1];
-    uint32_t encodeTable[BYTESTATES][MAX_REDUN_WORDS];
+    // Entry (z * BYTESTATES + i) is the shift register after processing byte i followed by z zeros
+    uint32_t encodeTable[SLICES * BYTESTATES][MAX_REDUN_WORDS];
+    // Contribution of each remainder byte value to the odd syndromes
+    uint16_t syndromeTable[mTParam][BYTESTATES];
     std::bitset<mFFSize> generatedRoots;  // need the place here otherwise blow stack
 
     int32_t
-    ffMult(int32_t a, int32_t b);
+    ffMult(int32_t a, int32_t b) const;
 
     int32_t
-    ffInv(int32_t opa, bool& success);
+    ffInv(int32_t opa, bool& success) const;
 
     int32_t
-    ffDiv(int32_t opa, int32_t opb, bool& success);
+    ffDiv(int32_t opa, int32_t opb, bool& success) const;
 
     void
     buildLogTables(void);
@@ -142,10 +132,10 @@ private:
     checkLogTables(void);
 
     int32_t
-    ffSquareRoot(int32_t opa);
+    ffSquareRoot(int32_t opa) const;
 
     int32_t
-    ffCubeRoot(int32_t opa, bool& success);
+    ffCubeRoot(int32_t opa, bool& success) const;
 
     void
     genTraceTestVal(void);
@@ -154,7 +144,7 @@ private:
     genQuadCompTable(void);
 
     int32_t
-    ffQuadFun(int32_t c);
+    ffQuadFun(int32_t c) const;
 
     void
     bchInit(void);
@@ -168,11 +158,108 @@ private:
     void
     generateEncodeTables(void);
 
+    void
+    generateSyndromeTables(void);
+
+    void
+    updateRemainder(uint32_t SR[], const uint8_t* data) const;
+};
+
+/**
+ * Class to encode/decode nand pages with BCH error correction.
+ * Warning: Functions not thread-safe add mutexes or us different instances of class.
+ *
+ * The tables are provided by a NandBCHRTimeTables object which has to outlive
+ * the instance. An instance only holds the working memory of a single code
+ * word, so several instances sharing one tables object can be used to decode
+ * on multiple threads without duplicating the 71 KiB of tables.
+ *
+ * Note: The compile time version provides the same tables as constant data that can be
+ *       placed in ROM, its instances only require 680 bytes (for default values)
+ */
+template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+class NandBCHRTime : public NandBCHInterface
+{
+    static constexpr uint32_t mNumDataBytes = 512;
+    static constexpr uint32_t mNumDataBits = mNumDataBytes * 8;
+
+    static_assert((mNandDataSize % mNumDataBytes) == 0, "mNandDataSize shall be multiple of 512");
+
+public:
+    typedef NandBCHRTimeTables<mMParam, mTParam> Tables;
+
+    /**
+     * \param tables
+     *      Tables for the parameters, must outlive the instance
+     */
+    explicit NandBCHRTime(const Tables& tables);
+
+    bool
+    encode(const outpost::Slice<const uint8_t>& src_data,
+           const outpost::Slice<uint8_t>& coded_data) override;
+
+    DecodeStatus
+    decode(const outpost::Slice<const uint8_t>& coded_data,
+           const outpost::Slice<uint8_t>& dst_data) override;
+
+    DecodeStatus
+    decodeSectors(const outpost::Slice<const uint8_t>& coded_data,
+                  const outpost::Slice<uint8_t>& dst_data,
+                  uint32_t firstSector,
+                  uint32_t numberOfSectors) override;
+
+    inline uint32_t
+    getNumberOfRedundantBytes(void) const override
+    {
+        return mNumRedundantBytes * (mNandDataSize / mNumDataBytes);
+    }
+
+    inline uint32_t
+    getNumberOfDatabytes(void) const override
+    {
+        return mNandDataSize;
+    }
+
+    inline uint32_t
+    getNumberOfSparebytes(void) const override
+    {
+        return mNandSpareSize;
+    }
+
+    inline bool
+    isTemplateParameterValid(void) const override
+    {
+        return mValid;
+    }
+
+    bool
+    isChecksumEmpty(const outpost::Slice<const uint8_t>& data) override;
+
+private:
+    static constexpr uint32_t mFFSize = Tables::mFFSize;
+    static constexpr uint32_t MAX_REDUN_WORDS = Tables::MAX_REDUN_WORDS;
+    static constexpr uint32_t MAX_NUM_SYM = (2 * mTParam);
+
+    static constexpr uint32_t ZERO_DIV_RETURN_VALUE = Tables::ZERO_DIV_RETURN_VALUE;
+
+    static constexpr uint32_t mMOddParam = mMParam % 2;
+    static constexpr uint32_t mNParam = Tables::mNParam;
+    static constexpr uint32_t mLogZVal = Tables::mLogZVal;
+
+    const Tables& mTables;
+    uint32_t mNumRedundantBits, mNumRedundantBytes;
+    uint32_t mNumCodeWordBytes, mNumRedundantWords;
+    uint32_t mLoc[mTParam];
+    uint32_t mSyndromes[MAX_NUM_SYM];
+    bool mValid;
+    uint8_t mCodeWord[mNumDataBytes + 4 * MAX_REDUN_WORDS];
+    uint8_t mRemainderBytes[(mTParam * mMParam) / 8 + 1];
+
     void
     bchEncode(void);
 
     int32_t
-    computeRemainder(void);
+    computeRemainder(const uint8_t* data, const uint8_t* redundancy);
 
     void
     computeSyndromes(void);
@@ -23,42 +23,39 @@ namespace outpost
 {
 namespace utils
 {
+template <uint32_t mMParam, uint32_t mTParam>
+constexpr uint32_t NandBCHRTimeTables<mMParam, mTParam>::mLogZVal;
+
 template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
 constexpr uint32_t NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::mLogZVal;
 
-template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
-NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::NandBCHRTime(void) :
+template <uint32_t mMParam, uint32_t mTParam>
+NandBCHRTimeTables<mMParam, mTParam>::NandBCHRTimeTables(void) :
     mNumRedundantBits(0),
     mNumRedundantBytes(0),
-    mNumCodeWordBytes(0),
     mNumRedundantWords(0),
-    mLoc{0},
-    mSyndromes{0},
     mTraceTestVal(0),
     mQuadCompTable{0},
     mValid(false),
-    mCodeWord{0},
-    mRemainderBytes{0},
     aLogTable{},
     logTable{},
     genPolyBitArray{},
     genPolyDegree(0),
     genPolyFdbkWords{},
-    encodeTable{}
+    encodeTable{},
+    syndromeTable{}
 {
     // Internal initialization
     bchInit();
 
     if (!checkLogTables())
     {
-        mValid = false;
         return;
     }
 
     // Generator polynomial
     if (!generateCodeGenPoly())
     {
-        mValid = false;
         return;
     }
 
@@ -68,9 +65,6 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::NandBCHRTime(void
     if ((genPolyDegree % 8) > 0)
         mNumRedundantBytes++;
 
-    // Note: number of data length must be less than equal to (mNParam - genPolyDegree) / 8
-    // value in our case it is 1010 bytes
-    mNumCodeWordBytes = mNumDataBytes + mNumRedundantBytes;
     mNumRedundantWords = mNumRedundantBytes / 4;
 
     if ((mNumRedundantBytes % 4) > 0)
@@ -80,14 +74,33 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::NandBCHRTime(void
 
     convertGenPolyBitToWord();
     generateEncodeTables();
+    generateSyndromeTables();
 
-    uint32_t iteration_count = (mNandDataSize * 8) / mNumDataBits;
-    mValid = (iteration_count * mNumRedundantBytes) <= mNandSpareSize;
+    mValid = true;
 }
 
 template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::NandBCHRTime(const Tables& tables) :
+    mTables(tables),
+    mNumRedundantBits(tables.mNumRedundantBits),
+    mNumRedundantBytes(tables.mNumRedundantBytes),
+    // Note: number of data length must be less than equal to (mNParam - genPolyDegree) / 8
+    // value in our case it is 1010 bytes
+    mNumCodeWordBytes(mNumDataBytes + tables.mNumRedundantBytes),
+    mNumRedundantWords(tables.mNumRedundantWords),
+    mLoc{0},
+    mSyndromes{0},
+    mValid(false),
+    mCodeWord{0},
+    mRemainderBytes{0}
+{
+    uint32_t iteration_count = (mNandDataSize * 8) / mNumDataBits;
+    mValid = tables.mValid && ((iteration_count * mNumRedundantBytes) <= mNandSpareSize);
+}
+
+template <uint32_t mMParam, uint32_t mTParam>
 void
-NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::buildLogTables(void)
+NandBCHRTimeTables<mMParam, mTParam>::buildLogTables(void)
 {
     // Constructing FF's LOG and ALOG tables
     uint32_t shiftReg = 1;
@@ -109,9 +122,9 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::buildLogTables(vo
     aLogTable[mLogZVal] = 0;
 }
 
-template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+template <uint32_t mMParam, uint32_t mTParam>
 bool
-NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::checkLogTables(void)
+NandBCHRTimeTables<mMParam, mTParam>::checkLogTables(void)
 {
     //****************************************************************
     //  Function: chkLogAlogTbls
@@ -147,9 +160,9 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::checkLogTables(vo
     return true;
 }
 
-template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+template <uint32_t mMParam, uint32_t mTParam>
 void
-NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::genTraceTestVal(void)
+NandBCHRTimeTables<mMParam, mTParam>::genTraceTestVal(void)
 {
     mTraceTestVal = 0;
     uint32_t shifter = 1;
@@ -171,9 +184,9 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::genTraceTestVal(v
     }
 }
 
-template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+template <uint32_t mMParam, uint32_t mTParam>
 void
-NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::genQuadCompTable(void)
+NandBCHRTimeTables<mMParam, mTParam>::genQuadCompTable(void)
 {
     //****************************************************************
     //  Function: genQuadCompTbl
@@ -244,9 +257,9 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::genQuadCompTable(
     }
 }
 
-template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+template <uint32_t mMParam, uint32_t mTParam>
 int32_t
-NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::ffQuadFun(int32_t c)
+NandBCHRTimeTables<mMParam, mTParam>::ffQuadFun(int32_t c) const
 {
     //****************************************************************
     // Function: ffQuadFun
@@ -291,18 +304,18 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::ffQuadFun(int32_t
         return y1 ^ 1;  // "1" Not for all basis.  y1 is one solution of y^2+y=c.
 }
 
-template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+template <uint32_t mMParam, uint32_t mTParam>
 void
-NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::bchInit(void)
+NandBCHRTimeTables<mMParam, mTParam>::bchInit(void)
 {
     buildLogTables();
     genTraceTestVal();
     genQuadCompTable();
 }
 
-template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+template <uint32_t mMParam, uint32_t mTParam>
 bool
-NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::generateCodeGenPoly(void)
+NandBCHRTimeTables<mMParam, mTParam>::generateCodeGenPoly(void)
 {
     //****************************************************************
     //  Function: genCodeGenPoly
@@ -405,9 +418,9 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::generateCodeGenPo
     return true;
 }
 
-template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+template <uint32_t mMParam, uint32_t mTParam>
 void
-NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::convertGenPolyBitToWord(void)
+NandBCHRTimeTables<mMParam, mTParam>::convertGenPolyBitToWord(void)
 {
     //****************************************************************
     //  Function: cvtCgpBitToCgpWord
@@ -447,9 +460,9 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::convertGenPolyBit
     }
 }
 
-template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+template <uint32_t mMParam, uint32_t mTParam>
 void
-NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::generateEncodeTables(void)
+NandBCHRTimeTables<mMParam, mTParam>::generateEncodeTables(void)
 {
     //****************************************************************
     //  Function: genEncodeTbls
@@ -505,11 +518,75 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::generateEncodeTab
             encodeTable[i][k] = SR[k];  // Move SR to encode table
         }
     }
+
+    // Tables for processing several bytes at once: The byte followed by
+    // zero bytes, i.e. one more byte shift of the previous table entry.
+    for (uint32_t z = 1; z < SLICES; z++)
+    {
+        for (uint32_t i = 0; i < BYTESTATES; i++)
+        {
+            const uint32_t* previous = encodeTable[(z - 1) * BYTESTATES + i];
+            uint32_t* entry = encodeTable[z * BYTESTATES + i];
+            uint32_t fdbk = previous[0] >> 24;
+            for (uint32_t k = 0; k < mNumRedundantWords; k++)
+            {
+                uint32_t next = (k + 1 < mNumRedundantWords) ? (previous[k + 1] >> 24) : 0;
+                entry[k] = (previous[k] << 8) ^ next ^ encodeTable[fdbk][k];
+            }
+        }
+    }
 }
 
-template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+template <uint32_t mMParam, uint32_t mTParam>
+void
+NandBCHRTimeTables<mMParam, mTParam>::generateSyndromeTables(void)
+{
+    // Odd syndrome S(2k+1) receives alpha^((2k+1)j) for every set bit j of a remainder byte
+    for (uint32_t k = 0; k < mTParam; k++)
+    {
+        for (uint32_t i = 0; i < BYTESTATES; i++)
+        {
+            uint16_t value = 0;
+            for (uint32_t j = 0; j < 8; j++)
+            {
+                if (i & (1 << j))
+                {
+                    value ^= aLogTable[((2 * k + 1) * j) % mNParam];
+                }
+            }
+            syndromeTable[k][i] = value;
+        }
+    }
+}
+
+template <uint32_t mMParam, uint32_t mTParam>
+void
+NandBCHRTimeTables<mMParam, mTParam>::updateRemainder(uint32_t SR[], const uint8_t* data) const
+{
+    // Equivalent to shifting the register byte by byte with the first
+    // encode table, but the feedback of SLICES bytes is looked up at once.
+    // The data length is a multiple of SLICES.
+    for (uint32_t addr = 0; addr < mNumDataBytes; addr += SLICES)
+    {
+        uint32_t fdbk = SR[0]
+                        ^ ((static_cast<uint32_t>(data[addr]) << 24)
+                           | (static_cast<uint32_t>(data[addr + 1]) << 16)
+                           | (static_cast<uint32_t>(data[addr + 2]) << 8) | data[addr + 3]);
+        const uint32_t* t3 = encodeTable[3 * BYTESTATES + (fdbk >> 24)];
+        const uint32_t* t2 = encodeTable[2 * BYTESTATES + ((fdbk >> 16) & 0xff)];
+        const uint32_t* t1 = encodeTable[BYTESTATES + ((fdbk >> 8) & 0xff)];
+        const uint32_t* t0 = encodeTable[fdbk & 0xff];
+        for (uint32_t k = 0; k < mNumRedundantWords; k++)
+        {
+            uint32_t next = (k + 1 < mNumRedundantWords) ? SR[k + 1] : 0;
+            SR[k] = next ^ t3[k] ^ t2[k] ^ t1[k] ^ t0[k];
+        }
+    }
+}
+
+template <uint32_t mMParam, uint32_t mTParam>
 int32_t
-NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::ffMult(int32_t a, int32_t b)
+NandBCHRTimeTables<mMParam, mTParam>::ffMult(int32_t a, int32_t b) const
 {
     if (a == 0 || b == 0)
         return 0;
@@ -522,10 +599,9 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::ffMult(int32_t a,
     return aLogTable[tmp];
 }
 
-template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+template <uint32_t mMParam, uint32_t mTParam>
 int32_t
-NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::ffInv(
-        int32_t opa, bool& success)  // Pointer to status
+NandBCHRTimeTables<mMParam, mTParam>::ffInv(int32_t opa, bool& success) const
 {
     //****************************************************************
     //  Function: ffInv
@@ -550,11 +626,9 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::ffInv(
     }
 }
 
-template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+template <uint32_t mMParam, uint32_t mTParam>
 int32_t
-NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::ffDiv(int32_t opa,
-                                                                     int32_t opb,
-                                                                     bool& success)
+NandBCHRTimeTables<mMParam, mTParam>::ffDiv(int32_t opa, int32_t opb, bool& success) const
 {
     //****************************************************************
     //  Function: ffDiv
@@ -580,9 +654,9 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::ffDiv(int32_t opa
     return aLogTable[tmp];
 }
 
-template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+template <uint32_t mMParam, uint32_t mTParam>
 int32_t
-NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::ffSquareRoot(int32_t opa)
+NandBCHRTimeTables<mMParam, mTParam>::ffSquareRoot(int32_t opa) const
 {
     //****************************************************************
     //  Function: ffSquareRoot
@@ -607,10 +681,9 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::ffSquareRoot(int3
     }
 }
 
-template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+template <uint32_t mMParam, uint32_t mTParam>
 int32_t
-NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::ffCubeRoot(int32_t opa,
-                                                                          bool& success)
+NandBCHRTimeTables<mMParam, mTParam>::ffCubeRoot(int32_t opa, bool& success) const
 {
     //****************************************************************
     //  Function: ffCubeRoot
@@ -665,30 +738,15 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::bchEncode(void)
     //  from a paper by Hsiao and Sih titled "Serial-to-Parrallel Transformation
     //  of Linear-Feedback Shift-Register Circuits" which appeared in
     //  IEEE. Trans. on Elec. Comp., 738-740 (Dec. 1964).
+    //
+    //  The shift register is advanced by four bytes at once with one table
+    //  per byte position, see mTables.updateRemainder.
     //****************************************************************
     uint32_t SR[MAX_REDUN_WORDS] = {0};
     // +5 So that we can temporarily keep remainder bytes in whole words
     uint8_t redunByteArray[(mTParam * mMParam) / 8 + 5];
 
-    for (uint16_t writeCWAddr = 0; writeCWAddr < mNumDataBytes; writeCWAddr++)
-    {  // index to write data buffer
-        uint32_t fdbk = 0;
-        for (int32_t i = mNumRedundantWords - 1; i >= 0; i--)
-        {
-            // IT IS POSSIBLE TO UNROLL THIS LOOP USING A SWITCH STATEMENT.
-            // WILL HAVE TO PROCESS FROM HIGH ADDRESS BACK TOWARDS ZERO
-            uint32_t fdbkSav = fdbk;
-            // 32 bits per int32_t - but process 8 bits at a time (8 bits unrelated to "m")
-            fdbk = (SR[i] >> 24) & 0x000000ff;
-            SR[i] = (SR[i] << 8) ^ fdbkSav;  // 8 # bits in parallel - unrelated to "m"
-        }
-        fdbk ^= mCodeWord[writeCWAddr];
-        // IT IS POSSIBLE TO UNROLL THIS LOOP USING A SWITCH STATEMENT
-        for (uint32_t kx = 0; kx < mNumRedundantWords; kx++)
-        {
-            SR[kx] ^= encodeTable[fdbk][kx];
-        }
-    }
+    mTables.updateRemainder(SR, mCodeWord);
     // Copy redundancy bytes from shift register (SR) word array
     for (uint32_t kx = 0; kx < mNumRedundantWords; kx++)
     {
@@ -707,7 +765,8 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::bchEncode(void)
 
 template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
 int32_t
-NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::computeRemainder(void)
+NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::computeRemainder(
+        const uint8_t* data, const uint8_t* redundancy)
 {
     //****************************************************************
     //  Function: computeRemainder
@@ -744,37 +803,21 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::computeRemainder(
     //  from a paper by Hsiao and Sih titled "Serial-to-Parrallel Transformation
     //  of Linear-Feedback Shift-Register Circuits" which appeared in
     //  IEEE. Trans. on Elec. Comp., 738-740 (Dec. 1964).
+    //
+    //  The data is read directly from the given buffers so that an error
+    //  free code word does not have to be copied.
     //****************************************************************
     uint32_t SR[MAX_REDUN_WORDS] = {0};
-    ;
 
     // SHIFTS WITH FEEDBACK
-    for (uint32_t readCWAddr = 0; readCWAddr < mNumDataBytes; readCWAddr++)
-    {  // index to write data buffer
-        uint32_t fdbk = 0;
-        for (int32_t nnn = mNumRedundantWords - 1; nnn >= 0; nnn--)
-        {
-            // IT IS POSSIBLE TO UNROLL THIS LOOP USING A SWITCH STATEMENT.
-            // WILL HAVE TO PROCESS FROM HIGH ADDRESS BACK TOWARDS ZERO
-            uint32_t fdbkSav = fdbk;
-            fdbk = (SR[nnn] >> 24);              // 32 - # bits in word (unrelated to "m")
-            SR[nnn] = (SR[nnn] << 8) ^ fdbkSav;  // 8 # bits in parallel - unrelated to "m"
-        }
-        fdbk ^= mCodeWord[readCWAddr];
-        for (uint32_t k = 0; k < mNumRedundantWords; k++)
-        {
-            // IT IS POSSIBLE TO UNROLL THIS LOOP
-            SR[k] ^= encodeTable[fdbk][k];
-        }
-    }
+    mTables.updateRemainder(SR, data);
     // SHIFTS WITHOUT FEEDBACK
     // Line below - This flag will be set later if the remainder is non zero.
     // Non-zero means either corr or uncorr err.  We will know which after decoding.
     int32_t remainderDetdErr = 0;
 
     // index to code word buffer
-    for (uint32_t readCWAddr = mNumDataBytes; readCWAddr < mNumDataBytes + mNumRedundantBytes;
-         readCWAddr++)
+    for (uint32_t readCWAddr = 0; readCWAddr < mNumRedundantBytes; readCWAddr++)
     {
         uint32_t fdbk = 0;
         for (int32_t nnn = mNumRedundantWords - 1; nnn >= 0; nnn--)
@@ -783,8 +826,8 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::computeRemainder(
             fdbk = (SR[nnn] >> 24);              // 32 - # bits in parallel (unrelated to "m")
             SR[nnn] = (SR[nnn] << 8) ^ fdbkSav;  // 8 # bits in parallel - unrelated to "m"
         }
-        fdbk ^= mCodeWord[readCWAddr];
-        mRemainderBytes[readCWAddr - mNumDataBytes] = static_cast<int32_t>(fdbk);
+        fdbk ^= redundancy[readCWAddr];
+        mRemainderBytes[readCWAddr] = static_cast<int32_t>(fdbk);
         if (fdbk != 0)
         {
             remainderDetdErr = 1;
@@ -816,36 +859,30 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::computeSyndromes(
     //  a remainder is page 160 of the Glover-Dudley 1991 book
     //  "Practical Error Correction Design for Engineers"
     //  REVISED SECOND EDITION.
+    //
+    //  The contribution of every remainder byte value is taken from a
+    //  table instead of processing the remainder bit by bit.
     //****************************************************************
 
     // In a real implementation of one fixed code, numSyndromes would be a constant
     uint32_t numSyndromes = 2 * mTParam;
 
-    // Clear syndromes array
-    outpost::asSlice(mSyndromes).fill(0);
-
-    for (uint32_t i = 0; i < mNumRedundantBytes; i++)
+    // The odd syndromes are evaluated byte wise with Horner's scheme, each
+    // byte of the remainder shifts the previous value by alpha^(8(2k+1)).
+    for (uint32_t k = 0; k < mTParam; k++)
     {
-        uint8_t mask = 0x01;
-        for (uint32_t j = 0; j < 8; j++)
+        uint32_t shift = (8 * (2 * k + 1)) % mNParam;
+        uint32_t value = 0;
+        for (uint32_t i = 0; i < mNumRedundantBytes; i++)
         {
-            uint8_t data = mRemainderBytes[i] & mask;
-            if (data > 0)
+            if (value > 0)
             {
-                // 9-10-10 Changed for speed
-                uint32_t accumVal = (((mNumRedundantBytes - 1) - i) * 8 + j);  // Initialize
-                uint32_t bumpVal = 2 * accumVal;                               // Initialize
-                // Note increment by 2
-                for (uint32_t k = 0; k < numSyndromes; k += 2)
-                {
-                    //  "+1" is for syndrome offset
-                    mSyndromes[k] ^= aLogTable[accumVal];
-                    accumVal += bumpVal;  // Add 2*preComputeVal
-                    accumVal = accumVal % mNParam;
-                }
+                // The alog table has twice the field size, no modulo needed
+                value = mTables.aLogTable[mTables.logTable[value] + shift];
             }
-            mask *= 2;
+            value ^= mTables.syndromeTable[k][mRemainderBytes[i]];
         }
+        mSyndromes[2 * k] = value;
     }
     // Compute even syndromes from the odd syndromes
     for (uint32_t k = 0; k < numSyndromes; k += 2)
@@ -857,7 +894,7 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::computeSyndromes(
             // Square "x"
             if (x > 0)
             {
-                x = aLogTable[2 * logTable[x]];
+                x = mTables.aLogTable[2 * mTables.logTable[x]];
             }
             mSyndromes[evenSNum - 1] = x;
             evenSNum *= 2;
@@ -933,7 +970,7 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::berMas(int32_t si
         int32_t dn = 0;
         for (uint32_t j = 0; j <= Ln; j++)
         {
-            dn ^= ffMult(sigmaN[j], mSyndromes[n - j]);
+            dn ^= mTables.ffMult(sigmaN[j], mSyndromes[n - j]);
         }
         if (dn == 0)
         {
@@ -948,14 +985,14 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::berMas(int32_t si
                     success = false;
                     break;
                 }
-                // Next 2 "if" blks chgd to not use ffMult and ffDiv funs 9-9-2010
+                // Next 2 "if" blks chgd to not use mTables.ffMult and mTables.ffDiv funs 9-9-2010
                 if (dk == 0)
                 {
                     return (ZERO_DIV_RETURN_VALUE);  // Divide by zero error
                 }
                 if (dn > 0)
                 {
-                    int32_t logTmpQ = logTable[dn] - logTable[dk];
+                    int32_t logTmpQ = mTables.logTable[dn] - mTables.logTable[dk];
                     if (logTmpQ < 0)
                     {
                         logTmpQ += mNParam;
@@ -964,7 +1001,8 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::berMas(int32_t si
                     {
                         if (sigmaK[j] > 0)
                         {
-                            sigmaN[nminusk + j] ^= aLogTable[logTable[sigmaK[j]] + logTmpQ];
+                            sigmaN[nminusk + j] ^=
+                                    mTables.aLogTable[mTables.logTable[sigmaK[j]] + logTmpQ];
                         }
                     }
                 }
@@ -982,14 +1020,14 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::berMas(int32_t si
                 {
                     sigmaTmp[j] = sigmaN[j];
                 }
-                // Next 2 "if" blks chgd to not use ffMult and ffDiv funs 9-9-2010
+                // Next 2 "if" blks chgd to not use mTables.ffMult and mTables.ffDiv funs 9-9-2010
                 if (dk == 0)
                 {
                     return (ZERO_DIV_RETURN_VALUE);  // Divide by zero error
                 }
                 if (dn > 0)
                 {
-                    int32_t logTmpQ = logTable[dn] - logTable[dk];
+                    int32_t logTmpQ = mTables.logTable[dn] - mTables.logTable[dk];
                     if (logTmpQ < 0)
                     {
                         logTmpQ += mNParam;
@@ -998,7 +1036,8 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::berMas(int32_t si
                     {
                         if (sigmaK[j] > 0)
                         {
-                            sigmaN[nminusk + j] ^= aLogTable[logTable[sigmaK[j]] + logTmpQ];
+                            sigmaN[nminusk + j] ^=
+                                    mTables.aLogTable[mTables.logTable[sigmaK[j]] + logTmpQ];
                         }
                     }
                 }
@@ -1085,7 +1124,7 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::chienSearch(int32
     // Convert error locator poly to log domain for Chien Search
     for (uint32_t n = 1; n <= Ln; n++)
     {
-        sigmaN[n] = logTable[sigmaN[n]];
+        sigmaN[n] = mTables.logTable[sigmaN[n]];
     }
     for (uint32_t n = 0; n < mNumCodeWordBytes * 8; n++)
     {
@@ -1099,7 +1138,7 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::chienSearch(int32
             {  // One step of Simple Chien Search in this loop
                 if (sigmaN[jj] != static_cast<int32_t>(mLogZVal))
                 {  // Test for log of zero
-                    accum ^= aLogTable[sigmaN[jj]];
+                    accum ^= mTables.aLogTable[sigmaN[jj]];
                     sigmaN[jj] -= jj;
                     if (sigmaN[jj] < 0)
                     {  // Compare & subtract is faster than mod
@@ -1112,7 +1151,7 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::chienSearch(int32
         {
             for (uint32_t i = Ln; i > 0; i--)
             {
-                accum ^= aLogTable[sigmaN[i]];  // accum is XOR sum of all alogs
+                accum ^= mTables.aLogTable[sigmaN[i]];  // accum is XOR sum of all alogs
                 sigmaN[i] -= i;
                 if (sigmaN[i] < 0)
                 {
@@ -1122,17 +1161,17 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::chienSearch(int32
         }
         if (accum == 1)
         {
-            mLoc[Ln - 1] = aLogTable[n % (mFFSize)];
+            mLoc[Ln - 1] = mTables.aLogTable[n % (mFFSize)];
             // Convert back to alog domain so we can divide down
             for (uint32_t i = 1; i <= Ln; i++)
             {
-                sigmaN[i] = aLogTable[sigmaN[i]];
+                sigmaN[i] = mTables.aLogTable[sigmaN[i]];
             }
             // Divide down the ELP to eliminate the root just found
             int32_t reg = 0;
             for (int32_t kx = Ln; kx >= 0; kx--)
             {
-                int32_t tmp = ffMult(reg, aLogTable[1]);  // The number "1"
+                int32_t tmp = mTables.ffMult(reg, mTables.aLogTable[1]);  // The number "1"
                 reg = sigmaN[kx] ^ tmp;
                 sigmaN[kx] = tmp;
             }
@@ -1154,14 +1193,15 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::chienSearch(int32
                 // position the ELP back to its starting point for special cases
                 for (uint32_t i = 1; i <= Ln; i++)
                 {
-                    sigmaN[i] = ffMult(sigmaN[i], aLogTable[((n + 1) * i) % mNParam]);
+                    sigmaN[i] =
+                            mTables.ffMult(sigmaN[i], mTables.aLogTable[((n + 1) * i) % mNParam]);
                 }
                 break;
             }
             // Convert back to log domain so we can continue root search
             for (uint32_t i = 1; i <= Ln; i++)
             {
-                sigmaN[i] = logTable[sigmaN[i]];
+                sigmaN[i] = mTables.logTable[sigmaN[i]];
             }
         }
     }
@@ -1197,9 +1237,9 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::quadraticElp(cons
     {
         success = false;
     }
-    int32_t c = ffDiv(sigmaN[2], ffMult(sigmaN[1], sigmaN[1]), success);
+    int32_t c = mTables.ffDiv(sigmaN[2], mTables.ffMult(sigmaN[1], sigmaN[1]), success);
 
-    int32_t y1 = ffQuadFun(c);
+    int32_t y1 = mTables.ffQuadFun(c);
 
     if (y1 == 0)
     {
@@ -1210,8 +1250,8 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::quadraticElp(cons
     // to change to alog[0]
     int32_t y2 = y1 ^ 1;
 
-    mLoc[0] = ffMult(sigmaN[1], y1);
-    mLoc[1] = ffMult(sigmaN[1], y2);
+    mLoc[0] = mTables.ffMult(sigmaN[1], y1);
+    mLoc[1] = mTables.ffMult(sigmaN[1], y2);
 
     return success;
 }
@@ -1243,17 +1283,17 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::cubicElp(const in
     //***************************************************************
     bool success = true;
     // n for numerator, d for denominator
-    int32_t n = sigmaN[2] ^ ffMult(sigmaN[1], sigmaN[1]);
-    int32_t d = sigmaN[3] ^ ffMult(sigmaN[1], sigmaN[2]);
+    int32_t n = sigmaN[2] ^ mTables.ffMult(sigmaN[1], sigmaN[1]);
+    int32_t d = sigmaN[3] ^ mTables.ffMult(sigmaN[1], sigmaN[2]);
     // Note to Neal.  The error check on the next line is
-    // redundant. This error would also get caught in "ffDiv" function.
+    // redundant. This error would also get caught in "mTables.ffDiv" function.
     if (d == 0)
     {
         success = false;  // Divide by "0" error
     }
-    int32_t n3 = ffMult(n, ffMult(n, n));  // Numerator cubed
-    int32_t d2 = ffMult(d, d);             // Denominator squared
-    int32_t c = ffDiv(n3, d2, success);    // Finite field divide
+    int32_t n3 = mTables.ffMult(n, mTables.ffMult(n, n));  // Numerator cubed
+    int32_t d2 = mTables.ffMult(d, d);             // Denominator squared
+    int32_t c = mTables.ffDiv(n3, d2, success);    // Finite field divide
     // Note to Neal.  ######## I think I put in the next decision
     // during debug in 1999.  The code could be extensively tested
     // without this decision to see if it can be left out.
@@ -1265,21 +1305,21 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::cubicElp(const in
     else
     {
         // The quad function is equiv to fetching from large table
-        int32_t v1 = ffQuadFun(c);
+        int32_t v1 = mTables.ffQuadFun(c);
         if (v1 == 0)
         {
             success = false;
         }
-        u1 = ffMult(v1, d);
+        u1 = mTables.ffMult(v1, d);
     }
     // Roots of transformed cubic
-    int32_t t1 = ffCubeRoot(u1, success);
-    int32_t t2 = ffMult(t1, aLogTable[mNParam / 3]);  // nParm/3 is 85 for gf(2^8)
+    int32_t t1 = mTables.ffCubeRoot(u1, success);
+    int32_t t2 = mTables.ffMult(t1, mTables.aLogTable[mNParam / 3]);  // nParm/3 is 85 for gf(2^8)
     int32_t t3 = t1 ^ t2;  // Equivalent to t2= line with nParm replaced by 2*nParm
     // Roots of original cubic
-    mLoc[0] = sigmaN[1] ^ t1 ^ ffDiv(n, t1, success);
-    mLoc[1] = sigmaN[1] ^ t2 ^ ffDiv(n, t2, success);
-    mLoc[2] = sigmaN[1] ^ t3 ^ ffDiv(n, t3, success);
+    mLoc[0] = sigmaN[1] ^ t1 ^ mTables.ffDiv(n, t1, success);
+    mLoc[1] = sigmaN[1] ^ t2 ^ mTables.ffDiv(n, t2, success);
+    mLoc[2] = sigmaN[1] ^ t3 ^ mTables.ffDiv(n, t3, success);
 
     return success;
 }
@@ -1339,12 +1379,14 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::quarticElp(int32_
     else
     {
         // ---------- Step b of the Deodhar-Weldon paper ----------
-        b4n = ffMult(sigbk[1], sigbk[1]);
-        b4d = ffMult(sigbk[3], sigbk[3]) ^ ffMult(sigbk[1], ffMult(sigbk[2], sigbk[3]))
-              ^ ffMult(sigbk[4], b4n);
-        b4 = ffDiv(b4n, b4d, success);
-        b3 = ffMult(sigbk[1], b4);
-        b2 = ffMult(b4, ffSquareRoot(ffMult(sigbk[1], sigbk[3])) ^ sigbk[2]);
+        b4n = mTables.ffMult(sigbk[1], sigbk[1]);
+        b4d = mTables.ffMult(sigbk[3], sigbk[3])
+              ^ mTables.ffMult(sigbk[1], mTables.ffMult(sigbk[2], sigbk[3]))
+              ^ mTables.ffMult(sigbk[4], b4n);
+        b4 = mTables.ffDiv(b4n, b4d, success);
+        b3 = mTables.ffMult(sigbk[1], b4);
+        b2 = mTables.ffMult(b4,
+                            mTables.ffSquareRoot(mTables.ffMult(sigbk[1], sigbk[3])) ^ sigbk[2]);
     }
     // ---------- Step c of the Deodhar-Weldon paper ----------
     //  Set up a cubic and find its 3 roots.
@@ -1357,7 +1399,7 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::quarticElp(int32_
     // ---------- Step d of the Deodhar-Weldon paper ----------
     //  Set up a quadratic and find its two roots
     sigmaN[0] = 1;
-    sigmaN[1] = ffDiv(b3, qq, success);
+    sigmaN[1] = mTables.ffDiv(b3, qq, success);
     sigmaN[2] = b4;
     success &= quadraticElp(sigmaN);
     int32_t ss = mLoc[0];
@@ -1379,10 +1421,10 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::quarticElp(int32_
     {
         // ---------- Step e of the Deodhar-Weldon paper ----------
         //  Do inverse substitution
-        int32_t tmp = ffSquareRoot(ffDiv(sigbk[3], sigbk[1], success));
+        int32_t tmp = mTables.ffSquareRoot(mTables.ffDiv(sigbk[3], sigbk[1], success));
         for (int32_t n = 0; n < 4; n++)
         {
-            mLoc[n] = ffInv(mLoc[n], success) ^ tmp;
+            mLoc[n] = mTables.ffInv(mLoc[n], success) ^ tmp;
         }
     }
 
@@ -1457,7 +1499,7 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::fixErrors(int32_t
 
     for (int32_t kx = 0; kx < Ln; kx++)
     {
-        uint32_t bitLoc = (((mNumCodeWordBytes * 8 - logTable[mLoc[kx]]) - 1) % mNParam);
+        uint32_t bitLoc = (((mNumCodeWordBytes * 8 - mTables.logTable[mLoc[kx]]) - 1) % mNParam);
         // Bounds check fwd displacement because pad bits at end.
         // Note to Neal.
         if (bitLoc < (mNumDataBits + mNumRedundantBits))
@@ -1484,7 +1526,6 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::bchDecode(void)
     //  Function: bchDecode
     //
     //  This function performs decoding by calling -
-    //  - a function to compute a remainder
     //  - a function to compute obj->mSyndromes from the remainder
     //  - a Berlekamp-Massey function to compute an error
     //    locator polynomial
@@ -1495,44 +1536,32 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::bchDecode(void)
     //  this function then you may want to remove the test code after
     //  testing is complete.  All such code is commented "For testing only"
     //
-    //  Array addresses for syndrome symbols and remainder bytes are passed
-    //  to this function but on entry to this function these arrays do not
-    //  contain useful data.
+    //  The remainder is computed by the caller, this function is only
+    //  called with the code word in mCodeWord if the remainder is not
+    //  zero, i.e. the code word contains errors.
     //****************************************************************
     int32_t sigmaN[mTParam + 1];
     bool success = true;
-    DecodeStatus status = DecodeStatus::noError;
+    DecodeStatus status = DecodeStatus::corrected;
 
     outpost::asSlice(mLoc).fill(mLogZVal);
 
-    int32_t remainderDetdErr = computeRemainder();
+    computeSyndromes();
 
-    // If remainderDetdErr is not 0, CW is not err free - could be corr or uncorr
-    if (remainderDetdErr != 0)
-    {
-        // GET HERE IF REMAINDER INDICATES AN ERROR (NON-ZERO REMAINDER)
-        status = DecodeStatus::corrected;
-        computeSyndromes();
+    //  Compute coeff's of ELP using Berlekamp/Massey
+    int32_t Ln = berMas(sigmaN, success);
 
-        //  Compute coeff's of ELP using Berlekamp/Massey
-        int32_t Ln = berMas(sigmaN, success);
+    if (success)
+    {
+        //  Find the roots of the ELP
+        success &= rootFindChien(sigmaN, Ln);
 
         if (success)
         {
-            //  Find the roots of the ELP
-            success &= rootFindChien(sigmaN, Ln);
-
-            if (success)
-            {
-                //  Fix the errors in the data buffer
-                success &= fixErrors(Ln);
-            }
+            //  Fix the errors in the data buffer
+            success &= fixErrors(Ln);
         }
     }
-    else
-    {
-        outpost::asSlice(mSyndromes).fill(0);
-    }
 
     if (!success)
     {
@@ -1565,7 +1594,7 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::encode(
             // all data fits
             memcpy(mCodeWord, &src_data[i * mNumDataBytes], mNumDataBytes);
         }
-        else if ((i * mNumDataBytes) <= src_data.getNumberOfElements())
+        else if (src_data.getNumberOfElements() <= (i * mNumDataBytes))
         {
             // fill up all remaining data
             outpost::asSlice(mCodeWord).first(mNumDataBytes).fill(NandBCHInterface::fillValue);
@@ -1598,6 +1627,17 @@ template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t m
 DecodeStatus
 NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::decode(
         const outpost::Slice<const uint8_t>& coded_data, const outpost::Slice<uint8_t>& dest_data)
+{
+    return decodeSectors(coded_data, dest_data, 0, mNandDataSize / mNumDataBytes);
+}
+
+template <uint32_t mMParam, uint32_t mTParam, uint32_t mNandDataSize, uint32_t mNandSpareSize>
+DecodeStatus
+NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::decodeSectors(
+        const outpost::Slice<const uint8_t>& coded_data,
+        const outpost::Slice<uint8_t>& dest_data,
+        uint32_t firstSector,
+        uint32_t numberOfSectors)
 {
     if (coded_data.getNumberOfElements() < mNandDataSize + mNandSpareSize || !mValid)
     {
@@ -1605,27 +1645,38 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::decode(
         return DecodeStatus::invalidParameters;
     }
 
-    DecodeStatus status = DecodeStatus::noError;
-
     uint32_t iteration_count = (mNandDataSize * 8) / mNumDataBits;
+    if (firstSector > iteration_count || numberOfSectors > iteration_count - firstSector)
+    {
+        return DecodeStatus::invalidParameters;
+    }
+
+    DecodeStatus status = DecodeStatus::noError;
 
     /* Convert k size information in bits format */
-    for (uint32_t i = 0; i < iteration_count; i++)
+    for (uint32_t i = firstSector; i < firstSector + numberOfSectors; i++)
     {
         /* Retrieving data incrementally from beginning and checksum at the end */
-        memcpy(mCodeWord, &coded_data[i * mNumDataBytes], mNumDataBytes);
-        memcpy(&mCodeWord[mNumDataBytes],
-               &coded_data[i * (mNumRedundantBytes) + mNandDataSize],
-               (mNumRedundantBytes));
+        const uint8_t* data = &coded_data[i * mNumDataBytes];
+        const uint8_t* redundancy = &coded_data[i * (mNumRedundantBytes) + mNandDataSize];
 
-        /* Perform decoding */
-        status = combine(status, bchDecode());
+        // Error free code words are copied directly to the destination
+        const uint8_t* result = data;
+        if (computeRemainder(data, redundancy) != 0)
+        {
+            memcpy(mCodeWord, data, mNumDataBytes);
+            memcpy(&mCodeWord[mNumDataBytes], redundancy, (mNumRedundantBytes));
+
+            /* Perform decoding */
+            status = combine(status, bchDecode());
+            result = mCodeWord;
+        }
 
         // Copy anyways, we tell them whether it is correct or not
         if (dest_data.getNumberOfElements() >= ((i + 1) * mNumDataBytes))
         {
             // all data fitting
-            memcpy(&dest_data[0] + (i * mNumDataBytes), mCodeWord, mNumDataBytes);
+            memcpy(&dest_data[0] + (i * mNumDataBytes), result, mNumDataBytes);
         }
         else if (dest_data.getNumberOfElements() <= (i * mNumDataBytes))
         {
@@ -1635,7 +1686,7 @@ NandBCHRTime<mMParam, mTParam, mNandDataSize, mNandSpareSize>::decode(
         {
             // partial
             uint32_t sizeRemaining = dest_data.getNumberOfElements() - (i * mNumDataBytes);
-            memcpy(&dest_data[0] + (i * mNumDataBytes), mCodeWord, sizeRemaining);
+            memcpy(&dest_data[0] + (i * mNumDataBytes), result, sizeRemaining);
         }
     }
     return status;
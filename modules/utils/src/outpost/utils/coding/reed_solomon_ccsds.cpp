@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "reed_solomon_ccsds.h"
+
+#include "reed_solomon_ccsds_tables.h"
+
+#include <string.h>
+
+using namespace outpost::utils;
+using namespace outpost::utils::reed_solomon;
+
+constexpr size_t ReedSolomonCcsdsCodeword::numberOfSymbols;
+constexpr size_t ReedSolomonCcsdsCodeword::numberOfDataSymbols;
+constexpr size_t ReedSolomonCcsdsCodeword::numberOfParitySymbols;
+constexpr size_t ReedSolomonCcsdsCodeword::correctableErrors;
+
+namespace
+{
+constexpr uint32_t fieldSize = 255;
+// Logarithm of zero
+constexpr uint32_t logZero = 255;
+
+// The roots of the generator polynomial are alpha^(primitiveElement * (firstRoot + i))
+constexpr uint32_t firstRoot = 112;
+constexpr uint32_t primitiveElement = 11;
+// primitiveElement * inversePrimitiveElement = 1 (mod 255)
+constexpr uint32_t inversePrimitiveElement = 116;
+
+constexpr size_t parityWords = ReedSolomonCcsdsCodeword::numberOfParitySymbols / 4;
+
+inline uint32_t
+modulo(uint32_t value)
+{
+    while (value >= fieldSize)
+    {
+        value -= fieldSize;
+        value = (value >> 8) + (value & fieldSize);
+    }
+    return value;
+}
+
+inline uint8_t
+getParitySymbol(const uint32_t* parity, size_t index)
+{
+    return static_cast<uint8_t>(parity[index / 4] >> (24 - 8 * (index % 4)));
+}
+
+/**
+ * Divide the data polynomial (in the conventional basis) by the generator
+ * polynomial, four symbols of the remainder are kept per word.
+ */
+void
+calculateParity(const uint8_t* data, size_t stride, uint32_t* parity)
+{
+    for (size_t k = 0; k < parityWords; k++)
+    {
+        parity[k] = 0;
+    }
+
+    for (size_t i = 0; i < ReedSolomonCcsdsCodeword::numberOfDataSymbols; i++)
+    {
+        uint8_t feedback = toConventionalBasis[data[i * stride]] ^ (parity[0] >> 24);
+        const uint32_t* row = encodeTable[feedback];
+        for (size_t k = 0; k < parityWords - 1; k++)
+        {
+            parity[k] = ((parity[k] << 8) | (parity[k + 1] >> 24)) ^ row[k];
+        }
+        parity[parityWords - 1] = (parity[parityWords - 1] << 8) ^ row[parityWords - 1];
+    }
+}
+}  // namespace
+
+void
+ReedSolomonCcsdsCodeword::encode(const uint8_t* data, uint8_t* parity, size_t stride)
+{
+    uint32_t remainder[parityWords];
+    calculateParity(data, stride, remainder);
+
+    for (size_t i = 0; i < numberOfParitySymbols; i++)
+    {
+        parity[i * stride] = toDualBasis[getParitySymbol(remainder, i)];
+    }
+}
+
+DecodeStatus
+ReedSolomonCcsdsCodeword::decode(const uint8_t* received, uint8_t* data, size_t stride)
+{
+    uint8_t remainder[numberOfParitySymbols];
+    if (!computeRemainder(received, stride, remainder))
+    {
+        return DecodeStatus::noError;
+    }
+    return correctErrors(remainder, data, stride);
+}
+
+bool
+ReedSolomonCcsdsCodeword::computeRemainder(const uint8_t* received,
+                                           size_t stride,
+                                           uint8_t* remainder)
+{
+    uint32_t parity[parityWords];
+    calculateParity(received, stride, parity);
+
+    // The remainder of the received polynomial is the difference between
+    // the received and the recomputed parity
+    const uint8_t* receivedParity = &received[numberOfDataSymbols * stride];
+    uint8_t difference = 0;
+    for (size_t i = 0; i < numberOfParitySymbols; i++)
+    {
+        remainder[i] =
+                getParitySymbol(parity, i) ^ toConventionalBasis[receivedParity[i * stride]];
+        difference |= remainder[i];
+    }
+    return difference != 0;
+}
+
+DecodeStatus
+ReedSolomonCcsdsCodeword::correctErrors(const uint8_t* remainder, uint8_t* data, size_t stride)
+{
+    // Syndromes in index form. The received polynomial and the remainder share
+    // the value in the roots of the generator polynomial, but the remainder has
+    // only numberOfParitySymbols coefficients.
+    uint32_t syndromes[numberOfParitySymbols];
+    for (size_t i = 0; i < numberOfParitySymbols; i++)
+    {
+        const uint32_t root = modulo((firstRoot + i) * primitiveElement);
+        uint8_t value = 0;
+        for (size_t k = 0; k < numberOfParitySymbols; k++)
+        {
+            if (value != 0)
+            {
+                value = exponentTable[logarithmTable[value] + root];
+            }
+            value ^= remainder[k];
+        }
+        syndromes[i] = logarithmTable[value];
+    }
+
+    // Berlekamp-Massey algorithm for the error locator polynomial lambda(x),
+    // lambda is in polynomial form, b in index form
+    uint8_t lambda[numberOfParitySymbols + 1] = {1};
+    uint32_t b[numberOfParitySymbols + 1];
+    uint8_t t[numberOfParitySymbols + 1];
+    b[0] = 0;
+    for (size_t i = 1; i <= numberOfParitySymbols; i++)
+    {
+        b[i] = logZero;
+    }
+
+    size_t degree = 0;
+    for (size_t r = 1; r <= numberOfParitySymbols; r++)
+    {
+        // Discrepancy at step r
+        uint8_t discrepancy = 0;
+        for (size_t i = 0; i < r; i++)
+        {
+            if (lambda[i] != 0 && syndromes[r - i - 1] != logZero)
+            {
+                discrepancy ^= exponentTable[modulo(logarithmTable[lambda[i]]
+                                                    + syndromes[r - i - 1])];
+            }
+        }
+        const uint32_t logDiscrepancy = logarithmTable[discrepancy];
+
+        if (logDiscrepancy == logZero)
+        {
+            // B(x) = x * B(x)
+            memmove(&b[1], &b[0], numberOfParitySymbols * sizeof(b[0]));
+            b[0] = logZero;
+        }
+        else
+        {
+            // T(x) = lambda(x) - discrepancy * x * B(x)
+            t[0] = lambda[0];
+            for (size_t i = 0; i < numberOfParitySymbols; i++)
+            {
+                t[i + 1] = lambda[i + 1];
+                if (b[i] != logZero)
+                {
+                    t[i + 1] ^= exponentTable[modulo(logDiscrepancy + b[i])];
+                }
+            }
+
+            if (2 * degree <= r - 1)
+            {
+                degree = r - degree;
+                // B(x) = lambda(x) / discrepancy
+                for (size_t i = 0; i <= numberOfParitySymbols; i++)
+                {
+                    b[i] = (lambda[i] == 0)
+                                   ? logZero
+                                   : modulo(logarithmTable[lambda[i]] + fieldSize
+                                            - logDiscrepancy);
+                }
+            }
+            else
+            {
+                memmove(&b[1], &b[0], numberOfParitySymbols * sizeof(b[0]));
+                b[0] = logZero;
+            }
+            memcpy(lambda, t, sizeof(lambda));
+        }
+    }
+
+    // Convert lambda to index form
+    uint32_t logLambda[numberOfParitySymbols + 1];
+    size_t lambdaDegree = 0;
+    for (size_t i = 0; i <= numberOfParitySymbols; i++)
+    {
+        logLambda[i] = logarithmTable[lambda[i]];
+        if (logLambda[i] != logZero)
+        {
+            lambdaDegree = i;
+        }
+    }
+    if (lambdaDegree > correctableErrors)
+    {
+        return DecodeStatus::uncorrectable;
+    }
+
+    // Chien search for the roots of lambda(x), i.e. the error locations
+    uint32_t registers[correctableErrors + 1];
+    uint32_t roots[correctableErrors];
+    size_t locations[correctableErrors];
+    size_t count = 0;
+    memcpy(registers, logLambda, sizeof(registers));
+    for (uint32_t i = 1, k = inversePrimitiveElement - 1;
+         (i <= fieldSize) && (count < lambdaDegree);
+         i++, k = modulo(k + inversePrimitiveElement))
+    {
+        uint8_t q = 1;
+        for (size_t j = lambdaDegree; j > 0; j--)
+        {
+            if (registers[j] != logZero)
+            {
+                registers[j] = modulo(registers[j] + j);
+                q ^= exponentTable[registers[j]];
+            }
+        }
+        if (q == 0)
+        {
+            roots[count] = i;
+            locations[count] = k;
+            count++;
+        }
+    }
+    if (count != lambdaDegree)
+    {
+        return DecodeStatus::uncorrectable;
+    }
+
+    // Error evaluator omega(x) = syndromes(x) * lambda(x) mod x^32 in index form
+    uint32_t omega[correctableErrors];
+    const size_t omegaDegree = lambdaDegree - 1;
+    for (size_t i = 0; i <= omegaDegree; i++)
+    {
+        uint8_t value = 0;
+        for (size_t j = 0; j <= i; j++)
+        {
+            if (syndromes[i - j] != logZero && logLambda[j] != logZero)
+            {
+                value ^= exponentTable[modulo(syndromes[i - j] + logLambda[j])];
+            }
+        }
+        omega[i] = logarithmTable[value];
+    }
+
+    // Forney algorithm for the error values:
+    // omega(X^-1) * X^-(firstRoot - 1) / lambda'(X^-1)
+    uint8_t errors[correctableErrors];
+    for (size_t j = 0; j < count; j++)
+    {
+        uint8_t numerator = 0;
+        for (size_t i = 0; i <= omegaDegree; i++)
+        {
+            if (omega[i] != logZero)
+            {
+                numerator ^= exponentTable[modulo(omega[i] + i * roots[j])];
+            }
+        }
+        const uint32_t logPower = modulo(roots[j] * (firstRoot - 1) + fieldSize);
+
+        // The formal derivative only consists of the odd coefficients
+        uint8_t denominator = 0;
+        for (size_t i = 0; i < lambdaDegree; i += 2)
+        {
+            if (logLambda[i + 1] != logZero)
+            {
+                denominator ^= exponentTable[modulo(logLambda[i + 1] + i * roots[j])];
+            }
+        }
+        if (denominator == 0)
+        {
+            return DecodeStatus::uncorrectable;
+        }
+
+        errors[j] = 0;
+        if (numerator != 0)
+        {
+            errors[j] = exponentTable[modulo(logarithmTable[numerator] + logPower + fieldSize
+                                             - logarithmTable[denominator])];
+        }
+    }
+
+    // Errors of the parity symbols are not relevant for the data
+    for (size_t j = 0; j < count; j++)
+    {
+        if (locations[j] < numberOfDataSymbols)
+        {
+            data[locations[j] * stride] ^= toDualBasis[errors[j]];
+        }
+    }
+    return DecodeStatus::corrected;
+}
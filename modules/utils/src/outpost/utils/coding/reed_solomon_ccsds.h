@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_CODING_REED_SOLOMON_CCSDS_H
+#define OUTPOST_UTILS_CODING_REED_SOLOMON_CCSDS_H
+
+#include "nand_bch_interface.h"
+
+#include <outpost/base/slice.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace utils
+{
+/**
+ * Single code words of the CCSDS Reed-Solomon (255,223) code.
+ *
+ * Implements the code of CCSDS 131.0-B, section 4, with symbols in the
+ * Berlekamp dual basis. The arithmetic in GF(256) uses constant lookup
+ * tables of 9.5 KiB in total. The parity is computed four symbols per
+ * table access, a received code word is checked by comparing against the
+ * recomputed parity, so error free code words are passed without running
+ * the actual decoder.
+ *
+ * The symbols of a code word are expected at a fixed distance (stride) to
+ * support the symbol interleaving of a code block.
+ *
+ * \see ReedSolomonCcsds
+ */
+class ReedSolomonCcsdsCodeword
+{
+public:
+    static constexpr size_t numberOfSymbols = 255;
+    static constexpr size_t numberOfDataSymbols = 223;
+    static constexpr size_t numberOfParitySymbols = 32;
+
+    /// Number of symbol errors which can be corrected per code word
+    static constexpr size_t correctableErrors = numberOfParitySymbols / 2;
+
+    /**
+     * Calculate the parity symbols of a code word.
+     *
+     * \param data
+     *      First data symbol, the following ones use the given stride.
+     * \param parity
+     *      First parity symbol, the following ones use the given stride.
+     * \param stride
+     *      Distance of consecutive symbols, i.e. the interleaving depth
+     */
+    static void
+    encode(const uint8_t* data, uint8_t* parity, size_t stride);
+
+    /**
+     * Correct the errors of a received code word.
+     *
+     * \param received
+     *      First symbol of the received code word, the parity symbols follow
+     *      the data symbols with the given stride.
+     * \param data
+     *      Copy of the received data symbols with the given stride, errors
+     *      within the data are corrected in place.
+     * \param stride
+     *      Distance of consecutive symbols, i.e. the interleaving depth
+     *
+     * \retval noError
+     *      No error detected, data is unchanged
+     * \retval corrected
+     *      Up to correctableErrors symbols have been corrected
+     * \retval uncorrectable
+     *      More errors than correctable, data is unchanged
+     */
+    static DecodeStatus
+    decode(const uint8_t* received, uint8_t* data, size_t stride);
+
+private:
+    /**
+     * Recompute the parity of the data and add the received parity.
+     *
+     * \return
+     *      true if the remainder is not zero, i.e. an error is detected
+     */
+    static bool
+    computeRemainder(const uint8_t* received, size_t stride, uint8_t* remainder);
+
+    static DecodeStatus
+    correctErrors(const uint8_t* remainder, uint8_t* data, size_t stride);
+};
+
+/**
+ * CCSDS Reed-Solomon (255,223) coding of interleaved code blocks.
+ *
+ * A code block of interleavingDepth code words contains the data symbols
+ * first followed by the parity symbols, both interleaved symbol by symbol:
+ * symbol k of the data (or parity) belongs to code word k % interleavingDepth.
+ * Up to 16 symbol errors can be corrected per code word.
+ *
+ * Shortened code blocks (virtual fill) are not supported.
+ *
+ * \tparam interleavingDepth
+ *      Number of interleaved code words, 1 to 5
+ *
+ * \ingroup coding
+ */
+template <uint8_t interleavingDepth>
+class ReedSolomonCcsds
+{
+    static_assert(interleavingDepth >= 1 && interleavingDepth <= 5,
+                  "CCSDS allows an interleaving depth of 1 to 5");
+
+public:
+    static constexpr size_t numberOfDataBytes =
+            interleavingDepth * ReedSolomonCcsdsCodeword::numberOfDataSymbols;
+    static constexpr size_t numberOfRedundantBytes =
+            interleavingDepth * ReedSolomonCcsdsCodeword::numberOfParitySymbols;
+    static constexpr size_t codeBlockSize = numberOfDataBytes + numberOfRedundantBytes;
+
+    /**
+     * Encode a code block.
+     *
+     * \param data
+     *      numberOfDataBytes of data, may be located at the beginning of
+     *      codeBlock to encode in place.
+     * \param codeBlock
+     *      Buffer for the code block, at least codeBlockSize bytes
+     *
+     * \return
+     *      false if one of the buffers is too small
+     */
+    static bool
+    encode(const outpost::Slice<const uint8_t>& data, const outpost::Slice<uint8_t>& codeBlock);
+
+    /**
+     * Decode a code block.
+     *
+     * The data is copied to the destination in any case, corrected as far
+     * as possible.
+     *
+     * \param codeBlock
+     *      Received code block of codeBlockSize bytes
+     * \param data
+     *      Destination for numberOfDataBytes of decoded data, may be the
+     *      beginning of codeBlock to decode in place.
+     *
+     * \return
+     *      Combined status of all code words, invalidParameters if one of
+     *      the buffers is too small
+     */
+    static DecodeStatus
+    decode(const outpost::Slice<const uint8_t>& codeBlock, const outpost::Slice<uint8_t>& data);
+};
+
+}  // namespace utils
+}  // namespace outpost
+
+#include "reed_solomon_ccsds_impl.h"
+
+#endif
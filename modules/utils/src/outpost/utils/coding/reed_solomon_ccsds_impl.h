@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_CODING_REED_SOLOMON_CCSDS_IMPL_H
+#define OUTPOST_UTILS_CODING_REED_SOLOMON_CCSDS_IMPL_H
+
+#include "reed_solomon_ccsds.h"
+
+#include <string.h>
+
+namespace outpost
+{
+namespace utils
+{
+template <uint8_t interleavingDepth>
+constexpr size_t ReedSolomonCcsds<interleavingDepth>::numberOfDataBytes;
+
+template <uint8_t interleavingDepth>
+constexpr size_t ReedSolomonCcsds<interleavingDepth>::numberOfRedundantBytes;
+
+template <uint8_t interleavingDepth>
+constexpr size_t ReedSolomonCcsds<interleavingDepth>::codeBlockSize;
+
+template <uint8_t interleavingDepth>
+bool
+ReedSolomonCcsds<interleavingDepth>::encode(const outpost::Slice<const uint8_t>& data,
+                                            const outpost::Slice<uint8_t>& codeBlock)
+{
+    if (data.getNumberOfElements() < numberOfDataBytes
+        || codeBlock.getNumberOfElements() < codeBlockSize)
+    {
+        return false;
+    }
+
+    memmove(&codeBlock[0], &data[0], numberOfDataBytes);
+    for (size_t i = 0; i < interleavingDepth; i++)
+    {
+        ReedSolomonCcsdsCodeword::encode(
+                &codeBlock[i], &codeBlock[numberOfDataBytes + i], interleavingDepth);
+    }
+    return true;
+}
+
+template <uint8_t interleavingDepth>
+DecodeStatus
+ReedSolomonCcsds<interleavingDepth>::decode(const outpost::Slice<const uint8_t>& codeBlock,
+                                            const outpost::Slice<uint8_t>& data)
+{
+    if (codeBlock.getNumberOfElements() < codeBlockSize
+        || data.getNumberOfElements() < numberOfDataBytes)
+    {
+        return DecodeStatus::invalidParameters;
+    }
+
+    // Errors are corrected in the destination, the received code block is
+    // only read. When decoding in place the data is not moved at all.
+    memmove(&data[0], &codeBlock[0], numberOfDataBytes);
+
+    DecodeStatus status = DecodeStatus::noError;
+    for (size_t i = 0; i < interleavingDepth; i++)
+    {
+        status = combine(status,
+                         ReedSolomonCcsdsCodeword::decode(
+                                 &codeBlock[i], &data[i], interleavingDepth));
+    }
+    return status;
+}
+
+}  // namespace utils
+}  // namespace outpost
+
+#endif
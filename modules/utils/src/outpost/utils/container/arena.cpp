@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "arena.h"
+
+namespace outpost
+{
+namespace utils
+{
+Arena::Arena(outpost::Slice<uint8_t> memory) :
+    mMemory(memory),
+    mOffset(0),
+    mHighWaterMark(0),
+    mNumberOfFailedAllocations(0)
+{
+}
+
+void*
+Arena::allocateBytes(size_t numberOfBytes, size_t alignment)
+{
+    // Align the address, not only the offset, the memory block itself may
+    // have a smaller alignment.
+    const uintptr_t base = reinterpret_cast<uintptr_t>(mMemory.begin());
+    const uintptr_t address = (base + mOffset + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    const size_t start = address - base;
+
+    if ((start > mMemory.getNumberOfElements())
+        || (numberOfBytes > mMemory.getNumberOfElements() - start))
+    {
+        mNumberOfFailedAllocations++;
+        return nullptr;
+    }
+
+    mOffset = start + numberOfBytes;
+    if (mOffset > mHighWaterMark)
+    {
+        mHighWaterMark = mOffset;
+    }
+    return reinterpret_cast<void*>(address);
+}
+
+}  // namespace utils
+}  // namespace outpost
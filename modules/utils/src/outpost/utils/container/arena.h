@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_ARENA_H
+#define OUTPOST_UTILS_ARENA_H
+
+#include <outpost/base/slice.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <new>
+#include <type_traits>
+
+namespace outpost
+{
+namespace utils
+{
+/**
+ * Monotonic allocator for scratch memory.
+ *
+ * Hands out aligned regions of a fixed memory block by advancing an
+ * offset, there is no per-allocation overhead and no way to free a single
+ * region. All regions are given back at once by reset(), usually at the end
+ * of a processing cycle, or back to a marker to share the memory between
+ * nested stages (see ArenaScope).
+ *
+ * In contrast to a buffer reserved per component, the scratch memory of
+ * stages which do not run at the same time is shared.
+ *
+ * \code
+ * outpost::utils::ArenaStorage<4096> scratch;
+ *
+ * void
+ * processCycle()
+ * {
+ *     outpost::Slice<Fixpoint> buffer = scratch.allocate<Fixpoint>(n);
+ *     ...
+ *     scratch.reset();
+ * }
+ * \endcode
+ *
+ * \warning The arena is not thread-safe. Regions must not be used after
+ *          the arena has been reset, the arena does not check that.
+ */
+class Arena
+{
+public:
+    /// Position within the arena, see getMarker()
+    typedef size_t Marker;
+
+    explicit Arena(outpost::Slice<uint8_t> memory);
+
+    // disable copy constructor
+    Arena(const Arena&) = delete;
+
+    // disable copy assignment operator
+    Arena&
+    operator=(const Arena&) = delete;
+
+    /**
+     * Allocate an array.
+     *
+     * The elements are default initialized, i.e. the values of scalar
+     * types are undefined. As the arena never calls destructors only
+     * trivially destructible types are supported.
+     *
+     * \return Array or an empty slice if not enough memory is left. The
+     *         arena is unchanged in the latter case.
+     */
+    template <typename T>
+    outpost::Slice<T>
+    allocate(size_t numberOfElements);
+
+    /**
+     * Allocate raw memory.
+     *
+     * \param alignment
+     *      Alignment of the region, must be a power of two.
+     *
+     * \return Pointer to the region or nullptr if not enough memory is
+     *         left. A region of zero bytes is a valid allocation.
+     */
+    void*
+    allocateBytes(size_t numberOfBytes, size_t alignment);
+
+    /**
+     * Release all regions.
+     */
+    inline void
+    reset()
+    {
+        mOffset = 0;
+    }
+
+    inline Marker
+    getMarker() const
+    {
+        return mOffset;
+    }
+
+    /**
+     * Release all regions allocated after the marker was taken.
+     */
+    inline void
+    release(Marker marker)
+    {
+        if (marker < mOffset)
+        {
+            mOffset = marker;
+        }
+    }
+
+    inline size_t
+    getCapacity() const
+    {
+        return mMemory.getNumberOfElements();
+    }
+
+    inline size_t
+    getUsedBytes() const
+    {
+        return mOffset;
+    }
+
+    inline size_t
+    getFreeBytes() const
+    {
+        return mMemory.getNumberOfElements() - mOffset;
+    }
+
+    /**
+     * Maximum number of bytes which were in use at the same time.
+     *
+     * Can be used to size the memory block from real usage data.
+     */
+    inline size_t
+    getHighWaterMark() const
+    {
+        return mHighWaterMark;
+    }
+
+    inline uint32_t
+    getNumberOfFailedAllocations() const
+    {
+        return mNumberOfFailedAllocations;
+    }
+
+private:
+    const outpost::Slice<uint8_t> mMemory;
+    size_t mOffset;
+    size_t mHighWaterMark;
+    uint32_t mNumberOfFailedAllocations;
+};
+
+/**
+ * Releases all regions allocated during the lifetime of the scope.
+ *
+ * \code
+ * void
+ * Stage::process(outpost::utils::Arena& scratch)
+ * {
+ *     outpost::utils::ArenaScope scope(scratch);
+ *     outpost::Slice<int16_t> temporary = scratch.allocate<int16_t>(n);
+ *     ...
+ * }
+ * \endcode
+ */
+class ArenaScope
+{
+public:
+    explicit ArenaScope(Arena& arena) : mArena(arena), mMarker(arena.getMarker())
+    {
+    }
+
+    ~ArenaScope()
+    {
+        mArena.release(mMarker);
+    }
+
+    // disable copy constructor
+    ArenaScope(const ArenaScope&) = delete;
+
+    // disable copy assignment operator
+    ArenaScope&
+    operator=(const ArenaScope&) = delete;
+
+private:
+    Arena& mArena;
+    const Arena::Marker mMarker;
+};
+
+/**
+ * Arena with a memory block of \p N bytes.
+ */
+template <size_t N>
+class ArenaStorage : public Arena
+{
+public:
+    ArenaStorage() : Arena(outpost::asSlice(mStorage))
+    {
+    }
+
+private:
+    // Aligned for 64 bit types, so that the alignment of the first region
+    // does not waste memory
+    alignas(alignof(uint64_t)) uint8_t mStorage[N];
+};
+
+// ----------------------------------------------------------------------------
+template <typename T>
+outpost::Slice<T>
+Arena::allocate(size_t numberOfElements)
+{
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "The arena does not call destructors");
+
+    if (numberOfElements > getCapacity() / sizeof(T))
+    {
+        mNumberOfFailedAllocations++;
+        return outpost::Slice<T>::empty();
+    }
+
+    void* memory = allocateBytes(numberOfElements * sizeof(T), alignof(T));
+    if (memory == nullptr)
+    {
+        return outpost::Slice<T>::empty();
+    }
+
+    T* elements = static_cast<T*>(memory);
+    for (size_t i = 0; i < numberOfElements; ++i)
+    {
+        new (&elements[i]) T;
+    }
+    return outpost::Slice<T>::unsafe(elements, numberOfElements);
+}
+
+}  // namespace utils
+}  // namespace outpost
+
+#endif
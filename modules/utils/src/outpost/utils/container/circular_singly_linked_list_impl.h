@@ -163,18 +163,23 @@ outpost::CircularSinglyLinkedList<T>::insert(T* node)
     else
     {
         // Traverse list until the list ends or a "bigger" entry is found.
+        // The head is the last entry, the search starts with its successor,
+        // the first entry.
         T* current = mHead;
         T* result = 0;
         do
         {
-            current = current->mNext;
             if (*node < *current->mNext)
             {
                 result = current;
             }
+            else
+            {
+                current = current->mNext;
+            }
         } while ((result == 0) && (current != mHead));
 
-        if ((result == 0) || (current == mHead))
+        if (result == 0)
         {
             // Add to end of the list, move head pointer to the new entry
             node->mNext = mHead->mNext;
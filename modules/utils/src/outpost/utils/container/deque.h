@@ -21,9 +21,6 @@
 #include <stddef.h>
 #include <stdint.h>
 
-// Needed for memcpy
-#include <string.h>
-
 namespace outpost
 {
 enum class DequeAppendStrategy
@@ -132,17 +129,52 @@ public:
      * until it is full.
      * Otherwise the append operation is aborted completely.
      *
+     * Trivially copyable types are copied with at most two calls to
+     * memcpy, one before and one after the end of the ring buffer.
+     *
      * \param values
      *      A slice to append to the deque.
      *
      * \result Number of appended values.
      */
     size_t
-    append(outpost::Slice<T> values);
+    append(outpost::Slice<const T> values);
 
     bool
     prepend(const T& value);
 
+    /**
+     * Prepend a list of elements to the queue.
+     *
+     * Afterwards the first value of the slice is the front of the queue,
+     * the order of the values is kept. If the append strategy is set to
+     * `partial` and not enough space is available, only the last values of
+     * the slice are prepended until the queue is full.
+     *
+     * \result Number of prepended values.
+     */
+    size_t
+    prepend(outpost::Slice<const T> values);
+
+    /**
+     * Copy elements from the front of the queue without removing them.
+     *
+     * \param values
+     *      Destination, at most `getSize()` elements are copied.
+     *
+     * \result Number of copied values.
+     */
+    size_t
+    peek(outpost::Slice<T> values) const;
+
+    /**
+     * Copy elements from the front of the queue and remove them.
+     *
+     * \result Number of removed values.
+     */
+    size_t
+    pop(outpost::Slice<T> values);
+
     void
     removeBack();
 
@@ -150,6 +182,13 @@ public:
     removeFront();
 
 private:
+    /// Number of values of a slice which can be added with the strategy
+    inline Size
+    getNumberOfElementsToAdd(Size numberOfElements) const;
+
+    inline Index
+    wrap(Index index) const;
+
     T* const mBuffer;
     const Size mMaxSize;
 
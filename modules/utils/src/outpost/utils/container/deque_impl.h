@@ -137,50 +137,56 @@ Deque<T, strategy>::append(const T& value)
 }
 
 template <typename T, DequeAppendStrategy strategy>
-size_t
-Deque<T, strategy>::append(outpost::Slice<T> values)
+typename Deque<T, strategy>::Size
+Deque<T, strategy>::getNumberOfElementsToAdd(Size numberOfElements) const
 {
-    Size elementsToAppend = 0;
-    if (!isFull())
+    if (numberOfElements > (mMaxSize - mSize))
     {
-        Index head = mHead + 1;
-
-        // Get number of elements until end of ring buffer
-        Size elementsUntilEndOfBuffer = mMaxSize - head;
-
-        // Get number of elements to copy until overflow happens
-        elementsToAppend = values.getNumberOfElements();
-        if (elementsToAppend > (mMaxSize - mSize))
+        if (strategy == DequeAppendStrategy::partial)
+        {
+            numberOfElements = mMaxSize - mSize;
+        }
+        else
         {
-            if (strategy == DequeAppendStrategy::partial)
-            {
-                elementsToAppend = mMaxSize - mSize;
-            }
-            else
-            {
-                // Do not append anything if not everything can be added.
-                elementsToAppend = 0;
-            }
+            // Do not add anything if not everything can be added.
+            numberOfElements = 0;
         }
+    }
+    return numberOfElements;
+}
+
+template <typename T, DequeAppendStrategy strategy>
+typename Deque<T, strategy>::Index
+Deque<T, strategy>::wrap(Index index) const
+{
+    return (index >= mMaxSize) ? (index - mMaxSize) : index;
+}
+
+template <typename T, DequeAppendStrategy strategy>
+size_t
+Deque<T, strategy>::append(outpost::Slice<const T> values)
+{
+    const Size elementsToAppend = getNumberOfElementsToAdd(values.getNumberOfElements());
+    if (elementsToAppend > 0)
+    {
+        const Index head = wrap(mHead + 1);
+        const outpost::Slice<T> buffer = outpost::Slice<T>::unsafe(mBuffer, mMaxSize);
 
         // Two cases:
-        // 1. All elements has place in the end of the ring buffer, or fill up
-        // all slots in the end and remaining elements should copy to the begin
-        // of the ring buffer.
+        // 1. All elements has place in the end of the ring buffer.
+        // 2. Fill up all slots in the end and copy the remaining elements
+        // to the begin of the ring buffer.
+        const Size elementsUntilEndOfBuffer = mMaxSize - head;
         if (elementsToAppend <= elementsUntilEndOfBuffer)
         {
-            // Copy only to the end of the ring buffer
-            memcpy(&mBuffer[head], values.begin(), sizeof(T) * elementsToAppend);
+            buffer.skipFirst(head).copyFrom(values.first(elementsToAppend));
             mHead = head + elementsToAppend - 1;
         }
         else
         {
-            // 2. Split the elements to copy into two slices, one in the end,
-            // other in the begin of array.
-            memcpy(&mBuffer[head], values.begin(), sizeof(T) * elementsUntilEndOfBuffer);
-            memcpy(&mBuffer[0],
-                   &(values[elementsUntilEndOfBuffer]),
-                   sizeof(T) * (elementsToAppend - elementsUntilEndOfBuffer));
+            buffer.skipFirst(head).copyFrom(values.first(elementsUntilEndOfBuffer));
+            buffer.copyFrom(values.subSlice(elementsUntilEndOfBuffer,
+                                            elementsToAppend - elementsUntilEndOfBuffer));
             mHead = elementsToAppend - elementsUntilEndOfBuffer - 1;
         }
 
@@ -190,6 +196,77 @@ Deque<T, strategy>::append(outpost::Slice<T> values)
     return elementsToAppend;
 }
 
+template <typename T, DequeAppendStrategy strategy>
+size_t
+Deque<T, strategy>::prepend(outpost::Slice<const T> values)
+{
+    const Size elementsToPrepend = getNumberOfElementsToAdd(values.getNumberOfElements());
+    if (elementsToPrepend > 0)
+    {
+        // The last values are next to the current front
+        values = values.last(elementsToPrepend);
+
+        const Index tail = wrap(mTail + mMaxSize - elementsToPrepend);
+        const outpost::Slice<T> buffer = outpost::Slice<T>::unsafe(mBuffer, mMaxSize);
+
+        const Size elementsUntilEndOfBuffer = mMaxSize - tail;
+        if (elementsToPrepend <= elementsUntilEndOfBuffer)
+        {
+            buffer.skipFirst(tail).copyFrom(values);
+        }
+        else
+        {
+            buffer.skipFirst(tail).copyFrom(values.first(elementsUntilEndOfBuffer));
+            buffer.copyFrom(values.skipFirst(elementsUntilEndOfBuffer));
+        }
+
+        mTail = tail;
+        mSize += elementsToPrepend;
+    }
+
+    return elementsToPrepend;
+}
+
+template <typename T, DequeAppendStrategy strategy>
+size_t
+Deque<T, strategy>::peek(outpost::Slice<T> values) const
+{
+    const Size elementsToCopy =
+            (values.getNumberOfElements() < mSize) ? values.getNumberOfElements() : mSize;
+    if (elementsToCopy > 0)
+    {
+        const outpost::Slice<const T> buffer = outpost::Slice<const T>::unsafe(mBuffer, mMaxSize);
+
+        const Size elementsUntilEndOfBuffer = mMaxSize - mTail;
+        if (elementsToCopy <= elementsUntilEndOfBuffer)
+        {
+            values.copyFrom(buffer.subSlice(mTail, elementsToCopy));
+        }
+        else
+        {
+            values.copyFrom(buffer.skipFirst(mTail));
+            values.skipFirst(elementsUntilEndOfBuffer)
+                    .copyFrom(buffer.first(elementsToCopy - elementsUntilEndOfBuffer));
+        }
+    }
+
+    return elementsToCopy;
+}
+
+template <typename T, DequeAppendStrategy strategy>
+size_t
+Deque<T, strategy>::pop(outpost::Slice<T> values)
+{
+    const Size elementsToRemove = peek(values);
+    if (elementsToRemove > 0)
+    {
+        mTail = wrap(mTail + elementsToRemove);
+        mSize -= elementsToRemove;
+    }
+
+    return elementsToRemove;
+}
+
 template <typename T, DequeAppendStrategy strategy>
 void
 Deque<T, strategy>::removeBack()
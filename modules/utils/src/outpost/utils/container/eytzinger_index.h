@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_EYTZINGER_INDEX_H
+#define OUTPOST_UTILS_EYTZINGER_INDEX_H
+
+#include <outpost/base/slice.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+/**
+ * Search index over the keys of a sorted array.
+ *
+ * The keys are copied into a separate array in Eytzinger (breadth-first
+ * binary tree) order: the children of the node at position k are stored
+ * at 2k and 2k+1. A search therefore only touches the densely packed keys
+ * instead of whole entries, the first levels of the tree share a few
+ * cache lines, and the next levels can be prefetched. The search loop
+ * has no data dependent branches.
+ *
+ * The index does not allocate memory, the storage has to be provided,
+ * see `EytzingerIndexStorage`.
+ *
+ * \tparam Key
+ *      Key type, must provide `operator<` and `operator==`.
+ */
+template <typename Key>
+class EytzingerIndex
+{
+public:
+    /**
+     * \param keys
+     *      Storage for the keys.
+     * \param positions
+     *      Storage for the position of each key in the sorted array.
+     *
+     * Both must have one element more than the maximum number of entries.
+     */
+    EytzingerIndex(outpost::Slice<Key> keys, outpost::Slice<size_t> positions);
+
+    // disable copy constructor
+    EytzingerIndex(const EytzingerIndex&) = delete;
+
+    // disable copy assignment operator
+    EytzingerIndex&
+    operator=(const EytzingerIndex&) = delete;
+
+    /**
+     * Build the index over the `mKey` member of the given entries.
+     *
+     * \param entries
+     *      Entries ordered by ascending `mKey` value.
+     *
+     * \retval false
+     *      The storage is too small, the index is empty.
+     */
+    template <typename Entry>
+    bool
+    build(outpost::Slice<const Entry> entries);
+
+    /**
+     * Find the position of a key in the sorted array.
+     *
+     * \return
+     *      Index of the entry with the key or getNumberOfElements() if
+     *      the key is not part of the index.
+     */
+    size_t
+    find(Key key) const;
+
+    inline size_t
+    getNumberOfElements() const
+    {
+        return mNumberOfElements;
+    }
+
+    /**
+     * Maximum number of keys for the given storage.
+     */
+    inline size_t
+    getCapacity() const
+    {
+        return mCapacity;
+    }
+
+private:
+    static inline size_t
+    calculateCapacity(size_t numberOfKeys, size_t numberOfPositions)
+    {
+        const size_t size = (numberOfKeys < numberOfPositions) ? numberOfKeys : numberOfPositions;
+        // position zero is not used
+        return (size > 0) ? (size - 1) : 0;
+    }
+
+    template <typename Entry>
+    size_t
+    fill(const Entry* entries, size_t sortedIndex, size_t position);
+
+    Key* const mKeys;
+    size_t* const mPositions;
+    const size_t mCapacity;
+    size_t mNumberOfElements;
+};
+
+/**
+ * Eytzinger index with storage for up to N keys.
+ */
+template <typename Key, size_t N>
+class EytzingerIndexStorage : public EytzingerIndex<Key>
+{
+public:
+    EytzingerIndexStorage() :
+        EytzingerIndex<Key>(outpost::asSlice(mKeyStorage), outpost::asSlice(mPositionStorage))
+    {
+    }
+
+private:
+    Key mKeyStorage[N + 1];
+    size_t mPositionStorage[N + 1];
+};
+
+}  // namespace outpost
+
+#include "eytzinger_index_impl.h"
+
+#endif
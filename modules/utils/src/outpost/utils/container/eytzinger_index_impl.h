@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_EYTZINGER_INDEX_IMPL_H
+#define OUTPOST_UTILS_EYTZINGER_INDEX_IMPL_H
+
+#include "eytzinger_index.h"
+
+template <typename Key>
+outpost::EytzingerIndex<Key>::EytzingerIndex(outpost::Slice<Key> keys,
+                                             outpost::Slice<size_t> positions) :
+    mKeys(&keys[0]),
+    mPositions(&positions[0]),
+    mCapacity(calculateCapacity(keys.getNumberOfElements(), positions.getNumberOfElements())),
+    mNumberOfElements(0)
+{
+}
+
+template <typename Key>
+template <typename Entry>
+bool
+outpost::EytzingerIndex<Key>::build(outpost::Slice<const Entry> entries)
+{
+    if (entries.getNumberOfElements() > mCapacity)
+    {
+        mNumberOfElements = 0;
+        return false;
+    }
+    mNumberOfElements = entries.getNumberOfElements();
+    if (mNumberOfElements > 0)
+    {
+        fill(&entries[0], 0, 1);
+    }
+    return true;
+}
+
+template <typename Key>
+template <typename Entry>
+size_t
+outpost::EytzingerIndex<Key>::fill(const Entry* entries, size_t sortedIndex, size_t position)
+{
+    // In-order traversal of the implicit tree, the recursion depth is
+    // limited to log2 of the number of elements.
+    if (position <= mNumberOfElements)
+    {
+        sortedIndex = fill(entries, sortedIndex, 2 * position);
+        mKeys[position] = entries[sortedIndex].mKey;
+        mPositions[position] = sortedIndex;
+        sortedIndex = fill(entries, sortedIndex + 1, 2 * position + 1);
+    }
+    return sortedIndex;
+}
+
+template <typename Key>
+size_t
+outpost::EytzingerIndex<Key>::find(Key key) const
+{
+    size_t position = 1;
+    while (position <= mNumberOfElements)
+    {
+#if defined(__GNUC__)
+        // Fetch the node four levels below, which shares the cache line
+        // with its siblings. Limited to the existing keys.
+        const size_t ahead = 16 * position;
+        __builtin_prefetch(&mKeys[(ahead <= mNumberOfElements) ? ahead : 0]);
+#endif
+        position = 2 * position + ((mKeys[position] < key) ? 1 : 0);
+    }
+
+    // Going up the tree to the last node where the search went left,
+    // which is the smallest key not less than the search key.
+#if defined(__GNUC__)
+    position >>= __builtin_ctzl(~static_cast<unsigned long>(position)) + 1;
+#else
+    while (position & 1)
+    {
+        position >>= 1;
+    }
+    position >>= 1;
+#endif
+
+    if ((position == 0) || !(mKeys[position] == key))
+    {
+        return mNumberOfElements;
+    }
+    return mPositions[position];
+}
+
+#endif
@@ -14,6 +14,8 @@
 #ifndef OUTPOST_UTILS_FIXED_ORDERED_MAP_H
 #define OUTPOST_UTILS_FIXED_ORDERED_MAP_H
 
+#include "eytzinger_index.h"
+
 #include <outpost/base/slice.h>
 #include <outpost/utils/iterator.h>
 
@@ -36,6 +38,11 @@ namespace outpost
  *
  * The `mKey` member is used to find a specific entry in the list of entries.
  *
+ * For large maps an `EytzingerIndex` can be given, which holds a copy of
+ * the keys in a cache friendly order. The search then only touches the
+ * keys and the entry which was found. The keys of the entries must not be
+ * changed afterwards.
+ *
  * \author  Fabian Greif
  */
 template <typename Entry, typename Key>
@@ -52,7 +59,10 @@ public:
      *      C style array of entries.
      */
     template <size_t N>
-    explicit inline FixedOrderedMap(Entry (&entries)[N]) : mEntries(entries), mNumberOfEntries(N)
+    explicit inline FixedOrderedMap(Entry (&entries)[N]) :
+        mEntries(entries),
+        mNumberOfEntries(N),
+        mIndex(nullptr)
     {
     }
 
@@ -70,8 +80,29 @@ public:
 
     explicit inline FixedOrderedMap(Slice<Entry> array) :
         mEntries(&array[0]),
-        mNumberOfEntries(array.getNumberOfElements())
+        mNumberOfEntries(array.getNumberOfElements()),
+        mIndex(nullptr)
+    {
+    }
+
+    /**
+     * Create a map with an search index over the keys.
+     *
+     * \param array
+     *      Entries ordered with ascending mKey value.
+     * \param index
+     *      Index which is build over the keys of the entries. Falls back
+     *      to a binary search over the entries if the index is too small.
+     */
+    FixedOrderedMap(Slice<Entry> array, EytzingerIndex<Key>& index);
+
+    /**
+     * Check if the search uses an index.
+     */
+    inline bool
+    hasIndex() const
     {
+        return mIndex != nullptr;
     }
 
     /**
@@ -88,7 +119,8 @@ public:
     /**
      * Find a entry.
      *
-     * Uses a binary search over the list of entries.
+     * Uses the index if available, otherwise a binary search over the
+     * list of entries.
      *
      * \param key
      *      Key identifying the entry.
@@ -142,6 +174,7 @@ public:
 private:
     Entry* const mEntries;
     const size_t mNumberOfEntries;
+    const EytzingerIndex<Key>* mIndex;
 };
 
 }  // namespace outpost
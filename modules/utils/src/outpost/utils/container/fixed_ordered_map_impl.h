@@ -19,14 +19,34 @@
 template <typename Entry, typename Key>
 outpost::FixedOrderedMap<Entry, Key>::FixedOrderedMap(Entry* entries, size_t numberOfEntries) :
     mEntries(entries),
-    mNumberOfEntries(numberOfEntries)
+    mNumberOfEntries(numberOfEntries),
+    mIndex(nullptr)
 {
 }
 
+template <typename Entry, typename Key>
+outpost::FixedOrderedMap<Entry, Key>::FixedOrderedMap(Slice<Entry> array,
+                                                      EytzingerIndex<Key>& index) :
+    mEntries(&array[0]),
+    mNumberOfEntries(array.getNumberOfElements()),
+    mIndex(nullptr)
+{
+    if (index.build(Slice<const Entry>(array)))
+    {
+        mIndex = &index;
+    }
+}
+
 template <typename Entry, typename Key>
 const Entry*
 outpost::FixedOrderedMap<Entry, Key>::getEntry(Key key) const
 {
+    if (mIndex != nullptr)
+    {
+        const size_t position = mIndex->find(key);
+        return (position < mNumberOfEntries) ? &mEntries[position] : 0;
+    }
+
     int imax = static_cast<int>(mNumberOfEntries) - 1;
     int imin = 0;
 
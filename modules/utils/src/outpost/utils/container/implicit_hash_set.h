@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_IMPLICIT_HASH_SET_H
+#define OUTPOST_UTILS_IMPLICIT_HASH_SET_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+/**
+ * Static intrusive hash set.
+ *
+ * Counterpart to ImplicitList for objects which are searched by a key,
+ * e.g. an ID. The objects add themselves to the set during construction
+ * and are found in O(1) on average instead of walking the list of all
+ * objects. The buckets are a plain array of pointers, no memory is
+ * allocated.
+ *
+ * \code
+ * class Parameter : public ImplicitList<Parameter>,
+ *                   public ImplicitHashSet<Parameter, uint16_t, 32>
+ * {
+ * public:
+ *     explicit Parameter(uint16_t id) :
+ *         ImplicitList<Parameter>(listOfAllParameters, this),
+ *         ImplicitHashSet<Parameter, uint16_t, 32>(setOfAllParameters, this, id)
+ *     {
+ *     }
+ *
+ *     ~Parameter()
+ *     {
+ *         removeFromList(&listOfAllParameters, this);
+ *         removeFromSet(setOfAllParameters, this);
+ *     }
+ *
+ *     static Parameter*
+ *     find(uint16_t id)
+ *     {
+ *         return ImplicitHashSet<Parameter, uint16_t, 32>::find(setOfAllParameters, id);
+ *     }
+ *
+ *     static Parameter* listOfAllParameters;
+ *     static Buckets setOfAllParameters;
+ * };
+ * \endcode
+ *
+ * Like ImplicitList this relies on the buckets being zero-initialized
+ * static variables, which happens before any constructor is called, see
+ * implicit_list.h.
+ *
+ * Elements with equal keys may be added, find() returns the one added
+ * last.
+ *
+ * \tparam T
+ *      Element type, must derive from ImplicitHashSet.
+ * \tparam Key
+ *      Integral or enumeration type of the key.
+ * \tparam numberOfBuckets
+ *      Number of buckets, must be a power of two. Should be chosen in the
+ *      order of the expected number of elements.
+ */
+template <typename T, typename Key, size_t numberOfBuckets>
+class ImplicitHashSet
+{
+    static_assert((numberOfBuckets > 0) && ((numberOfBuckets & (numberOfBuckets - 1)) == 0),
+                  "Number of buckets must be a power of two");
+    static_assert(numberOfBuckets <= 65536, "Number of buckets must not exceed 2^16");
+
+public:
+    typedef T* Buckets[numberOfBuckets];
+
+    /**
+     * Add element to the set.
+     *
+     * \param buckets
+     *         Set to which to add the element.
+     * \param element
+     *         Element to add to the set (mostly \c this).
+     * \param key
+     *         Key by which the element is found.
+     */
+    inline ImplicitHashSet(Buckets& buckets, T* element, Key key) :
+        mNextInBucket(buckets[getBucket(key)]), mHashKey(key)
+    {
+        buckets[getBucket(key)] = element;
+    }
+
+    /**
+     * Get the key by which the element is stored.
+     */
+    inline Key
+    getHashKey() const
+    {
+        return mHashKey;
+    }
+
+    /**
+     * Find an element by its key.
+     *
+     * O(1) on average.
+     *
+     * \return  Element or nullptr if no element with the key is part of the set.
+     */
+    static inline T*
+    find(const Buckets& buckets, Key key)
+    {
+        T* element = buckets[getBucket(key)];
+        while ((element != nullptr) && !(element->ImplicitHashSet::mHashKey == key))
+        {
+            element = element->ImplicitHashSet::mNextInBucket;
+        }
+        return element;
+    }
+
+    /**
+     * Remove an element from the set.
+     *
+     * Does nothing if the element is not part of the set.
+     *
+     * \param buckets
+     *         Set from which to remove the element.
+     * \param element
+     *         Element to remove.
+     */
+    static inline void
+    removeFromSet(Buckets& buckets, T* element)
+    {
+        T** node = &buckets[getBucket(element->ImplicitHashSet::mHashKey)];
+        while ((*node != nullptr) && (*node != element))
+        {
+            node = &(*node)->ImplicitHashSet::mNextInBucket;
+        }
+
+        if (*node != nullptr)
+        {
+            *node = element->ImplicitHashSet::mNextInBucket;
+        }
+    }
+
+    /**
+     * Bucket of a key.
+     *
+     * Fibonacci hashing, keys with a regular pattern (e.g. IDs which are
+     * multiples of 16) are spread over all buckets.
+     */
+    static inline size_t
+    getBucket(Key key)
+    {
+        const uint32_t hash = static_cast<uint32_t>(key) * 2654435769U;
+        return static_cast<size_t>(hash >> 16) & (numberOfBuckets - 1);
+    }
+
+private:
+    // disable copy constructor
+    ImplicitHashSet(const ImplicitHashSet&);
+
+    // disable assignment operator
+    ImplicitHashSet&
+    operator=(const ImplicitHashSet&);
+
+    /// Pointer to the next element of the same bucket
+    T* mNextInBucket;
+    const Key mHashKey;
+};
+
+}  // namespace outpost
+
+#endif
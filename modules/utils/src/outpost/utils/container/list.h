@@ -153,6 +153,8 @@ public:
      * shall produce a strict weak ordering of the elements.
      *
      * O(N)
+     *
+     * \see    SkipList for long sorted lists
      */
     void
     insert(T* node);
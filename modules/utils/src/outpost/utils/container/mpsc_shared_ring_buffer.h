@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_MPSC_SHARED_RING_BUFFER_H
+#define OUTPOST_UTILS_MPSC_SHARED_RING_BUFFER_H
+
+#include "shared_buffer.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/rtos/atomic.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <utility>
+
+namespace outpost
+{
+namespace utils
+{
+/**
+ * \ingroup SharedBuffer
+ * \brief Lock-free ring buffer for SharedBuffers with multiple producers
+ * and a single consumer.
+ *
+ * Several threads (e.g. protocol handlers) may append at the same time,
+ * a single thread (e.g. the downlink sender) removes the elements. No mutex
+ * is involved:
+ *
+ * - A producer reserves a slot by atomically advancing the write position
+ *   and afterwards publishes the slot by updating its sequence number.
+ * - The consumer only takes a slot once its sequence number shows that the
+ *   producer has finished writing it, and hands it back to the producers by
+ *   updating the sequence number again.
+ *
+ * Like `SharedRingBuffer` each element carries a byte of flags. In contrast
+ * to it the buffer does not block and there is no access to elements
+ * other than the oldest one.
+ *
+ * The number of slots must be a power of two, otherwise only the largest
+ * power of two below the number of provided slots is used.
+ *
+ * \warning Only one thread may call the consumer functions `pop()`,
+ *          `isEmpty()` and `reset()`.
+ */
+class MpscSharedRingBuffer
+{
+public:
+    struct Slot
+    {
+        Slot() : mSequence(0), mPointer(), mFlags(0)
+        {
+        }
+
+        // disable copy constructor
+        Slot(const Slot&) = delete;
+
+        // disable copy assignment operator
+        Slot&
+        operator=(const Slot&) = delete;
+
+        /// Position for which the slot is free (equal) or holds data (one more)
+        outpost::rtos::Atomic<size_t> mSequence;
+        SharedBufferPointer mPointer;
+        uint8_t mFlags;
+    };
+
+    /**
+     * \param slots
+     *      Storage for the elements. Without any slot the buffer is always
+     *      full and empty.
+     */
+    explicit MpscSharedRingBuffer(outpost::Slice<Slot> slots) :
+        mSlots((slots.getNumberOfElements() == 0) ? outpost::Slice<Slot>::unsafe(&mNoSlot, 1)
+                                                   : slots),
+        mMask(getPowerOfTwo(slots.getNumberOfElements()) - 1),
+        mWritePosition(0),
+        mReadPosition(0),
+        mNoSlot()
+    {
+        if (slots.getNumberOfElements() == 0)
+        {
+            // Never free for a producer and never published for the consumer
+            mNoSlot.mSequence.store(SIZE_MAX);
+        }
+        else
+        {
+            for (size_t i = 0; i <= mMask; ++i)
+            {
+                mSlots[i].mSequence.store(i);
+            }
+        }
+    }
+
+    virtual ~MpscSharedRingBuffer() = default;
+
+    // disable copy constructor
+    MpscSharedRingBuffer(const MpscSharedRingBuffer&) = delete;
+
+    // disable copy assignment operator
+    MpscSharedRingBuffer&
+    operator=(const MpscSharedRingBuffer&) = delete;
+
+    /**
+     * Store an element, may be called by any thread.
+     *
+     * \return Returns true if the element could be stored, false if the
+     * buffer is full.
+     */
+    inline bool
+    append(const SharedBufferPointer& p, uint8_t flags = 0)
+    {
+        Slot* slot = reserve();
+        if (slot == nullptr)
+        {
+            return false;
+        }
+        slot->mPointer = p;
+        publish(*slot, flags);
+        return true;
+    }
+
+    /**
+     * Move an element into the buffer, may be called by any thread.
+     *
+     * \p p is only moved from if it could be stored.
+     */
+    inline bool
+    append(SharedBufferPointer&& p, uint8_t flags = 0)
+    {
+        Slot* slot = reserve();
+        if (slot == nullptr)
+        {
+            return false;
+        }
+        slot->mPointer = std::move(p);
+        publish(*slot, flags);
+        return true;
+    }
+
+    /**
+     * Move the oldest element out of the buffer.
+     *
+     * An element which is currently written by a producer is not visible
+     * yet, even if producers which started later already have finished.
+     *
+     * \return Returns true if an element was removed, false if no element
+     * was available.
+     */
+    inline bool
+    pop(SharedBufferPointer& p, uint8_t& flags)
+    {
+        Slot& slot = mSlots[mReadPosition & mMask];
+        if (slot.mSequence.load() != mReadPosition + 1)
+        {
+            return false;
+        }
+        p = std::move(slot.mPointer);
+        slot.mPointer = SharedBufferPointer();
+        flags = slot.mFlags;
+
+        // Hand the slot back to the producers for the next round
+        slot.mSequence.store(mReadPosition + mMask + 1);
+        ++mReadPosition;
+        return true;
+    }
+
+    inline bool
+    pop(SharedBufferPointer& p)
+    {
+        uint8_t flags;
+        return pop(p, flags);
+    }
+
+    inline bool
+    isEmpty() const
+    {
+        return mSlots[mReadPosition & mMask].mSequence.load() != mReadPosition + 1;
+    }
+
+    /**
+     * Number of reserved slots, includes elements which are still being
+     * written. Only a snapshot if producers are active.
+     */
+    inline size_t
+    getUsedSlots() const
+    {
+        return mWritePosition.load() - mReadPosition;
+    }
+
+    inline size_t
+    getFreeSlots() const
+    {
+        return getCapacity() - getUsedSlots();
+    }
+
+    inline size_t
+    getCapacity() const
+    {
+        return (&mSlots[0] == &mNoSlot) ? 0 : mMask + 1;
+    }
+
+    /**
+     * Remove all published elements.
+     */
+    inline void
+    reset()
+    {
+        SharedBufferPointer p;
+        while (pop(p))
+        {
+        }
+    }
+
+private:
+    static inline size_t
+    getPowerOfTwo(size_t n)
+    {
+        size_t value = 1;
+        while ((value * 2 > value) && (value * 2 <= n))
+        {
+            value *= 2;
+        }
+        return value;
+    }
+
+    inline Slot*
+    reserve()
+    {
+        size_t position = mWritePosition.load();
+        while (true)
+        {
+            Slot& slot = mSlots[position & mMask];
+            const size_t sequence = slot.mSequence.load();
+            if (sequence == position)
+            {
+                // Slot is free, try to claim the position. On failure the
+                // current write position is loaded into `position`.
+                if (mWritePosition.compareAndSwap(position, position + 1))
+                {
+                    return &slot;
+                }
+            }
+            else if (static_cast<ptrdiff_t>(sequence - position) < 0)
+            {
+                // Slot still holds the element of the previous round
+                return nullptr;
+            }
+            else
+            {
+                // Another producer has claimed the position in the meantime
+                position = mWritePosition.load();
+            }
+        }
+    }
+
+    inline void
+    publish(Slot& slot, uint8_t flags)
+    {
+        slot.mFlags = flags;
+        slot.mSequence.store(slot.mSequence.load() + 1);
+    }
+
+    const outpost::Slice<Slot> mSlots;
+    const size_t mMask;
+
+    outpost::rtos::Atomic<size_t> mWritePosition;
+
+    /// Only used by the consumer
+    size_t mReadPosition;
+
+    /// Placeholder for an empty slot storage, keeps the index arithmetic valid
+    Slot mNoSlot;
+};
+
+namespace internal
+{
+// Constructed before the ring buffer, which initializes the slots
+template <size_t numberOfElements>
+class MpscSharedRingBufferSlots
+{
+protected:
+    MpscSharedRingBuffer::Slot mSlotStorage[numberOfElements];
+};
+}  // namespace internal
+
+/**
+ * \ingroup SharedBuffer
+ * Storage provider for the MpscSharedRingBuffer.
+ *
+ * \tparam numberOfElements
+ *      Maximum number of elements, must be a power of two.
+ */
+template <size_t numberOfElements>
+class MpscSharedRingBufferStorage : private internal::MpscSharedRingBufferSlots<numberOfElements>,
+                                    public MpscSharedRingBuffer
+{
+    static_assert((numberOfElements > 0) && ((numberOfElements & (numberOfElements - 1)) == 0),
+                  "Number of elements must be a power of two");
+
+public:
+    inline MpscSharedRingBufferStorage() :
+        MpscSharedRingBuffer(outpost::asSlice(
+                internal::MpscSharedRingBufferSlots<numberOfElements>::mSlotStorage))
+    {
+    }
+
+    virtual ~MpscSharedRingBufferStorage() = default;
+};
+
+}  // namespace utils
+}  // namespace outpost
+
+#endif
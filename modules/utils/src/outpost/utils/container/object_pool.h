@@ -0,0 +1,476 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_OBJECT_POOL_H
+#define OUTPOST_UTILS_OBJECT_POOL_H
+
+#include <outpost/rtos/atomic.h>
+#include <outpost/rtos/mutex.h>
+#include <outpost/rtos/mutex_guard.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace outpost
+{
+namespace utils
+{
+template <typename T>
+class ObjectPoolBase;
+
+template <typename T>
+class ObjectPointer;
+
+namespace internal
+{
+/**
+ * Storage for one object of an ObjectPool together with its management
+ * data.
+ */
+template <typename T>
+class ObjectPoolSlot
+{
+public:
+    ObjectPoolSlot() : mReferenceCounter(0), mOwner(nullptr), mNextFree(nullptr)
+    {
+    }
+
+    // disable copy constructor
+    ObjectPoolSlot(const ObjectPoolSlot&) = delete;
+
+    // disable copy assignment operator
+    ObjectPoolSlot&
+    operator=(const ObjectPoolSlot&) = delete;
+
+    inline T*
+    getObject()
+    {
+        return reinterpret_cast<T*>(&mStorage);
+    }
+
+    /// Same lock-free reference counting as used by SharedBuffer
+    inline void
+    incrementCount()
+    {
+        mReferenceCounter.fetchAdd(1);
+    }
+
+    void
+    decrementCount();
+
+    outpost::rtos::Atomic<size_t> mReferenceCounter;
+    ObjectPoolBase<T>* mOwner;
+
+    /// Link for the free list, only valid while the slot is unused
+    ObjectPoolSlot* mNextFree;
+
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type mStorage;
+};
+}  // namespace internal
+
+/**
+ * \ingroup SharedBuffer
+ * \brief Reference counted handle to an object of an ObjectPool.
+ *
+ * Works like SharedBufferPointer: copying the handle increments the
+ * reference count, the object is destroyed and its slot is returned to
+ * the pool when the last handle is dropped.
+ */
+template <typename T>
+class ObjectPointer
+{
+public:
+    ObjectPointer() : mSlot(nullptr)
+    {
+    }
+
+    ObjectPointer(const ObjectPointer& other) : mSlot(other.mSlot)
+    {
+        if (mSlot != nullptr)
+        {
+            mSlot->incrementCount();
+        }
+    }
+
+    ObjectPointer(ObjectPointer&& other) : mSlot(other.mSlot)
+    {
+        other.mSlot = nullptr;
+    }
+
+    ~ObjectPointer()
+    {
+        reset();
+    }
+
+    ObjectPointer&
+    operator=(const ObjectPointer& other)
+    {
+        if (mSlot != other.mSlot)
+        {
+            // Keep the other object alive before dropping the own reference
+            if (other.mSlot != nullptr)
+            {
+                other.mSlot->incrementCount();
+            }
+            internal::ObjectPoolSlot<T>* previous = mSlot;
+            mSlot = other.mSlot;
+            if (previous != nullptr)
+            {
+                previous->decrementCount();
+            }
+        }
+        return *this;
+    }
+
+    ObjectPointer&
+    operator=(ObjectPointer&& other)
+    {
+        if (this != &other)
+        {
+            internal::ObjectPoolSlot<T>* previous = mSlot;
+            mSlot = other.mSlot;
+            other.mSlot = nullptr;
+            if (previous != nullptr)
+            {
+                previous->decrementCount();
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * Drop the reference, the handle is invalid afterwards.
+     */
+    inline void
+    reset()
+    {
+        internal::ObjectPoolSlot<T>* previous = mSlot;
+        mSlot = nullptr;
+        if (previous != nullptr)
+        {
+            previous->decrementCount();
+        }
+    }
+
+    inline bool
+    isValid() const
+    {
+        return (mSlot != nullptr);
+    }
+
+    inline size_t
+    getReferenceCount() const
+    {
+        return (mSlot != nullptr) ? mSlot->mReferenceCounter.load() : 0;
+    }
+
+    inline T*
+    get() const
+    {
+        return (mSlot != nullptr) ? mSlot->getObject() : nullptr;
+    }
+
+    inline T* operator->() const
+    {
+        return mSlot->getObject();
+    }
+
+    inline T& operator*() const
+    {
+        return *mSlot->getObject();
+    }
+
+    inline bool
+    operator==(const ObjectPointer& other) const
+    {
+        return (mSlot == other.mSlot);
+    }
+
+    inline bool
+    operator!=(const ObjectPointer& other) const
+    {
+        return (mSlot != other.mSlot);
+    }
+
+private:
+    friend class ObjectPoolBase<T>;
+
+    /// Takes over the reference counted by the pool during the allocation
+    explicit ObjectPointer(internal::ObjectPoolSlot<T>* slot) : mSlot(slot)
+    {
+    }
+
+    internal::ObjectPoolSlot<T>* mSlot;
+};
+
+/**
+ * \ingroup SharedBuffer
+ * \brief Base class of the ObjectPool for passing instances by reference.
+ *
+ * Holds the free list and the statistics, the storage is provided by the
+ * ObjectPool.
+ */
+template <typename T>
+class ObjectPoolBase
+{
+public:
+    // disable copy constructor
+    ObjectPoolBase(const ObjectPoolBase&) = delete;
+
+    // disable copy assignment operator
+    ObjectPoolBase&
+    operator=(const ObjectPoolBase&) = delete;
+
+    /**
+     * \brief Allocate an object and construct it in place.
+     *
+     * O(1). The constructor of T is called outside of the pool lock.
+     *
+     * \param pointer
+     *      Receives the handle to the new object, unchanged if the pool is
+     *      exhausted.
+     * \param args
+     *      Arguments passed to the constructor of T.
+     *
+     * \return Returns true if an object was allocated, false if the pool
+     * is exhausted.
+     */
+    template <typename... Args>
+    bool
+    allocate(ObjectPointer<T>& pointer, Args&&... args)
+    {
+        internal::ObjectPoolSlot<T>* slot = nullptr;
+        {
+            outpost::rtos::MutexGuard lock(mMutex);
+            slot = mFreeList;
+            if (slot != nullptr)
+            {
+                mFreeList = slot->mNextFree;
+                slot->mNextFree = nullptr;
+                mNumberOfFreeElements--;
+                mNumberOfAllocations++;
+                if (mNumberOfElements - mNumberOfFreeElements > mHighWaterMark)
+                {
+                    mHighWaterMark = mNumberOfElements - mNumberOfFreeElements;
+                }
+            }
+            else
+            {
+                mNumberOfFailedAllocations++;
+            }
+        }
+
+        bool res = false;
+        if (slot != nullptr)
+        {
+            new (slot->getObject()) T(std::forward<Args>(args)...);
+            slot->mReferenceCounter.store(1);
+
+            // Assign outside of the lock, overwriting the previous content of
+            // pointer may release another object to this pool.
+            pointer = ObjectPointer<T>(slot);
+            res = true;
+        }
+        return res;
+    }
+
+    inline size_t
+    numberOfElements() const
+    {
+        return mNumberOfElements;
+    }
+
+    inline size_t
+    numberOfFreeElements() const
+    {
+        return mNumberOfFreeElements;
+    }
+
+    inline size_t
+    numberOfUsedElements() const
+    {
+        return mNumberOfElements - mNumberOfFreeElements;
+    }
+
+    /**
+     * \brief Number of successful allocations since construction or the last resetCounters().
+     */
+    inline uint32_t
+    getNumberOfAllocations() const
+    {
+        return mNumberOfAllocations;
+    }
+
+    /**
+     * \brief Number of allocations that failed because the pool was exhausted.
+     */
+    inline uint32_t
+    getNumberOfFailedAllocations() const
+    {
+        return mNumberOfFailedAllocations;
+    }
+
+    /**
+     * \brief Maximum number of objects that were in use at the same time.
+     */
+    inline size_t
+    getHighWaterMark() const
+    {
+        return mHighWaterMark;
+    }
+
+    /**
+     * \brief Resets the allocation counters and sets the high-water mark to the number of
+     * objects currently in use.
+     */
+    inline void
+    resetCounters()
+    {
+        outpost::rtos::MutexGuard lock(mMutex);
+        mNumberOfAllocations = 0;
+        mNumberOfFailedAllocations = 0;
+        mHighWaterMark = numberOfUsedElements();
+    }
+
+protected:
+    /**
+     * \param slots
+     *      Array of constructed slots.
+     * \param numberOfSlots
+     *      Number of elements of the array.
+     */
+    ObjectPoolBase(internal::ObjectPoolSlot<T>* slots, size_t numberOfSlots) :
+        mFreeList(nullptr),
+        mNumberOfElements(numberOfSlots),
+        mNumberOfFreeElements(numberOfSlots),
+        mNumberOfAllocations(0),
+        mNumberOfFailedAllocations(0),
+        mHighWaterMark(0)
+    {
+        // Build the list back to front so that the first slot is allocated first
+        for (size_t i = numberOfSlots; i > 0; i--)
+        {
+            slots[i - 1].mOwner = this;
+            slots[i - 1].mNextFree = mFreeList;
+            mFreeList = &slots[i - 1];
+        }
+    }
+
+    /**
+     * \brief Default destructor.
+     *
+     * Should not be called unless absolutely certain that all objects of
+     * the pool are unused, the objects are not destroyed.
+     */
+    ~ObjectPoolBase() = default;
+
+private:
+    friend class internal::ObjectPoolSlot<T>;
+
+    /// Called when the reference count of the slot drops to zero
+    void
+    release(internal::ObjectPoolSlot<T>& slot)
+    {
+        // Outside of the lock, the destructor may drop objects of this pool
+        slot.getObject()->~T();
+
+        outpost::rtos::MutexGuard lock(mMutex);
+        slot.mNextFree = mFreeList;
+        mFreeList = &slot;
+        mNumberOfFreeElements++;
+    }
+
+    internal::ObjectPoolSlot<T>* mFreeList;
+    const size_t mNumberOfElements;
+    size_t mNumberOfFreeElements;
+
+    uint32_t mNumberOfAllocations;
+    uint32_t mNumberOfFailedAllocations;
+    size_t mHighWaterMark;
+
+    outpost::rtos::Mutex mMutex;
+};
+
+namespace internal
+{
+// Constructed before the ObjectPoolBase, which links the slots
+template <typename T, size_t N>
+class ObjectPoolStorage
+{
+protected:
+    ObjectPoolSlot<T> mSlots[N];
+};
+
+template <typename T>
+void
+ObjectPoolSlot<T>::decrementCount()
+{
+    size_t current = mReferenceCounter.load();
+    while (current > 0 && !mReferenceCounter.compareAndSwap(current, current - 1))
+    {
+        // current has been updated with the actual value, retry
+    }
+
+    // Only the thread which dropped the last reference returns the slot
+    if (current == 1)
+    {
+        mOwner->release(*this);
+    }
+}
+}  // namespace internal
+
+/**
+ * \ingroup SharedBuffer
+ * \brief Fixed-capacity pool of objects of an arbitrary type.
+ *
+ * Generalization of SharedBufferPool: the objects are constructed in place
+ * by allocate() and handed out as reference counted ObjectPointers. When
+ * the last pointer is dropped the object is destroyed and its slot is
+ * pushed back onto an intrusive free list, allocation and release are
+ * O(1). No memory is allocated from the heap.
+ *
+ * \code
+ * outpost::utils::ObjectPool<Telecommand, 16> pool;
+ *
+ * outpost::utils::ObjectPointer<Telecommand> command;
+ * if (pool.allocate(command, apid, data))
+ * {
+ *     queue.send(command);
+ * }
+ * \endcode
+ *
+ * \tparam T Type of the objects
+ * \tparam N Number of objects
+ */
+template <typename T, size_t N>
+class ObjectPool : private internal::ObjectPoolStorage<T, N>, public ObjectPoolBase<T>
+{
+public:
+    ObjectPool() : ObjectPoolBase<T>(internal::ObjectPoolStorage<T, N>::mSlots, N)
+    {
+    }
+
+    /**
+     * \brief Default destructor.
+     *
+     * Should not be called unless absolutely certain that all objects of
+     * the pool are unused.
+     */
+    ~ObjectPool() = default;
+};
+
+}  // namespace utils
+}  // namespace outpost
+
+#endif
@@ -15,24 +15,114 @@
 #ifndef OUTPOST_UTILS_REFERENCE_QUEUE_H_
 #define OUTPOST_UTILS_REFERENCE_QUEUE_H_
 
+#include <outpost/rtos/atomic.h>
+#include <outpost/rtos/clock.h>
+#include <outpost/rtos/event_group.h>
+#include <outpost/rtos/mutex_guard.h>
 #include <outpost/rtos/queue.h>
+#include <outpost/rtos/semaphore.h>
+#include <outpost/time/duration.h>
 #include <outpost/utils/container/shared_buffer.h>
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <utility>
+
 namespace outpost
 {
 namespace utils
 {
+namespace internal
+{
+/**
+ * Lets senders of a full reference queue wait until a receiver frees a slot.
+ *
+ * Waiting senders are counted, so that receivers only signal the semaphore while a sender
+ * waits. A sender registers before its last attempt, a slot freed afterwards therefore always
+ * wakes it up. A signal left over from a sender which has timed out only causes an additional
+ * attempt of the next waiting sender.
+ */
+class FreeSlotWaiter
+{
+public:
+    FreeSlotWaiter() : mWaitingSenders(0), mSlotFreed(0)
+    {
+    }
+
+    // disable copy constructor
+    FreeSlotWaiter(const FreeSlotWaiter&) = delete;
+
+    // disable assignment operator
+    FreeSlotWaiter&
+    operator=(const FreeSlotWaiter&) = delete;
+
+    /**
+     * Repeats \p trySend whenever a slot has been freed until it succeeds or the timeout
+     * expires.
+     */
+    template <typename TrySend>
+    bool
+    send(TrySend trySend, outpost::time::Duration timeout)
+    {
+        if (trySend())
+        {
+            return true;
+        }
+        if (timeout <= outpost::time::Duration::zero())
+        {
+            return false;
+        }
+
+        const bool infinite = (timeout == outpost::time::Duration::infinity());
+        outpost::rtos::SystemClock clock;
+        const outpost::time::SpacecraftElapsedTime deadline = clock.now() + timeout;
+
+        mWaitingSenders.fetchAdd(1);
+        bool sent = trySend();
+        while (!sent)
+        {
+            const outpost::time::Duration remaining =
+                    infinite ? outpost::time::Duration::infinity() : (deadline - clock.now());
+            if (remaining <= outpost::time::Duration::zero())
+            {
+                break;
+            }
+            mSlotFreed.acquire(remaining);
+            sent = trySend();
+        }
+        mWaitingSenders.fetchSub(1);
+        return sent;
+    }
+
+    /**
+     * Called by receivers after a slot has been freed.
+     */
+    inline void
+    notify()
+    {
+        if (mWaitingSenders.load() != 0)
+        {
+            mSlotFreed.release();
+        }
+    }
+
+private:
+    outpost::rtos::Atomic<uint32_t> mWaitingSenders;
+    outpost::rtos::Semaphore mSlotFreed;
+};
+}  // namespace internal
+
 /**
  * \ingroup SharedBuffer
  * \brief Base class of the ReferenceQueue for passing by reference.
  *
  * The standard RTOS/POSIX queues are not capable of handling classes that may not be used as a
  * pointer (e.g. using reference counting), since they use pointers or standard constructors instead
- * of references. Hence, ReferenceQueueBase inherits from outpost::rtos::Queue and adds a wrapper
- * that keeps the references.
+ * of references. Hence, ReferenceQueueBase defines a queue interface that keeps the references.
  */
 template <typename T>
-class ReferenceQueueBase : public outpost::rtos::Queue<size_t>
+class ReferenceQueueBase
 {
 public:
     /**
@@ -48,6 +138,39 @@ public:
     virtual bool
     send(T& data) = 0;
 
+    /**
+     * \brief Move data into the queue.
+     *
+     * Avoids copying \p data, e.g. a reference count update for SharedBufferPointer.
+     * \p data is only moved from if it could be sent.
+     * \param data Data to be sent.
+     * \return Returns true if data could be sent, false otherwise.
+     */
+    virtual bool
+    send(T&& data) = 0;
+
+    /**
+     * \brief Send data to the queue, waiting for a free slot if the queue is full.
+     *
+     * The sender is woken up as soon as a receiver has freed a slot.
+     * \param data Data to be sent.
+     * \param timeout Duration for which the caller is willing to wait for a free slot
+     * \return Returns true if data could be sent, false otherwise (e.g. a timeout occured).
+     */
+    virtual bool
+    send(T& data, outpost::time::Duration timeout) = 0;
+
+    /**
+     * \brief Move data into the queue, waiting for a free slot if the queue is full.
+     *
+     * \p data is only moved from if it could be sent.
+     * \param data Data to be sent.
+     * \param timeout Duration for which the caller is willing to wait for a free slot
+     * \return Returns true if data could be sent, false otherwise (e.g. a timeout occured).
+     */
+    virtual bool
+    send(T&& data, outpost::time::Duration timeout) = 0;
+
     /**
      * \brief Receives data from the queue.
      *
@@ -82,20 +205,38 @@ public:
     virtual bool
     isFull() = 0;
 
-protected:
     /**
-     * \brief Constructor for a ReferenceQueueBase. May only be called by its derivatives (i.e.
-     * ReferenceQueue) \param N Maximum number of elements in the queue
+     * \brief Set bits of an event group whenever data has been sent.
+     *
+     * Allows the receiver to wait for this queue together with other sources, see
+     * outpost::rtos::EventGroup::waitAny(). The bits are set after the data is available, a
+     * receiver has to empty the queue after waking up as several elements may have been sent.
+     * \param group Event group to notify, nullptr to disable the notification.
+     * \param bits Bits to set.
+     * \return Returns true if the queue supports notifications, false otherwise.
      */
-    inline ReferenceQueueBase(size_t N) : outpost::rtos::Queue<size_t>(N)
+    virtual bool
+    setEventNotification(outpost::rtos::EventGroup* group, outpost::rtos::EventGroup::Bits bits)
     {
+        (void) group;
+        (void) bits;
+        return false;
     }
+
+protected:
+    /**
+     * \brief Constructor for a ReferenceQueueBase. May only be called by its derivatives (i.e.
+     * ReferenceQueue)
+     */
+    ReferenceQueueBase() = default;
 };
 
 /**
  * \ingroup SharedBuffer
- * \brief Implementation of a outpost::rtos::Queue that stores all additional information needed for
- * passing instances of classes that cannot be sent as pointers.
+ * \brief Queue that stores instances of classes that cannot be sent as pointers.
+ *
+ * The elements are kept in a ring buffer guarded by a single mutex, all operations are O(1). A
+ * counting semaphore tracks the number of stored elements to allow blocking receives.
  */
 template <typename T, size_t N>
 class ReferenceQueue : public ReferenceQueueBase<T>
@@ -104,12 +245,27 @@ public:
     /**
      * \brief Standard constructor.
      */
-    ReferenceQueue() : ReferenceQueueBase<T>(N), mItemsInQueue(0), mLastIndex(0)
+    ReferenceQueue() :
+        mItems(0),
+        mHead(0),
+        mItemsInQueue(0),
+        mNotificationGroup(nullptr),
+        mNotificationBits(0),
+        mFreeSlotWaiter()
     {
-        for (size_t i = 0; i < N; i++)
-        {
-            mIsUsed[i] = false;
-        }
+    }
+
+    /**
+     * \brief Set bits of an event group whenever data has been sent.
+     * \see ReferenceQueueBase::setEventNotification
+     */
+    virtual bool
+    setEventNotification(outpost::rtos::EventGroup* group,
+                         outpost::rtos::EventGroup::Bits bits) override
+    {
+        mNotificationGroup = group;
+        mNotificationBits = bits;
+        return true;
     }
 
     /**
@@ -121,14 +277,7 @@ public:
     isEmpty() override
     {
         outpost::rtos::MutexGuard lock(mMutex);
-        for (size_t i = 0; i < N; i++)
-        {
-            if (mIsUsed[i])
-            {
-                return false;
-            }
-        }
-        return true;
+        return mItemsInQueue == 0;
     }
 
     /**
@@ -139,12 +288,6 @@ public:
     isFull() override
     {
         outpost::rtos::MutexGuard lock(mMutex);
-        /*for (size_t i = 0; i < N; i++)
-        {
-            if(!isUsed[i])
-                return false;
-        }
-        return true;*/
         return mItemsInQueue == N;
     }
 
@@ -157,33 +300,39 @@ public:
     virtual bool
     send(T& data) override
     {
-        outpost::rtos::MutexGuard lock(mMutex);
-        bool res = false;
-        size_t i = mLastIndex;
-        size_t endSearch = (mLastIndex - 1) % N;
-        // for (size_t i = 0; i < N; i++)
-        do
-        {
-            if (!mIsUsed[i])
-            {
-                mPointers[i] = data;
-                mIsUsed[i] = true;
-                mLastIndex = (i + 1) % N;
-                if (outpost::rtos::Queue<size_t>::send(i))
-                {
-                    mItemsInQueue++;
-                    res = true;
-                }
-                else
-                {
-                    mIsUsed[i] = false;
-                    mPointers[i] = mEmpty;
-                }
-                break;
-            }
-            i = (i + 1) % N;
-        } while (i != endSearch);
-        return res;
+        return sendElement(data);
+    }
+
+    /**
+     * \brief Move data into the queue.
+     * \see ReferenceQueueBase::send(T&&)
+     * \param data Data to be sent. Is only moved from if it could be sent.
+     * \return Returns true if data could be sent, false otherwise.
+     */
+    virtual bool
+    send(T&& data) override
+    {
+        return sendElement(std::move(data));
+    }
+
+    /**
+     * \brief Send data to the queue, waiting for a free slot if the queue is full.
+     * \see ReferenceQueueBase::send(T&, outpost::time::Duration)
+     */
+    virtual bool
+    send(T& data, outpost::time::Duration timeout) override
+    {
+        return mFreeSlotWaiter.send([&]() { return sendElement(data); }, timeout);
+    }
+
+    /**
+     * \brief Move data into the queue, waiting for a free slot if the queue is full.
+     * \see ReferenceQueueBase::send(T&&, outpost::time::Duration)
+     */
+    virtual bool
+    send(T&& data, outpost::time::Duration timeout) override
+    {
+        return mFreeSlotWaiter.send([&]() { return sendElement(std::move(data)); }, timeout);
     }
 
     /**
@@ -199,18 +348,21 @@ public:
     virtual bool
     receive(T& data, outpost::time::Duration timeout = outpost::time::Duration::infinity()) override
     {
-        bool res = false;
-        size_t index;
-        if (outpost::rtos::Queue<size_t>::receive(index, timeout))
+        if (!mItems.acquire(timeout))
+        {
+            return false;
+        }
+
+        // every successful acquire is backed by a stored element
         {
             outpost::rtos::MutexGuard lock(mMutex);
-            data = mPointers[index];
-            mPointers[index] = mEmpty;
-            mIsUsed[index] = false;
+            data = std::move(mElements[mHead]);
+            mElements[mHead] = mEmpty;
+            mHead = (mHead + 1) % N;
             mItemsInQueue--;
-            res = true;
         }
-        return res;
+        mFreeSlotWaiter.notify();
+        return true;
     }
 
     /**
@@ -225,21 +377,287 @@ public:
     }
 
 private:
+    template <typename U>
+    bool
+    sendElement(U&& data)
+    {
+        {
+            outpost::rtos::MutexGuard lock(mMutex);
+            if (mItemsInQueue >= N)
+            {
+                return false;
+            }
+            mElements[(mHead + mItemsInQueue) % N] = std::forward<U>(data);
+            mItemsInQueue++;
+        }
+        mItems.release();
+        if (mNotificationGroup != nullptr)
+        {
+            mNotificationGroup->set(mNotificationBits);
+        }
+        return true;
+    }
+
     T mEmpty;
 
     outpost::rtos::Mutex mMutex;
+    outpost::rtos::Semaphore mItems;
 
+    size_t mHead;
     uint16_t mItemsInQueue;
 
-    size_t mLastIndex;
+    outpost::rtos::EventGroup* mNotificationGroup;
+    outpost::rtos::EventGroup::Bits mNotificationBits;
+
+    internal::FreeSlotWaiter mFreeSlotWaiter;
+
+    T mElements[N];
+};
+
+/**
+ * \ingroup SharedBuffer
+ * \brief Queue that passes instances of classes that cannot be sent as pointers through a queue
+ * of the operating system.
+ *
+ * The elements stay in slots inside the object, only the index of a slot is passed through an
+ * outpost::rtos::StaticQueue. The free slots are kept in a lock-free stack. A send or receive
+ * therefore needs a single kernel call (e.g. xQueueSend() or rtems_message_queue_send()) instead
+ * of a mutex and a semaphore as in ReferenceQueue, and elements are moved in and out of the
+ * slots, e.g. without updating the reference count of a SharedBufferPointer.
+ *
+ * getNumberOfItems(), isEmpty() and isFull() are only snapshots while other threads access the
+ * queue.
+ */
+template <typename T, size_t N>
+class NativeReferenceQueue : public ReferenceQueueBase<T>
+{
+    static_assert(N > 0, "Queue must hold at least one element");
+    static_assert(N < 0xFFFF, "Slot indices are limited to 16 bit");
+
+public:
+    /**
+     * \brief Standard constructor.
+     */
+    NativeReferenceQueue() :
+        mFreeSlots(0),
+        mItemsInQueue(0),
+        mNotificationGroup(nullptr),
+        mNotificationBits(0),
+        mFreeSlotWaiter()
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            mNextFreeSlot[i].store((i + 1 < N) ? static_cast<uint32_t>(i + 1) : noSlot);
+        }
+    }
 
-    T mPointers[N];
-    bool mIsUsed[N];
+    /**
+     * \brief Set bits of an event group whenever data has been sent.
+     * \see ReferenceQueueBase::setEventNotification
+     */
+    virtual bool
+    setEventNotification(outpost::rtos::EventGroup* group,
+                         outpost::rtos::EventGroup::Bits bits) override
+    {
+        mNotificationGroup = group;
+        mNotificationBits = bits;
+        return true;
+    }
+
+    /**
+     * \brief Checks whether the queue is currently empty.
+     * \return Returns true if there are no elements in the queue waiting to be received, false
+     * otherwise.
+     */
+    bool
+    isEmpty() override
+    {
+        return mItemsInQueue.load() == 0;
+    }
+
+    /**
+     * \brief Checks whether there is a free slot in the queue.
+     * \return Returns true if data can be sent to the queue, false otherwise.
+     */
+    bool
+    isFull() override
+    {
+        return (mFreeSlots.load() & indexMask) == noSlot;
+    }
+
+    /**
+     * \brief Send data to the queue.
+     * \see ReferenceQueueBase::send(T&)
+     * \param data Data to be sent.
+     * \return Returns true if data could be sent, false otherwise.
+     */
+    virtual bool
+    send(T& data) override
+    {
+        return sendElement(data);
+    }
+
+    /**
+     * \brief Move data into the queue.
+     * \see ReferenceQueueBase::send(T&&)
+     * \param data Data to be sent. Is only moved from if it could be sent.
+     * \return Returns true if data could be sent, false otherwise.
+     */
+    virtual bool
+    send(T&& data) override
+    {
+        return sendElement(std::move(data));
+    }
+
+    /**
+     * \brief Send data to the queue, waiting for a free slot if the queue is full.
+     * \see ReferenceQueueBase::send(T&, outpost::time::Duration)
+     */
+    virtual bool
+    send(T& data, outpost::time::Duration timeout) override
+    {
+        return mFreeSlotWaiter.send([&]() { return sendElement(data); }, timeout);
+    }
+
+    /**
+     * \brief Move data into the queue, waiting for a free slot if the queue is full.
+     * \see ReferenceQueueBase::send(T&&, outpost::time::Duration)
+     */
+    virtual bool
+    send(T&& data, outpost::time::Duration timeout) override
+    {
+        return mFreeSlotWaiter.send([&]() { return sendElement(std::move(data)); }, timeout);
+    }
+
+    /**
+     * \brief Receive data from the queue.
+     * \see ReferenceQueueBase::receive(T&, outpost::time::Duration)
+     * \param data Reference for the data to be received.
+     * \param timeout Duration for which the caller is willing to wait for incoming data
+     * \return Returns true if data was received, false otherwise (e.g. a timeout occured)
+     */
+    virtual bool
+    receive(T& data, outpost::time::Duration timeout = outpost::time::Duration::infinity()) override
+    {
+        uint16_t slot;
+        if (!mSlotQueue.receive(slot, timeout))
+        {
+            return false;
+        }
+
+        mItemsInQueue.fetchSub(1);
+        data = std::move(mElements[slot]);
+        mElements[slot] = mEmpty;
+        releaseSlot(slot);
+        mFreeSlotWaiter.notify();
+        return true;
+    }
+
+    /**
+     * \brief Getter function for the number of items currently stored in the queue.
+     * \return Returns the number of items in the queue that are ready for receiving.
+     */
+    virtual uint16_t
+    getNumberOfItems() override
+    {
+        return static_cast<uint16_t>(mItemsInQueue.load());
+    }
+
+private:
+    static constexpr uint32_t indexMask = 0xFFFF;
+    static constexpr uint32_t noSlot = 0xFFFF;
+
+    template <typename U>
+    bool
+    sendElement(U&& data)
+    {
+        uint16_t slot;
+        if (!acquireSlot(slot))
+        {
+            return false;
+        }
+
+        mElements[slot] = std::forward<U>(data);
+
+        // Cannot fail, there are never more slots in use than the
+        // queue can hold
+        mItemsInQueue.fetchAdd(1);
+        mSlotQueue.send(slot);
+
+        if (mNotificationGroup != nullptr)
+        {
+            mNotificationGroup->set(mNotificationBits);
+        }
+        return true;
+    }
+
+    /**
+     * Pop a slot from the free stack.
+     *
+     * The upper 16 bit of the stack head are incremented with every pop,
+     * a concurrent pop and push of the same slot thus lets the
+     * compare-and-swap fail (ABA problem).
+     */
+    bool
+    acquireSlot(uint16_t& slot)
+    {
+        uint32_t head = mFreeSlots.load();
+        while (1)
+        {
+            const uint32_t index = head & indexMask;
+            if (index == noSlot)
+            {
+                return false;
+            }
+
+            const uint32_t tag = (head >> 16) + 1;
+            const uint32_t next = mNextFreeSlot[index].load();
+            if (mFreeSlots.compareAndSwap(head, (tag << 16) | next))
+            {
+                slot = static_cast<uint16_t>(index);
+                return true;
+            }
+        }
+    }
+
+    void
+    releaseSlot(uint16_t slot)
+    {
+        uint32_t head = mFreeSlots.load();
+        do
+        {
+            mNextFreeSlot[slot].store(head & indexMask);
+        } while (!mFreeSlots.compareAndSwap(head, (head & ~indexMask) | slot));
+    }
+
+    T mEmpty;
+
+    outpost::rtos::StaticQueue<uint16_t, N> mSlotQueue;
+
+    /// Tag (upper 16 bit) and index of the first free slot
+    outpost::rtos::Atomic<uint32_t> mFreeSlots;
+    outpost::rtos::Atomic<uint32_t> mNextFreeSlot[N];
+    outpost::rtos::Atomic<uint32_t> mItemsInQueue;
+
+    outpost::rtos::EventGroup* mNotificationGroup;
+    outpost::rtos::EventGroup::Bits mNotificationBits;
+
+    internal::FreeSlotWaiter mFreeSlotWaiter;
+
+    T mElements[N];
 };
 
+template <typename T, size_t N>
+constexpr uint32_t NativeReferenceQueue<T, N>::indexMask;
+
+template <typename T, size_t N>
+constexpr uint32_t NativeReferenceQueue<T, N>::noSlot;
+
 using SharedBufferQueueBase = ReferenceQueueBase<SharedBufferPointer>;
 template <size_t N>
 using SharedBufferQueue = ReferenceQueue<SharedBufferPointer, N>;
+template <size_t N>
+using NativeSharedBufferQueue = NativeReferenceQueue<SharedBufferPointer, N>;
 
 }  // namespace utils
 }  // namespace outpost
@@ -14,16 +14,14 @@
 
 #include "shared_buffer.h"
 
+#include "shared_object_pool.h"
+
+#include <string.h>
+
 namespace outpost
 {
 namespace utils
 {
-outpost::rtos::Mutex SharedBuffer::mMutex;
-
-SharedBuffer::SharedBuffer() : mReferenceCounter(0), mBuffer(outpost::Slice<uint8_t>::empty())
-{
-}
-
 SharedBuffer::~SharedBuffer()
 {
 }
@@ -31,13 +29,23 @@ SharedBuffer::~SharedBuffer()
 void
 SharedBuffer::incrementCount()
 {
-    SharedBuffer::incrementCountAtomic(mReferenceCounter);
+    mReferenceCounter.fetchAdd(1);
 }
 
 void
 SharedBuffer::decrementCount()
 {
-    SharedBuffer::decrementCountAtomic(mReferenceCounter);
+    size_t current = mReferenceCounter.load();
+    while (current > 0 && !mReferenceCounter.compareAndSwap(current, current - 1))
+    {
+        // current has been updated with the actual value, retry
+    }
+
+    // Only the thread which dropped the last reference returns the buffer
+    if (current == 1 && mOwner != nullptr)
+    {
+        mOwner->returnBuffer(*this);
+    }
 }
 
 bool
@@ -53,12 +61,39 @@ SharedBufferPointer::getChild(SharedChildPointer& ptr,
         {
             ptr = SharedChildPointer(mPtr, *this);
             ptr.mType = type;
-            ptr.mOffset = mOffset + pOffset;
-            ptr.mLength = length;
+            ptr.mOffset = static_cast<uint32_t>(mOffset + pOffset);
+            ptr.mLength = static_cast<uint32_t>(length);
+            ptr.mChild = true;
             res = true;
         }
     }
     return res;
 }
+
+bool
+SharedBufferPointer::makeWritable()
+{
+    if (!isValid())
+    {
+        return false;
+    }
+    if (isExclusive())
+    {
+        return true;
+    }
+
+    SharedBufferPoolBase* pool = mPtr->mOwner;
+    SharedBufferPointer copy;
+    if (pool == nullptr || !pool->allocateForLength(copy, mLength) || copy.getLength() < mLength)
+    {
+        return false;
+    }
+
+    memcpy(&copy.mPtr->mBuffer[0], &mPtr->mBuffer[mOffset], mLength);
+    copy.mLength = mLength;
+    copy.mType = mType;
+    *this = std::move(copy);
+    return true;
+}
 }  // namespace utils
 }  // namespace outpost
@@ -15,17 +15,21 @@
 #ifndef OUTPOST_UTILS_SMART_BUFFER_H_
 #define OUTPOST_UTILS_SMART_BUFFER_H_
 #include <outpost/base/slice.h>
-#include <outpost/rtos/mutex_guard.h>
+#include <outpost/rtos/atomic.h>
 
 #include <stdio.h>
 #include <string.h>
 
 #include <array>
+#include <utility>
 
 namespace outpost
 {
 namespace utils
 {
+class SharedBufferPoolBase;
+class FixedSizeSharedBufferPoolBase;
+
 /**
  * \ingroup SharedBuffer
  * \brief Reference counting byte buffer as the underlying data structure for the
@@ -40,14 +44,24 @@ public:
      * Needed for array creation. The array then needs to be filled with setPointer(uint8_t*,size_t)
      * or SharedBuffer::setData
      */
-    SharedBuffer();
+    constexpr SharedBuffer() :
+        mReferenceCounter(0),
+        mBuffer(outpost::Slice<uint8_t>::empty()),
+        mOwner(nullptr),
+        mNextFree(nullptr)
+    {
+    }
 
     /**
      * \brief Constructor for creating a SharedBuffer instance from a pointer and a given size in
      * bytes.
      * \param slice Slice holding the byte array.
      */
-    explicit SharedBuffer(outpost::Slice<uint8_t> slice) : mReferenceCounter(0), mBuffer(slice)
+    explicit SharedBuffer(outpost::Slice<uint8_t> slice) :
+        mReferenceCounter(0),
+        mBuffer(slice),
+        mOwner(nullptr),
+        mNextFree(nullptr)
     {
     }
 
@@ -100,14 +114,13 @@ public:
     }
 
     /**
-     * \brief Getter function for the usage state of the SharedBuffer. Calls outpost::rtos::Mutex
-     * protected functions internally.
+     * \brief Getter function for the usage state of the SharedBuffer.
      * \return Returns true if the SharedBuffer is currently in use, false otherwise.
      */
     inline bool
     isUsed() const
     {
-        return SharedBuffer::isUsedAtomic(mReferenceCounter);
+        return mReferenceCounter.load() != 0;
     }
 
     /**
@@ -117,7 +130,7 @@ public:
     inline size_t
     getReferenceCount() const
     {
-        return mReferenceCounter;
+        return mReferenceCounter.load();
     }
 
     /**
@@ -132,12 +145,15 @@ public:
 
 private:
     friend class SharedBufferPointer;
+    friend class SharedBufferPoolBase;
+    friend class FixedSizeSharedBufferPoolBase;
+    friend class SharedBufferPoolCacheBase;
 
     /**
      * \brief Increments the reference count.
      *
      * Used by its friend class SharedBufferPointer, it does not need to be called manually.
-     * Uses outpost::rtos::Mutex protected functions internally for mutual exclusion.
+     * Uses the lock-free outpost::rtos::Atomic of the selected operating system backend.
      */
     void
     incrementCount();
@@ -146,71 +162,36 @@ private:
      * \brief Decrements the reference count.
      *
      * Used by its friend class SharedBufferPointer, it does not need to be called manually.
-     * Uses outpost::rtos::Mutex protected functions internally for mutual exclusion.
+     * Uses the lock-free outpost::rtos::Atomic of the selected operating system backend.
+     * The counter never drops below zero. When the last reference is dropped the buffer is
+     * handed back to its owning pool (if any).
      */
     void
     decrementCount();
 
     /**
-     * \brief outpost::rtos::Mutex protected access to the usage state, derived from the reference
-     * counter.
-     *
-     * Called internally by the member function isUsed().
-     * Does not need to be called manually.
-     * \param ref Reference counter to be checked.
+     * \brief Reference counter for the current usage state.
      */
-    inline static bool
-    isUsedAtomic(const size_t& ref)
-    {
-        outpost::rtos::MutexGuard lock(mMutex);
-        return ref != 0;
-    }
+    outpost::rtos::Atomic<size_t> mReferenceCounter;
 
     /**
-     * \brief outpost::rtos::Mutex protected increment of the reference counter.
-     *
-     * Called internally by the member function isUsed().
-     * Does not need to be called manually.
-     * \param ref Reference counter to be incremented.
+     * \brief Pointer to the underlying byte array.
      */
-    inline static void
-    incrementCountAtomic(size_t& ref)
-    {
-        outpost::rtos::MutexGuard lock(mMutex);
-        ref++;
-    }
+    outpost::Slice<uint8_t> mBuffer;
 
     /**
-     * \brief outpost::rtos::Mutex protected decrement of the reference counter.
+     * \brief Pool to which the buffer is returned once it is not referenced anymore.
      *
-     * Called internally by the member function isUsed().
-     * Does not need to be called manually.
-     * \param ref Reference counter to be decremented.
+     * nullptr for buffers that are not managed by a pool.
      */
-    inline static void
-    decrementCountAtomic(size_t& ref)
-    {
-        outpost::rtos::MutexGuard lock(mMutex);
-        if (ref > 0)
-        {
-            ref--;
-        }
-    }
+    SharedBufferPoolBase* mOwner;
 
     /**
-     * \brief outpost::rtos::Mutex for allowing only one reference counter to be changed at a time.
-     */
-    static outpost::rtos::Mutex mMutex;
-
-    /**
-     * \brief Reference counter for the current usage state.
-     */
-    size_t mReferenceCounter;
-
-    /**
-     * \brief Pointer to the underlying byte array.
+     * \brief Link for the intrusive free list of the owning pool.
+     *
+     * Only valid while the buffer is unused and part of the free list.
      */
-    outpost::Slice<uint8_t> mBuffer;
+    SharedBuffer* mNextFree;
 };
 
 class SharedChildPointer;
@@ -221,6 +202,12 @@ class SharedChildPointer;
  * Wrapper class for SharedBuffer instances that handles passing
  * (i.e. copying, assignment, etc.), nesting and
  * provides the means for user-defined type control.
+ *
+ * The class has no virtual functions, whether a pointer refers to a
+ * nested range is stored as a flag. Offset and length are 32 bit, which
+ * limits a SharedBuffer to 4 GiB. A pointer needs 24 bytes on 64 bit
+ * hosts and 16 bytes on 32 bit targets, which keeps queues and ring
+ * buffers of pointers compact.
  */
 class SharedBufferPointer
 {
@@ -229,8 +216,10 @@ public:
      * \brief Constructor for an empty (invalid) SharedBufferPointer.
      *
      * Used for array creation and invalidation of unused SharedBufferPointer instances.
+     * Static arrays of pointers, e.g. in a ReferenceQueue, are constant-initialized.
      */
-    SharedBufferPointer() : mPtr(nullptr), mType(0), mOffset(0), mLength(0)
+    constexpr SharedBufferPointer() :
+        mPtr(nullptr), mOffset(0), mLength(0), mType(0), mChild(false)
     {
     }
 
@@ -241,15 +230,16 @@ public:
      */
     explicit SharedBufferPointer(SharedBuffer* pT) :
         mPtr(pT),
-        mType(0),
         mOffset(0),
-        mLength([pT]() -> size_t {
+        mLength([pT]() -> uint32_t {
             if (pT)
             {
-                return pT->mBuffer.getNumberOfElements();
+                return static_cast<uint32_t>(pT->mBuffer.getNumberOfElements());
             }
             return 0;
-        }())
+        }()),
+        mType(0),
+        mChild(false)
     {
         incrementCount();
     }
@@ -261,9 +251,10 @@ public:
      */
     SharedBufferPointer(const SharedBufferPointer& other) :
         mPtr(other.mPtr),
-        mType(other.mType),
         mOffset(other.mOffset),
-        mLength(other.mLength)
+        mLength(other.mLength),
+        mType(other.mType),
+        mChild(other.mChild)
     {
         incrementCount();
     }
@@ -271,15 +262,19 @@ public:
     /**
      * \brief Move constructor for a SharedBufferPointer instance.
      *
+     * Takes over the reference held by \p other without touching the reference counter.
+     * \p other is left as an empty (invalid) SharedBufferPointer.
+     *
      * \param other Reference of the SharedBufferPointer instance to be moved.
      */
-    SharedBufferPointer(const SharedBufferPointer&& other) :
+    SharedBufferPointer(SharedBufferPointer&& other) :
         mPtr(other.mPtr),
-        mType(other.mType),
         mOffset(other.mOffset),
-        mLength(other.mLength)
+        mLength(other.mLength),
+        mType(other.mType),
+        mChild(other.mChild)
     {
-        incrementCount();
+        other.release();
     }
 
     /**
@@ -294,7 +289,7 @@ public:
      * The buffer itself, however, can only be reused once its reference counter reaches 0.
      *
      */
-    virtual ~SharedBufferPointer()
+    ~SharedBufferPointer()
     {
         decrementCount();
     }
@@ -314,6 +309,7 @@ public:
             mType = other.mType;
             mOffset = other.mOffset;
             mLength = other.mLength;
+            mChild = other.mChild;
             incrementCount();
         }
         return *this;
@@ -322,10 +318,12 @@ public:
     /**
      * \brief Move operator for a SharedBufferPointer instance.
      *
+     * Takes over the reference held by \p other, \p other is left empty.
+     *
      * \param other Reference of the SharedBufferPointer instance to be moved.
      */
     SharedBufferPointer&
-    operator=(const SharedBufferPointer&& other)
+    operator=(SharedBufferPointer&& other)
     {
         if (&other != this)
         {
@@ -334,7 +332,8 @@ public:
             mType = other.mType;
             mOffset = other.mOffset;
             mLength = other.mLength;
-            incrementCount();
+            mChild = other.mChild;
+            other.release();
         }
         return *this;
     }
@@ -356,13 +355,13 @@ public:
      * \brief Getter function for whether the current buffer is a nested buffer of some other
      * SharedBufferPointer instance.
      *
-     * \return Always returns false for instances of SharedBufferPointer, but needed for
-     * inheritance.
+     * \return Returns true if the pointer has been created by getChild(). The property is
+     * kept when a SharedChildPointer is copied into a SharedBufferPointer.
      */
-    virtual inline bool
+    inline bool
     isChild() const
     {
-        return false;
+        return mChild;
     }
 
     /**
@@ -379,6 +378,36 @@ public:
     bool
     getChild(SharedChildPointer& ptr, uint16_t type, size_t pOffest, size_t length) const;
 
+    /**
+     * \brief Check whether no other pointer refers to the underlying SharedBuffer.
+     *
+     * A child pointer holds two references, its own and the one of its parent.
+     *
+     * \return Returns true if the pointer is valid and the buffer may be modified without
+     * affecting other consumers.
+     */
+    inline bool
+    isExclusive() const
+    {
+        return isValid() && (mPtr->getReferenceCount() == (mChild ? 2U : 1U));
+    }
+
+    /**
+     * \brief Copy-on-write, gives this pointer a buffer of its own before it is modified.
+     *
+     * If the buffer is referenced by other pointers its range is copied into a buffer allocated
+     * from the owning pool and this pointer is set to the copy (offset 0, same length and type),
+     * which is not a child. Otherwise nothing is copied.
+     *
+     * Should be called on a SharedChildPointer through its own type, which also updates the
+     * parent.
+     *
+     * \return Returns false if the pointer is invalid, or the buffer is shared and the owning
+     * pool cannot provide a large enough buffer. The pointer is unchanged then.
+     */
+    bool
+    makeWritable();
+
     inline SharedBuffer* operator->() const
     {
         return mPtr;
@@ -575,12 +604,28 @@ protected:
         }
     }
 
+    /**
+     * \brief Reset to an empty pointer without changing the reference counter.
+     *
+     * Used after the reference has been handed over to another instance.
+     */
+    void
+    release()
+    {
+        mPtr = nullptr;
+        mOffset = 0;
+        mLength = 0;
+        mType = 0;
+        mChild = false;
+    }
+
 protected:
     SharedBuffer* mPtr;
 
+    uint32_t mOffset;
+    uint32_t mLength;
     uint16_t mType;
-    size_t mOffset;
-    size_t mLength;
+    bool mChild;
 };
 
 /**
@@ -611,9 +656,9 @@ public:
      *
      * \param other Reference of the SharedChildPointer instance to be moved.
      */
-    SharedChildPointer(const SharedChildPointer&& other) :
-        SharedBufferPointer(other),
-        mParent(other.mParent)
+    SharedChildPointer(SharedChildPointer&& other) :
+        SharedBufferPointer(std::move(other)),
+        mParent(std::move(other.mParent))
     {
     }
 
@@ -632,6 +677,7 @@ public:
             mType = other.mType;
             mOffset = other.mOffset;
             mLength = other.mLength;
+            mChild = other.mChild;
             mParent = other.mParent;
             incrementCount();
         }
@@ -644,22 +690,38 @@ public:
      * \param other Reference of the SharedChildPointer instance to be moved.
      */
     SharedChildPointer&
-    operator=(const SharedChildPointer&& other)
+    operator=(SharedChildPointer&& other)
     {
         if (&other != this)
         {
-            decrementCount();
-            mPtr = other.mPtr;
-            mType = other.mType;
-            mOffset = other.mOffset;
-            mLength = other.mLength;
-            mParent = other.mParent;
-            incrementCount();
+            SharedBufferPointer::operator=(std::move(other));
+            mParent = std::move(other.mParent);
         }
         return *this;
     }
 
-    virtual ~SharedChildPointer() = default;
+    ~SharedChildPointer() = default;
+
+    /**
+     * \brief Copy-on-write, see SharedBufferPointer::makeWritable().
+     *
+     * After a copy the child refers to the whole new buffer, which is also its parent.
+     */
+    bool
+    makeWritable()
+    {
+        const SharedBuffer* previous = mPtr;
+        if (!SharedBufferPointer::makeWritable())
+        {
+            return false;
+        }
+        if (mPtr != previous)
+        {
+            mParent = SharedBufferPointer(mPtr);
+            mChild = true;
+        }
+        return true;
+    }
 
     /**
      * \brief Getter function for the SharedChildPointer instance's parent buffer.
@@ -683,18 +745,6 @@ public:
         return SharedBufferPointer(mPtr);
     }
 
-    /**
-     * \brief Getter function for whether  the SharedChildPointer is actually a child buffer of some
-     * valid parent.
-     *
-     * \return Returns true if the SharedChildPointer instance's parent is valid.
-     */
-    virtual inline bool
-    isChild() const override
-    {
-        return mParent.isValid();
-    }
-
 private:
     SharedChildPointer(SharedBuffer* pT, const SharedBufferPointer& parent) :
         SharedBufferPointer(pT),
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "shared_buffer_pool_cache.h"
+
+using outpost::utils::SharedBuffer;
+using outpost::utils::SharedBufferPointer;
+using outpost::utils::SharedBufferPoolCacheBase;
+
+namespace
+{
+size_t
+getBatchSize(size_t batchSize, size_t magazineSize)
+{
+    if (batchSize == 0)
+    {
+        batchSize = magazineSize / 2;
+    }
+    if (batchSize > magazineSize)
+    {
+        batchSize = magazineSize;
+    }
+    return (batchSize > 0) ? batchSize : 1;
+}
+}  // namespace
+
+SharedBufferPoolCacheBase::SharedBufferPoolCacheBase(FixedSizeSharedBufferPoolBase& pool,
+                                                     outpost::Slice<SharedBuffer*> magazine,
+                                                     size_t batchSize) :
+    mPool(pool),
+    mMagazine(magazine),
+    mBatchSize(getBatchSize(batchSize, magazine.getNumberOfElements())),
+    mNumberOfCached(0),
+    mReturned(nullptr),
+    mNumberOfReturned(0),
+    mNumberOfRefills(0)
+{
+}
+
+SharedBufferPoolCacheBase::~SharedBufferPoolCacheBase()
+{
+    flush();
+}
+
+bool
+SharedBufferPoolCacheBase::allocate(SharedBufferPointer& pointer)
+{
+    if ((mNumberOfCached == 0) || (mNumberOfReturned.load() >= mBatchSize))
+    {
+        collectReturned();
+    }
+    if (mNumberOfCached == 0)
+    {
+        mNumberOfCached = mPool.takeBuffers(mMagazine.first(mBatchSize));
+        if (mNumberOfCached > 0)
+        {
+            mNumberOfRefills++;
+        }
+    }
+
+    SharedBuffer* buffer = nullptr;
+    if (mNumberOfCached > 0)
+    {
+        buffer = mMagazine[--mNumberOfCached];
+        adopt(*buffer);
+    }
+    updateAllocationCounters(buffer != nullptr, numberOfUsedElements());
+
+    // Overwriting the previous content of pointer may release a buffer to this cache
+    bool res = false;
+    if (buffer != nullptr)
+    {
+        pointer = SharedBufferPointer(buffer);
+        res = true;
+    }
+    return res;
+}
+
+size_t
+SharedBufferPoolCacheBase::numberOfElements() const
+{
+    return mPool.numberOfElements();
+}
+
+size_t
+SharedBufferPoolCacheBase::numberOfFreeElements() const
+{
+    return numberOfCachedElements() + mPool.numberOfFreeElements();
+}
+
+size_t
+SharedBufferPoolCacheBase::numberOfCachedElements() const
+{
+    return mNumberOfCached + mNumberOfReturned.load();
+}
+
+void
+SharedBufferPoolCacheBase::flush()
+{
+    collectReturned();
+
+    SharedBuffer* list = nullptr;
+    while (mNumberOfCached > 0)
+    {
+        SharedBuffer* buffer = mMagazine[--mNumberOfCached];
+        buffer->mNextFree = list;
+        list = buffer;
+    }
+    if (list != nullptr)
+    {
+        mPool.putBuffers(list);
+    }
+}
+
+void
+SharedBufferPoolCacheBase::release(SharedBuffer& buffer)
+{
+    // Counted before the push, so that the counter never drops below the length of the list
+    mNumberOfReturned.fetchAdd(1);
+
+    SharedBuffer* head = mReturned.load();
+    buffer.mNextFree = head;
+    while (!mReturned.compareAndSwap(head, &buffer))
+    {
+        // head has been updated with the actual value, retry
+        buffer.mNextFree = head;
+    }
+}
+
+void
+SharedBufferPoolCacheBase::collectReturned()
+{
+    // Take the whole list at once, single buffers are never popped which avoids ABA problems
+    SharedBuffer* list = mReturned.load();
+    while ((list != nullptr) && !mReturned.compareAndSwap(list, nullptr))
+    {
+        // list has been updated with the actual value, retry
+    }
+
+    size_t collected = 0;
+    SharedBuffer* overflow = nullptr;
+    while (list != nullptr)
+    {
+        SharedBuffer* next = list->mNextFree;
+        if (mNumberOfCached < mMagazine.getNumberOfElements())
+        {
+            list->mNextFree = nullptr;
+            mMagazine[mNumberOfCached++] = list;
+        }
+        else
+        {
+            list->mNextFree = overflow;
+            overflow = list;
+        }
+        list = next;
+        collected++;
+    }
+    mNumberOfReturned.fetchSub(collected);
+
+    if (overflow != nullptr)
+    {
+        mPool.putBuffers(overflow);
+    }
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_SHARED_BUFFER_POOL_CACHE_H_
+#define OUTPOST_UTILS_SHARED_BUFFER_POOL_CACHE_H_
+
+#include "shared_object_pool.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/rtos/atomic.h>
+
+#include <stddef.h>
+
+namespace outpost
+{
+namespace utils
+{
+/**
+ * \ingroup SharedBuffer
+ * \brief Magazine of buffers of one thread in front of a shared pool.
+ *
+ * The allocating thread takes buffers from its magazine without touching the
+ * state of the shared pool. An empty magazine is refilled with a batch of
+ * buffers under a single lock of the pool.
+ *
+ * Buffers allocated from the cache return to it when their last
+ * SharedBufferPointer is dropped, from any thread, by a lock-free push onto
+ * a list of returned buffers. The allocating thread moves them into its
+ * magazine once a batch has been returned and gives buffers exceeding the
+ * magazine back to the pool, again with a single lock.
+ *
+ * The cache can be given to a ProtocolDispatcher or any other user of a
+ * SharedBufferPoolBase, as long as all allocations are done by a single
+ * thread. Consumers in other threads only release buffers.
+ *
+ * Like a pool the cache has to outlive all buffers allocated from it.
+ *
+ * \code
+ * outpost::utils::SharedBufferPool<4500, 64> pool;
+ * outpost::utils::SharedBufferPoolCache<8> dispatcherCache(pool);
+ * \endcode
+ *
+ * \see SharedBufferPoolCache
+ */
+class SharedBufferPoolCacheBase : public SharedBufferPoolBase
+{
+public:
+    /**
+     * \param pool
+     *      Shared pool providing the buffers.
+     * \param magazine
+     *      Storage for the buffers held by the cache.
+     * \param batchSize
+     *      Number of buffers taken from the pool at once and number of
+     *      returned buffers after which they are collected. Limited to the
+     *      size of \p magazine, 0 selects half of it.
+     */
+    SharedBufferPoolCacheBase(FixedSizeSharedBufferPoolBase& pool,
+                              outpost::Slice<SharedBuffer*> magazine,
+                              size_t batchSize);
+
+    /**
+     * \brief Gives the cached buffers back to the pool.
+     */
+    virtual ~SharedBufferPoolCacheBase();
+
+    // disable copy constructor
+    SharedBufferPoolCacheBase(const SharedBufferPoolCacheBase&) = delete;
+
+    // disable assignment operator
+    SharedBufferPoolCacheBase&
+    operator=(const SharedBufferPoolCacheBase&) = delete;
+
+    /**
+     * \brief Allocation from the magazine, must only be called by the owning thread.
+     */
+    bool
+    allocate(SharedBufferPointer& pointer) override;
+
+    /**
+     * \brief Overall number of elements of the shared pool.
+     */
+    size_t
+    numberOfElements() const override;
+
+    /**
+     * \brief Number of buffers available to the cache, in the magazine, returned to the cache,
+     * or free in the shared pool.
+     */
+    size_t
+    numberOfFreeElements() const override;
+
+    /**
+     * \brief Number of buffers held by the cache and not available to other users of the pool.
+     */
+    size_t
+    numberOfCachedElements() const;
+
+    /**
+     * \brief Gives all cached buffers back to the pool, must only be called by the owning
+     * thread.
+     *
+     * E.g. before the thread is idle for a longer time.
+     */
+    void
+    flush();
+
+    /**
+     * \brief Number of batches taken from the pool.
+     */
+    inline uint32_t
+    getNumberOfRefills() const
+    {
+        return mNumberOfRefills;
+    }
+
+protected:
+    /**
+     * \brief Called from any thread when the last reference of a buffer is dropped.
+     */
+    void
+    release(SharedBuffer& buffer) override;
+
+private:
+    /**
+     * \brief Moves the returned buffers into the magazine, the ones not fitting are put back
+     * into the pool.
+     */
+    void
+    collectReturned();
+
+    FixedSizeSharedBufferPoolBase& mPool;
+    const outpost::Slice<SharedBuffer*> mMagazine;
+    const size_t mBatchSize;
+
+    /// Buffers in the magazine, only accessed by the owning thread
+    size_t mNumberOfCached;
+
+    /// Lock-free list of released buffers, linked via SharedBuffer::mNextFree
+    outpost::rtos::Atomic<SharedBuffer*> mReturned;
+    outpost::rtos::Atomic<size_t> mNumberOfReturned;
+
+    uint32_t mNumberOfRefills;
+};
+
+namespace internal
+{
+/**
+ * Memory of a SharedBufferPoolCache.
+ *
+ * Base class of SharedBufferPoolCache so that it is constructed before
+ * SharedBufferPoolCacheBase refers to it.
+ */
+template <size_t magazineSize>
+class SharedBufferPoolCacheStorage
+{
+protected:
+    SharedBufferPoolCacheStorage() : mMagazineStorage()
+    {
+    }
+
+    SharedBuffer* mMagazineStorage[magazineSize];
+};
+}  // namespace internal
+
+/**
+ * \ingroup SharedBuffer
+ * \brief Cache of up to \p magazineSize buffers in front of a shared pool.
+ */
+template <size_t magazineSize>
+class SharedBufferPoolCache : private internal::SharedBufferPoolCacheStorage<magazineSize>,
+                              public SharedBufferPoolCacheBase
+{
+    static_assert(magazineSize > 0, "At least one buffer required");
+
+public:
+    explicit SharedBufferPoolCache(FixedSizeSharedBufferPoolBase& pool, size_t batchSize = 0) :
+        internal::SharedBufferPoolCacheStorage<magazineSize>(),
+        SharedBufferPoolCacheBase(pool, outpost::asSlice(this->mMagazineStorage), batchSize)
+    {
+    }
+
+    virtual ~SharedBufferPoolCache() = default;
+};
+
+}  // namespace utils
+}  // namespace outpost
+
+#endif /* OUTPOST_UTILS_SHARED_BUFFER_POOL_CACHE_H_ */
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_SHARED_BUFFER_VIEW_H
+#define OUTPOST_UTILS_SHARED_BUFFER_VIEW_H
+
+#include "shared_buffer.h"
+
+#include <outpost/base/slice.h>
+#include <outpost/utils/storage/packet_layout.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace utils
+{
+/**
+ * \ingroup SharedBuffer
+ *
+ * Typed access to a packet stored in a SharedBuffer.
+ *
+ * Maps a `PacketLayout` directly onto the memory of a SharedBufferPointer.
+ * The fields are converted from and to their byte order on each access, so
+ * that a packet can be built in place in a buffer of a pool and passed on
+ * without copying it from an intermediate buffer. The view holds a
+ * reference to the buffer.
+ *
+ * \code
+ * typedef outpost::PacketLayout<outpost::BigEndianField<uint16_t>,
+ *                               outpost::BigEndianField<uint32_t>> Header;
+ *
+ * SharedBufferView<Header> packet(buffer);
+ * if (packet.isValid())
+ * {
+ *     packet.set<0>(apid);
+ *     packet.set<1>(time);
+ *     fillSamples(packet.getPayload());
+ *     queue.send(packet.getBuffer());
+ * }
+ * \endcode
+ *
+ * \tparam Layout
+ *      PacketLayout of the beginning of the buffer
+ */
+template <typename Layout>
+class SharedBufferView
+{
+public:
+    /**
+     * Create an invalid view.
+     */
+    SharedBufferView() : mBuffer()
+    {
+    }
+
+    explicit SharedBufferView(const SharedBufferPointer& buffer) : mBuffer(buffer)
+    {
+    }
+
+    /**
+     * Check that the buffer is valid and large enough for the layout.
+     *
+     * The accessors must only be used for valid views.
+     */
+    inline bool
+    isValid() const
+    {
+        return mBuffer.getLength() >= Layout::size;
+    }
+
+    template <size_t index>
+    inline typename Layout::template Field<index>::Type
+    get() const
+    {
+        return Layout::template get<index>(&mBuffer[0]);
+    }
+
+    template <size_t index>
+    inline void
+    set(typename Layout::template Field<index>::Type value)
+    {
+        Layout::template set<index>(&mBuffer[0], value);
+    }
+
+    /**
+     * Write all fields of the layout.
+     */
+    template <typename... Ts>
+    inline void
+    store(Ts... values)
+    {
+        Layout::store(&mBuffer[0], values...);
+    }
+
+    /**
+     * Data following the fields of the layout.
+     */
+    inline outpost::Slice<uint8_t>
+    getPayload() const
+    {
+        return mBuffer.asSlice().skipFirst(Layout::size);
+    }
+
+    /**
+     * Reference the data following the fields of the layout as a child
+     * buffer, e.g. to pass it on to the next protocol layer.
+     *
+     * \return
+     *      false if the view is invalid or there is no payload
+     */
+    inline bool
+    getPayload(SharedChildPointer& child, uint16_t type) const
+    {
+        return isValid()
+               && mBuffer.getChild(
+                       child, type, Layout::size, mBuffer.getLength() - Layout::size);
+    }
+
+    inline const SharedBufferPointer&
+    getBuffer() const
+    {
+        return mBuffer;
+    }
+
+private:
+    SharedBufferPointer mBuffer;
+};
+
+}  // namespace utils
+}  // namespace outpost
+
+#endif
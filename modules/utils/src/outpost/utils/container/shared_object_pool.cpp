@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "shared_object_pool.h"
+
+#include <outpost/rtos/memory.h>
+
+#include <stdio.h>
+
+using outpost::utils::FixedSizeSharedBufferPoolBase;
+using outpost::utils::SharedBuffer;
+using outpost::utils::SharedBufferPointer;
+
+namespace
+{
+size_t
+roundUp(size_t value, size_t alignment)
+{
+    return ((value + alignment - 1) / alignment) * alignment;
+}
+
+size_t
+getAlignmentOffset(outpost::Slice<uint8_t> memory, size_t alignment)
+{
+    const uintptr_t address = reinterpret_cast<uintptr_t>(memory.begin());
+    return roundUp(address, alignment) - address;
+}
+
+size_t
+getNumberOfFittingElements(outpost::Slice<uint8_t> memory,
+                           size_t elementLength,
+                           size_t alignment,
+                           size_t maximum)
+{
+    const size_t offset = getAlignmentOffset(memory, alignment);
+    const size_t stride = roundUp(elementLength, alignment);
+    if ((elementLength == 0) || (offset + elementLength > memory.getNumberOfElements()))
+    {
+        return 0;
+    }
+
+    // The padding after the last element does not need to be part of the memory
+    const size_t fitting = (memory.getNumberOfElements() - offset - elementLength) / stride + 1;
+    return (fitting < maximum) ? fitting : maximum;
+}
+}  // namespace
+
+FixedSizeSharedBufferPoolBase::FixedSizeSharedBufferPoolBase(outpost::Slice<SharedBuffer> buffers,
+                                                             outpost::Slice<uint8_t> memory,
+                                                             size_t elementLength,
+                                                             size_t alignment) :
+    mBuffers(buffers),
+    mMemory(memory.skipFirst(getAlignmentOffset(memory, alignment))),
+    mElementLength(elementLength),
+    mStride(roundUp(elementLength, alignment)),
+    mNumberOfElements(getNumberOfFittingElements(
+            memory, elementLength, alignment, buffers.getNumberOfElements())),
+    mFreeList(nullptr),
+    mNumberOfFreeElements(mNumberOfElements),
+    mNumberOfInitializedElements(0)
+{
+}
+
+bool
+FixedSizeSharedBufferPoolBase::allocate(SharedBufferPointer& pointer)
+{
+    SharedBuffer* buffer = nullptr;
+    {
+        outpost::rtos::MutexGuard lock(mMutex);
+        buffer = take();
+        updateAllocationCounters(buffer != nullptr, mNumberOfElements - mNumberOfFreeElements);
+    }
+
+    // Assign outside of the lock, overwriting the previous content of pointer may
+    // release another buffer to this pool.
+    bool res = false;
+    if (buffer != nullptr)
+    {
+        pointer = SharedBufferPointer(buffer);
+        res = true;
+    }
+    return res;
+}
+
+SharedBuffer*
+FixedSizeSharedBufferPoolBase::take()
+{
+    SharedBuffer* buffer = mFreeList;
+    if (buffer != nullptr)
+    {
+        mFreeList = buffer->mNextFree;
+        buffer->mNextFree = nullptr;
+        mNumberOfFreeElements--;
+    }
+    else if (mNumberOfInitializedElements < mNumberOfElements)
+    {
+        // Buffers are set up in order, so that the first buffer is allocated first
+        const size_t index = mNumberOfInitializedElements++;
+        buffer = &mBuffers[index];
+        buffer->setPointer(mMemory.skipFirst(index * mStride).first(mElementLength));
+        adopt(*buffer);
+        mNumberOfFreeElements--;
+    }
+    return buffer;
+}
+
+size_t
+FixedSizeSharedBufferPoolBase::takeBuffers(outpost::Slice<SharedBuffer*> buffers)
+{
+    outpost::rtos::MutexGuard lock(mMutex);
+    size_t count = 0;
+    while (count < buffers.getNumberOfElements())
+    {
+        SharedBuffer* buffer = take();
+        if (buffer == nullptr)
+        {
+            break;
+        }
+        buffers[count++] = buffer;
+    }
+    return count;
+}
+
+void
+FixedSizeSharedBufferPoolBase::putBuffers(SharedBuffer* list)
+{
+    outpost::rtos::MutexGuard lock(mMutex);
+    while (list != nullptr)
+    {
+        SharedBuffer* next = list->mNextFree;
+        adopt(*list);
+        list->mNextFree = mFreeList;
+        mFreeList = list;
+        mNumberOfFreeElements++;
+        list = next;
+    }
+}
+
+void
+FixedSizeSharedBufferPoolBase::prefault(bool hugePages)
+{
+    if (mNumberOfElements == 0)
+    {
+        return;
+    }
+
+    const outpost::Slice<uint8_t> memory =
+            mMemory.first((mNumberOfElements - 1) * mStride + mElementLength);
+    if (hugePages)
+    {
+        outpost::rtos::Memory::adviseHugePages(memory);
+    }
+    outpost::rtos::Memory::prefault(memory);
+}
+
+void
+FixedSizeSharedBufferPoolBase::print() const
+{
+    for (unsigned int i = 0; i < mNumberOfElements; i++)
+    {
+        printf("SharedBuffer: %u (Address %p) : ", i, &mBuffers[i]);
+        if (mBuffers[i].isUsed())
+        {
+            printf("used (%lu)\n", mBuffers[i].getReferenceCount());
+        }
+        else
+        {
+            printf("free\n");
+        }
+    }
+    printf("\n");
+}
+
+void
+FixedSizeSharedBufferPoolBase::release(SharedBuffer& buffer)
+{
+    outpost::rtos::MutexGuard lock(mMutex);
+    buffer.mNextFree = mFreeList;
+    mFreeList = &buffer;
+    mNumberOfFreeElements++;
+}
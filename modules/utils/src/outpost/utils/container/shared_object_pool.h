@@ -17,7 +17,9 @@
 
 #include "shared_buffer.h"
 
+#include <outpost/base/callable.h>
 #include <outpost/rtos/mutex_guard.h>
+#include <outpost/utils/counter_block.h>
 #include <outpost/utils/container/list.h>
 
 namespace outpost
@@ -32,6 +34,20 @@ namespace utils
 class SharedBufferPoolBase
 {
 public:
+    /**
+     * \brief Member function called after a buffer has been returned to the pool.
+     */
+    typedef void (Callable::*ReleaseFunction)(SharedBufferPoolBase& pool);
+
+    SharedBufferPoolBase() :
+        mReleaseObject(nullptr),
+        mReleaseFunction(nullptr),
+        mNumberOfAllocations(0),
+        mNumberOfFailedAllocations(0),
+        mHighWaterMark(0)
+    {
+    }
+
     /**
      * \brief Allocation of an unused SharedBufferPoiner from the pool.
      *
@@ -41,6 +57,22 @@ public:
     virtual bool
     allocate(SharedBufferPointer& pointer) = 0;
 
+    /**
+     * \brief Allocation of an unused SharedBufferPointer for \p length bytes.
+     *
+     * Pools with several element sizes choose the smallest fitting one. The default
+     * implementation ignores \p length, the buffer may therefore be shorter than requested.
+     *
+     * \param pointer Reference to the SharedBufferPointer
+     * \param length Number of bytes to be stored in the buffer
+     * \return Returns true if a valid SharedBufferPointer was found, otherwise false.
+     */
+    virtual bool
+    allocateForLength(SharedBufferPointer& pointer, size_t /*length*/)
+    {
+        return allocate(pointer);
+    }
+
     /**
      * \brief Getter function for the overall number of elements in the pool.
      *
@@ -58,6 +90,76 @@ public:
     virtual size_t
     numberOfFreeElements() const = 0;
 
+    /**
+     * \brief Getter function for the number of elements currently in use.
+     */
+    inline size_t
+    numberOfUsedElements() const
+    {
+        return numberOfElements() - numberOfFreeElements();
+    }
+
+    /**
+     * \brief Register a callback which is invoked whenever the last SharedBufferPointer
+     * of a buffer is dropped and the buffer is back in the pool.
+     *
+     * The callback is executed in the context of the thread dropping the reference, after
+     * the pool lock has been released. It may therefore allocate from the pool again.
+     *
+     * \param object
+     *      Object to call, has to be a sub-class of outpost::Callable.
+     * \param function
+     *      Member function of \p object. A nullptr removes the callback.
+     */
+    template <typename T>
+    inline void
+    setReleaseCallback(T* object, void (T::*function)(SharedBufferPoolBase& pool))
+    {
+        mReleaseObject = reinterpret_cast<Callable*>(object);
+        mReleaseFunction = reinterpret_cast<ReleaseFunction>(function);
+    }
+
+    /**
+     * \brief Number of successful allocations since construction or the last resetCounters().
+     */
+    inline uint32_t
+    getNumberOfAllocations() const
+    {
+        return mNumberOfAllocations;
+    }
+
+    /**
+     * \brief Number of allocations that failed because the pool was exhausted.
+     */
+    inline uint32_t
+    getNumberOfFailedAllocations() const
+    {
+        return mNumberOfFailedAllocations;
+    }
+
+    /**
+     * \brief Maximum number of elements that were in use at the same time.
+     *
+     * Can be used to size the pool from real usage data.
+     */
+    inline size_t
+    getHighWaterMark() const
+    {
+        return mHighWaterMark;
+    }
+
+    /**
+     * \brief Resets the allocation counters and sets the high-water mark to the number of
+     * elements currently in use.
+     */
+    inline void
+    resetCounters()
+    {
+        mNumberOfAllocations = 0;
+        mNumberOfFailedAllocations = 0;
+        mHighWaterMark = numberOfUsedElements();
+    }
+
     /**
      * \brief Default destructor.
      *
@@ -65,62 +167,122 @@ public:
      * since this might free their underlying memory.
      */
     virtual ~SharedBufferPoolBase() = default;
-};
 
-/**
- * \ingroup SharedBuffer
- * \brief A SharedBufferPool holds SharedBuffer instances and allows for allocating matching
- * SharedBufferPointer instances these when needed.
- *
- * \tparam E Length of a single element in bytes
- * \tparam N Number of elements
- */
-template <size_t E, size_t N>
-class SharedBufferPool : public SharedBufferPoolBase
-{
-public:
-    SharedBufferPool() : mLastIndex(0)
+protected:
+    /**
+     * \brief Return an unused buffer to the pool.
+     *
+     * Called when the last SharedBufferPointer of the buffer is dropped.
+     *
+     * \param buffer Buffer owned by this pool whose reference count reached zero.
+     */
+    virtual void
+    release(SharedBuffer& buffer) = 0;
+
+    /**
+     * \brief Make this pool the owner of a buffer.
+     *
+     * release() is called for \p buffer once its last SharedBufferPointer is dropped. Allows
+     * pools to manage buffers whose memory is provided by someone else, e.g. a driver.
+     *
+     * \param buffer Unused buffer to take over.
+     */
+    inline void
+    adopt(SharedBuffer& buffer)
     {
-        for (size_t i = 0; i < N; i++)
+        buffer.mOwner = this;
+    }
+
+    /**
+     * \brief Update the counters after an allocation attempt.
+     *
+     * Has to be called with the pool locked.
+     *
+     * \param success      True if a buffer was allocated.
+     * \param usedElements Number of elements in use after the allocation.
+     */
+    inline void
+    updateAllocationCounters(bool success, size_t usedElements)
+    {
+        if (success)
         {
-            mBuffer[i].setPointer(outpost::Slice<uint8_t>::unsafe(mDataBuffer[i], E));
+            mNumberOfAllocations++;
+            if (usedElements > mHighWaterMark)
+            {
+                mHighWaterMark = usedElements;
+            }
+        }
+        else
+        {
+            mNumberOfFailedAllocations++;
         }
     }
 
+private:
+    friend class SharedBuffer;
+
     /**
-     * \brief Default destructor.
-     *
-     * Should not be called unless absolutely certain that all buffers in the pool are unused.
+     * \brief Called by the SharedBuffer when its reference count drops to zero.
      */
-    virtual ~SharedBufferPool() = default;
+    inline void
+    returnBuffer(SharedBuffer& buffer)
+    {
+        release(buffer);
+        if (mReleaseObject != nullptr && mReleaseFunction != nullptr)
+        {
+            (mReleaseObject->*mReleaseFunction)(*this);
+        }
+    }
+
+    Callable* mReleaseObject;
+    ReleaseFunction mReleaseFunction;
 
+    uint32_t mNumberOfAllocations;
+    uint32_t mNumberOfFailedAllocations;
+    size_t mHighWaterMark;
+};
+
+/**
+ * \ingroup SharedBuffer
+ * \brief Pool of SharedBuffer instances with a common element length.
+ *
+ * Unused buffers are kept in an intrusive free list. Dropping the last SharedBufferPointer of a
+ * buffer pushes it back onto the list, therefore allocation, release and numberOfFreeElements()
+ * are O(1) independent of the pool size and occupancy.
+ *
+ * Buffers are only set up when they are allocated for the first time. Constructing a pool is
+ * therefore O(1) as well and does not touch the buffer memory, which keeps the startup time
+ * independent of the pool configuration.
+ *
+ * The memory of the buffers is given by the sub-class, see SharedBufferPool and
+ * ExternalSharedBufferPool.
+ */
+class FixedSizeSharedBufferPoolBase : public SharedBufferPoolBase
+{
+public:
     /**
      * \brief Allocation of an unused SharedBufferPoiner from the pool.
      *
-     *  When looking for an unused element,
-     *  the element next to the one that was allocated last is considered first.
+     * Takes the first element of the free list, i.e. the most recently released buffer.
      *
      * \param pointer Reference to the SharedBufferPointer
      * \return Returns true if a valid SharedBudderPointer was found, otherwise false.
      */
     bool
-    allocate(SharedBufferPointer& pointer) override
-    {
-        outpost::rtos::MutexGuard lock(mMutex);
-        size_t i = mLastIndex;
-        bool res = false;
-        do
-        {
-            if (!mBuffer[i].isUsed())
-            {
-                pointer = SharedBufferPointer(&mBuffer[i]);
-                res = true;
-                mLastIndex = (i + 1) % N;
-            }
-            i = (i + 1) % N;
-        } while (i != mLastIndex && !res);
-        return res;
-    }
+    allocate(SharedBufferPointer& pointer) override;
+
+    /**
+     * \brief Touch the memory of all buffers, so that the first use of a buffer does not take
+     * a page fault.
+     *
+     * Call during the initialization, after the construction and before buffers are allocated.
+     * Only POSIX targets map memory on the first access, see outpost::rtos::Memory.
+     *
+     * \param hugePages Ask for transparent huge pages for large pools before touching the
+     * memory, fewer TLB entries are then needed to access the buffers.
+     */
+    void
+    prefault(bool hugePages = false);
 
     /**
      * \brief Prints the current state (used, unused) of all SharedBufferPointers in the pool.
@@ -128,22 +290,7 @@ public:
      * Used for optimization and debugging only.
      */
     void
-    print() const
-    {
-        for (unsigned int i = 0; i < N; i++)
-        {
-            printf("SharedBuffer: %u (Address %p) : ", i, &mBuffer[i]);
-            if (mBuffer[i].isUsed())
-            {
-                printf("used (%lu)\n", mBuffer[i].getReferenceCount());
-            }
-            else
-            {
-                printf("free\n");
-            }
-        }
-        printf("\n");
-    }
+    print() const;
 
     /**
      * \brief Getter function for the overall number of elements in the pool.
@@ -154,7 +301,7 @@ public:
     inline size_t
     numberOfElements() const override
     {
-        return N;
+        return mNumberOfElements;
     }
 
     /**
@@ -165,23 +312,298 @@ public:
     size_t
     numberOfFreeElements() const override
     {
-        size_t temp = 0;
-        for (size_t i = 0; i < N; i++)
+        return mNumberOfFreeElements;
+    }
+
+    /**
+     * \brief Distance between the start of two consecutive buffers in bytes.
+     *
+     * The element length rounded up to the alignment.
+     */
+    inline size_t
+    getStride() const
+    {
+        return mStride;
+    }
+
+protected:
+    /**
+     * \brief Place the buffers in \p memory.
+     *
+     * The first buffer starts at the first address within \p memory which is a multiple
+     * of \p alignment, the following ones are \p elementLength rounded up to a multiple of
+     * \p alignment apart. Buffers which do not fit into \p memory are not used.
+     *
+     * \param buffers       Unused SharedBuffer instances, the maximum number of elements.
+     * \param memory        Memory for the content of the buffers.
+     * \param elementLength Length of a single element in bytes.
+     * \param alignment     Alignment of the start of each element in bytes, a power of two.
+     */
+    FixedSizeSharedBufferPoolBase(outpost::Slice<SharedBuffer> buffers,
+                                  outpost::Slice<uint8_t> memory,
+                                  size_t elementLength,
+                                  size_t alignment);
+
+    /**
+     * \brief Default destructor.
+     *
+     * Should not be called unless absolutely certain that all buffers in the pool are unused.
+     */
+    virtual ~FixedSizeSharedBufferPoolBase() = default;
+
+    void
+    release(SharedBuffer& buffer) override;
+
+private:
+    friend class SharedBufferPoolCacheBase;
+
+    /**
+     * \brief Takes an unused buffer, has to be called with the pool locked.
+     *
+     * \return Returns nullptr if the pool is exhausted.
+     */
+    SharedBuffer*
+    take();
+
+    /**
+     * \brief Takes up to the number of elements of \p buffers unused buffers with a single lock.
+     *
+     * Used by SharedBufferPoolCache, the buffers count as used until they are put back.
+     *
+     * \return Returns the number of buffers taken.
+     */
+    size_t
+    takeBuffers(outpost::Slice<SharedBuffer*> buffers);
+
+    /**
+     * \brief Puts a list of unused buffers, linked via SharedBuffer::mNextFree, back with a
+     * single lock and makes this pool their owner again.
+     */
+    void
+    putBuffers(SharedBuffer* list);
+
+    const outpost::Slice<SharedBuffer> mBuffers;
+    const outpost::Slice<uint8_t> mMemory;
+    const size_t mElementLength;
+    const size_t mStride;
+    const size_t mNumberOfElements;
+
+    /// Head of the intrusive list of released buffers, linked via SharedBuffer::mNextFree.
+    SharedBuffer* mFreeList;
+    size_t mNumberOfFreeElements;
+
+    /// Buffers starting at this index have never been allocated.
+    size_t mNumberOfInitializedElements;
+
+    outpost::rtos::Mutex mMutex;
+};
+
+namespace internal
+{
+// Constructed before the FixedSizeSharedBufferPoolBase, which links the buffers
+template <size_t N>
+class SharedBufferStorage
+{
+protected:
+    SharedBuffer mBuffer[N];
+};
+
+template <size_t E, size_t N, size_t alignment>
+class SharedBufferPoolStorage : protected SharedBufferStorage<N>
+{
+protected:
+    static constexpr size_t stride = ((E + alignment - 1) / alignment) * alignment;
+
+    // The array starts at a word boundary, at most the alignment minus one word is skipped
+    // to reach the start of the first buffer. Same approach as in CounterBlock, alignas()
+    // would not be honoured by operator new before C++17.
+    uint8_t mDataBuffer[N * stride + ((alignment > 4) ? (alignment - 4) : 0)]
+            __attribute__((aligned(4)));
+};
+}  // namespace internal
+
+/**
+ * \ingroup SharedBuffer
+ * \brief A SharedBufferPool holds SharedBuffer instances and allows for allocating matching
+ * SharedBufferPointer instances these when needed.
+ *
+ * The content of the buffers is part of the pool object. Each buffer starts at a multiple of
+ * \p alignment, e.g. outpost::utils::cacheLineSize to avoid that two buffers share a cache
+ * line. See ExternalSharedBufferPool to place the buffers in a specific memory section.
+ *
+ * \tparam E         Length of a single element in bytes
+ * \tparam N         Number of elements
+ * \tparam alignment Alignment of each element in bytes, a power of two.
+ */
+template <size_t E, size_t N, size_t alignment = 4>
+class SharedBufferPool : private internal::SharedBufferPoolStorage<E, N, alignment>,
+                         public FixedSizeSharedBufferPoolBase
+{
+    static_assert((alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+public:
+    SharedBufferPool() :
+        FixedSizeSharedBufferPoolBase(
+                outpost::asSlice(this->mBuffer), outpost::asSlice(this->mDataBuffer), E, alignment)
+    {
+    }
+
+    /**
+     * \brief Default destructor.
+     *
+     * Should not be called unless absolutely certain that all buffers in the pool are unused.
+     */
+    virtual ~SharedBufferPool() = default;
+};
+
+/**
+ * \ingroup SharedBuffer
+ * \brief Pool for buffers in memory provided by the caller.
+ *
+ * Allows placing the buffers in a memory section reachable by a DMA controller or in uncached
+ * memory, so that e.g. a SpaceWire driver can receive directly into pool buffers.
+ *
+ * \code
+ * typedef outpost::utils::ExternalSharedBufferPool<16> Pool;
+ *
+ * uint8_t memory[Pool::getRequiredMemory(4500, 32)] __attribute__((section(".dma")));
+ * Pool pool(outpost::asSlice(memory), 4500, 32);
+ * \endcode
+ *
+ * \tparam N Maximum number of elements
+ */
+template <size_t N>
+class ExternalSharedBufferPool : private internal::SharedBufferStorage<N>,
+                                 public FixedSizeSharedBufferPoolBase
+{
+public:
+    /**
+     * \brief Memory required for N elements, including the space skipped for aligning
+     * the first element at any start address.
+     */
+    static constexpr size_t
+    getRequiredMemory(size_t elementLength, size_t alignment)
+    {
+        return N * (((elementLength + alignment - 1) / alignment) * alignment) + alignment - 1;
+    }
+
+    /**
+     * \param memory
+     *      Memory for the content of the buffers. Has to live as long as the pool. If it is
+     *      smaller than getRequiredMemory() less than N buffers are available, see
+     *      numberOfElements().
+     * \param elementLength
+     *      Length of a single element in bytes.
+     * \param alignment
+     *      Alignment of each element in bytes, a power of two.
+     */
+    ExternalSharedBufferPool(outpost::Slice<uint8_t> memory,
+                             size_t elementLength,
+                             size_t alignment = cacheLineSize) :
+        FixedSizeSharedBufferPoolBase(
+                outpost::asSlice(this->mBuffer), memory, elementLength, alignment)
+    {
+    }
+
+    virtual ~ExternalSharedBufferPool() = default;
+};
+
+/**
+ * \ingroup SharedBuffer
+ * \brief Pool with two element sizes, chosen by the length of the content.
+ *
+ * Allows to provide a few large buffers for rare large packets and many
+ * small ones for the frequent short packets, instead of sizing all buffers
+ * for the largest packet. allocateForLength() takes a small buffer if the
+ * content fits and falls back to a large one if all small buffers are in
+ * use. Content larger than a small buffer only gets a large buffer so that
+ * it is never cut.
+ *
+ * Buffers are returned to the internal pools, release callbacks have to be
+ * registered there, see getSmallPool() and getLargePool().
+ *
+ * \tparam smallLength    Length of a small element in bytes
+ * \tparam numberOfSmall  Number of small elements
+ * \tparam largeLength    Length of a large element in bytes
+ * \tparam numberOfLarge  Number of large elements
+ */
+template <size_t smallLength, size_t numberOfSmall, size_t largeLength, size_t numberOfLarge>
+class SizeClassSharedBufferPool : public SharedBufferPoolBase
+{
+    static_assert(smallLength < largeLength, "Small elements must be shorter than large ones");
+
+public:
+    SizeClassSharedBufferPool() = default;
+
+    virtual ~SizeClassSharedBufferPool() = default;
+
+    /**
+     * \brief Allocation of a buffer for content of unknown length.
+     *
+     * Prefers a large buffer, so that the content fits.
+     */
+    bool
+    allocate(SharedBufferPointer& pointer) override
+    {
+        bool res = mLargePool.allocate(pointer) || mSmallPool.allocate(pointer);
+        outpost::rtos::MutexGuard lock(mMutex);
+        updateAllocationCounters(res, numberOfUsedElements());
+        return res;
+    }
+
+    bool
+    allocateForLength(SharedBufferPointer& pointer, size_t length) override
+    {
+        bool res = false;
+        if (length <= smallLength)
         {
-            if (!mBuffer[i].isUsed())
-            {
-                temp++;
-            }
+            res = mSmallPool.allocate(pointer) || mLargePool.allocate(pointer);
         }
-        return temp;
+        else
+        {
+            res = mLargePool.allocate(pointer);
+        }
+        outpost::rtos::MutexGuard lock(mMutex);
+        updateAllocationCounters(res, numberOfUsedElements());
+        return res;
+    }
+
+    size_t
+    numberOfElements() const override
+    {
+        return numberOfSmall + numberOfLarge;
+    }
+
+    size_t
+    numberOfFreeElements() const override
+    {
+        return mSmallPool.numberOfFreeElements() + mLargePool.numberOfFreeElements();
+    }
+
+    inline SharedBufferPool<smallLength, numberOfSmall>&
+    getSmallPool()
+    {
+        return mSmallPool;
+    }
+
+    inline SharedBufferPool<largeLength, numberOfLarge>&
+    getLargePool()
+    {
+        return mLargePool;
     }
 
 protected:
-    uint8_t mDataBuffer[N][E] __attribute__((aligned(4)));
-    SharedBuffer mBuffer[N];
+    void
+    release(SharedBuffer& /*buffer*/) override
+    {
+        // All buffers are owned by the internal pools
+    }
 
-    size_t mLastIndex;
+private:
+    SharedBufferPool<smallLength, numberOfSmall> mSmallPool;
+    SharedBufferPool<largeLength, numberOfLarge> mLargePool;
 
+    /// Protects the allocation counters
     outpost::rtos::Mutex mMutex;
 };
 
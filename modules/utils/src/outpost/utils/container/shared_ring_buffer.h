@@ -30,6 +30,8 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <utility>
+
 namespace outpost
 {
 namespace utils
@@ -118,6 +120,36 @@ public:
         return appended;
     }
 
+    /**
+     * \brief Moves an element into the first unoccupied index and updates the writeIndex.
+     *
+     * In contrast to append(const SharedBufferPointer&, uint8_t) no reference count update is
+     * necessary. \p p is only moved from if it could be stored.
+     *
+     * \param p SharedBufferPointer to be stored
+     * \param flags Additional flags for the SharedBufferPointer that may be set.
+     *
+     * \return Returns true if the element could be stored in the SharedRingBuffer, otherwise false.
+     */
+    inline bool
+    append(SharedBufferPointer&& p, uint8_t flags = 0)
+    {
+        bool appended = false;
+        if ((mNumberOfElements < mBuffer.getNumberOfElements()))
+        {
+            // calculate write index
+            int writeIndex = increment(mReadIndex, mNumberOfElements);
+
+            mFlags[writeIndex] = flags;
+            mBuffer[writeIndex] = std::move(p);
+            ++mNumberOfElements;
+
+            appended = true;
+        }
+
+        return appended;
+    }
+
     /**
      * \brief Checks if the buffer is empty.
      *
@@ -193,6 +225,31 @@ public:
         return elementRemoved;
     }
 
+    /**
+     * \brief Moves the element at the current read pointer out of the SharedRingBuffer and
+     * removes it.
+     *
+     * \param p Receives the removed element.
+     *
+     * \return Returns true if the element was removed, false if the buffer is empty and no element
+     * was removed.
+     */
+    inline bool
+    pop(SharedBufferPointer& p)
+    {
+        bool elementRemoved = false;
+
+        if (mNumberOfElements > 0)
+        {
+            p = std::move(mBuffer[mReadIndex]);
+            mReadIndex = increment(mReadIndex, 1);
+            --mNumberOfElements;
+            elementRemoved = true;
+        }
+
+        return elementRemoved;
+    }
+
     /**
      * \brief Provides the means to access one specific element.
      *
@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_SKIP_LIST_H
+#define OUTPOST_UTILS_SKIP_LIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+template <typename T>
+class SkipList;
+
+class SkipListElement
+{
+    template <typename T>
+    friend class SkipList;
+
+public:
+    /**
+     * Maximum number of levels of a node.
+     *
+     * Every fourth node is promoted to the next level, the list stays
+     * efficient up to 4^maximumLevel (65536) nodes.
+     */
+    static constexpr size_t maximumLevel = 8;
+
+    SkipListElement() = default;
+
+    // Copying/Assignment does not put a element in a list or removes it
+    SkipListElement(const SkipListElement&) : mNext(), mLevel(0)
+    {
+    }
+
+    SkipListElement&
+    operator=(const SkipListElement&)
+    {
+        return *this;
+    }
+
+private:
+    SkipListElement* mNext[maximumLevel] = {};
+
+    /// Number of levels the node is linked in
+    uint8_t mLevel = 0;
+};
+
+/**
+ * Sorted singly-linked skip list with external storage.
+ *
+ * Replacement for `List::insert()` for long sorted lists, e.g. time
+ * ordered schedules. Inserting and removing a node needs O(log N) steps
+ * on average instead of O(N), the smallest node is accessed and removed
+ * in O(1).
+ *
+ * Nodes with equal keys stay in the order in which they have been
+ * inserted. The levels of the nodes are chosen by a pseudo random
+ * generator with a fixed seed, no memory is allocated.
+ *
+ * The nodes must be derived from `SkipListElement` and comparable via
+ * `operator<`, which shall produce a strict weak ordering.
+ *
+ * \code
+ * struct Command : public outpost::SkipListElement
+ * {
+ *     bool
+ *     operator<(const Command& other) const
+ *     {
+ *         return mTime < other.mTime;
+ *     }
+ *
+ *     outpost::time::SpacecraftElapsedTime mTime;
+ * };
+ *
+ * outpost::SkipList<Command> schedule;
+ * schedule.insert(&command);
+ * ...
+ * while (!schedule.isEmpty() && (schedule.first()->mTime <= now))
+ * {
+ *     execute(*schedule.removeFirst());
+ * }
+ * \endcode
+ */
+template <typename T>
+class SkipList
+{
+public:
+    /**
+     * Construct an empty list.
+     */
+    SkipList();
+
+    // disable copy constructor
+    SkipList(const SkipList&) = delete;
+
+    // disable copy assignment operator
+    SkipList&
+    operator=(const SkipList&) = delete;
+
+    /**
+     * Remove all entries from the list.
+     *
+     * The nodes are not changed only the link to the first node is
+     * removed!
+     *
+     * O(1)
+     */
+    void
+    reset();
+
+    inline bool
+    isEmpty() const
+    {
+        return (mHead.mNext[0] == nullptr);
+    }
+
+    /**
+     * Number of nodes in the list.
+     *
+     * O(1)
+     */
+    inline size_t
+    size() const
+    {
+        return mSize;
+    }
+
+    /**
+     * Get the smallest node of the list.
+     *
+     * O(1)
+     */
+    inline T*
+    first()
+    {
+        return static_cast<T*>(mHead.mNext[0]);
+    }
+
+    inline const T*
+    first() const
+    {
+        return static_cast<const T*>(mHead.mNext[0]);
+    }
+
+    /**
+     * Insert a node sorted into the list.
+     *
+     * The node is placed behind all nodes with an equal key.
+     *
+     * O(log N) on average
+     */
+    void
+    insert(T* node);
+
+    /**
+     * Remove the smallest node from the list.
+     *
+     * O(1)
+     *
+     * \return  Removed node or nullptr if the list is empty.
+     */
+    T*
+    removeFirst();
+
+    /**
+     * Remove a node from the list.
+     *
+     * O(log N) on average, plus the number of nodes with a key equal to
+     * the key of the node.
+     *
+     * \retval \c true if the node was found and removed from list,
+     * \retval \c false if the node is not in the list.
+     */
+    bool
+    removeNode(T* node);
+
+    /**
+     * Iterates over the nodes in ascending order.
+     */
+    class Iterator
+    {
+    public:
+        friend class SkipList;
+
+        Iterator() : mNode(nullptr)
+        {
+        }
+
+        inline Iterator&
+        operator++()
+        {
+            mNode = mNode->mNext[0];
+            return *this;
+        }
+
+        inline bool
+        operator==(const Iterator& other) const
+        {
+            return (mNode == other.mNode);
+        }
+
+        inline bool
+        operator!=(const Iterator& other) const
+        {
+            return (mNode != other.mNode);
+        }
+
+        inline T& operator*()
+        {
+            return *static_cast<T*>(mNode);
+        }
+
+        inline T* operator->()
+        {
+            return static_cast<T*>(mNode);
+        }
+
+    private:
+        explicit Iterator(SkipListElement* node) : mNode(node)
+        {
+        }
+
+        /// Pointer to the current node. Set to NULL if end of list.
+        SkipListElement* mNode;
+    };
+
+    inline Iterator
+    begin()
+    {
+        return Iterator(mHead.mNext[0]);
+    }
+
+    inline Iterator
+    end()
+    {
+        return Iterator(nullptr);
+    }
+
+private:
+    uint8_t
+    getRandomLevel();
+
+    /// Links to the first node of each level
+    SkipListElement mHead;
+
+    /// Number of levels used by at least one node
+    size_t mLevel;
+    size_t mSize;
+
+    /// State of the xorshift generator used to choose the node levels
+    uint32_t mRandomState;
+};
+}  // namespace outpost
+
+#include "skip_list_impl.h"
+
+#endif
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_SKIP_LIST_IMPL_H
+#define OUTPOST_UTILS_SKIP_LIST_IMPL_H
+
+#include "skip_list.h"
+
+#include <type_traits>
+
+// ----------------------------------------------------------------------------
+template <typename T>
+outpost::SkipList<T>::SkipList() : mHead(), mLevel(0), mSize(0), mRandomState(2463534242U)
+{
+    static_assert(std::is_base_of<outpost::SkipListElement, T>::value,
+                  "T not derived from SkipListElement");
+}
+
+template <typename T>
+void
+outpost::SkipList<T>::reset()
+{
+    for (size_t level = 0; level < SkipListElement::maximumLevel; ++level)
+    {
+        mHead.mNext[level] = nullptr;
+    }
+    mLevel = 0;
+    mSize = 0;
+}
+
+template <typename T>
+uint8_t
+outpost::SkipList<T>::getRandomLevel()
+{
+    // xorshift32
+    uint32_t x = mRandomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    mRandomState = x;
+
+    // Each further level with a probability of 1/4
+    uint8_t level = 1;
+    while (((x & 3) == 0) && (level < SkipListElement::maximumLevel))
+    {
+        level++;
+        x >>= 2;
+    }
+    return level;
+}
+
+// ----------------------------------------------------------------------------
+template <typename T>
+void
+outpost::SkipList<T>::insert(T* node)
+{
+    SkipListElement* previous[SkipListElement::maximumLevel];
+
+    // Find the last node on each level which is not greater than the new
+    // node, so that the new node is placed behind nodes with equal keys.
+    SkipListElement* current = &mHead;
+    for (size_t level = mLevel; level > 0; --level)
+    {
+        SkipListElement* next = current->mNext[level - 1];
+        while ((next != nullptr) && !(*node < *static_cast<T*>(next)))
+        {
+            current = next;
+            next = current->mNext[level - 1];
+        }
+        previous[level - 1] = current;
+    }
+
+    const uint8_t nodeLevel = getRandomLevel();
+    while (mLevel < nodeLevel)
+    {
+        previous[mLevel] = &mHead;
+        mLevel++;
+    }
+
+    for (size_t level = 0; level < nodeLevel; ++level)
+    {
+        node->mNext[level] = previous[level]->mNext[level];
+        previous[level]->mNext[level] = node;
+    }
+    for (size_t level = nodeLevel; level < SkipListElement::maximumLevel; ++level)
+    {
+        node->mNext[level] = nullptr;
+    }
+    node->mLevel = nodeLevel;
+    mSize++;
+}
+
+template <typename T>
+T*
+outpost::SkipList<T>::removeFirst()
+{
+    SkipListElement* node = mHead.mNext[0];
+    if (node != nullptr)
+    {
+        // The first node is the first one on all of its levels
+        for (size_t level = 0; level < node->mLevel; ++level)
+        {
+            mHead.mNext[level] = node->mNext[level];
+            node->mNext[level] = nullptr;
+        }
+        node->mLevel = 0;
+
+        while ((mLevel > 0) && (mHead.mNext[mLevel - 1] == nullptr))
+        {
+            mLevel--;
+        }
+        mSize--;
+    }
+    return static_cast<T*>(node);
+}
+
+template <typename T>
+bool
+outpost::SkipList<T>::removeNode(T* node)
+{
+    SkipListElement* previous[SkipListElement::maximumLevel];
+
+    // Find the last node on each level which is less than the node
+    SkipListElement* current = &mHead;
+    for (size_t level = mLevel; level > 0; --level)
+    {
+        SkipListElement* next = current->mNext[level - 1];
+        while ((next != nullptr) && (*static_cast<T*>(next) < *node))
+        {
+            current = next;
+            next = current->mNext[level - 1];
+        }
+        previous[level - 1] = current;
+    }
+    if (mLevel == 0)
+    {
+        return false;
+    }
+
+    // Skip the nodes with an equal key on the lowest level first, the level
+    // of the node is only valid if it is part of the list.
+    for (size_t level = 0; (level == 0) || (level < node->mLevel); ++level)
+    {
+        current = previous[level];
+        SkipListElement* next = current->mNext[level];
+        while ((next != node) && (next != nullptr) && !(*node < *static_cast<T*>(next)))
+        {
+            current = next;
+            next = current->mNext[level];
+        }
+        if (next != node)
+        {
+            return false;
+        }
+        previous[level] = current;
+    }
+
+    for (size_t level = 0; level < node->mLevel; ++level)
+    {
+        previous[level]->mNext[level] = node->mNext[level];
+        node->mNext[level] = nullptr;
+    }
+    node->mLevel = 0;
+
+    while ((mLevel > 0) && (mHead.mNext[mLevel - 1] == nullptr))
+    {
+        mLevel--;
+    }
+    mSize--;
+    return true;
+}
+
+#endif
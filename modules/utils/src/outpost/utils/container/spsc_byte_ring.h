@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_SPSC_BYTE_RING_H_
+#define OUTPOST_UTILS_SPSC_BYTE_RING_H_
+
+#include <outpost/base/slice.h>
+#include <outpost/rtos/atomic.h>
+#include <outpost/utils/minmax.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace outpost
+{
+namespace utils
+{
+/**
+ * Lock-free single-producer/single-consumer ring of bytes.
+ *
+ * In contrast to SpscQueue both sides can work on contiguous spans of the
+ * storage: the producer (e.g. an ISR or a DMA transfer) may write directly
+ * into getWritableSpan() and the consumer may parse getReadableSpan() in
+ * place. Committing or consuming a span only updates an atomic index.
+ *
+ * The ring does not block, waiting has to be implemented by the user.
+ *
+ * Both sides only load and store the indices of outpost::rtos::Atomic,
+ * which is ISR-safe on all targets, so either side may run in an ISR.
+ *
+ * \warning Only one thread (or ISR) may produce and only one thread (or
+ *          ISR) may consume at the same time.
+ */
+class SpscByteRing
+{
+public:
+    /**
+     * \param storage
+     *      Memory for the bytes, defines the capacity of the ring. Must
+     *      stay valid for the lifetime of the ring.
+     */
+    explicit SpscByteRing(outpost::Slice<uint8_t> storage) : mStorage(storage), mHead(0), mTail(0)
+    {
+    }
+
+    // disable copy constructor
+    SpscByteRing(const SpscByteRing& other) = delete;
+
+    // disable assignment operator
+    SpscByteRing&
+    operator=(const SpscByteRing& other) = delete;
+
+    inline size_t
+    getCapacity() const
+    {
+        return mStorage.getNumberOfElements();
+    }
+
+    inline size_t
+    getNumberOfBytes() const
+    {
+        return distance(mHead.load(), mTail.load());
+    }
+
+    inline size_t
+    getFreeSpace() const
+    {
+        return getCapacity() - getNumberOfBytes();
+    }
+
+    inline bool
+    isEmpty() const
+    {
+        return getNumberOfBytes() == 0;
+    }
+
+    // ------------------------------------------------------------------------
+    // Producer
+
+    /**
+     * Largest contiguous free region, starting at the write position.
+     *
+     * May be shorter than getFreeSpace() if the free space wraps around
+     * the end of the storage.
+     */
+    inline outpost::Slice<uint8_t>
+    getWritableSpan() const
+    {
+        const size_t tail = mTail.load();
+        const size_t free = getCapacity() - distance(mHead.load(), tail);
+        const size_t position = slot(tail);
+        const size_t contiguous = getCapacity() - position;
+        return mStorage.subSlice(position, min<size_t>(free, contiguous));
+    }
+
+    /**
+     * Publish \p count bytes written to getWritableSpan().
+     */
+    inline void
+    commitWrite(size_t count)
+    {
+        mTail.store(advance(mTail.load(), count));
+    }
+
+    /**
+     * Copy bytes into the ring.
+     *
+     * \return  Number of bytes stored, less than \p data if the ring is full.
+     */
+    inline size_t
+    write(outpost::Slice<const uint8_t> data)
+    {
+        size_t written = 0;
+        while (written < data.getNumberOfElements())
+        {
+            outpost::Slice<uint8_t> span = getWritableSpan();
+            const size_t remaining = data.getNumberOfElements() - written;
+            const size_t count = min<size_t>(span.getNumberOfElements(), remaining);
+            if (count == 0)
+            {
+                break;
+            }
+            memcpy(&span[0], &data[written], count);
+            commitWrite(count);
+            written += count;
+        }
+        return written;
+    }
+
+    // ------------------------------------------------------------------------
+    // Consumer
+
+    /**
+     * Largest contiguous region of stored bytes, starting with the oldest.
+     *
+     * May be shorter than getNumberOfBytes() if the stored bytes wrap
+     * around the end of the storage.
+     */
+    inline outpost::Slice<const uint8_t>
+    getReadableSpan() const
+    {
+        const size_t head = mHead.load();
+        const size_t used = distance(head, mTail.load());
+        const size_t position = slot(head);
+        const size_t contiguous = getCapacity() - position;
+        return mStorage.subSlice(position, min<size_t>(used, contiguous));
+    }
+
+    /**
+     * Release the oldest \p count bytes, at most getNumberOfBytes().
+     */
+    inline void
+    consume(size_t count)
+    {
+        mHead.store(advance(mHead.load(), count));
+    }
+
+    /**
+     * Copy and consume the oldest bytes.
+     *
+     * \return  Number of bytes copied to \p data.
+     */
+    inline size_t
+    read(outpost::Slice<uint8_t> data)
+    {
+        size_t copied = 0;
+        while (copied < data.getNumberOfElements())
+        {
+            outpost::Slice<const uint8_t> span = getReadableSpan();
+            const size_t remaining = data.getNumberOfElements() - copied;
+            const size_t count = min<size_t>(span.getNumberOfElements(), remaining);
+            if (count == 0)
+            {
+                break;
+            }
+            memcpy(&data[copied], &span[0], count);
+            consume(count);
+            copied += count;
+        }
+        return copied;
+    }
+
+private:
+    // mHead and mTail run in [0, 2 * capacity) to distinguish full from empty
+    inline size_t
+    distance(size_t head, size_t tail) const
+    {
+        return (tail >= head) ? (tail - head) : (tail + 2 * getCapacity() - head);
+    }
+
+    inline size_t
+    advance(size_t index, size_t count) const
+    {
+        index += count;
+        return (index < 2 * getCapacity()) ? index : (index - 2 * getCapacity());
+    }
+
+    inline size_t
+    slot(size_t index) const
+    {
+        return (index < getCapacity()) ? index : (index - getCapacity());
+    }
+
+    const outpost::Slice<uint8_t> mStorage;
+    outpost::rtos::Atomic<size_t> mHead;
+    outpost::rtos::Atomic<size_t> mTail;
+};
+
+}  // namespace utils
+}  // namespace outpost
+
+#endif /* OUTPOST_UTILS_SPSC_BYTE_RING_H_ */
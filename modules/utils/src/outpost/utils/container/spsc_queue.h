@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_SPSC_QUEUE_H_
+#define OUTPOST_UTILS_SPSC_QUEUE_H_
+
+#include <outpost/base/slice.h>
+#include <outpost/rtos/atomic.h>
+#include <outpost/rtos/semaphore.h>
+#include <outpost/time/duration.h>
+
+#include <stddef.h>
+
+#include <utility>
+
+namespace outpost
+{
+namespace utils
+{
+/**
+ * Bounded single-producer/single-consumer queue.
+ *
+ * Sending and receiving only update an atomic index each, no mutex is
+ * involved. The semaphores are only touched when the consumer may wait for
+ * data (queue was empty) or the producer may wait for space (queue was
+ * full), so an uncontended queue needs no system call at all.
+ *
+ * The storage is provided by the user, e.g. a static array, and must stay
+ * valid for the lifetime of the queue. All slots can hold an element.
+ *
+ * A producer running in an ISR has to use sendFromInterrupt(). The
+ * indices are only loaded and stored, which outpost::rtos::Atomic
+ * supports in an ISR on all targets.
+ *
+ * \warning Only one thread (or ISR) may send and only one thread may
+ *          receive at the same time.
+ *
+ * \tparam T
+ *      Element type, must be default constructible and assignable.
+ */
+template <typename T>
+class SpscQueue
+{
+public:
+    /**
+     * \param storage
+     *      Memory for the elements, defines the capacity of the queue.
+     */
+    explicit SpscQueue(outpost::Slice<T> storage) :
+        mStorage(storage),
+        mHead(0),
+        mTail(0),
+        mDataAvailable(outpost::rtos::BinarySemaphore::State::acquired),
+        mSpaceAvailable(outpost::rtos::BinarySemaphore::State::acquired)
+    {
+    }
+
+    // disable copy constructor
+    SpscQueue(const SpscQueue& other) = delete;
+
+    // disable assignment operator
+    SpscQueue&
+    operator=(const SpscQueue& other) = delete;
+
+    /**
+     * Append an element, never blocks.
+     *
+     * \retval true     Element was stored.
+     * \retval false    Queue is full.
+     */
+    inline bool
+    send(const T& data)
+    {
+        return push(data, false);
+    }
+
+    /**
+     * Move an element into the queue, never blocks.
+     *
+     * \p data is only moved from if it could be stored.
+     */
+    inline bool
+    send(T&& data)
+    {
+        return push(std::move(data), false);
+    }
+
+    /**
+     * Append an element from an interrupt handler, never blocks.
+     *
+     * Same as send(const T&) but wakes a waiting consumer with
+     * BinarySemaphore::releaseFromInterrupt(). May only be called from
+     * interrupt context.
+     */
+    inline bool
+    sendFromInterrupt(const T& data)
+    {
+        return push(data, true);
+    }
+
+    /**
+     * Append an element, wait at most \p timeout for free space.
+     */
+    bool
+    send(const T& data, outpost::time::Duration timeout)
+    {
+        while (!push(data, false))
+        {
+            if (!mSpaceAvailable.acquire(timeout))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Remove the oldest element.
+     *
+     * \param data
+     *      Receives the element, unchanged if no element was available.
+     * \param timeout
+     *      Maximum time to wait for an element, zero for a non-blocking call.
+     *
+     * \retval true     Element was received.
+     * \retval false    Timeout occurred.
+     */
+    bool
+    receive(T& data, outpost::time::Duration timeout = outpost::time::Duration::infinity())
+    {
+        while (!pop(data))
+        {
+            if (!mDataAvailable.acquire(timeout))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    inline size_t
+    getNumberOfItems() const
+    {
+        return distance(mHead.load(), mTail.load());
+    }
+
+    inline size_t
+    getCapacity() const
+    {
+        return mStorage.getNumberOfElements();
+    }
+
+    inline bool
+    isEmpty() const
+    {
+        return getNumberOfItems() == 0;
+    }
+
+    inline bool
+    isFull() const
+    {
+        return getNumberOfItems() >= getCapacity();
+    }
+
+private:
+    // mHead and mTail run in [0, 2 * capacity) to distinguish full from empty
+    inline size_t
+    distance(size_t head, size_t tail) const
+    {
+        return (tail >= head) ? (tail - head) : (tail + 2 * getCapacity() - head);
+    }
+
+    inline size_t
+    advance(size_t index) const
+    {
+        return (index + 1 < 2 * getCapacity()) ? (index + 1) : 0;
+    }
+
+    inline size_t
+    slot(size_t index) const
+    {
+        return (index < getCapacity()) ? index : (index - getCapacity());
+    }
+
+    template <typename U>
+    bool
+    push(U&& data, bool fromInterrupt)
+    {
+        const size_t tail = mTail.load();
+        const size_t head = mHead.load();
+        if (distance(head, tail) >= getCapacity())
+        {
+            return false;
+        }
+        mStorage[slot(tail)] = std::forward<U>(data);
+        mTail.store(advance(tail));
+
+        // Re-read the head after publishing: if the consumer has taken
+        // everything before our element it might be waiting for it.
+        if (mHead.load() == tail)
+        {
+            if (fromInterrupt)
+            {
+                mDataAvailable.releaseFromInterrupt();
+            }
+            else
+            {
+                mDataAvailable.release();
+            }
+        }
+        return true;
+    }
+
+    bool
+    pop(T& data)
+    {
+        const size_t head = mHead.load();
+        const size_t tail = mTail.load();
+        if (head == tail)
+        {
+            return false;
+        }
+        data = std::move(mStorage[slot(head)]);
+        mHead.store(advance(head));
+
+        // Same for the producer, it might be waiting if the queue was full
+        // right before this element was taken.
+        if (distance(head, mTail.load()) >= getCapacity())
+        {
+            mSpaceAvailable.release();
+        }
+        return true;
+    }
+
+    outpost::Slice<T> mStorage;
+    outpost::rtos::Atomic<size_t> mHead;
+    outpost::rtos::Atomic<size_t> mTail;
+    outpost::rtos::BinarySemaphore mDataAvailable;
+    outpost::rtos::BinarySemaphore mSpaceAvailable;
+};
+
+}  // namespace utils
+}  // namespace outpost
+
+#endif /* OUTPOST_UTILS_SPSC_QUEUE_H_ */
@@ -0,0 +1,605 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_STATIC_HASH_MAP_H
+#define OUTPOST_UTILS_STATIC_HASH_MAP_H
+
+#include <outpost/utils/meta.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace internal
+{
+// Not constexpr on purpose: reaching one of these functions while
+// evaluating a constexpr StaticHashMap aborts the compilation.
+inline uint32_t
+staticHashMapNoSeedFound()
+{
+    return 0;
+}
+
+inline uint32_t
+staticHashMapDuplicateKeys()
+{
+    return 0;
+}
+
+constexpr uint32_t
+staticHashFinalize(uint32_t x)
+{
+    return x ^ (x >> 16);
+}
+
+constexpr uint32_t
+staticHashRound2(uint32_t x)
+{
+    return staticHashFinalize((x ^ (x >> 13)) * 0xC2B2AE35U);
+}
+
+/**
+ * Finalizer of MurmurHash3.
+ */
+constexpr uint32_t
+staticHashMix(uint32_t x)
+{
+    return staticHashRound2((x ^ (x >> 16)) * 0x85EBCA6BU);
+}
+
+constexpr uint32_t
+staticHash(uint64_t key, uint32_t seed)
+{
+    return staticHashMix(static_cast<uint32_t>(key)
+                         ^ staticHashMix(static_cast<uint32_t>(key >> 32) ^ seed));
+}
+
+constexpr size_t
+staticHashMapBucketCount(size_t n, size_t buckets = 1)
+{
+    return (buckets >= n) ? buckets : staticHashMapBucketCount(n, 2 * buckets);
+}
+
+/**
+ * Construction of a two level perfect hash (FKS scheme).
+ *
+ * The first level distributes the keys to a power of two number of
+ * buckets. A seed is chosen such that the sum of the squared bucket sizes
+ * is at most 2N. Each bucket with c keys gets c^2 slots and a seed of its
+ * own without collisions within these slots, which is found after a few
+ * tries.
+ *
+ * The intermediate results are stored in literal types (bucket of each
+ * entry, bucket sizes, offsets, entries ordered by bucket) so that every
+ * value is only calculated once. All recursions split the range in halves,
+ * the recursion depth only grows with log2(N).
+ */
+template <typename Entry, size_t N>
+struct StaticHashMapBuilder
+{
+    static constexpr size_t numberOfBuckets = staticHashMapBucketCount(N);
+    static constexpr size_t numberOfSlots = 2 * N;
+    static constexpr uint32_t maximumNumberOfTries = 256;
+
+    typedef typename MakeIndexSequence<N>::Type EntrySequence;
+    typedef typename MakeIndexSequence<numberOfBuckets>::Type BucketSequence;
+    typedef typename MakeIndexSequence<numberOfSlots>::Type SlotSequence;
+
+    static constexpr uint16_t
+    getBucket(const Entry* entries, uint32_t seed, size_t index)
+    {
+        return static_cast<uint16_t>(staticHash(static_cast<uint64_t>(entries[index].mKey), seed)
+                                     & (numberOfBuckets - 1));
+    }
+
+    static constexpr size_t
+    getSlot(uint64_t key, uint32_t bucketSeed, size_t bucketSize)
+    {
+        return staticHash(key, bucketSeed) % (bucketSize * bucketSize);
+    }
+
+    /// Bucket of each entry
+    struct Buckets
+    {
+        template <size_t... I>
+        constexpr Buckets(const Entry* entries, uint32_t seed, IndexSequence<I...>) :
+            mBucket{getBucket(entries, seed, I)...}
+        {
+        }
+
+        uint16_t mBucket[N];
+    };
+
+    /// Number of entries in [first, last) which belong to the bucket
+    static constexpr size_t
+    count(const Buckets& buckets, size_t bucket, size_t first, size_t last)
+    {
+        return (last - first == 0)
+                       ? 0
+                       : ((last - first == 1)
+                                  ? ((buckets.mBucket[first] == bucket) ? 1 : 0)
+                                  : count(buckets, bucket, first, first + (last - first) / 2)
+                                            + count(buckets,
+                                                    bucket,
+                                                    first + (last - first) / 2,
+                                                    last));
+    }
+
+    /// Sum of the sizes of the buckets of the entries in [first, last),
+    /// i.e. the sum of the squared bucket sizes for [0, N).
+    static constexpr size_t
+    getNumberOfSlots(const Buckets& buckets, size_t first, size_t last)
+    {
+        return (last - first == 0)
+                       ? 0
+                       : ((last - first == 1)
+                                  ? count(buckets, buckets.mBucket[first], 0, N)
+                                  : getNumberOfSlots(buckets, first, first + (last - first) / 2)
+                                            + getNumberOfSlots(
+                                                    buckets, first + (last - first) / 2, last));
+    }
+
+    static constexpr uint32_t
+    findSeed(const Entry* entries, uint32_t seed)
+    {
+        return (getNumberOfSlots(Buckets(entries, seed, EntrySequence()), 0, N) <= numberOfSlots)
+                       ? seed
+                       : ((seed < maximumNumberOfTries) ? findSeed(entries, seed + 1)
+                                                        : staticHashMapNoSeedFound());
+    }
+
+    /// Number of entries per bucket
+    struct Sizes
+    {
+        template <size_t... B>
+        constexpr Sizes(const Buckets& buckets, IndexSequence<B...>) :
+            mSize{static_cast<uint16_t>(count(buckets, B, 0, N))...}
+        {
+        }
+
+        uint16_t mSize[numberOfBuckets];
+    };
+
+    /// Sum of the (squared) sizes of the buckets in [first, last)
+    static constexpr size_t
+    sum(const Sizes& sizes, bool squared, size_t first, size_t last)
+    {
+        return (last - first == 0)
+                       ? 0
+                       : ((last - first == 1)
+                                  ? (squared ? sizes.mSize[first] * sizes.mSize[first]
+                                             : sizes.mSize[first])
+                                  : sum(sizes, squared, first, first + (last - first) / 2)
+                                            + sum(sizes,
+                                                  squared,
+                                                  first + (last - first) / 2,
+                                                  last));
+    }
+
+    /// First slot and first position in the bucket ordered entries per bucket
+    struct Offsets
+    {
+        template <size_t... B>
+        constexpr Offsets(const Sizes& sizes, IndexSequence<B...>) :
+            mSlot{static_cast<uint16_t>(sum(sizes, true, 0, B))...},
+            mPosition{static_cast<uint16_t>(sum(sizes, false, 0, B))...}
+        {
+        }
+
+        uint16_t mSlot[numberOfBuckets];
+        uint16_t mPosition[numberOfBuckets];
+    };
+
+    /// Position of each entry when ordered by bucket
+    struct Positions
+    {
+        template <size_t... I>
+        constexpr Positions(const Buckets& buckets, const Offsets& offsets, IndexSequence<I...>) :
+            mPosition{static_cast<uint16_t>(offsets.mPosition[buckets.mBucket[I]]
+                                            + count(buckets, buckets.mBucket[I], 0, I))...}
+        {
+        }
+
+        uint16_t mPosition[N];
+    };
+
+    /// Entry in [first, last) with the given position, N if there is none
+    static constexpr size_t
+    findPosition(const Positions& positions, size_t position, size_t first, size_t last)
+    {
+        return (last - first == 0)
+                       ? N
+                       : ((last - first == 1)
+                                  ? ((positions.mPosition[first] == position) ? first : N)
+                                  : ((findPosition(positions,
+                                                   position,
+                                                   first,
+                                                   first + (last - first) / 2)
+                                      != N)
+                                             ? findPosition(positions,
+                                                            position,
+                                                            first,
+                                                            first + (last - first) / 2)
+                                             : findPosition(positions,
+                                                            position,
+                                                            first + (last - first) / 2,
+                                                            last)));
+    }
+
+    /// Entries ordered by bucket
+    struct Members
+    {
+        template <size_t... P>
+        constexpr Members(const Positions& positions, IndexSequence<P...>) :
+            mEntry{static_cast<uint16_t>(findPosition(positions, P, 0, N))...}
+        {
+        }
+
+        uint16_t mEntry[N];
+    };
+
+    static constexpr size_t
+    getMemberSlot(const Entry* entries,
+                  const Members& members,
+                  size_t position,
+                  uint32_t bucketSeed,
+                  size_t bucketSize)
+    {
+        return getSlot(static_cast<uint64_t>(entries[members.mEntry[position]].mKey),
+                       bucketSeed,
+                       bucketSize);
+    }
+
+    /// Check that all members of the bucket from (a, b) onwards use different slots
+    static constexpr bool
+    isCollisionFree(const Entry* entries,
+                    const Members& members,
+                    size_t position,
+                    size_t bucketSize,
+                    uint32_t bucketSeed,
+                    size_t a,
+                    size_t b)
+    {
+        return (a >= bucketSize)
+                       ? true
+                       : ((b >= bucketSize)
+                                  ? isCollisionFree(entries,
+                                                    members,
+                                                    position,
+                                                    bucketSize,
+                                                    bucketSeed,
+                                                    a + 1,
+                                                    a + 2)
+                                  : ((getMemberSlot(entries,
+                                                    members,
+                                                    position + a,
+                                                    bucketSeed,
+                                                    bucketSize)
+                                      != getMemberSlot(entries,
+                                                       members,
+                                                       position + b,
+                                                       bucketSeed,
+                                                       bucketSize))
+                                     && isCollisionFree(entries,
+                                                        members,
+                                                        position,
+                                                        bucketSize,
+                                                        bucketSeed,
+                                                        a,
+                                                        b + 1)));
+    }
+
+    static constexpr uint32_t
+    findBucketSeed(const Entry* entries,
+                   const Members& members,
+                   size_t position,
+                   size_t bucketSize,
+                   uint32_t bucketSeed)
+    {
+        return isCollisionFree(entries, members, position, bucketSize, bucketSeed, 0, 1)
+                       ? bucketSeed
+                       : ((bucketSeed < maximumNumberOfTries)
+                                  ? findBucketSeed(
+                                            entries, members, position, bucketSize, bucketSeed + 1)
+                                  : staticHashMapDuplicateKeys());
+    }
+
+    /// Seed of the second level hash per bucket
+    struct Seeds
+    {
+        template <size_t... B>
+        constexpr Seeds(const Entry* entries,
+                        const Sizes& sizes,
+                        const Offsets& offsets,
+                        const Members& members,
+                        IndexSequence<B...>) :
+            mSeed{findBucketSeed(entries, members, offsets.mPosition[B], sizes.mSize[B], 0)...}
+        {
+        }
+
+        uint32_t mSeed[numberOfBuckets];
+    };
+
+    /// Last bucket in [first, last) starting at or before the slot
+    static constexpr size_t
+    getBucketOfSlot(const Offsets& offsets, size_t slot, size_t first, size_t last)
+    {
+        return (last - first == 1)
+                       ? first
+                       : ((slot < offsets.mSlot[first + (last - first) / 2])
+                                  ? getBucketOfSlot(
+                                            offsets, slot, first, first + (last - first) / 2)
+                                  : getBucketOfSlot(
+                                            offsets, slot, first + (last - first) / 2, last));
+    }
+
+    /// Entry of the bucket stored in the slot, N if there is none
+    static constexpr size_t
+    findSlotEntry(const Entry* entries,
+                  const Members& members,
+                  size_t position,
+                  size_t bucketSize,
+                  uint32_t bucketSeed,
+                  size_t slot,
+                  size_t n)
+    {
+        return (n >= bucketSize)
+                       ? N
+                       : ((getMemberSlot(entries, members, position + n, bucketSeed, bucketSize)
+                           == slot)
+                                  ? members.mEntry[position + n]
+                                  : findSlotEntry(entries,
+                                                  members,
+                                                  position,
+                                                  bucketSize,
+                                                  bucketSeed,
+                                                  slot,
+                                                  n + 1));
+    }
+
+    static constexpr size_t
+    getSlotEntryInBucket(const Entry* entries,
+                         const Sizes& sizes,
+                         const Offsets& offsets,
+                         const Members& members,
+                         const Seeds& seeds,
+                         size_t slot,
+                         size_t bucket)
+    {
+        return findSlotEntry(entries,
+                             members,
+                             offsets.mPosition[bucket],
+                             sizes.mSize[bucket],
+                             seeds.mSeed[bucket],
+                             slot - offsets.mSlot[bucket],
+                             0);
+    }
+
+    /// Index of the entry stored in the slot, N for an empty slot
+    static constexpr size_t
+    getSlotEntry(const Entry* entries,
+                 const Sizes& sizes,
+                 const Offsets& offsets,
+                 const Members& members,
+                 const Seeds& seeds,
+                 size_t slot)
+    {
+        return (slot >= sum(sizes, true, 0, numberOfBuckets))
+                       ? N
+                       : getSlotEntryInBucket(entries,
+                                              sizes,
+                                              offsets,
+                                              members,
+                                              seeds,
+                                              slot,
+                                              getBucketOfSlot(offsets, slot, 0, numberOfBuckets));
+    }
+};
+}  // namespace internal
+
+/**
+ * Map with a perfect hash over a fixed set of keys.
+ *
+ * The hash function and all tables are calculated by the compiler when
+ * the map is declared `constexpr`, the map can then be placed in ROM and
+ * needs no initialization at runtime. A lookup evaluates two hash
+ * functions and compares a single key, independent of the number of
+ * entries.
+ *
+ * Like `FixedOrderedMap` the `Entry` type needs a `mKey` member, which
+ * must be of an integral or enum type. The entries do not need to be
+ * ordered. Duplicate keys abort the compilation.
+ *
+ * \code
+ * struct Entry
+ * {
+ *     uint16_t mKey;
+ *     uint8_t mQueue;
+ * };
+ *
+ * constexpr Entry entries[] = {{0x100, 1}, {0x2A3, 0}, {0x010, 2}};
+ * constexpr outpost::StaticHashMap<Entry, uint16_t, 3> apids(entries);
+ *
+ * const Entry* entry = apids.getEntry(apid);
+ * \endcode
+ *
+ * The tables are built with recursive constexpr functions, the evaluation
+ * time grows roughly quadratic with the number of entries. With the default
+ * limits of GCC about 250 entries are possible, larger maps need a higher
+ * `-fconstexpr-ops-limit`.
+ *
+ * \tparam Entry
+ *      Type of the entries
+ * \tparam Key
+ *      Type of the `mKey` member
+ * \tparam N
+ *      Number of entries
+ */
+template <typename Entry, typename Key, size_t N>
+class StaticHashMap
+{
+    static_assert(N > 0, "Map needs at least one entry");
+    static_assert(2 * N <= 0xFFFF, "Too many entries");
+
+    typedef internal::StaticHashMapBuilder<Entry, N> Builder;
+
+public:
+    explicit constexpr StaticHashMap(const Entry (&entries)[N]) :
+        StaticHashMap(entries, Builder::findSeed(entries, 0))
+    {
+    }
+
+    /**
+     * Find an entry.
+     *
+     * \return
+     *      Pointer to the entry or nullptr if no entry with the
+     *      requested key exists.
+     */
+    constexpr const Entry*
+    getEntry(Key key) const
+    {
+        return findInBucket(key,
+                            mBuckets[internal::staticHash(static_cast<uint64_t>(key), mSeed)
+                                     & (Builder::numberOfBuckets - 1)]);
+    }
+
+    static constexpr size_t
+    getNumberOfElements()
+    {
+        return N;
+    }
+
+private:
+    struct Bucket
+    {
+        uint16_t mOffset;
+        uint16_t mSize;
+        uint32_t mSeed;
+    };
+
+    typedef typename Builder::Buckets Buckets;
+    typedef typename Builder::Sizes Sizes;
+    typedef typename Builder::Offsets Offsets;
+    typedef typename Builder::Positions Positions;
+    typedef typename Builder::Members Members;
+    typedef typename Builder::Seeds Seeds;
+
+    // The intermediate tables are passed from one delegating constructor
+    // to the next, they only exist during the construction.
+    constexpr StaticHashMap(const Entry* entries, uint32_t seed) :
+        StaticHashMap(entries, seed, Buckets(entries, seed, typename Builder::EntrySequence()))
+    {
+    }
+
+    constexpr StaticHashMap(const Entry* entries, uint32_t seed, const Buckets& buckets) :
+        StaticHashMap(entries,
+                      seed,
+                      buckets,
+                      Sizes(buckets, typename Builder::BucketSequence()))
+    {
+    }
+
+    constexpr StaticHashMap(const Entry* entries,
+                            uint32_t seed,
+                            const Buckets& buckets,
+                            const Sizes& sizes) :
+        StaticHashMap(entries,
+                      seed,
+                      buckets,
+                      sizes,
+                      Offsets(sizes, typename Builder::BucketSequence()))
+    {
+    }
+
+    constexpr StaticHashMap(const Entry* entries,
+                            uint32_t seed,
+                            const Buckets& buckets,
+                            const Sizes& sizes,
+                            const Offsets& offsets) :
+        StaticHashMap(entries,
+                      seed,
+                      sizes,
+                      offsets,
+                      Members(Positions(buckets, offsets, typename Builder::EntrySequence()),
+                              typename Builder::EntrySequence()))
+    {
+    }
+
+    constexpr StaticHashMap(const Entry* entries,
+                            uint32_t seed,
+                            const Sizes& sizes,
+                            const Offsets& offsets,
+                            const Members& members) :
+        StaticHashMap(entries,
+                      seed,
+                      sizes,
+                      offsets,
+                      members,
+                      Seeds(entries, sizes, offsets, members, typename Builder::BucketSequence()),
+                      typename Builder::BucketSequence(),
+                      typename Builder::SlotSequence())
+    {
+    }
+
+    template <size_t... B, size_t... S>
+    constexpr StaticHashMap(const Entry* entries,
+                            uint32_t seed,
+                            const Sizes& sizes,
+                            const Offsets& offsets,
+                            const Members& members,
+                            const Seeds& seeds,
+                            IndexSequence<B...>,
+                            IndexSequence<S...>) :
+        mEntries(entries),
+        mSeed(seed),
+        mBuckets{{offsets.mSlot[B], sizes.mSize[B], seeds.mSeed[B]}...},
+        mSlots{static_cast<uint16_t>(
+                Builder::getSlotEntry(entries, sizes, offsets, members, seeds, S))...}
+    {
+    }
+
+    constexpr const Entry*
+    findInBucket(Key key, const Bucket& bucket) const
+    {
+        return (bucket.mSize == 0)
+                       ? nullptr
+                       : compareKey(key,
+                                    mSlots[bucket.mOffset
+                                           + Builder::getSlot(static_cast<uint64_t>(key),
+                                                              bucket.mSeed,
+                                                              bucket.mSize)]);
+    }
+
+    constexpr const Entry*
+    compareKey(Key key, uint16_t index) const
+    {
+        return ((index < N) && (mEntries[index].mKey == key)) ? &mEntries[index] : nullptr;
+    }
+
+    const Entry* const mEntries;
+    const uint32_t mSeed;
+    const Bucket mBuckets[Builder::numberOfBuckets];
+    const uint16_t mSlots[Builder::numberOfSlots];
+};
+
+template <typename Entry, size_t N>
+constexpr size_t internal::StaticHashMapBuilder<Entry, N>::numberOfBuckets;
+
+template <typename Entry, size_t N>
+constexpr size_t internal::StaticHashMapBuilder<Entry, N>::numberOfSlots;
+
+template <typename Entry, size_t N>
+constexpr uint32_t internal::StaticHashMapBuilder<Entry, N>::maximumNumberOfTries;
+
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_STRUCT_OF_ARRAYS_H
+#define OUTPOST_UTILS_STRUCT_OF_ARRAYS_H
+
+#include <outpost/base/slice.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <new>
+
+namespace outpost
+{
+namespace utils
+{
+namespace internal
+{
+/// Alignment of the columns, matches the width of common vector units
+static constexpr size_t structOfArraysAlignment = 16;
+
+// One base class per column, the column index makes the base classes
+// distinct even for columns of the same type. The column is aligned within
+// its storage instead of using `alignas`, see CounterBlock.
+template <size_t N, size_t Index, typename... Columns>
+struct StructOfArraysColumns
+{
+    inline void
+    set(size_t)
+    {
+    }
+};
+
+template <size_t N, size_t Index, typename T, typename... Rest>
+struct StructOfArraysColumns<N, Index, T, Rest...> : StructOfArraysColumns<N, Index + 1, Rest...>
+{
+    StructOfArraysColumns() : mStorage(), mData(alignColumn(mStorage))
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            new (&mData[i]) T();
+        }
+    }
+
+    ~StructOfArraysColumns()
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            mData[i].~T();
+        }
+    }
+
+    // disable copy constructor
+    StructOfArraysColumns(const StructOfArraysColumns&) = delete;
+
+    // disable copy assignment operator
+    StructOfArraysColumns&
+    operator=(const StructOfArraysColumns&) = delete;
+
+    inline void
+    set(size_t row, const T& value, const Rest&... rest)
+    {
+        mData[row] = value;
+        StructOfArraysColumns<N, Index + 1, Rest...>::set(row, rest...);
+    }
+
+    static constexpr size_t alignment =
+            (alignof(T) > structOfArraysAlignment) ? alignof(T) : structOfArraysAlignment;
+
+    static inline T*
+    alignColumn(unsigned char* storage)
+    {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(storage);
+        return reinterpret_cast<T*>((address + alignment - 1)
+                                    & ~static_cast<uintptr_t>(alignment - 1));
+    }
+
+    // At most alignment - 1 bytes are skipped to reach the aligned start
+    unsigned char mStorage[N * sizeof(T) + alignment - 1];
+    T* const mData;
+};
+
+// The base class of the requested column is found by template argument
+// deduction through the derived-to-base conversion.
+template <size_t N, size_t Index, typename T, typename... Rest>
+inline T*
+getColumnData(StructOfArraysColumns<N, Index, T, Rest...>& columns)
+{
+    return columns.mData;
+}
+
+template <size_t N, size_t Index, typename T, typename... Rest>
+inline const T*
+getColumnData(const StructOfArraysColumns<N, Index, T, Rest...>& columns)
+{
+    return columns.mData;
+}
+
+template <size_t Index, typename... Columns>
+struct StructOfArraysColumnType;
+
+template <typename T, typename... Rest>
+struct StructOfArraysColumnType<0, T, Rest...>
+{
+    typedef T Type;
+};
+
+template <size_t Index, typename T, typename... Rest>
+struct StructOfArraysColumnType<Index, T, Rest...>
+{
+    typedef typename StructOfArraysColumnType<Index - 1, Rest...>::Type Type;
+};
+}  // namespace internal
+
+/**
+ * Fixed-capacity table stored column by column (struct of arrays).
+ *
+ * Every column is a separate array aligned to 16 bytes, the rows share a
+ * common index. The alignment is done within the object instead of using
+ * `alignas`, so the table can also be allocated with `operator new` before
+ * C++17. Kernels which only need a single field (e.g. filtering the
+ * values of samples or aggregating them) stream through one contiguous
+ * array instead of skipping over the other fields of an array of structs,
+ * and can be vectorized by the compiler.
+ *
+ * \code
+ * enum Column
+ * {
+ *     timestamp,
+ *     parameterId,
+ *     value
+ * };
+ * outpost::utils::StructOfArrays<256, uint32_t, uint16_t, int32_t> samples;
+ *
+ * samples.append(time, id, raw);
+ * ...
+ * outpost::Slice<int32_t> values = samples.getColumn<value>();
+ * \endcode
+ *
+ * \tparam N
+ *      Maximum number of rows
+ * \tparam Columns
+ *      Types of the columns, must be default constructible and assignable.
+ */
+template <size_t N, typename... Columns>
+class StructOfArrays
+{
+    static_assert(sizeof...(Columns) > 0, "At least one column is needed");
+
+public:
+    static constexpr size_t numberOfColumns = sizeof...(Columns);
+
+    template <size_t Index>
+    using ColumnType = typename internal::StructOfArraysColumnType<Index, Columns...>::Type;
+
+    StructOfArrays() : mColumns(), mSize(0)
+    {
+    }
+
+    // disable copy constructor
+    StructOfArrays(const StructOfArrays&) = delete;
+
+    // disable copy assignment operator
+    StructOfArrays&
+    operator=(const StructOfArrays&) = delete;
+
+    /**
+     * Append a row.
+     *
+     * \retval false    The table is full, nothing has been added.
+     */
+    inline bool
+    append(const Columns&... values)
+    {
+        if (mSize >= N)
+        {
+            return false;
+        }
+        mColumns.set(mSize, values...);
+        mSize++;
+        return true;
+    }
+
+    /**
+     * Field of a row.
+     *
+     * \warning The row is not checked.
+     */
+    template <size_t Index>
+    inline ColumnType<Index>&
+    get(size_t row)
+    {
+        return internal::getColumnData<N, Index>(mColumns)[row];
+    }
+
+    template <size_t Index>
+    inline const ColumnType<Index>&
+    get(size_t row) const
+    {
+        return internal::getColumnData<N, Index>(mColumns)[row];
+    }
+
+    /**
+     * Values of a column for all rows.
+     */
+    template <size_t Index>
+    inline outpost::Slice<ColumnType<Index>>
+    getColumn()
+    {
+        return outpost::Slice<ColumnType<Index>>::unsafe(
+                internal::getColumnData<N, Index>(mColumns), mSize);
+    }
+
+    template <size_t Index>
+    inline outpost::Slice<const ColumnType<Index>>
+    getColumn() const
+    {
+        return outpost::Slice<const ColumnType<Index>>::unsafe(
+                internal::getColumnData<N, Index>(mColumns), mSize);
+    }
+
+    /**
+     * Whole array of a column, including unused rows.
+     *
+     * Allows kernels to fill the columns directly, afterwards the number
+     * of valid rows is set with setSize().
+     */
+    template <size_t Index>
+    inline outpost::Slice<ColumnType<Index>>
+    getColumnStorage()
+    {
+        return outpost::Slice<ColumnType<Index>>::unsafe(
+                internal::getColumnData<N, Index>(mColumns), N);
+    }
+
+    /**
+     * Set the number of valid rows.
+     *
+     * \retval false    The size exceeds the capacity, the size is unchanged.
+     */
+    inline bool
+    setSize(size_t size)
+    {
+        if (size > N)
+        {
+            return false;
+        }
+        mSize = size;
+        return true;
+    }
+
+    inline size_t
+    getSize() const
+    {
+        return mSize;
+    }
+
+    static constexpr size_t
+    getCapacity()
+    {
+        return N;
+    }
+
+    inline bool
+    isEmpty() const
+    {
+        return (mSize == 0);
+    }
+
+    inline bool
+    isFull() const
+    {
+        return (mSize >= N);
+    }
+
+    /**
+     * Remove all rows, the values are not changed.
+     */
+    inline void
+    clear()
+    {
+        mSize = 0;
+    }
+
+private:
+    internal::StructOfArraysColumns<N, 0, Columns...> mColumns;
+    size_t mSize;
+};
+
+template <size_t N, typename... Columns>
+constexpr size_t StructOfArrays<N, Columns...>::numberOfColumns;
+
+}  // namespace utils
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_COUNTER_BLOCK_H
+#define OUTPOST_UTILS_COUNTER_BLOCK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Size of a cache line of the target in bytes.
+ *
+ * Can be overwritten by the build system, e.g. for targets without a data
+ * cache where the padding only wastes memory.
+ */
+#ifndef OUTPOST_CACHE_LINE_SIZE
+#define OUTPOST_CACHE_LINE_SIZE 64
+#endif
+
+namespace outpost
+{
+namespace utils
+{
+static constexpr size_t cacheLineSize = OUTPOST_CACHE_LINE_SIZE;
+
+namespace internal
+{
+// Relaxed atomic access where the compiler supports it. The counters are
+// only used for statistics, no ordering to other memory accesses is needed.
+inline void
+counterAdd(uint32_t& counter, uint32_t value)
+{
+#if defined(__ATOMIC_RELAXED)
+    __atomic_fetch_add(&counter, value, __ATOMIC_RELAXED);
+#else
+    *static_cast<volatile uint32_t*>(&counter) += value;
+#endif
+}
+
+inline uint32_t
+counterLoad(const uint32_t& counter)
+{
+#if defined(__ATOMIC_RELAXED)
+    return __atomic_load_n(&counter, __ATOMIC_RELAXED);
+#else
+    return *static_cast<const volatile uint32_t*>(&counter);
+#endif
+}
+
+inline void
+counterStore(uint32_t& counter, uint32_t value)
+{
+#if defined(__ATOMIC_RELAXED)
+    __atomic_store_n(&counter, value, __ATOMIC_RELAXED);
+#else
+    *static_cast<volatile uint32_t*>(&counter) = value;
+#endif
+}
+}  // namespace internal
+
+/**
+ * Block of statistics counters.
+ *
+ * The counters may be read from any thread without a lock. They are
+ * updated with relaxed atomic operations where the compiler provides them,
+ * otherwise only a single thread may write to a block.
+ *
+ * The counters are placed on cache lines of their own, so that
+ * incrementing them does not invalidate cache lines holding unrelated
+ * data, and vice versa. The alignment is done within the object instead of
+ * using `alignas`, because over-aligned types are not supported by
+ * `operator new` before C++17 and the block is usually part of a larger
+ * object.
+ *
+ * \code
+ * enum Counter
+ * {
+ *     receivedPackets,
+ *     droppedPackets,
+ *     numberOfCounters
+ * };
+ * outpost::utils::CounterBlock<numberOfCounters> mCounters;
+ *
+ * mCounters.increment(droppedPackets);
+ * \endcode
+ *
+ * \tparam N
+ *      Number of counters
+ */
+template <size_t N>
+class CounterBlock
+{
+public:
+    static constexpr size_t numberOfCounters = N;
+
+    CounterBlock() : mStorage(), mCounters(alignToCacheLine(mStorage))
+    {
+    }
+
+    // disable copy constructor
+    CounterBlock(const CounterBlock&) = delete;
+
+    // disable copy assignment operator
+    CounterBlock&
+    operator=(const CounterBlock&) = delete;
+
+    inline void
+    increment(size_t index, uint32_t value = 1)
+    {
+        internal::counterAdd(mCounters[index], value);
+    }
+
+    inline uint32_t
+    get(size_t index) const
+    {
+        return internal::counterLoad(mCounters[index]);
+    }
+
+    /**
+     * Set all counters to zero.
+     */
+    inline void
+    reset()
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            internal::counterStore(mCounters[i], 0);
+        }
+    }
+
+private:
+    /// Size of the counters rounded up to full cache lines
+    static constexpr size_t alignedSize =
+            ((N * sizeof(uint32_t) + cacheLineSize - 1) / cacheLineSize) * cacheLineSize;
+
+    static inline uint32_t*
+    alignToCacheLine(uint32_t* storage)
+    {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(storage);
+        return reinterpret_cast<uint32_t*>((address + cacheLineSize - 1)
+                                           & ~static_cast<uintptr_t>(cacheLineSize - 1));
+    }
+
+    // The storage starts at least at a word boundary, at most a cache line
+    // minus one word is skipped to reach the next cache line.
+    uint32_t mStorage[(alignedSize + cacheLineSize) / sizeof(uint32_t) - 1];
+    uint32_t* const mCounters;
+};
+
+/**
+ * Statistics counters written by several threads.
+ *
+ * Each writer (e.g. thread or core) increments its own `CounterBlock`,
+ * the values of all writers are added up when the counters are read.
+ * This avoids both a lock on the hot path and the cache line contention
+ * of a single shared counter.
+ *
+ * \tparam N
+ *      Number of counters
+ * \tparam numberOfWriters
+ *      Number of independent writers
+ */
+template <size_t N, size_t numberOfWriters>
+class DistributedCounterBlock
+{
+public:
+    static constexpr size_t numberOfCounters = N;
+
+    DistributedCounterBlock() = default;
+
+    // disable copy constructor
+    DistributedCounterBlock(const DistributedCounterBlock&) = delete;
+
+    // disable copy assignment operator
+    DistributedCounterBlock&
+    operator=(const DistributedCounterBlock&) = delete;
+
+    /**
+     * \param writer
+     *      Index of the writer, each may only be used by a single thread.
+     */
+    inline void
+    increment(size_t writer, size_t index, uint32_t value = 1)
+    {
+        mBlocks[writer].increment(index, value);
+    }
+
+    /**
+     * Sum of the counter over all writers.
+     */
+    inline uint32_t
+    get(size_t index) const
+    {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < numberOfWriters; ++i)
+        {
+            sum += mBlocks[i].get(index);
+        }
+        return sum;
+    }
+
+    /**
+     * Set all counters of all writers to zero.
+     */
+    inline void
+    reset()
+    {
+        for (size_t i = 0; i < numberOfWriters; ++i)
+        {
+            mBlocks[i].reset();
+        }
+    }
+
+private:
+    CounterBlock<N> mBlocks[numberOfWriters];
+};
+
+template <size_t N>
+constexpr size_t CounterBlock<N>::numberOfCounters;
+
+template <size_t N>
+constexpr size_t CounterBlock<N>::alignedSize;
+
+template <size_t N, size_t numberOfWriters>
+constexpr size_t DistributedCounterBlock<N, numberOfWriters>::numberOfCounters;
+
+}  // namespace utils
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_DELEGATE_H
+#define OUTPOST_UTILS_DELEGATE_H
+
+#include <utility>
+
+namespace outpost
+{
+template <typename Signature>
+class Delegate;
+
+/**
+ * Reference to a function or to a member function of an object.
+ *
+ * Stores the object pointer and a pointer to a function generated for
+ * the bound function, which restores the type of the object. The called
+ * function is a template argument, so the call through the delegate is a
+ * single indirect call of a normal function, no virtual call and no call
+ * through a member function pointer. A delegate has the size of two
+ * pointers and can be copied freely.
+ *
+ * In contrast to Functor1 the function has to be known at compile time.
+ *
+ * \code
+ * class Handler
+ * {
+ * public:
+ *     bool
+ *     onCommand(int value);
+ * };
+ *
+ * typedef outpost::Delegate<bool(int)> CommandHandler;
+ *
+ * Handler handler;
+ * CommandHandler delegate = CommandHandler::fromMember<Handler, &Handler::onCommand>(handler);
+ * delegate(5);
+ * \endcode
+ *
+ * \tparam R
+ *      Return type
+ * \tparam Args
+ *      Parameter types
+ */
+template <typename R, typename... Args>
+class Delegate<R(Args...)>
+{
+public:
+    /**
+     * Create an empty delegate, must not be called.
+     */
+    constexpr Delegate() : mObject(nullptr), mTrampoline(nullptr)
+    {
+    }
+
+    /**
+     * Bind a member function of \p object.
+     *
+     * \p object must outlive the delegate.
+     */
+    template <typename C, R (C::*function)(Args...)>
+    static inline Delegate
+    fromMember(C& object)
+    {
+        return Delegate(&object, &callMember<C, function>);
+    }
+
+    /**
+     * Bind a const member function of \p object.
+     */
+    template <typename C, R (C::*function)(Args...) const>
+    static inline Delegate
+    fromMember(const C& object)
+    {
+        return Delegate(const_cast<C*>(&object), &callConstMember<C, function>);
+    }
+
+    /**
+     * Bind a free or static member function.
+     */
+    template <R (*function)(Args...)>
+    static inline Delegate
+    fromFunction()
+    {
+        return Delegate(nullptr, &callFunction<function>);
+    }
+
+    /**
+     * Check whether a function is bound.
+     */
+    inline bool
+    isValid() const
+    {
+        return mTrampoline != nullptr;
+    }
+
+    /**
+     * Execute the bound function.
+     */
+    inline R
+    execute(Args... args) const
+    {
+        return mTrampoline(mObject, std::forward<Args>(args)...);
+    }
+
+    /**
+     * \see execute()
+     */
+    inline R
+    operator()(Args... args) const
+    {
+        return mTrampoline(mObject, std::forward<Args>(args)...);
+    }
+
+    /**
+     * Two delegates are equal if they call the same function on the same
+     * object.
+     */
+    inline bool
+    operator==(const Delegate& other) const
+    {
+        return (mObject == other.mObject) && (mTrampoline == other.mTrampoline);
+    }
+
+    inline bool
+    operator!=(const Delegate& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    typedef R (*Trampoline)(void* object, Args... args);
+
+    constexpr Delegate(void* object, Trampoline trampoline) :
+        mObject(object), mTrampoline(trampoline)
+    {
+    }
+
+    template <typename C, R (C::*function)(Args...)>
+    static R
+    callMember(void* object, Args... args)
+    {
+        return (static_cast<C*>(object)->*function)(std::forward<Args>(args)...);
+    }
+
+    template <typename C, R (C::*function)(Args...) const>
+    static R
+    callConstMember(void* object, Args... args)
+    {
+        return (static_cast<const C*>(object)->*function)(std::forward<Args>(args)...);
+    }
+
+    template <R (*function)(Args...)>
+    static R
+    callFunction(void* /*object*/, Args... args)
+    {
+        return function(std::forward<Args>(args)...);
+    }
+
+    void* mObject;
+    Trampoline mTrampoline;
+};
+
+}  // namespace outpost
+
+#endif
@@ -44,6 +44,8 @@ struct FunctionSignature<R(P1, P2)>
 
 /**
  * Definition of a function which is executable by telecommands.
+ *
+ * \see outpost::Delegate for functions which are known at compile time.
  */
 template <typename T>
 class Functor1
@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "log.h"
+
+outpost::rtos::Atomic<outpost::utils::LogBufferBase*> outpost::utils::Log::buffer(nullptr);
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_LOG_H
+#define OUTPOST_UTILS_LOG_H
+
+#include "log_buffer.h"
+
+#include <outpost/rtos/atomic.h>
+
+/**
+ * \def OUTPOST_LOG(format, ...)
+ *
+ * Record a log message in the buffer set with
+ * outpost::utils::Log::setBuffer(), e.g.
+ *
+ * \code
+ * OUTPOST_LOG("RMAP-Initiator: Command not executed successfully: %u\n", status);
+ * \endcode
+ *
+ * The format must be a string literal, at most four integral arguments
+ * are allowed. See outpost::utils::LogBufferBase for the allowed
+ * conversions. Messages are dropped while no buffer is set.
+ */
+#define OUTPOST_LOG(...) ::outpost::utils::Log::record(__VA_ARGS__)
+
+namespace outpost
+{
+namespace utils
+{
+/**
+ * Global log buffer used by the OUTPOST_LOG() macro.
+ *
+ * \code
+ * outpost::utils::LogBuffer<256> logBuffer;
+ * outpost::utils::LogPrinterThread logPrinter(logBuffer, 10);
+ *
+ * outpost::utils::Log::setBuffer(&logBuffer);
+ * logPrinter.start();
+ * \endcode
+ *
+ * \see outpost::utils::LogBufferBase
+ * \see outpost::utils::LogPrinterThread
+ */
+class Log
+{
+public:
+    /**
+     * Set the buffer for all further messages, nullptr to stop logging.
+     */
+    static inline void
+    setBuffer(LogBufferBase* logBuffer)
+    {
+        buffer.store(logBuffer);
+    }
+
+    static inline LogBufferBase*
+    getBuffer()
+    {
+        return buffer.load();
+    }
+
+    template <typename... Arguments>
+    static inline void
+    record(const char* format, Arguments... arguments)
+    {
+        LogBufferBase* logBuffer = buffer.load();
+        if (logBuffer != nullptr)
+        {
+            logBuffer->record(format, arguments...);
+        }
+    }
+
+private:
+    static outpost::rtos::Atomic<LogBufferBase*> buffer;
+};
+
+}  // namespace utils
+}  // namespace outpost
+
+#endif
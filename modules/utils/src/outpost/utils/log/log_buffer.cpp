@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "log_buffer.h"
+
+#include <outpost/utils/storage/serialize.h>
+
+#include <stdio.h>
+
+using outpost::utils::LogBufferBase;
+
+constexpr size_t outpost::utils::LogRecord::maximumNumberOfArguments;
+constexpr size_t LogBufferBase::headerSize;
+constexpr size_t LogBufferBase::serializedRecordSize;
+constexpr uint32_t LogBufferBase::magic;
+
+LogBufferBase::LogBufferBase(outpost::Slice<Entry> entries) :
+    mEntries(entries),
+    mMask(entries.getNumberOfElements() - 1),
+    mWriteIndex(0),
+    mReadIndex(0),
+    mNumberOfLostRecords(0)
+{
+    for (size_t i = 0; i < mEntries.getNumberOfElements(); ++i)
+    {
+        mEntries[i].mSequence.store(0);
+    }
+}
+
+bool
+LogBufferBase::read(LogRecord& record)
+{
+    if (!peek(record))
+    {
+        return false;
+    }
+    mReadIndex++;
+    return true;
+}
+
+size_t
+LogBufferBase::format(const LogRecord& record, outpost::Slice<char> buffer)
+{
+    const size_t size = buffer.getNumberOfElements();
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    // Unused arguments are zero and ignored by snprintf
+    const uint32_t* arguments = record.mArguments;
+    const int length = snprintf(buffer.begin(),
+                                size,
+                                record.mFormat,
+                                static_cast<unsigned int>(arguments[0]),
+                                static_cast<unsigned int>(arguments[1]),
+                                static_cast<unsigned int>(arguments[2]),
+                                static_cast<unsigned int>(arguments[3]));
+    if (length < 0)
+    {
+        buffer[0] = '\0';
+        return 0;
+    }
+    return (static_cast<size_t>(length) < size) ? static_cast<size_t>(length) : (size - 1);
+}
+
+size_t
+LogBufferBase::serialize(outpost::Slice<uint8_t> buffer)
+{
+    if (buffer.getNumberOfElements() < headerSize)
+    {
+        return 0;
+    }
+
+    outpost::Serialize payload(buffer.skipFirst(headerSize));
+    size_t available = buffer.getNumberOfElements() - headerSize;
+    uint32_t count = 0;
+
+    LogRecord record;
+    while (peek(record))
+    {
+        const size_t length = serializedRecordSize + record.mNumberOfArguments * 4;
+        if (length > available)
+        {
+            break;
+        }
+        mReadIndex++;
+
+        payload.store<uint64_t>(record.mTimestamp);
+        payload.store<uint32_t>(
+                static_cast<uint32_t>(reinterpret_cast<uintptr_t>(record.mFormat)));
+        payload.store<uint8_t>(static_cast<uint8_t>(record.mNumberOfArguments));
+        for (size_t i = 0; i < record.mNumberOfArguments; ++i)
+        {
+            payload.store<uint32_t>(record.mArguments[i]);
+        }
+        available -= length;
+        count++;
+    }
+
+    outpost::Serialize header(buffer);
+    header.store<uint32_t>(magic);
+    header.store<uint32_t>(count);
+    header.store<uint64_t>(outpost::rtos::CycleClock::getFrequency());
+
+    return buffer.getNumberOfElements() - available;
+}
+
+bool
+LogBufferBase::peek(LogRecord& record)
+{
+    while (true)
+    {
+        const uint32_t end = mWriteIndex.load();
+        if (mReadIndex == end)
+        {
+            return false;
+        }
+
+        // Skip the messages which have been overwritten already
+        const uint32_t capacity = static_cast<uint32_t>(getCapacity());
+        if ((end - mReadIndex) > capacity)
+        {
+            mNumberOfLostRecords += (end - capacity) - mReadIndex;
+            mReadIndex = end - capacity;
+        }
+
+        const Entry& entry = mEntries[mReadIndex & mMask];
+        const uint32_t sequence = entry.mSequence.load();
+        if (sequence == mReadIndex + 1)
+        {
+            record = entry.mRecord;
+
+            // Discard the copy if the entry has been overwritten in the meantime
+            if (entry.mSequence.load() == mReadIndex + 1)
+            {
+                return true;
+            }
+        }
+        else if ((sequence == 0) || (static_cast<int32_t>(sequence - (mReadIndex + 1)) < 0))
+        {
+            // The message is still being written
+            return false;
+        }
+    }
+}
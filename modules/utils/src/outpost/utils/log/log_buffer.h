@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_LOG_BUFFER_H
+#define OUTPOST_UTILS_LOG_BUFFER_H
+
+#include <outpost/base/slice.h>
+#include <outpost/rtos/atomic.h>
+#include <outpost/rtos/cycle_clock.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace utils
+{
+/**
+ * Single log message stored in a LogBuffer, not yet formatted.
+ */
+struct LogRecord
+{
+    static constexpr size_t maximumNumberOfArguments = 4;
+
+    /// Value of outpost::rtos::CycleClock::now() when the message was recorded
+    outpost::rtos::CycleClock::Ticks mTimestamp;
+
+    /// printf format string, must be a string literal
+    const char* mFormat;
+    uint32_t mNumberOfArguments;
+    uint32_t mArguments[maximumNumberOfArguments];
+};
+
+/**
+ * Lock-free ring of deferred log messages.
+ *
+ * Recording a message only stores the address of the format string and
+ * up to four arguments converted to uint32_t. The formatting is done later
+ * by the reader, e.g. a LogPrinterThread of low priority, or on ground
+ * from the output of serialize(). This keeps the cost of a message in the
+ * range of a few stores, so logging can stay enabled on time critical
+ * paths.
+ *
+ * Messages can be recorded from any number of threads and interrupts at
+ * the same time. When the ring is full the oldest messages are
+ * overwritten and counted by getNumberOfLostRecords(). There must be only
+ * one reader.
+ *
+ * Because all arguments are passed to printf as unsigned int, the format
+ * string may only use the conversions \c d, \c i, \c u, \c x, \c X and
+ * \c c, with the usual flags and field widths.
+ *
+ * \see outpost::utils::Log
+ */
+class LogBufferBase
+{
+public:
+    /// Size of the header created by serialize()
+    static constexpr size_t headerSize = 16;
+
+    /// Size of a serialized message without arguments
+    static constexpr size_t serializedRecordSize = 13;
+
+    /// First four bytes of the output of serialize(), "OLOG"
+    static constexpr uint32_t magic = 0x4F4C4F47;
+
+    // disable copy constructor
+    LogBufferBase(const LogBufferBase& other) = delete;
+
+    // disable assignment operator
+    LogBufferBase&
+    operator=(const LogBufferBase& other) = delete;
+
+    /**
+     * Record a message.
+     *
+     * \param format
+     *      printf format string, must be a string literal because only
+     *      its address is stored.
+     * \param arguments
+     *      Integral values, converted to uint32_t.
+     */
+    template <typename... Arguments>
+    inline void
+    record(const char* format, Arguments... arguments)
+    {
+        static_assert(sizeof...(Arguments) <= LogRecord::maximumNumberOfArguments,
+                      "Too many arguments for a log message");
+
+        // The additional element avoids an empty array
+        const uint32_t values[] = {static_cast<uint32_t>(arguments)..., 0};
+
+        const uint32_t index = mWriteIndex.fetchAdd(1);
+        Entry& entry = mEntries[index & mMask];
+
+        // Invalidate the slot while it is overwritten
+        entry.mSequence.store(0);
+        entry.mRecord.mTimestamp = outpost::rtos::CycleClock::now();
+        entry.mRecord.mFormat = format;
+        entry.mRecord.mNumberOfArguments = sizeof...(Arguments);
+        for (size_t i = 0; i < LogRecord::maximumNumberOfArguments; ++i)
+        {
+            entry.mRecord.mArguments[i] = (i < sizeof...(Arguments)) ? values[i] : 0;
+        }
+        entry.mSequence.store(index + 1);
+    }
+
+    inline size_t
+    getCapacity() const
+    {
+        return mEntries.getNumberOfElements();
+    }
+
+    /**
+     * Number of messages overwritten before they could be read.
+     */
+    inline uint32_t
+    getNumberOfLostRecords() const
+    {
+        return mNumberOfLostRecords;
+    }
+
+    /**
+     * Remove the oldest message from the buffer.
+     *
+     * \retval false    No message available, or the oldest one is still
+     *                  being written.
+     */
+    bool
+    read(LogRecord& record);
+
+    /**
+     * Format a message with snprintf.
+     *
+     * \return  Length of the text in \p buffer without the terminating
+     *          zero, truncated to the size of \p buffer.
+     */
+    static size_t
+    format(const LogRecord& record, outpost::Slice<char> buffer);
+
+    /**
+     * Remove the oldest messages from the buffer and write them in a
+     * binary format, big endian, to be formatted on ground.
+     *
+     * The output starts with a header of headerSize bytes:
+     *
+     *     uint32  magic
+     *     uint32  number of messages
+     *     uint64  CycleClock frequency in Hz
+     *
+     * followed by the messages, oldest first, serializedRecordSize bytes
+     * plus four bytes per argument each:
+     *
+     *     uint64  timestamp in CycleClock ticks
+     *     uint32  address of the format string, to be looked up in the
+     *             executable
+     *     uint8   number of arguments
+     *     uint32  arguments
+     *
+     * \return  Number of bytes written, zero if \p buffer is smaller than
+     *          the header. Only as many messages as fit into \p buffer
+     *          are removed.
+     */
+    size_t
+    serialize(outpost::Slice<uint8_t> buffer);
+
+protected:
+    struct Entry
+    {
+        /// Index of the message plus one, zero while the entry is written
+        outpost::rtos::Atomic<uint32_t> mSequence;
+        LogRecord mRecord;
+    };
+
+    /**
+     * \param entries
+     *      Storage for the messages, the number of elements must be a
+     *      power of two.
+     */
+    explicit LogBufferBase(outpost::Slice<Entry> entries);
+
+    ~LogBufferBase() = default;
+
+private:
+    /// Copy the oldest message without removing it
+    bool
+    peek(LogRecord& record);
+
+    const outpost::Slice<Entry> mEntries;
+    const uint32_t mMask;
+    outpost::rtos::Atomic<uint32_t> mWriteIndex;
+
+    /// Only used by the reader
+    uint32_t mReadIndex;
+    uint32_t mNumberOfLostRecords;
+};
+
+/**
+ * LogBuffer with storage for \p numberOfRecords messages.
+ *
+ * \tparam numberOfRecords
+ *      Capacity of the buffer, must be a power of two.
+ */
+template <size_t numberOfRecords>
+class LogBuffer : public LogBufferBase
+{
+    static_assert((numberOfRecords > 0) && ((numberOfRecords & (numberOfRecords - 1)) == 0),
+                  "The number of records must be a power of two");
+
+public:
+    LogBuffer() : LogBufferBase(outpost::asSlice(mStorage))
+    {
+    }
+
+private:
+    Entry mStorage[numberOfRecords];
+};
+
+}  // namespace utils
+}  // namespace outpost
+
+#endif
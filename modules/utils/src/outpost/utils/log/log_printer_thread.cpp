@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "log_printer_thread.h"
+
+#include <stdio.h>
+
+using outpost::utils::LogPrinterThread;
+
+constexpr size_t LogPrinterThread::maximumLineLength;
+
+LogPrinterThread::LogPrinterThread(LogBufferBase& buffer,
+                                   uint8_t priority,
+                                   Output output,
+                                   outpost::time::Duration interval,
+                                   size_t stackSize) :
+    Thread(priority, stackSize, "LOGP"),
+    mBuffer(buffer),
+    mOutput(output),
+    mInterval(interval),
+    mNumberOfLostRecords(0)
+{
+    mLine[0] = '\0';
+}
+
+size_t
+LogPrinterThread::step()
+{
+    const uint64_t frequency = outpost::rtos::CycleClock::getFrequency();
+
+    size_t count = 0;
+    LogRecord record;
+    while (mBuffer.read(record))
+    {
+        const uint32_t lost = mBuffer.getNumberOfLostRecords();
+        if (lost != mNumberOfLostRecords)
+        {
+            snprintf(mLine,
+                     sizeof(mLine),
+                     "log: %lu messages lost\n",
+                     static_cast<unsigned long>(lost - mNumberOfLostRecords));
+            mOutput(mLine);
+            mNumberOfLostRecords = lost;
+        }
+
+        // Split the timestamp to avoid an overflow of the multiplication
+        uint64_t seconds = 0;
+        uint64_t microseconds = 0;
+        if (frequency > 0)
+        {
+            seconds = record.mTimestamp / frequency;
+            microseconds = ((record.mTimestamp % frequency) * 1000000) / frequency;
+        }
+        int length = snprintf(mLine,
+                              sizeof(mLine),
+                              "[%lu.%06lu] ",
+                              static_cast<unsigned long>(seconds),
+                              static_cast<unsigned long>(microseconds));
+        if ((length < 0) || (static_cast<size_t>(length) >= sizeof(mLine)))
+        {
+            length = 0;
+        }
+        LogBufferBase::format(record,
+                              outpost::Slice<char>::unsafe(&mLine[length],
+                                                           sizeof(mLine) - length));
+        mOutput(mLine);
+        count++;
+    }
+    return count;
+}
+
+void
+LogPrinterThread::print(const char* line)
+{
+    printf("%s", line);
+}
+
+void
+LogPrinterThread::run()
+{
+    while (true)
+    {
+        if (step() == 0)
+        {
+            sleep(mInterval);
+        }
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_LOG_PRINTER_THREAD_H
+#define OUTPOST_UTILS_LOG_PRINTER_THREAD_H
+
+#include "log_buffer.h"
+
+#include <outpost/rtos/thread.h>
+#include <outpost/time/duration.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace utils
+{
+/**
+ * Formats the messages of a LogBuffer outside of the time critical
+ * threads.
+ *
+ * Every message is written as one line, prefixed with the time it was
+ * recorded in seconds of outpost::rtos::CycleClock:
+ *
+ *     [12.000345] RMAP-Initiator: Timeout
+ *
+ * Messages lost because the buffer was full are reported by an additional
+ * line. The thread should run with a low priority, it sleeps for the
+ * given interval whenever the buffer is empty.
+ */
+class LogPrinterThread : public outpost::rtos::Thread
+{
+public:
+    /// Receives a formatted line
+    typedef void (*Output)(const char* line);
+
+    /// Maximum length of a line, longer lines are truncated
+    static constexpr size_t maximumLineLength = 128;
+
+    /**
+     * \param buffer
+     *      Buffer to read from, this thread must be its only reader.
+     * \param priority
+     *      See outpost::rtos::Thread.
+     * \param output
+     *      Receives the lines.
+     * \param interval
+     *      Time to wait when no messages are available.
+     */
+    LogPrinterThread(LogBufferBase& buffer,
+                     uint8_t priority,
+                     Output output = &print,
+                     outpost::time::Duration interval = outpost::time::Milliseconds(10),
+                     size_t stackSize = defaultStackSize);
+
+    /**
+     * Format and output all available messages, exposed for testing.
+     *
+     * \return  Number of messages written.
+     */
+    size_t
+    step();
+
+    /**
+     * Write a line to stdout with printf.
+     */
+    static void
+    print(const char* line);
+
+protected:
+    void
+    run() override;
+
+private:
+    LogBufferBase& mBuffer;
+    const Output mOutput;
+    const outpost::time::Duration mInterval;
+
+    /// Lost messages already reported
+    uint32_t mNumberOfLostRecords;
+    char mLine[maximumLineLength];
+};
+
+}  // namespace utils
+}  // namespace outpost
+
+#endif
@@ -14,6 +14,8 @@
 #ifndef OUTPOST_META_H
 #define OUTPOST_META_H
 
+#include <stddef.h>
+
 namespace outpost
 {
 /**
@@ -74,6 +76,48 @@ struct remove_const<T*>
     typedef typename remove_const<T>::type* type;
 };
 
+/**
+ * Compile-time sequence of indices, e.g. to initialize an array with
+ * the results of a constexpr function for each index.
+ */
+template <size_t... I>
+struct IndexSequence
+{
+};
+
+template <typename First, typename Second>
+struct ConcatenateIndexSequence;
+
+template <size_t... I, size_t... J>
+struct ConcatenateIndexSequence<IndexSequence<I...>, IndexSequence<J...>>
+{
+    typedef IndexSequence<I..., (sizeof...(I) + J)...> Type;
+};
+
+/**
+ * Sequence 0 .. N - 1, generated with a recursion depth of log2(N) to stay
+ * below the template instantiation limit of the compilers for large tables.
+ */
+template <size_t N>
+struct MakeIndexSequence
+{
+    typedef typename ConcatenateIndexSequence<typename MakeIndexSequence<N / 2>::Type,
+                                              typename MakeIndexSequence<N - N / 2>::Type>::Type
+            Type;
+};
+
+template <>
+struct MakeIndexSequence<0>
+{
+    typedef IndexSequence<> Type;
+};
+
+template <>
+struct MakeIndexSequence<1>
+{
+    typedef IndexSequence<0> Type;
+};
+
 }  // namespace outpost
 
 #endif
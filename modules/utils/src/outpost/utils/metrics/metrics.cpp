@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "metrics.h"
+
+using namespace outpost::utils;
+
+// Global list of all metrics
+Metric* Metric::listOfAllMetrics = nullptr;
+
+// Size of id, type and number of values of a metric
+static constexpr size_t metricHeaderSize = 4;
+
+Metric::Metric(uint16_t id, const char* name, Type type) :
+    ImplicitList<Metric>(listOfAllMetrics, this),
+    mId(id),
+    mType(type),
+    mName(name)
+{
+}
+
+Metric::~Metric()
+{
+    removeFromList(&Metric::listOfAllMetrics, this);
+}
+
+// ----------------------------------------------------------------------------
+MetricCounter::MetricCounter(uint16_t id, const char* name) :
+    Metric(id, name, Type::counter),
+    mValue(0)
+{
+}
+
+uint8_t
+MetricCounter::getNumberOfValues() const
+{
+    return 1;
+}
+
+void
+MetricCounter::serializeValues(Serialize& packet) const
+{
+    packet.store<uint32_t>(get());
+}
+
+// ----------------------------------------------------------------------------
+MetricGauge::MetricGauge(uint16_t id, const char* name) : Metric(id, name, Type::gauge), mValue(0)
+{
+}
+
+uint8_t
+MetricGauge::getNumberOfValues() const
+{
+    return 1;
+}
+
+void
+MetricGauge::serializeValues(Serialize& packet) const
+{
+    packet.store<uint32_t>(internal::counterLoad(mValue));
+}
+
+// ----------------------------------------------------------------------------
+MetricHistogramBase::MetricHistogramBase(uint16_t id,
+                                         const char* name,
+                                         outpost::Slice<const uint32_t> bounds,
+                                         outpost::Slice<uint32_t> buckets) :
+    Metric(id, name, Type::histogram),
+    mBounds(bounds),
+    mBuckets(buckets)
+{
+}
+
+void
+MetricHistogramBase::record(uint32_t value)
+{
+    size_t index = 0;
+    while (index < mBounds.getNumberOfElements() && value > mBounds[index])
+    {
+        index++;
+    }
+    internal::counterAdd(mBuckets[index], 1);
+}
+
+uint32_t
+MetricHistogramBase::getBucket(size_t index) const
+{
+    if (index >= mBuckets.getNumberOfElements())
+    {
+        return 0;
+    }
+    return internal::counterLoad(mBuckets[index]);
+}
+
+uint8_t
+MetricHistogramBase::getNumberOfValues() const
+{
+    return static_cast<uint8_t>(mBuckets.getNumberOfElements());
+}
+
+void
+MetricHistogramBase::serializeValues(Serialize& packet) const
+{
+    for (size_t i = 0; i < mBuckets.getNumberOfElements(); ++i)
+    {
+        packet.store<uint32_t>(internal::counterLoad(mBuckets[i]));
+    }
+}
+
+// ----------------------------------------------------------------------------
+size_t
+MetricsRegistry::getNumberOfMetrics()
+{
+    size_t count = 0;
+    for (Metric* it = Metric::listOfAllMetrics; it != nullptr; it = it->getNext())
+    {
+        count++;
+    }
+    return count;
+}
+
+const Metric*
+MetricsRegistry::find(uint16_t id)
+{
+    for (Metric* it = Metric::listOfAllMetrics; it != nullptr; it = it->getNext())
+    {
+        if (it->getId() == id)
+        {
+            return it;
+        }
+    }
+    return nullptr;
+}
+
+size_t
+MetricsRegistry::getSerializedSize()
+{
+    size_t size = sizeof(uint16_t);
+    for (Metric* it = Metric::listOfAllMetrics; it != nullptr; it = it->getNext())
+    {
+        size += metricHeaderSize + it->getNumberOfValues() * sizeof(uint32_t);
+    }
+    return size;
+}
+
+size_t
+MetricsRegistry::serialize(outpost::Slice<uint8_t> buffer)
+{
+    const size_t size = getSerializedSize();
+    if (buffer.getNumberOfElements() < size)
+    {
+        return 0;
+    }
+
+    Serialize packet(buffer);
+    packet.store<uint16_t>(static_cast<uint16_t>(getNumberOfMetrics()));
+    for (Metric* it = Metric::listOfAllMetrics; it != nullptr; it = it->getNext())
+    {
+        packet.store<uint16_t>(it->getId());
+        packet.store<uint8_t>(static_cast<uint8_t>(it->getType()));
+        packet.store<uint8_t>(it->getNumberOfValues());
+        it->serializeValues(packet);
+    }
+    return packet.getPosition();
+}
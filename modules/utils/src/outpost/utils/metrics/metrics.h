@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_METRICS_H
+#define OUTPOST_UTILS_METRICS_H
+
+#include <outpost/base/slice.h>
+#include <outpost/utils/container/implicit_list.h>
+#include <outpost/utils/counter_block.h>
+#include <outpost/utils/storage/serialize.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace utils
+{
+/**
+ * Named runtime value registered in the global list of metrics.
+ *
+ * Metrics register themselves on construction, usually as static objects
+ * or as members of components with static storage. All metrics can then
+ * be read and serialized by the MetricsRegistry, e.g. into a housekeeping
+ * packet.
+ *
+ * Values are updated with relaxed atomic operations, producers never
+ * take a lock and are not stopped while the metrics are read.
+ *
+ * \warning
+ *      The creation and destruction of metrics during the normal runtime
+ *      is not thread-safe, the same as for topics.
+ *
+ * \see     MetricsRegistry
+ */
+class Metric : protected ImplicitList<Metric>
+{
+public:
+    enum class Type : uint8_t
+    {
+        counter = 1,
+        gauge = 2,
+        histogram = 3
+    };
+
+    /**
+     * \param id
+     *      Identifier of the metric in the serialized packet, has to be
+     *      unique.
+     * \param name
+     *      Name for the display, not serialized. Must outlive the metric.
+     */
+    Metric(uint16_t id, const char* name, Type type);
+
+    virtual ~Metric();
+
+    // disable copy constructor
+    Metric(const Metric&) = delete;
+
+    // disable assignment operator
+    Metric&
+    operator=(const Metric&) = delete;
+
+    inline uint16_t
+    getId() const
+    {
+        return mId;
+    }
+
+    inline const char*
+    getName() const
+    {
+        return mName;
+    }
+
+    inline Type
+    getType() const
+    {
+        return mType;
+    }
+
+    /**
+     * Number of 32 bit values written by serializeValues().
+     */
+    virtual uint8_t
+    getNumberOfValues() const = 0;
+
+    /**
+     * Write the current values.
+     */
+    virtual void
+    serializeValues(Serialize& packet) const = 0;
+
+private:
+    friend class ImplicitList<Metric>;
+    friend class MetricsRegistry;
+
+    static Metric* listOfAllMetrics;
+
+    const uint16_t mId;
+    const Type mType;
+    const char* const mName;
+};
+
+/**
+ * Monotonically increasing number of events.
+ *
+ * \code
+ * outpost::utils::MetricCounter droppedPackets(0x0101, "dispatcher.dropped");
+ *
+ * droppedPackets.increment();
+ * \endcode
+ */
+class MetricCounter : public Metric
+{
+public:
+    MetricCounter(uint16_t id, const char* name);
+
+    inline void
+    increment(uint32_t value = 1)
+    {
+        internal::counterAdd(mValue, value);
+    }
+
+    inline uint32_t
+    get() const
+    {
+        return internal::counterLoad(mValue);
+    }
+
+    uint8_t
+    getNumberOfValues() const override;
+
+    void
+    serializeValues(Serialize& packet) const override;
+
+private:
+    uint32_t mValue;
+};
+
+/**
+ * Current value of a quantity, e.g. the fill level of a queue.
+ */
+class MetricGauge : public Metric
+{
+public:
+    MetricGauge(uint16_t id, const char* name);
+
+    inline void
+    set(int32_t value)
+    {
+        internal::counterStore(mValue, static_cast<uint32_t>(value));
+    }
+
+    inline int32_t
+    get() const
+    {
+        return static_cast<int32_t>(internal::counterLoad(mValue));
+    }
+
+    uint8_t
+    getNumberOfValues() const override;
+
+    /**
+     * Serialized as two's complement.
+     */
+    void
+    serializeValues(Serialize& packet) const override;
+
+private:
+    uint32_t mValue;
+};
+
+/**
+ * Non-template part of the MetricHistogram.
+ */
+class MetricHistogramBase : public Metric
+{
+public:
+    /**
+     * Count a value in the first bucket whose upper bound is not smaller
+     * than \p value, or in the overflow bucket.
+     */
+    void
+    record(uint32_t value);
+
+    /**
+     * Number of values counted in a bucket, the last bucket is the
+     * overflow bucket.
+     */
+    uint32_t
+    getBucket(size_t index) const;
+
+    inline size_t
+    getNumberOfBuckets() const
+    {
+        return mBuckets.getNumberOfElements();
+    }
+
+    /**
+     * One value per bucket, the total number of values is their sum and
+     * therefore always consistent with the buckets.
+     */
+    uint8_t
+    getNumberOfValues() const override;
+
+    void
+    serializeValues(Serialize& packet) const override;
+
+protected:
+    /**
+     * \param bounds
+     *      Inclusive upper bounds of the buckets in ascending order.
+     * \param buckets
+     *      One element more than \p bounds.
+     */
+    MetricHistogramBase(uint16_t id,
+                        const char* name,
+                        outpost::Slice<const uint32_t> bounds,
+                        outpost::Slice<uint32_t> buckets);
+
+    ~MetricHistogramBase() = default;
+
+private:
+    const outpost::Slice<const uint32_t> mBounds;
+    const outpost::Slice<uint32_t> mBuckets;
+};
+
+/**
+ * Distribution of values, e.g. of latencies or packet sizes.
+ *
+ * \code
+ * static const uint32_t latencyBounds[] = {10, 100, 1000};
+ * outpost::utils::MetricHistogram<3> latency(0x0102, "rmap.latency", latencyBounds);
+ *
+ * latency.record(42);     // counted in the second bucket
+ * \endcode
+ *
+ * \tparam numberOfBounds
+ *      Number of bucket bounds, the histogram has an additional overflow
+ *      bucket.
+ */
+template <size_t numberOfBounds>
+class MetricHistogram : public MetricHistogramBase
+{
+    static_assert(numberOfBounds < 255, "Too many buckets for the serialized format");
+
+public:
+    /**
+     * \param bounds
+     *      Inclusive upper bounds of the buckets in ascending order, must
+     *      outlive the histogram.
+     */
+    MetricHistogram(uint16_t id, const char* name, const uint32_t (&bounds)[numberOfBounds]) :
+        MetricHistogramBase(id, name, outpost::asSlice(bounds), outpost::asSlice(mStorage)),
+        mStorage()
+    {
+    }
+
+private:
+    // Only referenced by the base class, the values are written after the
+    // construction of the histogram
+    uint32_t mStorage[numberOfBounds + 1];
+};
+
+/**
+ * Access to all registered metrics.
+ *
+ * The serialized format is:
+ *
+ *     uint16 numberOfMetrics
+ *     numberOfMetrics times:
+ *         uint16 id
+ *         uint8  type
+ *         uint8  numberOfValues
+ *         uint32 value[numberOfValues]
+ *
+ * All fields are big endian.
+ */
+class MetricsRegistry
+{
+public:
+    static size_t
+    getNumberOfMetrics();
+
+    /**
+     * \return  Metric with the given identifier, nullptr if not found.
+     */
+    static const Metric*
+    find(uint16_t id);
+
+    /**
+     * Size of the packet written by serialize().
+     */
+    static size_t
+    getSerializedSize();
+
+    /**
+     * Take a snapshot of all metrics.
+     *
+     * Every metric is read atomically, the producers continue while the
+     * metrics are visited.
+     *
+     * \return  Number of bytes written, zero if \p buffer is too small.
+     */
+    static size_t
+    serialize(outpost::Slice<uint8_t> buffer);
+
+private:
+    // Only static functions
+    MetricsRegistry() = delete;
+};
+
+}  // namespace utils
+}  // namespace outpost
+
+#endif
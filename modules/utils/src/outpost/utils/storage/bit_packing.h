@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_BIT_PACKING_H
+#define OUTPOST_UTILS_BIT_PACKING_H
+
+#include <outpost/base/slice.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+/**
+ * Pack and unpack arrays of values with a uniform bit width.
+ *
+ * The values are stored without gaps, most significant bit first, with the
+ * same bit order as `Bitfield` (e.g. two 12 bit values occupy three bytes
+ * as with `Serialize::storePacked12()`).
+ *
+ * Eight values always occupy exactly `width` bytes. The arrays are
+ * processed in such groups of eight values, for which all shifts and byte
+ * offsets are compile-time constants, so that no per field bookkeeping is
+ * left in the loop.
+ *
+ * \tparam width
+ *      Number of bits per value, 1 to 16
+ */
+template <uint8_t width>
+class BitPacking
+{
+    static_assert(width >= 1 && width <= 16, "Values must have 1 to 16 bits");
+
+public:
+    /// Number of values per group, a group fills exactly `width` bytes
+    static constexpr size_t valuesPerGroup = 8;
+
+    /**
+     * Number of bytes occupied by the given number of values.
+     */
+    static constexpr size_t
+    getPackedSize(size_t numberOfValues)
+    {
+        return (numberOfValues * width + 7) / 8;
+    }
+
+    /**
+     * Unpack values.
+     *
+     * \param input
+     *      Packed values, at least getPackedSize(numberOfValues) bytes
+     * \param values
+     *      Destination for the values
+     * \param numberOfValues
+     *      Number of values to unpack
+     */
+    static void
+    unpack(const uint8_t* input, uint16_t* values, size_t numberOfValues);
+
+    /**
+     * Pack values.
+     *
+     * Bits of the values above the given width are ignored. Bits of the
+     * last byte beyond the last value are set to zero.
+     *
+     * \param values
+     *      Values to pack
+     * \param numberOfValues
+     *      Number of values to pack
+     * \param output
+     *      Destination, at least getPackedSize(numberOfValues) bytes
+     */
+    static void
+    pack(const uint16_t* values, size_t numberOfValues, uint8_t* output);
+
+    /**
+     * Unpack as many values as fit into the destination.
+     *
+     * \retval false
+     *      The input is too small, nothing has been unpacked.
+     */
+    static bool
+    unpack(outpost::Slice<const uint8_t> input, outpost::Slice<uint16_t> values);
+
+    /**
+     * Pack all values.
+     *
+     * \retval false
+     *      The output is too small, nothing has been packed.
+     */
+    static bool
+    pack(outpost::Slice<const uint16_t> values, outpost::Slice<uint8_t> output);
+
+private:
+    static constexpr uint16_t mask = static_cast<uint16_t>((1UL << width) - 1);
+
+    /**
+     * Pack up to a full group of values.
+     */
+    static inline void
+    packGroup(const uint16_t* values, size_t numberOfValues, uint8_t* output);
+};
+
+}  // namespace outpost
+
+#include "bit_packing_impl.h"
+
+#endif
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_BIT_PACKING_IMPL_H
+#define OUTPOST_UTILS_BIT_PACKING_IMPL_H
+
+#include "bit_packing.h"
+
+#include <string.h>
+
+template <uint8_t width>
+constexpr size_t outpost::BitPacking<width>::valuesPerGroup;
+
+template <uint8_t width>
+constexpr uint16_t outpost::BitPacking<width>::mask;
+
+namespace outpost
+{
+namespace internal
+{
+/**
+ * Extract the value at the given bit offset, only the bytes covered by
+ * the value are accessed.
+ */
+template <uint8_t width>
+inline uint16_t
+extractPackedValue(const uint8_t* input, size_t bitOffset)
+{
+    const size_t index = bitOffset / 8;
+    const size_t shift = bitOffset % 8;
+
+    // The value covers one to three bytes
+    uint32_t window = static_cast<uint32_t>(input[index]) << 16;
+    if (shift + width > 8)
+    {
+        window |= static_cast<uint32_t>(input[index + 1]) << 8;
+    }
+    if (shift + width > 16)
+    {
+        window |= static_cast<uint32_t>(input[index + 2]);
+    }
+    return static_cast<uint16_t>((window >> (24 - shift - width)) & ((1UL << width) - 1));
+}
+
+/**
+ * Load eight bytes in big-endian order.
+ */
+inline uint64_t
+loadPackedWord(const uint8_t* input)
+{
+    uint64_t word;
+    memcpy(&word, input, sizeof(word));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    word = __builtin_bswap64(word);
+#elif !defined(__BYTE_ORDER__)
+    word = 0;
+    for (size_t i = 0; i < sizeof(word); ++i)
+    {
+        word = (word << 8) | input[i];
+    }
+#endif
+    return word;
+}
+
+/**
+ * Unpack the values k to 7 of a group from the first 128 bits of the input
+ * (high and low word), unrolled at compile time so that all shifts are
+ * constants.
+ */
+template <uint8_t width, size_t k>
+struct UnpackGroup
+{
+    static constexpr size_t bitOffset = k * width;
+    static constexpr uint64_t mask = (1ULL << width) - 1;
+
+    static inline void
+    unpack(uint64_t high, uint64_t low, uint16_t* values)
+    {
+        uint64_t value;
+        if (bitOffset + width <= 64)
+        {
+            value = high >> ((64 - bitOffset - width) % 64);
+        }
+        else if (bitOffset >= 64)
+        {
+            value = low >> ((128 - bitOffset - width) % 64);
+        }
+        else
+        {
+            // Value spans both words
+            value = (high << ((bitOffset + width - 64) % 64))
+                    | (low >> ((128 - bitOffset - width) % 64));
+        }
+        values[k] = static_cast<uint16_t>(value & mask);
+        UnpackGroup<width, k + 1>::unpack(high, low, values);
+    }
+};
+
+template <uint8_t width>
+struct UnpackGroup<width, 8>
+{
+    static inline void
+    unpack(uint64_t, uint64_t, uint16_t*)
+    {
+    }
+};
+
+inline void
+storePackedWord(uint8_t* output, uint64_t word)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    word = __builtin_bswap64(word);
+    memcpy(output, &word, sizeof(word));
+#elif defined(__BYTE_ORDER__)
+    memcpy(output, &word, sizeof(word));
+#else
+    for (size_t i = 0; i < sizeof(word); ++i)
+    {
+        output[i] = static_cast<uint8_t>(word >> (56 - 8 * i));
+    }
+#endif
+}
+
+/**
+ * Pack the values k to 7 of a group into 128 bits (high and low word).
+ */
+template <uint8_t width, size_t k>
+struct PackGroup
+{
+    static constexpr size_t bitOffset = k * width;
+    static constexpr uint64_t mask = (1ULL << width) - 1;
+
+    static inline void
+    pack(const uint16_t* values, uint64_t& high, uint64_t& low)
+    {
+        const uint64_t value = values[k] & mask;
+        if (bitOffset + width <= 64)
+        {
+            high |= value << ((64 - bitOffset - width) % 64);
+        }
+        else if (bitOffset >= 64)
+        {
+            low |= value << ((128 - bitOffset - width) % 64);
+        }
+        else
+        {
+            high |= value >> ((bitOffset + width - 64) % 64);
+            low |= value << ((128 - bitOffset - width) % 64);
+        }
+        PackGroup<width, k + 1>::pack(values, high, low);
+    }
+};
+
+template <uint8_t width>
+struct PackGroup<width, 8>
+{
+    static inline void
+    pack(const uint16_t*, uint64_t&, uint64_t&)
+    {
+    }
+};
+}  // namespace internal
+}  // namespace outpost
+
+template <uint8_t width>
+inline void
+outpost::BitPacking<width>::packGroup(const uint16_t* values,
+                                      size_t numberOfValues,
+                                      uint8_t* output)
+{
+    uint32_t accumulator = 0;
+    size_t bits = 0;
+    size_t index = 0;
+    for (size_t k = 0; k < numberOfValues; ++k)
+    {
+        accumulator = (accumulator << width) | (values[k] & mask);
+        bits += width;
+        while (bits >= 8)
+        {
+            bits -= 8;
+            output[index] = static_cast<uint8_t>(accumulator >> bits);
+            index++;
+        }
+    }
+    if (bits > 0)
+    {
+        output[index] = static_cast<uint8_t>(accumulator << (8 - bits));
+    }
+}
+
+template <uint8_t width>
+void
+outpost::BitPacking<width>::unpack(const uint8_t* input, uint16_t* values, size_t numberOfValues)
+{
+    // A group is loaded with two eight byte accesses, which may read beyond
+    // the group itself but not beyond the packed input.
+    const uint8_t* const end = input + getPackedSize(numberOfValues);
+    size_t i = 0;
+    for (; (i + valuesPerGroup <= numberOfValues) && (input + 16 <= end); i += valuesPerGroup)
+    {
+        const uint64_t high = internal::loadPackedWord(input);
+        const uint64_t low = internal::loadPackedWord(input + 8);
+        internal::UnpackGroup<width, 0>::unpack(high, low, &values[i]);
+        input += width;
+    }
+    const size_t remaining = numberOfValues - i;
+    for (size_t k = 0; k < remaining; ++k)
+    {
+        values[i + k] = internal::extractPackedValue<width>(input, k * width);
+    }
+}
+
+template <uint8_t width>
+void
+outpost::BitPacking<width>::pack(const uint16_t* values, size_t numberOfValues, uint8_t* output)
+{
+    // A group is stored with two eight byte accesses. The bytes beyond the
+    // group are overwritten by the following group in turn.
+    uint8_t* const end = output + getPackedSize(numberOfValues);
+    size_t i = 0;
+    for (; (i + valuesPerGroup <= numberOfValues) && (output + 16 <= end); i += valuesPerGroup)
+    {
+        uint64_t high = 0;
+        uint64_t low = 0;
+        internal::PackGroup<width, 0>::pack(&values[i], high, low);
+        internal::storePackedWord(output, high);
+        internal::storePackedWord(output + 8, low);
+        output += width;
+    }
+    for (; i + valuesPerGroup <= numberOfValues; i += valuesPerGroup)
+    {
+        packGroup(&values[i], valuesPerGroup, output);
+        output += width;
+    }
+    if (i < numberOfValues)
+    {
+        packGroup(&values[i], numberOfValues - i, output);
+    }
+}
+
+template <uint8_t width>
+bool
+outpost::BitPacking<width>::unpack(outpost::Slice<const uint8_t> input,
+                                   outpost::Slice<uint16_t> values)
+{
+    const size_t numberOfValues = values.getNumberOfElements();
+    if (input.getNumberOfElements() < getPackedSize(numberOfValues))
+    {
+        return false;
+    }
+    unpack(&input[0], &values[0], numberOfValues);
+    return true;
+}
+
+template <uint8_t width>
+bool
+outpost::BitPacking<width>::pack(outpost::Slice<const uint16_t> values,
+                                 outpost::Slice<uint8_t> output)
+{
+    const size_t numberOfValues = values.getNumberOfElements();
+    if (output.getNumberOfElements() < getPackedSize(numberOfValues))
+    {
+        return false;
+    }
+    pack(&values[0], numberOfValues, &output[0]);
+    return true;
+}
+
+#endif
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "bit_reader.h"
+
+#include <string.h>
+
+using namespace outpost;
+
+constexpr uint8_t BitReader::maximumBitsPerAccess;
+
+BitReader::BitReader(outpost::Slice<const uint8_t> buffer) :
+    mBuffer(&buffer[0]),
+    mNumberOfBits(static_cast<uint32_t>(buffer.getNumberOfElements() * 8)),
+    mNextByte(0),
+    mPosition(0),
+    mAccumulator(0),
+    mAvailableBits(0)
+{
+}
+
+BitReader::BitReader(outpost::Slice<const uint8_t> buffer, uint32_t numberOfBits) :
+    mBuffer(&buffer[0]),
+    mNumberOfBits((numberOfBits < buffer.getNumberOfElements() * 8)
+                          ? numberOfBits
+                          : static_cast<uint32_t>(buffer.getNumberOfElements() * 8)),
+    mNextByte(0),
+    mPosition(0),
+    mAccumulator(0),
+    mAvailableBits(0)
+{
+}
+
+bool
+BitReader::readBytes(outpost::Slice<uint8_t> bytes)
+{
+    const size_t length = bytes.getNumberOfElements();
+    if (length * 8 > getNumberOfRemainingBits())
+    {
+        return false;
+    }
+
+    size_t i = 0;
+    if ((mPosition % 8) == 0)
+    {
+        // Bytes already loaded into the accumulator
+        for (; (i < length) && (mAvailableBits > 0); i++)
+        {
+            bytes[i] = static_cast<uint8_t>(readBits(8));
+        }
+
+        const size_t remaining = length - i;
+        memcpy(&bytes[i], &mBuffer[mNextByte], remaining);
+        mNextByte += remaining;
+        mPosition += static_cast<uint32_t>(remaining * 8);
+        return true;
+    }
+
+    for (; i + 4 <= length; i += 4)
+    {
+        const uint32_t word = readBits(32);
+        bytes[i + 0] = static_cast<uint8_t>(word >> 24);
+        bytes[i + 1] = static_cast<uint8_t>(word >> 16);
+        bytes[i + 2] = static_cast<uint8_t>(word >> 8);
+        bytes[i + 3] = static_cast<uint8_t>(word >> 0);
+    }
+    for (; i < length; i++)
+    {
+        bytes[i] = static_cast<uint8_t>(readBits(8));
+    }
+    return true;
+}
+
+void
+BitReader::refill(uint8_t count)
+{
+    const size_t numberOfBytes = (mNumberOfBits + 7) / 8;
+    while ((mAvailableBits <= 56) && (mNextByte < numberOfBytes))
+    {
+        uint8_t byte = mBuffer[mNextByte];
+        mNextByte++;
+        if (mNextByte * 8 > mNumberOfBits)
+        {
+            // Clear the bits beyond the end of the stream in the last byte
+            byte &= static_cast<uint8_t>(0xFF << (mNextByte * 8 - mNumberOfBits));
+        }
+        mAccumulator = (mAccumulator << 8) | byte;
+        mAvailableBits += 8;
+    }
+
+    if (mAvailableBits < count)
+    {
+        mAccumulator <<= (count - mAvailableBits);
+        mAvailableBits = count;
+    }
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_STORAGE_BIT_READER_H
+#define OUTPOST_UTILS_STORAGE_BIT_READER_H
+
+#include <outpost/base/slice.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+/**
+ * Read bit fields of arbitrary width from a byte buffer.
+ *
+ * The bits are read most significant bit first, as written by BitWriter.
+ * Bytes are loaded into a 64 bit accumulator, so that the bounds of the
+ * buffer are only checked when refilling it. Like Bitstream::getBit(),
+ * bits beyond the end of the stream are read as zero.
+ *
+ * \see BitWriter
+ */
+class BitReader
+{
+public:
+    /// Maximum number of bits read with a single call of readBits()
+    static constexpr uint8_t maximumBitsPerAccess = 32;
+
+    /**
+     * Read all bits of the buffer.
+     */
+    explicit BitReader(outpost::Slice<const uint8_t> buffer);
+
+    /**
+     * Read the first numberOfBits bits of the buffer.
+     *
+     * The number of bits is limited to the size of the buffer.
+     */
+    BitReader(outpost::Slice<const uint8_t> buffer, uint32_t numberOfBits);
+
+    BitReader(const BitReader&) = delete;
+
+    BitReader&
+    operator=(const BitReader&) = delete;
+
+    inline bool
+    readBit()
+    {
+        return readBits(1) != 0;
+    }
+
+    /**
+     * Read several bits, the first bit read becomes the most significant one.
+     *
+     * \param count
+     *      Number of bits to read, at most maximumBitsPerAccess
+     */
+    inline uint32_t
+    readBits(uint8_t count)
+    {
+        if (mAvailableBits < count)
+        {
+            refill(count);
+        }
+        mAvailableBits -= count;
+        mPosition += count;
+
+        const uint64_t mask = (static_cast<uint64_t>(1) << count) - 1;
+        return static_cast<uint32_t>((mAccumulator >> mAvailableBits) & mask);
+    }
+
+    /**
+     * Read whole bytes.
+     *
+     * If the stream is at a byte boundary the bytes are copied with a
+     * single memcpy, otherwise they are read 32 bit at a time.
+     *
+     * \retval false
+     *      Not enough bits left in the stream, nothing has been read.
+     */
+    bool
+    readBytes(outpost::Slice<uint8_t> bytes);
+
+    /**
+     * Skip the remaining bits of the current byte.
+     */
+    inline void
+    alignToByte()
+    {
+        readBits((8 - (mPosition % 8)) % 8);
+    }
+
+    /**
+     * Index of the next bit to read
+     */
+    inline uint32_t
+    getPosition() const
+    {
+        return mPosition;
+    }
+
+    inline uint32_t
+    getNumberOfBits() const
+    {
+        return mNumberOfBits;
+    }
+
+    inline uint32_t
+    getNumberOfRemainingBits() const
+    {
+        return (mPosition < mNumberOfBits) ? (mNumberOfBits - mPosition) : 0;
+    }
+
+private:
+    /**
+     * Load bytes until at least count bits are available. Beyond the end
+     * of the stream zero bits are appended.
+     */
+    void
+    refill(uint8_t count);
+
+    const uint8_t* const mBuffer;
+    const uint32_t mNumberOfBits;
+
+    /// Index of the next byte to load into the accumulator
+    size_t mNextByte;
+    uint32_t mPosition;
+
+    uint64_t mAccumulator;
+    uint8_t mAvailableBits;
+};
+
+}  // namespace outpost
+
+#endif
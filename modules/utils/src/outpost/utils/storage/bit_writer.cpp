@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "bit_writer.h"
+
+#include <string.h>
+
+using namespace outpost;
+
+constexpr uint8_t BitWriter::maximumBitsPerAccess;
+
+BitWriter::BitWriter(outpost::Slice<uint8_t> buffer) :
+    mBuffer(&buffer[0]),
+    mCapacity(buffer.getNumberOfElements()),
+    mPosition(0),
+    mAccumulator(0),
+    mPendingBits(0)
+{
+}
+
+bool
+BitWriter::pushBytes(outpost::Slice<const uint8_t> bytes)
+{
+    const size_t length = bytes.getNumberOfElements();
+    if (length * 8 > getNumberOfFreeBits())
+    {
+        return false;
+    }
+
+    if ((mPendingBits % 8) == 0)
+    {
+        writeBytes();
+        memcpy(&mBuffer[mPosition], &bytes[0], length);
+        mPosition += length;
+        return true;
+    }
+
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4)
+    {
+        const uint32_t word = (static_cast<uint32_t>(bytes[i + 0]) << 24)
+                              | (static_cast<uint32_t>(bytes[i + 1]) << 16)
+                              | (static_cast<uint32_t>(bytes[i + 2]) << 8)
+                              | (static_cast<uint32_t>(bytes[i + 3]) << 0);
+        pushBits(word, 32);
+    }
+    for (; i < length; i++)
+    {
+        pushBits(bytes[i], 8);
+    }
+    return true;
+}
+
+size_t
+BitWriter::flush()
+{
+    writeBytes();
+    if (mPendingBits > 0)
+    {
+        mBuffer[mPosition] = static_cast<uint8_t>(mAccumulator << (8 - mPendingBits));
+    }
+    return getSize();
+}
+
+void
+BitWriter::writeBytes()
+{
+    while (mPendingBits >= 8)
+    {
+        mPendingBits -= 8;
+        mBuffer[mPosition] = static_cast<uint8_t>(mAccumulator >> mPendingBits);
+        mPosition++;
+    }
+}
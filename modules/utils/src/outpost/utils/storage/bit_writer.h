@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_STORAGE_BIT_WRITER_H
+#define OUTPOST_UTILS_STORAGE_BIT_WRITER_H
+
+#include <outpost/base/slice.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+/**
+ * Write bit fields of arbitrary width into a byte buffer.
+ *
+ * The bits are written most significant bit first. They are collected in
+ * a 64 bit accumulator and written to the buffer 32 bit at a time, so that
+ * no read-modify-write of the buffer is necessary.
+ *
+ * The buffer only contains all pushed bits after flush() has been called.
+ *
+ * \see BitReader
+ * \see BitstreamHeader for the wire format of Bitstream
+ */
+class BitWriter
+{
+public:
+    /// Maximum number of bits pushed with a single call of pushBits()
+    static constexpr uint8_t maximumBitsPerAccess = 32;
+
+    explicit BitWriter(outpost::Slice<uint8_t> buffer);
+
+    BitWriter(const BitWriter&) = delete;
+
+    BitWriter&
+    operator=(const BitWriter&) = delete;
+
+    inline bool
+    pushBit(bool bit)
+    {
+        return pushBits(bit ? 1U : 0U, 1);
+    }
+
+    /**
+     * Push several bits, most significant bit first.
+     *
+     * \param value
+     *      Bits to push, right aligned. Higher bits are ignored.
+     * \param count
+     *      Number of bits to push, at most maximumBitsPerAccess
+     *
+     * \retval true
+     *      Bits have been pushed.
+     * \retval false
+     *      Not enough space left in the buffer or count too large, nothing
+     *      has been pushed.
+     */
+    inline bool
+    pushBits(uint32_t value, uint8_t count)
+    {
+        if (count > maximumBitsPerAccess || count > getNumberOfFreeBits())
+        {
+            return false;
+        }
+
+        const uint64_t mask = (static_cast<uint64_t>(1) << count) - 1;
+        mAccumulator = (mAccumulator << count) | (value & mask);
+        mPendingBits += count;
+        if (mPendingBits >= 32)
+        {
+            writeWord();
+        }
+        return true;
+    }
+
+    /**
+     * Push whole bytes.
+     *
+     * If the stream is at a byte boundary the bytes are copied with a
+     * single memcpy, otherwise they are pushed 32 bit at a time.
+     *
+     * \retval false
+     *      Not enough space left in the buffer, nothing has been pushed.
+     */
+    bool
+    pushBytes(outpost::Slice<const uint8_t> bytes);
+
+    /**
+     * Fill up the current byte with zero bits.
+     */
+    inline void
+    alignToByte()
+    {
+        pushBits(0, (8 - (mPendingBits % 8)) % 8);
+    }
+
+    /**
+     * Write all pending bits to the buffer.
+     *
+     * An incomplete last byte is filled up with zero bits in the buffer,
+     * following bits will still be appended directly.
+     *
+     * \return
+     *      Number of bytes used in the buffer
+     */
+    size_t
+    flush();
+
+    /**
+     * Discard all bits.
+     */
+    inline void
+    reset()
+    {
+        mPosition = 0;
+        mAccumulator = 0;
+        mPendingBits = 0;
+    }
+
+    inline uint32_t
+    getNumberOfBits() const
+    {
+        return static_cast<uint32_t>(mPosition * 8 + mPendingBits);
+    }
+
+    inline size_t
+    getNumberOfFreeBits() const
+    {
+        return mCapacity * 8 - getNumberOfBits();
+    }
+
+    /**
+     * Number of bytes used, including an incomplete last byte.
+     */
+    inline size_t
+    getSize() const
+    {
+        return (getNumberOfBits() + 7) / 8;
+    }
+
+private:
+    inline void
+    writeWord()
+    {
+        const uint32_t word = static_cast<uint32_t>(mAccumulator >> (mPendingBits - 32));
+        mBuffer[mPosition + 0] = static_cast<uint8_t>(word >> 24);
+        mBuffer[mPosition + 1] = static_cast<uint8_t>(word >> 16);
+        mBuffer[mPosition + 2] = static_cast<uint8_t>(word >> 8);
+        mBuffer[mPosition + 3] = static_cast<uint8_t>(word >> 0);
+        mPosition += 4;
+        mPendingBits -= 32;
+    }
+
+    /**
+     * Write the complete bytes of the accumulator to the buffer.
+     */
+    void
+    writeBytes();
+
+    uint8_t* const mBuffer;
+    const size_t mCapacity;
+
+    /// Number of bytes written to the buffer
+    size_t mPosition;
+
+    /// Bits not yet written, right aligned
+    uint64_t mAccumulator;
+    uint8_t mPendingBits;
+};
+
+}  // namespace outpost
+
+#endif
@@ -90,6 +90,55 @@ public:
         }
     }
 
+    /**
+     * Pushes several bits to the stream, most significant bit first.
+     * The bits are written byte by byte instead of one at a time. Bits which
+     * do not fit into the stream anymore are discarded.
+     * \param value
+     *     Bits to push, right aligned
+     * \param count
+     *     Number of bits to push, at most 32
+     */
+    void
+    pushBits(uint32_t value, uint8_t count)
+    {
+        if (isEmpty() && !isFull())
+        {
+            mData[bytePointer] = 0;
+        }
+        while (count > 0 && !isFull())
+        {
+            uint8_t freeBits = bitPointer + 1;
+            uint8_t n = (count < freeBits) ? count : freeBits;
+            count -= n;
+
+            uint8_t shift = freeBits - n;
+            uint8_t mask = static_cast<uint8_t>(((1U << n) - 1) << shift);
+            uint8_t bits = static_cast<uint8_t>(((value >> count) << shift) & mask);
+            mData[bytePointer] = (mData[bytePointer] & ~mask) | bits;
+
+            bitPointer -= n;
+            if (bitPointer == -1)
+            {
+                bitPointer = 7;
+                bytePointer++;
+                if (!isFull())
+                {
+                    mData[bytePointer] = 0;
+                }
+            }
+        }
+    }
+
+    /**
+     * Number of bits in the stream
+     */
+    inline uint32_t
+    getNumberOfBits() const
+    {
+        return ((static_cast<uint32_t>(bytePointer) - headerSize) << 3) + (7 - bitPointer);
+    }
+
     /**
      * Grants bit-level access to the stream
      *
@@ -122,7 +171,7 @@ public:
     inline uint8_t
     getByte(uint16_t n) const
     {
-        if (n <= bytePointer - headerSize)
+        if (n < getSize())
         {
             return mData[n + headerSize];
         }
@@ -222,17 +271,21 @@ public:
     {
         uint16_t bytePointer_tmp = stream.read<uint16_t>();
         uint16_t bitPointer_tmp = stream.read<int8_t>();
-        if (bytePointer_tmp < mData.getNumberOfElements())
+        // The incomplete last byte is part of the serialized data as well
+        uint16_t length = bytePointer_tmp - headerSize + ((bitPointer_tmp < 7) ? 1 : 0);
+        // A stream ending on a byte boundary may fill the buffer completely
+        if (bytePointer_tmp >= headerSize
+            && static_cast<size_t>(headerSize + length) <= mData.getNumberOfElements())
         {
             bytePointer = bytePointer_tmp;
             bitPointer = bitPointer_tmp;
             if (stream.getPointer() != &mData[0])
             {
-                stream.readBuffer(&mData[headerSize], bytePointer - headerSize);
+                stream.readBuffer(&mData[headerSize], length);
             }
             else
             {
-                stream.skip(bytePointer - headerSize);
+                stream.skip(length);
             }
             return true;
         }
@@ -240,6 +293,224 @@ public:
     }
 };
 
+/**
+ * Collects bits in a 32 bit register before writing them to a Bitstream.
+ *
+ * The Bitstream only contains the pushed bits after flush() has been
+ * called, which is done automatically when the writer is destroyed.
+ */
+class BitstreamWriter
+{
+public:
+    explicit BitstreamWriter(Bitstream& stream) : mStream(stream), mRegister(0), mCount(0)
+    {
+    }
+
+    ~BitstreamWriter()
+    {
+        flush();
+    }
+
+    BitstreamWriter(const BitstreamWriter&) = delete;
+
+    BitstreamWriter&
+    operator=(const BitstreamWriter&) = delete;
+
+    inline void
+    pushBit(bool b)
+    {
+        mRegister = (mRegister << 1) | (b ? 1U : 0U);
+        mCount++;
+        if (mCount == registerSize)
+        {
+            flush();
+        }
+    }
+
+    /**
+     * Pushes several bits, most significant bit first.
+     * \param value
+     *     Bits to push, right aligned
+     * \param count
+     *     Number of bits to push, at most 32
+     */
+    inline void
+    pushBits(uint32_t value, uint8_t count)
+    {
+        if (mCount + count > registerSize)
+        {
+            flush();
+        }
+        if (count == registerSize)
+        {
+            mStream.pushBits(value, count);
+            return;
+        }
+        mRegister = (mRegister << count) | (value & ((1U << count) - 1));
+        mCount += count;
+        if (mCount == registerSize)
+        {
+            flush();
+        }
+    }
+
+    /**
+     * Writes the collected bits to the stream.
+     */
+    inline void
+    flush()
+    {
+        if (mCount > 0)
+        {
+            mStream.pushBits(mRegister, mCount);
+            mRegister = 0;
+            mCount = 0;
+        }
+    }
+
+private:
+    static constexpr uint8_t registerSize = 32;
+
+    Bitstream& mStream;
+    uint32_t mRegister;
+    uint8_t mCount;
+};
+
+/**
+ * Reads the bits of a Bitstream sequentially.
+ *
+ * The current byte is cached so that the bounds of the stream are only
+ * checked once per byte. Like Bitstream::getBit(), bits beyond the end
+ * of the stream are read as zero.
+ */
+class BitstreamReader
+{
+public:
+    /**
+     * \param position
+     *     Index of the first bit to read
+     */
+    explicit BitstreamReader(const Bitstream& stream, uint32_t position = 0) :
+        mStream(stream),
+        mNumberOfBits(stream.getNumberOfBits()),
+        mPosition(position),
+        mByte(stream.getByte(position >> 3))
+    {
+    }
+
+    inline bool
+    getBit()
+    {
+        if (mPosition >= mNumberOfBits)
+        {
+            mPosition++;
+            return false;
+        }
+        bool bit = (mByte & (0x80 >> (mPosition & 7))) != 0;
+        mPosition++;
+        if ((mPosition & 7) == 0)
+        {
+            mByte = mStream.getByte(mPosition >> 3);
+        }
+        return bit;
+    }
+
+    /**
+     * Reads several bits, the first bit read becomes the most significant one.
+     * \param count
+     *     Number of bits to read, at most 32
+     */
+    inline uint32_t
+    getBits(uint8_t count)
+    {
+        uint32_t value = 0;
+        for (uint8_t i = 0; i < count; i++)
+        {
+            value = (value << 1) | (getBit() ? 1U : 0U);
+        }
+        return value;
+    }
+
+    /**
+     * Index of the next bit to read
+     */
+    inline uint32_t
+    getPosition() const
+    {
+        return mPosition;
+    }
+
+private:
+    const Bitstream& mStream;
+    const uint32_t mNumberOfBits;
+    uint32_t mPosition;
+    uint8_t mByte;
+};
+
+/**
+ * Header of the wire format of Bitstream::serialize().
+ *
+ * Allows BitWriter and BitReader to produce and consume the serialized
+ * format of a Bitstream: the header is followed directly by the bits,
+ * most significant bit first.
+ *
+ * \code
+ * outpost::BitWriter writer(buffer.skipFirst(outpost::BitstreamHeader::size));
+ * ...
+ * writer.flush();
+ * outpost::BitstreamHeader::store(buffer, writer.getNumberOfBits());
+ * \endcode
+ */
+class BitstreamHeader
+{
+public:
+    static constexpr size_t size = Bitstream::headerSize;
+
+    /**
+     * Store the header for a stream of the given number of bits.
+     *
+     * \param buffer
+     *      Beginning of the serialized stream, at least `size` bytes
+     */
+    static inline void
+    store(outpost::Slice<uint8_t> buffer, uint32_t numberOfBits)
+    {
+        Serialize stream(buffer);
+        stream.store<uint16_t>(static_cast<uint16_t>(size + numberOfBits / 8));
+        stream.store<int8_t>(static_cast<int8_t>(7 - (numberOfBits % 8)));
+    }
+
+    /**
+     * Read the number of bits from the header of a serialized stream.
+     *
+     * \retval false
+     *      Header is invalid or the stream exceeds the buffer.
+     */
+    static inline bool
+    read(outpost::Slice<const uint8_t> buffer, uint32_t& numberOfBits)
+    {
+        if (buffer.getNumberOfElements() < size)
+        {
+            return false;
+        }
+
+        Deserialize stream(buffer);
+        const uint16_t bytePointer = stream.read<uint16_t>();
+        const int8_t bitPointer = stream.read<int8_t>();
+        if (bytePointer < size || bitPointer < 0 || bitPointer > 7)
+        {
+            return false;
+        }
+
+        numberOfBits = (static_cast<uint32_t>(bytePointer - size) * 8) + (7 - bitPointer);
+        if ((numberOfBits + 7) / 8 > buffer.getNumberOfElements() - size)
+        {
+            return false;
+        }
+        return true;
+    }
+};
+
 }  // namespace outpost
 
 #endif /*OUTPOST_UTILS_STORAGE_BITSTREAM_H_ */
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_CHECKED_SERIALIZE_H
+#define OUTPOST_UTILS_CHECKED_SERIALIZE_H
+
+#include "packet_layout.h"
+#include "serialize.h"
+
+#include <outpost/base/slice.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <type_traits>
+
+namespace outpost
+{
+namespace internal
+{
+template <typename... Ts>
+struct SerializedSize;
+
+template <>
+struct SerializedSize<>
+{
+    static constexpr size_t value = 0;
+};
+
+template <typename T, typename... Ts>
+struct SerializedSize<T, Ts...>
+{
+    static constexpr size_t value = Serialize::getTypeSize<T>() + SerializedSize<Ts...>::value;
+};
+
+template <typename T, typename... Ts>
+constexpr size_t SerializedSize<T, Ts...>::value;
+}  // namespace internal
+
+/**
+ * Serialize big-endian data with a check against the end of the buffer.
+ *
+ * The capacity is checked once per call with the static size of all values
+ * passed to the call, the values themselves are stored unchecked. Storing
+ * a message of several fields with a single `store(a, b, c)` call therefore
+ * costs one comparison.
+ *
+ * If a message does not fit into the remaining buffer nothing of it is
+ * written and the stream is marked as overflowed. The overflow is sticky,
+ * all following messages are dropped as well, so that it is sufficient to
+ * check `hasOverflow()` once after building a packet.
+ *
+ * \code
+ * outpost::CheckedSerialize stream(outpost::asSlice(buffer));
+ * stream.store<uint16_t, uint32_t, float>(id, time, value);
+ * stream.store(outpost::asSlice(samples));
+ * if (stream.hasOverflow())
+ * {
+ *     ...
+ * }
+ * \endcode
+ */
+class CheckedSerialize
+{
+public:
+    explicit inline CheckedSerialize(outpost::Slice<uint8_t> array) :
+        mSerialize(array),
+        mCapacity(array.getNumberOfElements()),
+        mOverflow(false)
+    {
+    }
+
+    ~CheckedSerialize() = default;
+
+    CheckedSerialize(const CheckedSerialize& other) = default;
+
+    // disable assignment operator
+    CheckedSerialize&
+    operator=(const CheckedSerialize& other) = delete;
+
+    /**
+     * Reset the write pointer to the beginning of the buffer and clear
+     * the overflow flag.
+     */
+    inline void
+    reset()
+    {
+        mSerialize.reset();
+        mOverflow = false;
+    }
+
+    /**
+     * Serialized size of all given types in bytes.
+     */
+    template <typename... Ts>
+    static inline constexpr size_t
+    getTypeSize()
+    {
+        return internal::SerializedSize<typename std::remove_cv<Ts>::type...>::value;
+    }
+
+    /**
+     * Store a message of one or more values.
+     *
+     * \return
+     *      false if the message does not fit into the remaining buffer
+     *      or a previous message has overflowed.
+     */
+    template <typename... Ts>
+    inline bool
+    store(Ts... values)
+    {
+        if (!reserve(getTypeSize<Ts...>()))
+        {
+            return false;
+        }
+        storeUnchecked(values...);
+        return true;
+    }
+
+    template <typename U>
+    inline bool
+    store(outpost::Slice<const U> array)
+    {
+        if (!reserve(Serialize::getTypeSize(array)))
+        {
+            return false;
+        }
+        mSerialize.store(array);
+        return true;
+    }
+
+    template <typename U>
+    inline bool
+    store(outpost::Slice<U> array)
+    {
+        return store(outpost::Slice<const U>(array));
+    }
+
+    /**
+     * Store a message described by a `PacketLayout`.
+     */
+    template <typename Layout, typename... Ts>
+    inline bool
+    storePacket(Ts... values)
+    {
+        if (!reserve(Layout::size))
+        {
+            return false;
+        }
+        Layout::store(mSerialize, values...);
+        return true;
+    }
+
+    inline bool
+    storeBuffer(const uint8_t* buffer, const size_t length)
+    {
+        if (!reserve(length))
+        {
+            return false;
+        }
+        mSerialize.storeBuffer(buffer, length);
+        return true;
+    }
+
+    /**
+     * Skip forward the given number of bytes.
+     *
+     * \return
+     *      false if the remaining buffer is smaller than the given number
+     *      of bytes.
+     */
+    inline bool
+    skip(const size_t bytes)
+    {
+        if (!reserve(bytes))
+        {
+            return false;
+        }
+        mSerialize.skip(bytes);
+        return true;
+    }
+
+    inline bool
+    hasOverflow() const
+    {
+        return mOverflow;
+    }
+
+    inline size_t
+    getRemainingSize() const
+    {
+        return mCapacity - mSerialize.getPosition<size_t>();
+    }
+
+    template <typename T = ptrdiff_t>
+    inline T
+    getPosition() const
+    {
+        return mSerialize.getPosition<T>();
+    }
+
+    inline Slice<uint8_t>
+    asSlice()
+    {
+        return mSerialize.asSlice();
+    }
+
+private:
+    inline bool
+    reserve(size_t bytes)
+    {
+        if (mOverflow || (bytes > getRemainingSize()))
+        {
+            mOverflow = true;
+            return false;
+        }
+        return true;
+    }
+
+    inline void
+    storeUnchecked()
+    {
+    }
+
+    template <typename T, typename... Ts>
+    inline void
+    storeUnchecked(T value, Ts... values)
+    {
+        mSerialize.store<T>(value);
+        storeUnchecked(values...);
+    }
+
+    Serialize mSerialize;
+    const size_t mCapacity;
+    bool mOverflow;
+};
+
+}  // namespace outpost
+
+#endif
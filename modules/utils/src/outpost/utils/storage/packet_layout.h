@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_PACKET_LAYOUT_H
+#define OUTPOST_UTILS_PACKET_LAYOUT_H
+
+#include "bitfield.h"
+#include "serialize.h"
+#include "serialize_little_endian_traits.h"
+#include "serialize_traits.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+/**
+ * Big-endian field of a packet layout.
+ *
+ * The field must start at a byte boundary.
+ */
+template <typename T>
+struct BigEndianField
+{
+    typedef T Type;
+
+    static constexpr size_t numberOfBits = SerializeBigEndianTraits<T>::size() * 8;
+
+    template <size_t bitOffset>
+    static inline void
+    store(uint8_t* buffer, T value)
+    {
+        static_assert(bitOffset % 8 == 0, "Byte fields must start at a byte boundary");
+        uint8_t* position = buffer + bitOffset / 8;
+        SerializeBigEndianTraits<T>::store(position, value);
+    }
+
+    template <size_t bitOffset>
+    static inline T
+    read(const uint8_t* buffer)
+    {
+        static_assert(bitOffset % 8 == 0, "Byte fields must start at a byte boundary");
+        return SerializeBigEndianTraits<T>::peek(buffer, bitOffset / 8);
+    }
+};
+
+/**
+ * Little-endian field of a packet layout.
+ *
+ * The field must start at a byte boundary.
+ */
+template <typename T>
+struct LittleEndianField
+{
+    typedef T Type;
+
+    static constexpr size_t numberOfBits = SerializeLittleEndianTraits<T>::size() * 8;
+
+    template <size_t bitOffset>
+    static inline void
+    store(uint8_t* buffer, T value)
+    {
+        static_assert(bitOffset % 8 == 0, "Byte fields must start at a byte boundary");
+        uint8_t* position = buffer + bitOffset / 8;
+        SerializeLittleEndianTraits<T>::store(position, value);
+    }
+
+    template <size_t bitOffset>
+    static inline T
+    read(const uint8_t* buffer)
+    {
+        static_assert(bitOffset % 8 == 0, "Byte fields must start at a byte boundary");
+        return SerializeLittleEndianTraits<T>::peek(buffer, bitOffset / 8);
+    }
+};
+
+/**
+ * Field of 1 to 16 bits of a packet layout.
+ *
+ * The bits are stored MSB first, see `Bitfield`, and may start at any bit
+ * position.
+ */
+template <size_t width>
+struct BitsField
+{
+    static_assert(width >= 1 && width <= 16, "Bit fields must have 1 to 16 bits");
+
+    typedef uint16_t Type;
+
+    static constexpr size_t numberOfBits = width;
+
+    template <size_t bitOffset>
+    static inline void
+    store(uint8_t* buffer, uint16_t value)
+    {
+        Bitfield::write<bitOffset % 8, bitOffset % 8 + width - 1>(buffer + bitOffset / 8, value);
+    }
+
+    template <size_t bitOffset>
+    static inline uint16_t
+    read(const uint8_t* buffer)
+    {
+        return Bitfield::read<bitOffset % 8, bitOffset % 8 + width - 1>(buffer + bitOffset / 8);
+    }
+};
+
+template <>
+struct BitsField<1>
+{
+    typedef uint16_t Type;
+
+    static constexpr size_t numberOfBits = 1;
+
+    template <size_t bitOffset>
+    static inline void
+    store(uint8_t* buffer, uint16_t value)
+    {
+        Bitfield::write<bitOffset % 8>(buffer + bitOffset / 8, value != 0);
+    }
+
+    template <size_t bitOffset>
+    static inline uint16_t
+    read(const uint8_t* buffer)
+    {
+        return Bitfield::read<bitOffset % 8>(buffer + bitOffset / 8) ? 1 : 0;
+    }
+};
+
+template <typename T>
+constexpr size_t BigEndianField<T>::numberOfBits;
+
+template <typename T>
+constexpr size_t LittleEndianField<T>::numberOfBits;
+
+template <size_t width>
+constexpr size_t BitsField<width>::numberOfBits;
+
+namespace internal
+{
+template <size_t bitOffset, typename... Fields>
+struct PacketLayoutAccess;
+
+template <size_t bitOffset>
+struct PacketLayoutAccess<bitOffset>
+{
+    static constexpr size_t numberOfBits = 0;
+
+    static inline void
+    store(uint8_t*)
+    {
+    }
+
+    static inline void
+    read(const uint8_t*)
+    {
+    }
+};
+
+template <size_t bitOffset, typename Field, typename... Remaining>
+struct PacketLayoutAccess<bitOffset, Field, Remaining...>
+{
+    typedef PacketLayoutAccess<bitOffset + Field::numberOfBits, Remaining...> Next;
+
+    static constexpr size_t numberOfBits = Field::numberOfBits + Next::numberOfBits;
+
+    static inline void
+    store(uint8_t* buffer, typename Field::Type value, typename Remaining::Type... remaining)
+    {
+        Field::template store<bitOffset>(buffer, value);
+        Next::store(buffer, remaining...);
+    }
+
+    static inline void
+    read(const uint8_t* buffer, typename Field::Type& value, typename Remaining::Type&... remaining)
+    {
+        value = Field::template read<bitOffset>(buffer);
+        Next::read(buffer, remaining...);
+    }
+};
+
+/**
+ * Descriptor and bit offset of the field with the given index.
+ */
+template <size_t index, size_t bitOffset, typename... Fields>
+struct PacketLayoutField;
+
+template <size_t bitOffset, typename Field, typename... Remaining>
+struct PacketLayoutField<0, bitOffset, Field, Remaining...>
+{
+    typedef Field Descriptor;
+    static constexpr size_t offset = bitOffset;
+};
+
+template <size_t index, size_t bitOffset, typename Field, typename... Remaining>
+struct PacketLayoutField<index, bitOffset, Field, Remaining...>
+    : public PacketLayoutField<index - 1, bitOffset + Field::numberOfBits, Remaining...>
+{
+};
+}  // namespace internal
+
+/**
+ * Compile-time description of the layout of a packet.
+ *
+ * All field offsets are known at compile time, the fields are accessed
+ * relative to the start of the packet without advancing a pointer after
+ * each field. This allows the compiler to merge adjacent stores and loads.
+ *
+ * Example for the primary header of a CCSDS space packet:
+ * \code
+ * typedef outpost::PacketLayout<outpost::BitsField<3>,     // version
+ *                               outpost::BitsField<1>,     // type
+ *                               outpost::BitsField<1>,     // secondary header
+ *                               outpost::BitsField<11>,    // APID
+ *                               outpost::BitsField<2>,     // sequence flags
+ *                               outpost::BitsField<14>,    // sequence count
+ *                               outpost::BigEndianField<uint16_t>> PrimaryHeader;
+ *
+ * PrimaryHeader::store(stream, 0, 0, 1, apid, 3, count, length);
+ * \endcode
+ *
+ * \tparam Fields
+ *      `BigEndianField`, `LittleEndianField` or `BitsField`
+ */
+template <typename... Fields>
+class PacketLayout
+{
+    typedef internal::PacketLayoutAccess<0, Fields...> Access;
+
+public:
+    static constexpr size_t numberOfBits = Access::numberOfBits;
+
+    /// Size of the packet in bytes
+    static constexpr size_t size = numberOfBits / 8;
+
+    static_assert(numberOfBits % 8 == 0, "Packet layout must end at a byte boundary");
+
+    /**
+     * Properties of a single field.
+     *
+     * \tparam index
+     *      Index of the field in the layout, starting at zero
+     */
+    template <size_t index>
+    struct Field
+    {
+        static_assert(index < sizeof...(Fields), "Field index out of range");
+
+        typedef typename internal::PacketLayoutField<index, 0, Fields...>::Descriptor Descriptor;
+        typedef typename Descriptor::Type Type;
+
+        static constexpr size_t bitOffset =
+                internal::PacketLayoutField<index, 0, Fields...>::offset;
+    };
+
+    /**
+     * Read a single field.
+     */
+    template <size_t index>
+    static inline typename Field<index>::Type
+    get(const uint8_t* buffer)
+    {
+        return Field<index>::Descriptor::template read<Field<index>::bitOffset>(buffer);
+    }
+
+    /**
+     * Write a single field, all other fields are left unchanged.
+     */
+    template <size_t index>
+    static inline void
+    set(uint8_t* buffer, typename Field<index>::Type value)
+    {
+        Field<index>::Descriptor::template store<Field<index>::bitOffset>(buffer, value);
+    }
+
+    /**
+     * Store all fields.
+     *
+     * Bit fields are merged into the existing contents of the buffer, a
+     * byte shared with a `BitsField` must therefore be initialized before.
+     * Bits outside the fields keep their value.
+     *
+     * \param buffer
+     *      Buffer of at least `size` bytes
+     */
+    static inline void
+    store(uint8_t* buffer, typename Fields::Type... values)
+    {
+        Access::store(buffer, values...);
+    }
+
+    /**
+     * Store all fields at the current position of the stream and advance it
+     * by `size` bytes.
+     *
+     * As for store(uint8_t*, ...) the bit fields are merged into the
+     * existing contents of the stream buffer.
+     */
+    static inline void
+    store(Serialize& stream, typename Fields::Type... values)
+    {
+        Access::store(stream.getPointerToCurrentPosition(), values...);
+        stream.skip(size);
+    }
+
+    /**
+     * Read all fields.
+     *
+     * \param buffer
+     *      Buffer of at least `size` bytes
+     */
+    static inline void
+    read(const uint8_t* buffer, typename Fields::Type&... values)
+    {
+        Access::read(buffer, values...);
+    }
+
+    /**
+     * Read all fields at the current position of the stream and advance it
+     * by `size` bytes.
+     */
+    static inline void
+    read(Deserialize& stream, typename Fields::Type&... values)
+    {
+        Access::read(stream.getPointerToCurrentPosition(), values...);
+        stream.skip(size);
+    }
+};
+
+template <size_t bitOffset, typename Field, typename... Remaining>
+constexpr size_t internal::PacketLayoutField<0, bitOffset, Field, Remaining...>::offset;
+
+template <size_t bitOffset>
+constexpr size_t internal::PacketLayoutAccess<bitOffset>::numberOfBits;
+
+template <size_t bitOffset, typename Field, typename... Remaining>
+constexpr size_t internal::PacketLayoutAccess<bitOffset, Field, Remaining...>::numberOfBits;
+
+template <typename... Fields>
+constexpr size_t PacketLayout<Fields...>::numberOfBits;
+
+template <typename... Fields>
+constexpr size_t PacketLayout<Fields...>::size;
+
+template <typename... Fields>
+template <size_t index>
+constexpr size_t PacketLayout<Fields...>::Field<index>::bitOffset;
+
+}  // namespace outpost
+
+#endif
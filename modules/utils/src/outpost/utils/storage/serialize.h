@@ -16,6 +16,7 @@
 #ifndef OUTPOST_UTILS_SERIALIZE_H
 #define OUTPOST_UTILS_SERIALIZE_H
 
+#include "serialize_array.h"
 #include "serialize_storage_traits.h"
 #include "serialize_traits.h"
 
@@ -157,24 +158,27 @@ public:
         mBuffer += N;
     }
 
+    /**
+     * Store an array of values.
+     *
+     * Arrays of the fixed size integer and floating point types are copied
+     * in bulk, other types are stored element by element through their
+     * `SerializeBigEndianTraits`.
+     */
     template <typename U>
     inline void
     store(outpost::Slice<const U> array)
     {
-        for (size_t i = 0; i < array.getNumberOfElements(); ++i)
-        {
-            store<U>(array[i]);
-        }
+        internal::SerializeArray<U>::storeBigEndian(
+                mBuffer, &array[0], array.getNumberOfElements());
     }
 
     template <typename U>
     inline void
     store(outpost::Slice<U> array)
     {
-        for (size_t i = 0; i < array.getNumberOfElements(); ++i)
-        {
-            store<U>(array[i]);
-        }
+        internal::SerializeArray<U>::storeBigEndian(
+                mBuffer, &array[0], array.getNumberOfElements());
     }
 
     /**
@@ -306,14 +310,17 @@ public:
         mBuffer += length;
     }
 
+    /**
+     * Read an array of values.
+     *
+     * \see Serialize::store(outpost::Slice<const U>)
+     */
     template <typename U>
     inline void
     read(outpost::Slice<U> array)
     {
-        for (size_t i = 0; i < array.getNumberOfElements(); ++i)
-        {
-            array[i] = SerializeBigEndianTraits<U>::read(mBuffer);
-        }
+        internal::SerializeArray<U>::readBigEndian(
+                mBuffer, &array[0], array.getNumberOfElements());
     }
 
     inline uint32_t
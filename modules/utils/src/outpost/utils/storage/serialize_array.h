@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_SERIALIZE_ARRAY_H
+#define OUTPOST_UTILS_SERIALIZE_ARRAY_H
+
+#include "serialize_little_endian_traits.h"
+#include "serialize_traits.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace outpost
+{
+namespace internal
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+constexpr bool hostIsBigEndian = true;
+#else
+constexpr bool hostIsBigEndian = false;
+#endif
+
+inline uint16_t
+byteSwap(uint16_t value)
+{
+    return __builtin_bswap16(value);
+}
+
+inline uint32_t
+byteSwap(uint32_t value)
+{
+    return __builtin_bswap32(value);
+}
+
+inline uint64_t
+byteSwap(uint64_t value)
+{
+    return __builtin_bswap64(value);
+}
+
+/**
+ * Element wise serialization of arrays through the serialize traits.
+ *
+ * Used for all types which have no bulk specialization below, e.g. types
+ * with user supplied traits.
+ */
+template <typename T>
+struct SerializeArray
+{
+    static inline void
+    storeBigEndian(uint8_t*& buffer, const T* values, size_t numberOfElements)
+    {
+        for (size_t i = 0; i < numberOfElements; ++i)
+        {
+            SerializeBigEndianTraits<T>::store(buffer, values[i]);
+        }
+    }
+
+    static inline void
+    readBigEndian(const uint8_t*& buffer, T* values, size_t numberOfElements)
+    {
+        for (size_t i = 0; i < numberOfElements; ++i)
+        {
+            values[i] = SerializeBigEndianTraits<T>::read(buffer);
+        }
+    }
+
+    static inline void
+    storeLittleEndian(uint8_t*& buffer, const T* values, size_t numberOfElements)
+    {
+        for (size_t i = 0; i < numberOfElements; ++i)
+        {
+            SerializeLittleEndianTraits<T>::store(buffer, values[i]);
+        }
+    }
+
+    static inline void
+    readLittleEndian(const uint8_t*& buffer, T* values, size_t numberOfElements)
+    {
+        for (size_t i = 0; i < numberOfElements; ++i)
+        {
+            values[i] = SerializeLittleEndianTraits<T>::read(buffer);
+        }
+    }
+};
+
+/**
+ * Bulk serialization of arrays of fixed size integer and floating point types.
+ *
+ * The serialized representation is the in-memory representation of the
+ * values, possibly with reversed byte order. If the byte order of the host
+ * matches the requested byte order the array is copied with a single
+ * `memcpy`, otherwise the words are swapped in blocks which the compiler
+ * is able to vectorize.
+ *
+ * \tparam T
+ *      Element type
+ * \tparam Word
+ *      Unsigned integer type with the size of T
+ */
+template <typename T, typename Word>
+struct SerializeArrayBulk
+{
+    static_assert(sizeof(T) == sizeof(Word), "Word type must match the element size");
+
+    static inline void
+    storeBigEndian(uint8_t*& buffer, const T* values, size_t numberOfElements)
+    {
+        copy(buffer, reinterpret_cast<const uint8_t*>(values), numberOfElements, !hostIsBigEndian);
+        buffer += numberOfElements * sizeof(T);
+    }
+
+    static inline void
+    readBigEndian(const uint8_t*& buffer, T* values, size_t numberOfElements)
+    {
+        copy(reinterpret_cast<uint8_t*>(values), buffer, numberOfElements, !hostIsBigEndian);
+        buffer += numberOfElements * sizeof(T);
+    }
+
+    static inline void
+    storeLittleEndian(uint8_t*& buffer, const T* values, size_t numberOfElements)
+    {
+        copy(buffer, reinterpret_cast<const uint8_t*>(values), numberOfElements, hostIsBigEndian);
+        buffer += numberOfElements * sizeof(T);
+    }
+
+    static inline void
+    readLittleEndian(const uint8_t*& buffer, T* values, size_t numberOfElements)
+    {
+        copy(reinterpret_cast<uint8_t*>(values), buffer, numberOfElements, hostIsBigEndian);
+        buffer += numberOfElements * sizeof(T);
+    }
+
+private:
+    static constexpr size_t blockSize = 16;
+
+    static inline void
+    copy(uint8_t* destination, const uint8_t* source, size_t numberOfElements, bool swap)
+    {
+        if (!swap)
+        {
+            memcpy(destination, source, numberOfElements * sizeof(Word));
+            return;
+        }
+
+        // The block is copied through a local buffer to avoid unaligned
+        // accesses and aliasing between the source and the destination.
+        Word block[blockSize];
+        size_t i = 0;
+        for (; i + blockSize <= numberOfElements; i += blockSize)
+        {
+            memcpy(block, &source[i * sizeof(Word)], sizeof(block));
+            for (size_t k = 0; k < blockSize; ++k)
+            {
+                block[k] = byteSwap(block[k]);
+            }
+            memcpy(&destination[i * sizeof(Word)], block, sizeof(block));
+        }
+
+        const size_t remaining = numberOfElements - i;
+        memcpy(block, &source[i * sizeof(Word)], remaining * sizeof(Word));
+        for (size_t k = 0; k < remaining; ++k)
+        {
+            block[k] = byteSwap(block[k]);
+        }
+        memcpy(&destination[i * sizeof(Word)], block, remaining * sizeof(Word));
+    }
+};
+
+template <typename T, typename Word>
+constexpr size_t SerializeArrayBulk<T, Word>::blockSize;
+
+// The element wise path is retained for targets without the predefined byte
+// order macros of GCC and clang.
+#if defined(__BYTE_ORDER__)
+template <>
+struct SerializeArray<uint16_t> : public SerializeArrayBulk<uint16_t, uint16_t>
+{
+};
+
+template <>
+struct SerializeArray<uint32_t> : public SerializeArrayBulk<uint32_t, uint32_t>
+{
+};
+
+template <>
+struct SerializeArray<uint64_t> : public SerializeArrayBulk<uint64_t, uint64_t>
+{
+};
+
+template <>
+struct SerializeArray<int16_t> : public SerializeArrayBulk<int16_t, uint16_t>
+{
+};
+
+template <>
+struct SerializeArray<int32_t> : public SerializeArrayBulk<int32_t, uint32_t>
+{
+};
+
+template <>
+struct SerializeArray<int64_t> : public SerializeArrayBulk<int64_t, uint64_t>
+{
+};
+
+template <>
+struct SerializeArray<float> : public SerializeArrayBulk<float, uint32_t>
+{
+};
+
+template <>
+struct SerializeArray<double> : public SerializeArrayBulk<double, uint64_t>
+{
+};
+#endif
+
+}  // namespace internal
+}  // namespace outpost
+
+#endif
@@ -16,6 +16,7 @@
 #ifndef OUTPOST_UTILS_SERIALIZE_LITTLE_ENDIAN_H
 #define OUTPOST_UTILS_SERIALIZE_LITTLE_ENDIAN_H
 
+#include "serialize_array.h"
 #include "serialize_little_endian_traits.h"
 
 #include <outpost/base/slice.h>
@@ -79,6 +80,29 @@ public:
         mBuffer += length;
     }
 
+    /**
+     * Store an array of values.
+     *
+     * Arrays of the fixed size integer and floating point types are copied
+     * in bulk, other types are stored element by element through their
+     * `SerializeLittleEndianTraits`.
+     */
+    template <typename U>
+    inline void
+    store(outpost::Slice<const U> array)
+    {
+        internal::SerializeArray<U>::storeLittleEndian(
+                mBuffer, &array[0], array.getNumberOfElements());
+    }
+
+    template <typename U>
+    inline void
+    store(outpost::Slice<U> array)
+    {
+        internal::SerializeArray<U>::storeLittleEndian(
+                mBuffer, &array[0], array.getNumberOfElements());
+    }
+
     // explicit template instantiations are provided in serialize_impl.h
     template <typename T>
     inline void
@@ -239,14 +263,17 @@ public:
         return SerializeLittleEndianTraits<T>::read(mBuffer);
     }
 
+    /**
+     * Read an array of values.
+     *
+     * \see SerializeLittleEndian::store(outpost::Slice<const U>)
+     */
     template <typename U>
     inline void
     read(outpost::Slice<U> array)
     {
-        for (size_t i = 0; i < array.getNumberOfElements(); ++i)
-        {
-            array[i] = SerializeLittleEndianTraits<U>::read(mBuffer);
-        }
+        internal::SerializeArray<U>::readLittleEndian(
+                mBuffer, &array[0], array.getNumberOfElements());
     }
 
     /**
@@ -12,6 +12,12 @@
  */
 
 #include "bit_access.h"
+#include "bit_packing.h"
+#include "bit_reader.h"
+#include "bit_writer.h"
 #include "bitfield.h"
 #include "bitorder.h"
+#include "checked_serialize.h"
+#include "packet_layout.h"
 #include "serialize.h"
+#include "varint.h"
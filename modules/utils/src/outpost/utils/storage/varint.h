@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_VARINT_H
+#define OUTPOST_UTILS_VARINT_H
+
+#include <outpost/base/slice.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <type_traits>
+
+namespace outpost
+{
+/**
+ * Variable length encoding of integers (unsigned LEB128).
+ *
+ * Every byte carries seven bits of the value, least significant group
+ * first. The most significant bit of a byte is set if another byte
+ * follows. Values below 128 need a single byte, a `uint32_t` at most
+ * five and a `uint64_t` at most ten bytes.
+ *
+ * Signed types are zigzag encoded first (0, -1, 1, -2, ... are mapped to
+ * 0, 1, 2, 3, ...), so that values of small magnitude stay short
+ * independent of their sign.
+ *
+ * \code
+ * size_t length = outpost::VarInt::encode(outpost::asSliceUnsafe(counters, 16),
+ *                                         outpost::asSlice(buffer));
+ * if (length == 0)
+ * {
+ *     ... // buffer too small
+ * }
+ * \endcode
+ */
+class VarInt
+{
+public:
+    /// Maximum number of bytes needed for a value of type \p T
+    template <typename T>
+    static constexpr size_t
+    getMaximumSize()
+    {
+        return (sizeof(T) * 8 + 6) / 7;
+    }
+
+    /// Number of bytes needed for the given value
+    template <typename T>
+    static size_t
+    getSize(T value);
+
+    /**
+     * Map a signed value to an unsigned one with small magnitudes
+     * mapped to small values.
+     */
+    template <typename T>
+    static constexpr typename std::make_unsigned<T>::type
+    zigzagEncode(T value)
+    {
+        typedef typename std::make_unsigned<T>::type U;
+        return (value < 0) ? static_cast<U>(~(static_cast<U>(value) << 1))
+                           : static_cast<U>(static_cast<U>(value) << 1);
+    }
+
+    /// Inverse of zigzagEncode()
+    template <typename U>
+    static constexpr typename std::make_signed<U>::type
+    zigzagDecode(U value)
+    {
+        typedef typename std::make_signed<U>::type S;
+        return static_cast<S>(static_cast<U>(value >> 1) ^ static_cast<U>(0 - (value & 1)));
+    }
+
+    /**
+     * Encode a single value.
+     *
+     * \return
+     *     Number of bytes written or zero if the output buffer is
+     *     too small. Nothing is written in that case.
+     */
+    template <typename T>
+    static size_t
+    encode(T value, outpost::Slice<uint8_t> output);
+
+    /**
+     * Decode a single value.
+     *
+     * \return
+     *     Number of bytes consumed or zero if the input is truncated or
+     *     the encoded value does not fit into \p T.
+     */
+    template <typename T>
+    static size_t
+    decode(outpost::Slice<const uint8_t> input, T& value);
+
+    /**
+     * Encode an array of values back to back.
+     *
+     * The capacity is checked once for the whole array if the output
+     * buffer can hold the worst case, otherwise per value.
+     *
+     * \return
+     *     Number of bytes written or zero if the output buffer is too
+     *     small. The content of the output buffer is undefined in that case.
+     */
+    template <typename T>
+    static size_t
+    encode(outpost::Slice<T> values, outpost::Slice<uint8_t> output);
+
+    /**
+     * Decode as many values as fit into \p values.
+     *
+     * \return
+     *     Number of bytes consumed or zero if the input ends before all
+     *     values are decoded or contains an invalid value.
+     */
+    template <typename T>
+    static size_t
+    decode(outpost::Slice<const uint8_t> input, outpost::Slice<T> values);
+
+private:
+    friend class DeltaOfDelta;
+
+    template <typename U>
+    static inline size_t
+    encodeUnchecked(U value, uint8_t* output);
+
+    template <typename U>
+    static inline size_t
+    decodeUnsigned(const uint8_t* input, size_t available, U& value);
+
+    template <typename T>
+    static constexpr typename std::make_unsigned<T>::type
+    toUnsigned(T value, std::true_type /* signed */)
+    {
+        return zigzagEncode(value);
+    }
+
+    template <typename T>
+    static constexpr T
+    toUnsigned(T value, std::false_type /* signed */)
+    {
+        return value;
+    }
+
+    template <typename T>
+    static constexpr typename std::make_unsigned<T>::type
+    toUnsigned(T value)
+    {
+        return toUnsigned(value, std::is_signed<T>());
+    }
+
+    template <typename T>
+    static constexpr T
+    fromUnsigned(typename std::make_unsigned<T>::type value, std::true_type /* signed */)
+    {
+        return zigzagDecode(value);
+    }
+
+    template <typename T>
+    static constexpr T
+    fromUnsigned(T value, std::false_type /* signed */)
+    {
+        return value;
+    }
+
+    template <typename T>
+    static constexpr T
+    fromUnsigned(typename std::make_unsigned<T>::type value)
+    {
+        return fromUnsigned<T>(value, std::is_signed<T>());
+    }
+};
+
+/**
+ * Delta-of-delta encoding of slowly changing values.
+ *
+ * Stores the first value, the difference between the first two values
+ * and afterwards only the change of the difference, all as zigzag
+ * encoded VarInt. Timestamps with a constant period and linearly rising
+ * counters therefore shrink to one byte per value.
+ *
+ * Differences are calculated with wrap-around, so that every sequence of
+ * the given type can be restored exactly.
+ */
+class DeltaOfDelta
+{
+public:
+    /// Maximum number of bytes needed for the given number of values
+    template <typename T>
+    static constexpr size_t
+    getMaximumSize(size_t numberOfValues)
+    {
+        return numberOfValues * VarInt::getMaximumSize<T>();
+    }
+
+    /**
+     * \return
+     *     Number of bytes written or zero if the output buffer is
+     *     too small.
+     */
+    template <typename T>
+    static size_t
+    encode(outpost::Slice<T> values, outpost::Slice<uint8_t> output);
+
+    /**
+     * Decode as many values as fit into \p values.
+     *
+     * \return
+     *     Number of bytes consumed or zero if the input ends before all
+     *     values are decoded or contains an invalid value.
+     */
+    template <typename T>
+    static size_t
+    decode(outpost::Slice<const uint8_t> input, outpost::Slice<T> values);
+};
+
+}  // namespace outpost
+
+#include "varint_impl.h"
+
+#endif
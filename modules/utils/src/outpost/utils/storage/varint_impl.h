@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_VARINT_IMPL_H
+#define OUTPOST_UTILS_VARINT_IMPL_H
+
+#include "varint.h"
+
+namespace outpost
+{
+// ----------------------------------------------------------------------------
+template <typename U>
+inline size_t
+VarInt::encodeUnchecked(U value, uint8_t* output)
+{
+    uint8_t* it = output;
+    while (value >= 0x80)
+    {
+        *it++ = static_cast<uint8_t>(value | 0x80);
+        value = static_cast<U>(value >> 7);
+    }
+    *it++ = static_cast<uint8_t>(value);
+    return it - output;
+}
+
+template <typename U>
+inline size_t
+VarInt::decodeUnsigned(const uint8_t* input, size_t available, U& value)
+{
+    const size_t maximumSize = getMaximumSize<U>();
+    const size_t limit = (available < maximumSize) ? available : maximumSize;
+
+    U result = 0;
+    for (size_t i = 0; i < limit; ++i)
+    {
+        const uint8_t byte = input[i];
+        const size_t shift = 7 * i;
+        result = static_cast<U>(result | (static_cast<U>(byte & 0x7F) << shift));
+        if ((byte & 0x80) == 0)
+        {
+            // The last possible byte may only carry the remaining bits
+            if ((i == maximumSize - 1) && ((byte >> (sizeof(U) * 8 - shift)) != 0))
+            {
+                return 0;
+            }
+            value = result;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+template <typename T>
+size_t
+VarInt::getSize(T value)
+{
+    typename std::make_unsigned<T>::type u = toUnsigned(value);
+    size_t size = 1;
+    while (u >= 0x80)
+    {
+        u >>= 7;
+        size++;
+    }
+    return size;
+}
+
+template <typename T>
+size_t
+VarInt::encode(T value, outpost::Slice<uint8_t> output)
+{
+    static_assert(std::is_integral<T>::value, "Only integer types can be encoded");
+
+    const size_t available = output.getNumberOfElements();
+    if ((available < getMaximumSize<T>()) && (available < getSize(value)))
+    {
+        return 0;
+    }
+    return encodeUnchecked(toUnsigned(value), &output[0]);
+}
+
+template <typename T>
+size_t
+VarInt::decode(outpost::Slice<const uint8_t> input, T& value)
+{
+    static_assert(std::is_integral<T>::value, "Only integer types can be decoded");
+
+    typename std::make_unsigned<T>::type u;
+    const size_t length = decodeUnsigned(&input[0], input.getNumberOfElements(), u);
+    if (length != 0)
+    {
+        value = fromUnsigned<T>(u);
+    }
+    return length;
+}
+
+template <typename T>
+size_t
+VarInt::encode(outpost::Slice<T> values, outpost::Slice<uint8_t> output)
+{
+    typedef typename std::remove_const<T>::type Value;
+    static_assert(std::is_integral<Value>::value, "Only integer types can be encoded");
+
+    const size_t numberOfValues = values.getNumberOfElements();
+    const size_t available = output.getNumberOfElements();
+    uint8_t* it = &output[0];
+    if (available / getMaximumSize<Value>() >= numberOfValues)
+    {
+        for (size_t i = 0; i < numberOfValues; ++i)
+        {
+            it += encodeUnchecked(toUnsigned<Value>(values[i]), it);
+        }
+        return it - &output[0];
+    }
+
+    size_t length = 0;
+    for (size_t i = 0; i < numberOfValues; ++i)
+    {
+        const size_t size = encode<Value>(values[i], output.skipFirst(length));
+        if (size == 0)
+        {
+            return 0;
+        }
+        length += size;
+    }
+    return length;
+}
+
+template <typename T>
+size_t
+VarInt::decode(outpost::Slice<const uint8_t> input, outpost::Slice<T> values)
+{
+    static_assert(std::is_integral<T>::value, "Only integer types can be decoded");
+
+    const uint8_t* it = &input[0];
+    const uint8_t* end = it + input.getNumberOfElements();
+    for (size_t i = 0; i < values.getNumberOfElements(); ++i)
+    {
+        typename std::make_unsigned<T>::type u;
+        if ((it < end) && (*it < 0x80))
+        {
+            // Fast path for the common case of a single byte
+            u = *it++;
+        }
+        else
+        {
+            const size_t length = decodeUnsigned(it, end - it, u);
+            if (length == 0)
+            {
+                return 0;
+            }
+            it += length;
+        }
+        values[i] = fromUnsigned<T>(u);
+    }
+    return it - &input[0];
+}
+
+// ----------------------------------------------------------------------------
+template <typename T>
+size_t
+DeltaOfDelta::encode(outpost::Slice<T> values, outpost::Slice<uint8_t> output)
+{
+    typedef typename std::remove_const<T>::type Value;
+    typedef typename std::make_unsigned<Value>::type U;
+    typedef typename std::make_signed<Value>::type S;
+
+    const size_t numberOfValues = values.getNumberOfElements();
+    const bool checked = (output.getNumberOfElements() < getMaximumSize<Value>(numberOfValues));
+    uint8_t* it = &output[0];
+    uint8_t* end = it + output.getNumberOfElements();
+
+    U previous = 0;
+    U previousDelta = 0;
+    for (size_t i = 0; i < numberOfValues; ++i)
+    {
+        const U current = static_cast<U>(values[i]);
+        const U delta = static_cast<U>(current - previous);
+        const U deltaOfDelta = static_cast<U>(delta - previousDelta);
+        // The first value is stored as difference to zero and the
+        // second as difference to the first
+        const U encoded = VarInt::zigzagEncode(static_cast<S>((i < 2) ? delta : deltaOfDelta));
+
+        if (checked)
+        {
+            const size_t length =
+                    VarInt::encode(encoded, outpost::Slice<uint8_t>::unsafe(it, end - it));
+            if (length == 0)
+            {
+                return 0;
+            }
+            it += length;
+        }
+        else
+        {
+            it += VarInt::encodeUnchecked(encoded, it);
+        }
+
+        previousDelta = (i == 0) ? 0 : delta;
+        previous = current;
+    }
+    return it - &output[0];
+}
+
+template <typename T>
+size_t
+DeltaOfDelta::decode(outpost::Slice<const uint8_t> input, outpost::Slice<T> values)
+{
+    typedef typename std::make_unsigned<T>::type U;
+    typedef typename std::make_signed<T>::type S;
+
+    const uint8_t* it = &input[0];
+    const uint8_t* end = it + input.getNumberOfElements();
+
+    U previous = 0;
+    U previousDelta = 0;
+    for (size_t i = 0; i < values.getNumberOfElements(); ++i)
+    {
+        S difference;
+        const size_t length =
+                VarInt::decode(outpost::Slice<const uint8_t>::unsafe(it, end - it), difference);
+        if (length == 0)
+        {
+            return 0;
+        }
+        it += length;
+
+        const U delta = (i < 2) ? static_cast<U>(difference)
+                                : static_cast<U>(previousDelta + static_cast<U>(difference));
+        const U current = static_cast<U>(previous + delta);
+        values[i] = static_cast<T>(current);
+
+        previousDelta = (i == 0) ? 0 : delta;
+        previous = current;
+    }
+    return it - &input[0];
+}
+
+}  // namespace outpost
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_TRACE_H
+#define OUTPOST_UTILS_TRACE_H
+
+#include "trace_buffer.h"
+
+#include <outpost/rtos/atomic.h>
+
+#include <stdint.h>
+
+/**
+ * \def OUTPOST_TRACE(id, argument0, argument1)
+ *
+ * Record an event in the buffer set with outpost::utils::Trace::setBuffer().
+ *
+ * \def OUTPOST_TRACE_TO(buffer, id, argument0, argument1)
+ *
+ * Record an event in the given TraceBufferBase, e.g. a buffer owned by the
+ * calling thread.
+ *
+ * Both macros expand to nothing unless OUTPOST_TRACING is defined, the
+ * arguments are not evaluated in this case.
+ */
+#ifdef OUTPOST_TRACING
+#define OUTPOST_TRACE(id, argument0, argument1) \
+    ::outpost::utils::Trace::record((id), (argument0), (argument1))
+#define OUTPOST_TRACE_TO(buffer, id, argument0, argument1) \
+    (buffer).record((id), (argument0), (argument1))
+#else
+#define OUTPOST_TRACE(id, argument0, argument1) ((void) 0)
+#define OUTPOST_TRACE_TO(buffer, id, argument0, argument1) ((void) 0)
+#endif
+
+namespace outpost
+{
+namespace utils
+{
+/**
+ * Identifiers of the events recorded by the library.
+ *
+ * Events ending with `Begin` and `End` enclose a section and are displayed
+ * as duration by `tools/trace_to_chrome.py`, all other events as instant.
+ */
+namespace trace
+{
+/// ProtocolDispatcherThread received packages: length of the first one, number of packages
+static constexpr uint32_t packetReceived = 1;
+
+/// ProtocolDispatcher inserted a package into a listener queue: length
+static constexpr uint32_t packetQueued = 2;
+
+/// RmapInitiator sent a command: transaction id, target logical address
+static constexpr uint32_t rmapCommandSent = 3;
+
+/// RmapInitiator received a reply: transaction id, status
+static constexpr uint32_t rmapReplyReceived = 4;
+
+/// Topic publish, arguments: lower 32 bits of the topic address
+static constexpr uint32_t publishBegin = 5;
+static constexpr uint32_t publishEnd = 6;
+
+/// DataProcessorThread compresses a block: parameter id, block size
+static constexpr uint32_t compressionBegin = 7;
+
+/// DataProcessorThread finished a block: parameter id, 1 on success
+static constexpr uint32_t compressionEnd = 8;
+
+/// Identifiers from here on are free for the application
+static constexpr uint32_t firstUserEvent = 0x1000;
+}  // namespace trace
+
+/**
+ * Global trace buffer used by the OUTPOST_TRACE() macro.
+ *
+ * Events are dropped until a buffer is set:
+ *
+ * \code
+ * outpost::utils::TraceBuffer<4096> traceBuffer;
+ *
+ * outpost::utils::Trace::setBuffer(&traceBuffer);
+ * ...
+ * outpost::utils::Trace::setBuffer(nullptr);
+ * size_t length = traceBuffer.serialize(dump);
+ * \endcode
+ *
+ * \see outpost::utils::TraceBufferBase
+ */
+class Trace
+{
+public:
+    /**
+     * Set the buffer for all further events, nullptr to stop tracing.
+     */
+    static inline void
+    setBuffer(TraceBufferBase* traceBuffer)
+    {
+        buffer.store(traceBuffer);
+    }
+
+    static inline TraceBufferBase*
+    getBuffer()
+    {
+        return buffer.load();
+    }
+
+    static inline void
+    record(uint32_t id, uint32_t argument0, uint32_t argument1)
+    {
+        TraceBufferBase* traceBuffer = buffer.load();
+        if (traceBuffer != nullptr)
+        {
+            traceBuffer->record(id, argument0, argument1);
+        }
+    }
+
+private:
+    static outpost::rtos::Atomic<TraceBufferBase*> buffer;
+};
+
+}  // namespace utils
+}  // namespace outpost
+
+#endif
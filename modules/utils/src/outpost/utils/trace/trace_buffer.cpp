@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "trace_buffer.h"
+
+#include <outpost/utils/minmax.h>
+#include <outpost/utils/storage/serialize.h>
+
+using outpost::utils::TraceBufferBase;
+
+constexpr size_t TraceBufferBase::headerSize;
+constexpr size_t TraceBufferBase::serializedRecordSize;
+constexpr uint32_t TraceBufferBase::magic;
+
+TraceBufferBase::TraceBufferBase(outpost::Slice<Entry> entries) :
+    mEntries(entries), mMask(entries.getNumberOfElements() - 1), mWriteIndex(0)
+{
+    clear();
+}
+
+void
+TraceBufferBase::clear()
+{
+    mWriteIndex.store(0);
+    for (size_t i = 0; i < mEntries.getNumberOfElements(); ++i)
+    {
+        mEntries[i].mSequence.store(0);
+    }
+}
+
+size_t
+TraceBufferBase::read(outpost::Slice<TraceRecord> records) const
+{
+    const uint32_t end = mWriteIndex.load();
+    size_t count = 0;
+    for (uint32_t index = getFirstIndex(end, records.getNumberOfElements()); index != end;
+         ++index)
+    {
+        if (readEntry(index, records[count]))
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+size_t
+TraceBufferBase::serialize(outpost::Slice<uint8_t> buffer) const
+{
+    if (buffer.getNumberOfElements() < headerSize)
+    {
+        return 0;
+    }
+
+    const size_t maximumNumberOfEvents =
+            (buffer.getNumberOfElements() - headerSize) / serializedRecordSize;
+    const uint32_t end = mWriteIndex.load();
+
+    outpost::Serialize payload(buffer.skipFirst(headerSize));
+    uint32_t count = 0;
+    for (uint32_t index = getFirstIndex(end, maximumNumberOfEvents); index != end; ++index)
+    {
+        TraceRecord record;
+        if (readEntry(index, record))
+        {
+            payload.store<uint64_t>(record.mTimestamp);
+            payload.store<uint32_t>(record.mId);
+            payload.store<uint32_t>(record.mArgument0);
+            payload.store<uint32_t>(record.mArgument1);
+            count++;
+        }
+    }
+
+    outpost::Serialize header(buffer);
+    header.store<uint32_t>(magic);
+    header.store<uint32_t>(count);
+    header.store<uint64_t>(outpost::rtos::CycleClock::getFrequency());
+
+    return headerSize + count * serializedRecordSize;
+}
+
+bool
+TraceBufferBase::readEntry(uint32_t index, TraceRecord& record) const
+{
+    const Entry& entry = mEntries[index & mMask];
+    if (entry.mSequence.load() != index + 1)
+    {
+        return false;
+    }
+
+    record = entry.mRecord;
+
+    // Discard the copy if the entry has been overwritten in the meantime
+    return (entry.mSequence.load() == index + 1);
+}
+
+uint32_t
+TraceBufferBase::getFirstIndex(uint32_t end, size_t maximumNumberOfEvents) const
+{
+    const uint32_t count = outpost::utils::min<size_t>(
+            end, mEntries.getNumberOfElements(), maximumNumberOfEvents);
+    return end - count;
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef OUTPOST_UTILS_TRACE_BUFFER_H
+#define OUTPOST_UTILS_TRACE_BUFFER_H
+
+#include <outpost/base/slice.h>
+#include <outpost/rtos/atomic.h>
+#include <outpost/rtos/cycle_clock.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace outpost
+{
+namespace utils
+{
+/**
+ * Single event stored in a TraceBuffer.
+ */
+struct TraceRecord
+{
+    /// Value of outpost::rtos::CycleClock::now() when the event was recorded
+    outpost::rtos::CycleClock::Ticks mTimestamp;
+    uint32_t mId;
+    uint32_t mArgument0;
+    uint32_t mArgument1;
+};
+
+/**
+ * Lock-free ring of trace events.
+ *
+ * Recording an event claims a slot with a single atomic increment, reads
+ * the cycle counter and stores the payload. When the ring is full the
+ * oldest events are overwritten. Events can be recorded from any number of
+ * threads and interrupts at the same time, a buffer per thread avoids the
+ * shared write index altogether.
+ *
+ * The events are read back with read() or serialize(). Both skip events
+ * which are overwritten or still being written during the read, the
+ * events should therefore be read while the tracing is paused.
+ *
+ * \see outpost::utils::Trace
+ */
+class TraceBufferBase
+{
+public:
+    /// Size of the header created by serialize()
+    static constexpr size_t headerSize = 16;
+
+    /// Size of a single serialized event
+    static constexpr size_t serializedRecordSize = 20;
+
+    /// First four bytes of the output of serialize(), "OTRC"
+    static constexpr uint32_t magic = 0x4F545243;
+
+    // disable copy constructor
+    TraceBufferBase(const TraceBufferBase& other) = delete;
+
+    // disable assignment operator
+    TraceBufferBase&
+    operator=(const TraceBufferBase& other) = delete;
+
+    /**
+     * Record an event.
+     *
+     * \param id
+     *      Event identifier, see outpost::utils::trace.
+     */
+    inline void
+    record(uint32_t id, uint32_t argument0, uint32_t argument1)
+    {
+        const uint32_t index = mWriteIndex.fetchAdd(1);
+        Entry& entry = mEntries[index & mMask];
+
+        // Invalidate the slot while it is overwritten
+        entry.mSequence.store(0);
+        entry.mRecord.mTimestamp = outpost::rtos::CycleClock::now();
+        entry.mRecord.mId = id;
+        entry.mRecord.mArgument0 = argument0;
+        entry.mRecord.mArgument1 = argument1;
+        entry.mSequence.store(index + 1);
+    }
+
+    inline size_t
+    getCapacity() const
+    {
+        return mEntries.getNumberOfElements();
+    }
+
+    /**
+     * Number of events recorded since the construction or the last call
+     * of clear(), including the overwritten ones.
+     */
+    inline uint32_t
+    getNumberOfRecordedEvents() const
+    {
+        return mWriteIndex.load();
+    }
+
+    /**
+     * Remove all events.
+     *
+     * \warning Must not be called while events are recorded.
+     */
+    void
+    clear();
+
+    /**
+     * Copy the newest events, oldest first.
+     *
+     * \return  Number of events copied to \p records.
+     */
+    size_t
+    read(outpost::Slice<TraceRecord> records) const;
+
+    /**
+     * Write the newest events in the binary trace format.
+     *
+     * The format is big endian and starts with a header of headerSize
+     * bytes:
+     *
+     *     uint32  magic
+     *     uint32  number of events
+     *     uint64  CycleClock frequency in Hz
+     *
+     * followed by the events, oldest first, serializedRecordSize bytes
+     * each:
+     *
+     *     uint64  timestamp in CycleClock ticks
+     *     uint32  id
+     *     uint32  argument 0
+     *     uint32  argument 1
+     *
+     * `tools/trace_to_chrome.py` converts the output into the Chrome trace
+     * format, which can be displayed by https://ui.perfetto.dev.
+     *
+     * \return  Number of bytes written, zero if \p buffer is smaller than
+     *          the header. Only as many events as fit into \p buffer are
+     *          written.
+     */
+    size_t
+    serialize(outpost::Slice<uint8_t> buffer) const;
+
+protected:
+    struct Entry
+    {
+        /// Index of the event plus one, zero while the entry is written
+        outpost::rtos::Atomic<uint32_t> mSequence;
+        TraceRecord mRecord;
+    };
+
+    /**
+     * \param entries
+     *      Storage for the events, the number of elements must be a power
+     *      of two.
+     */
+    explicit TraceBufferBase(outpost::Slice<Entry> entries);
+
+    ~TraceBufferBase() = default;
+
+private:
+    /// Copy the event with the given index if it is still available
+    bool
+    readEntry(uint32_t index, TraceRecord& record) const;
+
+    /// Index of the oldest event available for reading
+    uint32_t
+    getFirstIndex(uint32_t end, size_t maximumNumberOfEvents) const;
+
+    const outpost::Slice<Entry> mEntries;
+    const uint32_t mMask;
+    outpost::rtos::Atomic<uint32_t> mWriteIndex;
+};
+
+/**
+ * TraceBuffer with storage for \p numberOfEvents events.
+ *
+ * \tparam numberOfEvents
+ *      Capacity of the buffer, must be a power of two.
+ */
+template <size_t numberOfEvents>
+class TraceBuffer : public TraceBufferBase
+{
+    static_assert((numberOfEvents > 0) && ((numberOfEvents & (numberOfEvents - 1)) == 0),
+                  "The number of events must be a power of two");
+
+public:
+    TraceBuffer() : TraceBufferBase(outpost::asSlice(mStorage))
+    {
+    }
+
+private:
+    Entry mStorage[numberOfEvents];
+};
+
+}  // namespace utils
+}  // namespace outpost
+
+#endif
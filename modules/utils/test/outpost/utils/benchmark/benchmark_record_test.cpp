@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/benchmark/benchmark_record.h>
+
+#include <unittest/harness.h>
+
+#include <string>
+
+using outpost::utils::BenchmarkRecord;
+using outpost::utils::BenchmarkStatistics;
+
+namespace
+{
+std::string lastLine;
+
+void
+captureLine(const char* line)
+{
+    lastLine = line;
+}
+}  // namespace
+
+TEST(BenchmarkRecordTest, shouldStartWithSuiteAndBenchmark)
+{
+    BenchmarkRecord record("utils", "crc32");
+
+    EXPECT_STREQ(R"({"suite":"utils","benchmark":"crc32","status":"ok"})", record.finish(true));
+}
+
+TEST(BenchmarkRecordTest, shouldFormatFields)
+{
+    BenchmarkRecord record("smpc", "Topic");
+    record.addInteger("subscribers", 64)
+            .addString("topic", "raw")
+            .addNumber("publishes_per_second", 1234.5678, 1)
+            .addNumber("ratio", 1.0 / 0.0);
+
+    EXPECT_STREQ(R"({"suite":"smpc","benchmark":"Topic","subscribers":64,"topic":"raw",)"
+                 R"("publishes_per_second":1234.6,"ratio":null,"status":"failed"})",
+                 record.finish(false));
+}
+
+TEST(BenchmarkRecordTest, shouldEscapeStrings)
+{
+    BenchmarkRecord record("a\"b", "c\\d\n");
+
+    EXPECT_STREQ(R"({"suite":"a\"b","benchmark":"c\\d\u000a","status":"ok"})",
+                 record.finish(true));
+}
+
+TEST(BenchmarkRecordTest, shouldAddStatisticsWithPrefix)
+{
+    BenchmarkStatistics statistics = {10, 4, 2.0, 1.0, 2.0, 3.0, 4.25};
+    BenchmarkRecord record("comm", "pipeline");
+    record.addStatistics(statistics, "rmap_");
+
+    EXPECT_STREQ(R"({"suite":"comm","benchmark":"pipeline","rmap_samples":10,)"
+                 R"("rmap_operations_per_sample":4,"rmap_mean_ns":2.0,"rmap_min_ns":1.0,)"
+                 R"("rmap_p50_ns":2.0,"rmap_p99_ns":3.0,"rmap_max_ns":4.2,"status":"ok"})",
+                 record.finish(true));
+}
+
+TEST(BenchmarkRecordTest, shouldIgnoreFieldsAfterFinish)
+{
+    BenchmarkRecord record("rtos", "yield");
+    record.finish(true);
+    record.addInteger("threads", 2);
+
+    EXPECT_STREQ(R"({"suite":"rtos","benchmark":"yield","status":"ok"})", record.finish(false));
+    EXPECT_FALSE(record.isTruncated());
+}
+
+TEST(BenchmarkRecordTest, shouldDropFieldsWhichDoNotFit)
+{
+    const std::string value(400, 'x');
+    BenchmarkRecord record("rtos", "long");
+    record.addString("first", value.c_str())
+            .addString("second", value.c_str())
+            .addString("third", value.c_str())
+            .addInteger("last", 1);
+
+    EXPECT_TRUE(record.isTruncated());
+    record.write(true, &captureLine);
+
+    const std::string expected = R"({"suite":"rtos","benchmark":"long","first":")" + value
+                                 + R"(","second":")" + value
+                                 + R"(","last":1,"status":"truncated"})";
+    EXPECT_EQ(expected, lastLine);
+    EXPECT_GE(BenchmarkRecord::maximumLength, lastLine.size() + 1);
+}
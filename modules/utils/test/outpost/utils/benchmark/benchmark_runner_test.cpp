@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/benchmark/benchmark_runner.h>
+
+#include <unittest/harness.h>
+
+#include <string>
+
+using outpost::utils::BenchmarkRecord;
+using outpost::utils::BenchmarkRunner;
+
+namespace
+{
+std::string lastLine;
+
+void
+captureLine(const char* line)
+{
+    lastLine = line;
+}
+}  // namespace
+
+class BenchmarkRunnerTest : public testing::Test
+{
+public:
+    BenchmarkRunnerTest() : runner("utils", outpost::asSlice(samples), &captureLine)
+    {
+        lastLine.clear();
+    }
+
+    BenchmarkRunner::Ticks samples[16];
+    BenchmarkRunner runner;
+};
+
+TEST_F(BenchmarkRunnerTest, shouldCallFunctionForWarmupAndSamples)
+{
+    size_t calls = 0;
+    runner.setWarmup(3);
+
+    EXPECT_TRUE(runner.run("count", [&calls] { return ++calls > 0; }, 1, 5));
+    EXPECT_EQ(8U, calls);
+
+    // The number of samples is limited to the storage
+    calls = 0;
+    runner.setWarmup(0);
+    EXPECT_TRUE(runner.run("count", [&calls] { return ++calls > 0; }, 1, 100));
+    EXPECT_EQ(16U, calls);
+}
+
+TEST_F(BenchmarkRunnerTest, shouldWriteRecordWithParameters)
+{
+    BenchmarkRecord record = runner.createRecord("loop");
+    record.addInteger("size", 32);
+
+    EXPECT_TRUE(runner.run(record, [] { return true; }, 4));
+
+    EXPECT_EQ(0U, lastLine.find(R"({"suite":"utils","benchmark":"loop","size":32,"samples":16,)"
+                                R"("operations_per_sample":4,"mean_ns":)"));
+    EXPECT_NE(std::string::npos, lastLine.find(R"(,"status":"ok"})"));
+}
+
+TEST_F(BenchmarkRunnerTest, shouldReportFailedFunctions)
+{
+    size_t calls = 0;
+    runner.setWarmup(0);
+
+    EXPECT_FALSE(runner.run("fail", [&calls] { return ++calls != 2; }));
+    EXPECT_NE(std::string::npos, lastLine.find(R"("status":"failed")"));
+}
+
+TEST_F(BenchmarkRunnerTest, shouldReportSamplesOfTheCaller)
+{
+    outpost::Slice<BenchmarkRunner::Ticks> storage = runner.getSamples();
+    ASSERT_EQ(16U, storage.getNumberOfElements());
+    storage[0] = 0;
+    storage[1] = 0;
+
+    BenchmarkRecord record = runner.createRecord("jitter");
+    EXPECT_TRUE(runner.report(record, 2, 1, true));
+    EXPECT_NE(std::string::npos,
+              lastLine.find(R"("samples":2,"operations_per_sample":1,"mean_ns":0.0,)"));
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/benchmark/benchmark_statistics.h>
+
+#include <unittest/harness.h>
+
+using outpost::utils::BenchmarkStatistics;
+
+TEST(BenchmarkStatisticsTest, shouldBeZeroWithoutSamples)
+{
+    BenchmarkStatistics statistics = BenchmarkStatistics::calculate(
+            outpost::Slice<outpost::rtos::CycleClock::Ticks>::empty(), 4, 1000000000);
+
+    EXPECT_EQ(0U, statistics.mNumberOfSamples);
+    EXPECT_EQ(4U, statistics.mOperationsPerSample);
+    EXPECT_EQ(0.0, statistics.mMean);
+    EXPECT_EQ(0.0, statistics.mMaximum);
+}
+
+TEST(BenchmarkStatisticsTest, shouldCalculateNanosecondsPerOperation)
+{
+    // 100 MHz, 10 ns per tick
+    outpost::rtos::CycleClock::Ticks samples[100];
+    for (size_t i = 0; i < 100; ++i)
+    {
+        // Two operations per sample, 100 down to 1 ticks
+        samples[i] = 100 - i;
+    }
+
+    BenchmarkStatistics statistics =
+            BenchmarkStatistics::calculate(outpost::asSlice(samples), 2, 100000000);
+
+    EXPECT_EQ(100U, statistics.mNumberOfSamples);
+    EXPECT_EQ(2U, statistics.mOperationsPerSample);
+    EXPECT_DOUBLE_EQ(5.0, statistics.mMinimum);
+    EXPECT_DOUBLE_EQ(252.5, statistics.mMean);
+    EXPECT_DOUBLE_EQ(250.0, statistics.mMedian);
+    EXPECT_DOUBLE_EQ(495.0, statistics.mPercentile99);
+    EXPECT_DOUBLE_EQ(500.0, statistics.mMaximum);
+
+    // Sorted in place
+    EXPECT_EQ(1U, samples[0]);
+    EXPECT_EQ(100U, samples[99]);
+}
+
+TEST(BenchmarkStatisticsTest, shouldTreatZeroOperationsAsOne)
+{
+    outpost::rtos::CycleClock::Ticks samples[1] = {3};
+
+    BenchmarkStatistics statistics =
+            BenchmarkStatistics::calculate(outpost::asSlice(samples), 0, 1000000000);
+
+    EXPECT_EQ(1U, statistics.mOperationsPerSample);
+    EXPECT_DOUBLE_EQ(3.0, statistics.mMedian);
+}
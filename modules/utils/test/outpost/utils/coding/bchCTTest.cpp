@@ -1971,6 +1971,121 @@ TEST(BCHCTest, compareKnown)
     }
 }
 
+TEST(BCHCTest, correctsUpToConfiguredNumberOfBitFlips)
+{
+    // Two sectors, only the second one contains errors
+    BCH<dataSize * 2, spareSize * 2> lbch;
+
+    std::array<uint8_t, dataSize * 2> input;
+    std::array<uint8_t, dataSize * 2> output;
+    for (size_t i = 0; i < input.size(); i++)
+    {
+        input[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+
+    std::array<uint8_t, (dataSize + spareSize) * 2> encoded;
+    ASSERT_TRUE(lbch.encode(outpost::asSlice(input), outpost::asSlice(encoded)));
+
+    for (uint32_t errors = 1; errors <= NandBCHInterface::DEF_ERROR_CORRECTION; errors++)
+    {
+        std::array<uint8_t, (dataSize + spareSize) * 2> corrupted = encoded;
+        for (uint32_t k = 0; k < errors; k++)
+        {
+            // Spread over the data of the second sector, the last flip hits its checksum
+            uint32_t position = (k + 1 == errors && errors > 1)
+                                        ? dataSize * 2 + lbch.getNumberOfRedundantBytes() / 2 + 1
+                                        : dataSize + (k * 67 + errors * 13) % dataSize;
+            corrupted[position] ^= static_cast<uint8_t>(1 << ((k * 3) % 8));
+        }
+
+        output.fill(0);
+        EXPECT_EQ(DecodeStatus::corrected,
+                  lbch.decode(outpost::asSlice(corrupted), outpost::asSlice(output)))
+                << errors << " errors";
+        EXPECT_EQ(input, output) << errors << " errors";
+    }
+}
+
+TEST(BCHCTest, decodeSectorsOfPageWithSeveralInstances)
+{
+    constexpr uint32_t sectors = 4;
+    BCH<dataSize * sectors, spareSize * sectors> first;
+    BCH<dataSize * sectors, spareSize * sectors> second;
+    ASSERT_EQ(sectors, first.getNumberOfSectors());
+
+    std::array<uint8_t, dataSize * sectors> input;
+    for (size_t i = 0; i < input.size(); i++)
+    {
+        input[i] = static_cast<uint8_t>(i * 13 + 5);
+    }
+
+    std::array<uint8_t, (dataSize + spareSize) * sectors> encoded;
+    ASSERT_TRUE(first.encode(outpost::asSlice(input), outpost::asSlice(encoded)));
+    encoded[dataSize + 3] ^= 0x10;
+    encoded[dataSize * 3 + 100] ^= 0x01;
+
+    // Each instance decodes half of the page into the common destination
+    std::array<uint8_t, dataSize * sectors> output;
+    output.fill(0);
+    EXPECT_EQ(DecodeStatus::corrected,
+              first.decodeSectors(outpost::asSlice(encoded), outpost::asSlice(output), 0, 2));
+    EXPECT_EQ(0, output[dataSize * 2]);
+    EXPECT_EQ(DecodeStatus::corrected,
+              second.decodeSectors(outpost::asSlice(encoded), outpost::asSlice(output), 2, 2));
+    EXPECT_EQ(input, output);
+
+    EXPECT_EQ(DecodeStatus::noError,
+              first.decodeSectors(outpost::asSlice(encoded), outpost::asSlice(output), 2, 0));
+    EXPECT_EQ(DecodeStatus::invalidParameters,
+              first.decodeSectors(outpost::asSlice(encoded), outpost::asSlice(output), 3, 2));
+    EXPECT_EQ(DecodeStatus::invalidParameters,
+              first.decodeSectors(outpost::asSlice(encoded), outpost::asSlice(output), 5, 0));
+}
+
+TEST(BCHCTest, encodeAndDecodeSeveralPages)
+{
+    constexpr uint32_t pages = 3;
+    BCH<dataSize * 2, spareSize * 2> lbch;
+
+    // Data for the last page is incomplete and filled up
+    std::array<uint8_t, dataSize * 2 * pages - 100> input;
+    for (size_t i = 0; i < input.size(); i++)
+    {
+        input[i] = static_cast<uint8_t>(i * 29 + 1);
+    }
+
+    std::array<uint8_t, (dataSize + spareSize) * 2 * pages> encoded;
+    encoded.fill(0xFF);
+    EXPECT_FALSE(lbch.encodePages(
+            outpost::asSlice(input), outpost::asSlice(encoded).skipLast(1), pages));
+    ASSERT_TRUE(lbch.encodePages(outpost::asSlice(input), outpost::asSlice(encoded), pages));
+
+    // Pages are identical to the ones encoded individually
+    std::array<uint8_t, (dataSize + spareSize) * 2> page;
+    page.fill(0xFF);
+    ASSERT_TRUE(lbch.encode(outpost::asSlice(input).skipFirst(dataSize * 2),
+                            outpost::asSlice(page)));
+    for (size_t i = 0; i < page.size(); i++)
+    {
+        ASSERT_EQ(page[i], encoded[page.size() + i]) << i;
+    }
+
+    std::array<uint8_t, dataSize * 2 * pages> output;
+    output.fill(0);
+    EXPECT_EQ(DecodeStatus::noError,
+              lbch.decodePages(outpost::asSlice(encoded), outpost::asSlice(output), pages));
+    for (size_t i = 0; i < output.size(); i++)
+    {
+        ASSERT_EQ((i < input.size()) ? input[i] : NandBCHInterface::fillValue, output[i]) << i;
+    }
+
+    encoded[page.size() * 2 + 7] ^= 0x04;
+    EXPECT_EQ(DecodeStatus::corrected,
+              lbch.decodePages(outpost::asSlice(encoded), outpost::asSlice(output), pages));
+    EXPECT_EQ(DecodeStatus::invalidParameters,
+              lbch.decodePages(outpost::asSlice(encoded), outpost::asSlice(output), pages + 1));
+}
+
 RC_GTEST_FIXTURE_PROP(BCHCTest, simpleEncodeDecode, ())
 {
     std::array<uint8_t, dataSize> input;
@@ -32,7 +32,10 @@ using BCH = NandBCHRTime<NandBCHInterface::DEF_GALIOS_DIMENISIONS,
                          mNandDataSize,
                          mNandSpareSize>;
 
-static BCH<dataSize, spareSize> bch;
+static NandBCHRTimeTables<NandBCHInterface::DEF_GALIOS_DIMENISIONS,
+                          NandBCHInterface::DEF_ERROR_CORRECTION>
+        sharedTables;
+static BCH<dataSize, spareSize> bch(sharedTables);
 
 class BCHRTest : public ::testing::Test
 {
@@ -1971,6 +1974,41 @@ TEST(BCHRTest, defaultValueAreValid)
     EXPECT_TRUE(bch.isTemplateParameterValid());
 }
 
+TEST(BCHRTest, correctsUpToConfiguredNumberOfBitFlips)
+{
+    // Two sectors, only the second one contains errors
+    BCH<dataSize * 2, spareSize * 2> lbch(sharedTables);
+
+    std::array<uint8_t, dataSize * 2> input;
+    std::array<uint8_t, dataSize * 2> output;
+    for (size_t i = 0; i < input.size(); i++)
+    {
+        input[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+
+    std::array<uint8_t, (dataSize + spareSize) * 2> encoded;
+    ASSERT_TRUE(lbch.encode(outpost::asSlice(input), outpost::asSlice(encoded)));
+
+    for (uint32_t errors = 1; errors <= NandBCHInterface::DEF_ERROR_CORRECTION; errors++)
+    {
+        std::array<uint8_t, (dataSize + spareSize) * 2> corrupted = encoded;
+        for (uint32_t k = 0; k < errors; k++)
+        {
+            // Spread over the data of the second sector, the last flip hits its checksum
+            uint32_t position = (k + 1 == errors && errors > 1)
+                                        ? dataSize * 2 + lbch.getNumberOfRedundantBytes() / 2 + 1
+                                        : dataSize + (k * 67 + errors * 13) % dataSize;
+            corrupted[position] ^= static_cast<uint8_t>(1 << ((k * 3) % 8));
+        }
+
+        output.fill(0);
+        EXPECT_EQ(DecodeStatus::corrected,
+                  lbch.decode(outpost::asSlice(corrupted), outpost::asSlice(output)))
+                << errors << " errors";
+        EXPECT_EQ(input, output) << errors << " errors";
+    }
+}
+
 RC_GTEST_FIXTURE_PROP(BCHRTest, simpleEncodeDecode, ())
 {
     std::array<uint8_t, dataSize> input;
@@ -1998,7 +2036,7 @@ RC_GTEST_FIXTURE_PROP(BCHRTest, simpleEncodeDecode, ())
 RC_GTEST_FIXTURE_PROP(BCHRTest, simpleEncodeDecodeSeveralParts, ())
 {
     constexpr uint8_t multi = 8;
-    BCH<dataSize * multi, spareSize * multi> lbch;
+    BCH<dataSize * multi, spareSize * multi> lbch(sharedTables);
 
     std::array<uint8_t, dataSize * multi> input;
     std::array<uint8_t, dataSize * multi> output;
@@ -2026,7 +2064,7 @@ RC_GTEST_FIXTURE_PROP(BCHRTest, simpleSeveralPartsPartialCopy, ())
 {
     constexpr uint8_t multi = 8;
     constexpr uint32_t partial = dataSize * 6 + dataSize / 2;
-    BCH<dataSize * multi, spareSize * multi> lbch;
+    BCH<dataSize * multi, spareSize * multi> lbch(sharedTables);
 
     std::array<uint8_t, dataSize * multi> input;
     std::array<uint8_t, partial> output;
@@ -2228,3 +2266,39 @@ RC_GTEST_FIXTURE_PROP(BCHRTest, singleBitflipsShouldNotMoveFromCorrectableToWron
 
     EXPECT_GT(itcount, NandBCHInterface::DEF_ERROR_CORRECTION);
 }
+
+TEST(BCHRTablesTest, instancesShareTables)
+{
+    ASSERT_TRUE(sharedTables.isValid());
+
+    BCH<dataSize, spareSize> first(sharedTables);
+    BCH<dataSize, spareSize> second(sharedTables);
+    EXPECT_LT(sizeof(first), sizeof(sharedTables) / 50);
+
+    std::array<uint8_t, dataSize> input;
+    for (size_t i = 0; i < input.size(); i++)
+    {
+        input[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+
+    std::array<uint8_t, dataSize + spareSize> encodedFirst;
+    std::array<uint8_t, dataSize + spareSize> encodedSecond;
+    encodedFirst.fill(0xFF);
+    encodedSecond.fill(0xFF);
+    ASSERT_TRUE(first.encode(outpost::asSlice(input), outpost::asSlice(encodedFirst)));
+    ASSERT_TRUE(second.encode(outpost::asSlice(input), outpost::asSlice(encodedSecond)));
+    EXPECT_EQ(encodedFirst, encodedSecond);
+
+    // Decoding with one instance does not affect the other one
+    encodedFirst[10] ^= 0x01;
+    encodedSecond[100] ^= 0x80;
+
+    std::array<uint8_t, dataSize> outputFirst;
+    std::array<uint8_t, dataSize> outputSecond;
+    EXPECT_EQ(DecodeStatus::corrected,
+              first.decode(outpost::asSlice(encodedFirst), outpost::asSlice(outputFirst)));
+    EXPECT_EQ(DecodeStatus::corrected,
+              second.decode(outpost::asSlice(encodedSecond), outpost::asSlice(outputSecond)));
+    EXPECT_EQ(input, outputFirst);
+    EXPECT_EQ(input, outputSecond);
+}
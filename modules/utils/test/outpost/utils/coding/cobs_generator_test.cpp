@@ -457,3 +457,43 @@ TEST(CobsGeneratorTest, CopyAssignmentDuringDoubleBlockEncoding)
     EXPECT_EQ(13, generator2.getNextByte());
     EXPECT_TRUE(generator2.isFinished());
 }
+
+TEST(CobsGeneratorTest, chunkedGenerationMatchesBytewiseGeneration)
+{
+    uint8_t input[1000];
+    uint32_t state = 4711U;
+    for (size_t i = 0; i < sizeof(input); ++i)
+    {
+        state = state * 1103515245U + 12345U;
+        // Mixes long runs without zeros and sections with frequent zeros
+        input[i] = ((i / 300) % 2 == 0) ? static_cast<uint8_t>((state >> 16) | 1)
+                                        : static_cast<uint8_t>((state >> 16) % 4);
+    }
+
+    const size_t chunkSizes[] = {1, 2, 7, 64, 255, 300, 2000};
+    for (size_t chunkSize : chunkSizes)
+    {
+        CobsEncodingGenerator reference(outpost::asSlice(input));
+        uint8_t expected[1100] = {};
+        size_t expectedLength = getEncodedArray(reference, expected, sizeof(expected));
+
+        CobsEncodingGenerator generator(outpost::asSlice(input));
+        uint8_t actual[1100 + 2000];
+        size_t length = 0;
+        size_t count;
+        do
+        {
+            count = generator.getNextBytes(
+                    outpost::Slice<uint8_t>::unsafe(&actual[length], chunkSize));
+            EXPECT_LE(count, chunkSize);
+            length += count;
+        } while (count > 0);
+
+        EXPECT_TRUE(generator.isFinished());
+        ASSERT_EQ(expectedLength, length) << "chunk size " << chunkSize;
+        for (size_t i = 0; i < length; ++i)
+        {
+            ASSERT_EQ(expected[i], actual[i]) << "chunk size " << chunkSize << ", byte " << i;
+        }
+    }
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/coding/cobs.h>
+
+#include <unittest/harness.h>
+
+#include <algorithm>
+#include <vector>
+
+using ::testing::ElementsAre;
+
+using outpost::utils::Cobs;
+using outpost::utils::CobsStreamDecoder;
+
+namespace
+{
+std::vector<uint8_t>
+toVector(outpost::Slice<uint8_t> slice)
+{
+    return std::vector<uint8_t>(slice.begin(), slice.end());
+}
+
+class CobsStreamDecoderTest : public ::testing::Test
+{
+public:
+    CobsStreamDecoderTest() : mDecoder(outpost::asSlice(mBuffer))
+    {
+    }
+
+    /// Append a COBS encoded frame followed by a delimiter to the stream
+    void
+    appendFrame(const std::vector<uint8_t>& frame)
+    {
+        std::vector<uint8_t> encoded(Cobs::getMaximumSizeOfEncodedData(frame.size()));
+        size_t length = Cobs::encode(outpost::Slice<const uint8_t>::unsafe(frame.data(),
+                                                                           frame.size()),
+                                     outpost::asSlice(encoded));
+        mStream.insert(mStream.end(), encoded.begin(), encoded.begin() + length);
+        mStream.push_back(0);
+    }
+
+    /// Decode the stream in chunks of the given size and collect all frames
+    std::vector<std::vector<uint8_t>>
+    decodeStream(size_t chunkSize)
+    {
+        std::vector<std::vector<uint8_t>> frames;
+        size_t position = 0;
+        while (position < mStream.size())
+        {
+            size_t length = std::min(chunkSize, mStream.size() - position);
+            outpost::Slice<const uint8_t> chunk =
+                    outpost::Slice<const uint8_t>::unsafe(&mStream[position], length);
+            while (chunk.getNumberOfElements() > 0)
+            {
+                chunk = chunk.skipFirst(mDecoder.decode(chunk));
+                if (mDecoder.isFrameAvailable())
+                {
+                    outpost::Slice<uint8_t> frame = mDecoder.getFrame();
+                    frames.push_back(std::vector<uint8_t>(frame.begin(), frame.end()));
+                    mDecoder.releaseFrame();
+                }
+            }
+            position += length;
+        }
+        return frames;
+    }
+
+    uint8_t mBuffer[600];
+    CobsStreamDecoder mDecoder;
+    std::vector<uint8_t> mStream;
+};
+}  // namespace
+
+TEST_F(CobsStreamDecoderTest, shouldDecodeFramesIndependentOfChunkSize)
+{
+    std::vector<std::vector<uint8_t>> frames;
+    frames.push_back({0x01});
+    frames.push_back({0x00});
+    frames.push_back({0x00, 0x00});
+    frames.push_back({0x11, 0x22, 0x00, 0x33});
+    frames.push_back(std::vector<uint8_t>(254, 0xAB));
+    frames.push_back(std::vector<uint8_t>(600, 0xCD));
+
+    std::vector<uint8_t> random(500);
+    uint32_t state = 1234U;
+    for (size_t i = 0; i < random.size(); ++i)
+    {
+        state = state * 1103515245U + 12345U;
+        random[i] = static_cast<uint8_t>((state >> 16) % 8);
+    }
+    frames.push_back(random);
+
+    for (const std::vector<uint8_t>& frame : frames)
+    {
+        appendFrame(frame);
+    }
+
+    const size_t chunkSizes[] = {1, 2, 3, 17, 255, 4096};
+    for (size_t chunkSize : chunkSizes)
+    {
+        std::vector<std::vector<uint8_t>> decoded = decodeStream(chunkSize);
+        ASSERT_EQ(frames.size(), decoded.size()) << "chunk size " << chunkSize;
+        for (size_t i = 0; i < frames.size(); ++i)
+        {
+            EXPECT_EQ(frames[i], decoded[i]) << "chunk size " << chunkSize << ", frame " << i;
+        }
+    }
+    EXPECT_EQ(0U, mDecoder.getNumberOfErrors());
+}
+
+TEST_F(CobsStreamDecoderTest, shouldStopAtEndOfFrame)
+{
+    uint8_t input[] = {0x02, 0x11, 0x00, 0x03, 0x22, 0x33, 0x00};
+
+    EXPECT_EQ(3U, mDecoder.decode(outpost::asSlice(input)));
+    ASSERT_TRUE(mDecoder.isFrameAvailable());
+    EXPECT_THAT(toVector(mDecoder.getFrame()), ElementsAre(0x11));
+
+    // No data is consumed until the frame is released
+    EXPECT_EQ(0U, mDecoder.decode(outpost::asSlice(input).skipFirst(3)));
+
+    mDecoder.releaseFrame();
+    EXPECT_FALSE(mDecoder.isFrameAvailable());
+    EXPECT_EQ(0U, mDecoder.getFrame().getNumberOfElements());
+
+    EXPECT_EQ(4U, mDecoder.decode(outpost::asSlice(input).skipFirst(3)));
+    ASSERT_TRUE(mDecoder.isFrameAvailable());
+    EXPECT_THAT(toVector(mDecoder.getFrame()), ElementsAre(0x22, 0x33));
+}
+
+TEST_F(CobsStreamDecoderTest, shouldSkipEmptyFrames)
+{
+    uint8_t input[] = {0x00, 0x00, 0x02, 0x11, 0x00};
+
+    EXPECT_EQ(5U, mDecoder.decode(outpost::asSlice(input)));
+    ASSERT_TRUE(mDecoder.isFrameAvailable());
+    EXPECT_THAT(toVector(mDecoder.getFrame()), ElementsAre(0x11));
+}
+
+TEST_F(CobsStreamDecoderTest, shouldDiscardFrameEndingWithinBlock)
+{
+    uint8_t input[] = {0x05, 0x11, 0x22, 0x00, 0x02, 0x33, 0x00};
+
+    EXPECT_EQ(sizeof(input), mDecoder.decode(outpost::asSlice(input)));
+    EXPECT_EQ(1U, mDecoder.getNumberOfErrors());
+    ASSERT_TRUE(mDecoder.isFrameAvailable());
+    EXPECT_THAT(toVector(mDecoder.getFrame()), ElementsAre(0x33));
+}
+
+TEST_F(CobsStreamDecoderTest, shouldDiscardFrameExceedingBuffer)
+{
+    uint8_t buffer[4];
+    mDecoder.setBuffer(outpost::asSlice(buffer));
+
+    appendFrame({1, 2, 3, 4, 5});
+    appendFrame({1, 2, 3, 0});
+    appendFrame({1, 2, 3, 0, 5});
+    appendFrame({6, 7, 0, 8});
+
+    std::vector<std::vector<uint8_t>> decoded = decodeStream(2);
+    ASSERT_EQ(2U, decoded.size());
+    EXPECT_THAT(decoded[0], ElementsAre(1, 2, 3, 0));
+    EXPECT_THAT(decoded[1], ElementsAre(6, 7, 0, 8));
+    EXPECT_EQ(2U, mDecoder.getNumberOfErrors());
+}
+
+TEST_F(CobsStreamDecoderTest, shouldIgnoreDataUntilDelimiterAfterResynchronize)
+{
+    uint8_t input[] = {0x03, 0x11, 0x22, 0x33, 0x00, 0x02, 0x44, 0x00};
+
+    EXPECT_EQ(2U, mDecoder.decode(outpost::asSlice(input).first(2)));
+    mDecoder.resynchronize();
+
+    EXPECT_EQ(6U, mDecoder.decode(outpost::asSlice(input).skipFirst(2)));
+    ASSERT_TRUE(mDecoder.isFrameAvailable());
+    EXPECT_THAT(toVector(mDecoder.getFrame()), ElementsAre(0x44));
+    EXPECT_EQ(0U, mDecoder.getNumberOfErrors());
+}
+
+TEST_F(CobsStreamDecoderTest, shouldDecodeNextFrameIntoNewBuffer)
+{
+    uint8_t input[] = {0x02, 0x11, 0x00, 0x02, 0x22, 0x00};
+
+    EXPECT_EQ(3U, mDecoder.decode(outpost::asSlice(input)));
+    ASSERT_TRUE(mDecoder.isFrameAvailable());
+    EXPECT_EQ(&mBuffer[0], mDecoder.getFrame().begin());
+
+    uint8_t buffer[8];
+    mDecoder.setBuffer(outpost::asSlice(buffer));
+    EXPECT_FALSE(mDecoder.isFrameAvailable());
+    EXPECT_EQ(0x11, mBuffer[0]);
+
+    EXPECT_EQ(3U, mDecoder.decode(outpost::asSlice(input).skipFirst(3)));
+    ASSERT_TRUE(mDecoder.isFrameAvailable());
+    EXPECT_EQ(&buffer[0], mDecoder.getFrame().begin());
+    EXPECT_THAT(toVector(mDecoder.getFrame()), ElementsAre(0x22));
+}
@@ -12,9 +12,12 @@
  */
 
 #include <outpost/utils/coding/cobs.h>
+#include <outpost/utils/coding/crc16.h>
 
 #include <unittest/harness.h>
 
+#include <string.h>
+
 using ::testing::ElementsAreArray;
 
 using outpost::utils::Cobs;
@@ -411,6 +414,143 @@ TEST(CobsTest, abortWithAToSmallOutputBuffer)
     EXPECT_THAT(expected, ElementsAreArray(actual, sizeof(expected)));
 }
 
+/*
+ * Byte by byte encoding, used as reference for the block based
+ * implementation of Cobs::encode().
+ */
+static size_t
+encodeBytewise(const uint8_t* input, size_t inputLength, uint8_t* output, size_t outputLength)
+{
+    const uint8_t* inputEnd = input + inputLength;
+    uint8_t* blockLengthPtr = output++;
+    size_t length = 1;
+    uint8_t currentBlockLength = 0;
+
+    while ((input < inputEnd) && (length < outputLength))
+    {
+        if (*input == 0)
+        {
+            *blockLengthPtr = currentBlockLength + 1;
+            blockLengthPtr = output++;
+            length++;
+            currentBlockLength = 0;
+        }
+        else
+        {
+            *output++ = *input;
+            length++;
+            currentBlockLength++;
+            if ((currentBlockLength == 254) && (length < outputLength))
+            {
+                *blockLengthPtr = currentBlockLength + 1;
+                blockLengthPtr = output++;
+                length++;
+                currentBlockLength = 0;
+            }
+        }
+        input++;
+    }
+    *blockLengthPtr = currentBlockLength + 1;
+
+    return length;
+}
+
+TEST(CobsTest, blockEncodingMatchesBytewiseEncoding)
+{
+    uint8_t input[1100];
+    uint32_t state = 815U;
+    for (size_t i = 0; i < sizeof(input); ++i)
+    {
+        state = state * 1103515245U + 12345U;
+        // Mixes long runs without zeros and sections with frequent zeros
+        input[i] = ((i / 400) % 2 == 0) ? static_cast<uint8_t>((state >> 16) | 1)
+                                        : static_cast<uint8_t>((state >> 16) % 4);
+    }
+
+    const size_t inputLengths[] = {0, 1, 7, 253, 254, 255, 508, 509, 1100};
+    for (size_t inputLength : inputLengths)
+    {
+        const size_t maximumLength = Cobs::getMaximumSizeOfEncodedData(inputLength);
+        for (size_t outputLength = 1; outputLength <= maximumLength; ++outputLength)
+        {
+            // One additional byte as the final block length may be written behind
+            // a truncated output
+            uint8_t expected[1200] = {};
+            uint8_t actual[1200] = {};
+
+            size_t expectedLength = encodeBytewise(input, inputLength, expected, outputLength);
+            size_t length = Cobs::encode(outpost::Slice<const uint8_t>::unsafe(input, inputLength),
+                                         outpost::Slice<uint8_t>::unsafe(actual, outputLength));
+
+            ASSERT_EQ(expectedLength, length) << inputLength << " " << outputLength;
+            ASSERT_THAT(actual, ElementsAreArray(expected)) << inputLength << " " << outputLength;
+        }
+    }
+}
+
+TEST(CobsTest, frameEncodingMatchesSeparateSteps)
+{
+    uint8_t input[600];
+    uint32_t state = 4711U;
+    for (size_t i = 0; i < sizeof(input); ++i)
+    {
+        state = state * 1103515245U + 12345U;
+        input[i] = ((i / 200) % 2 == 0) ? static_cast<uint8_t>((state >> 16) | 1)
+                                        : static_cast<uint8_t>((state >> 16) % 4);
+    }
+
+    const size_t inputLengths[] = {0, 1, 2, 251, 252, 253, 254, 300, 600};
+    for (size_t inputLength : inputLengths)
+    {
+        auto data = outpost::Slice<const uint8_t>::unsafe(input, inputLength);
+
+        uint8_t packet[sizeof(input) + 2];
+        memcpy(packet, input, inputLength);
+        const uint16_t crc = outpost::Crc16Ccitt::calculate(data);
+        packet[inputLength] = static_cast<uint8_t>(crc >> 8);
+        packet[inputLength + 1] = static_cast<uint8_t>(crc);
+
+        uint8_t expected[700] = {};
+        size_t expectedLength = Cobs::encode(
+                outpost::Slice<const uint8_t>::unsafe(packet, inputLength + 2),
+                outpost::Slice<uint8_t>::unsafe(
+                        expected, Cobs::getMaximumSizeOfEncodedData(inputLength + 2)));
+        expected[expectedLength++] = 0;
+
+        uint8_t actual[700] = {};
+        size_t length =
+                Cobs::encodeFrame<outpost::Crc16Ccitt>(data, outpost::Slice<uint8_t>(actual));
+
+        ASSERT_EQ(expectedLength, length) << inputLength;
+        ASSERT_THAT(actual, ElementsAreArray(expected)) << inputLength;
+
+        uint8_t decoded[700];
+        ASSERT_EQ(inputLength + 2,
+                  Cobs::decode(outpost::Slice<const uint8_t>::unsafe(actual, length - 1),
+                               decoded));
+        EXPECT_EQ(0, memcmp(packet, decoded, inputLength + 2));
+    }
+}
+
+TEST(CobsTest, frameEncodingRequiresSpaceForTheCompleteFrame)
+{
+    uint8_t input[10] = {1, 2, 0, 4, 5, 6, 0, 8, 9, 10};
+    uint8_t output[20] = {};
+
+    // Encoded data and checksum plus the delimiter
+    const size_t frameLength = Cobs::getMaximumSizeOfEncodedData(sizeof(input) + 2) + 1;
+    EXPECT_EQ(0U,
+              Cobs::encodeFrame<outpost::Crc16Ccitt>(
+                      outpost::Slice<const uint8_t>(input),
+                      outpost::Slice<uint8_t>::unsafe(output, frameLength - 1)));
+
+    size_t length = Cobs::encodeFrame<outpost::Crc16Ccitt>(
+            outpost::Slice<const uint8_t>(input),
+            outpost::Slice<uint8_t>::unsafe(output, frameLength));
+    EXPECT_GE(frameLength, length);
+    EXPECT_EQ(0, output[length - 1]);
+}
+
 TEST(CobsTest, shouldAbortDecodingWhenZeroBytesAreDetected)
 {
     uint8_t input[] = {0, 0x04, 10, 11, 12, 0x03, 13, 14};
@@ -198,6 +198,40 @@ TEST(Crc16Test, testUpdate)
     EXPECT_EQ(0x7fd5, crc.getValue());
 }
 
+TEST(Crc16Test, testBlockUpdateMatchesBytewiseUpdate)
+{
+    uint8_t data[37];
+    for (size_t i = 0; i < sizeof(data); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 73 + 11);
+    }
+
+    // Covers all remainders of the four byte blocks
+    for (size_t length = 0; length <= sizeof(data); ++length)
+    {
+        Crc16Ccitt bytewise;
+        for (size_t i = 0; i < length; ++i)
+        {
+            bytewise.update(data[i]);
+        }
+
+        Crc16Ccitt block;
+        block.update(outpost::asSlice(data).first(length));
+        EXPECT_EQ(bytewise.getValue(), block.getValue());
+    }
+}
+
+TEST(Crc16Test, testFragmentedUpdate)
+{
+    uint8_t data[] = {0x14, 0x56, 0xf8, 0x9a, 0x00, 0x01};
+
+    Crc16Ccitt crc;
+    crc.update(outpost::asSlice(data).first(1));
+    crc.update(outpost::asSlice(data).skipFirst(1));
+
+    EXPECT_EQ(0x7fd5, crc.getValue());
+}
+
 // code from http://www.nongnu.org/avr-libc/user-manual/group__util__crc.html
 static uint16_t
 crc_xmodem_update(uint16_t crc, uint8_t data)
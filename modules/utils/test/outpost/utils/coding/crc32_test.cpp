@@ -117,3 +117,43 @@ TEST(Crc32Test, bitwiseTest)
 
     EXPECT_EQ(crc, Crc32Reversed::calculate(outpost::asSlice(data)));
 }
+
+TEST(Crc32Test, blockUpdateMatchesBytewiseUpdate)
+{
+    uint8_t data[100];
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+
+    // Cover every combination of offset and remainder of the eight byte steps
+    for (size_t offset = 0; offset < 8; offset++)
+    {
+        for (size_t length = 0; length + offset <= sizeof(data); length++)
+        {
+            Crc32Reversed bytewise;
+            for (size_t i = 0; i < length; i++)
+            {
+                bytewise.update(data[offset + i]);
+            }
+
+            Crc32Reversed block;
+            block.update(outpost::asSlice(data).subSlice(offset, length));
+            EXPECT_EQ(bytewise.getValue(), block.getValue())
+                    << "offset " << offset << ", length " << length;
+        }
+    }
+}
+
+TEST(Crc32Test, fragmentedUpdate)
+{
+    uint8_t data[] = "The quick brown fox jumps over the lazy dog";
+    outpost::Slice<const uint8_t> slice = outpost::asSlice(data).first(sizeof(data) - 1);
+
+    Crc32Reversed crc;
+    crc.update(slice.first(3));
+    crc.update(slice.subSlice(3, 17));
+    crc.update(slice.skipFirst(20));
+
+    EXPECT_EQ(0x414FA339U, crc.getValue());
+}
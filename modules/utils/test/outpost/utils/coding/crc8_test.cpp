@@ -71,6 +71,29 @@ TEST(Crc8CcittTest, bitwiseTest)
     EXPECT_EQ(crc, Crc8Ccitt::calculate(outpost::asSlice(data)));
 }
 
+TEST(Crc8CcittTest, blockUpdateShouldMatchBytewiseUpdate)
+{
+    uint8_t data[37];
+    for (size_t i = 0; i < sizeof(data); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 73 + 11);
+    }
+
+    // Covers all remainders of the four byte blocks
+    for (size_t length = 0; length <= sizeof(data); ++length)
+    {
+        Crc8Ccitt bytewise;
+        for (size_t i = 0; i < length; ++i)
+        {
+            bytewise.update(data[i]);
+        }
+
+        Crc8Ccitt block;
+        block.update(outpost::asSlice(data).first(length));
+        EXPECT_EQ(bytewise.getValue(), block.getValue());
+    }
+}
+
 // ----------------------------------------------------------------------------
 TEST(Crc8CcittReversedTest, initialValue)
 {
@@ -301,3 +324,36 @@ TEST(Crc8CcittReversedTest, bitwiseTest)
 
     EXPECT_EQ(crc, Crc8CcittReversed::calculate(outpost::asSlice(data)));
 }
+
+TEST(Crc8CcittReversedTest, blockUpdateShouldMatchBytewiseUpdate)
+{
+    uint8_t data[37];
+    for (size_t i = 0; i < sizeof(data); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 73 + 11);
+    }
+
+    // Covers all remainders of the four byte blocks
+    for (size_t length = 0; length <= sizeof(data); ++length)
+    {
+        Crc8CcittReversed bytewise;
+        for (size_t i = 0; i < length; ++i)
+        {
+            bytewise.update(data[i]);
+        }
+
+        Crc8CcittReversed block;
+        block.update(outpost::asSlice(data).first(length));
+        EXPECT_EQ(bytewise.getValue(), block.getValue());
+    }
+}
+
+TEST(Crc8CcittReversedTest, calculateAndCopy)
+{
+    uint8_t data[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B};
+    uint8_t copy[sizeof(data)] = {};
+
+    EXPECT_EQ(Crc8CcittReversed::calculate(outpost::asSlice(data)),
+              Crc8CcittReversed::calculateAndCopy(outpost::asSlice(data), copy));
+    EXPECT_THAT(copy, ::testing::ElementsAreArray(data));
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+ * \file
+ * \brief   Test the generic CRC engine
+ *
+ * Check values are taken from the CRC catalogue
+ * https://reveng.sourceforge.io/crc-catalogue/
+ */
+#include <outpost/utils/coding/crc.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using outpost::CrcEngine;
+
+namespace
+{
+const uint8_t checkData[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+template <typename Engine>
+typename Engine::ValueType
+check()
+{
+    return Engine::calculate(outpost::asSlice(checkData));
+}
+
+template <typename Engine, typename Reference>
+void
+expectSameResult()
+{
+    uint8_t data[67];
+    for (size_t i = 0; i < sizeof(data); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 73 + 11);
+    }
+
+    for (size_t length = 0; length <= sizeof(data); ++length)
+    {
+        Reference bytewise;
+        for (size_t i = 0; i < length; ++i)
+        {
+            bytewise.update(data[i]);
+        }
+
+        Engine block;
+        block.update(outpost::asSlice(data).first(length));
+        EXPECT_EQ(bytewise.getValue(), block.getValue()) << "length " << length;
+    }
+}
+
+template <typename Engine>
+void
+expectCombinedResult()
+{
+    uint8_t data[300];
+    for (size_t i = 0; i < sizeof(data); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 151 + 7);
+    }
+    const outpost::Slice<const uint8_t> slice = outpost::asSlice(data);
+    const typename Engine::ValueType expected = Engine::calculate(slice);
+
+    for (size_t split = 0; split <= sizeof(data); split += 13)
+    {
+        const typename Engine::ValueType first = Engine::calculate(slice.first(split));
+        const typename Engine::ValueType second = Engine::calculate(slice.skipFirst(split));
+        EXPECT_EQ(expected, Engine::combine(first, second, sizeof(data) - split))
+                << "split " << split;
+    }
+}
+}  // namespace
+
+TEST(CrcEngineTest, shouldMatchCatalogueCheckValues)
+{
+    EXPECT_EQ(0xF4U, check<outpost::Crc8Ccitt>());
+    EXPECT_EQ(0x29B1U, check<outpost::Crc16Ccitt>());
+    EXPECT_EQ(0x906EU, check<outpost::Crc16X25>());
+    EXPECT_EQ(0xCBF43926U, check<outpost::Crc32Reversed>());
+    EXPECT_EQ(0xE3069283U, check<outpost::Crc32Castagnoli>());
+
+    // CRC-16/ARC
+    EXPECT_EQ(0xBB3DU, (check<CrcEngine<16, 0x8005, 0x0000, true, true, 0x0000>>()));
+    // CRC-16/KERMIT
+    EXPECT_EQ(0x2189U, (check<CrcEngine<16, 0x1021, 0x0000, true, true, 0x0000, 2>>()));
+    // CRC-32/BZIP2
+    EXPECT_EQ(0xFC891918U,
+              (check<CrcEngine<32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF, 8>>()));
+    // CRC-32/MPEG-2
+    EXPECT_EQ(0x0376E6E7U,
+              (check<CrcEngine<32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0x00000000, 3>>()));
+    // CRC-8/MAXIM-DOW
+    EXPECT_EQ(0xA1U, (check<CrcEngine<8, 0x31, 0x00, true, true, 0x00, 5>>()));
+}
+
+TEST(CrcEngineTest, initialValueShouldIncludeFinalXor)
+{
+    outpost::Crc16X25 crc;
+    EXPECT_EQ(0x0000U, crc.getValue());
+
+    CrcEngine<16, 0x1021, 0x1D0F, false, false, 0x0000> augmented;
+    EXPECT_EQ(0x1D0FU, augmented.getValue());
+}
+
+TEST(CrcEngineTest, sliceCountShouldNotChangeResult)
+{
+    typedef CrcEngine<32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0xFFFFFFFF> Crc32;
+    expectSameResult<CrcEngine<32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 3>, Crc32>();
+    expectSameResult<CrcEngine<32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 4>, Crc32>();
+    expectSameResult<CrcEngine<32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 8>, Crc32>();
+
+    typedef CrcEngine<32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF> Bzip2;
+    expectSameResult<CrcEngine<32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF, 2>, Bzip2>();
+    expectSameResult<CrcEngine<32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF, 7>, Bzip2>();
+
+    typedef CrcEngine<16, 0x1021, 0xFFFF, false, false, 0x0000> Ccitt;
+    expectSameResult<CrcEngine<16, 0x1021, 0xFFFF, false, false, 0x0000, 3>, Ccitt>();
+    expectSameResult<CrcEngine<16, 0x1021, 0xFFFF, false, false, 0x0000, 8>, Ccitt>();
+
+    typedef CrcEngine<16, 0x1021, 0xFFFF, true, true, 0xFFFF> X25;
+    expectSameResult<CrcEngine<16, 0x1021, 0xFFFF, true, true, 0xFFFF, 6>, X25>();
+
+    typedef CrcEngine<8, 0x07, 0x00, false, false, 0x00> Crc8;
+    expectSameResult<CrcEngine<8, 0x07, 0x00, false, false, 0x00, 8>, Crc8>();
+}
+
+TEST(CrcEngineTest, hardwareImplementationShouldMatchTables)
+{
+    // Uses the instructions of the target if available, otherwise a second table layout
+    expectSameResult<outpost::Crc32Castagnoli,
+                     CrcEngine<32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 1>>();
+}
+
+TEST(CrcEngineTest, calculateAndCopy)
+{
+    uint8_t destination[sizeof(checkData)] = {};
+    EXPECT_EQ(0xCBF43926U,
+              outpost::Crc32Reversed::calculateAndCopy(outpost::asSlice(checkData), destination));
+    EXPECT_THAT(destination, testing::ElementsAreArray(checkData));
+}
+
+TEST(CrcEngineTest, combineShouldMatchCalculationOverBothBlocks)
+{
+    expectCombinedResult<outpost::Crc32Reversed>();
+    expectCombinedResult<outpost::Crc32Castagnoli>();
+    expectCombinedResult<outpost::Crc16Ccitt>();
+    expectCombinedResult<outpost::Crc16X25>();
+    expectCombinedResult<outpost::Crc8Ccitt>();
+    // CRC-32/BZIP2
+    expectCombinedResult<CrcEngine<32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF, 8>>();
+    // CRC-8/MAXIM-DOW
+    expectCombinedResult<CrcEngine<8, 0x31, 0x00, true, true, 0x00, 5>>();
+    // CRC-16 with differently reflected input and output
+    expectCombinedResult<CrcEngine<16, 0x8005, 0x1234, true, false, 0x00FF>>();
+}
+
+TEST(CrcEngineTest, combineShouldMergeSeveralParts)
+{
+    // Four parts as calculated by independent workers
+    const uint8_t parts[4][5] = {{'1', '2'}, {'3', '4', '5'}, {'6', '7', '8'}, {'9'}};
+    const size_t lengths[4] = {2, 3, 3, 1};
+
+    uint32_t crc = outpost::Crc32Reversed::calculate(outpost::Slice<const uint8_t>::empty());
+    for (size_t i = 0; i < 4; ++i)
+    {
+        const uint32_t part = outpost::Crc32Reversed::calculate(
+                outpost::asSlice(parts[i]).first(lengths[i]));
+        crc = outpost::Crc32Reversed::combine(crc, part, lengths[i]);
+    }
+    EXPECT_EQ(0xCBF43926U, crc);
+}
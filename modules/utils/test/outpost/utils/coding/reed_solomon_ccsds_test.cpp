@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/coding/reed_solomon_ccsds.h>
+
+#include <unittest/harness.h>
+
+#include <array>
+
+using outpost::utils::DecodeStatus;
+using outpost::utils::ReedSolomonCcsds;
+
+namespace
+{
+typedef ReedSolomonCcsds<1> Coder;
+typedef ReedSolomonCcsds<5> InterleavedCoder;
+
+template <typename T>
+void
+fillPattern(T& values, uint32_t seed)
+{
+    uint32_t state = seed;
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        state = state * 1103515245U + 12345U;
+        values[i] = static_cast<uint8_t>(state >> 16);
+    }
+}
+}  // namespace
+
+TEST(ReedSolomonCcsdsTest, shouldHaveCcsdsBlockSizes)
+{
+    EXPECT_EQ(223U, Coder::numberOfDataBytes);
+    EXPECT_EQ(255U, Coder::codeBlockSize);
+    EXPECT_EQ(1115U, InterleavedCoder::numberOfDataBytes);
+    EXPECT_EQ(160U, InterleavedCoder::numberOfRedundantBytes);
+    EXPECT_EQ(1275U, InterleavedCoder::codeBlockSize);
+}
+
+TEST(ReedSolomonCcsdsTest, shouldEncodeKnownCodeword)
+{
+    std::array<uint8_t, Coder::numberOfDataBytes> data;
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<uint8_t>(i);
+    }
+
+    // Computed by polynomial division with the parameters of CCSDS 131.0-B
+    const uint8_t expectedParity[32] = {0x4f, 0xfb, 0x92, 0xdd, 0x55, 0x7e, 0xc6, 0x7f,
+                                        0x27, 0xfb, 0x89, 0x82, 0xcf, 0x58, 0xf8, 0xfd,
+                                        0x02, 0x8a, 0xd1, 0x17, 0xfc, 0xef, 0x6b, 0x27,
+                                        0x93, 0xd0, 0x41, 0x88, 0x26, 0x57, 0x86, 0x51};
+
+    std::array<uint8_t, Coder::codeBlockSize> block;
+    ASSERT_TRUE(Coder::encode(outpost::asSlice(data), outpost::asSlice(block)));
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        ASSERT_EQ(data[i], block[i]);
+    }
+    for (size_t i = 0; i < 32; i++)
+    {
+        EXPECT_EQ(expectedParity[i], block[data.size() + i]) << i;
+    }
+}
+
+TEST(ReedSolomonCcsdsTest, shouldEncodeZeroDataToZeroParity)
+{
+    std::array<uint8_t, Coder::codeBlockSize> block;
+    block.fill(0);
+    ASSERT_TRUE(Coder::encode(outpost::asSlice(block), outpost::asSlice(block)));
+    for (size_t i = 0; i < block.size(); i++)
+    {
+        EXPECT_EQ(0, block[i]);
+    }
+}
+
+TEST(ReedSolomonCcsdsTest, shouldInterleaveCodewords)
+{
+    std::array<uint8_t, InterleavedCoder::numberOfDataBytes> data;
+    fillPattern(data, 1);
+
+    std::array<uint8_t, InterleavedCoder::codeBlockSize> block;
+    ASSERT_TRUE(InterleavedCoder::encode(outpost::asSlice(data), outpost::asSlice(block)));
+
+    // Every fifth symbol forms a code word of depth one
+    for (size_t codeword = 0; codeword < 5; codeword++)
+    {
+        std::array<uint8_t, Coder::codeBlockSize> single;
+        for (size_t i = 0; i < Coder::numberOfDataBytes; i++)
+        {
+            single[i] = data[i * 5 + codeword];
+        }
+        ASSERT_TRUE(Coder::encode(outpost::asSlice(single), outpost::asSlice(single)));
+        for (size_t i = 0; i < single.size(); i++)
+        {
+            ASSERT_EQ(single[i], block[i * 5 + codeword]) << codeword << ", " << i;
+        }
+    }
+}
+
+TEST(ReedSolomonCcsdsTest, shouldPassErrorFreeBlock)
+{
+    std::array<uint8_t, InterleavedCoder::numberOfDataBytes> data;
+    fillPattern(data, 2);
+
+    std::array<uint8_t, InterleavedCoder::codeBlockSize> block;
+    ASSERT_TRUE(InterleavedCoder::encode(outpost::asSlice(data), outpost::asSlice(block)));
+
+    std::array<uint8_t, InterleavedCoder::numberOfDataBytes> decoded;
+    EXPECT_EQ(DecodeStatus::noError,
+              InterleavedCoder::decode(outpost::asSlice(block), outpost::asSlice(decoded)));
+    EXPECT_EQ(data, decoded);
+}
+
+TEST(ReedSolomonCcsdsTest, shouldCorrectUpToSixteenErrorsPerCodeword)
+{
+    std::array<uint8_t, InterleavedCoder::numberOfDataBytes> data;
+    fillPattern(data, 3);
+
+    std::array<uint8_t, InterleavedCoder::codeBlockSize> block;
+    ASSERT_TRUE(InterleavedCoder::encode(outpost::asSlice(data), outpost::asSlice(block)));
+
+    for (size_t errors = 1; errors <= 16; errors++)
+    {
+        std::array<uint8_t, InterleavedCoder::codeBlockSize> corrupted = block;
+        for (size_t codeword = 0; codeword < 5; codeword++)
+        {
+            for (size_t k = 0; k < errors; k++)
+            {
+                // Distinct symbols of the code word, including the parity
+                size_t symbol = (k * 16 + codeword * 3 + errors) % 255;
+                corrupted[symbol * 5 + codeword] ^= static_cast<uint8_t>(k * 37 + errors);
+            }
+        }
+
+        std::array<uint8_t, InterleavedCoder::numberOfDataBytes> decoded;
+        EXPECT_EQ(DecodeStatus::corrected,
+                  InterleavedCoder::decode(outpost::asSlice(corrupted),
+                                           outpost::asSlice(decoded)))
+                << errors << " errors";
+        EXPECT_EQ(data, decoded) << errors << " errors";
+    }
+}
+
+TEST(ReedSolomonCcsdsTest, shouldDetectTooManyErrors)
+{
+    std::array<uint8_t, Coder::numberOfDataBytes> data;
+    fillPattern(data, 4);
+
+    std::array<uint8_t, Coder::codeBlockSize> block;
+    ASSERT_TRUE(Coder::encode(outpost::asSlice(data), outpost::asSlice(block)));
+    for (size_t k = 0; k < 17; k++)
+    {
+        block[k * 13] ^= 0x5A;
+    }
+    std::array<uint8_t, Coder::codeBlockSize> received = block;
+
+    std::array<uint8_t, Coder::numberOfDataBytes> decoded;
+    EXPECT_EQ(DecodeStatus::uncorrectable,
+              Coder::decode(outpost::asSlice(received), outpost::asSlice(decoded)));
+
+    // The received data is passed unchanged
+    for (size_t i = 0; i < decoded.size(); i++)
+    {
+        ASSERT_EQ(received[i], decoded[i]);
+    }
+}
+
+TEST(ReedSolomonCcsdsTest, shouldDecodeInPlace)
+{
+    std::array<uint8_t, InterleavedCoder::numberOfDataBytes> data;
+    fillPattern(data, 5);
+
+    std::array<uint8_t, InterleavedCoder::codeBlockSize> block;
+    ASSERT_TRUE(InterleavedCoder::encode(outpost::asSlice(data), outpost::asSlice(block)));
+    block[0] ^= 0xFF;
+    block[700] ^= 0x01;
+    block[1274] ^= 0x80;
+
+    EXPECT_EQ(DecodeStatus::corrected,
+              InterleavedCoder::decode(outpost::asSlice(block), outpost::asSlice(block)));
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        ASSERT_EQ(data[i], block[i]);
+    }
+}
+
+TEST(ReedSolomonCcsdsTest, shouldRejectTooSmallBuffers)
+{
+    std::array<uint8_t, Coder::codeBlockSize> block;
+    block.fill(0);
+
+    EXPECT_FALSE(Coder::encode(outpost::asSlice(block).first(222), outpost::asSlice(block)));
+    EXPECT_FALSE(Coder::encode(outpost::asSlice(block), outpost::asSlice(block).first(254)));
+    EXPECT_EQ(DecodeStatus::invalidParameters,
+              Coder::decode(outpost::asSlice(block).first(254), outpost::asSlice(block)));
+    EXPECT_EQ(DecodeStatus::invalidParameters,
+              Coder::decode(outpost::asSlice(block), outpost::asSlice(block).first(222)));
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/container/arena.h>
+
+#include <unittest/harness.h>
+
+using outpost::utils::Arena;
+using outpost::utils::ArenaScope;
+using outpost::utils::ArenaStorage;
+
+TEST(ArenaTest, shouldAllocateAlignedRegions)
+{
+    ArenaStorage<64> arena;
+    EXPECT_EQ(64U, arena.getCapacity());
+
+    outpost::Slice<uint8_t> bytes = arena.allocate<uint8_t>(3);
+    outpost::Slice<uint32_t> words = arena.allocate<uint32_t>(2);
+    outpost::Slice<uint64_t> values = arena.allocate<uint64_t>(1);
+
+    ASSERT_EQ(3U, bytes.getNumberOfElements());
+    ASSERT_EQ(2U, words.getNumberOfElements());
+    ASSERT_EQ(1U, values.getNumberOfElements());
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(words.begin()) % alignof(uint32_t));
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(values.begin()) % alignof(uint64_t));
+
+    // Regions do not overlap
+    EXPECT_LE(reinterpret_cast<uintptr_t>(bytes.end()), reinterpret_cast<uintptr_t>(words.begin()));
+    EXPECT_LE(reinterpret_cast<uintptr_t>(words.end()),
+              reinterpret_cast<uintptr_t>(values.begin()));
+    EXPECT_EQ(24U, arena.getUsedBytes());
+}
+
+TEST(ArenaTest, shouldFailWithoutChangesWhenExhausted)
+{
+    ArenaStorage<16> arena;
+
+    EXPECT_EQ(12U, arena.allocate<uint8_t>(12).getNumberOfElements());
+    EXPECT_EQ(0U, arena.allocate<uint32_t>(2).getNumberOfElements());
+    EXPECT_EQ(12U, arena.getUsedBytes());
+    EXPECT_EQ(1U, arena.getNumberOfFailedAllocations());
+
+    // Overflow of the requested size
+    EXPECT_EQ(0U, arena.allocate<uint32_t>(SIZE_MAX / 2).getNumberOfElements());
+    EXPECT_EQ(nullptr, arena.allocateBytes(SIZE_MAX, 1));
+
+    EXPECT_EQ(1U, arena.allocate<uint32_t>(1).getNumberOfElements());
+    EXPECT_EQ(0U, arena.getFreeBytes());
+}
+
+TEST(ArenaTest, shouldReuseMemoryAfterReset)
+{
+    ArenaStorage<32> arena;
+
+    outpost::Slice<uint16_t> first = arena.allocate<uint16_t>(16);
+    ASSERT_EQ(16U, first.getNumberOfElements());
+    EXPECT_EQ(0U, arena.allocate<uint16_t>(1).getNumberOfElements());
+
+    arena.reset();
+    outpost::Slice<uint16_t> second = arena.allocate<uint16_t>(16);
+    EXPECT_EQ(first.begin(), second.begin());
+    EXPECT_EQ(32U, arena.getHighWaterMark());
+}
+
+TEST(ArenaTest, scopeShouldReleaseNestedAllocations)
+{
+    ArenaStorage<64> arena;
+    outpost::Slice<uint32_t> persistent = arena.allocate<uint32_t>(4);
+    ASSERT_EQ(4U, persistent.getNumberOfElements());
+
+    uint32_t* nested = nullptr;
+    {
+        ArenaScope scope(arena);
+        nested = arena.allocate<uint32_t>(8).begin();
+        EXPECT_EQ(48U, arena.getUsedBytes());
+    }
+    EXPECT_EQ(16U, arena.getUsedBytes());
+    EXPECT_EQ(nested, arena.allocate<uint32_t>(8).begin());
+    EXPECT_EQ(48U, arena.getHighWaterMark());
+}
+
+TEST(ArenaTest, shouldWorkOnUnalignedMemory)
+{
+    uint8_t memory[33];
+    Arena arena(outpost::asSlice(memory).skipFirst(1));
+
+    outpost::Slice<uint32_t> words = arena.allocate<uint32_t>(7);
+    ASSERT_EQ(7U, words.getNumberOfElements());
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(words.begin()) % alignof(uint32_t));
+}
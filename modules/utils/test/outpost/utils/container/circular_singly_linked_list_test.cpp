@@ -357,3 +357,38 @@ TEST(CircularSinglyLinkedListTest, shouldIterateOverInsertedElements)
 
     ASSERT_FALSE(it != list.end());
 }
+
+TEST(CircularSinglyLinkedListTest, shouldInsertSmallerElementsInFront)
+{
+    CircularSinglyLinkedList<CircularSinglyLinkedListNode> list;
+
+    CircularSinglyLinkedListNode node1 = {10, 0};
+    CircularSinglyLinkedListNode node2 = {7, 0};
+    CircularSinglyLinkedListNode node3 = {5, 0};
+    CircularSinglyLinkedListNode node4 = {1, 0};
+
+    list.insert(&node1);
+    list.insert(&node2);
+    list.insert(&node3);
+    list.insert(&node4);
+
+    EXPECT_EQ(&node4, list.first());
+    EXPECT_EQ(&node1, list.last());
+
+    CircularSinglyLinkedList<CircularSinglyLinkedListNode>::Iterator it = list.begin();
+
+    ASSERT_TRUE(it != list.end());
+    EXPECT_EQ(it->mValue, 1);
+    ++it;
+    ASSERT_TRUE(it != list.end());
+    EXPECT_EQ(it->mValue, 5);
+    ++it;
+    ASSERT_TRUE(it != list.end());
+    EXPECT_EQ(it->mValue, 7);
+    ++it;
+    ASSERT_TRUE(it != list.end());
+    EXPECT_EQ(it->mValue, 10);
+    ++it;
+
+    ASSERT_FALSE(it != list.end());
+}
@@ -16,6 +16,9 @@
 
 #include <unittest/harness.h>
 
+#include <deque>
+#include <random>
+
 using namespace outpost;
 
 TEST(DequeTest, forward)
@@ -239,3 +242,125 @@ TEST(DequeTest, shouldAppendEmptySlice)
     EXPECT_EQ(0U, deque.append(outpost::Slice<int16_t>::empty()));
     EXPECT_TRUE(deque.isEmpty());
 }
+
+TEST(DequeTest, prependSlice)
+{
+    int16_t buffer[5];
+    outpost::Deque<int16_t> deque(outpost::asSlice(buffer));
+
+    int16_t elements[3] = {20, 31, 42};
+
+    deque.append(7);
+    EXPECT_EQ(3u, deque.prepend(outpost::asSlice(elements)));  // {31 42 7h - 20t}
+    EXPECT_EQ(4u, deque.getSize());
+    EXPECT_EQ(20, deque.getFront());
+    EXPECT_EQ(7, deque.getBack());
+
+    // Only the last value fits
+    EXPECT_EQ(1u, deque.prepend(outpost::asSlice(elements)));
+    EXPECT_TRUE(deque.isFull());
+
+    int16_t result[5];
+    EXPECT_EQ(5u, deque.pop(outpost::asSlice(result)));
+    EXPECT_EQ(42, result[0]);
+    EXPECT_EQ(20, result[1]);
+    EXPECT_EQ(31, result[2]);
+    EXPECT_EQ(42, result[3]);
+    EXPECT_EQ(7, result[4]);
+    EXPECT_TRUE(deque.isEmpty());
+}
+
+TEST(DequeTest, shouldOnlyPrependCompleteSlice)
+{
+    int16_t buffer[5];
+    Deque<int16_t, DequeAppendStrategy::complete> deque(outpost::asSlice(buffer));
+
+    int16_t elements[3] = {};
+    EXPECT_EQ(3U, deque.prepend(outpost::asSlice(elements)));
+    EXPECT_EQ(0U, deque.prepend(outpost::asSlice(elements)));
+    EXPECT_EQ(3U, deque.getSize());
+}
+
+TEST(DequeTest, shouldPeekAndPopAcrossTheEndOfTheBuffer)
+{
+    uint8_t buffer[6];
+    outpost::Deque<uint8_t> deque(outpost::asSlice(buffer));
+
+    uint8_t elements[4] = {1, 2, 3, 4};
+    deque.append(outpost::asSlice(elements));
+    deque.removeFront();
+    deque.removeFront();
+    EXPECT_EQ(4u, deque.append(outpost::asSlice(elements)));  // {3 4h - 3t 4 1 2}
+
+    uint8_t result[8] = {};
+    EXPECT_EQ(3u, deque.peek(outpost::Slice<uint8_t>(result).first(3)));
+    EXPECT_EQ(3, result[0]);
+    EXPECT_EQ(4, result[1]);
+    EXPECT_EQ(1, result[2]);
+    EXPECT_EQ(6u, deque.getSize());
+
+    EXPECT_EQ(6u, deque.pop(outpost::asSlice(result)));
+    EXPECT_EQ(3, result[0]);
+    EXPECT_EQ(4, result[1]);
+    EXPECT_EQ(1, result[2]);
+    EXPECT_EQ(2, result[3]);
+    EXPECT_EQ(3, result[4]);
+    EXPECT_EQ(4, result[5]);
+    EXPECT_TRUE(deque.isEmpty());
+    EXPECT_EQ(0u, deque.pop(outpost::asSlice(result)));
+}
+
+TEST(DequeTest, bulkOperationsShouldMatchStandardDeque)
+{
+    uint8_t buffer[13];
+    outpost::Deque<uint8_t> deque(outpost::asSlice(buffer));
+    std::deque<uint8_t> expected;
+
+    std::mt19937 generator(3);
+    uint8_t value = 0;
+    for (size_t i = 0; i < 2000; ++i)
+    {
+        uint8_t data[8];
+        outpost::Slice<uint8_t> slice = outpost::Slice<uint8_t>(data).first(generator() % 9);
+        switch (generator() % 3)
+        {
+            case 0:
+            {
+                for (size_t k = 0; k < slice.getNumberOfElements(); ++k)
+                {
+                    slice[k] = value++;
+                }
+                const size_t appended = deque.append(slice);
+                expected.insert(expected.end(), slice.begin(), slice.begin() + appended);
+                break;
+            }
+            case 1:
+            {
+                for (size_t k = 0; k < slice.getNumberOfElements(); ++k)
+                {
+                    slice[k] = value++;
+                }
+                const size_t prepended = deque.prepend(slice);
+                expected.insert(expected.begin(), slice.end() - prepended, slice.end());
+                break;
+            }
+            default:
+            {
+                const size_t popped = deque.pop(slice);
+                ASSERT_EQ(std::min(slice.getNumberOfElements(), expected.size()), popped);
+                for (size_t k = 0; k < popped; ++k)
+                {
+                    ASSERT_EQ(expected.front(), slice[k]) << i;
+                    expected.pop_front();
+                }
+                break;
+            }
+        }
+        ASSERT_EQ(expected.size(), deque.getSize());
+        if (!expected.empty())
+        {
+            ASSERT_EQ(expected.front(), deque.getFront());
+            ASSERT_EQ(expected.back(), deque.getBack());
+        }
+    }
+}
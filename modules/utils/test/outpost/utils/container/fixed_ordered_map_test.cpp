@@ -82,3 +82,47 @@ TEST(FixedOrderedMapTest, missingEntriesShouldReturnANullPointer)
     EXPECT_EQ(0, list.getEntry(4));
     EXPECT_EQ(0, list.getEntry(35000));
 }
+
+TEST(FixedOrderedMapTest, shouldFindAllEntriesWithIndex)
+{
+    for (size_t n = 0; n <= 40; ++n)
+    {
+        Entry entries[40];
+        for (size_t i = 0; i < n; ++i)
+        {
+            entries[i] = Entry({static_cast<uint16_t>(3 * i + 1), static_cast<uint32_t>(i)});
+        }
+
+        EytzingerIndexStorage<uint16_t, 40> index;
+        FixedOrderedMap<Entry, uint16_t> map(asSlice(entries).first(n), index);
+        ASSERT_TRUE(map.hasIndex());
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            const Entry* entry = map.getEntry(static_cast<uint16_t>(3 * i + 1));
+            ASSERT_NE(nullptr, entry) << n << " " << i;
+            EXPECT_EQ(&entries[i], entry);
+        }
+        for (uint16_t key = 0; key <= 3 * n + 1; key += 3)
+        {
+            EXPECT_EQ(nullptr, map.getEntry(key)) << n << " " << key;
+            EXPECT_EQ(nullptr, map.getEntry(static_cast<uint16_t>(key + 2))) << n << " " << key;
+        }
+    }
+}
+
+TEST(FixedOrderedMapTest, shouldFallBackToBinarySearchIfIndexIsTooSmall)
+{
+    Entry entries[] = {
+            Entry({1, 0}),
+            Entry({3, 1}),
+            Entry({5, 2}),
+    };
+
+    EytzingerIndexStorage<uint16_t, 2> index;
+    FixedOrderedMap<Entry, uint16_t> map(asSlice(entries), index);
+
+    EXPECT_FALSE(map.hasIndex());
+    EXPECT_EQ(2U, map.getEntry(5)->mValue);
+    EXPECT_EQ(0, map.getEntry(4));
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/container/implicit_hash_set.h>
+
+#include <unittest/harness.h>
+
+#include <memory>
+
+using namespace outpost;
+
+namespace
+{
+class Parameter : public ImplicitHashSet<Parameter, uint16_t, 8>
+{
+public:
+    explicit Parameter(uint16_t id) : ImplicitHashSet<Parameter, uint16_t, 8>(set, this, id)
+    {
+    }
+
+    ~Parameter()
+    {
+        removeFromSet(set, this);
+    }
+
+    static Buckets set;
+};
+
+Parameter::Buckets Parameter::set = {};
+
+enum class Node : uint8_t
+{
+    camera = 3,
+    storage = 17
+};
+
+class Device : public ImplicitHashSet<Device, Node, 4>
+{
+public:
+    explicit Device(Node node) : ImplicitHashSet<Device, Node, 4>(set, this, node)
+    {
+    }
+
+    ~Device()
+    {
+        removeFromSet(set, this);
+    }
+
+    static Buckets set;
+};
+
+Device::Buckets Device::set = {};
+}  // namespace
+
+TEST(ImplicitHashSetTest, emptySetShouldNotFindAnything)
+{
+    EXPECT_EQ(nullptr, Parameter::find(Parameter::set, 0));
+    EXPECT_EQ(nullptr, Parameter::find(Parameter::set, 123));
+}
+
+TEST(ImplicitHashSetTest, shouldFindElementsSharingABucket)
+{
+    // More elements than buckets, with a regular pattern of the keys
+    std::unique_ptr<Parameter> parameters[40];
+    for (uint16_t i = 0; i < 40; ++i)
+    {
+        parameters[i].reset(new Parameter(i * 16));
+    }
+
+    for (uint16_t i = 0; i < 40; ++i)
+    {
+        EXPECT_EQ(parameters[i].get(), Parameter::find(Parameter::set, i * 16)) << i;
+        EXPECT_EQ(i * 16, parameters[i]->getHashKey());
+        EXPECT_EQ(nullptr, Parameter::find(Parameter::set, i * 16 + 1)) << i;
+    }
+
+    // Remove every other element
+    for (uint16_t i = 0; i < 40; i += 2)
+    {
+        parameters[i].reset();
+    }
+
+    for (uint16_t i = 0; i < 40; ++i)
+    {
+        EXPECT_EQ(parameters[i].get(), Parameter::find(Parameter::set, i * 16)) << i;
+    }
+
+    for (uint16_t i = 1; i < 40; i += 2)
+    {
+        parameters[i].reset();
+    }
+    for (size_t i = 0; i < 8; ++i)
+    {
+        EXPECT_EQ(nullptr, Parameter::set[i]);
+    }
+}
+
+TEST(ImplicitHashSetTest, shouldReturnLastAddedElementForDuplicateKeys)
+{
+    Parameter first(42);
+    {
+        Parameter second(42);
+        EXPECT_EQ(&second, Parameter::find(Parameter::set, 42));
+    }
+    EXPECT_EQ(&first, Parameter::find(Parameter::set, 42));
+}
+
+TEST(ImplicitHashSetTest, shouldSupportEnumKeys)
+{
+    Device camera(Node::camera);
+    EXPECT_EQ(&camera, Device::find(Device::set, Node::camera));
+    EXPECT_EQ(nullptr, Device::find(Device::set, Node::storage));
+}
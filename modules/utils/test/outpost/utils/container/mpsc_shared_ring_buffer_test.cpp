@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos/thread.h>
+#include <outpost/utils/container/mpsc_shared_ring_buffer.h>
+#include <outpost/utils/container/shared_object_pool.h>
+
+#include <unittest/harness.h>
+
+using outpost::utils::MpscSharedRingBuffer;
+using outpost::utils::MpscSharedRingBufferStorage;
+using outpost::utils::SharedBufferPointer;
+
+TEST(MpscSharedRingBufferTest, shouldKeepFifoOrderAndFlags)
+{
+    outpost::utils::SharedBufferPool<8, 4> pool;
+    MpscSharedRingBufferStorage<4> buffer;
+
+    EXPECT_TRUE(buffer.isEmpty());
+    EXPECT_EQ(4U, buffer.getCapacity());
+
+    SharedBufferPointer pointers[4];
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(pool.allocate(pointers[i]));
+        EXPECT_TRUE(buffer.append(pointers[i], i));
+    }
+    EXPECT_EQ(0U, buffer.getFreeSlots());
+    EXPECT_FALSE(buffer.append(pointers[0]));
+
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        SharedBufferPointer p;
+        uint8_t flags = 0xFF;
+        ASSERT_TRUE(buffer.pop(p, flags));
+        EXPECT_EQ(pointers[i], p);
+        EXPECT_EQ(i, flags);
+    }
+    EXPECT_TRUE(buffer.isEmpty());
+
+    SharedBufferPointer p;
+    EXPECT_FALSE(buffer.pop(p));
+}
+
+TEST(MpscSharedRingBufferTest, shouldRejectElementsWithoutSlots)
+{
+    outpost::utils::SharedBufferPool<8, 1> pool;
+    MpscSharedRingBuffer buffer(outpost::Slice<MpscSharedRingBuffer::Slot>::empty());
+
+    EXPECT_EQ(0U, buffer.getCapacity());
+    EXPECT_EQ(0U, buffer.getFreeSlots());
+    EXPECT_TRUE(buffer.isEmpty());
+
+    SharedBufferPointer p;
+    ASSERT_TRUE(pool.allocate(p));
+    EXPECT_FALSE(buffer.append(p));
+    EXPECT_FALSE(buffer.pop(p));
+    EXPECT_TRUE(p.isValid());
+}
+
+TEST(MpscSharedRingBufferTest, shouldReleaseReferencesWhenPopped)
+{
+    outpost::utils::SharedBufferPool<8, 1> pool;
+    MpscSharedRingBufferStorage<2> buffer;
+
+    SharedBufferPointer p;
+    ASSERT_TRUE(pool.allocate(p));
+    EXPECT_TRUE(buffer.append(std::move(p)));
+    EXPECT_FALSE(p.isValid());
+
+    SharedBufferPointer received;
+    ASSERT_TRUE(buffer.pop(received));
+    EXPECT_EQ(1U, received->getReferenceCount());
+
+    EXPECT_TRUE(buffer.append(received));
+    EXPECT_EQ(2U, received->getReferenceCount());
+    buffer.reset();
+    EXPECT_EQ(1U, received->getReferenceCount());
+    EXPECT_TRUE(buffer.isEmpty());
+}
+
+TEST(MpscSharedRingBufferTest, shouldUsePowerOfTwoOfProvidedSlots)
+{
+    MpscSharedRingBuffer::Slot slots[6];
+    MpscSharedRingBuffer buffer(outpost::asSlice(slots));
+
+    EXPECT_EQ(4U, buffer.getCapacity());
+
+    // Several rounds through the slots
+    SharedBufferPointer p;
+    for (size_t i = 0; i < 20; ++i)
+    {
+        EXPECT_TRUE(buffer.append(p, static_cast<uint8_t>(i)));
+        uint8_t flags = 0;
+        EXPECT_TRUE(buffer.pop(p, flags));
+        EXPECT_EQ(i, flags);
+    }
+}
+
+namespace
+{
+class MpscProducerThread : public outpost::rtos::Thread
+{
+public:
+    MpscProducerThread(MpscSharedRingBuffer& buffer, uint8_t id, uint32_t count) :
+        Thread(0),
+        mBuffer(buffer),
+        mId(id),
+        mCount(count)
+    {
+    }
+
+protected:
+    void
+    run() override
+    {
+        SharedBufferPointer p;
+        for (uint32_t i = 0; i < mCount; i++)
+        {
+            // The flags carry the producer id and a sequence counter
+            const uint8_t flags = static_cast<uint8_t>((mId << 6) | (i & 0x3F));
+            while (!mBuffer.append(p, flags))
+            {
+                outpost::rtos::Thread::yield();
+            }
+        }
+
+        // Returning from a thread is not allowed, wait to be cancelled by the destructor
+        while (true)
+        {
+            outpost::rtos::Thread::sleep(outpost::time::Milliseconds(10));
+        }
+    }
+
+private:
+    MpscSharedRingBuffer& mBuffer;
+    const uint8_t mId;
+    const uint32_t mCount;
+};
+}  // namespace
+
+TEST(MpscSharedRingBufferTest, concurrentProducersShouldKeepTheirOrder)
+{
+    const uint32_t count = 10000;
+    const uint8_t numberOfProducers = 3;
+    MpscSharedRingBufferStorage<8> buffer;
+
+    MpscProducerThread producer0(buffer, 0, count);
+    MpscProducerThread producer1(buffer, 1, count);
+    MpscProducerThread producer2(buffer, 2, count);
+    producer0.start();
+    producer1.start();
+    producer2.start();
+
+    uint32_t received[numberOfProducers] = {};
+    uint32_t total = 0;
+    while (total < numberOfProducers * count)
+    {
+        SharedBufferPointer p;
+        uint8_t flags = 0;
+        if (buffer.pop(p, flags))
+        {
+            const uint8_t id = flags >> 6;
+            ASSERT_LT(id, numberOfProducers);
+            ASSERT_EQ(received[id] & 0x3F, flags & 0x3FU);
+            received[id]++;
+            total++;
+        }
+        else
+        {
+            outpost::rtos::Thread::yield();
+        }
+    }
+    EXPECT_TRUE(buffer.isEmpty());
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/container/object_pool.h>
+
+#include <unittest/harness.h>
+
+using outpost::utils::ObjectPointer;
+using outpost::utils::ObjectPool;
+using outpost::utils::ObjectPoolBase;
+
+namespace
+{
+struct Object
+{
+    Object(uint16_t id, int* liveObjects) : mId(id), mLiveObjects(liveObjects)
+    {
+        (*mLiveObjects)++;
+    }
+
+    ~Object()
+    {
+        (*mLiveObjects)--;
+    }
+
+    uint16_t mId;
+    int* mLiveObjects;
+};
+
+struct alignas(16) AlignedObject
+{
+    double mValue[2];
+};
+
+// Holds a reference to another object of the same pool
+struct Node
+{
+    ObjectPointer<Node> mNext;
+};
+}  // namespace
+
+TEST(ObjectPoolTest, shouldConstructAndDestroyObjects)
+{
+    int liveObjects = 0;
+    ObjectPool<Object, 2> pool;
+    EXPECT_EQ(2U, pool.numberOfElements());
+    EXPECT_EQ(2U, pool.numberOfFreeElements());
+
+    {
+        ObjectPointer<Object> p;
+        EXPECT_FALSE(p.isValid());
+        ASSERT_TRUE(pool.allocate(p, 7, &liveObjects));
+        EXPECT_TRUE(p.isValid());
+        EXPECT_EQ(7, p->mId);
+        EXPECT_EQ(1, liveObjects);
+        EXPECT_EQ(1U, p.getReferenceCount());
+        EXPECT_EQ(1U, pool.numberOfUsedElements());
+    }
+    EXPECT_EQ(0, liveObjects);
+    EXPECT_EQ(2U, pool.numberOfFreeElements());
+}
+
+TEST(ObjectPoolTest, shouldShareObjectsBetweenPointers)
+{
+    int liveObjects = 0;
+    ObjectPool<Object, 2> pool;
+
+    ObjectPointer<Object> p;
+    ASSERT_TRUE(pool.allocate(p, 1, &liveObjects));
+
+    ObjectPointer<Object> copy(p);
+    EXPECT_EQ(2U, p.getReferenceCount());
+    EXPECT_TRUE(copy == p);
+
+    ObjectPointer<Object> moved(std::move(copy));
+    EXPECT_FALSE(copy.isValid());
+    EXPECT_EQ(2U, p.getReferenceCount());
+
+    p.reset();
+    EXPECT_EQ(1, liveObjects);
+    EXPECT_EQ(1U, moved.getReferenceCount());
+
+    // Assigning a new object releases the previous one
+    ObjectPointer<Object> other;
+    ASSERT_TRUE(pool.allocate(other, 2, &liveObjects));
+    moved = other;
+    EXPECT_EQ(1, liveObjects);
+    EXPECT_EQ(2, moved->mId);
+    EXPECT_EQ(1U, pool.numberOfUsedElements());
+}
+
+TEST(ObjectPoolTest, shouldFailWhenExhaustedAndCountStatistics)
+{
+    int liveObjects = 0;
+    ObjectPool<Object, 2> pool;
+
+    ObjectPointer<Object> a;
+    ObjectPointer<Object> b;
+    ObjectPointer<Object> c;
+    EXPECT_TRUE(pool.allocate(a, 1, &liveObjects));
+    EXPECT_TRUE(pool.allocate(b, 2, &liveObjects));
+    EXPECT_FALSE(pool.allocate(c, 3, &liveObjects));
+    EXPECT_FALSE(c.isValid());
+    EXPECT_EQ(2, liveObjects);
+
+    EXPECT_EQ(2U, pool.getNumberOfAllocations());
+    EXPECT_EQ(1U, pool.getNumberOfFailedAllocations());
+    EXPECT_EQ(2U, pool.getHighWaterMark());
+
+    a.reset();
+    pool.resetCounters();
+    EXPECT_EQ(0U, pool.getNumberOfAllocations());
+    EXPECT_EQ(0U, pool.getNumberOfFailedAllocations());
+    EXPECT_EQ(1U, pool.getHighWaterMark());
+
+    // Released slots are reused
+    EXPECT_TRUE(pool.allocate(c, 3, &liveObjects));
+}
+
+TEST(ObjectPoolTest, shouldAlignObjects)
+{
+    ObjectPool<AlignedObject, 3> pool;
+    ObjectPointer<AlignedObject> pointers[3];
+    for (ObjectPointer<AlignedObject>& p : pointers)
+    {
+        ASSERT_TRUE(pool.allocate(p));
+        EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(p.get()) % alignof(AlignedObject));
+    }
+}
+
+TEST(ObjectPoolTest, destructorMayReleaseObjectsOfTheSamePool)
+{
+    ObjectPool<Node, 3> pool;
+    ObjectPoolBase<Node>& base = pool;
+
+    ObjectPointer<Node> head;
+    ASSERT_TRUE(base.allocate(head));
+    ASSERT_TRUE(base.allocate(head->mNext));
+    ASSERT_TRUE(base.allocate(head->mNext->mNext));
+    EXPECT_EQ(0U, pool.numberOfFreeElements());
+
+    head.reset();
+    EXPECT_EQ(3U, pool.numberOfFreeElements());
+}
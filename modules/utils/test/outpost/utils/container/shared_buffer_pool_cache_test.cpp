@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos/semaphore.h>
+#include <outpost/rtos/thread.h>
+#include <outpost/utils/container/reference_queue.h>
+#include <outpost/utils/container/shared_buffer_pool_cache.h>
+
+#include <unittest/harness.h>
+
+using outpost::utils::SharedBufferPointer;
+
+class SharedBufferPoolCacheTest : public testing::Test
+{
+public:
+    static constexpr size_t poolSize = 8;
+
+    outpost::utils::SharedBufferPool<16, poolSize> mPool;
+};
+
+constexpr size_t SharedBufferPoolCacheTest::poolSize;
+
+TEST_F(SharedBufferPoolCacheTest, shouldRefillInBatches)
+{
+    outpost::utils::SharedBufferPoolCache<4> cache(mPool);
+
+    SharedBufferPointer first;
+    ASSERT_TRUE(cache.allocate(first));
+    EXPECT_EQ(16U, first.getLength());
+    EXPECT_EQ(poolSize - 2, mPool.numberOfFreeElements());
+    EXPECT_EQ(1U, cache.numberOfCachedElements());
+    EXPECT_EQ(poolSize - 1, cache.numberOfFreeElements());
+
+    SharedBufferPointer second;
+    ASSERT_TRUE(cache.allocate(second));
+    EXPECT_EQ(1U, cache.getNumberOfRefills());
+
+    SharedBufferPointer third;
+    ASSERT_TRUE(cache.allocate(third));
+    EXPECT_EQ(2U, cache.getNumberOfRefills());
+    EXPECT_EQ(poolSize - 4, mPool.numberOfFreeElements());
+    EXPECT_EQ(3U, cache.getNumberOfAllocations());
+}
+
+TEST_F(SharedBufferPoolCacheTest, shouldReuseReleasedBuffers)
+{
+    outpost::utils::SharedBufferPoolCache<4> cache(mPool);
+
+    SharedBufferPointer first;
+    ASSERT_TRUE(cache.allocate(first));
+    first = SharedBufferPointer();
+    EXPECT_EQ(2U, cache.numberOfCachedElements());
+
+    // the released buffer is collected once the magazine is empty
+    SharedBufferPointer second;
+    SharedBufferPointer third;
+    ASSERT_TRUE(cache.allocate(second));
+    ASSERT_TRUE(cache.allocate(third));
+    EXPECT_EQ(0U, cache.numberOfCachedElements());
+    EXPECT_EQ(1U, cache.getNumberOfRefills());
+    EXPECT_EQ(poolSize - 2, mPool.numberOfFreeElements());
+}
+
+TEST_F(SharedBufferPoolCacheTest, shouldPutExcessBuffersBackIntoPool)
+{
+    outpost::utils::SharedBufferPoolCache<2> cache(mPool, 1);
+
+    SharedBufferPointer pointers[4];
+    for (auto& p : pointers)
+    {
+        ASSERT_TRUE(cache.allocate(p));
+    }
+    EXPECT_EQ(4U, cache.getNumberOfRefills());
+    EXPECT_EQ(poolSize - 4, mPool.numberOfFreeElements());
+
+    for (auto& p : pointers)
+    {
+        p = SharedBufferPointer();
+    }
+    EXPECT_EQ(4U, cache.numberOfCachedElements());
+    EXPECT_EQ(poolSize, cache.numberOfFreeElements());
+
+    // two fit into the magazine, the others go back with one lock
+    ASSERT_TRUE(cache.allocate(pointers[0]));
+    EXPECT_EQ(poolSize - 2, mPool.numberOfFreeElements());
+    EXPECT_EQ(1U, cache.numberOfCachedElements());
+    EXPECT_EQ(4U, cache.getNumberOfRefills());
+}
+
+TEST_F(SharedBufferPoolCacheTest, shouldFlushBuffers)
+{
+    {
+        outpost::utils::SharedBufferPoolCache<4> cache(mPool);
+        SharedBufferPointer pointer;
+        ASSERT_TRUE(cache.allocate(pointer));
+        ASSERT_TRUE(cache.allocate(pointer));
+
+        cache.flush();
+        EXPECT_EQ(0U, cache.numberOfCachedElements());
+        EXPECT_EQ(poolSize - 1, mPool.numberOfFreeElements());
+
+        // released to the cache after the flush, given back by the destructor
+        pointer = SharedBufferPointer();
+        EXPECT_EQ(poolSize - 1, mPool.numberOfFreeElements());
+    }
+    EXPECT_EQ(poolSize, mPool.numberOfFreeElements());
+
+    // buffers back in the pool are owned by it again
+    SharedBufferPointer pointer;
+    ASSERT_TRUE(mPool.allocate(pointer));
+    pointer = SharedBufferPointer();
+    EXPECT_EQ(poolSize, mPool.numberOfFreeElements());
+}
+
+TEST_F(SharedBufferPoolCacheTest, shouldFailIfPoolIsExhausted)
+{
+    outpost::utils::SharedBufferPoolCache<4> cache(mPool);
+    SharedBufferPointer pointers[poolSize];
+    for (auto& p : pointers)
+    {
+        ASSERT_TRUE(cache.allocate(p));
+    }
+
+    SharedBufferPointer pointer;
+    EXPECT_FALSE(cache.allocate(pointer));
+    EXPECT_EQ(1U, cache.getNumberOfFailedAllocations());
+    EXPECT_EQ(poolSize, cache.getHighWaterMark());
+    EXPECT_EQ(0U, cache.numberOfFreeElements());
+}
+
+namespace
+{
+class ConsumerThread : public outpost::rtos::Thread
+{
+public:
+    ConsumerThread(outpost::utils::SharedBufferQueueBase& queue, size_t packets) :
+        Thread(0),
+        mQueue(queue),
+        mPackets(packets),
+        mDone(outpost::rtos::BinarySemaphore::State::acquired)
+    {
+    }
+
+    void
+    waitUntilDone()
+    {
+        mDone.acquire();
+    }
+
+protected:
+    void
+    run() override
+    {
+        for (size_t i = 0; i < mPackets; i++)
+        {
+            SharedBufferPointer p;
+            mQueue.receive(p, outpost::time::Seconds(10));
+        }
+        mDone.release();
+
+        // Returning from a thread is not allowed, wait to be cancelled by the destructor
+        while (true)
+        {
+            outpost::rtos::Thread::sleep(outpost::time::Milliseconds(10));
+        }
+    }
+
+private:
+    outpost::utils::SharedBufferQueueBase& mQueue;
+    const size_t mPackets;
+    outpost::rtos::BinarySemaphore mDone;
+};
+}  // namespace
+
+TEST_F(SharedBufferPoolCacheTest, shouldTakeBuffersReleasedByOtherThread)
+{
+    const size_t packets = 5000;
+    outpost::utils::SharedBufferQueue<4> queue;
+    outpost::utils::SharedBufferPoolCache<4> cache(mPool);
+    {
+        ConsumerThread consumer(queue, packets);
+        consumer.start();
+
+        for (size_t i = 0; i < packets; i++)
+        {
+            SharedBufferPointer p;
+            while (!cache.allocate(p))
+            {
+                outpost::rtos::Thread::yield();
+            }
+            ASSERT_TRUE(queue.send(p, outpost::time::Seconds(10)));
+        }
+        consumer.waitUntilDone();
+    }
+
+    EXPECT_EQ(packets, cache.getNumberOfAllocations());
+    cache.flush();
+    EXPECT_EQ(poolSize, mPool.numberOfFreeElements());
+}
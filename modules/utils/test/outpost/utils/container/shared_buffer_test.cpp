@@ -12,14 +12,20 @@
  * - 2018, Fabian Greif (DLR RY-AVS)
  */
 
+#include <outpost/rtos/event_group.h>
+#include <outpost/rtos/semaphore.h>
 #include <outpost/rtos/thread.h>
 #include <outpost/utils/container/shared_buffer.h>
+#include <outpost/utils/container/reference_queue.h>
 #include <outpost/utils/container/shared_object_pool.h>
+#include <outpost/utils/container/shared_ring_buffer.h>
 #include <outpost/utils/storage/serialize.h>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <type_traits>
+
 #include <unittest/utils/container/reference_queue_stub.h>
 
 using namespace testing;
@@ -113,6 +119,252 @@ TEST_F(SharedBufferTest, constructorTest)
     EXPECT_EQ(p1->getReferenceCount(), 3U);
 }
 
+TEST_F(SharedBufferTest, moveConstructorTest)
+{
+    outpost::utils::SharedBufferPointer p1;
+    ASSERT_TRUE(mPool.allocate(p1));
+    p1.setType(5);
+    size_t length = p1.getLength();
+
+    outpost::utils::SharedBufferPointer p2(std::move(p1));
+    EXPECT_FALSE(p1.isValid());
+    EXPECT_EQ(p1.getLength(), 0U);
+    EXPECT_TRUE(p2.isValid());
+    EXPECT_EQ(p2->getReferenceCount(), 1U);
+    EXPECT_EQ(p2.getType(), 5U);
+    EXPECT_EQ(p2.getLength(), length);
+
+    outpost::utils::SharedBufferPointer p3;
+    ASSERT_TRUE(mPool.allocate(p3));
+    EXPECT_EQ(mPool.numberOfFreeElements(), poolSize - 2);
+
+    // Moving into an occupied pointer releases the previous buffer
+    p3 = std::move(p2);
+    EXPECT_FALSE(p2.isValid());
+    EXPECT_EQ(p3->getReferenceCount(), 1U);
+    EXPECT_EQ(mPool.numberOfFreeElements(), poolSize - 1);
+}
+
+TEST_F(SharedBufferTest, moveChildPointer)
+{
+    outpost::utils::SharedBufferPointer parent;
+    ASSERT_TRUE(mPool.allocate(parent));
+
+    outpost::utils::SharedChildPointer ch1;
+    ASSERT_TRUE(parent.getChild(ch1, 1, 2, 3));
+    EXPECT_EQ(parent->getReferenceCount(), 3U);
+
+    outpost::utils::SharedChildPointer ch2(std::move(ch1));
+    EXPECT_FALSE(ch1.isValid());
+    EXPECT_FALSE(ch1.isChild());
+    EXPECT_TRUE(ch2.isChild());
+    EXPECT_EQ(ch2.getType(), 1U);
+    EXPECT_EQ(ch2.getLength(), 3U);
+    EXPECT_EQ(parent->getReferenceCount(), 3U);
+
+    outpost::utils::SharedChildPointer ch3;
+    ch3 = std::move(ch2);
+    EXPECT_FALSE(ch2.isValid());
+    EXPECT_TRUE(ch3.isChild());
+    EXPECT_EQ(parent->getReferenceCount(), 3U);
+}
+
+TEST_F(SharedBufferTest, pointerIsCompact)
+{
+    static_assert(sizeof(outpost::utils::SharedBufferPointer) <= 2 * sizeof(void*) + 8,
+                  "SharedBufferPointer must not grow beyond a pointer plus two words");
+    static_assert(std::is_standard_layout<outpost::utils::SharedBufferPointer>::value,
+                  "SharedBufferPointer must not have virtual functions");
+
+    outpost::utils::SharedBufferPointer parent;
+    ASSERT_TRUE(mPool.allocate(parent));
+
+    outpost::utils::SharedChildPointer child;
+    ASSERT_TRUE(parent.getChild(child, 1, 2, 3));
+
+    // The child property survives slicing into the base class
+    outpost::utils::SharedBufferPointer copy = child;
+    EXPECT_TRUE(copy.isChild());
+    EXPECT_EQ(copy.getLength(), 3U);
+    EXPECT_FALSE(parent.isChild());
+
+    copy = parent;
+    EXPECT_FALSE(copy.isChild());
+}
+
+TEST_F(SharedBufferTest, moveThroughReferenceQueue)
+{
+    outpost::utils::SharedBufferQueue<2> queue;
+
+    outpost::utils::SharedBufferPointer p1;
+    ASSERT_TRUE(mPool.allocate(p1));
+    outpost::utils::SharedBufferPointer p2(p1);
+    EXPECT_EQ(p1->getReferenceCount(), 2U);
+
+    EXPECT_TRUE(queue.send(std::move(p2)));
+    EXPECT_FALSE(p2.isValid());
+    EXPECT_EQ(p1->getReferenceCount(), 2U);
+
+    outpost::utils::SharedBufferPointer received;
+    EXPECT_TRUE(queue.receive(received, outpost::time::Duration::zero()));
+    EXPECT_TRUE(received == p1);
+    EXPECT_EQ(p1->getReferenceCount(), 2U);
+}
+
+TEST_F(SharedBufferTest, moveFailsOnFullReferenceQueue)
+{
+    outpost::utils::SharedBufferQueue<1> queue;
+
+    outpost::utils::SharedBufferPointer p1;
+    ASSERT_TRUE(mPool.allocate(p1));
+    EXPECT_TRUE(queue.send(p1));
+
+    outpost::utils::SharedBufferPointer p2;
+    ASSERT_TRUE(mPool.allocate(p2));
+    EXPECT_FALSE(queue.send(std::move(p2)));
+    EXPECT_TRUE(p2.isValid());
+    EXPECT_EQ(p2->getReferenceCount(), 1U);
+}
+
+TEST_F(SharedBufferTest, referenceQueueKeepsOrderAcrossWrapAround)
+{
+    outpost::utils::SharedBufferQueue<2> queue;
+    EXPECT_TRUE(queue.isEmpty());
+
+    outpost::utils::SharedBufferPointer p1;
+    outpost::utils::SharedBufferPointer p2;
+    ASSERT_TRUE(mPool.allocate(p1));
+    ASSERT_TRUE(mPool.allocate(p2));
+
+    outpost::utils::SharedBufferPointer received;
+    for (size_t i = 0; i < 5; i++)
+    {
+        EXPECT_TRUE(queue.send(p1));
+        EXPECT_TRUE(queue.send(p2));
+        EXPECT_TRUE(queue.isFull());
+        EXPECT_EQ(queue.getNumberOfItems(), 2U);
+
+        EXPECT_TRUE(queue.receive(received, outpost::time::Duration::zero()));
+        EXPECT_TRUE(received == p1);
+        EXPECT_TRUE(queue.receive(received, outpost::time::Duration::zero()));
+        EXPECT_TRUE(received == p2);
+        EXPECT_TRUE(queue.isEmpty());
+    }
+
+    // the queue does not keep references to received elements
+    EXPECT_EQ(p1->getReferenceCount(), 1U);
+    EXPECT_EQ(p2->getReferenceCount(), 2U);
+    EXPECT_FALSE(queue.receive(received, outpost::time::Milliseconds(1)));
+}
+
+TEST_F(SharedBufferTest, referenceQueueSetsEventBitsOnSend)
+{
+    outpost::utils::SharedBufferQueue<2> queue;
+    outpost::rtos::EventGroup events;
+    EXPECT_TRUE(queue.setEventNotification(&events, 0x04));
+
+    outpost::utils::SharedBufferPointer p1;
+    ASSERT_TRUE(mPool.allocate(p1));
+
+    EXPECT_EQ(0U, events.waitAny(0x04, outpost::time::Duration::zero()));
+    EXPECT_TRUE(queue.send(p1));
+    EXPECT_EQ(0x04U, events.get());
+    EXPECT_EQ(0x04U, events.waitAny(0x06, outpost::time::Duration::zero()));
+    EXPECT_EQ(0U, events.get());
+
+    // No notification for failed sends
+    EXPECT_TRUE(queue.send(p1));
+    events.clear(0x04);
+    EXPECT_FALSE(queue.send(p1));
+    EXPECT_EQ(0U, events.get());
+
+    queue.setEventNotification(nullptr, 0);
+    outpost::utils::SharedBufferPointer received;
+    EXPECT_TRUE(queue.receive(received, outpost::time::Duration::zero()));
+    EXPECT_TRUE(queue.send(p1));
+    EXPECT_EQ(0U, events.get());
+}
+
+TEST_F(SharedBufferTest, moveThroughNativeReferenceQueue)
+{
+    outpost::utils::NativeSharedBufferQueue<2> queue;
+    EXPECT_TRUE(queue.isEmpty());
+
+    outpost::utils::SharedBufferPointer p1;
+    ASSERT_TRUE(mPool.allocate(p1));
+    outpost::utils::SharedBufferPointer p2(p1);
+
+    EXPECT_TRUE(queue.send(std::move(p2)));
+    EXPECT_FALSE(p2.isValid());
+    EXPECT_EQ(p1->getReferenceCount(), 2U);
+    EXPECT_EQ(queue.getNumberOfItems(), 1U);
+
+    outpost::utils::SharedBufferPointer received;
+    EXPECT_TRUE(queue.receive(received, outpost::time::Duration::zero()));
+    EXPECT_TRUE(received == p1);
+    EXPECT_EQ(p1->getReferenceCount(), 2U);
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_FALSE(queue.receive(received, outpost::time::Milliseconds(1)));
+}
+
+TEST_F(SharedBufferTest, nativeReferenceQueueReusesSlots)
+{
+    outpost::utils::NativeSharedBufferQueue<2> queue;
+
+    outpost::utils::SharedBufferPointer p1;
+    outpost::utils::SharedBufferPointer p2;
+    outpost::utils::SharedBufferPointer p3;
+    ASSERT_TRUE(mPool.allocate(p1));
+    ASSERT_TRUE(mPool.allocate(p2));
+    ASSERT_TRUE(mPool.allocate(p3));
+
+    outpost::utils::SharedBufferPointer received;
+    EXPECT_TRUE(queue.send(p1));
+    for (size_t i = 0; i < 5; i++)
+    {
+        EXPECT_TRUE(queue.send(p2));
+        EXPECT_TRUE(queue.isFull());
+        EXPECT_FALSE(queue.send(std::move(p3)));
+        EXPECT_TRUE(p3.isValid());
+
+        EXPECT_TRUE(queue.receive(received, outpost::time::Duration::zero()));
+        EXPECT_TRUE(received == p1);
+        EXPECT_TRUE(queue.send(p1));
+        EXPECT_TRUE(queue.receive(received, outpost::time::Duration::zero()));
+        EXPECT_TRUE(received == p2);
+    }
+    EXPECT_TRUE(queue.receive(received, outpost::time::Duration::zero()));
+    EXPECT_TRUE(received == p1);
+    EXPECT_TRUE(queue.isEmpty());
+
+    // the queue does not keep references to received elements
+    EXPECT_EQ(p1->getReferenceCount(), 2U);
+    EXPECT_EQ(p2->getReferenceCount(), 1U);
+    EXPECT_EQ(p3->getReferenceCount(), 1U);
+}
+
+TEST_F(SharedBufferTest, moveThroughSharedRingBuffer)
+{
+    outpost::utils::SharedRingBufferStorage<2> ringBuffer;
+
+    outpost::utils::SharedBufferPointer p1;
+    ASSERT_TRUE(mPool.allocate(p1));
+    outpost::utils::SharedBufferPointer p2(p1);
+
+    EXPECT_TRUE(ringBuffer.append(std::move(p2), 3));
+    EXPECT_FALSE(p2.isValid());
+    EXPECT_EQ(p1->getReferenceCount(), 2U);
+    EXPECT_EQ(ringBuffer.readFlags(), 3U);
+
+    outpost::utils::SharedBufferPointer head;
+    EXPECT_TRUE(ringBuffer.pop(head));
+    EXPECT_TRUE(head == p1);
+    EXPECT_TRUE(ringBuffer.isEmpty());
+    EXPECT_EQ(p1->getReferenceCount(), 2U);
+
+    EXPECT_FALSE(ringBuffer.pop(head));
+}
+
 TEST_F(SharedBufferTest, deleteParentFirst)
 {
     {
@@ -325,6 +577,220 @@ TEST_F(SharedBufferTest, threeElementPool)
     EXPECT_TRUE(pool.allocate(p3));
 }
 
+TEST_F(SharedBufferTest, sizeClassPoolChoosesBufferByLength)
+{
+    outpost::utils::SizeClassSharedBufferPool<4, 1, 16, 1> pool;
+    outpost::utils::SharedBufferPointer small, large, fallback;
+
+    ASSERT_TRUE(pool.allocateForLength(small, 3));
+    EXPECT_EQ(4U, small.getLength());
+    ASSERT_TRUE(pool.allocateForLength(fallback, 2));
+    EXPECT_EQ(16U, fallback.getLength());
+
+    // large content is never put into a small buffer
+    small = outpost::utils::SharedBufferPointer();
+    EXPECT_FALSE(pool.allocateForLength(large, 10));
+    EXPECT_EQ(1U, pool.numberOfFreeElements());
+    EXPECT_EQ(1U, pool.getNumberOfFailedAllocations());
+
+    fallback = outpost::utils::SharedBufferPointer();
+    ASSERT_TRUE(pool.allocateForLength(large, 10));
+    EXPECT_EQ(16U, large.getLength());
+    EXPECT_EQ(2U, pool.getHighWaterMark());
+}
+
+TEST_F(SharedBufferTest, alignedPoolSeparatesBuffers)
+{
+    outpost::utils::SharedBufferPool<10, 3, 32> pool;
+    EXPECT_EQ(32U, pool.getStride());
+
+    outpost::utils::SharedBufferPointer p1, p2, p3;
+    ASSERT_TRUE(pool.allocate(p1));
+    ASSERT_TRUE(pool.allocate(p2));
+    ASSERT_TRUE(pool.allocate(p3));
+    EXPECT_EQ(10U, p1.getLength());
+
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(&p1[0]) % 32);
+    EXPECT_EQ(32, &p2[0] - &p1[0]);
+    EXPECT_EQ(32, &p3[0] - &p2[0]);
+}
+
+TEST_F(SharedBufferTest, poolSetsUpBuffersOnFirstAllocation)
+{
+    outpost::utils::SharedBufferPool<8, 3> pool;
+    EXPECT_EQ(3U, pool.numberOfFreeElements());
+
+    outpost::utils::SharedBufferPointer p1, p2, p3;
+    ASSERT_TRUE(pool.allocate(p1));
+    ASSERT_TRUE(pool.allocate(p2));
+    EXPECT_EQ(8, &p2[0] - &p1[0]);
+
+    // A released buffer is preferred over one which has never been used
+    outpost::utils::SharedBuffer* released = &(*p1);
+    p1 = outpost::utils::SharedBufferPointer();
+    ASSERT_TRUE(pool.allocate(p1));
+    EXPECT_TRUE(p1 == released);
+
+    ASSERT_TRUE(pool.allocate(p3));
+    EXPECT_EQ(8, &p3[0] - &p2[0]);
+    EXPECT_EQ(8U, p3.getLength());
+    EXPECT_EQ(0U, pool.numberOfFreeElements());
+    EXPECT_FALSE(pool.allocate(p3));
+}
+
+TEST_F(SharedBufferTest, externalPoolUsesCallerMemory)
+{
+    typedef outpost::utils::ExternalSharedBufferPool<4> Pool;
+    uint8_t memory[Pool::getRequiredMemory(20, 16)];
+
+    // Start at an odd address to force skipping bytes for the alignment
+    outpost::Slice<uint8_t> slice = outpost::asSlice(memory).skipFirst(1);
+    Pool pool(slice, 20, 16);
+    EXPECT_EQ(4U, pool.numberOfElements());
+    EXPECT_EQ(32U, pool.getStride());
+
+    outpost::utils::SharedBufferPointer pointers[4];
+    for (auto& pointer : pointers)
+    {
+        ASSERT_TRUE(pool.allocate(pointer));
+        EXPECT_EQ(20U, pointer.getLength());
+        EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(&pointer[0]) % 16);
+        EXPECT_GE(&pointer[0], slice.begin());
+        EXPECT_LE(&pointer[0] + 20, slice.end());
+    }
+    outpost::utils::SharedBufferPointer p;
+    EXPECT_FALSE(pool.allocate(p));
+
+    pointers[0] = outpost::utils::SharedBufferPointer();
+    EXPECT_EQ(1U, pool.numberOfFreeElements());
+}
+
+TEST_F(SharedBufferTest, externalPoolIsLimitedByMemory)
+{
+    uint8_t memory[100];
+    outpost::utils::ExternalSharedBufferPool<8> pool(outpost::asSlice(memory), 20, 4);
+    EXPECT_GE(pool.numberOfElements(), 4U);
+    EXPECT_LE(pool.numberOfElements(), 5U);
+
+    outpost::utils::ExternalSharedBufferPool<8> empty(outpost::asSlice(memory).first(10), 20, 4);
+    EXPECT_EQ(0U, empty.numberOfElements());
+    outpost::utils::SharedBufferPointer p;
+    EXPECT_FALSE(empty.allocate(p));
+}
+
+TEST_F(SharedBufferTest, releasedBufferIsReused)
+{
+    outpost::utils::SharedBufferPool<1, 2> pool;
+    outpost::utils::SharedBufferPointer p1, p2, p3;
+    ASSERT_TRUE(pool.allocate(p1));
+    ASSERT_TRUE(pool.allocate(p2));
+    EXPECT_FALSE(pool.allocate(p3));
+    EXPECT_EQ(pool.numberOfFreeElements(), 0U);
+
+    outpost::utils::SharedBuffer* released = &(*p1);
+    p1 = outpost::utils::SharedBufferPointer();
+    EXPECT_EQ(pool.numberOfFreeElements(), 1U);
+
+    ASSERT_TRUE(pool.allocate(p3));
+    EXPECT_TRUE(p3 == released);
+    EXPECT_EQ(pool.numberOfFreeElements(), 0U);
+}
+
+TEST_F(SharedBufferTest, childKeepsBufferAllocated)
+{
+    outpost::utils::SharedBufferPool<4, 1> pool;
+    outpost::utils::SharedChildPointer child;
+    {
+        outpost::utils::SharedBufferPointer p;
+        ASSERT_TRUE(pool.allocate(p));
+        ASSERT_TRUE(p.getChild(child, 0, 1, 2));
+    }
+    EXPECT_EQ(pool.numberOfFreeElements(), 0U);
+
+    child = outpost::utils::SharedChildPointer();
+    EXPECT_EQ(pool.numberOfFreeElements(), 1U);
+}
+
+TEST_F(SharedBufferTest, failedAllocationKeepsPointer)
+{
+    outpost::utils::SharedBufferPool<1, 1> pool;
+    outpost::utils::SharedBufferPointer p;
+    ASSERT_TRUE(pool.allocate(p));
+
+    EXPECT_FALSE(pool.allocate(p));
+    EXPECT_TRUE(p.isValid());
+    EXPECT_EQ(pool.numberOfFreeElements(), 0U);
+}
+
+TEST_F(SharedBufferTest, poolStatistics)
+{
+    outpost::utils::SharedBufferPool<1, 3> pool;
+    EXPECT_EQ(pool.getNumberOfAllocations(), 0U);
+    EXPECT_EQ(pool.getHighWaterMark(), 0U);
+
+    {
+        outpost::utils::SharedBufferPointer p1, p2, p3, p4;
+        EXPECT_TRUE(pool.allocate(p1));
+        EXPECT_TRUE(pool.allocate(p2));
+        EXPECT_EQ(pool.numberOfUsedElements(), 2U);
+        p1 = outpost::utils::SharedBufferPointer();
+
+        EXPECT_TRUE(pool.allocate(p1));
+        EXPECT_TRUE(pool.allocate(p3));
+        EXPECT_FALSE(pool.allocate(p4));
+
+        EXPECT_EQ(pool.getNumberOfAllocations(), 4U);
+        EXPECT_EQ(pool.getNumberOfFailedAllocations(), 1U);
+        EXPECT_EQ(pool.getHighWaterMark(), 3U);
+        EXPECT_EQ(pool.numberOfUsedElements(), 3U);
+
+        p3 = outpost::utils::SharedBufferPointer();
+        pool.resetCounters();
+        EXPECT_EQ(pool.getNumberOfAllocations(), 0U);
+        EXPECT_EQ(pool.getNumberOfFailedAllocations(), 0U);
+        EXPECT_EQ(pool.getHighWaterMark(), 2U);
+    }
+
+    EXPECT_EQ(pool.numberOfUsedElements(), 0U);
+    EXPECT_EQ(pool.getHighWaterMark(), 2U);
+}
+
+class ReleaseCounter : public outpost::Callable
+{
+public:
+    ReleaseCounter() : mCalls(0), mFreeElements(0)
+    {
+    }
+
+    void
+    onRelease(outpost::utils::SharedBufferPoolBase& pool)
+    {
+        mCalls++;
+        mFreeElements = pool.numberOfFreeElements();
+    }
+
+    size_t mCalls;
+    size_t mFreeElements;
+};
+
+TEST_F(SharedBufferTest, releaseCallbackIsCalledForLastReference)
+{
+    outpost::utils::SharedBufferPool<4, 2> pool;
+    ReleaseCounter counter;
+    pool.setReleaseCallback(&counter, &ReleaseCounter::onRelease);
+
+    outpost::utils::SharedBufferPointer p1;
+    ASSERT_TRUE(pool.allocate(p1));
+    outpost::utils::SharedBufferPointer p2(p1);
+
+    p1 = outpost::utils::SharedBufferPointer();
+    EXPECT_EQ(counter.mCalls, 0U);
+
+    p2 = outpost::utils::SharedBufferPointer();
+    EXPECT_EQ(counter.mCalls, 1U);
+    EXPECT_EQ(counter.mFreeElements, 2U);
+}
+
 TEST_F(SharedBufferTest, allocateChildChildBuffer)
 {
     {
@@ -385,3 +851,228 @@ TEST_F(SharedBufferTest, allocateChildChildBuffer)
 
     EXPECT_EQ(mPool.numberOfFreeElements(), poolSize);
 }
+
+class SharedBufferCopyThread : public outpost::rtos::Thread
+{
+public:
+    SharedBufferCopyThread(const outpost::utils::SharedBufferPointer& pointer, size_t iterations) :
+        Thread(0),
+        mPointer(pointer),
+        mIterations(iterations),
+        mDone(outpost::rtos::BinarySemaphore::State::acquired)
+    {
+    }
+
+    void
+    waitUntilDone()
+    {
+        mDone.acquire();
+    }
+
+protected:
+    void
+    run() override
+    {
+        for (size_t i = 0; i < mIterations; i++)
+        {
+            outpost::utils::SharedBufferPointer copy(mPointer);
+            outpost::utils::SharedBufferPointer assigned;
+            assigned = copy;
+        }
+        mDone.release();
+
+        // Returning from a thread is not allowed, wait to be cancelled by the destructor
+        while (true)
+        {
+            outpost::rtos::Thread::sleep(outpost::time::Milliseconds(10));
+        }
+    }
+
+private:
+    const outpost::utils::SharedBufferPointer& mPointer;
+    const size_t mIterations;
+    outpost::rtos::BinarySemaphore mDone;
+};
+
+TEST_F(SharedBufferTest, concurrentReferenceCounting)
+{
+    outpost::utils::SharedBufferPointer p;
+    ASSERT_TRUE(mPool.allocate(p));
+
+    {
+        SharedBufferCopyThread first(p, 20000);
+        SharedBufferCopyThread second(p, 20000);
+        first.start();
+        second.start();
+
+        first.waitUntilDone();
+        second.waitUntilDone();
+    }
+
+    EXPECT_EQ(p->getReferenceCount(), 1U);
+    EXPECT_EQ(mPool.numberOfFreeElements(), poolSize - 1);
+}
+
+class DelayedReceiveThread : public outpost::rtos::Thread
+{
+public:
+    explicit DelayedReceiveThread(outpost::utils::SharedBufferQueueBase& queue) :
+        Thread(0), mQueue(queue), mDone(outpost::rtos::BinarySemaphore::State::acquired)
+    {
+    }
+
+    void
+    waitUntilDone()
+    {
+        mDone.acquire();
+    }
+
+protected:
+    void
+    run() override
+    {
+        outpost::rtos::Thread::sleep(outpost::time::Milliseconds(20));
+        outpost::utils::SharedBufferPointer p;
+        mQueue.receive(p, outpost::time::Duration::zero());
+        mDone.release();
+
+        // Returning from a thread is not allowed, wait to be cancelled by the destructor
+        while (true)
+        {
+            outpost::rtos::Thread::sleep(outpost::time::Milliseconds(10));
+        }
+    }
+
+private:
+    outpost::utils::SharedBufferQueueBase& mQueue;
+    outpost::rtos::BinarySemaphore mDone;
+};
+
+static void
+sendWaitsForFreeSlot(outpost::utils::SharedBufferPoolBase& pool,
+                     outpost::utils::SharedBufferQueueBase& queue)
+{
+    outpost::utils::SharedBufferPointer p1;
+    ASSERT_TRUE(pool.allocate(p1));
+    EXPECT_TRUE(queue.send(p1));
+
+    outpost::utils::SharedBufferPointer p2;
+    ASSERT_TRUE(pool.allocate(p2));
+    EXPECT_FALSE(queue.send(std::move(p2), outpost::time::Milliseconds(10)));
+    EXPECT_TRUE(p2.isValid());
+
+    DelayedReceiveThread receiver(queue);
+    receiver.start();
+
+    outpost::rtos::SystemClock clock;
+    const outpost::time::SpacecraftElapsedTime start = clock.now();
+    EXPECT_TRUE(queue.send(std::move(p2), outpost::time::Seconds(10)));
+    EXPECT_LT(clock.now() - start, outpost::time::Seconds(5));
+    EXPECT_FALSE(p2.isValid());
+    receiver.waitUntilDone();
+
+    EXPECT_EQ(queue.getNumberOfItems(), 1U);
+}
+
+TEST_F(SharedBufferTest, referenceQueueSendWaitsForFreeSlot)
+{
+    outpost::utils::SharedBufferQueue<1> queue;
+    sendWaitsForFreeSlot(mPool, queue);
+}
+
+TEST_F(SharedBufferTest, nativeReferenceQueueSendWaitsForFreeSlot)
+{
+    outpost::utils::NativeSharedBufferQueue<1> queue;
+    sendWaitsForFreeSlot(mPool, queue);
+}
+
+TEST_F(SharedBufferTest, makeWritableDoesNotCopyExclusiveBuffer)
+{
+    outpost::utils::SharedBufferPointer pointer;
+    ASSERT_TRUE(mPool.allocate(pointer));
+    EXPECT_TRUE(pointer.isExclusive());
+    EXPECT_TRUE(pointer.makeWritable());
+    EXPECT_EQ(mPool.numberOfFreeElements(), poolSize - 1);
+
+    // the parent is released, the child is the only consumer left
+    outpost::utils::SharedChildPointer child;
+    ASSERT_TRUE(pointer.getChild(child, 1, 5, 5));
+    EXPECT_FALSE(child.isExclusive());
+    pointer = outpost::utils::SharedBufferPointer();
+    EXPECT_TRUE(child.isExclusive());
+    EXPECT_TRUE(child.makeWritable());
+    EXPECT_EQ(mPool.numberOfFreeElements(), poolSize - 1);
+
+    outpost::utils::SharedBufferPointer invalid;
+    EXPECT_FALSE(invalid.isExclusive());
+    EXPECT_FALSE(invalid.makeWritable());
+}
+
+TEST_F(SharedBufferTest, makeWritableCopiesSharedBuffer)
+{
+    outpost::utils::SharedBufferPointer pointer;
+    ASSERT_TRUE(mPool.allocate(pointer));
+    for (size_t i = 0; i < objectSize; i++)
+    {
+        pointer[i] = i;
+    }
+    pointer.setType(7);
+
+    outpost::utils::SharedBufferPointer consumer = pointer;
+    EXPECT_TRUE(consumer.makeWritable());
+    EXPECT_FALSE(consumer == pointer);
+    EXPECT_TRUE(consumer.isExclusive());
+    EXPECT_TRUE(pointer.isExclusive());
+    EXPECT_EQ(consumer.getType(), 7U);
+    EXPECT_EQ(consumer.getLength(), objectSize);
+    EXPECT_EQ(mPool.numberOfFreeElements(), poolSize - 2);
+
+    consumer[0] = 0xFF;
+    EXPECT_EQ(pointer[0], 0U);
+    EXPECT_EQ(consumer[1], 1U);
+}
+
+TEST_F(SharedBufferTest, makeWritableCopiesRangeOfChild)
+{
+    outpost::utils::SharedBufferPointer pointer;
+    ASSERT_TRUE(mPool.allocate(pointer));
+    for (size_t i = 0; i < objectSize; i++)
+    {
+        pointer[i] = i;
+    }
+
+    outpost::utils::SharedChildPointer child;
+    ASSERT_TRUE(pointer.getChild(child, 3, 10, 4));
+    EXPECT_TRUE(child.makeWritable());
+    EXPECT_FALSE(child.getOrigin() == pointer);
+    EXPECT_TRUE(child.isChild());
+    EXPECT_TRUE(child.isExclusive());
+    EXPECT_TRUE(child.getParent() == child);
+    EXPECT_EQ(child.getType(), 3U);
+    EXPECT_EQ(child.getLength(), 4U);
+    EXPECT_EQ(child[0], 10U);
+    EXPECT_EQ(child[3], 13U);
+    EXPECT_TRUE(pointer.isExclusive());
+}
+
+TEST_F(SharedBufferTest, makeWritableFailsWithoutPool)
+{
+    uint8_t data[4] = {1, 2, 3, 4};
+    outpost::utils::SharedBuffer buffer(outpost::asSlice(data));
+    outpost::utils::SharedBufferPointer pointer(&buffer);
+    outpost::utils::SharedBufferPointer consumer = pointer;
+    EXPECT_FALSE(consumer.makeWritable());
+    EXPECT_TRUE(consumer == pointer);
+}
+
+TEST_F(SharedBufferTest, prefaultedPoolIsUnchanged)
+{
+    outpost::utils::SharedBufferPool<64, 4> pool;
+    pool.prefault(true);
+    EXPECT_EQ(pool.numberOfFreeElements(), 4U);
+
+    outpost::utils::SharedBufferPointer p;
+    ASSERT_TRUE(pool.allocate(p));
+    EXPECT_EQ(p.getLength(), 64U);
+    EXPECT_EQ(pool.numberOfFreeElements(), 3U);
+}
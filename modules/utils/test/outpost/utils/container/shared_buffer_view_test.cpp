@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/container/shared_buffer_view.h>
+#include <outpost/utils/container/shared_object_pool.h>
+#include <outpost/utils/storage/serialize.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace outpost;
+using namespace outpost::utils;
+
+namespace
+{
+typedef PacketLayout<BitsField<5>, BitsField<11>, BigEndianField<uint32_t>, BigEndianField<float>>
+        Header;
+
+class SharedBufferViewTest : public testing::Test
+{
+public:
+    SharedBufferPool<16, 2> mPool;
+};
+}  // namespace
+
+TEST_F(SharedBufferViewTest, shouldBeInvalidWithoutBuffer)
+{
+    SharedBufferView<Header> view;
+    EXPECT_FALSE(view.isValid());
+
+    SharedChildPointer child;
+    EXPECT_FALSE(view.getPayload(child, 0));
+}
+
+TEST_F(SharedBufferViewTest, shouldBuildPacketInPlace)
+{
+    SharedBufferPointer buffer;
+    ASSERT_TRUE(mPool.allocate(buffer));
+
+    SharedBufferView<Header> view(buffer);
+    ASSERT_TRUE(view.isValid());
+    EXPECT_EQ(2U, buffer->getReferenceCount());
+
+    view.set<0>(0x11);
+    view.set<1>(0x234);
+    view.set<2>(0x56789ABC);
+    view.set<3>(3.14159f);
+    view.getPayload()[0] = 0xEE;
+
+    uint8_t expected[11];
+    Serialize stream(expected);
+    stream.store<uint16_t>(0x8A34);
+    stream.store<uint32_t>(0x56789ABC);
+    stream.store<float>(3.14159f);
+    stream.store<uint8_t>(0xEE);
+    for (size_t i = 0; i < sizeof(expected); ++i)
+    {
+        EXPECT_EQ(expected[i], buffer[i]) << i;
+    }
+    EXPECT_EQ(6U, view.getPayload().getNumberOfElements());
+}
+
+TEST_F(SharedBufferViewTest, shouldReadFieldsFromBuffer)
+{
+    SharedBufferPointer buffer;
+    ASSERT_TRUE(mPool.allocate(buffer));
+    Header::store(&buffer[0], 0x1F, 0x7FF, 0x01020304, -1.5f);
+
+    const SharedBufferView<Header> view(buffer);
+    EXPECT_EQ(0x1F, view.get<0>());
+    EXPECT_EQ(0x7FF, view.get<1>());
+    EXPECT_EQ(0x01020304U, view.get<2>());
+    EXPECT_FLOAT_EQ(-1.5f, view.get<3>());
+}
+
+TEST_F(SharedBufferViewTest, setShouldOnlyChangeTheField)
+{
+    SharedBufferPointer buffer;
+    ASSERT_TRUE(mPool.allocate(buffer));
+
+    SharedBufferView<Header> view(buffer);
+    view.store(0x15, 0x2AA, 0xFFFFFFFF, 0.0f);
+    view.set<0>(0x0A);
+
+    EXPECT_EQ(0x0A, view.get<0>());
+    EXPECT_EQ(0x2AA, view.get<1>());
+    EXPECT_EQ(0xFFFFFFFFU, view.get<2>());
+}
+
+TEST_F(SharedBufferViewTest, shouldReferencePayloadAsChild)
+{
+    SharedBufferPointer buffer;
+    ASSERT_TRUE(mPool.allocate(buffer));
+
+    SharedBufferView<Header> view(buffer);
+    SharedChildPointer child;
+    ASSERT_TRUE(view.getPayload(child, 7));
+    EXPECT_EQ(7U, child.getType());
+    EXPECT_EQ(6U, child.getLength());
+    EXPECT_EQ(&buffer[Header::size], &child[0]);
+}
+
+TEST_F(SharedBufferViewTest, shouldRejectTooSmallBuffers)
+{
+    typedef PacketLayout<BigEndianField<uint64_t>,
+                         BigEndianField<uint64_t>,
+                         BigEndianField<uint8_t>>
+            LargeHeader;
+
+    SharedBufferPointer buffer;
+    ASSERT_TRUE(mPool.allocate(buffer));
+
+    SharedBufferView<LargeHeader> view(buffer);
+    EXPECT_FALSE(view.isValid());
+}
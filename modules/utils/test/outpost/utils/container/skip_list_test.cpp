@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/container/skip_list.h>
+
+#include <unittest/harness.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace outpost;
+
+namespace
+{
+struct Node : public outpost::SkipListElement
+{
+    Node() : mValue(0), mIndex(0)
+    {
+    }
+
+    Node(uint32_t value, uint32_t index) : mValue(value), mIndex(index)
+    {
+    }
+
+    bool
+    operator<(const Node& other) const
+    {
+        return mValue < other.mValue;
+    }
+
+    uint32_t mValue;
+    uint32_t mIndex;
+};
+}  // namespace
+
+TEST(SkipListTest, shouldBeEmptyAfterConstruction)
+{
+    SkipList<Node> list;
+
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_EQ(0U, list.size());
+    EXPECT_EQ(nullptr, list.first());
+    EXPECT_EQ(nullptr, list.removeFirst());
+    EXPECT_TRUE(list.begin() == list.end());
+}
+
+TEST(SkipListTest, shouldKeepNodesSorted)
+{
+    SkipList<Node> list;
+    std::vector<Node> nodes;
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        nodes.push_back(Node(i, i));
+    }
+    std::mt19937 generator(1);
+    std::shuffle(nodes.begin(), nodes.end(), generator);
+
+    for (Node& node : nodes)
+    {
+        list.insert(&node);
+    }
+    EXPECT_EQ(1000U, list.size());
+
+    uint32_t expected = 0;
+    for (SkipList<Node>::Iterator it = list.begin(); it != list.end(); ++it)
+    {
+        EXPECT_EQ(expected, it->mValue);
+        expected++;
+    }
+    EXPECT_EQ(1000U, expected);
+
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(i, list.first()->mValue);
+        EXPECT_EQ(i, list.removeFirst()->mValue);
+    }
+    EXPECT_TRUE(list.isEmpty());
+}
+
+TEST(SkipListTest, equalNodesShouldKeepTheirInsertionOrder)
+{
+    SkipList<Node> list;
+    std::vector<Node> nodes;
+    for (uint32_t i = 0; i < 300; ++i)
+    {
+        nodes.push_back(Node(i % 3, i));
+    }
+    for (Node& node : nodes)
+    {
+        list.insert(&node);
+    }
+
+    uint32_t previousValue = 0;
+    uint32_t previousIndex = 0;
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        Node* node = list.removeFirst();
+        ASSERT_NE(nullptr, node);
+        if ((i > 0) && (node->mValue == previousValue))
+        {
+            EXPECT_LT(previousIndex, node->mIndex);
+        }
+        else if (i > 0)
+        {
+            EXPECT_LT(previousValue, node->mValue);
+        }
+        previousValue = node->mValue;
+        previousIndex = node->mIndex;
+    }
+}
+
+TEST(SkipListTest, shouldRemoveNodes)
+{
+    SkipList<Node> list;
+    std::vector<Node> nodes;
+    for (uint32_t i = 0; i < 200; ++i)
+    {
+        nodes.push_back(Node(i / 4, i));
+    }
+    for (Node& node : nodes)
+    {
+        list.insert(&node);
+    }
+
+    // Remove every second node, including nodes with equal keys
+    for (size_t i = 0; i < nodes.size(); i += 2)
+    {
+        EXPECT_TRUE(list.removeNode(&nodes[i])) << i;
+        EXPECT_FALSE(list.removeNode(&nodes[i])) << i;
+    }
+    EXPECT_EQ(100U, list.size());
+
+    Node unknown(10, 1000);
+    EXPECT_FALSE(list.removeNode(&unknown));
+
+    for (size_t i = 1; i < nodes.size(); i += 2)
+    {
+        EXPECT_EQ(&nodes[i], list.removeFirst());
+    }
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_FALSE(list.removeNode(&nodes[1]));
+}
+
+TEST(SkipListTest, shouldBeUsableAfterReset)
+{
+    SkipList<Node> list;
+    Node a(2, 0);
+    Node b(1, 1);
+
+    list.insert(&a);
+    list.insert(&b);
+    list.reset();
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_EQ(0U, list.size());
+
+    list.insert(&a);
+    EXPECT_EQ(&a, list.first());
+    EXPECT_EQ(1U, list.size());
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/container/spsc_byte_ring.h>
+
+#include <unittest/harness.h>
+
+using outpost::utils::SpscByteRing;
+
+TEST(SpscByteRingTest, shouldProvideContiguousSpansAcrossWrapAround)
+{
+    uint8_t storage[8];
+    SpscByteRing ring(outpost::asSlice(storage));
+
+    const uint8_t first[] = {1, 2, 3, 4, 5, 6};
+    EXPECT_EQ(6U, ring.write(outpost::asSlice(first)));
+    ring.consume(5);
+    EXPECT_EQ(1U, ring.getNumberOfBytes());
+
+    // free space wraps around: two bytes at the end, five at the start
+    EXPECT_EQ(2U, ring.getWritableSpan().getNumberOfElements());
+    EXPECT_EQ(7U, ring.getFreeSpace());
+
+    const uint8_t second[] = {7, 8, 9, 10, 11, 12, 13, 14};
+    EXPECT_EQ(7U, ring.write(outpost::asSlice(second)));
+    EXPECT_EQ(0U, ring.getFreeSpace());
+    EXPECT_EQ(0U, ring.getWritableSpan().getNumberOfElements());
+
+    outpost::Slice<const uint8_t> span = ring.getReadableSpan();
+    ASSERT_EQ(3U, span.getNumberOfElements());
+    EXPECT_EQ(6, span[0]);
+    EXPECT_EQ(8, span[2]);
+    ring.consume(span.getNumberOfElements());
+
+    uint8_t data[8];
+    ASSERT_EQ(5U, ring.read(outpost::asSlice(data)));
+    EXPECT_EQ(9, data[0]);
+    EXPECT_EQ(13, data[4]);
+    EXPECT_TRUE(ring.isEmpty());
+}
+
+TEST(SpscByteRingTest, shouldPublishBytesWrittenInPlace)
+{
+    uint8_t storage[4];
+    SpscByteRing ring(outpost::asSlice(storage));
+
+    outpost::Slice<uint8_t> span = ring.getWritableSpan();
+    ASSERT_EQ(4U, span.getNumberOfElements());
+    span[0] = 0xAB;
+    span[1] = 0xCD;
+    EXPECT_TRUE(ring.isEmpty());
+
+    ring.commitWrite(2);
+    outpost::Slice<const uint8_t> readable = ring.getReadableSpan();
+    ASSERT_EQ(2U, readable.getNumberOfElements());
+    EXPECT_EQ(0xCD, readable[1]);
+}
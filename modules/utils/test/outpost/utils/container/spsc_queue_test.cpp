@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/rtos/thread.h>
+#include <outpost/utils/container/shared_object_pool.h>
+#include <outpost/utils/container/spsc_queue.h>
+
+#include <unittest/harness.h>
+
+using outpost::utils::SpscQueue;
+
+TEST(SpscQueueTest, fifoOrder)
+{
+    uint32_t storage[3];
+    SpscQueue<uint32_t> queue(outpost::asSlice(storage));
+
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(3U, queue.getCapacity());
+
+    EXPECT_TRUE(queue.send(1));
+    EXPECT_TRUE(queue.send(2));
+    EXPECT_TRUE(queue.send(3));
+    EXPECT_TRUE(queue.isFull());
+    EXPECT_FALSE(queue.send(4));
+
+    uint32_t value = 0;
+    EXPECT_TRUE(queue.receive(value, outpost::time::Duration::zero()));
+    EXPECT_EQ(1U, value);
+    EXPECT_TRUE(queue.send(4));
+
+    EXPECT_TRUE(queue.receive(value, outpost::time::Duration::zero()));
+    EXPECT_EQ(2U, value);
+    EXPECT_TRUE(queue.receive(value, outpost::time::Duration::zero()));
+    EXPECT_EQ(3U, value);
+    EXPECT_TRUE(queue.receive(value, outpost::time::Duration::zero()));
+    EXPECT_EQ(4U, value);
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(SpscQueueTest, receiveTimesOutOnEmptyQueue)
+{
+    uint32_t storage[2];
+    SpscQueue<uint32_t> queue(outpost::asSlice(storage));
+
+    uint32_t value = 7;
+    EXPECT_FALSE(queue.receive(value, outpost::time::Duration::zero()));
+    EXPECT_FALSE(queue.receive(value, outpost::time::Milliseconds(1)));
+    EXPECT_EQ(7U, value);
+}
+
+TEST(SpscQueueTest, wrapAroundKeepsCount)
+{
+    uint32_t storage[2];
+    SpscQueue<uint32_t> queue(outpost::asSlice(storage));
+
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        EXPECT_TRUE(queue.send(i));
+        EXPECT_EQ(1U, queue.getNumberOfItems());
+        EXPECT_TRUE(queue.receive(value, outpost::time::Duration::zero()));
+        EXPECT_EQ(i, value);
+        EXPECT_EQ(0U, queue.getNumberOfItems());
+    }
+}
+
+TEST(SpscQueueTest, moveSharedBufferPointer)
+{
+    outpost::utils::SharedBufferPool<8, 1> pool;
+    outpost::utils::SharedBufferPointer storage[1];
+    SpscQueue<outpost::utils::SharedBufferPointer> queue(outpost::asSlice(storage));
+
+    outpost::utils::SharedBufferPointer p;
+    ASSERT_TRUE(pool.allocate(p));
+    EXPECT_TRUE(queue.send(std::move(p)));
+    EXPECT_FALSE(p.isValid());
+
+    outpost::utils::SharedBufferPointer received;
+    EXPECT_TRUE(queue.receive(received, outpost::time::Duration::zero()));
+    EXPECT_EQ(1U, received->getReferenceCount());
+}
+
+class SpscProducerThread : public outpost::rtos::Thread
+{
+public:
+    SpscProducerThread(SpscQueue<uint32_t>& queue, uint32_t count) :
+        Thread(0),
+        mQueue(queue),
+        mCount(count)
+    {
+    }
+
+protected:
+    void
+    run() override
+    {
+        for (uint32_t i = 0; i < mCount; i++)
+        {
+            mQueue.send(i, outpost::time::Duration::infinity());
+        }
+
+        // Returning from a thread is not allowed, wait to be cancelled by the destructor
+        while (true)
+        {
+            outpost::rtos::Thread::sleep(outpost::time::Milliseconds(10));
+        }
+    }
+
+private:
+    SpscQueue<uint32_t>& mQueue;
+    const uint32_t mCount;
+};
+
+TEST(SpscQueueTest, concurrentProducerAndConsumer)
+{
+    const uint32_t count = 20000;
+    uint32_t storage[4];
+    SpscQueue<uint32_t> queue(outpost::asSlice(storage));
+
+    SpscProducerThread producer(queue, count);
+    producer.start();
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t value = count;
+        ASSERT_TRUE(queue.receive(value, outpost::time::Seconds(10)));
+        ASSERT_EQ(i, value);
+    }
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+/// Sends like an interrupt handler, retries at the next "interrupt" if full
+class SpscInterruptProducerThread : public outpost::rtos::Thread
+{
+public:
+    SpscInterruptProducerThread(SpscQueue<uint32_t>& queue, uint32_t count) :
+        Thread(0),
+        mQueue(queue),
+        mCount(count)
+    {
+    }
+
+protected:
+    void
+    run() override
+    {
+        uint32_t i = 0;
+        while (i < mCount)
+        {
+            if (mQueue.sendFromInterrupt(i))
+            {
+                i++;
+            }
+            else
+            {
+                outpost::rtos::Thread::sleep(outpost::time::Milliseconds(1));
+            }
+        }
+
+        // Returning from a thread is not allowed, wait to be cancelled by the destructor
+        while (true)
+        {
+            outpost::rtos::Thread::sleep(outpost::time::Milliseconds(10));
+        }
+    }
+
+private:
+    SpscQueue<uint32_t>& mQueue;
+    const uint32_t mCount;
+};
+
+TEST(SpscQueueTest, interruptProducerWakesConsumer)
+{
+    const uint32_t count = 200;
+    uint32_t storage[4];
+    SpscQueue<uint32_t> queue(outpost::asSlice(storage));
+
+    SpscInterruptProducerThread producer(queue, count);
+    producer.start();
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t value = count;
+        ASSERT_TRUE(queue.receive(value, outpost::time::Seconds(10)));
+        ASSERT_EQ(i, value);
+    }
+    EXPECT_TRUE(queue.isEmpty());
+}
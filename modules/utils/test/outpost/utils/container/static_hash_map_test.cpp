@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/container/static_hash_map.h>
+
+#include <unittest/harness.h>
+
+using namespace outpost;
+
+namespace
+{
+struct Entry
+{
+    uint16_t mKey;
+    uint32_t mValue;
+};
+
+constexpr Entry entries[] = {
+        {0x100, 0}, {0x2A3, 1}, {0x010, 2}, {0x7FF, 3}, {0x001, 4}, {0x123, 5}};
+
+constexpr StaticHashMap<Entry, uint16_t, 6> map(entries);
+
+// Identifiers with a regular pattern
+constexpr Entry largeEntries[] = {
+        {0, 0},     {16, 1},    {32, 2},    {48, 3},    {64, 4},    {80, 5},    {96, 6},
+        {112, 7},   {128, 8},   {144, 9},   {160, 10},  {176, 11},  {192, 12},  {208, 13},
+        {224, 14},  {240, 15},  {256, 16},  {272, 17},  {288, 18},  {304, 19},  {320, 20},
+        {336, 21},  {352, 22},  {368, 23},  {384, 24},  {400, 25},  {416, 26},  {432, 27},
+        {448, 28},  {464, 29},  {480, 30},  {496, 31},  {512, 32},  {528, 33},  {544, 34},
+        {560, 35},  {576, 36},  {592, 37},  {608, 38},  {624, 39},  {640, 40},  {656, 41},
+        {672, 42},  {688, 43},  {704, 44},  {720, 45},  {736, 46},  {752, 47},  {768, 48},
+        {784, 49},  {800, 50},  {816, 51},  {832, 52},  {848, 53},  {864, 54},  {880, 55},
+        {896, 56},  {912, 57},  {928, 58},  {944, 59},  {960, 60},  {976, 61},  {992, 62},
+        {1008, 63}, {1024, 64}, {1040, 65}, {1056, 66}, {1072, 67}, {1088, 68}, {1104, 69}};
+
+constexpr StaticHashMap<Entry, uint16_t, 70> largeMap(largeEntries);
+
+enum class Node : uint8_t
+{
+    camera = 3,
+    storage = 17,
+    payload = 42
+};
+
+struct NodeEntry
+{
+    Node mKey;
+    uint8_t mAddress;
+};
+
+constexpr NodeEntry nodes[] = {{Node::payload, 0xFE}, {Node::camera, 0x20}};
+
+constexpr StaticHashMap<NodeEntry, Node, 2> nodeMap(nodes);
+}  // namespace
+
+// Lookups are constant expressions as well
+static_assert(map.getEntry(0x2A3)->mValue == 1, "compile-time lookup");
+static_assert(map.getEntry(0x2A4) == nullptr, "compile-time lookup");
+
+TEST(StaticHashMapTest, shouldFindAllEntries)
+{
+    EXPECT_EQ(6U, map.getNumberOfElements());
+    for (size_t i = 0; i < 6; ++i)
+    {
+        EXPECT_EQ(&entries[i], map.getEntry(entries[i].mKey)) << i;
+    }
+}
+
+TEST(StaticHashMapTest, missingEntriesShouldReturnANullPointer)
+{
+    for (uint32_t key = 0; key < 0x10000; ++key)
+    {
+        const Entry* entry = map.getEntry(static_cast<uint16_t>(key));
+        if (entry != nullptr)
+        {
+            EXPECT_EQ(key, entry->mKey);
+        }
+    }
+    EXPECT_EQ(nullptr, map.getEntry(0));
+    EXPECT_EQ(nullptr, map.getEntry(0xFFFF));
+}
+
+TEST(StaticHashMapTest, shouldFindAllEntriesOfLargerMaps)
+{
+    for (size_t i = 0; i < 70; ++i)
+    {
+        EXPECT_EQ(&largeEntries[i], largeMap.getEntry(largeEntries[i].mKey)) << i;
+        EXPECT_EQ(nullptr, largeMap.getEntry(static_cast<uint16_t>(largeEntries[i].mKey + 1)))
+                << i;
+    }
+}
+
+TEST(StaticHashMapTest, shouldSupportEnumKeys)
+{
+    EXPECT_EQ(0x20, nodeMap.getEntry(Node::camera)->mAddress);
+    EXPECT_EQ(0xFE, nodeMap.getEntry(Node::payload)->mAddress);
+    EXPECT_EQ(nullptr, nodeMap.getEntry(Node::storage));
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/container/struct_of_arrays.h>
+
+#include <unittest/harness.h>
+
+#include <memory>
+#include <type_traits>
+
+using outpost::utils::StructOfArrays;
+
+namespace
+{
+enum Column
+{
+    timestamp,
+    parameterId,
+    value
+};
+
+typedef StructOfArrays<4, uint32_t, uint16_t, int32_t> Samples;
+
+static_assert(std::is_same<Samples::ColumnType<parameterId>, uint16_t>::value, "column type");
+static_assert(Samples::numberOfColumns == 3, "number of columns");
+static_assert(alignof(Samples) <= alignof(void*), "no over-aligned type");
+}  // namespace
+
+TEST(StructOfArraysTest, shouldStoreRowsInColumns)
+{
+    Samples samples;
+    EXPECT_TRUE(samples.isEmpty());
+    EXPECT_EQ(4U, samples.getCapacity());
+
+    EXPECT_TRUE(samples.append(100, 7, -1));
+    EXPECT_TRUE(samples.append(200, 8, 5));
+    EXPECT_TRUE(samples.append(300, 7, 42));
+    EXPECT_EQ(3U, samples.getSize());
+
+    outpost::Slice<int32_t> values = samples.getColumn<value>();
+    ASSERT_EQ(3U, values.getNumberOfElements());
+    EXPECT_EQ(-1, values[0]);
+    EXPECT_EQ(5, values[1]);
+    EXPECT_EQ(42, values[2]);
+
+    EXPECT_EQ(200U, samples.get<timestamp>(1));
+    EXPECT_EQ(7U, samples.get<parameterId>(2));
+
+    samples.get<value>(0) = 3;
+    EXPECT_EQ(3, samples.getColumn<value>()[0]);
+}
+
+TEST(StructOfArraysTest, shouldRejectRowsWhenFull)
+{
+    Samples samples;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(samples.append(i, 0, 0));
+    }
+    EXPECT_TRUE(samples.isFull());
+    EXPECT_FALSE(samples.append(5, 0, 0));
+    EXPECT_EQ(4U, samples.getSize());
+
+    samples.clear();
+    EXPECT_TRUE(samples.isEmpty());
+    EXPECT_EQ(0U, samples.getColumn<timestamp>().getNumberOfElements());
+}
+
+TEST(StructOfArraysTest, columnsShouldBeAlignedAndContiguous)
+{
+    StructOfArrays<5, uint8_t, uint8_t, double> table;
+    for (uint8_t i = 0; i < 5; ++i)
+    {
+        table.append(i, static_cast<uint8_t>(10 + i), i * 0.5);
+    }
+
+    const StructOfArrays<5, uint8_t, uint8_t, double>& constTable = table;
+    outpost::Slice<const uint8_t> first = constTable.getColumn<0>();
+    outpost::Slice<const uint8_t> second = constTable.getColumn<1>();
+    outpost::Slice<const double> third = constTable.getColumn<2>();
+
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(first.begin()) % 16);
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(second.begin()) % 16);
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(third.begin()) % 16);
+    EXPECT_NE(first.begin(), second.begin());
+    for (size_t i = 0; i < 5; ++i)
+    {
+        EXPECT_EQ(i, first[i]);
+        EXPECT_EQ(10 + i, second[i]);
+        EXPECT_EQ(i * 0.5, third[i]);
+    }
+}
+
+TEST(StructOfArraysTest, columnsShouldBeAlignedWhenAllocatedDynamically)
+{
+    typedef StructOfArrays<3, uint8_t, uint32_t> Table;
+    std::unique_ptr<Table> table(new Table());
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(table->getColumnStorage<0>().begin()) % 16);
+    EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(table->getColumnStorage<1>().begin()) % 16);
+    EXPECT_EQ(0U, table->get<1>(2));
+}
+
+TEST(StructOfArraysTest, shouldAllowFillingColumnsDirectly)
+{
+    Samples samples;
+    outpost::Slice<int32_t> storage = samples.getColumnStorage<value>();
+    ASSERT_EQ(4U, storage.getNumberOfElements());
+    storage.fill(9);
+
+    EXPECT_FALSE(samples.setSize(5));
+    EXPECT_TRUE(samples.setSize(2));
+    EXPECT_EQ(2U, samples.getColumn<value>().getNumberOfElements());
+    EXPECT_EQ(9, samples.getColumn<value>()[1]);
+}
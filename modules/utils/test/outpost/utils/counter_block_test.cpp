@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/counter_block.h>
+
+#include <gtest/gtest.h>
+
+using outpost::utils::CounterBlock;
+using outpost::utils::DistributedCounterBlock;
+
+TEST(CounterBlockTest, shouldReserveFullCacheLines)
+{
+    const size_t line = outpost::utils::cacheLineSize;
+    EXPECT_LE(2 * line - sizeof(uint32_t), sizeof(CounterBlock<1>));
+    EXPECT_GT(2 * line + sizeof(void*) + sizeof(uint32_t), sizeof(CounterBlock<1>));
+    EXPECT_GT(2 * line + sizeof(void*) + sizeof(uint32_t), sizeof(CounterBlock<16>));
+    EXPECT_LE(3 * line - sizeof(uint32_t), sizeof(CounterBlock<17>));
+}
+
+TEST(CounterBlockTest, shouldKeepAdjacentBlocksIndependent)
+{
+    CounterBlock<16> blocks[3];
+    for (size_t i = 0; i < 16; ++i)
+    {
+        blocks[1].increment(i, static_cast<uint32_t>(i + 1));
+    }
+    for (size_t i = 0; i < 16; ++i)
+    {
+        EXPECT_EQ(0U, blocks[0].get(i));
+        EXPECT_EQ(i + 1, blocks[1].get(i));
+        EXPECT_EQ(0U, blocks[2].get(i));
+    }
+}
+
+TEST(CounterBlockTest, shouldCountAndReset)
+{
+    CounterBlock<3> counters;
+    EXPECT_EQ(0U, counters.get(0));
+
+    counters.increment(0);
+    counters.increment(2, 5);
+    counters.increment(2);
+    EXPECT_EQ(1U, counters.get(0));
+    EXPECT_EQ(0U, counters.get(1));
+    EXPECT_EQ(6U, counters.get(2));
+
+    counters.reset();
+    EXPECT_EQ(0U, counters.get(0));
+    EXPECT_EQ(0U, counters.get(2));
+}
+
+TEST(CounterBlockTest, shouldAggregateAllWriters)
+{
+    DistributedCounterBlock<2, 3> counters;
+
+    counters.increment(0, 0);
+    counters.increment(1, 0, 2);
+    counters.increment(2, 1, 4);
+    EXPECT_EQ(3U, counters.get(0));
+    EXPECT_EQ(4U, counters.get(1));
+
+    counters.reset();
+    EXPECT_EQ(0U, counters.get(0));
+    EXPECT_EQ(0U, counters.get(1));
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/delegate.h>
+
+#include <gtest/gtest.h>
+
+using outpost::Delegate;
+
+namespace
+{
+class Counter
+{
+public:
+    Counter() : mValue(0)
+    {
+    }
+
+    int
+    add(int value)
+    {
+        mValue += value;
+        return mValue;
+    }
+
+    int
+    get() const
+    {
+        return mValue;
+    }
+
+    void
+    reset()
+    {
+        mValue = 0;
+    }
+
+private:
+    int mValue;
+};
+
+int
+twice(int value)
+{
+    return 2 * value;
+}
+
+typedef Delegate<int(int)> IntFunction;
+}  // namespace
+
+TEST(DelegateTest, shouldHaveSizeOfTwoPointers)
+{
+    EXPECT_EQ(2 * sizeof(void*), sizeof(IntFunction));
+    EXPECT_FALSE(IntFunction().isValid());
+}
+
+TEST(DelegateTest, shouldCallMemberFunction)
+{
+    Counter counter;
+    IntFunction add = IntFunction::fromMember<Counter, &Counter::add>(counter);
+
+    ASSERT_TRUE(add.isValid());
+    EXPECT_EQ(3, add(3));
+    EXPECT_EQ(7, add.execute(4));
+    EXPECT_EQ(7, counter.get());
+
+    Delegate<void()> reset = Delegate<void()>::fromMember<Counter, &Counter::reset>(counter);
+    reset();
+    EXPECT_EQ(0, counter.get());
+}
+
+TEST(DelegateTest, shouldCallConstMemberFunction)
+{
+    Counter counter;
+    counter.add(5);
+
+    const Counter& constCounter = counter;
+    Delegate<int()> get = Delegate<int()>::fromMember<Counter, &Counter::get>(constCounter);
+    EXPECT_EQ(5, get());
+}
+
+TEST(DelegateTest, shouldCallFreeFunction)
+{
+    IntFunction function = IntFunction::fromFunction<&twice>();
+    EXPECT_EQ(10, function(5));
+}
+
+TEST(DelegateTest, shouldCompareObjectAndFunction)
+{
+    Counter first;
+    Counter second;
+    IntFunction a = IntFunction::fromMember<Counter, &Counter::add>(first);
+    IntFunction b = IntFunction::fromMember<Counter, &Counter::add>(first);
+    IntFunction c = IntFunction::fromMember<Counter, &Counter::add>(second);
+
+    EXPECT_TRUE(a == b);
+    EXPECT_TRUE(a != c);
+    EXPECT_TRUE(a != IntFunction::fromFunction<&twice>());
+
+    // Copies call the same object
+    IntFunction copy = c;
+    copy(2);
+    EXPECT_EQ(2, second.get());
+    EXPECT_EQ(0, first.get());
+}
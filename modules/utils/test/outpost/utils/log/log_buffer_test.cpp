@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/log/log.h>
+#include <outpost/utils/storage/serialize.h>
+
+#include <unittest/harness.h>
+
+#include <string.h>
+
+using outpost::utils::Log;
+using outpost::utils::LogBuffer;
+using outpost::utils::LogBufferBase;
+using outpost::utils::LogRecord;
+
+class LogBufferTest : public testing::Test
+{
+public:
+    LogBuffer<4> mBuffer;
+    LogRecord mRecord;
+};
+
+TEST_F(LogBufferTest, shouldBeEmptyAfterConstruction)
+{
+    EXPECT_EQ(4U, mBuffer.getCapacity());
+    EXPECT_EQ(0U, mBuffer.getNumberOfLostRecords());
+    EXPECT_FALSE(mBuffer.read(mRecord));
+}
+
+TEST_F(LogBufferTest, shouldReadMessagesInOrder)
+{
+    static const char* const first = "first\n";
+    static const char* const second = "second %u %u\n";
+    mBuffer.record(first);
+    mBuffer.record(second, 1, static_cast<uint8_t>(2));
+
+    ASSERT_TRUE(mBuffer.read(mRecord));
+    EXPECT_EQ(first, mRecord.mFormat);
+    EXPECT_EQ(0U, mRecord.mNumberOfArguments);
+    const outpost::rtos::CycleClock::Ticks timestamp = mRecord.mTimestamp;
+
+    ASSERT_TRUE(mBuffer.read(mRecord));
+    EXPECT_EQ(second, mRecord.mFormat);
+    ASSERT_EQ(2U, mRecord.mNumberOfArguments);
+    EXPECT_EQ(1U, mRecord.mArguments[0]);
+    EXPECT_EQ(2U, mRecord.mArguments[1]);
+    EXPECT_EQ(0U, mRecord.mArguments[2]);
+    EXPECT_LE(timestamp, mRecord.mTimestamp);
+
+    EXPECT_FALSE(mBuffer.read(mRecord));
+}
+
+TEST_F(LogBufferTest, shouldCountOverwrittenMessages)
+{
+    for (uint32_t i = 0; i < 7; ++i)
+    {
+        mBuffer.record("%u", i);
+    }
+
+    for (uint32_t i = 3; i < 7; ++i)
+    {
+        ASSERT_TRUE(mBuffer.read(mRecord));
+        EXPECT_EQ(i, mRecord.mArguments[0]);
+    }
+    EXPECT_FALSE(mBuffer.read(mRecord));
+    EXPECT_EQ(3U, mBuffer.getNumberOfLostRecords());
+
+    // The buffer is usable again after being read
+    mBuffer.record("%u", 7);
+    ASSERT_TRUE(mBuffer.read(mRecord));
+    EXPECT_EQ(7U, mRecord.mArguments[0]);
+    EXPECT_EQ(3U, mBuffer.getNumberOfLostRecords());
+}
+
+TEST_F(LogBufferTest, shouldFormatMessages)
+{
+    char text[32];
+    mBuffer.record("id %u, status 0x%02X, %d\n", 12, 0xA, -3);
+    mBuffer.record("%u", 123456789);
+
+    ASSERT_TRUE(mBuffer.read(mRecord));
+    EXPECT_EQ(strlen("id 12, status 0x0A, -3\n"),
+              LogBufferBase::format(mRecord, outpost::asSlice(text)));
+    EXPECT_STREQ("id 12, status 0x0A, -3\n", text);
+
+    // Truncated to the buffer
+    ASSERT_TRUE(mBuffer.read(mRecord));
+    EXPECT_EQ(4U, LogBufferBase::format(mRecord, outpost::asSlice(text).first(5)));
+    EXPECT_STREQ("1234", text);
+    EXPECT_EQ(0U, LogBufferBase::format(mRecord, outpost::asSlice(text).first(0)));
+}
+
+TEST_F(LogBufferTest, shouldSerializeMessages)
+{
+    static const char* const format = "%u %u";
+    mBuffer.record(format, 0x01020304, 5);
+    mBuffer.record("none");
+
+    uint8_t data[64];
+    const size_t expectedLength = LogBufferBase::headerSize
+                                  + 2 * LogBufferBase::serializedRecordSize + 2 * 4;
+    ASSERT_EQ(expectedLength, mBuffer.serialize(outpost::asSlice(data)));
+
+    outpost::Deserialize payload(data);
+    EXPECT_EQ(LogBufferBase::magic, payload.read<uint32_t>());
+    EXPECT_EQ(2U, payload.read<uint32_t>());
+    EXPECT_EQ(outpost::rtos::CycleClock::getFrequency(), payload.read<uint64_t>());
+
+    payload.skip(8);
+    EXPECT_EQ(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(format)),
+              payload.read<uint32_t>());
+    EXPECT_EQ(2U, payload.read<uint8_t>());
+    EXPECT_EQ(0x01020304U, payload.read<uint32_t>());
+    EXPECT_EQ(5U, payload.read<uint32_t>());
+
+    payload.skip(12);
+    EXPECT_EQ(0U, payload.read<uint8_t>());
+
+    // Serialized messages are removed
+    EXPECT_FALSE(mBuffer.read(mRecord));
+}
+
+TEST_F(LogBufferTest, shouldKeepMessagesWhichDoNotFit)
+{
+    mBuffer.record("a %u", 1);
+    mBuffer.record("b %u", 2);
+
+    uint8_t data[LogBufferBase::headerSize + LogBufferBase::serializedRecordSize + 4];
+    EXPECT_EQ(sizeof(data), mBuffer.serialize(outpost::asSlice(data)));
+    EXPECT_EQ(0U, mBuffer.serialize(outpost::asSlice(data).first(LogBufferBase::headerSize - 1)));
+
+    ASSERT_TRUE(mBuffer.read(mRecord));
+    EXPECT_EQ(2U, mRecord.mArguments[0]);
+}
+
+TEST_F(LogBufferTest, shouldRecordToGlobalBuffer)
+{
+    OUTPOST_LOG("dropped\n");
+
+    Log::setBuffer(&mBuffer);
+    EXPECT_EQ(&mBuffer, Log::getBuffer());
+    OUTPOST_LOG("recorded %u\n", 42);
+    Log::setBuffer(nullptr);
+
+    ASSERT_TRUE(mBuffer.read(mRecord));
+    EXPECT_STREQ("recorded %u\n", mRecord.mFormat);
+    EXPECT_EQ(42U, mRecord.mArguments[0]);
+    EXPECT_FALSE(mBuffer.read(mRecord));
+}
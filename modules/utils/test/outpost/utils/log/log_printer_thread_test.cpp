@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/log/log_printer_thread.h>
+
+#include <unittest/harness.h>
+
+#include <string>
+#include <vector>
+
+using outpost::utils::LogBuffer;
+using outpost::utils::LogPrinterThread;
+
+namespace
+{
+std::vector<std::string> lines;
+
+void
+captureLine(const char* line)
+{
+    lines.push_back(line);
+}
+
+/// Line without the timestamp
+std::string
+getMessage(const std::string& line)
+{
+    const size_t end = line.find("] ");
+    return (end == std::string::npos) ? line : line.substr(end + 2);
+}
+}  // namespace
+
+class LogPrinterThreadTest : public testing::Test
+{
+public:
+    LogPrinterThreadTest() : mPrinter(mBuffer, 10, &captureLine)
+    {
+        lines.clear();
+    }
+
+    LogBuffer<4> mBuffer;
+    LogPrinterThread mPrinter;
+};
+
+TEST_F(LogPrinterThreadTest, shouldWriteNothingWithoutMessages)
+{
+    EXPECT_EQ(0U, mPrinter.step());
+    EXPECT_TRUE(lines.empty());
+}
+
+TEST_F(LogPrinterThreadTest, shouldFormatMessagesWithTimestamp)
+{
+    mBuffer.record("RMAP-Initiator: Timeout\n");
+    mBuffer.record("RMAP-Initiator: Command not executed successfully: %u\n", 3);
+
+    EXPECT_EQ(2U, mPrinter.step());
+    ASSERT_EQ(2U, lines.size());
+    EXPECT_EQ('[', lines[0][0]);
+    EXPECT_EQ("RMAP-Initiator: Timeout\n", getMessage(lines[0]));
+    EXPECT_EQ("RMAP-Initiator: Command not executed successfully: 3\n", getMessage(lines[1]));
+
+    EXPECT_EQ(0U, mPrinter.step());
+}
+
+TEST_F(LogPrinterThreadTest, shouldReportLostMessages)
+{
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        mBuffer.record("%u\n", i);
+    }
+
+    EXPECT_EQ(4U, mPrinter.step());
+    ASSERT_EQ(5U, lines.size());
+    EXPECT_EQ("log: 2 messages lost\n", lines[0]);
+    EXPECT_EQ("2\n", getMessage(lines[1]));
+    EXPECT_EQ("5\n", getMessage(lines[4]));
+
+    // Only reported once
+    mBuffer.record("%u\n", 6);
+    EXPECT_EQ(1U, mPrinter.step());
+    ASSERT_EQ(6U, lines.size());
+    EXPECT_EQ("6\n", getMessage(lines[5]));
+}
+
+TEST_F(LogPrinterThreadTest, shouldTruncateLongMessages)
+{
+    static const std::string text(200, 'x');
+    static const char* const format = text.c_str();
+    mBuffer.record(format);
+
+    EXPECT_EQ(1U, mPrinter.step());
+    ASSERT_EQ(1U, lines.size());
+    EXPECT_EQ(LogPrinterThread::maximumLineLength - 1, lines[0].size());
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/metrics/metrics.h>
+
+#include <gtest/gtest.h>
+
+using namespace outpost::utils;
+
+static const uint32_t histogramBounds[] = {10, 100};
+
+TEST(MetricsTest, shouldUpdateValues)
+{
+    MetricCounter counter(1, "counter");
+    MetricGauge gauge(2, "gauge");
+    MetricHistogram<2> histogram(3, "histogram", histogramBounds);
+
+    counter.increment();
+    counter.increment(4);
+    gauge.set(-3);
+    histogram.record(0);
+    histogram.record(10);
+    histogram.record(11);
+    histogram.record(1000);
+
+    EXPECT_EQ(5U, counter.get());
+    EXPECT_EQ(-3, gauge.get());
+    ASSERT_EQ(3U, histogram.getNumberOfBuckets());
+    EXPECT_EQ(2U, histogram.getBucket(0));
+    EXPECT_EQ(1U, histogram.getBucket(1));
+    EXPECT_EQ(1U, histogram.getBucket(2));
+    EXPECT_EQ(0U, histogram.getBucket(3));
+}
+
+TEST(MetricsTest, shouldRegisterAndUnregisterMetrics)
+{
+    EXPECT_EQ(0U, MetricsRegistry::getNumberOfMetrics());
+    {
+        MetricCounter counter(0x0101, "counter");
+        MetricGauge gauge(0x0102, "gauge");
+
+        EXPECT_EQ(2U, MetricsRegistry::getNumberOfMetrics());
+        EXPECT_EQ(&gauge, MetricsRegistry::find(0x0102));
+        EXPECT_EQ(&counter, MetricsRegistry::find(0x0101));
+        EXPECT_EQ(nullptr, MetricsRegistry::find(0x0103));
+        EXPECT_STREQ("counter", MetricsRegistry::find(0x0101)->getName());
+    }
+    EXPECT_EQ(0U, MetricsRegistry::getNumberOfMetrics());
+    EXPECT_EQ(nullptr, MetricsRegistry::find(0x0101));
+}
+
+TEST(MetricsTest, shouldSerializeAllMetrics)
+{
+    MetricCounter counter(0x0101, "counter");
+    MetricGauge gauge(0x0102, "gauge");
+    MetricHistogram<2> histogram(0x0103, "histogram", histogramBounds);
+
+    counter.increment(7);
+    gauge.set(-1);
+    histogram.record(50);
+
+    const size_t expectedSize = 2 + (4 + 4) + (4 + 4) + (4 + 3 * 4);
+    EXPECT_EQ(expectedSize, MetricsRegistry::getSerializedSize());
+
+    uint8_t buffer[64] = {};
+    ASSERT_EQ(expectedSize, MetricsRegistry::serialize(outpost::asSlice(buffer)));
+
+    // The most recently created metric is the first in the list
+    outpost::Deserialize packet(buffer);
+    EXPECT_EQ(3U, packet.read<uint16_t>());
+
+    EXPECT_EQ(0x0103U, packet.read<uint16_t>());
+    EXPECT_EQ(3U, packet.read<uint8_t>());
+    EXPECT_EQ(3U, packet.read<uint8_t>());
+    EXPECT_EQ(0U, packet.read<uint32_t>());
+    EXPECT_EQ(1U, packet.read<uint32_t>());
+    EXPECT_EQ(0U, packet.read<uint32_t>());
+
+    EXPECT_EQ(0x0102U, packet.read<uint16_t>());
+    EXPECT_EQ(2U, packet.read<uint8_t>());
+    EXPECT_EQ(1U, packet.read<uint8_t>());
+    EXPECT_EQ(0xFFFFFFFFU, packet.read<uint32_t>());
+
+    EXPECT_EQ(0x0101U, packet.read<uint16_t>());
+    EXPECT_EQ(1U, packet.read<uint8_t>());
+    EXPECT_EQ(1U, packet.read<uint8_t>());
+    EXPECT_EQ(7U, packet.read<uint32_t>());
+}
+
+TEST(MetricsTest, shouldRejectTooSmallBuffer)
+{
+    MetricCounter counter(0x0101, "counter");
+
+    // Number of metrics, header of the counter and its value
+    uint8_t buffer[10] = {};
+    EXPECT_EQ(0U, MetricsRegistry::serialize(outpost::asSlice(buffer).first(9)));
+    EXPECT_EQ(10U, MetricsRegistry::serialize(outpost::asSlice(buffer)));
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <unittest/harness.h>
+#include <unittest/utils/replay/mapped_file.h>
+#include <unittest/utils/replay/packet_archive.h>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+using outpost::time::Milliseconds;
+using outpost::time::SpacecraftElapsedTime;
+using unittest::utils::MappedFile;
+using unittest::utils::PacketArchive;
+using unittest::utils::PacketArchiveReader;
+using unittest::utils::PacketArchiveWriter;
+
+namespace
+{
+class PacketArchiveTest : public testing::Test
+{
+public:
+    virtual void
+    SetUp() override
+    {
+        char path[] = "/tmp/outpost_archive_XXXXXX";
+        const int file = mkstemp(path);
+        ASSERT_LE(0, file);
+        close(file);
+        mPath = path;
+    }
+
+    virtual void
+    TearDown() override
+    {
+        unlink(mPath.c_str());
+    }
+
+    static SpacecraftElapsedTime
+    at(int64_t milliseconds)
+    {
+        return SpacecraftElapsedTime::afterEpoch(Milliseconds(milliseconds));
+    }
+
+    /**
+     * Archive with \p count records every 10 ms, record i has i + 1 bytes
+     * of value i and channel i % 3.
+     */
+    void
+    writeArchive(size_t count, uint16_t indexInterval)
+    {
+        PacketArchiveWriter writer;
+        ASSERT_TRUE(writer.open(mPath.c_str(), indexInterval));
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::vector<uint8_t> data(i + 1, static_cast<uint8_t>(i));
+            ASSERT_TRUE(writer.append(at(i * 10), i % 3, outpost::asSlice(data)));
+        }
+        ASSERT_TRUE(writer.close());
+    }
+
+    std::string mPath;
+    MappedFile mFile;
+    PacketArchiveReader mReader;
+};
+}  // namespace
+
+TEST_F(PacketArchiveTest, shouldReadRecordsFromMapping)
+{
+    writeArchive(20, 4);
+    ASSERT_TRUE(mFile.open(mPath.c_str()));
+    ASSERT_TRUE(mReader.open(mFile.getData()));
+    EXPECT_EQ(20U, mReader.getNumberOfRecords());
+
+    PacketArchive::Record record;
+    size_t position = mReader.begin();
+    for (size_t i = 0; i < 20; ++i)
+    {
+        ASSERT_TRUE(mReader.read(position, record));
+        EXPECT_EQ(at(i * 10), record.mTime);
+        EXPECT_EQ(i % 3, record.mChannel);
+        ASSERT_EQ(i + 1, record.mData.getNumberOfElements());
+        EXPECT_EQ(i, record.mData[i]);
+
+        // Views point directly into the mapping
+        EXPECT_GE(&record.mData[0], &mFile.getData()[0]);
+        EXPECT_EQ(0U, (position % PacketArchive::alignment));
+    }
+    EXPECT_FALSE(mReader.read(position, record));
+}
+
+TEST_F(PacketArchiveTest, shouldFindStartOfTimeRange)
+{
+    writeArchive(100, 8);
+    ASSERT_TRUE(mFile.open(mPath.c_str()));
+    ASSERT_TRUE(mReader.open(mFile.getData()));
+
+    PacketArchive::Record record;
+    for (int64_t time : {0, 5, 10, 475, 480, 990})
+    {
+        size_t position = mReader.find(at(time));
+        ASSERT_TRUE(mReader.read(position, record));
+        EXPECT_EQ(at(((time + 9) / 10) * 10), record.mTime);
+    }
+
+    size_t position = mReader.find(at(1000));
+    EXPECT_FALSE(mReader.read(position, record));
+}
+
+TEST_F(PacketArchiveTest, shouldRejectRecordsOutOfOrder)
+{
+    PacketArchiveWriter writer;
+    ASSERT_TRUE(writer.open(mPath.c_str()));
+
+    uint8_t data[1] = {0};
+    EXPECT_TRUE(writer.append(at(10), 0, outpost::asSlice(data)));
+    EXPECT_TRUE(writer.append(at(10), 0, outpost::asSlice(data)));
+    EXPECT_FALSE(writer.append(at(9), 0, outpost::asSlice(data)));
+    EXPECT_TRUE(writer.close());
+}
+
+TEST_F(PacketArchiveTest, shouldRejectInvalidArchives)
+{
+    uint8_t data[PacketArchive::headerSize] = {};
+    EXPECT_FALSE(mReader.open(outpost::asSlice(data)));
+    EXPECT_FALSE(mReader.open(outpost::asSlice(data).first(10)));
+
+    // Truncated capture whose index is missing
+    writeArchive(10, 4);
+    ASSERT_TRUE(mFile.open(mPath.c_str()));
+    std::vector<uint8_t> truncated(mFile.getData().begin(), mFile.getData().end() - 1);
+    EXPECT_FALSE(mReader.open(outpost::asSlice(truncated)));
+}
+
+TEST_F(PacketArchiveTest, shouldFailForMissingFile)
+{
+    EXPECT_FALSE(mFile.open("/tmp/outpost_archive_does_not_exist"));
+    EXPECT_FALSE(mFile.isOpen());
+    EXPECT_EQ(0U, mFile.getData().getNumberOfElements());
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/storage/bit_packing.h>
+#include <outpost/utils/storage/bit_writer.h>
+#include <outpost/utils/storage/serialize.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace outpost;
+
+namespace
+{
+template <uint8_t width>
+void
+checkAgainstBitWriter(size_t numberOfValues)
+{
+    uint16_t values[80];
+    uint8_t expected[160];
+    BitWriter writer(asSlice(expected));
+    for (size_t i = 0; i < numberOfValues; ++i)
+    {
+        values[i] = static_cast<uint16_t>((i * 0x9E37U + 0x1234U) & ((1U << width) - 1));
+        writer.pushBits(values[i], width);
+    }
+    writer.flush();
+    ASSERT_EQ(BitPacking<width>::getPackedSize(numberOfValues), writer.getSize());
+
+    uint8_t packed[160];
+    BitPacking<width>::pack(values, numberOfValues, packed);
+    for (size_t i = 0; i < writer.getSize(); ++i)
+    {
+        ASSERT_EQ(expected[i], packed[i]) << static_cast<int>(width) << ", " << i;
+    }
+
+    uint16_t unpacked[80];
+    BitPacking<width>::unpack(packed, unpacked, numberOfValues);
+    for (size_t i = 0; i < numberOfValues; ++i)
+    {
+        ASSERT_EQ(values[i], unpacked[i]) << static_cast<int>(width) << ", " << i;
+    }
+}
+}  // namespace
+
+TEST(BitPackingTest, shouldPackLikeSerializePacked12)
+{
+    const uint16_t values[4] = {0x123, 0x456, 0x789, 0xABC};
+
+    uint8_t expected[6];
+    Serialize stream(expected);
+    stream.storePacked12(values[0], values[1]);
+    stream.storePacked12(values[2], values[3]);
+
+    uint8_t packed[6];
+    ASSERT_TRUE(BitPacking<12>::pack(asSlice(values), asSlice(packed)));
+    EXPECT_THAT(packed, testing::ElementsAreArray(expected));
+
+    uint16_t unpacked[4];
+    ASSERT_TRUE(BitPacking<12>::unpack(asSlice(packed), asSlice(unpacked)));
+    EXPECT_THAT(unpacked, testing::ElementsAreArray(values));
+}
+
+TEST(BitPackingTest, shouldMatchBitWriterForAllWidths)
+{
+    // Full groups and an incomplete last group, the larger ones also use
+    // the word wise access for the first groups
+    const size_t numberOfValues[6] = {0, 5, 8, 29, 37, 80};
+    for (size_t n : numberOfValues)
+    {
+        checkAgainstBitWriter<1>(n);
+        checkAgainstBitWriter<3>(n);
+        checkAgainstBitWriter<8>(n);
+        checkAgainstBitWriter<10>(n);
+        checkAgainstBitWriter<12>(n);
+        checkAgainstBitWriter<14>(n);
+        checkAgainstBitWriter<15>(n);
+        checkAgainstBitWriter<16>(n);
+    }
+}
+
+TEST(BitPackingTest, shouldIgnoreBitsAboveWidthAndClearPadding)
+{
+    const uint16_t values[3] = {0xFFFF, 0x0000, 0xFC00};
+
+    uint8_t packed[4] = {0xAA, 0xAA, 0xAA, 0xAA};
+    ASSERT_TRUE(BitPacking<10>::pack(asSlice(values), asSlice(packed)));
+    EXPECT_THAT(packed, testing::ElementsAre(0xFF, 0xC0, 0x00, 0x00));
+}
+
+TEST(BitPackingTest, shouldRejectTooSmallBuffers)
+{
+    uint16_t values[8] = {};
+    uint8_t packed[14] = {};
+
+    EXPECT_EQ(14U, BitPacking<14>::getPackedSize(8));
+    EXPECT_FALSE(BitPacking<14>::pack(asSlice(values), asSlice(packed).first(13)));
+    EXPECT_FALSE(BitPacking<14>::unpack(asSlice(packed).first(13), asSlice(values)));
+    EXPECT_TRUE(BitPacking<14>::unpack(asSlice(packed), asSlice(values)));
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/storage/bit_reader.h>
+#include <outpost/utils/storage/bit_writer.h>
+#include <outpost/utils/storage/bitstream.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace outpost;
+
+TEST(BitWriterTest, shouldPushFieldsMostSignificantBitFirst)
+{
+    uint8_t data[7];
+    memset(data, 0xFF, sizeof(data));
+    BitWriter writer(asSlice(data));
+
+    EXPECT_TRUE(writer.pushBits(0x5, 3));
+    EXPECT_TRUE(writer.pushBit(false));
+    EXPECT_TRUE(writer.pushBits(0xABC, 12));
+    EXPECT_TRUE(writer.pushBits(0x12345678, 32));
+    EXPECT_TRUE(writer.pushBits(0xFF3, 2));
+
+    EXPECT_EQ(50U, writer.getNumberOfBits());
+    EXPECT_EQ(7U, writer.flush());
+    EXPECT_THAT(data, testing::ElementsAre(0xAA, 0xBC, 0x12, 0x34, 0x56, 0x78, 0xC0));
+}
+
+TEST(BitWriterTest, shouldRejectBitsBeyondTheBuffer)
+{
+    uint8_t data[2];
+    BitWriter writer(asSlice(data));
+
+    EXPECT_TRUE(writer.pushBits(0x1FF, 9));
+    EXPECT_FALSE(writer.pushBits(0, 8));
+    EXPECT_FALSE(writer.pushBits(0, 33));
+    EXPECT_TRUE(writer.pushBits(0, 7));
+    EXPECT_FALSE(writer.pushBit(true));
+    EXPECT_EQ(0U, writer.getNumberOfFreeBits());
+
+    EXPECT_EQ(2U, writer.flush());
+    EXPECT_THAT(data, testing::ElementsAre(0xFF, 0x80));
+}
+
+TEST(BitWriterTest, shouldPushBytesAlignedAndUnaligned)
+{
+    const uint8_t bytes[5] = {0x12, 0x34, 0x56, 0x78, 0x9A};
+
+    uint8_t data[12];
+    BitWriter writer(asSlice(data));
+    EXPECT_TRUE(writer.pushBits(0xF, 4));
+    EXPECT_TRUE(writer.pushBytes(asSlice(bytes)));
+    writer.alignToByte();
+    EXPECT_EQ(48U, writer.getNumberOfBits());
+    EXPECT_TRUE(writer.pushBytes(asSlice(bytes)));
+    EXPECT_FALSE(writer.pushBytes(asSlice(bytes)));
+
+    EXPECT_EQ(11U, writer.flush());
+    EXPECT_THAT(std::vector<uint8_t>(&data[0], &data[11]),
+                testing::ElementsAre(
+                        0xF1, 0x23, 0x45, 0x67, 0x89, 0xA0, 0x12, 0x34, 0x56, 0x78, 0x9A));
+}
+
+TEST(BitWriterTest, flushShouldKeepAppendingBits)
+{
+    uint8_t data[2];
+    BitWriter writer(asSlice(data));
+
+    writer.pushBits(0x5, 3);
+    EXPECT_EQ(1U, writer.flush());
+    EXPECT_EQ(0xA0, data[0]);
+
+    writer.pushBits(0x1F, 5);
+    writer.pushBits(0x1, 1);
+    EXPECT_EQ(2U, writer.flush());
+    EXPECT_EQ(0xBF, data[0]);
+    EXPECT_EQ(0x80, data[1]);
+}
+
+TEST(BitReaderTest, shouldReadWrittenFields)
+{
+    // 528 bits in total
+    uint8_t data[66];
+    BitWriter writer(asSlice(data));
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        ASSERT_TRUE(writer.pushBits(i * 0x9E3779B9U, static_cast<uint8_t>(i + 1)));
+    }
+    writer.flush();
+
+    BitReader reader(Slice<const uint8_t>(asSlice(data).first(writer.getSize())),
+                     writer.getNumberOfBits());
+    for (uint32_t i = 0; i < 32; i++)
+    {
+        const uint32_t mask = (i == 31) ? 0xFFFFFFFFU : ((1U << (i + 1)) - 1);
+        EXPECT_EQ((i * 0x9E3779B9U) & mask, reader.readBits(static_cast<uint8_t>(i + 1))) << i;
+    }
+    EXPECT_EQ(0U, reader.getNumberOfRemainingBits());
+}
+
+TEST(BitReaderTest, shouldReadZeroBeyondTheEnd)
+{
+    const uint8_t data[2] = {0xFF, 0xFF};
+    BitReader reader(asSlice(data), 12);
+
+    EXPECT_EQ(0x7FU, reader.readBits(7));
+    EXPECT_EQ(0x3E0U, reader.readBits(10));
+    EXPECT_FALSE(reader.readBit());
+    EXPECT_EQ(18U, reader.getPosition());
+    EXPECT_EQ(0U, reader.getNumberOfRemainingBits());
+}
+
+TEST(BitReaderTest, shouldReadBytesAlignedAndUnaligned)
+{
+    const uint8_t data[11] = {0xF1, 0x23, 0x45, 0x67, 0x89, 0xA0, 0x12, 0x34, 0x56, 0x78, 0x9A};
+    BitReader reader(asSlice(data));
+
+    uint8_t bytes[5];
+    EXPECT_EQ(0xFU, reader.readBits(4));
+    EXPECT_TRUE(reader.readBytes(asSlice(bytes)));
+    EXPECT_THAT(bytes, testing::ElementsAre(0x12, 0x34, 0x56, 0x78, 0x9A));
+
+    reader.alignToByte();
+    EXPECT_EQ(48U, reader.getPosition());
+    memset(bytes, 0, sizeof(bytes));
+    EXPECT_TRUE(reader.readBytes(asSlice(bytes)));
+    EXPECT_THAT(bytes, testing::ElementsAre(0x12, 0x34, 0x56, 0x78, 0x9A));
+    EXPECT_FALSE(reader.readBytes(asSlice(bytes).first(1)));
+}
+
+TEST(BitstreamHeaderTest, shouldUseBitstreamWireFormat)
+{
+    uint8_t data[16];
+    BitWriter writer(asSlice(data).skipFirst(BitstreamHeader::size));
+    writer.pushBits(0x2AB, 10);
+    writer.pushBits(0x5, 3);
+    writer.flush();
+    BitstreamHeader::store(asSlice(data), writer.getNumberOfBits());
+
+    uint8_t buffer[16];
+    Slice<uint8_t> slice(buffer);
+    Bitstream bitstream(slice);
+    Deserialize input(data);
+    ASSERT_TRUE(bitstream.deserialize(input));
+    ASSERT_EQ(13U, bitstream.getNumberOfBits());
+
+    uint8_t serialized[16];
+    Serialize output(serialized);
+    bitstream.serialize(output);
+
+    uint32_t numberOfBits = 0;
+    ASSERT_TRUE(BitstreamHeader::read(asSlice(serialized), numberOfBits));
+    EXPECT_EQ(13U, numberOfBits);
+
+    BitReader reader(Slice<const uint8_t>(asSlice(serialized).skipFirst(BitstreamHeader::size)),
+                     numberOfBits);
+    EXPECT_EQ(0x2ABU, reader.readBits(10));
+    EXPECT_EQ(0x5U, reader.readBits(3));
+}
+
+TEST(BitstreamHeaderTest, shouldRejectInvalidHeaders)
+{
+    uint32_t numberOfBits = 0;
+    const uint8_t tooShort[2] = {0, 3};
+    EXPECT_FALSE(BitstreamHeader::read(asSlice(tooShort), numberOfBits));
+
+    const uint8_t invalidBytePointer[4] = {0, 2, 7, 0};
+    EXPECT_FALSE(BitstreamHeader::read(asSlice(invalidBytePointer), numberOfBits));
+
+    const uint8_t exceedsBuffer[4] = {0, 5, 7, 0};
+    EXPECT_FALSE(BitstreamHeader::read(asSlice(exceedsBuffer), numberOfBits));
+}
@@ -296,3 +296,97 @@ TEST(BitstreamTest, deserializeFail)
         EXPECT_EQ(bitstream.getSerializedSize(), 3U);
     }
 }
+
+TEST(BitstreamTest, pushBitsShouldMatchSingleBits)
+{
+    memset(buffer_in, 0xFF, ARRAY_LENGTH);
+    memset(buffer_out, 0, ARRAY_LENGTH);
+
+    outpost::Bitstream bits(data_in);
+    outpost::Bitstream reference(data_out);
+
+    const uint32_t values[] = {0x5, 0x0, 0x3FF, 0x12345678, 0x1, 0xABCDEF};
+    const uint8_t counts[] = {3, 5, 10, 32, 1, 24};
+    for (size_t i = 0; i < sizeof(counts); i++)
+    {
+        bits.pushBits(values[i], counts[i]);
+        for (int j = counts[i] - 1; j >= 0; j--)
+        {
+            reference.pushBit((values[i] >> j) & 1);
+        }
+    }
+
+    EXPECT_EQ(reference.getSize(), bits.getSize());
+    EXPECT_EQ(75U, bits.getNumberOfBits());
+    for (uint16_t i = 0; i < reference.getSize(); i++)
+    {
+        EXPECT_EQ(reference.getByte(i), bits.getByte(i)) << "at byte " << i;
+    }
+}
+
+TEST(BitstreamTest, pushBitsShouldStopAtEndOfBuffer)
+{
+    memset(buffer_in, 0, ARRAY_LENGTH);
+    outpost::Slice<uint8_t> shortBuffer = data_in.first(5);
+    outpost::Bitstream bitstream(shortBuffer);
+
+    bitstream.pushBits(0xFFFFFFFF, 32);
+    EXPECT_TRUE(bitstream.isFull());
+    EXPECT_EQ(2U, bitstream.getSize());
+    EXPECT_EQ(0U, buffer_in[5]);
+}
+
+TEST(BitstreamTest, writerShouldCollectBits)
+{
+    memset(buffer_in, 0, ARRAY_LENGTH);
+    memset(buffer_out, 0, ARRAY_LENGTH);
+
+    outpost::Bitstream bits(data_in);
+    outpost::Bitstream reference(data_out);
+    {
+        outpost::BitstreamWriter writer(bits);
+        for (uint32_t i = 0; i < 100; i++)
+        {
+            writer.pushBit((i % 3) == 0);
+            reference.pushBit((i % 3) == 0);
+            if ((i % 10) == 0)
+            {
+                writer.pushBits(i, 7);
+                reference.pushBits(i, 7);
+            }
+        }
+        writer.pushBits(0xDEADBEEF, 32);
+        reference.pushBits(0xDEADBEEF, 32);
+
+        writer.flush();
+        EXPECT_EQ(reference.getNumberOfBits(), bits.getNumberOfBits());
+
+        writer.pushBit(true);
+        reference.pushBit(true);
+    }
+
+    ASSERT_EQ(reference.getNumberOfBits(), bits.getNumberOfBits());
+    for (uint16_t i = 0; i < reference.getSize(); i++)
+    {
+        EXPECT_EQ(reference.getByte(i), bits.getByte(i)) << "at byte " << i;
+    }
+}
+
+TEST(BitstreamTest, readerShouldReadSequentially)
+{
+    memset(buffer_in, 0, ARRAY_LENGTH);
+    outpost::Bitstream bitstream(data_in);
+    bitstream.pushBits(0xA5, 8);
+    bitstream.pushBits(0x3, 3);
+
+    outpost::BitstreamReader reader(bitstream, 4);
+    EXPECT_EQ(0x5U, reader.getBits(4));
+    EXPECT_FALSE(reader.getBit());
+    EXPECT_EQ(0x3U, reader.getBits(2));
+    EXPECT_EQ(11U, reader.getPosition());
+
+    // Beyond the end of the stream
+    EXPECT_FALSE(reader.getBit());
+    EXPECT_EQ(0U, reader.getBits(16));
+    EXPECT_EQ(28U, reader.getPosition());
+}
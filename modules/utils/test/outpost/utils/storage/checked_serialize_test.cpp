@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/storage/checked_serialize.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace outpost;
+
+TEST(CheckedSerializeTest, shouldCalculateMessageSize)
+{
+    EXPECT_EQ(0U, CheckedSerialize::getTypeSize<>());
+    EXPECT_EQ(15U, (CheckedSerialize::getTypeSize<uint8_t, const uint16_t, float, double>()));
+}
+
+TEST(CheckedSerializeTest, shouldStoreMessages)
+{
+    uint8_t data[9];
+    CheckedSerialize stream(asSlice(data));
+
+    EXPECT_TRUE((stream.store<uint8_t, uint16_t>(0x12, 0x3456)));
+    EXPECT_EQ(6U, stream.getRemainingSize());
+
+    const uint16_t values[2] = {0x789A, 0xBCDE};
+    EXPECT_TRUE(stream.store(Slice<const uint16_t>(values)));
+    EXPECT_TRUE(stream.store<uint16_t>(0xF012));
+
+    EXPECT_FALSE(stream.hasOverflow());
+    EXPECT_EQ(0U, stream.getRemainingSize());
+    EXPECT_EQ(9, stream.getPosition());
+    EXPECT_THAT(data, testing::ElementsAre(0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0x12));
+}
+
+TEST(CheckedSerializeTest, shouldDropMessageOnOverflow)
+{
+    uint8_t data[6] = {0, 0, 0, 0, 0, 0};
+    CheckedSerialize stream(asSlice(data));
+
+    EXPECT_TRUE(stream.store<uint32_t>(0x01020304));
+    EXPECT_FALSE((stream.store<uint8_t, uint16_t>(0xAA, 0xBBCC)));
+    EXPECT_TRUE(stream.hasOverflow());
+
+    // Nothing of the failed message is written
+    EXPECT_EQ(4, stream.getPosition());
+    EXPECT_THAT(data, testing::ElementsAre(0x01, 0x02, 0x03, 0x04, 0, 0));
+
+    // The overflow is sticky even if the next message would fit
+    EXPECT_FALSE(stream.store<uint8_t>(0xAA));
+    EXPECT_FALSE(stream.skip(1));
+    EXPECT_EQ(4, stream.getPosition());
+
+    stream.reset();
+    EXPECT_FALSE(stream.hasOverflow());
+    EXPECT_EQ(6U, stream.getRemainingSize());
+}
+
+TEST(CheckedSerializeTest, shouldCheckArraysAndBuffers)
+{
+    uint8_t data[8];
+    CheckedSerialize stream(asSlice(data));
+
+    uint32_t values[3] = {1, 2, 3};
+    EXPECT_FALSE(stream.store(asSlice(values)));
+    EXPECT_EQ(0, stream.getPosition());
+
+    stream.reset();
+    const uint8_t buffer[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    EXPECT_TRUE(stream.storeBuffer(buffer, 8));
+    EXPECT_FALSE(stream.storeBuffer(buffer, 1));
+    EXPECT_EQ(8U, stream.asSlice().getNumberOfElements());
+}
+
+TEST(CheckedSerializeTest, shouldStorePacketLayouts)
+{
+    typedef PacketLayout<BitsField<4>, BitsField<12>, BigEndianField<uint8_t>> Header;
+
+    uint8_t data[4];
+    CheckedSerialize stream(asSlice(data));
+
+    EXPECT_TRUE(stream.storePacket<Header>(0xA, 0xBCD, 0xEF));
+    EXPECT_FALSE(stream.storePacket<Header>(0, 0, 0));
+    EXPECT_EQ(3, stream.getPosition());
+    EXPECT_EQ(0xAB, data[0]);
+    EXPECT_EQ(0xCD, data[1]);
+    EXPECT_EQ(0xEF, data[2]);
+}
@@ -318,3 +318,37 @@ TEST(DeserializeLittleEndianTest, shouldRetrieveReadDataAsSlice)
     EXPECT_EQ(4U, slice.getNumberOfElements());
     EXPECT_EQ(&data[0], &slice[0]);
 }
+
+TEST(DeserializeLittleEndianTest, readArrayShouldMatchReadingSingleElements)
+{
+    uint8_t data[37 * 4];
+    for (size_t i = 0; i < sizeof(data); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+
+    int32_t values[37];
+    DeserializeLittleEndian payload(data);
+    payload.read(outpost::asSlice(values));
+
+    EXPECT_EQ(37 * 4, payload.getPosition());
+    DeserializeLittleEndian single(data);
+    for (size_t i = 0; i < 37; ++i)
+    {
+        EXPECT_EQ(single.read<int32_t>(), values[i]) << i;
+    }
+}
+
+TEST(DeserializeLittleEndianTest, readArrayOfDoubleValues)
+{
+    const uint8_t data[] = {0x18, 0x2D, 0x44, 0x54, 0xFB, 0x21, 0x09, 0x40,
+                            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xBF};
+
+    double d[2];
+    DeserializeLittleEndian payload(data);
+    payload.read(outpost::asSlice(d));
+
+    EXPECT_EQ(16, payload.getPosition());
+    EXPECT_DOUBLE_EQ(3.1415926535897931, d[0]);
+    EXPECT_DOUBLE_EQ(-1.0, d[1]);
+}
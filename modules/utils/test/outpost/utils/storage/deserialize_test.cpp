@@ -325,3 +325,45 @@ TEST(DeserializeTest, readSigned24ShouldDecodeForAllBitPositions)
         negative *= 2;
     }
 }
+
+TEST(DeserializeTest, readArrayShouldMatchReadingSingleElements)
+{
+    uint8_t data[37 * 2];
+    for (size_t i = 0; i < sizeof(data); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+
+    uint16_t values[37];
+    Deserialize payload(data);
+    payload.read(outpost::asSlice(values));
+
+    EXPECT_EQ(37 * 2, payload.getPosition());
+    Deserialize single(data);
+    for (size_t i = 0; i < 37; ++i)
+    {
+        EXPECT_EQ(single.read<uint16_t>(), values[i]) << i;
+    }
+}
+
+TEST(DeserializeTest, readArrayOfFloatingPointAndSignedValues)
+{
+    const uint8_t data[] = {0x40, 0x49, 0x0F, 0xD0, 0xBF, 0x80, 0x00, 0x00, 0xFF, 0xFE,
+                            0x12, 0x34, 0x40, 0x09, 0x21, 0xFB, 0x54, 0x44, 0x2D, 0x18};
+
+    float f[2];
+    int16_t s[2];
+    double d[1];
+
+    Deserialize payload(data);
+    payload.read(outpost::asSlice(f));
+    payload.read(outpost::asSlice(s));
+    payload.read(outpost::asSlice(d));
+
+    EXPECT_EQ(sizeof(data), payload.getPosition<size_t>());
+    EXPECT_FLOAT_EQ(3.14159f, f[0]);
+    EXPECT_FLOAT_EQ(-1.0f, f[1]);
+    EXPECT_EQ(-2, s[0]);
+    EXPECT_EQ(0x1234, s[1]);
+    EXPECT_DOUBLE_EQ(3.1415926535897931, d[0]);
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/storage/packet_layout.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace outpost;
+
+namespace
+{
+typedef PacketLayout<BitsField<3>,
+                     BitsField<1>,
+                     BitsField<1>,
+                     BitsField<11>,
+                     BitsField<2>,
+                     BitsField<14>,
+                     BigEndianField<uint16_t>>
+        PrimaryHeader;
+
+typedef PacketLayout<BigEndianField<uint8_t>,
+                     BigEndianField<uint32_t>,
+                     LittleEndianField<uint16_t>,
+                     BigEndianField<float>,
+                     LittleEndianField<int64_t>>
+        MixedPacket;
+}  // namespace
+
+TEST(PacketLayoutTest, shouldHaveStaticSize)
+{
+    EXPECT_EQ(48U, PrimaryHeader::numberOfBits);
+    EXPECT_EQ(6U, PrimaryHeader::size);
+    EXPECT_EQ(19U, MixedPacket::size);
+}
+
+TEST(PacketLayoutTest, shouldStoreBitFields)
+{
+    uint8_t data[6] = {};
+    PrimaryHeader::store(data, 0, 1, 1, 0x7FA, 3, 0x1234, 0xABCD);
+
+    EXPECT_THAT(data, testing::ElementsAre(0x1F, 0xFA, 0xD2, 0x34, 0xAB, 0xCD));
+}
+
+TEST(PacketLayoutTest, shouldReadBitFields)
+{
+    const uint8_t data[6] = {0x1F, 0xFA, 0xD2, 0x34, 0xAB, 0xCD};
+
+    uint16_t version;
+    uint16_t type;
+    uint16_t secondaryHeader;
+    uint16_t apid;
+    uint16_t flags;
+    uint16_t count;
+    uint16_t length;
+    PrimaryHeader::read(data, version, type, secondaryHeader, apid, flags, count, length);
+
+    EXPECT_EQ(0, version);
+    EXPECT_EQ(1, type);
+    EXPECT_EQ(1, secondaryHeader);
+    EXPECT_EQ(0x7FA, apid);
+    EXPECT_EQ(3, flags);
+    EXPECT_EQ(0x1234, count);
+    EXPECT_EQ(0xABCD, length);
+}
+
+TEST(PacketLayoutTest, shouldMatchSerializeWithMixedByteOrder)
+{
+    uint8_t expected[19];
+    uint8_t* position = expected;
+    SerializeBigEndianTraits<uint8_t>::store(position, 0x12);
+    SerializeBigEndianTraits<uint32_t>::store(position, 0x3456789A);
+    SerializeLittleEndianTraits<uint16_t>::store(position, 0xBCDE);
+    SerializeBigEndianTraits<float>::store(position, 3.14159f);
+    SerializeLittleEndianTraits<int64_t>::store(position, -2);
+
+    uint8_t data[19];
+    MixedPacket::store(data, 0x12, 0x3456789A, 0xBCDE, 3.14159f, -2);
+    EXPECT_EQ(0, memcmp(expected, data, sizeof(data)));
+
+    uint8_t byte;
+    uint32_t word;
+    uint16_t half;
+    float f;
+    int64_t value;
+    MixedPacket::read(data, byte, word, half, f, value);
+
+    EXPECT_EQ(0x12, byte);
+    EXPECT_EQ(0x3456789AU, word);
+    EXPECT_EQ(0xBCDE, half);
+    EXPECT_FLOAT_EQ(3.14159f, f);
+    EXPECT_EQ(-2, value);
+}
+
+TEST(PacketLayoutTest, shouldAdvanceStreams)
+{
+    uint8_t data[8] = {};
+    Serialize stream(data);
+    stream.store<uint8_t>(0x55);
+    PrimaryHeader::store(stream, 0, 0, 0, 0x123, 1, 2, 3);
+    stream.store<uint8_t>(0xAA);
+
+    EXPECT_EQ(8, stream.getPosition());
+    EXPECT_THAT(data, testing::ElementsAre(0x55, 0x01, 0x23, 0x40, 0x02, 0x00, 0x03, 0xAA));
+
+    Deserialize input(data);
+    EXPECT_EQ(0x55, input.read<uint8_t>());
+
+    uint16_t fields[7];
+    PrimaryHeader::read(
+            input, fields[0], fields[1], fields[2], fields[3], fields[4], fields[5], fields[6]);
+    EXPECT_THAT(fields, testing::ElementsAre(0, 0, 0, 0x123, 1, 2, 3));
+    EXPECT_EQ(0xAA, input.read<uint8_t>());
+}
+
+TEST(PacketLayoutTest, shouldAccessSingleFields)
+{
+    EXPECT_EQ(5U, PrimaryHeader::Field<3>::bitOffset);
+    EXPECT_EQ(32U, PrimaryHeader::Field<6>::bitOffset);
+    EXPECT_EQ(88U, MixedPacket::Field<4>::bitOffset);
+
+    uint8_t data[6];
+    PrimaryHeader::store(data, 0, 1, 1, 0x7FA, 3, 0x1234, 0xABCD);
+
+    EXPECT_EQ(0x7FA, PrimaryHeader::get<3>(data));
+    PrimaryHeader::set<3>(data, 0x005);
+    PrimaryHeader::set<6>(data, 0x0102);
+    EXPECT_THAT(data, testing::ElementsAre(0x18, 0x05, 0xD2, 0x34, 0x01, 0x02));
+}
@@ -231,3 +231,42 @@ TEST(SerializeLitteEndianTest, shouldRetrieveWrittenOutputAsSlice)
     EXPECT_EQ(4U, slice.getNumberOfElements());
     EXPECT_EQ(&data[0], &slice[0]);
 }
+
+TEST(SerializeLittleEndianTest, storeArrayShouldMatchStoringSingleElements)
+{
+    uint64_t values[19];
+    for (size_t i = 0; i < 19; ++i)
+    {
+        values[i] = 0x0102030405060708ULL * (i + 1);
+    }
+
+    uint8_t expected[19 * 8];
+    SerializeLittleEndian single(expected);
+    for (size_t i = 0; i < 19; ++i)
+    {
+        single.store<uint64_t>(values[i]);
+    }
+
+    uint8_t data[19 * 8];
+    SerializeLittleEndian payload(data);
+    payload.store(outpost::asSlice(values));
+
+    EXPECT_EQ(19 * 8, payload.getPosition());
+    EXPECT_EQ(0, memcmp(expected, data, sizeof(data)));
+}
+
+TEST(SerializeLittleEndianTest, storeArrayOfFloatingPointAndSignedValues)
+{
+    const float f[2] = {3.14159f, -1.0f};
+    const int32_t s[1] = {-2};
+
+    uint8_t data[8 + 4];
+    SerializeLittleEndian payload(data);
+    payload.store(outpost::Slice<const float>(f));
+    payload.store(outpost::Slice<const int32_t>(s));
+
+    EXPECT_EQ(sizeof(data), payload.getPosition<size_t>());
+    EXPECT_THAT(data,
+                testing::ElementsAre(
+                        0xD0, 0x0F, 0x49, 0x40, 0x00, 0x00, 0x80, 0xBF, 0xFE, 0xFF, 0xFF, 0xFF));
+}
@@ -231,3 +231,46 @@ TEST(SerializeTest, shouldRetrieveWrittenOutputAsSlice)
     EXPECT_EQ(4U, slice.getNumberOfElements());
     EXPECT_EQ(&data[0], &slice[0]);
 }
+
+TEST(SerializeTest, storeArrayShouldMatchStoringSingleElements)
+{
+    // Spans more than one block of the byte swapping loop
+    uint32_t values[37];
+    for (size_t i = 0; i < 37; ++i)
+    {
+        values[i] = 0x01020304U * static_cast<uint32_t>(i + 1) + 0x80000000U;
+    }
+
+    uint8_t expected[37 * 4];
+    Serialize single(expected);
+    for (size_t i = 0; i < 37; ++i)
+    {
+        single.store<uint32_t>(values[i]);
+    }
+
+    uint8_t data[37 * 4];
+    Serialize payload(data);
+    payload.store(outpost::asSlice(values));
+
+    EXPECT_EQ(37 * 4, payload.getPosition());
+    EXPECT_EQ(0, memcmp(expected, data, sizeof(data)));
+}
+
+TEST(SerializeTest, storeArrayOfFloatingPointAndSignedValues)
+{
+    const float f[2] = {3.14159f, -1.0f};
+    const int16_t s[2] = {-2, 0x1234};
+    const double d[1] = {3.1415926535897931};
+
+    uint8_t data[8 + 4 + 8];
+    Serialize payload(data);
+    payload.store(outpost::Slice<const float>(f));
+    payload.store(outpost::Slice<const int16_t>(s));
+    payload.store(outpost::Slice<const double>(d));
+
+    EXPECT_EQ(sizeof(data), payload.getPosition<size_t>());
+    EXPECT_THAT(data,
+                testing::ElementsAre(0x40, 0x49, 0x0F, 0xD0, 0xBF, 0x80, 0x00, 0x00,
+                                     0xFF, 0xFE, 0x12, 0x34,
+                                     0x40, 0x09, 0x21, 0xFB, 0x54, 0x44, 0x2D, 0x18));
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/storage/varint.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+using namespace outpost;
+
+TEST(VarIntTest, shouldEncodeSingleValues)
+{
+    uint8_t data[10];
+
+    EXPECT_EQ(1U, VarInt::encode<uint32_t>(0, asSlice(data)));
+    EXPECT_EQ(0, data[0]);
+
+    EXPECT_EQ(1U, VarInt::encode<uint32_t>(127, asSlice(data)));
+    EXPECT_EQ(0x7F, data[0]);
+
+    EXPECT_EQ(2U, VarInt::encode<uint32_t>(300, asSlice(data)));
+    EXPECT_EQ(0xAC, data[0]);
+    EXPECT_EQ(0x02, data[1]);
+
+    EXPECT_EQ(5U, VarInt::encode<uint32_t>(0xFFFFFFFF, asSlice(data)));
+    EXPECT_THAT(data, testing::ElementsAre(0xFF, 0xFF, 0xFF, 0xFF, 0x0F, testing::_, testing::_,
+                                           testing::_, testing::_, testing::_));
+
+    EXPECT_EQ(10U, VarInt::encode<uint64_t>(UINT64_MAX, asSlice(data)));
+    EXPECT_EQ(0x01, data[9]);
+}
+
+TEST(VarIntTest, shouldZigzagEncodeSignedValues)
+{
+    EXPECT_EQ(0U, VarInt::zigzagEncode<int32_t>(0));
+    EXPECT_EQ(1U, VarInt::zigzagEncode<int32_t>(-1));
+    EXPECT_EQ(2U, VarInt::zigzagEncode<int32_t>(1));
+    EXPECT_EQ(0xFFFFFFFEU, VarInt::zigzagEncode<int32_t>(INT32_MAX));
+    EXPECT_EQ(0xFFFFFFFFU, VarInt::zigzagEncode<int32_t>(INT32_MIN));
+
+    const int64_t values[] = {0, -1, 1, -64, 64, INT64_MIN, INT64_MAX};
+    for (int64_t value : values)
+    {
+        EXPECT_EQ(value, VarInt::zigzagDecode(VarInt::zigzagEncode(value)));
+    }
+
+    uint8_t data[5];
+    EXPECT_EQ(1U, VarInt::encode<int16_t>(-64, asSlice(data)));
+    EXPECT_EQ(0x7F, data[0]);
+
+    int16_t value = 0;
+    EXPECT_EQ(1U, VarInt::decode(Slice<const uint8_t>(data).first(1), value));
+    EXPECT_EQ(-64, value);
+}
+
+TEST(VarIntTest, shouldRejectTooSmallOutputBuffer)
+{
+    uint8_t data[4] = {0xA5, 0xA5, 0xA5, 0xA5};
+
+    EXPECT_EQ(0U, VarInt::encode<uint32_t>(0x10000000, asSlice(data)));
+    EXPECT_THAT(data, testing::ElementsAre(0xA5, 0xA5, 0xA5, 0xA5));
+
+    EXPECT_EQ(4U, VarInt::encode<uint32_t>(0x0FFFFFFF, asSlice(data)));
+}
+
+TEST(VarIntTest, shouldRejectInvalidInput)
+{
+    uint32_t value = 42;
+
+    // Truncated value
+    const uint8_t truncated[] = {0x80, 0x80};
+    EXPECT_EQ(0U, VarInt::decode(Slice<const uint8_t>(truncated), value));
+
+    // Too many bits for a uint32_t
+    const uint8_t overflow[] = {0xFF, 0xFF, 0xFF, 0xFF, 0x1F};
+    EXPECT_EQ(0U, VarInt::decode(Slice<const uint8_t>(overflow), value));
+
+    // Too many bytes for a uint32_t
+    const uint8_t tooLong[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x00};
+    EXPECT_EQ(0U, VarInt::decode(Slice<const uint8_t>(tooLong), value));
+
+    EXPECT_EQ(42U, value);
+
+    const uint8_t maximum[] = {0xFF, 0xFF, 0xFF, 0xFF, 0x0F};
+    EXPECT_EQ(5U, VarInt::decode(Slice<const uint8_t>(maximum), value));
+    EXPECT_EQ(0xFFFFFFFFU, value);
+}
+
+TEST(VarIntTest, shouldEncodeAndDecodeArrays)
+{
+    const int32_t values[] = {0, 1, -1, 63, -64, 64, 1000, -100000, INT32_MAX, INT32_MIN};
+    const size_t numberOfValues = sizeof(values) / sizeof(values[0]);
+
+    size_t expectedLength = 0;
+    for (int32_t value : values)
+    {
+        expectedLength += VarInt::getSize(value);
+    }
+
+    // Exact fit uses the checked path, a worst case sized buffer the unchecked one
+    uint8_t exact[30];
+    uint8_t large[numberOfValues * VarInt::getMaximumSize<int32_t>()];
+    ASSERT_EQ(expectedLength,
+              VarInt::encode(Slice<const int32_t>(values),
+                             Slice<uint8_t>::unsafe(exact, expectedLength)));
+    ASSERT_EQ(expectedLength, VarInt::encode(Slice<const int32_t>(values), asSlice(large)));
+    EXPECT_EQ(0, memcmp(exact, large, expectedLength));
+
+    EXPECT_EQ(0U,
+              VarInt::encode(Slice<const int32_t>(values),
+                             Slice<uint8_t>::unsafe(exact, expectedLength - 1)));
+
+    int32_t decoded[numberOfValues] = {};
+    EXPECT_EQ(expectedLength,
+              VarInt::decode(Slice<const uint8_t>::unsafe(large, expectedLength),
+                             asSlice(decoded)));
+    EXPECT_THAT(decoded, testing::ElementsAreArray(values));
+
+    EXPECT_EQ(0U,
+              VarInt::decode(Slice<const uint8_t>::unsafe(large, expectedLength - 1),
+                             asSlice(decoded)));
+}
+
+TEST(DeltaOfDeltaTest, shouldEncodeRegularSequencesWithOneBytePerValue)
+{
+    uint32_t timestamps[100];
+    for (size_t i = 0; i < 100; ++i)
+    {
+        timestamps[i] = 1000000 + 250 * i;
+    }
+
+    uint8_t data[DeltaOfDelta::getMaximumSize<uint32_t>(100)];
+    size_t length = DeltaOfDelta::encode(Slice<const uint32_t>(timestamps), asSlice(data));
+
+    // First value, first difference and a zero for every following value
+    EXPECT_EQ(VarInt::getSize(1000000U) + VarInt::getSize(VarInt::zigzagEncode(250)) + 98,
+              length);
+
+    uint32_t decoded[100] = {};
+    EXPECT_EQ(length,
+              DeltaOfDelta::decode(Slice<const uint8_t>::unsafe(data, length), asSlice(decoded)));
+    EXPECT_THAT(decoded, testing::ElementsAreArray(timestamps));
+}
+
+TEST(DeltaOfDeltaTest, shouldRestoreArbitrarySequences)
+{
+    const int16_t values[] = {0, INT16_MAX, INT16_MIN, -1, 5, 5, 5, 4, INT16_MIN, 17};
+    const size_t numberOfValues = sizeof(values) / sizeof(values[0]);
+
+    uint8_t data[DeltaOfDelta::getMaximumSize<int16_t>(numberOfValues)];
+    size_t length = DeltaOfDelta::encode(Slice<const int16_t>(values), asSlice(data));
+    ASSERT_NE(0U, length);
+
+    // Exact buffer size takes the checked path with the same result
+    uint8_t exact[sizeof(data)];
+    EXPECT_EQ(length,
+              DeltaOfDelta::encode(Slice<const int16_t>(values),
+                                   Slice<uint8_t>::unsafe(exact, length)));
+    EXPECT_EQ(0, memcmp(data, exact, length));
+    EXPECT_EQ(0U,
+              DeltaOfDelta::encode(Slice<const int16_t>(values),
+                                   Slice<uint8_t>::unsafe(exact, length - 1)));
+
+    int16_t decoded[numberOfValues] = {};
+    EXPECT_EQ(length,
+              DeltaOfDelta::decode(Slice<const uint8_t>::unsafe(data, length), asSlice(decoded)));
+    EXPECT_THAT(decoded, testing::ElementsAreArray(values));
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <outpost/utils/storage/serialize.h>
+#include <outpost/utils/trace/trace.h>
+
+#include <unittest/harness.h>
+
+using outpost::utils::Trace;
+using outpost::utils::TraceBuffer;
+using outpost::utils::TraceBufferBase;
+using outpost::utils::TraceRecord;
+
+class TraceBufferTest : public testing::Test
+{
+public:
+    TraceBuffer<4> mBuffer;
+    TraceRecord mRecords[8];
+};
+
+TEST_F(TraceBufferTest, shouldBeEmptyAfterConstruction)
+{
+    EXPECT_EQ(4U, mBuffer.getCapacity());
+    EXPECT_EQ(0U, mBuffer.getNumberOfRecordedEvents());
+    EXPECT_EQ(0U, mBuffer.read(outpost::asSlice(mRecords)));
+}
+
+TEST_F(TraceBufferTest, shouldReadEventsInOrder)
+{
+    mBuffer.record(10, 1, 2);
+    mBuffer.record(11, 3, 4);
+
+    ASSERT_EQ(2U, mBuffer.read(outpost::asSlice(mRecords)));
+    EXPECT_EQ(10U, mRecords[0].mId);
+    EXPECT_EQ(1U, mRecords[0].mArgument0);
+    EXPECT_EQ(2U, mRecords[0].mArgument1);
+    EXPECT_EQ(11U, mRecords[1].mId);
+    EXPECT_EQ(3U, mRecords[1].mArgument0);
+    EXPECT_EQ(4U, mRecords[1].mArgument1);
+    EXPECT_LE(mRecords[0].mTimestamp, mRecords[1].mTimestamp);
+}
+
+TEST_F(TraceBufferTest, shouldKeepNewestEventsWhenFull)
+{
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        mBuffer.record(i, 0, 0);
+    }
+    EXPECT_EQ(6U, mBuffer.getNumberOfRecordedEvents());
+
+    ASSERT_EQ(4U, mBuffer.read(outpost::asSlice(mRecords)));
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(i + 2, mRecords[i].mId);
+    }
+
+    // A smaller output only receives the newest events
+    ASSERT_EQ(2U, mBuffer.read(outpost::asSlice(mRecords).first(2)));
+    EXPECT_EQ(4U, mRecords[0].mId);
+    EXPECT_EQ(5U, mRecords[1].mId);
+}
+
+TEST_F(TraceBufferTest, shouldRemoveEventsOnClear)
+{
+    mBuffer.record(1, 0, 0);
+    mBuffer.clear();
+
+    EXPECT_EQ(0U, mBuffer.getNumberOfRecordedEvents());
+    EXPECT_EQ(0U, mBuffer.read(outpost::asSlice(mRecords)));
+}
+
+TEST_F(TraceBufferTest, shouldSerializeHeaderAndEvents)
+{
+    mBuffer.record(7, 0x01020304, 0x05060708);
+    mBuffer.record(8, 0, 0);
+
+    uint8_t data[TraceBufferBase::headerSize + 2 * TraceBufferBase::serializedRecordSize];
+    ASSERT_EQ(sizeof(data), mBuffer.serialize(outpost::asSlice(data)));
+
+    outpost::Deserialize payload(data);
+    EXPECT_EQ(TraceBufferBase::magic, payload.read<uint32_t>());
+    EXPECT_EQ(2U, payload.read<uint32_t>());
+    EXPECT_EQ(outpost::rtos::CycleClock::getFrequency(), payload.read<uint64_t>());
+
+    payload.skip(8);
+    EXPECT_EQ(7U, payload.read<uint32_t>());
+    EXPECT_EQ(0x01020304U, payload.read<uint32_t>());
+    EXPECT_EQ(0x05060708U, payload.read<uint32_t>());
+    payload.skip(8);
+    EXPECT_EQ(8U, payload.read<uint32_t>());
+}
+
+TEST_F(TraceBufferTest, shouldSerializeNewestEventsFittingIntoBuffer)
+{
+    mBuffer.record(1, 0, 0);
+    mBuffer.record(2, 0, 0);
+
+    uint8_t data[TraceBufferBase::headerSize + TraceBufferBase::serializedRecordSize + 4];
+    ASSERT_EQ(TraceBufferBase::headerSize + TraceBufferBase::serializedRecordSize,
+              mBuffer.serialize(outpost::asSlice(data)));
+
+    outpost::Deserialize payload(data);
+    payload.skip(4);
+    EXPECT_EQ(1U, payload.read<uint32_t>());
+    payload.skip(8 + 8);
+    EXPECT_EQ(2U, payload.read<uint32_t>());
+
+    EXPECT_EQ(0U, mBuffer.serialize(outpost::asSlice(data).first(TraceBufferBase::headerSize - 1)));
+}
+
+TEST_F(TraceBufferTest, shouldRecordIntoGlobalBufferOnlyIfSet)
+{
+    Trace::record(1, 0, 0);
+    EXPECT_EQ(0U, mBuffer.getNumberOfRecordedEvents());
+
+    Trace::setBuffer(&mBuffer);
+    Trace::record(2, 0, 0);
+    Trace::setBuffer(nullptr);
+    Trace::record(3, 0, 0);
+
+    ASSERT_EQ(1U, mBuffer.read(outpost::asSlice(mRecords)));
+    EXPECT_EQ(2U, mRecords[0].mId);
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using unittest::utils::MappedFile;
+
+MappedFile::MappedFile() : mData(nullptr), mSize(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool
+MappedFile::open(const char* path, bool sequential)
+{
+    close();
+
+    const int file = ::open(path, O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat status;
+    if ((fstat(file, &status) != 0) || (status.st_size <= 0))
+    {
+        ::close(file);
+        return false;
+    }
+
+    // The mapping stays valid after the file descriptor is closed
+    const size_t size = static_cast<size_t>(status.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    if (sequential)
+    {
+        madvise(data, size, MADV_SEQUENTIAL);
+    }
+    mData = static_cast<const uint8_t*>(data);
+    mSize = size;
+    return true;
+}
+
+void
+MappedFile::close()
+{
+    if (mData != nullptr)
+    {
+        munmap(const_cast<uint8_t*>(mData), mSize);
+        mData = nullptr;
+        mSize = 0;
+    }
+}
+
+outpost::Slice<const uint8_t>
+MappedFile::getData() const
+{
+    if (mData == nullptr)
+    {
+        return outpost::Slice<const uint8_t>::empty();
+    }
+    return outpost::Slice<const uint8_t>::unsafe(mData, mSize);
+}
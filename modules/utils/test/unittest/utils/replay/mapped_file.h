@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef UNITTEST_UTILS_REPLAY_MAPPED_FILE_H_
+#define UNITTEST_UTILS_REPLAY_MAPPED_FILE_H_
+
+#include <outpost/base/slice.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace unittest
+{
+namespace utils
+{
+/**
+ * Read-only memory mapping of a file on the POSIX host.
+ *
+ * The pages are loaded on access by the operating system, a file of
+ * several gigabytes is usable without reading it first.
+ */
+class MappedFile
+{
+public:
+    MappedFile();
+
+    ~MappedFile();
+
+    // disable copy constructor
+    MappedFile(const MappedFile&) = delete;
+
+    // disable assignment operator
+    MappedFile&
+    operator=(const MappedFile&) = delete;
+
+    /**
+     * Map a file, a previously mapped file is unmapped.
+     *
+     * \param sequential
+     *      Advise the operating system to read ahead for a sequential
+     *      pass through the file.
+     *
+     * \retval false  File could not be opened or mapped.
+     */
+    bool
+    open(const char* path, bool sequential = true);
+
+    void
+    close();
+
+    inline bool
+    isOpen() const
+    {
+        return mData != nullptr;
+    }
+
+    /**
+     * Content of the file, empty if no file is mapped.
+     */
+    outpost::Slice<const uint8_t>
+    getData() const;
+
+private:
+    const uint8_t* mData;
+    size_t mSize;
+};
+
+}  // namespace utils
+}  // namespace unittest
+
+#endif
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "packet_archive.h"
+
+using unittest::utils::PacketArchive;
+using unittest::utils::PacketArchiveReader;
+using unittest::utils::PacketArchiveWriter;
+
+constexpr uint32_t PacketArchive::magic;
+constexpr uint16_t PacketArchive::version;
+constexpr size_t PacketArchive::headerSize;
+constexpr size_t PacketArchive::recordHeaderSize;
+constexpr size_t PacketArchive::indexEntrySize;
+constexpr size_t PacketArchive::alignment;
+constexpr uint16_t PacketArchive::defaultIndexInterval;
+
+static uint64_t
+load(const uint8_t* data, size_t bytes)
+{
+    uint64_t value = 0;
+    for (size_t i = bytes; i > 0; --i)
+    {
+        value = (value << 8) | data[i - 1];
+    }
+    return value;
+}
+
+static void
+store(uint8_t* data, uint64_t value, size_t bytes)
+{
+    for (size_t i = 0; i < bytes; ++i)
+    {
+        data[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+static inline size_t
+align(size_t position)
+{
+    return (position + PacketArchive::alignment - 1) & ~(PacketArchive::alignment - 1);
+}
+
+static inline outpost::time::SpacecraftElapsedTime
+toTime(uint64_t microseconds)
+{
+    return outpost::time::SpacecraftElapsedTime::afterEpoch(
+            outpost::time::Microseconds(static_cast<int64_t>(microseconds)));
+}
+
+// ---------------------------------------------------------------------------
+PacketArchiveReader::PacketArchiveReader() :
+    mArchive(outpost::Slice<const uint8_t>::empty()),
+    mNumberOfRecords(0),
+    mRecordsEnd(0),
+    mIndexOffset(0),
+    mNumberOfIndexEntries(0)
+{
+}
+
+bool
+PacketArchiveReader::open(outpost::Slice<const uint8_t> archive)
+{
+    mArchive = outpost::Slice<const uint8_t>::empty();
+    mNumberOfRecords = 0;
+    mRecordsEnd = 0;
+
+    const size_t size = archive.getNumberOfElements();
+    if (size < PacketArchive::headerSize)
+    {
+        return false;
+    }
+
+    const uint8_t* header = &archive[0];
+    const uint64_t indexOffset = load(&header[16], 8);
+    const uint64_t entries = load(&header[24], 8);
+    if ((load(&header[0], 4) != PacketArchive::magic)
+        || (load(&header[4], 2) != PacketArchive::version) || (load(&header[6], 2) == 0)
+        || (indexOffset < PacketArchive::headerSize) || (indexOffset > size)
+        || (entries > ((size - indexOffset) / PacketArchive::indexEntrySize)))
+    {
+        return false;
+    }
+
+    mArchive = archive;
+    mNumberOfRecords = load(&header[8], 8);
+    mRecordsEnd = static_cast<size_t>(indexOffset);
+    mIndexOffset = static_cast<size_t>(indexOffset);
+    mNumberOfIndexEntries = static_cast<size_t>(entries);
+    return true;
+}
+
+size_t
+PacketArchiveReader::find(outpost::time::SpacecraftElapsedTime time) const
+{
+    const uint64_t target = static_cast<uint64_t>(time.timeSinceEpoch().microseconds());
+
+    // Last index entry before the target time
+    size_t low = 0;
+    size_t high = mNumberOfIndexEntries;
+    while (low < high)
+    {
+        const size_t middle = low + (high - low) / 2;
+        const uint8_t* entry = &mArchive[mIndexOffset + middle * PacketArchive::indexEntrySize];
+        if (static_cast<int64_t>(load(entry, 8)) < static_cast<int64_t>(target))
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    size_t position = begin();
+    if (low > 0)
+    {
+        const uint8_t* entry = &mArchive[mIndexOffset + (low - 1) * PacketArchive::indexEntrySize];
+        const uint64_t offset = load(&entry[8], 8);
+        if ((offset >= begin()) && (offset < mRecordsEnd))
+        {
+            position = static_cast<size_t>(offset);
+        }
+    }
+
+    PacketArchive::Record record;
+    size_t next = position;
+    while (read(next, record))
+    {
+        if (record.mTime >= time)
+        {
+            return position;
+        }
+        position = next;
+    }
+    return mRecordsEnd;
+}
+
+bool
+PacketArchiveReader::read(size_t& position, PacketArchive::Record& record) const
+{
+    if ((position < begin()) || ((position + PacketArchive::recordHeaderSize) > mRecordsEnd))
+    {
+        return false;
+    }
+
+    const uint8_t* header = &mArchive[position];
+    const size_t length = static_cast<size_t>(load(&header[8], 4));
+    const size_t data = position + PacketArchive::recordHeaderSize;
+    if (length > (mRecordsEnd - data))
+    {
+        return false;
+    }
+
+    record.mTime = toTime(load(&header[0], 8));
+    record.mChannel = static_cast<uint16_t>(load(&header[12], 2));
+    record.mData = mArchive.subSlice(data, length);
+    position = align(data + length);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+PacketArchiveWriter::PacketArchiveWriter() :
+    mFile(nullptr),
+    mIndexInterval(PacketArchive::defaultIndexInterval),
+    mNumberOfRecords(0),
+    mPosition(0),
+    mLastTime(0),
+    mIndex(nullptr),
+    mNumberOfIndexEntries(0),
+    mValid(false)
+{
+}
+
+PacketArchiveWriter::~PacketArchiveWriter()
+{
+    close();
+}
+
+bool
+PacketArchiveWriter::open(const char* path, uint16_t indexInterval)
+{
+    close();
+    if (indexInterval == 0)
+    {
+        return false;
+    }
+
+    mFile = fopen(path, "wb");
+    mIndex = tmpfile();
+    if ((mFile == nullptr) || (mIndex == nullptr))
+    {
+        close();
+        return false;
+    }
+
+    mIndexInterval = indexInterval;
+    mNumberOfRecords = 0;
+    mNumberOfIndexEntries = 0;
+    mPosition = 0;
+    mLastTime = INT64_MIN;
+    mValid = true;
+
+    // Placeholder, the header is written by close()
+    const uint8_t header[PacketArchive::headerSize] = {};
+    return write(header, sizeof(header));
+}
+
+bool
+PacketArchiveWriter::append(outpost::time::SpacecraftElapsedTime time,
+                            uint16_t channel,
+                            outpost::Slice<const uint8_t> data)
+{
+    const int64_t microseconds = time.timeSinceEpoch().microseconds();
+    if (!mValid || (microseconds < mLastTime) || (data.getNumberOfElements() > UINT32_MAX))
+    {
+        return false;
+    }
+
+    if ((mNumberOfRecords % mIndexInterval) == 0)
+    {
+        uint8_t entry[PacketArchive::indexEntrySize];
+        store(&entry[0], static_cast<uint64_t>(microseconds), 8);
+        store(&entry[8], mPosition, 8);
+        if (fwrite(entry, sizeof(entry), 1, mIndex) != 1)
+        {
+            mValid = false;
+            return false;
+        }
+        mNumberOfIndexEntries++;
+    }
+
+    uint8_t header[PacketArchive::recordHeaderSize] = {};
+    store(&header[0], static_cast<uint64_t>(microseconds), 8);
+    store(&header[8], data.getNumberOfElements(), 4);
+    store(&header[12], channel, 2);
+
+    const uint8_t padding[PacketArchive::alignment] = {};
+    const size_t length = PacketArchive::recordHeaderSize + data.getNumberOfElements();
+    if (!write(header, sizeof(header))
+        || ((data.getNumberOfElements() > 0) && !write(&data[0], data.getNumberOfElements()))
+        || !write(padding, align(length) - length))
+    {
+        return false;
+    }
+
+    mLastTime = microseconds;
+    mNumberOfRecords++;
+    return true;
+}
+
+bool
+PacketArchiveWriter::close()
+{
+    if (mFile == nullptr)
+    {
+        if (mIndex != nullptr)
+        {
+            fclose(mIndex);
+            mIndex = nullptr;
+        }
+        return false;
+    }
+
+    bool success = mValid;
+    const uint64_t indexOffset = mPosition;
+    if (success)
+    {
+        rewind(mIndex);
+        uint8_t entry[PacketArchive::indexEntrySize];
+        for (uint64_t i = 0; success && (i < mNumberOfIndexEntries); ++i)
+        {
+            success = (fread(entry, sizeof(entry), 1, mIndex) == 1) && write(entry, sizeof(entry));
+        }
+    }
+
+    if (success)
+    {
+        uint8_t header[PacketArchive::headerSize] = {};
+        store(&header[0], PacketArchive::magic, 4);
+        store(&header[4], PacketArchive::version, 2);
+        store(&header[6], mIndexInterval, 2);
+        store(&header[8], mNumberOfRecords, 8);
+        store(&header[16], indexOffset, 8);
+        store(&header[24], mNumberOfIndexEntries, 8);
+        success = (fseek(mFile, 0, SEEK_SET) == 0)
+                  && (fwrite(header, sizeof(header), 1, mFile) == 1);
+    }
+
+    success = (fclose(mFile) == 0) && success;
+    fclose(mIndex);
+    mFile = nullptr;
+    mIndex = nullptr;
+    mValid = false;
+    return success;
+}
+
+bool
+PacketArchiveWriter::write(const void* data, size_t length)
+{
+    if ((length > 0) && (fwrite(data, length, 1, mFile) != 1))
+    {
+        mValid = false;
+        return false;
+    }
+    mPosition += length;
+    return true;
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef UNITTEST_UTILS_REPLAY_PACKET_ARCHIVE_H_
+#define UNITTEST_UTILS_REPLAY_PACKET_ARCHIVE_H_
+
+#include <outpost/base/slice.h>
+#include <outpost/time/time_point.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+namespace unittest
+{
+namespace utils
+{
+/**
+ * Layout of a packet archive file.
+ *
+ * \code
+ * Header (32 bytes)
+ *   0..3    magic "OPKA"
+ *   4..5    version
+ *   6..7    index interval, records per index entry
+ *   8..15   number of records
+ *   16..23  offset of the index
+ *   24..31  number of index entries
+ * Records, each aligned to 8 bytes
+ *   0..7    time in microseconds since the epoch
+ *   8..11   length of the data
+ *   12..13  channel, e.g. the SpaceWire link or protocol identifier
+ *   14..15  reserved
+ *   16..    data
+ * Index, one entry for every index interval records
+ *   0..7    time of the record
+ *   8..15   offset of the record
+ * \endcode
+ *
+ * All values are little endian. The records have to be in the order of
+ * their times, the sparse index then allows a binary search for the
+ * start of a time range.
+ */
+struct PacketArchive
+{
+    static constexpr uint32_t magic = 0x414B504F;
+    static constexpr uint16_t version = 1;
+    static constexpr size_t headerSize = 32;
+    static constexpr size_t recordHeaderSize = 16;
+    static constexpr size_t indexEntrySize = 16;
+    static constexpr size_t alignment = 8;
+    static constexpr uint16_t defaultIndexInterval = 64;
+
+    struct Record
+    {
+        Record() : mTime(), mChannel(0), mData(outpost::Slice<const uint8_t>::empty())
+        {
+        }
+
+        outpost::time::SpacecraftElapsedTime mTime;
+        uint16_t mChannel;
+        outpost::Slice<const uint8_t> mData;
+    };
+};
+
+/**
+ * Read a packet archive from memory, e.g. a MappedFile.
+ *
+ * The records are returned as views into the archive, nothing is copied.
+ * A position in the archive is the byte offset of a record.
+ *
+ * \code
+ * MappedFile file;
+ * PacketArchiveReader reader;
+ * if (file.open("capture.opka") && reader.open(file.getData()))
+ * {
+ *     PacketArchive::Record record;
+ *     for (size_t position = reader.find(begin); reader.read(position, record);)
+ *     {
+ *         ...
+ *     }
+ * }
+ * \endcode
+ */
+class PacketArchiveReader
+{
+public:
+    PacketArchiveReader();
+
+    /**
+     * \retval false  Header or index is invalid.
+     */
+    bool
+    open(outpost::Slice<const uint8_t> archive);
+
+    inline uint64_t
+    getNumberOfRecords() const
+    {
+        return mNumberOfRecords;
+    }
+
+    /**
+     * Position of the first record.
+     */
+    inline size_t
+    begin() const
+    {
+        return PacketArchive::headerSize;
+    }
+
+    /**
+     * Position of the first record with a time of at least \p time.
+     */
+    size_t
+    find(outpost::time::SpacecraftElapsedTime time) const;
+
+    /**
+     * Read the record at \p position and advance \p position to the
+     * next record.
+     *
+     * \retval false  No record left or the record is damaged.
+     */
+    bool
+    read(size_t& position, PacketArchive::Record& record) const;
+
+private:
+    outpost::Slice<const uint8_t> mArchive;
+    uint64_t mNumberOfRecords;
+    size_t mRecordsEnd;
+    size_t mIndexOffset;
+    size_t mNumberOfIndexEntries;
+};
+
+/**
+ * Write a packet archive file.
+ */
+class PacketArchiveWriter
+{
+public:
+    PacketArchiveWriter();
+
+    ~PacketArchiveWriter();
+
+    // disable copy constructor
+    PacketArchiveWriter(const PacketArchiveWriter&) = delete;
+
+    // disable assignment operator
+    PacketArchiveWriter&
+    operator=(const PacketArchiveWriter&) = delete;
+
+    /**
+     * Create the file, an existing file is overwritten.
+     */
+    bool
+    open(const char* path, uint16_t indexInterval = PacketArchive::defaultIndexInterval);
+
+    /**
+     * Append a record.
+     *
+     * \retval false  No file open, \p time is before the time of the
+     *                previous record or writing failed.
+     */
+    bool
+    append(outpost::time::SpacecraftElapsedTime time,
+           uint16_t channel,
+           outpost::Slice<const uint8_t> data);
+
+    /**
+     * Write the index and the header and close the file.
+     */
+    bool
+    close();
+
+private:
+    bool
+    write(const void* data, size_t length);
+
+    FILE* mFile;
+    uint16_t mIndexInterval;
+    uint64_t mNumberOfRecords;
+    uint64_t mPosition;
+    int64_t mLastTime;
+
+    // Index entries are collected in a temporary file and appended on
+    // close, so that the memory needed does not depend on the size of
+    // the archive
+    FILE* mIndex;
+    uint64_t mNumberOfIndexEntries;
+    bool mValid;
+};
+
+}  // namespace utils
+}  // namespace unittest
+
+#endif
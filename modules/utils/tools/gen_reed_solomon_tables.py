@@ -0,0 +1,161 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) 2020, German Aerospace Center (DLR)
+#
+# This file is part of the development version of OUTPOST.
+#
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this
+# file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+"""
+Generates the lookup tables of the CCSDS Reed-Solomon (255,223) code.
+
+The parameters are given by CCSDS 131.0-B, section 4:
+  - field generator polynomial F(x) = x^8 + x^7 + x^2 + x + 1
+  - code generator polynomial g(x) = prod_{j=112}^{143} (x - alpha^(11 j))
+  - symbols are transmitted in the Berlekamp dual basis
+"""
+
+import string
+
+FIELD_POLYNOMIAL = 0x187
+FIRST_ROOT = 112
+PRIMITIVE_ELEMENT = 11
+PARITY = 32
+
+# Rows of the matrix converting from the conventional to the dual basis
+DUAL_BASIS = [0x8d, 0xef, 0xec, 0x86, 0xfa, 0x99, 0xaf, 0x7b]
+
+file_template = string.Template("""/*
+ * Copyright (c) 2020, German Aerospace Center (DLR)
+ *
+ * This file is part of the development version of OUTPOST.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+// Generated by modules/utils/tools/gen_reed_solomon_tables.py, do not edit.
+
+#ifndef OUTPOST_UTILS_CODING_REED_SOLOMON_CCSDS_TABLES_H
+#define OUTPOST_UTILS_CODING_REED_SOLOMON_CCSDS_TABLES_H
+
+#include <stdint.h>
+
+namespace outpost
+{
+namespace utils
+{
+namespace reed_solomon
+{
+// alpha^i, repeated so that the sum of two logarithms needs no reduction
+static const uint8_t exponentTable[512] = {
+        $exponent};
+
+// Logarithm to the base alpha, the logarithm of zero is 255
+static const uint8_t logarithmTable[256] = {
+        $logarithm};
+
+static const uint8_t toDualBasis[256] = {
+        $dual};
+
+static const uint8_t toConventionalBasis[256] = {
+        $conventional};
+
+// Change of the parity register for a feedback symbol, four symbols per
+// word with the first symbol in the most significant byte
+static const uint32_t encodeTable[256][8] = {
+        $encode};
+}  // namespace reed_solomon
+}  // namespace utils
+}  // namespace outpost
+
+#endif
+""")
+
+
+def generate_field():
+    exponent = [0] * 255
+    logarithm = [255] * 256
+    value = 1
+    for i in range(255):
+        exponent[i] = value
+        logarithm[value] = i
+        value <<= 1
+        if value & 0x100:
+            value ^= FIELD_POLYNOMIAL
+    return exponent, logarithm
+
+
+def multiply(a, b, exponent, logarithm):
+    if a == 0 or b == 0:
+        return 0
+    return exponent[(logarithm[a] + logarithm[b]) % 255]
+
+
+def generator_polynomial(exponent, logarithm):
+    # Coefficients with the highest power first
+    g = [1]
+    for j in range(FIRST_ROOT, FIRST_ROOT + PARITY):
+        root = exponent[(PRIMITIVE_ELEMENT * j) % 255]
+        product = g + [0]
+        for k in range(len(g)):
+            product[k + 1] ^= multiply(g[k], root, exponent, logarithm)
+        g = product
+    return g
+
+
+def dual_basis():
+    dual = [0] * 256
+    conventional = [0] * 256
+    for value in range(256):
+        result = 0
+        for row in range(8):
+            if value & (1 << row):
+                result ^= DUAL_BASIS[7 - row]
+        dual[value] = result
+        conventional[result] = value
+    return dual, conventional
+
+
+def format_table(values, width, digits):
+    lines = []
+    for i in range(0, len(values), width):
+        lines.append(", ".join("0x%0*x" % (digits, v) for v in values[i:i + width]))
+    return ",\n        ".join(lines)
+
+
+if __name__ == '__main__':
+    exponent, logarithm = generate_field()
+    g = generator_polynomial(exponent, logarithm)
+    dual, conventional = dual_basis()
+
+    # g(x) is self-reciprocal as its roots are symmetric around alpha^(11 * 127.5)
+    assert g == list(reversed(g))
+    assert sorted(conventional) == list(range(256))
+
+    encode = []
+    for feedback in range(256):
+        # Contributions to the shifted parity register, g[0] = 1 is implicit
+        row = [multiply(feedback, g[k + 1], exponent, logarithm) for k in range(PARITY)]
+        words = []
+        for w in range(PARITY // 4):
+            words.append((row[4 * w] << 24) | (row[4 * w + 1] << 16) | (row[4 * w + 2] << 8)
+                         | row[4 * w + 3])
+        encode.append("{" + ", ".join("0x%08x" % v for v in words[:4]) + ",\n         "
+                      + ", ".join("0x%08x" % v for v in words[4:]) + "}")
+
+    content = file_template.substitute({
+        'exponent': format_table(exponent + exponent + exponent[:2], 12, 2),
+        'logarithm': format_table(logarithm, 12, 2),
+        'dual': format_table(dual, 12, 2),
+        'conventional': format_table(conventional, 12, 2),
+        'encode': ",\n        ".join(encode),
+    })
+
+    file = open("reed_solomon_ccsds_tables.h", "w")
+    file.write(content)
+    file.close()
@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) 2020, German Aerospace Center (DLR)
+#
+# This file is part of the development version of OUTPOST.
+#
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this
+# file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+# Converts dumps of outpost::utils::TraceBufferBase::serialize() into the
+# Chrome trace event format, which can be opened with https://ui.perfetto.dev
+# or chrome://tracing.
+#
+# Every dump is shown as a separate thread, e.g. one dump per thread if
+# every thread records into an own buffer:
+#
+#     trace_to_chrome.py -o trace.json dispatcher.bin rmap.bin
+#
+# Names for application events can be given as `id=name`, ids can be
+# decimal or hexadecimal. Names ending with `Begin` and `End` start and
+# stop a section:
+#
+#     trace_to_chrome.py -n 0x1000=controlBegin -n 0x1001=controlEnd trace.bin
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = 0x4F545243
+HEADER = struct.Struct(">IIQ")
+RECORD = struct.Struct(">QIII")
+
+# Keep in sync with outpost/utils/trace/trace.h
+EVENT_NAMES = {
+    1: "packetReceived",
+    2: "packetQueued",
+    3: "rmapCommandSent",
+    4: "rmapReplyReceived",
+    5: "publishBegin",
+    6: "publishEnd",
+    7: "compressionBegin",
+    8: "compressionEnd",
+}
+
+
+def read_dump(filename):
+    with open(filename, "rb") as dump:
+        data = dump.read()
+
+    if len(data) < HEADER.size:
+        raise ValueError("%s: file too short" % filename)
+
+    magic, count, frequency = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise ValueError("%s: not a trace dump" % filename)
+    if len(data) < HEADER.size + count * RECORD.size:
+        raise ValueError("%s: truncated, expected %d events" % (filename, count))
+
+    records = [RECORD.unpack_from(data, HEADER.size + i * RECORD.size) for i in range(count)]
+    return frequency, records
+
+
+def to_event(record, start, frequency, thread, names):
+    timestamp, event_id, argument0, argument1 = record
+    name = names.get(event_id, "event%d" % event_id)
+
+    event = {
+        "pid": 1,
+        "tid": thread,
+        # Chrome traces use microseconds
+        "ts": (timestamp - start) * 1e6 / frequency,
+        "args": {"argument0": argument0, "argument1": argument1},
+    }
+    if name.endswith("Begin"):
+        event["name"] = name[:-len("Begin")]
+        event["ph"] = "B"
+    elif name.endswith("End"):
+        event["name"] = name[:-len("End")]
+        event["ph"] = "E"
+    else:
+        event["name"] = name
+        event["ph"] = "i"
+        event["s"] = "t"
+    return event
+
+
+def parse_name(text):
+    event_id, separator, name = text.partition("=")
+    if not separator or not name:
+        raise argparse.ArgumentTypeError("expected id=name, got '%s'" % text)
+    return int(event_id, 0), name
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert OUTPOST trace dumps to Chrome traces.")
+    parser.add_argument("dumps", nargs="+", help="output of TraceBufferBase::serialize()")
+    parser.add_argument("-o", "--output", help="output file, default stdout")
+    parser.add_argument("-n", "--name", action="append", type=parse_name, default=[],
+                        help="name of an application event as id=name")
+    args = parser.parse_args()
+
+    names = dict(EVENT_NAMES)
+    names.update(args.name)
+
+    dumps = [read_dump(filename) for filename in args.dumps]
+
+    # All dumps use the same cycle counter, align them to the earliest event
+    timestamps = [records[0][0] for _, records in dumps if records]
+    start = min(timestamps) if timestamps else 0
+
+    events = []
+    for thread, (filename, (frequency, records)) in enumerate(zip(args.dumps, dumps), 1):
+        events.append({"pid": 1, "tid": thread, "ph": "M", "name": "thread_name",
+                       "args": {"name": filename}})
+        events.extend(to_event(record, start, frequency, thread, names) for record in records)
+
+    trace = {"traceEvents": events, "displayTimeUnit": "ns"}
+    if args.output:
+        with open(args.output, "w") as output:
+            json.dump(trace, output, indent=1)
+    else:
+        json.dump(trace, sys.stdout, indent=1)
+
+
+if __name__ == "__main__":
+    main()